@@ -0,0 +1,239 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark the compile time of TVM on a fixed set of models.
+
+Each model is built in a fresh process, so that its peak memory is not shadowed by the models
+built before it. The results are written as JSON keyed by model, along with the commit they
+were measured at, and can be compared with the results of another commit:
+
+.. code-block:: bash
+
+    python3 compile_time_bench.py --output main.json
+    # ... check out and build the change ...
+    python3 compile_time_bench.py --output change.json --compare main.json
+"""
+import argparse
+import collections
+import json
+import multiprocessing
+import resource
+import sys
+import tempfile
+import time
+
+import tvm
+from tvm import relay
+from tvm.ir.instrument import pass_instrument
+from tvm.relay import testing
+from tvm.relay.loops import while_loop
+
+MODELS = ["resnet-50", "mobilenet", "bert-base", "lstm-dynamic"]
+
+
+def get_bert(num_layers=12, seq_len=128, hidden=768, num_heads=12, batch_size=1):
+    """A BERT-base encoder, without the embeddings."""
+    head_dim = hidden // num_heads
+    x = relay.var("data", shape=(batch_size * seq_len, hidden))
+
+    def dense(data, name, units):
+        output = relay.nn.dense(data, relay.var(f"{name}_weight"), units)
+        return relay.nn.bias_add(output, relay.var(f"{name}_bias"), axis=-1)
+
+    def layer_norm(data, name):
+        return relay.nn.layer_norm(data, relay.var(f"{name}_gamma"), relay.var(f"{name}_beta"))
+
+    def split_heads(data):
+        data = relay.reshape(data, (batch_size, seq_len, num_heads, head_dim))
+        data = relay.transpose(data, (0, 2, 1, 3))
+        return relay.reshape(data, (batch_size * num_heads, seq_len, head_dim))
+
+    for i in range(num_layers):
+        query = split_heads(dense(x, f"layer{i}_query", hidden))
+        key = split_heads(dense(x, f"layer{i}_key", hidden))
+        value = split_heads(dense(x, f"layer{i}_value", hidden))
+        scores = relay.nn.batch_matmul(query, key) * relay.const(head_dim**-0.5)
+        context = relay.nn.batch_matmul(
+            relay.nn.softmax(scores), value, transpose_a=False, transpose_b=False
+        )
+        context = relay.reshape(context, (batch_size, num_heads, seq_len, head_dim))
+        context = relay.reshape(relay.transpose(context, (0, 2, 1, 3)), (-1, hidden))
+        x = layer_norm(x + dense(context, f"layer{i}_output", hidden), f"layer{i}_attention_norm")
+        intermediate = dense(x, f"layer{i}_intermediate", 4 * hidden)
+        # GELU
+        half = relay.const(0.5)
+        intermediate = intermediate * (half + half * relay.erf(intermediate * relay.const(2**-0.5)))
+        x = layer_norm(x + dense(intermediate, f"layer{i}_ffn", hidden), f"layer{i}_ffn_norm")
+    return testing.create_workload(relay.Function(relay.analysis.free_vars(x), x))
+
+
+def get_dynamic_lstm(num_hidden=512, batch_size=1):
+    """An LSTM running over a sequence of dynamic length, which needs the VM."""
+    data = relay.var("data", shape=(relay.Any(), batch_size, num_hidden))
+    i2h_weight = relay.var("i2h_weight", shape=(4 * num_hidden, num_hidden))
+    h2h_weight = relay.var("h2h_weight", shape=(4 * num_hidden, num_hidden))
+    bias = relay.var("bias", shape=(4 * num_hidden,))
+    state_type = relay.TensorType((batch_size, num_hidden))
+    step = relay.var("step", shape=(), dtype="int32")
+    hidden = relay.var("hidden", type_annotation=state_type)
+    cell = relay.var("cell", type_annotation=state_type)
+    seq_len = relay.take(relay.shape_of(data, "int32"), relay.const(0))
+
+    def cond(step, hidden, cell):
+        return relay.less(step, seq_len)
+
+    def body(step, hidden, cell):
+        gates = relay.nn.dense(relay.take(data, step, axis=0), i2h_weight)
+        gates = relay.nn.bias_add(gates + relay.nn.dense(hidden, h2h_weight), bias, axis=-1)
+        in_gate, forget_gate, in_transform, out_gate = relay.split(gates, 4, axis=-1)
+        next_cell = relay.sigmoid(forget_gate) * cell + relay.sigmoid(in_gate) * relay.tanh(
+            in_transform
+        )
+        next_hidden = relay.sigmoid(out_gate) * relay.tanh(next_cell)
+        return step + relay.const(1), next_hidden, next_cell
+
+    loop = while_loop(cond, [step, hidden, cell], body)
+    zeros = relay.zeros((batch_size, num_hidden), "float32")
+    out = relay.TupleGetItem(loop(relay.const(0), zeros, zeros), 1)
+    return testing.create_workload(relay.Function(relay.analysis.free_vars(out), out))
+
+
+def get_model(name):
+    """Get the module and parameters of a model, and whether it must be built for the VM."""
+    if name == "resnet-50":
+        return testing.resnet.get_workload(num_layers=50, batch_size=1) + (False,)
+    if name == "mobilenet":
+        return testing.mobilenet.get_workload(batch_size=1) + (False,)
+    if name == "bert-base":
+        return get_bert() + (False,)
+    if name == "lstm-dynamic":
+        return get_dynamic_lstm() + (True,)
+    raise ValueError(f"Unknown model {name}, expected one of {MODELS}")
+
+
+@pass_instrument
+class PassTimes:
+    """Accumulate the wall time of every pass by name. Nested passes are counted in their own
+    entry as well as in the time of the passes containing them."""
+
+    def __init__(self):
+        self.times = collections.defaultdict(float)
+        self.starts = []
+
+    def run_before_pass(self, mod, info):
+        self.starts.append(time.perf_counter())
+
+    def run_after_pass(self, mod, info):
+        self.times[info.name] += time.perf_counter() - self.starts.pop()
+
+
+def _peak_memory_mb():
+    # ru_maxrss is in KB on Linux but in bytes on macOS.
+    scale = 1 << 20 if sys.platform == "darwin" else 1 << 10
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / scale
+
+
+def _build(name, target, opt_level, tune_trials):
+    mod, params, use_vm = get_model(name)
+    result = {}
+    pass_times = PassTimes()
+    start = time.perf_counter()
+    with tvm.transform.PassContext(opt_level=opt_level, instruments=[pass_times]):
+        if use_vm:
+            relay.vm.compile(mod, target=target, params=params)
+        else:
+            relay.build(mod, target=target, params=params)
+    result["build_seconds"] = time.perf_counter() - start
+    result["pass_seconds"] = dict(sorted(pass_times.times.items()))
+
+    if tune_trials > 0:
+        # pylint: disable=import-outside-toplevel
+        from tvm import meta_schedule as ms
+
+        with tempfile.TemporaryDirectory() as work_dir:
+            start = time.perf_counter()
+            database = ms.relay_integration.tune_relay(
+                mod, params, target, work_dir, max_trials_global=tune_trials, seed=0
+            )
+            tune_seconds = time.perf_counter() - start
+            num_candidates = len(database)
+        result["tune_seconds"] = tune_seconds
+        result["tune_candidates_per_second"] = num_candidates / tune_seconds
+    result["peak_memory_mb"] = _peak_memory_mb()
+    return result
+
+
+def _build_in_subprocess(name, target, opt_level, tune_trials):
+    ctx = multiprocessing.get_context("spawn")
+    with ctx.Pool(1) as pool:
+        return pool.apply(_build, (name, str(target), opt_level, tune_trials))
+
+
+def compare(results, baseline):
+    """Print the ratio of the totals of `results` to the ones of `baseline`."""
+    keys = ["build_seconds", "peak_memory_mb", "tune_candidates_per_second"]
+    print(f"{'model':<16}" + "".join(f"{key:>28}" for key in keys))
+    for name, result in results["models"].items():
+        if name not in baseline["models"]:
+            continue
+        base = baseline["models"][name]
+        ratios = [
+            f"{result[key] / base[key]:.3f}x" if key in result and base.get(key) else "-"
+            for key in keys
+        ]
+        print(f"{name:<16}" + "".join(f"{ratio:>28}" for ratio in ratios))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--models", nargs="+", choices=MODELS, default=MODELS)
+    parser.add_argument("--target", default="llvm")
+    parser.add_argument("--opt-level", type=int, default=3)
+    parser.add_argument(
+        "--tune-trials",
+        type=int,
+        default=0,
+        help="Tune each model with meta_schedule for this many trials to measure its throughput",
+    )
+    parser.add_argument("--output", help="Write the results to this JSON file")
+    parser.add_argument("--compare", help="JSON file of the results of another commit")
+    args = parser.parse_args()
+
+    results = {
+        "commit": tvm.support.libinfo()["GIT_COMMIT_HASH"],
+        "target": args.target,
+        "opt_level": args.opt_level,
+        "tune_trials": args.tune_trials,
+        "models": {},
+    }
+    for name in args.models:
+        result = _build_in_subprocess(name, args.target, args.opt_level, args.tune_trials)
+        results["models"][name] = result
+        print(
+            f"{name:<16} {result['build_seconds']:8.2f} s {result['peak_memory_mb']:10.1f} MB",
+            flush=True,
+        )
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+    if args.compare:
+        with open(args.compare) as f:
+            compare(results, json.load(f))
+
+
+if __name__ == "__main__":
+    main()
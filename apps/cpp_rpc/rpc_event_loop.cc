@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_event_loop.cc
+ * \brief Event loop serving several RPC sessions concurrently.
+ */
+#include "rpc_event_loop.h"
+
+#ifdef TVM_RPC_EVENT_LOOP_SUPPORTED
+
+#if defined(__APPLE__)
+#include <sys/event.h>
+#else
+#include <sys/epoll.h>
+#endif
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../src/runtime/rpc/rpc_channel.h"
+#include "../../src/runtime/rpc/rpc_endpoint.h"
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+/*! \brief Maximum number of events fetched by one poll call. */
+constexpr int kMaxEvents = 64;
+/*! \brief Poll interval, bounds the latency of timeouts and session release. */
+constexpr int kPollIntervalMs = 100;
+/*! \brief Size of the buffer used to read from session sockets. */
+constexpr size_t kRecvBufferSize = 64 * 1024;
+
+/*!
+ * \brief Channel used by a session worker to send replies.
+ *
+ *  Receiving is done by the event loop, the socket is owned by the session.
+ */
+class SessionChannel final : public RPCChannel {
+ public:
+  explicit SessionChannel(support::TCPSocket sock) : sock_(sock) {}
+  size_t Send(const void* data, size_t size) final { return sock_.SendAll(data, size); }
+  size_t Recv(void* data, size_t size) final {
+    LOG(FATAL) << "Do not allow explicit receive";
+    return 0;
+  }
+
+ private:
+  support::TCPSocket sock_;
+};
+}  // namespace
+
+/*!
+ * \brief A session served by the event loop.
+ *
+ *  The worker thread owns the RPCEndpoint and handles the bytes pushed by the
+ *  event loop in order.
+ */
+class RPCEventLoop::Session {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  Session(support::TCPSocket sock, support::SockAddr addr, int timeout)
+      : sock_(sock),
+        addr_(addr),
+        deadline_(timeout > 0 ? Clock::now() + std::chrono::seconds(timeout)
+                              : Clock::time_point::max()) {
+    worker_ = std::thread(&Session::WorkerProc, this);
+  }
+
+  ~Session() {
+    Close();
+    if (worker_.joinable()) worker_.join();
+    sock_.Close();
+  }
+
+  /*! \brief Queue received bytes for the worker. */
+  void Push(std::string bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(std::move(bytes));
+    cv_.notify_one();
+  }
+
+  /*! \brief Let the worker exit once the queued bytes are handled. */
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_one();
+  }
+
+  /*! \brief Disconnect the client, used when the session timed out. */
+  void Disconnect() {
+    shutdown(sock_.sockfd, SHUT_RDWR);
+    Close();
+  }
+
+  bool finished() const { return finished_; }
+
+  bool expired(Clock::time_point now) const { return now >= deadline_; }
+
+  support::TCPSocket& socket() { return sock_; }
+
+  /*! \brief Whether the event loop already stopped watching the socket. */
+  bool unwatched{false};
+
+ private:
+  void WorkerProc() {
+    std::shared_ptr<RPCEndpoint> endpoint =
+        RPCEndpoint::Create(std::make_unique<SessionChannel>(sock_), "SockServerLoop", "");
+    while (true) {
+      std::string bytes;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !pending_.empty() || closed_; });
+        if (pending_.empty()) break;
+        bytes = std::move(pending_.front());
+        pending_.pop_front();
+      }
+      int ret = 0;
+      try {
+        // 1: read available, 2: write available
+        ret = endpoint->ServerAsyncIOEventHandler(bytes, 3);
+        while (ret == 2) {
+          ret = endpoint->ServerAsyncIOEventHandler("", 2);
+        }
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Session " << addr_.AsString() << " failed: " << e.what();
+      }
+      if (ret == 0) break;
+    }
+    endpoint.reset();
+    LOG(INFO) << "Finish serving " << addr_.AsString();
+    finished_ = true;
+  }
+
+  support::TCPSocket sock_;
+  support::SockAddr addr_;
+  Clock::time_point deadline_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::string> pending_;
+  bool closed_{false};
+  std::atomic<bool> finished_{false};
+  std::thread worker_;
+};
+
+RPCEventLoop::RPCEventLoop(int max_sessions) : max_sessions_(max_sessions) {
+  ICHECK_GT(max_sessions, 0) << "ValueError: max_sessions must be positive";
+#if defined(__APPLE__)
+  poll_fd_ = kqueue();
+#else
+  poll_fd_ = epoll_create1(0);
+#endif
+  ICHECK_GE(poll_fd_, 0) << "Failed to create the RPC event loop: " << strerror(errno);
+  io_thread_ = std::thread(&RPCEventLoop::Run, this);
+}
+
+RPCEventLoop::~RPCEventLoop() {
+  stop_ = true;
+  if (io_thread_.joinable()) io_thread_.join();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& kv : sessions_) {
+      kv.second->Disconnect();
+    }
+    sessions_.clear();
+  }
+  close(poll_fd_);
+}
+
+void RPCEventLoop::AddSession(support::TCPSocket conn, support::SockAddr addr, int timeout) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int fd = static_cast<int>(conn.sockfd);
+  sessions_[fd] = std::make_unique<Session>(conn, addr, timeout);
+  Watch(fd);
+  LOG(INFO) << "Serving " << addr.AsString() << ", active sessions=" << sessions_.size();
+}
+
+void RPCEventLoop::WaitForSlot() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  slot_cv_.wait(lock, [this] { return sessions_.size() < max_sessions_; });
+}
+
+void RPCEventLoop::Run() {
+  std::vector<int> ready;
+  while (!stop_) {
+    ready.clear();
+#if defined(__APPLE__)
+    struct kevent events[kMaxEvents];
+    struct timespec ts = {0, kPollIntervalMs * 1000000L};
+    int n = kevent(poll_fd_, nullptr, 0, events, kMaxEvents, &ts);
+    for (int i = 0; i < n; ++i) ready.push_back(static_cast<int>(events[i].ident));
+#else
+    struct epoll_event events[kMaxEvents];
+    int n = epoll_wait(poll_fd_, events, kMaxEvents, kPollIntervalMs);
+    for (int i = 0; i < n; ++i) ready.push_back(events[i].data.fd);
+#endif
+    if (n < 0 && errno != EINTR) {
+      LOG(WARNING) << "RPC event loop poll failed: " << strerror(errno);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int fd : ready) {
+        HandleReadable(fd);
+      }
+    }
+    ReapSessions();
+  }
+}
+
+void RPCEventLoop::HandleReadable(int fd) {
+  auto it = sessions_.find(fd);
+  if (it == sessions_.end() || it->second->unwatched) return;
+  Session* session = it->second.get();
+  char buf[kRecvBufferSize];
+  ssize_t n = session->socket().Recv(buf, sizeof(buf));
+  if (n > 0) {
+    session->Push(std::string(buf, n));
+  } else if (n < 0 && support::Socket::LastErrorWouldBlock()) {
+    return;
+  } else {
+    // the client disconnected, let the worker drain its queue and exit
+    Unwatch(fd);
+    session->unwatched = true;
+    session->Close();
+  }
+}
+
+void RPCEventLoop::ReapSessions() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto now = Session::Clock::now();
+  bool released = false;
+  for (auto it = sessions_.begin(); it != sessions_.end();) {
+    Session* session = it->second.get();
+    if (!session->unwatched && (session->finished() || session->expired(now))) {
+      if (!session->finished()) {
+        LOG(INFO) << "Session on fd=" << it->first << " timed out, disconnecting";
+        session->Disconnect();
+      }
+      Unwatch(it->first);
+      session->unwatched = true;
+    }
+    // a worker stuck in a long call is only released once the call returns
+    if (session->finished()) {
+      it = sessions_.erase(it);
+      released = true;
+    } else {
+      ++it;
+    }
+  }
+  if (released) slot_cv_.notify_all();
+}
+
+void RPCEventLoop::Watch(int fd) {
+#if defined(__APPLE__)
+  struct kevent ev;
+  EV_SET(&ev, fd, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+  ICHECK_EQ(kevent(poll_fd_, &ev, 1, nullptr, 0, nullptr), 0)
+      << "Failed to watch socket: " << strerror(errno);
+#else
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  ICHECK_EQ(epoll_ctl(poll_fd_, EPOLL_CTL_ADD, fd, &ev), 0)
+      << "Failed to watch socket: " << strerror(errno);
+#endif
+}
+
+void RPCEventLoop::Unwatch(int fd) {
+#if defined(__APPLE__)
+  struct kevent ev;
+  EV_SET(&ev, fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+  kevent(poll_fd_, &ev, 1, nullptr, 0, nullptr);
+#else
+  epoll_ctl(poll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+}
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RPC_EVENT_LOOP_SUPPORTED
@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_event_loop.h
+ * \brief Event loop serving several RPC sessions concurrently.
+ */
+#ifndef TVM_APPS_CPP_RPC_EVENT_LOOP_H_
+#define TVM_APPS_CPP_RPC_EVENT_LOOP_H_
+
+#if defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+#define TVM_RPC_EVENT_LOOP_SUPPORTED 1
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "../../src/support/socket.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief RPCEventLoop serves several RPC sessions concurrently in one process.
+ *
+ *  Session sockets are watched by a single epoll (Linux/Android) or kqueue (macOS)
+ *  loop. Received bytes are forwarded to a per-session worker thread that drives an
+ *  event driven RPCEndpoint through ServerAsyncIOEventHandler, so a long running
+ *  call in one session does not block the other sessions on the same device.
+ *
+ *  Unlike the forked server, sessions share the process and its work directory,
+ *  and a session that exceeds its timeout is disconnected rather than killed.
+ */
+class RPCEventLoop {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param max_sessions The maximum number of concurrently served sessions.
+   */
+  explicit RPCEventLoop(int max_sessions);
+  /*!
+   * \brief Destructor, disconnects all sessions and stops the loop.
+   */
+  ~RPCEventLoop();
+  /*!
+   * \brief Start serving a connection which already finished the RPC handshake.
+   * \param conn The connection socket, owned by the loop afterwards.
+   * \param addr The address of the client.
+   * \param timeout The session timeout in seconds, 0 means no timeout.
+   */
+  void AddSession(support::TCPSocket conn, support::SockAddr addr, int timeout);
+  /*!
+   * \brief Block until fewer than max_sessions sessions are being served.
+   */
+  void WaitForSlot();
+
+ private:
+  class Session;
+  /*! \brief The IO loop run by io_thread_. */
+  void Run();
+  /*! \brief Read the available bytes of fd and forward them to its session. */
+  void HandleReadable(int fd);
+  /*! \brief Disconnect sessions past their deadline and release finished ones. */
+  void ReapSessions();
+  /*! \brief Start or stop watching fd for read events. */
+  void Watch(int fd);
+  void Unwatch(int fd);
+
+  /*! \brief The maximum number of concurrent sessions. */
+  size_t max_sessions_;
+  /*! \brief The epoll or kqueue descriptor. */
+  int poll_fd_{-1};
+  /*! \brief Whether the IO loop should exit. */
+  std::atomic<bool> stop_{false};
+  /*! \brief Guards sessions_. */
+  std::mutex mutex_;
+  /*! \brief Notified when a session is released. */
+  std::condition_variable slot_cv_;
+  /*! \brief The active sessions indexed by socket descriptor. */
+  std::unordered_map<int, std::unique_ptr<Session>> sessions_;
+  /*! \brief The thread running the IO loop. */
+  std::thread io_thread_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+#endif  // TVM_APPS_CPP_RPC_EVENT_LOOP_H_
@@ -30,6 +30,7 @@
 #include <chrono>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <thread>
@@ -38,6 +39,7 @@
 #include "../../src/runtime/rpc/rpc_socket_impl.h"
 #include "../../src/support/socket.h"
 #include "rpc_env.h"
+#include "rpc_event_loop.h"
 #include "rpc_server.h"
 #include "rpc_tracker_client.h"
 #if defined(_WIN32)
@@ -101,6 +103,10 @@ static std::string getNextString(std::stringstream* iss) {
  * \param key The key used to identify the device type in tracker.
  *
  * \param custom_addr Custom IP Address to Report to RPC Tracker.
+ *
+ * \param max_sessions The maximum number of sessions served concurrently.
+ *     With more than one session, sessions are served by an RPCEventLoop
+ *     in this process instead of one forked process per session.
  */
 class RPCServer {
  public:
@@ -108,7 +114,7 @@ class RPCServer {
    * \brief Constructor.
    */
   RPCServer(std::string host, int port_search_start, int port_search_end, std::string tracker_addr,
-            std::string key, std::string custom_addr, std::string work_dir)
+            std::string key, std::string custom_addr, std::string work_dir, int max_sessions)
       : host_(std::move(host)),
         port_search_start_(port_search_start),
         my_port_(0),
@@ -116,7 +122,8 @@ class RPCServer {
         tracker_addr_(std::move(tracker_addr)),
         key_(std::move(key)),
         custom_addr_(std::move(custom_addr)),
-        work_dir_(std::move(work_dir)) {}
+        work_dir_(std::move(work_dir)),
+        max_sessions_(max_sessions) {}
 
   /*!
    * \brief Destructor.
@@ -137,7 +144,17 @@ class RPCServer {
     listen_sock_.Create();
     my_port_ = listen_sock_.TryBindHost(host_, port_search_start_, port_search_end_);
     LOG(INFO) << "bind to " << host_ << ":" << my_port_;
-    listen_sock_.Listen(1);
+    listen_sock_.Listen(max_sessions_ > 1 ? max_sessions_ : 1);
+    if (max_sessions_ > 1) {
+#ifdef TVM_RPC_EVENT_LOOP_SUPPORTED
+      // replies to a disconnected client must fail instead of killing the server
+      signal(SIGPIPE, SIG_IGN);
+      event_loop_ = std::make_unique<RPCEventLoop>(max_sessions_);
+#else
+      LOG(WARNING) << "Concurrent sessions are not supported on this platform,"
+                   << " serving one session at a time.";
+#endif
+    }
     std::future<void> proc(std::async(std::launch::async, &RPCServer::ListenLoopProc, this));
     proc.get();
     // Close the listen socket
@@ -150,6 +167,13 @@ class RPCServer {
    */
   void ListenLoopProc() {
     TrackerClient tracker(tracker_addr_, key_, custom_addr_, my_port_);
+#ifdef TVM_RPC_EVENT_LOOP_SUPPORTED
+    // concurrent sessions share the work directory of this process
+    std::unique_ptr<RPCEnv> shared_env;
+    if (event_loop_ != nullptr) {
+      shared_env = std::make_unique<RPCEnv>(work_dir_);
+    }
+#endif
     while (true) {
       support::TCPSocket conn;
       support::SockAddr addr("0.0.0.0", 0);
@@ -172,6 +196,14 @@ class RPCServer {
       }
 
       int timeout = GetTimeOutFromOpts(opts);
+#ifdef TVM_RPC_EVENT_LOOP_SUPPORTED
+      if (event_loop_ != nullptr) {
+        // step 3: serving in the event loop, accept the next client once a slot is free
+        event_loop_->AddSession(conn, addr, timeout);
+        event_loop_->WaitForSlot();
+        continue;
+      }
+#endif
 #if defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
       // step 3: serving
       if (timeout != 0) {
@@ -356,6 +388,10 @@ class RPCServer {
   std::string key_;
   std::string custom_addr_;
   std::string work_dir_;
+  int max_sessions_;
+#ifdef TVM_RPC_EVENT_LOOP_SUPPORTED
+  std::unique_ptr<RPCEventLoop> event_loop_;
+#endif
   support::TCPSocket listen_sock_;
   support::TCPSocket tracker_sock_;
 };
@@ -384,22 +420,26 @@ void ServerLoopFromChild(SOCKET socket) {
  * \param tracker_addr The address of RPC tracker in host:port format e.g. 10.77.1.234:9190
  * Default="" \param key The key used to identify the device type in tracker. Default="" \param
  * custom_addr Custom IP Address to Report to RPC Tracker. Default="" \param silent Whether run in
- * silent mode. Default=True
+ * silent mode. Default=True \param max_sessions The maximum number of concurrent sessions.
+ * Default=1
  */
 void RPCServerCreate(std::string host, int port, int port_end, std::string tracker_addr,
-                     std::string key, std::string custom_addr, std::string work_dir, bool silent) {
+                     std::string key, std::string custom_addr, std::string work_dir, bool silent,
+                     int max_sessions) {
   if (silent) {
     // Only errors and fatal is logged
     dmlc::InitLogging("--minloglevel=2");
   }
   // Start the rpc server
   RPCServer rpc(std::move(host), port, port_end, std::move(tracker_addr), std::move(key),
-                std::move(custom_addr), std::move(work_dir));
+                std::move(custom_addr), std::move(work_dir), max_sessions);
   rpc.Start();
 }
 
 TVM_REGISTER_GLOBAL("rpc.ServerCreate").set_body([](TVMArgs args, TVMRetValue* rv) {
-  RPCServerCreate(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]);
+  int max_sessions = args.size() > 8 ? args[8].operator int() : 1;
+  RPCServerCreate(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7],
+                  max_sessions);
 });
 }  // namespace runtime
 }  // namespace tvm
@@ -50,10 +50,12 @@ void ServerLoopFromChild(SOCKET socket);
  * \param custom_addr Custom IP Address to Report to RPC Tracker. Default=""
  * \param work_dir Custom work directory. Default=""
  * \param silent Whether run in silent mode. Default=True
+ * \param max_sessions The maximum number of sessions served concurrently. Default=1
  */
 void RPCServerCreate(std::string host = "", int port = 9090, int port_end = 9099,
                      std::string tracker_addr = "", std::string key = "",
-                     std::string custom_addr = "", std::string work_dir = "", bool silent = true);
+                     std::string custom_addr = "", std::string work_dir = "", bool silent = true,
+                     int max_sessions = 1);
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_APPS_CPP_RPC_SERVER_H_
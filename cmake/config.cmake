@@ -98,6 +98,9 @@ set(USE_KHRONOS_SPIRV OFF)
 # whether enable SPIRV_KHR_DOT_PRODUCT
 set(USE_SPIRV_KHR_INTEGER_DOT_PRODUCT OFF)
 
+# whether enable SPIRV_KHR_COOPERATIVE_MATRIX, requires SPIR-V headers from Vulkan SDK 1.3.261+
+set(USE_SPIRV_KHR_COOPERATIVE_MATRIX OFF)
+
 # Whether enable OpenGL runtime
 set(USE_OPENGL OFF)
 
@@ -125,6 +128,9 @@ set(USE_GRAPH_EXECUTOR ON)
 # Whether enable tiny graph executor with CUDA Graph
 set(USE_GRAPH_EXECUTOR_CUDA_GRAPH OFF)
 
+# Whether enable tiny graph executor with HIP Graph
+set(USE_GRAPH_EXECUTOR_HIP_GRAPH OFF)
+
 # Whether enable pipeline executor.
 set(USE_PIPELINE_EXECUTOR OFF)
 
@@ -222,6 +228,9 @@ set(USE_CUDNN OFF)
 # Whether use cuBLAS
 set(USE_CUBLAS OFF)
 
+# Whether use cuFile (GPUDirect Storage) to load parameters directly to CUDA devices
+set(USE_CUFILE OFF)
+
 # Whether use MIOpen
 set(USE_MIOPEN OFF)
 
@@ -234,6 +243,9 @@ set(USE_ROCBLAS OFF)
 # Whether use contrib sort
 set(USE_SORT ON)
 
+# Whether use contrib embedding table lookups
+set(USE_EMBEDDING ON)
+
 # Whether to use Arm Compute Library (ACL) codegen
 # We provide 2 separate flags since we cannot build the ACL runtime on x86.
 # This is useful for cases where you want to cross-compile a relay graph
@@ -311,6 +323,17 @@ set(USE_THRUST OFF)
 # Whether use cuRAND
 set(USE_CURAND OFF)
 
+# Whether to enable CUPTI support in profiling. CUPTI provides access to the
+# performance counters of CUDA kernels while profiling.
+set(USE_CUPTI OFF)
+
+# Whether to build with NCCL, for the collective communication between GPUs.
+# Possible values:
+# - ON: enable NCCL, searching it in the CUDA toolkit and the system paths
+# - /path/to/nccl: enable NCCL, searching it in the given path
+# - OFF: disable NCCL
+set(USE_NCCL OFF)
+
 # Whether to build the TensorFlow TVMDSOOp module
 set(USE_TF_TVMDSOOP OFF)
 
@@ -381,6 +404,13 @@ set(USE_LIBBACKTRACE AUTO)
 # Need to have USE_LIBBACKTRACE enabled.
 set(BACKTRACE_ON_SEGFAULT OFF)
 
+# Whether to make the runtime tracepoints (kernel launch, allocation, copy, VM
+# instruction, parallel launch and RPC message) USDT probes of the "tvm"
+# provider, which bpftrace and perf can attach to. Requires sys/sdt.h, e.g.
+# from systemtap-sdt-dev. The tracepoints can always be recorded to a ring
+# buffer with tvm.runtime.profiling.enable_tracepoints.
+set(USE_USDT OFF)
+
 # Whether to enable PAPI support in profiling. PAPI provides access to hardware
 # counters while profiling.
 # Possible values:
@@ -401,6 +431,17 @@ set(USE_PAPI OFF)
 # predefined variables to specify the path to the GTest package if needed.
 set(USE_GTEST AUTO)
 
+# Whether to build the C++ microbenchmarks of the runtime hot paths with Google
+# Benchmark. When enabled, the generated build file will have the targets
+# "cppbench", and "cppbench_json" which runs it and writes cppbench.json.
+# Possible values:
+# - ON: enable Google Benchmark. The package `benchmark` will be required for
+#   cmake to succeed.
+# - OFF: disable Google Benchmark.
+# - AUTO: cmake will attempt to find the benchmark package, if found the
+#   benchmarks will be enabled, otherwise they will be disabled.
+set(USE_GBENCHMARK AUTO)
+
 # Enable using CUTLASS as a BYOC backend
 # Need to have USE_CUDA=ON
 set(USE_CUTLASS OFF)
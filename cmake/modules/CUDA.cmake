@@ -60,6 +60,13 @@ if(USE_CUDA)
     endif()
   endif(USE_CUBLAS)
 
+  if(USE_CUFILE)
+    message(STATUS "Build with cuFile support")
+    tvm_file_glob(GLOB CONTRIB_CUFILE_SRCS src/runtime/contrib/cufile/*.cc)
+    list(APPEND RUNTIME_SRCS ${CONTRIB_CUFILE_SRCS})
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${CUDA_CUFILE_LIBRARY})
+  endif(USE_CUFILE)
+
   if(USE_THRUST)
     message(STATUS "Build with Thrust support")
     cmake_minimum_required(VERSION 3.13) # to compile CUDA code
@@ -81,6 +88,43 @@ if(USE_CUDA)
     list(APPEND RUNTIME_SRCS ${CONTRIB_CURAND_SRC_CU})
   endif(USE_CURAND)
 
+  if(USE_RANDOM)
+    message(STATUS "Build with contrib.random CUDA kernels")
+    cmake_minimum_required(VERSION 3.13) # to compile CUDA code
+    enable_language(CUDA)
+    tvm_file_glob(GLOB CONTRIB_RANDOM_SRC_CU src/runtime/contrib/random/*.cu)
+    list(APPEND RUNTIME_SRCS ${CONTRIB_RANDOM_SRC_CU})
+  endif(USE_RANDOM)
+
+  if(USE_CUPTI)
+    message(STATUS "Build with CUPTI support")
+    find_library(CUDA_CUPTI_LIBRARY cupti
+      HINTS ${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib64)
+    include_directories(SYSTEM ${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI/include)
+    tvm_file_glob(GLOB CONTRIB_CUPTI_SRC_CC src/runtime/contrib/cupti/*.cc)
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${CUDA_CUPTI_LIBRARY})
+    list(APPEND RUNTIME_SRCS ${CONTRIB_CUPTI_SRC_CC})
+  endif(USE_CUPTI)
+
+  if(USE_NCCL)
+    message(STATUS "Build with NCCL support")
+    if(IS_DIRECTORY ${USE_NCCL})
+      set(NCCL_HINTS ${USE_NCCL})
+    endif()
+    find_path(NCCL_INCLUDE_DIR nccl.h
+      HINTS ${NCCL_HINTS} ${CUDA_TOOLKIT_ROOT_DIR} PATH_SUFFIXES include)
+    find_library(NCCL_LIBRARY nccl
+      HINTS ${NCCL_HINTS} ${CUDA_TOOLKIT_ROOT_DIR} PATH_SUFFIXES lib lib64)
+    if(NOT NCCL_INCLUDE_DIR OR NOT NCCL_LIBRARY)
+      message(FATAL_ERROR "Cannot find NCCL, USE_NCCL=" ${USE_NCCL})
+    endif()
+    message(STATUS "Found NCCL_LIBRARY=" ${NCCL_LIBRARY})
+    include_directories(SYSTEM ${NCCL_INCLUDE_DIR})
+    tvm_file_glob(GLOB CONTRIB_NCCL_SRC_CC src/runtime/contrib/nccl/*.cc)
+    list(APPEND TVM_RUNTIME_LINKER_LIBS ${NCCL_LIBRARY})
+    list(APPEND RUNTIME_SRCS ${CONTRIB_NCCL_SRC_CC})
+  endif(USE_NCCL)
+
   if(USE_GRAPH_EXECUTOR_CUDA_GRAPH)
     if(NOT USE_GRAPH_EXECUTOR)
       message(FATAL_ERROR "CUDA Graph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
@@ -91,6 +135,8 @@ if(USE_CUDA)
     message(STATUS "Build with Graph executor with CUDA Graph support...")
     tvm_file_glob(GLOB RUNTIME_CUDA_GRAPH_SRCS src/runtime/graph_executor/cuda_graph/*.cc)
     list(APPEND RUNTIME_SRCS ${RUNTIME_CUDA_GRAPH_SRCS})
+    tvm_file_glob(GLOB RUNTIME_VM_CUDA_GRAPH_SRCS src/runtime/vm/cuda_graph/*.cc)
+    list(APPEND RUNTIME_SRCS ${RUNTIME_VM_CUDA_GRAPH_SRCS})
   endif()
 else(USE_CUDA)
   list(APPEND COMPILER_SRCS src/target/opt/build_cuda_off.cc)
@@ -64,14 +64,18 @@ function(add_lib_info src_file)
     TVM_INFO_USE_CUBLAS="${USE_CUBLAS}"
     TVM_INFO_USE_CUDA="${USE_CUDA}"
     TVM_INFO_USE_CUDNN="${USE_CUDNN}"
+    TVM_INFO_USE_CUFILE="${USE_CUFILE}"
     TVM_INFO_USE_CUSTOM_LOGGING="${USE_CUSTOM_LOGGING}"
     TVM_INFO_USE_CUTLASS="${USE_CUTLASS}"
     TVM_INFO_USE_AMX="${USE_AMX}"
     TVM_INFO_USE_DNNL="${USE_DNNL}"
+    TVM_INFO_USE_EMBEDDING="${USE_EMBEDDING}"
     TVM_INFO_USE_ETHOSN="${USE_ETHOSN}"
     TVM_INFO_USE_FALLBACK_STL_MAP="${USE_FALLBACK_STL_MAP}"
     TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH="${USE_GRAPH_EXECUTOR_CUDA_GRAPH}"
+    TVM_INFO_USE_GRAPH_EXECUTOR_HIP_GRAPH="${USE_GRAPH_EXECUTOR_HIP_GRAPH}"
     TVM_INFO_USE_GRAPH_EXECUTOR="${USE_GRAPH_EXECUTOR}"
+    TVM_INFO_USE_GBENCHMARK="${USE_GBENCHMARK}"
     TVM_INFO_USE_GTEST="${USE_GTEST}"
     TVM_INFO_USE_HEXAGON="${USE_HEXAGON}"
     TVM_INFO_USE_HEXAGON_RPC="${USE_HEXAGON_RPC}"
@@ -105,6 +109,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_RTTI="${USE_RTTI}"
     TVM_INFO_USE_RUST_EXT="${USE_RUST_EXT}"
     TVM_INFO_USE_SORT="${USE_SORT}"
+    TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX="${USE_SPIRV_KHR_COOPERATIVE_MATRIX}"
     TVM_INFO_USE_SPIRV_KHR_INTEGER_DOT_PRODUCT="${USE_SPIRV_KHR_INTEGER_DOT_PRODUCT}"
     TVM_INFO_USE_STACKVM_RUNTIME="${USE_STACKVM_RUNTIME}"
     TVM_INFO_USE_TARGET_ONNX="${USE_TARGET_ONNX}"
@@ -116,12 +121,15 @@ function(add_lib_info src_file)
     TVM_INFO_USE_THREADS="${USE_THREADS}"
     TVM_INFO_USE_THRUST="${USE_THRUST}"
     TVM_INFO_USE_CURAND="${USE_CURAND}"
+    TVM_INFO_USE_CUPTI="${USE_CUPTI}"
+    TVM_INFO_USE_NCCL="${USE_NCCL}"
     TVM_INFO_USE_VITIS_AI="${USE_VITIS_AI}"
     TVM_INFO_USE_VULKAN="${USE_VULKAN}"
     TVM_INFO_USE_CLML="${USE_CLML}"
     TVM_INFO_USE_CLML_GRAPH_EXECUTOR="${USE_CLML_GRAPH_EXECUTOR}"
     TVM_INFO_USE_TVM_CLML_VERSION="${CLML_VERSION_MAJOR}"
     TVM_INFO_USE_UMA="${USE_UMA}"
+    TVM_INFO_USE_USDT="${USE_USDT}"
     TVM_INFO_USE_VERILATOR="${USE_VERILATOR}"
     TVM_INFO_USE_CCACHE="${USE_CCACHE}"
     TVM_INFO_BACKTRACE_ON_SEGFAULT="${BACKTRACE_ON_SEGFAULT}"
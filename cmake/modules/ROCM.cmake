@@ -38,6 +38,15 @@ if(USE_ROCM)
     list(APPEND TVM_RUNTIME_LINKER_LIBS ${ROCM_HSA_LIBRARY})
   endif()
 
+  if(USE_GRAPH_EXECUTOR_HIP_GRAPH)
+    if(NOT USE_GRAPH_EXECUTOR)
+      message(FATAL_ERROR "HIP Graph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
+    endif()
+    message(STATUS "Build with Graph executor with HIP Graph support...")
+    tvm_file_glob(GLOB RUNTIME_HIP_GRAPH_SRCS src/runtime/graph_executor/hip_graph/*.cc)
+    list(APPEND RUNTIME_SRCS ${RUNTIME_HIP_GRAPH_SRCS})
+  endif()
+
   if(USE_MIOPEN)
     message(STATUS "Build with MIOpen support")
     tvm_file_glob(GLOB MIOPEN_CONTRIB_SRCS src/runtime/contrib/miopen/*.cc)
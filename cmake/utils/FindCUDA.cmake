@@ -37,6 +37,7 @@
 # - CUDA_CUDNN_INCLUDE_DIRS
 # - CUDA_CUDNN_LIBRARY
 # - CUDA_CUBLAS_LIBRARY
+# - CUDA_CUFILE_LIBRARY
 #
 macro(find_cuda use_cuda use_cudnn)
   set(__use_cuda ${use_cuda})
@@ -102,6 +103,11 @@ macro(find_cuda use_cuda use_cudnn)
         NO_DEFAULT_PATH)
       # search default path if cannot find cublaslt in non-default
       find_library(CUDA_CUBLASLT_LIBRARY NAMES cublaslt cublasLt)
+      find_library(CUDA_CUFILE_LIBRARY cufile
+        PATHS ${CUDA_TOOLKIT_ROOT_DIR}
+        PATH_SUFFIXES lib lib64 targets/x86_64-linux/lib targets/sbsa-linux/lib lib/x86_64-linux-gnu
+        NO_DEFAULT_PATH)
+      find_library(CUDA_CUFILE_LIBRARY cufile)
     endif(MSVC)
 
     # find cuDNN
@@ -139,5 +145,6 @@ macro(find_cuda use_cuda use_cudnn)
     message(STATUS "Found CUDA_CUBLAS_LIBRARY=" ${CUDA_CUBLAS_LIBRARY})
     message(STATUS "Found CUDA_CURAND_LIBRARY=" ${CUDA_CURAND_LIBRARY})
     message(STATUS "Found CUDA_CUBLASLT_LIBRARY=" ${CUDA_CUBLASLT_LIBRARY})
+    message(STATUS "Found CUDA_CUFILE_LIBRARY=" ${CUDA_CUFILE_LIBRARY})
   endif(CUDA_FOUND)
 endmacro(find_cuda)
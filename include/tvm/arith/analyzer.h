@@ -367,11 +367,49 @@ class RewriteSimplifier {
    */
   TVM_DLL void SetMaximumRewriteSteps(int64_t maximum);
 
+  /*! \brief Enable or disable the memoization of simplifications
+   *
+   * When enabled, the results of this simplifier and of
+   * `Analyzer::Simplify` are recorded by the address of the
+   * expression being simplified, and reused while the constraints
+   * in scope and the variable bindings are unchanged.  The results of
+   * `DetectIterMap` with this analyzer are recorded likewise, by the
+   * structure of its arguments.  This speeds
+   * up passes which simplify the same expression objects many times,
+   * at the cost of keeping these expressions alive.  The cache hits
+   * and misses are part of the statistics counters.
+   *
+   * Only the facts given through `Analyzer::Bind` and
+   * `ConstraintContext` are tracked, updating a sub-analyzer
+   * directly does not invalidate the memoized results.
+   */
+  TVM_DLL void SetMemoizationEnabled(bool enabled);
+
+  /*!
+   * \brief Find the result of an analysis memoized in the current context.
+   * \param key The analysis and its arguments, compared structurally.
+   * \return The result, if memoization is enabled and the result is still valid.
+   */
+  TVM_DLL Optional<ObjectRef> FindMemoizedAnalysis(const ObjectRef& key);
+
+  /*!
+   * \brief Record the result of an analysis in the current context.
+   * \param key The analysis and its arguments, compared structurally.
+   * \param result The result of the analysis.
+   */
+  TVM_DLL void MemoizeAnalysis(const ObjectRef& key, const ObjectRef& result);
+
  private:
   friend class Analyzer;
   friend class ConstraintContext;
   friend class CanonicalSimplifier;
   explicit RewriteSimplifier(Analyzer* parent);
+  /*! \brief Find the memoized result of `Analyzer::Simplify(expr, steps)` */
+  Optional<PrimExpr> FindMemoizedSimplify(const PrimExpr& expr, int steps);
+  /*! \brief Record the result of `Analyzer::Simplify(expr, steps)` */
+  void MemoizeSimplify(const PrimExpr& expr, int steps, const PrimExpr& result);
+  /*! \brief Forget the memoized results after the known ranges of variables changed */
+  void InvalidateMemo();
   TVM_DLL ~RewriteSimplifier();
   class Impl;
   /*! \brief Internal impl */
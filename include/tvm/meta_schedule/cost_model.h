@@ -21,6 +21,7 @@
 #define TVM_META_SCHEDULE_COST_MODEL_H_
 
 #include <tvm/meta_schedule/arg_info.h>
+#include <tvm/meta_schedule/feature_extractor.h>
 #include <tvm/meta_schedule/measure_candidate.h>
 #include <tvm/meta_schedule/runner.h>
 #include <tvm/node/reflection.h>
@@ -165,6 +166,17 @@ class CostModel : public runtime::ObjectRef {
                                        PyCostModelNode::FUpdate f_update,    //
                                        PyCostModelNode::FPredict f_predict,  //
                                        PyCostModelNode::FAsString f_as_string);
+  /*!
+   * \brief Create a cost model that natively scores the candidates with a pre-trained tree
+   * ensemble, in parallel and without calling back into python. It is inference-only, i.e.
+   * `Update` is a no-op.
+   * \param extractor The feature extractor, whose features the tree ensemble is trained on.
+   * \param path The path to the tree ensemble, an XGBoost model saved in JSON. If undefined, the
+   * model has to be loaded by `Load` before predicting.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel TreeEnsembleCostModel(FeatureExtractor extractor,
+                                                 Optional<String> path);
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CostModel, ObjectRef, CostModelNode);
 };
 
@@ -102,12 +102,15 @@ class FeatureExtractor : public runtime::ObjectRef {
    * curve.
    * \param cache_line_bytes The number of bytes in a cache line.
    * \param extract_workload Whether to extract features in the workload in tuning context or not.
+   * \param max_cache_size The maximum number of candidates whose features are cached, keyed by
+   * their structural hash. Non-positive values disable the cache.
    * \return The feature extractor created.
    */
   TVM_DLL static FeatureExtractor PerStoreFeature(int buffers_per_store = 5,
                                                   int arith_intensity_curve_num_samples = 10,
                                                   int cache_line_bytes = 64,
-                                                  bool extract_workload = false);
+                                                  bool extract_workload = false,
+                                                  int max_cache_size = 1024);
   /*!
    * \brief Create a feature extractor with customized methods on the python-side.
    * \param f_extract_from The packed function of `ExtractFrom`.
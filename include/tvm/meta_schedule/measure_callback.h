@@ -127,6 +127,23 @@ class MeasureCallback : public runtime::ObjectRef {
    * \return The measure callback created.
    */
   TVM_DLL static MeasureCallback UpdateCostModel();
+  /*!
+   * \brief Create a measure callback that stops tuning a task early once it converges, so that
+   *  the rest of the global trial budget goes to the tasks that still improve.
+   * \param patience The number of trials without improvement of the best latency after which
+   *  a task is stopped. Non-positive values disable the check.
+   * \param min_improvement The relative decrease of the best latency counted as an improvement.
+   * \param max_prediction_error If positive, a plateau only stops a task when the cost model
+   *  mis-ranks at most this fraction of the pairs of candidates in the last measured batch.
+   * \param max_seconds_per_task The wall-clock budget of each task in seconds, counted from its
+   *  first measured batch. Non-positive values disable the check.
+   * \return The measure callback created.
+   * \note The callback should be placed before `UpdateCostModel`, so that the prediction error is
+   *  measured on candidates the cost model has not been trained on.
+   */
+  TVM_DLL static MeasureCallback StopOnConvergence(int patience, double min_improvement,
+                                                   double max_prediction_error,
+                                                   double max_seconds_per_task);
   /*!
    * \brief Create a measure callback with customized methods on the python-side.
    * \param f_apply The packed function of `Apply`.
@@ -28,7 +28,10 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/target/target.h>
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -51,17 +54,45 @@ class ScopedTimer {
   runtime::TypedPackedFunc<void()> deferred_;
 };
 
-/*! \brief A generic profiler */
+/*!
+ * \brief A generic profiler. Besides the total time of each named segment, it records a timeline
+ * of every timed scope, including those timed on threads other than the one that entered the
+ * profiler, which can be exported as a Chrome trace or as folded stacks for flame graphs.
+ */
 class ProfilerNode : public runtime::Object {
  public:
+  /*! \brief A timed scope on the timeline */
+  struct Event {
+    /*! \brief The names of the enclosing scopes on the same thread and the scope, joined by ';' */
+    std::string path;
+    /*! \brief The thread of the scope, numbered in the order of their first scope */
+    int thread_id;
+    /*! \brief The start time of the scope since the profiler is entered, in microseconds */
+    double start_us;
+    /*! \brief The duration of the scope, in microseconds */
+    double duration_us;
+  };
+
   /*! \brief The segments that are already profiled */
   std::unordered_map<std::string, double> stats_sec;
   /*! \brief Counter for the total time used */
   runtime::PackedFunc total_timer;
+  /*! \brief The timed scopes, in the order they end */
+  std::vector<Event> events;
+  /*! \brief The number assigned to each thread in `events` */
+  std::unordered_map<std::thread::id, int> thread_ids;
+  /*! \brief The time when the profiler is entered */
+  std::chrono::high_resolution_clock::time_point start_time;
+  /*! \brief The mutex guarding `events` and `thread_ids` */
+  mutable std::mutex events_mutex;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     // `stats_sec` is not visited.
     // `total_timer` is not visited.
+    // `events` is not visited.
+    // `thread_ids` is not visited.
+    // `start_time` is not visited.
+    // `events_mutex` is not visited.
   }
 
   static constexpr const char* _type_key = "meta_schedule.Profiler";
@@ -72,6 +103,21 @@ class ProfilerNode : public runtime::Object {
   Map<String, FloatImm> Get() const;
   /*! \brief Return a summary of profiling results as table format */
   String Table() const;
+  /*! \brief Return the timeline in the Chrome trace event format, readable by Perfetto */
+  String ChromeTrace() const;
+  /*!
+   * \brief Return the exclusive time of each stack of scopes in the folded format of flame graphs,
+   * one line per stack, e.g. "Total;EvoSearch/Evolve 1234" with the time in microseconds.
+   */
+  String FlameGraph() const;
+  /*!
+   * \brief Record a timed scope on the timeline
+   * \param path The names of the enclosing scopes and the scope, joined by ';'
+   * \param tik The start time of the scope
+   * \param tok The end time of the scope
+   */
+  void AddEvent(std::string path, std::chrono::high_resolution_clock::time_point tik,
+                std::chrono::high_resolution_clock::time_point tok);
 };
 
 /*!
@@ -202,13 +202,17 @@ class ScheduleRule : public runtime::ObjectRef {
    * \param reuse_read Data reuse configuration for reading. NullOpt means no reuse.
    * \param reuse_write Data reuse configuration for writing. NullOpt means no reuse.
    * \param use_software_pipeline Whether use the software pipeline.
+   * \param split_k_factors The candidate numbers of parts to split the reduction into, each of
+   * which adds design spaces computing the partial sums in parallel and adding them up in a
+   * separate reduction stage. NullOpt means no split-K.
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule MultiLevelTilingTensorCore(
       Array<Map<String, String>> intrin_groups, String structure,
       Optional<Array<String>> tile_binds, Optional<Integer> max_innermost_factor,
       Optional<Array<Integer>> vector_load_lens, Optional<Map<String, ObjectRef>> reuse_read,
-      Optional<Map<String, ObjectRef>> reuse_write, bool use_software_pipeline);
+      Optional<Map<String, ObjectRef>> reuse_write, bool use_software_pipeline,
+      Optional<Array<Integer>> split_k_factors);
 
   /*!
    * \brief Extension of MultiLevelTiling for backends with wide vectors.
@@ -247,6 +251,22 @@ class ScheduleRule : public runtime::ObjectRef {
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule RandomComputeLocation();
+  /*!
+   * \brief A rule that computes an intermediate buffer under the loops of its only consumer
+   * with a rolling buffer, so that consecutive spatial stages, e.g. pooling and depthwise
+   * convolution chains, exchange their feature maps through line buffers kept in cache.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule RollingBuffer();
+  /*!
+   * \brief Sample the distance of the software prefetches of strided and gathered loads and mark
+   * it to the root block. The mark is applied to the innermost serial loop of each block in
+   * the post processor RewriteParallelVectorizeUnroll.
+   * \param prefetch_distances The candidate distances, in loop iterations. A distance of 0 leaves
+   * the loops without prefetch.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule SoftwarePrefetch(Array<Integer> prefetch_distances);
   /*!
    * \brief Mark parallelize, vectorize and unroll to the root block. The mark will be applied to
    * each block in a follow-up post processor
@@ -258,12 +278,18 @@ class ScheduleRule : public runtime::ObjectRef {
    * \param unroll_max_steps The options of the maximum number of unroll steps to be done.
    * Use an empty array to disable unroll.
    * \param unroll_explicit Whether to explicitly unroll the loop, or just add an "unroll" pragma.
+   * \param unroll_max_registers The maximum estimated number of registers of an unrolled loop,
+   * which keeps aggressive unrolling from spilling. Use -1 for no limit.
+   * \param unroll_max_code_size The maximum estimated number of instructions of an unrolled loop,
+   * which keeps aggressive unrolling from overflowing the instruction cache. Use -1 for no limit.
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule ParallelizeVectorizeUnroll(int max_jobs_per_core,            //
                                                          int max_vectorize_extent,         //
                                                          Array<Integer> unroll_max_steps,  //
-                                                         bool unroll_explicit);
+                                                         bool unroll_explicit,             //
+                                                         int unroll_max_registers = -1,    //
+                                                         int unroll_max_code_size = -1);
   /*!
    * \brief Auto bind loops around the block to BlockIdx and ThreadIdx
    * \param max_threadblocks The maximum number of threadblock on GPU
@@ -290,12 +316,14 @@ class ScheduleRule : public runtime::ObjectRef {
 
   /*! \brief Create default schedule rules for LLVM */
   TVM_DLL static Array<ScheduleRule, void> DefaultLLVM();
-  /*! \brief Create default schedule rules for x86 (AVX512 and VNNI) */
+  /*! \brief Create default schedule rules for x86 (AVX512, VNNI and AVX512-BF16) */
   TVM_DLL static Array<ScheduleRule, void> DefaultX86(const String& type);
   /*! \brief Create default schedule rules for CUDA */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDA();
   /*! \brief Create default postprocessors for CUDA with TensorCore */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDATensorCore();
+  /*! \brief Create default schedule rules for Vulkan with cooperative matrices */
+  TVM_DLL static Array<ScheduleRule, void> DefaultVulkanTensorCore();
   /*! \brief Create default schedule rules for Hexagon */
   TVM_DLL static Array<ScheduleRule, void> DefaultHexagon();
   /*! \brief Create default schedule rules for Micro */
@@ -205,6 +205,11 @@ class SearchStrategy : public runtime::ObjectRef {
    * \param genetic_mutate_prob The probability of mutation.
    * \param genetic_max_fail_count The maximum number to try evolving the given trace.
    * \param eps_greedy The ratio to select samples in a greedy fashion via their predicted score.
+   * \param num_transfer_workloads The number of similar workloads in the database whose best
+   *  traces fill up the measured samples of the initial population, when the workload being
+   *  tuned does not have enough records.
+   * \param dedup_lowered_ir Whether to skip the candidates lowering to the same TIR as a candidate
+   *  already measured.
    */
   TVM_DLL static SearchStrategy EvolutionarySearch(int population_size,         //
                                                    double init_measured_ratio,  //
@@ -213,7 +218,9 @@ class SearchStrategy : public runtime::ObjectRef {
                                                    int genetic_num_iters,       //
                                                    double genetic_mutate_prob,  //
                                                    int genetic_max_fail_count,  //
-                                                   double eps_greedy);
+                                                   double eps_greedy,           //
+                                                   int num_transfer_workloads,  //
+                                                   bool dedup_lowered_ir);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(SearchStrategy, ObjectRef, SearchStrategyNode);
 };
@@ -38,9 +38,18 @@ namespace tvm {
  */
 TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
 
+/*!
+ * \brief save the node as well as all the node it depends on in a compact binary format,
+ *  with a string table, varint indices and raw NDArray blobs. LoadJSON detects and loads it.
+ *
+ * \return The bytes of the binary representation of the node.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
 /*!
  * \brief Internal implementation of LoadJSON
- * Load tvm Node object from json and return a shared_ptr of Node.
+ * Load tvm Node object from json, or from the output of SaveBinary,
+ * and return a shared_ptr of Node.
  * \param json_str The json string to load from.
  *
  * \return The shared_ptr of the Node.
@@ -1111,6 +1111,16 @@ struct DensePackAttrs : public tvm::AttrsNode<DensePackAttrs> {
   }
 };
 
+/*! \brief Attributes for embedding_lookup operator */
+struct EmbeddingLookupAttrs : public tvm::AttrsNode<EmbeddingLookupAttrs> {
+  tvm::String mode;
+
+  TVM_DECLARE_ATTRS(EmbeddingLookupAttrs, "relay.attrs.EmbeddingLookupAttrs") {
+    TVM_ATTR_FIELD(mode).set_default("none").describe(
+        "Reduction of the looked up rows over the last axis of indices, one of none, sum, mean.");
+  }
+};
+
 /*! \brief Attributes for batch matmul operator. */
 struct BatchMatmulAttrs : public tvm::AttrsNode<BatchMatmulAttrs> {
   DataType out_dtype;
@@ -1135,6 +1145,21 @@ struct BatchMatmulAttrs : public tvm::AttrsNode<BatchMatmulAttrs> {
   }
 };
 
+/*! \brief Attributes for fused_attention operator */
+struct FusedAttentionAttrs : public tvm::AttrsNode<FusedAttentionAttrs> {
+  double scale;
+  DataType out_dtype;
+
+  TVM_DECLARE_ATTRS(FusedAttentionAttrs, "relay.attrs.FusedAttentionAttrs") {
+    TVM_ATTR_FIELD(scale).set_default(1.0).describe(
+        "The scale applied to the scores before the softmax.");
+    // use 0 bits to indicate none.
+    TVM_ATTR_FIELD(out_dtype)
+        .set_default(NullValue<DataType>())
+        .describe("Output data type, set to explicit type under mixed precision setting");
+  }
+};
+
 /*! \brief Attributes for sparse_dense operator */
 struct SparseDenseAttrs : public tvm::AttrsNode<SparseDenseAttrs> {
   bool sparse_lhs;
@@ -327,6 +327,17 @@ TVM_DLL Pass CombineParallelDense(uint64_t min_num_branches = 3, bool to_batch_m
  */
 TVM_DLL Pass CombineParallelBatchMatmul(uint64_t min_num_branches = 3);
 
+/*!
+ * \brief Combine parallel take ops gathering rows of the same table into a
+ * single take over the stacked indices if the number of branches is not less
+ * than `min_num_branch`.
+ *
+ * \param min_num_branches The minimun number of branches.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass CombineParallelTake(uint64_t min_num_branches = 3);
+
 /*!
  * \brief Backward fold axis scaling into weights of conv/dense operators.
  *
@@ -467,6 +478,24 @@ TVM_DLL Pass RemoveUnusedFunctions(Array<runtime::String> entry_functions);
  */
 TVM_DLL Pass SimplifyExpr();
 
+/*!
+ * \brief Rewrite the batch_matmul, softmax and batch_matmul chain of scaled dot-product attention
+ * into nn.fused_attention, which computes the softmax online without materializing the scores.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass FuseAttention();
+
+/*!
+ * \brief Rewrite take along the first axis of large 2-D tables, optionally followed by a sum or
+ * mean over the last index axis, into nn.contrib_embedding_lookup.
+ *
+ * \param min_table_bytes The minimum size of the tables to rewrite the lookups of.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass RewriteEmbeddingLookup(int64_t min_table_bytes);
+
 /*!
  * \brief Stripped down version of SimplifyExpr which is run after AlterOpLayout.
  *
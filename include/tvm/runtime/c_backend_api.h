@@ -153,6 +153,19 @@ TVM_DLL int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, in
  */
 TVM_DLL int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv);
 
+/*!
+ * \brief Record the start or the end of a region instrumented by the lightweight profiler.
+ *
+ *  The events are appended to a ring buffer of the calling thread, and
+ *  collected by tvm::runtime::profiling::LWPReport.
+ *
+ * \param id The id of the instrumented loop or function.
+ * \param is_end Whether the event marks the end of the region.
+ * \param cycles The value of the cycle counter, or -1 to let the runtime read it.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileEvent(int32_t id, int32_t is_end, int64_t cycles);
+
 /*!
  * \brief Simple static initialization function.
  *  Run f once and set handle to be not null.
@@ -69,6 +69,22 @@ typedef struct TVMGraphExecutor TVMGraphExecutor;
 int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
                             const DLDevice* devices, TVMGraphExecutor** executor);
 
+/*!
+ * \brief Allocate a new GraphExecutor running a binary graph in place.
+ *
+ * The node tables and attributes of the graph are used directly from graph_binary, e.g. in flash,
+ * so that only the tensors and operator closures are allocated with TVMPlatformMemoryAllocate.
+ * The binary graph is produced on the host by tvm.micro.graph_binary.serialize_graph.
+ *
+ * \param graph_binary The binary graph, aligned to 8 bytes. It must outlive the executor.
+ * \param module_handle TVM Module that exposes the functions to call.
+ * \param devices runtime execution device.
+ * \param executor Pointer which receives a pointer to the newly-created instance.
+ * \return 0 if successful.
+ */
+int TVMGraphExecutor_CreateFromBinary(const void* graph_binary, TVMModuleHandle module_handle,
+                                      const DLDevice* devices, TVMGraphExecutor** executor);
+
 int TVMGraphExecutor_GetInputIndex(TVMGraphExecutor* executor, const char* name);
 
 /*!
@@ -66,6 +66,9 @@ struct MemoryManagerInterface {
 /*!
  * Exposed for testing.
  *
+ * When TVM_CRT_PAGE_ALLOCATOR_TLSF is defined in crt_config.h, this creates the TLSF page
+ * allocator, see TLSFPageMemoryManagerCreate.
+ *
  * \param manager Pointer, initialized with the new MemoryManager.
  * \param memory_pool Pointer to the global memory pool used by the CRT.
  * \param memory_pool_size_bytes Size of `memory_pool`, in bytes.
@@ -75,6 +78,22 @@ struct MemoryManagerInterface {
 tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
                                         size_t memory_pool_size_bytes, size_t page_size_bytes_log2);
 
+/*!
+ * \brief Create a page allocator based on two-level segregated fit (TLSF).
+ *
+ * Runs of free pages are kept in segregated free lists indexed by their size, and adjacent free
+ * runs are coalesced when freed, so that both Allocate and Free run in constant time.
+ *
+ * \param manager Pointer, initialized with the new memory manager.
+ * \param memory_pool Pointer to the global memory pool used by the CRT.
+ * \param memory_pool_size_bytes Size of `memory_pool`, in bytes.
+ * \param page_size_bytes_log2 log2 of the page size, in bytes.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFPageMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
+                                            size_t memory_pool_size_bytes,
+                                            size_t page_size_bytes_log2);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
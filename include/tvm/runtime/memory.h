@@ -26,6 +26,7 @@
 #include <tvm/runtime/object.h>
 
 #include <cstdlib>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -47,9 +48,128 @@ inline ObjectPtr<T> make_object(Args&&... args);
 //
 // Possible future allocator optimizations:
 // - Arena allocator that gives ownership of memory to arena (deleter_= nullptr)
-// - Thread-local object pools: one pool per size and alignment requirement.
 // - Can specialize by type of object to give the specific allocator to each object.
 
+/*!
+ * \brief Thread-local free lists recycling the memory of small objects, one list per size class.
+ *
+ *  Blocks are only cached while an ObjectPoolScope is alive on the thread, and the cache is
+ *  released when the outermost scope exits. The entry of a thread is trivially destructible,
+ *  so that objects freed during the static destruction still find it. Every block is a plain ::operator new allocation,
+ *  so that objects outliving the scope, or freed on another thread, are freed normally.
+ */
+class ObjectPool {
+ public:
+  /*! \brief The granularity and the maximum alignment of the pooled blocks */
+  static constexpr size_t kGranularity = 16;
+  /*! \brief The number of size classes, covering blocks of up to 256 bytes */
+  static constexpr size_t kNumSizeClasses = 16;
+  /*! \brief The maximum number of blocks cached in each size class */
+  static constexpr size_t kMaxCachedBlocks = 4096;
+
+  /*!
+   * \brief Allocate a block of memory.
+   * \param size The size of the block.
+   * \param align The alignment of the block.
+   * \return The block.
+   */
+  static void* Alloc(size_t size, size_t align) {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(size, std::align_val_t(align));
+    }
+    size_t cls = SizeClass(size, align);
+    if (cls == kNumSizeClasses) {
+      return ::operator new(size);
+    }
+    Entry* entry = Get();
+    if (Block* block = entry->free_lists[cls]) {
+      entry->free_lists[cls] = block->next;
+      --entry->num_cached[cls];
+      return block;
+    }
+    return ::operator new((cls + 1) * kGranularity);
+  }
+
+  /*!
+   * \brief Free a block of memory returned by Alloc.
+   * \param ptr The block.
+   * \param size The size of the block.
+   * \param align The alignment of the block.
+   */
+  static void Free(void* ptr, size_t size, size_t align) {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(ptr, std::align_val_t(align));
+      return;
+    }
+    size_t cls = SizeClass(size, align);
+    Entry* entry = cls == kNumSizeClasses ? nullptr : Get();
+    if (entry == nullptr || entry->depth == 0 || entry->num_cached[cls] >= kMaxCachedBlocks) {
+      ::operator delete(ptr);
+      return;
+    }
+    Block* block = static_cast<Block*>(ptr);
+    block->next = entry->free_lists[cls];
+    entry->free_lists[cls] = block;
+    ++entry->num_cached[cls];
+  }
+
+ private:
+  friend class ObjectPoolScope;
+
+  struct Block {
+    Block* next;
+  };
+
+  struct Entry {
+    /*! \brief The number of live ObjectPoolScopes on the thread */
+    int depth = 0;
+    Block* free_lists[kNumSizeClasses] = {nullptr};
+    size_t num_cached[kNumSizeClasses] = {0};
+
+    void Release() {
+      for (size_t cls = 0; cls < kNumSizeClasses; ++cls) {
+        while (Block* block = free_lists[cls]) {
+          free_lists[cls] = block->next;
+          ::operator delete(block);
+        }
+        num_cached[cls] = 0;
+      }
+    }
+  };
+
+  static Entry* Get() {
+    static thread_local Entry entry;
+    return &entry;
+  }
+
+  /*! \brief The size class of a block, or kNumSizeClasses if it is not pooled */
+  static size_t SizeClass(size_t size, size_t align) {
+    if (align > kGranularity || size == 0 || size > kNumSizeClasses * kGranularity) {
+      return kNumSizeClasses;
+    }
+    return (size - 1) / kGranularity;
+  }
+};
+
+/*!
+ * \brief RAII scope in which the memory of the objects freed on the current thread is kept
+ *  for the objects allocated next, instead of being returned to the heap.
+ */
+class ObjectPoolScope {
+ public:
+  ObjectPoolScope() { ++ObjectPool::Get()->depth; }
+
+  ~ObjectPoolScope() {
+    ObjectPool::Entry* entry = ObjectPool::Get();
+    if (--entry->depth == 0) {
+      entry->Release();
+    }
+  }
+
+  ObjectPoolScope(const ObjectPoolScope&) = delete;
+  ObjectPoolScope& operator=(const ObjectPoolScope&) = delete;
+};
+
 /*!
  * \brief Base class of object allocators that implements make.
  *  Use curiously recurring template pattern.
@@ -118,7 +238,7 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
       // class with non-virtual destructor.
       // We are fine here as we captured the right deleter during construction.
       // This is also the right way to get storage type for an object pool.
-      StorageType* data = new StorageType();
+      void* data = ObjectPool::Alloc(sizeof(StorageType), alignof(StorageType));
       new (data) T(std::forward<Args>(args)...);
       return reinterpret_cast<T*>(data);
     }
@@ -136,7 +256,7 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
       // instead of tptr->~T(), which could mean the intention
       // call a virtual destructor(which may not be available and is not required).
       tptr->T::~T();
-      delete reinterpret_cast<StorageType*>(tptr);
+      ObjectPool::Free(tptr, sizeof(StorageType), alignof(StorageType));
     }
   };
 
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/memory_stats.h
+ * \brief Live accounting of the device memory held by the runtime.
+ */
+#ifndef TVM_RUNTIME_MEMORY_STATS_H_
+#define TVM_RUNTIME_MEMORY_STATS_H_
+
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/profiling.h>
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Accounting of the device memory allocated by the runtime, per device and per owner.
+ *
+ * The owners, e.g. "ndarray" or "vm.pooled", record every allocation and free they make through
+ * the DeviceAPI. The current and peak bytes of each (device, owner) pair are always kept. When
+ * tracing is enabled the stack of every live allocation is kept as well, so that the report
+ * shows where the memory still held, e.g. leaked, was allocated. Tracing is enabled by default
+ * when the environment variable TVM_MEMORY_TRACE is set.
+ */
+class MemoryStats {
+ public:
+  /*! \brief The global memory stats. */
+  TVM_DLL static MemoryStats* Global();
+  /*!
+   * \brief Record an allocation.
+   * \param dev The device of the allocation.
+   * \param owner The name of the owner of the allocation, which must outlive the stats.
+   * \param ptr The allocated pointer.
+   * \param nbytes The number of bytes allocated.
+   */
+  TVM_DLL void RecordAlloc(Device dev, const char* owner, const void* ptr, size_t nbytes);
+  /*!
+   * \brief Record the free of an allocation recorded by RecordAlloc.
+   * \param dev The device of the allocation.
+   * \param owner The owner the allocation was recorded with.
+   * \param ptr The freed pointer.
+   * \param nbytes The number of bytes freed.
+   */
+  TVM_DLL void RecordFree(Device dev, const char* owner, const void* ptr, size_t nbytes);
+  /*!
+   * \brief Enable or disable the tracing of the stacks of the live allocations. Only the
+   *  allocations made while tracing is enabled are traced.
+   */
+  TVM_DLL void SetTracing(bool enable);
+  /*! \brief Reset the peaks to the current bytes. */
+  TVM_DLL void ResetPeak();
+  /*!
+   * \brief Report the memory held by the runtime.
+   *
+   * Each (device, owner) pair is a call named after the owner, with its "Current (bytes)",
+   * "Peak (bytes)" and live "Allocations". The device metrics hold the same numbers summed per
+   * device, where the peak is the peak of the sum. The pools of the VM allocators are reported
+   * as calls named "<owner> pool", with the bytes they hold from the device, the bytes of free
+   * buffers cached in them, and their occupancy. When tracing, the live allocations are
+   * reported as calls named "live <owner>", one per allocation stack, with the stack in "Stack".
+   */
+  TVM_DLL profiling::Report Report();
+
+ private:
+  MemoryStats();
+
+  struct Counter {
+    size_t current{0};
+    size_t peak{0};
+    int64_t num_allocs{0};
+  };
+  /*! \brief Orders the (device type, device id, owner) keys by the contents of the owner. */
+  struct OwnerKeyLess {
+    bool operator()(const std::tuple<int, int, const char*>& a,
+                    const std::tuple<int, int, const char*>& b) const {
+      if (std::get<0>(a) != std::get<0>(b)) return std::get<0>(a) < std::get<0>(b);
+      if (std::get<1>(a) != std::get<1>(b)) return std::get<1>(a) < std::get<1>(b);
+      return std::strcmp(std::get<2>(a), std::get<2>(b)) < 0;
+    }
+  };
+  struct LiveAllocation {
+    Device dev;
+    const char* owner;
+    size_t nbytes;
+    std::string stack;
+  };
+
+  std::mutex mu_;
+  std::atomic<bool> tracing_{false};
+  /*! \brief The counters keyed by (device type, device id, owner). */
+  std::map<std::tuple<int, int, const char*>, Counter, OwnerKeyLess> owners_;
+  /*! \brief The counters keyed by (device type, device id). */
+  std::map<std::pair<int, int>, Counter> devices_;
+  std::unordered_map<const void*, LiveAllocation> live_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_MEMORY_STATS_H_
@@ -284,6 +284,10 @@ constexpr const char* tvm_set_device = "__tvm_set_device";
 constexpr const char* tvm_global_barrier_state = "__tvm_global_barrier_state";
 /*! \brief Prepare the global barrier before kernels that uses global barrier. */
 constexpr const char* tvm_prepare_global_barrier = "__tvm_prepare_global_barrier";
+/*! \brief The counters of the regions instrumented by the lightweight profiler in a device. */
+constexpr const char* tvm_lwp_counters = "__tvm_lwp_counters";
+/*! \brief Read, and optionally reset, the lightweight profiler counters of a device module. */
+constexpr const char* tvm_lwp_read_counters = "__tvm_lwp_read_counters";
 /*! \brief Placeholder for the module's entry function. */
 constexpr const char* tvm_module_main = "__tvm_main__";
 /*! \brief Prefix for parameter symbols emitted into the main program. */
@@ -79,6 +79,9 @@ class PackedFuncObj : public Object {
   TVM_DECLARE_FINAL_OBJECT_INFO(PackedFuncObj, Object);
 
  protected:
+  template <typename FType>
+  friend class TypedPackedFunc;
+
   /*!
    * \brief Internal struct for extracting the callable method from callable type.
    */
@@ -107,6 +110,21 @@ class PackedFuncObj : public Object {
 
   /*! \brief Internal callable function pointer used to call the packed function. */
   FCallPacked* f_call_packed_;
+
+  /*! \brief The type-erased function type of the direct typed call. */
+  using FCallTyped = void();
+
+  /*!
+   * \brief Key of the C++ signature accepted by f_call_typed_, nullptr if the function can only
+   *  be called in packed format.
+   */
+  const void* typed_signature_{nullptr};
+
+  /*!
+   * \brief Internal function pointer used by TypedPackedFunc callers of the same signature to
+   *  call the function without packing the arguments.
+   */
+  FCallTyped* f_call_typed_{nullptr};
 };
 
 /*! \brief Derived object class for constructing PackedFuncObj. */
@@ -1722,34 +1740,102 @@ template <typename R, typename... Args>
 TypedPackedFunc<R(Args...)>::TypedPackedFunc(TVMMovableArgValueWithContext_&& value)
     : packed_(value.operator PackedFunc()) {}
 
+namespace detail {
+/*! \brief Unique address identifying a C++ function signature. */
+template <typename FSignature>
+struct TypedSignatureKey {
+  static const char value;
+};
+
+template <typename FSignature>
+const char TypedSignatureKey<FSignature>::value = 0;
+
+/*!
+ * \brief PackedFuncObj backed by a typed lambda.
+ *
+ *  Besides the packed calling convention, the lambda can be called directly by TypedPackedFunc
+ *  callers of the same signature, which skips packing and type checking the arguments.
+ */
+template <typename FLambda, typename R, typename... Args>
+class TypedLambdaObj : public PackedFuncObj {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param flambda The typed lambda.
+   * \param name The name of the lambda, nullptr if it is anonymous.
+   * \param f_sig The printer of the lambda signature.
+   */
+  TypedLambdaObj(FLambda flambda, const std::string* name, FSig* f_sig)
+      : PackedFuncObj(PackedCall),
+        flambda_(flambda),
+        name_(name ? *name : ""),
+        has_name_(name != nullptr),
+        f_sig_(f_sig) {
+    typed_signature_ = &TypedSignatureKey<R(Args...)>::value;
+    f_call_typed_ = reinterpret_cast<FCallTyped*>(&TypedCall);
+  }
+
+ private:
+  static void PackedCall(const PackedFuncObj* obj, TVMArgs args, TVMRetValue* rv) {
+    const TypedLambdaObj* self = static_cast<const TypedLambdaObj*>(obj);
+    if (args.size() != sizeof...(Args)) {
+      if (self->has_name_) {
+        LOG(FATAL) << "Function " << self->name_
+                   << (self->f_sig_ == nullptr ? "" : (*self->f_sig_)()) << " expects "
+                   << sizeof...(Args) << " arguments, but " << args.size() << " were provided.";
+      } else {
+        LOG(FATAL) << "Function <anonymous> " << (*self->f_sig_)() << " expects "
+                   << sizeof...(Args) << " arguments, but " << args.size() << " were provided.";
+      }
+    }
+    unpack_call<R, sizeof...(Args)>(self->has_name_ ? &self->name_ : nullptr, self->flambda_,
+                                    args, rv);
+  }
+
+  static R TypedCall(const PackedFuncObj* obj, Args... args) {
+    const TypedLambdaObj* self = static_cast<const TypedLambdaObj*>(obj);
+    if constexpr (std::is_void<R>::value) {
+      self->flambda_(std::forward<Args>(args)...);
+    } else {
+      return self->flambda_(std::forward<Args>(args)...);
+    }
+  }
+
+  /*! \brief The typed lambda. */
+  FLambda flambda_;
+  /*! \brief The name of the lambda. */
+  std::string name_;
+  /*! \brief Whether the lambda has a name. */
+  bool has_name_;
+  /*! \brief The printer of the lambda signature. */
+  FSig* f_sig_;
+};
+}  // namespace detail
+
 template <typename R, typename... Args>
 template <typename FType>
 inline void TypedPackedFunc<R(Args...)>::AssignTypedLambda(FType flambda, std::string name) {
   FSig* f_sig = detail::SignaturePrinter<detail::function_signature<FType>>::F;
-  packed_ = PackedFunc([flambda, name, f_sig](const TVMArgs& args, TVMRetValue* rv) {
-    if (args.size() != sizeof...(Args)) {
-      LOG(FATAL) << "Function " << name << (f_sig == nullptr ? "" : (*f_sig)()) << " expects "
-                 << sizeof...(Args) << " arguments, but " << args.size() << " were provided.";
-    }
-    detail::unpack_call<R, sizeof...(Args)>(&name, flambda, args, rv);
-  });
+  using ObjType = detail::TypedLambdaObj<FType, R, Args...>;
+  packed_ = PackedFunc(make_object<ObjType>(flambda, &name, f_sig));
 }
 
 template <typename R, typename... Args>
 template <typename FType>
 inline void TypedPackedFunc<R(Args...)>::AssignTypedLambda(FType flambda) {
   FSig* f_sig = detail::SignaturePrinter<detail::function_signature<FType>>::F;
-  packed_ = PackedFunc([flambda, f_sig](const TVMArgs& args, TVMRetValue* rv) {
-    if (args.size() != sizeof...(Args)) {
-      LOG(FATAL) << "Function <anonymous> " << (*f_sig)() << " expects " << sizeof...(Args)
-                 << " arguments, but " << args.size() << " were provided.";
-    }
-    detail::unpack_call<R, sizeof...(Args)>(nullptr, flambda, args, rv);
-  });
+  using ObjType = detail::TypedLambdaObj<FType, R, Args...>;
+  packed_ = PackedFunc(make_object<ObjType>(flambda, nullptr, f_sig));
 }
 
 template <typename R, typename... Args>
 TVM_ALWAYS_INLINE R TypedPackedFunc<R(Args...)>::operator()(Args... args) const {
+  // Both sides are native C++ functions of the same signature, call the lambda directly.
+  const PackedFuncObj* obj = static_cast<const PackedFuncObj*>(packed_.get());
+  if (obj != nullptr && obj->typed_signature_ == &detail::TypedSignatureKey<R(Args...)>::value) {
+    using FCallTyped = R(const PackedFuncObj*, Args...);
+    return (*reinterpret_cast<FCallTyped*>(obj->f_call_typed_))(obj, std::forward<Args>(args)...);
+  }
   return detail::typed_packed_call_dispatcher<R>::run(packed_, std::forward<Args>(args)...);
 }
 
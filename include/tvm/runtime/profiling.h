@@ -251,6 +251,15 @@ class ReportNode : public Object {
    * \endcode
    */
   String AsJSON() const;
+  /*! \brief Convert the calls of this report to the Chrome trace event format, which can be
+   * opened in chrome://tracing or https://ui.perfetto.dev.
+   *
+   * Each call becomes a complete event on the track of its device, with the other metrics of the
+   * call as its arguments. Calls are placed at their "Start (us)" timestamp, as recorded by
+   * `CreateTimelineCollector`. Without timestamps the calls of each device are laid out back to
+   * back in order of appearance, which shows their durations but not the gaps between them.
+   */
+  String AsChromeTrace() const;
 
   static constexpr const char* _type_key = "runtime.profiling.Report";
   TVM_DECLARE_FINAL_OBJECT_INFO(ReportNode, Object);
@@ -537,6 +546,20 @@ String ShapeString(const std::vector<int64_t>& shape, DLDataType dtype);
 PackedFunc ProfileFunction(Module mod, std::string func_name, int device_type, int device_id,
                            int warmup_iters, Array<MetricCollector> collectors);
 
+/*! \brief Create a MetricCollector which records when each call starts and ends.
+ *
+ * The "Start (us)" and "End (us)" metrics of a call are the host timestamps, relative to the
+ * start of the first call, at which the call was launched and returned. They place the calls on
+ * the timeline exported by `ReportNode::AsChromeTrace`.
+ *
+ * \param sync Whether to synchronize the device before taking each timestamp. Without it the
+ *        timestamps of asynchronous devices are the launch times of the calls, which shows the
+ *        host overhead and how far the host runs ahead of the device. With it they are the times
+ *        the device ran the calls, at the price of serializing the host and the device.
+ * \returns The collector.
+ */
+MetricCollector CreateTimelineCollector(bool sync);
+
 /*!
  * \brief Wrap a timer function to measure the time cost of a given packed function.
  *
@@ -587,6 +610,24 @@ PackedFunc WrapTimeEvaluator(PackedFunc f, Device dev, int number, int repeat, i
                              int limit_zero_time_iterations, int cooldown_interval_ms,
                              int repeats_to_cooldown, PackedFunc f_preproc = nullptr);
 
+/*!
+ * \brief Collect the timings of the loops and functions instrumented with
+ *        the `tir.instrument_lwp` pass configuration.
+ *
+ * Every instrumented region gets a call named `lwp_<id>`, where `id` is the
+ * one InstrumentProfileIntrinsics assigned to it. The CPU calls sum the
+ * events of all the threads, and report the total duration of the region.
+ * The calls of a device, e.g. CUDA, sum the cycles of all the threads running
+ * the region, and report the mean duration of one execution by a thread.
+ *
+ * Nothing instrumented may run while the report is collected.
+ *
+ * \param mod The module whose device counters to read, along with the ones of its imports.
+ * \param reset Whether to clear the events and the counters once read.
+ * \return The report, with one call per instrumented region.
+ */
+Report LWPReport(Optional<Module> mod, bool reset);
+
 }  // namespace profiling
 }  // namespace runtime
 }  // namespace tvm
@@ -140,6 +140,108 @@ void ResetThreadPool();
 TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode, int nthreads,
                        std::vector<unsigned int> cpus);
 
+/*!
+ * \brief Configure the work stealing mode of the thread pool.
+ * \param chunks_per_worker The number of tasks per worker a parallel job whose number
+ *  of tasks is decided by the runtime is split into, 0 disables work stealing.
+ *
+ * Note that this does nothing when openmp is used.
+ */
+void ConfigureWorkStealing(int chunks_per_worker);
+
+/*!
+ * \brief Configure whether parallel jobs launched from inside a parallel task share the
+ *  idle workers of the thread pool instead of running inline on the launching worker.
+ * \param nested Whether to enable nested parallelism.
+ *
+ * Note that this does nothing when openmp is used.
+ */
+void ConfigureNestedParallelism(bool nested);
+
+/*! \brief How the idle workers of a thread pool wait for the next parallel job. */
+enum WaitPolicy : int {
+  /*! \brief Spin yielding the core for a number of iterations, then sleep. */
+  kWaitYield = 0,
+  /*! \brief Spin without yielding the core for a number of iterations, then sleep. */
+  kWaitSpin = 1,
+  /*! \brief Sleep as soon as there is no job. */
+  kWaitSleep = 2,
+  /*!
+   * \brief Spin yielding the core while the gap observed between the parallel jobs is
+   *  short, sleep right away otherwise.
+   */
+  kWaitAdaptive = 3,
+};
+
+/*!
+ * \brief Configure how the workers of the thread pool of the calling thread wait for jobs.
+ *
+ * Latency critical models keep the workers spinning between operators, while models on
+ * shared hosts let them sleep. The pool is per calling thread, so models served from
+ * different threads can each use their own policy.
+ * \param policy The policy.
+ * \param spin_count The number of spin iterations before sleeping, -1 keeps the current
+ *  count, set by TVM_THREAD_POOL_SPIN_COUNT at first.
+ *
+ * Note that this does nothing when openmp is used.
+ */
+TVM_DLL void ConfigureWaitPolicy(WaitPolicy policy, int spin_count);
+
+/*!
+ * \brief Start the workers of the thread pool of the calling thread and wake them up with
+ *  an empty job, so that the first parallel job of a model does not pay for it.
+ *
+ * Note that this does nothing when openmp is used.
+ */
+TVM_DLL void WarmUpThreadPool();
+
+/*!
+ * \brief The number of NUMA nodes of the system, 1 when the topology is unknown.
+ */
+int NumNumaNodes();
+
+/*!
+ * \brief The CPUs of a NUMA node.
+ * \param node The index of the node, below NumNumaNodes().
+ * \return The ids of the CPUs, all the CPUs when the topology is unknown.
+ */
+std::vector<unsigned int> NumaNodeCPUs(int node);
+
+/*!
+ * \brief The NUMA node the CPU allocations of the calling thread are placed on.
+ * \return The node set by ConfigureNumaNode, -1 to let the system decide.
+ */
+int CurrentNumaNode();
+
+/*!
+ * \brief Set the NUMA node the CPU allocations of the calling thread are placed on.
+ * \param node The node, -1 to let the system decide.
+ */
+void SetCurrentNumaNode(int node);
+
+/*!
+ * \brief Place a CPU allocation on the pages of a NUMA node.
+ *
+ * Only the whole pages of the range are bound, and only on Linux. The policy is a
+ * preference, so the allocation still succeeds when the node is out of memory.
+ * \param ptr The start of the allocation.
+ * \param nbytes The size of the allocation.
+ * \param node The node.
+ */
+void BindMemoryToNumaNode(void* ptr, size_t nbytes, int node);
+
+/*!
+ * \brief Bind the thread pool of the calling thread to a NUMA node.
+ *
+ * The thread pool of the TVM runtime is per calling thread, so several model instances
+ * run from different threads of one process each get their own workers. Binding each of
+ * those threads to a different node gives the instances disjoint cores, and places the
+ * activations and workspaces they allocate afterwards in the memory of their node.
+ * \param node The index of the node, below NumNumaNodes().
+ * \param nthreads The number of threads to use (0 = one per CPU of the node).
+ */
+TVM_DLL void ConfigureNumaNode(int node, int nthreads);
+
 /*!
  * \brief Get the number of threads being used by the TVM runtime
  * \returns The number of threads used.
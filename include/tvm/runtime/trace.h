@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/trace.h
+ * \brief Tracepoints on the hot paths of the runtime.
+ *
+ * A tracepoint costs one relaxed load and a predicted branch while tracing is disabled. When it
+ * is enabled with runtime.profiling.EnableTracepoints, every hit appends a fixed size record to
+ * a ring buffer, which runtime.profiling.DumpTracepoints exports as a Chrome trace.
+ *
+ * When the runtime is built with USE_USDT, each tracepoint is also a USDT probe in the "tvm"
+ * provider, e.g. tvm:VMInstruction, which bpftrace or perf can attach to without enabling the
+ * ring buffer.
+ */
+#ifndef TVM_RUNTIME_TRACE_H_
+#define TVM_RUNTIME_TRACE_H_
+
+#include <tvm/runtime/c_runtime_api.h>
+
+#include <atomic>
+#include <cstdint>
+
+#if TVM_USE_USDT
+#include <sys/sdt.h>
+#define TVM_TRACE_USDT(name, a0, a1) DTRACE_PROBE2(tvm, name, a0, a1)
+#else
+#define TVM_TRACE_USDT(name, a0, a1)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_TRACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define TVM_TRACE_UNLIKELY(x) (x)
+#endif
+
+namespace tvm {
+namespace runtime {
+namespace trace {
+
+/*! \brief The tracepoints, the meaning of the two arguments of each is given alongside. */
+enum TraceEvent : int32_t {
+  /*! \brief A device kernel launch: (number of blocks, threads per block). */
+  kKernelLaunch = 0,
+  /*! \brief A device allocation: (bytes, device type). */
+  kAlloc = 1,
+  /*! \brief A device free: (bytes, device type). */
+  kFree = 2,
+  /*! \brief A tensor copy: (bytes, device type of the non-CPU side). */
+  kCopy = 3,
+  /*! \brief A VM instruction about to execute: (opcode, pc). */
+  kVMInstruction = 4,
+  /*! \brief A parallel launch on the thread pool: (number of tasks, 0). */
+  kParallelLaunch = 5,
+  /*! \brief An RPC packet handled by an endpoint: (RPC code, 0). */
+  kRPCMessage = 6,
+};
+
+/*! \brief Whether the ring buffer is recording, read by every tracepoint. */
+TVM_DLL extern std::atomic<bool> enabled;
+
+/*!
+ * \brief Append a record to the ring buffer. Only called by TVM_TRACE when enabled.
+ * \param event The tracepoint.
+ * \param a0 The first argument of the tracepoint.
+ * \param a1 The second argument of the tracepoint.
+ */
+TVM_DLL void Record(TraceEvent event, int64_t a0, int64_t a1);
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace tvm
+
+/*!
+ * \brief Hit the tracepoint name with two integer arguments.
+ * \param name The TraceEvent without its k prefix, e.g. VMInstruction.
+ */
+#define TVM_TRACE(name, a0, a1)                                                       \
+  do {                                                                                \
+    TVM_TRACE_USDT(name, a0, a1);                                                     \
+    if (TVM_TRACE_UNLIKELY(                                                           \
+            ::tvm::runtime::trace::enabled.load(std::memory_order_relaxed))) {        \
+      ::tvm::runtime::trace::Record(::tvm::runtime::trace::k##name,                   \
+                                    static_cast<int64_t>(a0), static_cast<int64_t>(a1)); \
+    }                                                                                 \
+  } while (0)
+
+#endif  // TVM_RUNTIME_TRACE_H_
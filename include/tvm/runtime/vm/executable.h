@@ -32,16 +32,26 @@
 #include <tvm/runtime/vm/bytecode.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace tvm {
 namespace runtime {
+
+class MappedFile;
+
 namespace vm {
 
 struct VMFunction;
 
+/*!
+ * \brief The key of Executable::op_attrs marking a primitive as the shape function
+ * of a dynamically shaped operator.
+ */
+constexpr const char* kShapeFuncAttr = "vm_shape_func";
+
 /*!
  * \brief The executable emitted by the VM compiler.
  *
@@ -113,6 +123,32 @@ class TVM_DLL Executable : public ModuleNode {
    */
   static runtime::Module Load(const std::string& code, const runtime::Module lib);
 
+  /*!
+   * \brief Save the executable to a file whose constants can be memory mapped.
+   *
+   * The serialized executable is followed by a page aligned data region holding
+   * the contents of the immediate constants, each aligned to kAllocAlignment, so
+   * that \p LoadFromMmapFile can wrap them in place instead of reading them.
+   * Late-bound constants (if any) must have already been moved out.
+   *
+   * \param path The path to write the executable to.
+   */
+  void SaveToMmapFile(const std::string& path);
+
+  /*!
+   * \brief Load an executable saved by \p SaveToMmapFile.
+   *
+   * The file is mapped copy-on-write and the constants become CPU NDArrays over
+   * the mapping, so they are paged in lazily and shared with every other process
+   * mapping the same file. The mapping is released with the last constant.
+   *
+   * \param path The path to load the executable from.
+   * \param lib The compiled runtime library.
+   *
+   * \return exe The constructed executable.
+   */
+  static runtime::Module LoadFromMmapFile(const std::string& path, const runtime::Module lib);
+
   /*!
    * \brief Returns the late-bound constants for the executable (if any) as a byte-stream.
    * Leaves the executable's late-bound constants map empty. Only constants who's byte
@@ -152,6 +188,9 @@ class TVM_DLL Executable : public ModuleNode {
 
   /*!
    * \brief As for \p LoadLateBoundConstantsFromStream, but load from file at \p path.
+   *
+   * A file written by \p SaveParamsMmap is memory mapped instead, and the constants
+   * become views over the mapping.
    */
   void LoadLateBoundConstantsFromFile(const std::string& path);
 
@@ -367,8 +406,28 @@ class TVM_DLL Executable : public ModuleNode {
    */
   void LoadCodeSection(dmlc::Stream* strm);
 
+  /*!
+   * \brief Load the executable from its serialized bytecode.
+   *
+   * \param code The bytecode in string.
+   * \param lib The compiled runtime library.
+   * \param mapped_file The file holding the data region of mapped constants, if any.
+   * \param data_offset The offset of the data region in \p mapped_file.
+   */
+  static runtime::Module Load(const std::string& code, const runtime::Module lib,
+                              std::shared_ptr<MappedFile> mapped_file, size_t data_offset);
+
   /*! \brief The serialized bytecode. */
   std::string code_;
+  /*!
+   * \brief The offset of each immediate constant in the data region while saving
+   * to a mappable file, empty otherwise.
+   */
+  std::vector<uint64_t> mapped_const_offsets_;
+  /*! \brief The mapped file constants are loaded from, only set while loading. */
+  std::shared_ptr<MappedFile> mapped_file_;
+  /*! \brief The offset of the data region in mapped_file_. */
+  size_t mapped_data_offset_{0};
 };
 
 }  // namespace vm
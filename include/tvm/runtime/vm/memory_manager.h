@@ -32,6 +32,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -50,6 +51,8 @@ struct Buffer {
 enum AllocatorType {
   kNaive = 1,
   kPooled,
+  kSizeClass,
+  kStreamOrdered,
 };
 
 class Allocator {
@@ -65,6 +68,8 @@ class Allocator {
   NDArray Empty(std::vector<int64_t> shape, DLDataType dtype, Device dev);
   /*! \brief Return the allocator type. */
   inline AllocatorType type() const { return type_; }
+  /*! \brief The owner name the allocator records its device memory with in MemoryStats. */
+  const char* name() const;
   /*! \brief Allocate a buffer given a size, alignment and type.
    *  \param nbytes The size of the buffer.
    *  \param alignment The alignment of the buffer.
@@ -80,6 +85,10 @@ class Allocator {
    *  \return The amount of memory currently allocated.
    */
   virtual size_t UsedMemory() const = 0;
+  /*! \brief The amount of memory allocated from the device but cached free by the allocator.
+   *  \return The amount of memory cached for reuse.
+   */
+  virtual size_t CachedMemory() const { return 0; }
 
  private:
   AllocatorType type_;
@@ -101,6 +110,11 @@ class MemoryManager {
    * \return The memory allocator.
    */
   static Allocator* GetAllocator(Device dev);
+  /*!
+   * \brief List the allocators created so far.
+   * \return The allocators along with their devices.
+   */
+  static std::vector<std::pair<Device, Allocator*>> ListAllocators();
 
  private:
   MemoryManager() {}
@@ -25,6 +25,7 @@
 #define TVM_RUNTIME_VM_VM_H_
 
 #include <tvm/runtime/container/closure.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
@@ -33,8 +34,10 @@
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -119,7 +122,12 @@ struct VMFrame {
   /*! \brief A pointer into the caller function's instructions. */
   const Instruction* code;
 
-  /*! \brief Statically allocated space for objects */
+  /*!
+   * \brief Statically allocated space for objects.
+   *
+   * Frames are recycled by the VM, so the capacity of the vector may exceed the
+   * register file size of the function the frame currently belongs to.
+   */
   std::vector<ObjectRef> register_file;
 
   /*! \brief Register in caller's frame to put return value */
@@ -166,7 +174,7 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    */
   virtual PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self);
 
-  virtual ~VirtualMachine() {}
+  virtual ~VirtualMachine();
 
   const char* type_key() const final { return "VirtualMachine"; }
 
@@ -178,6 +186,39 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    */
   virtual void LoadExecutable(const ObjectPtr<Executable>& exec);
 
+  /*!
+   * \brief Defer the lookup of each primitive in the kernel library to its first call.
+   *
+   * Must be set before LoadExecutable. A primitive missing from the library is then
+   * only reported when it is called.
+   *
+   * \param lazy Whether to resolve the primitives lazily.
+   */
+  void SetLazyPrimitives(bool lazy) { lazy_primitives_ = lazy; }
+
+  /*!
+   * \brief Resolve the primitives not called yet on background threads.
+   *
+   * Only useful with lazy primitives, the VM keeps running meanwhile and resolves
+   * a primitive itself if it is called before its turn comes.
+   *
+   * \param num_threads The number of threads looking up primitives. The library
+   *  must support concurrent GetFunction calls for more than one thread, as DSO
+   *  libraries do.
+   */
+  void PrewarmPrimitives(int num_threads);
+
+  /*!
+   * \brief Create a VM running the same executable on the same devices, for another thread.
+   *
+   * The clone shares the executable, the primitives resolved so far, the allocators and
+   * the constants already copied to the devices, so nothing is loaded again. Its inputs,
+   * outputs, frames and streams are its own. Must not be called while this VM is running.
+   *
+   * \return The new VM.
+   */
+  ObjectPtr<VirtualMachine> Clone() const;
+
   /*! \brief Get the property of the runtime module .*/
   int GetPropertyMask() const final { return ModulePropertyMask::kRunnable; }
 
@@ -275,6 +316,21 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    */
   void InvokeGlobal(const VMFunction& func, const std::vector<ObjectRef>& args);
 
+  /*!
+   * \brief Invoke a global with arguments read from the registers of the current frame.
+   *
+   * Unlike InvokeGlobal, the arguments are moved straight from the caller's register
+   * file into the callee's, so that a call does not allocate in steady state.
+   *
+   * \param func The function to invoke.
+   * \param free_vars The captured variables passed before the arguments, if any.
+   * \param arg_registers The caller registers holding the arguments.
+   * \param num_args The number of argument registers.
+   * \param dst The caller register to write the return value to.
+   */
+  void InvokeGlobalFromRegisters(const VMFunction& func, const std::vector<ObjectRef>* free_vars,
+                                 const RegName* arg_registers, Index num_args, RegName dst);
+
   /*!
    * \brief Set inputs to a function.
    * \param name The function name
@@ -305,6 +361,71 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    */
   void SetOutputs(std::string name, TVMArgs args);
 
+  /*!
+   * \brief Start streaming chunks through a function written in the stateful-chunk style.
+   *
+   * The function takes the inputs of a chunk followed by the states, and returns a tuple of
+   * its outputs followed by the new states. The states stay on the device between chunks.
+   * With reuse_outputs, the outputs and new states of a chunk are written into the buffers
+   * of the chunk before the last one whenever the inputs keep their shapes, so a stream
+   * allocates no new tensors in steady state. This requires every field of the returned
+   * tuple to be a tensor allocated by the function, and makes the outputs of a chunk valid
+   * until the next chunk only.
+   * \param name The function name.
+   * \param args args[offset] is reuse_outputs and args[offset + 1:] are the initial states,
+   *  which are copied.
+   * \param offset Starting offset of the arguments in `args`.
+   */
+  void BeginStream(std::string name, TVMArgs args, int offset);
+
+  /*!
+   * \brief Run the next chunk of a stream started with BeginStream.
+   * \param name The function name.
+   * \param args args[offset:] are the inputs of the chunk.
+   * \param offset Starting offset of the arguments in `args`.
+   * \return The outputs of the chunk, a tensor when there is only one.
+   */
+  ObjectRef RunStreamChunk(std::string name, TVMArgs args, int offset);
+
+  /*!
+   * \brief End a stream and release its buffers.
+   * \param name The function name.
+   * \return The states after the last chunk.
+   */
+  ObjectRef EndStream(std::string name);
+
+  /*!
+   * \brief Enable or disable the memoization of shape functions.
+   *
+   * When enabled, the outputs of every shape function call are cached keyed by the
+   * contents of its (host) inputs, and a later call with the same inputs copies the
+   * cached shapes instead of invoking the function. Disabling clears the cache.
+   *
+   * \param enable Whether to memoize shape functions.
+   */
+  void SetShapeFuncMemo(bool enable);
+
+  /*!
+   * \brief Set the number of streams kernels are dispatched to.
+   *
+   * With more than one stream, every kernel whose arguments all live on the same
+   * non-CPU device is issued on one of a pool of streams of that device. The streams
+   * are chosen from the buffers the kernels read and write, so that kernels touching
+   * disjoint memory, e.g. independent branches of the model, run concurrently, while
+   * dependent kernels are ordered by staying on one stream or through events.
+   *
+   * \param num_streams The size of the stream pool, 1 issues everything on the
+   *  default stream.
+   */
+  void SetNumStreams(int num_streams);
+
+  /*!
+   * \brief Make the default stream wait for the kernels in flight on the stream pool.
+   *
+   * Called before the host or the default stream access memory the kernels may use.
+   */
+  void SyncStreams() const;
+
   /*!
    * \brief Preparation part of Invoke method before RunLoop.
    * \param func the function.
@@ -329,13 +450,21 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    *
    * \param instr Instruction that will be executed after this hook fires
    */
-  virtual void OpStartHook(Instruction instr);
+  virtual void OpStartHook(const Instruction& instr);
 
   /*!
    * \brief Internal hook for profiling the end of an op.
    */
   virtual void OpStopHook();
 
+  /*!
+   * \brief Whether RunLoop should call OpStartHook and OpStopHook.
+   *
+   * Set by subclasses which override the hooks, so that the plain VM does not
+   * pay for a virtual call around every costly instruction.
+   */
+  bool op_hooks_enabled_{false};
+
  private:
   /*!
    * \brief Get index of input tensor from its name.
@@ -422,11 +551,59 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
 
   bool FindIndex(const std::vector<Index>& indices, Index val) const;
 
+  /*!
+   * \brief Get the packed function at an index, resolving it on first use.
+   * \param packed_index The index of the packed function.
+   * \return The packed function.
+   */
+  inline const PackedFunc& GetPackedFunc(Index packed_index);
+
+  /*!
+   * \brief Look up the packed function at an index in the kernel library.
+   * \param packed_index The index of the packed function.
+   * \param wait Whether to wait for another thread resolving the function, and to fail if
+   *  it is missing from the library.
+   * \return Whether the function is resolved.
+   */
+  bool ResolvePackedFunc(Index packed_index, bool wait);
+
+  /*! \brief Stop and join the prewarming threads. */
+  void StopPrewarm();
+
  protected:
-  /*! \brief The virtual machine's packed function table. */
+  /*!
+   * \brief The virtual machine's packed function table.
+   *
+   * An entry is only valid once its packed_func_states_ is kResolved, use
+   * GetPackedFunc to read it.
+   */
   std::vector<PackedFunc> packed_funcs_;
-  /*! \brief The current stack of call frames. */
+  /*! \brief The names of the packed functions in the kernel library. */
+  std::vector<std::string> packed_func_names_;
+  /*!
+   * \brief Whether each packed function is unresolved, being resolved or resolved.
+   *
+   * The state is published with release semantics once the function is written, so
+   * that reading a resolved function only costs an acquire load.
+   */
+  std::unique_ptr<std::atomic<int>[]> packed_func_states_;
+  /*! \brief Whether primitives are resolved on first use rather than on load. */
+  bool lazy_primitives_{false};
+  /*! \brief The threads resolving primitives in the background. */
+  std::vector<std::thread> prewarm_threads_;
+  /*! \brief The next packed function to be resolved by a prewarming thread. */
+  std::atomic<size_t> next_prewarm_{0};
+  std::atomic<bool> stop_prewarm_{false};
+  /*!
+   * \brief The current stack of call frames.
+   *
+   * Only the first num_frames_ entries are live. The frames above them are kept,
+   * with their registers cleared, so that their register files can be reused by
+   * the next calls instead of being allocated again.
+   */
   std::vector<VMFrame> frames_;
+  /*! \brief The depth of the call stack. */
+  size_t num_frames_{0};
   /*! \brief The fuction table index of the current function. */
   Index func_index_;
   /*! \brief The current pointer to the code section. */
@@ -447,6 +624,19 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
   std::unordered_map<std::string, std::vector<Index>> output_tensor_reg_indices_;
   /*! \brief The function name to pre-allocated outputs mapping. */
   std::unordered_map<std::string, std::vector<ObjectRef>> outputs_;
+  /*! \brief A stream of chunks run through a stateful function, see BeginStream. */
+  struct ChunkStream {
+    /*! \brief The states the next chunk reads. */
+    std::vector<ObjectRef> states;
+    /*! \brief The buffers the next chunk writes its outputs and new states into, if any. */
+    std::vector<ObjectRef> spare;
+    /*! \brief The shapes of the inputs of the last chunk. */
+    std::vector<ShapeTuple> input_shapes;
+    /*! \brief Whether the buffers of the chunk before the last one are reused. */
+    bool reuse_outputs;
+  };
+  /*! \brief The function name to active stream mapping. */
+  std::unordered_map<std::string, ChunkStream> chunk_streams_;
   /*!
    * \brief The "physical" devices the VM can execute primitives on. All "device indexes"
    * are w.r.t. this vector. Each entry in this vector must match the corresponding entry
@@ -460,6 +650,53 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    * object to avoid rellocation of constants during inference.
    */
   std::vector<ObjectRef> const_pool_;
+  /*!
+   * \brief Scratch buffers for the arguments of InvokePacked. Packed calls do not
+   * nest, so they are shared by all frames and only grow to the largest arity seen.
+   */
+  std::vector<ObjectRef> packed_args_;
+  std::vector<TVMValue> packed_values_;
+  std::vector<int> packed_codes_;
+  /*! \brief Whether the packed function at each index is a shape function. */
+  std::vector<bool> is_shape_func_;
+  /*! \brief Whether shape function results are memoized. */
+  bool shape_func_memo_enabled_{false};
+  /*! \brief The memoized outputs of shape functions, keyed by function and input contents. */
+  std::unordered_map<std::string, std::vector<NDArray>> shape_func_memo_;
+
+ private:
+  /*!
+   * \brief Pick the stream of the pool a kernel should be issued on.
+   * \param values The flattened kernel arguments.
+   * \param num_inputs The number of arguments read by the kernel, the others are written.
+   * \param arity The number of arguments.
+   * \param dev The device of the arguments.
+   * \return The index of the stream, -1 to run the kernel as usual.
+   */
+  int AssignStream(const TVMValue* values, size_t num_inputs, size_t arity, Device* dev);
+
+  /*! \brief A memory range accessed by a kernel in flight on the stream pool. */
+  struct StreamAccess {
+    uintptr_t begin;
+    uintptr_t end;
+    bool write;
+    int stream;
+  };
+  /*! \brief The size of the stream pool. */
+  int num_streams_{1};
+  /*! \brief The device of the stream pool. */
+  Device stream_device_{kDLCPU, 0};
+  /*! \brief The stream pool, created lazily. */
+  std::vector<TVMStreamHandle> streams_;
+  /*!
+   * \brief Whether each stream must wait for the default stream before its next kernel,
+   * and the accesses of the kernels issued since the last SyncStreams. Synchronizing does
+   * not change the observable state of the VM, so they are updated by const methods.
+   */
+  mutable std::vector<bool> stream_stale_;
+  mutable std::vector<StreamAccess> stream_accesses_;
+  /*! \brief The stream the next independent kernel is issued on. */
+  size_t next_stream_{0};
 };
 
 }  // namespace vm
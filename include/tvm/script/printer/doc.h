@@ -23,6 +23,7 @@
 #include <tvm/node/node.h>
 #include <tvm/runtime/data_type.h>
 
+#include <ostream>
 #include <string>
 
 namespace tvm {
@@ -39,6 +40,14 @@ class Doc;
  */
 String DocToPythonScript(Doc doc, const PrinterConfig& cfg);
 
+/*!
+ * \brief Convert Doc into Python script, written to a stream as it is printed.
+ * \param doc Doc to be converted
+ * \param cfg The configuration of the printer
+ * \param os The stream to write to
+ */
+void DocToPythonScript(Doc doc, const PrinterConfig& cfg, std::ostream* os);
+
 /*!
  * \brief The base class of all Doc.
  *
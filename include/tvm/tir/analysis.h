@@ -208,6 +208,15 @@ TVM_DLL bool VerifyVTCMLimit(const IRModule& mod, Integer limit);
  */
 TVM_DLL bool VerifyVTCMLimit(const PrimFunc& func, Integer limit);
 
+/*!
+ * \brief Get the number of bytes of VTCM available to a function.
+ * \param target The target of the function, the current target is used when undefined.
+ * \param pass_ctx The pass context, whose tir.vtcm_capacity is used when the target has no
+ *  vtcm-capacity.
+ * \return The capacity in bytes, 0 when unknown.
+ */
+TVM_DLL int64_t GetVTCMCapacity(Target target, const transform::PassContext& pass_ctx);
+
 /*!
  * \brief Auto detect the block access region according to its body stmt
  *        It will detect the access region as an array in order of appearance in AST
@@ -663,6 +663,35 @@ TVM_DLL const Op& ptx_cp_async();
 TVM_DLL const Op& ptx_commit_group();
 TVM_DLL const Op& ptx_wait_group();
 
+/*!
+ * \brief tvm intrinsic for ptx bulk async copy from global to shared memory, available
+ *  from sm_90. The copy signals its completion on the mbarrier `barrier_id`.
+ *
+ * void ptx_cp_async_bulk(Var shared_ptr, Expr shared_offset, Var global_ptr, Expr global_offset,
+ *                        Expr bytes, Expr barrier_id);
+ *
+ */
+TVM_DLL const Op& ptx_cp_async_bulk();
+
+/*!
+ * \brief tvm intrinsics for the mbarriers synchronizing bulk async copies.
+ *
+ * void create_barriers(int barrier_count);
+ * void ptx_init_barrier_thread_count(Expr barrier_id, Expr thread_count);
+ * void ptx_arrive_barrier_expect_tx(Expr barrier_id, Expr byte_count);
+ * void ptx_wait_barrier(Expr barrier_id);
+ * void ptx_inval_barrier(Expr barrier_id);
+ *
+ * create_barriers declares the array of barriers of the kernel in shared memory, the other
+ * intrinsics refer to its elements by index. ptx_wait_barrier waits for the first phase of
+ * the barrier to complete, the barrier is then invalidated before being initialized again.
+ */
+TVM_DLL const Op& create_barriers();
+TVM_DLL const Op& ptx_init_barrier_thread_count();
+TVM_DLL const Op& ptx_arrive_barrier_expect_tx();
+TVM_DLL const Op& ptx_wait_barrier();
+TVM_DLL const Op& ptx_inval_barrier();
+
 /*!
  * \brief tvm intrinsic for storing the result of PTX MMA into a destination pointer.
  *        For example, if each thread in a warp of size 32 has 4 elements from the result of
@@ -352,6 +352,22 @@ constexpr const char* kIsGlobalFunc = "tir.is_global_func";
  */
 constexpr const char* kIsHostFunc = "tir.is_host_func";
 
+/*!
+ * \brief Maximum number of loop variants LoopPartition may generate in the function,
+ *  overriding the max_variants of the tir.LoopPartition config.
+ *
+ * Type: Integer
+ */
+constexpr const char* kLoopPartitionMaxVariants = "tir.loop_partition_max_variants";
+
+/*!
+ * \brief Maximum estimated code size of the function after LoopPartition,
+ *  overriding the max_code_size of the tir.LoopPartition config.
+ *
+ * Type: Integer
+ */
+constexpr const char* kLoopPartitionMaxCodeSize = "tir.loop_partition_max_code_size";
+
 }  // namespace attr
 }  // namespace tir
 }  // namespace tvm
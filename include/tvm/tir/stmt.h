@@ -231,23 +231,30 @@ class BufferStoreNode : public StmtNode {
   PrimExpr value;
   /*! \brief The indices location to be stored. */
   Array<PrimExpr> indices;
+  /*!
+   * \brief The boolean mask of the lanes to store, with as many lanes as the value.
+   *  Masked off lanes are not accessed. All the lanes are stored when not defined.
+   */
+  Optional<PrimExpr> predicate;
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("buffer", &buffer);
     v->Visit("value", &value);
     v->Visit("indices", &indices);
+    v->Visit("predicate", &predicate);
     v->Visit("span", &span);
   }
 
   bool SEqualReduce(const BufferStoreNode* other, SEqualReducer equal) const {
     return equal(buffer, other->buffer) && equal(value, other->value) &&
-           equal(indices, other->indices);
+           equal(indices, other->indices) && equal(predicate, other->predicate);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
     hash_reduce(buffer);
     hash_reduce(value);
     hash_reduce(indices);
+    hash_reduce(predicate);
   }
 
   static constexpr const char* _type_key = "tir.BufferStore";
@@ -261,7 +268,7 @@ class BufferStoreNode : public StmtNode {
 class BufferStore : public Stmt {
  public:
   TVM_DLL explicit BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
-                               Span span = Span());
+                               Optional<PrimExpr> predicate = NullOpt, Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(BufferStore, Stmt, BufferStoreNode);
   TVM_DEFINE_OBJECT_REF_COW_METHOD(BufferStoreNode);
@@ -1422,6 +1429,10 @@ constexpr const char* loop_scope = "loop_scope";
 constexpr const char* reduce_scope = "reduce_scope";
 /*! \brief Pragma: auto-unroll, max_step */
 constexpr const char* pragma_auto_unroll_max_step = "pragma_auto_unroll_max_step";
+/*! \brief Pragma: auto-unroll, max estimated number of registers */
+constexpr const char* pragma_auto_unroll_max_registers = "pragma_auto_unroll_max_registers";
+/*! \brief Pragma: auto-unroll, max estimated number of instructions */
+constexpr const char* pragma_auto_unroll_max_code_size = "pragma_auto_unroll_max_code_size";
 /*! \brief Pragma: unroll explicit */
 constexpr const char* pragma_unroll_explicit = "pragma_unroll_explicit";
 /*! \brief Mark region is guarded by the pragma extension */
@@ -1559,6 +1570,31 @@ constexpr const char* script_parsing_detect_access = "tir.script_parsing_detect_
  */
 constexpr const char* pragma_loop_partition_hint = "pragma_loop_partition_hint";
 
+/*!
+ * \brief Mark the vectorization width that the LLVM loop vectorizer uses for a serial loop,
+ *  emitted as llvm.loop.vectorize.width.
+ */
+constexpr const char* llvm_loop_vectorize_width = "llvm_loop_vectorize_width";
+
+/*!
+ * \brief Mark that the LLVM loop vectorizer uses scalable vectors for a serial loop, e.g. SVE
+ *  on AArch64, emitted as llvm.loop.vectorize.scalable.enable. Combined with
+ *  llvm_loop_vectorize_width, the width is the minimum number of lanes, scaled by vscale.
+ */
+constexpr const char* llvm_loop_vectorize_scalable = "llvm_loop_vectorize_scalable";
+
+/*!
+ * \brief Mark the unroll count that LLVM uses for a serial loop, emitted as
+ *  llvm.loop.unroll.count.
+ */
+constexpr const char* llvm_loop_unroll_count = "llvm_loop_unroll_count";
+
+/*!
+ * \brief Mark the number of iterations ahead that the strided and gathered loads of a serial
+ *  loop are software prefetched in LLVM codegen.
+ */
+constexpr const char* llvm_loop_prefetch_distance = "llvm_loop_prefetch_distance";
+
 /*! \brief Mark the stage of a statement in the software pipeline */
 constexpr const char* software_pipeline_stage = "software_pipeline_stage";
 
@@ -1571,6 +1607,19 @@ constexpr const char* software_pipeline_order = "software_pipeline_order";
  */
 constexpr const char* software_pipeline_async_stages = "software_pipeline_async_stages";
 
+/*!
+ * \brief Mark the loop to be software pipelined with at most the given number of stages,
+ *  with the stage and order of each statement chosen by the pipeline injection.
+ */
+constexpr const char* software_pipeline_max_stages = "software_pipeline_max_stages";
+
+/*!
+ * \brief The number of bytes of shared memory the buffers of an automatically pipelined
+ *  loop may use, which bounds its number of stages. No bound is applied when absent.
+ */
+constexpr const char* software_pipeline_shared_memory_bytes =
+    "software_pipeline_shared_memory_bytes";
+
 /*! \brief Mark the buffers which is const access and can be transformed layout. */
 constexpr const char* layout_free_buffers = "layout_free_buffers";
 
@@ -1598,6 +1647,12 @@ constexpr const char* meta_schedule_thread_extent_high_inclusive =
 constexpr const char* meta_schedule_random_compute_producer =
     "meta_schedule.random_compute_producer";
 
+/*!
+ * \brief Mark the outermost loop around a rolling buffer created by rule Rolling-Buffer, whose
+ * iterations share the buffer and thus must not be parallelized.
+ */
+constexpr const char* meta_schedule_rolling_buffer = "meta_schedule.rolling_buffer";
+
 /*! \brief Mark auto-parallel setting on the block. */
 constexpr const char* meta_schedule_parallel = "meta_schedule.parallel";
 
@@ -1610,6 +1665,15 @@ constexpr const char* meta_schedule_unroll_explicit = "meta_schedule.unroll_expl
 /*! \brief Mark auto-unroll setting on the block. */
 constexpr const char* meta_schedule_unroll_implicit = "meta_schedule.unroll_implicit";
 
+/*! \brief Mark the register limit of the auto-unroll setting on the block. */
+constexpr const char* meta_schedule_unroll_max_registers = "meta_schedule.unroll_max_registers";
+
+/*! \brief Mark the code size limit of the auto-unroll setting on the block. */
+constexpr const char* meta_schedule_unroll_max_code_size = "meta_schedule.unroll_max_code_size";
+
+/*! \brief Mark the software prefetch distance sampled by rule Software-Prefetch on the block. */
+constexpr const char* meta_schedule_prefetch_distance = "meta_schedule.prefetch_distance";
+
 /*! \brief Mark that a block should be further rewritten using tensorization. */
 constexpr const char* meta_schedule_auto_tensorize = "meta_schedule.auto_tensorize";
 
@@ -51,12 +51,14 @@ using tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param thread_safe Whether pass_func can run on several PrimFuncs of a module
+ *  concurrently, which is done when the "tir.num_pass_threads" config is above 1.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe = false);
 
 /*!
  * \brief Inject prefetch instructions into stmt.
@@ -362,6 +364,14 @@ TVM_DLL Pass BF16ComputeLegalize();
  */
 TVM_DLL Pass BF16StorageLegalize();
 
+/*!
+ * \brief Legalize fp8 compute Ops. Add a cast to the promoted type
+ *   before Ops, then add a cast back to fp8.
+ * \param promote_dtype_str The float type that the fp8 compute is promoted to.
+ * \return The pass.
+ */
+TVM_DLL Pass FP8ComputeLegalize(String promote_dtype_str = "float16");
+
 /*!
  * \brief Rewrite the pointer content type of arguments,
  *  as well as Alloc internal to the function to use
@@ -575,6 +585,17 @@ TVM_DLL Pass UnifiedStaticMemoryPlanner();
  * 3) Block annotation `double_buffer_scope` controls certain buffer sizes to allow decoupling of
  * read/write dependency. It's an integer index of the write regions of the block.
  *
+ * Instead of 1) and 2), a loop can be annotated with `software_pipeline_max_stages`, and
+ * optionally `software_pipeline_shared_memory_bytes`. The components that only read global
+ * buffers not written in the loop and write shared buffers allocated in the loop are then put
+ * in stage 0, with every other component in the last stage, keeping the original order. The
+ * number of stages is the largest one, up to the maximum and the loop extent, for which the
+ * versions of the shared buffers fit in the given bytes. The components may write `global.vtcm`
+ * buffers instead, which are bounded by the VTCM capacity of the target when no bytes are given,
+ * and their stage is made asynchronous when `tir.use_async_copy` lowers the copies to DMA. Loops
+ * that do not have this producer/consumer structure, or would have less than two stages, are
+ * left unchanged.
+ *
  * Every annotated loop is transformed into a loop with three blocks as its direct children:
  *
  * 1) Prologue block, where components whose stage is less than `max_stage` is executed;
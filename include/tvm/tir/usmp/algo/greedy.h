@@ -64,6 +64,12 @@ class GreedyBase {
   bool IsValidPlacement(const PoolInfo& candidate_pool, const size_t& next_offset,
                         const size_t& size_bytes);
 
+  /*!
+   * \brief Returns the pool candidates of the BufferInfo in the order of preference.
+   * By default, this is the order the user has specified.
+   */
+  virtual Array<PoolInfo> GetOrderedPoolCandidates(const BufferInfo& buf_info);
+
   /*!
    * \brief Selects a pool for placement in the given set of ordered pool candidates
    */
@@ -53,6 +53,18 @@ Map<BufferInfo, PoolAllocation> GreedyBySize(const Array<BufferInfo>& buffer_inf
  */
 Map<BufferInfo, PoolAllocation> GreedyByConflicts(const Array<BufferInfo>& buffer_info_arr,
                                                   const Integer& memory_pressure);
+/*!
+ * \brief The Greedy-by-Bandwidth algorithm to plan memory
+ *
+ * This will perform a greedy algorithm in deciding the pools and the offsets
+ * within them, placing the buffers with the most traffic per byte first, each
+ * in the candidate pool that serves its traffic in the fewest cycles.
+ *
+ * \return A Map of BufferInfo objects and their associated PoolAllocation
+ */
+Map<BufferInfo, PoolAllocation> GreedyByBandwidth(const Array<BufferInfo>& buffer_info_arr,
+                                                  const Integer& memory_pressure);
+
 /*!
  *\brief The Hill-Climb algoritm to plan memory
  *
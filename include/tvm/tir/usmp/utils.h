@@ -81,6 +81,10 @@ struct BufferInfoNode : public Object {
   Array<ObjectRef> conflicts;
   /*! \brief Whether BufferInfo object retains info about IO tensors or intermediaries */
   BufferInfoKind kind;
+  /*! \brief The estimated number of bytes read from the buffer in one inference */
+  int64_t read_bytes = 0;
+  /*! \brief The estimated number of bytes written to the buffer in one inference */
+  int64_t write_bytes = 0;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("name_hint", &name_hint);
@@ -89,12 +93,15 @@ struct BufferInfoNode : public Object {
     v->Visit("alignment", &alignment);
     v->Visit("conflicts", &conflicts);
     v->Visit("kind", &kind);
+    v->Visit("read_bytes", &read_bytes);
+    v->Visit("write_bytes", &write_bytes);
   }
 
   bool SEqualReduce(const BufferInfoNode* other, SEqualReducer equal) const {
     return equal(name_hint, other->name_hint) && equal(size_bytes, other->size_bytes) &&
            equal(pool_candidates, other->pool_candidates) && equal(alignment, other->alignment) &&
-           equal(conflicts, other->conflicts) && equal(kind, other->kind);
+           equal(conflicts, other->conflicts) && equal(kind, other->kind) &&
+           equal(read_bytes, other->read_bytes) && equal(write_bytes, other->write_bytes);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
@@ -104,6 +111,8 @@ struct BufferInfoNode : public Object {
     hash_reduce(conflicts);
     hash_reduce(pool_candidates);
     hash_reduce(kind);
+    hash_reduce(read_bytes);
+    hash_reduce(write_bytes);
   }
   /*!
    * \brief Set the liveness conflicts of this BufferInfo
@@ -111,6 +120,13 @@ struct BufferInfoNode : public Object {
    * \param conflicting_buffer_info_objs An array of BufferInfo that conflicts in liveness
    */
   TVM_DLL void SetConflicts(Array<ObjectRef> conflicting_buffer_info_objs);
+  /*!
+   * \brief Set the estimated traffic to this BufferInfo
+   *
+   * \param read_bytes The number of bytes read from the buffer in one inference
+   * \param write_bytes The number of bytes written to the buffer in one inference
+   */
+  TVM_DLL void SetAccessBytes(int64_t read_bytes, int64_t write_bytes);
 
   static constexpr const char* _type_key = "tir.usmp.BufferInfo";
   TVM_DECLARE_FINAL_OBJECT_INFO(BufferInfoNode, Object);
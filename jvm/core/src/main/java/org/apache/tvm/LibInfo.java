@@ -17,6 +17,7 @@
 
 package org.apache.tvm;
 
+import java.nio.ByteBuffer;
 import java.util.List;
 
 class LibInfo {
@@ -71,6 +72,17 @@ class LibInfo {
 
   native int tvmArrayCopyToJArray(long from, byte[] to);
 
+  native int tvmArrayFromDirectBuffer(ByteBuffer buffer, long offset, long[] shape,
+      int dtypeCode, int dtypeBits, int dtypeLanes, Base.RefLong refHandle);
+
+  native ByteBuffer tvmArrayAsDirectBuffer(long handle, long nbytes);
+
+  native int tvmArrayCopyFromDirectBuffer(ByteBuffer buffer, long offset, long to, long nbytes);
+
+  native int tvmArrayCopyToDirectBuffer(long from, ByteBuffer buffer, long offset, long nbytes);
+
+  native int tvmDirectBufferAddress(ByteBuffer buffer, Base.RefLong refAddress);
+
   // Device
   native int tvmSynchronize(int deviceType, int deviceId);
 }
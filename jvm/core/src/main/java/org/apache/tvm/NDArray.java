@@ -26,8 +26,13 @@ import java.util.List;
  * Lightweight NDArray class of TVM runtime.
  */
 public class NDArray extends NDArrayBase {
+  /** The alignment TVM requires of the data of an NDArray, in bytes. */
+  public static final int ALIGNMENT = 64;
+
   private final TVMType dtype;
   private final Device device;
+  // The caller-owned buffer an array from fromDirectBuffer is a view of.
+  private ByteBuffer directBuffer = null;
 
   NDArray(long handle, boolean isView, TVMType dtype, Device dev) {
     super(handle, isView);
@@ -185,6 +190,68 @@ public class NDArray extends NDArrayBase {
     tmpArr.release();
   }
 
+  /**
+   * Copy from a direct buffer, without going through a java array.
+   * The bytes are read from the position of the buffer, which is left unchanged.
+   * Unlike {@link #fromDirectBuffer}, the buffer needs no alignment and the array can be on any
+   * device.
+   * @param source the source data, in the native byte order.
+   */
+  public void copyFrom(ByteBuffer source) {
+    long nbytes = checkDirectBuffer(source);
+    Base.checkCall(Base._LIB.tvmArrayCopyFromDirectBuffer(
+        source, source.position(), handle, nbytes));
+  }
+
+  /**
+   * Copy to a direct buffer, without going through a java array.
+   * The bytes are written from the position of the buffer, which is left unchanged.
+   * @param target the target buffer, in the native byte order.
+   * @return target
+   */
+  public ByteBuffer copyTo(ByteBuffer target) {
+    long nbytes = checkDirectBuffer(target);
+    Base.checkCall(Base._LIB.tvmArrayCopyToDirectBuffer(
+        handle, target, target.position(), nbytes));
+    return target;
+  }
+
+  private long checkDirectBuffer(ByteBuffer buffer) {
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("The buffer must be a direct buffer");
+    }
+    long nbytes = nbytes();
+    if (buffer.remaining() < nbytes) {
+      throw new IllegalArgumentException(String.format(
+          "The buffer has %d bytes remaining, the array needs %d", buffer.remaining(), nbytes));
+    }
+    return nbytes;
+  }
+
+  /**
+   * View the data of a cpu array as a direct buffer, without copying.
+   * The buffer is only valid while this array is alive and not released.
+   * @return A buffer over the data, in the native byte order.
+   */
+  public ByteBuffer asDirectBuffer() {
+    if (device.deviceType != Device.cpu().deviceType) {
+      throw new IllegalArgumentException("Only cpu arrays can be viewed as a direct buffer");
+    }
+    ByteBuffer buffer = Base._LIB.tvmArrayAsDirectBuffer(handle, nbytes());
+    if (buffer == null) {
+      throw new Base.TVMError("Failed to create a direct buffer over the array");
+    }
+    return buffer.order(ByteOrder.nativeOrder());
+  }
+
+  /**
+   * Get the number of bytes of the data of current NDArray.
+   * @return size of the data in bytes.
+   */
+  public long nbytes() {
+    return size() * dtype.numOfBytes * dtype.lanes;
+  }
+
   /**
    * Get shape of current NDArray.
    * @return an array representing shape of current ndarray
@@ -414,6 +481,53 @@ public class NDArray extends NDArrayBase {
     return empty(shape, new TVMType("float32", 1), dev);
   }
 
+  /**
+   * Wrap a caller-owned direct buffer as a cpu array, without copying.
+   * The array starts at the position of the buffer, which must be aligned to {@link #ALIGNMENT}
+   * bytes, e.g. a buffer from {@link #allocateDirect}. Writes through either are seen by the
+   * other, so an input or output of a model can be a view of the buffers of a serving stack. The
+   * buffer is kept reachable until the array is released and TVM no longer refers to it.
+   * @param buffer The buffer holding the data, in the native byte order.
+   * @param shape The shape of the array.
+   * @param dtype The data type of the array.
+   * @return The array viewing the buffer.
+   */
+  public static NDArray fromDirectBuffer(ByteBuffer buffer, long[] shape, TVMType dtype) {
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("The buffer must be a direct buffer");
+    }
+    long nbytes = dtype.numOfBytes * dtype.lanes;
+    for (long dim : shape) {
+      nbytes *= dim;
+    }
+    if (buffer.remaining() < nbytes) {
+      throw new IllegalArgumentException(String.format(
+          "The buffer has %d bytes remaining, the array needs %d", buffer.remaining(), nbytes));
+    }
+    Base.RefLong refHandle = new Base.RefLong();
+    Base.checkCall(Base._LIB.tvmArrayFromDirectBuffer(buffer, buffer.position(), shape,
+        dtype.typeCode, dtype.bits, dtype.lanes, refHandle));
+    NDArray array = new NDArray(refHandle.value, false, dtype, Device.cpu());
+    array.directBuffer = buffer;
+    return array;
+  }
+
+  /**
+   * Allocate a direct buffer aligned as {@link #fromDirectBuffer} requires.
+   * @param nbytes The capacity of the buffer.
+   * @return A buffer in the native byte order, whose first byte is aligned to
+   *         {@link #ALIGNMENT} bytes.
+   */
+  public static ByteBuffer allocateDirect(int nbytes) {
+    ByteBuffer raw = ByteBuffer.allocateDirect(nbytes + ALIGNMENT);
+    Base.RefLong refAddress = new Base.RefLong();
+    Base.checkCall(Base._LIB.tvmDirectBufferAddress(raw, refAddress));
+    int padding = (int) ((ALIGNMENT - refAddress.value % ALIGNMENT) % ALIGNMENT);
+    raw.position(padding);
+    raw.limit(padding + nbytes);
+    return raw.slice().order(ByteOrder.nativeOrder());
+  }
+
   private static ByteBuffer wrapBytes(byte[] bytes) {
     ByteBuffer bb = ByteBuffer.wrap(bytes);
     bb.order(ByteOrder.LITTLE_ENDIAN);
@@ -19,6 +19,8 @@
 
 package org.apache.tvm.contrib;
 
+import java.util.HashMap;
+import java.util.Map;
 import org.apache.tvm.Device;
 import org.apache.tvm.Function;
 import org.apache.tvm.Module;
@@ -40,6 +42,11 @@ public class GraphModule {
   private Function fgetInput;
   private Function fdebugGetOutput;
   private Function floadParams;
+  private Function fsetInputZeroCopy;
+  private Function fsetOutputZeroCopy;
+  // The executor only keeps the data pointers of zero-copy arrays, keep the arrays alive.
+  private final Map<Object, NDArray> boundInputs = new HashMap<Object, NDArray>();
+  private final Map<Integer, NDArray> boundOutputs = new HashMap<Integer, NDArray>();
 
   GraphModule(Module module, Device dev) {
     this.module = module;
@@ -54,6 +61,8 @@ public class GraphModule {
       // ignore
     }
     floadParams = module.getFunction("load_params");
+    fsetInputZeroCopy = module.getFunction("set_input_zero_copy");
+    fsetOutputZeroCopy = module.getFunction("set_output_zero_copy");
   }
 
   /**
@@ -71,6 +80,10 @@ public class GraphModule {
       fdebugGetOutput.release();
     }
     floadParams.release();
+    fsetInputZeroCopy.release();
+    fsetOutputZeroCopy.release();
+    boundInputs.clear();
+    boundOutputs.clear();
     module.release();
   }
 
@@ -106,6 +119,47 @@ public class GraphModule {
     return this;
   }
 
+  /**
+   * Make the module read an input from an array, without copying it.
+   * The array must be on the device of the module, and its data aligned as NDArray.ALIGNMENT
+   * bytes, e.g. a view from NDArray.fromDirectBuffer. Every run reads the current content of
+   * the array, until another array is bound to the same input.
+   * @param key The input key.
+   * @param value The input value.
+   * @return self.
+   */
+  public GraphModule setInputZeroCopy(String key, NDArray value) {
+    fsetInputZeroCopy.pushArg(key).pushArg(value).invoke();
+    boundInputs.put(key, value);
+    return this;
+  }
+
+  /**
+   * Make the module read an input from an array, without copying it.
+   * @param key The input index.
+   * @param value The input value.
+   * @return self.
+   * @see #setInputZeroCopy(String, NDArray)
+   */
+  public GraphModule setInputZeroCopy(int key, NDArray value) {
+    fsetInputZeroCopy.pushArg(key).pushArg(value).invoke();
+    boundInputs.put(key, value);
+    return this;
+  }
+
+  /**
+   * Make the module write an output into an array, without copying it from its own storage.
+   * The requirements on the array are those of {@link #setInputZeroCopy(String, NDArray)}.
+   * @param index The output index.
+   * @param out The output array.
+   * @return self.
+   */
+  public GraphModule setOutputZeroCopy(int index, NDArray out) {
+    fsetOutputZeroCopy.pushArg(index).pushArg(out).invoke();
+    boundOutputs.put(index, out);
+    return this;
+  }
+
   /**
    * Run forward execution of the graph.
    * @return self.
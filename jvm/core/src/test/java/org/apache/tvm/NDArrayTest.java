@@ -19,6 +19,8 @@ package org.apache.tvm;
 
 import org.junit.Test;
 
+import java.nio.ByteBuffer;
+
 import static org.junit.Assert.*;
 
 public class NDArrayTest {
@@ -77,4 +79,24 @@ public class NDArrayTest {
     assertArrayEquals(new char[]{65535, 2, 3, 4}, ndarray.asCharArray());
     ndarray.release();
   }
+
+  @Test
+  public void test_direct_buffer() {
+    ByteBuffer buffer = NDArray.allocateDirect(16);
+    buffer.asFloatBuffer().put(new float[]{1, 2, 3, 4});
+    NDArray view = NDArray.fromDirectBuffer(buffer, new long[]{2, 2}, new TVMType("float32"));
+    assertArrayEquals(new float[]{1f, 2f, 3f, 4f}, view.asFloatArray(), 1e-3f);
+    // Writes through the array are seen in the buffer.
+    view.asDirectBuffer().putFloat(0, 5f);
+    assertEquals(5f, buffer.getFloat(0), 1e-3f);
+
+    NDArray copy = NDArray.empty(new long[]{2, 2}, new TVMType("float32"));
+    copy.copyFrom(buffer);
+    ByteBuffer out = ByteBuffer.allocateDirect(16).order(buffer.order());
+    copy.copyTo(out);
+    assertEquals(5f, out.getFloat(0), 1e-3f);
+    assertEquals(4f, out.getFloat(12), 1e-3f);
+    view.release();
+    copy.release();
+  }
 }
@@ -20,6 +20,7 @@ package org.apache.tvm.contrib;
 import org.apache.tvm.Module;
 import org.apache.tvm.NDArray;
 import org.apache.tvm.Device;
+import org.apache.tvm.TVMType;
 import org.apache.tvm.TestUtils;
 import org.apache.tvm.rpc.Client;
 import org.apache.tvm.rpc.RPCSession;
@@ -31,6 +32,7 @@ import org.slf4j.LoggerFactory;
 
 import java.io.File;
 import java.io.IOException;
+import java.nio.ByteBuffer;
 import java.util.Scanner;
 
 import static org.junit.Assert.assertArrayEquals;
@@ -70,6 +72,38 @@ public class GraphExecutorTest {
     graph.release();
   }
 
+  @Test
+  public void test_add_one_zero_copy() throws IOException {
+    Module libmod = Module.load(loadingDir + File.separator + "graph_addone_lib.so");
+    String graphJson = new Scanner(new File(
+        loadingDir + File.separator + "graph_addone.json"))
+        .useDelimiter("\\Z").next();
+
+    Device dev = Device.cpu();
+    GraphModule graph = GraphExecutor.create(graphJson, libmod, dev);
+
+    long[] shape = new long[]{4};
+    TVMType dtype = new TVMType("float32");
+    ByteBuffer input = NDArray.allocateDirect(16);
+    ByteBuffer output = NDArray.allocateDirect(16);
+    graph.setInputZeroCopy("x", NDArray.fromDirectBuffer(input, shape, dtype))
+        .setOutputZeroCopy(0, NDArray.fromDirectBuffer(output, shape, dtype));
+
+    input.asFloatBuffer().put(new float[]{1f, 2f, 3f, 4f});
+    graph.run();
+    float[] result = new float[4];
+    output.asFloatBuffer().get(result);
+    assertArrayEquals(new float[]{2f, 3f, 4f, 5f}, result, 1e-3f);
+
+    // The next run reads the new content of the same buffer.
+    input.asFloatBuffer().put(new float[]{5f, 6f, 7f, 8f});
+    graph.run();
+    output.asFloatBuffer().get(result);
+    assertArrayEquals(new float[]{6f, 7f, 8f, 9f}, result, 1e-3f);
+
+    graph.release();
+  }
+
   @Test
   public void test_add_one_remote() throws IOException {
     if (!Module.enabled("rpc")) {
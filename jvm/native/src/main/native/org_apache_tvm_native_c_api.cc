@@ -453,6 +453,109 @@ JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayCopyToJArray(JNIEnv*
   return ret;
 }
 
+// Direct buffers
+struct DirectBufferContext {
+  DLManagedTensor managed;
+  std::vector<int64_t> shape;
+  // Global reference keeping the buffer reachable while TVM holds the tensor.
+  jobject buffer;
+};
+
+extern "C" void directBufferDeleter(DLManagedTensor* managed) {
+  DirectBufferContext* ctx = static_cast<DirectBufferContext*>(managed->manager_ctx);
+  JNIEnv* env;
+  int jniStatus = _jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+  if (jniStatus == JNI_EDETACHED) {
+#ifdef TVM4J_ANDROID
+    _jvm->AttachCurrentThread(&env, nullptr);
+#else
+    _jvm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr);
+#endif
+  } else {
+    CHECK(jniStatus == JNI_OK);
+  }
+  env->DeleteGlobalRef(ctx->buffer);
+  delete ctx;
+}
+
+static char* directBufferData(JNIEnv* env, jobject jbuffer, jlong joffset) {
+  char* data = static_cast<char*>(env->GetDirectBufferAddress(jbuffer));
+  if (data == nullptr) {
+    TVMAPISetLastError("The buffer is not a direct buffer");
+    return nullptr;
+  }
+  return data + joffset;
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayFromDirectBuffer(
+    JNIEnv* env, jobject obj, jobject jbuffer, jlong joffset, jlongArray jshape, jint jdtypeCode,
+    jint jdtypeBits, jint jdtypeLanes, jobject jret) {
+  char* data = directBufferData(env, jbuffer, joffset);
+  if (data == nullptr) return -1;
+
+  DirectBufferContext* ctx = new DirectBufferContext();
+  int ndim = static_cast<int>(env->GetArrayLength(jshape));
+  ctx->shape.resize(ndim);
+  env->GetLongArrayRegion(jshape, 0, ndim, reinterpret_cast<jlong*>(ctx->shape.data()));
+  ctx->buffer = env->NewGlobalRef(jbuffer);
+
+  DLTensor& tensor = ctx->managed.dl_tensor;
+  tensor.data = data;
+  tensor.device = DLDevice{kDLCPU, 0};
+  tensor.ndim = ndim;
+  tensor.dtype = DLDataType{static_cast<uint8_t>(jdtypeCode), static_cast<uint8_t>(jdtypeBits),
+                            static_cast<uint16_t>(jdtypeLanes)};
+  tensor.shape = ctx->shape.data();
+  tensor.strides = nullptr;
+  tensor.byte_offset = 0;
+  ctx->managed.manager_ctx = ctx;
+  ctx->managed.deleter = directBufferDeleter;
+
+  TVMArrayHandle out;
+  int ret = TVMArrayFromDLPack(&ctx->managed, &out);
+  if (ret != 0) {
+    // The tensor was not taken over.
+    directBufferDeleter(&ctx->managed);
+    return ret;
+  }
+  setLongField(env, jret, reinterpret_cast<jlong>(out));
+  return 0;
+}
+
+JNIEXPORT jobject JNICALL Java_org_apache_tvm_LibInfo_tvmArrayAsDirectBuffer(JNIEnv* env,
+                                                                            jobject obj,
+                                                                            jlong jhandle,
+                                                                            jlong jnbytes) {
+  DLTensor* array = reinterpret_cast<DLTensor*>(jhandle);
+  return env->NewDirectByteBuffer(static_cast<char*>(array->data) + array->byte_offset, jnbytes);
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayCopyFromDirectBuffer(
+    JNIEnv* env, jobject obj, jobject jbuffer, jlong joffset, jlong jto, jlong jnbytes) {
+  char* data = directBufferData(env, jbuffer, joffset);
+  if (data == nullptr) return -1;
+  return TVMArrayCopyFromBytes(reinterpret_cast<TVMArrayHandle>(jto), data,
+                               static_cast<size_t>(jnbytes));
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmArrayCopyToDirectBuffer(
+    JNIEnv* env, jobject obj, jlong jfrom, jobject jbuffer, jlong joffset, jlong jnbytes) {
+  char* data = directBufferData(env, jbuffer, joffset);
+  if (data == nullptr) return -1;
+  return TVMArrayCopyToBytes(reinterpret_cast<TVMArrayHandle>(jfrom), data,
+                             static_cast<size_t>(jnbytes));
+}
+
+JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmDirectBufferAddress(JNIEnv* env,
+                                                                          jobject obj,
+                                                                          jobject jbuffer,
+                                                                          jobject jret) {
+  char* data = directBufferData(env, jbuffer, 0);
+  if (data == nullptr) return -1;
+  setLongField(env, jret, reinterpret_cast<jlong>(data));
+  return 0;
+}
+
 // Device
 JNIEXPORT jint JNICALL Java_org_apache_tvm_LibInfo_tvmSynchronize(JNIEnv* env, jint deviceType,
                                                                   jint deviceId) {
@@ -98,6 +98,7 @@ class Analyzer:
         self._rewrite_simplify = _mod("rewrite_simplify")
         self._get_rewrite_simplify_stats = _mod("get_rewrite_simplify_stats")
         self._reset_rewrite_simplify_stats = _mod("reset_rewrite_simplify_stats")
+        self._set_memoization_enabled = _mod("set_memoization_enabled")
         self._canonical_simplify = _mod("canonical_simplify")
         self._int_set = _mod("int_set")
         self._enter_constraint_context = _mod("enter_constraint_context")
@@ -176,6 +177,21 @@ class Analyzer:
     def reset_rewrite_simplify_stats(self):
         self._reset_rewrite_simplify_stats()
 
+    def set_memoization_enabled(self, enabled):
+        """Enable or disable the memoization of simplifications.
+
+        When enabled, the results of simplify and rewrite_simplify are
+        reused for the same expression object while the bindings and
+        constraints in scope are unchanged. The cache hits and misses
+        are reported in rewrite_simplify_stats.
+
+        Parameters
+        ----------
+        enabled : bool
+            Whether to memoize.
+        """
+        self._set_memoization_enabled(enabled)
+
     def canonical_simplify(self, expr):
         """Simplify expression via canonicalization.
 
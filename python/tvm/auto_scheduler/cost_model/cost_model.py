@@ -22,6 +22,7 @@ import numpy as np
 import tvm._ffi
 from tvm.runtime import Object
 from .. import _ffi_api
+from ..feature import DEFAULT_MAX_N_BUFS
 
 
 @tvm._ffi.register_object("auto_scheduler.CostModel")
@@ -66,6 +67,49 @@ class RandomModel(CostModel):
         return [x.value for x in _ffi_api.CostModelPredict(self, search_task, states)]
 
 
+@tvm._ffi.register_object("auto_scheduler.TreeEnsembleModel")
+class TreeEnsembleModel(CostModel):
+    """A model that predicts the scores of states with a pre-trained tree ensemble in C++.
+
+    The features are extracted and the states are scored in parallel, without calling back into
+    python. The model is inference-only, so that `update` is a no-op.
+
+    Parameters
+    ----------
+    path : str
+        The path to the tree ensemble, an XGBoost model saved in JSON, e.g. by
+        `XGBModel.save("model.json")`.
+    max_n_bufs : Optional[int]
+        The maximum number of buffers in the features that the tree ensemble is trained on.
+    """
+
+    def __init__(self, path, max_n_bufs=None):
+        self.__init_handle_by_constructor__(
+            _ffi_api.TreeEnsembleModel, path, max_n_bufs or DEFAULT_MAX_N_BUFS
+        )
+
+    def update(self, inputs, results):
+        """The tree ensemble is pre-trained, so that the measurement results are not used."""
+        _ffi_api.CostModelUpdate(self, inputs, results)
+
+    def predict(self, search_task, states):
+        """Predict the scores of states
+
+        Parameters
+        ----------
+        search_task : SearchTask
+            The search task of states
+        states : List[State]
+            The input states
+
+        Returns
+        -------
+        scores: List[float]
+            The predicted scores for all states
+        """
+        return [x.value for x in _ffi_api.CostModelPredict(self, search_task, states)]
+
+
 @tvm._ffi.register_func("auto_scheduler.cost_model.random_fill_float")
 def random_fill_float(size, return_ptr):
     """Fills a c++ float array with random numbers in [0, 1]
@@ -328,7 +328,8 @@ class XGBModel(PythonBasedModel):
         Parameters
         ----------
         file_name: str
-            The filename
+            The filename. The model is saved in JSON if it ends with ".json", which can be
+            loaded by TreeEnsembleModel to predict natively.
         """
         self.bst.save_model(file_name)
 
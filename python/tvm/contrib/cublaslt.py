@@ -52,3 +52,49 @@ def matmul(lhs, rhs, transa=False, transb=False, n=0, m=0, dtype=None):
         dtype=dtype,
         name="C",
     )
+
+
+def matmul_bias(lhs, rhs, bias, transa=False, transb=False, epilogue="bias", dtype=None):
+    """Create an extern op that compute matrix mult of lhs and rhs with cuBLASLt, with the bias
+    and activation fused into the matmul as a cuBLASLt epilogue
+
+    Parameters
+    ----------
+    lhs : Tensor
+        The left matrix operand
+    rhs : Tensor
+        The right matrix operand
+    bias : Tensor
+        The 1-D bias, added to each row of the result
+    transa : bool
+        Whether transpose lhs
+    transb : bool
+        Whether transpose rhs
+    epilogue : str
+        The epilogue applied after adding the bias, "bias" for none, "relu" or "gelu". The
+        cuBLASLt gelu is the tanh approximation of gelu.
+
+    Returns
+    -------
+    C : Tensor
+        The result tensor.
+    """
+    n = lhs.shape[1] if transa else lhs.shape[0]
+    m = rhs.shape[0] if transb else rhs.shape[1]
+    dtype = dtype if dtype is not None else lhs.dtype
+    return te.extern(
+        (n, m),
+        [lhs, rhs, bias],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.cublaslt.matmul_bias",
+            ins[0],
+            ins[1],
+            ins[2],
+            outs[0],
+            transa,
+            transb,
+            epilogue,
+        ),
+        dtype=dtype,
+        name="matmul_bias_cublaslt",
+    )
@@ -80,7 +80,8 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         self._start_capture = module["start_capture"]
         self._end_capture = module["end_capture"]
         self._run_cuda_graph = module["run_cuda_graph"]
-        self._cuda_graph_captured = False
+        self._run_cuda_graph_cached = module["run_cuda_graph_cached"]
+        self._set_cuda_graph_cache_size = module["set_cuda_graph_cache_size"]
         graph_executor.GraphModule.__init__(self, module)
 
     def capture_cuda_graph(self):
@@ -93,7 +94,6 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         self._start_capture()
         self._run()
         self._end_capture()
-        self._cuda_graph_captured = True
 
     def run_cuda_graph(self):
         """Run the CUDA graph for tvm_op graph
@@ -103,10 +103,26 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         """
         self._run_cuda_graph()
 
+    def set_cuda_graph_cache_size(self, cache_size):
+        """Set the number of CUDA graphs kept by :py:func:`run`.
+
+        Parameters
+        ----------
+        cache_size : int
+            The maximum number of cached graphs, the least recently used graph
+            is evicted first.
+        """
+        self._set_cuda_graph_cache_size(cache_size)
+
     def run(self, **input_dict):
         """A run wrapper for graph capture / launch, user can just
         change default graph executor to cuda graph executor, and
-        the first call will capture a cuda graph for future launch
+        the calls will capture cuda graphs for future launch
+
+        The graphs are cached by the addresses and shapes of the input and output
+        buffers, so that rotating between buffers bound with
+        :py:func:`set_input_zero_copy` and :py:func:`set_output_zero_copy` still
+        launches one captured graph per run.
 
         Parameters
         ----------
@@ -115,10 +131,7 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         """
         if input_dict:
             self.set_input(**input_dict)
-        if not self._cuda_graph_captured:
-            self.capture_cuda_graph()
-        else:
-            self._run_cuda_graph()
+        self._run_cuda_graph_cached()
 
     def debug_get_output(self, node, out):
         """Run graph up to node and get the output to out
@@ -0,0 +1,71 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Relay virtual machine with CUDA graph"""
+import tvm._ffi
+
+from tvm.rpc import base as rpc_base
+from tvm.runtime import vm
+
+
+class VirtualMachineCudaGraph(vm.VirtualMachine):
+    """Relay VM replaying the kernels of static regions with CUDA graphs.
+
+    Straight-line ranges of kernel calls between control flow, shape functions and
+    dynamic allocations are captured as CUDA graphs the second time they run with the
+    same input buffers and shapes, and replayed with a single graph launch afterwards.
+
+    Capture requires that no memory is allocated or freed on the device while a region
+    runs, so the default pooled allocator should be used.
+
+    Parameters
+    ----------
+    exe : Union[Executable, Module]
+        The executable.
+
+    device : Union[Device, List[Device]]
+        The device, or devices on which to execute the VM code.
+
+    memory_cfg : Optional[str]
+        The allocator behavior to use for the VM.
+    """
+
+    def __init__(self, exe, device, memory_cfg=None):
+        super(VirtualMachineCudaGraph, self).__init__(exe, device, memory_cfg)
+
+        devs = device if isinstance(device, (list, tuple)) else [device]
+        try:
+            if devs[0].device_type >= rpc_base.RPC_SESS_MASK:
+                fcreate = devs[0]._rpc_sess.get_function("runtime._VirtualMachineCudaGraph")
+            else:
+                fcreate = tvm._ffi.get_global_func("runtime._VirtualMachineCudaGraph")
+        except ValueError:
+            raise ValueError(
+                "To enable CUDA graph support (experimental), please set "
+                "'(USE_GRAPH_EXECUTOR_CUDA_GRAPH ON)' in config.cmake and rebuild TVM"
+            )
+        self.module = fcreate(self._exec.mod)
+
+        self._init = self.module["init"]
+        self._invoke = self.module["invoke"]
+        self._invoke_stateful = self.module["invoke_stateful"]
+        self._get_output = self.module["get_output"]
+        self._get_num_outputs = self.module["get_num_outputs"]
+        self._get_input_index = self.module["get_input_index"]
+        self._set_input = self.module["set_input"]
+        self._set_one_input = self.module["set_one_input"]
+        self._set_outputs = self.module["set_outputs"]
+        self._setup_device(device, memory_cfg)
@@ -19,6 +19,8 @@
 import logging
 import os
 import multiprocessing
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
 import tvm
 from tvm import relay, runtime
 from tvm._ffi.registry import register_func
@@ -519,12 +521,15 @@ def tune_cutlass_function(
 
 @register_func("contrib.cutlass.compile")
 def compile_cutlass_module(c_source_module, options):
-    """Compile all CUTLASS kernels in the given C-source module.
+    """Compile all CUTLASS kernels in the given C-source module(s).
+
+    When a list of C-source modules is given, each module is compiled as a separate translation
+    unit, in parallel, and the resulting objects are combined into one relocatable object.
 
     Parameters
     ----------
-    c_source_module: runtime.Module
-        A C-source module containing CUTLASS kernels.
+    c_source_module: Union[runtime.Module, List[runtime.Module]]
+        A C-source module, or a list of C-source modules, containing CUTLASS kernels.
 
     options: dict
         Compilation options. Currently recognizes
@@ -543,11 +548,52 @@ def compile_cutlass_module(c_source_module, options):
     defaults = {"sm": 80, "threads": -1, "use_fast_math": False}
     compile_config = {key: options.get(key, val) for key, val in defaults.items()}
 
-    function_names = c_source_module.get_function("get_func_names")()
-    compile_options = _get_cutlass_compile_options(**compile_config)
+    c_source_modules = (
+        list(c_source_module) if isinstance(c_source_module, (list, tuple)) else [c_source_module]
+    )
     lib_path = os.path.join(tmp_dir, "cutlass.o")
-    logger.info("Compiling generated CUTLASS code")
-    c_source_module.export_library(lib_path, workspace_dir=tmp_dir, **compile_options)
+    function_names = []
+    for mod in c_source_modules:
+        function_names += list(mod.get_function("get_func_names")())
+
+    if len(c_source_modules) == 1:
+        logger.info("Compiling generated CUTLASS code")
+        compile_options = _get_cutlass_compile_options(**compile_config)
+        c_source_modules[0].export_library(lib_path, workspace_dir=tmp_dir, **compile_options)
+        return tvm.runtime.load_static_library(lib_path, function_names)
+
+    # Spread the threads over the translation units instead of over the nvcc passes.
+    threads = compile_config["threads"]
+    ncpu = multiprocessing.cpu_count() if threads < 0 else threads
+    num_workers = max(1, min(ncpu, len(c_source_modules)))
+    compile_config["threads"] = max(1, ncpu // num_workers)
+    compile_options = _get_cutlass_compile_options(**compile_config)
+
+    def _compile(i):
+        obj_path = os.path.join(tmp_dir, f"cutlass_{i}.o")
+        workspace_dir = os.path.join(tmp_dir, f"cutlass_{i}")
+        os.makedirs(workspace_dir, exist_ok=True)
+        c_source_modules[i].export_library(obj_path, workspace_dir=workspace_dir, **compile_options)
+        return obj_path
+
+    logger.info(
+        "Compiling generated CUTLASS code in %d translation units with %d workers",
+        len(c_source_modules),
+        num_workers,
+    )
+    with ThreadPoolExecutor(max_workers=num_workers) as executor:
+        obj_paths = list(executor.map(_compile, range(len(c_source_modules))))
+
+    # Combine the objects into one relocatable object, so that none of the kernels is dropped
+    # when the static library is linked into the final shared library.
+    proc = subprocess.run(
+        ["ld", "-r", "-o", lib_path] + obj_paths,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.STDOUT,
+        check=False,
+    )
+    if proc.returncode != 0:
+        raise RuntimeError(f"Linking CUTLASS objects failed:\n{proc.stdout.decode('utf-8')}")
 
     # Recover static library
     return tvm.runtime.load_static_library(lib_path, function_names)
@@ -561,11 +607,11 @@ def compile_for_cutlass(mod, cutlass_target):
        repeated compilation and execution of CUDA code using nvcc. The results of this
        is captured as annotation on each relevant function. Kernel performance is cached
        overall all functions.
-     - Then generates a single CSourceModule containing C code implementing all the
-       Compiler='cutlass' Relay functions, accounting for the tuning done above.
-     - Then compiles that CSourceModule with the appropriate nvcc arguments to yield
-       a static .o library. An export_library step will be required on the final runtime
-       module to link that library into the overall .so library.
+     - Then generates one CSourceModule per Compiler='cutlass' Relay function, containing C
+       code implementing it, accounting for the tuning done above.
+     - Then compiles those CSourceModules in parallel with the appropriate nvcc arguments and
+       combines them into a static .o library. An export_library step will be required on the
+       final runtime module to link that library into the overall .so library.
      See CompileForCutlass in src/relay/backend/contrib/cutlass/codegen.cc for where this
      helper function is used to implement the RelayToTIR pass hook for CUTLASS."""
 
@@ -594,9 +640,16 @@ def compile_for_cutlass(mod, cutlass_target):
 
     # Compile
     logger.info("Creating CSource module for CUTLASS")
-    create_c_source_module = tvm._ffi.get_global_func("relay.ext.cutlass.create_c_source_module")
-    c_module = create_c_source_module(mod)
-    return compile_cutlass_module(c_module, compile_config)
+    create_c_source_modules = tvm._ffi.get_global_func(
+        "relay.ext.cutlass.create_c_source_modules"
+    )
+    c_modules = list(create_c_source_modules(mod))
+    if len(c_modules) <= 1:
+        create_c_source_module = tvm._ffi.get_global_func(
+            "relay.ext.cutlass.create_c_source_module"
+        )
+        c_modules = create_c_source_module(mod)
+    return compile_cutlass_module(c_modules, compile_config)
 
 
 def finalize_modules(lib, lib_path="compile.so", tmp_dir="./tmp"):
@@ -20,7 +20,7 @@ from functools import partial
 from .conv2d_operation import Conv2dOperation, EmitConv2dInstance
 from .gen_gemm import CutlassGemmProfiler
 from .conv2d_profiler import Conv2dProfilerEmitter
-from .gen_tensor_op import ProfilerEngine, GENERATOR_FUNC_TABLE, EPILOGUE_MAP
+from .gen_tensor_op import ProfileCache, ProfilerEngine, GENERATOR_FUNC_TABLE, EPILOGUE_MAP
 from .library import (
     DataType,
     EpilogueFunctor,
@@ -182,6 +182,7 @@ class CutlassConv2DProfiler:
         assert sm in GENERATOR_FUNC_TABLE, f"sm{sm} not supported yet."
         self.engine = ProfilerEngine(sm, cutlass_path, binary_path)
         self.cache = {}
+        self.profile_cache = ProfileCache(binary_path)
 
     def get_default(
         self,
@@ -262,8 +263,21 @@ class CutlassConv2DProfiler:
             dilation[1],
         )
 
-        if workload in self.cache:
-            return self.cache[workload]
+        key = ProfileCache.get_key(
+            f"sm{self.sm}",
+            "conv2d",
+            conv_kind,
+            stride_support,
+            *workload,
+            out_dtype,
+            data_dtype,
+            weight_dtype,
+            use_3xtf32,
+            "_".join(str(split_k) for split_k in split_k_slices),
+            profile_all_alignments,
+        )
+        if key in self.cache:
+            return self.cache[key]
 
         ops = GENERATOR_FUNC_TABLE[self.sm](
             out_dtype,
@@ -277,6 +291,11 @@ class CutlassConv2DProfiler:
             accumlator_dtype="float32" if conv_kind == ConvKind.Wgrad else out_dtype,
         )
 
+        op = self.profile_cache.lookup(key, ops)
+        if op is not None:
+            self.cache[key] = op
+            return op
+
         if not find_first_valid:
             self.engine.compile_all(ops, use_multiprocessing)
 
@@ -289,11 +308,12 @@ class CutlassConv2DProfiler:
             out = self.engine.evaluate(op, args.split(" "))
             op["runtime"] = out
             if out < float("inf") and find_first_valid:
-                self.cache[workload] = op
+                self.cache[key] = op
                 return op
 
         op = min(ops, key=lambda i: i["runtime"])
-        self.cache[workload] = op
+        self.cache[key] = op
+        self.profile_cache.insert(key, op)
         return op
 
     def profile(
@@ -18,7 +18,7 @@
 """GEMM kernel generator and profiler for CUTLASS."""
 from .gemm_operation import EmitGemmInstance, GemmOperation
 from .gemm_profiler import GemmProfilerEmitter
-from .gen_tensor_op import EPILOGUE_MAP, GENERATOR_FUNC_TABLE, ProfilerEngine
+from .gen_tensor_op import EPILOGUE_MAP, GENERATOR_FUNC_TABLE, ProfileCache, ProfilerEngine
 from .library import (
     DataType,
     DataTypeTag,
@@ -153,6 +153,7 @@ class CutlassGemmProfiler:
         self.engine = ProfilerEngine(sm, cutlass_path, binary_path)
         self.sm = sm
         self.cache = {}
+        self.profile_cache = ProfileCache(binary_path)
 
     def get_default(
         self, op_type, out_dtype, arg0_dtype, arg1_dtype, use_3xtf32=True, batched=False
@@ -210,9 +211,20 @@ class CutlassGemmProfiler:
         Profile and select the best kernel from candidate kernels.
         See the documentation for the profile method below.
         """
-        if (M, N, K) in self.cache:
-            op = self.cache[(M, N, K)]
-            return op
+        key = ProfileCache.get_key(
+            f"sm{self.sm}",
+            "gemm",
+            M,
+            N,
+            K,
+            out_dtype,
+            arg0_dtype,
+            arg1_dtype,
+            use_3xtf32,
+            profile_all_alignments,
+        )
+        if key in self.cache:
+            return self.cache[key]
 
         # TODO(masahi): CUTLASS alignment check on gemm kernels is too restrictive.
         # See https://github.com/NVIDIA/cutlass/issues/362.
@@ -230,6 +242,11 @@ class CutlassGemmProfiler:
             accumlator_dtype=out_dtype,
         )
 
+        op = self.profile_cache.lookup(key, ops)
+        if op is not None:
+            self.cache[key] = op
+            return op
+
         if not find_first_valid:
             self.engine.compile_all(ops, use_multiprocessing)
 
@@ -237,11 +254,12 @@ class CutlassGemmProfiler:
             out = self.engine.evaluate(op, [M, N, K])
             op["runtime"] = out
             if out < float("inf") and find_first_valid:
-                self.cache[(M, N, K)] = op
+                self.cache[key] = op
                 return op
 
         op = min(ops, key=lambda i: i["runtime"])
-        self.cache[(M, N, K)] = op
+        self.cache[key] = op
+        self.profile_cache.insert(key, op)
         return op
 
     def profile(
@@ -16,6 +16,7 @@
 # under the License.
 # pylint: disable=invalid-name
 """Common functions and classes for CUTLASS GEMM and Conv2d geneator."""
+import json
 import logging
 import os
 import re
@@ -362,6 +363,65 @@ EPILOGUE_MAP = {
 }
 
 
+class ProfileCache:
+    """A persistent cache of the kernels selected by profiling, shared across builds.
+
+    The cache is a JSON file mapping a key, made of the target architecture, the problem shape
+    and the dtypes, to the name and the runtime of the best kernel. It is stored at the path
+    given by the TVM_CUTLASS_PROFILE_CACHE environment variable, or in the profiler binary
+    directory otherwise.
+    """
+
+    def __init__(self, binary_prefix):
+        self.path = os.environ.get(
+            "TVM_CUTLASS_PROFILE_CACHE", os.path.join(binary_prefix, "cutlass_profile_cache.json")
+        )
+        self.entries = self._load()
+
+    def _load(self):
+        try:
+            with open(self.path, "r") as f:
+                return json.load(f)
+        except (OSError, ValueError):
+            return {}
+
+    @staticmethod
+    def get_key(*fields):
+        return "/".join(str(field) for field in fields)
+
+    def lookup(self, key, ops):
+        """Return the op among the candidates ops that was recorded for key, or None."""
+        entry = self.entries.get(key)
+        if entry is None:
+            return None
+        for op in ops:
+            if op["name"] == entry["name"] and op.get("split_k_slices") == entry.get(
+                "split_k_slices"
+            ):
+                op["runtime"] = entry["runtime"]
+                return op
+        return None
+
+    def insert(self, key, op):
+        """Record op for key and save the cache, merging the entries written by other builds."""
+        if op["runtime"] == float("inf"):
+            return
+        self.entries = {**self._load(), **self.entries}
+        self.entries[key] = {
+            "name": op["name"],
+            "runtime": op["runtime"],
+            "split_k_slices": op.get("split_k_slices"),
+        }
+        directory = os.path.dirname(os.path.abspath(self.path))
+        try:
+            os.makedirs(directory, exist_ok=True)
+            with tempfile.NamedTemporaryFile("w", dir=directory, delete=False) as f:
+                json.dump(self.entries, f, indent=2, sort_keys=True)
+            os.replace(f.name, self.path)
+        except OSError as err:
+            logger.warning("Failed to save the CUTLASS profile cache to %s: %s", self.path, err)
+
+
 class ProfilerEngine:
     """Compile and run a given profiler executable."""
 
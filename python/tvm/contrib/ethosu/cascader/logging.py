@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """A class to hold logging information about the cascader"""
-from typing import Tuple
+from typing import List, Tuple
 import datetime
 import json
 import os
@@ -33,10 +33,33 @@ class Logging:
 
         self.selected_proposal_idx = -1
         self.proposals = {}
+        self.selected_plans = []
         self.cascader_runtime = 0
 
-    def add_proposal(self, idx: int, memory_usage: int, cycles: int):
-        self.proposals[idx] = {"memory_usage": memory_usage, "cycles": cycles}
+    def add_proposal(self, idx: int, memory_usage: int, cycles: int, dram_bytes: int = 0):
+        self.proposals[idx] = {
+            "memory_usage": memory_usage,
+            "cycles": cycles,
+            "dram_bytes": dram_bytes,
+        }
+
+    def add_selected_plan(
+        self,
+        num_parts: int,
+        memory_usage: int,
+        cycles: int,
+        stripe_shape: List[int],
+        output_region: str,
+    ):
+        self.selected_plans.append(
+            {
+                "num_parts": num_parts,
+                "memory_usage": memory_usage,
+                "cycles": cycles,
+                "stripe_shape": stripe_shape,
+                "output_region": output_region,
+            }
+        )
 
     def get_extreme_points(self) -> Tuple[int, int, int, int]:
         min_cycles, min_mem_usage = math.inf, math.inf
@@ -62,6 +85,7 @@ class Logging:
                         "min_memory_usage": min_mem_usage,
                         "max_memory_usage": max_mem_usage,
                         "selected_proposal": self.selected_proposal_idx,
+                        "selected_plans": self.selected_plans,
                         "proposals": self.proposals,
                     },
                     indent=2,
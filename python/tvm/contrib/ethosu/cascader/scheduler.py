@@ -211,14 +211,64 @@ def create_home_map(
     return home_map
 
 
+def get_dram_bytes(proposal: Proposal) -> int:
+    """Estimate the bytes a Proposal moves to and from memories other than the cascade region.
+
+    The estimate uses the performance model of the Parts: the bytes read from every input that
+    is homed outside the cascade region (including the reads of copies into it) and the bytes
+    written to every output that is stored outside of it.
+
+    Parameters
+    ----------
+    proposal : Proposal
+        The Proposal to estimate.
+
+    Returns
+    -------
+    int
+        The estimated number of bytes transferred.
+
+    """
+    dram_bytes = 0
+    for plan in proposal.plans:
+        for part in plan.part_group:
+            if not isinstance(part, EthosuPart):
+                continue
+            output_config = plan.tensor_configs[part.output_tensor]
+            perf_info = part.get_performance_info(
+                output_config.stripe_configs[0], output_config.buffer_mode
+            )
+            for i, input_tensor in enumerate(part.input_tensors):
+                if plan.tensor_configs[input_tensor].home_region != proposal.cascade_region:
+                    dram_bytes += int(perf_info.read_bytes[i])
+            if output_config.copy_region != proposal.cascade_region:
+                dram_bytes += int(perf_info.write_bytes)
+
+    return dram_bytes
+
+
 def choose_proposal(
-    proposals: List[Proposal], cascade_region: MemoryRegion, select_proposal_idx: int
+    proposals: List[Proposal],
+    cascade_region: MemoryRegion,
+    select_proposal_idx: int,
+    dram_weight: float = 0.0,
 ):
-    """Choose the best performing Proposal that doesn't overflow the cascade region."""
+    """Choose the best Proposal that doesn't overflow the cascade region.
+
+    Proposals are ranked by cycles plus dram_weight cycles for every byte estimated by
+    get_dram_bytes, so a positive weight trades extra cascade region usage for less
+    DRAM bandwidth. With the default weight of 0 the best performing Proposal is chosen.
+    """
     if select_proposal_idx != -1:
         # Manually select proposal based on index, take modulus the total number of proposals to
         # ensure that some proposal is always selected.
         proposal_choice = proposals[select_proposal_idx % len(proposals)]
+    elif dram_weight > 0:
+        fitting = [p for p in proposals if p.memory_usage < cascade_region.size]
+        proposal_choice = min(
+            fitting or proposals[:1],
+            key=lambda p: (p.cycles + dram_weight * get_dram_bytes(p), p.memory_usage),
+        )
     else:
         proposal_choice = proposals[0]
         for proposal in reversed(proposals):
@@ -308,6 +358,7 @@ def cascade(
         if tvmc_options and tvmc_options.dev_select_proposal_idx
         else -1
     )
+    dram_weight = float(tvmc_options.cascader_dram_weight) if tvmc_options else 0.0
 
     if log:
         start = time.time()
@@ -320,14 +371,26 @@ def cascade(
     # Generate Proposals for Pareto-optimal ways to cascade the CascaderGraph
     proposals = generate_proposals(casc_graph, home_map, options)
     # Select the best Proposal subject to the memory constraints
-    proposal_choice = choose_proposal(proposals, options.cascade_region, select_proposal_idx)
+    proposal_choice = choose_proposal(
+        proposals, options.cascade_region, select_proposal_idx, dram_weight
+    )
 
     if log:
         for idx, proposal in enumerate(proposals):
-            log.add_proposal(idx, proposal.memory_usage, proposal.cycles)
+            log.add_proposal(idx, proposal.memory_usage, proposal.cycles, get_dram_bytes(proposal))
             if proposal == proposal_choice:
                 log.selected_proposal_idx = idx
 
+        for plan in proposal_choice.plans:
+            output_config = plan.output_config
+            log.add_selected_plan(
+                len(plan.part_group),
+                int(plan.memory_usage),
+                int(plan.cycles),
+                [int(x) for x in output_config.stripe_configs[0].shape],
+                str(output_config.copy_region.name),
+            )
+
         log.cascader_runtime = time.time() - start
         log.dump_json()
 
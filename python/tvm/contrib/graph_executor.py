@@ -29,8 +29,9 @@ def create(graph_json_str, libmod, device):
 
     Parameters
     ----------
-    graph_json_str : str
-        The graph to be deployed in json format output by json graph.
+    graph_json_str : str or bytearray
+        The graph to be deployed in json format output by json graph,
+        or in the binary format given by encode_binary_graph.
         The graph can contain operator(tvm_op) that points to the name
         of PackedFunc in the libmod.
 
@@ -54,7 +55,7 @@ def create(graph_json_str, libmod, device):
     for examples to directly construct a GraphModule from an exported
     relay compiled library.
     """
-    assert isinstance(graph_json_str, string_types)
+    assert isinstance(graph_json_str, (string_types, bytes, bytearray))
 
     dev, num_rpc_dev, device_type_id = get_device(libmod, device)
 
@@ -66,6 +67,23 @@ def create(graph_json_str, libmod, device):
     return GraphModule(fcreate(graph_json_str, libmod, *device_type_id))
 
 
+def encode_binary_graph(graph_json_str):
+    """Encode a graph in the binary format, which the graph executor loads
+    in a single pass instead of parsing JSON.
+
+    Parameters
+    ----------
+    graph_json_str : str
+        The graph in json format.
+
+    Returns
+    -------
+    graph_binary : bytearray
+        The graph in the binary format, to be given to create.
+    """
+    return tvm._ffi.get_global_func("tvm.graph_executor.encode_binary_graph")(graph_json_str)
+
+
 def get_device(libmod, device):
     """Parse and validate all the device(s).
 
@@ -177,6 +195,7 @@ class GraphModule(object):
         self._get_num_inputs = module["get_num_inputs"]
         self._load_params = module["load_params"]
         self._share_params = module["share_params"]
+        self._load_params_mmap = module["load_params_mmap"]
 
     def set_input(self, key=None, value=None, **params):
         """Set inputs to the module via kwargs
@@ -341,6 +360,40 @@ class GraphModule(object):
 
         return shape_dict, dtype_dict
 
+    def set_inputs(self, inputs=None, pack_bytes=65536, **params):
+        """Set several inputs with a single synchronization.
+
+        The copies are issued asynchronously on a stream of the executor, and the host inputs
+        smaller than `pack_bytes` going to the same CUDA device are packed into a single host to
+        device transfer, which helps models with many small inputs.
+
+        Parameters
+        ----------
+        inputs : dict of str to NDArray
+            The input values by name, the names which are not inputs are ignored.
+
+        pack_bytes : int
+            The size under which the inputs are packed, 0 disables packing.
+
+        params : dict of str to NDArray
+            Additional input values.
+        """
+        inputs = dict(inputs or {}, **params)
+        inputs = {
+            k: v if isinstance(v, tvm.nd.NDArray) else tvm.nd.array(v) for k, v in inputs.items()
+        }
+        self.module["set_inputs"](inputs, pack_bytes)
+
+    def get_outputs(self):
+        """Copy all the outputs to the CPU with a single synchronization.
+
+        Returns
+        -------
+        outputs : list of NDArray
+            The copies of the outputs.
+        """
+        return list(self.module["get_outputs"]())
+
     def get_output(self, index, out=None):
         """Get index-th output to out
 
@@ -381,6 +434,20 @@ class GraphModule(object):
         """
         self._load_params(bytearray(params_bytes))
 
+    def load_params_from_mmap_file(self, path):
+        """Load parameters from a file saved by
+        :py:func:`tvm.runtime.save_param_dict_to_mmap_file`.
+
+        Parameters of CPU inputs are bound to views over the mapped file
+        instead of being copied, the others are copied to their device.
+
+        Parameters
+        ----------
+        path : str
+            The path to the parameter file.
+        """
+        self._load_params_mmap(path)
+
     def share_params(self, other, params_bytes):
         """Share parameters from pre-existing GraphExecutor instance.
 
@@ -394,6 +461,119 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def clone(self):
+        """Create an executor of the same graph for another thread.
+
+        The clone shares the graph, the compiled functions and the parameters
+        with this executor, and only allocates the storage of the activations,
+        so that each serving thread can run its own copy.
+
+        Returns
+        -------
+        graph_module : GraphModule
+            The new executor.
+        """
+        return GraphModule(self.module["clone"]())
+
+    def set_inter_op_parallelism(self, num_threads):
+        """Run independent operators of the graph concurrently on the CPU thread pool.
+
+        Each operator runs as soon as the operators it depends on are done, on one
+        of `num_threads` threads. The parallel loops of the operators then run on
+        their own thread, unless nested parallelism is enabled with
+        `runtime.config_threadpool_nested`, in which case they share the threads left
+        idle by the other branches. Graphs using other devices than the CPU always
+        run sequentially.
+
+        Parameters
+        ----------
+        num_threads : int
+            The number of operators run at the same time, 1 runs them in order.
+        """
+        self.module["set_inter_op_parallelism"](num_threads)
+
+    def set_l2_persisting_input(self, key, hit_ratio=1.0):
+        """Keep an input or a parameter in the L2 cache of the CUDA device during the runs.
+
+        The input is set as the L2 access policy window of the stream running the graph, so that
+        the kernels keep it in the persisting part of the L2 cache, e.g. weights reused by every
+        step of a decoding loop. A stream has a single window, so only one input is pinned at a
+        time. GPUs before Ampere ignore the window.
+
+        Parameters
+        ----------
+        key : int or str or None
+            The input to pin, or None to stop pinning.
+
+        hit_ratio : float
+            The fraction of the accesses to the input which persist in L2, in (0, 1].
+        """
+        self.module["set_l2_persisting_input"](-1 if key is None else key, hit_ratio)
+
+    def enable_weight_streaming(self, num_buffers=2):
+        """Keep the parameters in pinned host memory and stream them to the GPU during the runs.
+
+        The parameters planned on a CUDA or ROCm device are moved to page-locked host memory, and
+        their device storage is released. Each run copies the parameters of the next operators
+        into a ring of device buffers while the current operator computes, so that a model larger
+        than the device memory still runs, at the cost of the host to device bandwidth.
+
+        Parameters
+        ----------
+        num_buffers : int
+            The number of operators whose parameters are on the device at the same time, at
+            least 2. Each buffer holds the parameters of the largest operator.
+        """
+        self.module["enable_weight_streaming"](num_buffers)
+
+    def init_async(self, num_slots):
+        """Prepare the executor to serve several requests at the same time.
+
+        Each in-flight request gets its own storage set, driving thread and
+        device streams, while the parameters are shared. The input copy of
+        one request therefore overlaps with the compute of another.
+
+        Parameters
+        ----------
+        num_slots : int
+            The maximum number of requests executed concurrently.
+        """
+        self.module["init_async"](num_slots)
+
+    def enqueue(self, **input_dict):
+        """Queue a request, `init_async` must have been called before.
+
+        Parameters
+        ----------
+        input_dict: dict of str to NDArray
+            The inputs of the request.
+
+        Returns
+        -------
+        request_id : int
+            The id of the request to pass to `wait`.
+        """
+        inputs = {
+            k: v if isinstance(v, tvm.nd.NDArray) else tvm.nd.array(v)
+            for k, v in input_dict.items()
+        }
+        return self.module["enqueue"](inputs)
+
+    def wait(self, request_id):
+        """Wait for a queued request to finish.
+
+        Parameters
+        ----------
+        request_id : int
+            The id returned by `enqueue`.
+
+        Returns
+        -------
+        outputs : List[NDArray]
+            The outputs of the request. They are not reused by later requests.
+        """
+        return list(self.module["wait"](request_id))
+
     def __getitem__(self, key):
         """Get internal module function
 
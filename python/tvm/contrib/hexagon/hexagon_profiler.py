@@ -26,6 +26,7 @@ from tvm.contrib.hexagon.profiling.process_lwp_data import process_lwp_output
 from tvm.relay.backend.executor_factory import ExecutorFactoryModule
 from tvm.driver.build_module import OperatorModule
 from tvm.contrib import utils
+from tvm.runtime.profiling import Report
 
 
 class HexagonProfiler:
@@ -89,6 +90,29 @@ class HexagonProfiler:
     def get_remote_path(self):
         return self._remote_path
 
+    def get_report(self, hexagon_session, reset: bool = False) -> Report:
+        """Get the lightweight profiling data of the device as a profiling report.
+
+        Unlike get_profile_output, this needs neither the model .so nor the run log. Every
+        instrumented function and loop is named by its LWP id, with one row per call stack, and
+        the DMA and VTCM counters of the device are in the device metrics of "hexagon0".
+
+        Parameters
+        ----------
+        hexagon_session : Session
+            The session the profiled model ran in.
+
+        reset : bool
+            Whether to clear the LWP data and the DMA and VTCM counters of the device afterwards.
+
+        Returns
+        -------
+        report : Report
+            The report, with the same columns as tvm.runtime.profiling.lwp_report.
+        """
+        lwp_report = hexagon_session.get_function("tvm.hexagon.lwp_report")
+        return Report.from_json(lwp_report(reset))
+
     def get_profile_output(self, hexagon_launcher, hexagon_session):
         """Get runtime profiling data"""
         prof_out = hexagon_launcher.get_profile_output(self, hexagon_session)
@@ -0,0 +1,137 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""External function interface to the NCCL collectives between the local GPUs.
+
+The collectives run on a clique of local CUDA devices created by :py:func:`init`. Every
+collective has to be launched on all the devices of the clique, either from one thread per
+device, or from a single thread inside a :py:func:`group` block.
+"""
+import contextlib
+
+import tvm
+from tvm import te
+
+
+def init(device_ids):
+    """Create the NCCL communicators of a clique of local CUDA devices.
+
+    Parameters
+    ----------
+    device_ids : List[int]
+        The ids of the CUDA devices of the clique. The rank of a device is its index in the list.
+    """
+    tvm.get_global_func("tvm.contrib.nccl.init")(*device_ids)
+
+
+def size():
+    """Get the number of devices in the clique.
+
+    Returns
+    -------
+    size : int
+        The number of devices, or 0 if :py:func:`init` is not called yet.
+    """
+    return tvm.get_global_func("tvm.contrib.nccl.size")()
+
+
+@contextlib.contextmanager
+def group():
+    """Group the collectives launched from a single thread on several devices of the clique."""
+    tvm.get_global_func("tvm.contrib.nccl.group_start")()
+    try:
+        yield
+    finally:
+        tvm.get_global_func("tvm.contrib.nccl.group_end")()
+
+
+def allreduce(data, op="sum"):
+    """Create an extern op that reduces the tensor over all the devices of the clique
+
+    Parameters
+    ----------
+    data : Tensor
+        The tensor of the local device
+    op : str
+        The reduction, one of "sum", "prod", "max" and "min"
+
+    Returns
+    -------
+    out : Tensor
+        The reduced tensor, of the same shape as data.
+    """
+    return te.extern(
+        data.shape,
+        [data],
+        lambda ins, outs: tvm.tir.call_packed("tvm.contrib.nccl.allreduce", ins[0], outs[0], op),
+        dtype=data.dtype,
+        name="allreduce_nccl",
+    )
+
+
+def allgather(data, nranks):
+    """Create an extern op that concatenates the tensors of all the devices along the first axis
+
+    Parameters
+    ----------
+    data : Tensor
+        The tensor of the local device
+    nranks : int
+        The number of devices in the clique
+
+    Returns
+    -------
+    out : Tensor
+        The gathered tensor, whose first dimension is nranks times the one of data.
+    """
+    shape = [data.shape[0] * nranks] + list(data.shape[1:])
+    return te.extern(
+        shape,
+        [data],
+        lambda ins, outs: tvm.tir.call_packed("tvm.contrib.nccl.allgather", ins[0], outs[0]),
+        dtype=data.dtype,
+        name="allgather_nccl",
+    )
+
+
+def reduce_scatter(data, nranks, op="sum"):
+    """Create an extern op that reduces the tensor over all the devices, and scatters the result
+    along the first axis, so that each device gets its own slice
+
+    Parameters
+    ----------
+    data : Tensor
+        The tensor of the local device, whose first dimension is divisible by nranks
+    nranks : int
+        The number of devices in the clique
+    op : str
+        The reduction, one of "sum", "prod", "max" and "min"
+
+    Returns
+    -------
+    out : Tensor
+        The slice of the reduced tensor of the local device.
+    """
+    shape = [tvm.tir.indexdiv(data.shape[0], nranks)] + list(data.shape[1:])
+    return te.extern(
+        shape,
+        [data],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.nccl.reduce_scatter", ins[0], outs[0], op
+        ),
+        dtype=data.dtype,
+        name="reduce_scatter_nccl",
+    )
@@ -672,3 +672,311 @@ class PipelineConfig(object):
     def pipe_output(self, idx):
         # Return the output interface according to the name.
         return self.output_bindings[idx]
+
+
+def estimate_op_cost(call):
+    """Estimate the cost of a Relay call, used by 'auto_partition' by default.
+
+    The cost is the number of multiply-accumulates for the operators counted by
+    'relay.analysis.get_total_mac_number', plus the number of elements read and written.
+
+    Parameters
+    ----------
+    call : tvm.relay.Call
+        The type checked call.
+
+    Returns
+    -------
+    cost : float
+        The estimated cost, in arbitrary units.
+    """
+
+    def num_elements(ty):
+        if isinstance(ty, tvm.ir.TupleType):
+            return sum(num_elements(field) for field in ty.fields)
+        if isinstance(ty, tvm.ir.TensorType) and all(
+            isinstance(dim, tvm.tir.IntImm) for dim in ty.shape
+        ):
+            size = 1
+            for dim in ty.shape:
+                size *= int(dim)
+            return size
+        return 0
+
+    cost = num_elements(call.checked_type) + sum(num_elements(a.checked_type) for a in call.args)
+    if isinstance(call.op, tvm.ir.Op):
+        args = [relay.var(f"arg_{i}", a.checked_type) for i, a in enumerate(call.args)]
+        func = relay.Function(args, relay.Call(call.op, args, call.attrs, call.type_args))
+        func = InferType()(tvm.IRModule.from_expr(func))["main"]
+        cost += int(relay.analysis.get_total_mac_number(func))
+    return float(cost)
+
+
+def profile_op_cost(target, dev, number=10):
+    """Create a cost function timing each Relay call on a device, for 'auto_partition'.
+
+    Parameters
+    ----------
+    target : str or tvm.target.Target
+        The target to build each call for.
+
+    dev : tvm.runtime.Device
+        The device to run each call on.
+
+    number : int
+        The number of runs averaged for each call.
+
+    Returns
+    -------
+    cost_fn : Callable[[tvm.relay.Call], float]
+        The function returning the mean run time of a call in seconds.
+    """
+    # pylint: disable=import-outside-toplevel
+    from tvm.contrib import graph_executor
+
+    def cost_fn(call):
+        args = [relay.var(f"arg_{i}", a.checked_type) for i, a in enumerate(call.args)]
+        func = relay.Function(args, relay.Call(call.op, args, call.attrs, call.type_args))
+        with tvm.transform.PassContext(opt_level=3):
+            lib = relay.build(tvm.IRModule.from_expr(func), target=target)
+        module = graph_executor.GraphModule(lib["default"](dev))
+        return module.benchmark(dev, number=number, repeat=1).mean
+
+    return cost_fn
+
+
+def _balance_stages(costs, speeds, allowed):
+    """Split a sequence of costs into contiguous stages minimizing the slowest stage.
+
+    Parameters
+    ----------
+    costs : List[float]
+        The cost of each node, in order.
+
+    speeds : List[float]
+        The relative speed of each stage.
+
+    allowed : List[bool]
+        Whether a stage may start at each node, the first node excluded.
+
+    Returns
+    -------
+    starts : List[int]
+        The index of the first node of each stage.
+    """
+    num_nodes, num_stages = len(costs), len(speeds)
+    prefix = [0.0]
+    for cost in costs:
+        prefix.append(prefix[-1] + cost)
+    inf = float("inf")
+    # best[k][p] is the slowest stage of the best split of nodes[0:p] into k + 1 stages.
+    best = [[inf] * (num_nodes + 1) for _ in range(num_stages)]
+    prev = [[0] * (num_nodes + 1) for _ in range(num_stages)]
+    for p in range(1, num_nodes + 1):
+        best[0][p] = prefix[p] / speeds[0]
+    for k in range(1, num_stages):
+        for p in range(k + 1, num_nodes + 1):
+            for q in range(k, p):
+                if not allowed[q] or best[k - 1][q] == inf:
+                    continue
+                slowest = max(best[k - 1][q], (prefix[p] - prefix[q]) / speeds[k])
+                if slowest < best[k][p]:
+                    best[k][p] = slowest
+                    prev[k][p] = q
+    if best[num_stages - 1][num_nodes] == inf:
+        raise ValueError(f"The module can not be split into {num_stages} stages.")
+    starts = []
+    p = num_nodes
+    for k in range(num_stages - 1, 0, -1):
+        p = prev[k][p]
+        starts.insert(0, p)
+    return [0] + starts
+
+
+def auto_partition(mod, stages, params=None, cost_fn=None):
+    """Split a Relay module into pipeline stages of balanced cost, and connect them.
+
+    The operators of the "main" function are taken in dataflow order and split into
+    contiguous stages, so that the cost of the slowest stage, which bounds the pipeline
+    throughput, is minimal. The values a stage uses from the previous ones are forwarded
+    through the pipeline, stages are only split where all of these values are tensors.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module to split.
+
+    stages : List[Dict[str, Any]]
+        The configuration of each stage in order, with the keys "target" and "dev", and
+        optionally "cpu_affinity", and "speed", the relative speed of the stage used to
+        weight its cost, 1.0 by default.
+
+    params : Optional[Dict[str, NDArray]]
+        The parameters to bind into the module as constants before splitting it.
+
+    cost_fn : Optional[Callable[[tvm.relay.Call], float]]
+        The cost of each call, 'estimate_op_cost' by default. 'profile_op_cost' creates a
+        cost function measuring each call on a device.
+
+    Returns
+    -------
+    pipe_config : PipelineConfig
+        The configuration of the pipeline, ready for 'build'.
+
+    stage_costs : List[float]
+        The cost of each stage, weighted by its speed.
+    """
+    # pylint: disable=too-many-locals,too-many-branches
+    cost_fn = cost_fn or estimate_op_cost
+    func = mod["main"]
+    if params:
+        func = relay.build_module.bind_params_by_name(func, params)
+    functions = {gv: f for gv, f in mod.functions.items() if gv.name_hint != "main"}
+    mod = tvm.IRModule.from_expr(func, functions, mod.type_definitions)
+    func = InferType()(relay.transform.ToGraphNormalForm()(mod))["main"]
+
+    body = func.body
+    global_outputs = list(body.fields) if isinstance(body, relay.Tuple) else [body]
+    for value in global_outputs:
+        if not isinstance(value, (relay.Call, relay.TupleGetItem)) or not isinstance(
+            value.checked_type, tvm.ir.TensorType
+        ):
+            raise ValueError("The outputs of the module must be tensors computed by operators.")
+
+    def operands(node):
+        if isinstance(node, relay.Call):
+            return list(node.args)
+        if isinstance(node, relay.Tuple):
+            return list(node.fields)
+        if isinstance(node, relay.TupleGetItem):
+            return [node.tuple_value]
+        return []
+
+    # The non leaf nodes in dataflow order, without visiting the functions being called.
+    nodes, visited = [], set()
+    stack = [(value, False) for value in reversed(global_outputs)]
+    while stack:
+        value, expanded = stack.pop()
+        if expanded:
+            nodes.append(value)
+            continue
+        if value in visited or not operands(value) and not isinstance(value, relay.Call):
+            continue
+        visited.add(value)
+        stack.append((value, True))
+        stack.extend((arg, False) for arg in reversed(operands(value)))
+    if not nodes:
+        raise ValueError("The module has no operator to split.")
+    node_index = {node: i for i, node in enumerate(nodes)}
+
+    # A param belongs to the first node using it, and is forwarded from there.
+    first_user = {}
+    for i, node in enumerate(nodes):
+        for arg in operands(node):
+            if isinstance(arg, relay.Var) and arg not in first_user:
+                first_user[arg] = i
+
+    def home(value):
+        if isinstance(value, relay.Var):
+            return first_user[value]
+        return node_index[value]
+
+    # A stage may start at node p when every value defined before p and used from p on
+    # is a tensor.
+    last_use = {}
+    for i, node in enumerate(nodes):
+        for arg in operands(node):
+            if not isinstance(arg, relay.Constant):
+                last_use[arg] = i
+    for value in global_outputs:
+        last_use[value] = len(nodes)
+    crossing = [0] * (len(nodes) + 1)
+    for value, last in last_use.items():
+        if not isinstance(value.checked_type, tvm.ir.TensorType):
+            for p in range(home(value) + 1, last + 1):
+                crossing[p] += 1
+    allowed = [c == 0 for c in crossing]
+
+    costs = [cost_fn(node) if isinstance(node, relay.Call) else 0.0 for node in nodes]
+    speeds = [float(stage.get("speed", 1.0)) for stage in stages]
+    starts = _balance_stages(costs, speeds, allowed)
+    ends = starts[1:] + [len(nodes)]
+
+    def stage_of(value):
+        index = home(value)
+        return max(s for s, start in enumerate(starts) if start <= index)
+
+    # The values each stage takes from the previous ones, and gives to the next ones.
+    forwarded = [[] for _ in stages]
+    consumers = {}
+    for i, node in enumerate(nodes):
+        stage = stage_of(node)
+        for arg in operands(node):
+            if isinstance(arg, relay.Constant) or stage_of(arg) == stage:
+                continue
+            consumers.setdefault(arg, set())
+            if stage not in consumers[arg]:
+                consumers[arg].add(stage)
+                forwarded[stage].append(arg)
+    forward_names = {}
+    for value in consumers:
+        forward_names[value] = f"data_n_{len(forward_names)}"
+
+    stage_mods, stage_outputs = [], []
+    pipe_config = PipelineConfig()
+    for stage, (start, end) in enumerate(zip(starts, ends)):
+        memo = {}
+        inputs = []
+        for param in func.params:
+            if param in first_user and stage_of(param) == stage:
+                memo[param] = relay.var(param.name_hint, param.checked_type)
+                inputs.append(memo[param])
+        for value in forwarded[stage]:
+            memo[value] = relay.var(forward_names[value], value.checked_type)
+            inputs.append(memo[value])
+
+        def rebuild(value, memo=memo):
+            if isinstance(value, relay.Constant):
+                return value
+            return memo[value]
+
+        for node in nodes[start:end]:
+            if isinstance(node, relay.Call):
+                args = [rebuild(arg) for arg in node.args]
+                memo[node] = relay.Call(node.op, args, node.attrs, node.type_args, node.span)
+            elif isinstance(node, relay.Tuple):
+                memo[node] = relay.Tuple([rebuild(field) for field in node.fields], node.span)
+            else:
+                memo[node] = relay.TupleGetItem(rebuild(node.tuple_value), node.index)
+
+        outputs = [v for v in consumers if stage_of(v) == stage]
+        outputs += [v for v in global_outputs if stage_of(v) == stage and v not in outputs]
+        if not outputs:
+            raise ValueError(f"Stage {stage} computes nothing used by the pipeline.")
+        fields = [memo[v] for v in outputs]
+        stage_func = relay.Function(inputs, fields[0] if len(fields) == 1 else relay.Tuple(fields))
+        stage_mod = tvm.IRModule.from_expr(stage_func, functions, mod.type_definitions)
+        stage_mods.append(stage_mod)
+        stage_outputs.append(outputs)
+
+        pipe_config[stage_mod].target = stages[stage]["target"]
+        pipe_config[stage_mod].dev = stages[stage]["dev"]
+        pipe_config[stage_mod].cpu_affinity = stages[stage].get("cpu_affinity", "")
+
+    for stage, stage_mod in enumerate(stage_mods):
+        for param in stage_mod["main"].params:
+            if param.name_hint in forward_names.values():
+                continue
+            pipe_config["input"][param.name_hint].connect(
+                pipe_config[stage_mod]["input"][param.name_hint]
+            )
+        for output_idx, value in enumerate(stage_outputs[stage]):
+            output = pipe_config[stage_mod]["output"][output_idx]
+            for consumer in sorted(consumers.get(value, ())):
+                output.connect(pipe_config[stage_mods[consumer]]["input"][forward_names[value]])
+            for global_idx, global_value in enumerate(global_outputs):
+                if global_value == value:
+                    output.connect(pipe_config["output"][str(global_idx)])
+
+    stage_costs = [sum(costs[start:end]) / speed for start, end, speed in zip(starts, ends, speeds)]
+    return pipe_config, stage_costs
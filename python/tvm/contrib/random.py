@@ -112,4 +112,79 @@ def normal(loc, scale, size):
     )
 
 
+def philox_uniform(low, high, size, seed, offset=0):
+    """Draw samples from a uniform distribution with the counter-based Philox generator.
+
+    Unlike uniform, the samples only depend on (seed, offset) and their index, so the fill
+    runs in parallel and gives the same values on every thread count and on CUDA.
+
+    Parameters
+    ----------
+    low : float
+        Lower boundary of the output interval.
+    high : float
+        Upper boundary of the output interval.
+    size : tuple of ints
+        Output shape.
+    seed : int
+        The key of the random stream.
+    offset : int
+        The offset of the random stream, e.g. the step of a sampling loop.
+
+    Returns
+    -------
+    out : Tensor
+        A float32 tensor with specified size.
+    """
+    return te.extern(
+        size,
+        [],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.random.philox_uniform",
+            int(seed),
+            int(offset),
+            float(low),
+            float(high),
+            outs[0],
+        ),
+        dtype="float32",
+    )
+
+
+def philox_normal(loc, scale, size, seed, offset=0):
+    """Draw samples from a normal distribution with the counter-based Philox generator.
+
+    Parameters
+    ----------
+    loc : float
+        loc of the distribution.
+    scale : float
+        Standard deviation of the distribution.
+    size : tuple of ints
+        Output shape.
+    seed : int
+        The key of the random stream.
+    offset : int
+        The offset of the random stream, e.g. the step of a sampling loop.
+
+    Returns
+    -------
+    out : Tensor
+        A float32 tensor with specified size.
+    """
+    return te.extern(
+        size,
+        [],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.random.philox_normal",
+            int(seed),
+            int(offset),
+            float(loc),
+            float(scale),
+            outs[0],
+        ),
+        dtype="float32",
+    )
+
+
 tvm._ffi._init_api("tvm.contrib.random")
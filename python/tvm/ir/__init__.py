@@ -26,7 +26,9 @@ from .base import (
     SourceName,
     Span,
     assert_structural_equal,
+    configure_structural_hash_cache,
     load_json,
+    save_binary,
     save_json,
     structural_equal,
     structural_hash,
@@ -100,8 +100,8 @@ def load_json(json_str) -> Object:
 
     Parameters
     ----------
-    json_str : str
-        The json string
+    json_str : Union[str, bytes, bytearray]
+        The json string, or the bytes saved by save_binary.
 
     Returns
     -------
@@ -112,6 +112,8 @@ def load_json(json_str) -> Object:
     try:
         return _ffi_node_api.LoadJSON(json_str)
     except tvm.error.TVMError:
+        if not isinstance(json_str, str):
+            raise
         json_str = json_compact.upgrade_json(json_str)
         return _ffi_node_api.LoadJSON(json_str)
 
@@ -132,6 +134,25 @@ def save_json(node) -> str:
     return _ffi_node_api.SaveJSON(node)
 
 
+def save_binary(node) -> bytearray:
+    """Save tvm object in a compact binary format, which load_json detects and loads.
+
+    The binary format holds the same object graph as save_json, with a table of the strings,
+    varint indices and raw NDArray data, so that it is smaller and faster to load.
+
+    Parameters
+    ----------
+    node : Object
+        A TVM object to be saved.
+
+    Returns
+    -------
+    blob : bytearray
+        The saved bytes.
+    """
+    return _ffi_node_api.SaveBinary(node)
+
+
 def structural_equal(lhs, rhs, map_free_vars=False):
     """Check structural equality of lhs and rhs.
 
@@ -284,6 +305,21 @@ def structural_hash(node, map_free_vars=False):
     return _ffi_node_api.StructuralHash(node, map_free_vars)  # type: ignore # pylint: disable=no-member
 
 
+def configure_structural_hash_cache(max_size=4096):
+    """Configure the memo of the structural hashes of IRModules and functions.
+
+    When enabled, the structural hash of an IRModule or a function is computed once and reused
+    until the object is modified, which replaces it or its function map by a copy. The memo
+    keeps the hashed objects alive until it is full, when it is cleared.
+
+    Parameters
+    ----------
+    max_size : int
+        The maximum number of objects kept in the memo, 0 to disable it.
+    """
+    _ffi_node_api.ConfigureStructuralHashCache(max_size)  # type: ignore # pylint: disable=no-member
+
+
 def deprecated(
     method_name: str,
     new_method_name: str,
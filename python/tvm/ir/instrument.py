@@ -18,6 +18,9 @@
 """Common pass instrumentation across IR variants."""
 import inspect
 import functools
+import json
+import time
+import warnings
 
 import tvm._ffi
 import tvm.runtime
@@ -255,3 +258,120 @@ class PassTimingInstrument(tvm.runtime.Object):
                 profiles = timing_inst.render()
         """
         return _ffi_instrument_api.RenderTimePassProfiles()
+
+
+def _peak_rss_kb():
+    """The peak resident set size of the process in KB, or 0 if it cannot be read."""
+    try:
+        import resource  # pylint: disable=import-outside-toplevel
+    except ImportError:
+        return 0
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+
+
+def _ir_size(mod):
+    """The number of expression and statement nodes in the functions of a module."""
+    from tvm import relay, tir  # pylint: disable=import-outside-toplevel
+
+    count = [0]
+
+    def _visit(_):
+        count[0] += 1
+
+    for func in mod.functions.values():
+        if isinstance(func, tir.PrimFunc):
+            tir.stmt_functor.post_order_visit(func.body, _visit)
+        elif isinstance(func, relay.Function):
+            relay.analysis.post_order_visit(func, _visit)
+    return count[0]
+
+
+@pass_instrument
+class PassProfileInstrument:
+    """A pass instrument recording the wall time, the peak RSS delta and the IR size of each pass
+    invocation, which can be dumped to JSON and checked against budgets.
+
+    Each record is a dict with the keys ``name``, ``depth`` (the nesting level of the pass),
+    ``time_ms``, ``peak_rss_delta_kb`` (the growth of the peak resident set size of the process
+    during the pass), ``ir_size_before``, ``ir_size_after`` and ``ir_size_growth`` (the ratio of
+    the two). The IR sizes are the numbers of expression and statement nodes of the module.
+    Records are appended when the passes finish, so that nested passes precede their parent.
+
+    Parameters
+    ----------
+    output_path : Optional[str]
+        The JSON file the records are written to when exiting the PassContext.
+
+    budgets : Optional[Dict[str, Dict[str, float]]]
+        The budgets of the passes, from the pass name, or "*" for all passes, to the limits of
+        the record keys, e.g. ``{"FoldConstant": {"time_ms": 100, "ir_size_growth": 2.0}}``.
+        A warning is raised for each record exceeding a limit.
+
+    count_ir_nodes : bool
+        Whether to count the IR nodes, which visits the whole module around every pass.
+
+    Examples
+    --------
+
+    .. code-block:: python
+
+        profile = PassProfileInstrument("passes.json", budgets={"*": {"time_ms": 1000}})
+        with tvm.transform.PassContext(instruments=[profile]):
+            mod = relay.transform.FoldConstant()(mod)
+        print(profile.records)
+    """
+
+    def __init__(self, output_path=None, budgets=None, count_ir_nodes=True):
+        self.output_path = output_path
+        self.budgets = budgets or {}
+        self.count_ir_nodes = count_ir_nodes
+        self.records = []
+        self._stack = []
+
+    def enter_pass_ctx(self):
+        self.records = []
+        self._stack = []
+
+    def exit_pass_ctx(self):
+        if self.output_path is not None:
+            self.dump(self.output_path)
+
+    def run_before_pass(self, mod, info):
+        ir_size = _ir_size(mod) if self.count_ir_nodes else None
+        self._stack.append((time.perf_counter(), _peak_rss_kb(), ir_size))
+
+    def run_after_pass(self, mod, info):
+        start, peak_rss, ir_size_before = self._stack.pop()
+        record = {
+            "name": info.name,
+            "depth": len(self._stack),
+            "time_ms": (time.perf_counter() - start) * 1000.0,
+            "peak_rss_delta_kb": _peak_rss_kb() - peak_rss,
+        }
+        if self.count_ir_nodes:
+            ir_size_after = _ir_size(mod)
+            record["ir_size_before"] = ir_size_before
+            record["ir_size_after"] = ir_size_after
+            record["ir_size_growth"] = ir_size_after / max(ir_size_before, 1)
+        self.records.append(record)
+        self._check_budgets(record)
+
+    def _check_budgets(self, record):
+        for pass_name in ("*", record["name"]):
+            for key, limit in self.budgets.get(pass_name, {}).items():
+                value = record.get(key, None)
+                if value is not None and value > limit:
+                    warnings.warn(
+                        f"Pass {record['name']} exceeds its budget of {key}: {value} > {limit}"
+                    )
+
+    def dump(self, path):
+        """Write the records to a JSON file
+
+        Parameters
+        ----------
+        path : str
+            The path to the JSON file.
+        """
+        with open(path, "w") as f:
+            json.dump(self.records, f, indent=2)
@@ -20,4 +20,5 @@ Meta Schedule builders that translate IRModule to runtime.Module,
 and then export
 """
 from .builder import Builder, BuilderInput, BuilderResult, PyBuilder, create
+from .in_memory_builder import InMemoryBuilder
 from .local_builder import LocalBuilder
@@ -130,7 +130,7 @@ class Builder(Object):
 
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
-        kind: Literal["local"] = "local",
+        kind: Literal["local", "in_memory"] = "local",
         *args,
         **kwargs,
     ) -> "Builder":
@@ -138,18 +138,23 @@ class Builder(Object):
 
         Parameters
         ----------
-        kind : Literal["local"]
-            The kind of the builder. For now, only "local" is supported.
+        kind : Literal["local", "in_memory"]
+            The kind of the builder.
 
         Returns
         -------
         builder : Builder
             The builder created.
         """
-        from . import LocalBuilder  # pylint: disable=import-outside-toplevel
+        from . import (  # pylint: disable=import-outside-toplevel
+            InMemoryBuilder,
+            LocalBuilder,
+        )
 
         if kind == "local":
             return LocalBuilder(*args, **kwargs)  # type: ignore
+        elif kind == "in_memory":
+            return InMemoryBuilder(*args, **kwargs)  # type: ignore
         raise ValueError(f"Unknown Builder: {kind}")
 
 
@@ -0,0 +1,115 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Builder that keeps the built modules in the memory of the current process"""
+import itertools
+import threading
+from concurrent.futures import ThreadPoolExecutor
+from typing import Dict, List, Optional, Union
+
+from tvm.runtime import Module
+
+from ..logging import get_logger
+from ..utils import cpu_count, derived_object, get_global_func_with_default_on_worker
+from .builder import BuilderInput, BuilderResult, PyBuilder
+from .local_builder import T_BUILD, default_build
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+IN_MEMORY_ARTIFACT_PREFIX = "memory:"
+
+_ARTIFACTS: Dict[str, Module] = {}
+_ARTIFACTS_LOCK = threading.Lock()
+_ARTIFACT_IDS = itertools.count()
+
+
+def add_in_memory_artifact(mod: Module) -> str:
+    """Keep a built module in memory, and return the artifact path referring to it."""
+    with _ARTIFACTS_LOCK:
+        artifact_path = IN_MEMORY_ARTIFACT_PREFIX + str(next(_ARTIFACT_IDS))
+        _ARTIFACTS[artifact_path] = mod
+    return artifact_path
+
+
+def get_in_memory_artifact(artifact_path: str) -> Module:
+    """Get the module referred to by an artifact path of InMemoryBuilder."""
+    with _ARTIFACTS_LOCK:
+        mod = _ARTIFACTS.get(artifact_path, None)
+    if mod is None:
+        raise ValueError(
+            f"The artifact {artifact_path} is not in the memory of this process. "
+            "InMemoryBuilder must be used with a runner in the same process, e.g. InMemoryRunner"
+        )
+    return mod
+
+
+def remove_in_memory_artifact(artifact_path: str) -> None:
+    """Release the module referred to by an artifact path of InMemoryBuilder."""
+    with _ARTIFACTS_LOCK:
+        _ARTIFACTS.pop(artifact_path, None)
+
+
+@derived_object
+class InMemoryBuilder(PyBuilder):
+    """A builder that builds the given input in the current process, and keeps the built module in
+    memory instead of exporting it to a file.
+
+    The artifact paths it returns start with "memory:" and only make sense in the current process,
+    so that it must be paired with a runner in the same process, e.g. InMemoryRunner. The modules
+    are released by `meta_schedule.remove_build_dir`, as the files of LocalBuilder are.
+
+    Compared to LocalBuilder, it saves the startup of the worker processes, the export, and the
+    reloading of the module by the runner, which dominate the measurement of small kernels. Unlike
+    LocalBuilder, a build cannot be interrupted by a timeout, nor can a crash of the compiler be
+    isolated from the tuning process.
+
+    Parameters
+    ----------
+    max_workers: Optional[int]
+        The number of threads building concurrently. Defaults to the number of CPUs.
+    f_build : Union[None, str, T_BUILD]
+        Name of the build function to be used, or the function itself.
+        Defaults to `meta_schedule.builder.default_build`.
+    """
+
+    max_workers: int
+    f_build: Union[None, str, T_BUILD]
+
+    def __init__(
+        self,
+        *,
+        max_workers: Optional[int] = None,
+        f_build: Union[None, str, T_BUILD] = None,
+    ) -> None:
+        super().__init__()
+        if max_workers is None:
+            max_workers = cpu_count(logical=True)
+        logger.info("InMemoryBuilder: max_workers = %d", max_workers)
+        self.max_workers = max_workers
+        self.f_build = f_build
+        # Persist across the calls to `build`, as the threads do not leak like popen workers
+        self._pool = ThreadPoolExecutor(max_workers=max_workers)
+
+    def _build_one(self, build_input: BuilderInput) -> BuilderResult:
+        f_build: T_BUILD = get_global_func_with_default_on_worker(self.f_build, default_build)
+        try:
+            rt_mod: Module = f_build(build_input.mod, build_input.target, build_input.params)
+        except Exception as exception:  # pylint: disable=broad-except
+            return BuilderResult(None, "InMemoryBuilder: An exception occurred\n" + str(exception))
+        return BuilderResult(add_in_memory_artifact(rt_mod), None)
+
+    def build(self, build_inputs: List[BuilderInput]) -> List[BuilderResult]:
+        return list(self._pool.map(self._build_one, build_inputs))
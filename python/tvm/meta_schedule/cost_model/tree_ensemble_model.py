@@ -0,0 +1,55 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A cost model scoring candidates natively with a pre-trained tree ensemble"""
+from typing import Optional
+
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..feature_extractor import FeatureExtractor, PerStoreFeature
+from .cost_model import CostModel
+
+
+@register_object("meta_schedule.TreeEnsembleCostModel")
+class TreeEnsembleModel(CostModel):
+    """A cost model scoring candidates with a pre-trained tree ensemble in C++.
+
+    The candidates are scored in parallel, using the number of threads of the tuning context,
+    without calling back into python. The model is inference-only, so that `update` is a no-op.
+
+    Parameters
+    ----------
+    path : Optional[str]
+        The path to the tree ensemble, an XGBoost model saved in JSON, e.g. by
+        `XGBModel.save_tree_ensemble`. If not specified, the model has to be loaded by `load`.
+    extractor : Optional[FeatureExtractor]
+        The feature extractor that the tree ensemble is trained with. Defaults to PerStoreFeature.
+    """
+
+    def __init__(
+        self,
+        path: Optional[str] = None,
+        *,
+        extractor: Optional[FeatureExtractor] = None,
+    ) -> None:
+        if extractor is None:
+            extractor = PerStoreFeature()
+        self.__init_handle_by_constructor__(
+            _ffi_api.CostModelTreeEnsembleCostModel,  # type: ignore # pylint: disable=no-member
+            extractor,
+            path,
+        )
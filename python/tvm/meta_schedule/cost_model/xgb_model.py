@@ -444,6 +444,21 @@ class XGBModel(PyCostModel):
             tar(path, [x for x in [model_path, data_path] if x is not None])
             logger.info("Saved XGBModel to %s", path)
 
+    def save_tree_ensemble(self, path: str) -> None:
+        """Save the trained booster alone in JSON, to be loaded by TreeEnsembleModel.
+
+        Parameters
+        ----------
+        path : str
+            The file path.
+        """
+        if self.booster is None:
+            raise ValueError("XGBModel has not been trained yet")
+        # XGBoost picks the format from the extension of the file
+        if not path.endswith(".json"):
+            raise ValueError(f"The path to the tree ensemble must end with .json, but gets: {path}")
+        self.booster.save_model(path)
+
     def update(
         self,
         context: "TuneContext",
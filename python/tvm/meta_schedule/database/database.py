@@ -380,7 +380,9 @@ class Database(Object):
         kind: Union[
             Literal[
                 "json",
+                "binary",
                 "memory",
+                "rpc",
                 "union",
                 "ordered_union",
             ],
@@ -393,10 +395,11 @@ class Database(Object):
 
         Parameters
         ----------
-        kind : str = "json" | "memory" | "union" | "ordered_union" | Callable[[tvm.tir.Schedule],
-        bool]
+        kind : str = "json" | "binary" | "memory" | "rpc" | "union" | "ordered_union" |
+        Callable[[tvm.tir.Schedule], bool]
             The kind of the database to be created. The following kinds are supported:
-            "json", "memory", "union", "ordered_union", and a custom schedule function.
+            "json", "binary", "memory", "rpc", "union", "ordered_union", and a custom schedule
+            function.
 
         Returns
         -------
@@ -404,9 +407,11 @@ class Database(Object):
             The created database.
         """
         from . import (  # pylint: disable=import-outside-toplevel
+            BinaryDatabase,
             JSONDatabase,
             MemoryDatabase,
             OrderedUnionDatabase,
+            RPCDatabase,
             ScheduleFnDatabase,
             UnionDatabase,
         )
@@ -415,8 +420,12 @@ class Database(Object):
             return ScheduleFnDatabase(kind, *args, **kwargs)  # type: ignore
         if kind == "json":
             return JSONDatabase(*args, **kwargs)
+        if kind == "binary":
+            return BinaryDatabase(*args, **kwargs)  # type: ignore
         if kind == "memory":
             return MemoryDatabase(*args, **kwargs)  # type: ignore
+        if kind == "rpc":
+            return RPCDatabase(*args, **kwargs)  # type: ignore
         if kind == "union":
             return UnionDatabase(*args, **kwargs)  # type: ignore
         if kind == "ordered_union":
@@ -0,0 +1,301 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A database shared by several tuning processes over the TVM RPC protocol.
+
+The server side wraps any existing database, e.g. a JSONDatabase, and serves it to every
+connected client from a single process, so that a tuning record committed by a machine is
+visible to all the others during their search. Workloads and tuning records travel as JSON
+strings, the same format used by JSONDatabase.
+"""
+import json
+import logging
+import socket
+import struct
+import threading
+import time
+from typing import Dict, List, Optional, Tuple
+
+import tvm._ffi
+from tvm import rpc
+from tvm._ffi.base import py_str
+from tvm.ir import IRModule
+from tvm.rpc import _ffi_api as _rpc_ffi_api
+from tvm.rpc import base as rpc_base
+
+from ..utils import derived_object
+from .database import Database, PyDatabase, TuningRecord, Workload
+
+logger = logging.getLogger(__name__)  # pylint: disable=invalid-name
+
+_FUNC_PREFIX = "meta_schedule.rpc_database."
+
+
+def _dumps(obj) -> str:
+    return json.dumps(obj.as_json())
+
+
+class RPCDatabaseServer:
+    """Serve a database to RPCDatabase clients.
+
+    The connections are served by threads of the current process, which all share the same
+    database, and the accesses to the database are serialized by a lock. As the remote functions
+    are registered globally, only one server can run in a process.
+
+    Parameters
+    ----------
+    database : Database
+        The database to be served.
+    host : str
+        The host address to listen on.
+    port : int
+        The first port to try to listen on.
+    port_end : int
+        The port after the last port to try to listen on.
+    key : str
+        The key that the clients must present.
+    """
+
+    def __init__(
+        self,
+        database: Database,
+        host: str = "0.0.0.0",
+        port: int = 9190,
+        port_end: int = 9290,
+        key: str = "",
+    ) -> None:
+        self.database = database
+        self.key = key
+        self._lock = threading.Lock()
+        # JSON string of a workload => the same workload in `database`
+        self._workloads: Dict[str, Workload] = {}
+        self._sock = socket.socket(rpc_base.get_addr_family((host, port)), socket.SOCK_STREAM)
+        self._sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        for my_port in range(port, port_end):
+            try:
+                self._sock.bind((host, my_port))
+                self.port = my_port
+                break
+            except socket.error as sock_err:
+                if sock_err.errno not in (98, 48, 10098):  # Address in use
+                    raise sock_err
+        else:
+            raise ValueError("cannot bind to any port in [%d, %d)" % (port, port_end))
+        self._sock.listen(128)
+        self._register_funcs()
+        self._thread = threading.Thread(target=self._listen_loop, daemon=True)
+        self._thread.start()
+        logger.info("RPCDatabaseServer bind to %s:%d", host, self.port)
+
+    def _workload(self, workload_json: str, commit: bool) -> Optional[Workload]:
+        """Get the workload of `database` equal to the given one, committing it if needed."""
+        workload = self._workloads.get(workload_json, None)
+        if workload is None:
+            mod = Workload.from_json(json.loads(workload_json)).mod
+            if not commit and not self.database.has_workload(mod):
+                return None
+            workload = self.database.commit_workload(mod)
+            self._workloads[workload_json] = workload
+        return workload
+
+    def _register_funcs(self) -> None:
+        @tvm._ffi.register_func(_FUNC_PREFIX + "has_workload", override=True)
+        def has_workload(workload_json: str) -> bool:
+            with self._lock:
+                return self._workload(workload_json, commit=False) is not None
+
+        @tvm._ffi.register_func(_FUNC_PREFIX + "commit_workload", override=True)
+        def commit_workload(workload_json: str) -> None:
+            with self._lock:
+                self._workload(workload_json, commit=True)
+
+        @tvm._ffi.register_func(_FUNC_PREFIX + "commit_tuning_record", override=True)
+        def commit_tuning_record(workload_json: str, record_json: str) -> None:
+            with self._lock:
+                workload = self._workload(workload_json, commit=True)
+                record = TuningRecord.from_json(json.loads(record_json), workload)
+                self.database.commit_tuning_record(record)
+
+        @tvm._ffi.register_func(_FUNC_PREFIX + "get_top_k", override=True)
+        def get_top_k(workload_json: str, top_k: int) -> str:
+            with self._lock:
+                workload = self._workload(workload_json, commit=False)
+                if workload is None:
+                    return "[]"
+                records = self.database.get_top_k(workload, top_k)
+            return json.dumps([record.as_json() for record in records])
+
+        @tvm._ffi.register_func(_FUNC_PREFIX + "get_all_tuning_records", override=True)
+        def get_all_tuning_records() -> str:
+            with self._lock:
+                records = self.database.get_all_tuning_records()
+            # The workloads are sent once, and referred to by their index
+            workloads: Dict[Workload, int] = {}
+            workload_jsons: List = []
+            record_jsons: List = []
+            for record in records:
+                if record.workload not in workloads:
+                    workloads[record.workload] = len(workload_jsons)
+                    workload_jsons.append(record.workload.as_json())
+                record_jsons.append([workloads[record.workload], record.as_json()])
+            return json.dumps([workload_jsons, record_jsons])
+
+        @tvm._ffi.register_func(_FUNC_PREFIX + "size", override=True)
+        def size() -> int:
+            with self._lock:
+                return len(self.database)
+
+    def _accept(self) -> Optional[socket.socket]:
+        """Accept a connection and do the handshake of the RPC protocol."""
+        conn, addr = self._sock.accept()
+        magic = struct.unpack("<i", rpc_base.recvall(conn, 4))[0]
+        if magic != rpc_base.RPC_MAGIC:
+            conn.close()
+            return None
+        keylen = struct.unpack("<i", rpc_base.recvall(conn, 4))[0]
+        key = py_str(rpc_base.recvall(conn, keylen))
+        if key.split()[0] != "client:" + self.key:
+            conn.sendall(struct.pack("<i", rpc_base.RPC_CODE_MISMATCH))
+            conn.close()
+            logger.warning("mismatch key from %s", addr)
+            return None
+        server_key = "server:" + self.key
+        conn.sendall(struct.pack("<i", rpc_base.RPC_CODE_SUCCESS))
+        conn.sendall(struct.pack("<i", len(server_key)))
+        conn.sendall(server_key.encode("utf-8"))
+        logger.info("connection from %s", addr)
+        return conn
+
+    def _listen_loop(self) -> None:
+        while True:
+            try:
+                conn = self._accept()
+            except (socket.error, IOError):
+                if self._sock.fileno() == -1:
+                    return
+                continue
+            if conn is not None:
+                # The socket is owned, and closed, by the server loop
+                threading.Thread(
+                    target=_rpc_ffi_api.ServerLoop, args=(conn.detach(),), daemon=True
+                ).start()
+
+    def terminate(self) -> None:
+        """Stop accepting new connections."""
+        self._sock.close()
+
+    def __del__(self) -> None:
+        self.terminate()
+
+
+@derived_object
+class RPCDatabase(PyDatabase):
+    """A database served by an RPCDatabaseServer, possibly on another machine.
+
+    The results of `get_top_k` are cached for `cache_seconds`, unless a tuning record of the
+    same workload is committed by this client in the meantime.
+
+    Parameters
+    ----------
+    host : str
+        The host address of the server.
+    port : int
+        The port of the server.
+    key : str
+        The key of the server.
+    session_timeout : float
+        The duration of the session in seconds, zero meaning no timeout.
+    cache_seconds : float
+        How long the results of `get_top_k` are cached.
+    """
+
+    def __init__(
+        self,
+        host: str,
+        port: int,
+        key: str = "",
+        session_timeout: float = 0,
+        cache_seconds: float = 1.0,
+    ) -> None:
+        super().__init__()
+        self.session = rpc.connect(host, port, key, session_timeout=session_timeout)
+        self.cache_seconds = cache_seconds
+        self._lock = threading.Lock()
+        self._f_has_workload = self.session.get_function(_FUNC_PREFIX + "has_workload")
+        self._f_commit_workload = self.session.get_function(_FUNC_PREFIX + "commit_workload")
+        self._f_commit_tuning_record = self.session.get_function(
+            _FUNC_PREFIX + "commit_tuning_record"
+        )
+        self._f_get_top_k = self.session.get_function(_FUNC_PREFIX + "get_top_k")
+        self._f_get_all_tuning_records = self.session.get_function(
+            _FUNC_PREFIX + "get_all_tuning_records"
+        )
+        self._f_size = self.session.get_function(_FUNC_PREFIX + "size")
+        # The JSON string of each workload
+        self._workload_jsons: Dict[Workload, str] = {}
+        # workload => (time of query, top_k, records)
+        self._top_k_cache: Dict[Workload, Tuple[float, int, List[TuningRecord]]] = {}
+
+    def _workload_json(self, workload: Workload) -> str:
+        result = self._workload_jsons.get(workload, None)
+        if result is None:
+            result = self._workload_jsons[workload] = _dumps(workload)
+        return result
+
+    def has_workload(self, mod: IRModule) -> bool:
+        with self._lock:
+            return bool(self._f_has_workload(_dumps(Workload(mod))))
+
+    def commit_workload(self, mod: IRModule) -> Workload:
+        workload = Workload(mod)
+        with self._lock:
+            self._f_commit_workload(self._workload_json(workload))
+        return workload
+
+    def commit_tuning_record(self, record: TuningRecord) -> None:
+        with self._lock:
+            self._f_commit_tuning_record(self._workload_json(record.workload), _dumps(record))
+            self._top_k_cache.pop(record.workload, None)
+
+    def get_top_k(self, workload: Workload, top_k: int) -> List[TuningRecord]:
+        if top_k < 0:
+            raise ValueError("top_k must be non-negative")
+        with self._lock:
+            cached = self._top_k_cache.get(workload, None)
+            now = time.monotonic()
+            if cached is not None and now - cached[0] < self.cache_seconds and cached[1] >= top_k:
+                return cached[2][:top_k]
+            records = [
+                TuningRecord.from_json(record_json, workload)
+                for record_json in json.loads(
+                    self._f_get_top_k(self._workload_json(workload), top_k)
+                )
+            ]
+            self._top_k_cache[workload] = (now, top_k, records)
+            return records
+
+    def get_all_tuning_records(self) -> List[TuningRecord]:
+        with self._lock:
+            workload_jsons, record_jsons = json.loads(self._f_get_all_tuning_records())
+        workloads = [Workload.from_json(workload_json) for workload_json in workload_jsons]
+        return [
+            TuningRecord.from_json(record_json, workloads[workload_idx])
+            for workload_idx, record_json in record_jsons
+        ]
+
+    def __len__(self) -> int:
+        with self._lock:
+            return int(self._f_size())
@@ -38,6 +38,9 @@ class PerStoreFeature(FeatureExtractor):
         The number of bytes in a cache line.
     extract_workload : bool
         Whether to extract features in the workload in tuning context or not.
+    max_cache_size : int
+        The maximum number of candidates whose features are cached, keyed by their structural
+        hash. Non-positive values disable the cache.
     """
 
     buffers_per_store: int
@@ -50,6 +53,8 @@ class PerStoreFeature(FeatureExtractor):
     """Whether to extract features in the workload in tuning context or not."""
     feature_vector_length: int
     """Length of the feature vector."""
+    max_cache_size: int
+    """The maximum number of candidates whose features are cached."""
 
     def __init__(
         self,
@@ -57,6 +62,7 @@ class PerStoreFeature(FeatureExtractor):
         arith_intensity_curve_num_samples: int = 10,
         cache_line_bytes: int = 64,
         extract_workload: bool = False,
+        max_cache_size: int = 1024,
     ):
         self.__init_handle_by_constructor__(
             _ffi_api.FeatureExtractorPerStoreFeature,  # type: ignore # pylint: disable=no-member
@@ -64,4 +70,5 @@ class PerStoreFeature(FeatureExtractor):
             arith_intensity_curve_num_samples,
             cache_line_bytes,
             extract_workload,
+            max_cache_size,
         )
@@ -18,4 +18,5 @@
 from .add_to_database import AddToDatabase
 from .measure_callback import MeasureCallback, PyMeasureCallback
 from .remove_build_artifact import RemoveBuildArtifact
+from .stop_on_convergence import StopOnConvergence
 from .update_cost_model import UpdateCostModel
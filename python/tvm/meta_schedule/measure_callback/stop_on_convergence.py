@@ -0,0 +1,60 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A measure callback that stops tuning the tasks that converge"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .measure_callback import MeasureCallback
+
+
+@register_object("meta_schedule.StopOnConvergence")
+class StopOnConvergence(MeasureCallback):
+    """A measure callback that stops tuning a task early once it converges, so that the rest of
+    the global trial budget goes to the tasks that still improve.
+
+    It should be placed before `UpdateCostModel` in the list of measure callbacks, so that the
+    prediction error is measured on candidates the cost model has not been trained on.
+
+    Parameters
+    ----------
+    patience : int
+        The number of trials without improvement of the best latency after which a task is
+        stopped. Non-positive values disable the check.
+    min_improvement : float
+        The relative decrease of the best latency counted as an improvement.
+    max_prediction_error : float
+        If positive, a plateau only stops a task when the cost model mis-ranks at most this
+        fraction of the pairs of candidates in the last measured batch.
+    max_seconds_per_task : float
+        The wall-clock budget of each task in seconds, counted from its first measured batch.
+        Non-positive values disable the check.
+    """
+
+    def __init__(
+        self,
+        patience: int = 256,
+        min_improvement: float = 0.01,
+        max_prediction_error: float = 0.0,
+        max_seconds_per_task: float = 0.0,
+    ) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.MeasureCallbackStopOnConvergence,  # type: ignore # pylint: disable=no-member
+            patience,
+            min_improvement,
+            max_prediction_error,
+            max_seconds_per_task,
+        )
@@ -42,6 +42,21 @@ class Profiler(Object):
         """Get the profiling results in a table format"""
         return _ffi_api.ProfilerTable(self)  # type: ignore # pylint: disable=no-member
 
+    def chrome_trace(self) -> str:
+        """Get the timeline of the timed scopes on all the threads, in the Chrome trace event
+        format, which can be loaded by chrome://tracing or https://ui.perfetto.dev"""
+        return _ffi_api.ProfilerChromeTrace(self)  # type: ignore # pylint: disable=no-member
+
+    def export_chrome_trace(self, path: str) -> None:
+        """Write the timeline of the timed scopes to a JSON file in the Chrome trace event format"""
+        with open(path, "w", encoding="utf-8") as o_f:
+            o_f.write(self.chrome_trace())
+
+    def flame_graph(self) -> str:
+        """Get the exclusive time in microseconds of each stack of timed scopes, in the folded
+        format read by flame graph tools, e.g. flamegraph.pl or https://www.speedscope.app"""
+        return _ffi_api.ProfilerFlameGraph(self)  # type: ignore # pylint: disable=no-member
+
     def __enter__(self) -> "Profiler":
         """Entering the scope of the context manager"""
         _ffi_api.ProfilerEnterWithScope(self)  # type: ignore # pylint: disable=no-member
@@ -27,7 +27,7 @@ import numpy as np  # type: ignore
 
 from tvm import nd
 from tvm._ffi import get_global_func
-from tvm.ir import IRModule, transform
+from tvm.ir import IRModule, structural_equal, structural_hash, transform
 from tvm.ir.instrument import PassInstrument
 from tvm.runtime import NDArray
 from tvm.target import Target
@@ -198,6 +198,121 @@ def extract_tasks(
                 return list(_extract_task(mod, target, params, module_equality))
 
 
+def _bind_input_shapes(mod: IRModule, input_shapes: Mapping[str, Sequence[int]]) -> IRModule:
+    """Rebind the inputs of the main function of a relay program to static shapes."""
+    # pylint: disable=import-outside-toplevel
+    from tvm import relay
+
+    # pylint: enable=import-outside-toplevel
+    func = mod["main"]
+    params = []
+    binds = {}
+    for param in func.params:
+        name = param.name_hint
+        if name in input_shapes:
+            new_param = relay.var(
+                name,
+                shape=[int(dim) for dim in input_shapes[name]],
+                dtype=param.type_annotation.dtype,
+            )
+            binds[param] = new_param
+            params.append(new_param)
+        else:
+            params.append(param)
+    unknown = set(input_shapes) - {param.name_hint for param in func.params}
+    if unknown:
+        raise ValueError(f"Unknown inputs in the shape histogram: {sorted(unknown)}")
+    new_mod = IRModule(dict(mod.functions.items()), mod.type_definitions)
+    if mod.attrs is not None:
+        for key in mod.attrs.keys():
+            new_mod = new_mod.with_attr(key, mod.attrs[key])
+    mod = new_mod
+    mod["main"] = relay.Function(params, relay.bind(func.body, binds), attrs=func.attrs)
+    return relay.transform.InferType()(mod)
+
+
+def extract_tasks_from_shape_histogram(
+    mod: IRModule,
+    target: Union[Target, str],
+    params: Optional[Dict[str, NDArray]],
+    shape_histogram: Sequence[Tuple[Mapping[str, Sequence[int]], float]],
+    *,
+    module_equality: str = "structural",
+    **kwargs: Any,
+) -> List[ExtractedTask]:
+    """Extract tuning tasks from a relay program for the input shapes seen in production.
+
+    The program is specialized to each entry of the histogram, and the tasks extracted from all the
+    entries are merged. The weight of a task is the number of its occurrences in each specialized
+    program, times the frequency of the entry, so that the task scheduler spends the trials on the
+    tasks by their share of the latency the traffic actually sees.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The module to tune, whose inputs may have dynamic shapes
+    target : tvm.target.Target
+        The compilation target
+    params : Optional[Dict[str, tvm.runtime.NDArray]]
+        The associated parameters of the program
+    shape_histogram : Sequence[Tuple[Mapping[str, Sequence[int]], float]]
+        The input shapes observed, each a mapping from the input names to their static shapes,
+        together with their frequency, e.g. the number of requests of these shapes
+    module_equality : Optional[str]
+        A string to specify the module equality testing and hashing method, see `extract_tasks`
+    **kwargs : Any
+        The other arguments of `extract_tasks`
+
+    Returns
+    -------
+    tasks: List[ExtractedTask]
+        The tasks extracted for all the shapes, weighted by traffic
+    """
+    if not shape_histogram:
+        raise ValueError("The shape histogram is empty")
+    # The merged tasks, bucketed by the structural hash of their first dispatched module
+    merged: Dict[int, List[List[Any]]] = {}
+    order: List[List[Any]] = []
+    for input_shapes, frequency in shape_histogram:
+        if frequency <= 0:
+            continue
+        for task in extract_tasks(
+            _bind_input_shapes(mod, input_shapes),
+            target,
+            params,
+            module_equality=module_equality,
+            **kwargs,
+        ):
+            key = structural_hash(task.dispatched[0])
+            for entry in merged.setdefault(key, []):
+                if structural_equal(entry[0].dispatched[0], task.dispatched[0]):
+                    entry[1] += task.weight * frequency
+                    break
+            else:
+                entry = [task, task.weight * frequency]
+                merged[key].append(entry)
+                order.append(entry)
+    results: List[ExtractedTask] = []
+    names: Set[str] = set()
+    for task, weight in order:
+        name = task.task_name
+        suffix = 0
+        while name in names:
+            suffix += 1
+            name = f"{task.task_name}_{suffix}"
+        names.add(name)
+        results.append(
+            ExtractedTask(
+                task_name=name,
+                mod=task.mod,
+                target=task.target,
+                dispatched=task.dispatched,
+                weight=max(1, int(round(weight))),
+            )
+        )
+    return results
+
+
 def extracted_tasks_to_tune_contexts(
     extracted_tasks: List[ExtractedTask],
     work_dir: str,
@@ -19,7 +19,9 @@ The tvm.meta_schedule.runner package.
 Meta Schedule runners that runs an artifact either locally or through the RPC interface
 """
 from .config import EvaluatorConfig, RPCConfig
+from .in_memory_runner import InMemoryRunner
 from .local_runner import LocalRunner, LocalRunnerFuture
+from .multi_device_runner import MultiDeviceRunner
 from .rpc_runner import RPCRunner
 from .runner import (
     PyRunner,
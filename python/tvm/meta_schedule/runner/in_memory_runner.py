@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Runner that measures the modules kept in memory by InMemoryBuilder"""
+from typing import List, Optional, Union
+
+import tvm
+
+from ..builder.in_memory_builder import get_in_memory_artifact
+from ..logging import get_logger
+from ..profiler import Profiler
+from ..utils import derived_object, get_global_func_with_default_on_worker
+from .config import EvaluatorConfig
+from .local_runner import (
+    T_ALLOC_ARGUMENT,
+    T_CLEANUP,
+    T_RUN_EVALUATOR,
+    LocalRunnerFuture,
+    default_alloc_argument,
+    default_cleanup,
+    default_run_evaluator,
+)
+from .runner import PyRunner, RunnerFuture, RunnerInput
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+
+@derived_object
+class InMemoryRunner(PyRunner):
+    """A runner that measures, in the current process, the modules built by InMemoryBuilder
+
+    The modules are taken from memory, with no file to load. As the measurement runs in the
+    tuning process, a candidate cannot be interrupted by a timeout, nor can its crash be isolated.
+
+    Parameters
+    ----------
+    evaluator_config: EvaluatorConfig
+        The evaluator configuration.
+    alloc_repeat: int
+        The number of times to random fill the allocation.
+    f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
+        The function name to allocate the arguments or the function itself.
+    f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
+        The function name to run the evaluator or the function itself.
+    f_cleanup: Union[T_CLEANUP, str, None]
+        The function name to cleanup the session or the function itself.
+    """
+
+    evaluator_config: EvaluatorConfig
+    alloc_repeat: int
+
+    f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
+    f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
+    f_cleanup: Union[T_CLEANUP, str, None]
+
+    def __init__(
+        self,
+        evaluator_config: Optional[EvaluatorConfig] = None,
+        alloc_repeat: int = 1,
+        f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None] = None,
+        f_run_evaluator: Union[T_RUN_EVALUATOR, str, None] = None,
+        f_cleanup: Union[T_CLEANUP, str, None] = None,
+    ) -> None:
+        super().__init__()
+        self.evaluator_config = EvaluatorConfig._normalized(evaluator_config)
+        self.alloc_repeat = alloc_repeat
+        self.f_alloc_argument = f_alloc_argument
+        self.f_run_evaluator = f_run_evaluator
+        self.f_cleanup = f_cleanup
+
+    def _run_one(self, runner_input: RunnerInput) -> List[float]:
+        f_alloc_argument: T_ALLOC_ARGUMENT = get_global_func_with_default_on_worker(
+            self.f_alloc_argument, default_alloc_argument
+        )
+        f_run_evaluator: T_RUN_EVALUATOR = get_global_func_with_default_on_worker(
+            self.f_run_evaluator, default_run_evaluator
+        )
+        f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(
+            self.f_cleanup, default_cleanup
+        )
+        try:
+            rt_mod = get_in_memory_artifact(str(runner_input.artifact_path))
+            with Profiler.timeit("InMemoryRunner/alloc_argument"):
+                device = tvm.runtime.device(dev_type=str(runner_input.device_type), dev_id=0)
+                repeated_args = f_alloc_argument(
+                    device,
+                    tuple(arg_info.as_json() for arg_info in runner_input.args_info),
+                    self.alloc_repeat,
+                )
+            with Profiler.timeit("InMemoryRunner/run_evaluator"):
+                return f_run_evaluator(rt_mod, device, self.evaluator_config, repeated_args)
+        finally:
+            with Profiler.timeit("InMemoryRunner/cleanup"):
+                f_cleanup()
+
+    def run(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        results: List[RunnerFuture] = []
+        for runner_input in runner_inputs:
+            try:
+                result: List[float] = self._run_one(runner_input)
+                error_message: str = None
+            except Exception as exception:  # pylint: disable=broad-except
+                result = None
+                error_message = "InMemoryRunner: An exception occurred\n" + str(exception)
+            results.append(LocalRunnerFuture(res=result, error_message=error_message))
+        return results
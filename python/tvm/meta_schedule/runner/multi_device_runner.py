@@ -0,0 +1,209 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Local runner measuring on all the local devices of a kind concurrently"""
+import subprocess
+import threading
+from typing import Callable, Dict, List, Optional, Union
+
+import tvm
+
+from ...contrib.popen_pool import PopenPoolExecutor
+from ..logging import get_logger
+from ..utils import derived_object
+from .config import EvaluatorConfig
+from .local_runner import (
+    T_ALLOC_ARGUMENT,
+    T_CLEANUP,
+    T_RUN_EVALUATOR,
+    LocalRunnerFuture,
+    _worker_func,
+)
+from .runner import PyRunner, RunnerFuture, RunnerInput
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+# The device types whose devices are timed in parallel. The other kinds, e.g. CPU, share the
+# cores of the host, so that concurrent measurements would disturb each other.
+_PARALLEL_DEVICE_TYPES = ("cuda", "rocm", "vulkan", "opencl", "metal", "gpu")
+
+
+def _discover_devices(device_type: str, max_devices: int) -> List[int]:
+    """Find the ids of the existing devices of the given type, run in a worker process."""
+    ids = []
+    for device_id in range(max_devices):
+        if not tvm.runtime.device(device_type, device_id).exist:
+            break
+        ids.append(device_id)
+    return ids
+
+
+@derived_object
+class MultiDeviceRunner(PyRunner):
+    """Local runner measuring candidates on all the local devices of their kind concurrently
+
+    Each device gets its own worker process, which only times candidates on that device, and the
+    candidates are handed to the first device that is free. The results are returned in the order
+    of the runner inputs. Devices which are not GPUs, e.g. CPU, are measured one candidate at a
+    time, like LocalRunner.
+
+    Parameters
+    ----------
+    timeout_sec: float
+        The timeout setting.
+    evaluator_config: EvaluatorConfig
+        The evaluator configuration.
+    alloc_repeat: int
+        The number of times to random fill the allocation.
+    device_ids: Optional[List[int]]
+        The ids of the devices to measure on. If not specified, all the local devices of the
+        type of the runner inputs are discovered and used.
+    max_devices: int
+        The maximum number of devices to discover.
+    f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
+        The function name to allocate the arguments or the function itself.
+    f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
+        The function name to run the evaluator or the function itself.
+    f_cleanup: Union[T_CLEANUP, str, None]
+        The function name to cleanup the session or the function itself.
+    initializer: Optional[Callable[[], None]]
+        The initializer function of each worker process.
+    """
+
+    timeout_sec: float
+    evaluator_config: EvaluatorConfig
+    alloc_repeat: int
+    device_ids: Optional[List[int]]
+    max_devices: int
+
+    f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
+    f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
+    f_cleanup: Union[T_CLEANUP, str, None]
+
+    def __init__(
+        self,
+        timeout_sec: float = 30,
+        evaluator_config: Optional[EvaluatorConfig] = None,
+        alloc_repeat: int = 1,
+        device_ids: Optional[List[int]] = None,
+        max_devices: int = 64,
+        f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None] = None,
+        f_run_evaluator: Union[T_RUN_EVALUATOR, str, None] = None,
+        f_cleanup: Union[T_CLEANUP, str, None] = None,
+        initializer: Optional[Callable[[], None]] = None,
+    ) -> None:
+        super().__init__()
+        self.timeout_sec = timeout_sec
+        self.evaluator_config = EvaluatorConfig._normalized(evaluator_config)
+        self.alloc_repeat = alloc_repeat
+        self.device_ids = device_ids
+        self.max_devices = max_devices
+        self.f_alloc_argument = f_alloc_argument
+        self.f_run_evaluator = f_run_evaluator
+        self.f_cleanup = f_cleanup
+        self.initializer = initializer
+        # device id => the worker process dedicated to the device
+        self._pools: Dict[int, PopenPoolExecutor] = {}
+        # device type => the ids of the devices of the type
+        self._devices: Dict[str, List[int]] = {}
+
+    def _pool(self, device_id: int) -> PopenPoolExecutor:
+        pool = self._pools.get(device_id, None)
+        if pool is None:
+            pool = self._pools[device_id] = PopenPoolExecutor(
+                max_workers=1,  # one worker per device
+                timeout=self.timeout_sec,
+                initializer=self.initializer,
+                stderr=subprocess.DEVNULL,  # suppress the stderr output
+            )
+        return pool
+
+    def _get_devices(self, device_type: str) -> List[int]:
+        devices = self._devices.get(device_type, None)
+        if devices is not None:
+            return devices
+        if device_type not in _PARALLEL_DEVICE_TYPES:
+            devices = [0]
+        elif self.device_ids is not None:
+            devices = list(self.device_ids)
+        else:
+            # Discover the devices in a worker, to keep the device runtime out of this process
+            devices = (
+                self._pool(0).submit(_discover_devices, device_type, self.max_devices).result()
+            )
+            if not devices:
+                raise ValueError(f"MultiDeviceRunner: No {device_type} device is found")
+        logger.info("MultiDeviceRunner: %s devices = %s", device_type, devices)
+        self._devices[device_type] = devices
+        return devices
+
+    def _run_on_device(self, device_id: int, runner_input: RunnerInput) -> LocalRunnerFuture:
+        future = self._pool(device_id).submit(
+            _worker_func,
+            self.f_alloc_argument,
+            self.f_run_evaluator,
+            self.f_cleanup,
+            self.evaluator_config,
+            self.alloc_repeat,
+            str(runner_input.artifact_path),
+            str(runner_input.device_type),
+            tuple(arg_info.as_json() for arg_info in runner_input.args_info),
+            device_id,
+        )
+        try:
+            result: List[float] = future.result()
+            error_message: str = None
+        except TimeoutError:
+            result = None
+            error_message = (
+                f"MultiDeviceRunner: Timeout on device {device_id}, "
+                f"killed after {self.timeout_sec} seconds\n"
+            )
+        except Exception as exception:  # pylint: disable=broad-except
+            result = None
+            error_message = (
+                f"MultiDeviceRunner: An exception occurred on device {device_id}\n"
+                + str(exception)
+            )
+        return LocalRunnerFuture(res=result, error_message=error_message)
+
+    def run(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        results: List[Optional[RunnerFuture]] = [None] * len(runner_inputs)
+        # Group the inputs by device type, keeping their indices to preserve the order
+        groups: Dict[str, List[int]] = {}
+        for i, runner_input in enumerate(runner_inputs):
+            groups.setdefault(str(runner_input.device_type), []).append(i)
+        for device_type, indices in groups.items():
+            devices = self._get_devices(device_type)
+            pending = iter(indices)
+            lock = threading.Lock()
+
+            def _device_loop(device_id: int, pending=pending, lock=lock) -> None:
+                while True:
+                    with lock:
+                        i = next(pending, None)
+                    if i is None:
+                        return
+                    results[i] = self._run_on_device(device_id, runner_inputs[i])
+
+            threads = [
+                threading.Thread(target=_device_loop, args=(device_id,)) for device_id in devices
+            ]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        return results  # type: ignore
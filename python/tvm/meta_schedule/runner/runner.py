@@ -186,19 +186,32 @@ class Runner(Object):
 
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
-        kind: Literal["local", "rpc"] = "local",
+        kind: Literal["local", "multi_device", "rpc", "in_memory"] = "local",
         *args,
         **kwargs,
     ) -> "Runner":
         """Create a Runner."""
-        from . import LocalRunner, RPCRunner  # pylint: disable=import-outside-toplevel
+        from . import (  # pylint: disable=import-outside-toplevel
+            InMemoryRunner,
+            LocalRunner,
+            MultiDeviceRunner,
+            RPCRunner,
+        )
 
         if kind == "local":
             if "max_workers" in kwargs:
                 kwargs.pop("max_workers")
             return LocalRunner(*args, **kwargs)  # type: ignore
+        elif kind == "multi_device":
+            if "max_workers" in kwargs:
+                kwargs.pop("max_workers")
+            return MultiDeviceRunner(*args, **kwargs)  # type: ignore
         elif kind == "rpc":
             return RPCRunner(*args, **kwargs)  # type: ignore
+        elif kind == "in_memory":
+            if "max_workers" in kwargs:
+                kwargs.pop("max_workers")
+            return InMemoryRunner(*args, **kwargs)  # type: ignore
         raise ValueError(f"Unknown Runner: {kind}")
 
 
@@ -171,6 +171,11 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         Data reuse configuration for writing. None means no reuse.
     use_software_pipeline : bool
         Whether to use the software pipeline.
+    split_k_factors : Optional[List[int]]
+        The candidate numbers of parts to split the reduction into. Each of them adds design
+        spaces computing the partial sums of the parts in parallel, which helps skinny workloads
+        with a large reduction, and adding them up in a separate reduction stage.
+        None means no split-K.
     """
 
     def __init__(
@@ -183,6 +188,7 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         reuse_read: Optional[ReuseType] = None,
         reuse_write: Optional[ReuseType] = None,
         use_software_pipeline: bool = False,
+        split_k_factors: Optional[List[int]] = None,
     ) -> None:
         self.__init_handle_by_constructor__(
             _ffi_api.ScheduleRuleMultiLevelTilingTensorCore,  # type: ignore # pylint: disable=no-member
@@ -194,6 +200,7 @@ class MultiLevelTilingTensorCore(ScheduleRule):
             reuse_read.as_dict() if reuse_read is not None else None,
             reuse_write.as_dict() if reuse_write is not None else None,
             use_software_pipeline,
+            split_k_factors,
         )
 
 
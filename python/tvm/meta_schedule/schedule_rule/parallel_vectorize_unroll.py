@@ -44,6 +44,14 @@ class ParallelizeVectorizeUnroll(ScheduleRule):
         Use None to disable unroll
     unroll_explicit: bool
         Whether to explicitly unroll the loop, or just add an "unroll" pragma
+    unroll_max_registers: Optional[int]
+        The maximum estimated number of registers of an unrolled loop, which keeps aggressive
+        unrolling from spilling on GPUs.
+        Use None for no limit.
+    unroll_max_code_size: Optional[int]
+        The maximum estimated number of instructions of an unrolled loop, which keeps aggressive
+        unrolling from overflowing the instruction cache on CPUs.
+        Use None for no limit.
     """
 
     def __init__(
@@ -52,13 +60,21 @@ class ParallelizeVectorizeUnroll(ScheduleRule):
         max_vectorize_extent: int = 16,
         unroll_max_steps: Optional[List[int]] = None,
         unroll_explicit: bool = True,
+        unroll_max_registers: Optional[int] = None,
+        unroll_max_code_size: Optional[int] = None,
     ) -> None:
         if unroll_max_steps is None:
             unroll_max_steps = []
+        if unroll_max_registers is None:
+            unroll_max_registers = -1
+        if unroll_max_code_size is None:
+            unroll_max_code_size = -1
         self.__init_handle_by_constructor__(
             _ffi_api.ScheduleRuleParallelizeVectorizeUnroll,  # type: ignore # pylint: disable=no-member
             max_jobs_per_core,
             max_vectorize_extent,
             unroll_max_steps,
             unroll_explicit,
+            unroll_max_registers,
+            unroll_max_code_size,
         )
@@ -0,0 +1,35 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that computes an intermediate buffer in a rolling buffer under its consumer"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("meta_schedule.RollingBuffer")
+class RollingBuffer(ScheduleRule):
+    """A rule that computes an intermediate buffer under a spatial loop of its only consumer, and
+    shrinks it into a rolling buffer over the rows that the consecutive iterations of the loop
+    share, e.g. the line buffer between two pooling or depthwise convolution stages. The loops
+    around the rolling buffer are annotated to stay serial. The rule is expected to be placed
+    before MultiLevelTiling, so that the consumer is not yet tiled."""
+
+    def __init__(self) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleRollingBuffer,  # type: ignore # pylint: disable=no-member
+        )
@@ -82,12 +82,20 @@ class ScheduleRule(Object):
         return _ffi_api.ScheduleRuleClone(self)  # type: ignore # pylint: disable=no-member
 
     @staticmethod
-    def create(kind: Literal["llvm", "cuda", "cuda-tensorcore", "hexagon"]) -> List["ScheduleRule"]:
+    def create(
+        kind: Literal[
+            "llvm",
+            "cuda",
+            "cuda-tensorcore",
+            "vulkan-tensorcore",
+            "hexagon",
+        ]
+    ) -> List["ScheduleRule"]:
         """Create a list of schedule rules for the given kind.
 
         Parameters
         ----------
-        kind : Literal["llvm", "cuda", "cuda-tensorcore", "hexagon"]
+        kind : Literal["llvm", "cuda", "cuda-tensorcore", "vulkan-tensorcore", "hexagon"]
             The kind of the schedule rules.
 
         Returns
@@ -100,6 +108,7 @@ class ScheduleRule(Object):
             "llvm": _ffi_api.ScheduleRuleDefaultLLVM,  # type: ignore
             "cuda": _ffi_api.ScheduleRuleDefaultCUDA,  # type: ignore
             "cuda-tensorcore": _ffi_api.ScheduleRuleDefaultCUDATensorCore,  # type: ignore
+            "vulkan-tensorcore": _ffi_api.ScheduleRuleDefaultVulkanTensorCore,  # type: ignore
             "hexagon": _ffi_api.ScheduleRuleDefaultHexagon,  # type: ignore
             # pylint: enable=no-member
         }
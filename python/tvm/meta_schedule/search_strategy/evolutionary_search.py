@@ -45,6 +45,13 @@ class EvolutionarySearch(SearchStrategy):
         The maximum number to retry mutation.
     eps_greedy : float
         The ratio of greedy selected samples in the final picks.
+    num_transfer_workloads : int
+        The number of similar workloads in the database, i.e. those whose anchor block differs
+        only in shape, whose best traces fill up the measured samples of the initial population
+        when the workload being tuned does not have enough records. Zero disables the transfer.
+    dedup_lowered_ir : bool
+        Whether to skip the candidates whose lowered TIR is the same as the one of a candidate
+        already measured, e.g. those differing only in a split by 1 or an equivalent reorder.
     """
 
     population_size: int
@@ -54,6 +61,8 @@ class EvolutionarySearch(SearchStrategy):
     genetic_mutate_prob: float
     genetic_max_fail_count: int
     eps_greedy: float
+    num_transfer_workloads: int
+    dedup_lowered_ir: bool
 
     def __init__(
         self,
@@ -66,6 +75,8 @@ class EvolutionarySearch(SearchStrategy):
         genetic_mutate_prob: float = 0.85,
         genetic_max_fail_count: int = 10,
         eps_greedy: float = 0.05,
+        num_transfer_workloads: int = 0,
+        dedup_lowered_ir: bool = False,
     ) -> None:
         """Constructor"""
         self.__init_handle_by_constructor__(
@@ -78,4 +89,6 @@ class EvolutionarySearch(SearchStrategy):
             genetic_mutate_prob,
             genetic_max_fail_count,
             eps_greedy,
+            num_transfer_workloads,
+            dedup_lowered_ir,
         )
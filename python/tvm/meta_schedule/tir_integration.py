@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """MetaSchedule-TIR integration"""
-from typing import List, Mapping, Optional, Tuple, Union
+from typing import Any, Dict, List, Mapping, Optional, Sequence, Tuple, Union
 
 # isort: off
 from typing_extensions import Literal
@@ -182,3 +182,170 @@ def compile_tir(
     if not isinstance(target, Target):
         target = Target(target)
     return database.query_schedule(mod, target, workload_name="main")
+
+
+def _specialize_dynamic(
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    var_name: str,
+    sample_values: Sequence[int],
+) -> Tuple[tir.PrimFunc, List[Tuple[int, str, tir.PrimFunc]]]:
+    """Specialize the symbolic dimension of a TIR function to each of the sample values.
+
+    Returns the normalized function, and the sorted list of the sample values, with the name and
+    the static function of each variant.
+    """
+    func = _normalize_mod(mod)["main"]
+    # The dimension is bound either by a scalar parameter, or by the shape of a buffer parameter
+    scalar: Optional[tir.Var] = None
+    handle: Optional[tir.Var] = None
+    for param in func.params:
+        if param in func.buffer_map:
+            if handle is None and any(
+                isinstance(dim, tir.Var) and dim.name == var_name
+                for dim in func.buffer_map[param].shape
+            ):
+                handle = param
+        elif param.name == var_name:
+            scalar = param
+    if scalar is None and handle is None:
+        raise ValueError(f"Symbolic dimension `{var_name}` is not found in the function")
+    if not sample_values:
+        raise ValueError("At least one sample value of the symbolic dimension is required")
+    variants = []
+    for value in sorted(set(int(v) for v in sample_values)):
+        if value <= 0:
+            raise ValueError(f"Sample values should be positive, but gets: {value}")
+        if scalar is not None:
+            variant = func.specialize({scalar: tir.IntImm(scalar.dtype, value)})
+        else:
+            buffer = func.buffer_map[handle]
+            shape = [
+                tir.IntImm(dim.dtype, value)
+                if isinstance(dim, tir.Var) and dim.name == var_name
+                else dim
+                for dim in buffer.shape
+            ]
+            static_buffer = tir.decl_buffer(
+                shape,
+                buffer.dtype,
+                buffer.name,
+                strides=buffer.strides,
+                elem_offset=buffer.elem_offset,
+                scope=buffer.scope(),
+                data_alignment=buffer.data_alignment,
+                offset_factor=buffer.offset_factor,
+            )
+            variant = func.specialize({handle: static_buffer})
+        name = f"main_{var_name}_{value}"
+        variants.append((value, name, variant.with_attr("global_symbol", name)))
+    return func, variants
+
+
+def tune_tir_dynamic(
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    var_name: str,
+    sample_values: Sequence[int],
+    target: Union[str, Target],
+    work_dir: str,
+    max_trials_global: int,
+    **kwargs: Any,
+) -> Database:
+    """Tune a TIR function with a symbolic dimension at several sample values of the dimension.
+
+    Each sample value gives a static variant of the function, tuned as a task of its own, so that
+    the variants share the trial budget and the cost model.
+
+    Parameters
+    ----------
+    mod : Union[ir.IRModule, tir.PrimFunc]
+        The TIR function to tune, with a symbolic dimension.
+    var_name : str
+        The name of the symbolic dimension, e.g. the sequence length.
+    sample_values : Sequence[int]
+        The values of the symbolic dimension to tune for, i.e. the upper bounds of the shape
+        ranges dispatched to each variant.
+    target : Union[str, Target]
+        The target to tune for.
+    work_dir : str
+        The working directory.
+    max_trials_global : int
+        The maximum number of trials to run globally.
+    **kwargs : Any
+        The other arguments of `tune_tir`.
+
+    Returns
+    -------
+    database : Database
+        The database with all tuning records
+    """
+    _, variants = _specialize_dynamic(mod, var_name, sample_values)
+    variant_mod = ir.IRModule({name: variant for _, name, variant in variants})
+    return tune_tir(variant_mod, target, work_dir, max_trials_global, **kwargs)
+
+
+def compile_tir_dynamic(
+    database: Database,
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    var_name: str,
+    sample_values: Sequence[int],
+    target: Union[Target, str],
+) -> ir.IRModule:
+    """Compile a TIR function with a symbolic dimension into a module of tuned variants.
+
+    The module contains the best schedule of each variant tuned by `tune_tir_dynamic`, named
+    `main_<var_name>_<value>`, and the untuned symbolic function as `main`, which serves the
+    values above the largest sample value. Its `meta_schedule.dynamic_dispatch` attribute lists
+    the upper bound and the name of each variant, in increasing order, see `dispatch_dynamic`.
+
+    Parameters
+    ----------
+    database : Database
+        The database of tuning records.
+    mod : Union[ir.IRModule, tir.PrimFunc]
+        The TIR function to compile, with a symbolic dimension.
+    var_name : str
+        The name of the symbolic dimension.
+    sample_values : Sequence[int]
+        The values of the symbolic dimension given to `tune_tir_dynamic`.
+    target : Union[str, Target]
+        The target to compile for.
+
+    Returns
+    -------
+    mod : IRModule
+        The module of the variants, with the dispatch table.
+    """
+    func, variants = _specialize_dynamic(mod, var_name, sample_values)
+    functions: Dict[str, tir.PrimFunc] = {"main": func.with_attr("global_symbol", "main")}
+    table = []
+    for value, name, variant in variants:
+        sch = compile_tir(database, variant, target)
+        if sch is not None:
+            variant = sch.mod["main"].with_attr("global_symbol", name)
+        functions[name] = variant
+        table.append([value, name])
+    return ir.IRModule(functions).with_attr("meta_schedule.dynamic_dispatch", table)
+
+
+def dispatch_dynamic(mod: ir.IRModule, value: int) -> Tuple[str, Optional[int]]:
+    """Pick the variant of a module compiled by `compile_tir_dynamic` for a shape.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The module compiled by `compile_tir_dynamic`.
+    value : int
+        The value of the symbolic dimension to run with.
+
+    Returns
+    -------
+    name : str
+        The name of the function to call.
+    padded_value : Optional[int]
+        The value of the symbolic dimension the function is specialized to, up to which the
+        inputs are to be padded, or None for the symbolic function, which takes any value.
+    """
+    for upper, name in mod.attrs["meta_schedule.dynamic_dispatch"]:
+        if value <= int(upper):
+            return str(name), int(upper)
+    return "main", None
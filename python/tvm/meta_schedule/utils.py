@@ -301,6 +301,16 @@ def get_global_func_on_rpc_session(
 @register_func("meta_schedule.remove_build_dir")
 def remove_build_dir(artifact_path: str) -> None:
     """Clean up the build directory"""
+    # pylint: disable=import-outside-toplevel
+    from .builder.in_memory_builder import (
+        IN_MEMORY_ARTIFACT_PREFIX,
+        remove_in_memory_artifact,
+    )
+
+    # pylint: enable=import-outside-toplevel
+    if artifact_path.startswith(IN_MEMORY_ARTIFACT_PREFIX):
+        remove_in_memory_artifact(artifact_path)
+        return
     shutil.rmtree(os.path.dirname(artifact_path))
 
 
@@ -0,0 +1,150 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Serialize graph executor graphs to the binary graph format of the C runtime.
+
+The C runtime graph executor runs a binary graph in place, e.g. from flash, with
+TVMGraphExecutor_CreateFromBinary, instead of parsing the graph JSON into heap-allocated tables.
+The layout is described by TVMGraphExecutorBinaryHeader in
+src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_executor.h. All the
+fields are little-endian.
+"""
+import json
+import struct
+import typing
+
+from ..runtime import DataType
+
+GRAPH_BINARY_MAGIC = 0xF7E58D4F05049CB9
+GRAPH_BINARY_VERSION = 1
+# func_name of the nodes which are not operators.
+GRAPH_BINARY_NULL_OP = 0xFFFFFFFF
+
+_HEADER_FORMAT = "<QIIIIIIII"
+_NODE_FORMAT = "<IIIIII"
+_NODE_ENTRY_FORMAT = "<III"
+_DLTYPE_FORMAT = "<BBH"
+
+
+def _node_entry(entry: typing.List[int]) -> bytes:
+    version = entry[2] if len(entry) > 2 else 0
+    return struct.pack(_NODE_ENTRY_FORMAT, entry[0], entry[1], version)
+
+
+def serialize_graph(graph_json: str, shape_stride: typing.Optional[int] = None) -> bytes:
+    """Serialize a graph executor graph to the binary graph format of the C runtime.
+
+    Parameters
+    ----------
+    graph_json : str
+        The graph JSON, e.g. the graph_json of the result of tvm.relay.build().
+
+    shape_stride : Optional[int]
+        The number of dimensions reserved for the shape of each entry. Defaults to the largest
+        number of dimensions in the graph.
+
+    Returns
+    -------
+    bytes :
+        The binary graph. It must be placed at an 8-byte aligned address on the device.
+    """
+    graph = json.loads(graph_json)
+    attrs = graph["attrs"]
+    shapes = attrs["shape"][1]
+    dltypes = attrs["dltype"][1]
+    storage_ids = attrs["storage_id"][1]
+    node_row_ptr = graph["node_row_ptr"]
+    num_entries = node_row_ptr[-1]
+    if len(node_row_ptr) != len(graph["nodes"]) + 1:
+        raise ValueError(
+            f"The graph has {len(graph['nodes'])} nodes, but {len(node_row_ptr)} node_row_ptr"
+        )
+    if not len(shapes) == len(dltypes) == len(storage_ids) == num_entries:
+        raise ValueError(
+            f"The graph has {num_entries} entries, but {len(shapes)} shapes, {len(dltypes)} "
+            f"dltypes and {len(storage_ids)} storage ids"
+        )
+    max_ndim = max((len(shape) for shape in shapes), default=0)
+    if shape_stride is None:
+        shape_stride = max_ndim
+    elif shape_stride < max_ndim:
+        raise ValueError(f"shape_stride {shape_stride} is smaller than the graph ndim {max_ndim}")
+
+    strings = bytearray()
+    string_offsets: typing.Dict[str, int] = {}
+
+    def _add_string(value: str) -> int:
+        if value not in string_offsets:
+            string_offsets[value] = len(strings)
+            strings.extend(value.encode("utf-8") + b"\0")
+        return string_offsets[value]
+
+    nodes = bytearray()
+    node_entries = bytearray()
+    num_node_entries = 0
+    for node in graph["nodes"]:
+        inputs = node["inputs"]
+        name = _add_string(node["name"])
+        if node["op"] == "null":
+            func_name, num_outputs, flatten_data = GRAPH_BINARY_NULL_OP, 1, 0
+        elif node["op"] == "tvm_op":
+            node_attrs = node["attrs"]
+            func_name = _add_string(node_attrs["func_name"])
+            num_outputs = int(node_attrs["num_outputs"])
+            flatten_data = int(node_attrs["flatten_data"])
+        else:
+            raise ValueError(f"Can only take tvm_op as op, but {node['op']} is found")
+        nodes += struct.pack(
+            _NODE_FORMAT,
+            name,
+            func_name,
+            num_node_entries,
+            len(inputs),
+            num_outputs,
+            flatten_data,
+        )
+        for entry in inputs:
+            node_entries += _node_entry(entry)
+        num_node_entries += len(inputs)
+
+    header = struct.pack(
+        _HEADER_FORMAT,
+        GRAPH_BINARY_MAGIC,
+        GRAPH_BINARY_VERSION,
+        len(graph["nodes"]),
+        num_node_entries,
+        len(graph["arg_nodes"]),
+        len(graph["heads"]),
+        num_entries,
+        shape_stride,
+        len(strings),
+    )
+    sections = [header]
+    for shape in shapes:
+        padded_shape = list(shape) + [0] * (shape_stride - len(shape))
+        sections.append(struct.pack(f"<{shape_stride}q", *padded_shape))
+    sections += [nodes, node_entries]
+    sections += [_node_entry(entry) for entry in graph["heads"]]
+    sections.append(struct.pack(f"<{len(graph['arg_nodes'])}I", *graph["arg_nodes"]))
+    sections.append(struct.pack(f"<{len(node_row_ptr)}I", *node_row_ptr))
+    sections.append(struct.pack(f"<{num_entries}I", *storage_ids))
+    sections.append(struct.pack(f"<{num_entries}I", *(len(shape) for shape in shapes)))
+    for dltype in dltypes:
+        dtype = DataType(dltype)
+        sections.append(struct.pack(_DLTYPE_FORMAT, dtype.type_code, dtype.bits, dtype.lanes))
+    sections.append(bytes(strings))
+    binary = b"".join(sections)
+    return binary + b"\0" * (-len(binary) % 8)
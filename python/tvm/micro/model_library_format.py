@@ -36,6 +36,7 @@ from ..relay import param_dict
 from ..relay.backend import executor_factory
 from ..relay.backend.name_transforms import prefix_generated_name, to_c_variable_style
 from ..tir import expr
+from . import graph_binary
 
 # This should be kept identical to runtime::symbol::tvm_module_main
 MAIN_FUNC_NAME_STR = "__tvm_main__"
@@ -508,6 +509,9 @@ def _export_graph_model_library_format(
                 graph_config_dir.mkdir(parents=True)
             with open(graph_config_dir / f"{mod.libmod_name}.graph", "w") as f:
                 f.write(mod.get_executor_config())
+            # The graph for TVMGraphExecutor_CreateFromBinary in the C runtime.
+            with open(graph_config_dir / f"{mod.libmod_name}.graph.bin", "wb") as f:
+                f.write(graph_binary.serialize_graph(mod.get_executor_config()))
 
 
 class NonStaticShapeError(Exception):
@@ -34,7 +34,7 @@ from .base import pretty_print, astext
 from . import transform
 from . import analysis
 from . import collage
-from .build_module import build, create_executor, optimize
+from .build_module import build, build_buckets, create_executor, optimize
 from .transform import build_config
 from . import debug
 from . import param_dict
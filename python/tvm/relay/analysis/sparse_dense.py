@@ -63,8 +63,9 @@ def process_params(expr, params, block_size, sparsity_threshold):
         Expr of the network
     params : Dict[String, tvm.nd.array]
         parameters of the network
-    block_size : Tuple(int, int)
-        Blocksize in BSR matrix
+    block_size : Union[Tuple(int, int), Dict[String, Tuple(int, int)]]
+        Blocksize in BSR matrix, or the blocksize of each weight to convert by its name,
+        in which case the other weights are kept dense
     sparsity_threshold : float
         Minimal sparsity requirement for converting to sparse operation
 
@@ -83,10 +84,16 @@ def process_params(expr, params, block_size, sparsity_threshold):
     weight_names = _search_dense_op_weight(expr)
     for name in weight_names:
         name = str(name)
+        if isinstance(block_size, dict):
+            if name not in block_size:
+                continue
+            weight_block_size = block_size[name]
+        else:
+            weight_block_size = block_size
         w_np = params[name].numpy()
         sparsity = 1.0 - (np.count_nonzero(w_np) / w_np.size)
         if sparsity >= sparsity_threshold:
-            sparse_weight = sp.bsr_matrix(w_np, blocksize=block_size)
+            sparse_weight = sp.bsr_matrix(w_np, blocksize=weight_block_size)
             # remove dense weight
             del params[name]
             memo.weight_name.append(name)
@@ -102,8 +109,8 @@ def process_params(expr, params, block_size, sparsity_threshold):
             prefix = "sparse_dense_bsr_%d_%d_%d_%d_%d_%d_" % (
                 w_np.shape[0],
                 w_np.shape[1],
-                block_size[0],
-                block_size[1],
+                weight_block_size[0],
+                weight_block_size[1],
                 sparse_weight.indices.shape[0],
                 sparse_weight.indptr.shape[0],
             )
@@ -43,6 +43,7 @@ class UMALower:
         self.target_name = target_name
         self._operator_strategies: OperatorStrategies = []
         self._tir_passes: List[Tuple[PassPhase, tvm.tir.transform.PrimFuncPass]] = []
+        self._tir_schedules: List[Callable[[tvm.tir.Schedule], None]] = []
 
     def _lower_relay_to_tir(self, relay_prim_func: relay.Function) -> tvm.tir.PrimFunc:
         """Lower a Relay primitive function to a S-TIR primitive function.
@@ -79,6 +80,27 @@ class UMALower:
         tir_prim_func = tir_prim_func.with_attr("relay_attrs", relay_prim_func.attrs)
         return tir_prim_func
 
+    def _schedule_stir(self, prim_func: tvm.tir.PrimFunc) -> tvm.tir.PrimFunc:
+        """Apply the registered schedules to a S-TIR primitive function.
+
+        Parameters
+        ----------
+        prim_func : tvm.tir.PrimFunc
+            The primitive function to schedule.
+
+        Returns
+        -------
+        out : tvm.tir.PrimFunc
+            The scheduled schedulable TensorIR primitive function.
+
+        """
+        if not self._tir_schedules:
+            return prim_func
+        sch = tvm.tir.Schedule(prim_func)
+        for schedule in self._tir_schedules:
+            schedule(sch)
+        return sch.mod["main"]
+
     def _lower_stir_to_nstir(self, prim_func: tvm.tir.PrimFunc) -> tvm.tir.PrimFunc:
         """Lower a S-TIR primitive function to a NS-TIR primitive function.
 
@@ -134,6 +156,7 @@ class UMALower:
         for gvar, func in mod.functions.items():
             if "Compiler" in func.attrs and func.attrs["Compiler"] == self.target_name:
                 func = self._lower_relay_to_tir(func)
+                func = self._schedule_stir(func)
                 func = self._lower_stir_to_nstir(func)
                 mod.update_func(gvar, func)
         return mod
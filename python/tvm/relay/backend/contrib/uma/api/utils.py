@@ -18,6 +18,7 @@
 """Utility methods for the Universal Modular Accelerator Interface (UMA)"""
 
 from enum import Enum, auto
+from typing import List
 import uuid
 
 import tvm
@@ -72,3 +73,53 @@ def add_llvm_to_block(
     assert len(loops) > 0
     sch.annotate(loops[0], "pragma_import_llvm", _c_to_llvm(c_code_str))
     return sch
+
+
+def double_buffer_dma(
+    sch: tvm.tir.Schedule,
+    loop: tvm.tir.schedule.LoopRV,
+    copy_blocks: List[str],
+    async_copy: bool = False,
+) -> tvm.tir.Schedule:
+    """Software pipeline a loop so that the copies of iteration i+1 overlap the compute of
+    iteration i. The buffers written by the copies get two versions during lowering
+    (InjectSoftwarePipeline), so a copy never overwrites data that is still being consumed.
+
+    Parameters
+    ----------
+    sch : tvm.tir.Schedule
+        The schedule to transform.
+
+    loop : tvm.tir.schedule.LoopRV
+        The loop to pipeline, e.g. the loop the copies were moved to with compute_at.
+
+    copy_blocks : List[str]
+        The names of the blocks that move data into the accelerator-local memory. Every other
+        statement in the body of the loop is treated as compute.
+
+    async_copy : bool
+        Whether to mark the copies as asynchronous, for targets that lower asynchronous copies
+        to DMA transfers.
+
+    Returns
+    -------
+    sch : tvm.tir.Schedule
+        The transformed schedule.
+    """
+    body = sch.get(loop).body
+    stmts = body.seq if isinstance(body, tvm.tir.SeqStmt) else [body]
+
+    def _is_copy(stmt):
+        names = []
+        tvm.tir.stmt_functor.post_order_visit(
+            stmt, lambda n: names.append(n.name_hint) if isinstance(n, tvm.tir.Block) else None
+        )
+        return any(name in copy_blocks for name in names)
+
+    stages = [0 if _is_copy(stmt) else 1 for stmt in stmts]
+    assert 0 in stages, "None of the copy blocks is in the body of the loop"
+    sch.annotate(loop, "software_pipeline_stage", stages)
+    sch.annotate(loop, "software_pipeline_order", list(range(len(stmts))))
+    if async_copy:
+        sch.annotate(loop, "software_pipeline_async_stages", [0])
+    return sch
@@ -18,9 +18,10 @@
 """Backend base class of the Universal Modular Accelerator Interface (UMA)"""
 
 from abc import ABC, abstractmethod
-from typing import Union, Dict, Callable, Optional, Any
+from typing import Union, Dict, Callable, Optional, Any, List
 
 import tvm
+from tvm.ir.memory_pools import PoolInfoProperties, WorkspacePoolInfo
 from tvm.relay.backend.contrib.uma.api.codegen import UMACodegen
 from tvm.relay.backend.contrib.uma.api.lower import UMALower
 from tvm.relay.backend.contrib.uma.api.partitioner import UMAPartitioner
@@ -33,6 +34,7 @@ class UMABackend(ABC):
     def __init__(self, merge_compiler_regions: bool = True) -> None:
         self._target_attrs: Dict = {}
         self._target_preprocessor: Callable[[str], Dict[str, Any]] = None
+        self._memory_pools: List = []
         self._relay_to_relay = UMAPartitioner(self.target_name, merge_compiler_regions)
         self._relay_to_tir = UMALower(self.target_name)
         self._tir_to_runtime = UMACodegen(self.target_name)
@@ -233,6 +235,70 @@ class UMABackend(ABC):
         """
         self._relay_to_tir._tir_passes.append((phase, tir_pass))
 
+    def _register_tir_schedule(self, schedule: Callable[[tvm.tir.Schedule], None]) -> None:
+        """Registers a schedule that is applied to the S-TIR of every function lowered for the
+        target, before it is lowered to NS-TIR. Schedules are applied in registration order.
+
+        Parameters
+        ----------
+        schedule: Callable[[tvm.tir.Schedule], None]
+            A function that transforms the given schedule in place.
+
+        Example
+        -------
+        Here is an example that stages the rows of the input in accelerator-local memory and
+        double buffers the copies, so that the DMA of row i+1 overlaps the compute of row i.
+
+        .. code-block:: python
+
+            self._register_tir_schedule(my_dma_schedule)
+
+        .. code-block:: python
+
+            from tvm.relay.backend.contrib.uma.api.utils import double_buffer_dma
+
+            def my_dma_schedule(sch):
+                block = sch.get_block("compute")
+                row = sch.get_loops(block)[0]
+                copy = sch.cache_read(block, 0, "global.my_hwa")
+                sch.compute_at(copy, row)
+                double_buffer_dma(sch, row, [sch.get(copy).name_hint])
+        """
+        self._relay_to_tir._tir_schedules.append(schedule)
+
+    # Memory planning registration
+    def _register_memory_pool(
+        self,
+        name: str,
+        size_hint_bytes: int = -1,
+        **properties: Any,
+    ) -> None:
+        """Registers an accelerator-local memory pool. The pools are exposed through
+        memory_pools() so that the Unified Static Memory Planner (USMP) can place the workspace
+        buffers of the functions lowered for the target into them.
+
+        Parameters
+        ----------
+        name: str
+            The name of the memory pool.
+
+        size_hint_bytes: int
+            The size of the pool in bytes. The default of -1 leaves the pool unrestricted.
+
+        properties: Any
+            Further keyword arguments of tvm.ir.memory_pools.PoolInfoProperties,
+            e.g. read_bandwidth_bytes_per_cycle or target_burst_bytes.
+
+        Example
+        -------
+        Here is an example of how a 256KB scratchpad is registered.
+
+        .. code-block:: python
+
+            self._register_memory_pool("my_hwa_sram", size_hint_bytes=256 * 1024)
+        """
+        self._memory_pools.append((name, size_hint_bytes, properties))
+
     # TIR to runtime function registration
     def _register_codegen(self, fmt: str = "c", **kwargs) -> None:
         """Registers a codegen which is used in place of the default C-codegen.
@@ -289,6 +355,41 @@ class UMABackend(ABC):
             self._relay_to_tir.register()
             self._tir_to_runtime.register()
 
+    def memory_pools(
+        self, target: Optional[tvm.target.Target] = None
+    ) -> List[WorkspacePoolInfo]:
+        """The registered accelerator-local memory pools, to be combined with the pools of the
+        host in the workspace_memory_pools given to relay.build.
+
+        Parameters
+        ----------
+        target: Optional[tvm.target.Target]
+            The accelerator target the model is built for. Defaults to the target
+            instantiated from the target name, the backend must then be registered.
+
+        Returns
+        -------
+        out : List[WorkspacePoolInfo]
+            One pool per registration, accessible from the accelerator target only.
+
+        Example
+        -------
+
+        .. code-block:: python
+
+            pools = WorkspaceMemoryPools(
+                [WorkspacePoolInfo("sram", [cpu_target])] + backend.memory_pools()
+            )
+            with tvm.transform.PassContext(config={"tir.usmp.enable": True}):
+                relay.build(mod, [accel_target, cpu_target], workspace_memory_pools=pools)
+        """
+        if target is None:
+            target = tvm.target.Target(self.target_name)
+        return [
+            WorkspacePoolInfo(name, [target], PoolInfoProperties(size_hint_bytes, **properties))
+            for name, size_hint_bytes, properties in self._memory_pools
+        ]
+
     def partition(
         self, mod: tvm.IRModule, params: Optional[Dict[str, tvm.runtime.NDArray]] = None
     ) -> tvm.IRModule:
@@ -47,6 +47,7 @@ class GraphExecutorCodegen(object):
         self._init = self._mod["init"]
         self._codegen = self._mod["codegen"]
         self._get_graph_json = self._mod["get_graph_json"]
+        self._get_graph_binary = self._mod["get_graph_binary"]
         self._list_params_name = self._mod["list_params_name"]
         self._get_param_by_name = self._mod["get_param_by_name"]
         self._get_irmodule = self._mod["get_irmodule"]
@@ -87,3 +88,14 @@ class GraphExecutorCodegen(object):
             arr.copyto(param)
             params[key] = param
         return graph_json, lowered_func, params
+
+    def get_graph_binary(self):
+        """Get the graph of the last call to codegen in the binary format.
+
+        Returns
+        -------
+        graph_binary : bytearray
+            The graph, which tvm.contrib.graph_executor.create loads without
+            parsing JSON.
+        """
+        return self._get_graph_binary()
@@ -414,6 +414,26 @@ def get():
     return _backend._TECompilerGlobal()
 
 
+def create(mod_name="default"):
+    """Create a TE Compiler to share between builds.
+
+    The builds run under ``PassContext(config={"relay.backend.te_compiler": compiler})``
+    lower each primitive function once, and emit it into the library of the first build
+    using it. The libraries of the later builds must be linked with the earlier ones.
+
+    Parameters
+    ----------
+    mod_name : str
+        The module name prefixed to the names of the lowered functions.
+
+    Returns
+    -------
+    compiler : tvm.relay.backend.TECompiler
+        The TE Compiler.
+    """
+    return _backend._TECompiler(mangle_module_name(mod_name))
+
+
 def lower_to_primfunc(relay_func, target):
     """Lower Relay Function to TIR PrimFunc.
 
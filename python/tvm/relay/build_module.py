@@ -22,6 +22,7 @@ import warnings
 
 import numpy as np
 from tvm.ir import IRModule
+from tvm.ir.transform import PassContext
 from tvm.target import Target
 
 from .. import autotvm
@@ -39,9 +40,11 @@ from . import ty as _ty
 from .backend import Executor, Runtime
 from .backend import executor_factory as _executor_factory
 from .backend import interpreter as _interpreter
+from .backend import te_compiler as _te_compiler
 from .backend.utils import mangle_module_name
 from .backend.vm import VMExecutor
-from .transform import InferType
+from .transform import DynamicToStatic, InferType
+from .transform.flexible_shape import override_shape
 
 
 def _convert_param_map(params):
@@ -407,6 +410,198 @@ def build(
         return executor_factory
 
 
+def build_buckets(
+    ir_mod, buckets, target=None, params=None, axis=0, input_indices=None, mod_name="default"
+):
+    """Build a module with a dynamic dimension into one static graph executor module per bucket
+    of the dimension, with the VM as the fallback of the other sizes.
+
+    The module is specialized to each bucket, where DynamicToStatic folds the dynamic operators
+    into static ones, and built for the graph executor. The builds share a TECompiler, so that
+    the kernels common to several buckets are compiled once, into a single library.
+
+    Parameters
+    ----------
+    ir_mod : :py:class:`~tvm.IRModule`
+        The IR module to build, whose inputs are dynamic along ``axis``.
+
+    buckets : List[int]
+        The sizes of the dynamic dimension built into static modules.
+
+    target : None, or any multi-target like object, see Target.canon_multi_target
+        The build target.
+
+    params : dict of str to NDArray
+        Input parameters to the graph that do not change during inference time.
+
+    axis : int
+        The dynamic dimension of the inputs.
+
+    input_indices : Optional[List[int]]
+        The inputs of the main function sharing the dynamic dimension. Defaults to the first one.
+
+    mod_name : Optional[str]
+        The module name we will build.
+
+    Returns
+    -------
+    factory : BucketedExecutorFactory
+        The static modules and the fallback, whose ``create`` makes the dispatching executor.
+    """
+    # pylint: disable=import-outside-toplevel
+    from .backend import vm as _vm
+
+    if input_indices is None:
+        input_indices = [0]
+    ir_mod = InferType()(ir_mod)
+    main = ir_mod["main"]
+
+    ctx = PassContext.current()
+    config = dict(ctx.config)
+    config["relay.backend.te_compiler"] = _te_compiler.create(mod_name)
+    bucket_ctx = PassContext(
+        opt_level=ctx.opt_level,
+        required_pass=ctx.required_pass,
+        disabled_pass=ctx.disabled_pass,
+        instruments=ctx.instruments,
+        config=config,
+    )
+
+    graphs = {}
+    lib = None
+    for bucket in buckets:
+        new_params = list(main.params)
+        binding = {}
+        for i in input_indices:
+            param = main.params[i]
+            static_ty = override_shape(param.type_annotation, axis, bucket)
+            new_params[i] = _expr.var(param.name_hint, type_annotation=static_ty)
+            binding[param] = new_params[i]
+        body = _expr.bind(main.body, binding)
+        static_mod = IRModule(dict(ir_mod.functions), ir_mod.type_definitions)
+        static_mod["main"] = _function.Function(
+            new_params, body, None, main.type_params, main.attrs
+        )
+        static_mod = DynamicToStatic()(InferType()(static_mod))
+        with bucket_ctx:
+            factory = build(static_mod, target=target, params=params, mod_name=mod_name)
+        graphs[bucket] = (factory.get_graph_json(), factory.get_params())
+        # The kernels shared with the earlier buckets are only in the earlier libraries
+        if lib is None:
+            lib = factory.get_lib()
+        else:
+            lib.import_module(factory.get_lib())
+
+    vm_exec = _vm.compile(ir_mod, target=target, params=params)
+    input_names = [p.name_hint for p in main.params if not params or p.name_hint not in params]
+    dispatch_input = input_names.index(main.params[input_indices[0]].name_hint)
+    return BucketedExecutorFactory(graphs, lib, vm_exec, input_names, dispatch_input, axis)
+
+
+class BucketedExecutorFactory(object):
+    """The static graph executor modules of the buckets of a dynamic dimension, and the VM
+    fallback of the other sizes, see build_buckets.
+
+    Parameters
+    ----------
+    graphs : Dict[int, Tuple[str, Dict[str, NDArray]]]
+        The graph and parameters of each bucket.
+
+    lib : tvm.runtime.Module
+        The library holding the kernels of all the buckets.
+
+    vm_exec : tvm.runtime.vm.Executable
+        The VM executable of the dynamic module.
+
+    input_names : List[str]
+        The names of the inputs.
+
+    dispatch_input : int
+        The input whose dynamic dimension selects the bucket.
+
+    axis : int
+        The dynamic dimension.
+    """
+
+    def __init__(self, graphs, lib, vm_exec, input_names, dispatch_input, axis):
+        self.graphs = graphs
+        self.lib = lib
+        self.vm_exec = vm_exec
+        self.input_names = input_names
+        self.dispatch_input = dispatch_input
+        self.axis = axis
+
+    def create(self, device):
+        """Create the executor of the buckets on a device.
+
+        Parameters
+        ----------
+        device : tvm.runtime.Device
+            The device to run on.
+
+        Returns
+        -------
+        executor : BucketedModule
+            The executor, dispatching each run to the module of its bucket.
+        """
+        return BucketedModule(self, device)
+
+
+class BucketedModule(object):
+    """Executor running the inputs whose dynamic dimension is a bucket on the static graph
+    executor module of the bucket, and the other ones on the VM.
+
+    Parameters
+    ----------
+    factory : BucketedExecutorFactory
+        The modules to run.
+
+    device : tvm.runtime.Device
+        The device to run on.
+    """
+
+    def __init__(self, factory, device):
+        # pylint: disable=import-outside-toplevel
+        from ..runtime import vm as _vm_rt
+
+        self.factory = factory
+        self.modules = {}
+        for bucket, (graph_json, params) in factory.graphs.items():
+            module = _graph_executor.create(graph_json, factory.lib, device)
+            if params:
+                module.set_input(**params)
+            self.modules[bucket] = module
+        self.vm = _vm_rt.VirtualMachine(factory.vm_exec, device)
+
+    def run(self, *args):
+        """Run the inputs on the module of their bucket.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the main function.
+
+        Returns
+        -------
+        outputs : List[tvm.runtime.NDArray]
+            The outputs.
+        """
+        size = args[self.factory.dispatch_input].shape[self.factory.axis]
+        module = self.modules.get(size)
+        if module is None:
+            return _flatten_outputs(self.vm.invoke("main", *args))
+        for name, arg in zip(self.factory.input_names, args):
+            module.set_input(name, arg)
+        module.run()
+        return [module.get_output(i) for i in range(module.get_num_outputs())]
+
+
+def _flatten_outputs(result):
+    if isinstance(result, _nd.NDArray):
+        return [result]
+    return [out for field in result for out in _flatten_outputs(field)]
+
+
 def optimize(mod, target=None, params=None):
     """Helper function that optimizes a Relay module.
 
@@ -22,4 +22,6 @@ from .collage import (
     CostEstimator,
     MockCostEstimator,
     CustomCostEstimator,
+    CachingCostEstimator,
+    ParallelCostEstimator,
 )
@@ -44,6 +44,26 @@ class CostEstimator(Object):
         self.__init_handle_by_constructor__(_ffi_api.CostEstimator)
 
 
+@register_object("relay.collage.CachingCostEstimator")
+class CachingCostEstimator(Object):
+    """CachingCostEstimator class, remembering the costs estimated by another estimator in a file
+    keyed by the structural hash of the candidate module and the target, across runs"""
+
+    def __init__(self, estimator, path):
+        self.__init_handle_by_constructor__(_ffi_api.CachingCostEstimator, estimator, path)
+
+
+@register_object("relay.collage.ParallelCostEstimator")
+class ParallelCostEstimator(Object):
+    """ParallelCostEstimator class, compiling the candidate modules in parallel worker processes
+    before benchmarking them one at a time"""
+
+    def __init__(self, num_workers=None):
+        if num_workers is None:
+            num_workers = os.cpu_count() or 1
+        self.__init_handle_by_constructor__(_ffi_api.ParallelCostEstimator, num_workers)
+
+
 @register_object("relay.collage.MockCostEstimator")
 class MockCostEstimator(Object):
     """MockEstimator class"""
@@ -86,12 +106,9 @@ def vm_estimate_seconds(device, the_vm, func_name, args):
     )
 
 
-@register_func("tvm.relay.collage.estimate_seconds")
-def estimate_seconds(mod, target):
-    """Returns the mean execution time of "main" in mod on target with params. The module
-    may contain "Primitive" functions, possibly with "Compiler" attributes."""
-    device = tvm.device(target.get_target_device_type())
-
+def _compile_for_estimate(mod, target, tmp_dir):
+    """Compiles mod for target, exporting its library to tmp_dir. Returns the code and the path of
+    the library of the VM executable, or None if mod cannot be built."""
     try:
         # Build the module.
         logging.info("Compiling module to estimate")
@@ -101,14 +118,19 @@ def estimate_seconds(mod, target):
         # eg trying to build an nn.batch_norm on GPU, which has no schedule since we assume it
         # is only ever used with a tuple projection which is rewritten away.
         logging.info("Assigning module infinite cost since unable to build: %s", err)
-        return math.inf
+        return None
 
     # Finalize compilation
-    tmp_dir = tempfile.mkdtemp()
     code, lib = exe.save()
     lib_path = os.path.join(tmp_dir, "library.so")
     # TODO(mbs): Avoid nvcc dependency?
     lib.export_library(lib_path, workspace_dir=tmp_dir, cc="nvcc")
+    return code, lib_path
+
+
+def _benchmark_for_estimate(mod, target, code, lib_path):
+    """Returns the median execution time of "main" in the VM executable compiled from mod."""
+    device = tvm.device(target.get_target_device_type())
     lib = tvm.runtime.load_module(lib_path)
     exe = tvm.runtime.vm.Executable.load_exec(code, lib)
 
@@ -122,6 +144,54 @@ def estimate_seconds(mod, target):
     return profile.median  # seconds
 
 
+@register_func("tvm.relay.collage.estimate_seconds")
+def estimate_seconds(mod, target):
+    """Returns the mean execution time of "main" in mod on target with params. The module
+    may contain "Primitive" functions, possibly with "Compiler" attributes."""
+    compiled = _compile_for_estimate(mod, target, tempfile.mkdtemp())
+    if compiled is None:
+        return math.inf
+    return _benchmark_for_estimate(mod, target, *compiled)
+
+
+def _compile_for_estimate_worker(mod, target):
+    """Compiles a module to estimate in a worker process, see _compile_for_estimate."""
+    return _compile_for_estimate(mod, target, tempfile.mkdtemp())
+
+
+@register_func("tvm.relay.collage.estimate_seconds_batch")
+def estimate_seconds_batch(mods, targets, num_workers):
+    """Returns the execution times of "main" in each of mods on the target of the same index.
+    The modules are compiled in num_workers parallel processes, then benchmarked one at a time."""
+    # pylint: disable=import-outside-toplevel
+    from tvm.contrib.popen_pool import PopenPoolExecutor
+
+    # pylint: enable=import-outside-toplevel
+    mods = list(mods)
+    targets = list(targets)
+    pool = PopenPoolExecutor(max_workers=max(1, min(int(num_workers), len(mods))))
+    try:
+        futures = [
+            pool.submit(_compile_for_estimate_worker, mod, target)
+            for mod, target in zip(mods, targets)
+        ]
+        results = []
+        for mod, target, future in zip(mods, targets, futures):
+            try:
+                compiled = future.result()
+            except Exception as err:  # pylint: disable=broad-except
+                logging.info("Assigning module infinite cost since the compilation failed: %s", err)
+                compiled = None
+            if compiled is None:
+                seconds = math.inf
+            else:
+                seconds = _benchmark_for_estimate(mod, target, *compiled)
+            results.append(tvm.tir.FloatImm("float64", seconds))
+        return results
+    finally:
+        del pool
+
+
 def make_labelled_dfpattern_partition_rule_wrapper(compiler, pattern_tuple):
     """Returns a DFPatternPartitionRule representing one (label, pattern, predicate) entry from
     the pattern table for external codegen compiler"""
@@ -17,8 +17,12 @@
 # pylint: disable=unused-argument, not-context-manager
 """Automatic convert model from dense to block sparse"""
 
+import numpy as np
+import scipy.sparse as sp
+
+import tvm
 from tvm import relay
-from tvm.relay.analysis.sparse_dense import process_params
+from tvm.relay.analysis.sparse_dense import _search_dense_op_weight, process_params
 
 from .utils import _run_opt_pass
 
@@ -32,8 +36,8 @@ def convert(func, params, blocksize, sparsity_threshold):
         Expr will be optimized to sparse operation
     params : Dict[Srting, tvm.nd.array]
         Parameters of the Expr
-    blocksize : Tuple(int, int)
-        Blocksize for BSR matrix
+    blocksize : Union[Tuple(int, int), Dict[String, Tuple(int, int)]]
+        Blocksize for BSR matrix, or the blocksize of each weight to convert by its name
     sparsity_threshold : float
         Minimal sparsity requirement for converting.
         If weight sparsity is lower than this threshold,
@@ -52,3 +56,116 @@ def convert(func, params, blocksize, sparsity_threshold):
         func, relay.transform.DenseToSparse(weight_info.weight_name, weight_info.weight_shape)
     )
     return new_func, params
+
+
+def _block_sparsity(w_np, blocksize):
+    """The fraction of the blocks of the given size in the weight which are all zero"""
+    rows, cols = w_np.shape
+    if rows % blocksize[0] != 0 or cols % blocksize[1] != 0:
+        return 0.0
+    blocks = w_np.reshape(rows // blocksize[0], blocksize[0], cols // blocksize[1], blocksize[1])
+    nonzero_blocks = np.count_nonzero(np.any(blocks != 0, axis=(1, 3)))
+    return 1.0 - nonzero_blocks / (blocks.shape[0] * blocks.shape[2])
+
+
+def _measure_dense(w_np, blocksize, batch_size, target, dev, number, repeat):
+    """Measure the latency of a dense layer with the weight, in BSR format if blocksize is given"""
+    data = relay.var("data", shape=(batch_size, w_np.shape[1]), dtype=str(w_np.dtype))
+    if blocksize is None:
+        out = relay.nn.dense(data, relay.const(w_np))
+    else:
+        w_bsr = sp.bsr_matrix(w_np, blocksize=blocksize)
+        weight = (relay.const(w_bsr.data), relay.const(w_bsr.indices), relay.const(w_bsr.indptr))
+        out = relay.nn.sparse_dense(data, weight)
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(tvm.IRModule.from_expr(out), target=target)
+    # pylint: disable=import-outside-toplevel
+    from tvm.contrib import graph_executor
+
+    module = graph_executor.GraphModule(lib["default"](dev))
+    data_np = np.random.uniform(size=(batch_size, w_np.shape[1])).astype(w_np.dtype)
+    module.set_input("data", data_np)
+    return module.benchmark(dev, number=number, repeat=repeat).mean
+
+
+def select_blocksizes(
+    func,
+    params,
+    target,
+    blocksizes=((1, 1), (4, 1), (8, 1), (16, 1), (32, 1)),
+    sparsity_threshold=0.5,
+    batch_size=1,
+    number=10,
+    repeat=3,
+):
+    """Select the BSR blocksize of each dense weight, or to keep it dense, from measured speed
+
+    A weight is a candidate if the fraction of all-zero blocks of a blocksize reaches
+    sparsity_threshold. A sparse dense layer with the candidate blocksize is then measured
+    against the dense layer, and the fastest format is kept.
+
+    Parameters
+    ----------
+    func : relay.Expr
+        Expr will be optimized to sparse operation
+    params : Dict[Srting, tvm.nd.array]
+        Parameters of the Expr
+    target : tvm.target.Target
+        The target to measure the layers on
+    blocksizes : List[Tuple(int, int)]
+        The candidate blocksizes for BSR matrix
+    sparsity_threshold : float
+        Minimal block sparsity requirement for a blocksize to be measured
+    batch_size : int
+        The batch size of the data of the measured layers
+    number : int
+        The number of runs in each latency measurement
+    repeat : int
+        The number of latency measurements, whose mean is used
+
+    Returns
+    -------
+    blocksizes: Dict[String, Tuple(int, int)]
+        The selected blocksize of the weights to convert, by their names
+    """
+    target = tvm.target.Target(target)
+    dev = tvm.device(target.kind.name, 0)
+    selected = {}
+    for name in _search_dense_op_weight(func):
+        name = str(name)
+        w_np = params[name].numpy()
+        candidates = [bs for bs in blocksizes if _block_sparsity(w_np, bs) >= sparsity_threshold]
+        if not candidates:
+            continue
+        best = _measure_dense(w_np, None, batch_size, target, dev, number, repeat)
+        for blocksize in candidates:
+            latency = _measure_dense(w_np, blocksize, batch_size, target, dev, number, repeat)
+            if latency < best:
+                selected[name], best = tuple(blocksize), latency
+    return selected
+
+
+def convert_auto(func, params, target, **kwargs):
+    """Convert the dense weights of a func to block sparse where it is measured to be faster
+
+    Parameters
+    ----------
+    func : relay.Expr
+        Expr will be optimized to sparse operation
+    params : Dict[Srting, tvm.nd.array]
+        Parameters of the Expr
+    target : tvm.target.Target
+        The target to measure the layers on
+    kwargs : Dict[str, Any]
+        The options of select_blocksizes
+
+    Returns
+    -------
+    new_func: relay.Expr
+        Mutated Expr with sparse operations
+
+    params: Dict[Srting, tvm.nd.array]
+        New params with BSR matrix for mutated Expr
+    """
+    blocksizes = select_blocksizes(func, params, target, **kwargs)
+    return convert(func, params, blocksizes, 0.0)
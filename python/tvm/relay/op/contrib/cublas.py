@@ -23,9 +23,9 @@ import tvm.ir
 from tvm import relay
 from tvm import te
 from tvm.relay import transform
-from tvm.contrib import cublas
+from tvm.contrib import cublas, cublaslt
 
-from ...dataflow_pattern import is_op, wildcard
+from ...dataflow_pattern import is_constant, is_op, wildcard
 from .te_target import lower_composite, relay_to_runtime
 from .register import register_pattern_table
 
@@ -79,6 +79,24 @@ def pattern_table() -> List[Tuple[str, relay.Pattern, Callable[[relay.Call], boo
         """Create pattern for dense."""
         return is_op("nn.dense")(wildcard(), wildcard())
 
+    def dense_bias_pattern() -> relay.Pattern:
+        """Create pattern for dense followed by a bias add."""
+        dense = dense_pattern()
+        return is_op("nn.bias_add")(dense, wildcard()) | is_op("add")(dense, wildcard())
+
+    def dense_bias_relu_pattern() -> relay.Pattern:
+        """Create pattern for dense followed by a bias add and relu."""
+        return is_op("nn.relu")(dense_bias_pattern())
+
+    def dense_bias_gelu_pattern() -> relay.Pattern:
+        """Create pattern for dense followed by a bias add and the erf form of gelu."""
+        bias_out = dense_bias_pattern()
+        mul = is_op("multiply")(bias_out, is_constant())
+        erf = is_op("erf")(mul) | is_op("cast")(is_op("erf")(is_op("cast")(mul)))
+        mul_half = is_op("multiply")(erf, is_constant())
+        add = is_op("add")(mul_half, is_constant())
+        return is_op("multiply")(add, bias_out)
+
     def check_matmul_like(matched: relay.Call) -> bool:
         """Check if matmul is supported by cuBLAS."""
         # Input data types can't be mixed
@@ -108,7 +126,30 @@ def pattern_table() -> List[Tuple[str, relay.Pattern, Callable[[relay.Call], boo
 
         return True
 
+    def check_dense_bias(bias_out: relay.Call) -> bool:
+        """Check if a dense and its bias add can be fused into a cuBLASLt epilogue."""
+        dense, bias = bias_out.args
+        if bias_out.op.name == "nn.bias_add" and int(bias_out.attrs.axis) not in [1, -1]:
+            return False
+        dtype = bias_out.checked_type.dtype
+        # The epilogue adds a 1-D bias of the output type to the rows of the output.
+        if dtype not in ["float16", "float32"]:
+            return False
+        if any(arg.checked_type.dtype != dtype for arg in [dense.args[0], dense.args[1], bias]):
+            return False
+        bias_shape = bias.checked_type.shape
+        return len(bias_shape) == 1 and int(bias_shape[0]) == int(dense.checked_type.shape[1])
+
+    def check_dense_bias_act(matched: relay.Call) -> bool:
+        """Check if a dense, its bias add and activation can be fused into a cuBLASLt epilogue."""
+        # The gelu pattern ends with the multiply of its input by the erf term.
+        bias_out = matched.args[0] if matched.op.name == "nn.relu" else matched.args[1]
+        return check_dense_bias(bias_out)
+
     return [
+        ("cublas.dense_bias_gelu", dense_bias_gelu_pattern(), check_dense_bias_act),
+        ("cublas.dense_bias_relu", dense_bias_relu_pattern(), check_dense_bias_act),
+        ("cublas.dense_bias", dense_bias_pattern(), check_dense_bias),
         ("cublas.matmul", matmul_pattern(), check_matmul_like),
         ("cublas.batch_matmul", batch_matmul_pattern(), check_matmul_like),
         ("cublas.dense", dense_pattern(), check_matmul_like),
@@ -145,3 +186,29 @@ def _lower_dense(op: relay.Call, inputs: List[te.Tensor]) -> te.Tensor:
     return cublas.matmul(
         inputs[0], inputs[1], transa=False, transb=True, dtype=op.checked_type.dtype
     )
+
+
+def _lower_dense_bias_epilogue(inputs: List[te.Tensor], epilogue: str, dtype: str) -> te.Tensor:
+    """Lower a dense with its bias add and activation using a cuBLASLt epilogue."""
+    return cublaslt.matmul_bias(
+        inputs[0], inputs[1], inputs[2], transa=False, transb=True, epilogue=epilogue, dtype=dtype
+    )
+
+
+@lower_composite("cublas.dense_bias")
+def _lower_dense_bias(op: relay.Call, inputs: List[te.Tensor]) -> te.Tensor:
+    """Lower a dense followed by a bias add using cuBLASLt."""
+    return _lower_dense_bias_epilogue(inputs, "bias", op.checked_type.dtype)
+
+
+@lower_composite("cublas.dense_bias_relu")
+def _lower_dense_bias_relu(op: relay.Call, inputs: List[te.Tensor]) -> te.Tensor:
+    """Lower a dense followed by a bias add and relu using cuBLASLt."""
+    return _lower_dense_bias_epilogue(inputs, "relu", op.checked_type.dtype)
+
+
+@lower_composite("cublas.dense_bias_gelu")
+def _lower_dense_bias_gelu(op: relay.Call, inputs: List[te.Tensor]) -> te.Tensor:
+    """Lower a dense followed by a bias add and gelu using cuBLASLt, whose gelu is the tanh
+    approximation."""
+    return _lower_dense_bias_epilogue(inputs, "gelu", op.checked_type.dtype)
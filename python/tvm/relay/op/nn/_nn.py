@@ -108,6 +108,10 @@ def alter_op_layout_dense(attrs, inputs, tinfos, out_type):
 reg.register_strategy("nn.contrib_dense_pack", strategy.dense_pack_strategy)
 
 
+# embedding_lookup
+reg.register_strategy("nn.contrib_embedding_lookup", strategy.embedding_lookup_strategy)
+
+
 # fifo_buffer
 @reg.register_compute("nn.fifo_buffer")
 def compute_fifo_buffer(attrs, inputs, out_type):
@@ -142,6 +146,10 @@ def legalize_batch_matmul(attrs, inputs, types):
 reg.register_strategy("nn.batch_matmul", strategy.batch_matmul_strategy)
 
 
+# fused_attention
+reg.register_strategy("nn.fused_attention", strategy.fused_attention_strategy)
+
+
 # batch_norm
 reg.register_strategy("nn.batch_norm", strategy.batch_norm_strategy)
 
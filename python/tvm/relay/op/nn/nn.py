@@ -1667,6 +1667,36 @@ def contrib_dense_pack(data, weight, weight_layout="NC", units=None, out_dtype="
     return _make.contrib_dense_pack(data, weight, weight_layout, units, out_dtype)
 
 
+def contrib_embedding_lookup(table, indices, mode="none"):
+    """Embedding table lookup.
+    Gathers rows of a large, typically memory mapped, embedding table and
+    optionally reduces them per bag.
+
+    .. math::
+
+        out[i_1, ..., i_n, :] = table[indices[i_1, ..., i_n], :]
+
+    Parameters
+    ----------
+    table : tvm.relay.Expr
+        The embedding table, of shape `(num_rows, dim)`.
+
+    indices : tvm.relay.Expr
+        The integer row indices, clipped to `[0, num_rows)`.
+
+    mode : str, optional
+        "none" returns the rows, of shape `indices.shape + (dim,)`.
+        "sum" and "mean" reduce the rows over the last axis of indices,
+        giving a shape of `indices.shape[:-1] + (dim,)`.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The computed result.
+    """
+    return _make.contrib_embedding_lookup(table, indices, mode)
+
+
 def fifo_buffer(data, buffer, axis):
     """FIFO buffer to enable computation reuse in CNNs with sliding indow input
 
@@ -2259,6 +2289,41 @@ def batch_matmul(tensor_a, tensor_b, out_dtype="", transpose_a=False, transpose_
     return _make.batch_matmul(tensor_a, tensor_b, out_dtype, transpose_a, transpose_b)
 
 
+def fused_attention(query, key, value, scale=1.0, out_dtype=""):
+    r"""
+    Compute scaled dot-product attention, with the softmax computed online so that the score
+    matrix is not materialized.
+
+    .. math::
+
+        \mbox{fused_attention}(Q, K, V)[i, :, :] =
+            \mbox{softmax}(Q[i, :, :] * K[i, :, :]^T * scale) * V[i, :, :]
+
+    Parameters
+    ----------
+    query : tvm.relay.Expr
+        The query, with shape [batch, seq_q, head_dim].
+
+    key : tvm.relay.Expr
+        The key, with shape [batch, seq_kv, head_dim].
+
+    value : tvm.relay.Expr
+        The value, with shape [batch, seq_kv, value_dim].
+
+    scale : Optional[float] = 1.0
+        The scale applied to the scores before the softmax.
+
+    out_dtype : Optional[str]
+        Specifies the output data type for mixed precision attention.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result, with shape [batch, seq_q, value_dim].
+    """
+    return _make.fused_attention(query, key, value, scale, out_dtype)
+
+
 # pylint: disable=no-else-return,inconsistent-return-statements
 def sparse_dense(dense_mat, sparse_mat, sparse_lhs=False):
     r"""
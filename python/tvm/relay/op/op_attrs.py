@@ -79,6 +79,11 @@ class DensePackAttrs(Attrs):
     """Attributes for nn.contrib_dense_pack"""
 
 
+@tvm._ffi.register_object("relay.attrs.EmbeddingLookupAttrs")
+class EmbeddingLookupAttrs(Attrs):
+    """Attributes for nn.contrib_embedding_lookup"""
+
+
 @tvm._ffi.register_object("relay.attrs.BatchMatmulAttrs")
 class BatchMatmulAttrs(Attrs):
     """Attributes for nn.batch_matmul"""
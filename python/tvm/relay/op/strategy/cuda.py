@@ -1016,6 +1016,19 @@ def batch_matmul_strategy_cuda(attrs, inputs, out_type, target):
     return strategy
 
 
+@fused_attention_strategy.register(["cuda", "gpu"])
+def fused_attention_strategy_cuda(attrs, inputs, out_type, target):
+    """fused_attention cuda strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.cuda.fused_attention),
+        wrap_topi_schedule(topi.cuda.schedule_fused_attention),
+        name="fused_attention.cuda",
+        plevel=10,
+    )
+    return strategy
+
+
 @sparse_dense_strategy.register(["cuda", "gpu"])
 def sparse_dense_strategy_cuda(attrs, inputs, out_type, target):
     """sparse dense cuda strategy"""
@@ -896,6 +896,28 @@ def dense_pack_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# embedding_lookup
+def wrap_compute_embedding_lookup(topi_compute):
+    """Wrap embedding_lookup topi compute"""
+
+    def _compute_embedding_lookup(attrs, inputs, _):
+        return [topi_compute(inputs[0], inputs[1], mode=attrs.mode)]
+
+    return _compute_embedding_lookup
+
+
+@override_native_generic_func("embedding_lookup_strategy")
+def embedding_lookup_strategy(attrs, inputs, out_type, target):
+    """embedding_lookup generic strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_embedding_lookup(topi.nn.embedding_lookup),
+        wrap_topi_schedule(topi.generic.schedule_extern),
+        name="embedding_lookup.generic",
+    )
+    return strategy
+
+
 # batch_matmul
 def wrap_compute_batch_matmul(
     topi_compute,
@@ -935,6 +957,29 @@ def batch_matmul_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# fused_attention
+def wrap_compute_fused_attention(topi_compute):
+    """wrap fused_attention topi compute"""
+
+    def _compute_fused_attention(attrs, inputs, out_type):
+        return [topi_compute(inputs[0], inputs[1], inputs[2], attrs.scale, out_type.dtype)]
+
+    return _compute_fused_attention
+
+
+@override_native_generic_func("fused_attention_strategy")
+def fused_attention_strategy(attrs, inputs, out_type, target):
+    """fused_attention generic strategy"""
+    logger.warning("fused_attention is not optimized for this platform.")
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.generic.schedule_fused_attention),
+        name="fused_attention.generic",
+    )
+    return strategy
+
+
 # batch_norm
 def wrap_compute_batch_norm(topi_compute):
     """wrap batch_norm topi compute"""
@@ -669,6 +669,26 @@ def batch_matmul_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@fused_attention_strategy.register("cpu")
+def fused_attention_strategy_cpu(attrs, inputs, out_type, target):
+    """fused_attention x86 strategy"""
+    strategy = _op.OpStrategy()
+    if not all(isinstance(dim, tir.IntImm) for x in inputs for dim in x.shape):
+        strategy.add_implementation(
+            wrap_compute_fused_attention(topi.nn.fused_attention),
+            wrap_topi_schedule(topi.generic.schedule_fused_attention),
+            name="fused_attention.generic",
+        )
+    else:
+        strategy.add_implementation(
+            wrap_compute_fused_attention(topi.x86.fused_attention),
+            wrap_topi_schedule(topi.x86.schedule_fused_attention),
+            name="fused_attention.x86",
+            plevel=10,
+        )
+    return strategy
+
+
 @sparse_dense_strategy.register("cpu")
 def sparse_dense_strategy_cpu(attrs, inputs, out_type, target):
     """sparse dense x86 strategy"""
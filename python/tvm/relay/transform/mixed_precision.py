@@ -16,10 +16,15 @@
 # under the License.
 # pylint: disable=line-too-long,unused-argument
 """Default behavior for ops in mixed_precision pass. Import this file to use."""
-from typing import List
+import logging
+from typing import Any, Dict, List, Optional
+
+import numpy as np
 
 from tvm.relay.op import register_mixed_precision_conversion
 
+logger = logging.getLogger("mixed_precision")  # pylint: disable=invalid-name
+
 # MIXED_PRECISION_ALWAYS ops should always be done in lower precision due to the speed and memory
 # savings. MIXED_PRECISION_FOLLOW ops can be done in lower precision but don't have speedups to
 # justify a cast. MIXED_PRECISION_NEVER colored ops should not be done in lower precision due to
@@ -198,3 +203,123 @@ def generic_follow_op(call_node: "relay.Call", mixed_precision_type: str) -> Lis
 @register_func_to_op_list(list_ops=DEFAULT_NEVER_LIST)
 def generic_never_op(call_node: "relay.Call", mixed_precision_type: str) -> List:
     return [MIXED_PRECISION_NEVER] + get_generic_out_dtypes(call_node, mixed_precision_type)
+
+
+def _always_ops(mod: "tvm.IRModule", mixed_precision_type: str) -> List[str]:
+    """The names of the ops in the module which ToMixedPrecision always converts, in the order
+    of their first appearance."""
+    from tvm import ir, relay  # pylint: disable=import-outside-toplevel
+
+    names: List[str] = []
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and isinstance(expr.op, ir.Op):
+            func = expr.op.get_attr("FTVMMixedPrecisionConversionType")
+            if func is not None and expr.op.name not in names:
+                if int(func(expr, mixed_precision_type)[0]) == MIXED_PRECISION_ALWAYS:
+                    names.append(expr.op.name)
+
+    relay.analysis.post_order_visit(mod["main"], visit)
+    return names
+
+
+def search_mixed_precision(
+    mod: "tvm.IRModule",
+    params: Optional[Dict[str, Any]],
+    target: "tvm.target.Target",
+    dataset: List[Dict[str, Any]],
+    mixed_precision_type: str = "float16",
+    rtol: float = 1e-2,
+    atol: float = 1e-2,
+    number: int = 10,
+    repeat: int = 3,
+) -> List[str]:
+    """Profile-guided search of the ops to keep in float32 when running ToMixedPrecision.
+
+    The search starts from the float32 model and tries to convert the ops that ToMixedPrecision
+    always converts, one op name at a time, together with the ops which follow them. A conversion
+    is kept only if the outputs on every input of the calibration dataset stay close to the float32
+    ones and the measured latency improves. The result is meant to be passed to the pass through
+    the config "relay.ToMixedPrecision.never_ops".
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The float32 model.
+    params : Optional[Dict[str, Any]]
+        The parameters of the model.
+    target : tvm.target.Target
+        The target to compile and measure the model on.
+    dataset : List[Dict[str, Any]]
+        The calibration dataset, a list of the inputs of the model by their names.
+    mixed_precision_type : str
+        The reduced precision to convert the ops to.
+    rtol : float
+        The relative tolerance of the outputs.
+    atol : float
+        The absolute tolerance of the outputs.
+    number : int
+        The number of runs in each latency measurement.
+    repeat : int
+        The number of latency measurements, whose mean is used.
+
+    Returns
+    -------
+    never_ops : List[str]
+        The names of the ops to keep in float32.
+    """
+    # pylint: disable=import-outside-toplevel
+    import tvm
+    from tvm import relay
+    from tvm.contrib import graph_executor
+
+    from .transform import InferType, ToMixedPrecision
+
+    # pylint: enable=import-outside-toplevel
+    if not dataset:
+        raise ValueError("The calibration dataset is empty")
+    target = tvm.target.Target(target)
+    dev = tvm.device(target.kind.name, 0)
+    mod = InferType()(mod)
+
+    def measure(never_ops: Optional[List[str]]):
+        config = {
+            "relay.ToMixedPrecision.keep_orig_output_dtype": True,
+            "relay.ToMixedPrecision.never_ops": never_ops or [],
+        }
+        with tvm.transform.PassContext(opt_level=3, config=config):
+            candidate = mod if never_ops is None else ToMixedPrecision(mixed_precision_type)(mod)
+            lib = relay.build(candidate, target=target, params=params)
+        module = graph_executor.GraphModule(lib["default"](dev))
+        outputs = []
+        for inputs in dataset:
+            module.set_input(**inputs)
+            module.run()
+            outputs.append([module.get_output(i).numpy() for i in range(module.get_num_outputs())])
+        latency = module.benchmark(dev, number=number, repeat=repeat).mean
+        return outputs, latency
+
+    def is_accurate(outputs) -> bool:
+        for results, ref_results in zip(outputs, ref_outputs):
+            for result, ref_result in zip(results, ref_results):
+                if not np.allclose(result.astype("float32"), ref_result, rtol=rtol, atol=atol):
+                    return False
+        return True
+
+    ref_outputs, best_latency = measure(None)
+    logger.info("float32 latency: %.3e s", best_latency)
+    never_ops = _always_ops(mod, mixed_precision_type)
+    for op_name in list(never_ops):
+        trial = [name for name in never_ops if name != op_name]
+        outputs, latency = measure(trial)
+        accurate = is_accurate(outputs)
+        logger.info(
+            "Converting %s to %s: latency %.3e s, accurate: %s",
+            op_name,
+            mixed_precision_type,
+            latency,
+            accurate,
+        )
+        if accurate and latency < best_latency:
+            never_ops, best_latency = trial, latency
+    return never_ops
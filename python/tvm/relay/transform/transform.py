@@ -426,6 +426,46 @@ def CombineParallelBatchMatmul(min_num_branches=3):
     return _ffi_api.CombineParallelBatchMatmul(min_num_branches)
 
 
+def CombineParallelTake(min_num_branches=3):
+    """Combine multiple take operators gathering rows of the same table into one.
+    For example:
+
+    .. code-block
+                          table (10, 4)
+                     /                    \
+        take(table, (2, 3), axis=0)    take(table, (2, 3), axis=0)
+                |                              |
+        elemwise/bcast (2, 3, 4)        elemwise/bcast (2, 3, 4)
+
+    Would become:
+
+    .. code-block
+
+                table (10, 4)
+                |
+            take(table, stack([(2, 3), (2, 3)]), axis=0)
+                |
+            elemwise/bcast (2, 2, 3, 4)
+                |
+            split + squeeze
+
+    Only take ops with ``axis=0`` and ``batch_dims=0`` whose indices have the same shape and
+    dtype are combined.
+
+    Parameters
+    ----------
+    min_num_branches : int
+        The minimum number of required parallel branches for performing this
+        optimization.
+
+    Returns
+    -------
+    ret: tvm.transform.Pass
+        The registered pass that combines parallel take operators.
+    """
+    return _ffi_api.CombineParallelTake(min_num_branches)
+
+
 def BatchingOps():
     """Batching parallel operators into one for Conv2D, Dense and BatchMatmul.
 
@@ -1194,6 +1234,40 @@ def SimplifyExpr():
     return _ffi_api.SimplifyExpr()
 
 
+def FuseAttention():
+    """
+    Rewrite the batch_matmul, softmax and batch_matmul chain of scaled dot-product attention,
+    optionally scaled by a constant, into nn.fused_attention. The fused operator computes the
+    softmax online, so that the score matrix is not materialized.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered FuseAttention pass.
+    """
+    return _ffi_api.FuseAttention()
+
+
+def RewriteEmbeddingLookup(min_table_bytes=1 << 26):
+    """
+    Rewrite take along the first axis of large 2-D embedding tables into
+    nn.contrib_embedding_lookup. A sum or mean of the rows over the last index axis,
+    as in embedding_bag, is folded into the lookup. The lookup gathers the rows in
+    sorted order with prefetching, which suits tables memory mapped from the params file.
+
+    Parameters
+    ----------
+    min_table_bytes : int
+        Only lookups into tables of at least this many bytes are rewritten.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered RewriteEmbeddingLookup pass.
+    """
+    return _ffi_api.RewriteEmbeddingLookup(min_table_bytes)
+
+
 def PlanDevices(config):
     """
     Uses existing "on_device" and "device_copy" calls to infer the virtual device on which
@@ -1363,6 +1437,11 @@ def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
       This parameter is not part of explicit arguments of the transformation, but should
       be passed through tvm.transform.PassContext.
 
+    relay.ToMixedPrecision.never_ops: List[str]
+      The names of the ops which are kept in float32 regardless of their registered
+      conversion category, e.g. as found by mixed_precision.search_mixed_precision.
+      This parameter should also be passed through tvm.transform.PassContext.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -31,6 +31,23 @@ from tvm._ffi.runtime_ctypes import Device
 from . import _ffi_api, base, server
 
 
+class RPCFuture(object):
+    """The future of an asynchronous remote call, see RPCSession.async_call"""
+
+    def __init__(self, fwait):
+        self._fwait = fwait
+
+    def result(self):
+        """Wait for the remote call to return.
+
+        Returns
+        -------
+        value : object
+            The return value of the remote call, the error of the call is raised.
+        """
+        return self._fwait()
+
+
 class RPCSession(object):
     """RPC Client session module
 
@@ -72,6 +89,32 @@ class RPCSession(object):
         """
         return self._sess.get_function(name)
 
+    def async_call(self, func, *args):
+        """Call a remote function without waiting for its return.
+
+        The calls are pipelined: the remote runs them in order, and the synchronous calls of
+        the session run after the pending asynchronous calls, so the dependent calls keep
+        their order. This hides the network latency of a sequence of calls.
+
+        Parameters
+        ----------
+        func : Function
+            The remote function, obtained from this session.
+
+        args : list
+            The arguments of the call.
+
+        Returns
+        -------
+        future : RPCFuture
+            The future of the return value.
+        """
+        return RPCFuture(_ffi_api.AsyncCall(func, *args))
+
+    def wait_pending_calls(self):
+        """Wait until all the asynchronous calls of the session return."""
+        _ffi_api.WaitPendingCalls(self._sess)
+
     def device(self, dev_type, dev_id=0):
         """Construct a remote device.
 
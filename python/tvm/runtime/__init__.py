@@ -23,7 +23,8 @@ from .object_path import ObjectPath, ObjectPathPair
 from .script_printer import Scriptable
 from .object_generic import ObjectGeneric, ObjectTypes
 from .ndarray import NDArray, DataType, DataTypeCode, Device
-from .module import Module, num_threads
+from .module import Module, num_threads, num_numa_nodes, numa_node_cpus, bind_numa_node
+from .module import set_threadpool_wait_policy, warm_up_threadpool
 from .profiling import Report
 
 # function exposures
@@ -37,6 +38,9 @@ from .params import (
     load_param_dict,
     save_param_dict_to_file,
     load_param_dict_from_file,
+    save_param_dict_to_mmap_file,
+    load_param_dict_from_mmap_file,
+    load_param_dict_to_device,
 )
 
 from . import executor
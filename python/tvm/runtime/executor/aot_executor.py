@@ -61,6 +61,8 @@ class AotModule(object):
     def __init__(self, module):
         self.module = module
         self._set_input = module["set_input"]
+        self._set_input_zero_copy = module["set_input_zero_copy"]
+        self._set_output_zero_copy = module["set_output_zero_copy"]
         self._run = module["run"]
         self._get_output = module["get_output"]
         self._get_input = module["get_input"]
@@ -101,6 +103,43 @@ class AotModule(object):
                 if val:
                     self._get_input(k).copyfrom(params[k])
 
+    def set_input_zero_copy(self, key=None, value=None, **params):
+        """Bind buffers to the inputs of the module, without copying their data
+
+        The buffers must be contiguous, of the shape and dtype of the inputs, and
+        aligned to 64 bytes. They stay bound until another buffer is bound.
+
+        Parameters
+        ----------
+        key : int or str
+           The input key
+
+        value : the input value in DLPack
+           The input value
+
+        params : dict of str to NDArray
+           Additional arguments
+        """
+        if key is not None:
+            self._set_input_zero_copy(key, value)
+
+        if params:
+            for k, v in params.items():
+                self._set_input_zero_copy(k, v)
+
+    def set_output_zero_copy(self, key, value):
+        """Bind a buffer to an output of the module, without copying its data
+
+        Parameters
+        ----------
+        key : int or str
+           The output key
+
+        value : the output value in DLPack
+           The output value
+        """
+        self._set_output_zero_copy(key, value)
+
     def run(self, **input_dict):
         """Run forward execution of the model
 
@@ -18,9 +18,10 @@
 # pylint: disable=invalid-name, unused-import, import-outside-toplevel, inconsistent-return-statements
 """Runtime Module namespace."""
 import os
+import concurrent.futures
 import ctypes
 import struct
-from typing import Sequence
+from typing import List, Sequence
 import numpy as np
 
 import tvm._ffi
@@ -511,6 +512,7 @@ class Module(object):
         system_lib_prefix = None
         llvm_target_string = None
         global_object_format = "o"
+        llvm_modules = []
         for index, module in enumerate(modules):
             if fcompile is not None and hasattr(fcompile, "object_format"):
                 if module.type_key == "c":
@@ -545,12 +547,23 @@ class Module(object):
                     global_object_format = object_format = "o"
 
             path_obj = os.path.join(workspace_dir, f"lib{index}.{object_format}")
-            module.save(path_obj)
             files.append(path_obj)
             if module.type_key == "llvm":
                 is_system_lib = module.get_function("__tvm_is_system_module")()
                 llvm_target_string = module.get_function("_get_target_string")()
                 system_lib_prefix = module.get_function("__tvm_get_system_lib_prefix")()
+                llvm_modules.append((module, path_obj, llvm_target_string))
+            else:
+                module.save(path_obj)
+
+        # Each LLVM module owns its LLVM context, so their objects can be emitted
+        # concurrently unless a target modifies the global LLVM options.
+        if len(llvm_modules) > 1 and all("-cl-opt" not in t for _, _, t in llvm_modules):
+            with concurrent.futures.ThreadPoolExecutor(len(llvm_modules)) as pool:
+                list(pool.map(lambda m: m[0].save(m[1]), llvm_modules))
+        else:
+            for module, path_obj, _ in llvm_modules:
+                module.save(path_obj)
 
         if not fcompile:
             if file_name.endswith(".tar"):
@@ -713,4 +726,77 @@ def num_threads() -> int:
     return _ffi_api.NumThreads()
 
 
+def num_numa_nodes() -> int:
+    """Get the number of NUMA nodes of the system.
+
+    Returns
+    -------
+    int
+        Number of NUMA nodes, 1 when the topology is unknown.
+    """
+    return _ffi_api.NumNumaNodes()
+
+
+def numa_node_cpus(node: int) -> List[int]:
+    """Get the CPUs of a NUMA node.
+
+    Parameters
+    ----------
+    node : int
+        The index of the node.
+
+    Returns
+    -------
+    List[int]
+        The ids of the CPUs of the node.
+    """
+    return list(_ffi_api.NumaNodeCPUs(node))
+
+
+def bind_numa_node(node: int, nthreads: int = 0):
+    """Bind the thread pool of the calling thread to a NUMA node.
+
+    The TVM runtime has one thread pool per calling thread. Running each model
+    instance from its own thread bound to a different node gives the instances
+    disjoint cores, and places the memory they allocate afterwards, e.g. when
+    creating an executor, on their node.
+
+    Parameters
+    ----------
+    node : int
+        The index of the node.
+    nthreads : int
+        The number of threads of the pool, 0 uses one per CPU of the node.
+    """
+    _ffi_api.config_threadpool_numa_node(node, nthreads)
+
+
+_WAIT_POLICIES = {"yield": 0, "spin": 1, "sleep": 2, "adaptive": 3}
+
+
+def set_threadpool_wait_policy(policy: str, spin_count: int = -1):
+    """Set how the workers of the thread pool of the calling thread wait between jobs.
+
+    Parameters
+    ----------
+    policy : str
+        "yield" spins yielding the core, then sleeps. "spin" spins without yielding,
+        then sleeps. "sleep" sleeps right away. "adaptive" spins like "yield" while
+        the gaps observed between the parallel jobs are short, and sleeps otherwise.
+    spin_count : int
+        The number of spin iterations before sleeping, -1 keeps the current count.
+    """
+    if policy not in _WAIT_POLICIES:
+        raise ValueError(
+            "policy should be one of {}, but got {}".format(list(_WAIT_POLICIES), policy)
+        )
+    _ffi_api.config_threadpool_wait_policy(_WAIT_POLICIES[policy], spin_count)
+
+
+def warm_up_threadpool():
+    """Start and wake up the workers of the thread pool of the calling thread, so that
+    the first parallel job of a model does not pay for it."""
+    _ffi_api.threadpool_warm_up()
+
+
 _set_class_module(Module)
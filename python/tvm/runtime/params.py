@@ -76,6 +76,24 @@ def save_param_dict_to_file(params, path):
     return _ffi_api.SaveParamsToFile(_to_ndarray(params), path)
 
 
+def save_param_dict_to_mmap_file(params, path):
+    """Save parameter dictionary to a file that can be memory mapped.
+
+    Each tensor is stored at an aligned offset, so that
+    :py:func:`load_param_dict_from_mmap_file` can return CPU arrays that
+    are views over the mapped file instead of copies.
+
+    Parameters
+    ----------
+    params : dict of str to NDArray
+        The parameter dictionary.
+
+    path: str
+        The path to the parameter file.
+    """
+    return _ffi_api.SaveParamsMmap(_to_ndarray(params), path)
+
+
 def load_param_dict(param_bytes):
     """Load parameter dictionary from binary bytes.
 
@@ -108,3 +126,51 @@ def load_param_dict_from_file(path):
         The parameter dictionary.
     """
     return _ffi_api.LoadParamsFromFile(path)
+
+
+def load_param_dict_from_mmap_file(path):
+    """Load parameter dictionary from a file saved by
+    :py:func:`save_param_dict_to_mmap_file`.
+
+    The returned arrays live on CPU and share the pages of the mapped file,
+    which stays mapped as long as any of them is alive.
+
+    Parameters
+    ----------
+    path: str
+        The path to the parameter file to load from.
+
+    Returns
+    -------
+    params : dict of str to NDArray
+        The parameter dictionary.
+    """
+    return _ffi_api.LoadParamsMmap(path)
+
+
+def load_param_dict_to_device(path, device, num_threads=0):
+    """Load parameter dictionary from a file saved by
+    :py:func:`save_param_dict_to_mmap_file` into arrays on a device.
+
+    The tensors are read in parallel at their offsets in the file and copied
+    through a bounded host buffer per thread, so the whole file is never held
+    in host memory. When TVM is built with ``USE_CUFILE``, CUDA arrays are
+    read with GPUDirect Storage without a host copy where supported.
+
+    Parameters
+    ----------
+    path: str
+        The path to the parameter file to load from.
+
+    device : Device
+        The device to allocate the arrays on.
+
+    num_threads : int
+        The number of reading threads, 0 uses the hardware concurrency.
+
+    Returns
+    -------
+    params : dict of str to NDArray
+        The parameter dictionary.
+    """
+    return _ffi_api.LoadParamsToDevice(path, device, num_threads)
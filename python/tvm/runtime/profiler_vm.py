@@ -49,6 +49,7 @@ class VirtualMachineProfiler(vm.VirtualMachine):
         self._invoke = self.module["invoke"]
         self._profile = self.module["profile"]
         self._profile_rpc = self.module["profile_rpc"]
+        self._set_sampling = self.module["set_sampling"]
         self._set_input = self.module["set_input"]
         self._setup_device(device, memory_cfg)
 
@@ -89,3 +90,30 @@ class VirtualMachineProfiler(vm.VirtualMachine):
             assert collectors is None, "Profiling with collectors is not supported over RPC"
             return Report.from_json(self._profile_rpc(func_name))
         return self._profile(func_name, collectors)
+
+    def set_sampling(self, interval):
+        """Profile one in every `interval` calls to :py:func:`invoke`.
+
+        Sampled calls are timed without metric collectors, and the timers are
+        only read by :py:func:`sampled_report`, so on devices with asynchronous
+        timers (e.g. CUDA) sampling adds no synchronization to the calls.
+
+        Parameters
+        ----------
+        interval : int
+            The sampling interval, 0 disables sampling.
+        """
+        self._set_sampling(interval)
+
+    def sampled_report(self):
+        """Aggregate the calls sampled since the last report.
+
+        Returns
+        -------
+        report : Report
+            The calls of all the sampled invocations. Percentages are relative
+            to the total time of the sampled invocations.
+        """
+        if self.module.type_key == "rpc":
+            return Report.from_json(self.module["sampled_report_rpc"]())
+        return self.module["sampled_report"]()
@@ -155,6 +155,21 @@ class Report(Object):
         """
         return _ffi_api.AsJSON(self)
 
+    def chrome_trace(self):
+        """Convert the calls of this profiling report to the Chrome trace event format.
+
+        The result can be opened in chrome://tracing or https://ui.perfetto.dev. Calls are placed
+        on the track of their device at the timestamps recorded by :py:class:`TimelineCollector`,
+        so gaps between calls and host-device overlap become visible. Without the timestamps the
+        calls of each device are laid out back to back.
+
+        Returns
+        -------
+        trace : str
+            The trace as JSON
+        """
+        return _ffi_api.AsChromeTrace(self)
+
     @classmethod
     def from_json(cls, s):
         """Deserialize a report from JSON.
@@ -209,6 +224,24 @@ class MetricCollector(Object):
     """Interface for user defined profiling metric collection."""
 
 
+@_ffi.register_object("runtime.profiling.TimelineCollector")
+class TimelineCollector(MetricCollector):
+    """Records the "Start (us)" and "End (us)" timestamps of every call, relative to the start of
+    the first one, for the timeline of :py:meth:`Report.chrome_trace`.
+    """
+
+    def __init__(self, sync: bool = False):
+        """
+        Parameters
+        ----------
+        sync : bool
+            Whether to synchronize the device before each timestamp. Without it the timestamps
+            of asynchronous devices are the launch times of the calls. With it they are the times
+            the device ran the calls, at the price of serializing the host and the device.
+        """
+        self.__init_handle_by_constructor__(_ffi_api.TimelineCollector, sync)
+
+
 @_ffi.register_object("runtime.profiling.DeviceWrapper")
 class DeviceWrapper(Object):
     """Wraps a tvm.runtime.Device"""
@@ -269,6 +302,109 @@ def profile_function(mod, dev, collectors, func_name=None, warmup_iters=10):
     )
 
 
+
+def lwp_report(mod=None, reset=False):
+    """Collect the timings of the loops and functions instrumented with the
+    ``tir.instrument_lwp`` pass configuration.
+
+    Example
+    -------
+
+    .. code-block: python
+        with tvm.transform.PassContext(config={"tir.instrument_lwp": True}):
+            f = tvm.build(my_func, target="llvm")
+        f(*args)
+        print(tvm.runtime.profiling.lwp_report(f, reset=True))
+
+    Parameters
+    ----------
+    mod: Optional[Module]
+        Module whose device counters (e.g. of its CUDA kernels) are collected,
+        along with the ones of its imports. The CPU events are always collected.
+    reset: bool
+        Whether to clear the events and the counters once read.
+
+    Returns
+    -------
+    report: Report
+        One call named ``lwp_<id>`` per instrumented region, where ``id`` is the
+        one assigned by ``tir.transform.InstrumentProfileIntrinsics``. CPU calls
+        report the total duration of the region, device calls the mean duration
+        of one execution by a thread.
+    """
+    return _ffi_api.LWPReport(mod, reset)
+
+def memory_report():
+    """Report the device memory held by the runtime.
+
+    Each device and owner of memory, e.g. ``ndarray`` or ``vm.pooled``, is a call with its
+    current and peak bytes and its number of live allocations. The pools of the VM allocators
+    are calls named ``<owner> pool`` with the bytes they hold, the bytes cached free in them,
+    and their occupancy. When tracing is enabled, see :py:func:`set_memory_tracing`, the live
+    allocations are calls named ``live <owner>``, grouped by the stack they were allocated at.
+
+    The calls have no duration, so the report should be printed with
+    ``report.table(sort=False)``.
+
+    Returns
+    -------
+    report: Report
+        The memory report, with the per device totals in its device metrics.
+    """
+    return _ffi_api.MemoryReport()
+
+
+def set_memory_tracing(enable: bool):
+    """Enable or disable the tracing of the stacks of the live allocations, to find where
+    leaked memory was allocated. Tracing is enabled at startup when the environment variable
+    ``TVM_MEMORY_TRACE`` is set.
+
+    Parameters
+    ----------
+    enable: bool
+        Whether to trace the allocations made from now on.
+    """
+    _ffi_api.SetMemoryTracing(enable)
+
+
+def reset_memory_peak():
+    """Reset the peaks of :py:func:`memory_report` to the current bytes."""
+    _ffi_api.ResetMemoryPeak()
+
+
+def enable_tracepoints(capacity: int = 1 << 20):
+    """Start recording the runtime tracepoints to a ring buffer.
+
+    The tracepoints are kernel launches, allocations, frees, copies, VM instructions, thread
+    pool launches and RPC messages. Recording restarts from an empty buffer.
+
+    Parameters
+    ----------
+    capacity : int
+        The number of records kept. Once full, the oldest records are overwritten.
+    """
+    _ffi_api.EnableTracepoints(capacity)
+
+
+def disable_tracepoints():
+    """Stop recording the runtime tracepoints. The recorded ones are kept for dumping."""
+    _ffi_api.DisableTracepoints()
+
+
+def dump_tracepoints() -> str:
+    """The recorded tracepoints as a Chrome trace of instant events, one track per thread.
+
+    Each event carries its two integer arguments as ``a0`` and ``a1``, whose meaning is listed
+    in include/tvm/runtime/trace.h.
+
+    Returns
+    -------
+    trace : str
+        The trace in the Trace Event Format, for chrome://tracing or Perfetto.
+    """
+    return _ffi_api.DumpTracepoints()
+
+
 # We only enable this class when TVM is build with PAPI support
 if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=True) is not None:
 
@@ -291,3 +427,31 @@ if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=T
             for dev, names in metric_names.items():
                 wrapped[DeviceWrapper(dev)] = names
             self.__init_handle_by_constructor__(_ffi_api.PAPIMetricCollector, wrapped)
+
+
+# We only enable this class when TVM is build with CUPTI support
+if _ffi.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is not None:
+
+    @_ffi.register_object("runtime.profiling.CUPTIMetricCollector")
+    class CUPTIMetricCollector(MetricCollector):
+        """Collects the performance counters of CUDA kernels using the CUDA
+        Profiling Tools Interface (CUPTI).
+
+        The metrics of a call cover every kernel it launches. By default the
+        achieved DRAM bandwidth and SM occupancy are collected. Only the metrics
+        CUPTI can collect in a single pass are supported.
+        """
+
+        def __init__(self, metric_names: Optional[Dict[Device, Sequence[str]]] = None):
+            """
+            Parameters
+            ----------
+            metric_names : Optional[Dict[Device, Sequence[str]]]
+                List of per-device metrics to collect. You can find a list of valid
+                metrics by runing `nvprof --query-metrics` from the command line.
+            """
+            metric_names = {} if metric_names is None else metric_names
+            wrapped = dict()
+            for dev, names in metric_names.items():
+                wrapped[DeviceWrapper(dev)] = names
+            self.__init_handle_by_constructor__(_ffi_api.CUPTIMetricCollector, wrapped)
@@ -91,6 +91,7 @@ class Executable(object):
         self._get_late_bound_consts = self.mod["get_late_bound_consts"]
         self._load_late_bound_consts = self.mod["load_late_bound_consts"]
         self._load_late_bound_consts_from_map = self.mod["load_late_bound_consts_from_map"]
+        self._save_to_mmap_file = self.mod["save_to_mmap_file"]
 
     def save(self):
         """Save the Relay VM Executable.
@@ -191,6 +192,42 @@ class Executable(object):
 
         return Executable(_ffi_api.Load_Executable(bytecode, lib))
 
+    def save_to_mmap_file(self, path):
+        """Save the bytecode and constants of the executable to a memory mappable file.
+
+        The constants are stored in a page aligned data region following the
+        bytecode, from which :py:func:`load_exec_from_mmap_file` wraps them in place.
+        The library must be saved separately, as for :py:func:`save`.
+
+        Parameters
+        ----------
+        path : str
+            The file to write to.
+        """
+        self._save_to_mmap_file(path)
+
+    @staticmethod
+    def load_exec_from_mmap_file(path, lib):
+        """Construct an executable from a file written by :py:func:`save_to_mmap_file`.
+
+        The file is memory mapped and the constants are CPU arrays over the mapping,
+        so they are only paged in when used and are shared across processes.
+
+        Parameters
+        ----------
+        path : str
+            The file to load from.
+
+        lib : :py:class:`~tvm.runtime.Module`
+            The runtime module that contains the generated code.
+
+        Returns
+        -------
+        exec: Executable
+            An executable constructed using the provided artifacts.
+        """
+        return Executable(_ffi_api.Load_ExecutableFromMmapFile(path, lib))
+
     @property
     def lib(self):
         """Get the library that contains hardware dependent code.
@@ -343,17 +380,23 @@ class VirtualMachine(object):
 
     memory_cfg : str or Dict[tvm.runtime.Device, str], optional
         Config the type of memory allocator. The allocator type can be ["naive",
-        "pooled"]. If memory_cfg is None, all devices will use pooled allocator
-        by default. If memory_cfg is string, all devices will use the specified
-        allocator type. If memory_cfg is a dict, each device uses the allocator
-        type specified in the dict, or pooled allocator if not specified in the
-        dict.
+        "pooled", "size_class", "stream_ordered"]. If memory_cfg is None, all
+        devices will use pooled allocator by default. If memory_cfg is string,
+        all devices will use the specified allocator type. If memory_cfg is a
+        dict, each device uses the allocator type specified in the dict, or
+        pooled allocator if not specified in the dict.
+
+    lazy_primitives : bool, optional
+        Whether to look up the primitives in the kernel library on their first
+        call rather than when the VM is created.
     """
 
     NAIVE_ALLOCATOR = 1
     POOLED_ALLOCATOR = 2
+    SIZE_CLASS_ALLOCATOR = 3
+    STREAM_ORDERED_ALLOCATOR = 4
 
-    def __init__(self, exe, device, memory_cfg=None):
+    def __init__(self, exe, device, memory_cfg=None, lazy_primitives=False):
         """
         Construct a VirtualMachine wrapper class which provides a simple
         interface over the raw C++ Module based API.
@@ -377,6 +420,9 @@ class VirtualMachine(object):
         memory_cfg: Optional[str]
             The allocator behavior to use for the VM.
 
+        lazy_primitives: bool
+            Whether to resolve the primitives on first use.
+
         Returns
         -------
         vm: VirtualMachine
@@ -391,7 +437,12 @@ class VirtualMachine(object):
         if not isinstance(exe, Executable):
             exe = Executable(exe)
 
-        self.module = exe.mod["vm_load_executable"]()
+        self._bind(exe, exe.mod["vm_load_executable"](lazy_primitives))
+        self._setup_device(device, memory_cfg)
+
+    def _bind(self, exe, module):
+        """Bind the wrapper to a VM module running the executable."""
+        self.module = module
         self._exec = exe
         self._init = self.module["init"]
         self._invoke = self.module["invoke"]
@@ -402,7 +453,22 @@ class VirtualMachine(object):
         self._set_input = self.module["set_input"]
         self._set_one_input = self.module["set_one_input"]
         self._set_outputs = self.module["set_outputs"]
-        self._setup_device(device, memory_cfg)
+
+    def clone(self):
+        """Create a VM running the same executable for another thread.
+
+        The clone shares the executable, the resolved kernels, the devices and
+        allocators and the constants already loaded on the devices, without
+        loading anything again. Its inputs, outputs and call frames are its own.
+
+        Returns
+        -------
+        vm: VirtualMachine
+            The new VM.
+        """
+        vm = VirtualMachine.__new__(VirtualMachine)
+        vm._bind(self._exec, self.module["clone"]())
+        return vm
 
     def _setup_device(self, dev, memory_cfg):
         """Init devices and allocators."""
@@ -420,9 +486,13 @@ class VirtualMachine(object):
         if memory_cfg is None:
             memory_cfg = {}
         elif isinstance(memory_cfg, str):
-            assert memory_cfg in ["naive", "pooled"]
+            assert memory_cfg in ["naive", "pooled", "size_class", "stream_ordered"]
             if memory_cfg == "naive":
                 default_alloc_type = VirtualMachine.NAIVE_ALLOCATOR
+            elif memory_cfg == "size_class":
+                default_alloc_type = VirtualMachine.SIZE_CLASS_ALLOCATOR
+            elif memory_cfg == "stream_ordered":
+                default_alloc_type = VirtualMachine.STREAM_ORDERED_ALLOCATOR
             memory_cfg = {}
         elif not isinstance(memory_cfg, dict):
             raise TypeError(
@@ -598,6 +668,36 @@ class VirtualMachine(object):
         self._set_outputs(func_name, *output_args)
         self._invoke(func_name)
 
+    def stream(self, func_name, states, reuse_outputs=True):
+        """Start streaming chunks through a function written in the stateful-chunk style.
+
+        The function takes the inputs of a chunk followed by the states, and returns
+        a tuple of its outputs followed by the new states. The states stay on the
+        device between chunks, so memory is bounded by the chunk size rather than by
+        the length of the whole input.
+
+        Parameters
+        ----------
+        func_name : str
+            The name of the function.
+
+        states : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The initial states, which are copied to the device.
+
+        reuse_outputs : bool
+            Whether the outputs and new states of a chunk are written into the buffers
+            of the chunk before the last one while the inputs keep their shapes. Every
+            field of the returned tuple must then be a tensor allocated by the function,
+            and the outputs of a chunk are only valid until the next chunk.
+
+        Returns
+        -------
+        stream : VMStream
+            The stream, to call with the inputs of each chunk.
+        """
+        self.module["begin_stream"](func_name, reuse_outputs, *convert(states))
+        return VMStream(self, func_name)
+
     def get_outputs(self):
         """Get the outputs from a call to :py:func`invoke_stateful`.
 
@@ -623,6 +723,47 @@ class VirtualMachine(object):
         """
         return self._get_input_index(input_name, func_name)
 
+    def set_shape_func_memo(self, enable=True):
+        """Memoize the results of shape functions.
+
+        When enabled, shape functions called again with the same input shapes (or,
+        for data dependent shape functions, the same small host inputs) reuse the
+        shapes computed the first time instead of being executed.
+
+        Parameters
+        ----------
+        enable : bool
+            Whether to memoize shape functions. Disabling the memo clears it.
+        """
+        self.module["set_shape_func_memo"](enable)
+
+    def prewarm_primitives(self, num_threads=1):
+        """Resolve the primitives not called yet on background threads.
+
+        Only useful for a VM created with ``lazy_primitives``, which can keep running
+        meanwhile.
+
+        Parameters
+        ----------
+        num_threads : int
+            The number of threads looking up primitives.
+        """
+        self.module["prewarm_primitives"](num_threads)
+
+    def set_num_streams(self, num_streams):
+        """Dispatch the kernels of the VM to a pool of streams.
+
+        Kernels reading and writing disjoint buffers, such as the ones of independent
+        branches of the model, are issued on different streams of the device so that
+        they can run concurrently. Dependent kernels are ordered with events.
+
+        Parameters
+        ----------
+        num_streams : int
+            The number of streams, 1 issues every kernel on the default stream.
+        """
+        self.module["set_num_streams"](num_streams)
+
     def benchmark(
         self,
         device,
@@ -739,3 +880,228 @@ class VirtualMachine(object):
             cooldown_interval_ms=cooldown_interval_ms,
             repeats_to_cooldown=repeats_to_cooldown,
         )(func_name)
+
+
+class VMStream(object):
+    """A stream of chunks run through a stateful function, see :py:func:`VirtualMachine.stream`.
+
+    Parameters
+    ----------
+    vm : VirtualMachine
+        The VM running the chunks.
+
+    func_name : str
+        The name of the function.
+    """
+
+    def __init__(self, vm, func_name):
+        self.func_name = func_name
+        self._run_chunk = vm.module["run_stream_chunk"]
+        self._end = vm.module["end_stream"]
+        self._states = None
+
+    def __call__(self, *args):
+        """Run the next chunk.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the chunk.
+
+        Returns
+        -------
+        result : Object
+            The outputs of the chunk, a tensor when there is only one.
+        """
+        return self._run_chunk(self.func_name, *convert(args))
+
+    def end(self):
+        """End the stream and release its buffers.
+
+        Returns
+        -------
+        states : list[tvm.runtime.NDArray]
+            The states after the last chunk.
+        """
+        if self._states is None:
+            self._states = list(self._end(self.func_name))
+        return self._states
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.end()
+
+
+class DynamicBatcher(object):
+    """Dynamic request batching front-end of a VM function.
+
+    Requests submitted concurrently from several threads are gathered into the
+    rows of a single batch, which runs as one invocation of the function. A batch
+    is run once ``max_batch_size`` rows are pending, or once its oldest request
+    waited for ``timeout_us`` microseconds, and is padded to the smallest of the
+    ``buckets`` holding all its rows. The rows of the function must be independent
+    of each other, and all its inputs and outputs must be batched along their first
+    axis.
+
+    Parameters
+    ----------
+    vm : VirtualMachine
+        The VM running the batches. It must not be invoked directly while batching.
+
+    device : tvm.runtime.Device
+        The device the batch inputs are allocated on, the one the inputs of the
+        function are expected on.
+
+    max_batch_size : int
+        The maximum number of rows of a batch.
+
+    timeout_us : int
+        How long a request waits for other requests to batch with.
+
+    buckets : Optional[List[int]]
+        The batch sizes a batch is padded to. By default batches are not padded.
+
+    func_name : str
+        The name of the batched function.
+    """
+
+    def __init__(self, vm, device, max_batch_size, timeout_us, buckets=None, func_name="main"):
+        if buckets is None:
+            buckets = []
+        self.module = _ffi_api._DynamicBatcher(
+            vm.module, func_name, max_batch_size, timeout_us, container.ShapeTuple(buckets), device
+        )
+        self._submit = self.module["submit"]
+
+    def submit(self, *args):
+        """Run one request, blocking until its outputs are ready.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the request, holding the same number of rows.
+
+        Returns
+        -------
+        outputs : List[NDArray]
+            The outputs of the request, views over its rows of the batch outputs.
+        """
+        return list(self._submit(*convert(args)))
+
+    @property
+    def num_batches(self):
+        """The number of batches run so far."""
+        return self.module["get_num_batches"]()
+
+
+class PagedKVCache(object):
+    """Paged key/value cache of the attention layers of autoregressive decoding.
+
+    The keys and values of all the sequences live in one pool of fixed size pages,
+    allocated through the pooled allocator of the device. Each sequence holds a block
+    table, the list of its pages, so growing it by a token only writes that token.
+    Forked sequences share their pages until one of them writes into a shared page.
+    The kernels of ``topi.nn.paged_attention`` read the pool through the block tables.
+
+    Parameters
+    ----------
+    num_layers : int
+        The number of attention layers.
+
+    num_heads : int
+        The number of attention heads.
+
+    head_dim : int
+        The dimension of each head.
+
+    page_size : int
+        The number of tokens of a page.
+
+    num_pages : int
+        The number of pages of the pool.
+
+    dtype : str
+        The data type of the keys and values.
+
+    device : tvm.runtime.Device
+        The device holding the pool.
+    """
+
+    def __init__(self, num_layers, num_heads, head_dim, page_size, num_pages, dtype, device):
+        self.module = _ffi_api._PagedKVCache(
+            num_layers, num_heads, head_dim, page_size, num_pages, dtype, device
+        )
+        self.page_size = page_size
+
+    def add_sequence(self, seq_id):
+        """Start an empty sequence."""
+        self.module["add_sequence"](seq_id)
+
+    def remove_sequence(self, seq_id):
+        """Drop a sequence, releasing the pages no other sequence holds."""
+        self.module["remove_sequence"](seq_id)
+
+    def fork_sequence(self, parent, child):
+        """Start a sequence holding the tokens of parent, sharing its pages."""
+        self.module["fork_sequence"](parent, child)
+
+    def reserve(self, seq_id, num_tokens):
+        """Grow a sequence by num_tokens tokens, written next by append for each layer."""
+        self.module["reserve"](seq_id, num_tokens)
+
+    def append(self, seq_id, layer, keys, values):
+        """Write the keys and values of the tokens reserved last for one layer.
+
+        Parameters
+        ----------
+        seq_id : int
+            The sequence.
+
+        layer : int
+            The attention layer.
+
+        keys : tvm.runtime.NDArray or np.ndarray
+            The keys, of shape (num_tokens, num_heads, head_dim).
+
+        values : tvm.runtime.NDArray or np.ndarray
+            The values, of the same shape.
+        """
+        keys, values = convert([keys, values])
+        self.module["append"](seq_id, layer, keys, values)
+
+    def block_table(self, seq_ids):
+        """The block tables and lengths of a batch of sequences.
+
+        Parameters
+        ----------
+        seq_ids : List[int]
+            The sequences of the batch.
+
+        Returns
+        -------
+        block_table : tvm.runtime.NDArray
+            The pages of each sequence, an int32 tensor of shape (batch, max_pages)
+            padded with page 0.
+
+        seq_lens : tvm.runtime.NDArray
+            The number of tokens of each sequence, an int32 tensor of shape (batch,).
+        """
+        table, lengths = self.module["get_block_table"](container.ShapeTuple(seq_ids))
+        return table, lengths
+
+    @property
+    def pages(self):
+        """The pool of pages, of shape
+        (num_layers, 2, num_pages, page_size, num_heads, head_dim)."""
+        return self.module["get_pages"]()
+
+    def length(self, seq_id):
+        """The number of tokens of a sequence."""
+        return self.module["get_length"](seq_id)
+
+    @property
+    def num_free_pages(self):
+        """The number of pages no sequence holds."""
+        return self.module["get_num_free_pages"]()
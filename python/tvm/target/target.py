@@ -240,6 +240,13 @@ class Target(Object):
         else:
             return False
 
+    @property
+    def supports_khr_cooperative_matrix(self):
+        if self.attrs.get("supports_khr_cooperative_matrix", []):
+            return bool(self.attrs["supports_khr_cooperative_matrix"])
+        else:
+            return False
+
     @property
     def features(self):
         return TargetFeatures(self)
@@ -1025,13 +1025,16 @@ class BufferLoad(PrimExprWithOp):
     indices : List[PrimExpr]
         The buffer indices.
 
+    predicate : Optional[PrimExpr]
+        The boolean mask of the lanes to load, all the lanes are loaded if None.
+
     span : Optional[Span]
         The location of this itervar in the source code.
     """
 
-    def __init__(self, buffer, indices, span=None):
+    def __init__(self, buffer, indices, predicate=None, span=None):
         self.__init_handle_by_constructor__(
-            _ffi_api.BufferLoad, buffer, indices, span  # type: ignore
+            _ffi_api.BufferLoad, buffer, indices, predicate, span  # type: ignore
         )
 
 
@@ -16,7 +16,6 @@
 # under the License.
 # pylint: disable=invalid-name,missing-function-docstring
 """Intrinsics for tensorization on NVIDIA GPU."""
-import re
 from typing import Dict, Tuple
 
 from typing_extensions import Literal
@@ -25,7 +24,7 @@ from tvm.script import tir as T
 from tvm.tir.function import PrimFunc
 
 from ..._ffi import register_func
-from ...runtime import convert
+from ...runtime import DataType, convert
 from .. import Cast, IntImm, TensorIntrin
 
 
@@ -46,8 +45,7 @@ def shared_32x16_to_ldmatrix_32x16_layout(i, j):
 
 def get_tensor_core_load_offset_factor(dtype):
     """get offset factor for tensor core load intrin"""
-    bits = re.search(r"(\d+)", dtype).group(0)
-    bits = int(bits)
+    bits = DataType(dtype).bits
     if bits <= 4:
         # sub-byte oeprations have different offset factor
         return 128 // bits
@@ -96,13 +94,15 @@ def get_ldmatrix_intrin(k_dim, dtype, is_b, transposed, shared_scope="shared"):
                 tx // HALF_WARP_expr
             )
     else:
-        assert (
-            k_dim == 32 and dtype == "int8"
-        ), "Only k_dim == 16 (float16) or k_dim == 32 (int8) supported for now"
+        assert k_dim == 32 and dtype in [
+            "int8",
+            "e4m3_float8",
+            "e5m2_float8",
+        ], "Only k_dim == 16 (float16) or k_dim == 32 (int8/float8) supported for now"
 
         if ldmatrix_col_major:
             index_map = shared_32x16_to_ldmatrix_32x16_layout
-            # A dummy offset, ldmatrix cannot be used for int8 + trans case.
+            # A dummy offset, ldmatrix cannot be used for 8-bit + trans case.
             # We still use the ldmatrix intrinsic, but lower it to a manual loop in the codegen.
             # Only the stride information is required.
             shared_offset = lambda _, stride: stride
@@ -205,7 +205,7 @@ def get_ldmatrix_intrin(k_dim, dtype, is_b, transposed, shared_scope="shared"):
     return ldmatrix_desc, ldmatrix_impl
 
 
-def get_mma_intrin(k_dim, out_dtype, b_transposed):
+def get_mma_intrin(k_dim, out_dtype, b_transposed, in_dtype=None):
     local_size = (M_DIM * k_dim) // WARP_SIZE
     local_size_out = (M_DIM * N_DIM) // 32
 
@@ -227,12 +227,14 @@ def get_mma_intrin(k_dim, out_dtype, b_transposed):
 
     out_dtype_abbrv = {"float16": "fp16", "float32": "fp32", "int32": "int32"}[out_dtype]
 
-    if out_dtype in ["float16", "float32"]:
-        in_dtype = "float16"
-        in_dtype_abbrv = "fp16"
-    else:
-        in_dtype = "int8"
-        in_dtype_abbrv = "int8"
+    if in_dtype is None:
+        in_dtype = "float16" if out_dtype in ["float16", "float32"] else "int8"
+    in_dtype_abbrv = {
+        "float16": "fp16",
+        "int8": "int8",
+        "e4m3_float8": "e4m3",
+        "e5m2_float8": "e5m2",
+    }[in_dtype]
 
     def maybe_cast(v):
         if out_dtype in ["float32", "int32"]:
@@ -519,6 +521,56 @@ TensorIntrin.register(MMA_i8i8i32_INTRIN, *get_mma_intrin(32, "int32", False))
 MMA_i8i8i32_TRANS_INTRIN = "mma_i8i8i32_trans"
 TensorIntrin.register(MMA_i8i8i32_TRANS_INTRIN, *get_mma_intrin(32, "int32", True))
 
+LDMATRIX_16x32_A_E4M3_INTRIN = "mma.ldmatrix_16x32_a_e4m3"
+TensorIntrin.register(
+    LDMATRIX_16x32_A_E4M3_INTRIN, *get_ldmatrix_intrin(32, "e4m3_float8", False, False)
+)
+
+LDMATRIX_32x16_B_E4M3_INTRIN = "mma.ldmatrix_32x16_b_e4m3"
+TensorIntrin.register(
+    LDMATRIX_32x16_B_E4M3_INTRIN, *get_ldmatrix_intrin(32, "e4m3_float8", True, False)
+)
+
+LDMATRIX_16x32_B_TRANS_E4M3_INTRIN = "mma.ldmatrix_16x32_b_trans_e4m3"
+TensorIntrin.register(
+    LDMATRIX_16x32_B_TRANS_E4M3_INTRIN, *get_ldmatrix_intrin(32, "e4m3_float8", True, True)
+)
+
+LDMATRIX_16x32_A_E5M2_INTRIN = "mma.ldmatrix_16x32_a_e5m2"
+TensorIntrin.register(
+    LDMATRIX_16x32_A_E5M2_INTRIN, *get_ldmatrix_intrin(32, "e5m2_float8", False, False)
+)
+
+LDMATRIX_32x16_B_E5M2_INTRIN = "mma.ldmatrix_32x16_b_e5m2"
+TensorIntrin.register(
+    LDMATRIX_32x16_B_E5M2_INTRIN, *get_ldmatrix_intrin(32, "e5m2_float8", True, False)
+)
+
+LDMATRIX_16x32_B_TRANS_E5M2_INTRIN = "mma.ldmatrix_16x32_b_trans_e5m2"
+TensorIntrin.register(
+    LDMATRIX_16x32_B_TRANS_E5M2_INTRIN, *get_ldmatrix_intrin(32, "e5m2_float8", True, True)
+)
+
+MMA_e4m3e4m3f32_INTRIN = "mma_e4m3e4m3f32"
+TensorIntrin.register(
+    MMA_e4m3e4m3f32_INTRIN, *get_mma_intrin(32, "float32", False, "e4m3_float8")
+)
+
+MMA_e4m3e4m3f32_TRANS_INTRIN = "mma_e4m3e4m3f32_trans"
+TensorIntrin.register(
+    MMA_e4m3e4m3f32_TRANS_INTRIN, *get_mma_intrin(32, "float32", True, "e4m3_float8")
+)
+
+MMA_e5m2e5m2f32_INTRIN = "mma_e5m2e5m2f32"
+TensorIntrin.register(
+    MMA_e5m2e5m2f32_INTRIN, *get_mma_intrin(32, "float32", False, "e5m2_float8")
+)
+
+MMA_e5m2e5m2f32_TRANS_INTRIN = "mma_e5m2e5m2f32_trans"
+TensorIntrin.register(
+    MMA_e5m2e5m2f32_TRANS_INTRIN, *get_mma_intrin(32, "float32", True, "e5m2_float8")
+)
+
 MMA_fill_16x16_f32_INTRIN = "mma_fill_16x16_f32"
 TensorIntrin.register(MMA_fill_16x16_f32_INTRIN, *get_mma_fill_intrin("float32", 8))
 
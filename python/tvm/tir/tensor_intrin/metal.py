@@ -0,0 +1,372 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,missing-function-docstring
+"""Intrinsics for tensorization on Apple GPU with simdgroup matrices.
+
+The intrinsics use the WMMA builtins and fragment scopes, which the Metal codegen emits as
+8x8 simdgroup matrix operations, so that they work with MultiLevelTilingTensorCore.
+"""
+from typing import Dict, Tuple
+
+from typing_extensions import Literal
+
+from tvm.script import tir as T
+from tvm.tir.function import PrimFunc
+
+from .. import Cast, IntImm, TensorIntrin
+from .cuda import get_wmma_fragment_index
+
+# The fragments are 8x8 tiles, so their offsets are multiples of 8 elements
+SIMDGROUP_OFFSET_FACTOR = 8
+
+
+def get_simdgroup_load_intrin(
+    dtype: str, shared_scope: str, is_b: bool, is_col_major: bool
+) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of simdgroup_load intrins"""
+    fragment_scope = "wmma.matrix_{}".format("b" if is_b else "a")
+    layout = "col_major" if is_col_major else "row_major"
+
+    @T.prim_func
+    def simdgroup_load_desc(a: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (8, 8), dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope=shared_scope
+        )
+        C = T.match_buffer(
+            c, (8, 8), dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope=fragment_scope
+        )
+        with T.block("root"):
+            T.reads(A[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            for i, j in T.grid(8, 8):
+                with T.block("load"):
+                    vii, vjj = T.axis.remap("SS", [i, j])
+                    C[vii, vjj] = A[vii, vjj]
+
+    @T.prim_func
+    def simdgroup_load_impl(a: T.handle, c: T.handle) -> None:
+        s1 = T.int32()
+        s0 = T.int32()
+        d1 = T.int32()
+        d0 = T.int32()
+        A = T.match_buffer(
+            a,
+            (8, 8),
+            dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope=shared_scope,
+            strides=[s1, s0],
+        )
+        C = T.match_buffer(
+            c,
+            (8, 8),
+            dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope=fragment_scope,
+            strides=[d1, d0],
+        )
+        with T.block("root"):
+            T.reads(A[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            T.evaluate(
+                T.tvm_load_matrix_sync(
+                    C.data,
+                    8,
+                    8,
+                    8,
+                    get_wmma_fragment_index(C, d1, 8, 8),
+                    A.access_ptr("r"),
+                    s1,
+                    layout,
+                    dtype="handle",
+                )
+            )
+
+    return simdgroup_load_desc, simdgroup_load_impl
+
+
+def get_simdgroup_fill_intrin(dtype: str) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of simdgroup_fill intrins"""
+    zero = IntImm("int32", 0).astype(dtype)
+
+    @T.prim_func
+    def simdgroup_fill_desc(c: T.handle) -> None:
+        C = T.match_buffer(
+            c, (8, 8), dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope="wmma.accumulator"
+        )
+        with T.block("root"):
+            T.reads()
+            T.writes(C[0:8, 0:8])
+            for i, j in T.grid(8, 8):
+                with T.block("init"):
+                    vii, vjj = T.axis.remap("SS", [i, j])
+                    C[vii, vjj] = zero
+
+    @T.prim_func
+    def simdgroup_fill_impl(c: T.handle) -> None:
+        d1 = T.int32()
+        d0 = T.int32()
+        C = T.match_buffer(
+            c,
+            (8, 8),
+            dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope="wmma.accumulator",
+            strides=[d1, d0],
+        )
+        with T.block("root"):
+            T.reads()
+            T.writes(C[0:8, 0:8])
+            T.evaluate(
+                T.tvm_fill_fragment(
+                    C.data, 8, 8, 8, get_wmma_fragment_index(C, d1, 8, 8), zero, dtype="handle"
+                )
+            )
+
+    return simdgroup_fill_desc, simdgroup_fill_impl
+
+
+def get_simdgroup_store_intrin(dtype: str, scope: str) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of simdgroup_store intrins"""
+
+    @T.prim_func
+    def simdgroup_store_desc(a: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (8, 8), dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope="wmma.accumulator"
+        )
+        C = T.match_buffer(c, (8, 8), dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope=scope)
+        with T.block("root"):
+            T.reads(A[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            for i, j in T.grid(8, 8):
+                with T.block("store"):
+                    vii, vjj = T.axis.remap("SS", [i, j])
+                    C[vii, vjj] = A[vii, vjj]
+
+    @T.prim_func
+    def simdgroup_store_impl(a: T.handle, c: T.handle) -> None:
+        s1 = T.int32()
+        s0 = T.int32()
+        d1 = T.int32()
+        d0 = T.int32()
+        A = T.match_buffer(
+            a,
+            (8, 8),
+            dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope="wmma.accumulator",
+            strides=[d1, d0],
+        )
+        C = T.match_buffer(
+            c,
+            (8, 8),
+            dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope=scope,
+            strides=[s1, s0],
+        )
+        with T.block("root"):
+            T.reads(A[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            T.evaluate(
+                T.tvm_store_matrix_sync(
+                    A.data,
+                    8,
+                    8,
+                    8,
+                    get_wmma_fragment_index(A, d1, 8, 8),
+                    C.access_ptr("w"),
+                    s1,
+                    "row_major",
+                    dtype="handle",
+                )
+            )
+
+    return simdgroup_store_desc, simdgroup_store_impl
+
+
+def get_simdgroup_sync_intrin(
+    in_dtype: str, out_dtype: str, b_transposed: bool
+) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of simdgroup_sync intrins, i.e. C += A * B on 8x8 simdgroup matrices"""
+
+    def maybe_cast(v):
+        if in_dtype != out_dtype:
+            return Cast(out_dtype, v)
+        return v
+
+    def maybe_swap(i, j):
+        if b_transposed:
+            return j, i
+        return i, j
+
+    @T.prim_func
+    def simdgroup_sync_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (8, 8), in_dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope="wmma.matrix_a"
+        )
+        B = T.match_buffer(
+            b, (8, 8), in_dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope="wmma.matrix_b"
+        )
+        C = T.match_buffer(
+            c, (8, 8), out_dtype, offset_factor=SIMDGROUP_OFFSET_FACTOR, scope="wmma.accumulator"
+        )
+        with T.block("root"):
+            T.reads(C[0:8, 0:8], A[0:8, 0:8], B[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            for i, j, k in T.grid(8, 8, 8):
+                with T.block(""):
+                    vii, vjj, vkk = T.axis.remap("SSR", [i, j, k])
+                    B_index_0, B_index_1 = T.meta_var(maybe_swap(vkk, vjj))
+                    C[vii, vjj] = C[vii, vjj] + maybe_cast(A[vii, vkk]) * maybe_cast(
+                        B[B_index_0, B_index_1]
+                    )
+
+    @T.prim_func
+    def simdgroup_sync_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        a1 = T.int32()
+        a0 = T.int32()
+        b1 = T.int32()
+        b0 = T.int32()
+        c1 = T.int32()
+        c0 = T.int32()
+        A = T.match_buffer(
+            a,
+            (8, 8),
+            in_dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope="wmma.matrix_a",
+            strides=[a1, a0],
+        )
+        B = T.match_buffer(
+            b,
+            (8, 8),
+            in_dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope="wmma.matrix_b",
+            strides=[b1, b0],
+        )
+        C = T.match_buffer(
+            c,
+            (8, 8),
+            out_dtype,
+            offset_factor=SIMDGROUP_OFFSET_FACTOR,
+            scope="wmma.accumulator",
+            strides=[c1, c0],
+        )
+        with T.block("root"):
+            T.reads(C[0:8, 0:8], A[0:8, 0:8], B[0:8, 0:8])
+            T.writes(C[0:8, 0:8])
+            T.evaluate(
+                T.tvm_mma_sync(
+                    C.data,
+                    get_wmma_fragment_index(C, c1, 8, 8),
+                    A.data,
+                    get_wmma_fragment_index(A, a1, 8, 8),
+                    B.data,
+                    get_wmma_fragment_index(B, b1, 8, 8),
+                    C.data,
+                    get_wmma_fragment_index(C, c1, 8, 8),
+                    dtype="handle",
+                )
+            )
+
+    return simdgroup_sync_desc, simdgroup_sync_impl
+
+
+_DTYPE_ABBR = {"float16": "f16", "float32": "f32"}
+
+for _dtype, _abbr in _DTYPE_ABBR.items():
+    # e.g. simdgroup_load_8x8x8_f16_a_shared, simdgroup_load_8x8x8_f16_b_trans_shared
+    TensorIntrin.register(
+        f"simdgroup_load_8x8x8_{_abbr}_a_shared",
+        *get_simdgroup_load_intrin(_dtype, "shared", False, False),
+    )
+    TensorIntrin.register(
+        f"simdgroup_load_8x8x8_{_abbr}_b_shared",
+        *get_simdgroup_load_intrin(_dtype, "shared", True, False),
+    )
+    TensorIntrin.register(
+        f"simdgroup_load_8x8x8_{_abbr}_b_trans_shared",
+        *get_simdgroup_load_intrin(_dtype, "shared", True, True),
+    )
+    # e.g. simdgroup_fill_8x8x8_f32
+    TensorIntrin.register(f"simdgroup_fill_8x8x8_{_abbr}", *get_simdgroup_fill_intrin(_dtype))
+    # e.g. simdgroup_store_8x8x8_f32_shared, simdgroup_store_8x8x8_f32_global
+    for _scope in ["shared", "global"]:
+        TensorIntrin.register(
+            f"simdgroup_store_8x8x8_{_abbr}_{_scope}", *get_simdgroup_store_intrin(_dtype, _scope)
+        )
+
+# e.g. simdgroup_sync_8x8x8_f16f16f32, simdgroup_sync_8x8x8_f16f16f32_trans
+for _in_dtype, _out_dtype in [
+    ("float16", "float16"),
+    ("float16", "float32"),
+    ("float32", "float32"),
+]:
+    for _trans_b in [False, True]:
+        TensorIntrin.register(
+            "simdgroup_sync_8x8x8_{0}{0}{1}{2}".format(
+                _DTYPE_ABBR[_in_dtype], _DTYPE_ABBR[_out_dtype], "_trans" if _trans_b else ""
+            ),
+            *get_simdgroup_sync_intrin(_in_dtype, _out_dtype, _trans_b),
+        )
+
+
+def get_simdgroup_intrin_group(
+    store_scope: Literal["global", "shared"],
+    in_dtype: Literal["float16", "float32"],
+    out_dtype: Literal["float16", "float32"],
+    trans_b: bool,
+) -> Dict[str, str]:
+    """Get a group of simdgroup matrix intrinsics with the given configurations, to be used by
+    MultiLevelTilingTensorCore. The inputs are loaded from shared memory.
+
+    Parameters
+    ----------
+    store_scope : Literal["global", "shared"]
+        The memory scope of the result buffer.
+
+    in_dtype : Literal["float16", "float32"]
+        The input data type.
+
+    out_dtype : Literal["float16", "float32"]
+        The output data dtype.
+
+    trans_b : bool
+        Whether the input matrix B is transposed.
+
+    Returns
+    -------
+    ret : Dict[str, str]
+        A group of tensor intrinsics.
+    """
+    assert store_scope in ["global", "shared"]
+    assert in_dtype in ["float16", "float32"]
+    assert out_dtype in ["float16", "float32"]
+    assert in_dtype == "float16" or out_dtype == "float32"
+
+    in_dtype = _DTYPE_ABBR[in_dtype]
+    out_dtype = _DTYPE_ABBR[out_dtype]
+    trans_b = "_trans" if trans_b else ""
+    return {
+        "init": f"simdgroup_fill_8x8x8_{out_dtype}",
+        "load_a": f"simdgroup_load_8x8x8_{in_dtype}_a_shared",
+        "load_b": f"simdgroup_load_8x8x8_{in_dtype}_b{trans_b}_shared",
+        "compute": f"simdgroup_sync_8x8x8_{in_dtype}{in_dtype}{out_dtype}{trans_b}",
+        "store": f"simdgroup_store_8x8x8_{out_dtype}_{store_scope}",
+    }
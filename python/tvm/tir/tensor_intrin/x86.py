@@ -112,3 +112,57 @@ AVX512_DOT_16x4_INTRIN = "dot_16x4_avx512"
 TensorIntrin.register(
     AVX512_DOT_16x4_INTRIN, dot_product_16x4_u8i8i32_desc, dot_product_16x4_u8i8i32_avx512
 )
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_desc(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+        for i in T.serial(0, 16):
+            for k in T.serial(0, 2):
+                with T.block("update"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    C[vi] = C[vi] + T.cast(A[vk], "float32") * T.cast(B[vi, vk], "float32")
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_avx512bf16(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+
+        # The pairs of bf16 values are passed as 32-bit lanes, which the LLVM codegen casts to the
+        # operand type of the intrinsic of the LLVM version in use
+        A_bf16x2 = A.vload([0], "bfloat16x2")
+        A_i32 = T.reinterpret(A_bf16x2, dtype="int32")
+
+        B_bf16x32 = B.vload([0, 0], dtype="bfloat16x32")
+        B_i32x16 = T.reinterpret(B_bf16x32, dtype="int32x16")
+        C_f32x16 = C.vload([0], dtype="float32x16")
+
+        C[T.ramp(T.int32(0), 1, 16)] = T.call_llvm_pure_intrin(
+            T.llvm_lookup_intrinsic_id("llvm.x86.avx512bf16.dpbf16ps.512"),
+            T.uint32(3),
+            C_f32x16,
+            T.broadcast(A_i32, 16),
+            B_i32x16,
+            dtype="float32x16",
+        )
+
+
+AVX512BF16_DOT_16x2_INTRIN = "dot_16x2_avx512bf16"
+
+TensorIntrin.register(
+    AVX512BF16_DOT_16x2_INTRIN,
+    dot_product_16x2_bf16bf16f32_desc,
+    dot_product_16x2_bf16bf16f32_avx512bf16,
+)
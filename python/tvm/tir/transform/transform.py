@@ -308,6 +308,22 @@ def BF16StorageLegalize():
     return _ffi_api.BF16StorageLegalize()  # type: ignore
 
 
+def FP8ComputeLegalize(promote_dtype_str: str = "float16"):
+    """Legalize fp8 compute Ops.
+
+    Parameters
+    ----------
+    promote_dtype_str : str
+        The float type that the fp8 compute is promoted to.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.FP8ComputeLegalize(promote_dtype_str)  # type: ignore
+
+
 def CommonSubexprElimTIR(enable_cse_tir: bool = True, identify_equiv_terms: bool = False):
     """Replace redundant computations by new variables.
 
@@ -876,6 +892,12 @@ def MergeDynamicSharedMemoryAllocations():
     """This pass merges multiple TIR-level dynamic shared memory allocations
     into one allocation.
 
+    The buffers are packed by their live intervals, so that buffers which are
+    never live at the same time share memory. The minimum alignment of each
+    buffer and the padding of the buffers whose size is a multiple of a bank
+    row are set by the ``align_bytes`` and ``swizzle_pad_bytes`` fields of the
+    ``tir.MergeDynamicSharedMemoryAllocations`` pass config.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -81,6 +81,10 @@ class BufferInfo(Object):
         """Sets the conflicting array of buffer info objects"""
         _ffi_api.BufferInfoSetConflicts(self, conflicts)
 
+    def set_access_bytes(self, read_bytes: int, write_bytes: int):
+        """Sets the estimated number of bytes read from and written to the buffer"""
+        _ffi_api.BufferInfoSetAccessBytes(self, read_bytes, write_bytes)
+
 
 @register_object("tir.usmp.PoolAllocation")
 class PoolAllocation(Object):
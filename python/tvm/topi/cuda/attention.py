@@ -0,0 +1,166 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,unused-argument
+"""cuda fused_attention operators"""
+from tvm import autotvm, te
+from tvm.autotvm.task.space import OtherOptionEntity, SplitEntity
+
+from .. import nn
+from ..utils import get_const_tuple, get_max_power2_factor, traverse_inline
+
+
+@autotvm.register_topi_compute("fused_attention.cuda")
+def fused_attention(cfg, query, key, value, scale=1.0, out_dtype=None):
+    """Compute fused scaled dot-product attention on CUDA, see topi.nn.fused_attention."""
+    return nn.fused_attention(query, key, value, scale, out_dtype)
+
+
+@autotvm.register_topi_schedule("fused_attention.cuda")
+def schedule_fused_attention(cfg, outs):
+    """Schedule for fused_attention
+
+    Each thread block computes a row of the output. The scores of the row are computed a tile of
+    keys at a time into shared memory, and reduced into the online softmax state of the threads,
+    which hold the state in registers, so that the score matrix never reaches global memory.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        AutoTVM tuning space config file.
+    outs : Array of Tensor
+        The computation graph description of fused_attention
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    s: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _schedule(cfg, op):
+        output = op.output(0)
+        state = op.input_tensors[0].op
+        (score,) = [t for t in state.input_tensors if t.op.tag == "fused_attention_score"]
+        _, _, seq_kv = get_const_tuple(score.shape)
+        _, _, value_dim = get_const_tuple(output.shape)
+
+        b, i, d = s[output].op.axis
+        (j,) = s[state].op.reduce_axis
+        cfg.define_split("tile_d", d, num_outputs=2)
+        cfg.define_split("tile_j", j, num_outputs=2)
+        cfg.define_knob("auto_unroll_max_step", [0, 16, 64])
+        if cfg.is_fallback:
+            num_thread = get_max_power2_factor(value_dim, 128)
+            cfg["tile_d"] = SplitEntity([num_thread, value_dim // num_thread])
+            tile_j = get_max_power2_factor(seq_kv, 64)
+            cfg["tile_j"] = SplitEntity([seq_kv // tile_j, tile_j])
+            cfg["auto_unroll_max_step"] = OtherOptionEntity(16)
+        num_thread = cfg["tile_d"].size[0]
+        thread_x = te.thread_axis("threadIdx.x")
+
+        s[state].set_scope("local")
+        s[score].set_scope("shared")
+
+        bi = s[output].fuse(b, i)
+        tx, _ = cfg["tile_d"].apply(s, output, d)
+        s[output].bind(bi, te.thread_axis("blockIdx.x"))
+        s[output].bind(tx, thread_x)
+
+        # The keys are the outer loop, so that the threads of the block share each score tile
+        s[state].compute_at(s[output], bi)
+        _, _, d = s[state].op.axis
+        jo, ji = cfg["tile_j"].apply(s, state, j)
+        tx, di = cfg["tile_d"].apply(s, state, d)
+        s[state].reorder(jo, tx, ji, di)
+        s[state].bind(tx, thread_x)
+        s[state].pragma(ji, "auto_unroll_max_step", cfg["auto_unroll_max_step"].val)
+
+        s[score].compute_at(s[state], jo)
+        _, _, j = s[score].op.axis
+        tx, _ = s[score].split(j, nparts=num_thread)
+        s[score].bind(tx, thread_x)
+
+    def _callback(op):
+        if op.tag == "fused_attention":
+            _schedule(cfg, op)
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def schedule_paged_attention(outs):
+    """Schedule for paged_attention
+
+    Each thread block computes the output of a head of a sequence. The scores are computed a page
+    at a time into shared memory, and reduced into the online softmax state of the threads, which
+    hold the state in registers.
+
+    Parameters
+    ----------
+    outs : Array of Tensor
+        The computation graph description of paged_attention
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    s: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _schedule(op):
+        output = op.output(0)
+        state = op.input_tensors[0].op
+        (score,) = [t for t in state.input_tensors if t.op.tag == "paged_attention_score"]
+        (pages,) = [t for t in score.op.input_tensors if len(t.shape) == 6]
+        page_size = get_const_tuple(pages.shape)[3]
+        _, _, head_dim = get_const_tuple(output.shape)
+        num_thread = get_max_power2_factor(head_dim, 128)
+        thread_x = te.thread_axis("threadIdx.x")
+
+        s[state].set_scope("local")
+        s[score].set_scope("shared")
+
+        b, h, d = s[output].op.axis
+        bh = s[output].fuse(b, h)
+        tx, _ = s[output].split(d, nparts=num_thread)
+        s[output].bind(bh, te.thread_axis("blockIdx.x"))
+        s[output].bind(tx, thread_x)
+
+        # The pages are the outer loop, so that the threads of the block share each score page
+        s[state].compute_at(s[output], bh)
+        _, _, d = s[state].op.axis
+        (t,) = s[state].op.reduce_axis
+        to, ti = s[state].split(t, factor=page_size)
+        tx, di = s[state].split(d, nparts=num_thread)
+        s[state].reorder(to, tx, ti, di)
+        s[state].bind(tx, thread_x)
+
+        s[score].compute_at(s[state], to)
+        _, _, t = s[score].op.axis
+        tx, _ = s[score].split(t, nparts=num_thread)
+        s[score].bind(tx, thread_x)
+
+    def _callback(op):
+        if op.tag == "paged_attention":
+            _schedule(op)
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
@@ -849,6 +849,40 @@ def schedule_batch_matmul(outs):
     return _default_schedule(outs, False)
 
 
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    return _default_schedule(outs, False)
+
+
+def schedule_paged_attention(outs):
+    """Schedule for paged_attention
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of paged_attention
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    return _default_schedule(outs, False)
+
+
 def schedule_batch_norm(outs):
     """Schedule for batch_norm
 
@@ -45,10 +45,12 @@ from .local_response_norm import *
 from .bitserial_conv2d import *
 from .bitserial_dense import *
 from .batch_matmul import *
+from .attention import *
 from .batch_norm import *
 from .sparse import *
 from .pad import *
 from .fifo_buffer import *
+from .embedding import *
 from .depth_to_space import *
 from .space_to_depth import *
 from .space_to_batch_nd import *
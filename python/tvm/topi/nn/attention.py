@@ -0,0 +1,208 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Fused scaled dot-product attention"""
+# pylint: disable=invalid-name
+import tvm
+from tvm import te
+
+
+def _online_softmax_reducer():
+    """The reducer of the online softmax, whose state is the running maximum of the scores, the
+    sum of their exponentials and the sum of the values weighted by the exponentials, both
+    relative to the running maximum. Merging two states rescales them to the larger maximum, so
+    that the reduction is commutative and the exponentials never overflow."""
+
+    def _combine(lhs, rhs):
+        max_l, sum_l, acc_l = lhs
+        max_r, sum_r, acc_r = rhs
+        new_max = te.max(max_l, max_r)
+        scale_l = te.exp(max_l - new_max)
+        scale_r = te.exp(max_r - new_max)
+        return new_max, sum_l * scale_l + sum_r * scale_r, acc_l * scale_l + acc_r * scale_r
+
+    def _identity(max_dtype, sum_dtype, acc_dtype):
+        return (
+            tvm.te.min_value(max_dtype),
+            tvm.tir.const(0, sum_dtype),
+            tvm.tir.const(0, acc_dtype),
+        )
+
+    return te.comm_reducer(_combine, _identity, name="online_softmax")
+
+
+def fused_attention(query, key, value, scale=1.0, out_dtype=None):
+    """Scaled dot-product attention, softmax(query * key^T * scale) * value, computed with an
+    online softmax.
+
+    The softmax and the product with the value are fused into a single reduction over the keys,
+    so that a schedule computing the scores under the reduction loop never materializes the
+    [seq_q, seq_kv] score matrix, and the memory traffic grows linearly with the sequence length.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        3-D with shape [batch, seq_q, head_dim].
+
+    key : tvm.te.Tensor
+        3-D with shape [batch, seq_kv, head_dim].
+
+    value : tvm.te.Tensor
+        3-D with shape [batch, seq_kv, value_dim].
+
+    scale : float
+        The scale applied to the scores before the softmax.
+
+    out_dtype : Optional[str]
+        The output data type. The scores and the softmax are accumulated in float32 for float16
+        inputs. Defaults to the data type of the query.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, seq_q, value_dim].
+    """
+    assert len(query.shape) == 3 and len(key.shape) == 3 and len(value.shape) == 3
+    if out_dtype is None:
+        out_dtype = query.dtype
+    acc_dtype = "float32" if query.dtype == "float16" else query.dtype
+    batch, seq_q, head_dim = query.shape
+    _, seq_kv, value_dim = value.shape
+
+    k = te.reduce_axis((0, head_dim), name="k")
+    score = te.compute(
+        (batch, seq_q, seq_kv),
+        lambda b, i, j: te.sum(
+            query[b, i, k].astype(acc_dtype)
+            * key[b, j, k].astype(acc_dtype)
+            * tvm.tir.const(scale, acc_dtype),
+            axis=k,
+        ),
+        name="attention_score",
+        tag="fused_attention_score",
+    )
+
+    online_softmax = _online_softmax_reducer()
+    j = te.reduce_axis((0, seq_kv), name="j")
+    _, score_sum, weighted_sum = te.compute(
+        (batch, seq_q, value_dim),
+        lambda b, i, d: online_softmax(
+            (score[b, i, j], tvm.tir.const(1, acc_dtype), value[b, j, d].astype(acc_dtype)),
+            axis=j,
+        ),
+        name="attention_state",
+        tag="fused_attention_state",
+    )
+
+    return te.compute(
+        (batch, seq_q, value_dim),
+        lambda b, i, d: (weighted_sum[b, i, d] / score_sum[b, i, d]).astype(out_dtype),
+        name="attention",
+        tag="fused_attention",
+    )
+
+
+def paged_attention(query, pages, block_table, seq_lens, layer, scale=1.0, out_dtype=None):
+    """Decoding attention of one query token per sequence over keys and values kept in the pages
+    of a paged KV cache, see tvm.runtime.vm.PagedKVCache.
+
+    Token t of sequence b is slot t % page_size of page block_table[b, t // page_size]. The
+    tokens past the length of a sequence, up to the padded length of the block table, are masked
+    out of the online softmax.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        3-D with shape [batch, num_heads, head_dim].
+
+    pages : tvm.te.Tensor
+        6-D with shape [num_layers, 2, num_pages, page_size, num_heads, head_dim], the keys
+        followed by the values.
+
+    block_table : tvm.te.Tensor
+        2-D int32 with shape [batch, max_pages], the pages of each sequence.
+
+    seq_lens : tvm.te.Tensor
+        1-D int32 with shape [batch], the number of tokens of each sequence.
+
+    layer : int
+        The attention layer read from the pages.
+
+    scale : float
+        The scale applied to the scores before the softmax.
+
+    out_dtype : Optional[str]
+        The output data type. The scores and the softmax are accumulated in float32 for float16
+        inputs. Defaults to the data type of the query.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, num_heads, head_dim].
+    """
+    assert len(query.shape) == 3 and len(pages.shape) == 6
+    assert len(block_table.shape) == 2 and len(seq_lens.shape) == 1
+    if out_dtype is None:
+        out_dtype = query.dtype
+    acc_dtype = "float32" if query.dtype == "float16" else query.dtype
+    batch, num_heads, head_dim = query.shape
+    page_size = pages.shape[3]
+    max_len = block_table.shape[1] * page_size
+
+    def _kv(kv, b, t, h, d):
+        return pages[layer, kv, block_table[b, t // page_size], t % page_size, h, d]
+
+    k = te.reduce_axis((0, head_dim), name="k")
+    score = te.compute(
+        (batch, num_heads, max_len),
+        lambda b, h, t: te.sum(
+            query[b, h, k].astype(acc_dtype)
+            * _kv(0, b, t, h, k).astype(acc_dtype)
+            * tvm.tir.const(scale, acc_dtype),
+            axis=k,
+        ),
+        name="paged_attention_score",
+        tag="paged_attention_score",
+    )
+
+    online_softmax = _online_softmax_reducer()
+    t = te.reduce_axis((0, max_len), name="t")
+
+    def _state(b, h, d):
+        valid = t < seq_lens[b]
+        zero = tvm.tir.const(0, acc_dtype)
+        return online_softmax(
+            (
+                tvm.tir.Select(valid, score[b, h, t], tvm.te.min_value(acc_dtype)),
+                tvm.tir.Select(valid, tvm.tir.const(1, acc_dtype), zero),
+                tvm.tir.if_then_else(valid, _kv(1, b, t, h, d).astype(acc_dtype), zero),
+            ),
+            axis=t,
+        )
+
+    _, score_sum, weighted_sum = te.compute(
+        (batch, num_heads, head_dim),
+        _state,
+        name="paged_attention_state",
+        tag="paged_attention_state",
+    )
+
+    return te.compute(
+        (batch, num_heads, head_dim),
+        lambda b, h, d: (weighted_sum[b, h, d] / score_sum[b, h, d]).astype(out_dtype),
+        name="paged_attention",
+        tag="paged_attention",
+    )
@@ -287,6 +287,86 @@ def dense_pack(data, weight, bias=None, out_dtype=None):
     return C
 
 
+def dense_weight_quantized(
+    data, weight, scale, zero_point=None, bits=8, group_size=None, out_dtype=None
+):
+    """The default implementation of dense with weight-only quantization in topi.
+
+    The weight is dequantized inside the reduction, so that it is read from memory in its
+    quantized form: ``(weight - zero_point) * scale``, with one scale and zero point per output
+    channel, or per group of ``group_size`` input channels of each output channel.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        2-D with shape [batch, in_dim]
+
+    weight : tvm.te.Tensor
+        2-D with shape [out_dim, in_dim] of int8 if bits is 8, or [out_dim, in_dim // 2] of uint8
+        if bits is 4, with two unsigned 4-bit values packed in each byte, the lower bits first.
+
+    scale : tvm.te.Tensor
+        1-D with shape [out_dim], or 2-D with shape [out_dim, in_dim // group_size]
+
+    zero_point : Optional[tvm.te.Tensor]
+        The zero point with the same shape as scale. If not given, it is 0 for 8-bit weights
+        and 8 for 4-bit weights.
+
+    bits : int
+        The number of bits of each weight value, 8 or 4.
+
+    group_size : Optional[int]
+        The number of input channels that share a scale, required if scale is 2-D.
+
+    out_dtype : Optional[str]
+        The output type.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D with shape [batch, out_dim]
+    """
+    assert len(data.shape) == 2 and len(weight.shape) == 2, "only support 2-dim dense"
+    assert bits in (4, 8), "only support 8-bit and 4-bit weights"
+    if out_dtype is None:
+        out_dtype = data.dtype
+    batch, in_dim = data.shape
+    out_dim = weight.shape[0]
+    if bits == 4:
+        assert int(weight.shape[1]) * 2 == int(in_dim), "4-bit weights are packed in pairs"
+    else:
+        assert int(weight.shape[1]) == int(in_dim), "Inner dimensions of dense do not match."
+    grouped = len(scale.shape) == 2
+    if grouped:
+        assert group_size is not None, "group_size is required for grouped scales"
+        assert int(scale.shape[1]) * group_size == int(in_dim)
+    if zero_point is not None:
+        assert len(zero_point.shape) == len(scale.shape)
+
+    def per_group(tensor, j, k):
+        return tensor[j, k // group_size] if grouped else tensor[j]
+
+    def dequantize(j, k):
+        if bits == 8:
+            value = weight[j, k].astype(out_dtype)
+        else:
+            packed = weight[j, k // 2].astype("int32")
+            value = ((packed >> ((k % 2) * 4)) & 0xF).astype(out_dtype)
+        if zero_point is not None:
+            value = value - per_group(zero_point, j, k).astype(out_dtype)
+        elif bits == 4:
+            value = value - tvm.tir.const(8, out_dtype)
+        return value * per_group(scale, j, k).astype(out_dtype)
+
+    k = te.reduce_axis((0, in_dim), name="k")
+    return te.compute(
+        (batch, out_dim),
+        lambda i, j: te.sum(data[i, k].astype(out_dtype) * dequantize(j, k), axis=k),
+        name="T_dense_weight_quantized",
+        tag="dense_weight_quantized",
+    )
+
+
 @tvm.target.generic_func
 def dense_alter_layout(attrs, inputs, tinfos, out_type):
     """Change dense layout.
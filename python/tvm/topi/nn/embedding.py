@@ -0,0 +1,69 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Embedding table lookup operator"""
+import tvm
+from tvm import te
+
+_EMBEDDING_MODES = {"none": 0, "sum": 1, "mean": 2}
+
+
+def embedding_lookup(table, indices, mode="none"):
+    """Look up rows of a large embedding table on CPU.
+
+    Calls the contrib embedding kernel, which gathers the rows in sorted order and
+    prefetches them ahead of the copy, so lookups into memory mapped tables touch
+    each page in address order.
+
+    Parameters
+    ----------
+    table : tvm.te.Tensor
+        2-D with shape [num_rows, dim]
+
+    indices : tvm.te.Tensor
+        N-D integer tensor, clipped to [0, num_rows)
+
+    mode : str
+        Reduction of the rows over the last axis of indices, one of "none", "sum", "mean".
+
+    Returns
+    -------
+    out : tvm.te.Tensor
+        indices.shape + [dim] for mode "none", indices.shape[:-1] + [dim] otherwise.
+    """
+    if mode not in _EMBEDDING_MODES:
+        raise ValueError("Unsupported embedding lookup mode: %s" % mode)
+    out_shape = list(indices.shape)
+    if mode != "none":
+        out_shape = out_shape[:-1]
+    out_shape.append(table.shape[1])
+    table_buf = tvm.tir.decl_buffer(table.shape, table.dtype, "table_buf", data_alignment=8)
+    indices_buf = tvm.tir.decl_buffer(
+        indices.shape, indices.dtype, "indices_buf", data_alignment=4
+    )
+    out_buf = tvm.tir.decl_buffer(out_shape, table.dtype, "out_buf", data_alignment=8)
+    return te.extern(
+        out_shape,
+        [table, indices],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.embedding.lookup", ins[0], ins[1], outs[0], _EMBEDDING_MODES[mode]
+        ),
+        dtype=table.dtype,
+        in_buffers=[table_buf, indices_buf],
+        out_buffers=out_buf,
+        name="embedding_lookup_cpu",
+        tag="embedding_lookup_cpu",
+    )
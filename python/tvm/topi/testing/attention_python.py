@@ -0,0 +1,49 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Scaled dot-product attention in python"""
+import numpy as np
+
+from .softmax_python import softmax_python
+
+
+def attention_python(query, key, value, scale=1.0):
+    """Scaled dot-product attention, with the score matrix materialized.
+
+    Parameters
+    ----------
+    query : numpy.ndarray
+        3-D with shape [batch, seq_q, head_dim]
+
+    key : numpy.ndarray
+        3-D with shape [batch, seq_kv, head_dim]
+
+    value : numpy.ndarray
+        3-D with shape [batch, seq_kv, value_dim]
+
+    scale : float
+        The scale applied to the scores before the softmax
+
+    Returns
+    -------
+    output : numpy.ndarray
+        3-D with shape [batch, seq_q, value_dim]
+    """
+    acc_dtype = "float32" if query.dtype == "float16" else query.dtype
+    score = np.matmul(query.astype(acc_dtype), key.astype(acc_dtype).transpose(0, 2, 1)) * scale
+    prob = softmax_python(score, axis=2)
+    return np.matmul(prob, value.astype(acc_dtype)).astype(query.dtype)
@@ -34,6 +34,7 @@ from .bitserial_dense import *
 from .depthwise_conv2d import *
 from .dense import *
 from .batch_matmul import *
+from .attention import *
 from .roi_align import roi_align_nchw
 from .conv2d_transpose import *
 from .conv3d_transpose import *
@@ -0,0 +1,86 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,unused-argument
+"""x86 fused_attention operators"""
+from tvm import autotvm, te
+from tvm.autotvm.task.space import SplitEntity
+
+from .. import nn
+from ..utils import get_const_tuple, get_max_power2_factor, traverse_inline
+
+
+@autotvm.register_topi_compute("fused_attention.x86")
+def fused_attention(cfg, query, key, value, scale=1.0, out_dtype=None):
+    """Compute fused scaled dot-product attention on x86, see topi.nn.fused_attention."""
+    return nn.fused_attention(query, key, value, scale, out_dtype)
+
+
+@autotvm.register_topi_schedule("fused_attention.x86")
+def schedule_fused_attention(cfg, outs):
+    """Schedule for fused_attention
+
+    The rows of the output are computed in parallel. Each row computes its scores a tile of keys
+    at a time into a buffer small enough to stay in cache, and reduces them into the online
+    softmax state, vectorized along the value dimension.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        AutoTVM tuning space config file.
+    outs : Array of Tensor
+        The computation graph description of fused_attention
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    s: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _schedule(cfg, op):
+        output = op.output(0)
+        state = op.input_tensors[0].op
+        (score,) = [t for t in state.input_tensors if t.op.tag == "fused_attention_score"]
+        _, _, seq_kv = get_const_tuple(score.shape)
+
+        b, i, d = s[output].op.axis
+        (j,) = s[state].op.reduce_axis
+        cfg.define_split("tile_j", j, num_outputs=2)
+        if cfg.is_fallback:
+            tile_j = get_max_power2_factor(seq_kv, 64)
+            cfg["tile_j"] = SplitEntity([seq_kv // tile_j, tile_j])
+
+        bi = s[output].fuse(b, i)
+        s[output].parallel(bi)
+        s[output].vectorize(d)
+
+        s[state].compute_at(s[output], bi)
+        _, _, d = s[state].op.axis
+        jo, ji = cfg["tile_j"].apply(s, state, j)
+        s[state].reorder(jo, ji, d)
+        s[state].vectorize(d)
+
+        s[score].compute_at(s[state], jo)
+
+    def _callback(op):
+        if op.tag == "fused_attention":
+            _schedule(cfg, op)
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
@@ -18,9 +18,61 @@
 """x86 declaration and schedules."""
 import tvm
 from tvm import te
+from tvm.target.x86 import get_simd_32bit_lanes
 from .injective import schedule_injective_from_existing
 from .. import tag
-from ..utils import get_const_tuple
+from ..utils import get_const_int, get_const_tuple, prod
+
+
+def _get_num_cores():
+    target = tvm.target.Target.current(allow_none=True)
+    if target is not None and "num-cores" in target.attrs:
+        return int(target.attrs["num-cores"])
+    return tvm.runtime.num_threads()
+
+
+def _schedule_two_stage_reduce(sch, out):
+    """Schedule a reduction with a small output and a long reduction as a parallel reduction into
+    vector accumulators per core, followed by a serial combine of the partial results.
+
+    Returns
+    -------
+    scheduled: bool
+        Whether the reduction is scheduled in two stages.
+    """
+    num_cores = _get_num_cores()
+    reduce_axes = sch[out].op.reduce_axis
+    if num_cores <= 1 or not reduce_axes or len(out.op.body) != 1:
+        return False
+    out_extent = prod(get_const_tuple(out.shape))
+    reduce_extent = [ivar.dom.extent for ivar in reduce_axes]
+    if not all(isinstance(extent, tvm.tir.IntImm) for extent in reduce_extent):
+        return False
+    reduce_extent = prod([get_const_int(extent) for extent in reduce_extent])
+    lanes = 1
+    if tvm.target.Target.current(allow_none=True) is not None:
+        bits = tvm.DataType(out.dtype).bits
+        lanes = max(1, get_simd_32bit_lanes() * 32 // max(bits, 8))
+    if reduce_extent % lanes != 0:
+        lanes = 1
+    # Only worth it when the output cannot occupy the cores and each core reduces many vectors
+    if out_extent >= num_cores or reduce_extent < num_cores * lanes * 16:
+        return False
+
+    k = sch[out].fuse(*reduce_axes)
+    ko, kv = sch[out].split(k, factor=lanes)
+    kp, kr = sch[out].split(ko, nparts=num_cores)
+    sch[out].reorder(kp, kv, kr)
+    # Stage 1: each core reduces a chunk of the reduction into `lanes` partial results
+    out_rf = sch.rfactor(out, sch[out].fuse(kp, kv))
+    kpv = sch[out_rf].op.axis[0]
+    kpv_o, kpv_i = sch[out_rf].split(kpv, factor=lanes)
+    sch[out_rf].reorder(kpv_o, *sch[out_rf].op.axis[1:], *sch[out_rf].op.reduce_axis, kpv_i)
+    sch[out_rf].parallel(kpv_o)
+    if lanes > 1:
+        sch[out_rf].vectorize(kpv_i)
+    # Stage 2: the partial results are combined serially, as there are only a few of them
+    return True
 
 
 def _schedule_reduce(sch, op, is_idx_reduce=False):
@@ -38,6 +90,8 @@ def _schedule_reduce(sch, op, is_idx_reduce=False):
             const_shape = False
             break
 
+    if const_shape and not is_idx_reduce and _schedule_two_stage_reduce(sch, out):
+        return
     if const_shape:
         naxes = len(sch[out].op.axis)
         parallelism = 1
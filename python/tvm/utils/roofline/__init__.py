@@ -25,7 +25,7 @@ from ...ir.expr import GlobalVar
 from ...ir.instrument import pass_instrument
 from ...rpc.base import RPC_SESS_MASK
 from ...rpc.client import RPCSession
-from ...runtime import Device, num_threads, profiler_vm, profiling
+from ...runtime import DataType, Device, num_threads, profiler_vm, profiling
 from ...script import tir as T
 from ...target import Target
 from . import cuda, registry, x86
@@ -188,6 +188,103 @@ def roofline_from_existing(
     return profiling.Report(new_calls, report.device_metrics, new_configuration)
 
 
+def _param_bytes(prim: tir.PrimFunc) -> int:
+    """Number of bytes in the statically shaped buffer parameters of `prim`. Each byte is
+    assumed to move between the kernel and main memory exactly once."""
+    total = 0
+    for param in prim.params:
+        buf = prim.buffer_map.get(param, None)
+        if buf is None or not all(isinstance(dim, tir.IntImm) for dim in buf.shape):
+            continue
+        dtype = DataType(buf.dtype)
+        total += int(np.prod([dim.value for dim in buf.shape])) * dtype.bits * dtype.lanes // 8
+    return total
+
+
+def roofline_from_target(
+    report: profiling.Report,
+    tir_functions: Dict[GlobalVar, tir.PrimFunc],
+    target: Union[str, Target],
+    threshold: float = 10.0,
+) -> profiling.Report:
+    """Add roofline statistics to an existing profiling report, using the peaks recorded in the
+    `peak_gflops` and `peak_gbps` attributes of `target` instead of measuring them.
+
+    Unlike :py:func:`roofline_from_existing` this does not need the device, so it can be run
+    offline on a report collected elsewhere. FLOPs are counted with
+    :py:func:`tvm.tir.analysis.estimate_tir_flops` and the memory traffic is the size of the
+    buffer parameters of each kernel. The attainable runtime of a kernel is
+    ``max(flops / peak_flops, bytes / peak_bandwidth)``; kernels running at less than
+    `threshold` percent of it are flagged, and the difference to the measured runtime is
+    reported as the headroom, so tuning effort can go to the kernels with the most to gain.
+
+    Parameters
+    ----------
+    report : Report
+        Existing profiling report, e.g. from :py:method:`VirtualMachineProfiler.profile`.
+    tir_functions : Dict[GlobalVar, PrimFunc]
+        TIR primfuncs from the module run to generate `report`, as collected by
+        :py:class:`SaveLoweredTIR`.
+    target : Union[str, Target]
+        Target with the `peak_gflops` and `peak_gbps` attributes set, e.g.
+        ``cuda -peak_gflops=19500 -peak_gbps=1555``.
+    threshold : float
+        Percent of the roofline below which a kernel is flagged.
+
+    Returns
+    -------
+    profiling.Report
+        New profiling report that includes all information from `report` along with the
+        columns "Estimated FLOPs", "Estimated Bytes", "Arithmetic Intensity", "GFLOP/s", "GB/s",
+        "Percent of Roofline", "Headroom (us)" and "Below Roofline".
+    """
+    if isinstance(target, str):
+        target = Target(target)
+    if "peak_gflops" not in target.attrs or "peak_gbps" not in target.attrs:
+        raise ValueError(
+            f"Target {target} must set peak_gflops and peak_gbps, or use roofline_from_existing "
+            "to measure the peaks on the device"
+        )
+    peak_flops = float(target.attrs["peak_gflops"]) * 1e9
+    peak_bandwidth = float(target.attrs["peak_gbps"]) * 1e9
+    if peak_flops <= 0 or peak_bandwidth <= 0:
+        raise ValueError(f"Target {target} must have positive peak_gflops and peak_gbps")
+
+    estimates = {}
+    for prim in tir_functions.values():
+        if isinstance(prim, tir.PrimFunc) and "hash" in prim.attrs.keys():
+            flops = tir.analysis.estimate_tir_flops(IRModule({"main": prim}))
+            estimates[prim.attrs["hash"]] = (flops, _param_bytes(prim))
+
+    new_configuration = dict(report.configuration.items())
+    new_configuration["Peak FLOP/s (target)"] = profiling.Ratio(peak_flops)
+    new_configuration["Peak Bandwidth (target, byte/second)"] = profiling.Ratio(peak_bandwidth)
+    new_calls = []
+    for call in report.calls:
+        if "Hash" not in call.keys() or call["Hash"] not in estimates:
+            new_calls.append(call)
+            continue
+        flops, num_bytes = estimates[call["Hash"]]
+        runtime = call["Duration (us)"].microseconds * 1e-6
+        if runtime <= 0 or num_bytes == 0:
+            new_calls.append(call)
+            continue
+        attainable = max(flops / peak_flops, num_bytes / peak_bandwidth)
+        percent = attainable / runtime * 100.0
+        call = dict(call)
+        call["Estimated FLOPs"] = profiling.Count(int(flops))
+        call["Estimated Bytes"] = profiling.Count(num_bytes)
+        call["Arithmetic Intensity"] = profiling.Ratio(flops / num_bytes)
+        call["GFLOP/s"] = profiling.Ratio(flops / runtime * 1e-9)
+        call["GB/s"] = profiling.Ratio(num_bytes / runtime * 1e-9)
+        # Ratio because the percentages should be averaged instead of summed.
+        call["Percent of Roofline"] = profiling.Ratio(percent)
+        call["Headroom (us)"] = profiling.Duration(max(runtime - attainable, 0.0) * 1e6)
+        call["Below Roofline"] = "yes" if percent < threshold else "no"
+        new_calls.append(call)
+    return profiling.Report(new_calls, report.device_metrics, new_configuration)
+
+
 def roofline_analysis(
     mod: IRModule,
     params: Dict[str, nd.NDArray],
@@ -58,6 +58,8 @@ void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
     this->const_int_bound.Bind(var, range, allow_override);
     this->int_set.Bind(var, range, allow_override);
     this->transitive_comparisons.Bind(var, range, allow_override);
+    // The rewrite simplifier queries the bounds of the variable.
+    this->rewrite_simplify.InvalidateMemo();
   }
   // skip modular_set
   // skip rewrite simplify
@@ -180,6 +182,9 @@ bool Analyzer::CanProve(const PrimExpr& expr, ProofStrength strength) {
 }
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
+  if (auto memoized = this->rewrite_simplify.FindMemoizedSimplify(expr, steps)) {
+    return memoized.value();
+  }
   PrimExpr res = expr;
 
   // Always starts with a canonical simplification, as some structural property
@@ -188,7 +193,7 @@ PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
 
   for (int i = 0; i < steps; ++i) {
     if (tir::is_const_int(res)) {
-      return res;
+      break;
     }
     if (i % 2 == 0) {
       res = this->rewrite_simplify(res);
@@ -197,6 +202,7 @@ PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
     }
   }
 
+  this->rewrite_simplify.MemoizeSimplify(expr, steps, res);
   return res;
 }
 
@@ -235,6 +241,10 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "reset_rewrite_simplify_stats") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { self->rewrite_simplify.ResetStatsCounters(); });
+    } else if (name == "set_memoization_enabled") {
+      return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
+        self->rewrite_simplify.SetMemoizationEnabled(args[0]);
+      });
     } else if (name == "canonical_simplify") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->canonical_simplify(args[0]); });
@@ -23,8 +23,12 @@
 #include "ir_mutator_with_analyzer.h"
 
 #include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/op.h>
 
+#include <memory>
+#include <vector>
+
 namespace tvm {
 namespace arith {
 
@@ -133,6 +137,50 @@ Stmt IRMutatorWithAnalyzer::VisitStmt_(const AssertStmtNode* op) {
   }
 }
 
+Stmt IRMutatorWithAnalyzer::VisitStmt_(const SeqStmtNode* op) {
+  // T.evaluate(T.assume(cond)) holds for the statements that follow it
+  auto get_assumption = [](const Stmt& stmt) -> Optional<PrimExpr> {
+    if (const auto* eval = stmt.as<EvaluateNode>()) {
+      if (const auto* call = eval->value.as<CallNode>()) {
+        if (call->op.same_as(builtin::assume()) && call->args.size() == 1) {
+          return call->args[0];
+        }
+      }
+    }
+    return NullOpt;
+  };
+  bool has_assumption = false;
+  for (size_t i = 0; i + 1 < op->seq.size(); ++i) {
+    if (get_assumption(op->seq[i]).defined()) {
+      has_assumption = true;
+      break;
+    }
+  }
+  if (!has_assumption) {
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Array<Stmt> seq;
+  bool changed = false;
+  std::vector<std::unique_ptr<With<ConstraintContext>>> constraints;
+  for (const Stmt& stmt : op->seq) {
+    Stmt new_stmt = this->VisitStmt(stmt);
+    changed = changed || !new_stmt.same_as(stmt);
+    seq.push_back(new_stmt);
+    if (Optional<PrimExpr> assumption = get_assumption(new_stmt)) {
+      constraints.emplace_back(new With<ConstraintContext>(analyzer_, assumption.value()));
+    }
+  }
+  // The constraints must be exited in the reverse order of entering
+  while (!constraints.empty()) {
+    constraints.pop_back();
+  }
+  if (!changed) {
+    return GetRef<Stmt>(op);
+  }
+  return SeqStmt::Flatten(seq);
+}
+
 PrimExpr IRMutatorWithAnalyzer::VisitExpr_(const CallNode* op) {
   // add condition context to if_then_else
   static auto op_if_then_else = Op::Get("tir.if_then_else");
@@ -1331,9 +1331,11 @@ bool IterRangeSanityCheck(const Map<Var, Range>& iter_ranges) {
   return true;
 }
 
-IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-                            const PrimExpr& predicate, IterMapLevel check_level,
-                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+static IterMapResult DetectIterMapImpl(const Array<PrimExpr>& indices,
+                                       const Map<Var, Range>& input_iters,
+                                       const PrimExpr& predicate, IterMapLevel check_level,
+                                       arith::Analyzer* analyzer,
+                                       bool simplify_trivial_iterators) {
   IterMapResult result;
 
   // Overall detection algorithm is divided into two steps:
@@ -1416,6 +1418,37 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
   return result;
 }
 
+IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                            const PrimExpr& predicate, IterMapLevel check_level,
+                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+  // The same index expressions are often detected again in the same analyzer context, e.g. by
+  // the checks of consecutive schedule primitives, so that the result is memoized along with
+  // the simplifications of the analyzer, when enabled.
+  Array<ObjectRef> key{String("arith.DetectIterMap"),
+                       indices,
+                       input_iters,
+                       predicate,
+                       Integer(static_cast<int>(check_level)),
+                       Bool(simplify_trivial_iterators)};
+  IterMapResult result;
+  if (Optional<ObjectRef> memoized = analyzer->rewrite_simplify.FindMemoizedAnalysis(key)) {
+    // Copy the result, which callers may modify
+    IterMapResult cached = Downcast<IterMapResult>(memoized.value());
+    result->indices = cached->indices;
+    result->errors = cached->errors;
+    result->padding_predicate = cached->padding_predicate;
+    return result;
+  }
+  result = DetectIterMapImpl(indices, input_iters, predicate, check_level, analyzer,
+                             simplify_trivial_iterators);
+  IterMapResult stored;
+  stored->indices = result->indices;
+  stored->errors = result->errors;
+  stored->padding_predicate = result->padding_predicate;
+  analyzer->rewrite_simplify.MemoizeAnalysis(key, stored);
+  return result;
+}
+
 TVM_REGISTER_GLOBAL("arith.DetectIterMap")
     .set_body_typed([](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
                        const PrimExpr& input_pred, int check_level,
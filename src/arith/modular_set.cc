@@ -30,7 +30,9 @@
 #include <limits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "constraint_extract.h"
 #include "pattern_match.h"
 
 namespace tvm {
@@ -117,17 +119,24 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
   std::function<void()> EnterConstraint(const PrimExpr& constraint) {
     PVar<Var> var;
     PVar<IntImm> coeff, base;
-    // pattern match interesting constraints
-    if ((truncmod(var, coeff) == base).Match(constraint) ||
-        (floormod(var, coeff) == base).Match(constraint)) {
-      Entry entry(coeff.Eval()->value, base.Eval()->value);
-      return UpdateByIntersect(var.Eval(), entry);
-    }
-    if ((var == base).Match(constraint) || (base == var).Match(constraint)) {
-      Entry entry(1, base.Eval()->value);
-      return UpdateByIntersect(var.Eval(), entry);
+    // pattern match interesting constraints, in each part of a conjunction
+    std::vector<std::function<void()>> recovers;
+    for (const PrimExpr& subexpr : ExtractConstraints(constraint, false)) {
+      if ((truncmod(var, coeff) == base).Match(subexpr) ||
+          (floormod(var, coeff) == base).Match(subexpr)) {
+        Entry entry(coeff.Eval()->value, base.Eval()->value);
+        recovers.push_back(UpdateByIntersect(var.Eval(), entry));
+      } else if ((var == base).Match(subexpr) || (base == var).Match(subexpr)) {
+        Entry entry(1, base.Eval()->value);
+        recovers.push_back(UpdateByIntersect(var.Eval(), entry));
+      }
     }
-    return nullptr;
+    if (recovers.empty()) return nullptr;
+    return [recovers]() {
+      for (auto it = recovers.rbegin(); it != recovers.rend(); ++it) {
+        (*it)();
+      }
+    };
   }
 
   // Override visitor behaviors
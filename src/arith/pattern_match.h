@@ -83,6 +83,13 @@ namespace arith {
  * - Match: checks if value matches the pattern.
  * - Eval: construct a new value based on matched values in PVar.
  *
+ * Each pattern also implements MayMatch_, a necessary condition for
+ * Match_ that only compares the node types of the value against the
+ * node types in the pattern, without filling PVars or checking the
+ * equality of repeated PVars.  Match runs it first, so that the rules
+ * which fail on the shape of the expression are rejected without the
+ * cost of binding and deep-comparing the operands.
+ *
  * We use curiously recurring template pattern to construct
  * expression templates.
  *
@@ -136,6 +143,7 @@ class Pattern {
    */
   template <typename NodeType, typename Condition>
   bool Match(const NodeType& value, Condition cond) const {
+    if (!derived().MayMatch_(value)) return false;
     derived().InitMatch_();
     return derived().Match_(value) && cond();
   }
@@ -220,6 +228,17 @@ class PVar : public Pattern<PVar<T>> {
     }
   }
 
+  template <typename V>
+  bool MayMatch_(const V& value) const {
+    if constexpr (std::is_base_of<ObjectRef, V>::value && std::is_base_of<V, T>::value &&
+                  !std::is_same<V, T>::value) {
+      // Only the values which can be downcast to T are accepted
+      return value.template as<typename T::ContainerType>() != nullptr;
+    } else {
+      return true;
+    }
+  }
+
   T Eval() const {
     ICHECK(filled_);
     return value_;
@@ -263,6 +282,11 @@ class PVarWithCheck : public arith::Pattern<PVarWithCheck<Derived, T>> {
     }
   }
 
+  template <typename V>
+  bool MayMatch_(const V& value) const {
+    return pvar_.MayMatch_(value);
+  }
+
   T Eval() const { return pvar_.Eval(); }
 
  protected:
@@ -316,6 +340,11 @@ class PConst : public Pattern<PConst<T>> {
 
   bool Match_(const T& value) const { return PEqualChecker<T>()(value_, value); }
 
+  template <typename V>
+  bool MayMatch_(const V& value) const {
+    return true;
+  }
+
   T Eval() const { return value_; }
 
  private:
@@ -349,6 +378,12 @@ class PBinaryExpr : public Pattern<PBinaryExpr<OpType, TA, TB>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    using NodeType = typename OpType::ContainerType;
+    const NodeType* ptr = node.as<NodeType>();
+    return ptr != nullptr && a_.MayMatch_(ptr->a) && b_.MayMatch_(ptr->b);
+  }
+
   PrimExpr Eval() const {
     PrimExpr lhs = a_.Eval();
     PrimExpr rhs = b_.Eval();
@@ -376,6 +411,8 @@ class PConstWithTypeLike : public Pattern<PConstWithTypeLike<TA>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const { return Match_(node); }
+
   PrimExpr Eval() const { return tir::make_const(ref_.Eval().dtype(), value_); }
 
  private:
@@ -450,6 +487,11 @@ class PNotExpr : public Pattern<PNotExpr<TA>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    const tir::NotNode* ptr = node.as<tir::NotNode>();
+    return ptr != nullptr && value_.MayMatch_(ptr->a);
+  }
+
   PrimExpr Eval() const { return tir::Not(value_.Eval()); }
 
  private:
@@ -491,6 +533,12 @@ class PSelectExpr : public Pattern<PSelectExpr<TCond, TA, TB>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    const tir::SelectNode* ptr = node.as<tir::SelectNode>();
+    return ptr != nullptr && condition_.MayMatch_(ptr->condition) &&
+           true_value_.MayMatch_(ptr->true_value) && false_value_.MayMatch_(ptr->false_value);
+  }
+
   PrimExpr Eval() const {
     return tir::Select(condition_.Eval(), true_value_.Eval(), false_value_.Eval());
   }
@@ -547,6 +595,11 @@ class PCastExpr : public Pattern<PCastExpr<DType, TA>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    const tir::CastNode* ptr = node.as<tir::CastNode>();
+    return ptr != nullptr && dtype_.MayMatch_(ptr->dtype) && value_.MayMatch_(ptr->value);
+  }
+
   PrimExpr Eval() const { return tir::Cast(dtype_.Eval(), value_.Eval()); }
 
  private:
@@ -599,6 +652,12 @@ class PRampExpr : public Pattern<PRampExpr<TBase, TStride, TLanes>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    const tir::RampNode* ptr = node.as<tir::RampNode>();
+    return ptr != nullptr && base_.MayMatch_(ptr->base) && stride_.MayMatch_(ptr->stride) &&
+           lanes_.MayMatch_(ptr->lanes);
+  }
+
   PrimExpr Eval() const { return tir::Ramp(base_.Eval(), stride_.Eval(), lanes_.Eval()); }
 
  private:
@@ -659,6 +718,11 @@ class PBroadcastExpr : public Pattern<PBroadcastExpr<TA, TLanes>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    const tir::BroadcastNode* ptr = node.as<tir::BroadcastNode>();
+    return ptr != nullptr && value_.MayMatch_(ptr->value) && lanes_.MayMatch_(ptr->lanes);
+  }
+
   PrimExpr Eval() const { return tir::Broadcast(value_.Eval(), lanes_.Eval()); }
 
  private:
@@ -725,6 +789,18 @@ struct PCallExprMatchFunctor {
   }
 };
 
+struct PCallExprMayMatchFunctor {
+  const tir::CallNode* call_;
+  bool matched_{true};
+
+  explicit PCallExprMayMatchFunctor(const tir::CallNode* call) : call_(call) {}
+
+  template <typename T>
+  void operator()(size_t i, const T& pattern) {
+    matched_ = matched_ && pattern.MayMatch_(call_->args[i]);
+  }
+};
+
 struct PCallExprEvalArgsFunctor {
   Array<PrimExpr> args_;
 
@@ -764,6 +840,18 @@ class PCallExpr : public Pattern<PCallExpr<Op, TArgs...>> {
     }
   }
 
+  bool MayMatch_(const ObjectRef& node) const {
+    if (const tir::CallNode* ptr = node.as<tir::CallNode>()) {
+      if (ptr->args.size() != sizeof...(TArgs)) return false;
+      if (!ptr->op.same_as(Op::GetOp())) return false;
+      detail::PCallExprMayMatchFunctor fmatch(ptr);
+      detail::tuple_for_each(fmatch, args_);
+      return fmatch.matched_;
+    } else {
+      return false;
+    }
+  }
+
   PrimExpr Eval() const {
     detail::PCallExprEvalArgsFunctor feval_args;
     detail::tuple_for_each(feval_args, args_);
@@ -234,6 +234,41 @@ void RewriteSimplifier::Impl::Update(const Var& var, const PrimExpr& info, bool
     }
   }
   var_map_[var] = info;
+  InvalidateMemo();
+}
+
+Optional<PrimExpr> RewriteSimplifier::Impl::FindMemoized(const PrimExpr& expr, int steps) {
+  if (!memoize_) return NullOpt;
+  auto it = memo_.find(expr);
+  if (it != memo_.end() && it->second.context == memo_context_ && it->second.steps == steps) {
+    stats_.cache_hits++;
+    return it->second.result;
+  }
+  stats_.cache_misses++;
+  return NullOpt;
+}
+
+void RewriteSimplifier::Impl::Memoize(const PrimExpr& expr, int steps, const PrimExpr& result) {
+  if (!memoize_) return;
+  if (memo_.size() >= kMaxMemoEntries) memo_.clear();
+  memo_[expr] = MemoEntry{memo_context_, steps, result};
+}
+
+Optional<ObjectRef> RewriteSimplifier::Impl::FindMemoizedAnalysis(const ObjectRef& key) {
+  if (!memoize_) return NullOpt;
+  auto it = analysis_memo_.find(key);
+  if (it != analysis_memo_.end() && it->second.context == memo_context_) {
+    stats_.cache_hits++;
+    return it->second.result;
+  }
+  stats_.cache_misses++;
+  return NullOpt;
+}
+
+void RewriteSimplifier::Impl::MemoizeAnalysis(const ObjectRef& key, const ObjectRef& result) {
+  if (!memoize_) return;
+  if (analysis_memo_.size() >= kMaxMemoEntries) analysis_memo_.clear();
+  analysis_memo_[key] = AnalysisMemoEntry{memo_context_, result};
 }
 
 PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
@@ -374,14 +409,21 @@ std::function<void()> RewriteSimplifier::Impl::EnterConstraint(const PrimExpr& c
   }
   stats_.constraints_entered++;
   size_t new_literal_size = literal_constraints_.size();
-  auto frecover = [old_literal_size, new_literal_size, this]() {
+  int64_t old_memo_context = memo_context_;
+  memo_context_ = ++memo_next_context_;
+  auto frecover = [old_literal_size, new_literal_size, old_memo_context, this]() {
     ICHECK_EQ(literal_constraints_.size(), new_literal_size);
     literal_constraints_.resize(old_literal_size);
+    memo_context_ =
+        old_memo_context < memo_valid_from_ ? ++memo_next_context_ : old_memo_context;
   };
   return frecover;
 }
 
-void RewriteSimplifier::Impl::SetEnabledExtensions(Extension flags) { enabled_extensions_ = flags; }
+void RewriteSimplifier::Impl::SetEnabledExtensions(Extension flags) {
+  enabled_extensions_ = flags;
+  InvalidateMemo();
+}
 
 RewriteSimplifier::Extension RewriteSimplifier::Impl::GetEnabledExtensions() const {
   return enabled_extensions_;
@@ -2138,14 +2180,18 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const LetNode* op) {
 }
 
 PrimExpr RewriteSimplifier::operator()(const PrimExpr& expr) {
+  if (auto memoized = impl_->FindMemoized(expr, Impl::kRewriteOnly)) {
+    return memoized.value();
+  }
   // Run simplification in post order
   PrimExpr res = expr;
   int max_iter = 2;
   for (int i = 0; i < max_iter; ++i) {
     PrimExpr new_expr = impl_->operator()(res);
-    if (new_expr.same_as(res)) return res;
+    if (new_expr.same_as(res)) break;
     res = new_expr;
   }
+  impl_->Memoize(expr, Impl::kRewriteOnly, res);
   return res;
 }
 
@@ -2172,6 +2218,28 @@ void RewriteSimplifier::SetMaximumRewriteSteps(int64_t maximum) {
   impl_->SetMaximumRewriteSteps(maximum);
 }
 
+void RewriteSimplifier::SetMemoizationEnabled(bool enabled) {
+  impl_->SetMemoizationEnabled(enabled);
+}
+
+Optional<PrimExpr> RewriteSimplifier::FindMemoizedSimplify(const PrimExpr& expr, int steps) {
+  return impl_->FindMemoized(expr, steps);
+}
+
+void RewriteSimplifier::MemoizeSimplify(const PrimExpr& expr, int steps, const PrimExpr& result) {
+  impl_->Memoize(expr, steps, result);
+}
+
+Optional<ObjectRef> RewriteSimplifier::FindMemoizedAnalysis(const ObjectRef& key) {
+  return impl_->FindMemoizedAnalysis(key);
+}
+
+void RewriteSimplifier::MemoizeAnalysis(const ObjectRef& key, const ObjectRef& result) {
+  impl_->MemoizeAnalysis(key, result);
+}
+
+void RewriteSimplifier::InvalidateMemo() { impl_->InvalidateMemo(); }
+
 RewriteSimplifier::RewriteSimplifier(Analyzer* parent) : impl_(new Impl(parent)) {}
 
 RewriteSimplifier::~RewriteSimplifier() { delete impl_; }
@@ -2186,7 +2254,9 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
                 << ", rewrites_attempted = " << ptr->rewrites_attempted
                 << ", rewrites_performed = " << ptr->rewrites_performed
                 << ", max_recursive_depth = " << ptr->max_recursive_depth
-                << ", num_recursive_rewrites = " << ptr->num_recursive_rewrites << ")";
+                << ", num_recursive_rewrites = " << ptr->num_recursive_rewrites
+                << ", cache_hits = " << ptr->cache_hits << ", cache_misses = " << ptr->cache_misses
+                << ")";
     });
 
 }  // namespace arith
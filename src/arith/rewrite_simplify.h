@@ -25,6 +25,8 @@
 #define TVM_ARITH_REWRITE_SIMPLIFY_H_
 
 #include <tvm/arith/analyzer.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/tir/op.h>
 
 #include <algorithm>
@@ -52,6 +54,8 @@ struct RewriteSimplifierStatsNode : Object {
   int64_t rewrites_performed{0};
   int64_t max_recursive_depth{0};
   int64_t num_recursive_rewrites{0};
+  int64_t cache_hits{0};
+  int64_t cache_misses{0};
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("nodes_visited", &nodes_visited);
@@ -60,6 +64,8 @@ struct RewriteSimplifierStatsNode : Object {
     v->Visit("rewrites_performed", &rewrites_performed);
     v->Visit("max_recursive_depth", &max_recursive_depth);
     v->Visit("num_recursive_rewrites", &num_recursive_rewrites);
+    v->Visit("cache_hits", &cache_hits);
+    v->Visit("cache_misses", &cache_misses);
   }
 
   static constexpr const char* _type_key = "arith.RewriteSimplifierStats";
@@ -131,10 +137,65 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   void SetMaximumRewriteSteps(int64_t maximum) { maximum_rewrite_steps_ = maximum; }
 
+  void SetMemoizationEnabled(bool enabled) {
+    memoize_ = enabled;
+    memo_.clear();
+    analysis_memo_.clear();
+  }
+
+  /*!
+   * \brief Find the memoized simplification of an expression in the current context.
+   * \param expr The expression that was simplified.
+   * \param steps The steps of Analyzer::Simplify, or kRewriteOnly.
+   */
+  Optional<PrimExpr> FindMemoized(const PrimExpr& expr, int steps);
+
+  /*! \brief Record the simplification of an expression in the current context. */
+  void Memoize(const PrimExpr& expr, int steps, const PrimExpr& result);
+
+  /*! \brief Find the result of an analysis memoized in the current context. */
+  Optional<ObjectRef> FindMemoizedAnalysis(const ObjectRef& key);
+
+  /*! \brief Record the result of an analysis in the current context. */
+  void MemoizeAnalysis(const ObjectRef& key, const ObjectRef& result);
+
+  /*! \brief Forget the memoized simplifications, after the known facts changed. */
+  void InvalidateMemo() { memo_context_ = memo_valid_from_ = ++memo_next_context_; }
+
+  /*! \brief The steps recorded for the results of RewriteSimplifier::operator(). */
+  static constexpr int kRewriteOnly = -1;
+
  protected:
   int64_t maximum_rewrite_steps_{0};
   RewriteSimplifierStatsNode stats_;
 
+  struct MemoEntry {
+    int64_t context;
+    int steps;
+    PrimExpr result;
+  };
+  /*! \brief The maximum number of memoized expressions, the table is cleared when full. */
+  static constexpr size_t kMaxMemoEntries = 1 << 16;
+  bool memoize_{false};
+  /*!
+   * \brief The context the memo entries are valid in.
+   *
+   * Every constraint entered gets a new context, and the previous one is restored on exit.
+   * Contexts older than memo_valid_from_ were entered before a variable binding changed.
+   */
+  int64_t memo_context_{0};
+  int64_t memo_next_context_{0};
+  int64_t memo_valid_from_{0};
+  /*! \brief The memo table, keeping the keys alive so that their address is not reused. */
+  std::unordered_map<PrimExpr, MemoEntry, ObjectPtrHash, ObjectPtrEqual> memo_;
+
+  struct AnalysisMemoEntry {
+    int64_t context;
+    ObjectRef result;
+  };
+  /*! \brief The memo table of other analyses, keyed by the structure of their arguments. */
+  std::unordered_map<ObjectRef, AnalysisMemoEntry, StructuralHash, StructuralEqual> analysis_memo_;
+
   void RecordAttemptedRewrite() { stats_.rewrites_attempted++; }
   void RecordRewrite() {
     stats_.rewrites_performed++;
@@ -25,6 +25,8 @@
 #include <tvm/tir/expr.h>
 
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "constraint_extract.h"
@@ -191,6 +193,14 @@ class TransitiveComparisonAnalyzer::Impl {
   /*! \brief Generate a Comparison representing the given expression */
   std::optional<Comparison> FromExpr(const PrimExpr& expr);
 
+  /*! \brief Index of the known comparisons by the expressions they use
+   *
+   * Maps each Key to the comparisons that have it as either the LHS
+   * or the RHS, in the order in which they were added.  Used to avoid
+   * scanning every known comparison at each step of a search.
+   */
+  using ComparisonIndex = std::unordered_map<Key, std::vector<Comparison>>;
+
   /*! \brief Utility function used by Bind and EnterConstraint
    *
    * \param expr The comparison expression, to be converted into
@@ -198,8 +208,25 @@ class TransitiveComparisonAnalyzer::Impl {
    *
    * \param vec The vector to which the Comparison objects should be
    * appended.
+   *
+   * \param index The index to which the Comparison objects should be
+   * added.
+   */
+  void AddKnown(const PrimExpr& expr, std::vector<Comparison>* vec, ComparisonIndex* index);
+
+  /*! \brief Add a comparison to an index, under both of its sides */
+  static void IndexComparison(const Comparison& cmp, ComparisonIndex* index);
+
+  /*! \brief Call a function on each known comparison that uses an expression
+   *
+   * \param key The expression of interest
+   *
+   * \param f The function to call, with each comparison from
+   * `knowns_` and then from `scoped_knowns_` that has `key` as its
+   * LHS or its RHS.
    */
-  void AddKnown(const PrimExpr& expr, std::vector<Comparison>* vec);
+  template <typename F>
+  void ForEachKnownUsing(Key key, F f) const;
 
   /*! Collect known comparisons between LHS and RHS, without propagation
    *
@@ -295,6 +322,17 @@ class TransitiveComparisonAnalyzer::Impl {
    * the condition may no longer be true.
    */
   std::vector<Comparison> scoped_knowns_;
+
+  /*! \brief The comparisons of `knowns_`, indexed by expression */
+  ComparisonIndex knowns_index_;
+
+  /*! \brief The comparisons of `scoped_knowns_`, indexed by expression
+   *
+   * Scoped comparisons are appended on entering a constraint and
+   * removed in the reverse order on exiting it, so they are always at
+   * the back of the vectors of the index.
+   */
+  ComparisonIndex scoped_knowns_index_;
 };
 
 namespace {
@@ -545,11 +583,32 @@ std::function<void()> TransitiveComparisonAnalyzer::EnterConstraint(const PrimEx
 }
 
 void TransitiveComparisonAnalyzer::Impl::AddKnown(const PrimExpr& expr,
-                                                  std::vector<Comparison>* vec) {
+                                                  std::vector<Comparison>* vec,
+                                                  ComparisonIndex* index) {
   for (const auto& subexpr : ExtractConstraints(expr, false)) {
     if (tir::SideEffect(expr) <= tir::CallEffectKind::kPure) {
       if (auto cmp = FromExpr(subexpr)) {
         vec->push_back(cmp.value());
+        IndexComparison(cmp.value(), index);
+      }
+    }
+  }
+}
+
+void TransitiveComparisonAnalyzer::Impl::IndexComparison(const Comparison& cmp,
+                                                         ComparisonIndex* index) {
+  (*index)[cmp.lhs_].push_back(cmp);
+  if (cmp.rhs_ != cmp.lhs_) {
+    (*index)[cmp.rhs_].push_back(cmp);
+  }
+}
+
+template <typename F>
+void TransitiveComparisonAnalyzer::Impl::ForEachKnownUsing(Key key, F f) const {
+  for (const ComparisonIndex* index : {&knowns_index_, &scoped_knowns_index_}) {
+    if (auto it = index->find(key); it != index->end()) {
+      for (const auto& known : it->second) {
+        f(known);
       }
     }
   }
@@ -569,6 +628,10 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tir::Var& var, const Range&
         knowns_.erase(std::remove_if(knowns_.begin(), knowns_.end(),
                                      [&](const auto& known) { return known.lhs_ == key.value(); }),
                       knowns_.end());
+        knowns_index_.clear();
+        for (const auto& known : knowns_) {
+          IndexComparison(known, &knowns_index_);
+        }
       }
     }
   }
@@ -576,10 +639,10 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tir::Var& var, const Range&
   prev_bindings_.Set(var, range);
 
   if (is_const_int(range->extent, 1)) {
-    AddKnown(var == range->min, &knowns_);
+    AddKnown(var == range->min, &knowns_, &knowns_index_);
   } else {
-    AddKnown(var >= range->min, &knowns_);
-    AddKnown(var < range->min + range->extent, &knowns_);
+    AddKnown(var >= range->min, &knowns_, &knowns_index_);
+    AddKnown(var < range->min + range->extent, &knowns_, &knowns_index_);
   }
 }
 
@@ -590,11 +653,25 @@ void TransitiveComparisonAnalyzer::Impl::Bind(const tir::Var& var, const PrimExp
 
 std::function<void()> TransitiveComparisonAnalyzer::Impl::EnterConstraint(const PrimExpr& expr) {
   size_t old_literal_size = scoped_knowns_.size();
-  AddKnown(expr, &scoped_knowns_);
+  AddKnown(expr, &scoped_knowns_, &scoped_knowns_index_);
   size_t new_literal_size = scoped_knowns_.size();
 
   auto frecover = [old_literal_size, new_literal_size, this]() {
     ICHECK_EQ(scoped_knowns_.size(), new_literal_size);
+    // Roll back the index in the reverse order of insertion, so that
+    // each removed comparison is at the back of its vectors.
+    for (size_t i = new_literal_size; i > old_literal_size; i--) {
+      const Comparison& known = scoped_knowns_[i - 1];
+      for (Key key : {known.lhs_, known.rhs_}) {
+        auto it = scoped_knowns_index_.find(key);
+        if (it == scoped_knowns_index_.end()) continue;
+        it->second.pop_back();
+        if (it->second.empty()) {
+          scoped_knowns_index_.erase(it);
+        }
+        if (known.lhs_ == known.rhs_) break;
+      }
+    }
     scoped_knowns_.erase(scoped_knowns_.begin() + old_literal_size, scoped_knowns_.end());
   };
   return frecover;
@@ -652,12 +729,7 @@ TransitiveComparisonAnalyzer::Impl::CollectDirectComparisons(Key lhs_key, Key rh
     }
   };
 
-  for (const auto& known : knowns_) {
-    append_known(known);
-  }
-  for (const auto& known : scoped_knowns_) {
-    append_known(known);
-  }
+  ForEachKnownUsing(lhs_key, append_known);
 
   return output;
 }
@@ -714,16 +786,11 @@ TransitiveComparisonAnalyzer::Impl::DFSFromLHS(Key lhs_key, Key rhs_key) const {
 
   // Initialize the search based on any known (in)equalities that use
   // the LHS of the comparison.
-  for (const auto& known : knowns_) {
+  ForEachKnownUsing(lhs_key, [&](const Comparison& known) {
     if (auto normalized = known.WithLHS(lhs_key)) {
       declare_known(normalized.value());
     }
-  }
-  for (const auto& known : scoped_knowns_) {
-    if (auto normalized = known.WithLHS(lhs_key)) {
-      declare_known(normalized.value());
-    }
-  }
+  });
 
   // Walk through the space of all comparisons that can be made with
   // LHS.
@@ -787,17 +854,11 @@ TransitiveComparisonAnalyzer::Impl::DFSFromLHS(Key lhs_key, Key rhs_key) const {
     // we must first combine `a<=b` and `b<=c` into `a<=c`.  During
     // this first step, `b` is the "middle" and `c` is the "right".
     // The next step can then combind `a<=c` and `c<=d` into `a<=d`.
-    for (const auto& known : knowns_) {
+    ForEachKnownUsing(middle_key, [&](const Comparison& known) {
       if (auto cmp = known.WithLHS(middle_key)) {
         attempt_transitive(cmp.value());
       }
-    }
-
-    for (const auto& known : scoped_knowns_) {
-      if (auto cmp = known.WithLHS(middle_key)) {
-        attempt_transitive(cmp.value());
-      }
-    }
+    });
 
     // Collect together all new knowns, marking new nodes for visiting
     // as needed.
@@ -23,6 +23,13 @@
  */
 
 #include <tvm/auto_scheduler/cost_model.h>
+#include <tvm/auto_scheduler/feature.h>
+#include <tvm/support/parallel_for.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "../meta_schedule/cost_model/tree_ensemble.h"
 
 namespace tvm {
 namespace auto_scheduler {
@@ -145,8 +152,71 @@ void PythonBasedModelNode::PredictStages(const SearchTask& task, const Array<Sta
   }
 }
 
+/*!
+ * \brief A cost model that natively predicts the scores of states with a pre-trained tree
+ * ensemble, e.g. the booster of XGBModel saved in JSON. The features are extracted and the states
+ * are scored in parallel, without calling back into python. The score of a state is the sum of
+ * the predictions over its stores, the same pack-sum formulation as XGBModel.
+ * The model is inference-only, i.e. `Update` is a no-op.
+ */
+class TreeEnsembleModelNode : public CostModelNode {
+ public:
+  /*! \brief The tree ensemble */
+  meta_schedule::TreeEnsemble ensemble;
+  /*! \brief The maximum number of buffers of the features that the ensemble is trained on */
+  int max_n_bufs;
+
+  void Update(const Array<MeasureInput>& inputs, const Array<MeasureResult>& results) final {}
+
+  void Predict(const SearchTask& task, const Array<State>& states,
+               std::vector<float>* scores) final {
+    std::vector<std::vector<float>> features;
+    GetPerStoreFeaturesFromStates(states, task, 0, max_n_bufs, &features);
+    scores->assign(states.size(), 0.0f);
+    support::parallel_for(0, states.size(), [this, &features, &scores](int i) {
+      (*scores)[i] = PredictState(features[i]);
+    });
+  }
+
+  static constexpr const char* _type_key = "auto_scheduler.TreeEnsembleModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TreeEnsembleModelNode, CostModelNode);
+
+ private:
+  /*!
+   * \brief Predict the score of a state from its features, i.e. the number of stores followed by
+   * the feature vector of each store.
+   */
+  float PredictState(const std::vector<float>& feature) const {
+    // The states that failed to be lowered have no features
+    int n_stores = feature.empty() ? 0 : static_cast<int>(feature[0] + 0.5);
+    if (n_stores == 0 ||
+        std::all_of(feature.begin() + 1, feature.end(), [](float x) { return x == 0.0f; })) {
+      return -std::numeric_limits<float>::infinity();
+    }
+    size_t vec_len = (feature.size() - 1) / n_stores;
+    CHECK_GE(static_cast<int64_t>(vec_len), ensemble.num_features())
+        << "ValueError: The tree ensemble reads " << ensemble.num_features()
+        << " features, but only " << vec_len << " are extracted";
+    double score = 0.0;
+    for (int i = 0; i < n_stores; ++i) {
+      score += ensemble.Predict(feature.data() + 1 + i * vec_len);
+    }
+    return score;
+  }
+};
+
+TVM_REGISTER_OBJECT_TYPE(TreeEnsembleModelNode);
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RandomModel").set_body_typed([]() { return RandomModel(); });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.TreeEnsembleModel")
+    .set_body_typed([](String path, int max_n_bufs) {
+      ObjectPtr<TreeEnsembleModelNode> node = make_object<TreeEnsembleModelNode>();
+      node->ensemble.Load(path);
+      node->max_n_bufs = max_n_bufs;
+      return CostModel(node);
+    });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedModel")
     .set_body_typed([](PackedFunc update_func, PackedFunc predict_func,
                        PackedFunc predict_stage_func) {
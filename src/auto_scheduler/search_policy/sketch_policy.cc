@@ -439,9 +439,10 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
       cand_states = search_task->compute_dag.InferBound(cand_states);
       PruneInvalidState(search_task, &cand_states);
       program_cost_model->Predict(search_task, cand_states, &pop_scores);
+      std::vector<std::string> state_strs = StatesToStrs(cand_states);
 
       for (size_t i = 0; i < cand_states.size(); i++) {
-        const auto state_str = cand_states[i].ToStr();
+        const auto& state_str = state_strs[i];
         if (pop_scores[i] > -1e10 && explored_state_strs.count(state_str) == 0) {
           explored_state_strs.insert(state_str);
           out_states.push_back(std::move(cand_states[i]));
@@ -522,7 +523,6 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   float max_score = -1e-10f;
   pop_scores.reserve(population);
   pop_selection_probs.reserve(population);
-  std::uniform_real_distribution<> dis(0.0, 1.0);
 
   // mutation rules
   int mutation_success_ct, mutation_fail_ct;
@@ -536,14 +536,17 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
 
   // Genetic Algorithm
   for (int k = 0; k < num_iters + 1; ++k) {
-    // Maintain the heap
-    *pnow = search_task->compute_dag.InferBound(*pnow);
+    // Maintain the heap. The later populations are bound when they are generated below.
+    if (k == 0) {
+      *pnow = search_task->compute_dag.InferBound(*pnow);
+    }
     PruneInvalidState(search_task, pnow);
     program_cost_model->Predict(search_task, *pnow, &pop_scores);
+    std::vector<std::string> state_strs = StatesToStrs(*pnow);
 
     for (size_t i = 0; i < pnow->size(); ++i) {
       const State& state = (*pnow)[i];
-      std::string state_str = state.ToStr();
+      const std::string& state_str = state_strs[i];
 
       if (in_heap.count(state_str) == 0) {
         if (static_cast<int>(heap.size()) < out_size) {
@@ -587,20 +590,55 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
 
     // TODO(merrymercy, comaniac): add crossover.
 
-    // Do mutation
+    // Do mutation in parallel, with one random generator per new state so that the result
+    // does not depend on the number of threads.
     while (pnext->size() < population) {
-      State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, &rand_gen)];
+      size_t num_new = population - pnext->size();
+      std::vector<std::mt19937> rand_gens;
+      rand_gens.reserve(num_new);
+      for (size_t i = 0; i < num_new; ++i) {
+        rand_gens.push_back(std::mt19937(rand_gen()));
+      }
+      std::vector<State> new_states(num_new);
+      std::vector<char> mutated(num_new, 0);
+      support::parallel_for(0, num_new, [&](int i) {
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, &rand_gens[i])];
+        if (dis(rand_gens[i]) < mutation_prob) {
+          const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, &rand_gens[i])];
+          mutated[i] = 1;
+          if (rule->Apply(this, &tmp_s, &rand_gens[i]) ==
+              PopulationGenerationRule::ResultKind::kValid) {
+            new_states[i] = std::move(tmp_s);
+          }
+        } else {
+          new_states[i] = std::move(tmp_s);
+        }
+      });
+
+      // Only the mutated states need new bounds, the others are copies of bound states
+      Array<State> mutated_states;
+      std::vector<size_t> mutated_ids;
+      for (size_t i = 0; i < num_new; ++i) {
+        if (mutated[i] && new_states[i].defined()) {
+          mutated_states.push_back(new_states[i]);
+          mutated_ids.push_back(i);
+        }
+      }
+      mutated_states = search_task->compute_dag.InferBound(mutated_states);
+      for (size_t i = 0; i < mutated_ids.size(); ++i) {
+        new_states[mutated_ids[i]] = mutated_states[i];
+      }
 
-      if (dis(rand_gen) < mutation_prob) {
-        const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, &rand_gen)];
-        if (rule->Apply(this, &tmp_s, &rand_gen) == PopulationGenerationRule::ResultKind::kValid) {
-          pnext->push_back(std::move(tmp_s));
+      for (size_t i = 0; i < num_new; ++i) {
+        if (!mutated[i]) {
+          pnext->push_back(std::move(new_states[i]));
+        } else if (new_states[i].defined()) {
+          pnext->push_back(std::move(new_states[i]));
           mutation_success_ct++;
         } else {
           mutation_fail_ct++;
         }
-      } else {
-        pnext->push_back(std::move(tmp_s));
       }
     }
 
@@ -24,6 +24,8 @@
 
 #include "utils.h"
 
+#include <tvm/support/parallel_for.h>
+
 #include <algorithm>
 
 namespace tvm {
@@ -395,9 +397,19 @@ void PruneInvalidState(const SearchTask& task, Array<State>* states) {
   }
 }
 
+std::vector<std::string> StatesToStrs(const Array<State>& states) {
+  std::vector<std::string> state_strs(states.size());
+  support::parallel_for(0, states.size(),
+                        [&states, &state_strs](int i) { state_strs[i] = states[i].ToStr(); });
+  return state_strs;
+}
+
 /********** SplitFactorizationMemo **********/
 const Array<Array<Integer>>& SplitFactorizationMemo::GetFactorizationSchemes(
     int extent, int n_lengths, int max_innermost_factor) {
+  // The entries of the maps are never moved or changed once computed, so the returned
+  // references stay valid after the lock is released.
+  std::lock_guard<std::mutex> lock(mutex_);
   QueryKey key = std::make_tuple(extent, n_lengths, max_innermost_factor);
   const auto& it = memory_.find(key);
   if (it != memory_.end()) {
@@ -419,7 +431,7 @@ void SplitFactorizationMemo::DfsEnumerate(int now, int remaining_length, int max
       results_->push_back(tmp_stack_);
     }
   } else {
-    for (const auto& f : GetFactors(remaining_length)) {
+    for (const auto& f : GetFactorsUnlocked(remaining_length)) {
       tmp_stack_.Set(now, Integer(f));
       DfsEnumerate(now + 1, remaining_length / f, max_innermost_factor);
     }
@@ -427,6 +439,11 @@ void SplitFactorizationMemo::DfsEnumerate(int now, int remaining_length, int max
 }
 
 const std::vector<int>& SplitFactorizationMemo::GetFactors(int n) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return GetFactorsUnlocked(n);
+}
+
+const std::vector<int>& SplitFactorizationMemo::GetFactorsUnlocked(int n) {
   auto it = factor_memory_.find(n);
   if (it != factor_memory_.end()) {
     return it->second;
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -663,7 +664,8 @@ inline void PrintTitle(const std::string& title, int verbose) {
 
 /*!
  * \brief Enumerate all possible factorization schemes for splitting an axes.
- * \note This class will memorize the results for reuse.
+ * \note This class will memorize the results for reuse. It is safe to share one memo
+ * between the threads that sample and mutate states in parallel.
  */
 class SplitFactorizationMemo {
  public:
@@ -675,7 +677,9 @@ class SplitFactorizationMemo {
 
  private:
   void DfsEnumerate(int now, int remaining_length, int max_innermost_factor);
+  const std::vector<int>& GetFactorsUnlocked(int n);
 
+  std::mutex mutex_;
   std::unordered_map<QueryKey, Array<Array<Integer>>> memory_;
 
   int n_lengths_;
@@ -708,6 +712,9 @@ State FollowTiling(const State& state, int stage_id, const std::vector<int>& spl
 // Prune invalid states and return the results in-place.
 void PruneInvalidState(const SearchTask& task, Array<State>* states);
 
+// Print the states to strings in parallel, e.g. to deduplicate them.
+std::vector<std::string> StatesToStrs(const Array<State>& states);
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
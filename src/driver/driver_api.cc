@@ -211,6 +211,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
   pass_list.push_back(tir::transform::LowerOpaqueBlock());
   pass_list.push_back(tir::transform::FlattenBuffer());
   pass_list.push_back(tir::transform::BF16ComputeLegalize());
+  pass_list.push_back(tir::transform::FP8ComputeLegalize());
   pass_list.push_back(tir::transform::NarrowDataType(32));
   pass_list.push_back(tir::transform::Simplify());
 
@@ -260,7 +261,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
       tir::transform::CommonSubexprElimTIR(!disable_cse_tir, enable_equiv_terms_in_cse_tir));
 
   // This pass instruments the loops with the profile builtin calls to capture the runtime
-  // performance data (only enabled for Hexagon at the moment). To ensure that no other
+  // performance data (on Hexagon, LLVM CPU targets and CUDA). To ensure that no other
   // optimizations are performed on the instrumented code, this pass must be added at the end
   // of the list.
   if (instrument_lwp) {
@@ -30,6 +30,7 @@
 
 #include <chrono>
 #include <iomanip>
+#include <optional>
 #include <stack>
 #include <unordered_set>
 
@@ -43,6 +44,7 @@ using tvm::runtime::TVMArgs;
 using tvm::runtime::TVMRetValue;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("testing.immutable_module", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("ir.enable_object_pool", Bool);
 
 struct PassContextThreadLocalEntry {
   /*! \brief The default pass context. */
@@ -268,6 +270,12 @@ IRModule Pass::operator()(IRModule mod, const PassContext& pass_ctx) const {
     return mod;
   }
   IRModule ret;
+  // Recycle the memory of the temporary objects created by the pass, released at the exit
+  // of the outermost pass.
+  std::optional<runtime::ObjectPoolScope> object_pool;
+  if (pass_ctx->GetConfig<Bool>("ir.enable_object_pool", Bool(false)).value()) {
+    object_pool.emplace();
+  }
   if (pass_ctx->GetConfig<Bool>("testing.immutable_module", Bool(false)).value()) {
     ret = Pass::AssertImmutableModule(mod, node, pass_ctx);
   } else {
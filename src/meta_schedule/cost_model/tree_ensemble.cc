@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "./tree_ensemble.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+void TreeEnsemble::Load(const String& path) {
+  std::ifstream is(path);
+  CHECK(is.good()) << "ValueError: Cannot open the file to read: " << path;
+  std::stringstream ss;
+  ss << is.rdbuf();
+  std::string model_json = ss.str();
+  ObjectRef json = JSONLoads(model_json);
+
+  auto get = [&path](const ObjectRef& obj, const char* key) -> ObjectRef {
+    const auto* dict = obj.as<MapNode>();
+    CHECK(dict != nullptr && dict->count(String(key)))
+        << "ValueError: Unable to find \"" << key << "\" in the tree ensemble: " << path;
+    return dict->at(String(key));
+  };
+  auto get_ints = [&get](const ObjectRef& obj, const char* key) -> std::vector<int32_t> {
+    Array<ObjectRef> arr = Downcast<Array<ObjectRef>>(get(obj, key));
+    std::vector<int32_t> result;
+    result.reserve(arr.size());
+    for (const ObjectRef& elem : arr) {
+      result.push_back(Downcast<Integer>(elem).IntValue());
+    }
+    return result;
+  };
+  ObjectRef learner = get(json, "learner");
+  ObjectRef booster = get(learner, "gradient_booster");
+  String name = Downcast<String>(get(booster, "name"));
+  CHECK(name == "gbtree") << "ValueError: Only gbtree boosters are supported, but gets: " << name;
+  // Recent versions of XGBoost save the base score as a one-element list, e.g. "[5E-1]"
+  std::string base_score = Downcast<String>(get(get(learner, "learner_model_param"), "base_score"));
+  if (!base_score.empty() && base_score.front() == '[') {
+    base_score = base_score.substr(1, base_score.size() - 2);
+  }
+  Array<ObjectRef> trees_json = Downcast<Array<ObjectRef>>(get(get(booster, "model"), "trees"));
+  std::vector<RegressionTree> trees;
+  trees.reserve(trees_json.size());
+  int64_t num_features = 0;
+  for (const ObjectRef& tree_json : trees_json) {
+    RegressionTree tree;
+    tree.left_children = get_ints(tree_json, "left_children");
+    tree.right_children = get_ints(tree_json, "right_children");
+    tree.split_indices = get_ints(tree_json, "split_indices");
+    for (int32_t value : get_ints(tree_json, "default_left")) {
+      tree.default_left.push_back(value);
+    }
+    for (const ObjectRef& elem : Downcast<Array<ObjectRef>>(get(tree_json, "split_conditions"))) {
+      if (const auto* imm = elem.as<IntImmNode>()) {
+        tree.split_conditions.push_back(imm->value);
+      } else {
+        tree.split_conditions.push_back(Downcast<FloatImm>(elem)->value);
+      }
+    }
+    size_t n = tree.left_children.size();
+    CHECK(n > 0 && tree.right_children.size() == n && tree.split_indices.size() == n &&
+          tree.default_left.size() == n && tree.split_conditions.size() == n)
+        << "ValueError: Malformed tree in the tree ensemble: " << path;
+    for (size_t i = 0; i < n; ++i) {
+      if (tree.left_children[i] != -1) {
+        CHECK(tree.left_children[i] > static_cast<int32_t>(i) &&
+              tree.left_children[i] < static_cast<int32_t>(n) &&
+              tree.right_children[i] > static_cast<int32_t>(i) &&
+              tree.right_children[i] < static_cast<int32_t>(n))
+            << "ValueError: Malformed tree in the tree ensemble: " << path;
+        num_features = std::max(num_features, static_cast<int64_t>(tree.split_indices[i]) + 1);
+      }
+    }
+    trees.push_back(std::move(tree));
+  }
+  // Only replace the loaded ensemble once the new one is fully parsed
+  this->trees_ = std::move(trees);
+  this->base_score_ = std::stod(base_score);
+  this->num_features_ = num_features;
+  this->model_json_ = std::move(model_json);
+}
+
+void TreeEnsemble::Save(const String& path) const {
+  CHECK(!this->model_json_.empty()) << "ValueError: No tree ensemble has been loaded";
+  std::ofstream os(path);
+  CHECK(os.good()) << "ValueError: Cannot open the file to write: " << path;
+  os << this->model_json_;
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
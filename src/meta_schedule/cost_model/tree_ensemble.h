@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_COST_MODEL_TREE_ENSEMBLE_H_
+#define TVM_META_SCHEDULE_COST_MODEL_TREE_ENSEMBLE_H_
+
+#include <tvm/runtime/container/string.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief A regression tree, stored as flat arrays indexed by the node id. */
+struct RegressionTree {
+  /*! \brief The left child of each node, -1 for leaves */
+  std::vector<int32_t> left_children;
+  /*! \brief The right child of each node, -1 for leaves */
+  std::vector<int32_t> right_children;
+  /*! \brief The feature that each node splits on */
+  std::vector<int32_t> split_indices;
+  /*! \brief The split threshold of each node, or the value of each leaf */
+  std::vector<float> split_conditions;
+  /*! \brief Whether the missing values go to the left child */
+  std::vector<uint8_t> default_left;
+
+  /*! \brief Compute the value of the leaf that a feature vector falls into. */
+  float Predict(const float* features) const {
+    int32_t node = 0;
+    while (left_children[node] != -1) {
+      float value = features[split_indices[node]];
+      if (std::isnan(value)) {
+        node = default_left[node] ? left_children[node] : right_children[node];
+      } else {
+        node = value < split_conditions[node] ? left_children[node] : right_children[node];
+      }
+    }
+    return split_conditions[node];
+  }
+};
+
+/*!
+ * \brief A pre-trained gbtree ensemble in the JSON format of XGBoost models, e.g. saved by
+ * `booster.save_model("model.json")`. It is shared by the native cost models of meta_schedule
+ * and auto_scheduler, which both score a program as the sum of the predictions over its stores.
+ */
+class TreeEnsemble {
+ public:
+  /*! \brief Load the ensemble from a file, replacing the loaded one. */
+  void Load(const String& path);
+  /*! \brief Save the JSON of the loaded ensemble to a file. */
+  void Save(const String& path) const;
+  /*! \brief Whether an ensemble has been loaded. */
+  bool empty() const { return trees_.empty(); }
+  /*! \brief The number of trees of the ensemble. */
+  size_t num_trees() const { return trees_.size(); }
+  /*! \brief The number of features that the trees read. */
+  int64_t num_features() const { return num_features_; }
+  /*! \brief Predict the value of one feature vector, which has at least num_features() entries. */
+  double Predict(const float* features) const {
+    double score = base_score_;
+    for (const RegressionTree& tree : trees_) {
+      score += tree.Predict(features);
+    }
+    return score;
+  }
+
+ private:
+  /*! \brief The trees of the ensemble */
+  std::vector<RegressionTree> trees_;
+  /*! \brief The initial prediction of each feature vector */
+  double base_score_ = 0.0;
+  /*! \brief The number of features that the trees read */
+  int64_t num_features_ = 0;
+  /*! \brief The JSON of the loaded model, kept for saving */
+  std::string model_json_;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_COST_MODEL_TREE_ENSEMBLE_H_
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+#include "./tree_ensemble.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief A cost model that scores candidates natively with a pre-trained tree ensemble, in the
+ *  JSON format of XGBoost models. The score of a candidate is the sum of the predictions over its
+ *  stores, the same pack-sum formulation as the XGBModel that trains it.
+ */
+class TreeEnsembleCostModelNode : public CostModelNode {
+ public:
+  /*! \brief The feature extractor */
+  FeatureExtractor extractor{nullptr};
+  /*! \brief The tree ensemble */
+  TreeEnsemble ensemble;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("extractor", &extractor);
+    // `ensemble` is not visited
+  }
+
+  void Load(const String& path) final { this->ensemble.Load(path); }
+
+  void Save(const String& path) final { this->ensemble.Save(path); }
+
+  void Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
+              const Array<RunnerResult>& results) final {
+    // The tree ensemble is pre-trained, so that the measured results are not used
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const Array<MeasureCandidate>& candidates) final {
+    CHECK(!this->ensemble.empty()) << "ValueError: No tree ensemble has been loaded";
+    Array<runtime::NDArray> features = this->extractor->ExtractFrom(context, candidates);
+    ICHECK_EQ(features.size(), candidates.size());
+    std::vector<double> results(candidates.size(), 0.0);
+    auto f = [this, &features, &results](int, int task_id) -> void {
+      const runtime::NDArray& feature = features[task_id];
+      CHECK_EQ(feature->ndim, 2) << "ValueError: Expect 2-dimensional features";
+      int64_t n_rows = feature->shape[0];
+      int64_t n_cols = feature->shape[1];
+      if (n_rows == 0) {
+        return;
+      }
+      CHECK_GE(n_cols, this->ensemble.num_features())
+          << "ValueError: The tree ensemble reads " << this->ensemble.num_features()
+          << " features, but only " << n_cols << " are extracted";
+      // The trees are trained on float32 features, which the thresholds are compared to
+      std::vector<float> row(n_cols);
+      double result = 0.0;
+      for (int64_t i = 0; i < n_rows; ++i) {
+        if (feature.DataType() == DataType::Float(64)) {
+          const double* src = static_cast<const double*>(feature->data) + i * n_cols;
+          std::copy(src, src + n_cols, row.begin());
+        } else {
+          CHECK(feature.DataType() == DataType::Float(32))
+              << "ValueError: Unsupported dtype of features: " << feature.DataType();
+          const float* src = static_cast<const float*>(feature->data) + i * n_cols;
+          std::copy(src, src + n_cols, row.begin());
+        }
+        result += this->ensemble.Predict(row.data());
+      }
+      results[task_id] = result;
+    };
+    support::parallel_for_dynamic(0, candidates.size(), std::max(context->num_threads, 1), f);
+    return results;
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.TreeEnsembleCostModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TreeEnsembleCostModelNode, CostModelNode);
+};
+
+CostModel CostModel::TreeEnsembleCostModel(FeatureExtractor extractor, Optional<String> path) {
+  ObjectPtr<TreeEnsembleCostModelNode> n = make_object<TreeEnsembleCostModelNode>();
+  n->extractor = std::move(extractor);
+  if (path.defined()) {
+    n->Load(path.value());
+  }
+  return CostModel(n);
+}
+
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<TreeEnsembleCostModelNode>([](const ObjectRef& n, ReprPrinter* p) {
+      const auto* self = n.as<TreeEnsembleCostModelNode>();
+      ICHECK(self);
+      p->stream << "meta_schedule.TreeEnsembleCostModel(num_trees=" << self->ensemble.num_trees()
+                << ")";
+    });
+
+TVM_REGISTER_NODE_TYPE(TreeEnsembleCostModelNode);
+TVM_REGISTER_GLOBAL("meta_schedule.CostModelTreeEnsembleCostModel")
+    .set_body_typed(CostModel::TreeEnsembleCostModel);
+
+}  // namespace meta_schedule
+}  // namespace tvm
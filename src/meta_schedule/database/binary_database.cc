@@ -0,0 +1,344 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief The magic number at the beginning of a binary database file. */
+constexpr uint64_t kBinaryDatabaseMagic = 0xF7E58D4F05049CC0;
+
+/*! \brief The kinds of the frames of a binary database file. */
+enum class BinaryDatabaseFrame : uint8_t {
+  kWorkload = 0,
+  kTuningRecord = 1,
+};
+
+/*!
+ * \brief The layout of a frame is `kind (uint8) | payload size (uint64) | payload`.
+ *  The payload of a workload is its JSON. The payload of a tuning record is
+ *  `workload index (int64) | is valid (uint8) | mean run secs (double) | JSON`, so that the
+ *  records can be indexed without parsing their JSON.
+ */
+constexpr size_t kFrameHeaderBytes = sizeof(uint8_t) + sizeof(uint64_t);
+constexpr size_t kRecordHeaderBytes = sizeof(int64_t) + sizeof(uint8_t) + sizeof(double);
+
+template <typename T>
+void AppendPOD(std::string* buffer, const T& value) {
+  buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadPOD(const char* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+/*!
+ * \brief A database backed by a single append-only binary log. The valid records of each
+ *  workload are indexed by their mean run time, and the JSON of a record is only parsed the first
+ *  time the record is returned.
+ */
+class BinaryDatabaseNode : public DatabaseNode {
+ public:
+  explicit BinaryDatabaseNode(String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name),
+        workloads2idx_(/*bucket_count*/ 0, WorkloadHash(), WorkloadEqual(GetModuleEquality())) {}
+
+  /*! \brief A tuning record in the log, deserialized lazily. */
+  struct RecordEntry {
+    /*! \brief The index of the workload of the record */
+    int64_t workload_idx;
+    /*! \brief The offset of the JSON of the record in the log */
+    int64_t offset;
+    /*! \brief The size of the JSON of the record */
+    int64_t size;
+    /*! \brief The record, once deserialized */
+    Optional<TuningRecord> record;
+  };
+
+  /*! \brief The path to the log */
+  String path;
+  /*! \brief The size of the log */
+  int64_t file_size_ = 0;
+  /*! \brief All the workloads in the database, in the order of the log */
+  std::vector<Workload> workloads_;
+  /*! \brief The index of each workload */
+  std::unordered_map<Workload, int64_t, WorkloadHash, WorkloadEqual> workloads2idx_;
+  /*! \brief All the tuning records in the database, in the order of the log */
+  std::vector<RecordEntry> records_;
+  /*! \brief The valid records of each workload, keyed by (and sorted on) their mean run time */
+  std::vector<std::multimap<double, int64_t>> sorted_records_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("path", &path);
+    // `file_size_` is not visited
+    // `workloads_` is not visited
+    // `workloads2idx_` is not visited
+    // `records_` is not visited
+    // `sorted_records_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.BinaryDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(BinaryDatabaseNode, DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) final {
+    return workloads2idx_.find(Workload(mod, GetModuleEquality().Hash(mod))) !=
+           workloads2idx_.end();
+  }
+
+  Workload CommitWorkload(const IRModule& mod) final {
+    auto [it, inserted] =
+        this->workloads2idx_.emplace(Workload(mod, GetModuleEquality().Hash(mod)), -1);
+    if (inserted) {
+      it->second = AddWorkload(it->first);
+      Append(BinaryDatabaseFrame::kWorkload, JSONDumps(it->first->AsJSON()));
+    }
+    return it->first;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) final {
+    int64_t workload_idx = this->workloads2idx_.at(record->workload);
+    bool is_valid = record->IsValid();
+    double mean = SortTuningRecordByMeanRunSecs::Mean(record->run_secs.value_or({}));
+    std::string json = JSONDumps(record->AsJSON());
+    std::string payload;
+    payload.reserve(kRecordHeaderBytes + json.size());
+    AppendPOD(&payload, workload_idx);
+    AppendPOD(&payload, static_cast<uint8_t>(is_valid));
+    AppendPOD(&payload, mean);
+    payload += json;
+    int64_t offset = this->file_size_ + kFrameHeaderBytes + kRecordHeaderBytes;
+    Append(BinaryDatabaseFrame::kTuningRecord, payload);
+    AddRecord(workload_idx, is_valid, mean, offset, json.size(), record);
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) final {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    auto it = this->workloads2idx_.find(workload);
+    if (it == this->workloads2idx_.end()) {
+      return {};
+    }
+    Array<TuningRecord> results;
+    std::ifstream is;
+    for (const auto& kv : this->sorted_records_[it->second]) {
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
+      }
+      results.push_back(GetRecord(kv.second, &is));
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() final {
+    Array<TuningRecord> results;
+    results.reserve(Size());
+    std::ifstream is;
+    for (size_t i = 0; i < this->records_.size(); ++i) {
+      results.push_back(GetRecord(i, &is));
+    }
+    return results;
+  }
+
+  int64_t Size() final { return records_.size(); }
+
+  /*! \brief Register a new workload, and return its index. */
+  int64_t AddWorkload(const Workload& workload) {
+    this->workloads_.push_back(workload);
+    this->sorted_records_.emplace_back();
+    return static_cast<int64_t>(this->workloads_.size()) - 1;
+  }
+
+  /*! \brief Register a tuning record, `record` being undefined until it is deserialized. */
+  void AddRecord(int64_t workload_idx, bool is_valid, double mean, int64_t offset, int64_t size,
+                 Optional<TuningRecord> record) {
+    int64_t record_idx = this->records_.size();
+    this->records_.push_back(RecordEntry{workload_idx, offset, size, record});
+    if (is_valid) {
+      this->sorted_records_[workload_idx].emplace(mean, record_idx);
+    }
+  }
+
+ private:
+  /*! \brief Append a frame to the log. */
+  void Append(BinaryDatabaseFrame kind, const std::string& payload) {
+    std::ofstream os(this->path, std::ofstream::app | std::ofstream::binary);
+    CHECK(os.good()) << "ValueError: Cannot open the file to write: " << this->path;
+    uint8_t kind_value = static_cast<uint8_t>(kind);
+    uint64_t size = payload.size();
+    os.write(reinterpret_cast<const char*>(&kind_value), sizeof(kind_value));
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    os.write(payload.data(), payload.size());
+    os.flush();
+    CHECK(os.good()) << "ValueError: Cannot write to the file: " << this->path;
+    this->file_size_ += kFrameHeaderBytes + payload.size();
+  }
+
+  /*! \brief Get a tuning record, reading its JSON from the log if not deserialized yet. */
+  TuningRecord GetRecord(int64_t record_idx, std::ifstream* is) {
+    RecordEntry& entry = this->records_[record_idx];
+    if (!entry.record.defined()) {
+      if (!is->is_open()) {
+        is->open(this->path, std::ifstream::binary);
+        CHECK(is->good()) << "ValueError: Cannot open the file to read: " << this->path;
+      }
+      std::string json(entry.size, '\0');
+      is->seekg(entry.offset);
+      is->read(&json[0], entry.size);
+      CHECK(is->good()) << "ValueError: Unable to read TuningRecord at offset " << entry.offset
+                        << " of file " << this->path;
+      const Workload& workload = this->workloads_[entry.workload_idx];
+      try {
+        entry.record = TuningRecord::FromJSON(JSONLoads(json), workload);
+      } catch (std::runtime_error& e) {
+        LOG(FATAL) << "ValueError: Unable to parse TuningRecord, at offset " << entry.offset
+                   << " of file " << this->path << ". The workload is:\n"
+                   << workload->mod->Script() << "\nThe JSONObject of TuningRecord is:\n"
+                   << json << "\nThe error message is:\n"
+                   << e.what();
+      }
+    }
+    return entry.record.value();
+  }
+};
+
+Database Database::BinaryDatabase(String path, bool allow_missing, String mod_eq_name) {
+  ObjectPtr<BinaryDatabaseNode> n = make_object<BinaryDatabaseNode>(mod_eq_name);
+  n->path = path;
+  std::ifstream is(path, std::ifstream::binary);
+  int64_t file_size = 0;
+  if (is.good()) {
+    is.seekg(0, std::ifstream::end);
+    file_size = is.tellg();
+    is.seekg(0, std::ifstream::beg);
+  } else {
+    CHECK(allow_missing) << "ValueError: File doesn't exist: " << path;
+  }
+  if (file_size == 0) {
+    std::ofstream os(path, std::ofstream::binary);
+    CHECK(os.good()) << "ValueError: Cannot create new file: " << path;
+    os.write(reinterpret_cast<const char*>(&kBinaryDatabaseMagic), sizeof(kBinaryDatabaseMagic));
+    CHECK(os.good()) << "ValueError: Cannot write to the file: " << path;
+    n->file_size_ = sizeof(kBinaryDatabaseMagic);
+    return Database(n);
+  }
+  uint64_t magic = 0;
+  is.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  CHECK(is.good() && magic == kBinaryDatabaseMagic)
+      << "ValueError: Not a binary database file: " << path;
+  int64_t offset = sizeof(magic);
+  // Only the workloads are parsed eagerly, as they are few. Their hashes are recomputed, see the
+  // JSON database.
+  std::vector<std::string> workload_jsons;
+  struct PendingRecord {
+    int64_t workload_idx;
+    bool is_valid;
+    double mean;
+    int64_t offset;
+    int64_t size;
+  };
+  std::vector<PendingRecord> records;
+  static_assert(kRecordHeaderBytes >= kFrameHeaderBytes, "header must hold both headers");
+  char header[kRecordHeaderBytes];
+  while (offset < file_size) {
+    // A frame which is not complete was being written when the process stopped. It is not
+    // dropped silently, as the next frames would be appended after it.
+    CHECK(offset + static_cast<int64_t>(kFrameHeaderBytes) <= file_size &&
+          is.read(header, kFrameHeaderBytes))
+        << "ValueError: Incomplete frame at offset " << offset << " of file " << path
+        << ", truncate the file to " << offset << " bytes to recover it";
+    BinaryDatabaseFrame kind = static_cast<BinaryDatabaseFrame>(ReadPOD<uint8_t>(header));
+    int64_t size = static_cast<int64_t>(ReadPOD<uint64_t>(header + sizeof(uint8_t)));
+    int64_t payload_offset = offset + kFrameHeaderBytes;
+    CHECK(size >= 0 && payload_offset + size <= file_size)
+        << "ValueError: Incomplete frame at offset " << offset << " of file " << path
+        << ", truncate the file to " << offset << " bytes to recover it";
+    if (kind == BinaryDatabaseFrame::kWorkload) {
+      std::string json(size, '\0');
+      is.read(&json[0], size);
+      workload_jsons.push_back(std::move(json));
+    } else if (kind == BinaryDatabaseFrame::kTuningRecord) {
+      CHECK_GE(size, kRecordHeaderBytes) << "ValueError: Corrupted TuningRecord at offset "
+                                         << offset << " of file " << path;
+      is.read(header, kRecordHeaderBytes);
+      PendingRecord record;
+      record.workload_idx = ReadPOD<int64_t>(header);
+      record.is_valid = ReadPOD<uint8_t>(header + sizeof(int64_t));
+      record.mean = ReadPOD<double>(header + sizeof(int64_t) + sizeof(uint8_t));
+      record.offset = payload_offset + kRecordHeaderBytes;
+      record.size = size - kRecordHeaderBytes;
+      is.seekg(record.size, std::ifstream::cur);
+      records.push_back(record);
+    } else {
+      LOG(FATAL) << "ValueError: Unknown frame kind " << static_cast<int>(kind) << " at offset "
+                 << offset << " of file " << path;
+    }
+    CHECK(is.good()) << "ValueError: Unable to read the frame at offset " << offset << " of file "
+                     << path;
+    offset = payload_offset + size;
+  }
+  n->file_size_ = file_size;
+  // Parse the workloads
+  int num_threads = std::thread::hardware_concurrency();
+  int n_workloads = workload_jsons.size();
+  std::vector<Workload> workloads(n_workloads, Workload{nullptr});
+  support::parallel_for_dynamic(0, n_workloads, num_threads, [&](int thread_id, int task_id) {
+    Workload workload = Workload::FromJSON(JSONLoads(workload_jsons[task_id]));
+    auto recalc_hash = n->GetModuleEquality().Hash(workload->mod);
+    if (recalc_hash != workload->shash) {
+      ObjectPtr<WorkloadNode> wkl = make_object<WorkloadNode>(*workload.get());
+      wkl->shash = recalc_hash;
+      workload = Workload(wkl);
+    }
+    workloads[task_id] = workload;
+  });
+  n->workloads2idx_.reserve(n_workloads);
+  for (const Workload& workload : workloads) {
+    n->workloads2idx_.emplace(workload, n->AddWorkload(workload));
+  }
+  // Index the tuning records, without parsing them
+  n->records_.reserve(records.size());
+  for (const PendingRecord& record : records) {
+    CHECK(record.workload_idx >= 0 && record.workload_idx < n_workloads)
+        << "ValueError: Unknown workload " << record.workload_idx << " of TuningRecord at offset "
+        << record.offset << " of file " << path;
+    n->AddRecord(record.workload_idx, record.is_valid, record.mean, record.offset, record.size,
+                 NullOpt);
+  }
+  return Database(n);
+}
+
+TVM_REGISTER_NODE_TYPE(BinaryDatabaseNode);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseBinaryDatabase")
+    .set_body_typed(Database::BinaryDatabase);
+
+}  // namespace meta_schedule
+}  // namespace tvm
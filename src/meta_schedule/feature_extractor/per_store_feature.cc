@@ -19,7 +19,9 @@
 #include <tvm/tir/transform.h>
 
 #include <cmath>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -1362,12 +1364,76 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
   int cache_line_bytes;
   bool extract_workload;
   int feature_vector_length;
+  int max_cache_size;
+
+  /*! \brief The features extracted from an IRModule, before lowering */
+  struct CacheEntry {
+    /*! \brief The IRModule */
+    IRModule mod;
+    /*! \brief Whether the IRModule targets GPU */
+    bool is_gpu;
+    /*! \brief The features of each store in the IRModule */
+    std::shared_ptr<const std::vector<std::vector<double>>> features;
+  };
+  /*! \brief The mutex guarding the cache */
+  std::mutex cache_mutex_;
+  /*! \brief The cached features, keyed by the structural hash of the IRModule */
+  std::unordered_map<size_t, std::vector<CacheEntry>> cache_;
+  /*! \brief The hashes of the cached entries, in the order of insertion, for eviction */
+  std::deque<size_t> cache_order_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("buffers_per_store", &buffers_per_store);
     v->Visit("arith_intensity_curve_num_samples", &arith_intensity_curve_num_samples);
     v->Visit("cache_line_bytes", &cache_line_bytes);
     v->Visit("feature_vector_length", &feature_vector_length);
+    v->Visit("max_cache_size", &max_cache_size);
+    // `cache_mutex_` is not visited
+    // `cache_` is not visited
+    // `cache_order_` is not visited
+  }
+
+  /*!
+   * \brief Extract the features of an IRModule, reusing those of a structurally equal IRModule
+   * seen before. The search strategies score the same candidates over and over, e.g. the best
+   * measured ones, and a hit skips both the lowering and the walk over the lowered IR.
+   */
+  std::shared_ptr<const std::vector<std::vector<double>>> ExtractCached(const IRModule& mod,
+                                                                        bool is_gpu) {
+    if (this->max_cache_size <= 0) {
+      auto features = std::make_shared<std::vector<std::vector<double>>>();
+      ExtractSingle(DeepCopyIRModule(mod), is_gpu, features.get());
+      return features;
+    }
+    size_t shash = StructuralHash()(mod);
+    std::vector<CacheEntry> entries;
+    {
+      std::lock_guard<std::mutex> lock(this->cache_mutex_);
+      auto it = this->cache_.find(shash);
+      if (it != this->cache_.end()) {
+        entries = it->second;
+      }
+    }
+    // The comparisons run without the lock, as they walk the IR
+    for (const CacheEntry& entry : entries) {
+      if (entry.is_gpu == is_gpu && StructuralEqual()(entry.mod, mod)) {
+        return entry.features;
+      }
+    }
+    auto features = std::make_shared<std::vector<std::vector<double>>>();
+    ExtractSingle(DeepCopyIRModule(mod), is_gpu, features.get());
+    std::lock_guard<std::mutex> lock(this->cache_mutex_);
+    if (static_cast<int>(this->cache_order_.size()) >= this->max_cache_size) {
+      auto it = this->cache_.find(this->cache_order_.front());
+      this->cache_order_.pop_front();
+      it->second.erase(it->second.begin());
+      if (it->second.empty()) {
+        this->cache_.erase(it);
+      }
+    }
+    this->cache_[shash].push_back(CacheEntry{mod, is_gpu, features});
+    this->cache_order_.push_back(shash);
+    return features;
   }
 
   void ExtractSingle(IRModule mod, bool is_gpu, std::vector<std::vector<double>>* results) {
@@ -1400,8 +1466,7 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     }
     auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
       const auto& candidate = candidates[task_id];
-      std::vector<std::vector<double>> features;
-      ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
+      std::vector<std::vector<double>> features = *ExtractCached(candidate->sch->mod(), is_gpu);
       if (extract_workload) {
         for (auto& feature : features) {
           feature_group6->Export(&feature);
@@ -1419,12 +1484,14 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
 
 FeatureExtractor FeatureExtractor::PerStoreFeature(int buffers_per_store,
                                                    int arith_intensity_curve_num_samples,
-                                                   int cache_line_bytes, bool extract_workload) {
+                                                   int cache_line_bytes, bool extract_workload,
+                                                   int max_cache_size) {
   ObjectPtr<PerStoreFeatureNode> n = make_object<PerStoreFeatureNode>();
   n->buffers_per_store = buffers_per_store;
   n->arith_intensity_curve_num_samples = arith_intensity_curve_num_samples;
   n->cache_line_bytes = cache_line_bytes;
   n->extract_workload = extract_workload;
+  n->max_cache_size = max_cache_size;
   n->feature_vector_length = tir::group1::Feature::kCount +                                  //
                              tir::group2::Feature::SubFeature::kCount * buffers_per_store +  //
                              arith_intensity_curve_num_samples +                             //
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <chrono>
+#include <unordered_map>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Compute the fraction of the pairs of candidates that the predicted scores rank in the
+ *  opposite order of the measured latencies.
+ * \param scores The predicted scores, higher meaning faster
+ * \param latency_ms The measured latencies
+ * \return The fraction of the discordant pairs, or -1 if there is no pair to compare
+ */
+static double RankError(const std::vector<double>& scores, const std::vector<double>& latency_ms) {
+  int n = scores.size();
+  int64_t n_pairs = 0;
+  int64_t n_discordant = 0;
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      if (latency_ms[i] == latency_ms[j]) {
+        continue;
+      }
+      ++n_pairs;
+      if ((latency_ms[i] < latency_ms[j]) != (scores[i] > scores[j])) {
+        ++n_discordant;
+      }
+    }
+  }
+  return n_pairs == 0 ? -1.0 : static_cast<double>(n_discordant) / n_pairs;
+}
+
+class StopOnConvergenceNode : public MeasureCallbackNode {
+ public:
+  /*! \brief The progress of a task, as seen by the callback */
+  struct TaskState {
+    /*! \brief The best latency so far, in milliseconds */
+    double best_ms = 1e9;
+    /*! \brief The number of trials since the best latency last improved */
+    int trials_since_improvement = 0;
+    /*! \brief The rank error of the cost model on the last batch, -1 if unknown */
+    double prediction_error = -1.0;
+    /*! \brief The time when the first batch of the task was reported */
+    std::chrono::steady_clock::time_point start_time;
+  };
+
+  /*! \brief The number of trials without improvement after which a task is stopped */
+  int patience;
+  /*! \brief The relative decrease of the best latency counted as an improvement */
+  double min_improvement;
+  /*! \brief The rank error of the cost model below which a plateau is trusted */
+  double max_prediction_error;
+  /*! \brief The wall-clock budget of each task, in seconds */
+  double max_seconds_per_task;
+  /*! \brief The progress of each task */
+  std::unordered_map<TaskRecord, TaskState, ObjectPtrHash, ObjectPtrEqual> states_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("patience", &patience);
+    v->Visit("min_improvement", &min_improvement);
+    v->Visit("max_prediction_error", &max_prediction_error);
+    v->Visit("max_seconds_per_task", &max_seconds_per_task);
+    // `states_` is not visited
+  }
+
+  void Apply(const TaskScheduler& task_scheduler, int task_id,
+             const Array<MeasureCandidate>& measure_candidates,
+             const Array<BuilderResult>& builder_results,
+             const Array<RunnerResult>& runner_results) final {
+    auto _ = Profiler::TimedScope("MeasureCallback/StopOnConvergence");
+    TaskRecord task = task_scheduler->tasks_[task_id];
+    if (task->is_terminated) {
+      return;
+    }
+    auto it = this->states_.find(task);
+    if (it == this->states_.end()) {
+      it = this->states_.emplace(task, TaskState()).first;
+      it->second.start_time = std::chrono::steady_clock::now();
+    }
+    TaskState& state = it->second;
+    // Step 1. Collect the latencies of the candidates measured successfully
+    int n = measure_candidates.size();
+    Array<MeasureCandidate> candidates;
+    std::vector<double> latency_ms;
+    candidates.reserve(n);
+    latency_ms.reserve(n);
+    for (int i = 0; i < n; ++i) {
+      if (!builder_results[i]->error_msg.defined() && !runner_results[i]->error_msg.defined() &&
+          runner_results[i]->run_secs.defined() && !runner_results[i]->run_secs.value().empty()) {
+        candidates.push_back(measure_candidates[i]);
+        latency_ms.push_back(GetRunMsMedian(runner_results[i]));
+      }
+    }
+    // Step 2. Check if the best latency improves
+    double batch_best_ms =
+        latency_ms.empty() ? 1e9 : *std::min_element(latency_ms.begin(), latency_ms.end());
+    if (batch_best_ms < state.best_ms * (1.0 - this->min_improvement)) {
+      state.best_ms = batch_best_ms;
+      state.trials_since_improvement = 0;
+    } else {
+      state.trials_since_improvement += n;
+    }
+    // Step 3. Check how well the cost model ranks the measured candidates. This callback has to
+    // run before `UpdateCostModel`, so that the model has not been trained on them yet.
+    if (this->max_prediction_error > 0 && task_scheduler->cost_model_.defined() &&
+        candidates.size() > 1) {
+      std::vector<double> scores =
+          task_scheduler->cost_model_.value()->Predict(task->ctx, candidates);
+      state.prediction_error = RankError(scores, latency_ms);
+    }
+    // Step 4. Stop the task if it converges or runs out of time
+    const char* reason = nullptr;
+    if (this->patience > 0 && state.best_ms < 1e9 &&
+        state.trials_since_improvement >= this->patience) {
+      if (this->max_prediction_error <= 0 ||
+          (state.prediction_error >= 0 && state.prediction_error <= this->max_prediction_error)) {
+        reason = "its best latency has plateaued";
+      }
+    }
+    if (reason == nullptr && this->max_seconds_per_task > 0) {
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                     state.start_time)
+                           .count();
+      if (elapsed >= this->max_seconds_per_task) {
+        reason = "it has run out of time";
+      }
+    }
+    if (reason != nullptr) {
+      TVM_PY_LOG(INFO, task_scheduler->logger)
+          << "Stopping Task #" << task_id << ": " << task->ctx->task_name << " early, as "
+          << reason << ". Best latency: " << state.best_ms * 1e3
+          << " us, trials since improvement: " << state.trials_since_improvement;
+      task_scheduler->TerminateTask(task_id);
+    }
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.StopOnConvergence";
+  TVM_DECLARE_FINAL_OBJECT_INFO(StopOnConvergenceNode, MeasureCallbackNode);
+};
+
+MeasureCallback MeasureCallback::StopOnConvergence(int patience, double min_improvement,
+                                                   double max_prediction_error,
+                                                   double max_seconds_per_task) {
+  CHECK_GE(min_improvement, 0.0) << "ValueError: `min_improvement` must be non-negative";
+  ObjectPtr<StopOnConvergenceNode> n = make_object<StopOnConvergenceNode>();
+  n->patience = patience;
+  n->min_improvement = min_improvement;
+  n->max_prediction_error = max_prediction_error;
+  n->max_seconds_per_task = max_seconds_per_task;
+  return MeasureCallback(n);
+}
+
+TVM_REGISTER_NODE_TYPE(StopOnConvergenceNode);
+TVM_REGISTER_GLOBAL("meta_schedule.MeasureCallbackStopOnConvergence")
+    .set_body_typed(MeasureCallback::StopOnConvergence);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -98,11 +98,14 @@ struct ParsedAnnotation {
   int unroll_implicit;
   int num_parallel_loops;
   int num_vectorize_loops;
+  int prefetch_distance;
+  int unroll_max_registers;
+  int unroll_max_code_size;
 };
 
 bool ParseAnnotation(const Block& block, ParsedAnnotation* parsed) {
   bool found = false;
-  *parsed = ParsedAnnotation{-1, -1, -1, -1, -1, -1};
+  *parsed = ParsedAnnotation{-1, -1, -1, -1, -1, -1, -1, -1, -1};
   for (const auto& ann : block->annotations) {
     if (ann.first == attr::meta_schedule_parallel) {
       found = true;
@@ -124,6 +127,21 @@ bool ParseAnnotation(const Block& block, ParsedAnnotation* parsed) {
       if (const auto* imm = ann.second.as<tir::IntImmNode>()) {
         parsed->unroll_implicit = imm->value;
       }
+    } else if (ann.first == attr::meta_schedule_prefetch_distance) {
+      found = true;
+      if (const auto* imm = ann.second.as<tir::IntImmNode>()) {
+        parsed->prefetch_distance = imm->value;
+      }
+    } else if (ann.first == attr::meta_schedule_unroll_max_registers) {
+      found = true;
+      if (const auto* imm = ann.second.as<tir::IntImmNode>()) {
+        parsed->unroll_max_registers = imm->value;
+      }
+    } else if (ann.first == attr::meta_schedule_unroll_max_code_size) {
+      found = true;
+      if (const auto* imm = ann.second.as<tir::IntImmNode>()) {
+        parsed->unroll_max_code_size = imm->value;
+      }
     }
   }
   return found;
@@ -142,6 +160,15 @@ void RemoveParsedAnn(const Schedule& sch, const BlockRV& block_rv, const ParsedA
   if (parsed.unroll_implicit != -1) {
     sch->Unannotate(block_rv, attr::meta_schedule_unroll_implicit);
   }
+  if (parsed.prefetch_distance != -1) {
+    sch->Unannotate(block_rv, attr::meta_schedule_prefetch_distance);
+  }
+  if (parsed.unroll_max_registers != -1) {
+    sch->Unannotate(block_rv, attr::meta_schedule_unroll_max_registers);
+  }
+  if (parsed.unroll_max_code_size != -1) {
+    sch->Unannotate(block_rv, attr::meta_schedule_unroll_max_code_size);
+  }
 }
 
 int CalculateNumRewritableLoops(const Array<StmtSRef>& loop_srefs,
@@ -389,8 +416,8 @@ void RewriteVectorize(const Schedule& sch, size_t n, Array<LoopRV>* loop_rvs) {
   }
 }
 
-void RewriteUnroll(const Schedule& sch, int unroll_explicit, int max_step, const BlockRV& block,
-                   const LoopRV& loop) {
+void RewriteUnroll(const Schedule& sch, int unroll_explicit, int max_step,
+                   const ParsedAnnotation& parsed, const BlockRV& block, const LoopRV& loop) {
   // Do not unroll for pure spatial block.
   if (max_step <= 0 || IsSpatial(sch->GetSRef(block))) {
     return;
@@ -398,6 +425,29 @@ void RewriteUnroll(const Schedule& sch, int unroll_explicit, int max_step, const
 
   sch->Annotate(loop, attr::pragma_auto_unroll_max_step, IntImm(DataType::Int(32), max_step));
   sch->Annotate(loop, attr::pragma_unroll_explicit, IntImm(DataType::Int(32), unroll_explicit));
+  if (parsed.unroll_max_registers > 0) {
+    sch->Annotate(loop, attr::pragma_auto_unroll_max_registers,
+                  IntImm(DataType::Int(32), parsed.unroll_max_registers));
+  }
+  if (parsed.unroll_max_code_size > 0) {
+    sch->Annotate(loop, attr::pragma_auto_unroll_max_code_size,
+                  IntImm(DataType::Int(32), parsed.unroll_max_code_size));
+  }
+}
+
+void RewritePrefetch(const Schedule& sch, int distance, const Array<LoopRV>& loop_rvs) {
+  if (distance <= 0) {
+    return;
+  }
+  // The prefetches go to the innermost serial loop, which LLVM codegen emits as a plain loop
+  for (auto it = loop_rvs.rbegin(); it != loop_rvs.rend(); ++it) {
+    const ForNode* loop = TVM_SREF_TO_FOR(sch->GetSRef(*it));
+    const int64_t* extent = GetLoopIntExtent(loop);
+    if (loop->kind == ForKind::kSerial && (extent == nullptr || *extent > 1)) {
+      sch->Annotate(*it, attr::llvm_loop_prefetch_distance, IntImm(DataType::Int(32), distance));
+      return;
+    }
+  }
 }
 
 }  // namespace tir
@@ -440,9 +490,14 @@ class RewriteParallelVectorizeUnrollNode : public PostprocNode {
           ICHECK(parsed.unroll_explicit == -1 || parsed.unroll_implicit == -1);
           int unroll_explicit = parsed.unroll_explicit != -1;
           int max_step = parsed.unroll_explicit + parsed.unroll_implicit + 1;
-          tir::RewriteUnroll(sch, unroll_explicit, max_step, block_rv, loop_rvs[0]);
+          tir::RewriteUnroll(sch, unroll_explicit, max_step, parsed, block_rv, loop_rvs[0]);
         }
       }
+      // Annotated loops are not parallelized or vectorized, so the prefetches are placed after
+      // all the blocks under the root are rewritten
+      for (tir::BlockRV block_rv : sch->GetChildBlocks(root_rv)) {
+        tir::RewritePrefetch(sch, parsed_root.prefetch_distance, sch->GetLoops(block_rv));
+      }
     }
     return true;
   }
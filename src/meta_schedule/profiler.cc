@@ -17,7 +17,10 @@
  * under the License.
  */
 #include <algorithm>
+#include <atomic>
+#include <map>
 
+#include "../support/str_escape.h"
 #include "./utils.h"
 
 namespace tvm {
@@ -67,25 +70,138 @@ String ProfilerNode::Table() const {
   return p.AsStr();
 }
 
+String ProfilerNode::ChromeTrace() const {
+  std::lock_guard<std::mutex> lock(this->events_mutex);
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& kv : this->thread_ids) {
+    os << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+       << kv.second << ",\"args\":{\"name\":\"Thread #" << kv.second << "\"}}";
+    first = false;
+  }
+  for (const Event& event : this->events) {
+    size_t pos = event.path.rfind(';');
+    std::string name = pos == std::string::npos ? event.path : event.path.substr(pos + 1);
+    os << (first ? "" : ",") << "{\"name\":\"" << support::StrEscape(name)
+       << "\",\"cat\":\"meta_schedule\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread_id
+       << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us << "}";
+    first = false;
+  }
+  os << "]}";
+  return os.str();
+}
+
+String ProfilerNode::FlameGraph() const {
+  std::lock_guard<std::mutex> lock(this->events_mutex);
+  // The exclusive time of each stack, sorted by the stack
+  std::map<std::string, double> self_us;
+  for (const Event& event : this->events) {
+    self_us[event.path] += event.duration_us;
+    size_t pos = event.path.rfind(';');
+    if (pos != std::string::npos) {
+      self_us[event.path.substr(0, pos)] -= event.duration_us;
+    }
+  }
+  std::ostringstream os;
+  for (const auto& kv : self_us) {
+    // The time of a scope enclosing a scope on another thread is not recorded
+    int64_t us = std::max<int64_t>(0, static_cast<int64_t>(kv.second));
+    if (us > 0) {
+      os << kv.first << ' ' << us << '\n';
+    }
+  }
+  return os.str();
+}
+
+void ProfilerNode::AddEvent(std::string path, std::chrono::high_resolution_clock::time_point tik,
+                            std::chrono::high_resolution_clock::time_point tok) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  Event event;
+  event.path = std::move(path);
+  event.start_us = duration_cast<nanoseconds>(tik - this->start_time).count() / 1e3;
+  event.duration_us = duration_cast<nanoseconds>(tok - tik).count() / 1e3;
+  std::lock_guard<std::mutex> lock(this->events_mutex);
+  auto it = this->thread_ids.find(std::this_thread::get_id());
+  if (it == this->thread_ids.end()) {
+    int thread_id = this->thread_ids.size();
+    it = this->thread_ids.emplace(std::this_thread::get_id(), thread_id).first;
+  }
+  event.thread_id = it->second;
+  this->events.push_back(std::move(event));
+}
+
 Profiler::Profiler() {
   ObjectPtr<ProfilerNode> n = make_object<ProfilerNode>();
   n->stats_sec.clear();
   n->total_timer = nullptr;
+  n->start_time = std::chrono::high_resolution_clock::now();
   data_ = n;
 }
 
+/*! \brief The names of the scopes being timed on the current thread, outermost first */
+std::vector<std::string>* ThreadLocalScopeStack() {
+  static thread_local std::vector<std::string> stack;
+  return &stack;
+}
+
+/*! \brief The profilers entered on any thread, to which the other threads report their scopes */
+struct GlobalProfilers {
+  /*! \brief The number of profilers entered, to skip the lock when there is none */
+  std::atomic<int> count{0};
+  /*! \brief The mutex guarding `profilers` */
+  std::mutex mutex;
+  /*! \brief The profilers entered, innermost last */
+  std::vector<Profiler> profilers;
+
+  static GlobalProfilers* Global() {
+    static GlobalProfilers* inst = new GlobalProfilers();
+    return inst;
+  }
+
+  Optional<Profiler> Current() {
+    if (this->count.load() == 0) {
+      return NullOpt;
+    }
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->profilers.empty()) {
+      return NullOpt;
+    }
+    return this->profilers.back();
+  }
+};
+
 PackedFunc ProfilerTimedScope(String name) {
-  if (Optional<Profiler> opt_profiler = Profiler::Current()) {
-    return TypedPackedFunc<void()>([profiler = opt_profiler.value(),                  //
-                                    tik = std::chrono::high_resolution_clock::now(),  //
-                                    name = std::move(name)]() {
-      auto tok = std::chrono::high_resolution_clock::now();
-      double duration =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(tok - tik).count() / 1e9;
-      profiler->stats_sec[name] += duration;
-    });
+  Optional<Profiler> opt_profiler = Profiler::Current();
+  // The scopes on the threads without their own profiler, e.g. the workers of a parallel loop,
+  // overlap with those of the thread that entered the profiler, so they are only on the timeline
+  bool timeline_only = false;
+  if (!opt_profiler.defined()) {
+    opt_profiler = GlobalProfilers::Global()->Current();
+    timeline_only = true;
+  }
+  if (!opt_profiler.defined()) {
+    return nullptr;
   }
-  return nullptr;
+  std::vector<std::string>* stack = ThreadLocalScopeStack();
+  int depth = stack->size();
+  std::string path = stack->empty() ? std::string(name) : stack->back() + ";" + name;
+  stack->push_back(path);
+  return TypedPackedFunc<void()>([profiler = opt_profiler.value(),                  //
+                                  tik = std::chrono::high_resolution_clock::now(),  //
+                                  name = std::move(name), path = std::move(path),   //
+                                  depth, timeline_only]() {
+    auto tok = std::chrono::high_resolution_clock::now();
+    double duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(tok - tik).count() / 1e9;
+    if (!timeline_only) {
+      profiler->stats_sec[name] += duration;
+    }
+    profiler->AddEvent(path, tik, tok);
+    ThreadLocalScopeStack()->resize(depth);
+  });
 }
 
 ScopedTimer Profiler::TimedScope(String name) { return ScopedTimer(ProfilerTimedScope(name)); }
@@ -99,11 +215,29 @@ std::vector<Profiler>* ThreadLocalProfilers() {
 
 void Profiler::EnterWithScope() {
   ThreadLocalProfilers()->push_back(*this);
+  {
+    GlobalProfilers* global = GlobalProfilers::Global();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->profilers.push_back(*this);
+    ++global->count;
+  }
+  (*this)->start_time = std::chrono::high_resolution_clock::now();
   (*this)->total_timer = ProfilerTimedScope("Total");
 }
 
 void Profiler::ExitWithScope() {
   ThreadLocalProfilers()->pop_back();
+  {
+    GlobalProfilers* global = GlobalProfilers::Global();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    for (auto it = global->profilers.rbegin(); it != global->profilers.rend(); ++it) {
+      if (it->same_as(*this)) {
+        global->profilers.erase(std::next(it).base());
+        --global->count;
+        break;
+      }
+    }
+  }
   if ((*this)->total_timer != nullptr) {
     (*this)->total_timer();
     (*this)->total_timer = nullptr;
@@ -130,6 +264,10 @@ TVM_REGISTER_GLOBAL("meta_schedule.ProfilerExitWithScope")
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerCurrent").set_body_typed(Profiler::Current);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerGet").set_body_method<Profiler>(&ProfilerNode::Get);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerTable").set_body_method<Profiler>(&ProfilerNode::Table);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerChromeTrace")
+    .set_body_method<Profiler>(&ProfilerNode::ChromeTrace);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerFlameGraph")
+    .set_body_method<Profiler>(&ProfilerNode::FlameGraph);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerTimedScope").set_body_typed(ProfilerTimedScope);
 
 }  // namespace meta_schedule
@@ -87,6 +87,10 @@ void MultiLevelTilingNode::InitializeWithTuneContext(const TuneContext& context)
       TVM_PY_LOG(INFO, context->logger) << "'thread_warp_size' is not defined in the target";
     }
   }
+  if (Optional<Integer> v =
+          context->target.value()->GetAttr<Integer>("max_shared_memory_per_block")) {
+    this->max_shared_memory_per_block_ = v.value()->value;
+  }
   if (Optional<String> opt_sm = context->target.value()->GetAttr<String>("arch")) {
     std::string sm = opt_sm.value();
     if (support::StartsWith(sm, "sm_")) {
@@ -309,19 +313,20 @@ std::vector<State> MultiLevelTilingNode::AddAsyncPipeline(State state) const {
   if (r_indices_.size() < 1 || this->stages.empty()) {
     return {state};
   }
-  // Current only support default config used by ScheduleRule::DefaultCUDA
+  // The default config used by ScheduleRule::DefaultCUDA gets explicit annotations
   // @see src/meta_schedule/schedule_rule/schedule_rule.cc
   // check the reduce loop contains exactly 3 for loops
   // therefore it matches the notation array size in the following code
   tir::StmtSRef r_loop_sref = state->sch->GetSRef(state->tiles[r_indices_[0]].back());
   const tir::ForNode* r_for_loop = TVM_SREF_TO_FOR(r_loop_sref);
-  Array<tir::Stmt> seq = Downcast<tir::SeqStmt>(r_for_loop->body)->seq;
-  if (seq.size() != 3) {
+  const auto* seq = r_for_loop->body.as<tir::SeqStmtNode>();
+  if (seq == nullptr) {
     return {state};
   }
-  for (auto& stmt : seq) {
-    if (!stmt.as<tir::ForNode>()) {
-      return {state};
+  bool is_default_config = seq->size() == 3;
+  for (const tir::Stmt& stmt : seq->seq) {
+    if (!stmt->IsInstance<tir::ForNode>()) {
+      is_default_config = false;
     }
   }
 
@@ -330,10 +335,21 @@ std::vector<State> MultiLevelTilingNode::AddAsyncPipeline(State state) const {
   for (int stage : this->stages) {
     State new_state = state->Copy();
     LoopRV r_loop_fused = new_state->sch->Fuse(new_state->tiles[r_indices_[0]]);
-    new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_stage,
-                             Array<Integer>{0, 0, stage - 2});
-    new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_order,
-                             Array<Integer>{0, 1, 2});
+    if (is_default_config) {
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_stage,
+                               Array<Integer>{0, 0, stage - 2});
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_order,
+                               Array<Integer>{0, 1, 2});
+    } else {
+      // Other loop bodies are pipelined with the stages picked by InjectSoftwarePipeline,
+      // within the shared memory of the target.
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_max_stages,
+                               Integer(stage - 1));
+      if (this->max_shared_memory_per_block_ != -1) {
+        new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_shared_memory_bytes,
+                                 Integer(this->max_shared_memory_per_block_));
+      }
+    }
     new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_async_stages,
                              Array<Integer>{0});
     ret.push_back(std::move(new_state));
@@ -198,6 +198,8 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
   int thread_warp_size_;
   /*! \brief The maximum number of threads to be used size of a thread warp */
   int max_threads_per_block_;
+  /*! \brief The maximum shared memory per block in bytes, -1 if not defined by the target */
+  int64_t max_shared_memory_per_block_;
   /*! \brief All available async pipeline stages. */
   std::vector<int> stages;
   /*! \brief The logging function */
@@ -216,6 +218,7 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
     // `r_indices_` is not visited
     // `thread_warp_size_` is not visited
     // `max_threads_per_block` is not visited
+    // `max_shared_memory_per_block_` is not visited
   }
 
   static constexpr const char* _type_key = "meta_schedule.MultiLevelTiling";
@@ -249,6 +252,7 @@ ObjectPtr<NodeType> MultiLevelTilingInitCommon(String structure, Optional<Array<
   }
   n->thread_warp_size_ = -1;
   n->max_threads_per_block_ = -1;
+  n->max_shared_memory_per_block_ = -1;
   return n;
 }
 
@@ -17,6 +17,7 @@
  * under the License.
  */
 #include <tvm/meta_schedule/schedule_rule.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/op.h>
 
 #include <algorithm>
@@ -125,6 +126,9 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
  private:
   // SubRule: Add tensorization-related transformations
   inline std::vector<State> TransformForTensorization(TensorCoreState state) const;
+  // Subrule: Decompose the padding of the input reindex stages, which are padded when the
+  // workload does not divide the tensor intrin
+  inline std::vector<State> DecomposeReindexPadding(TensorCoreState state) const;
   // Subrule: Transform the layout of the output. This is necessary for efficient cache write the
   // output in the shared memory.
   std::vector<State> TransformIntermediateOutputLayout(TensorCoreState state);
@@ -157,6 +161,17 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
   Optional<LoopRV> TransformWithTensorIntrin(TensorCoreStateNode* state,
                                              const String& intrin_name) const;
 
+  /*!
+   * \brief Partition the outermost reduction loop into `split_k` independent parts with rfactor,
+   * which become an extra spatial dimension of the tensorized block, and leave the sum of the
+   * partial results to a separate reduction epilogue.
+   * \param sch The schedule
+   * \param block_rv The block to be tensorized
+   * \param split_k The number of the parts of the reduction
+   * \return The initial states tensorizing the rfactor block, empty if the split is not possible.
+   */
+  std::vector<State> SplitK(const Schedule& sch, const BlockRV& block_rv, int64_t split_k) const;
+
   /*!
    * \brief Tile, blockize and annotate for tensorization with the given intrin
    * \param block_rv The block to be tensorized
@@ -170,6 +185,8 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
   std::vector<TensorCoreIntrinGroup> intrin_groups;
   /*! \brief Whether to use software pipeline */
   bool use_software_pipeline = false;
+  /*! \brief The candidate numbers of parts to split the reduction into, for skinny workloads */
+  std::vector<int64_t> split_k_factors;
   static constexpr const char* _type_key = "meta_schedule.MultiLevelTilingTensorCore";
   TVM_DECLARE_FINAL_OBJECT_INFO(MultiLevelTilingTensorCoreNode, MultiLevelTilingNode);
 
@@ -211,6 +228,10 @@ Array<Schedule> MultiLevelTilingTensorCoreNode::Apply(const Schedule& sch,
     new_sch->Annotate(block_rv, tir::attr::meta_schedule_tiling_structure, structure);
     initial_states.push_back(TensorCoreState(intrin_group, mapping_info, new_sch, block_rv));
   }
+  for (int64_t split_k : split_k_factors) {
+    std::vector<State> split_k_states = SplitK(sch, block_rv, split_k);
+    initial_states.insert(initial_states.end(), split_k_states.begin(), split_k_states.end());
+  }
   Array<Schedule> results;
   for (auto&& state : ApplySubRules(initial_states)) {
     TVM_PY_LOG(INFO, logger) << "Sketch " << results.size() << ": tensorizing with "
@@ -224,10 +245,55 @@ Array<Schedule> MultiLevelTilingTensorCoreNode::Apply(const Schedule& sch,
   return results;
 }
 
+std::vector<State> MultiLevelTilingTensorCoreNode::SplitK(const Schedule& sch,
+                                                          const BlockRV& block_rv,
+                                                          int64_t split_k) const {
+  Schedule new_sch = sch->Copy();
+  Optional<LoopRV> reduction_loop = NullOpt;
+  for (const LoopRV& loop_rv : new_sch->GetLoops(block_rv)) {
+    if (tir::GetLoopIterType(new_sch->GetSRef(loop_rv)) == tir::IterVarType::kCommReduce) {
+      reduction_loop = loop_rv;
+      break;
+    }
+  }
+  if (!reduction_loop.defined()) {
+    return {};
+  }
+  const int64_t* extent = tir::GetLoopIntExtent(new_sch->GetSRef(reduction_loop.value()));
+  if (extent == nullptr || *extent % split_k != 0) {
+    return {};
+  }
+  BlockRV rf_block_rv{nullptr};
+  try {
+    Array<LoopRV> split = new_sch->Split(reduction_loop.value(), {Integer(split_k), NullOpt});
+    // The partial results are indexed by the part in the leading dimension, which the tensor
+    // intrin treats like a batch dimension
+    rf_block_rv = new_sch->RFactor(split[0], /*factor_axis=*/0);
+  } catch (const tvm::runtime::Error& e) {
+    return {};
+  }
+  std::vector<State> states;
+  for (const TensorCoreIntrinGroup& intrin_group : intrin_groups) {
+    Optional<tir::AutoTensorizeMappingInfo> mapping_info = tir::GetAutoTensorizeMappingInfo(
+        new_sch->state(), new_sch->GetSRef(rf_block_rv),
+        tir::TensorIntrin::Get(intrin_group.compute_intrin).value()->desc);
+    if (!mapping_info.defined()) {
+      continue;
+    }
+    Schedule state_sch = new_sch->Copy();
+    state_sch->Annotate(rf_block_rv, tir::attr::meta_schedule_tiling_structure, structure);
+    states.push_back(TensorCoreState(intrin_group, mapping_info.value(), state_sch, rf_block_rv));
+  }
+  return states;
+}
+
 std::vector<State> MultiLevelTilingTensorCoreNode::ApplySubRules(std::vector<State> states) {
   states = SubRule(std::move(states), [&](State state) {
     return TransformForTensorization(Downcast<TensorCoreState>(state));
   });
+  states = SubRule(std::move(states), [&](State state) {
+    return DecomposeReindexPadding(Downcast<TensorCoreState>(state));
+  });
   states = SubRule(std::move(states), [&](State state) { return TileLoopNest(state); });
   states = SubRule(std::move(states), [&](State state) {
     return TransformIntermediateOutputLayout(Downcast<TensorCoreState>(state));
@@ -246,6 +312,43 @@ std::vector<State> MultiLevelTilingTensorCoreNode::ApplySubRules(std::vector<Sta
   return states;
 }
 
+inline std::vector<State> MultiLevelTilingTensorCoreNode::DecomposeReindexPadding(
+    TensorCoreState state) const {
+  // PadEinsum pads the reindex stage of an input by guarding its value with `if_then_else`. By
+  // default the stage is inlined into the shared memory fetch, which then evaluates the guard on
+  // every element it loads. Alternatively, the padded input is materialized once by a stage
+  // filling the pad values and a stage copying the in-bound values, both free of branches, so that
+  // the fetch is a plain copy.
+  auto f_is_padded = [&state](const BlockRV& block_rv) -> bool {
+    const auto* store = state->sch->Get(block_rv)->body.as<tir::BufferStoreNode>();
+    if (store == nullptr) {
+      return false;
+    }
+    const auto* call = store->value.as<tir::CallNode>();
+    return call != nullptr && call->op.same_as(tir::builtin::if_then_else());
+  };
+  std::vector<BlockRV> padded_blocks;
+  for (const BlockRV& block_rv : {state->tensor_core_reindex_A, state->tensor_core_reindex_B}) {
+    if (f_is_padded(block_rv)) {
+      padded_blocks.push_back(block_rv);
+    }
+  }
+  if (padded_blocks.empty()) {
+    return {state};
+  }
+  TensorCoreState new_state = Downcast<TensorCoreState>(state->Copy());
+  try {
+    for (const BlockRV& block_rv : padded_blocks) {
+      Array<LoopRV> loops = new_state->sch->GetLoops(block_rv);
+      ICHECK(!loops.empty());
+      new_state->sch->DecomposePadding(block_rv, loops[0]);
+    }
+  } catch (const tvm::runtime::Error& e) {
+    return {state};
+  }
+  return {state, new_state};
+}
+
 void MultiLevelTilingTensorCoreNode::TileAndAnnotateTensorize(Schedule* sch,
                                                               const BlockRV& block_rv,
                                                               const String& intrin_name) const {
@@ -705,7 +808,7 @@ ScheduleRule ScheduleRule::MultiLevelTilingTensorCore(
     Array<Map<String, String>> intrin_groups, String structure, Optional<Array<String>> tile_binds,
     Optional<Integer> max_innermost_factor, Optional<Array<Integer>> vector_load_lens,
     Optional<Map<String, ObjectRef>> reuse_read, Optional<Map<String, ObjectRef>> reuse_write,
-    bool use_software_pipeline) {
+    bool use_software_pipeline, Optional<Array<Integer>> split_k_factors) {
   if (tile_binds.defined()) {
     for (const String& tile_bind : tile_binds.value()) {
       CHECK_NE(tile_bind, "threadIdx.x") << "Cannot bind to threadIdx.x when using tensor core.";
@@ -724,6 +827,13 @@ ScheduleRule ScheduleRule::MultiLevelTilingTensorCore(
     node->intrin_groups.emplace_back(TensorCoreIntrinGroup::FromConfig(intrin_group_config));
   }
   node->use_software_pipeline = use_software_pipeline;
+  if (split_k_factors.defined()) {
+    for (const Integer& split_k : split_k_factors.value()) {
+      CHECK_GT(split_k->value, 1)
+          << "ValueError: The split-K factors should be greater than 1, but gets: " << split_k;
+      node->split_k_factors.push_back(split_k->value);
+    }
+  }
   return ScheduleRule(node);
 }
 
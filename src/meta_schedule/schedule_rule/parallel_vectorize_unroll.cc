@@ -75,6 +75,14 @@ class ParallelizeVectorizeUnrollNode : public ScheduleRuleNode {
       } else {
         sch->Annotate(root_rv, tir::attr::meta_schedule_unroll_implicit, max_step);
       }
+      if (unroll_max_registers != -1) {
+        sch->Annotate(root_rv, tir::attr::meta_schedule_unroll_max_registers,
+                      Integer(unroll_max_registers));
+      }
+      if (unroll_max_code_size != -1) {
+        sch->Annotate(root_rv, tir::attr::meta_schedule_unroll_max_code_size,
+                      Integer(unroll_max_code_size));
+      }
     }
     return {sch};
   }
@@ -105,6 +113,10 @@ class ParallelizeVectorizeUnrollNode : public ScheduleRuleNode {
   Array<Integer> unroll_max_steps;
   /*! \brief Whether to explicitly unroll the loop, or just add an "unroll" pragma. */
   bool unroll_explicit;
+  /*! \brief The maximum estimated number of registers of an unrolled loop, -1 for no limit. */
+  int unroll_max_registers;
+  /*! \brief The maximum estimated number of instructions of an unrolled loop, -1 for no limit. */
+  int unroll_max_code_size;
   /*! \brief The number of maximum available jobs in CPU. */
   int64_t max_parallel_extent_;
 
@@ -113,6 +125,8 @@ class ParallelizeVectorizeUnrollNode : public ScheduleRuleNode {
     v->Visit("max_vectorize_extent", &max_vectorize_extent);
     v->Visit("unroll_max_steps", &unroll_max_steps);
     v->Visit("unroll_explicit", &unroll_explicit);
+    v->Visit("unroll_max_registers", &unroll_max_registers);
+    v->Visit("unroll_max_code_size", &unroll_max_code_size);
     // `max_parallel_extent_` is not visited
   }
 
@@ -123,12 +137,16 @@ class ParallelizeVectorizeUnrollNode : public ScheduleRuleNode {
 ScheduleRule ScheduleRule::ParallelizeVectorizeUnroll(int max_jobs_per_core,
                                                       int max_vectorize_extent,
                                                       Array<Integer> unroll_max_steps,
-                                                      bool unroll_explicit) {
+                                                      bool unroll_explicit,
+                                                      int unroll_max_registers,
+                                                      int unroll_max_code_size) {
   ObjectPtr<ParallelizeVectorizeUnrollNode> n = make_object<ParallelizeVectorizeUnrollNode>();
   n->max_jobs_per_core = max_jobs_per_core;
   n->max_vectorize_extent = max_vectorize_extent;
   n->unroll_max_steps = unroll_max_steps;
   n->unroll_explicit = unroll_explicit;
+  n->unroll_max_registers = unroll_max_registers;
+  n->unroll_max_code_size = unroll_max_code_size;
   n->max_parallel_extent_ = -1;
   return ScheduleRule(n);
 }
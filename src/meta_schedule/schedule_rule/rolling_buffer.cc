@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+class RollingBufferNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  Array<tir::Schedule> Apply(const tir::Schedule& sch, const tir::BlockRV& block_rv) final {
+    if (!CheckConditions(sch, block_rv)) {
+      return {sch};
+    }
+    tir::BlockRV consumer_rv = sch->GetConsumers(block_rv)[0];
+    Array<tir::LoopRV> loop_rvs = sch->GetLoops(consumer_rv);
+    // Try the spatial loops of the consumer from the outermost one. The first loop whose
+    // iterations access overlapping regions of the buffer gives the line buffer.
+    for (const tir::LoopRV& loop_rv : loop_rvs) {
+      if (tir::GetLoopIterType(sch->GetSRef(loop_rv)) != tir::IterVarType::kDataPar) {
+        break;
+      }
+      tir::Schedule sch_tmp = sch->Copy();
+      sch_tmp->Seed(sch->ForkSeed());
+      try {
+        sch_tmp->ComputeAt(block_rv, loop_rv, /*preserve_unit_loops=*/true);
+        sch_tmp->RollingBuffer(block_rv, /*write_buffer_index=*/0);
+      } catch (const tvm::runtime::Error& e) {
+        continue;
+      }
+      // All the iterations around the rolling buffer share it, so they have to stay serial
+      sch_tmp->Annotate(loop_rvs[0], tir::attr::meta_schedule_rolling_buffer, Integer(1));
+      return {sch_tmp, sch};
+    }
+    return {sch};
+  }
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<RollingBufferNode> n = make_object<RollingBufferNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ private:
+  bool CheckConditions(const tir::Schedule sch, const tir::BlockRV& block_rv) const {
+    tir::StmtSRef block_sref = sch->GetSRef(block_rv);
+    const tir::BlockNode* block = TVM_SREF_TO_BLOCK(block_sref);
+
+    // Cond 1. The block is not the root block.
+    if (block_sref->parent == nullptr) {
+      return false;
+    }
+    // Cond 2. The block should be the direct child block of the root block.
+    tir::StmtSRef scope_sref = GetScopeRoot(sch->state(), block_sref,
+                                            /*require_stage_pipeline=*/false);
+    if (scope_sref->parent != nullptr) {
+      return false;
+    }
+    // Cond 3. The block writes a single buffer, which is allocated by the root block.
+    if (block->writes.size() != 1) {
+      return false;
+    }
+    const tir::BlockNode* scope_block = TVM_SREF_TO_BLOCK(scope_sref);
+    const tir::Buffer& buffer = block->writes[0]->buffer;
+    if (std::none_of(scope_block->alloc_buffers.begin(), scope_block->alloc_buffers.end(),
+                     [&buffer](const tir::Buffer& alloc) { return alloc.same_as(buffer); })) {
+      return false;
+    }
+    // Cond 4 & 5. The block has at least one outer loop, and the outermost loop has only one
+    // child block, i.e. the block has not been computed at another location.
+    Array<tir::StmtSRef> loop_srefs = tir::GetLoops(block_sref);
+    if (loop_srefs.empty()) {
+      return false;
+    }
+    if (tir::GetChildBlockSRefOnSRefTree(sch->state(), loop_srefs[0]).size() > 1) {
+      return false;
+    }
+    // Cond 6. The block has exactly one consumer.
+    if (tir::GetConsumers(sch->state(), block_sref).size() != 1) {
+      return false;
+    }
+    return true;
+  }
+
+ public:
+  void VisitAttrs(tvm::AttrVisitor* v) {}
+
+  static constexpr const char* _type_key = "meta_schedule.RollingBuffer";
+  TVM_DECLARE_FINAL_OBJECT_INFO(RollingBufferNode, ScheduleRuleNode);
+};
+
+ScheduleRule ScheduleRule::RollingBuffer() {
+  return ScheduleRule(make_object<RollingBufferNode>());
+}
+
+TVM_REGISTER_NODE_TYPE(RollingBufferNode);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleRollingBuffer")
+    .set_body_typed(ScheduleRule::RollingBuffer);
+}  // namespace meta_schedule
+}  // namespace tvm
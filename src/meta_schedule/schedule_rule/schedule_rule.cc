@@ -86,11 +86,27 @@ Array<ScheduleRule> ScheduleRule::DefaultLLVM() {
 }
 
 Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
-  static const Map<String, String> intrins = {{"vnni", "dot_16x4_vnni"},
-                                              {"avx512", "dot_16x4_avx512"}};
-  return {
-      ScheduleRule::ApplyCustomRule(),
-      ScheduleRule::InlineConstantScalars(),
+  // CPUs with AVX512-BF16 also have VNNI, so both int8 and bf16 workloads are tensorized
+  static const Map<String, Array<String>> intrins = {
+      {"vnni", {"dot_16x4_vnni"}},
+      {"avx512", {"dot_16x4_avx512"}},
+      {"avx512bf16", {"dot_16x4_vnni", "dot_16x2_avx512bf16"}}};
+  Array<ScheduleRule> intrin_rules;
+  for (const String& intrin_name : intrins.at(type)) {
+    intrin_rules.push_back(ScheduleRule::MultiLevelTilingWithIntrin(
+        /*intrin_name=*/intrin_name,
+        /*structure=*/"SSRSRS",
+        /*tile_binds=*/NullOpt,
+        /*max_innermost_factor=*/Integer(64),
+        /*vector_load_lens=*/NullOpt,
+        /*reuse_read=*/NullOpt,
+        /*reuse_write=*/
+        Map<String, ObjectRef>{{"req", String("may")},
+                               {"levels", Array<Integer>{1, 2}},
+                               {"scope", String("global")}}));
+  }
+  return Array<ScheduleRule>::Agregate(
+      ScheduleRule::ApplyCustomRule(), ScheduleRule::InlineConstantScalars(),
       ScheduleRule::AutoInline(
           /*into_producer=*/false,
           /*into_consumer=*/true,
@@ -102,17 +118,7 @@ Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
       ScheduleRule::AddRFactor(
           /*max_jobs_per_core=*/16,
           /*max_innermost_factor=*/Integer(64)),
-      ScheduleRule::MultiLevelTilingWithIntrin(
-          /*intrin_name=*/intrins[type],
-          /*structure=*/"SSRSRS",
-          /*tile_binds=*/NullOpt,
-          /*max_innermost_factor=*/Integer(64),
-          /*vector_load_lens=*/NullOpt,
-          /*reuse_read=*/NullOpt,
-          /*reuse_write=*/
-          Map<String, ObjectRef>{{"req", String("may")},
-                                 {"levels", Array<Integer>{1, 2}},
-                                 {"scope", String("global")}}),
+      intrin_rules,
       ScheduleRule::MultiLevelTiling(
           /*structure=*/"SSRSRS",
           /*tile_binds=*/NullOpt,
@@ -128,8 +134,7 @@ Array<ScheduleRule> ScheduleRule::DefaultX86(const String& type) {
           /*max_vectorize_extent=*/64,
           /*unroll_max_steps=*/Array<Integer>{0, 16, 64, 512},
           /*unroll_explicit=*/true),
-      ScheduleRule::RandomComputeLocation(),
-  };
+      ScheduleRule::RandomComputeLocation());
 }
 
 Array<ScheduleRule> ScheduleRule::DefaultCUDA() {
@@ -234,7 +239,67 @@ Array<ScheduleRule> ScheduleRule::DefaultCUDATensorCore() {
           Map<String, ObjectRef>{{"req", String("must")},
                                  {"levels", Array<Integer>{2}},  //
                                  {"scope", String("shared.dyn")}},
-          /*use_software_pipeline=*/false)  //
+          /*use_software_pipeline=*/false,
+          /*split_k_factors=*/NullOpt)  //
+  };
+  Array<ScheduleRule> append = ScheduleRule::DefaultCUDA();
+  results.insert(results.end(), append.begin() + 1, append.end());
+  return results;
+}
+
+Array<ScheduleRule> ScheduleRule::DefaultVulkanTensorCore() {
+  // The WMMA intrinsics lower to the cooperative matrix instructions of SPIR-V. Those are issued
+  // from static shared memory, as SPIR-V has no dynamic shared memory.
+  Array<Map<String, String>> intrin_groups = {
+      // f32 += f16 * f16
+      {
+          {"init", "wmma_fill_16x16x16_f32"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f32"},
+          {"store", "wmma_store_16x16x16_f32_shared"},
+      },
+      {
+          {"init", "wmma_fill_16x16x16_f32"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_trans_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f32_trans"},
+          {"store", "wmma_store_16x16x16_f32_shared"},
+      },
+      // f16 += f16 * f16
+      {
+          {"init", "wmma_fill_16x16x16_f16"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f16"},
+          {"store", "wmma_store_16x16x16_f16_shared"},
+      },
+      {
+          {"init", "wmma_fill_16x16x16_f16"},
+          {"load_a", "wmma_load_16x16x16_f16_a_shared"},
+          {"load_b", "wmma_load_16x16x16_f16_b_trans_shared"},
+          {"compute", "wmma_sync_16x16x16_f16f16f16_trans"},
+          {"store", "wmma_store_16x16x16_f16_shared"},
+      },
+  };
+  Array<ScheduleRule> results{
+      ScheduleRule::ApplyCustomRule(),
+      ScheduleRule::MultiLevelTilingTensorCore(
+          /*intrin_groups=*/intrin_groups,
+          /*structure=*/"SSSRRSRS",
+          /*tile_binds=*/Array<String>{"blockIdx.y", "blockIdx.x", "threadIdx.y"},
+          /*max_innermost_factor=*/Integer(4),
+          /*vector_load_lens=*/Array<Integer>{1, 2, 3, 4, 8, 16},
+          /*reuse_read=*/
+          Map<String, ObjectRef>{{"req", String("must")},
+                                 {"levels", Array<Integer>{4}},  //
+                                 {"scope", String("shared")}},
+          /*reuse_write=*/
+          Map<String, ObjectRef>{{"req", String("must")},
+                                 {"levels", Array<Integer>{2}},  //
+                                 {"scope", String("shared")}},
+          /*use_software_pipeline=*/false,
+          /*split_k_factors=*/NullOpt)  //
   };
   Array<ScheduleRule> append = ScheduleRule::DefaultCUDA();
   results.insert(results.end(), append.begin() + 1, append.end());
@@ -409,6 +474,8 @@ TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultCUDA")
     .set_body_typed(ScheduleRule::DefaultCUDA);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultCUDATensorCore")
     .set_body_typed(ScheduleRule::DefaultCUDATensorCore);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultVulkanTensorCore")
+    .set_body_typed(ScheduleRule::DefaultVulkanTensorCore);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultHexagon")
     .set_body_typed(ScheduleRule::DefaultHexagon);
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleDefaultMicro")
@@ -17,8 +17,11 @@
  * under the License.
  */
 
+#include <tvm/driver/driver_api.h>
+
 #include "../module_equality.h"
 #include "../utils.h"
+#include "../workload_similarity.h"
 
 #define TVM_META_SCHEDULE_CHECK_PROB_RANGE(p, name)                               \
   CHECK(0.0 <= (p) && (p) <= 1.0) << "ValueError: name should be within [0, 1], " \
@@ -267,12 +270,21 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * TODO(junrushao1994): add records from the database to avoid re-measuring.
      * */
     IRModuleSet measured_workloads_;
+    /*! \brief The structural equality of the lowered workloads. */
+    std::unique_ptr<ModuleEquality> lowered_equality_;
+    /*!
+     * \brief The lowered forms of the workloads that are already measured, used to skip the
+     *  candidates which lower to the same code when `dedup_lowered_ir` is enabled.
+     */
+    IRModuleSet lowered_workloads_;
     /*! \brief A Database for selecting useful candidates. */
     Database database_{nullptr};
     /*! \brief A cost model helping to explore the search space */
     CostModel cost_model_{nullptr};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{nullptr};
+    /*! \brief The workloads in database most similar to the given one, nearest first. */
+    std::vector<Workload> transfer_workloads_;
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    Array<Schedule> design_space_schedules, Database database, CostModel cost_model)
@@ -282,7 +294,9 @@ class EvolutionarySearchNode : public SearchStrategyNode {
           st(0),
           ed(num_trials_per_iter),
           num_empty_iters(0),
-          measured_workloads_(database->GetModuleEquality()) {
+          measured_workloads_(database->GetModuleEquality()),
+          lowered_equality_(ModuleEquality::Create("structural")),
+          lowered_workloads_(*lowered_equality_) {
       design_spaces.reserve(design_space_schedules.size());
       for (const Schedule& space : design_space_schedules) {
         design_spaces.push_back(space->trace().value()->Simplified(true));
@@ -297,10 +311,18 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       this->database_ = database;
       this->cost_model_ = cost_model;
       this->token_ = database->CommitWorkload(mod);
+      if (self->num_transfer_workloads > 0) {
+        auto _ = Profiler::TimedScope("EvoSearch/FindTransferWorkloads");
+        this->transfer_workloads_ = WorkloadSimilarityIndex(database).FindNearest(
+            mod, self->num_transfer_workloads, database->GetModuleEquality());
+        TVM_PY_LOG(INFO, ctx->logger) << "Found " << this->transfer_workloads_.size()
+                                      << " similar workload(s) in database to transfer from";
+      }
     }
 
     /*!
-     * \brief Pick up best candidates from database.
+     * \brief Pick up best candidates from database. If the given workload does not have enough
+     *  records, the best traces of the similar workloads are replayed to fill up the rest.
      * \param num The number of traces to produce.
      * \return The picked best candidates.
      */
@@ -319,6 +341,17 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * \return The evolved traces from initial population.
      */
     inline std::vector<Schedule> EvolveWithCostModel(std::vector<Schedule> population, int num);
+    /*!
+     * \brief Predict the normalized scores of a population, reusing the scores of the candidates
+     *  carried over unchanged from the previous population.
+     * \param population The population to score.
+     * \param prev_population The previous population.
+     * \param prev_scores The scores of the previous population.
+     * \return The normalized scores of the population.
+     */
+    inline std::vector<double> PredictWithReuse(const std::vector<Schedule>& population,
+                                                const std::vector<Schedule>& prev_population,
+                                                const std::vector<double>& prev_scores);
     /*!
      * \brief Pick final candidates from the given initial population and bests of evolved ones.
      * \param inits The initial population of traces sampled.
@@ -333,6 +366,13 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     /*! \brief An interface method to be called by it's counterpart in EvolutionarySearchNode */
     inline void NotifyRunnerResults(const Array<MeasureCandidate>& measure_candidates,
                                     const Array<RunnerResult>& results);
+    /*!
+     * \brief Check if a candidate lowers to the same code as a candidate already picked for
+     *  measurement, and record its lowered form otherwise.
+     * \param mod The scheduled module of the candidate.
+     * \return Whether the candidate is equivalent to one already picked.
+     */
+    inline bool IsLoweredDuplicate(const IRModule& mod);
     /*!
      * \brief Compute the hash for the given module.
      * \param mod The input TIR module.
@@ -363,6 +403,11 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   /*** Configuration: the initial population ***/
   /*! \brief The ratio of measured states used in the initial population */
   double init_measured_ratio;
+  /*!
+   * \brief The number of similar workloads in the database whose best traces fill up the measured
+   * states of the initial population, when the given workload does not have enough records.
+   */
+  int num_transfer_workloads;
   /*! \brief The minimal size of unmeasured population in the initial sampling.*/
   int init_min_unmeasured;
   /*! \brief The maximum number of failure during initial sampling. */
@@ -377,6 +422,11 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   /*** Configuration: pick states for measurement ***/
   /*! \brief The ratio of measurements to use randomly sampled states. */
   double eps_greedy;
+  /*!
+   * \brief Whether to skip the candidates whose lowered TIR is the same as the one of a candidate
+   * already measured, e.g. those differing only in a split by 1.
+   */
+  bool dedup_lowered_ir;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     // `context_` is not visited
@@ -388,6 +438,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     v->Visit("num_empty_iters_before_early_stop", &num_empty_iters_before_early_stop);
     /*** Configuration: the initial population ***/
     v->Visit("init_measured_ratio", &init_measured_ratio);
+    v->Visit("num_transfer_workloads", &num_transfer_workloads);
     v->Visit("init_min_unmeasured", &init_min_unmeasured);
     v->Visit("max_fail_count", &max_fail_count);
     /*** Configuration: evolution ***/
@@ -396,6 +447,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     v->Visit("genetic_max_fail_count", &genetic_max_fail_count);
     /*** Configuration: pick states for measurement ***/
     v->Visit("eps_greedy", &eps_greedy);
+    v->Visit("dedup_lowered_ir", &dedup_lowered_ir);
   }
 
   static constexpr const char* _type_key = "meta_schedule.EvolutionarySearch";
@@ -458,12 +510,14 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     n->population_size = this->population_size;
     n->num_empty_iters_before_early_stop = this->num_empty_iters_before_early_stop;
     n->init_measured_ratio = this->init_measured_ratio;
+    n->num_transfer_workloads = this->num_transfer_workloads;
     n->init_min_unmeasured = this->init_min_unmeasured;
     n->max_fail_count = this->max_fail_count;
     n->genetic_num_iters = this->genetic_num_iters;
     n->genetic_mutate_prob = this->genetic_mutate_prob;
     n->genetic_max_fail_count = this->genetic_max_fail_count;
     n->eps_greedy = this->eps_greedy;
+    n->dedup_lowered_ir = this->dedup_lowered_ir;
     n->ctx_ = this->ctx_;
     n->rand_state_ = this->rand_state_;
     n->state_ = nullptr;  // cleared the state
@@ -479,18 +533,36 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   for (TuningRecord record : top_records) {
     measured_traces.push_back(record->trace);
   }
+  // The traces of the workload itself always apply, while those of similar workloads may not
+  int num_exact = measured_traces.size();
+  for (const Workload& workload : this->transfer_workloads_) {
+    if (static_cast<int>(measured_traces.size()) >= num) {
+      break;
+    }
+    for (TuningRecord record : this->database_->GetTopK(workload, num - measured_traces.size())) {
+      measured_traces.push_back(record->trace);
+    }
+  }
   int actual_num = measured_traces.size();
   ThreadedTraceApply pp(self->postprocs_);
   std::vector<Schedule> results(actual_num, Schedule{nullptr});
-  auto f_proc_measured = [this, &measured_traces, &results, &pp](int thread_id,
-                                                                 int trace_id) -> void {
+  auto f_proc_measured = [this, &measured_traces, &results, &pp, num_exact](int thread_id,
+                                                                            int trace_id) -> void {
     PerThreadData& data = this->per_thread_data_.at(thread_id);
     TRandState* rand_state = &data.rand_state;
     const IRModule& mod = data.mod;
     tir::Trace trace = measured_traces.at(trace_id);
     Schedule& result = results.at(trace_id);
     ICHECK(!result.defined());
-    if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
+    if (trace_id >= num_exact) {
+      try {
+        if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
+          result = sch.value();
+        }
+      } catch (const std::exception&) {
+        // The trace does not fit the workload, e.g. it refers to a block that does not exist
+      }
+    } else if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
       result = sch.value();
     } else {
       LOG(FATAL) << "ValueError: Cannot postprocess the trace:\n" << trace;
@@ -498,6 +570,18 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     }
   };
   support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_measured);
+  if (actual_num > num_exact) {
+    int num_transferred = 0;
+    for (int i = num_exact; i < actual_num; ++i) {
+      if (results[i].defined()) {
+        results[num_exact + num_transferred++] = results[i];
+      }
+    }
+    results.resize(num_exact + num_transferred);
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Transferred " << num_transferred << " out of " << (actual_num - num_exact)
+        << " candidate(s) from similar workloads";
+  }
   return results;
 }
 
@@ -536,6 +620,49 @@ std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int nu
   return out_schs;
 }
 
+std::vector<double> EvolutionarySearchNode::State::PredictWithReuse(
+    const std::vector<Schedule>& population, const std::vector<Schedule>& prev_population,
+    const std::vector<double>& prev_scores) {
+  ICHECK_EQ(prev_population.size(), prev_scores.size());
+  std::unordered_map<const ScheduleNode*, double> known;
+  known.reserve(prev_population.size());
+  for (int i = 0, n = prev_population.size(); i < n; ++i) {
+    known.emplace(prev_population[i].get(), prev_scores[i]);
+  }
+  int n = population.size();
+  std::vector<double> scores(n, 0.0);
+  std::vector<Schedule> unscored;
+  // A candidate may be sampled several times, and it is scored only once
+  std::unordered_map<const ScheduleNode*, int> batch_index;
+  std::vector<int> index_in_batch(n, -1);
+  for (int i = 0; i < n; ++i) {
+    const ScheduleNode* sch = population[i].get();
+    auto it = known.find(sch);
+    if (it != known.end()) {
+      scores[i] = it->second;
+      continue;
+    }
+    auto [jt, inserted] = batch_index.emplace(sch, unscored.size());
+    if (inserted) {
+      unscored.push_back(population[i]);
+    }
+    index_in_batch[i] = jt->second;
+  }
+  if (!unscored.empty()) {
+    std::vector<double> batch_scores =
+        PredictNormalizedScore(unscored, GetRef<TuneContext>(self->ctx_), this->cost_model_);
+    ICHECK_EQ(batch_scores.size(), unscored.size());
+    for (int i = 0; i < n; ++i) {
+      if (index_in_batch[i] != -1) {
+        scores[i] = batch_scores[index_in_batch[i]];
+      }
+    }
+  }
+  TVM_PY_LOG(DEBUG, self->ctx_->logger)
+      << "Scored " << unscored.size() << " new candidates out of a population of " << n;
+  return scores;
+}
+
 std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
     std::vector<Schedule> population, int num) {
   IRModuleSet exists(database_->GetModuleEquality());
@@ -546,10 +673,13 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
     exists = this->measured_workloads_;
   }
   SizedHeap heap(num);
+  // The previous population and its scores. The candidates carried over without mutation keep
+  // their scores, so that only the new candidates of an iteration are sent to the cost model.
+  std::vector<Schedule> prev_population;
+  std::vector<double> prev_scores;
   for (int iter = 0;; ++iter) {
-    // Predict normalized score with the cost model,
-    std::vector<double> scores =
-        PredictNormalizedScore(population, GetRef<TuneContext>(self->ctx_), this->cost_model_);
+    // Predict normalized score with the cost model, in one batch of the unscored candidates
+    std::vector<double> scores = PredictWithReuse(population, prev_population, prev_scores);
 
     {
       auto _ = Profiler::TimedScope("EvoSearch/Evolve/Misc");
@@ -617,6 +747,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
       support::parallel_for_dynamic(0, self->population_size, self->ctx_->num_threads,
                                     f_find_candidate);
 
+      prev_population.swap(population);
+      prev_scores.swap(scores);
       population.swap(next_population);
       TVM_PY_LOG(INFO, self->ctx_->logger) << "Evolve iter #" << iter << " done. Summary:\n"
                                            << pp.SummarizeFailures();
@@ -662,6 +794,7 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickWithEpsGreedy(
   std::vector<Schedule> results;
   results.reserve(num);
   IRModuleSet& measured_workloads = this->measured_workloads_;
+  int num_lowered_duplicates = 0;
   for (int i = 0, i_bests = 0, i_rands = 0; i < num; ++i) {
     bool has_best = i_bests < static_cast<int>(bests.size());
     bool has_rand = i_rands < static_cast<int>(rands.size());
@@ -690,12 +823,38 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickWithEpsGreedy(
     size_t shash = ModuleHash(mod);
     if (!measured_workloads.Has(mod, shash)) {
       measured_workloads.Add(mod, shash);
+      if (self->dedup_lowered_ir && IsLoweredDuplicate(mod)) {
+        ++num_lowered_duplicates;
+        continue;
+      }
       results.push_back(sch);
     }
   }
+  if (num_lowered_duplicates > 0) {
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Skipped " << num_lowered_duplicates
+        << " candidate(s) lowering to the same code as measured ones";
+  }
   return results;
 }
 
+bool EvolutionarySearchNode::State::IsLoweredDuplicate(const IRModule& mod) {
+  auto _ = Profiler::TimedScope("EvoSearch/LowerForDedup");
+  IRModule lowered{nullptr};
+  try {
+    lowered = LowerModule(DeepCopyIRModule(mod), /*simple_mode=*/true);
+  } catch (const std::exception&) {
+    // The candidate is kept, and the builder reports the error
+    return false;
+  }
+  size_t shash = lowered_equality_->Hash(lowered);
+  if (lowered_workloads_.Has(lowered, shash)) {
+    return true;
+  }
+  lowered_workloads_.Add(lowered, shash);
+  return false;
+}
+
 Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasureCandidates() {
   if (st >= max_trials) {
     return NullOpt;
@@ -755,7 +914,9 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
                                                   int genetic_num_iters,       //
                                                   double genetic_mutate_prob,  //
                                                   int genetic_max_fail_count,  //
-                                                  double eps_greedy) {
+                                                  double eps_greedy,           //
+                                                  int num_transfer_workloads,  //
+                                                  bool dedup_lowered_ir) {
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(init_measured_ratio, "Initial measured ratio");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(genetic_mutate_prob, "Mutation probability");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(eps_greedy, "Greedy pick probability");
@@ -769,6 +930,8 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
   n->genetic_max_fail_count = genetic_max_fail_count;
   n->genetic_mutate_prob = genetic_mutate_prob;
   n->eps_greedy = eps_greedy;
+  n->num_transfer_workloads = num_transfer_workloads;
+  n->dedup_lowered_ir = dedup_lowered_ir;
   return SearchStrategy(n);
 }
 
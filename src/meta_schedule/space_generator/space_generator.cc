@@ -22,22 +22,48 @@
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief Check if an x86 target has a feature, either implied by its `mcpu` or explicitly enabled
+ *  in its `mattr`, e.g. "-mattr=+avx512vnni" on a generic `mcpu`.
+ * \param target The target to check
+ * \param f_check_mcpu The name of the registered function checking the `mcpu`
+ * \param features The names of the `mattr` features which imply the feature
+ * \return Whether the target has the feature
+ */
+bool X86TargetHasFeature(const Target& target, const char* f_check_mcpu,
+                         std::initializer_list<const char*> features) {
+  const PackedFunc* f_check = runtime::Registry::Get(f_check_mcpu);
+  ICHECK(f_check != nullptr) << "The `" << f_check_mcpu << "` func is not in tvm registry.";
+  if (Optional<String> mcpu = target->GetAttr<String>("mcpu")) {
+    if ((*f_check)(mcpu.value())) {
+      return true;
+    }
+  }
+  if (Optional<Array<String>> mattr = target->GetAttr<Array<String>>("mattr")) {
+    for (const String& attr : mattr.value()) {
+      for (const char* feature : features) {
+        if (attr == String("+") + feature) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 String GetRuleKindFromTarget(const Target& target) {
   if (target->kind->name == "llvm") {
-    static const PackedFunc* f_check_vnni =
-        runtime::Registry::Get("tvm.target.x86.target_has_vnni");
-    ICHECK(f_check_vnni != nullptr) << "The `target_has_vnni` func is not in tvm registry.";
-    if (target->GetAttr<String>("mcpu") &&
-        (*f_check_vnni)(target->GetAttr<String>("mcpu").value())) {
+    if (X86TargetHasFeature(target, "tvm.target.x86.target_has_avx512bf16", {"avx512bf16"})) {
+      return "avx512bf16";
+    }
+    // AMX-INT8 implies AVX512-VNNI, whose dot product intrinsic is used until AMX tiles are
+    // supported by the tensorization rules
+    if (X86TargetHasFeature(target, "tvm.target.x86.target_has_vnni",
+                            {"avx512vnni", "amx-int8"})) {
       return "vnni";
-    } else {
-      static const PackedFunc* f_check_avx512 =
-          runtime::Registry::Get("tvm.target.x86.target_has_avx512");
-      ICHECK(f_check_avx512 != nullptr) << "The `target_has_avx512` func is not in tvm registry.";
-      if (target->GetAttr<String>("mcpu") &&
-          (*f_check_avx512)(target->GetAttr<String>("mcpu").value())) {
-        return "avx512";
-      }
+    }
+    if (X86TargetHasFeature(target, "tvm.target.x86.target_has_avx512", {"avx512bw"})) {
+      return "avx512";
     }
 
     TargetJSON target_json = target::parsers::aprofile::ParseTarget(target->Export());
@@ -71,6 +97,13 @@ String GetRuleKindFromTarget(const Target& target) {
     }
     return "cuda";
   }
+  if (target->kind->name == "vulkan") {
+    if (target->GetAttr<Bool>("supports_cooperative_matrix").value_or(Bool(false)) ||
+        target->GetAttr<Bool>("supports_khr_cooperative_matrix").value_or(Bool(false))) {
+      return "vulkan-tensorcore";
+    }
+    return "cuda";
+  }
 
   if (IsGPUTarget(target->kind->name)) {
     return "cuda";
@@ -105,6 +138,10 @@ void SpaceGeneratorNode::InitializeWithTuneContext(const TuneContext& context) {
       default_sch_rules = ScheduleRule::DefaultCUDATensorCore();
       default_postprocs = Postproc::DefaultCUDATensorCore();
       default_mutator_probs = Mutator::DefaultCUDATensorCore();
+    } else if (kind == "vulkan-tensorcore") {
+      default_sch_rules = ScheduleRule::DefaultVulkanTensorCore();
+      default_postprocs = Postproc::DefaultCUDATensorCore();
+      default_mutator_probs = Mutator::DefaultCUDATensorCore();
     } else if (kind == "hexagon") {
       default_sch_rules = ScheduleRule::DefaultHexagon();
       default_postprocs = Postproc::DefaultHexagon();
@@ -113,6 +150,10 @@ void SpaceGeneratorNode::InitializeWithTuneContext(const TuneContext& context) {
       default_sch_rules = ScheduleRule::DefaultX86("vnni");
       default_postprocs = Postproc::DefaultCPUTensorization();
       default_mutator_probs = Mutator::DefaultLLVM();
+    } else if (kind == "avx512bf16") {
+      default_sch_rules = ScheduleRule::DefaultX86("avx512bf16");
+      default_postprocs = Postproc::DefaultCPUTensorization();
+      default_mutator_probs = Mutator::DefaultLLVM();
     } else if (kind == "avx512") {
       default_sch_rules = ScheduleRule::DefaultX86("avx512");
       default_postprocs = Postproc::DefaultCPUTensorization();
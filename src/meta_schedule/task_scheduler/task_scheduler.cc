@@ -180,7 +180,10 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
     TVM_PY_LOG(INFO, this->logger)
         << "TaskScheduler picks Task #" << task_id << ": " << tasks_[task_id]->ctx->task_name;
     TaskRecordNode* task = tasks_[task_id].get();
-    ICHECK(!task->is_terminated);
+    if (task->is_terminated) {
+      // A measure callback may stop the task when its last batch is joined in `NextTaskId`
+      continue;
+    }
     ICHECK(!task->runner_futures.defined());
     if (static_cast<int>(task->latency_ms.size()) >= max_trials_per_task) {
       TerminateTask(task_id);
@@ -200,10 +203,10 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
   }
   for (int task_id = 0; task_id < n_tasks; ++task_id) {
     TaskRecordNode* task = this->tasks_[task_id].get();
+    if (!task->is_terminated && task->runner_futures.defined()) {
+      JoinRunningTask(task_id);
+    }
     if (!task->is_terminated) {
-      if (task->runner_futures.defined()) {
-        JoinRunningTask(task_id);
-      }
       TerminateTask(task_id);
     }
     task->ctx->search_strategy.value()->PostTuning();
@@ -43,7 +43,10 @@
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -324,11 +327,8 @@ struct ThreadedTraceApply {
    */
   Optional<tir::Schedule> Apply(const IRModule& mod, const tir::Trace& trace,
                                 TRandState* rand_state) {
-    tir::Schedule sch =
-        tir::Schedule::Traced(mod,
-                              /*rand_state=*/ForkSeed(rand_state),
-                              /*debug_mode=*/0,
-                              /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+    tir::Schedule sch = Fork(mod);
+    sch->Seed(ForkSeed(rand_state));
 
     trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
     sch->EnterPostproc();
@@ -366,10 +366,50 @@ struct ThreadedTraceApply {
     std::atomic<int> fail_counter{0};
   };
 
+  /*! \brief A schedule of an IRModule on which no instruction is applied yet. */
+  struct Template {
+    /*! \brief The schedule, which is never modified */
+    tir::Schedule sch{nullptr};
+    /*! \brief The mutex guarding the copies of the schedule, which fork its random state */
+    std::mutex mutex;
+  };
+
+  /*!
+   * \brief Create a fresh schedule of an IRModule. Analyzing the IRModule into a ScheduleState is
+   * done once per IRModule, and each schedule afterwards is a copy of the analyzed state, which
+   * only remaps the srefs. The callers apply the traces to per-thread IRModules, so the copies
+   * of the same template are rarely contended.
+   * \param mod The IRModule to be scheduled
+   * \return The schedule created
+   */
+  tir::Schedule Fork(const IRModule& mod) {
+    Template* tmpl = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(templates_mutex_);
+      std::unique_ptr<Template>& entry = templates_[mod.get()];
+      if (entry == nullptr) {
+        entry = std::make_unique<Template>();
+      }
+      tmpl = entry.get();
+    }
+    std::lock_guard<std::mutex> lock(tmpl->mutex);
+    if (!tmpl->sch.defined()) {
+      tmpl->sch = tir::Schedule::Traced(mod,
+                                        /*rand_state=*/-1,
+                                        /*debug_mode=*/0,
+                                        /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+    }
+    return tmpl->sch->Copy();
+  }
+
   /*! \brief The number of total postprocessors. */
   int n_;
   /*! \brief The pointer to the list of postprocessor items. */
   Item* items_;
+  /*! \brief The mutex guarding `templates_` */
+  std::mutex templates_mutex_;
+  /*! \brief The template schedule of each IRModule, which the template keeps alive */
+  std::unordered_map<const IRModuleNode*, std::unique_ptr<Template>> templates_;
 };
 
 /*!
@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "workload_similarity.h"
+
+#include <tvm/tir/analysis.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+namespace tvm {
+namespace meta_schedule {
+
+AnchorBlockSignature AnchorBlockSignature::FromModule(const IRModule& mod) {
+  AnchorBlockSignature result;
+  const tir::BlockNode* block = tir::FindAnchorBlock(mod);
+  if (block == nullptr) {
+    return result;
+  }
+  std::ostringstream os;
+  os << block->name_hint << ';';
+  result.extents.reserve(block->iter_vars.size());
+  for (const tir::IterVar& iter : block->iter_vars) {
+    const auto* extent = iter->dom->extent.as<IntImmNode>();
+    if (extent == nullptr || extent->value <= 0) {
+      return result;
+    }
+    result.extents.push_back(extent->value);
+    os << static_cast<int>(iter->iter_type) << ',';
+  }
+  for (const Array<tir::BufferRegion>* regions : {&block->reads, &block->writes}) {
+    os << ';';
+    for (const tir::BufferRegion& region : *regions) {
+      os << region->buffer->dtype << '[' << region->buffer->shape.size() << "],";
+    }
+  }
+  result.structure = os.str();
+  result.defined = true;
+  return result;
+}
+
+double AnchorBlockSignature::Distance(const AnchorBlockSignature& other) const {
+  if (!this->defined || !other.defined || this->structure != other.structure) {
+    return std::numeric_limits<double>::infinity();
+  }
+  ICHECK_EQ(this->extents.size(), other.extents.size());
+  double result = 0.0;
+  for (int i = 0, n = this->extents.size(); i < n; ++i) {
+    result += std::abs(std::log2(static_cast<double>(this->extents[i])) -
+                       std::log2(static_cast<double>(other.extents[i])));
+  }
+  return result;
+}
+
+WorkloadSimilarityIndex::WorkloadSimilarityIndex(const Database& database) {
+  std::unordered_set<const WorkloadNode*> visited;
+  for (const TuningRecord& record : database->GetAllTuningRecords()) {
+    if (!visited.insert(record->workload.get()).second) {
+      continue;
+    }
+    AnchorBlockSignature signature = AnchorBlockSignature::FromModule(record->workload->mod);
+    if (signature.defined) {
+      this->workloads_.push_back(record->workload);
+      this->signatures_.push_back(std::move(signature));
+    }
+  }
+}
+
+std::vector<Workload> WorkloadSimilarityIndex::FindNearest(const IRModule& mod, int k,
+                                                           const ModuleEquality& mod_eq) const {
+  AnchorBlockSignature signature = AnchorBlockSignature::FromModule(mod);
+  std::vector<std::pair<double, int>> candidates;
+  if (signature.defined) {
+    for (int i = 0, n = this->workloads_.size(); i < n; ++i) {
+      double distance = signature.Distance(this->signatures_[i]);
+      if (!std::isfinite(distance)) {
+        continue;
+      }
+      if (distance == 0.0 && mod_eq.Equal(mod, this->workloads_[i]->mod)) {
+        continue;
+      }
+      candidates.emplace_back(distance, i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  std::vector<Workload> results;
+  for (int i = 0, n = std::min<int>(k, candidates.size()); i < n; ++i) {
+    results.push_back(this->workloads_[candidates[i].second]);
+  }
+  return results;
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
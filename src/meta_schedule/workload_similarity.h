@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_WORKLOAD_SIMILARITY_H_
+#define TVM_META_SCHEDULE_WORKLOAD_SIMILARITY_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/meta_schedule/database.h>
+
+#include <string>
+#include <vector>
+
+#include "module_equality.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The signature of the anchor block of a workload, which splits the block into its
+ * structure and its shape. Two workloads with the same structure differ only in the extents of
+ * the block iters, e.g. two conv2d with different numbers of channels, so that a trace tuned on
+ * one of them can be replayed on the other. For the definition of the anchor block, see
+ * tvm/tir/analysis.h.
+ */
+struct AnchorBlockSignature {
+  /*! \brief Whether an anchor block with constant extents is found in the workload */
+  bool defined = false;
+  /*!
+   * \brief The structure of the anchor block, independent of its shape: the name of the block,
+   * the type of its iters, and the dtype and rank of the buffers it accesses.
+   */
+  std::string structure;
+  /*! \brief The extents of the iters of the anchor block */
+  std::vector<int64_t> extents;
+
+  /*!
+   * \brief Extract the signature of the anchor block of a workload
+   * \param mod The workload
+   * \return The signature, which is not defined if no anchor block is found
+   */
+  static AnchorBlockSignature FromModule(const IRModule& mod);
+
+  /*!
+   * \brief The distance between the shapes of two anchor blocks of the same structure, the sum
+   * over the block iters of the absolute log2 ratio of their extents.
+   * \param other The other signature
+   * \return The distance, or infinity if the two blocks have different structures
+   */
+  double Distance(const AnchorBlockSignature& other) const;
+};
+
+/*!
+ * \brief An index of the workloads in a database, to look up the workloads whose anchor block has
+ * the same structure as a given one, nearest first.
+ */
+class WorkloadSimilarityIndex {
+ public:
+  /*!
+   * \brief Index the workloads that have tuning records in a database
+   * \param database The database
+   */
+  explicit WorkloadSimilarityIndex(const Database& database);
+
+  /*!
+   * \brief Find the workloads nearest to a given one
+   * \param mod The workload to look up
+   * \param k The maximum number of workloads to return
+   * \param mod_eq The module equality of the database
+   * \return The workloads of the same structure, nearest first, excluding those equal to `mod`
+   */
+  std::vector<Workload> FindNearest(const IRModule& mod, int k,
+                                    const ModuleEquality& mod_eq) const;
+
+ private:
+  /*! \brief The indexed workloads */
+  std::vector<Workload> workloads_;
+  /*! \brief The signature of each indexed workload */
+  std::vector<AnchorBlockSignature> signatures_;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_WORKLOAD_SIMILARITY_H_
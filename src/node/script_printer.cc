@@ -88,6 +88,9 @@ PrinterConfig::PrinterConfig(Map<String, ObjectRef> config_dict) {
   if (auto v = config_dict.Get("syntax_sugar")) {
     n->syntax_sugar = Downcast<IntImm>(v)->value;
   }
+  if (auto v = config_dict.Get("num_threads")) {
+    n->num_threads = Downcast<IntImm>(v)->value;
+  }
   this->data_ = std::move(n);
 }
 
@@ -35,6 +35,8 @@
 #include <cctype>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../runtime/object_internal.h"
 #include "../support/base64.h"
@@ -474,7 +476,7 @@ struct JSONGraph {
   size_t root;
   // the nodes of the graph
   std::vector<JSONNode> nodes;
-  // base64 b64ndarrays of arrays
+  // base64 b64ndarrays of arrays, or the raw bytes of the arrays in the binary format
   std::vector<std::string> b64ndarrays;
   // global attributes
   AttrMap attrs;
@@ -500,7 +502,7 @@ struct JSONGraph {
     helper.ReadAllFields(reader);
   }
 
-  static JSONGraph Create(const ObjectRef& root) {
+  static JSONGraph Create(const ObjectRef& root, bool b64_ndarrays = true) {
     JSONGraph g;
     NodeIndexer indexer;
     indexer.MakeIndex(const_cast<Object*>(root.get()));
@@ -519,9 +521,13 @@ struct JSONGraph {
     for (DLTensor* tensor : indexer.tensor_list_) {
       std::string blob;
       dmlc::MemoryStringStream mstrm(&blob);
-      support::Base64OutStream b64strm(&mstrm);
-      runtime::SaveDLTensor(&b64strm, tensor);
-      b64strm.Finish();
+      if (b64_ndarrays) {
+        support::Base64OutStream b64strm(&mstrm);
+        runtime::SaveDLTensor(&b64strm, tensor);
+        b64strm.Finish();
+      } else {
+        runtime::SaveDLTensor(&mstrm, tensor);
+      }
       g.b64ndarrays.emplace_back(std::move(blob));
     }
     return g;
@@ -563,40 +569,207 @@ struct JSONGraph {
   }
 };
 
-std::string SaveJSON(const ObjectRef& n) {
-  auto jgraph = JSONGraph::Create(n);
-  std::ostringstream os;
-  dmlc::JSONWriter writer(&os);
-  jgraph.Save(&writer);
-  return os.str();
-}
+/*!
+ * \brief The binary encoding of a JSONGraph.
+ *
+ *  It starts with kMagic and the format version, followed by a table of all the distinct
+ *  strings, the root, the nodes and the raw NDArray blobs. Strings are referred to by their
+ *  index in the table plus one, 0 being the empty string, and all integers are varints.
+ */
+class BinaryGraphCodec {
+ public:
+  /*! \brief The leading bytes of the binary format, which cannot start a JSON document */
+  static constexpr const char kMagic[] = "\0TVMB";
+  static constexpr size_t kMagicSize = 5;
+  static constexpr uint64_t kVersion = 1;
+
+  static bool IsBinary(const std::string& blob) {
+    return blob.size() >= kMagicSize && blob.compare(0, kMagicSize, kMagic, kMagicSize) == 0;
+  }
+
+  static std::string Encode(const JSONGraph& g) {
+    BinaryGraphCodec codec;
+    // Encode the graph first to collect the strings into the table
+    std::string body;
+    codec.out_ = &body;
+    codec.WriteVarint(g.root);
+    codec.WriteVarint(g.nodes.size());
+    for (const JSONNode& jnode : g.nodes) {
+      codec.WriteString(jnode.type_key);
+      codec.WriteString(jnode.repr_bytes);
+      codec.WriteAttrs(jnode.attrs);
+      codec.WriteVarint(jnode.keys.size());
+      for (const std::string& key : jnode.keys) {
+        codec.WriteString(key);
+      }
+      codec.WriteVarint(jnode.data.size());
+      for (size_t index : jnode.data) {
+        codec.WriteVarint(index);
+      }
+    }
+    codec.WriteAttrs(g.attrs);
+    codec.WriteVarint(g.b64ndarrays.size());
+    for (const std::string& blob : g.b64ndarrays) {
+      codec.WriteVarint(blob.size());
+      body.append(blob);
+    }
+    std::string result(kMagic, kMagicSize);
+    codec.out_ = &result;
+    codec.WriteVarint(kVersion);
+    codec.WriteVarint(codec.strings_.size());
+    for (const std::string* str : codec.strings_) {
+      codec.WriteVarint(str->size());
+      result.append(*str);
+    }
+    result.append(body);
+    return result;
+  }
+
+  static JSONGraph Decode(const std::string& blob) {
+    ICHECK(IsBinary(blob));
+    BinaryGraphCodec codec;
+    codec.in_ = &blob;
+    codec.pos_ = kMagicSize;
+    uint64_t version = codec.ReadVarint();
+    CHECK_EQ(version, kVersion) << "ValueError: Unsupported version of the binary format: "
+                                << version;
+    uint64_t n_strings = codec.ReadVarint();
+    codec.table_.reserve(n_strings + 1);
+    codec.table_.emplace_back();
+    for (uint64_t i = 0; i < n_strings; ++i) {
+      codec.table_.push_back(codec.ReadBytes(codec.ReadVarint()));
+    }
+    JSONGraph g;
+    g.root = codec.ReadVarint();
+    g.nodes.resize(codec.ReadVarint());
+    for (JSONNode& jnode : g.nodes) {
+      jnode.type_key = codec.ReadString();
+      jnode.repr_bytes = codec.ReadString();
+      codec.ReadAttrs(&jnode.attrs);
+      jnode.keys.resize(codec.ReadVarint());
+      for (std::string& key : jnode.keys) {
+        key = codec.ReadString();
+      }
+      jnode.data.resize(codec.ReadVarint());
+      for (size_t& index : jnode.data) {
+        index = codec.ReadVarint();
+      }
+    }
+    codec.ReadAttrs(&g.attrs);
+    g.b64ndarrays.resize(codec.ReadVarint());
+    for (std::string& ndarray : g.b64ndarrays) {
+      ndarray = codec.ReadBytes(codec.ReadVarint());
+    }
+    CHECK_EQ(codec.pos_, blob.size()) << "ValueError: Trailing bytes in the binary format";
+    return g;
+  }
 
-ObjectRef LoadJSON(std::string json_str) {
-  ReflectionVTable* reflection = ReflectionVTable::Global();
-  JSONGraph jgraph;
-  {
-    // load in json graph.
-    std::istringstream is(json_str);
-    dmlc::JSONReader reader(&is);
-    jgraph.Load(&reader);
+ private:
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      out_->push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out_->push_back(static_cast<char>(value));
+  }
+
+  void WriteString(const std::string& str) {
+    if (str.empty()) {
+      WriteVarint(0);
+      return;
+    }
+    auto it = string_index_.find(str);
+    if (it == string_index_.end()) {
+      it = string_index_.emplace(str, strings_.size() + 1).first;
+      strings_.push_back(&it->first);
+    }
+    WriteVarint(it->second);
+  }
+
+  void WriteAttrs(const AttrMap& attrs) {
+    WriteVarint(attrs.size());
+    for (const auto& kv : attrs) {
+      WriteString(kv.first);
+      WriteString(kv.second);
+    }
   }
-  size_t n_nodes = jgraph.nodes.size();
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      CHECK(pos_ < in_->size() && shift < 64) << "ValueError: Malformed binary format";
+      uint8_t byte = static_cast<uint8_t>((*in_)[pos_++]);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+  }
+
+  std::string ReadBytes(uint64_t size) {
+    CHECK_LE(size, in_->size() - pos_) << "ValueError: Malformed binary format";
+    std::string bytes = in_->substr(pos_, size);
+    pos_ += size;
+    return bytes;
+  }
+
+  const std::string& ReadString() {
+    uint64_t index = ReadVarint();
+    CHECK_LT(index, table_.size()) << "ValueError: Malformed binary format";
+    return table_[index];
+  }
+
+  void ReadAttrs(AttrMap* attrs) {
+    attrs->clear();
+    for (uint64_t n = ReadVarint(); n > 0; --n) {
+      const std::string& key = ReadString();
+      (*attrs)[key] = ReadString();
+    }
+  }
+
+  /*! \brief The output buffer when encoding */
+  std::string* out_{nullptr};
+  /*! \brief The string table when encoding, in the order of first occurrence */
+  std::vector<const std::string*> strings_;
+  /*! \brief The index of each string in the table when encoding */
+  std::unordered_map<std::string, uint64_t> string_index_;
+  /*! \brief The input buffer when decoding */
+  const std::string* in_{nullptr};
+  /*! \brief The read position when decoding */
+  size_t pos_{0};
+  /*! \brief The string table when decoding, with the empty string at index 0 */
+  std::vector<std::string> table_;
+};
+
+/*!
+ * \brief Create the objects of a graph.
+ * \param jgraph The graph.
+ * \param b64_ndarrays Whether the NDArrays of the graph are base64 encoded.
+ * \return The root object.
+ */
+ObjectRef LoadJSONGraph(JSONGraph* jgraph, bool b64_ndarrays) {
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  size_t n_nodes = jgraph->nodes.size();
   std::vector<runtime::NDArray> tensors;
   {
     // load in tensors
-    for (const std::string& blob : jgraph.b64ndarrays) {
+    for (const std::string& blob : jgraph->b64ndarrays) {
       dmlc::MemoryStringStream mstrm(const_cast<std::string*>(&blob));
-      support::Base64InStream b64strm(&mstrm);
-      b64strm.InitPosition();
       runtime::NDArray temp;
-      ICHECK(temp.Load(&b64strm));
+      if (b64_ndarrays) {
+        support::Base64InStream b64strm(&mstrm);
+        b64strm.InitPosition();
+        ICHECK(temp.Load(&b64strm));
+      } else {
+        ICHECK(temp.Load(&mstrm));
+      }
       tensors.emplace_back(std::move(temp));
     }
   }
   // Pass 1: create all non-container objects
   std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
   for (size_t i = 0; i < n_nodes; ++i) {
-    const JSONNode& jnode = jgraph.nodes[i];
+    const JSONNode& jnode = jgraph->nodes[i];
     if (jnode.type_key.length() != 0) {
       nodes[i] = reflection->CreateInitObject(jnode.type_key, jnode.repr_bytes);
     }
@@ -605,24 +778,59 @@ ObjectRef LoadJSON(std::string json_str) {
   {
     FieldDependencyFinder dep_finder;
     for (size_t i = 0; i < n_nodes; ++i) {
-      dep_finder.Find(nodes[i].get(), &jgraph.nodes[i]);
+      dep_finder.Find(nodes[i].get(), &jgraph->nodes[i]);
     }
   }
   // Pass 3: topo sort
-  std::vector<size_t> topo_order = jgraph.TopoSort();
+  std::vector<size_t> topo_order = jgraph->TopoSort();
   // Pass 4: set all values
   {
     JSONAttrSetter setter;
     setter.node_list_ = &nodes;
     setter.tensor_list_ = &tensors;
     for (size_t i : topo_order) {
-      setter.Set(&nodes[i], &jgraph.nodes[i]);
+      setter.Set(&nodes[i], &jgraph->nodes[i]);
     }
   }
-  return ObjectRef(nodes.at(jgraph.root));
+  return ObjectRef(nodes.at(jgraph->root));
+}
+
+std::string SaveJSON(const ObjectRef& n) {
+  auto jgraph = JSONGraph::Create(n);
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  jgraph.Save(&writer);
+  return os.str();
+}
+
+std::string SaveBinary(const ObjectRef& n) {
+  return BinaryGraphCodec::Encode(JSONGraph::Create(n, /*b64_ndarrays=*/false));
+}
+
+ObjectRef LoadJSON(std::string json_str) {
+  if (BinaryGraphCodec::IsBinary(json_str)) {
+    JSONGraph jgraph = BinaryGraphCodec::Decode(json_str);
+    return LoadJSONGraph(&jgraph, /*b64_ndarrays=*/false);
+  }
+  JSONGraph jgraph;
+  {
+    // load in json graph.
+    std::istringstream is(json_str);
+    dmlc::JSONReader reader(&is);
+    jgraph.Load(&reader);
+  }
+  return LoadJSONGraph(&jgraph, /*b64_ndarrays=*/true);
 }
 
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body([](TVMArgs args, TVMRetValue* rv) {
+  std::string blob = SaveBinary(args[0]);
+  TVMByteArray arr;
+  arr.size = blob.length();
+  arr.data = blob.data();
+  *rv = arr;
+});
+
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
 }  // namespace tvm
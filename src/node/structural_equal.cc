@@ -30,6 +30,7 @@
 #include <unordered_map>
 
 #include "ndarray_hash_equal.h"
+#include "structural_hash_cache.h"
 
 namespace tvm {
 
@@ -287,6 +288,8 @@ class SEqualHandlerDefault::Impl {
   // Function that implements actual equality check.
   bool Equal(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars) {
     if (!lhs.defined() && !rhs.defined()) return true;
+    // An object is equal to itself under any variable mapping
+    if (lhs.same_as(rhs)) return true;
     task_stack_.clear();
     pending_tasks_.clear();
     equal_map_lhs_.clear();
@@ -527,9 +530,23 @@ bool SEqualHandlerDefault::DispatchSEqualReduce(const ObjectRef& lhs, const Obje
   return impl->DispatchSEqualReduce(lhs, rhs, map_free_vars, current_paths);
 }
 
+/*!
+ * \brief Whether the memoized structural hashes of two objects prove that they differ.
+ *  Only valid for the default equality, which the structural hash is consistent with.
+ */
+static bool CachedHashesDiffer(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars) {
+  uint64_t lhs_hash, rhs_hash;
+  return LookupCachedStructuralHash(lhs, map_free_vars, &lhs_hash) &&
+         LookupCachedStructuralHash(rhs, map_free_vars, &rhs_hash) && lhs_hash != rhs_hash;
+}
+
 TVM_REGISTER_GLOBAL("node.StructuralEqual")
     .set_body_typed([](const ObjectRef& lhs, const ObjectRef& rhs, bool assert_mode,
                        bool map_free_vars) {
+      // In assert mode, the full comparison is needed to report the mismatch
+      if (!assert_mode && CachedHashesDiffer(lhs, rhs, map_free_vars)) {
+        return false;
+      }
       Optional<ObjectPathPair> first_mismatch;
       return SEqualHandlerDefault(assert_mode, &first_mismatch, false)
           .Equal(lhs, rhs, map_free_vars);
@@ -545,6 +562,9 @@ TVM_REGISTER_GLOBAL("node.GetFirstStructuralMismatch")
     });
 
 bool StructuralEqual::operator()(const ObjectRef& lhs, const ObjectRef& rhs) const {
+  if (CachedHashesDiffer(lhs, rhs, false)) {
+    return false;
+  }
   return SEqualHandlerDefault(false, nullptr, false).Equal(lhs, rhs, false);
 }
 
@@ -20,6 +20,7 @@
  * \file src/node/structural_hash.cc
  */
 #include <dmlc/memory_io.h>
+#include <tvm/ir/module.h>
 #include <tvm/node/functor.h>
 #include <tvm/node/node.h>
 #include <tvm/node/object_path.h>
@@ -30,12 +31,16 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "../support/base64.h"
 #include "../support/str_escape.h"
 #include "../support/utils.h"
 #include "ndarray_hash_equal.h"
+#include "structural_hash_cache.h"
 
 namespace tvm {
 
@@ -287,14 +292,119 @@ void SHashHandlerDefault::DispatchSHash(const ObjectRef& key, bool map_free_vars
   impl->DispatchSHash(key, map_free_vars);
 }
 
+/*!
+ * \brief An opt-in memo of the structural hashes of IRModules and functions, which are hashed
+ *  repeatedly by the compilation caches and the tuning database.
+ *
+ *  The memo holds a reference to each object it hashed, so that the object can neither be
+ *  freed, which would let its address be reused, nor be mutated in place, since CopyOnWrite
+ *  copies it when it is not unique. IRModuleNode is the exception, its methods mutate it in
+ *  place, so the memo also keeps the containers of a module that enter its hash, which are
+ *  copied on write as well, and recomputes the hash when one of them is replaced.
+ */
+class StructuralHashCache {
+ public:
+  static StructuralHashCache* Global() {
+    static StructuralHashCache inst;
+    return &inst;
+  }
+
+  void Configure(int64_t max_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_size_ = max_size;
+    for (auto& memo : memo_) {
+      memo.clear();
+    }
+  }
+
+  uint64_t Hash(const ObjectRef& object, bool map_free_vars) {
+    if (max_size_ <= 0 || !object.defined() ||
+        !(object->IsInstance<IRModuleNode>() || object->IsInstance<BaseFuncNode>())) {
+      return SHashHandlerDefault().Hash(object, map_free_vars);
+    }
+    std::vector<ObjectRef> fields = HashedFields(object);
+    auto& memo = memo_[map_free_vars];
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = memo.find(object);
+      if (it != memo.end() && IsSame(it->second.fields, fields)) {
+        return it->second.hash;
+      }
+    }
+    uint64_t hashed_value = SHashHandlerDefault().Hash(object, map_free_vars);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (static_cast<int64_t>(memo.size()) >= max_size_) {
+      memo.clear();
+    }
+    memo[object] = Entry{hashed_value, std::move(fields)};
+    return hashed_value;
+  }
+
+  bool Lookup(const ObjectRef& object, bool map_free_vars, uint64_t* hash) {
+    if (max_size_ <= 0 || !object.defined()) {
+      return false;
+    }
+    std::vector<ObjectRef> fields = HashedFields(object);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& memo = memo_[map_free_vars];
+    auto it = memo.find(object);
+    if (it == memo.end() || !IsSame(it->second.fields, fields)) {
+      return false;
+    }
+    *hash = it->second.hash;
+    return true;
+  }
+
+ private:
+  struct Entry {
+    /*! \brief The structural hash of the object */
+    uint64_t hash;
+    /*! \brief The fields of the object which may be replaced in place */
+    std::vector<ObjectRef> fields;
+  };
+
+  static std::vector<ObjectRef> HashedFields(const ObjectRef& object) {
+    if (const auto* mod = object.as<IRModuleNode>()) {
+      return {mod->functions, mod->type_definitions, mod->attrs};
+    }
+    return {};
+  }
+
+  static bool IsSame(const std::vector<ObjectRef>& a, const std::vector<ObjectRef>& b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (!a[i].same_as(b[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::mutex mutex_;
+  /*! \brief The maximum number of objects kept for each map_free_vars, 0 to disable the memo */
+  std::atomic<int64_t> max_size_{0};
+  /*! \brief The memo of each map_free_vars */
+  std::unordered_map<ObjectRef, Entry, ObjectPtrHash, ObjectPtrEqual> memo_[2];
+};
+
+bool LookupCachedStructuralHash(const ObjectRef& object, bool map_free_vars, uint64_t* hash) {
+  return StructuralHashCache::Global()->Lookup(object, map_free_vars, hash);
+}
+
 TVM_REGISTER_GLOBAL("node.StructuralHash")
     .set_body_typed([](const ObjectRef& object, bool map_free_vars) -> int64_t {
-      uint64_t hashed_value = SHashHandlerDefault().Hash(object, map_free_vars);
+      uint64_t hashed_value = StructuralHashCache::Global()->Hash(object, map_free_vars);
       return static_cast<int64_t>(hashed_value);
     });
 
+TVM_REGISTER_GLOBAL("node.ConfigureStructuralHashCache").set_body_typed([](int64_t max_size) {
+  StructuralHashCache::Global()->Configure(max_size);
+});
+
 uint64_t StructuralHash::operator()(const ObjectRef& object) const {
-  return SHashHandlerDefault().Hash(object, false);
+  return StructuralHashCache::Global()->Hash(object, false);
 }
 
 // SEQualReduce traits for runtime containers.
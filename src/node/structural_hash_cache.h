@@ -0,0 +1,39 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_NODE_STRUCTURAL_HASH_CACHE_H_
+#define TVM_NODE_STRUCTURAL_HASH_CACHE_H_
+
+#include <tvm/runtime/object.h>
+
+#include <cstdint>
+
+namespace tvm {
+
+/*!
+ * \brief Look up the memoized structural hash of an object, without computing it.
+ * \param object The object.
+ * \param map_free_vars Whether the hash maps the free variables.
+ * \param hash The memoized hash, if any.
+ * \return Whether the memo of structural hashes holds a valid hash of the object.
+ */
+bool LookupCachedStructuralHash(const runtime::ObjectRef& object, bool map_free_vars,
+                                uint64_t* hash);
+
+}  // namespace tvm
+#endif  // TVM_NODE_STRUCTURAL_HASH_CACHE_H_
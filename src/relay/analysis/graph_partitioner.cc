@@ -220,8 +220,49 @@ size_t GraphPartitioner::CountFusedNodesWithNewChild(IndexedForwardGraph::Node*
   return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
 }
 
+void GraphPartitioner::CollectGroupsUptoSink_(IndexedForwardGraph::Node* src,
+                                              IndexedForwardGraph::Node* sink,
+                                              std::unordered_set<Group*>* groups) {
+  if (src == sink || visited_.count(src)) return;
+  visited_.insert(src);
+  Group* gnode = groups_[src->index];
+  ICHECK(gnode != nullptr);
+  groups->insert(gnode->FindRoot());
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    CollectGroupsUptoSink_(link->value.node, sink, groups);
+  }
+}
+
+size_t GraphPartitioner::CountFusedArgsWithNewChild(IndexedForwardGraph::Node* child,
+                                                    IndexedForwardGraph::Node* dom_parent) {
+  std::unordered_set<Group*> fused_groups{groups_[dom_parent->index]->FindRoot()};
+  visited_.clear();
+  ICHECK(child != dom_parent);
+  CollectGroupsUptoSink_(child, dom_parent, &fused_groups);
+  // The inputs of the fused nodes which are not fused themselves become the arguments.
+  std::unordered_set<size_t> args;
+  for (size_t nid = 0; nid < groups_.size(); ++nid) {
+    if (!fused_groups.count(groups_[nid]->FindRoot())) continue;
+    for (size_t input : node_inputs_[nid]) {
+      if (!fused_groups.count(groups_[input]->FindRoot())) {
+        args.insert(input);
+      }
+    }
+  }
+  return args.size();
+}
+
 void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
   groups_.resize(graph.post_dfs_order.size());
+  if (max_function_args_ > 0) {
+    // The graph only links each node to its outputs, so that the inputs are collected here.
+    node_inputs_.assign(graph.post_dfs_order.size(), {});
+    for (const IndexedForwardGraph::Node* node : graph.post_dfs_order) {
+      for (auto link = node->outputs.head; link != nullptr; link = link->next) {
+        node_inputs_[link->value.node->index].push_back(node->index);
+      }
+    }
+  }
   for (size_t nid = 0; nid < groups_.size(); ++nid) {
     const auto* graph_node = graph.post_dfs_order[nid];
     auto* group_node = arena_->make<Group>();
@@ -254,6 +295,10 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
     // refuse the fusion if too many ops are going to be fused together
     if (CountFusedNodesWithNewChild(graph_node, dom_node->parent->gnode) > max_fuse_depth_)
       continue;
+    // refuse the fusion if the fused function is going to read too many tensors
+    if (max_function_args_ > 0 &&
+        CountFusedArgsWithNewChild(graph_node, dom_node->parent->gnode) > max_function_args_)
+      continue;
 
     if (phase == 2) {
       // Fuse injective ops into intermediate tuples, if any
@@ -162,8 +162,12 @@ class DominatorTree {
  */
 class GraphPartitioner {
  public:
-  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth)
-      : arena_(arena), opt_level_(opt_level), max_fuse_depth_(max_fuse_depth) {}
+  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
+                            size_t max_function_args = 0)
+      : arena_(arena),
+        opt_level_(opt_level),
+        max_fuse_depth_(max_fuse_depth),
+        max_function_args_(max_function_args) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -205,6 +209,14 @@ class GraphPartitioner {
   int opt_level_;
   /*! \brief The maximum number of operations in one fused function */
   size_t max_fuse_depth_;
+  /*!
+   * \brief The maximum number of arguments of one fused function, 0 for no limit.
+   *  Each argument is a tensor that the fused kernel streams from memory, so that bounding
+   *  the arguments bounds the live inputs, and hence the register pressure, of the kernel.
+   */
+  size_t max_function_args_;
+  /*! \brief The indices of the nodes that each node reads, used when counting arguments. */
+  std::vector<std::vector<size_t>> node_inputs_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -257,6 +269,16 @@ class GraphPartitioner {
   size_t CountFusedNodesWithNewChild(IndexedForwardGraph::Node* child,
                                      IndexedForwardGraph::Node* dom_parent);
 
+  // Collect the groups of the nodes between src and sink, excluding sink.
+  void CollectGroupsUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink,
+                              std::unordered_set<Group*>* groups);
+
+  // Count the number of arguments of the fused function if child is additionally fused,
+  // i.e. the number of distinct nodes outside of the fused subgraph that it reads.
+  // The subgraph is the same as the one counted by CountFusedNodesWithNewChild.
+  size_t CountFusedArgsWithNewChild(IndexedForwardGraph::Node* child,
+                                    IndexedForwardGraph::Node* dom_parent);
+
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph);
 
@@ -496,6 +496,20 @@ class AOTExecutorCodegen : public MixedModeVisitor {
 
     tir::Stmt body = tir::SeqStmt::Flatten(func_call);
     stmts_.push_back(body);
+
+    StmtAccess access;
+    for (const Expr& arg : call_lowered_props.arguments) {
+      if (params_by_expr_.find(arg) == params_by_expr_.end()) {
+        for (const tir::Var& var : FindExpr(arg)) access.reads.push_back(var.get());
+      }
+    }
+    for (const tir::Var& var : result_expr_sid) access.writes.push_back(var.get());
+    for (int64_t size : storage_device_map_[result_expr]->storage_sizes_in_bytes) {
+      access.cost += size;
+    }
+    // Device hooks are not expected to be reentrant.
+    access.exclusive = has_c_device_api_context;
+    stmt_accesses_.push_back(std::move(access));
   }
 
   /*!
@@ -517,6 +531,82 @@ class AOTExecutorCodegen : public MixedModeVisitor {
         loop_idx, 0, tir::make_const(DataType::Int(32, 1), size, Span()), tir::ForKind::kSerial,
         tir::BufferStore(tmp_write, tir::Let(tmp_read->data, in, retval_i), {loop_idx}));
     stmts_.push_back(tir::LetStmt(tmp_write->data, out, copy));
+
+    StmtAccess access;
+    if (const auto* var = in.as<tir::VarNode>()) access.reads.push_back(var);
+    if (const auto* var = out.as<tir::VarNode>()) access.writes.push_back(var);
+    access.cost = size;
+    stmt_accesses_.push_back(std::move(access));
+  }
+
+  /*!
+   * \brief Schedule the statements of the main function over num_cores_ cores.
+   *
+   * Each statement is put in the first level following all the statements it conflicts
+   * with (read after write, write after read or write), then the statements of a level
+   * are given to the cores by decreasing cost, each to the least loaded core. A level
+   * with more than one statement becomes a parallel loop over the cores, the end of the
+   * loop being the barrier between two levels. StorageRewrite keeps every buffer touched
+   * in a loop alive for the whole loop, so the memory plan never lets statements running
+   * concurrently share a buffer.
+   */
+  tir::Stmt ScheduleOnCores() {
+    ICHECK_EQ(stmts_.size(), stmt_accesses_.size());
+    std::unordered_map<const tir::VarNode*, int> last_write, last_read;
+    std::vector<std::vector<size_t>> levels;
+    int first_level = 0;
+    for (size_t i = 0; i < stmts_.size(); ++i) {
+      const StmtAccess& access = stmt_accesses_[i];
+      int level = first_level;
+      auto after = [&level](const std::unordered_map<const tir::VarNode*, int>& last,
+                            const tir::VarNode* var) {
+        auto it = last.find(var);
+        if (it != last.end()) level = std::max(level, it->second + 1);
+      };
+      for (const tir::VarNode* var : access.reads) after(last_write, var);
+      for (const tir::VarNode* var : access.writes) {
+        after(last_write, var);
+        after(last_read, var);
+      }
+      if (access.exclusive) {
+        level = levels.size();
+        first_level = level + 1;
+      }
+      if (level == static_cast<int>(levels.size())) levels.emplace_back();
+      levels[level].push_back(i);
+      for (const tir::VarNode* var : access.reads) {
+        last_read[var] = std::max(level, last_read.count(var) ? last_read[var] : 0);
+      }
+      for (const tir::VarNode* var : access.writes) last_write[var] = level;
+    }
+
+    std::vector<tir::Stmt> seq;
+    for (std::vector<size_t>& level : levels) {
+      if (level.size() == 1) {
+        seq.push_back(stmts_[level[0]]);
+        continue;
+      }
+      std::stable_sort(level.begin(), level.end(), [this](size_t a, size_t b) {
+        return stmt_accesses_[a].cost > stmt_accesses_[b].cost;
+      });
+      size_t num_cores = std::min<size_t>(num_cores_, level.size());
+      std::vector<std::vector<tir::Stmt>> per_core(num_cores);
+      std::vector<int64_t> load(num_cores, 0);
+      for (size_t i : level) {
+        size_t core = std::min_element(load.begin(), load.end()) - load.begin();
+        per_core[core].push_back(stmts_[i]);
+        load[core] += stmt_accesses_[i].cost;
+      }
+      tir::Var core("core", DataType::Int(32));
+      tir::Stmt body = tir::SeqStmt::Flatten(per_core.back());
+      for (int k = num_cores - 2; k >= 0; --k) {
+        body = tir::IfThenElse(tir::EQ(core, tir::make_const(DataType::Int(32), k)),
+                               tir::SeqStmt::Flatten(per_core[k]), body);
+      }
+      seq.push_back(tir::For(core, 0, tir::make_const(DataType::Int(32), num_cores),
+                             tir::ForKind::kParallel, body));
+    }
+    return tir::SeqStmt::Flatten(seq);
   }
 
   /*
@@ -736,7 +826,7 @@ class AOTExecutorCodegen : public MixedModeVisitor {
   // the packed function calls don't pack their arguments. The AOT
   // runner function needs to be legalized by the LegalizePackedCalls pass.
   tir::PrimFunc CreateMainFunc(String mod_name, unsigned int relay_params) {
-    tir::Stmt body = tir::SeqStmt::Flatten(stmts_);
+    tir::Stmt body = num_cores_ > 1 ? ScheduleOnCores() : tir::SeqStmt::Flatten(stmts_);
     // Allocate the sids
     std::unordered_map<int, bool> allocated;
 
@@ -1026,6 +1116,19 @@ class AOTExecutorCodegen : public MixedModeVisitor {
   Map<String, FunctionInfo> function_metadata_;
   /*! \brief the set of statements that make the program */
   std::vector<tir::Stmt> stmts_;
+  /*! \brief The buffers a statement of the program reads and writes. */
+  struct StmtAccess {
+    std::vector<const tir::VarNode*> reads;
+    std::vector<const tir::VarNode*> writes;
+    /*! \brief The estimated cost of the statement, the number of bytes it writes. */
+    int64_t cost{0};
+    /*! \brief Whether the statement has to run alone. */
+    bool exclusive{false};
+  };
+  /*! \brief the accesses of each of stmts_ */
+  std::vector<StmtAccess> stmt_accesses_;
+  /*! \brief the number of cores the statements are scheduled over */
+  int num_cores_{1};
   /*! \brief the list of return sids (note that the function might return more then one output */
   std::vector<int> return_sid_;
   /*! \brief This is per IO var name counter to aid the generating unique names */
@@ -1047,6 +1150,8 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     std::string interface_api =
         executor_config->GetAttr<String>("interface-api").value_or("packed");
     bool unpacked_api = executor_config->GetAttr<Bool>("unpacked-api").value_or(Bool(false));
+    num_cores_ = executor_config->GetAttr<Integer>("num-cores").value_or(1).IntValue();
+    CHECK_GE(num_cores_, 1) << "num-cores must be positive (got: " << num_cores_ << ")";
 
     // Validate choice of unpacked_api and use_call_cpacked_
     if (runtime_config->name == kTvmRuntimeCrt) {
@@ -1205,18 +1310,22 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     Array<tir::Var> outputs =
         Array<tir::Var>(outputs_begin_iterator, main_func_params_end_iterator - devices.size());
 
-    lowered_mod->Update(GlobalVar(::tvm::runtime::symbol::tvm_module_main), tir_main_func);
-    // Parallel for loops are not supported in AoT codegen.
+    // Parallel for loops are not supported in AoT codegen. The main function is added afterwards,
+    // its levels run in parallel when num-cores > 1.
     lowered_mod = tir::transform::ConvertForLoopsToSerial()(lowered_mod);
+    lowered_mod->Update(GlobalVar(::tvm::runtime::symbol::tvm_module_main), tir_main_func);
 
     // Check USMP option
     bool enable_usmp = false;
-    if (runtime_config->name == kTvmRuntimeCrt) {
+    if (runtime_config->name == kTvmRuntimeCrt && num_cores_ == 1) {
       enable_usmp = true;
     }
     if (pass_ctx->GetConfig<Bool>(kUSMPEnableOption) != nullptr) {
       enable_usmp = pass_ctx->GetConfig<Bool>(kUSMPEnableOption, Bool(false)).value();
     }
+    // USMP plans the workspaces of the operators as if they ran one after the other.
+    CHECK(!enable_usmp || num_cores_ == 1)
+        << "USMP is not supported with num-cores > 1 (got: " << num_cores_ << ")";
 
     if (enable_usmp) {
       lowered_mod = PlanMemoryWithUSMP(lowered_mod);
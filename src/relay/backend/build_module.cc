@@ -332,7 +332,6 @@ class RelayBuildModule : public runtime::ModuleNode {
 
     Array<Pass> pass_seqs =
         GetPassPrefix(/*is_homogenous=*/config_->primitive_targets.size() == 1, /*is_vm=*/false);
-    transform::PassContext pass_ctx = PassContext::Current();
 
     if (config_->optional_homogeneous_target.defined()) {
       // This pass currently only supports the homogeneous case.
@@ -358,34 +357,10 @@ class RelayBuildModule : public runtime::ModuleNode {
       relay_module = seq(relay_module);
     }
 
-    // Do layout rewrite for auto-scheduler.
-    if (backend::IsAutoSchedulerEnabled() && config_->optional_homogeneous_target.defined()) {
-      Pass major_pass = transform::AutoSchedulerLayoutRewrite();
-      bool enable_layout_rewrite_targets =
-          config_->optional_homogeneous_target->GetTargetDeviceType() == kDLCPU ||
-          config_->optional_homogeneous_target->GetAttr<String>("device", "") == "mali";
-      if (enable_layout_rewrite_targets && pass_ctx.PassEnabled(major_pass->Info())) {
-        With<Target> tctx(config_->optional_homogeneous_target);
-        relay_module = major_pass(relay_module);
-        // Defuse ops to fold constants, then fuse them again
-        relay_module = transform::DefuseOps()(relay_module);
-        relay_module = transform::FoldConstant()(relay_module);
-        relay_module = transform::FuseOps()(relay_module);
-      }
-    }
-    if (backend::IsMetaScheduleEnabled() && config_->optional_homogeneous_target.defined()) {
-      Pass major_pass = transform::MetaScheduleLayoutRewrite();
-      bool enable_layout_rewrite_targets =
-          config_->optional_homogeneous_target->GetTargetDeviceType() == kDLCPU ||
-          config_->optional_homogeneous_target->GetAttr<String>("device", "") == "mali";
-      if (enable_layout_rewrite_targets && pass_ctx.PassEnabled(major_pass->Info())) {
-        With<Target> tctx(config_->optional_homogeneous_target);
-        relay_module = major_pass(relay_module);
-        // Defuse ops to fold constants, then fuse them again
-        relay_module = transform::DefuseOps()(relay_module);
-        relay_module = transform::FoldConstant()(relay_module);
-        relay_module = transform::FuseOps()(relay_module);
-      }
+    // Do layout rewrite for auto-scheduler and meta-schedule, pre-packing the constant weights.
+    if (Optional<Pass> prepack =
+            GetLayoutRewritePrePackPass(config_->optional_homogeneous_target)) {
+      relay_module = prepack.value()(relay_module);
     }
 
     relay_module = transform::InferType()(relay_module);
@@ -54,11 +54,13 @@ Target GetCCompilerTarget() {
 class CodegenC : public backend::MemoizedExprTranslator<std::vector<Output>>, public CodegenCBase {
  public:
   CodegenC(std::unordered_map<std::string, runtime::NDArray>* const_name_to_constant,
-           Array<String>* const_names, bool* needs_extra_headers, std::string ext_func_id)
+           Array<String>* const_names, bool* needs_extra_headers, std::string ext_func_id,
+           bool unpacked_api)
       : const_name_to_constant_(const_name_to_constant),
         const_names_(const_names),
         needs_extra_headers_(needs_extra_headers),
-        ext_func_id_(std::move(ext_func_id)) {}
+        ext_func_id_(std::move(ext_func_id)),
+        unpacked_api_(unpacked_api) {}
 
   /*!
    * \brief Emit the source code that invokes C compiler compatible wrappers.
@@ -70,7 +72,8 @@ class CodegenC : public backend::MemoizedExprTranslator<std::vector<Output>>, pu
     for (auto decl : func_decl_) {
       code_stream_ << decl << "\n";
     }
-    return JitImpl(ext_func_id_, ext_func_args_, buf_decl_, ext_func_body_, const_array_name_, out);
+    return JitImpl(ext_func_id_, ext_func_args_, buf_decl_, ext_func_body_, const_array_name_, out,
+                   unpacked_api_);
   }
 
  private:
@@ -221,6 +224,8 @@ class CodegenC : public backend::MemoizedExprTranslator<std::vector<Output>>, pu
   bool* needs_extra_headers_;
   /*! \brief Name of the global function currently being compiled. */
   std::string ext_func_id_;
+  /*! \brief Whether the global function is called with the unpacked API. */
+  bool unpacked_api_;
 
   /*! \brief The index of the next available wrapped C function. */
   int func_idx = 0;
@@ -310,12 +315,23 @@ class CodegenCModule {
   void GenCFunc(const Function& function) {
     ICHECK(function.defined()) << "Input error: expect a Relay function.";
     std::string ext_func_id = backend::GetExtSymbol(function);
-    CodegenC builder(&const_name_to_constant_, &const_names_, &needs_extra_headers_, ext_func_id);
+    CodegenC builder(&const_name_to_constant_, &const_names_, &needs_extra_headers_, ext_func_id,
+                     UseUnpackedAPI());
     std::vector<Output> out = builder.VisitExpr(function->body);
     code_stream_ << builder.JIT(out);
     func_names_.push_back(ext_func_id);
   }
 
+  /*!
+   * \brief Returns true if the functions are called by the AOT executor with the unpacked API,
+   * i.e. directly with the data pointers of the tensors.
+   */
+  bool UseUnpackedAPI() const {
+    Optional<Executor> executor = mod_->GetAttr<Executor>(tvm::attr::kExecutor);
+    return executor.defined() && executor.value()->name == "aot" &&
+           executor.value()->GetAttr<Bool>("unpacked-api").value_or(Bool(false));
+  }
+
   /*! \brief Returns function if it is tagged with "Compiler=ccompiler". */
   static const FunctionNode* GetCCompilerFunctionNode(const Expr& expr) {
     if (const auto* function_node = expr.as<FunctionNode>()) {
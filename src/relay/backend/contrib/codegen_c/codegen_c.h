@@ -159,13 +159,31 @@ class CodegenCBase {
    * TVM_DLL_EXPORT_TYPED_FUNC(__init_foo, foo_init_wrapper_);
    *
    * \endcode
+   *
+   * With \p unpacked_api, foo is instead called directly by the AOT executor with the data
+   * pointers of its arguments, and no DLTensor wrapper is generated:
+   *
+   * \code
+   *
+   * TVM_DLL int32_t foo(void* arg0, void* arg1, void* out0) {
+   *   foo_((float*)arg0, (float*)arg1, (float*)out0);
+   *   return 0;
+   * }
+   *
+   * \endcode
    */
   void GenerateBackendCFunc(const std::string& func_name, const Array<Var>& args,
                             const std::string& const_arr_name, const std::vector<Output>& outs,
-                            bool pass_dl_tensor = false) {
+                            bool pass_dl_tensor = false, bool unpacked_api = false) {
     // Print signature
     code_stream_ << "\n";
 
+    if (unpacked_api) {
+      ICHECK(!pass_dl_tensor) << "The unpacked API only passes the data of the tensors";
+      GenerateUnpackedCFunc(func_name, args, outs);
+      return;
+    }
+
     code_stream_ << "int " << func_name << "_wrapper_(";
     for (size_t i = 0; i < args.size(); i++) {
       code_stream_ << "DLTensor* arg" << i << ",\n";
@@ -256,6 +274,41 @@ class CodegenCBase {
     }
   }
 
+  /*!
+   * \brief Generate the unpacked API entry of the external function, see GenerateBackendCFunc.
+   */
+  void GenerateUnpackedCFunc(const std::string& func_name, const Array<Var>& args,
+                             const std::vector<Output>& outs) {
+    code_stream_ << "#ifdef __cplusplus\n";
+    code_stream_ << "extern \"C\" {\n";
+    code_stream_ << "#endif\n";
+    code_stream_ << "TVM_DLL int32_t " << func_name << "(";
+    for (size_t i = 0; i < args.size(); i++) {
+      code_stream_ << "void* arg" << i << ", ";
+    }
+    for (size_t i = 0; i < outs.size() - 1; i++) {
+      code_stream_ << "void* out" << i << ", ";
+    }
+    code_stream_ << "void* out" << outs.size() - 1 << ") {\n";
+    EnterScope();
+    PrintIndents();
+    code_stream_ << func_name << "_(";
+    for (size_t i = 0; i < args.size(); i++) {
+      code_stream_ << "(" << GetDtypeString(args[i]) << "*)arg" << i << ", ";
+    }
+    for (size_t i = 0; i < outs.size() - 1; i++) {
+      code_stream_ << "(" << outs[i].dtype << "*)out" << i << ", ";
+    }
+    code_stream_ << "(" << outs.back().dtype << "*)out" << outs.size() - 1 << ");\n";
+    PrintIndents();
+    code_stream_ << "return 0;\n";
+    ExitScope();
+    code_stream_ << "}\n";
+    code_stream_ << "#ifdef __cplusplus\n";
+    code_stream_ << "}\n";
+    code_stream_ << "#endif\n";
+  }
+
   /*!
    * \brief Emit the code for external runtime.
    *
@@ -276,13 +329,14 @@ class CodegenCBase {
    * intermeidate of each external kernel.
    * \param body The statements of the external function.
    * \param out The name and id pairs for output.
+   * \param unpacked_api Whether the external function is called with the unpacked API.
    *
    * \return The emitted code string.
    */
   std::string JitImpl(const std::string& ext_func_id, const Array<Var>& args,
                       const std::vector<std::string>& buf_decl,
                       const std::vector<std::string>& body, const std::string& const_arr_name,
-                      const std::vector<Output>& outs) {
+                      const std::vector<Output>& outs, bool unpacked_api = false) {
     // Create a declaration for global ndarrays that contain constant data.
     if (!const_arr_name.empty()) {
       code_stream_ << "#ifdef __cplusplus\n";
@@ -334,7 +388,8 @@ class CodegenCBase {
     code_stream_ << "}\n";
 
     // Create the wrapper to call the ext_func
-    this->GenerateBackendCFunc(ext_func_id, args, const_arr_name, outs);
+    this->GenerateBackendCFunc(ext_func_id, args, const_arr_name, outs, /*pass_dl_tensor=*/false,
+                               unpacked_api);
     return code_stream_.str();
   }
 
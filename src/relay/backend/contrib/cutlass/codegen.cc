@@ -344,15 +344,34 @@ class CutlassModuleCodegen {
   explicit CutlassModuleCodegen(IRModule mod) : mod_(std::move(mod)) {}
 
   runtime::Module CreateCSourceModule() {
+    GenCutlassFuncs();
+    std::ostringstream code_stream;
+    for (const auto& code : func_codes_) code_stream << code;
+    return Finalize(code_stream.str(), func_names_);
+  }
+
+  /*!
+   * \brief Create one CSourceModule per CUTLASS function, so that the kernels can be compiled
+   * as separate translation units in parallel.
+   */
+  Array<runtime::Module> CreateCSourceModules() {
+    GenCutlassFuncs();
+    Array<runtime::Module> modules;
+    for (size_t i = 0; i < func_codes_.size(); ++i) {
+      modules.push_back(Finalize(func_codes_[i], {func_names_[i]}));
+    }
+    return modules;
+  }
+
+ private:
+  void GenCutlassFuncs() {
     for (const auto& entry : mod_->functions) {
       if (const auto* function_node = GetCutlassFunctionNode(entry.second)) {
         GenCutlassFunc(GetRef<Function>(function_node));
       }
     }
-    return Finalize(code_stream_.str(), func_names_);
   }
 
- private:
   void GenCutlassFunc(const Function& function) {
     ICHECK(function.defined()) << "Input error: expect a Relay function.";
 
@@ -373,11 +392,12 @@ class CutlassModuleCodegen {
     CodegenCutlass builder(sid, dict);
     VLOG(1) << "Creating cutlass C code for '" << sid << "' from:\n" << PrettyPrint(function);
     auto out = builder.VisitExpr(function->body);
-    auto code = builder.JIT(out);
+    std::ostringstream code_stream;
     for (const auto& header : builder.GetHeaders()) {
-      code_stream_ << "#include <" << header << ">\n";
+      code_stream << "#include <" << header << ">\n";
     }
-    code_stream_ << "\n" + code;
+    code_stream << "\n" + builder.JIT(out);
+    func_codes_.push_back(code_stream.str());
   }
 
   /*!
@@ -396,8 +416,8 @@ class CutlassModuleCodegen {
 
   /*! \brief Module we are compiling. */
   IRModule mod_;
-  /*! \brief The accumulated code stream that will be compiled by NVCC */
-  std::ostringstream code_stream_;
+  /*! \brief The code of each function that will be compiled by NVCC */
+  std::vector<std::string> func_codes_;
   /*! \brief The accumulated function names. */
   Array<String> func_names_;
 };  // CutlassModuleCodegen
@@ -426,9 +446,16 @@ runtime::Module CreateCSourceModule(const IRModule& mod) {
   return CutlassModuleCodegen(mod).CreateCSourceModule();
 }
 
+Array<runtime::Module> CreateCSourceModules(const IRModule& mod) {
+  VLOG(1) << "Creating CUTLASS CSource modules from:" << std::endl << PrettyPrint(mod);
+  return CutlassModuleCodegen(mod).CreateCSourceModules();
+}
+
 }  // namespace
 
 TVM_REGISTER_GLOBAL("relay.ext.cutlass.create_c_source_module").set_body_typed(CreateCSourceModule);
+TVM_REGISTER_GLOBAL("relay.ext.cutlass.create_c_source_modules")
+    .set_body_typed(CreateCSourceModules);
 
 tvm::transform::Pass CompileForCutlass() {
   return transform::Sequential(
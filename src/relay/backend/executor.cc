@@ -65,6 +65,13 @@ Executor Executor::Create(String name, Map<String, ObjectRef> attrs) {
     }
   }
 
+  // The C interface calls the operators and external functions directly with their arguments
+  // statically allocated, unless the packed API is explicitly requested.
+  if (name == "aot" && !attrs.count("unpacked-api") && attrs.count("interface-api") &&
+      Downcast<String>(attrs.at("interface-api")) == "c") {
+    attrs.Set("unpacked-api", Bool(true));
+  }
+
   return Executor(name, DictAttrs(attrs));
 }
 
@@ -93,7 +100,8 @@ TVM_REGISTER_EXECUTOR("aot")
     .add_attr_option<Bool>("unpacked-api")
     .add_attr_option<String>("interface-api")
     .add_attr_option<Integer>("workspace-byte-alignment")
-    .add_attr_option<Integer>("constant-byte-alignment");
+    .add_attr_option<Integer>("constant-byte-alignment")
+    .add_attr_option<Integer>("num-cores");
 
 TVM_REGISTER_EXECUTOR("graph").add_attr_option<Bool>("link-params", Bool(false));
 
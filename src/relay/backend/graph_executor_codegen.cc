@@ -243,6 +243,10 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     // We need to unfortunately re-plan as the previous results have been invalidated by lowering
     // we will fix this in future refactors.
     memory_plan_ = GraphPlanMemory(lowered_main_func);
+    for (const auto& kv : memory_plan_->arena_sizes) {
+      LOG(INFO) << "Packed the intermediate tensors of storage " << kv.first << " in "
+                << kv.second << " bytes";
+    }
 
     // The graph planner also can not handle planning calls to global variables to we must remap
 
@@ -310,6 +314,9 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       storage_ids.push_back(v);
     }
     node->attrs_["storage_id"] = std::move(storage_ids);
+    if (!storage_info->storage_offsets_in_bytes.empty()) {
+      node->attrs_["storage_offset"] = storage_info->storage_offsets_in_bytes;
+    }
     // type
     std::vector<int64_t> device_types;
     for (const auto& virtual_device : storage_info->virtual_devices) {
@@ -536,6 +543,7 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     size_t num_entry = 0;
     ShapeVector shapes;
     std::vector<size_t> storage_ids;
+    std::vector<size_t> storage_offsets;
     std::vector<std::string> storage_scopes;
     std::vector<size_t> device_types;
     std::vector<std::string> dltypes;
@@ -553,6 +561,11 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       shapes.insert(shapes.end(), shape_vec.begin(), shape_vec.end());
       dltypes.insert(dltypes.end(), dtype_vec.begin(), dtype_vec.end());
       storage_ids.insert(storage_ids.end(), storage_id.begin(), storage_id.end());
+      if (node->attrs_.count("storage_offset")) {
+        const auto& offsets = dmlc::get<std::vector<int64_t>>(node->attrs_["storage_offset"]);
+        storage_offsets.resize(num_entry - node->num_outputs_);
+        storage_offsets.insert(storage_offsets.end(), offsets.begin(), offsets.end());
+      }
       storage_scopes.insert(storage_scopes.end(), storage_scope.begin(), storage_scope.end());
       if (node->attrs_.count("device_index")) {
         const auto& dev_types = dmlc::get<std::vector<int64_t>>(node->attrs_["device_index"]);
@@ -581,6 +594,11 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     attrs["shape"].emplace_back(shapes);
     attrs["storage_id"].emplace_back(std::string("list_int"));
     attrs["storage_id"].emplace_back(storage_ids);
+    if (storage_offsets.size()) {
+      storage_offsets.resize(num_entry);
+      attrs["storage_offset"].emplace_back(std::string("list_int"));
+      attrs["storage_offset"].emplace_back(storage_offsets);
+    }
     if (device_types.size()) {
       attrs["device_index"].emplace_back(std::string("list_int"));
       attrs["device_index"].emplace_back(device_types);
@@ -648,6 +666,13 @@ class GraphExecutorCodegenModule : public runtime::ModuleNode {
     } else if (name == "get_graph_json") {
       return PackedFunc(
           [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->output_.graph_json; });
+    } else if (name == "get_graph_binary") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        const PackedFunc* encode = runtime::Registry::Get("tvm.graph_executor.encode_binary_graph");
+        ICHECK(encode != nullptr) << "Cannot find tvm.graph_executor.encode_binary_graph, "
+                                     "is the graph executor enabled?";
+        *rv = (*encode)(this->output_.graph_json);
+      });
     } else if (name == "list_params_name") {
       return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
         Array<runtime::String> ret;
@@ -21,6 +21,10 @@
  * \file relay/backend/graph_plan_memory.cc
  * \brief Memory index assignment pass for executing
  *   the program in the graph executor.
+ *
+ *  With relay.backend.graph_memory_planner set to "greedy_by_size", the intermediate
+ *  1d tensors are packed at offsets of one storage per virtual device, instead of
+ *  reusing whole storages of a close enough size.
  */
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
@@ -211,7 +215,7 @@ class StorageAllocaInit : protected StorageAllocaBaseVisitor {
 /*! \brief Associate storage with every expression, reusing storage where possible. */
 class StorageAllocator : public StorageAllocaBaseVisitor {
  public:
-  StorageAllocator() = default;
+  explicit StorageAllocator(bool use_arena) : allocator_(use_arena) {}
 
   /*!
    * \return total number of bytes allocated
@@ -230,6 +234,7 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     VLOG(1) << "planning:" << std::endl << PrettyPrint(func);
     prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
     this->Run(func);
+    Map<Integer, Integer> arena_sizes = allocator_.PlanArenas();
 
     // The value of smap contains two integer arrays where the first array
     // contains the planned storage ids and the second holds the device types.
@@ -244,6 +249,7 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
       virtual_devices.reserve(kv.second.size());
       std::vector<int64_t> sid_sizes_byte;
       sid_sizes_byte.reserve(kv.second.size());
+      std::vector<int64_t> sid_offsets_byte;
 
       for (StorageToken* tok : kv.second) {
         VLOG(1) << "token: " << tok->ToString();
@@ -254,9 +260,13 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
         storage_ids.push_back(tok->storage_id);
         virtual_devices.push_back(tok->virtual_device);
         sid_sizes_byte.push_back(allocator_.GetMemorySize(tok));
+        if (!arena_sizes.empty()) {
+          sid_offsets_byte.push_back(static_cast<int64_t>(tok->offset));
+        }
       }
-      auto storage_info = backend::StorageInfo(std::move(storage_ids), std::move(virtual_devices),
-                                               std::move(sid_sizes_byte));
+      auto storage_info =
+          backend::StorageInfo(std::move(storage_ids), std::move(virtual_devices),
+                               std::move(sid_sizes_byte), std::move(sid_offsets_byte));
       smap.Set(GetRef<Expr>(kv.first), storage_info);
     }
     // Either all or none of the nodes should be annotated.
@@ -267,7 +277,7 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
                  << "expressions are assigned with virtual device types. Either all "
                     "or none of the expressions are expected to be annotated.";
     }
-    return backend::StaticMemoryPlan(smap);
+    return backend::StaticMemoryPlan(smap, arena_sizes);
   }
 
  protected:
@@ -356,17 +366,35 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
 
   class TokenAllocator {
    public:
+    explicit TokenAllocator(bool use_arena) : use_arena_(use_arena) {}
+
     StorageToken* Alloc(StorageToken* proto) {
       return Is2DStorage(proto) ? token_2d_.Alloc(proto, storage_ids_++)
                                 : token_1d_.Alloc(proto, storage_ids_++);
     }
     StorageToken* Request(StorageToken* proto) {
+      if (use_arena_ && !Is2DStorage(proto)) {
+        return token_arena_.Alloc(proto, token_1d_.GetMemorySize(proto));
+      }
       StorageToken* token =
           Is2DStorage(proto) ? token_2d_.Request(proto) : token_1d_.Request(proto);
       return token ? token : this->Alloc(proto);
     }
     void CheckForRelease(StorageToken* tok) {
-      return Is2DStorage(tok) ? token_2d_.CheckForRelease(tok) : token_1d_.CheckForRelease(tok);
+      if (Is2DStorage(tok)) {
+        token_2d_.CheckForRelease(tok);
+      } else if (!token_arena_.CheckForRelease(tok)) {
+        token_1d_.CheckForRelease(tok);
+      }
+    }
+    /*!
+     * \brief Place the arena tokens once the lifetimes of all the tokens are known.
+     * \return The size in bytes of each arena, keyed by its storage id.
+     */
+    Map<Integer, Integer> PlanArenas() {
+      Map<Integer, Integer> arena_sizes;
+      storage_ids_ = token_arena_.Plan(storage_ids_, &arena_sizes);
+      return arena_sizes;
     }
 
     size_t GetMemorySize(StorageToken* tok) {
@@ -381,9 +409,11 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     }
 
    private:
+    bool use_arena_;
     int64_t storage_ids_{0};
     TokenAllocator1D token_1d_;
     TokenAllocator2D token_2d_;
+    TokenAllocatorArena token_arena_;
   };
 
  private:
@@ -401,7 +431,17 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   TokenAllocator allocator_;
 };
 
-StaticMemoryPlan GraphPlanMemory(const Function& func) { return StorageAllocator().Plan(func); }
+StaticMemoryPlan GraphPlanMemory(const Function& func) {
+  String planner = transform::PassContext::Current()
+                       ->GetConfig<String>("relay.backend.graph_memory_planner", String("token"))
+                       .value();
+  ICHECK(planner == "token" || planner == "greedy_by_size")
+      << "relay.backend.graph_memory_planner must be \"token\" or \"greedy_by_size\", got "
+      << planner;
+  return StorageAllocator(planner == "greedy_by_size").Plan(func);
+}
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.graph_memory_planner", String);
 
 TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory").set_body_typed(GraphPlanMemory);
 
@@ -112,6 +112,7 @@
 #include <mutex>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -317,7 +318,15 @@ class TECompilerImpl : public TECompilerNode {
     device_contexts_ = device_contexts;
   }
 
-  void Clear() final { cache_.clear(); }
+  bool MarkEmitted(const GlobalVar& var) final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return emitted_.insert(var->name_hint).second;
+  }
+
+  void Clear() final {
+    cache_.clear();
+    emitted_.clear();
+  }
 
   // List all items in the cache.
   Array<ObjectRef> ListItems() {
@@ -534,6 +543,8 @@ class TECompilerImpl : public TECompilerNode {
   CCacheKey cur_ccache_key_;
   /*! \brief Map of GlobalVar to C Device API context names */
   Map<GlobalVar, String> device_contexts_;
+  /*! \brief The lowered functions emitted by the builds sharing this compiler */
+  std::unordered_set<std::string> emitted_;
 };
 
 TECompiler::TECompiler(Optional<IRModule> opt_mod, Optional<String> mod_name) {
@@ -552,11 +563,19 @@ TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_auto_scheduler", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule_dispatch", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.tir_converter", String);
+// A compiler shared by several builds, which then lower each primitive function once and emit it
+// in the first build using it. The later builds call it without emitting it, so their libraries
+// must be linked with the earlier ones.
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.te_compiler", TECompiler);
 
 TVM_REGISTER_GLOBAL("relay.backend._TECompilerGlobal").set_body_typed([]() {
   return TECompiler::Global();
 });
 
+TVM_REGISTER_GLOBAL("relay.backend._TECompiler").set_body_typed([](String mod_name) {
+  return TECompiler(Optional<IRModule>(), mod_name);
+});
+
 TVM_REGISTER_GLOBAL("relay.backend._make_CCacheKey")
     .set_body_typed([](Function source_func, Target target) {
       return CCacheKey(source_func, target);
@@ -1186,7 +1205,10 @@ void UpdateFunctionMetadata(BaseFunc func,
 /*! \brief Main lowering driving. */
 IRModule LowerTE(const IRModule& module, const String& module_name, ProcessFn process_fn,
                  CompilationConfig config) {
-  TECompiler compiler(module, module_name);
+  Optional<TECompiler> shared_compiler =
+      tvm::transform::PassContext::Current()->GetConfig<TECompiler>("relay.backend.te_compiler");
+  TECompiler compiler =
+      shared_compiler ? shared_compiler.value() : TECompiler(module, module_name);
 
   // TODO(mbs): This is all unnecessarily convoluted. Better would be to accumulate the rewritten
   // module as we go (including rewritten Functions, lowered primitives, and runtime modules
@@ -1220,7 +1242,12 @@ IRModule LowerTE(const IRModule& module, const String& module_name, ProcessFn pr
                  << "while new is:" << std::endl
                  << PrettyPrint(kv.second);
     }
-    updated_module->Add(kv.first, kv.second);
+    BaseFunc func = kv.second;
+    if (!compiler->MarkEmitted(kv.first)) {
+      // Emitted by an earlier build sharing the compiler, only kept to type the calls.
+      func = WithAttr(Downcast<tir::PrimFunc>(func), attr::kExtern, Integer(1));
+    }
+    updated_module->Add(kv.first, func);
   }
 
   // Invoke external codegen for all Functions in the cache tagged with "Compiler", and
@@ -1276,6 +1303,8 @@ Map<Target, IRModule> GetPerTargetModules(IRModule mod) {
     const GlobalVar& var = kv.first;
     const BaseFunc& func = kv.second;
     if (func->IsInstance<tir::PrimFuncNode>()) {
+      // Skip the functions emitted by an earlier build sharing the TECompiler
+      if (func->HasNonzeroAttr(attr::kExtern)) continue;
       // Extract target
       Optional<Target> target = func->GetAttr<Target>(tvm::attr::kTarget);
       ICHECK(target) << "Target should be set at this point";
@@ -125,6 +125,13 @@ class TECompilerNode : public Object {
 
   virtual Map<String, Integer> GetOpWeights() const = 0;
 
+  /*!
+   * \brief Record that a lowered function is emitted into the module being built.
+   * \param var The lowered function.
+   * \return Whether no earlier build sharing this compiler emitted the function.
+   */
+  virtual bool MarkEmitted(const GlobalVar& var) = 0;
+
   /*! \brief clear the cache. */
   virtual void Clear() = 0;
 
@@ -24,6 +24,7 @@
 
 #include "token_allocator.h"
 
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/op.h>
 
 #include <algorithm>
@@ -100,6 +101,93 @@ void TokenAllocator1D::CheckForRelease(StorageToken* tok) {
   }
 }
 
+StorageToken* TokenAllocatorArena::Alloc(StorageToken* prototype, size_t size) {
+  prototype->max_bytes = size;
+  token_index_[prototype] = lifetimes_.size();
+  lifetimes_.push_back({prototype, clock_++, std::numeric_limits<size_t>::max()});
+  return prototype;
+}
+
+bool TokenAllocatorArena::CheckForRelease(StorageToken* tok) {
+  auto it = token_index_.find(tok);
+  if (it == token_index_.end()) {
+    return false;
+  }
+  ICHECK_GE(tok->ref_counter, 0);
+  Lifetime& lifetime = lifetimes_[it->second];
+  if (tok->ref_counter == 0 && lifetime.end == std::numeric_limits<size_t>::max()) {
+    lifetime.end = clock_++;
+  }
+  return true;
+}
+
+int64_t TokenAllocatorArena::Plan(int64_t storage_id, Map<Integer, Integer>* arena_sizes) {
+  auto align = [](size_t value) {
+    return (value + runtime::kAllocAlignment - 1) / runtime::kAllocAlignment *
+           runtime::kAllocAlignment;
+  };
+  // one arena per virtual device
+  std::vector<std::vector<Lifetime*>> arenas;
+  for (Lifetime& lifetime : lifetimes_) {
+    auto it = std::find_if(arenas.begin(), arenas.end(), [&](const std::vector<Lifetime*>& arena) {
+      return arena[0]->token->is_compatible(*lifetime.token);
+    });
+    if (it == arenas.end()) {
+      arenas.push_back({&lifetime});
+    } else {
+      it->push_back(&lifetime);
+    }
+  }
+  for (std::vector<Lifetime*>& arena : arenas) {
+    std::stable_sort(arena.begin(), arena.end(), [](const Lifetime* lhs, const Lifetime* rhs) {
+      return lhs->token->max_bytes > rhs->token->max_bytes;
+    });
+    size_t arena_bytes = 0;
+    size_t total_bytes = 0;
+    std::vector<const Lifetime*> placed;
+    std::vector<const Lifetime*> live;
+    for (Lifetime* lifetime : arena) {
+      StorageToken* tok = lifetime->token;
+      live.clear();
+      for (const Lifetime* other : placed) {
+        if (other->begin <= lifetime->end && lifetime->begin <= other->end) {
+          live.push_back(other);
+        }
+      }
+      std::sort(live.begin(), live.end(), [](const Lifetime* lhs, const Lifetime* rhs) {
+        return lhs->token->offset < rhs->token->offset;
+      });
+      // best fit among the gaps between the live tokens, otherwise on top of them
+      size_t offset = 0;
+      size_t best_offset = std::numeric_limits<size_t>::max();
+      size_t best_gap = std::numeric_limits<size_t>::max();
+      for (const Lifetime* other : live) {
+        size_t other_offset = other->token->offset;
+        if (other_offset >= offset + tok->max_bytes && other_offset - offset < best_gap) {
+          best_gap = other_offset - offset;
+          best_offset = offset;
+        }
+        offset = std::max(offset, align(other_offset + other->token->max_bytes));
+      }
+      if (best_offset == std::numeric_limits<size_t>::max()) {
+        best_offset = offset;
+      }
+      tok->storage_id = storage_id;
+      tok->offset = best_offset;
+      arena_bytes = std::max(arena_bytes, best_offset + tok->max_bytes);
+      total_bytes += tok->max_bytes;
+      placed.push_back(lifetime);
+    }
+    VLOG(1) << "arena storage_id " << storage_id << " on " << arena[0]->token->virtual_device
+            << " packs " << arena.size() << " tensors of " << total_bytes << " bytes in "
+            << arena_bytes << " bytes";
+    arena_sizes->Set(Integer(static_cast<int>(storage_id)),
+                     Integer(IntImm(DataType::Int(64), static_cast<int64_t>(arena_bytes))));
+    ++storage_id;
+  }
+  return storage_id;
+}
+
 StorageToken* TokenAllocator2D::Request(StorageToken* prototype) {
   auto shape = GetSize2D(prototype);
   const int64_t max_ratio = 5;
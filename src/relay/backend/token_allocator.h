@@ -50,6 +50,8 @@ struct StorageToken {
   VirtualDevice virtual_device = VirtualDevice::FullyUnconstrained();
   /*! \brief The storage id */
   int64_t storage_id{-1};
+  /*! \brief The byte offset within the storage */
+  size_t offset{0};
 
   bool is_valid() const { return !virtual_device->IsFullyUnconstrained(); }
 
@@ -115,6 +117,52 @@ class TokenAllocator1D {
   std::vector<StorageToken*> data_;
 };
 
+/**
+ * @brief Memory manager packing flattened 1d buffers at offsets of one arena per virtual device
+ *
+ * Tokens are never shared while the expressions are visited, each request gets its own token
+ * and the interval between its allocation and its release is recorded. Plan then places the
+ * tokens by decreasing size, each one in the tightest gap left between the tokens already
+ * placed whose lifetime overlaps its own, or above all of them if no gap fits.
+ */
+class TokenAllocatorArena {
+ public:
+  /*!
+   * \brief Allocate a token by consuming the prototype, its offset is set by Plan.
+   * \param prototype The prototype token.
+   * \param size The size of memory being requested.
+   * \return The result token.
+   */
+  StorageToken* Alloc(StorageToken* prototype, size_t size);
+  /*!
+   * \brief Check if we can release token.
+   * \param tok The token to be released.
+   * \return Whether the token is one of the arena tokens.
+   */
+  bool CheckForRelease(StorageToken* tok);
+  /*!
+   * \brief Assign the arena storage ids and the offsets of all the allocated tokens.
+   * \param storage_id The first storage id to use for the arenas.
+   * \param arena_sizes Updated with the size in bytes of each arena.
+   * \return The next free storage id.
+   */
+  int64_t Plan(int64_t storage_id, Map<Integer, Integer>* arena_sizes);
+
+ private:
+  struct Lifetime {
+    StorageToken* token;
+    size_t begin;
+    size_t end;
+  };
+
+  // the logical clock ticking at each allocation and release
+  size_t clock_{0};
+  // the lifetime of the tokens, in allocation order
+  std::vector<Lifetime> lifetimes_;
+  // the index of each token in lifetimes_
+  std::unordered_map<const StorageToken*, size_t> token_index_;
+};
+
 /**
  * @brief Memory manager for 2d memory (textures)
  */
@@ -54,18 +54,28 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
       for (auto bytes : node->storage_sizes_in_bytes) {
         p->stream << bytes << ",";
       }
+      if (!node->storage_offsets_in_bytes.empty()) {
+        p->stream << "], storage_offsets_in_bytes=[";
+        for (auto offset : node->storage_offsets_in_bytes) {
+          p->stream << offset << ",";
+        }
+      }
       p->stream << "])";
     });
 
 StorageInfo::StorageInfo(std::vector<int64_t> storage_ids,
                          std::vector<VirtualDevice> virtual_devices,
-                         std::vector<int64_t> storage_sizes_in_bytes) {
+                         std::vector<int64_t> storage_sizes_in_bytes,
+                         std::vector<int64_t> storage_offsets_in_bytes) {
   ICHECK_EQ(storage_ids.size(), virtual_devices.size());
   ICHECK_EQ(storage_ids.size(), storage_sizes_in_bytes.size());
+  ICHECK(storage_offsets_in_bytes.empty() ||
+         storage_ids.size() == storage_offsets_in_bytes.size());
   auto node = make_object<StorageInfoNode>();
   node->storage_ids = std::move(storage_ids);
   node->virtual_devices = std::move(virtual_devices);
   node->storage_sizes_in_bytes = std::move(storage_sizes_in_bytes);
+  node->storage_offsets_in_bytes = std::move(storage_offsets_in_bytes);
   data_ = std::move(node);
 }
 
@@ -117,6 +127,15 @@ TVM_REGISTER_GLOBAL("relay.ir.StorageInfoStorageSizes").set_body_typed([](Storag
   return storage_sizes_in_bytes;
 });
 
+TVM_REGISTER_GLOBAL("relay.ir.StorageInfoStorageOffsets").set_body_typed([](StorageInfo si) {
+  Array<tvm::Integer> storage_offsets_in_bytes;
+  for (size_t i = 0; i < si->storage_ids.size(); ++i) {
+    storage_offsets_in_bytes.push_back(
+        si->storage_offsets_in_bytes.empty() ? 0 : si->storage_offsets_in_bytes[i]);
+  }
+  return storage_offsets_in_bytes;
+});
+
 TVM_REGISTER_GLOBAL("relay.ir.StorageInfoVirtualDevices").set_body_typed([](StorageInfo si) {
   Array<VirtualDevice> virtual_devices;
   for (auto id : si->virtual_devices) {
@@ -127,9 +146,11 @@ TVM_REGISTER_GLOBAL("relay.ir.StorageInfoVirtualDevices").set_body_typed([](Stor
 
 TVM_REGISTER_NODE_TYPE(StaticMemoryPlanNode);
 
-StaticMemoryPlan::StaticMemoryPlan(Map<Expr, StorageInfo> expr_to_storage_info) {
+StaticMemoryPlan::StaticMemoryPlan(Map<Expr, StorageInfo> expr_to_storage_info,
+                                   Map<Integer, Integer> arena_sizes) {
   auto n = make_object<StaticMemoryPlanNode>();
   n->expr_to_storage_info = std::move(expr_to_storage_info);
+  n->arena_sizes = std::move(arena_sizes);
   data_ = std::move(n);
 }
 
@@ -284,6 +305,69 @@ Array<Pass> GetPassPrefix(bool is_homogeneous, bool is_vm) {
   return pass_seqs;
 }
 
+Optional<Pass> GetLayoutRewritePrePackPass(const Optional<Target>& homogeneous_target) {
+  if (!homogeneous_target.defined()) {
+    return NullOpt;
+  }
+  Target target = homogeneous_target.value();
+  bool enable_layout_rewrite_targets =
+      target->GetTargetDeviceType() == kDLCPU || target->GetAttr<String>("device", "") == "mali";
+  if (!enable_layout_rewrite_targets) {
+    return NullOpt;
+  }
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  Array<Pass> rewrite_passes;
+  if (IsAutoSchedulerEnabled()) {
+    Pass major_pass = transform::AutoSchedulerLayoutRewrite();
+    if (pass_ctx.PassEnabled(major_pass->Info())) {
+      rewrite_passes.push_back(major_pass);
+    }
+  }
+  if (IsMetaScheduleEnabled()) {
+    Pass major_pass = transform::MetaScheduleLayoutRewrite();
+    if (pass_ctx.PassEnabled(major_pass->Info())) {
+      rewrite_passes.push_back(major_pass);
+    }
+  }
+  if (rewrite_passes.empty()) {
+    return NullOpt;
+  }
+  // Defuse ops to fold constants, then fuse them again
+  rewrite_passes.push_back(transform::DefuseOps());
+  rewrite_passes.push_back(transform::FoldConstant());
+  Pass rewrite = transform::Sequential(rewrite_passes);
+
+  auto pass_func = [rewrite, target](IRModule mod, transform::PassContext ctx) -> IRModule {
+    // The layout rewrite passes look up the tuned schedules of the current target
+    With<Target> tctx(target);
+    mod = rewrite(std::move(mod));
+    // The layout transforms which are not folded run at every inference
+    static const Op& auto_scheduler_layout_transform = Op::Get("auto_scheduler_layout_transform");
+    static const Op& meta_schedule_layout_transform = Op::Get("meta_schedule_layout_transform");
+    int num_runtime_transforms = 0;
+    for (const auto& kv : mod->functions) {
+      if (const auto* func = kv.second.as<FunctionNode>()) {
+        PostOrderVisit(func->body, [&](const Expr& expr) {
+          if (const auto* call = expr.as<CallNode>()) {
+            if ((call->op == auto_scheduler_layout_transform ||
+                 call->op == meta_schedule_layout_transform) &&
+                !call->args[0]->IsInstance<ConstantNode>()) {
+              ++num_runtime_transforms;
+            }
+          }
+        });
+      }
+    }
+    if (num_runtime_transforms > 0) {
+      LOG(WARNING) << num_runtime_transforms
+                   << " weight layout transform(s) cannot be pre-packed at build time and will run "
+                      "at every inference. Bind the weights as params to pre-pack them.";
+    }
+    return transform::FuseOps()(std::move(mod));
+  };
+  return transform::CreateModulePass(pass_func, 0, "LayoutRewritePrePack", {});
+}
+
 std::unordered_map<Target, IRModule, TargetStrHash, TargetStrEqual>
 TargetModuleMapToTargetStrModuleMap(Map<Target, IRModule> input_map) {
   std::unordered_map<Target, IRModule, TargetStrHash, TargetStrEqual> std_map;
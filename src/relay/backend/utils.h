@@ -212,6 +212,11 @@ class StorageInfoNode : public Object {
   std::vector<VirtualDevice> virtual_devices;
   /* \brief The sizes of each storage element, in bytes. */
   std::vector<int64_t> storage_sizes_in_bytes;
+  /*!
+   * \brief The byte offsets of each storage element within its storage, empty when all the
+   * elements start at the beginning of their storage.
+   */
+  std::vector<int64_t> storage_offsets_in_bytes;
 
   // TODO(@jroesch): expose the fields
   void VisitAttrs(AttrVisitor* v) {}
@@ -224,7 +229,8 @@ class StorageInfoNode : public Object {
 class StorageInfo : public ObjectRef {
  public:
   StorageInfo(std::vector<int64_t> storage_ids, std::vector<VirtualDevice> virtual_devices,
-              std::vector<int64_t> storage_sizes_in_bytes);
+              std::vector<int64_t> storage_sizes_in_bytes,
+              std::vector<int64_t> storage_offsets_in_bytes = {});
   TVM_DEFINE_OBJECT_REF_METHODS(StorageInfo, ObjectRef, StorageInfoNode);
 };
 
@@ -234,8 +240,13 @@ class StorageInfo : public ObjectRef {
 class StaticMemoryPlanNode : public Object {
  public:
   Map<Expr, StorageInfo> expr_to_storage_info;
+  /*! \brief The size in bytes of each storage holding an arena of offset planned tensors. */
+  Map<Integer, Integer> arena_sizes;
 
-  void VisitAttrs(AttrVisitor* v) { v->Visit("expr_to_storage_info", &expr_to_storage_info); }
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("expr_to_storage_info", &expr_to_storage_info);
+    v->Visit("arena_sizes", &arena_sizes);
+  }
 
   static constexpr const char* _type_key = "relay.StaticMemoryPlan";
   TVM_DECLARE_FINAL_OBJECT_INFO(StaticMemoryPlanNode, Object);
@@ -244,7 +255,8 @@ class StaticMemoryPlanNode : public Object {
 /*! \brief The result of running static memory planning. */
 class StaticMemoryPlan : public ObjectRef {
  public:
-  explicit StaticMemoryPlan(Map<Expr, StorageInfo> expr_to_storage_info);
+  explicit StaticMemoryPlan(Map<Expr, StorageInfo> expr_to_storage_info,
+                            Map<Integer, Integer> arena_sizes = {});
   TVM_DEFINE_OBJECT_REF_METHODS(StaticMemoryPlan, ObjectRef, StaticMemoryPlanNode);
 };
 
@@ -684,6 +696,19 @@ inline IRModule PrimFuncToIRModule(tir::PrimFunc f) {
  */
 Array<Pass> GetPassPrefix(bool is_homogeneous, bool is_vm);
 
+/*!
+ * \brief Get the pass that pre-packs the weights whose layouts are rewritten by the
+ * auto-scheduler or meta-schedule, shared by the graph and the vm executors.
+ *
+ * The pass inserts the layout transforms recorded by the tuned schedules, folds them into the
+ * constant weights at build time so that the packed constants are stored in the artifact, and
+ * warns about the weights which are not constants and are thus transformed at every inference.
+ *
+ * \param homogeneous_target The target of homogeneous execution, if any.
+ * \return The pass, or NullOpt if no layout rewrite is enabled for the target.
+ */
+Optional<Pass> GetLayoutRewritePrePackPass(const Optional<Target>& homogeneous_target);
+
 /*! \brief Target hash function */
 struct TargetStrHash {
   /*!
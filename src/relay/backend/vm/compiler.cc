@@ -1062,35 +1062,11 @@ IRModule VMCompiler::OptimizeModuleImpl(IRModule mod) {
 
   pass_seqs.push_back(transform::FuseOps());
 
-  // Do layout rewrite for auto-scheduler.
+  // Do layout rewrite for auto-scheduler and meta-schedule, pre-packing the constant weights.
   transform::PassContext pass_ctx = PassContext::Current();
-  if (backend::IsAutoSchedulerEnabled() && config_->optional_homogeneous_target.defined()) {
-    Pass major_pass = transform::AutoSchedulerLayoutRewrite();
-    bool enable_layout_rewrite_targets =
-        config_->optional_homogeneous_target->GetTargetDeviceType() == kDLCPU ||
-        config_->optional_homogeneous_target->GetAttr<String>("device", "") == "mali";
-    if (enable_layout_rewrite_targets && pass_ctx.PassEnabled(major_pass->Info())) {
-      With<Target> tctx(config_->optional_homogeneous_target);
-      pass_seqs.push_back(major_pass);
-      // Defuse ops to fold constants, then fuse them again
-      pass_seqs.push_back(transform::DefuseOps());
-      pass_seqs.push_back(transform::FoldConstant());
-      pass_seqs.push_back(transform::FuseOps());
-    }
-  }
-  if (backend::IsMetaScheduleEnabled() && config_->optional_homogeneous_target.defined()) {
-    Pass major_pass = transform::MetaScheduleLayoutRewrite();
-    bool enable_layout_rewrite_targets =
-        config_->optional_homogeneous_target->GetTargetDeviceType() == kDLCPU ||
-        config_->optional_homogeneous_target->GetAttr<String>("device", "") == "mali";
-    if (enable_layout_rewrite_targets && pass_ctx.PassEnabled(major_pass->Info())) {
-      With<Target> tctx(config_->optional_homogeneous_target);
-      pass_seqs.push_back(major_pass);
-      // Defuse ops to fold constants, then fuse them again
-      pass_seqs.push_back(transform::DefuseOps());
-      pass_seqs.push_back(transform::FoldConstant());
-      pass_seqs.push_back(transform::FuseOps());
-    }
+  if (Optional<Pass> prepack =
+          backend::GetLayoutRewritePrePackPass(config_->optional_homogeneous_target)) {
+    pass_seqs.push_back(prepack.value());
   }
 
   pass_seqs.push_back(transform::ToANormalForm());
@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/collage/caching_cost_estimator.cc
+ * \brief A CostEstimator remembering the costs of candidate modules on disk across runs.
+ */
+
+#include "./caching_cost_estimator.h"
+
+#include <tvm/node/structural_hash.h>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace tvm {
+namespace relay {
+namespace collage {
+
+TVM_REGISTER_OBJECT_TYPE(CachingCostEstimatorNode);
+
+std::string CachingCostEstimatorNode::CacheKey(const IRModule& mod, const Target& target) {
+  std::ostringstream os;
+  os << std::hex << StructuralHash()(mod) << "\t" << target->str();
+  return os.str();
+}
+
+void CachingCostEstimatorNode::Record(const std::string& key, Cost cost) const {
+  // Unknown costs are not worth remembering, the next run should try again.
+  if (cost.is_unknown()) {
+    return;
+  }
+  costs_.emplace(key, cost);
+  std::ofstream os(path_, std::ios::app);
+  ICHECK(os.good()) << "Unable to append to the cost cache file " << path_;
+  os << key << "\t";
+  if (cost.is_invalid()) {
+    os << "inf";
+  } else {
+    os << std::setprecision(17) << cost.value();
+  }
+  os << std::endl;
+}
+
+Cost CachingCostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
+  return EstimateBatch({mod}, {target})[0];
+}
+
+std::vector<Cost> CachingCostEstimatorNode::EstimateBatch(const Array<IRModule>& mods,
+                                                          const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  std::vector<Cost> costs(mods.size(), Cost::Unknown());
+  std::vector<std::string> keys;
+  keys.reserve(mods.size());
+  Array<IRModule> missing_mods;
+  Array<Target> missing_targets;
+  std::vector<size_t> missing_indices;
+  for (size_t i = 0; i < mods.size(); ++i) {
+    keys.push_back(CacheKey(mods[i], targets[i]));
+    auto itr = costs_.find(keys.back());
+    if (itr != costs_.end()) {
+      VLOG(1) << "Reusing cost " << itr->second.ToString() << " cached in " << path_;
+      costs[i] = itr->second;
+    } else {
+      missing_mods.push_back(mods[i]);
+      missing_targets.push_back(targets[i]);
+      missing_indices.push_back(i);
+    }
+  }
+  if (!missing_mods.empty()) {
+    std::vector<Cost> missing_costs = estimator_->EstimateBatch(missing_mods, missing_targets);
+    ICHECK_EQ(missing_costs.size(), missing_indices.size());
+    for (size_t i = 0; i < missing_indices.size(); ++i) {
+      costs[missing_indices[i]] = missing_costs[i];
+      Record(keys[missing_indices[i]], missing_costs[i]);
+    }
+  }
+  return costs;
+}
+
+CachingCostEstimator::CachingCostEstimator(CostEstimator estimator, String path) {
+  auto node = make_object<CachingCostEstimatorNode>();
+  std::ifstream is(path);
+  std::string line;
+  while (std::getline(is, line)) {
+    size_t pos = line.rfind('\t');
+    if (pos == std::string::npos) {
+      continue;
+    }
+    std::string key = line.substr(0, pos);
+    double value = std::stod(line.substr(pos + 1));
+    node->costs_[key] = std::isinf(value) ? Cost::Invalid() : Cost::Value(value);
+  }
+  node->estimator_ = std::move(estimator);
+  node->path_ = std::move(path);
+  data_ = std::move(node);
+}
+
+TVM_REGISTER_GLOBAL("relay.collage.CachingCostEstimator")
+    .set_body_typed([](CostEstimator estimator, String path) {
+      return CachingCostEstimator(std::move(estimator), std::move(path));
+    });
+
+}  // namespace collage
+}  // namespace relay
+}  // namespace tvm
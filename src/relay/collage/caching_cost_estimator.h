@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/collage/caching_cost_estimator.h
+ * \brief A CostEstimator remembering the costs of candidate modules on disk across runs.
+ */
+
+#ifndef TVM_RELAY_COLLAGE_CACHING_COST_ESTIMATOR_H_
+#define TVM_RELAY_COLLAGE_CACHING_COST_ESTIMATOR_H_
+
+#include <tvm/relay/function.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./cost.h"
+#include "./cost_estimator.h"
+
+namespace tvm {
+namespace relay {
+namespace collage {
+
+/*!
+ * \brief A cost estimator which delegates to another estimator, remembering the estimated costs
+ * in a file keyed by the structural hash of the candidate module and the target. The file is
+ * loaded when the estimator is created and appended to after every estimate, so that partitioning
+ * variants of a model, or the same model again, only estimates the candidates not seen before.
+ */
+class CachingCostEstimatorNode : public CostEstimatorNode {
+ public:
+  Cost Estimate(const IRModule& mod, const Target& target) const override;
+
+  std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                  const Array<Target>& targets) const override;
+
+  static constexpr const char* _type_key = "relay.collage.CachingCostEstimator";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CachingCostEstimatorNode, CostEstimatorNode);
+
+ protected:
+  /*! \brief Returns the key of \p mod estimated for \p target in the cache. */
+  static std::string CacheKey(const IRModule& mod, const Target& target);
+
+  /*! \brief Records the cost of the module with \p key in the cache and in the cache file. */
+  void Record(const std::string& key, Cost cost) const;
+
+  /*! \brief The estimator of the modules missing from the cache. */
+  CostEstimator estimator_;
+
+  /*! \brief The path of the cache file. */
+  String path_;
+
+  /*! \brief The costs in the cache, by their key. */
+  mutable std::unordered_map<std::string, Cost> costs_;
+
+  friend class CachingCostEstimator;
+};
+
+class CachingCostEstimator : public CostEstimator {
+ public:
+  CachingCostEstimator(CostEstimator estimator, String path);
+
+  TVM_DEFINE_OBJECT_REF_METHODS(CachingCostEstimator, CostEstimator, CachingCostEstimatorNode);
+};
+
+}  // namespace collage
+}  // namespace relay
+}  // namespace tvm
+
+#endif  // TVM_RELAY_COLLAGE_CACHING_COST_ESTIMATOR_H_
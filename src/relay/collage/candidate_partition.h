@@ -103,6 +103,16 @@ class CandidatePartitionNode : public Object {
   Cost EstimatedCost(const DataflowGraph& dataflow_graph, const CostEstimator& cost_estimator,
                      const std::shared_ptr<CandidateFunctionCache>& cache) const;
 
+  /*!
+   * \brief Returns the module whose cost must be estimated to know the cost of the candidate
+   * partition, or NullOpt if the cost is already known, either by the candidate itself or by
+   * \p cache. Sets \p entry to the entry of \p cache which the estimated cost is to be recorded
+   * in, after which \p EstimatedCost will pick up the cost without estimating it again.
+   */
+  Optional<IRModule> ModuleToEstimate(const DataflowGraph& dataflow_graph,
+                                      const std::shared_ptr<CandidateFunctionCache>& cache,
+                                      CandidateFunctionCache::Entry** entry) const;
+
   /*!
    * \brief Returns a brief description of candidate suitable for debugging output.
    */
@@ -24,6 +24,9 @@
 
 #include "./candidate_partition_index.h"
 
+#include <unordered_set>
+#include <vector>
+
 #include "./gather_partition_specs.h"
 #include "./prune_candidates.h"
 #include "./utils.h"
@@ -52,14 +55,36 @@ void CandidatePartitionIndex::Index(const Array<PartitionSpec>& partition_specs)
 
 void CandidatePartitionIndex::EstimateAllCosts(
     const CostEstimator cost_estimator, const std::shared_ptr<CandidateFunctionCache>& cache) {
+  // Gather the distinct modules whose cost is unknown, so that they are estimated as one batch.
+  Array<IRModule> mods;
+  Array<Target> targets;
+  std::vector<CandidateFunctionCache::Entry*> entries;
+  std::unordered_set<CandidateFunctionCache::Entry*> pending;
+  for (PostDfsIndex index = 0; index < dataflow_graph_->size(); ++index) {
+    for (const auto& candidate : first_inside_index_to_candidates_[index]) {
+      CandidateFunctionCache::Entry* entry = nullptr;
+      Optional<IRModule> mod = candidate->ModuleToEstimate(*dataflow_graph_, cache, &entry);
+      if (mod.defined() && pending.insert(entry).second) {
+        mods.push_back(mod.value());
+        targets.push_back(candidate->target());
+        entries.push_back(entry);
+      }
+    }
+  }
+  LOG(INFO) << "Estimating the cost of " << mods.size() << " distinct modules for " << size_
+            << " candidates";
+  std::vector<Cost> costs = cost_estimator->EstimateBatch(mods, targets);
+  ICHECK_EQ(costs.size(), entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    entries[i]->cost = costs[i];
+  }
   size_t n = 0;
   for (PostDfsIndex index = 0; index < dataflow_graph_->size(); ++index) {
     for (const auto& candidate : first_inside_index_to_candidates_[index]) {
-      LOG(INFO) << "Estimating cost of candidate " << candidate->ToSummary(*dataflow_graph_) << " ["
-                << n++ << "/" << size_ << "]";
       // Cost will be cached in candidate as a side effect.
       Cost cost = candidate->EstimatedCost(*dataflow_graph_, cost_estimator, cache);
-      LOG(INFO) << "Candidate has cost " << cost.ToString();
+      LOG(INFO) << "Candidate " << candidate->ToSummary(*dataflow_graph_) << " [" << n++ << "/"
+                << size_ << "] has cost " << cost.ToString();
     }
   }
 }
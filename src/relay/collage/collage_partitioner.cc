@@ -150,8 +150,8 @@ class Partitioner {
     //  - There are no paths in which the candidate does not intersect candidates already
     //    applied on the path.
     //  - The Dijkstra search terminates early with a least cost path.
-    // So eager may result in more estimation overhead. However, eager could be made
-    // embarrassingly parallel.
+    // So eager may result in more estimation overhead. However, eager estimates the distinct
+    // candidate modules as one batch, which the cost estimator may estimate concurrently.
     VLOG(1) << "Beginning eager cost estimation";
     index_->EstimateAllCosts(cost_estimator_, cache_);
     VLOG(1) << "Finished eager cost estimation";
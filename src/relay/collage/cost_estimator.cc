@@ -52,6 +52,17 @@ Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) cons
   }
 }
 
+std::vector<Cost> CostEstimatorNode::EstimateBatch(const Array<IRModule>& mods,
+                                                  const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  std::vector<Cost> costs;
+  costs.reserve(mods.size());
+  for (size_t i = 0; i < mods.size(); ++i) {
+    costs.push_back(Estimate(mods[i], targets[i]));
+  }
+  return costs;
+}
+
 TVM_REGISTER_GLOBAL("relay.collage.CostEstimator").set_body_typed([]() { return CostEstimator(); });
 
 }  // namespace collage
@@ -27,6 +27,8 @@
 
 #include <tvm/relay/function.h>
 
+#include <vector>
+
 #include "./cost.h"
 
 namespace tvm {
@@ -54,6 +56,14 @@ class CostEstimatorNode : public Object {
    */
   virtual Cost Estimate(const IRModule& mod, const Target& target) const;
 
+  /*!
+   * \brief Returns the estimated costs of running "main" in each of \p mods using the target of
+   * the same index in \p targets. The modules are independent of each other, so implementations
+   * are free to estimate them concurrently. By default they are estimated one by one.
+   */
+  virtual std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                          const Array<Target>& targets) const;
+
   static constexpr const char* _type_key = "relay.collage.CostEstimator";
   TVM_DECLARE_BASE_OBJECT_INFO(CostEstimatorNode, Object);
 };
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/collage/parallel_cost_estimator.cc
+ * \brief A CostEstimator compiling candidate modules in parallel worker processes.
+ */
+
+#include "./parallel_cost_estimator.h"
+
+#include <cmath>
+
+namespace tvm {
+namespace relay {
+namespace collage {
+
+TVM_REGISTER_OBJECT_TYPE(ParallelCostEstimatorNode);
+
+Cost ParallelCostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
+  return EstimateBatch({mod}, {target})[0];
+}
+
+std::vector<Cost> ParallelCostEstimatorNode::EstimateBatch(const Array<IRModule>& mods,
+                                                           const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  std::vector<Cost> costs;
+  if (mods.empty()) {
+    return costs;
+  }
+  static const runtime::PackedFunc* estimate_seconds_batch =
+      runtime::Registry::Get("tvm.relay.collage.estimate_seconds_batch");
+  ICHECK(estimate_seconds_batch);
+  Array<FloatImm> values = (*estimate_seconds_batch)(mods, targets, num_workers_);
+  ICHECK_EQ(values.size(), mods.size());
+  costs.reserve(values.size());
+  for (const FloatImm& value : values) {
+    if (std::isinf(value->value)) {
+      costs.push_back(Cost::Invalid());
+    } else if (std::isnan(value->value)) {
+      costs.push_back(Cost::Unknown());
+    } else {
+      costs.push_back(Cost::Value(value->value));
+    }
+  }
+  return costs;
+}
+
+ParallelCostEstimator::ParallelCostEstimator(Integer num_workers) {
+  auto node = make_object<ParallelCostEstimatorNode>();
+  node->num_workers_ = std::move(num_workers);
+  data_ = std::move(node);
+}
+
+TVM_REGISTER_GLOBAL("relay.collage.ParallelCostEstimator").set_body_typed([](Integer num_workers) {
+  return ParallelCostEstimator(std::move(num_workers));
+});
+
+}  // namespace collage
+}  // namespace relay
+}  // namespace tvm
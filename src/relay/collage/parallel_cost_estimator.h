@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/collage/parallel_cost_estimator.h
+ * \brief A CostEstimator compiling candidate modules in parallel worker processes.
+ */
+
+#ifndef TVM_RELAY_COLLAGE_PARALLEL_COST_ESTIMATOR_H_
+#define TVM_RELAY_COLLAGE_PARALLEL_COST_ESTIMATOR_H_
+
+#include <tvm/relay/function.h>
+
+#include <vector>
+
+#include "./cost.h"
+#include "./cost_estimator.h"
+
+namespace tvm {
+namespace relay {
+namespace collage {
+
+/*!
+ * \brief A cost estimator which, like the default \p CostEstimator, compiles and benchmarks the
+ * candidate modules locally, but compiles a batch of modules in parallel worker processes. The
+ * compiled modules are still benchmarked one at a time so that measurements do not disturb each
+ * other.
+ */
+class ParallelCostEstimatorNode : public CostEstimatorNode {
+ public:
+  Cost Estimate(const IRModule& mod, const Target& target) const override;
+
+  std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                  const Array<Target>& targets) const override;
+
+  static constexpr const char* _type_key = "relay.collage.ParallelCostEstimator";
+  TVM_DECLARE_FINAL_OBJECT_INFO(ParallelCostEstimatorNode, CostEstimatorNode);
+
+ protected:
+  /*! \brief The number of worker processes compiling the modules. */
+  Integer num_workers_;
+
+  friend class ParallelCostEstimator;
+};
+
+class ParallelCostEstimator : public CostEstimator {
+ public:
+  explicit ParallelCostEstimator(Integer num_workers);
+
+  TVM_DEFINE_OBJECT_REF_METHODS(ParallelCostEstimator, CostEstimator, ParallelCostEstimatorNode);
+};
+
+}  // namespace collage
+}  // namespace relay
+}  // namespace tvm
+
+#endif  // TVM_RELAY_COLLAGE_PARALLEL_COST_ESTIMATOR_H_
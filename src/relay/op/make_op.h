@@ -52,6 +52,10 @@ Expr MakeDense(Expr data, Expr weight, IndexExpr units, DataType out_dtype);
 
 Expr MakeBatchMatmul(Expr lhs, Expr rhs, DataType out_dtype, bool transpose_a, bool transpose_b);
 
+Expr MakeFusedAttention(Expr query, Expr key, Expr value, double scale, DataType out_dtype);
+
+Expr MakeEmbeddingLookup(Expr table, Expr indices, tvm::String mode);
+
 Expr MakeExpandDims(Expr data, int axis, int num_newaxis);
 
 Expr MakeFixedPointMultiplyPerAxis(Expr x, Expr m, Expr lshift, Expr rshift,
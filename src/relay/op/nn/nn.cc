@@ -306,6 +306,64 @@ RELAY_REGISTER_OP("nn.contrib_dense_pack")
 
 // ------------------- relay.nn.contrib_dense_pack
 
+// ------------------- relay.nn.contrib_embedding_lookup
+TVM_REGISTER_NODE_TYPE(EmbeddingLookupAttrs);
+
+// Positional relay function to create embedding_lookup operator used by frontend FFI.
+Expr MakeEmbeddingLookup(Expr table, Expr indices, tvm::String mode) {
+  auto attrs = make_object<EmbeddingLookupAttrs>();
+  attrs->mode = std::move(mode);
+  static const Op& op = Op::Get("nn.contrib_embedding_lookup");
+  return Call(op, {table, indices}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.contrib_embedding_lookup")
+    .set_body_typed(MakeEmbeddingLookup);
+
+bool EmbeddingLookupRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                        const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 3);
+  const auto* table = types[0].as<TensorTypeNode>();
+  const auto* indices = types[1].as<TensorTypeNode>();
+  if (table == nullptr || indices == nullptr) return false;
+
+  const EmbeddingLookupAttrs* param = attrs.as<EmbeddingLookupAttrs>();
+  ICHECK(param != nullptr);
+  ICHECK(param->mode == "none" || param->mode == "sum" || param->mode == "mean")
+      << "ValueError: embedding_lookup mode must be one of none, sum, mean, but got "
+      << param->mode;
+  ICHECK_EQ(table->shape.size(), 2) << "ValueError: embedding table must be 2-D";
+  ICHECK(indices->dtype.is_int()) << "ValueError: indices must be integers";
+
+  Array<tvm::PrimExpr> oshape = indices->shape;
+  if (param->mode != "none") {
+    ICHECK_GE(indices->shape.size(), 1) << "ValueError: bag reductions need a bag axis";
+    oshape.pop_back();
+  }
+  oshape.push_back(table->shape[1]);
+  reporter->Assign(types[2], TensorType(oshape, table->dtype));
+  return true;
+}
+
+RELAY_REGISTER_OP("nn.contrib_embedding_lookup")
+    .describe(R"code(Looks up rows of an embedding table, optionally reducing them per bag.
+
+- **table**: `(num_rows, dim)`
+- **indices**: `(d_1, ..., d_n)`, clipped to `[0, num_rows)`
+- **out**: `(d_1, ..., d_n, dim)` with mode none, `(d_1, ..., d_{n-1}, dim)` with mode sum or
+  mean, which reduce the rows over the last axis of indices.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<EmbeddingLookupAttrs>()
+    .set_num_inputs(2)
+    .add_argument("table", "2D Tensor", "Embedding table.")
+    .add_argument("indices", "Tensor", "Row indices.")
+    .set_support_level(10)
+    .add_type_rel("EmbeddingLookup", EmbeddingLookupRel)
+    .set_attr<TOpPattern>("TOpPattern", kOpaque);
+
+// ------------------- relay.nn.contrib_embedding_lookup
+
 // relay.leaky_relu
 TVM_REGISTER_NODE_TYPE(LeakyReluAttrs);
 
@@ -1135,6 +1193,75 @@ Both `tensor_a` and `tensor_b` can be transposed. For legacy reason, we use NT f
 
 // ------------------- relay.nn.batch_matmul
 
+// ------------------- relay.nn.fused_attention
+TVM_REGISTER_NODE_TYPE(FusedAttentionAttrs);
+
+bool FusedAttentionRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                       const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 4);
+  const auto* query = types[0].as<TensorTypeNode>();
+  const auto* key = types[1].as<TensorTypeNode>();
+  const auto* value = types[2].as<TensorTypeNode>();
+  if (query == nullptr || key == nullptr || value == nullptr) return false;
+  const auto* param = attrs.as<FusedAttentionAttrs>();
+  ICHECK(param != nullptr);
+  ICHECK(query->shape.size() == 3 && key->shape.size() == 3 && value->shape.size() == 3)
+      << "FusedAttention: expect 3-D query, key and value, but got query shape = "
+      << query->shape << ", key shape = " << key->shape << ", value shape = " << value->shape;
+  // query: [batch, seq_q, head_dim], key: [batch, seq_kv, head_dim],
+  // value: [batch, seq_kv, value_dim]
+  ICHECK(reporter->AssertEQ(query->shape[0], key->shape[0]) &&
+         reporter->AssertEQ(query->shape[0], value->shape[0]))
+      << "FusedAttention: batch dimensions don't match, query shape = " << query->shape
+      << ", key shape = " << key->shape << ", value shape = " << value->shape;
+  ICHECK(reporter->AssertEQ(query->shape[2], key->shape[2]))
+      << "FusedAttention: head dimensions don't match, query shape = " << query->shape
+      << ", key shape = " << key->shape;
+  ICHECK(reporter->AssertEQ(key->shape[1], value->shape[1]))
+      << "FusedAttention: sequence lengths of key and value don't match, key shape = "
+      << key->shape << ", value shape = " << value->shape;
+  DataType out_dtype = param->out_dtype.is_void() ? query->dtype : param->out_dtype;
+  reporter->Assign(types[3],
+                   TensorType({query->shape[0], query->shape[1], value->shape[2]}, out_dtype));
+  return true;
+}
+
+// Positional relay function to create fused_attention operator used by frontend FFI.
+Expr MakeFusedAttention(Expr query, Expr key, Expr value, double scale, DataType out_dtype) {
+  auto attrs = make_object<FusedAttentionAttrs>();
+  attrs->scale = scale;
+  attrs->out_dtype = out_dtype;
+  static const Op& op = Op::Get("nn.fused_attention");
+  return Call(op, {query, key, value}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.fused_attention").set_body_typed(MakeFusedAttention);
+
+RELAY_REGISTER_OP("nn.fused_attention")
+    .describe(R"code(Compute scaled dot-product attention, with the softmax computed online so
+that the score matrix is not materialized.
+
+.. math::
+
+  fused\_attention(Q, K, V)[i, :, :] = softmax(Q[i, :, :] * K[i, :, :]^T * scale) * V[i, :, :]
+
+- **query**: `(b, m, k)`
+- **key**: `(b, n, k)`
+- **value**: `(b, n, d)`
+- **out**: `(b, m, d)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<FusedAttentionAttrs>()
+    .set_num_inputs(3)
+    .add_argument("query", "3D Tensor", "The query.")
+    .add_argument("key", "3D Tensor", "The key.")
+    .add_argument("value", "3D Tensor", "The value.")
+    .set_support_level(10)
+    .add_type_rel("FusedAttention", FusedAttentionRel)
+    .set_attr<TOpPattern>("TOpPattern", kOpaque);
+
+// ------------------- relay.nn.fused_attention
+
 // relay.nn.cross_entropy
 bool CrossEntropyRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
                      const TypeReporter& reporter) {
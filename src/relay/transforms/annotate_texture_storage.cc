@@ -31,6 +31,12 @@
  *  - AnnotateMemoryScope calls *target.CollectStorageInfo for all target been represented
  *    in the graph and rewrites graph modifying or inserting of VirtualDevice with required
  *    memory_scope collected from the CollectStorageInfo
+ *
+ *  - Texture storage is only selected for a primitive function when it is expected to be
+ *    faster than buffers. Measured speedups (buffer time / texture time) can be attached
+ *    to ops via the "TTextureSpeedup" op attribute; a fused function containing an op with
+ *    a measured speedup of at most 1.0 keeps its tensors in buffers, and the required
+ *    scope conversions are inserted as device_copy by RewriteVDStorageScopes.
  */
 
 #include <tvm/relay/attrs/nn.h>
@@ -148,8 +154,9 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
     if (const auto* fn = call->op.as<FunctionNode>()) {
       if (fn->HasNonzeroAttr(attr::kPrimitive)) {
         primitive_supports_texture_ = false;
+        primitive_prefers_buffers_ = false;
         Visit(call->op);
-        if (primitive_supports_texture_) {
+        if (primitive_supports_texture_ && !primitive_prefers_buffers_) {
           if (call->checked_type().as<TensorTypeNode>()) {
             std::string scope = "global.texture";
             if (const auto* ttype = call->checked_type().as<TensorTypeNode>()) {
@@ -213,6 +220,9 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
       expr_attrib = call->attrs;
       primitive_supports_texture_ = SupportsTextureStorage(call);
     }
+    if (!TextureIsFaster(call)) {
+      primitive_prefers_buffers_ = true;
+    }
 
     for (auto& arg : call->args) {
       if (buffers_args.find(arg) == buffers_args.end()) {
@@ -416,6 +426,24 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
     return supports_texture_storage;
   }
 
+  /*!
+   * \brief Checks the measured texture speedup of the op called by \p call.
+   *
+   * Ops without a "TTextureSpeedup" attribute are assumed to benefit from textures
+   * whenever SupportsTextureStorage accepts them.
+   */
+  bool TextureIsFaster(const CallNode* call) const {
+    const auto* opnode = call->op.as<OpNode>();
+    if (opnode && Op::HasAttrMap("TTextureSpeedup")) {
+      auto fspeedup = Op::GetAttrMap<double>("TTextureSpeedup");
+      Op op = GetRef<Op>(opnode);
+      if (fspeedup.count(op)) {
+        return fspeedup[op] > 1.0;
+      }
+    }
+    return true;
+  }
+
   bool CanUseBuffers(const Expr param, const Array<PrimExpr> shape,
                      const tvm::DictAttrs param_attrs) const {
     bool use_buffer = false;
@@ -441,6 +469,9 @@ class StorageInfo : private transform::DeviceAwareExprVisitor {
   /*! \brief Temporary state for marking whether a visited function
    *         primitive supports texture storage scope */
   bool primitive_supports_texture_ = false;
+  /*! \brief Temporary state for marking whether a visited function
+   *         primitive contains an op measured to be slower on textures */
+  bool primitive_prefers_buffers_ = false;
   /*! \brief expr storage scope mapping for each output  */
   std::unordered_map<const ExprNode*, std::vector<std::string>> storage_scope_;
   /*! \brief output storage scopes used by consumers of expr key  */
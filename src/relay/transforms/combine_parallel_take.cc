@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *
+ * \file combine_parallel_take.cc
+ * \brief Combine parallel takes from the same table into a single one.
+ *
+ * This pass replaces take ops that gather rows of the same table with
+ * indices of the same shape by a single take, whose indices are the stacked
+ * indices of all the branches. Elemwise and broadcast ops following take are
+ * also combined if possible, by stacking their other arguments.
+ *
+ * This prevents launching one gather kernel per lookup in networks with
+ * many parallel embedding lookups, such as recommendation models.
+ */
+
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+
+#include "./combine_parallel_op.h"
+#include "./expr_subst.h"
+#include "pattern_utils.h"
+
+namespace tvm {
+namespace relay {
+
+class ParallelTakeCombiner : public ParallelOpCombiner {
+ public:
+  explicit ParallelTakeCombiner(uint64_t min_num_branches)
+      : ParallelOpCombiner("take", min_num_branches) {}
+
+ protected:
+  bool IsSupportedOp(const CallNode* n) {
+    // Only row gathers are combined, since the stacked indices add a leading axis to the output
+    const auto* attrs = n->attrs.as<TakeAttrs>();
+    ICHECK(attrs);
+    return attrs->axis.defined() && attrs->axis.IntValue() == 0 &&
+           attrs->batch_dims.IntValue() == 0;
+  }
+
+  bool CanOpsBeCombined(const CallNode* a, const CallNode* b) {
+    const auto* attrs_a = a->attrs.as<TakeAttrs>();
+    const auto* attrs_b = b->attrs.as<TakeAttrs>();
+    ICHECK(attrs_a);
+    ICHECK(attrs_b);
+    return attrs_a->mode == attrs_b->mode && IsArgCompatible(a, b, 1);
+  }
+
+  Call MakeCombinedOp(const Group& branches) {
+    Expr table = branches[0][0]->args[0];
+
+    Array<Expr> indices;
+    for (const auto& branch : branches) {
+      indices.push_back(branch[0]->args[1]);
+    }
+    Expr new_indices = MakeStack(Tuple(indices), 0);
+
+    const auto* origin_attrs = branches[0][0]->attrs.as<TakeAttrs>();
+    ICHECK(origin_attrs);
+    return Downcast<Call>(
+        MakeTake(table, new_indices, origin_attrs->batch_dims, 0, origin_attrs->mode));
+  }
+
+  bool IsArgCompatible(const CallNode* a, const CallNode* b, size_t index) {
+    StructuralEqual eq;
+    auto ta = a->args[index]->type_as<TensorTypeNode>();
+    auto tb = b->args[index]->type_as<TensorTypeNode>();
+
+    if (!eq(ta->dtype, tb->dtype) || ta->shape.size() != tb->shape.size()) return false;
+
+    for (size_t i = 0; i < ta->shape.size(); i++) {
+      if (!eq(ta->shape[i], tb->shape[i])) return false;
+    }
+    return true;
+  }
+
+  Call MakeCombinedCallFromFollowingOps(const Expr& data, const Group& branches, size_t depth,
+                                        size_t parent_index) {
+    Array<Expr> new_args;
+    const CallNode* call = branches[0][depth];
+    size_t ndim = call->args[parent_index]->type_as<TensorTypeNode>()->shape.size();
+
+    for (size_t i = 0; i < call->args.size(); i++) {
+      if (i == parent_index) {
+        new_args.push_back(data);
+        continue;
+      }
+
+      Array<Expr> tuple;
+      for (const auto& branch : branches) {
+        // Expand the arg to the rank of the branch output, so that the stacked
+        // arg broadcasts along the branch axis of the combined output.
+        Expr arg = branch[depth]->args[i];
+        size_t arg_ndim = arg->type_as<TensorTypeNode>()->shape.size();
+        if (arg_ndim < ndim) {
+          arg = MakeExpandDims(arg, 0, ndim - arg_ndim);
+        }
+        tuple.push_back(arg);
+      }
+
+      new_args.push_back(MakeStack(Tuple(tuple), 0));
+    }
+
+    return Call(call->op, new_args, call->attrs, {});
+  }
+
+  void UpdateGroupOutput(const Expr& data, const Group& branches, size_t depth,
+                         ExprSubstMap* subst_map) {
+    int index = 0;
+    auto split = MakeSplit(data, Integer(branches.size()), 0);
+    for (const auto& branch : branches) {
+      auto split_data = TupleGetItem(split, index++);
+      auto squeezed_data = MakeSqueeze(split_data, {0});
+      subst_map->insert({GetRef<Expr>(branch[depth]), squeezed_data});
+    }
+  }
+};
+
+/*! \brief Combine parallel take if number of branches >= min_num_branches */
+Expr CombineParallelTake(const Expr& expr, uint64_t min_num_branches) {
+  return ParallelTakeCombiner(min_num_branches).Combine(expr);
+}
+
+namespace transform {
+
+Pass CombineParallelTake(uint64_t min_num_branches) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(CombineParallelTake(f, min_num_branches));
+      };
+  return CreateFunctionPass(pass_func, 4, "CombineParallelTake", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.CombineParallelTake").set_body_typed(CombineParallelTake);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -161,6 +161,13 @@
  *
  * This pass can be run before FuseOps so that it can use device-specific fusion rules.
  *
+ * Cost-based placement
+ * --------------------
+ * When the "relay.PlanDevices.cost_based_placement" pass config is set, primitive calls which
+ * the user did not annotate are first placed on either the host or the default primitive device
+ * by a simple latency model, see \p CostBasedPlacer. The placement is expressed as "on_device"
+ * calls before Phase 0, so the remaining phases are unchanged.
+ *
  * 'Stored on' vs 'Executes on'
  * ----------------------------
  * Obviously for a primitive call \code add(x, y) \endcode we can execute the primitive on the
@@ -266,6 +273,7 @@
 #include <tvm/relay/attrs/memory.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op.h>
+#include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 #include <tvm/relay/type.h>
@@ -274,7 +282,10 @@
 #include <tvm/tir/function.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "../../tir/analysis/device_constraint_utils.h"
 #include "../op/annotation/annotation.h"
@@ -288,6 +299,233 @@ namespace transform {
 
 namespace {
 
+/* =============== Cost-based placement =============== */
+
+/*! \brief Estimated throughput of the host, in operations per microsecond. */
+constexpr double kHostOpsPerUs = 1e4;
+/*! \brief Estimated throughput of the device, in operations per microsecond. */
+constexpr double kDeviceOpsPerUs = 1e6;
+/*! \brief Estimated overhead of launching a kernel on the device, in microseconds. */
+constexpr double kKernelLaunchUs = 5.0;
+/*! \brief Estimated fixed cost of a copy between devices, including the synchronization. */
+constexpr double kCopyLatencyUs = 10.0;
+/*! \brief Estimated bandwidth between devices, in bytes per microsecond. */
+constexpr double kCopyBytesPerUs = 1e4;
+
+/*! \brief Returns the number of elements of \p tensor_type, or -1 if its shape is not static. */
+int64_t StaticNumElements(const TensorTypeNode* tensor_type) {
+  int64_t num_elements = 1;
+  for (const PrimExpr& dim : tensor_type->shape) {
+    const auto* extent = dim.as<IntImmNode>();
+    if (extent == nullptr) return -1;
+    num_elements *= extent->value;
+  }
+  return num_elements;
+}
+
+/*! \brief Returns the number of bytes of a value of \p type, or -1 if its shape is not static. */
+int64_t StaticSizeBytes(const Type& type) {
+  if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+    int64_t num_elements = StaticNumElements(tensor_type);
+    if (num_elements < 0) return -1;
+    return num_elements * ((tensor_type->dtype.bits() * tensor_type->dtype.lanes() + 7) / 8);
+  }
+  if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+    int64_t size = 0;
+    for (const Type& field : tuple_type->fields) {
+      int64_t field_size = StaticSizeBytes(field);
+      if (field_size < 0) return -1;
+      size += field_size;
+    }
+    return size;
+  }
+  return -1;
+}
+
+/*!
+ * \brief Places the primitive calls the user did not annotate on either the host or the default
+ * primitive device, by greedily minimizing the estimated latency of each call plus the copies of
+ * its arguments, in dataflow order:
+ *  - Calls of kOutEWiseFusable operators (e.g. conv2d and dense) do about as many multiply-adds as
+ *    their output elements times the elements of their weight per output channel. Other calls
+ *    touch each element of their arguments and result once.
+ *  - The device pays a kernel launch per call, so cheap calls, e.g. shape manipulation, stay next
+ *    to their arguments rather than paying a copy and a synchronization.
+ *  - A call whose result does not fit in the "relay.PlanDevices.device_memory_limit" bytes left
+ *    on the device runs on the host. The results are summed without accounting for storage
+ *    reuse, so the limit is conservative.
+ *
+ * The choice is recorded as an "on_device" call constraining the call but not its context, and
+ * the arguments are wrapped in 'free' "on_device" calls, so that a "device_copy" is inserted
+ * between calls placed on different devices, e.g.:
+ * \code
+ *   nn.dense(%x, %w)
+ *   ==> on_device(nn.dense(copy_ok(%x), copy_ok(%w)), virtual_device=GPU, constrain_body=True)
+ * \endcode
+ * The arguments which are neither parameters nor placed calls are assumed to be free.
+ */
+class CostBasedPlacer : public ExprMutator {
+ public:
+  CostBasedPlacer(CompilationConfig config, int64_t device_memory_limit)
+      : host_(config->host_virtual_device),
+        device_(config->default_primitive_virtual_device),
+        device_memory_limit_(device_memory_limit) {}
+
+  Function Place(const Function& function) { return Downcast<Function>(Mutate(function)); }
+
+ private:
+  Expr VisitExpr_(const FunctionNode* function_node) final {
+    if (function_node->HasNonzeroAttr(attr::kPrimitive)) {
+      return GetRef<Function>(function_node);
+    }
+    // Unconstrained parameters default to the device for the function result, see
+    // DeviceDefaulter below.
+    for (const Var& param : function_node->params) {
+      device_of_[param.get()] =
+          param->virtual_device()->IsFullyUnconstrained() ? device_ : param->virtual_device();
+    }
+    return ExprMutator::VisitExpr_(function_node);
+  }
+
+  Expr VisitExpr_(const LetNode* let_node) final {
+    Expr expr = GetRef<Let>(let_node);
+    // Iteratively visit let nodes to avoid stack overflow.
+    std::vector<std::pair<Let, Expr>> bindings;
+    while (auto opt = expr.as<Let>()) {
+      Let let = opt.value();
+      Expr value = VisitExpr(let->value);
+      auto it = device_of_.find(let->value.get());
+      if (it != device_of_.end()) device_of_[let->var.get()] = it->second;
+      bindings.emplace_back(let, value);
+      expr = let->body;
+    }
+    expr = VisitExpr(expr);
+    for (auto itr = bindings.rbegin(); itr != bindings.rend(); ++itr) {
+      expr = WithFields(/*let=*/itr->first, /*opt_var=*/{}, /*opt_value=*/itr->second,
+                        /*opt_body=*/expr);
+    }
+    return expr;
+  }
+
+  Expr VisitExpr_(const TupleGetItemNode* tuple_get_item_node) final {
+    Expr tuple_get_item = ExprMutator::VisitExpr_(tuple_get_item_node);
+    auto it = device_of_.find(tuple_get_item_node->tuple.get());
+    if (it != device_of_.end()) device_of_[tuple_get_item_node] = it->second;
+    return tuple_get_item;
+  }
+
+  Expr VisitExpr_(const CallNode* call_node) final {
+    OnDeviceProps on_device_props = GetOnDeviceProps(call_node);
+    if (on_device_props.body.defined()) {
+      // Respect the user's annotation, but still place the calls feeding the annotated call.
+      Expr body = on_device_props.body;
+      const auto* body_call = body.as<CallNode>();
+      if (body_call != nullptr && body_call->op.as<OpNode>()) {
+        Array<Expr> args;
+        for (const Expr& arg : body_call->args) {
+          args.push_back(VisitExpr(arg));
+        }
+        body = WithFields(GetRef<Call>(body_call), body_call->op, args);
+      } else {
+        body = VisitExpr(body);
+      }
+      if (!on_device_props.virtual_device->IsFullyUnconstrained()) {
+        device_of_[call_node] = on_device_props.virtual_device;
+      }
+      return OnDeviceWithProps(body, on_device_props);
+    }
+
+    DeviceCopyProps device_copy_props = GetDeviceCopyProps(call_node);
+    if (device_copy_props.body.defined()) {
+      Expr device_copy = ExprMutator::VisitExpr_(call_node);
+      device_of_[call_node] = device_copy_props.dst_virtual_device;
+      return device_copy;
+    }
+
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    const auto* op_node = call_node->op.as<OpNode>();
+    int64_t result_bytes =
+        call_node->checked_type_.defined() ? StaticSizeBytes(call_node->checked_type()) : -1;
+    if (op_node == nullptr || !fpattern.count(GetRef<Op>(op_node)) || result_bytes < 0) {
+      return ExprMutator::VisitExpr_(call_node);
+    }
+
+    Array<Expr> args;
+    for (const Expr& arg : call_node->args) {
+      Expr new_arg = VisitExpr(arg);
+      // Allow a "device_copy" between the argument and the call.
+      if (!GetOnDeviceProps(new_arg).body.defined()) new_arg = OnDeviceCopyOk(new_arg);
+      args.push_back(new_arg);
+    }
+
+    auto pattern = static_cast<OpPatternKind>(fpattern[GetRef<Op>(op_node)]);
+    double ops = EstimateOps(call_node, pattern, result_bytes);
+    double host_us = ops / kHostOpsPerUs + EstimateCopyUs(call_node, host_);
+    double device_us = kKernelLaunchUs + ops / kDeviceOpsPerUs + EstimateCopyUs(call_node, device_);
+    bool fits = device_memory_limit_ <= 0 || device_bytes_ + result_bytes <= device_memory_limit_;
+    VirtualDevice virtual_device = fits && device_us < host_us ? device_ : host_;
+    if (virtual_device == device_) device_bytes_ += result_bytes;
+    VLOG(2) << "placing " << op_node->name << " on " << virtual_device << ", estimated " << host_us
+            << "us on the host and " << device_us << "us on the device";
+    device_of_[call_node] = virtual_device;
+    return OnDevice(WithFields(GetRef<Call>(call_node), call_node->op, args), virtual_device,
+                    /*constrain_result=*/false, /*constrain_body=*/true);
+  }
+
+  /*! \brief Returns the estimated number of operations of \p call_node. */
+  static double EstimateOps(const CallNode* call_node, OpPatternKind pattern,
+                            int64_t result_bytes) {
+    if (pattern == kOutEWiseFusable && call_node->args.size() >= 2) {
+      const auto* result_type = call_node->checked_type().as<TensorTypeNode>();
+      const auto* weight_type = call_node->args[1]->checked_type_.as<TensorTypeNode>();
+      if (result_type != nullptr && weight_type != nullptr && !weight_type->shape.empty()) {
+        int64_t num_results = StaticNumElements(result_type);
+        int64_t num_weights = StaticNumElements(weight_type);
+        const auto* out_channels = weight_type->shape[0].as<IntImmNode>();
+        if (num_results >= 0 && num_weights >= 0 && out_channels != nullptr &&
+            out_channels->value > 0) {
+          return static_cast<double>(num_results) * num_weights / out_channels->value;
+        }
+      }
+    }
+    // Assume 4 byte elements.
+    double num_bytes = result_bytes;
+    for (const Expr& arg : call_node->args) {
+      if (!arg->checked_type_.defined()) continue;
+      num_bytes += std::max<int64_t>(StaticSizeBytes(arg->checked_type()), 0);
+    }
+    return num_bytes / 4;
+  }
+
+  /*!
+   * \brief Returns the estimated time, in microseconds, to copy the arguments of \p call_node
+   * which are not already on \p virtual_device.
+   */
+  double EstimateCopyUs(const CallNode* call_node, const VirtualDevice& virtual_device) const {
+    double us = 0.0;
+    for (const Expr& arg : call_node->args) {
+      auto it = device_of_.find(arg.get());
+      if (it == device_of_.end() || it->second->device_type() == virtual_device->device_type()) {
+        continue;
+      }
+      int64_t num_bytes = arg->checked_type_.defined() ? StaticSizeBytes(arg->checked_type()) : 0;
+      us += kCopyLatencyUs + std::max<int64_t>(num_bytes, 0) / kCopyBytesPerUs;
+    }
+    return us;
+  }
+
+  /*! \brief The host virtual device. */
+  VirtualDevice host_;
+  /*! \brief The default primitive virtual device. */
+  VirtualDevice device_;
+  /*! \brief The bytes the results placed on the device may take, or 0 if unlimited. */
+  int64_t device_memory_limit_;
+  /*! \brief The bytes of the results placed on the device so far. */
+  int64_t device_bytes_ = 0;
+  /*! \brief The virtual device of the parameters, placed calls and the values derived from them. */
+  std::unordered_map<const ExprNode*, VirtualDevice> device_of_;
+};
+
 /* =============== Phase 0 =============== */
 
 /*!
@@ -1276,6 +1514,32 @@ tvm::transform::Pass Rewrite() {
   return tvm::relay::transform::CreateFunctionPass(pass_func, 0, "PlanDevicesRewrite", {});
 }
 
+/*! \brief Place the unannotated primitive calls by cost, if enabled in the pass config. */
+tvm::transform::Pass PlaceByCost(CompilationConfig config) {
+  auto pass_func = [config = std::move(config)](Function f, IRModule m,
+                                                transform::PassContext ctxt) -> Function {
+    if (!ctxt->GetConfig<Bool>("relay.PlanDevices.cost_based_placement", Bool(false)).value()) {
+      return f;
+    }
+    if (config->host_virtual_device->device_type() ==
+        config->default_primitive_virtual_device->device_type()) {
+      return f;
+    }
+    // Keep the placement of functions planned by an earlier run, so that the pass is idempotent.
+    bool planned = !f->virtual_device()->IsFullyUnconstrained();
+    for (const Var& param : f->params) {
+      planned = planned && !param->virtual_device()->IsFullyUnconstrained();
+    }
+    if (planned) return f;
+    int64_t device_memory_limit =
+        ctxt->GetConfig<Integer>("relay.PlanDevices.device_memory_limit", Integer(0))
+            .value()
+            ->value;
+    return CostBasedPlacer(config, device_memory_limit).Place(f);
+  };
+  return tvm::relay::transform::CreateFunctionPass(pass_func, 0, "PlanDevicesPlaceByCost", {});
+}
+
 /*! \brief Run the remaining phases. */
 tvm::transform::Pass PlanDevicesCore(CompilationConfig config) {
   return tvm::transform::CreateModulePass(
@@ -1304,9 +1568,13 @@ tvm::transform::Pass PlanDevicesCore(CompilationConfig config) {
 
 /* =============== Driver =============== */
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.PlanDevices.cost_based_placement", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.PlanDevices.device_memory_limit", Integer);
+
 // This function is declared in the public <tvm/relay/transform.h>.
 tvm::transform::Pass PlanDevices(CompilationConfig config) {
   std::vector<Pass> passes;
+  passes.emplace_back(PlaceByCost(config));
   passes.emplace_back(Rewrite());
   passes.emplace_back(PlanDevicesCore(std::move(config)));
   return tvm::transform::Sequential(passes, "PlanDevices");
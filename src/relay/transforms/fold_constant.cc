@@ -32,6 +32,9 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "../op/memory/on_device.h"
 #include "./pattern_utils.h"
 
@@ -250,6 +253,13 @@ class ConstantFolder : public MixedModeMutator {
   // Constant evaluate an expression.
   Expr ConstEvaluate(const Expr& expr) {
     VLOG_CONTEXT << "ConstEvaluate";
+    // Constants are compared by content, so structurally equal expressions, such as the
+    // same weight transpose repeated in every layer, are only compiled and evaluated once.
+    auto it = eval_cache_.find(expr);
+    if (it != eval_cache_.end()) {
+      VLOG(1) << "Reusing evaluation of :" << std::endl << PrettyPrint(expr);
+      return it->second;
+    }
     VLOG(1) << "Evaluating :" << std::endl << PrettyPrint(expr);
 
     // We'll invoke the interpreter using the generic CPU device and target. Technically there's
@@ -267,12 +277,26 @@ class ConstantFolder : public MixedModeMutator {
     // always use graph executor with no link-params
     dict.Set(tvm::attr::kExecutor,
              relay::Executor::Create("graph", {{"link-params", Bool(false)}}));
-    Expr result = ObjectToExpr(Eval(expr, module_->type_definitions, module_->Imports(),
-                                    eval_cpu_dev_, eval_cpu_target_, dict));
+    Expr result = Intern(ObjectToExpr(Eval(expr, module_->type_definitions, module_->Imports(),
+                                           eval_cpu_dev_, eval_cpu_target_, dict)));
     VLOG(1) << "Evaluated to constant:" << std::endl << PrettyPrint(result);
+    eval_cache_.emplace(expr, result);
     return result;
   }
 
+  // Return the constant equal to value already produced by this folder, if any, so that equal
+  // results share their data.
+  Expr Intern(const Expr& value) {
+    if (const auto* tuple_node = value.as<TupleNode>()) {
+      Array<Expr> fields;
+      for (const Expr& field : tuple_node->fields) {
+        fields.push_back(Intern(field));
+      }
+      return Tuple(fields);
+    }
+    return *constant_pool_.insert(value).first;
+  }
+
   /*!
    * \brief Returns constant shape result of \p call if it of form \p shape_of(e) and \p e has
    * a non-dynamic tensor shape. Returns null otherwise.
@@ -411,6 +435,11 @@ class ConstantFolder : public MixedModeMutator {
 
   // True if currently within a "primitive" Relay Function.
   bool inside_primitive_ = false;
+
+  // The results of the expressions evaluated so far.
+  std::unordered_map<Expr, Expr, StructuralHash, StructuralEqual> eval_cache_;
+  // The evaluated constants, deduplicated by content.
+  std::unordered_set<Expr, StructuralHash, StructuralEqual> constant_pool_;
 };
 
 }  // namespace
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/fuse_attention.cc
+ * \brief Rewrite the batch_matmul-softmax-batch_matmul chain of scaled dot-product attention
+ * into nn.fused_attention, which does not materialize the score matrix.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/dataflow_matcher.h>
+#include <tvm/relay/expr.h>
+#include <tvm/relay/transform.h>
+
+#include "../op/make_op.h"
+#include "./pattern_utils.h"
+#include "./simplify_expr.h"
+
+namespace tvm {
+namespace relay {
+
+/*!
+ * \brief Rewrite batch_matmul(softmax(batch_matmul(Q, K) * scale), V) into
+ * fused_attention(Q, K, V, scale). The scale is an optional scalar constant, which multiplies or
+ * divides the scores. Transposed operands of the batch_matmuls are transposed back explicitly.
+ */
+class FuseAttentionRewrite : public DFPatternRewrite {
+ public:
+  FuseAttentionRewrite() {
+    query_ = IsWildcard();
+    key_ = IsWildcard();
+    value_ = IsWildcard();
+    scale_ = IsConstant();
+    score_ = IsOp("nn.batch_matmul")({query_, key_});
+    scaled_score_ = IsOp("multiply")({score_, scale_}) || IsOp("multiply")({scale_, score_}) ||
+                    IsOp("divide")({score_, scale_});
+    prob_ = IsOp("nn.softmax")({scaled_score_ || score_});
+    pattern_ = IsOp("nn.batch_matmul")({prob_, value_});
+  }
+
+  Expr Callback(const Expr& pre, const Expr& post,
+                const Map<DFPattern, Array<Expr>>& node_map) const override {
+    Expr query = node_map[query_][0];
+    Expr key = node_map[key_][0];
+    Expr value = node_map[value_][0];
+    const auto* query_type = query->checked_type().as<TensorTypeNode>();
+    if (query_type == nullptr || !query_type->dtype.is_float() || query_type->shape.size() != 3) {
+      return post;
+    }
+    // The softmax should normalize each row of the scores
+    const auto* softmax_attrs = node_map[prob_][0].as<CallNode>()->attrs.as<SoftmaxAttrs>();
+    if (softmax_attrs->axis != -1 && softmax_attrs->axis != 2) {
+      return post;
+    }
+    const auto* score_attrs = node_map[score_][0].as<CallNode>()->attrs.as<BatchMatmulAttrs>();
+    const auto* output_attrs = post.as<CallNode>()->attrs.as<BatchMatmulAttrs>();
+    if (output_attrs->transpose_a) {
+      return post;
+    }
+    double scale = 1.0;
+    if (node_map.count(scale_)) {
+      const Expr& scale_expr = node_map[scale_][0];
+      if (!IsScalar(scale_expr)) {
+        return post;
+      }
+      std::optional<long double> scale_value = TryToScalar(scale_expr.as<ConstantNode>()->data);
+      if (!scale_value.has_value()) {
+        return post;
+      }
+      const auto* scaled = node_map[scaled_score_][0].as<CallNode>();
+      if (scaled->op == Op::Get("divide")) {
+        if (scale_value.value() == 0) {
+          return post;
+        }
+        scale = static_cast<double>(1.0 / scale_value.value());
+      } else {
+        scale = static_cast<double>(scale_value.value());
+      }
+    }
+    // fused_attention expects query [b, m, k], key [b, n, k] and value [b, n, d]
+    if (score_attrs->transpose_a) {
+      query = MakeTranspose(query, {0, 2, 1});
+    }
+    if (!score_attrs->transpose_b) {
+      key = MakeTranspose(key, {0, 2, 1});
+    }
+    if (output_attrs->transpose_b) {
+      value = MakeTranspose(value, {0, 2, 1});
+    }
+    DataType out_dtype = Downcast<TensorType>(pre->checked_type())->dtype;
+    return MakeFusedAttention(query, key, value, scale, out_dtype);
+  }
+
+ private:
+  /*! \brief Pattern input */
+  DFPattern query_;
+  DFPattern key_;
+  DFPattern value_;
+  DFPattern scale_;
+  /*! \brief Pattern of the intermediate results */
+  DFPattern score_;
+  DFPattern scaled_score_;
+  DFPattern prob_;
+};
+
+Expr FuseAttention(const Expr& expr, const IRModule& mod) {
+  DFPatternRewriteComposer composer;
+  composer.AddRewrite<FuseAttentionRewrite>();
+  return RewritePatterns(composer.MakeCallbacks(), expr, mod);
+}
+
+namespace transform {
+
+Pass FuseAttention() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(FuseAttention(f, m));
+      };
+  return CreateFunctionPass(pass_func, 0, "FuseAttention", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.FuseAttention").set_body_typed(FuseAttention);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -34,8 +34,10 @@
 #include <tvm/relay/op.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/vm/vm.h>
 #include <tvm/target/target.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <string>
@@ -59,12 +61,16 @@ using namespace tvm::runtime;
 namespace tvm {
 namespace relay {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ManifestAlloc.share_dynamic_storage", Bool);
+
 class DialectRewriter : public transform::DeviceAwareExprMutator {
  public:
-  DialectRewriter(IRModule mod, VirtualDevice host_virtual_device)
+  DialectRewriter(IRModule mod, VirtualDevice host_virtual_device,
+                  bool share_dynamic_storage = false)
       : transform::DeviceAwareExprMutator(mod),
         mod_(std::move(mod)),
-        host_virtual_device_(std::move(host_virtual_device)) {}
+        host_virtual_device_(std::move(host_virtual_device)),
+        share_dynamic_storage_(share_dynamic_storage) {}
 
   Function Rewrite(const Function& expr) { return Downcast<Function>(Mutate(expr)); }
 
@@ -215,12 +221,22 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
                                    assert_shape);
   }
 
-  Expr ComputeAlignment(const DataType& dtype) const {
+  /*! Returns an \p alloc_tensor call like the above, at the byte \p offset in \p storage. */
+  inline Expr AllocTensor(const Expr& storage, const Expr& offset, tvm::relay::Expr shape,
+                          DataType dtype, Array<IndexExpr> assert_shape) {
+    return tvm::relay::AllocTensor(storage, offset, std::move(shape), dtype, assert_shape);
+  }
+
+  int64_t AlignmentOf(const DataType& dtype) const {
     int64_t align = dtype.bits() / 8 * dtype.lanes();
     if (align < 64) {
       align = 64;
     }
-    return MakeConstantScalar(DataType::Int(64), align);
+    return align;
+  }
+
+  Expr ComputeAlignment(const DataType& dtype) const {
+    return MakeConstantScalar(DataType::Int(64), AlignmentOf(dtype));
   }
 
   Expr ComputeStorageInRelay(const Expr& shape, const TensorType& type) const {
@@ -343,9 +359,16 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
       out_shapes.push_back(alloc);
     }
 
-    // Represent the call in DPS form.
+    // Represent the call in DPS form. The shape function is marked so that the VM can
+    // recognize it and memoize its results.
+    auto relay_attrs = Downcast<DictAttrs>(attrs.metadata.at("relay_attrs"));
+    Map<String, ObjectRef> shape_func_attrs;
+    if (relay_attrs.defined()) {
+      shape_func_attrs = relay_attrs->dict;
+    }
+    shape_func_attrs.Set(runtime::vm::kShapeFuncAttr, String("1"));
     auto shape_call = InvokeTVMOp(prim_fn_var, Tuple(shape_func_ins), Tuple(out_shapes),
-                                  Downcast<DictAttrs>(attrs.metadata.at("relay_attrs")));
+                                  DictAttrs(shape_func_attrs));
     Var shape_func_var("shape_func", Type(nullptr));
     scope->Push(shape_func_var, MaybeOnDeviceFixed(shape_call, host_virtual_device_));
     return out_shapes;
@@ -357,17 +380,48 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
                      const Type& ret_type, const VirtualDevice& virtual_device) {
     Array<Expr> out_shapes = EmitShapeFunc(scope, ins, attrs);
     std::vector<Var> storages;
+    std::vector<Expr> offsets;
     CHECK_EQ(out_shapes.size(), out_types.size());
-    for (size_t i = 0; i < out_shapes.size(); ++i) {
-      auto out_shape = out_shapes[i];
-      auto out_type = out_types[i];
-      auto size =
-          MaybeOnDeviceFixed(ComputeStorageInRelay(out_shape, out_type), host_virtual_device_);
-      // Alignment is directly captured in the instruction so don't wrap in "on_device".
-      auto alignment = ComputeAlignment(out_type->dtype);
-      Var sto_var("storage_" + std::to_string(i), Type(nullptr));
-      auto val = AllocStorage(size, alignment, virtual_device, out_type->dtype);
-      storages.push_back(scope->Push(sto_var, MaybeOnDeviceFixed(val, virtual_device)));
+    if (share_dynamic_storage_ && out_shapes.size() > 1) {
+      // Place all the outputs in one storage, at offsets computed from their sizes when the
+      // call runs, so that the call allocates one storage rather than one per output.
+      int64_t align = 1;
+      for (const TensorType& out_type : out_types) {
+        align = std::max(align, AlignmentOf(out_type->dtype));
+      }
+      Expr total = MakeConstantScalar(DataType::Int(64), 0);
+      for (size_t i = 0; i < out_shapes.size(); ++i) {
+        Var offset_var("offset_" + std::to_string(i), Type(nullptr));
+        offsets.push_back(
+            scope->Push(offset_var, MaybeOnDeviceFixed(total, host_virtual_device_)));
+        // Round the size up, so that the next output is aligned as well
+        Expr size = ComputeStorageInRelay(out_shapes[i], out_types[i]);
+        Expr align_expr = MakeConstantScalar(DataType::Int(64), align);
+        size = Multiply(
+            Divide(Add(size, MakeConstantScalar(DataType::Int(64), align - 1)), align_expr),
+            align_expr);
+        total = Add(offsets.back(), size);
+      }
+      Var sto_var("storage", Type(nullptr));
+      auto val = AllocStorage(MaybeOnDeviceFixed(total, host_virtual_device_),
+                              MakeConstantScalar(DataType::Int(64), align), virtual_device,
+                              out_types[0]->dtype);
+      storages.assign(out_shapes.size(),
+                      scope->Push(sto_var, MaybeOnDeviceFixed(val, virtual_device)));
+    } else {
+      for (size_t i = 0; i < out_shapes.size(); ++i) {
+        auto out_shape = out_shapes[i];
+        auto out_type = out_types[i];
+        auto size =
+            MaybeOnDeviceFixed(ComputeStorageInRelay(out_shape, out_type), host_virtual_device_);
+        // Alignment is directly captured in the instruction so don't wrap in "on_device".
+        auto alignment = ComputeAlignment(out_type->dtype);
+        Var sto_var("storage_" + std::to_string(i), Type(nullptr));
+        auto val = AllocStorage(size, alignment, virtual_device, out_type->dtype);
+        storages.push_back(scope->Push(sto_var, MaybeOnDeviceFixed(val, virtual_device)));
+        offsets.push_back(
+            MaybeOnDeviceFixed(MakeConstantScalar(DataType::Int(64), 0), host_virtual_device_));
+      }
     }
 
     Array<Expr> outs;
@@ -375,7 +429,7 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
       auto out_shape = out_shapes[i];
       auto out_type = out_types[i];
       auto storage = storages[i];
-      auto alloc = AllocTensor(storage, out_shape, out_type->dtype, out_type->shape);
+      auto alloc = AllocTensor(storage, offsets[i], out_shape, out_type->dtype, out_type->shape);
       Var out_var("out_" + std::to_string(i), Type(nullptr));
       outs.push_back(scope->Push(out_var, MaybeOnDeviceFixed(alloc, virtual_device)));
     }
@@ -417,6 +471,8 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
   runtime::DataType compute_dtype_ = runtime::DataType::Int(64);
   IRModule mod_;
   VirtualDevice host_virtual_device_;
+  /*! \brief Whether the dynamically shaped outputs of a call share one storage */
+  bool share_dynamic_storage_;
 
   std::vector<LetList> scopes_;
 };
@@ -435,7 +491,9 @@ Pass ManifestAllocImportStorage() {
 
 Pass ManifestAllocImpl(VirtualDevice host_virtual_device) {
   auto pass_func = [host_virtual_device](Function func, IRModule mod, PassContext ctxt) {
-    return DialectRewriter(mod, host_virtual_device).Rewrite(func);
+    bool share_dynamic_storage =
+        ctxt->GetConfig<Bool>("relay.ManifestAlloc.share_dynamic_storage", Bool(false)).value();
+    return DialectRewriter(mod, host_virtual_device, share_dynamic_storage).Rewrite(func);
   };
   return CreateFunctionPass(pass_func, 0, "ManifestAllocImpl", {});
 }
@@ -0,0 +1,165 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/rewrite_embedding_lookup.cc
+ * \brief Rewrite row gathers from large embedding tables, and their per bag sums and means,
+ * into nn.contrib_embedding_lookup.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/attrs/reduce.h>
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/dataflow_matcher.h>
+#include <tvm/relay/expr.h>
+#include <tvm/relay/transform.h>
+
+#include "../op/make_op.h"
+#include "./pattern_utils.h"
+#include "./simplify_expr.h"
+
+namespace tvm {
+namespace relay {
+
+/*!
+ * \brief Base of the embedding rewrites, matching take(table, indices, axis=0) on a static 2-D
+ * table of at least min_table_bytes bytes.
+ */
+class EmbeddingTakeRewrite : public DFPatternRewrite {
+ public:
+  explicit EmbeddingTakeRewrite(int64_t min_table_bytes) : min_table_bytes_(min_table_bytes) {
+    table_ = IsWildcard();
+    indices_ = IsWildcard();
+    take_ = IsOp("take")({table_, indices_});
+  }
+
+ protected:
+  /*! \brief Whether the matched take is a row lookup the embedding kernel can serve. */
+  bool IsEmbeddingTake(const Map<DFPattern, Array<Expr>>& node_map) const {
+    const auto* table_type = node_map[table_][0]->checked_type().as<TensorTypeNode>();
+    const auto* indices_type = node_map[indices_][0]->checked_type().as<TensorTypeNode>();
+    if (table_type == nullptr || indices_type == nullptr || table_type->shape.size() != 2 ||
+        !indices_type->dtype.is_int()) {
+      return false;
+    }
+    const auto* attrs = node_map[take_][0].as<CallNode>()->attrs.as<TakeAttrs>();
+    // the kernel clips out of bound indices, which is also valid for fast mode
+    if (!attrs->axis.defined() || attrs->axis->value != 0 || attrs->batch_dims->value != 0 ||
+        attrs->mode == "wrap") {
+      return false;
+    }
+    int64_t table_bytes = table_type->dtype.bytes();
+    for (const PrimExpr& dim : table_type->shape) {
+      const auto* extent = dim.as<IntImmNode>();
+      if (extent == nullptr) return false;
+      table_bytes *= extent->value;
+    }
+    return table_bytes >= min_table_bytes_;
+  }
+
+  /*! \brief The minimum size of the rewritten tables. */
+  int64_t min_table_bytes_;
+  /*! \brief Pattern input */
+  DFPattern table_;
+  DFPattern indices_;
+  /*! \brief Pattern of the row gather */
+  DFPattern take_;
+};
+
+/*! \brief Rewrite take(table, indices, axis=0) into embedding_lookup(table, indices). */
+class EmbeddingGatherRewrite : public EmbeddingTakeRewrite {
+ public:
+  explicit EmbeddingGatherRewrite(int64_t min_table_bytes)
+      : EmbeddingTakeRewrite(min_table_bytes) {
+    pattern_ = take_;
+  }
+
+  Expr Callback(const Expr& pre, const Expr& post,
+                const Map<DFPattern, Array<Expr>>& node_map) const override {
+    if (!IsEmbeddingTake(node_map)) {
+      return post;
+    }
+    return MakeEmbeddingLookup(node_map[table_][0], node_map[indices_][0], "none");
+  }
+};
+
+/*!
+ * \brief Rewrite sum or mean of take(table, indices, axis=0) over the last axis of indices, the
+ * embedding_bag pattern, into embedding_lookup(table, indices, mode). The looked up rows are
+ * accumulated without materializing them.
+ */
+class EmbeddingBagRewrite : public EmbeddingTakeRewrite {
+ public:
+  explicit EmbeddingBagRewrite(int64_t min_table_bytes) : EmbeddingTakeRewrite(min_table_bytes) {
+    pattern_ = IsOp("sum")({take_}) || IsOp("mean")({take_});
+  }
+
+  Expr Callback(const Expr& pre, const Expr& post,
+                const Map<DFPattern, Array<Expr>>& node_map) const override {
+    if (!IsEmbeddingTake(node_map)) {
+      return post;
+    }
+    const auto* call = post.as<CallNode>();
+    const auto* attrs = call->attrs.as<ReduceAttrs>();
+    const auto* take_type = node_map[take_][0]->checked_type().as<TensorTypeNode>();
+    const auto* table_type = node_map[table_][0]->checked_type().as<TensorTypeNode>();
+    if (take_type == nullptr || !table_type->dtype.is_float() ||
+        (table_type->dtype.bits() != 32 && table_type->dtype.bits() != 64)) {
+      return post;
+    }
+    // the bag axis is the last axis of indices, the one before the embedding dimension
+    int64_t ndim = static_cast<int64_t>(take_type->shape.size());
+    if (ndim < 2 || attrs->keepdims || attrs->exclude || !attrs->axis.defined() ||
+        attrs->axis.size() != 1) {
+      return post;
+    }
+    int64_t axis = attrs->axis[0]->value;
+    if (axis < 0) axis += ndim;
+    if (axis != ndim - 2) {
+      return post;
+    }
+    String mode = call->op == Op::Get("sum") ? "sum" : "mean";
+    return MakeEmbeddingLookup(node_map[table_][0], node_map[indices_][0], mode);
+  }
+};
+
+Expr RewriteEmbeddingLookup(const Expr& expr, const IRModule& mod, int64_t min_table_bytes) {
+  DFPatternRewriteComposer composer;
+  // bags first, so that their takes are not rewritten into gathers on their own
+  composer.AddRewrite<EmbeddingBagRewrite>(min_table_bytes);
+  composer.AddRewrite<EmbeddingGatherRewrite>(min_table_bytes);
+  return RewritePatterns(composer.MakeCallbacks(), expr, mod);
+}
+
+namespace transform {
+
+Pass RewriteEmbeddingLookup(int64_t min_table_bytes) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(RewriteEmbeddingLookup(f, m, min_table_bytes));
+      };
+  return CreateFunctionPass(pass_func, 0, "RewriteEmbeddingLookup", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.RewriteEmbeddingLookup")
+    .set_body_typed(RewriteEmbeddingLookup);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -35,6 +35,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../op/tensor/transform.h"
 #include "fold_constant.h"
@@ -502,6 +503,67 @@ class SimplifyNoOpTranspose : public DFPatternRewrite {
   DFPattern x_;
 };
 
+/*!
+ * \brief SimplifyLayoutTransformAroundElemwise matches a layout_transform and its inverse which
+ *  are separated by a chain of unary elementwise ops, e.g. the transforms that AlterOpLayout
+ *  inserts around an activation whose neighbours disagree on the layout, and removes both, so
+ *  that the elementwise ops run on the layout of the original input.
+ */
+class SimplifyLayoutTransformAroundElemwise : public DFPatternRewrite {
+ public:
+  SimplifyLayoutTransformAroundElemwise() {
+    x_ = IsWildcard();
+    pattern_ = IsOp("layout_transform")({x_});
+  }
+
+  Expr Callback(const Expr& pre, const Expr& post,
+                const Map<DFPattern, Array<Expr>>& node_map) const override {
+    static const Op& layout_transform_op = Op::Get("layout_transform");
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    const auto* outer_attrs = Downcast<Call>(post)->attrs.as<LayoutTransformAttrs>();
+    ICHECK(outer_attrs);
+    // Walk down the chain of unary elementwise ops to the inner layout_transform
+    std::vector<Call> chain;
+    Expr expr = node_map[x_][0];
+    while (const auto* call = expr.as<CallNode>()) {
+      if (call->op.same_as(layout_transform_op)) {
+        break;
+      }
+      const auto* op = call->op.as<OpNode>();
+      if (op == nullptr || call->args.size() != 1 || !fpattern.count(GetRef<Op>(op)) ||
+          fpattern[GetRef<Op>(op)] != kElemWise) {
+        return post;
+      }
+      chain.push_back(GetRef<Call>(call));
+      expr = call->args[0];
+    }
+    // Consecutive layout transforms are handled by SimplifyTranspose
+    if (chain.empty()) {
+      return post;
+    }
+    const auto* inner = expr.as<CallNode>();
+    if (inner == nullptr || !inner->op.same_as(layout_transform_op)) {
+      return post;
+    }
+    const auto* inner_attrs = inner->attrs.as<LayoutTransformAttrs>();
+    ICHECK(inner_attrs);
+    if (inner_attrs->src_layout != outer_attrs->dst_layout ||
+        inner_attrs->dst_layout != outer_attrs->src_layout) {
+      return post;
+    }
+    // Replay the elementwise ops on the input of the inner layout_transform
+    Expr result = inner->args[0];
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      result = Call((*it)->op, {result}, (*it)->attrs, (*it)->type_args, (*it)->span);
+    }
+    return result;
+  }
+
+ private:
+  /*! \brief Pattern input */
+  DFPattern x_;
+};
+
 /*!
  * \brief FullElementwise finds full like ops followed by broadcasting ops, and eliminates
  * the full op by directly passing the fill value into the broadcasting op.
@@ -1076,6 +1138,7 @@ Expr SimplifyExpr(const Expr& expr, const IRModule& mod) {
   composer.AddRewrite<SimplifyReshape>();
   composer.AddRewrite<SimplifyTranspose>();
   composer.AddRewrite<SimplifyNoOpTranspose>();
+  composer.AddRewrite<SimplifyLayoutTransformAroundElemwise>();
   composer.AddRewrite<SimplifySameCast>();
   composer.AddRewrite<SimplifyConsecutiveCast>();
   composer.AddRewrite<FullElementwise>();
@@ -1096,6 +1159,7 @@ Expr SimplifyExprPostAlterOp(const Expr& expr, const IRModule& mod) {
   DFPatternRewriteComposer composer;
   composer.AddRewrite<EliminateIdentityRewrite>();
   composer.AddRewrite<SimplifyReshape>();
+  composer.AddRewrite<SimplifyLayoutTransformAroundElemwise>();
   composer.AddRewrite<SimplifySameCast>();
   composer.AddRewrite<SimplifyConsecutiveCast>();
   composer.AddRewrite<SimplifyClipAndConsecutiveCast>();
@@ -29,6 +29,8 @@
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/object.h>
 
+#include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "pattern_utils.h"
@@ -37,6 +39,7 @@ namespace tvm {
 namespace relay {
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.keep_orig_output_dtype", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.never_ops", Array<String>);
 // A callable which hashes std::pair
 struct pair_hash {
   template <class T1, class T2>
@@ -109,6 +112,8 @@ class MixedPrecisionPass : public MixedModeMutator {
   const RelayExprNode* root_;
   std::vector<DataType> original_dtype_;
   bool keep_orig_output_dtype_;
+  /*! \brief The names of the ops kept in float32 regardless of their registered category. */
+  std::unordered_set<std::string> never_ops_;
 
   Attrs GetNewAttrs(const CallNode* call, const DataType& accumulation_dtype) const {
     /* If the accumulation dtype is in the attributes make a copy and mutate the field. */
@@ -286,11 +291,15 @@ class MixedPrecisionPass : public MixedModeMutator {
   using MixedModeMutator::VisitExpr_;
 
   explicit MixedPrecisionPass(Expr base, bool keep_orig_output_dtype,
-                              DataType mixed_precision_type = DataType::Float(16))
+                              DataType mixed_precision_type = DataType::Float(16),
+                              const Array<String>& never_ops = {})
       : MixedModeMutator(),
         mixed_precision_type_(mixed_precision_type),
         root_(Downcast<Function>(base)->body.get()),
         keep_orig_output_dtype_(keep_orig_output_dtype) {
+    for (const String& op_name : never_ops) {
+      never_ops_.insert(op_name);
+    }
     if (keep_orig_output_dtype_) {
       if (root_->IsInstance<tvm::relay::TupleNode>()) {
         const TupleTypeNode* tuple_type = (root_->checked_type_).as<TupleTypeNode>();
@@ -355,6 +364,12 @@ class MixedPrecisionPass : public MixedModeMutator {
         accumulation_dtype = mixed_precision_type_;
         output_dtype = mixed_precision_type_;
       }
+      if (never_ops_.count(op->name)) {
+        // The op is requested to stay in float32, e.g. for the accuracy of the model
+        initial_category = MIXED_PRECISION_NEVER;
+        accumulation_dtype = DataType::Float(32);
+        output_dtype = DataType::Float(32);
+      }
     } else {
       LOG(FATAL) << "Unsupported op type in CallNode: " << pre_call_node->op;
     }
@@ -464,11 +479,13 @@ class MixedPrecisionPass : public MixedModeMutator {
 
   // To access map of ops not registered for error reporting
   friend Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                               const DataType& mixed_precision_type, int missing_op_mode);
+                               const DataType& mixed_precision_type, int missing_op_mode,
+                               const Array<String>& never_ops);
 };
 
 Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                      const DataType& mixed_precision_type, int missing_op_mode) {
+                      const DataType& mixed_precision_type, int missing_op_mode,
+                      const Array<String>& never_ops) {
   /*
   missing_op_mode:
 
@@ -480,7 +497,7 @@ Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
       << " missing_op_mode must be either 0, 1, or 2 got " << missing_op_mode;
 
   MixedPrecisionPass converter =
-      MixedPrecisionPass(expr, keep_orig_output_dtype, mixed_precision_type);
+      MixedPrecisionPass(expr, keep_orig_output_dtype, mixed_precision_type, never_ops);
   auto result = converter.Mutate(expr);
 
   for (auto it = converter.missing_ops_.begin();
@@ -508,8 +525,10 @@ Pass ToMixedPrecision(DataType mixed_precision_type, int missing_op_mode) {
         keep_orig_output_dtype = pc->GetConfig("relay.ToMixedPrecision.keep_orig_output_dtype",
                                                Bool(keep_orig_output_dtype))
                                      .value();
-        return Downcast<Function>(
-            ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type, missing_op_mode));
+        Array<String> never_ops =
+            pc->GetConfig("relay.ToMixedPrecision.never_ops", Array<String>()).value();
+        return Downcast<Function>(ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type,
+                                                   missing_op_mode, never_ops));
       };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
@@ -799,6 +799,11 @@ Expr TypeInferencer::Infer(GlobalVar var, Function function) {
 
 struct AllCheckTypePopulated : MixedModeVisitor {
   using MixedModeVisitor::VisitExpr_;
+  /*! \brief Whether to fail on a missing type, or only to record it in all_populated */
+  bool fatal{true};
+  /*! \brief Whether all the visited expressions have their types populated */
+  bool all_populated{true};
+
   void DispatchExprVisit(const Expr& e) {
     if (e.as<OpNode>()) {
       return;
@@ -809,7 +814,11 @@ struct AllCheckTypePopulated : MixedModeVisitor {
     if (e.as<ConstructorNode>()) {
       return;
     }
-    ICHECK(e->checked_type_.defined()) << "Expression: " << e;
+    if (!e->checked_type_.defined()) {
+      ICHECK(!fatal) << "Expression: " << e;
+      all_populated = false;
+      return;
+    }
     return ExprVisitor::VisitExpr(e);
   }
   void VisitExpr_(const LetNode* op) final {
@@ -827,6 +836,13 @@ struct AllCheckTypePopulated : MixedModeVisitor {
 
 void EnsureCheckedType(const Expr& e) { AllCheckTypePopulated().VisitExpr(e); }
 
+bool IsCheckedTypePopulated(const Expr& e) {
+  AllCheckTypePopulated checker;
+  checker.fatal = false;
+  checker.VisitExpr(e);
+  return checker.all_populated;
+}
+
 // TODO(@jroesch): Can we optimize this?
 void AddGlobalTypes(IRModule mod) {
   std::vector<std::pair<GlobalVar, Function>> updates;
@@ -923,6 +939,8 @@ class SameTypedSubgraphExtractor : public ExprMutator {
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType.incremental", Bool);
+
 Type InferTypeLocal(const Expr& expr) {
   /*
   This type inference differs from InferType in that it uses existing type information
@@ -958,43 +976,82 @@ Pass InferType() {
 
         pass_ctx->diag_ctx = DiagnosticContext::Default(updated_mod);
 
+        bool incremental =
+            pass_ctx->GetConfig<Bool>("relay.InferType.incremental", Bool(false)).value();
+
         // Add all the type annotations to the functions in the model.
         AddGlobalTypes(mod);
 
-        std::vector<std::pair<GlobalVar, Function>> updates;
-        for (const auto& it : updated_mod->functions) {
-          // Currently we don't type check TIR.
-          //
-          // The inferencer will only check Relay functions.
+        // Currently we don't type check TIR.
+        //
+        // The inferencer will only check Relay functions.
 
-          // In the future we plan a unified type checker
-          // that works on TIR and Relay at the same time.
+        // In the future we plan a unified type checker
+        // that works on TIR and Relay at the same time.
+        std::vector<GlobalVar> worklist;
+        std::unordered_set<const GlobalVarNode*> scheduled;
+        // The callers of each global function, only collected in the incremental mode.
+        std::unordered_map<const GlobalVarNode*, std::vector<GlobalVar>> callers;
+        for (const auto& it : updated_mod->functions) {
           if (auto func = it.second.as<Function>()) {
-            // // If a function already has type information we can skip checking it.
-            // if (func->checked_type_.defined()) {
-            //   continue;
-            // }
+            // In the incremental mode, a function whose expressions are all typed is assumed
+            // to be unchanged, and is only checked again if the type of a callee changes.
+            if (incremental && func.value()->checked_type_.defined() &&
+                IsCheckedTypePopulated(func.value())) {
+              it.first->checked_type_ = func.value()->checked_type_;
+            } else {
+              worklist.push_back(it.first);
+              scheduled.insert(it.first.get());
+            }
+            if (incremental) {
+              GlobalVar caller = it.first;
+              PostOrderVisit(func.value(), [&callers, &caller](const Expr& e) {
+                if (const auto* callee = e.as<GlobalVarNode>()) {
+                  std::vector<GlobalVar>& vec = callers[callee];
+                  if (vec.empty() || !vec.back().same_as(caller)) {
+                    vec.push_back(caller);
+                  }
+                }
+              });
+            }
+          }
+        }
 
-            // TODO(@jroesch): we should be able to move the type inferencer outside
-            // of this function but it seems to be more stateful then I expect.
-            auto inferencer = TypeInferencer(mod, pass_ctx->diag_ctx.value());
-            auto updated_func = inferencer.Infer(it.first, func.value());
+        std::vector<std::pair<GlobalVar, Function>> updates;
+        for (size_t i = 0; i < worklist.size(); ++i) {
+          GlobalVar gv = worklist[i];
+          Function func = Downcast<Function>(updated_mod->Lookup(gv));
+          Type old_type = func->checked_type_;
 
-            pass_ctx->diag_ctx.value().Render();
+          // TODO(@jroesch): we should be able to move the type inferencer outside
+          // of this function but it seems to be more stateful then I expect.
+          auto inferencer = TypeInferencer(mod, pass_ctx->diag_ctx.value());
+          auto updated_func = inferencer.Infer(gv, func);
 
-            // After we are done checking write the global type back
-            // into the global var.
-            it.first->checked_type_ = updated_func->checked_type();
+          pass_ctx->diag_ctx.value().Render();
 
-            if (!WellFormed(updated_func, pass_ctx->diag_ctx)) {
-              LOG(FATAL) << "The type checked intermediate representation is malformed";
-            }
+          // After we are done checking write the global type back
+          // into the global var.
+          gv->checked_type_ = updated_func->checked_type();
+
+          if (!WellFormed(updated_func, pass_ctx->diag_ctx)) {
+            LOG(FATAL) << "The type checked intermediate representation is malformed";
+          }
 
-            auto free_tvars = FreeTypeVars(updated_func, mod);
-            ICHECK(free_tvars.size() == 0)
-                << "Found unbound type variables in " << updated_func << ": " << free_tvars;
-            EnsureCheckedType(updated_func);
-            updates.push_back({it.first, Downcast<Function>(updated_func)});
+          auto free_tvars = FreeTypeVars(updated_func, mod);
+          ICHECK(free_tvars.size() == 0)
+              << "Found unbound type variables in " << updated_func << ": " << free_tvars;
+          EnsureCheckedType(updated_func);
+          updates.push_back({gv, Downcast<Function>(updated_func)});
+
+          // The callers have to be checked again if the type of the function changes.
+          if (incremental &&
+              !(old_type.defined() && StructuralEqual()(old_type, updated_func->checked_type()))) {
+            for (const GlobalVar& caller : callers[gv.get()]) {
+              if (scheduled.insert(caller.get()).second) {
+                worklist.push_back(caller);
+              }
+            }
           }
         }
 
@@ -27,6 +27,7 @@
 
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/name_transforms.h>
 
 #include <limits>
@@ -174,8 +175,7 @@ void AotExecutor::Run() {
   auto call_values = ::std::make_unique<TVMValue[]>(num_args);
   auto call_type_codes = ::std::make_unique<int[]>(num_args);
   for (int i = 0; i < num_args; ++i) {
-    auto managed = args_[i].ToDLPack();
-    call_values.get()[i].v_handle = &managed->dl_tensor;
+    call_values.get()[i].v_handle = const_cast<DLTensor*>(args_[i].operator->());
     call_type_codes.get()[i] = kTVMDLTensorHandle;
   }
 
@@ -211,12 +211,45 @@ int AotExecutor::GetOutputIndex(const std::string& name) {
 
 void AotExecutor::SetInput(int index, DLTensor* data_ref) { args_[index].CopyFrom(data_ref); }
 
+void AotExecutor::CheckExternalDLTensor(const DLTensor* external,
+                                        const metadata::TensorInfo& info) const {
+  ICHECK(IsContiguous(*external)) << "Buffer bound to " << info->name() << " must be contiguous";
+  ICHECK_EQ(reinterpret_cast<size_t>(static_cast<char*>(external->data) + external->byte_offset) %
+                kAllocAlignment,
+            0)
+      << "Buffer bound to " << info->name() << " must be aligned to " << kAllocAlignment
+      << " bytes";
+  ICHECK_EQ(external->device.device_type, devices_[0].device_type);
+  ICHECK_EQ(external->device.device_id, devices_[0].device_id);
+  ICHECK(DataType(external->dtype) == info->dtype())
+      << "Buffer bound to " << info->name() << " has type " << DataType(external->dtype)
+      << ", expected " << info->dtype();
+  ICHECK_EQ(external->ndim, info->num_shape());
+  for (int i = 0; i < external->ndim; ++i) {
+    ICHECK_EQ(external->shape[i], info->shape()[i])
+        << "Buffer bound to " << info->name() << " has a different shape at dimension " << i;
+  }
+}
+
+NDArray AotExecutor::ViewExternalDLTensor(const DLTensor* external) {
+  // The entrypoint binds the data pointer of its arguments, fold the offset into it.
+  DLTensor view = *external;
+  view.data = static_cast<char*>(external->data) + external->byte_offset;
+  view.byte_offset = 0;
+  view.strides = nullptr;
+  return NDArray::FromExternalDLTensor(view);
+}
+
 void AotExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
-  ICHECK(false) << "not implemented";
+  ICHECK_LT(index, NumInputs());
+  CheckExternalDLTensor(data_ref, metadata_->inputs()[index]);
+  args_[index] = ViewExternalDLTensor(data_ref);
 }
 
 void AotExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
-  ICHECK(false) << "not implemented";
+  ICHECK_LT(index, NumOutputs());
+  CheckExternalDLTensor(data_ref, metadata_->outputs()[index]);
+  args_[metadata_->num_inputs() + index] = ViewExternalDLTensor(data_ref);
 }
 
 int AotExecutor::NumOutputs() const { return metadata_->num_outputs(); }
@@ -94,12 +94,17 @@ class TVM_DLL AotExecutor : public ModuleNode {
   void SetInput(int index, DLTensor* data_in);
   /*!
    * \brief set index-th input to the graph without copying the data
+   *
+   * The buffer replaces the one allocated for the input until it is bound again,
+   * so GetInput and SetInput refer to it as well.
    * \param index The input index.
    * \param data_ref The input data that is referred.
    */
   void SetInputZeroCopy(int index, DLTensor* data_ref);
   /*!
    * \brief set index-th output to the graph without copying the data.
+   *
+   * The buffer replaces the one allocated for the output until it is bound again.
    * \param index The output index.
    * \param data_ref The output data that is referred.
    */
@@ -138,6 +143,15 @@ class TVM_DLL AotExecutor : public ModuleNode {
   void CopyOutputTo(int index, DLTensor* data_out);
 
  private:
+  /*!
+   * \brief Check that a buffer can be bound to an input or output of the model.
+   * \param external The buffer to bind.
+   * \param info The metadata of the input or output.
+   */
+  void CheckExternalDLTensor(const DLTensor* external, const metadata::TensorInfo& info) const;
+  /*! \brief Wrap a buffer bound to an input or output, without owning its data. */
+  static NDArray ViewExternalDLTensor(const DLTensor* external);
+
   /*! \brief Metadata provided to the runtime from the compiler. */
   metadata::Metadata metadata_;
 
@@ -26,6 +26,9 @@
 #include <CL/opencl.h>
 #ifdef TVM_GRAPH_EXECUTOR_CLML
 #include <CL/cl_qcom_ml_ops.h>
+#if __has_include(<CL/cl_ext_qcom.h>)
+#include <CL/cl_ext_qcom.h>
+#endif
 #endif
 #include <stdlib.h>
 #include <tvm/runtime/ndarray.h>
@@ -33,7 +36,9 @@
 #include <tvm/runtime/registry.h>
 
 #include <fstream>
+#include <iomanip>
 #include <map>
+#include <sstream>
 #include <utility>
 
 #include "../../file_utils.h"
@@ -73,7 +78,17 @@ class CLMLRuntime : public JSONRuntimeBase {
   ~CLMLRuntime() {
 #ifdef TVM_GRAPH_EXECUTOR_CLML
     cl_int result = 0;
-    if (this->is_tuning_run) {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    if (this->recording) {
+      result = clReleaseRecordingQCOM(this->recording);
+      ICHECK(result == CL_SUCCESS) << "clReleaseRecordingQCOM:" << result;
+    }
+    if (this->recordable_queue) {
+      result = clReleaseCommandQueue(this->recordable_queue);
+      ICHECK(result == CL_SUCCESS) << "clReleaseCommandQueue:" << result;
+    }
+#endif
+    if (this->tuning_cache) {
       result = h_ClmlIntf->clReleaseMLTuningCacheQCOM(this->tuning_cache);
       ICHECK(result == CL_SUCCESS) << "clReleaseMLTuningCacheQCOM:" << result;
     }
@@ -185,42 +200,75 @@ class CLMLRuntime : public JSONRuntimeBase {
     // A Tuning run, so create the cache from scratch
     result = h_ClmlIntf->clCreateMLTuningCacheQCOM(&tuning_cache);
     ICHECK(result == CL_SUCCESS) << "clCreateMLTuningCacheQCOM:" << result;
+    tuning_key = GetTuningCacheKey();
     if (!this->is_tuning_run && this->tuning_file) {
       std::vector<unsigned char> tune_buffer;
       std::string tune_blob;
-      LoadBinaryFromFile(this->tuning_file, &tune_blob);
+      if (std::ifstream(this->tuning_file).good()) {
+        LoadBinaryFromFile(this->tuning_file, &tune_blob);
+      }
       dmlc::MemoryStringStream mstrm(const_cast<std::string*>(&tune_blob));
       dmlc::Stream* strm = &mstrm;
 
+      // Entries are appended, so the last one for the key is the most recent tuning. Entries
+      // keyed by the symbol alone were written before the key included the device and model.
       uint64_t header, reserve;
       std::string tune_symbol;
+      bool exact_match = false;
       while (strm->Read(&header)) {
         if (header != kTVMCLMLTuningCacheMagic) break;
         if (!strm->Read(&reserve)) break;
         if (!strm->Read(&tune_symbol)) break;
-        LOG(INFO) << "Tuning Cache Symbol:" << tune_symbol;
-        if (tune_symbol == clml_symbol) {
-          strm->Read(&tune_buffer);
-          break;
-        } else {
-          std::vector<unsigned char> tmp_buf;
-          if (!strm->Read(&tmp_buf)) break;
+        std::vector<unsigned char> entry_buffer;
+        if (!strm->Read(&entry_buffer)) break;
+        if (tune_symbol == tuning_key) {
+          tune_buffer = std::move(entry_buffer);
+          exact_match = true;
+        } else if (tune_symbol == clml_symbol && !exact_match) {
+          tune_buffer = std::move(entry_buffer);
         }
       }
 
       if (tune_buffer.size()) {
-        LOG(INFO) << "Loading tuning cache for symbol:" << clml_symbol
-                  << " size:" << tune_buffer.size();
+        LOG(INFO) << "Loading tuning cache for:" << tuning_key << " size:" << tune_buffer.size();
         result = h_ClmlIntf->clLoadMLTuningCacheQCOM(tuning_cache, tune_buffer.size(),
                                                      tune_buffer.data());
         ICHECK(result == CL_SUCCESS) << "clLoadMLTuningCacheQCOM:" << result;
       } else {
-        LOG(WARNING) << "Tuning cache not cound for symbol :" << clml_symbol << " in file "
-                     << this->tuning_file;
+        // Tune this sub-graph once on this device and persist the result for the next sessions.
+        LOG(WARNING) << "Tuning cache not found for:" << tuning_key << " in file "
+                     << this->tuning_file << ", tuning now";
+        this->is_tuning_run = 1;
       }
     }
   }
 
+  /*!
+   * \brief Get the key of the tuning cache entry of this sub-graph, which is only valid for the
+   * same device, driver and sub-graph.
+   */
+  std::string GetTuningCacheKey() {
+    auto get_device_string = [this](cl_device_info param) {
+      size_t size = 0;
+      cl_int result = clGetDeviceInfo(device_id, param, 0, nullptr, &size);
+      ICHECK(result == CL_SUCCESS) << "clGetDeviceInfo:" << result;
+      std::vector<char> buf(size + 1, 0);
+      result = clGetDeviceInfo(device_id, param, size, buf.data(), nullptr);
+      ICHECK(result == CL_SUCCESS) << "clGetDeviceInfo:" << result;
+      return std::string(buf.data());
+    };
+    // FNV-1a, which is stable across processes unlike std::hash.
+    uint64_t graph_hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : graph_json_) {
+      graph_hash = (graph_hash ^ c) * 0x100000001b3ULL;
+    }
+    std::ostringstream os;
+    os << clml_symbol << ":" << get_device_string(CL_DEVICE_NAME) << ":"
+       << get_device_string(CL_DRIVER_VERSION) << ":" << std::hex << std::setw(16)
+       << std::setfill('0') << graph_hash;
+    return os.str();
+  }
+
   std::vector<unsigned char> readBinFile(const std::string& filename) {
     std::ifstream fin(filename, std::ios::binary | std::ios::ate);
     if (!fin.good()) {
@@ -313,7 +361,14 @@ class CLMLRuntime : public JSONRuntimeBase {
     }
 
     int64_t duration = 0;
-    for (size_t i = 0; i < this->layer_.function.size(); ++i) {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    if (this->recording && !getenv("CLML_PROFILING")) {
+      result = clEnqueueRecordingQCOM(queue, this->recording, 0, nullptr, 0, nullptr, 0, nullptr, 0,
+                                      nullptr, 0, nullptr, nullptr);
+      ICHECK(result == CL_SUCCESS) << "clEnqueueRecordingQCOM:" << result;
+    }
+#endif
+    for (size_t i = 0; i < this->layer_.function.size() && !IsDispatchRecorded(); ++i) {
       // Make CLML subgraphs accounted by OpenCLTimerNode.
 
       if (getenv("CLML_PROFILING")) {
@@ -548,7 +603,7 @@ class CLMLRuntime : public JSONRuntimeBase {
       uint64_t reserved = 0x0;
       strm->Write(header);
       strm->Write(reserved);
-      strm->Write(clml_symbol);
+      strm->Write(tuning_key);
       strm->Write(saved_cache);
 
       std::ofstream fs(tuning_file, std::ios::app | std::ios::binary);
@@ -557,6 +612,44 @@ class CLMLRuntime : public JSONRuntimeBase {
       LOG(WARNING) << "CLML: Tuning cache dumped to:" << tuning_file << " size" << tune_str.length()
                    << " with tuning blob len " << saved_cache.size();
     }
+
+    RecordDispatch();
+  }
+
+  /*!
+   * \brief Record the dispatch of all the ops of the sub-graph on a recordable queue, so that Run
+   * replays it with a single enqueue. The ops always bind the same tensors through the descriptor
+   * set, since the inputs and outputs are copied in and out of them.
+   */
+  void RecordDispatch() {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    if (getenv("CLML_DISABLE_RECORDABLE_QUEUE") ||
+        !ExtensionStringPresent("cl_qcom_recordable_queues")) {
+      return;
+    }
+    cl_int result = 0;
+    this->recordable_queue = clCreateCommandQueue(workspace->contexts[platform_id], device_id,
+                                                  CL_QUEUE_RECORDABLE_QCOM, &result);
+    ICHECK(result == CL_SUCCESS) << "clCreateCommandQueue:" << result;
+    this->recording = clNewRecordingQCOM(this->recordable_queue, &result);
+    ICHECK(result == CL_SUCCESS) << "clNewRecordingQCOM:" << result;
+    for (size_t i = 0; i < this->layer_.function.size(); ++i) {
+      result = h_ClmlIntf->clEnqueueMLOpQCOM(this->recordable_queue, this->layer_.function[i],
+                                             this->layer_.descriptorSet, 0, nullptr, nullptr);
+      ICHECK(result == CL_SUCCESS) << "clEnqueueMLOpQCOM:" << result;
+    }
+    result = clEndRecordingQCOM(this->recording);
+    ICHECK(result == CL_SUCCESS) << "clEndRecordingQCOM:" << result;
+#endif
+  }
+
+  /*! \brief Whether Run replays the recorded dispatch instead of enqueuing every op. */
+  bool IsDispatchRecorded() const {
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+    return this->recording != nullptr && !getenv("CLML_PROFILING");
+#else
+    return false;
+#endif
   }
 
   /*!
@@ -585,7 +678,7 @@ class CLMLRuntime : public JSONRuntimeBase {
     uint32_t n, c, h, w;
   };
 
-  bool ExtensionStringPresent(void) {
+  bool ExtensionStringPresent(const std::string& extension = "cl_qcom_ml_ops") {
     cl_int result = 0;
     size_t reqd_size = 0;
     cl_device_id device_id =
@@ -599,7 +692,7 @@ class CLMLRuntime : public JSONRuntimeBase {
 
     std::string extensions(buf.data());
     LOG(WARNING) << "OpenCL Extensions:" << extensions;
-    return (extensions.find("cl_qcom_ml_ops") != std::string::npos);
+    return (extensions.find(extension) != std::string::npos);
   }
 
   cl_ml_tensor_qcom DeviceMakeCLMLTensor(
@@ -1444,6 +1537,14 @@ class CLMLRuntime : public JSONRuntimeBase {
   cl_ml_tuningcache_qcom tuning_cache = nullptr;
   bool is_tuning_run;
   char* tuning_file;
+  /*! \brief The key of the tuning cache entry of this sub-graph */
+  std::string tuning_key;
+#ifdef CL_QUEUE_RECORDABLE_QCOM
+  /*! \brief The queue the dispatch of the sub-graph is recorded on */
+  cl_command_queue recordable_queue = nullptr;
+  /*! \brief The recorded dispatch of the sub-graph, replayed by Run */
+  cl_recording_qcom recording = nullptr;
+#endif
 #else
   void Run() override {
     LOG(FATAL) << "Cannot call run on CLML module without runtime enabled. "
@@ -21,9 +21,17 @@
  * \file Use external cblas library call.
  */
 #include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "../../cuda/cuda_common.h"
 #include "../cblas/gemm_common.h"
 #include "cublas_utils.h"
 
@@ -208,6 +216,201 @@ inline void CallLtIgemm(TVMArgs args, TVMRetValue* ret, cublasLtHandle_t hdl) {
 }
 #endif
 
+#if CUDART_VERSION >= 11000
+/*! \brief The workspace of cuBLASLt matmuls, which enables more algorithms. */
+constexpr size_t kCublasLtWorkspaceSize = 32 << 20;
+/*! \brief The number of heuristic algorithms timed for each new matmul shape. */
+constexpr int kCublasLtNumAlgoCandidates = 8;
+/*! \brief The number of runs of each candidate algorithm while timing it. */
+constexpr int kCublasLtNumTimingRepeats = 3;
+
+/*!
+ * \brief The device, shape, transposes, leading dimensions, data type and epilogue of a cuBLASLt
+ * matmul.
+ */
+using CublasLtAlgoKey = std::tuple<int, int, int, int, bool, bool, int, int, int, int, int>;
+
+/*!
+ * \brief The cache of the fastest cuBLASLt algorithm of each matmul, kept for the lifetime of the
+ * process.
+ */
+struct CublasLtAlgoCache {
+  std::mutex mutex;
+  std::map<CublasLtAlgoKey, cublasLtMatmulAlgo_t> algos;
+
+  static CublasLtAlgoCache* Global() {
+    static CublasLtAlgoCache* inst = new CublasLtAlgoCache();
+    return inst;
+  }
+};
+
+inline cublasLtEpilogue_t GetCublasLtEpilogue(const std::string& epilogue) {
+  if (epilogue == "bias") return CUBLASLT_EPILOGUE_BIAS;
+  if (epilogue == "relu") return CUBLASLT_EPILOGUE_RELU_BIAS;
+#if CUDART_VERSION >= 11030
+  if (epilogue == "gelu") return CUBLASLT_EPILOGUE_GELU_BIAS;
+#endif
+  LOG(FATAL) << "ValueError: unsupported cuBLASLt epilogue " << epilogue;
+  return CUBLASLT_EPILOGUE_DEFAULT;
+}
+
+/*!
+ * \brief Select the fastest of the heuristic algorithms of a matmul by timing them on the stream,
+ * the first time the matmul is called.
+ */
+inline cublasLtMatmulAlgo_t GetOrSelectCublasLtAlgo(
+    const CublasLtAlgoKey& key, cublasLtHandle_t hdl, cublasLtMatmulDesc_t op_desc,
+    cublasLtMatrixLayout_t a_desc, const void* a, cublasLtMatrixLayout_t b_desc, const void* b,
+    cublasLtMatrixLayout_t c_desc, void* c, const void* alpha, const void* beta, void* workspace,
+    cudaStream_t stream) {
+  CublasLtAlgoCache* cache = CublasLtAlgoCache::Global();
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto it = cache->algos.find(key);
+    if (it != cache->algos.end()) return it->second;
+  }
+
+  cublasLtMatmulPreference_t preference = nullptr;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceCreate(&preference));
+  size_t workspace_size = kCublasLtWorkspaceSize;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceSetAttribute(
+      preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &workspace_size,
+      sizeof(workspace_size)));
+  cublasLtMatmulHeuristicResult_t results[kCublasLtNumAlgoCandidates];
+  int num_results = 0;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(hdl, op_desc, a_desc, b_desc, c_desc, c_desc,
+                                                    preference, kCublasLtNumAlgoCandidates,
+                                                    results, &num_results));
+  CHECK_CUBLAS_ERROR(cublasLtMatmulPreferenceDestroy(preference));
+  ICHECK_GT(num_results, 0) << "cuBLASLt found no algorithm for the matmul";
+
+  int best = 0;
+  if (num_results > 1) {
+    cudaEvent_t start, stop;
+    CUDA_CALL(cudaEventCreate(&start));
+    CUDA_CALL(cudaEventCreate(&stop));
+    float best_time = std::numeric_limits<float>::max();
+    for (int i = 0; i < num_results; ++i) {
+      if (results[i].state != CUBLAS_STATUS_SUCCESS) continue;
+      CUDA_CALL(cudaEventRecord(start, stream));
+      bool failed = false;
+      for (int r = 0; r < kCublasLtNumTimingRepeats && !failed; ++r) {
+        failed = cublasLtMatmul(hdl, op_desc, alpha, a, a_desc, b, b_desc, beta, c, c_desc, c,
+                                c_desc, &results[i].algo, workspace, kCublasLtWorkspaceSize,
+                                stream) != CUBLAS_STATUS_SUCCESS;
+      }
+      CUDA_CALL(cudaEventRecord(stop, stream));
+      CUDA_CALL(cudaEventSynchronize(stop));
+      float time = 0;
+      CUDA_CALL(cudaEventElapsedTime(&time, start, stop));
+      if (!failed && time < best_time) {
+        best_time = time;
+        best = i;
+      }
+    }
+    CUDA_CALL(cudaEventDestroy(start));
+    CUDA_CALL(cudaEventDestroy(stop));
+  }
+
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  return cache->algos.emplace(key, results[best].algo).first->second;
+}
+
+/*!
+ * \brief Row major C = epilogue(op(A) * op(B) + bias), with the bias and the activation fused
+ * into the cuBLASLt matmul.
+ */
+inline void CallLtMatmulBias(TVMArgs args, TVMRetValue* ret, cublasLtHandle_t hdl) {
+  DLTensor* A = args[0];
+  DLTensor* B = args[1];
+  DLTensor* bias = args[2];
+  DLTensor* C = args[3];
+  bool transa = args[4];
+  bool transb = args[5];
+  std::string epilogue = args[6];
+  ICHECK_EQ(A->ndim, 2);
+  ICHECK_EQ(B->ndim, 2);
+  ICHECK_EQ(C->ndim, 2);
+  ICHECK_EQ(bias->ndim, 1);
+
+  ICHECK_EQ(ElementStride(A), 1);
+  ICHECK_EQ(ElementStride(B), 1);
+  ICHECK_EQ(ElementStride(C), 1);
+  ICHECK(!IsInPlaceTransposed(A) && !IsInPlaceTransposed(B) && !IsInPlaceTransposed(C));
+
+  ICHECK(TypeEqual(A->dtype, B->dtype));
+  ICHECK(TypeEqual(A->dtype, C->dtype) && TypeEqual(bias->dtype, C->dtype))
+      << "ValueError: the cuBLASLt epilogue needs the same inputs, bias and output data types";
+  ICHECK(TypeMatch(C->dtype, kDLFloat, 16) || TypeMatch(C->dtype, kDLFloat, 32))
+      << "ValueError: the cuBLASLt epilogue only supports float16 and float32";
+
+  // cuBLASLt is column major: the row major C is the column major m x n matrix
+  // op(B) * op(A), and the bias is added to its rows.
+  int m = ColumnCount(B, transb);
+  int n = RowCount(A, transa);
+  int k = ColumnCount(A, transa);
+  ICHECK_EQ(bias->shape[0], m);
+  ICHECK_EQ(ColumnCount(C, false), m);
+  ICHECK_EQ(RowCount(C, false), n);
+
+  cudaDataType_t cuda_type = GetCudaDataType(C->dtype);
+  cublasLtMatmulDesc_t op_desc = nullptr;
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescCreate(&op_desc, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  cublasOperation_t op_transb = CUBLASBooleanToTranspose(transb);
+  cublasOperation_t op_transa = CUBLASBooleanToTranspose(transa);
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                    &op_transb, sizeof(op_transb)));
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                    &op_transa, sizeof(op_transa)));
+  cublasLtEpilogue_t lt_epilogue = GetCublasLtEpilogue(epilogue);
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                    &lt_epilogue, sizeof(lt_epilogue)));
+  auto bias_data = reinterpret_cast<void*>(static_cast<char*>(bias->data) + bias->byte_offset);
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescSetAttribute(op_desc, CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                    &bias_data, sizeof(bias_data)));
+
+  cublasLtMatrixLayout_t b_desc = nullptr, a_desc = nullptr, c_desc = nullptr;
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&b_desc, cuda_type, transb ? k : m, transb ? m : k,
+                                                ColumnStride(B)));
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&a_desc, cuda_type, transa ? n : k, transa ? k : n,
+                                                ColumnStride(A)));
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutCreate(&c_desc, cuda_type, m, n, ColumnStride(C)));
+
+  auto A_data = reinterpret_cast<void*>(static_cast<char*>(A->data) + A->byte_offset);
+  auto B_data = reinterpret_cast<void*>(static_cast<char*>(B->data) + B->byte_offset);
+  auto C_data = reinterpret_cast<void*>(static_cast<char*>(C->data) + C->byte_offset);
+  float alpha = 1.0f;
+  float beta = 0.0f;
+
+  auto stream = static_cast<cudaStream_t>(CUDAThreadEntry::ThreadLocal()->stream);
+  DeviceAPI* device_api = DeviceAPI::Get(C->device);
+  void* workspace = device_api->AllocWorkspace(C->device, kCublasLtWorkspaceSize);
+  CublasLtAlgoKey key{C->device.device_id,
+                      m,
+                      n,
+                      k,
+                      transa,
+                      transb,
+                      static_cast<int>(ColumnStride(A)),
+                      static_cast<int>(ColumnStride(B)),
+                      static_cast<int>(ColumnStride(C)),
+                      static_cast<int>(cuda_type),
+                      static_cast<int>(lt_epilogue)};
+  cublasLtMatmulAlgo_t algo =
+      GetOrSelectCublasLtAlgo(key, hdl, op_desc, b_desc, B_data, a_desc, A_data, c_desc, C_data,
+                              &alpha, &beta, workspace, stream);
+  CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, &alpha, B_data, b_desc, A_data, a_desc, &beta,
+                                    C_data, c_desc, C_data, c_desc, &algo, workspace,
+                                    kCublasLtWorkspaceSize, stream));
+  device_api->FreeWorkspace(C->device, workspace);
+
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutDestroy(a_desc));
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutDestroy(b_desc));
+  CHECK_CUBLAS_ERROR(cublasLtMatrixLayoutDestroy(c_desc));
+  CHECK_CUBLAS_ERROR(cublasLtMatmulDescDestroy(op_desc));
+}
+#endif  // CUDART_VERSION >= 11000
+
 inline void CallGemmEx(TVMArgs args, TVMRetValue* ret, cublasHandle_t hdl) {
   DLTensor* A = args[0];
   DLTensor* B = args[1];
@@ -376,13 +579,18 @@ TVM_REGISTER_GLOBAL("tvm.contrib.cublaslt.matmul").set_body([](TVMArgs args, TVM
   CUBLASTryEnableTensorCore(entry_ptr->handle);
 
   ICHECK(TypeMatch(A->dtype, kDLInt, 8)) << "Expects dtype to be int8\n";
-  cublasLtHandle_t ltHandle;
-  CHECK_CUBLAS_ERROR(cublasLtCreate(&ltHandle));
-  CallLtIgemm(args, ret, ltHandle);
-  CHECK_CUBLAS_ERROR(cublasLtDestroy(ltHandle));
+  CallLtIgemm(args, ret, CuBlasLtThreadEntry::ThreadLocal()->handle);
 });
 #endif  // CUDART_VERSION >= 10010
 
+#if CUDART_VERSION >= 11000
+// matrix multiplication for row major, with the bias and activation epilogue fused
+TVM_REGISTER_GLOBAL("tvm.contrib.cublaslt.matmul_bias")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      CallLtMatmulBias(args, ret, CuBlasLtThreadEntry::ThreadLocal()->handle);
+    });
+#endif  // CUDART_VERSION >= 11000
+
 TVM_REGISTER_GLOBAL("tvm.contrib.cublas.batch_matmul").set_body([](TVMArgs args, TVMRetValue* ret) {
   DLTensor* A = args[0];
   DLTensor* C = args[2];
@@ -64,6 +64,14 @@ void BackwardDataFindAlgo(int format, int dims, int groups, const int pad[], con
                           const int dilation[], const int dy_dim[], const int w_dim[],
                           const int dx_dim[], const std::string& data_dtype,
                           const std::string& conv_dtype, TVMRetValue* ret) {
+  const std::string cache_key = CuDNNAlgoCache::GetKey("bwd_data", format, dims, groups, pad, stride,
+                                                        dilation, dx_dim, w_dim, dy_dim, data_dtype,
+                                                        conv_dtype);
+  int cached_algo;
+  if (CuDNNAlgoCache::Global()->Lookup(cache_key, &cached_algo)) {
+    ret[0] = cached_algo;
+    return;
+  }
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
   std::vector<int64_t> dy_dim_int64(full_dims);
@@ -103,6 +111,7 @@ void BackwardDataFindAlgo(int format, int dims, int groups, const int pad[], con
               << ", Memory: " << perf_results[i].memory;
   }
 
+  CuDNNAlgoCache::Global()->Insert(cache_key, best_algo);
   ret[0] = best_algo;
 }
 
@@ -140,6 +149,14 @@ void BackwardFilterFindAlgo(int format, int dims, int groups, const int pad[], c
                             const int dilation[], const int dy_dim[], const int x_dim[],
                             const int dw_dim[], const std::string& data_dtype,
                             const std::string& conv_dtype, TVMRetValue* ret) {
+  const std::string cache_key = CuDNNAlgoCache::GetKey("bwd_filter", format, dims, groups, pad, stride,
+                                                        dilation, x_dim, dw_dim, dy_dim, data_dtype,
+                                                        conv_dtype);
+  int cached_algo;
+  if (CuDNNAlgoCache::Global()->Lookup(cache_key, &cached_algo)) {
+    ret[0] = cached_algo;
+    return;
+  }
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
   std::vector<int64_t> x_dim_int64(full_dims);
@@ -180,6 +197,7 @@ void BackwardFilterFindAlgo(int format, int dims, int groups, const int pad[], c
               << ", Memory: " << perf_results[i].memory;
   }
 
+  CuDNNAlgoCache::Global()->Insert(cache_key, best_algo);
   ret[0] = best_algo;
 }
 
@@ -101,6 +101,14 @@ void ConvolutionBiasActivationForward(int mode, int format, int algo, int dims,
 void FindAlgo(int format, int dims, int groups, const int pad[], const int stride[],
               const int dilation[], const int x_dim[], const int w_dim[], const int y_dim[],
               const std::string& data_dtype, const std::string& conv_dtype, TVMRetValue* ret) {
+  const std::string cache_key = CuDNNAlgoCache::GetKey("fwd", format, dims, groups, pad, stride,
+                                                        dilation, x_dim, w_dim, y_dim, data_dtype,
+                                                        conv_dtype);
+  int cached_algo;
+  if (CuDNNAlgoCache::Global()->Lookup(cache_key, &cached_algo)) {
+    ret[0] = cached_algo;
+    return;
+  }
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
   const int full_dims = dims + 2;
   std::vector<int64_t> x_dim_int64(full_dims);
@@ -140,6 +148,7 @@ void FindAlgo(int format, int dims, int groups, const int pad[], const int strid
               << ", Memory: " << perf_results[i].memory;
   }
 
+  CuDNNAlgoCache::Global()->Insert(cache_key, best_algo);
   ret[0] = best_algo;
 }
 
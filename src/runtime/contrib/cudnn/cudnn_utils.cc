@@ -27,6 +27,9 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -261,6 +264,73 @@ void SetConvDescriptors(CuDNNThreadEntry* entry_ptr, int format, int dims, int g
 
 // SoftmaxEntry
 
+// CuDNNAlgoCache
+
+CuDNNAlgoCache::CuDNNAlgoCache() {
+  const char* path = std::getenv("TVM_CUDNN_ALGO_CACHE");
+  if (path == nullptr || path[0] == '\0') return;
+  path_ = path;
+  std::ifstream is(path_);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream ss(line);
+    std::string key;
+    int algo;
+    if (ss >> key >> algo) algos_[key] = algo;
+  }
+  DLOG(INFO) << "Loaded " << algos_.size() << " cuDNN algorithms from " << path_;
+}
+
+CuDNNAlgoCache* CuDNNAlgoCache::Global() {
+  static CuDNNAlgoCache* inst = new CuDNNAlgoCache();
+  return inst;
+}
+
+std::string CuDNNAlgoCache::GetKey(const std::string& kind, int format, int dims, int groups,
+                                   const int pad[], const int stride[], const int dilation[],
+                                   const int x_dim[], const int w_dim[], const int y_dim[],
+                                   const std::string& data_dtype, const std::string& conv_dtype) {
+  auto append = [](std::ostringstream* os, const char* name, const int* values, int size) {
+    *os << '|' << name << '=';
+    for (int i = 0; i < size; ++i) *os << (i ? "," : "") << values[i];
+  };
+  int device_id, major, minor;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device_id));
+  CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device_id));
+
+  std::ostringstream os;
+  os << kind << "|sm_" << major << minor << "|cudnn=" << cudnnGetVersion() << "|format=" << format
+     << "|groups=" << groups;
+  append(&os, "pad", pad, dims);
+  append(&os, "stride", stride, dims);
+  append(&os, "dilation", dilation, dims);
+  append(&os, "x", x_dim, dims + 2);
+  append(&os, "w", w_dim, dims + 2);
+  append(&os, "y", y_dim, dims + 2);
+  os << "|data=" << data_dtype << "|conv=" << conv_dtype;
+  return os.str();
+}
+
+bool CuDNNAlgoCache::Lookup(const std::string& key, int* algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = algos_.find(key);
+  if (it == algos_.end()) return false;
+  *algo = it->second;
+  return true;
+}
+
+void CuDNNAlgoCache::Insert(const std::string& key, int algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  algos_[key] = algo;
+  if (path_.empty()) return;
+  // Each entry is appended as a single line, which the processes sharing the file can write
+  // concurrently.
+  std::ofstream os(path_, std::ios::app);
+  os << key << ' ' << algo << '\n';
+  if (!os) LOG(WARNING) << "Cannot write the cuDNN algorithm cache " << path_;
+}
+
 SoftmaxEntry::SoftmaxEntry() { CUDNN_CALL(cudnnCreateTensorDescriptor(&shape_desc)); }
 
 SoftmaxEntry::~SoftmaxEntry() { CUDNN_CALL(cudnnDestroyTensorDescriptor(shape_desc)); }
@@ -28,7 +28,9 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "../../cuda/cuda_common.h"
 
@@ -114,6 +116,41 @@ void SetConvDescriptors(CuDNNThreadEntry* entry_ptr, int format, int dims, int g
                         int64_t w_dim[], int64_t y_dim[], DLDataType data_dtype,
                         const std::string& conv_dtype);
 
+/*!
+ * \brief The cache of the convolution algorithms found by cuDNN, shared by the forward and
+ * backward convolutions.
+ *
+ * When the environment variable TVM_CUDNN_ALGO_CACHE names a file, the cache is loaded from it,
+ * and each algorithm found by this process is appended to it, so that later processes skip the
+ * search.
+ */
+class CuDNNAlgoCache {
+ public:
+  /*!
+   * \brief Get the key of a convolution algorithm search. It includes the GPU arch of the current
+   * device and the cuDNN version, which the best algorithm depends on.
+   * \param kind The searched algorithm, i.e. "fwd", "bwd_data" or "bwd_filter".
+   */
+  static std::string GetKey(const std::string& kind, int format, int dims, int groups,
+                            const int pad[], const int stride[], const int dilation[],
+                            const int x_dim[], const int w_dim[], const int y_dim[],
+                            const std::string& data_dtype, const std::string& conv_dtype);
+  /*! \brief Find the cached algorithm of the key, returns whether it is found. */
+  bool Lookup(const std::string& key, int* algo);
+  /*! \brief Cache the algorithm of the key, and append it to the cache file if any. */
+  void Insert(const std::string& key, int algo);
+
+  static CuDNNAlgoCache* Global();
+
+ private:
+  CuDNNAlgoCache();
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, int> algos_;
+  /*! \brief The path of the cache file, empty if the cache is in memory only. */
+  std::string path_;
+};
+
 }  // namespace contrib
 }  // namespace tvm
 
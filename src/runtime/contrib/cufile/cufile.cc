@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cufile.cc
+ * \brief Read parameter files directly into CUDA memory with cuFile (GPUDirect Storage).
+ */
+#include <cufile.h>
+#include <fcntl.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace contrib {
+
+/*!
+ * \brief Read the contents of arr from path at offset, without a host copy.
+ * \return Whether the read succeeded, false lets the caller fall back to a staged copy.
+ */
+bool CuFileRead(const std::string& path, int64_t offset, NDArray arr) {
+  static const bool driver_opened = cuFileDriverOpen().err == CU_FILE_SUCCESS;
+  if (!driver_opened) return false;
+  int fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+  if (fd < 0) return false;
+  CUfileDescr_t descr;
+  memset(&descr, 0, sizeof(descr));
+  descr.handle.fd = fd;
+  descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+  CUfileHandle_t handle;
+  if (cuFileHandleRegister(&handle, &descr).err != CU_FILE_SUCCESS) {
+    close(fd);
+    return false;
+  }
+  CUDA_CALL(cudaSetDevice(arr->device.device_id));
+  size_t nbytes = GetDataSize(*arr.operator->());
+  size_t done = 0;
+  while (done < nbytes) {
+    ssize_t n = cuFileRead(handle, arr->data, nbytes - done, static_cast<off_t>(offset + done),
+                           static_cast<off_t>(arr->byte_offset + done));
+    if (n <= 0) break;
+    done += static_cast<size_t>(n);
+  }
+  cuFileHandleDeregister(handle);
+  close(fd);
+  return done == nbytes;
+}
+
+TVM_REGISTER_GLOBAL("runtime.params.direct_read.cuda").set_body_typed(CuFileRead);
+
+}  // namespace contrib
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,338 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <cupti.h>
+#include <tvm/runtime/contrib/cupti.h>
+#include <tvm/runtime/registry.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+#define CUPTI_CALL(func)                                                     \
+  {                                                                          \
+    CUptiResult e = (func);                                                  \
+    if (e != CUPTI_SUCCESS) {                                                \
+      const char* msg;                                                       \
+      cuptiGetResultString(e, &msg);                                         \
+      LOG(FATAL) << "CUPTIError: in function " #func " " << e << " " << msg; \
+    }                                                                        \
+  }
+
+static const std::vector<std::string> default_metric_names = {
+    "dram_read_throughput", "dram_write_throughput", "achieved_occupancy"};
+
+/*! \brief The metrics collected on one CUDA device, and the event totals of its kernels. */
+struct CUPTIDeviceMetrics {
+  CUdevice device;
+  std::vector<std::string> metric_names;
+  std::vector<CUpti_MetricID> metric_ids;
+  CUpti_EventGroupSets* group_sets{nullptr};
+  /*! \brief The events the metrics are computed from, in the order of `event_totals`. */
+  std::vector<CUpti_EventID> event_ids;
+  /*! \brief The sum of each event over all the kernels run so far, normalized to the device. */
+  std::vector<uint64_t> event_totals;
+  /*! \brief The total run time of the kernels so far, in nanoseconds. */
+  uint64_t kernel_ns{0};
+  std::chrono::high_resolution_clock::time_point launch_start;
+};
+
+/*! \brief Object that holds the event totals of a device at the start of a function call. */
+struct CUPTIEventSetNode : public Object {
+  std::vector<uint64_t> start_totals;
+  uint64_t start_kernel_ns;
+  Device dev;
+
+  CUPTIEventSetNode(std::vector<uint64_t> start_totals, uint64_t start_kernel_ns, Device dev)
+      : start_totals(start_totals), start_kernel_ns(start_kernel_ns), dev(dev) {}
+
+  static constexpr const char* _type_key = "CUPTIEventSetNode";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIEventSetNode, Object);
+};
+
+/*! \brief MetricCollectorNode for CUPTI metrics.
+ *
+ * The events of the requested metrics are counted for every kernel launch by
+ * subscribing to the launches of the CUDA driver, so that the metrics of a call
+ * cover all the kernels it launched. Only the metrics which can be collected in
+ * a single pass are supported, as a call cannot be replayed. The metrics are
+ * computed by CUPTI from the event totals and the kernel run time of the call.
+ */
+struct CUPTIMetricCollectorNode final : public MetricCollectorNode {
+  explicit CUPTIMetricCollectorNode(Map<DeviceWrapper, Array<String>> metrics) {
+    for (auto& p : metrics) {
+      ICHECK_EQ(p.first->device.device_type, kDLCUDA) << "CUPTI only supports CUDA devices";
+      auto& names = metric_names[p.first->device.device_id];
+      for (auto& metric : p.second) {
+        names.push_back(metric);
+      }
+    }
+  }
+
+  void Init(Array<DeviceWrapper> devices) final {
+    for (auto wrapped_device : devices) {
+      Device dev = wrapped_device->device;
+      if (dev.device_type != kDLCUDA || devices_.count(dev.device_id)) continue;
+      std::vector<std::string> names = default_metric_names;
+      if (!metric_names.empty()) {
+        auto it = metric_names.find(dev.device_id);
+        if (it == metric_names.end()) continue;
+        names = it->second;
+      }
+      CUPTIDeviceMetrics metrics;
+      CUDA_CALL(cudaSetDevice(dev.device_id));
+      CUDA_CALL(cudaFree(nullptr));
+      CUcontext context;
+      CUDA_DRIVER_CALL(cuCtxGetCurrent(&context));
+      CUDA_DRIVER_CALL(cuDeviceGet(&metrics.device, dev.device_id));
+      for (const std::string& name : names) {
+        CUpti_MetricID id;
+        CUptiResult e = cuptiMetricGetIdFromName(metrics.device, name.c_str(), &id);
+        if (e != CUPTI_SUCCESS) {
+          const char* msg;
+          cuptiGetResultString(e, &msg);
+          LOG(WARNING) << "CUPTI can not collect " << name << " on cuda(" << dev.device_id
+                       << "): " << msg;
+          continue;
+        }
+        // Keeping the metric only if all the metrics still fit in a single pass.
+        metrics.metric_ids.push_back(id);
+        CUpti_EventGroupSets* sets = nullptr;
+        CUPTI_CALL(cuptiMetricCreateEventGroupSets(
+            context, sizeof(CUpti_MetricID) * metrics.metric_ids.size(), metrics.metric_ids.data(),
+            &sets));
+        if (sets->numSets > 1) {
+          LOG(WARNING) << "CUPTI needs several passes to collect " << name << ", skipping it";
+          CUPTI_CALL(cuptiEventGroupSetsDestroy(sets));
+          metrics.metric_ids.pop_back();
+          continue;
+        }
+        if (metrics.group_sets != nullptr) {
+          CUPTI_CALL(cuptiEventGroupSetsDestroy(metrics.group_sets));
+        }
+        metrics.group_sets = sets;
+        metrics.metric_names.push_back(name);
+      }
+      if (metrics.metric_ids.empty()) continue;
+
+      CUpti_EventGroupSet& set = metrics.group_sets->sets[0];
+      for (uint32_t i = 0; i < set.numEventGroups; ++i) {
+        uint32_t num_events;
+        size_t size = sizeof(num_events);
+        CUPTI_CALL(cuptiEventGroupGetAttribute(set.eventGroups[i],
+                                               CUPTI_EVENT_GROUP_ATTR_NUM_EVENTS, &size,
+                                               &num_events));
+        std::vector<CUpti_EventID> ids(num_events);
+        size = sizeof(CUpti_EventID) * num_events;
+        CUPTI_CALL(cuptiEventGroupGetAttribute(set.eventGroups[i], CUPTI_EVENT_GROUP_ATTR_EVENTS,
+                                               &size, ids.data()));
+        metrics.event_ids.insert(metrics.event_ids.end(), ids.begin(), ids.end());
+      }
+      metrics.event_totals.assign(metrics.event_ids.size(), 0);
+      CUPTI_CALL(cuptiSetEventCollectionMode(context, CUPTI_EVENT_COLLECTION_MODE_KERNEL));
+      devices_[dev.device_id] = std::move(metrics);
+    }
+    if (!devices_.empty()) {
+      CUPTI_CALL(cuptiSubscribe(&subscriber_, &CUPTIMetricCollectorNode::OnLaunch, this));
+      CUPTI_CALL(cuptiEnableCallback(1, subscriber_, CUPTI_CB_DOMAIN_DRIVER_API,
+                                     CUPTI_DRIVER_TRACE_CBID_cuLaunchKernel));
+    }
+  }
+
+  ObjectRef Start(Device dev) final {
+    if (dev.device_type != kDLCUDA) return ObjectRef(nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(dev.device_id);
+    if (it == devices_.end()) return ObjectRef(nullptr);
+    return ObjectRef(
+        make_object<CUPTIEventSetNode>(it->second.event_totals, it->second.kernel_ns, dev));
+  }
+
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const CUPTIEventSetNode* start = obj.as<CUPTIEventSetNode>();
+    // The launch callbacks wait for the kernels, the totals are up to date.
+    std::lock_guard<std::mutex> lock(mutex_);
+    CUPTIDeviceMetrics& metrics = devices_.at(start->dev.device_id);
+    std::vector<uint64_t> values(metrics.event_totals.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = metrics.event_totals[i] - start->start_totals[i];
+    }
+    uint64_t duration = metrics.kernel_ns - start->start_kernel_ns;
+    std::unordered_map<String, ObjectRef> reported_metrics;
+    if (duration == 0) return reported_metrics;
+    double dram_bandwidth = 0;
+    for (size_t i = 0; i < metrics.metric_ids.size(); ++i) {
+      CUpti_MetricValue value;
+      CUptiResult e = cuptiMetricGetValue(
+          metrics.device, metrics.metric_ids[i], sizeof(CUpti_EventID) * metrics.event_ids.size(),
+          metrics.event_ids.data(), sizeof(uint64_t) * values.size(), values.data(), duration,
+          &value);
+      if (e != CUPTI_SUCCESS) continue;
+      CUpti_MetricValueKind kind;
+      size_t size = sizeof(kind);
+      CUPTI_CALL(cuptiMetricGetAttribute(metrics.metric_ids[i], CUPTI_METRIC_ATTR_VALUE_KIND,
+                                         &size, &kind));
+      const std::string& name = metrics.metric_names[i];
+      switch (kind) {
+        case CUPTI_METRIC_VALUE_KIND_DOUBLE:
+          reported_metrics[name] = ObjectRef(make_object<RatioNode>(value.metricValueDouble));
+          break;
+        case CUPTI_METRIC_VALUE_KIND_UINT64:
+          reported_metrics[name] = ObjectRef(
+              make_object<CountNode>(static_cast<int64_t>(value.metricValueUint64)));
+          break;
+        case CUPTI_METRIC_VALUE_KIND_INT64:
+          reported_metrics[name] = ObjectRef(make_object<CountNode>(value.metricValueInt64));
+          break;
+        case CUPTI_METRIC_VALUE_KIND_PERCENT:
+          reported_metrics[name] = ObjectRef(make_object<PercentNode>(value.metricValuePercent));
+          break;
+        case CUPTI_METRIC_VALUE_KIND_THROUGHPUT: {
+          double gbps = static_cast<double>(value.metricValueThroughput) / 1e9;
+          reported_metrics[name + " (GB/s)"] = ObjectRef(make_object<RatioNode>(gbps));
+          if (name.rfind("dram_", 0) == 0) dram_bandwidth += gbps;
+          break;
+        }
+        default:
+          break;
+      }
+    }
+    if (dram_bandwidth > 0) {
+      reported_metrics["DRAM Bandwidth (GB/s)"] = ObjectRef(make_object<RatioNode>(dram_bandwidth));
+    }
+    return reported_metrics;
+  }
+
+  ~CUPTIMetricCollectorNode() final {
+    if (subscriber_ != nullptr) {
+      cuptiUnsubscribe(subscriber_);
+    }
+    for (auto& p : devices_) {
+      cuptiEventGroupSetsDestroy(p.second.group_sets);
+    }
+  }
+
+  /*! \brief Metric names requested for each CUDA device id, the defaults are used if empty. */
+  std::unordered_map<int, std::vector<std::string>> metric_names;
+
+  static constexpr const char* _type_key = "runtime.profiling.CUPTIMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  static void CUPTIAPI OnLaunch(void* userdata, CUpti_CallbackDomain domain,
+                                CUpti_CallbackId cbid, const void* cbdata) {
+    auto* self = static_cast<CUPTIMetricCollectorNode*>(userdata);
+    auto* info = static_cast<const CUpti_CallbackData*>(cbdata);
+    CUdevice device;
+    if (cuCtxGetDevice(&device) != CUDA_SUCCESS) return;
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    auto it = self->devices_.find(static_cast<int>(device));
+    if (it == self->devices_.end()) return;
+    CUPTIDeviceMetrics& metrics = it->second;
+    CUpti_EventGroupSet& set = metrics.group_sets->sets[0];
+    // Kernels are serialized, so that the counters and the run time are the launched kernel's.
+    cuCtxSynchronize();
+    if (info->callbackSite == CUPTI_API_ENTER) {
+      // Enabling the groups zeros their counters.
+      cuptiEventGroupSetEnable(&set);
+      metrics.launch_start = std::chrono::high_resolution_clock::now();
+      return;
+    }
+    metrics.kernel_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::high_resolution_clock::now() - metrics.launch_start)
+                             .count();
+    size_t offset = 0;
+    for (uint32_t i = 0; i < set.numEventGroups; ++i) {
+      CUpti_EventGroup group = set.eventGroups[i];
+      CUpti_EventDomainID domain_id;
+      uint32_t num_events, num_instances, num_total_instances;
+      size_t size = sizeof(domain_id);
+      cuptiEventGroupGetAttribute(group, CUPTI_EVENT_GROUP_ATTR_EVENT_DOMAIN_ID, &size, &domain_id);
+      size = sizeof(num_events);
+      cuptiEventGroupGetAttribute(group, CUPTI_EVENT_GROUP_ATTR_NUM_EVENTS, &size, &num_events);
+      size = sizeof(num_instances);
+      cuptiEventGroupGetAttribute(group, CUPTI_EVENT_GROUP_ATTR_INSTANCE_COUNT, &size,
+                                  &num_instances);
+      size = sizeof(num_total_instances);
+      cuptiDeviceGetEventDomainAttribute(metrics.device, domain_id,
+                                         CUPTI_EVENT_DOMAIN_ATTR_TOTAL_INSTANCE_COUNT, &size,
+                                         &num_total_instances);
+      std::vector<uint64_t> values(num_events * num_instances);
+      std::vector<CUpti_EventID> ids(num_events);
+      size_t values_size = sizeof(uint64_t) * values.size();
+      size_t ids_size = sizeof(CUpti_EventID) * ids.size();
+      size_t num_read;
+      if (cuptiEventGroupReadAllEvents(group, CUPTI_EVENT_READ_FLAG_NONE, &values_size,
+                                       values.data(), &ids_size, ids.data(),
+                                       &num_read) == CUPTI_SUCCESS) {
+        // The values are laid out instance major, each event is summed over the instances
+        // and scaled up to all the instances of its domain.
+        for (uint32_t j = 0; j < num_events; ++j) {
+          uint64_t sum = 0;
+          for (uint32_t k = 0; k < num_instances; ++k) {
+            sum += values[k * num_events + j];
+          }
+          metrics.event_totals[offset + j] += sum * num_total_instances / num_instances;
+        }
+      }
+      offset += num_events;
+    }
+    cuptiEventGroupSetDisable(&set);
+  }
+
+  CUpti_SubscriberHandle subscriber_{nullptr};
+  std::unordered_map<int, CUPTIDeviceMetrics> devices_;
+  std::mutex mutex_;
+};
+
+/*! \brief Wrapper for `CUPTIMetricCollectorNode`. */
+class CUPTIMetricCollector : public MetricCollector {
+ public:
+  explicit CUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+    data_ = make_object<CUPTIMetricCollectorNode>(metrics);
+  }
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CUPTIMetricCollector, MetricCollector,
+                                        CUPTIMetricCollectorNode);
+};
+
+MetricCollector CreateCUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+  return CUPTIMetricCollector(metrics);
+}
+
+TVM_REGISTER_OBJECT_TYPE(CUPTIEventSetNode);
+TVM_REGISTER_OBJECT_TYPE(CUPTIMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.CUPTIMetricCollector")
+    .set_body_typed([](Map<DeviceWrapper, Array<String>> metrics) {
+      return CUPTIMetricCollector(metrics);
+    });
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
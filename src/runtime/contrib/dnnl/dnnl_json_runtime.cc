@@ -26,8 +26,11 @@
 #include <tvm/runtime/registry.h>
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../json/json_node.h"
@@ -55,6 +58,16 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
         next_unique_eid_offset_(data_entry_.size()),
         run_arg_eid_(input_var_eid_) {
     for (const auto e : outputs_) run_arg_eid_.push_back(EntryID(e));
+    for (const auto nid : input_nodes_) {
+      if (nodes_[nid].GetOpType() != "input") continue;
+      for (const auto& shape : nodes_[nid].GetOpShape()) graph_input_shapes_.push_back(shape);
+    }
+    // The outermost dimension of the first input is the batch, -1 if it is dynamic.
+    for (const auto& shape : graph_input_shapes_) {
+      if (shape.empty()) continue;
+      graph_batch_ = shape[0];
+      break;
+    }
   }
 
   const char* type_key() const override { return "dnnl_json"; }
@@ -65,18 +78,24 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
     // Setup constants entries for weights.
     SetupConstants(consts);
-    BuildEngine();
+
+    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
+    stream_ = dnnl::stream(engine_);
+    packed_consts_ = std::make_shared<PackedConstCache>();
+    // The primitives of a dynamic batch are built at the first run of each batch size.
+    if (graph_batch_ != -1) GetOrBuildSubgraph(graph_batch_);
   }
 
   /* Unused stub implementation */
   void Run() override { LOG(FATAL) << "Unreachable code"; }
 
   /* Thread safe implementation of Run. Keep runtime instance immutable */
-  void Run(const TVMArgs& args) const {
+  void Run(const TVMArgs& args, const TensorRegistry::ActionQue& net,
+           const TensorRegistry& tensor_registry) const {
     auto arg_data_provider = makeIODataProvider(args);
-    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider);
+    auto mem_solver = tensor_registry.MakeSolver(arg_data_provider);
     // Execute primitives one by one
-    for (const auto& act : net_) {
+    for (const auto& act : net) {
       auto prim = std::get<0>(act);
       auto arg_reqs = std::get<1>(act);
 
@@ -107,7 +126,8 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
         ICHECK_EQ(args.size(), input_var_eid_.size() + outputs_.size())
             << "Found mismatch in the number of provided data entries and required.";
 
-        Run(args);
+        const auto& subgraph = GetOrBuildSubgraph(GetBatchSize(args));
+        Run(args, subgraph.net, subgraph.tensor_registry);
       });
     } else {
       return JSONRuntimeBase::GetFunction(name, sptr_to_self);
@@ -116,16 +136,9 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
   /* Same as makeInitDataProvider but in case of InputOutput return real DLTensor */
   TensorRegistry::DLTensorProvider makeIODataProvider(const TVMArgs& args) const {
-    auto extract_dl_tensor = [](const TVMArgValue& val) -> const DLTensor* {
-      ICHECK(val.type_code() == kTVMNDArrayHandle || val.type_code() == kTVMDLTensorHandle)
-          << "Expect NDArray or DLTensor";
-      return val.IsObjectRef<NDArray>() ? val.operator NDArray().operator->()
-                                        : val.operator DLTensor*();
-    };
-
     std::map<uint32_t, const DLTensor*> io_map;  // eid to dl tensor map
     for (size_t i = 0; i < run_arg_eid_.size(); i++) {
-      io_map[run_arg_eid_[i]] = extract_dl_tensor(args[i]);
+      io_map[run_arg_eid_[i]] = ExtractDLTensor(args[i]);
     }
 
     // lambda with captured IO data handlers
@@ -133,6 +146,62 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   }
 
  private:
+  /*! \brief The primitives built for one batch size and the registry of their tensors. */
+  struct Subgraph {
+    TensorRegistry::ActionQue net;
+    TensorRegistry tensor_registry;
+  };
+
+  static const DLTensor* ExtractDLTensor(const TVMArgValue& val) {
+    ICHECK(val.type_code() == kTVMNDArrayHandle || val.type_code() == kTVMDLTensorHandle)
+        << "Expect NDArray or DLTensor";
+    return val.IsObjectRef<NDArray>() ? val.operator NDArray().operator->()
+                                      : val.operator DLTensor*();
+  }
+
+  /*!
+   * \brief Get the batch size of the inputs. Only the outermost dimension of the inputs whose
+   * graph shape starts with the graph batch size may differ from the graph.
+   */
+  int64_t GetBatchSize(const TVMArgs& args) const {
+    int64_t batch = graph_batch_;
+    for (size_t i = 0; i < graph_input_shapes_.size(); ++i) {
+      const DLTensor* arg = ExtractDLTensor(args[i]);
+      const auto& shape = graph_input_shapes_[i];
+      ICHECK_EQ(static_cast<size_t>(arg->ndim), shape.size())
+          << "ValueError: input " << i << " of " << symbol_name_ << " must have " << shape.size()
+          << " dimensions, but gets " << arg->ndim;
+      for (int d = 0; d < arg->ndim; ++d) {
+        if (arg->shape[d] == shape[d]) continue;
+        ICHECK(d == 0 && shape[0] == graph_batch_ &&
+               (batch == graph_batch_ || batch == arg->shape[0]))
+            << "ValueError: DNNL only supports a dynamic batch size, but dimension " << d
+            << " of input " << i << " of " << symbol_name_ << " is " << arg->shape[d]
+            << " instead of " << shape[d];
+        batch = arg->shape[0];
+      }
+    }
+    return batch;
+  }
+
+  /*!
+   * \brief Get the primitives for the batch size, building them at the first run of the batch
+   * size. The constants reordered for the primitives are shared by all the batch sizes.
+   */
+  const Subgraph& GetOrBuildSubgraph(int64_t batch) {
+    std::lock_guard<std::mutex> lock(subgraphs_mutex_);
+    auto it = subgraphs_.find(batch);
+    if (it != subgraphs_.end()) return it->second;
+
+    DLOG(INFO) << "Building the DNNL primitives of " << symbol_name_ << " for batch size " << batch;
+    BuildEngine(batch);
+    auto& subgraph = subgraphs_[batch];
+    subgraph.net = std::move(net_);
+    subgraph.tensor_registry = std::move(tensor_registry_);
+    net_.clear();
+    return subgraph;
+  }
+
   const std::map<std::string, dnnl::algorithm> elt_name2algo{
       {"abs", dnnl::algorithm::eltwise_abs},
       {"exp", dnnl::algorithm::eltwise_exp},
@@ -245,13 +314,11 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     return attr;
   }
 
-  // Build up the engine based on the input graph.
-  void BuildEngine() {
-    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
-    stream_ = dnnl::stream(engine_);
-
+  // Build up the engine based on the input graph, for the batch size.
+  void BuildEngine(int64_t batch) {
+    batch_ = batch;
     std::set<uint32_t> io_eid_set(run_arg_eid_.begin(), run_arg_eid_.end());
-    tensor_registry_ = TensorRegistry(engine_, io_eid_set);
+    tensor_registry_ = TensorRegistry(engine_, io_eid_set, packed_consts_);
 
     std::regex conv_pat(".*conv[1-3]d.*");
     std::regex deconv_pat(".*deconv[1-3]d.*");
@@ -578,7 +645,24 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     auto bn_prim_desc = dnnl::batch_normalization_forward::primitive_desc(bn_desc, engine_);
 
     // Concatenate scale and shift tensors
-    auto scale_shift_tr = TensorRequisite::AsIs(bn_prim_desc.weights_desc(), GenUniqueEid());
+    auto scale_shift_tr = ScaleShift(bn_prim_desc.weights_desc(), gamma_tr, beta_tr);
+
+    Submit(dnnl::batch_normalization_forward(bn_prim_desc), {{DNNL_ARG_SRC, src_tr},
+                                                             {DNNL_ARG_DST, dst_tr},
+                                                             {DNNL_ARG_SCALE_SHIFT, scale_shift_tr},
+                                                             {DNNL_ARG_MEAN, mean_tr},
+                                                             {DNNL_ARG_VARIANCE, var_tr}});
+  }
+
+  /*!
+   * \brief Concatenate the scale and shift tensors into the weights of a normalization. Constant
+   * scale and shift are concatenated once at build time instead of by every run.
+   */
+  TensorRequisite ScaleShift(const dnnl::memory::desc& desc, const TensorRequisite& gamma_tr,
+                             const TensorRequisite& beta_tr) {
+    bool is_const = gamma_tr.IsConstant() && beta_tr.IsConstant();
+    auto scale_shift_tr = is_const ? TensorRequisite::AsIs(dnnl::memory(desc, engine_))
+                                   : TensorRequisite::AsIs(desc, GenUniqueEid());
     auto sc_sh_dims = scale_shift_tr.dims();
     ICHECK(sc_sh_dims.size() == 2);
     ICHECK(sc_sh_dims[0] == 2);
@@ -586,19 +670,21 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     auto scale_tr = scale_shift_tr.Crop(sc_sh_dims, {0, 0}).Squeeze();
     auto shift_tr = scale_shift_tr.Crop(sc_sh_dims, {1, 0}).Squeeze();
 
-    auto register_copy = [this](const TensorRequisite& src, const TensorRequisite& dst) {
+    auto register_copy = [this, is_const](const TensorRequisite& src, const TensorRequisite& dst) {
+      if (is_const) {
+        auto src_mem = src.GetConstData();
+        auto dst_mem = dst.GetConstData();
+        dnnl::reorder(src_mem, dst_mem).execute(stream_, src_mem, dst_mem);
+        stream_.wait();
+        return;
+      }
       dnnl::reorder::primitive_desc copy_pd(engine_, src.desc(), engine_, dst.desc());
       Submit(dnnl::reorder(copy_pd), {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
     };
 
     register_copy(gamma_tr, scale_tr);
     register_copy(beta_tr, shift_tr);
-
-    Submit(dnnl::batch_normalization_forward(bn_prim_desc), {{DNNL_ARG_SRC, src_tr},
-                                                             {DNNL_ARG_DST, dst_tr},
-                                                             {DNNL_ARG_SCALE_SHIFT, scale_shift_tr},
-                                                             {DNNL_ARG_MEAN, mean_tr},
-                                                             {DNNL_ARG_VARIANCE, var_tr}});
+    return scale_shift_tr;
   }
 
   void LayerNorm(const size_t& nid) {
@@ -624,22 +710,7 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     auto lnorm_prim_desc = dnnl::layer_normalization_forward::primitive_desc(lnorm_desc, engine_);
 
     // Concatenate scale and shift tensors
-    auto scale_shift_tr = TensorRequisite::AsIs(lnorm_prim_desc.weights_desc(), GenUniqueEid());
-    auto sc_sh_dims = scale_shift_tr.dims();
-
-    ICHECK(sc_sh_dims.size() == 2);
-    ICHECK(sc_sh_dims[0] == 2);
-    sc_sh_dims[0] /= 2;
-    auto scale_tr = scale_shift_tr.Crop(sc_sh_dims, {0, 0}).Squeeze();
-    auto shift_tr = scale_shift_tr.Crop(sc_sh_dims, {1, 0}).Squeeze();
-
-    auto register_copy = [this](const TensorRequisite& src, const TensorRequisite& dst) {
-      dnnl::reorder::primitive_desc copy_pd(engine_, src.desc(), engine_, dst.desc());
-      Submit(dnnl::reorder(copy_pd), {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}});
-    };
-
-    register_copy(gamma_tr, scale_tr);
-    register_copy(beta_tr, shift_tr);
+    auto scale_shift_tr = ScaleShift(lnorm_prim_desc.weights_desc(), gamma_tr, beta_tr);
 
     Submit(
         dnnl::layer_normalization_forward(lnorm_prim_desc),
@@ -815,10 +886,10 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     ICHECK_LT(idx, node.GetInputs().size());
     auto data_entry = node.GetInputs()[idx];
 
-    auto shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
     auto dtype = nodes_[data_entry.id_].GetOpDataType()[data_entry.index_];
     auto eid = node_row_ptr_[data_entry.id_] + data_entry.index_;
     auto const_dl_tensor = data_entry_[eid];
+    auto shape = GetEntryShape(data_entry.id_, data_entry.index_);
 
     auto desc = MakePlainDesc(shape, dtype);
 
@@ -834,6 +905,20 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     return res;
   }
 
+  /*!
+   * \brief Get the shape of the entry for the batch size being built. The outermost dimension of
+   * the non-constant entries which is the graph batch size is the batch.
+   */
+  std::vector<int64_t> GetEntryShape(uint32_t nid, uint32_t idx) {
+    auto shape = nodes_[nid].GetOpShape()[idx];
+    auto eid = node_row_ptr_[nid] + idx;
+    if (batch_ != graph_batch_ && data_entry_[eid] == nullptr && !shape.empty() &&
+        shape[0] == graph_batch_) {
+      shape[0] = batch_;
+    }
+    return shape;
+  }
+
   TensorRequisite GetInputByName(const size_t& nid, const std::string& name) {
     auto idx = GetNodeAttr<int>(nodes_[nid], name, {"-1"});
     return GetInput(nid, idx);
@@ -844,7 +929,7 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     const JSONGraphNode& node = nodes_[nid];
 
     ICHECK_LT(idx, node.GetNumOutput());
-    auto shape = node.GetOpShape()[idx];
+    auto shape = GetEntryShape(nid, idx);
     auto dtype = node.GetOpDataType()[idx];
     auto eid = node_row_ptr_[nid] + static_cast<uint32_t>(idx);
 
@@ -917,10 +1002,22 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   dnnl::engine engine_;
   /* The dnnl stream. */
   dnnl::stream stream_;
-  /* The network layers that are represented in dnnl primitives. */
+  /* The network layers that are represented in dnnl primitives, while building them. */
   TensorRegistry::ActionQue net_;
-  /* Storage for all memory objects */
+  /* Storage for all memory objects, while building the primitives. */
   TensorRegistry tensor_registry_;
+  /* The constants reordered to the layouts of the primitives. */
+  std::shared_ptr<PackedConstCache> packed_consts_;
+  /* The primitives built for each batch size. */
+  std::unordered_map<int64_t, Subgraph> subgraphs_;
+  /* Guard of subgraphs_ for the concurrent runs. */
+  std::mutex subgraphs_mutex_;
+  /* Shapes of the graph inputs, in the order of the Run args. */
+  std::vector<std::vector<int64_t>> graph_input_shapes_;
+  /* The batch size of the graph, -1 if it is dynamic. */
+  int64_t graph_batch_ = 1;
+  /* The batch size of the primitives being built. */
+  int64_t batch_ = 1;
   /* Generator of new unique eid which doesn't match with existing data entry */
   uint32_t next_unique_eid_offset_;
   /* Map of Run arg idx to corresponding eid */
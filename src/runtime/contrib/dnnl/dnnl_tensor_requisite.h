@@ -496,6 +496,40 @@ class TensorRequisite {
   friend class TensorRegistry;
 };
 
+/*!
+ * \brief The cache of constant tensors reordered to the layouts requested by primitives.
+ *
+ * Each constant is reordered only once into each requested layout, e.g. the blocked format of
+ * convolution weights. The packed copy is shared by all registrations of the constant, including
+ * those of the subgraphs built for other batch sizes.
+ */
+class PackedConstCache {
+ public:
+  /*!
+   * \brief Get the constant reordered to the provided memory descriptor.
+   * \param src constant data to reorder
+   * \param desc memory descriptor of the packed tensor
+   * \return packed constant data, reordered at the first request
+   */
+  dnnl::memory Reorder(const dnnl::memory& src, const dnnl::memory::desc& desc) {
+    auto& packed = packed_[src.get_data_handle()];
+    for (const auto& kvp : packed) {
+      if (kvp.first == src.get_desc() && kvp.second.get_desc() == desc) return kvp.second;
+    }
+    auto eng = src.get_engine();
+    auto res = dnnl::memory{desc, eng};
+    auto stream = dnnl::stream(eng);
+    dnnl::reorder(src, res).execute(stream, src, res);
+    stream.wait();
+    packed.push_back({src.get_desc(), res});
+    return res;
+  }
+
+ private:
+  /* Map of the source data handle to its source descriptors and packed copies */
+  std::unordered_map<void*, std::vector<std::pair<dnnl::memory::desc, dnnl::memory>>> packed_;
+};
+
 /*!
  * \brief The registry of tensors. Implement matching of provided TRs and real memory buffers.
  *
@@ -522,8 +556,13 @@ class TensorRegistry {
   using MemSolver = std::function<const dnnl::memory(ArgId)>;
 
   TensorRegistry() = default;
-  TensorRegistry(const dnnl::engine& eng, const std::set<uint32_t>& ext_io_eid)
-      : tmp_mem_collection_(1), ext_io_eid_(ext_io_eid), eng_(eng), stream_(eng) {}
+  TensorRegistry(const dnnl::engine& eng, const std::set<uint32_t>& ext_io_eid,
+                 const std::shared_ptr<PackedConstCache>& packed_consts = nullptr)
+      : tmp_mem_collection_(1),
+        ext_io_eid_(ext_io_eid),
+        eng_(eng),
+        stream_(eng),
+        packed_consts_(packed_consts) {}
 
   /*!
    * \brief Register TR to registry
@@ -540,7 +579,7 @@ class TensorRegistry {
    */
   ArgId Register(const TensorRequisite& tr, ActionQue* action) {
     // 1) Constant tensor. Direct reference
-    if (auto const_data = tr.GetConstData()) {
+    if (auto const_data = GetConstData(tr)) {
       auto idx = const_mem_collection_.size();
       const_mem_collection_.push_back(const_data);
       return MakeArgReq(ArgReqFlag::CONST, static_cast<uint32_t>(idx));
@@ -612,6 +651,18 @@ class TensorRegistry {
   }
 
  private:
+  /*! \brief Same as tr.GetConstData(), but reuse the packed constants of the cache if any. */
+  dnnl::memory GetConstData(const TensorRequisite& tr) {
+    if (!packed_consts_ || tr.mem_ || !tr.orig_) return tr.GetConstData();
+
+    auto orig_const_data = GetConstData(*tr.orig_);
+    if (!orig_const_data) return {};
+    if (tr.reinterpret_) {
+      return {tr.t_desc_, orig_const_data.get_engine(), orig_const_data.get_data_handle()};
+    }
+    return packed_consts_->Reorder(orig_const_data, tr.t_desc_);
+  }
+
   ArgId RegisterReinterpret(ArgId src_ar, const dnnl::memory::desc& desc) {
     switch (src_ar.flag_) {
       case TMP_STORAGE: {
@@ -736,6 +787,9 @@ class TensorRegistry {
 
   /* Execution stream use to reorder const data */
   dnnl::stream stream_;
+
+  /* Cache of packed constants shared with other registries, optional */
+  std::shared_ptr<PackedConstCache> packed_consts_;
 };
 
 }  // namespace contrib
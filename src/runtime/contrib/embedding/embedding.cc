@@ -0,0 +1,227 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file embedding.cc
+ * \brief Row lookups in large embedding tables on CPU.
+ *
+ *  The tables are typically views over a memory mapped parameters file, so rows
+ *  are paged in on first use. Lookups sort the requested rows, so that the table
+ *  is walked in address order, and prefetch the rows a few lookups ahead.
+ */
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+/*! \brief Modes of the lookup, matching the mode attribute of nn.contrib_embedding_lookup. */
+enum EmbeddingMode : int { kGather = 0, kSum = 1, kMean = 2 };
+
+/*! \brief Number of lookups a row is prefetched ahead of its copy. */
+constexpr int64_t kEmbeddingPrefetchDistance = 8;
+/*! \brief Maximum number of cache lines prefetched for one row. */
+constexpr int64_t kEmbeddingPrefetchLines = 8;
+/*! \brief Below this number of lookups the rows are gathered in index order. */
+constexpr int64_t kMinSortedLookups = 64;
+/*! \brief Below this number of copied bytes the lookup runs on the calling thread. */
+constexpr int64_t kMinParallelLookupBytes = 1 << 16;
+
+inline void PrefetchRow(const char* row, int64_t row_bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  int64_t nbytes = std::min(row_bytes, kEmbeddingPrefetchLines * 64);
+  for (int64_t offset = 0; offset < nbytes; offset += 64) {
+    __builtin_prefetch(row + offset, 0, 0);
+  }
+#endif
+}
+
+/*!
+ * \brief Run f(begin, end) over [0, num_items) on the TVM thread pool.
+ * \param num_items The number of independent items.
+ * \param total_bytes The number of bytes copied for all the items.
+ * \param f The function processing the items in [begin, end).
+ */
+template <typename F>
+void ParallelForItems(int64_t num_items, int64_t total_bytes, F f) {
+  if (num_items <= 1 || total_bytes < kMinParallelLookupBytes) {
+    f(0, num_items);
+    return;
+  }
+  struct ParallelTask {
+    static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      ParallelTask* task = static_cast<ParallelTask*>(cdata);
+      int64_t chunk_size = (task->num_items + penv->num_task - 1) / penv->num_task;
+      int64_t begin = std::min(task_id * chunk_size, task->num_items);
+      int64_t end = std::min(begin + chunk_size, task->num_items);
+      if (begin < end) {
+        (*task->f)(begin, end);
+      }
+      return 0;
+    }
+
+    int64_t num_items;
+    F* f;
+  };
+  ParallelTask task{num_items, &f};
+  int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+  ICHECK_EQ(res, 0) << "EmbeddingLookup: TVMBackendParallelLaunch failed";
+}
+
+inline int64_t NumElements(const DLTensor* tensor) {
+  int64_t size = 1;
+  for (int i = 0; i < tensor->ndim; ++i) {
+    size *= tensor->shape[i];
+  }
+  return size;
+}
+
+/*! \brief Read the indices, clipped to the rows of the table. */
+template <typename IType>
+std::vector<int64_t> ReadIndices(const DLTensor* indices, int64_t num_rows) {
+  const IType* data = reinterpret_cast<const IType*>(static_cast<const char*>(indices->data) +
+                                                     indices->byte_offset);
+  std::vector<int64_t> rows(NumElements(indices));
+  for (size_t i = 0; i < rows.size(); ++i) {
+    rows[i] = std::min(std::max(static_cast<int64_t>(data[i]), int64_t(0)), num_rows - 1);
+  }
+  return rows;
+}
+
+/*! \brief Copy the requested rows, walking the table in address order. */
+void GatherRows(const char* table, int64_t row_bytes, const std::vector<int64_t>& rows,
+                char* out) {
+  int64_t n = static_cast<int64_t>(rows.size());
+  // (row, position in the output), sorted by row once there are enough lookups to reorder.
+  std::vector<std::pair<int64_t, int64_t>> order(n);
+  for (int64_t i = 0; i < n; ++i) {
+    order[i] = {rows[i], i};
+  }
+  if (n >= kMinSortedLookups) {
+    std::sort(order.begin(), order.end());
+  }
+  ParallelForItems(n, n * row_bytes, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; ++k) {
+      if (k + kEmbeddingPrefetchDistance < end) {
+        PrefetchRow(table + order[k + kEmbeddingPrefetchDistance].first * row_bytes, row_bytes);
+      }
+      std::memcpy(out + order[k].second * row_bytes, table + order[k].first * row_bytes,
+                  row_bytes);
+    }
+  });
+}
+
+/*! \brief Sum, or average, the rows of each of num_bags bags of bag_size consecutive indices. */
+template <typename DType>
+void ReduceBags(const DType* table, int64_t dim, const std::vector<int64_t>& rows,
+                int64_t num_bags, int64_t bag_size, bool mean, DType* out) {
+  if (bag_size == 0) {
+    // empty bags reduce to zeros
+    std::fill(out, out + num_bags * dim, DType(0));
+    return;
+  }
+  int64_t row_bytes = dim * static_cast<int64_t>(sizeof(DType));
+  ParallelForItems(num_bags, num_bags * bag_size * row_bytes, [&](int64_t begin, int64_t end) {
+    std::vector<int64_t> bag;
+    for (int64_t b = begin; b < end; ++b) {
+      const int64_t* bag_rows = rows.data() + b * bag_size;
+      bag.assign(bag_rows, bag_rows + bag_size);
+      std::sort(bag.begin(), bag.end());
+      DType* acc = out + b * dim;
+      std::fill(acc, acc + dim, DType(0));
+      for (int64_t k = 0; k < bag_size; ++k) {
+        if (k + kEmbeddingPrefetchDistance < bag_size) {
+          const DType* next = table + bag[k + kEmbeddingPrefetchDistance] * dim;
+          PrefetchRow(reinterpret_cast<const char*>(next), row_bytes);
+        }
+        const DType* row = table + bag[k] * dim;
+        for (int64_t j = 0; j < dim; ++j) {
+          acc[j] += row[j];
+        }
+      }
+      if (mean) {
+        for (int64_t j = 0; j < dim; ++j) {
+          acc[j] /= static_cast<DType>(bag_size);
+        }
+      }
+    }
+  });
+}
+
+// Look up rows of a 2-D embedding table.
+// Mode kGather: out[i..., :] = table[indices[i...], :].
+// Mode kSum / kMean: reduce the looked up rows over the last axis of indices.
+// Indices are clipped to the rows of the table.
+TVM_REGISTER_GLOBAL("tvm.contrib.embedding.lookup").set_body([](TVMArgs args, TVMRetValue* ret) {
+  DLTensor* table = args[0];
+  DLTensor* indices = args[1];
+  DLTensor* out = args[2];
+  int mode = args[3];
+  ICHECK_EQ(table->ndim, 2) << "ValueError: embedding table must be 2-D";
+  ICHECK(table->strides == nullptr && indices->strides == nullptr && out->strides == nullptr)
+      << "ValueError: embedding lookup requires compact tensors";
+  ICHECK_EQ(indices->dtype.code, kDLInt) << "ValueError: indices must be integers";
+  int64_t num_rows = table->shape[0];
+  int64_t dim = table->shape[1];
+  ICHECK_GT(num_rows, 0) << "ValueError: embedding table is empty";
+
+  std::vector<int64_t> rows;
+  if (indices->dtype.bits == 32) {
+    rows = ReadIndices<int32_t>(indices, num_rows);
+  } else if (indices->dtype.bits == 64) {
+    rows = ReadIndices<int64_t>(indices, num_rows);
+  } else {
+    LOG(FATAL) << "ValueError: unsupported index type with "
+               << static_cast<int>(indices->dtype.bits) << " bits";
+  }
+
+  const char* table_data = static_cast<const char*>(table->data) + table->byte_offset;
+  char* out_data = static_cast<char*>(out->data) + out->byte_offset;
+  if (mode == kGather) {
+    int64_t row_bytes = dim * ((table->dtype.bits * table->dtype.lanes + 7) / 8);
+    GatherRows(table_data, row_bytes, rows, out_data);
+    return;
+  }
+  ICHECK(mode == kSum || mode == kMean) << "ValueError: unknown embedding lookup mode " << mode;
+  ICHECK_GE(indices->ndim, 1) << "ValueError: bag reductions need indices with a bag axis";
+  int64_t bag_size = indices->shape[indices->ndim - 1];
+  int64_t num_bags = dim == 0 ? 0 : NumElements(out) / dim;
+  bool mean = mode == kMean;
+  if (table->dtype.code == kDLFloat && table->dtype.bits == 32) {
+    ReduceBags(reinterpret_cast<const float*>(table_data), dim, rows, num_bags, bag_size, mean,
+               reinterpret_cast<float*>(out_data));
+  } else if (table->dtype.code == kDLFloat && table->dtype.bits == 64) {
+    ReduceBags(reinterpret_cast<const double*>(table_data), dim, rows, num_bags, bag_size, mean,
+               reinterpret_cast<double*>(out_data));
+  } else {
+    LOG(FATAL) << "ValueError: bag reductions support float32 and float64 tables";
+  }
+});
+
+}  // namespace contrib
+}  // namespace tvm
@@ -28,7 +28,9 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/ndarray.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -90,6 +92,8 @@ class JSONRuntimeBase : public ModuleNode {
         this->SetInputOutputBuffers(args);
         // Execute the subgraph.
         this->Run();
+        // Copy the outputs which were bound to staging buffers.
+        this->WriteBackOutputs();
       });
     } else if ("__init_" + this->symbol_name_ == name) {
       // The function to initialize constant tensors.
@@ -148,6 +152,17 @@ class JSONRuntimeBase : public ModuleNode {
   std::string GetSource(const std::string& format = "json") override { return graph_json_; }
 
  protected:
+  /*!
+   * \brief The alignment in bytes of the input and output data that the backend can use in
+   * place. The backends can always use data_entry_[eid]->data directly: the tensors are compact,
+   * and their byte_offset is folded into the data pointer on the devices where it is a plain
+   * address. The tensors which are not aligned, or whose offset cannot be folded, are bound
+   * through staging buffers from the allocator of their device instead.
+   *
+   * \param device The device of the tensor.
+   */
+  virtual size_t GetRequiredAlignment(const DLDevice& device) const { return 1; }
+
   /*!
    * \brief Set up the input and output buffers by binding their DLTensor pointers to the
    * corresponding data entry.
@@ -174,8 +189,68 @@ class JSONRuntimeBase : public ModuleNode {
 
       // Assign input/output the NDArray pointers to data entry so that we can directly
       // read/write host buffers.
+      BindDataEntry(eid, arg, i >= input_var_eid_.size());
+    }
+  }
+
+  /*!
+   * \brief Bind the caller's tensor to a data entry without copy when the backend can use it in
+   * place, otherwise through a staging buffer.
+   *
+   * \param eid The data entry id.
+   * \param arg The input or output tensor of the caller.
+   * \param is_output Whether the tensor is an output, which is copied back after Run.
+   */
+  void BindDataEntry(uint32_t eid, const DLTensor* arg, bool is_output) {
+    ICHECK(IsContiguous(*arg)) << "ValueError: the inputs and outputs of the JSON runtime must be "
+                                  "compact, but entry "
+                               << eid << " has strides";
+    // The data of these devices is a plain address, the others may use opaque handles.
+    DLDeviceType device_type = arg->device.device_type;
+    bool is_address = device_type == kDLCPU || device_type == kDLCUDA ||
+                      device_type == kDLCUDAHost || device_type == kDLCUDAManaged ||
+                      device_type == kDLROCM || device_type == kDLROCMHost;
+    if (arg->byte_offset == 0 && !is_address) {
       data_entry_[eid] = arg;
+      return;
+    }
+    size_t alignment = GetRequiredAlignment(arg->device);
+    if (is_address &&
+        (reinterpret_cast<uintptr_t>(arg->data) + arg->byte_offset) % alignment == 0) {
+      if (arg->byte_offset == 0) {
+        data_entry_[eid] = arg;
+      } else {
+        DLTensor& view = data_entry_views_[eid];
+        view = *arg;
+        view.data = static_cast<char*>(arg->data) + arg->byte_offset;
+        view.byte_offset = 0;
+        data_entry_[eid] = &view;
+      }
+      return;
+    }
+    NDArray& staging = staging_buffers_[eid];
+    std::vector<int64_t> shape(arg->shape, arg->shape + arg->ndim);
+    if (!staging.defined() || staging->ndim != arg->ndim ||
+        !std::equal(shape.begin(), shape.end(), staging->shape) ||
+        staging.DataType() != DataType(arg->dtype) ||
+        staging->device.device_type != arg->device.device_type ||
+        staging->device.device_id != arg->device.device_id) {
+      staging = NDArray::Empty(shape, arg->dtype, arg->device);
+    }
+    if (is_output) {
+      staged_outputs_.emplace_back(staging, const_cast<DLTensor*>(arg));
+    } else {
+      staging.CopyFrom(arg);
+    }
+    data_entry_[eid] = staging.operator->();
+  }
+
+  /*! \brief Copy the outputs bound to staging buffers back to the caller's tensors. */
+  void WriteBackOutputs() {
+    for (auto& staged : staged_outputs_) {
+      staged.first.CopyTo(staged.second);
     }
+    staged_outputs_.clear();
   }
 
   /*!
@@ -277,6 +352,12 @@ class JSONRuntimeBase : public ModuleNode {
   std::vector<JSONGraphNodeEntry> outputs_;
   /*! \brief Data of that entry. */
   std::vector<const DLTensor*> data_entry_;
+  /*! \brief Views of the bound tensors with their byte_offset folded into the data pointer. */
+  std::unordered_map<uint32_t, DLTensor> data_entry_views_;
+  /*! \brief Staging buffers of the bound tensors which the backend cannot use in place. */
+  std::unordered_map<uint32_t, NDArray> staging_buffers_;
+  /*! \brief The outputs of the current call bound to staging buffers, and the caller's tensors. */
+  std::vector<std::pair<NDArray, DLTensor*>> staged_outputs_;
   /*! \brief Map the input name to entry id. */
   std::vector<uint32_t> input_var_eid_;
   /*! \brief input const node index. */
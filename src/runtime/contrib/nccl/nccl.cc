@@ -0,0 +1,225 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file Use external NCCL library call for the collectives between the local GPUs.
+ */
+#include <nccl.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/registry.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace nccl {
+
+#define TVM_NCCL_CALL(func)                                              \
+  {                                                                      \
+    ncclResult_t e = (func);                                             \
+    ICHECK(e == ncclSuccess) << "NCCL error: " << ncclGetErrorString(e); \
+  }
+
+/*!
+ * \brief The communicators of a clique of the local GPUs, one per device.
+ *
+ * The clique is created once by `tvm.contrib.nccl.init`, after which the collectives on a tensor
+ * use the communicator of the device holding the tensor. A collective has to be launched on every
+ * device of the clique, either from one thread per device, or from a single thread within a
+ * `group_start` / `group_end` pair.
+ */
+class NCCLCommunicators {
+ public:
+  static NCCLCommunicators* Global() {
+    static NCCLCommunicators* inst = new NCCLCommunicators();
+    return inst;
+  }
+
+  void Init(const std::vector<int>& device_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Destroy();
+    std::vector<ncclComm_t> comms(device_ids.size());
+    TVM_NCCL_CALL(ncclCommInitAll(comms.data(), static_cast<int>(device_ids.size()),
+                                  device_ids.data()));
+    for (size_t i = 0; i < device_ids.size(); ++i) {
+      comms_[device_ids[i]] = comms[i];
+    }
+  }
+
+  ncclComm_t Get(int device_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = comms_.find(device_id);
+    CHECK(it != comms_.end()) << "ValueError: cuda(" << device_id
+                              << ") is not in the NCCL clique, call tvm.contrib.nccl.init first";
+    return it->second;
+  }
+
+  int Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(comms_.size());
+  }
+
+ private:
+  void Destroy() {
+    for (auto& kv : comms_) {
+      TVM_NCCL_CALL(ncclCommDestroy(kv.second));
+    }
+    comms_.clear();
+  }
+
+  std::mutex mutex_;
+  /*! \brief device id => the communicator of the device */
+  std::unordered_map<int, ncclComm_t> comms_;
+};
+
+inline ncclDataType_t GetNCCLDataType(DLDataType dtype) {
+  if (dtype.lanes == 1) {
+    if (dtype.code == kDLInt && dtype.bits == 8) return ncclInt8;
+    if (dtype.code == kDLInt && dtype.bits == 32) return ncclInt32;
+    if (dtype.code == kDLInt && dtype.bits == 64) return ncclInt64;
+    if (dtype.code == kDLUInt && dtype.bits == 8) return ncclUint8;
+    if (dtype.code == kDLUInt && dtype.bits == 32) return ncclUint32;
+    if (dtype.code == kDLUInt && dtype.bits == 64) return ncclUint64;
+    if (dtype.code == kDLFloat && dtype.bits == 16) return ncclFloat16;
+    if (dtype.code == kDLFloat && dtype.bits == 32) return ncclFloat32;
+    if (dtype.code == kDLFloat && dtype.bits == 64) return ncclFloat64;
+#if NCCL_VERSION_CODE >= 21000
+    if (dtype.code == kDLBfloat && dtype.bits == 16) return ncclBfloat16;
+#endif
+  }
+  LOG(FATAL) << "ValueError: Unsupported NCCL data type: " << DLDataType2String(dtype);
+  return ncclFloat32;
+}
+
+inline ncclRedOp_t GetNCCLReduceOp(const std::string& op) {
+  if (op == "sum") return ncclSum;
+  if (op == "prod") return ncclProd;
+  if (op == "max") return ncclMax;
+  if (op == "min") return ncclMin;
+  LOG(FATAL) << "ValueError: Unsupported NCCL reduction: " << op
+             << ", expected one of sum, prod, max and min";
+  return ncclSum;
+}
+
+inline size_t GetNumElements(const DLTensor* tensor) {
+  size_t size = 1;
+  for (int i = 0; i < tensor->ndim; ++i) {
+    size *= static_cast<size_t>(tensor->shape[i]);
+  }
+  return size;
+}
+
+inline void CheckTensors(const DLTensor* send, const DLTensor* recv) {
+  CHECK_EQ(send->device.device_type, kDLCUDA) << "ValueError: NCCL only supports CUDA tensors";
+  CHECK_EQ(recv->device.device_type, kDLCUDA) << "ValueError: NCCL only supports CUDA tensors";
+  CHECK_EQ(send->device.device_id, recv->device.device_id)
+      << "ValueError: The send and receive tensors of a collective must be on the same device";
+  CHECK(TypeEqual(send->dtype, recv->dtype))
+      << "ValueError: The send and receive tensors of a collective must have the same dtype";
+}
+
+inline void* GetData(const DLTensor* tensor) {
+  return static_cast<char*>(tensor->data) + tensor->byte_offset;
+}
+
+/*! \brief Get the communicator of the device holding the tensor, making it the current device. */
+inline ncclComm_t GetComm(const DLTensor* tensor) {
+  ncclComm_t comm = NCCLCommunicators::Global()->Get(tensor->device.device_id);
+  CUDA_CALL(cudaSetDevice(tensor->device.device_id));
+  return comm;
+}
+
+void AllReduce(DLTensor* send, DLTensor* recv, const std::string& op) {
+  CheckTensors(send, recv);
+  size_t count = GetNumElements(send);
+  CHECK_EQ(count, GetNumElements(recv))
+      << "ValueError: allreduce requires the send and receive tensors of the same size";
+  ncclComm_t comm = GetComm(send);
+  cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+  TVM_NCCL_CALL(ncclAllReduce(GetData(send), GetData(recv), count, GetNCCLDataType(send->dtype),
+                              GetNCCLReduceOp(op), comm, stream));
+}
+
+void AllGather(DLTensor* send, DLTensor* recv) {
+  CheckTensors(send, recv);
+  size_t count = GetNumElements(send);
+  int nranks = NCCLCommunicators::Global()->Size();
+  CHECK_EQ(count * nranks, GetNumElements(recv))
+      << "ValueError: allgather requires the receive tensor to be " << nranks
+      << " times of the send tensor";
+  ncclComm_t comm = GetComm(send);
+  cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+  TVM_NCCL_CALL(ncclAllGather(GetData(send), GetData(recv), count, GetNCCLDataType(send->dtype),
+                              comm, stream));
+}
+
+void ReduceScatter(DLTensor* send, DLTensor* recv, const std::string& op) {
+  CheckTensors(send, recv);
+  size_t count = GetNumElements(recv);
+  int nranks = NCCLCommunicators::Global()->Size();
+  CHECK_EQ(count * nranks, GetNumElements(send))
+      << "ValueError: reduce_scatter requires the send tensor to be " << nranks
+      << " times of the receive tensor";
+  ncclComm_t comm = GetComm(send);
+  cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+  TVM_NCCL_CALL(ncclReduceScatter(GetData(send), GetData(recv), count,
+                                  GetNCCLDataType(send->dtype), GetNCCLReduceOp(op), comm, stream));
+}
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.init").set_body([](TVMArgs args, TVMRetValue* ret) {
+  std::vector<int> device_ids;
+  for (int i = 0; i < args.num_args; ++i) {
+    device_ids.push_back(args[i]);
+  }
+  CHECK(!device_ids.empty()) << "ValueError: NCCL requires at least one device";
+  NCCLCommunicators::Global()->Init(device_ids);
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.size").set_body_typed([]() {
+  return NCCLCommunicators::Global()->Size();
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.group_start").set_body_typed([]() {
+  TVM_NCCL_CALL(ncclGroupStart());
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.group_end").set_body_typed([]() {
+  TVM_NCCL_CALL(ncclGroupEnd());
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.allreduce").set_body([](TVMArgs args, TVMRetValue* ret) {
+  AllReduce(args[0], args[1], args[2].operator std::string());
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.allgather").set_body([](TVMArgs args, TVMRetValue* ret) {
+  AllGather(args[0], args[1]);
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.nccl.reduce_scatter")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      ReduceScatter(args[0], args[1], args[2].operator std::string());
+    });
+
+}  // namespace nccl
+}  // namespace runtime
+}  // namespace tvm
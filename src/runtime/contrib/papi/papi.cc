@@ -250,6 +250,20 @@ struct PAPIMetricCollectorNode final : public MetricCollectorNode {
             ObjectRef(make_object<CountNode>(end_values[i] - event_set_node->start_values[i]));
       }
     }
+    // Derive the instructions per cycle when both counters are collected.
+    auto count = [&](std::initializer_list<const char*> names) -> int64_t {
+      for (const char* name : names) {
+        auto it = reported_metrics.find(name);
+        if (it != reported_metrics.end()) return it->second.as<CountNode>()->value;
+      }
+      return -1;
+    };
+    int64_t instructions = count({"perf::INSTRUCTIONS", "PAPI_TOT_INS"});
+    int64_t cycles = count({"perf::CYCLES", "PAPI_TOT_CYC"});
+    if (instructions >= 0 && cycles > 0) {
+      reported_metrics["IPC"] = ObjectRef(
+          make_object<RatioNode>(static_cast<double>(instructions) / static_cast<double>(cycles)));
+    }
     return reported_metrics;
   }
 
@@ -33,6 +33,7 @@
 #include <thread>
 
 #include "../3rdparty/compiler-rt/builtin_fp16.h"
+#include "philox.h"
 
 namespace tvm {
 namespace contrib {
@@ -143,32 +144,31 @@ class RandomEngine {
   }
 
  private:
-  void FillDataImpl(void* data, int64_t st, int64_t ed, DLDataType dtype) {
+  template <typename Engine>
+  void FillDataImpl(void* data, int64_t st, int64_t ed, DLDataType dtype, Engine* engine) {
     // Make the value be 1.0 - 10.0, not (0.0 - 1.0) so that we could satisfy
     // quantized dtype (uint8 / int8) data non-empty requirement
     std::uniform_real_distribution<> dist(1.0, 10.0);
     // Use float representation could make us work well on float / int type too.
     if (dtype.bits == 1) {
-      std::generate_n(static_cast<bool*>(data) + st, ed - st, [&]() { return dist(rnd_engine_); });
+      std::generate_n(static_cast<bool*>(data) + st, ed - st, [&]() { return dist(*engine); });
     } else if (dtype.bits == 4) {
       // For uint4/int4 we pack two values into a single byte.
       // Thus, to ensure both values are non-zero, we use a distribution of 17 - 30.
       std::uniform_real_distribution<> packed_dist(17.0, 30.0);
       std::generate_n(reinterpret_cast<uint8_t*>(data) + st, ed - st,
-                      [&]() { return packed_dist(rnd_engine_); });
+                      [&]() { return packed_dist(*engine); });
     } else if (dtype.bits == 8) {
-      std::generate_n(static_cast<uint8_t*>(data) + st, ed - st,
-                      [&]() { return dist(rnd_engine_); });
+      std::generate_n(static_cast<uint8_t*>(data) + st, ed - st, [&]() { return dist(*engine); });
     } else if (dtype.bits == 16) {
       std::generate_n(static_cast<uint16_t*>(data) + st, ed - st, [&]() {
         return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(
-            static_cast<float>(dist(rnd_engine_)));
+            static_cast<float>(dist(*engine)));
       });
     } else if (dtype.bits == 32) {
-      std::generate_n(static_cast<float*>(data) + st, ed - st, [&]() { return dist(rnd_engine_); });
+      std::generate_n(static_cast<float*>(data) + st, ed - st, [&]() { return dist(*engine); });
     } else if (dtype.bits == 64) {
-      std::generate_n(static_cast<double*>(data) + st, ed - st,
-                      [&]() { return dist(rnd_engine_); });
+      std::generate_n(static_cast<double*>(data) + st, ed - st, [&]() { return dist(*engine); });
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << dtype.code << " dtype bits " << dtype.bits;
     }
@@ -182,7 +182,7 @@ class RandomEngine {
     DLDataType dtype = tensor->dtype;
     if (dtype.bits == 1 || dtype.bits == 4 || dtype.bits == 8 || dtype.bits == 16 ||
         dtype.bits == 32 || dtype.bits == 64) {
-      FillDataImpl(tensor->data, 0, size, dtype);
+      FillDataImpl(tensor->data, 0, size, dtype, &rnd_engine_);
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << dtype.code << " dtype bits " << dtype.bits;
     }
@@ -196,14 +196,20 @@ class RandomEngine {
         return 0;
       }
 
+      // Every chunk draws from its own Philox stream, so the threads do not share the state of
+      // the engine and the values do not depend on the number of threads.
       void Run(int i, int num_tasks) {
-        int64_t chunk_size = size / num_tasks;
-        int64_t st = i * chunk_size;
-        int64_t ed = std::min(st + chunk_size, size);
-        self->FillDataImpl(data, st, ed, dtype);
+        int64_t num_chunks = (size + kMeasureFillChunkSize - 1) / kMeasureFillChunkSize;
+        for (int64_t chunk = i; chunk < num_chunks; chunk += num_tasks) {
+          philox::PhiloxEngine engine(seed, chunk);
+          int64_t st = chunk * kMeasureFillChunkSize;
+          int64_t ed = std::min(st + kMeasureFillChunkSize, size);
+          self->FillDataImpl(data, st, ed, dtype, &engine);
+        }
       }
 
       RandomEngine* self;
+      uint64_t seed;
       void* data;
       int64_t size;
       DLDataType dtype;
@@ -211,6 +217,8 @@ class RandomEngine {
 
     ParallelTask task;
     task.self = this;
+    uint64_t seed_hi = rnd_engine_();
+    task.seed = (seed_hi << 32) | rnd_engine_();
     task.data = tensor->data;
     DLDataType dtype = task.dtype = tensor->dtype;
     int64_t& size = task.size = 1;
@@ -227,6 +235,8 @@ class RandomEngine {
   }
 
  private:
+  /*! \brief The number of elements filled from one Philox stream by FillDataForMeasure. */
+  static constexpr int64_t kMeasureFillChunkSize = 1 << 16;
   std::mt19937 rnd_engine_;
   unsigned rseed_;
 };
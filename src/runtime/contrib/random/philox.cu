@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox.cu
+ * \brief CUDA fill from the Philox streams, matching the CPU fill in random.cc.
+ */
+#include <tvm/runtime/registry.h>
+
+#include <string>
+
+#include "../../cuda/cuda_common.h"
+#include "philox.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+__global__ void PhiloxUniformKernel(uint64_t seed, uint64_t offset, float low, float high,
+                                    float* out, int64_t size) {
+  int64_t block = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  int64_t first = block * philox::kBlockSize;
+  if (first < size) {
+    int num = static_cast<int>(min(static_cast<int64_t>(philox::kBlockSize), size - first));
+    philox::UniformBlock(seed, offset, block, low, high, out + first, num);
+  }
+}
+
+__global__ void PhiloxNormalKernel(uint64_t seed, uint64_t offset, float loc, float scale,
+                                   float* out, int64_t size) {
+  int64_t block = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  int64_t first = block * philox::kBlockSize;
+  if (first < size) {
+    int num = static_cast<int>(min(static_cast<int64_t>(philox::kBlockSize), size - first));
+    philox::NormalBlock(seed, offset, block, loc, scale, out + first, num);
+  }
+}
+
+void PhiloxFillCUDA(DLTensor* out, std::string distribution, int64_t seed, int64_t offset,
+                    double a, double b) {
+  int64_t size = 1;
+  for (int i = 0; i < out->ndim; ++i) {
+    size *= out->shape[i];
+  }
+  if (size == 0) return;
+  CUDA_CALL(cudaSetDevice(out->device.device_id));
+  constexpr int kThreads = 256;
+  int64_t num_blocks = (size + philox::kBlockSize - 1) / philox::kBlockSize;
+  int64_t grid = (num_blocks + kThreads - 1) / kThreads;
+  cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+  float* data = static_cast<float*>(out->data);
+  if (distribution == "uniform") {
+    PhiloxUniformKernel<<<grid, kThreads, 0, stream>>>(seed, offset, a, b, data, size);
+  } else {
+    PhiloxNormalKernel<<<grid, kThreads, 0, stream>>>(seed, offset, a, b, data, size);
+  }
+  CUDA_CALL(cudaGetLastError());
+}
+
+TVM_REGISTER_GLOBAL("runtime.contrib.random.PhiloxFillCUDA").set_body_typed(PhiloxFillCUDA);
+
+}  // namespace contrib
+}  // namespace tvm
@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox.h
+ * \brief Philox4x32-10 counter-based random number generator, shared by the CPU and CUDA fills.
+ *
+ * Every (key, counter) pair maps to four independent random words, so any element of a random
+ * stream can be computed without generating the ones before it. Element i of the stream
+ * (seed, offset) is lane i % 4 of the block with counter (i / 4, offset) and key seed, which
+ * makes the result independent of how the elements are split over threads.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+#define TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__CUDACC__)
+#define TVM_PHILOX_FUNC __host__ __device__ inline
+#else
+#define TVM_PHILOX_FUNC inline
+#endif
+
+namespace tvm {
+namespace contrib {
+namespace philox {
+
+/*! \brief The four random words generated for one counter. */
+struct Philox4x32 {
+  uint32_t x[4];
+};
+
+/*! \brief The number of elements generated for one counter. */
+constexpr int kBlockSize = 4;
+
+/*!
+ * \brief The Philox4x32-10 generator of Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3", SC 2011.
+ * \param key The 64-bit key, i.e. the seed.
+ * \param counter_lo The lower 64 bits of the counter, i.e. the block index.
+ * \param counter_hi The upper 64 bits of the counter, i.e. the stream offset.
+ */
+TVM_PHILOX_FUNC Philox4x32 Philox(uint64_t key, uint64_t counter_lo, uint64_t counter_hi) {
+  uint32_t k0 = static_cast<uint32_t>(key);
+  uint32_t k1 = static_cast<uint32_t>(key >> 32);
+  uint32_t c0 = static_cast<uint32_t>(counter_lo);
+  uint32_t c1 = static_cast<uint32_t>(counter_lo >> 32);
+  uint32_t c2 = static_cast<uint32_t>(counter_hi);
+  uint32_t c3 = static_cast<uint32_t>(counter_hi >> 32);
+  for (int round = 0; round < 10; ++round) {
+    uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+    uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+    c0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(product1);
+    c2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(product0);
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+  return {{c0, c1, c2, c3}};
+}
+
+/*! \brief Map a random word to a float in [0, 1). */
+TVM_PHILOX_FUNC float ToUniform(uint32_t x) { return (x >> 8) * (1.0f / 16777216.0f); }
+
+/*! \brief Map a random word to a float in (0, 1], which is safe to take the log of. */
+TVM_PHILOX_FUNC float ToOpenUniform(uint32_t x) { return ((x >> 8) + 1) * (1.0f / 16777216.0f); }
+
+/*!
+ * \brief Write the first num elements of a block of samples from Unif(low, high).
+ * \param seed The key of the stream.
+ * \param offset The offset of the stream.
+ * \param block The index of the block, i.e. the index of its first element divided by 4.
+ */
+TVM_PHILOX_FUNC void UniformBlock(uint64_t seed, uint64_t offset, uint64_t block, float low,
+                                  float high, float* out, int num) {
+  Philox4x32 r = Philox(seed, block, offset);
+  for (int i = 0; i < num; ++i) {
+    out[i] = low + (high - low) * ToUniform(r.x[i]);
+  }
+}
+
+/*!
+ * \brief Write the first num elements of a block of samples from Normal(loc, scale**2), using
+ * the Box-Muller transform on the two pairs of words of the block.
+ */
+TVM_PHILOX_FUNC void NormalBlock(uint64_t seed, uint64_t offset, uint64_t block, float loc,
+                                 float scale, float* out, int num) {
+  Philox4x32 r = Philox(seed, block, offset);
+  float values[kBlockSize];
+  for (int pair = 0; pair < kBlockSize / 2; ++pair) {
+    float radius = sqrtf(-2.0f * logf(ToOpenUniform(r.x[2 * pair])));
+    float theta = 6.2831853071795864f * ToUniform(r.x[2 * pair + 1]);
+    values[2 * pair] = loc + scale * radius * cosf(theta);
+    values[2 * pair + 1] = loc + scale * radius * sinf(theta);
+  }
+  for (int i = 0; i < num; ++i) {
+    out[i] = values[i];
+  }
+}
+
+/*!
+ * \brief A UniformRandomBitGenerator over one Philox stream, for use with the standard
+ * distributions on the CPU.
+ */
+class PhiloxEngine {
+ public:
+  using result_type = uint32_t;
+
+  PhiloxEngine(uint64_t seed, uint64_t offset) : seed_(seed), offset_(offset) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT32_MAX; }
+
+  result_type operator()() {
+    if (lane_ == kBlockSize) {
+      words_ = Philox(seed_, block_++, offset_);
+      lane_ = 0;
+    }
+    return words_.x[lane_++];
+  }
+
+ private:
+  uint64_t seed_;
+  uint64_t offset_;
+  uint64_t block_{0};
+  Philox4x32 words_{};
+  int lane_{kBlockSize};
+};
+
+}  // namespace philox
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
@@ -27,8 +27,10 @@
 #include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <string>
 
 #include "mt_random_engine.cc"
+#include "philox.h"
 
 #define DLPACK_INTEGER_TYPE_SWITCH(type, DType, ...)    \
   if (type.code == kDLInt && type.bits == 32) {         \
@@ -69,6 +71,14 @@ RandomThreadLocalEntry* RandomThreadLocalEntry::ThreadLocal() {
   return RandomThreadLocalStore::Get();
 }
 
+int64_t GetTensorSize(const DLTensor* tensor) {
+  int64_t size = 1;
+  for (int i = 0; i < tensor->ndim; ++i) {
+    size *= tensor->shape[i];
+  }
+  return size;
+}
+
 TVM_REGISTER_GLOBAL("tvm.contrib.random.randint").set_body([](TVMArgs args, TVMRetValue* ret) {
   RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
   int64_t low = args[0];
@@ -118,6 +128,84 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.normal").set_body([](TVMArgs args, TVMRe
   entry->random_engine.SampleNormal(out, loc, scale);
 });
 
+/*!
+ * \brief Fill a float32 tensor from the Philox stream (seed, offset), calling
+ * fblock(block, out, num) for every block of 4 elements. The blocks are spread over the TVM
+ * thread pool; the values only depend on the element index, so they match the CUDA fill.
+ */
+template <typename FBlock>
+void PhiloxFillCPU(DLTensor* out, FBlock fblock) {
+  struct ParallelTask {
+    static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      ParallelTask* task = static_cast<ParallelTask*>(cdata);
+      int64_t num_blocks = (task->size + philox::kBlockSize - 1) / philox::kBlockSize;
+      int64_t chunk_size = (num_blocks + penv->num_task - 1) / penv->num_task;
+      int64_t begin = std::min(task_id * chunk_size, num_blocks);
+      int64_t end = std::min(begin + chunk_size, num_blocks);
+      for (int64_t block = begin; block < end; ++block) {
+        int64_t first = block * philox::kBlockSize;
+        int num = static_cast<int>(std::min<int64_t>(philox::kBlockSize, task->size - first));
+        (*task->fblock)(block, task->data + first, num);
+      }
+      return 0;
+    }
+
+    float* data;
+    int64_t size;
+    FBlock* fblock;
+  };
+  ParallelTask task{static_cast<float*>(out->data), GetTensorSize(out), &fblock};
+  int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+  ICHECK_EQ(res, 0) << "PhiloxFill: TVMBackendParallelLaunch failed";
+}
+
+/*!
+ * \brief Fill a float32 tensor with samples from the Philox stream (seed, offset).
+ * \param distribution "uniform" for Unif(a, b), or "normal" for Normal(a, b**2).
+ */
+void PhiloxFill(DLTensor* out, const std::string& distribution, uint64_t seed, uint64_t offset,
+                float a, float b) {
+  ICHECK(out->strides == nullptr) << "ValueError: Philox fill requires a compact tensor";
+  ICHECK(out->dtype.code == kDLFloat && out->dtype.bits == 32 && out->dtype.lanes == 1)
+      << "ValueError: Philox fill only supports float32, but gets " << out->dtype;
+  if (distribution == "uniform") {
+    ICHECK_GT(b, a) << "high must be bigger than low";
+  } else if (distribution == "normal") {
+    ICHECK_GT(b, 0) << "standard deviation must be positive";
+  } else {
+    LOG(FATAL) << "ValueError: Unknown distribution " << distribution;
+  }
+
+  if (out->device.device_type == kDLCUDA) {
+    static const PackedFunc* fill_cuda = Registry::Get("runtime.contrib.random.PhiloxFillCUDA");
+    ICHECK(fill_cuda) << "ValueError: Philox fill on CUDA requires TVM built with USE_CUDA=ON";
+    (*fill_cuda)(out, distribution, static_cast<int64_t>(seed), static_cast<int64_t>(offset), a,
+                 b);
+    return;
+  }
+  ICHECK_EQ(out->device.device_type, kDLCPU)
+      << "Do not support Philox random fill on this device yet";
+  if (distribution == "uniform") {
+    PhiloxFillCPU(out, [&](int64_t block, float* data, int num) {
+      philox::UniformBlock(seed, offset, block, a, b, data, num);
+    });
+  } else {
+    PhiloxFillCPU(out, [&](int64_t block, float* data, int num) {
+      philox::NormalBlock(seed, offset, block, a, b, data, num);
+    });
+  }
+}
+
+TVM_REGISTER_GLOBAL("tvm.contrib.random.philox_uniform")
+    .set_body_typed([](int64_t seed, int64_t offset, double low, double high, DLTensor* out) {
+      PhiloxFill(out, "uniform", seed, offset, low, high);
+    });
+
+TVM_REGISTER_GLOBAL("tvm.contrib.random.philox_normal")
+    .set_body_typed([](int64_t seed, int64_t offset, double loc, double scale, DLTensor* out) {
+      PhiloxFill(out, "normal", seed, offset, loc, scale);
+    });
+
 TVM_REGISTER_GLOBAL("tvm.contrib.random.random_fill").set_body([](TVMArgs args, TVMRetValue* ret) {
   RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
   DLTensor* out = args[0];
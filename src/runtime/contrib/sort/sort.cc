@@ -22,9 +22,14 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../../../../3rdparty/compiler-rt/builtin_fp16.h"
@@ -70,6 +75,59 @@ struct float16 {
   inline bool operator>=(const float16& rhs) const { return to_float() >= rhs.to_float(); }
 };
 
+/*! \brief The minimum number of elements to sort before the rows are spread over threads. */
+constexpr int64_t kMinParallelSortSize = 16384;
+
+/*!
+ * \brief Get the number of rows before and after the sort axis.
+ * \return The pair of (axis_mul_before, axis_mul_after).
+ */
+std::pair<int64_t, int64_t> GetAxisMul(const DLTensor* input, int axis) {
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
+  for (int i = 0; i < input->ndim; ++i) {
+    if (i < axis) {
+      axis_mul_before *= input->shape[i];
+    } else if (i > axis) {
+      axis_mul_after *= input->shape[i];
+    }
+  }
+  return {axis_mul_before, axis_mul_after};
+}
+
+/*!
+ * \brief Run f(begin, end) over the rows [0, num_rows) on the TVM thread pool. The rows are
+ * sorted independently, so every task only needs its own scratch buffers.
+ * \param num_rows The number of rows to sort.
+ * \param row_size The number of elements in each row.
+ * \param f The function sorting the rows in [begin, end).
+ */
+template <typename F>
+void ParallelForRows(int64_t num_rows, int64_t row_size, F f) {
+  if (num_rows <= 1 || num_rows * row_size < kMinParallelSortSize) {
+    f(0, num_rows);
+    return;
+  }
+  struct ParallelTask {
+    static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      ParallelTask* task = static_cast<ParallelTask*>(cdata);
+      int64_t chunk_size = (task->num_rows + penv->num_task - 1) / penv->num_task;
+      int64_t begin = std::min(task_id * chunk_size, task->num_rows);
+      int64_t end = std::min(begin + chunk_size, task->num_rows);
+      if (begin < end) {
+        (*task->f)(begin, end);
+      }
+      return 0;
+    }
+
+    int64_t num_rows;
+    F* f;
+  };
+  ParallelTask task{num_rows, &f};
+  int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+  ICHECK_EQ(res, 0) << "Sort: TVMBackendParallelLaunch failed";
+}
+
 // Argsort implemented C library sort for nms.
 // Return indices of sorted tensor.
 // By default, the last axis will be used to sort.
@@ -87,9 +145,6 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   auto dtype = input->dtype;
   auto data_ptr = static_cast<float*>(input->data);
   auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
-  int64_t axis_mul_before = 1;
-  int64_t axis_mul_after = 1;
 
   if (axis < 0) {
     axis = input->ndim + axis;
@@ -106,16 +161,14 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
                                   "input ndim "
                                << input->ndim;
 
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
+  int64_t axis_mul_before, axis_mul_after;
+  std::tie(axis_mul_before, axis_mul_after) = GetAxisMul(input, axis);
 
-  for (int64_t i = 0; i < axis_mul_before; ++i) {
-    for (int64_t j = 0; j < axis_mul_after; ++j) {
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int32_t, float>> sorter;
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t i = row / axis_mul_after;
+      int64_t j = row % axis_mul_after;
       sorter.clear();
       int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
       int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
@@ -149,7 +202,8 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
             k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
       }
     }
-  }
+  };
+  ParallelForRows(axis_mul_before * axis_mul_after, input->shape[axis], sort_rows);
 });
 
 template <typename DataType, typename OutType>
@@ -158,36 +212,30 @@ void sort_impl(
     std::function<void(OutType*, size_t, const std::pair<int64_t, DataType>&)> epilogue) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
+  int64_t axis_mul_before, axis_mul_after;
+  std::tie(axis_mul_before, axis_mul_after) = GetAxisMul(input, axis);
+  int64_t axis_size = input->shape[axis];
+
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    sorter.reserve(axis_size);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t base_idx = (row / axis_mul_after) * axis_size * axis_mul_after + row % axis_mul_after;
       sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
+      for (int64_t k = 0; k < axis_size; ++k) {
+        sorter.emplace_back(k, data_ptr[base_idx + k * axis_mul_after]);
       }
       if (is_ascend) {
         std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
       } else {
         std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
       }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
+      for (int64_t k = 0; k < axis_size; ++k) {
         epilogue(out_ptr, base_idx + k * axis_mul_after, sorter[k]);
       }
     }
-  }
+  };
+  ParallelForRows(axis_mul_before * axis_mul_after, axis_size, sort_rows);
 }
 
 template <typename DataType, typename OutType>
@@ -199,13 +247,42 @@ void argsort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
       });
 }
 
+// Sorting the values alone moves half the data of sorting (index, value) pairs. Equal integers
+// are indistinguishable, so they do not need a stable sort either.
 template <typename DataType>
 void sort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
-  return sort_impl<DataType, DataType>(
-      input, output, axis, is_ascend,
-      [](DataType* out_ptr, size_t index, const std::pair<int64_t, DataType>& sort_pair) {
-        out_ptr[index] = sort_pair.second;
-      });
+  auto data_ptr = static_cast<DataType*>(input->data);
+  auto out_ptr = static_cast<DataType*>(output->data);
+  int64_t axis_mul_before, axis_mul_after;
+  std::tie(axis_mul_before, axis_mul_after) = GetAxisMul(input, axis);
+  int64_t axis_size = input->shape[axis];
+
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    std::vector<DataType> values(axis_size);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t base_idx = (row / axis_mul_after) * axis_size * axis_mul_after + row % axis_mul_after;
+      for (int64_t k = 0; k < axis_size; ++k) {
+        values[k] = data_ptr[base_idx + k * axis_mul_after];
+      }
+      if constexpr (std::is_integral_v<DataType>) {
+        if (is_ascend) {
+          std::sort(values.begin(), values.end(), std::less<DataType>());
+        } else {
+          std::sort(values.begin(), values.end(), std::greater<DataType>());
+        }
+      } else {
+        if (is_ascend) {
+          std::stable_sort(values.begin(), values.end(), std::less<DataType>());
+        } else {
+          std::stable_sort(values.begin(), values.end(), std::greater<DataType>());
+        }
+      }
+      for (int64_t k = 0; k < axis_size; ++k) {
+        out_ptr[base_idx + k * axis_mul_after] = values[k];
+      }
+    }
+  };
+  ParallelForRows(axis_mul_before * axis_mul_after, axis_size, sort_rows);
 }
 
 // Argsort implemented C library sort.
@@ -355,81 +432,56 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
 
-  // Maintain a min/max containing the top-k elements
-  std::vector<std::pair<int64_t, DataType>> running_heap;
-
-  // Need +1 when inserting new element before maintaining heap invariant
-  running_heap.reserve(k + 1);
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
+  int64_t axis_mul_before, axis_mul_after;
+  std::tie(axis_mul_before, axis_mul_after) = GetAxisMul(input, axis);
+  int64_t axis_size = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_size;
   }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      running_heap.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
+  int64_t num_top = std::min<int64_t>(k, axis_size);
+
+  auto sort_rows = [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    sorter.reserve(axis_size);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t i = row / axis_mul_after;
+      int64_t j = row % axis_mul_after;
+      int64_t src_base_idx = i * axis_size * axis_mul_after + j;
       int64_t dst_base_idx = i * k * axis_mul_after + j;
-
-      // Start by creating min/max heap with fixed-k elements
-      int cur_axis_index = 0;
-      for (; cur_axis_index < k && cur_axis_index < input->shape[axis]; cur_axis_index++) {
+      sorter.clear();
+      for (int64_t cur_axis_index = 0; cur_axis_index < axis_size; ++cur_axis_index) {
         int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        running_heap.emplace_back(std::make_pair(cur_axis_index, data_ptr[full_idx]));
-      }
-      if (!is_ascend) {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-      } else {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
+        sorter.emplace_back(cur_axis_index, data_ptr[full_idx]);
       }
 
-      // Iterate through all elements, adding to heap along the way
-      for (; cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        std::pair<int64_t, DataType> cur_val = {cur_axis_index, data_ptr[full_idx]};
-
-        // Eq. to cur_val.second > running_heap.second
-        if (!is_ascend && CompareDescend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          running_heap.pop_back();
-        } else if (is_ascend && CompareAscend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          running_heap.pop_back();
+      // The comparison breaks ties by index, so selecting the top-k with a heap and sorting only
+      // them gives the same result as a full stable sort, in O(n log k) instead of O(n log n).
+      if (num_top == axis_size) {
+        if (is_ascend) {
+          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType, true>);
+        } else {
+          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType, true>);
         }
-      }
-
-      // finally sort heap and deliver results
-      if (is_ascend) {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
+      } else if (is_ascend) {
+        std::partial_sort(sorter.begin(), sorter.begin() + num_top, sorter.end(),
+                          CompareAscend<DataType, true>);
       } else {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
+        std::partial_sort(sorter.begin(), sorter.begin() + num_top, sorter.end(),
+                          CompareDescend<DataType, true>);
       }
 
-      for (uint32_t kk = 0; kk < running_heap.size(); ++kk) {
+      for (int64_t kk = 0; kk < num_top; ++kk) {
         if (indices_ptr != nullptr) {
           indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(running_heap[kk].first);
+              static_cast<IndicesType>(sorter[kk].first);
         }
         if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<DataType>(running_heap[kk].second);
+          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
         }
       }
     }
-  }
+  };
+  ParallelForRows(axis_mul_before * axis_mul_after, axis_size, sort_rows);
 }
 
 // Argsort implemented C library sort.
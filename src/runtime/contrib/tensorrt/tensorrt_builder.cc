@@ -183,7 +183,26 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
   }
 
   // Add profiles.
-  if (!use_implicit_batch_) {
+  if (!use_implicit_batch_ && !profile_max_dims_.empty()) {
+    for (int64_t max_dim : profile_max_dims_) {
+      auto profile = builder_->createOptimizationProfile();
+      for (int i = 0; i < network_->getNbInputs(); ++i) {
+        auto name = network_->getInput(i)->getName();
+        nvinfer1::Dims min_dims = network_->getInput(i)->getDimensions();
+        nvinfer1::Dims max_dims = min_dims;
+        for (int j = 0; j < min_dims.nbDims; ++j) {
+          if (min_dims.d[j] == -1) {
+            min_dims.d[j] = 1;
+            max_dims.d[j] = static_cast<int>(max_dim);
+          }
+        }
+        profile->setDimensions(name, nvinfer1::OptProfileSelector::kMIN, min_dims);
+        profile->setDimensions(name, nvinfer1::OptProfileSelector::kOPT, max_dims);
+        profile->setDimensions(name, nvinfer1::OptProfileSelector::kMAX, max_dims);
+      }
+      config_->addOptimizationProfile(profile);
+    }
+  } else if (!use_implicit_batch_) {
     auto profile = builder_->createOptimizationProfile();
     for (int i = 0; i < network_->getNbInputs(); ++i) {
       auto name = network_->getInput(i)->getName();
@@ -204,17 +223,20 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
     config_->addOptimizationProfile(profile);
   }
   nvinfer1::ICudaEngine* engine = builder_->buildEngineWithConfig(*network_, *config_);
+  // Every optimization profile has its own set of bindings.
+  ICHECK_EQ(engine->getNbBindings(), (network_input_names_.size() + network_output_names_.size()) *
+                                         engine->getNbOptimizationProfiles());
 #else
   nvinfer1::ICudaEngine* engine = builder_->buildCudaEngine(*network_);
-#endif
   ICHECK_EQ(engine->getNbBindings(), network_input_names_.size() + network_output_names_.size());
+#endif
   nvinfer1::IExecutionContext* context = engine->createExecutionContext();
   CleanUp();
 
   ICHECK(engine);
   ICHECK(context);
 
-  return {engine, context, network_input_names_, network_output_names_};
+  return {engine, context, network_input_names_, network_output_names_, profile_max_dims_};
 }
 
 nvinfer1::Weights TensorRTBuilder::GetDLTensorAsWeights(const DLTensor* dptr,
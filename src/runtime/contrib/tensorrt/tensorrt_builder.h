@@ -52,6 +52,9 @@ struct TensorRTEngineAndContext {
   nvinfer1::IExecutionContext* context = nullptr;
   std::vector<std::string> inputs;
   std::vector<std::string> outputs;
+  /*! \brief The largest value of the dynamic dims in each optimization profile of the engine,
+   * in increasing order. Empty if the engine was built for the shapes of a single call. */
+  std::vector<int64_t> profile_max_dims;
 };
 
 /*!
@@ -104,6 +107,16 @@ class TensorRTBuilder {
    */
   void AddOutput(const JSONGraphNodeEntry& entry, uint32_t entry_id);
 
+  /*!
+   * \brief Build the engine with one optimization profile per element of \p profile_max_dims,
+   * instead of a profile for the current input shapes. In the profile of max_dim, every dynamic
+   * dim of the inputs ranges from 1 to max_dim, and the kernels are optimized for max_dim.
+   * \param profile_max_dims The largest value of the dynamic dims in each profile.
+   */
+  void SetOptimizationProfiles(const std::vector<int64_t>& profile_max_dims) {
+    profile_max_dims_ = profile_max_dims;
+  }
+
   /*!
    * \brief Takes network definition and "compiles" a TensorRT engine which can be used for
    * inference. This step is time confusing.
@@ -159,6 +172,9 @@ class TensorRTBuilder {
   /*! \brief Batch size to optimize for. */
   int batch_size_;
 
+  /*! \brief The largest value of the dynamic dims in each optimization profile. */
+  std::vector<int64_t> profile_max_dims_;
+
   /*! \brief Input names. */
   std::vector<std::string> network_input_names_;
 
@@ -26,6 +26,7 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -73,6 +74,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
         max_workspace_size_(size_t(1) << 30),
         max_batch_size_(-1),
         multi_engine_mode_(false),
+        use_optimization_profiles_(false),
         use_fp16_(false) {
     const bool use_int8 = dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false);
     multi_engine_mode_ = dmlc::GetEnv("TVM_TENSORRT_MULTI_ENGINE", false);
@@ -113,6 +115,11 @@ class TensorRTRuntime : public JSONRuntimeBase {
         << "The number of input constants must match the number of required.";
     LoadGlobalAttributes();
     SetupConstants(consts);
+    // A single engine with optimization profiles serves all the shapes of the dynamic dims,
+    // except in implicit batch mode which only supports a dynamic batch, and in INT8 mode
+    // where the calibration needs the shapes of a single call.
+    use_optimization_profiles_ = !use_implicit_batch_ && HasDynamicInputShapes() &&
+                                 !dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false);
     GetCachedEnginesFromDisk();
   }
 
@@ -139,6 +146,17 @@ class TensorRTRuntime : public JSONRuntimeBase {
     }
   }
 
+  /*! \brief Whether any input of the sub-graph has a dynamic dim. */
+  bool HasDynamicInputShapes() const {
+    for (auto nid : input_nodes_) {
+      if (nodes_[nid].GetOpType() != "input") continue;
+      for (const auto& shape : nodes_[nid].GetOpShape()) {
+        if (std::find(shape.begin(), shape.end(), -1) != shape.end()) return true;
+      }
+    }
+    return false;
+  }
+
 #ifdef TVM_GRAPH_EXECUTOR_TENSORRT
   /*! \brief Destroy engines and contexts. */
   void DestroyEngines() {
@@ -169,6 +187,21 @@ class TensorRTRuntime : public JSONRuntimeBase {
     const int num_bindings = engine->getNbBindings();
     std::vector<void*> bindings(num_bindings, nullptr);
     std::vector<size_t> binding_sizes(num_bindings, 0);
+    // The bindings of the optimization profile k follow those of the profiles before it.
+    int binding_offset = 0;
+#if TRT_VERSION_GE(6, 0, 1)
+    if (!engine_and_context.profile_max_dims.empty()) {
+      const int profile_index = SelectOptimizationProfile(engine_and_context);
+      if (context->getOptimizationProfile() != profile_index) {
+#if TRT_VERSION_GE(8, 0, 0)
+        ICHECK(context->setOptimizationProfileAsync(profile_index, nullptr));
+#else
+        ICHECK(context->setOptimizationProfile(profile_index));
+#endif
+      }
+      binding_offset = profile_index * (num_bindings / engine->getNbOptimizationProfiles());
+    }
+#endif
     // Setup input bindings.
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto nid = input_nodes_[i];
@@ -178,6 +211,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
           const std::string name = nodes_[nid].GetOpName() + "_" + std::to_string(j);
           int binding_index = engine->getBindingIndex(name.c_str());
           ICHECK_NE(binding_index, -1);
+          binding_index += binding_offset;
 #if TRT_VERSION_GE(6, 0, 1)
           if (!use_implicit_batch_) {
             std::vector<int64_t> shape(data_entry_[eid]->shape,
@@ -219,6 +253,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       const std::string& name = engine_and_context.outputs[i];
       int binding_index = engine->getBindingIndex(name.c_str());
       ICHECK_NE(binding_index, -1);
+      binding_index += binding_offset;
       if (data_entry_[eid]->device.device_type == kDLCUDA) {
         bindings[binding_index] = data_entry_[eid]->data;
       } else {
@@ -243,6 +278,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       const std::string& name = engine_and_context.outputs[i];
       int binding_index = engine->getBindingIndex(name.c_str());
       ICHECK_NE(binding_index, -1);
+      binding_index += binding_offset;
       if (data_entry_[eid]->device.device_type != kDLCUDA) {
         auto device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
         device_buffer.CopyTo(const_cast<DLTensor*>(data_entry_[eid]));
@@ -250,6 +286,12 @@ class TensorRTRuntime : public JSONRuntimeBase {
     }
   }
 
+ protected:
+  /*! \brief TensorRT reads the CUDA inputs and outputs in place, at 256-byte aligned addresses. */
+  size_t GetRequiredAlignment(const DLDevice& device) const final {
+    return device.device_type == kDLCUDA ? 256 : 1;
+  }
+
  private:
   /*! \brief Get batch size for engine from the runtime input shapes. */
   int GetBatchSize() {
@@ -280,6 +322,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * already built, do nothing.
    */
   TensorRTEngineAndContext& GetOrBuildEngine() {
+    if (use_optimization_profiles_) return GetOrBuildProfileEngine();
     int batch_size = GetBatchSize();
     int compatible_engine_batch_size = -1;
     bool find_engine_flag = FindCompatibleEngine(batch_size, &compatible_engine_batch_size);
@@ -317,14 +360,68 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
     VLOG(1) << "Finished building TensorRT engine for subgraph " << symbol_name_
             << " with batch size " << batch_size;
-    CacheEngineToDisk();
+    CacheEngineToDisk(batch_size);
     return trt_engine_cache_.at(std::make_pair(symbol_name_, batch_size));
   }
 
-  void BuildEngineFromJson(int batch_size) {
+  /*! \brief Get the largest value of the dynamic input dims in the current call. */
+  int64_t GetMaxDynamicDim() {
+    int64_t max_dim = 1;
+    for (auto nid : input_nodes_) {
+      if (nodes_[nid].GetOpType() != "input") continue;
+      const auto& shapes = nodes_[nid].GetOpShape();
+      for (size_t j = 0; j < shapes.size(); ++j) {
+        const DLTensor* tensor = data_entry_[EntryID(nid, j)];
+        for (size_t k = 0; k < shapes[j].size() && k < static_cast<size_t>(tensor->ndim); ++k) {
+          if (shapes[j][k] == -1) max_dim = std::max(max_dim, tensor->shape[k]);
+        }
+      }
+    }
+    return max_dim;
+  }
+
+  /*! \brief Select the smallest optimization profile of the engine covering the current call. */
+  int SelectOptimizationProfile(const TensorRTEngineAndContext& engine_and_context) {
+    const std::vector<int64_t>& profile_max_dims = engine_and_context.profile_max_dims;
+    auto it = std::lower_bound(profile_max_dims.begin(), profile_max_dims.end(),
+                               GetMaxDynamicDim());
+    ICHECK(it != profile_max_dims.end()) << "No optimization profile covers the input shapes";
+    return static_cast<int>(it - profile_max_dims.begin());
+  }
+
+  /*!
+   * \brief Get the engine with optimization profiles covering the dynamic dims of the current
+   * call. The engine has a profile for each power of two up to the largest dynamic dim seen so
+   * far, or TVM_TENSORRT_MAX_DYNAMIC_DIM if larger, so that it is only rebuilt when a call
+   * exceeds it.
+   */
+  TensorRTEngineAndContext& GetOrBuildProfileEngine() {
+    const auto key = std::make_pair(symbol_name_, kProfileEngineBatchSize);
+    int64_t max_dim = GetMaxDynamicDim();
+    auto it = trt_engine_cache_.find(key);
+    if (it != trt_engine_cache_.end() && !it->second.profile_max_dims.empty()) {
+      if (max_dim <= it->second.profile_max_dims.back()) return it->second;
+      max_dim = std::max(max_dim, it->second.profile_max_dims.back() * 2);
+    }
+    max_dim = std::max(max_dim, dmlc::GetEnv("TVM_TENSORRT_MAX_DYNAMIC_DIM", int64_t(0)));
+    std::vector<int64_t> profile_max_dims = {1};
+    while (profile_max_dims.back() < max_dim) {
+      profile_max_dims.push_back(profile_max_dims.back() * 2);
+    }
+    DestroyEngines();
+    DLOG(INFO) << "Building new TensorRT engine for subgraph " << symbol_name_ << " with "
+               << profile_max_dims.size() << " optimization profiles up to dynamic dim "
+               << profile_max_dims.back();
+    BuildEngineFromJson(kProfileEngineBatchSize, profile_max_dims);
+    CacheEngineToDisk(kProfileEngineBatchSize);
+    return trt_engine_cache_.at(key);
+  }
+
+  void BuildEngineFromJson(int batch_size, const std::vector<int64_t>& profile_max_dims = {}) {
     const bool use_fp16 = dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) || use_fp16_;
     TensorRTBuilder builder(&logger_, data_entry_, max_workspace_size_, use_implicit_batch_,
                             use_fp16, batch_size, calibrator_.get());
+    builder.SetOptimizationProfiles(profile_max_dims);
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto nid = input_nodes_[i];
       const auto& node = nodes_[nid];
@@ -387,6 +484,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
     helper.DeclareField("inputs", &engine_and_context.inputs);
     helper.DeclareField("outputs", &engine_and_context.outputs);
     helper.DeclareField("batch_size", &batch_size);
+    helper.DeclareOptionalField("profile_max_dims", &engine_and_context.profile_max_dims);
     helper.ReadAllFields(&reader);
     trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
     max_batch_size_ = batch_size;
@@ -397,8 +495,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will save the engine to that
    * directory so it can be loaded later.
    */
-  void CacheEngineToDisk() {
-    int batch_size = GetBatchSize();
+  void CacheEngineToDisk(int batch_size) {
     std::string cache_dir = dmlc::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return;
     std::string key = GetSubgraphKey();
@@ -419,6 +516,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
     writer.WriteObjectKeyValue("outputs",
                                trt_engine_cache_[std::make_pair(symbol_name_, batch_size)].outputs);
     writer.WriteObjectKeyValue("batch_size", batch_size);
+    writer.WriteObjectKeyValue(
+        "profile_max_dims",
+        trt_engine_cache_[std::make_pair(symbol_name_, batch_size)].profile_max_dims);
     writer.EndObject();
     std::string meta_path = cache_dir + "/" + key + ".meta";
     SaveBinaryToFile(meta_path, os.str());
@@ -437,12 +537,14 @@ class TensorRTRuntime : public JSONRuntimeBase {
                                data_entry_[entry_id]->shape + data_entry_[entry_id]->ndim);
     if (device_buffers_.count(binding_index)) {
       // Buffer is already initialized.
-      if (shape[0] > device_buffers_[binding_index]->shape[0]) {
+      const DLTensor* buffer = device_buffers_[binding_index].operator->();
+      if (GetDataSize(*data_entry_[entry_id]) > GetDataSize(*buffer)) {
         // Buffer is too small. Need to allocate bigger buffer.
         device_buffers_[binding_index] =
             runtime::NDArray::Empty(shape, data_entry_[entry_id]->dtype, {kDLCUDA, 0});
-      } else if (shape[0] < device_buffers_[binding_index]->shape[0]) {
-        // Buffer is too large. Create view.
+      } else if (!std::equal(shape.begin(), shape.end(), buffer->shape,
+                             buffer->shape + buffer->ndim)) {
+        // Buffer is large enough, but has another shape. Create view.
         return device_buffers_[binding_index].CreateView(shape, data_entry_[entry_id]->dtype);
       }
     } else {
@@ -493,7 +595,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   bool GetCachedEnginesFromDisk() { return false; }
 
-  void CacheEngineToDisk() {}
+  void CacheEngineToDisk(int batch_size) {}
 #endif  // TVM_GRAPH_EXECUTOR_TENSORRT
 
   bool use_implicit_batch_;
@@ -514,6 +616,14 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * and more time spent building engines. */
   bool multi_engine_mode_;
 
+  /*! \brief Whether a single engine with optimization profiles serves all the shapes of the dynamic
+   * dims. It is used in explicit batch mode when the sub-graph has dynamic input dims, instead of
+   * the engines per batch size. */
+  bool use_optimization_profiles_;
+
+  /*! \brief The batch size key of the engine with optimization profiles in the engine cache. */
+  static constexpr int kProfileEngineBatchSize = -1;
+
   /*! \brief Use auto-conversion to fp16 */
   bool use_fp16_;
 };
@@ -22,23 +22,78 @@
  */
 
 #include <thrust/device_ptr.h>
-#include <thrust/device_vector.h>
 #include <thrust/sort.h>
 #include <thrust/gather.h>
 #include <thrust/scan.h>
 #include <thrust/sequence.h>
 
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 #include <dlpack/dlpack.h>
 #include <algorithm>
 #include <vector>
 #include <functional>
 
+#if defined(__HIP_PLATFORM_AMD__) || defined(__HIP_PLATFORM_HCC__)
+#include <thrust/system/hip/execution_policy.h>
+#include "../../rocm/rocm_common.h"
+#else
+#include <thrust/system/cuda/execution_policy.h>
+#include "../../cuda/cuda_common.h"
+#endif
+
 namespace tvm {
 namespace contrib {
 
 using namespace runtime;
 
+/*!
+ * \brief Allocator of the temporary storage of Thrust algorithms, backed by the TVM workspace
+ *  pool, so that the algorithms reuse cached memory instead of calling cudaMalloc and cudaFree.
+ */
+class WorkspaceAllocator {
+ public:
+  typedef char value_type;
+
+  explicit WorkspaceAllocator(DLDevice device) : device_(device) {}
+
+  char* allocate(std::ptrdiff_t num_bytes) {
+    return static_cast<char*>(DeviceAPI::Get(device_)->AllocWorkspace(device_, num_bytes));
+  }
+
+  void deallocate(char* ptr, size_t) { DeviceAPI::Get(device_)->FreeWorkspace(device_, ptr); }
+
+ private:
+  DLDevice device_;
+};
+
+/*!
+ * \brief The execution policy of the Thrust algorithms: the work is issued on the current TVM
+ *  stream and the temporary storage comes from the given allocator, which must outlive it.
+ */
+inline auto ThrustPolicy(WorkspaceAllocator* alloc) {
+#if defined(__HIP_PLATFORM_AMD__) || defined(__HIP_PLATFORM_HCC__)
+  return thrust::hip::par(*alloc).on(ROCMThreadEntry::ThreadLocal()->stream);
+#else
+  return thrust::cuda::par(*alloc).on(CUDAThreadEntry::ThreadLocal()->stream);
+#endif
+}
+
+/*! \brief A typed buffer in the TVM workspace pool, freed when it goes out of scope. */
+template <typename T>
+class WorkspaceBuffer {
+ public:
+  WorkspaceBuffer(WorkspaceAllocator* alloc, size_t size)
+      : alloc_(alloc), data_(reinterpret_cast<T*>(alloc->allocate(size * sizeof(T)))) {}
+  ~WorkspaceBuffer() { alloc_->deallocate(reinterpret_cast<char*>(data_), 0); }
+
+  thrust::device_ptr<T> begin() const { return thrust::device_ptr<T>(data_); }
+
+ private:
+  WorkspaceAllocator* alloc_;
+  T* data_;
+};
+
 // Performs sorting along axis -1 and returns both sorted values and indices.
 template<typename DataType, typename IndicesType>
 void thrust_sort(DLTensor* input,
@@ -49,34 +104,37 @@ void thrust_sort(DLTensor* input,
   thrust::device_ptr<DataType> data_ptr(static_cast<DataType *>(input->data));
   thrust::device_ptr<DataType> values_ptr(static_cast<DataType *>(out_values->data));
   thrust::device_ptr<IndicesType> indices_ptr(static_cast<IndicesType *>(out_indices->data));
+  WorkspaceAllocator alloc(input->device);
+  auto policy = ThrustPolicy(&alloc);
 
   size_t size = 1;
   for (int i = 0; i < input->ndim; ++i) {
     size *= input->shape[i];
   }
-  thrust::copy(data_ptr, data_ptr + size, values_ptr);
+  thrust::copy(policy, data_ptr, data_ptr + size, values_ptr);
 
   if (size == static_cast<size_t>(input->shape[input->ndim - 1])) {
     // A fast path for single segment case
-    thrust::sequence(indices_ptr, indices_ptr + n_values);
+    thrust::sequence(policy, indices_ptr, indices_ptr + n_values);
     if (is_ascend) {
-      thrust::sort_by_key(values_ptr, values_ptr + n_values, indices_ptr);
+      thrust::sort_by_key(policy, values_ptr, values_ptr + n_values, indices_ptr);
     } else {
-      thrust::sort_by_key(values_ptr, values_ptr + n_values, indices_ptr,
+      thrust::sort_by_key(policy, values_ptr, values_ptr + n_values, indices_ptr,
                           thrust::greater<DataType>());
     }
   } else {
     // segmented sort by key
     // Follow the back-to-back stable_sort_by_key strategy explained below
     // https://groups.google.com/g/thrust-users/c/BoLsxO6b4FY
-    thrust::device_vector<int64_t> argsort_order(size);
-    thrust::sequence(argsort_order.begin(), argsort_order.end());
+    WorkspaceBuffer<int64_t> argsort_order_buffer(&alloc, size);
+    auto argsort_order = argsort_order_buffer.begin();
+    thrust::sequence(policy, argsort_order, argsort_order + size);
 
     // First, sort values and store the sorted order in argsort_order.
     if (is_ascend) {
-      thrust::stable_sort_by_key(values_ptr, values_ptr + size, argsort_order.begin());
+      thrust::stable_sort_by_key(policy, values_ptr, values_ptr + size, argsort_order);
     } else {
-      thrust::stable_sort_by_key(values_ptr, values_ptr + size, argsort_order.begin(),
+      thrust::stable_sort_by_key(policy, values_ptr, values_ptr + size, argsort_order,
                                  thrust::greater<DataType>());
     }
 
@@ -90,14 +148,15 @@ void thrust_sort(DLTensor* input,
                                                              linear_index_to_sort_axis_index);
 
     // This will reorder indices 0, 1, 2 ... in the sorted order of values_ptr
-    thrust::gather(argsort_order.begin(), argsort_order.end(), init_indices_iter, indices_ptr);
+    thrust::gather(policy, argsort_order, argsort_order + size, init_indices_iter, indices_ptr);
 
-    thrust::device_vector<int> segment_ids(size);
+    WorkspaceBuffer<int> segment_ids_buffer(&alloc, size);
+    auto segment_ids = segment_ids_buffer.begin();
     auto linear_index_to_segment_id = [n_values] __host__ __device__(int64_t i) {
       return i / n_values;
     }; // NOLINT(*)
     // We also reorder segment indices 0, 0, 0, 1, 1, 1 ... in the order of values_ptr
-    thrust::transform(argsort_order.begin(), argsort_order.end(), segment_ids.begin(),
+    thrust::transform(policy, argsort_order, argsort_order + size, segment_ids,
                       linear_index_to_segment_id);
 
     // The second sort key-ed by segment_ids would bring segment_ids back to 0, 0, 0, 1, 1, 1 ...
@@ -105,7 +164,7 @@ void thrust_sort(DLTensor* input,
     // Since sorting has been done in a stable way, relative orderings of values and indices
     // in the segment do not change and hence they remain sorted.
     auto key_val_zip = thrust::make_zip_iterator(thrust::make_tuple(values_ptr, indices_ptr));
-    thrust::stable_sort_by_key(segment_ids.begin(), segment_ids.end(), key_val_zip);
+    thrust::stable_sort_by_key(policy, segment_ids, segment_ids + size, key_val_zip);
   }
 }
 
@@ -196,18 +255,21 @@ void thrust_stable_sort_by_key(DLTensor* keys_in,
   thrust::device_ptr<ValueType> values_in_ptr(static_cast<ValueType *>(values_in->data));
   thrust::device_ptr<KeyType> keys_out_ptr(static_cast<KeyType *>(keys_out->data));
   thrust::device_ptr<ValueType> values_out_ptr(static_cast<ValueType *>(values_out->data));
+  WorkspaceAllocator alloc(keys_in->device);
+  auto policy = ThrustPolicy(&alloc);
 
   if (for_scatter) {
-    thrust::transform(keys_in_ptr, keys_in_ptr + size, keys_out_ptr, [size] __device__(KeyType k) {
+    thrust::transform(policy, keys_in_ptr, keys_in_ptr + size, keys_out_ptr,
+                      [size] __device__(KeyType k) {
       if (k < 0) return k + static_cast<KeyType>(size);
       return k;
     });
   } else {
-    thrust::copy(keys_in_ptr, keys_in_ptr + size, keys_out_ptr);
+    thrust::copy(policy, keys_in_ptr, keys_in_ptr + size, keys_out_ptr);
   }
-  thrust::copy(values_in_ptr, values_in_ptr + size, values_out_ptr);
+  thrust::copy(policy, values_in_ptr, values_in_ptr + size, values_out_ptr);
 
-  thrust::stable_sort_by_key(keys_out_ptr, keys_out_ptr + size, values_out_ptr);
+  thrust::stable_sort_by_key(policy, keys_out_ptr, keys_out_ptr + size, values_out_ptr);
 }
 
 TVM_REGISTER_GLOBAL("tvm.contrib.thrust.stable_sort_by_key")
@@ -276,6 +338,9 @@ void thrust_scan(DLTensor* data,
 
   if (scan_size == 0) return;
 
+  WorkspaceAllocator alloc(data->device);
+  auto policy = ThrustPolicy(&alloc);
+
   size_t size = 1;
   for (int i = 0; i < data->ndim; ++i) size *= data->shape[i];
 
@@ -287,13 +352,13 @@ void thrust_scan(DLTensor* data,
 
   if (size == static_cast<size_t>(data->shape[data->ndim - 1])) {
     if (exclusive && need_cast) {
-      thrust::exclusive_scan(data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
+      thrust::exclusive_scan(policy, data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
     } else if (exclusive && !need_cast) {
-      thrust::exclusive_scan(data_ptr, data_ptr + scan_size, output_ptr);
+      thrust::exclusive_scan(policy, data_ptr, data_ptr + scan_size, output_ptr);
     } else if (!exclusive && need_cast) {
-      thrust::inclusive_scan(data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
+      thrust::inclusive_scan(policy, data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
     } else {
-      thrust::inclusive_scan(data_ptr, data_ptr + scan_size, output_ptr);
+      thrust::inclusive_scan(policy, data_ptr, data_ptr + scan_size, output_ptr);
     }
   } else {
     // Use thrust segmented scan to compute scan on the inner most axis
@@ -310,13 +375,13 @@ void thrust_scan(DLTensor* data,
     auto key_iter = thrust::make_transform_iterator(counting_iter, linear_index_to_scan_key);
 
     if (exclusive && need_cast) {
-      thrust::exclusive_scan_by_key(key_iter, key_iter + size, data_cast_ptr, output_ptr);
+      thrust::exclusive_scan_by_key(policy, key_iter, key_iter + size, data_cast_ptr, output_ptr);
     } else if (exclusive && !need_cast) {
-      thrust::exclusive_scan_by_key(key_iter, key_iter + size, data_ptr, output_ptr);
+      thrust::exclusive_scan_by_key(policy, key_iter, key_iter + size, data_ptr, output_ptr);
     } else if (!exclusive && need_cast) {
-      thrust::inclusive_scan_by_key(key_iter, key_iter + size, data_cast_ptr, output_ptr);
+      thrust::inclusive_scan_by_key(policy, key_iter, key_iter + size, data_cast_ptr, output_ptr);
     } else {
-      thrust::inclusive_scan_by_key(key_iter, key_iter + size, data_ptr, output_ptr);
+      thrust::inclusive_scan_by_key(policy, key_iter, key_iter + size, data_ptr, output_ptr);
     }
   }
 }
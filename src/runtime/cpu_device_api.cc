@@ -24,7 +24,9 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -46,6 +48,12 @@ class CPUDeviceAPI final : public DeviceAPI {
   }
   void* AllocDataSpace(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
     void* ptr;
+    // Allocations of a thread bound to a NUMA node start on a page, so that they can be
+    // placed on the node as a whole.
+    int numa_node = threading::CurrentNumaNode();
+    if (numa_node >= 0 && nbytes >= kNumaPageBytes) {
+      alignment = std::max(alignment, kNumaPageBytes);
+    }
 #if _MSC_VER
     ptr = _aligned_malloc(nbytes, alignment);
     if (ptr == nullptr) throw std::bad_alloc();
@@ -57,6 +65,9 @@ class CPUDeviceAPI final : public DeviceAPI {
     int ret = posix_memalign(&ptr, alignment, nbytes);
     if (ret != 0) throw std::bad_alloc();
 #endif
+    if (numa_node >= 0 && nbytes >= kNumaPageBytes) {
+      threading::BindMemoryToNumaNode(ptr, nbytes, numa_node);
+    }
     return ptr;
   }
 
@@ -73,6 +84,9 @@ class CPUDeviceAPI final : public DeviceAPI {
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final;
   void FreeWorkspace(Device dev, void* data) final;
 
+  /*! \brief The page size assumed by the NUMA placement, smaller allocations are left alone. */
+  static constexpr size_t kNumaPageBytes = 4096;
+
   static CPUDeviceAPI* Global() {
     // NOTE: explicitly use new to avoid exit-time destruction of global state
     // Global state will be recycled by OS as the process exits.
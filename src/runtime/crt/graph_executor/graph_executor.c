@@ -573,6 +573,7 @@ int TVMGraphExecutorGraphAttr_Release(TVMGraphExecutorGraphAttr* attr) {
 
 int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader) {
   int status = 0;
+  executor->shape_stride = TVM_CRT_MAX_NDIM;
   reader->BeginObject(reader);
   int bitmask = 0;
   char key[20];
@@ -723,6 +724,75 @@ int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader) {
   return status;
 }
 
+/*!
+ * \brief Load a binary graph in place: the tables of the executor point into the binary graph.
+ * \param executor The graph executor.
+ * \param graph_binary The binary graph, aligned to 8 bytes.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const void* graph_binary) {
+  const TVMGraphExecutorBinaryHeader* header = (const TVMGraphExecutorBinaryHeader*)graph_binary;
+  if (((uintptr_t)graph_binary) % sizeof(uint64_t) != 0) {
+    fprintf(stderr, "binary graph is not aligned to 8 bytes\n");
+    return -1;
+  }
+  if (header->magic != kTVMGraphBinaryMagic || header->version != kTVMGraphBinaryVersion) {
+    fprintf(stderr, "invalid binary graph format\n");
+    return -1;
+  }
+
+  const uint8_t* cursor = (const uint8_t*)(header + 1);
+  executor->binary = header;
+  executor->shape_stride = header->shape_stride;
+  executor->attrs.shape = (int64_t*)cursor;
+  cursor += sizeof(int64_t) * header->data_entry_count * header->shape_stride;
+  executor->binary_nodes = (const TVMGraphExecutorBinaryNode*)cursor;
+  executor->nodes_count = header->nodes_count;
+  cursor += sizeof(TVMGraphExecutorBinaryNode) * header->nodes_count;
+  executor->binary_node_entries = (const TVMGraphExecutorNodeEntry*)cursor;
+  cursor += sizeof(TVMGraphExecutorNodeEntry) * header->node_entries_count;
+  executor->outputs = (TVMGraphExecutorNodeEntry*)cursor;
+  executor->outputs_count = header->outputs_count;
+  cursor += sizeof(TVMGraphExecutorNodeEntry) * header->outputs_count;
+  executor->input_nodes = (uint32_t*)cursor;
+  executor->input_nodes_count = header->input_nodes_count;
+  cursor += sizeof(uint32_t) * header->input_nodes_count;
+  executor->node_row_ptr = (uint32_t*)cursor;
+  executor->node_row_ptr_count = header->nodes_count + 1;
+  cursor += sizeof(uint32_t) * executor->node_row_ptr_count;
+  executor->attrs.storage_id = (uint32_t*)cursor;
+  cursor += sizeof(uint32_t) * header->data_entry_count;
+  executor->attrs.ndim = (uint32_t*)cursor;
+  cursor += sizeof(uint32_t) * header->data_entry_count;
+  executor->binary_dltype = (const DLDataType*)cursor;
+  cursor += sizeof(DLDataType) * header->data_entry_count;
+  executor->binary_strings = (const char*)cursor;
+  executor->attrs.dltype_count = header->data_entry_count;
+  executor->attrs.shape_count = header->data_entry_count;
+
+  if (executor->node_row_ptr[header->nodes_count] != header->data_entry_count) {
+    fprintf(stderr, "invalid binary graph format: %u entries, but node_row_ptr ends at %u\n",
+            header->data_entry_count, executor->node_row_ptr[header->nodes_count]);
+    return -1;
+  }
+  uint32_t idx;
+  for (idx = 0; idx < header->data_entry_count; idx++) {
+    if (executor->attrs.ndim[idx] > header->shape_stride) {
+      fprintf(stderr, "invalid binary graph format: entry %u has more than %u dimensions\n", idx,
+              header->shape_stride);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static const char* TVMGraphExecutor_GetNodeName(TVMGraphExecutor* executor, uint32_t nid) {
+  if (executor->binary != NULL) {
+    return executor->binary_strings + executor->binary_nodes[nid].name;
+  }
+  return executor->nodes[nid].name;
+}
+
 uint32_t TVMGraphExecutor_GetEntryId(TVMGraphExecutor* executor, uint32_t nid, uint32_t index) {
   return executor->node_row_ptr[nid] + index;
 }
@@ -747,7 +817,7 @@ int TVMGraphExecutor_GetInputIndex(TVMGraphExecutor* executor, const char* name)
   int32_t rv = -1;
   for (i = 0; i < executor->input_nodes_count; ++i) {
     uint32_t nid = executor->input_nodes[i];
-    if (!strcmp(executor->nodes[nid].name, name)) {
+    if (!strcmp(TVMGraphExecutor_GetNodeName(executor, nid), name)) {
       rv = i;
       break;
     }
@@ -934,14 +1004,19 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   TVMGraphExecutorGraphAttr* attrs = &(executor->attrs);
   DLDataType* vtype = NULL;
   DLDevice alloc_dev = {kDLCPU, 0};
-  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count,
-                                                  alloc_dev, (void**)&vtype);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
-    return -1;
-  }
-  for (idx = 0; idx < attrs->dltype_count; idx++) {
-    vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
+  tvm_crt_error_t err;
+  if (executor->binary != NULL) {
+    vtype = (DLDataType*)executor->binary_dltype;
+  } else {
+    err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count, alloc_dev,
+                                    (void**)&vtype);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    for (idx = 0; idx < attrs->dltype_count; idx++) {
+      vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
+    }
   }
 
   // Size and device type of each storage pool entry.
@@ -959,7 +1034,8 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     int storage_id = attrs->storage_id[idx];
     // Use the fallback device if no device index is available.
     int device_type = executor->devices[0].device_type;
-    uint32_t size = Shape_Accumulate(attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx]);
+    uint32_t size =
+        Shape_Accumulate(attrs->shape + idx * executor->shape_stride, attrs->ndim[idx]);
     DLDataType t = vtype[idx];
     uint32_t bits = t.bits * t.lanes;
     size_t bytes = ((bits + 7U) / 8U) * size;
@@ -995,7 +1071,7 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
         tensor->data = linked_param_data;
         tensor->device = dev;
         tensor->ndim = attrs->ndim[pit.entry_id];
-        tensor->shape = attrs->shape + idx * TVM_CRT_MAX_NDIM;
+        tensor->shape = attrs->shape + idx * executor->shape_stride;
         tensor->strides = NULL;
         tensor->byte_offset = 0;
         did_find_linked_param = 1;
@@ -1027,19 +1103,21 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   for (idx = 0; idx < executor->data_entry_count; ++idx) {
     uint32_t storage_id = attrs->storage_id[idx];
     CHECK(storage_id < executor->storage_pool_count);
-    int status = TVMNDArray_CreateView(&(executor->storage_pool[storage_id].array),
-                                       attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx],
-                                       vtype[idx], &executor->data_entry[idx]);
+    int status = TVMNDArray_CreateView(
+        &(executor->storage_pool[storage_id].array), attrs->shape + idx * executor->shape_stride,
+        attrs->ndim[idx], vtype[idx], &executor->data_entry[idx]);
     CHECK_EQ(status, 0, "fail to create for node with idx=%d, storage_id=%u\n", idx, storage_id);
 
     TVMNDArray_IncrementReference(&executor->data_entry[idx]);
   }
 
   // Release memory
-  err = TVMPlatformMemoryFree(vtype, alloc_dev);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory free error: %08x", err);
-    return err;
+  if (executor->binary == NULL) {
+    err = TVMPlatformMemoryFree(vtype, alloc_dev);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory free error: %08x", err);
+      return err;
+    }
   }
 
   err = TVMPlatformMemoryFree(pool_entry, alloc_dev);
@@ -1064,41 +1142,70 @@ int TVMGraphExecutor_SetupOpExecs(TVMGraphExecutor* executor) {
     return status;
   }
   for (nid = 0; nid < executor->nodes_count; nid++) {
-    const TVMGraphExecutorNode* inode = executor->nodes + nid;
-    if (strcmp(inode->op_type, "null")) {
-      DLTensorPtr args[TVM_CRT_MAX_ARGS];
-      uint32_t args_count = 0;
-      for (idx = 0; idx < inode->inputs_count; idx++) {
-        const TVMGraphExecutorNodeEntry* entry = inode->inputs + idx;
-        uint32_t eid = TVMGraphExecutor_GetEntryId(executor, entry->node_id, entry->index);
-        args[idx] = &(executor->data_entry[eid].dl_tensor);
-        args_count++;
-      }
-      for (idx = 0; idx < inode->param.num_outputs; idx++) {
-        uint32_t eid = TVMGraphExecutor_GetEntryId(executor, nid, idx);
-        args[args_count] = &(executor->data_entry[eid].dl_tensor);
-        args_count++;
+    const TVMOpParam* param;
+    TVMOpParam binary_param;
+    const TVMGraphExecutorNodeEntry* inputs;
+    uint32_t inputs_count;
+    if (executor->binary != NULL) {
+      const TVMGraphExecutorBinaryNode* bnode = executor->binary_nodes + nid;
+      if (bnode->func_name == kTVMGraphBinaryNullOp) {
+        memset(&executor->op_execs[nid], 0, sizeof(TVMPackedFunc));
+        continue;
       }
-      if (strcmp(inode->op_type, "tvm_op")) {
-        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", inode->op_type);
+      const char* func_name = executor->binary_strings + bnode->func_name;
+      if (strlen(func_name) >= sizeof(binary_param.func_name)) {
+        fprintf(stderr, "function name longer than expected: %s\n", func_name);
         status = -1;
         break;
       }
-      if (args_count >= TVM_CRT_MAX_ARGS) {
-        fprintf(stderr, "too many arguments: expected less than %d args, but got %d.\n",
-                TVM_CRT_MAX_ARGS, args_count);
+      memset(&binary_param, 0, sizeof(binary_param));
+      strcpy(binary_param.func_name, func_name);  // NOLINT(runtime/printf)
+      binary_param.num_inputs = bnode->inputs_count;
+      binary_param.num_outputs = bnode->num_outputs;
+      binary_param.flatten_data = bnode->flatten_data;
+      param = &binary_param;
+      inputs = executor->binary_node_entries + bnode->inputs;
+      inputs_count = bnode->inputs_count;
+    } else {
+      const TVMGraphExecutorNode* inode = executor->nodes + nid;
+      if (!strcmp(inode->op_type, "null")) {
+        memset(&executor->op_execs[nid], 0, sizeof(TVMPackedFunc));
+        continue;
+      }
+      if (strcmp(inode->op_type, "tvm_op")) {
+        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", inode->op_type);
         status = -1;
         break;
       }
+      param = &(inode->param);
+      inputs = inode->inputs;
+      inputs_count = inode->inputs_count;
+    }
+    if (inputs_count + param->num_outputs >= TVM_CRT_MAX_ARGS) {
+      fprintf(stderr, "too many arguments: expected less than %d args, but got %d.\n",
+              TVM_CRT_MAX_ARGS, inputs_count + param->num_outputs);
+      status = -1;
+      break;
+    }
+    DLTensorPtr args[TVM_CRT_MAX_ARGS];
+    uint32_t args_count = 0;
+    for (idx = 0; idx < inputs_count; idx++) {
+      const TVMGraphExecutorNodeEntry* entry = inputs + idx;
+      uint32_t eid = TVMGraphExecutor_GetEntryId(executor, entry->node_id, entry->index);
+      args[idx] = &(executor->data_entry[eid].dl_tensor);
+      args_count++;
+    }
+    for (idx = 0; idx < param->num_outputs; idx++) {
+      uint32_t eid = TVMGraphExecutor_GetEntryId(executor, nid, idx);
+      args[args_count] = &(executor->data_entry[eid].dl_tensor);
+      args_count++;
+    }
 #if TVM_CRT_DEBUG
-      printf("tvm_op: creating %s with node_id=%d\n", inode->param.func_name, nid);
+    printf("tvm_op: creating %s with node_id=%d\n", param->func_name, nid);
 #endif  // TVM_CRT_DEBUG
-      TVMPackedFunc pf;
-      TVMGraphExecutor_CreateTVMOp(executor, &(inode->param), args, args_count, &pf);
-      executor->op_execs[nid] = pf;
-    } else {
-      memset(&executor->op_execs[nid], 0, sizeof(TVMPackedFunc));
-    }
+    TVMPackedFunc pf;
+    TVMGraphExecutor_CreateTVMOp(executor, param, args, args_count, &pf);
+    executor->op_execs[nid] = pf;
   }
   return status;
 }
@@ -1152,6 +1259,29 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
   return status;
 }
 
+/*!
+ * \brief Allocate the storage and the operators of a loaded graph.
+ * \param module_handle The module containing the compiled functions for the host
+ * processor.
+ * \param devs The device of the host and devices where graph nodes will be
+ * executed on.
+ * \return 0 on success.
+ */
+static int TVMGraphExecutor_Setup(TVMGraphExecutor* executor, TVMModuleHandle module_handle,
+                                  const DLDevice* devs) {
+  executor->module_handle = module_handle;
+  executor->devices[0] = devs[0];
+
+  int status;
+  status = TVMGraphExecutor_SetupStorage(executor);
+  if (status != 0) {
+    return status;
+  }
+  status = TVMGraphExecutor_SetupOpExecs(executor);
+
+  return status;
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -1174,17 +1304,25 @@ int TVMGraphExecutor_Init(TVMGraphExecutor* executor, const char* graph_json,
   if (err != kTvmErrorNoError) {
     return -1;
   }
-  executor->module_handle = module_handle;
-  executor->devices[0] = devs[0];
+  return TVMGraphExecutor_Setup(executor, module_handle, devs);
+}
 
-  int status;
-  status = TVMGraphExecutor_SetupStorage(executor);
+/*!
+ * \brief Initialize the graph executor with a binary graph, which is run in place, and device.
+ * \param graph_binary The execution graph, in the binary graph format.
+ * \param module_handle The module containing the compiled functions for the host
+ * processor.
+ * \param devs The device of the host and devices where graph nodes will be
+ * executed on.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_InitFromBinary(TVMGraphExecutor* executor, const void* graph_binary,
+                                    TVMModuleHandle module_handle, const DLDevice* devs) {
+  int status = TVMGraphExecutor_LoadBinary(executor, graph_binary);
   if (status != 0) {
     return status;
   }
-  status = TVMGraphExecutor_SetupOpExecs(executor);
-
-  return status;
+  return TVMGraphExecutor_Setup(executor, module_handle, devs);
 }
 
 int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
@@ -1201,24 +1339,52 @@ int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
   return TVMGraphExecutor_Init(*executor, sym_json, module_handle, devs);
 }
 
+int TVMGraphExecutor_CreateFromBinary(const void* graph_binary, TVMModuleHandle module_handle,
+                                      const DLDevice* devs, TVMGraphExecutor** executor) {
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutor), dev, (void**)executor);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+
+  memset(*executor, 0, sizeof(TVMGraphExecutor));
+  return TVMGraphExecutor_InitFromBinary(*executor, graph_binary, module_handle, devs);
+}
+
 int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
   int status = 0;
   int32_t idx;
   TVMGraphExecutor* executor = (TVMGraphExecutor*)(*pptr);
-  for (idx = 0; idx < executor->nodes_count; ++idx) {
-    status = TVMGraphExecutorNodeRelease(&(executor->nodes[idx]));
+  DLDevice dev = {kDLCPU, 0};
+  // The tables of a binary graph are used in place.
+  if (executor->binary == NULL) {
+    for (idx = 0; idx < executor->nodes_count; ++idx) {
+      status = TVMGraphExecutorNodeRelease(&(executor->nodes[idx]));
+      if (status != 0) {
+        return status;
+      }
+    }
+    status = TVMPlatformMemoryFree(executor->nodes, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMGraphExecutorGraphAttr_Release(&(executor->attrs));
+    if (status != 0) {
+      return status;
+    }
+    status = TVMPlatformMemoryFree(executor->input_nodes, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMPlatformMemoryFree(executor->outputs, dev);
     if (status != 0) {
       return status;
     }
-  }
-  DLDevice dev = {kDLCPU, 0};
-  status = TVMPlatformMemoryFree(executor->nodes, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMGraphExecutorGraphAttr_Release(&(executor->attrs));
-  if (status != 0) {
-    return status;
   }
   for (idx = 0; idx < executor->storage_pool_count; ++idx) {
     if (executor->storage_pool[idx].is_linked_param == 0) {
@@ -1234,18 +1400,6 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
       return status;
     }
   }
-  status = TVMPlatformMemoryFree(executor->input_nodes, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->outputs, dev);
-  if (status != 0) {
-    return status;
-  }
   status = TVMPlatformMemoryFree(executor->storage_pool, dev);
   if (status != 0) {
     return status;
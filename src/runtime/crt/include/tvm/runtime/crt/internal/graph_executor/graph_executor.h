@@ -45,8 +45,6 @@ typedef struct TVMGraphExecutorNodeEntry {
   uint32_t node_id;
   uint32_t index;
   uint32_t version;
-  // JSON Loader
-  void (*Load)(JSONReader* reader);
 } TVMGraphExecutorNodeEntry;
 
 // Storage entry.
@@ -75,6 +73,54 @@ typedef struct TVMGraphExecutorNode {
   int (*Load)(struct TVMGraphExecutorNode* node, JSONReader* reader);
 } TVMGraphExecutorNode;
 
+/*! \brief Magic number of a binary graph. */
+#define kTVMGraphBinaryMagic 0xF7E58D4F05049CB9
+/*! \brief Version of the binary graph format. */
+#define kTVMGraphBinaryVersion 1
+/*! \brief func_name of the nodes of a binary graph which are not operators. */
+#define kTVMGraphBinaryNullOp 0xFFFFFFFF
+
+// Header of a binary graph. The header is followed by the sections of the graph, in the order
+// below, each one being an array of the given number of items:
+//   int64_t shape[data_entry_count * shape_stride]
+//   TVMGraphExecutorBinaryNode nodes[nodes_count]
+//   TVMGraphExecutorNodeEntry node_entries[node_entries_count]
+//   TVMGraphExecutorNodeEntry outputs[outputs_count]
+//   uint32_t input_nodes[input_nodes_count]
+//   uint32_t node_row_ptr[nodes_count + 1]
+//   uint32_t storage_id[data_entry_count]
+//   uint32_t ndim[data_entry_count]
+//   DLDataType dltype[data_entry_count]
+//   char strings[strings_size]
+typedef struct TVMGraphExecutorBinaryHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t nodes_count;
+  uint32_t node_entries_count;
+  uint32_t input_nodes_count;
+  uint32_t outputs_count;
+  uint32_t data_entry_count;
+  // number of dimensions reserved for the shape of each entry
+  uint32_t shape_stride;
+  uint32_t strings_size;
+} TVMGraphExecutorBinaryHeader;
+
+// Node of a binary graph
+typedef struct TVMGraphExecutorBinaryNode {
+  // offset of the name of the node in the strings
+  uint32_t name;
+  // offset of the name of the operator function in the strings, or kTVMGraphBinaryNullOp
+  uint32_t func_name;
+  // index of the first input of the node in the node entries
+  uint32_t inputs;
+  // number of inputs
+  uint32_t inputs_count;
+  // number of outputs
+  uint32_t num_outputs;
+  // whether the operator takes flattened inputs
+  uint32_t flatten_data;
+} TVMGraphExecutorBinaryNode;
+
 typedef struct TVMGraphExecutor {
   /*! \brief The graph nodes. */
   TVMGraphExecutorNode* nodes;
@@ -92,6 +138,21 @@ typedef struct TVMGraphExecutor {
   uint32_t outputs_count;
   /*! \brief Additional graph attributes. */
   TVMGraphExecutorGraphAttr attrs;
+  /*! \brief Number of dimensions reserved for each shape in attrs.shape. */
+  uint32_t shape_stride;
+  /*!
+   * \brief The binary graph the executor runs in place, or NULL when the graph was loaded from
+   *  JSON. When set, nodes is NULL and the tables of the graph point into the binary graph.
+   */
+  const TVMGraphExecutorBinaryHeader* binary;
+  /*! \brief The nodes of the binary graph. */
+  const TVMGraphExecutorBinaryNode* binary_nodes;
+  /*! \brief The node entries referenced by the inputs of binary_nodes. */
+  const TVMGraphExecutorNodeEntry* binary_node_entries;
+  /*! \brief The data type of each entry of the binary graph. */
+  const DLDataType* binary_dltype;
+  /*! \brief The strings of the binary graph. */
+  const char* binary_strings;
   /*! \brief The code module that contains both host and device code. */
   TVMModuleHandle module_handle;
   /*! \brief Execution context of all devices including the host. */
@@ -122,6 +183,7 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
                                      DLTensorPtr* args, const uint32_t args_count,
                                      TVMPackedFunc* pf);
 int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader);
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const void* graph_binary);
 
 #ifdef __cplusplus
 }
@@ -105,6 +105,63 @@ typedef struct MemoryManager {
   MultiMap free_map;
 } MemoryManager;
 
+/*! \brief log2 of the number of second-level free lists in each first-level range of sizes. */
+#ifndef TVM_CRT_TLSF_SL_COUNT_LOG2
+#define TVM_CRT_TLSF_SL_COUNT_LOG2 3
+#endif
+
+/*! \brief Number of second-level free lists in each first-level range of sizes. */
+#define TLSF_SL_COUNT (1 << TVM_CRT_TLSF_SL_COUNT_LOG2)
+
+/*! \brief Page index marking the end of a free list. */
+#define TLSF_NO_PAGE UINT32_MAX
+
+/*!
+ * \brief Metadata of one page, used by the TLSF page allocator.
+ *
+ * The fields are only meaningful on the first page of a run of pages (a block), except `head`,
+ * which is only meaningful on the last page and lets Free find the block preceding a page.
+ */
+typedef struct TLSFPage {
+  /*! \brief The number of pages in the block, 0 on the pages which do not start a block */
+  uint32_t num_pages;
+  /*! \brief The first page of the block ending at this page */
+  uint32_t head;
+  /*! \brief The previous free block in the same free list */
+  uint32_t prev_free;
+  /*! \brief The next free block in the same free list */
+  uint32_t next_free;
+  /*! \brief Whether the block is free */
+  uint8_t is_free;
+} TLSFPage;
+
+/*!
+ * \brief DRAM memory manager based on two-level segregated fit.
+ *  Free blocks of pages are kept in free lists indexed by (fl, sl), where fl is the log2 of the
+ *  block size and sl subdivides each power-of-2 range linearly. Non-empty lists are tracked in
+ *  bitmaps, so finding a fitting block is a couple of find-first-set operations.
+ */
+typedef struct TLSFMemoryManager {
+  // Public interface for this object.
+  MemoryManagerInterface interface;
+  // Pointer to beginning of memory pool.
+  uint8_t* memory_pool;
+  // log2 of the size of one page.
+  size_t page_size_bytes_log2;
+  // Number of pages in the memory pool.
+  uint32_t num_pages;
+  // Number of first-level ranges.
+  uint32_t fl_count;
+  // Bit fl is set when any list of the range fl is non-empty.
+  uint32_t fl_bitmap;
+  // Bit sl of sl_bitmap[fl] is set when the list (fl, sl) is non-empty.
+  uint32_t* sl_bitmap;
+  // First block of the list (fl, sl), at free_lists[fl * TLSF_SL_COUNT + sl].
+  uint32_t* free_lists;
+  // Metadata of each page.
+  TLSFPage* pages;
+} TLSFMemoryManager;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
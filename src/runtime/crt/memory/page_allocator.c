@@ -280,6 +280,10 @@ tvm_crt_error_t PageMemoryManager_Free(MemoryManagerInterface* interface, void*
 tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
                                         size_t memory_pool_size_bytes,
                                         size_t page_size_bytes_log2) {
+#ifdef TVM_CRT_PAGE_ALLOCATOR_TLSF
+  return TLSFPageMemoryManagerCreate(interface, memory_pool, memory_pool_size_bytes,
+                                     page_size_bytes_log2);
+#endif
   memset(memory_pool, 0, memory_pool_size_bytes);
 
   // Allocate enough space for MAX_PAGES.
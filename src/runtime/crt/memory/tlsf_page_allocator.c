@@ -0,0 +1,315 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_page_allocator.c
+ * \brief Page allocator based on two-level segregated fit, with O(1) allocation and free.
+ *
+ * Like the page allocator, thread-safety is left to the platform.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/internal/memory/page_allocator.h>
+#include <tvm/runtime/crt/logging.h>
+#include <tvm/runtime/crt/platform.h>
+
+#if TVM_CRT_TLSF_SL_COUNT_LOG2 < 0 || TVM_CRT_TLSF_SL_COUNT_LOG2 > 5
+#error "TVM_CRT_TLSF_SL_COUNT_LOG2 must be in [0, 5], so that a second-level bitmap fits 32 bits"
+#endif
+
+/*! \brief Index of the most significant set bit of x, which must be non-zero. */
+static inline uint32_t TLSF_Fls(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 31 - __builtin_clz(x);
+#else
+  uint32_t bit = 0;
+  while (x >>= 1) {
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/*! \brief Index of the least significant set bit of x, which must be non-zero. */
+static inline uint32_t TLSF_Ffs(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(x);
+#else
+  uint32_t bit = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/*! \brief Find the free list (fl, sl) holding the blocks of num_pages pages. */
+static void TLSF_Mapping(uint32_t num_pages, uint32_t* fl, uint32_t* sl) {
+  if (num_pages < TLSF_SL_COUNT) {
+    *fl = 0;
+    *sl = num_pages;
+  } else {
+    uint32_t msb = TLSF_Fls(num_pages);
+    *fl = msb - TVM_CRT_TLSF_SL_COUNT_LOG2 + 1;
+    *sl = (num_pages >> (msb - TVM_CRT_TLSF_SL_COUNT_LOG2)) ^ TLSF_SL_COUNT;
+  }
+}
+
+static void TLSF_SetBlock(TLSFMemoryManager* mgr, uint32_t begin, uint32_t num_pages,
+                          bool is_free) {
+  mgr->pages[begin].num_pages = num_pages;
+  mgr->pages[begin].is_free = is_free;
+  mgr->pages[begin + num_pages - 1].head = begin;
+}
+
+static void TLSF_Insert(TLSFMemoryManager* mgr, uint32_t begin) {
+  uint32_t fl, sl;
+  TLSF_Mapping(mgr->pages[begin].num_pages, &fl, &sl);
+  uint32_t* list = mgr->free_lists + fl * TLSF_SL_COUNT + sl;
+  mgr->pages[begin].prev_free = TLSF_NO_PAGE;
+  mgr->pages[begin].next_free = *list;
+  if (*list != TLSF_NO_PAGE) {
+    mgr->pages[*list].prev_free = begin;
+  }
+  *list = begin;
+  mgr->sl_bitmap[fl] |= 1u << sl;
+  mgr->fl_bitmap |= 1u << fl;
+}
+
+static void TLSF_Remove(TLSFMemoryManager* mgr, uint32_t begin) {
+  uint32_t fl, sl;
+  TLSF_Mapping(mgr->pages[begin].num_pages, &fl, &sl);
+  uint32_t* list = mgr->free_lists + fl * TLSF_SL_COUNT + sl;
+  uint32_t prev = mgr->pages[begin].prev_free;
+  uint32_t next = mgr->pages[begin].next_free;
+  if (prev != TLSF_NO_PAGE) {
+    mgr->pages[prev].next_free = next;
+  } else {
+    *list = next;
+  }
+  if (next != TLSF_NO_PAGE) {
+    mgr->pages[next].prev_free = prev;
+  }
+  if (*list == TLSF_NO_PAGE) {
+    mgr->sl_bitmap[fl] &= ~(1u << sl);
+    if (mgr->sl_bitmap[fl] == 0) {
+      mgr->fl_bitmap &= ~(1u << fl);
+    }
+  }
+}
+
+/*!
+ * \brief Find a free block of at least num_pages pages.
+ *
+ * The request is rounded up to the next free list, so that any block of the first non-empty list
+ * at or above it fits, without walking the list. Only when there is no such list, the list holding
+ * the requested size itself is searched, so that the last large blocks remain usable.
+ *
+ * \return The first page of the block, or TLSF_NO_PAGE when no block is large enough.
+ */
+static uint32_t TLSF_FindFreeBlock(TLSFMemoryManager* mgr, uint32_t num_pages) {
+  uint32_t rounded = num_pages;
+  if (rounded >= TLSF_SL_COUNT) {
+    rounded += (1u << (TLSF_Fls(rounded) - TVM_CRT_TLSF_SL_COUNT_LOG2)) - 1;
+  }
+  uint32_t fl, sl;
+  TLSF_Mapping(rounded, &fl, &sl);
+  if (fl < mgr->fl_count) {
+    uint32_t sl_map = mgr->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+      uint32_t fl_map = mgr->fl_bitmap & (~0u << (fl + 1));
+      if (fl_map != 0) {
+        fl = TLSF_Ffs(fl_map);
+        sl_map = mgr->sl_bitmap[fl];
+      }
+    }
+    if (sl_map != 0) {
+      return mgr->free_lists[fl * TLSF_SL_COUNT + TLSF_Ffs(sl_map)];
+    }
+  }
+
+  TLSF_Mapping(num_pages, &fl, &sl);
+  uint32_t block = mgr->free_lists[fl * TLSF_SL_COUNT + sl];
+  while (block != TLSF_NO_PAGE && mgr->pages[block].num_pages < num_pages) {
+    block = mgr->pages[block].next_free;
+  }
+  return block;
+}
+
+/*!
+ * \brief Allocate memory from manager
+ * \param interface Pointer to this structure.
+ * \param num_bytes The size of memory.
+ * \param dev Execution device that will be used with the allocated memory. Must be {kDLCPU, 0}.
+ * \param out_ptr A pointer to which is written a pointer to the newly-allocated memory.
+ * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TLSFPageMemoryManager_Allocate(MemoryManagerInterface* interface, size_t num_bytes,
+                                               DLDevice dev, void** out_ptr) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+
+  *out_ptr = 0;
+  size_t page_size_bytes = ((size_t)1) << mgr->page_size_bytes_log2;
+  size_t npage = (num_bytes + page_size_bytes - 1) >> mgr->page_size_bytes_log2;
+  if (npage == 0) {
+    npage = 1;
+  }
+  uint32_t begin = npage <= mgr->num_pages ? TLSF_FindFreeBlock(mgr, npage) : TLSF_NO_PAGE;
+  if (begin == TLSF_NO_PAGE) {
+#if TVM_CRT_DEBUG > 1
+    TVMLogf("insufficient memory, npage=%zu, total=%" PRIu32, npage, mgr->num_pages);
+#endif
+    return kTvmErrorPlatformNoMemory;
+  }
+
+  TLSF_Remove(mgr, begin);
+  uint32_t block_pages = mgr->pages[begin].num_pages;
+  if (block_pages > npage) {
+    // return the tail of the block to the free lists. The block following it is in use, otherwise
+    // it would have been coalesced with this block when freed.
+    uint32_t rest = begin + npage;
+    TLSF_SetBlock(mgr, rest, block_pages - npage, true);
+    TLSF_Insert(mgr, rest);
+  }
+  TLSF_SetBlock(mgr, begin, npage, false);
+  *out_ptr = mgr->memory_pool + (((size_t)begin) << mgr->page_size_bytes_log2);
+  mgr->interface.vleak_size++;
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("allocate: addr=%p, start=%" PRIu32 "/%" PRIu32 ", npage=%zu, vleak=%d\n", *out_ptr,
+          begin, mgr->num_pages, npage, mgr->interface.vleak_size);
+#endif  // TVM_CRT_DEBUG
+  return kTvmErrorNoError;
+}
+
+/*!
+ * \brief Free the memory, coalescing it with the free blocks next to it.
+ * \param interface Pointer to this structure.
+ * \param ptr A pointer returned from TVMPlatformMemoryAllocate which should be free'd.
+ * \param dev Execution device passed to TVMPlatformMemoryAllocate. Fixed to {kDLCPU, 0}.
+ * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TLSFPageMemoryManager_Free(MemoryManagerInterface* interface, void* ptr,
+                                           DLDevice dev) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+
+  uintptr_t offset = (uintptr_t)ptr - (uintptr_t)mgr->memory_pool;
+  if ((uint8_t*)ptr < mgr->memory_pool ||
+      (offset >> mgr->page_size_bytes_log2) >= mgr->num_pages ||
+      (offset & ((((uintptr_t)1) << mgr->page_size_bytes_log2) - 1)) != 0) {
+    return kTvmErrorPlatformPageAllocBadFree;
+  }
+  uint32_t begin = offset >> mgr->page_size_bytes_log2;
+  if (mgr->pages[begin].num_pages == 0 || mgr->pages[begin].is_free) {
+    return kTvmErrorPlatformPageAllocBadFree;
+  }
+
+  uint32_t num_pages = mgr->pages[begin].num_pages;
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("release: addr=%p, start=%" PRIu32 "/%" PRIu32 ", npage=%" PRIu32 ", vleak=%d", ptr,
+          begin, mgr->num_pages, num_pages, mgr->interface.vleak_size - 1);
+#endif  // TVM_CRT_DEBUG
+  uint32_t next = begin + num_pages;
+  if (next < mgr->num_pages && mgr->pages[next].is_free) {
+    TLSF_Remove(mgr, next);
+    num_pages += mgr->pages[next].num_pages;
+    mgr->pages[next].num_pages = 0;
+    mgr->pages[next].is_free = false;
+  }
+  if (begin > 0) {
+    uint32_t prev = mgr->pages[begin - 1].head;
+    if (mgr->pages[prev].is_free) {
+      TLSF_Remove(mgr, prev);
+      num_pages += mgr->pages[prev].num_pages;
+      mgr->pages[begin].num_pages = 0;
+      begin = prev;
+    }
+  }
+  TLSF_SetBlock(mgr, begin, num_pages, true);
+  TLSF_Insert(mgr, begin);
+  mgr->interface.vleak_size--;
+  return kTvmErrorNoError;
+}
+
+/*! \brief Bytes of metadata needed to manage num_pages pages, besides the pages themselves. */
+static size_t TLSF_MetadataBytes(size_t num_pages) {
+  uint32_t fl, sl;
+  TLSF_Mapping(num_pages, &fl, &sl);
+  return sizeof(TLSFMemoryManager) + (fl + 1) * (TLSF_SL_COUNT + 1) * sizeof(uint32_t) +
+         num_pages * sizeof(TLSFPage);
+}
+
+tvm_crt_error_t TLSFPageMemoryManagerCreate(MemoryManagerInterface** interface,
+                                            uint8_t* memory_pool, size_t memory_pool_size_bytes,
+                                            size_t page_size_bytes_log2) {
+  memset(memory_pool, 0, memory_pool_size_bytes);
+
+  size_t page_size_bytes = ((size_t)1) << page_size_bytes_log2;
+  size_t num_pages = 0;
+  if (memory_pool_size_bytes > sizeof(TLSFMemoryManager)) {
+    num_pages = (memory_pool_size_bytes - sizeof(TLSFMemoryManager)) /
+                (page_size_bytes + sizeof(TLSFPage));
+  }
+  if (num_pages >= TLSF_NO_PAGE) {
+    num_pages = TLSF_NO_PAGE - 1;
+  }
+  // Leave room for the free lists, which grow with the number of pages.
+  while (num_pages > 0 && (num_pages << page_size_bytes_log2) + TLSF_MetadataBytes(num_pages) >
+                              memory_pool_size_bytes) {
+    num_pages--;
+  }
+  if (num_pages == 0) {
+    return kTvmErrorPlatformNoMemory;
+  }
+
+  uint8_t* metadata_cursor = memory_pool + (num_pages << page_size_bytes_log2);
+  TLSFMemoryManager* manager = (TLSFMemoryManager*)metadata_cursor;
+  metadata_cursor += sizeof(TLSFMemoryManager);
+  *interface = &manager->interface;
+  manager->interface.Allocate = TLSFPageMemoryManager_Allocate;
+  manager->interface.Free = TLSFPageMemoryManager_Free;
+  manager->memory_pool = memory_pool;
+  manager->page_size_bytes_log2 = page_size_bytes_log2;
+  manager->num_pages = num_pages;
+
+  uint32_t fl, sl;
+  TLSF_Mapping(num_pages, &fl, &sl);
+  manager->fl_count = fl + 1;
+  manager->fl_bitmap = 0;
+  manager->sl_bitmap = (uint32_t*)metadata_cursor;
+  metadata_cursor += sizeof(uint32_t) * manager->fl_count;
+  manager->free_lists = (uint32_t*)metadata_cursor;
+  metadata_cursor += sizeof(uint32_t) * manager->fl_count * TLSF_SL_COUNT;
+  for (uint32_t idx = 0; idx < manager->fl_count * TLSF_SL_COUNT; idx++) {
+    manager->free_lists[idx] = TLSF_NO_PAGE;
+  }
+  manager->pages = (TLSFPage*)metadata_cursor;
+
+  // The whole pool starts as a single free block.
+  TLSF_SetBlock(manager, 0, num_pages, true);
+  TLSF_Insert(manager, 0);
+  return kTvmErrorNoError;
+}
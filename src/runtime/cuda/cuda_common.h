@@ -27,9 +27,10 @@
 #include <cuda_runtime.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <mutex>
 #include <string>
-
-#include "../workspace_pool.h"
+#include <unordered_map>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
@@ -51,15 +52,91 @@ namespace runtime {
         << "CUDA: " << cudaGetErrorString(e);                 \
   }
 
+/*!
+ * \brief Pinned host buffers to stage the copies from pageable host memory to the device.
+ *
+ * The copy is split into chunks which are staged alternately in two pinned buffers, so that
+ * the memcpy of a chunk on the host overlaps with the DMA of the previous one. Like cudaMemcpy
+ * from pageable memory, the copy returns once the source is consumed, while the DMA of the
+ * last chunks may still be running on the stream.
+ */
+class CUDAPinnedStagingPool {
+ public:
+  ~CUDAPinnedStagingPool();
+  /*!
+   * \brief Copy from pageable host memory to the device.
+   * \param from The source in pageable host memory.
+   * \param to The destination on the current device.
+   * \param size The size in bytes.
+   * \param device_id The id of the current device.
+   * \param stream The stream to copy on.
+   */
+  void CopyToDevice(const void* from, void* to, size_t size, int device_id, cudaStream_t stream);
+
+ private:
+  struct Buffer {
+    void* data{nullptr};
+    // recorded after the DMA reading the buffer, on a stream of device_id
+    cudaEvent_t event{nullptr};
+    int device_id{-1};
+    bool in_use{false};
+  };
+  Buffer buffers_[2];
+  size_t next_{0};
+};
+
+/*!
+ * \brief Workspace pool shared by the threads, which tracks the stream using each workspace.
+ *
+ * A freed workspace is tagged with the stream it was freed on, and an event is recorded on that
+ * stream. The workspace is reused right away on the same stream, as the stream orders its work,
+ * and on another stream only once the event completed. So executors running on different streams
+ * of a device share the workspaces without serializing each other.
+ */
+class CUDAStreamWorkspacePool {
+ public:
+  /*!
+   * \brief Allocate a workspace.
+   * \param device_id The id of the device.
+   * \param size The size in bytes.
+   * \param stream The stream the workspace is used on.
+   * \return The workspace.
+   */
+  void* Alloc(int device_id, size_t size, cudaStream_t stream);
+  /*!
+   * \brief Free a workspace, once the work using it is enqueued on the stream.
+   * \param device_id The id of the device.
+   * \param ptr The workspace.
+   * \param stream The stream the workspace was used on.
+   */
+  void Free(int device_id, void* ptr, cudaStream_t stream);
+
+ private:
+  struct Entry {
+    void* data{nullptr};
+    size_t size{0};
+    // the stream that last used the workspace
+    cudaStream_t stream{nullptr};
+    // recorded on the stream when the workspace is freed
+    cudaEvent_t event{nullptr};
+  };
+  /*! \brief Release a free workspace to the device. */
+  void Release(const Entry& entry);
+
+  std::mutex mutex_;
+  /*! \brief device id => free workspaces of the device */
+  std::unordered_map<int, std::vector<Entry>> free_;
+  /*! \brief workspaces in use */
+  std::unordered_map<void*, Entry> allocated_;
+};
+
 /*! \brief Thread local workspace */
 class CUDAThreadEntry {
  public:
   /*! \brief The cuda stream */
   cudaStream_t stream{nullptr};
-  /*! \brief thread local pool*/
-  WorkspacePool pool;
-  /*! \brief constructor */
-  CUDAThreadEntry();
+  /*! \brief thread local pinned staging buffers */
+  CUDAPinnedStagingPool staging;
   // get the threadlocal workspace
   static CUDAThreadEntry* ThreadLocal();
 };
@@ -25,16 +25,51 @@
 #include <cuda_runtime.h>
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <unordered_set>
 
+#include "../../support/utils.h"
 #include "cuda_common.h"
 
 namespace tvm {
 namespace runtime {
 
+namespace {
+// The size of the chunks of the copies staged in pinned memory.
+constexpr size_t kStagingChunkSize = 4 << 20;
+// The copies from pageable memory smaller than this are left to the driver.
+constexpr size_t kMinStagedCopySize = 1 << 20;
+// The workspaces are allocated in multiples of this size.
+constexpr size_t kWorkspacePageSize = 4 << 10;
+
+/*! \brief Whether to stage the copies from pageable host memory in pinned buffers. */
+bool UsePinnedStaging() {
+  static bool use = !support::BoolEnvironmentVar("TVM_CUDA_DISABLE_PINNED_STAGING");
+  return use;
+}
+
+/*! \brief Whether the pointer is pageable host memory, unknown to CUDA. */
+bool IsPageable(const void* ptr) {
+#if CUDART_VERSION >= 10000
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    // clear the error
+    cudaGetLastError();
+    return false;
+  }
+  return attr.type == cudaMemoryTypeUnregistered;
+#else
+  return false;
+#endif
+}
+}  // namespace
+
 class CUDADeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final { CUDA_CALL(cudaSetDevice(dev.device_id)); }
@@ -170,7 +205,12 @@ class CUDADeviceAPI final : public DeviceAPI {
       GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLCUDA) {
       CUDA_CALL(cudaSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      if (size >= kMinStagedCopySize && UsePinnedStaging() && IsPageable(from)) {
+        CUDAThreadEntry::ThreadLocal()->staging.CopyToDevice(from, to, size, dev_to.device_id,
+                                                             cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      }
     } else {
       LOG(FATAL) << "expect copy from/to GPU or between GPU";
     }
@@ -211,11 +251,11 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
 
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final {
-    return CUDAThreadEntry::ThreadLocal()->pool.AllocWorkspace(dev, size);
+    return workspace_pool_.Alloc(dev.device_id, size, CUDAThreadEntry::ThreadLocal()->stream);
   }
 
   void FreeWorkspace(Device dev, void* data) final {
-    CUDAThreadEntry::ThreadLocal()->pool.FreeWorkspace(dev, data);
+    workspace_pool_.Free(dev.device_id, data, CUDAThreadEntry::ThreadLocal()->stream);
   }
 
   static CUDADeviceAPI* Global() {
@@ -226,6 +266,9 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
 
  private:
+  /*! \brief The workspaces of all the threads and streams */
+  CUDAStreamWorkspacePool workspace_pool_;
+
   static void GPUCopy(const void* from, void* to, size_t size, cudaMemcpyKind kind,
                       cudaStream_t stream) {
     if (stream != nullptr) {
@@ -236,9 +279,111 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
 };
 
-typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
+CUDAPinnedStagingPool::~CUDAPinnedStagingPool() {
+  for (Buffer& buf : buffers_) {
+    if (buf.event != nullptr) {
+      CUDA_CALL(cudaEventSynchronize(buf.event));
+      CUDA_CALL(cudaEventDestroy(buf.event));
+    }
+    if (buf.data != nullptr) {
+      CUDA_CALL(cudaFreeHost(buf.data));
+    }
+  }
+}
+
+void CUDAPinnedStagingPool::CopyToDevice(const void* from, void* to, size_t size, int device_id,
+                                         cudaStream_t stream) {
+  for (size_t offset = 0; offset < size; offset += kStagingChunkSize) {
+    size_t chunk_size = std::min(kStagingChunkSize, size - offset);
+    Buffer& buf = buffers_[next_];
+    next_ = (next_ + 1) % 2;
+    // wait for the DMA of the previous chunk staged in the buffer
+    if (buf.in_use) {
+      CUDA_CALL(cudaEventSynchronize(buf.event));
+      buf.in_use = false;
+    }
+    if (buf.data == nullptr) {
+      CUDA_CALL(cudaHostAlloc(&buf.data, kStagingChunkSize, cudaHostAllocPortable));
+    }
+    // the event must belong to the device of the stream
+    if (buf.device_id != device_id) {
+      if (buf.event != nullptr) {
+        CUDA_CALL(cudaEventDestroy(buf.event));
+      }
+      CUDA_CALL(cudaEventCreateWithFlags(&buf.event, cudaEventDisableTiming));
+      buf.device_id = device_id;
+    }
+    memcpy(buf.data, static_cast<const char*>(from) + offset, chunk_size);
+    CUDA_CALL(cudaMemcpyAsync(static_cast<char*>(to) + offset, buf.data, chunk_size,
+                              cudaMemcpyHostToDevice, stream));
+    CUDA_CALL(cudaEventRecord(buf.event, stream));
+    buf.in_use = true;
+  }
+}
+
+void* CUDAStreamWorkspacePool::Alloc(int device_id, size_t size, cudaStream_t stream) {
+  size = std::max<size_t>(1, (size + kWorkspacePageSize - 1) / kWorkspacePageSize) *
+         kWorkspacePageSize;
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Entry>& free_list = free_[device_id];
+  // the smallest free workspace which fits and is safe to use on the stream
+  auto best = free_list.end();
+  // the largest workspace too small for the request, but no longer in use on the device
+  auto too_small = free_list.end();
+  for (auto it = free_list.begin(); it != free_list.end(); ++it) {
+    bool fits = it->size >= size;
+    if (fits && best != free_list.end() && it->size >= best->size) continue;
+    if (!fits && too_small != free_list.end() && it->size <= too_small->size) continue;
+    bool ready = it->stream == stream;
+    if (!ready) {
+      cudaError_t err = cudaEventQuery(it->event);
+      if (err != cudaErrorNotReady) CUDA_CALL(err);
+      ready = err == cudaSuccess;
+    }
+    if (!ready) continue;
+    (fits ? best : too_small) = it;
+  }
+  Entry entry;
+  if (best != free_list.end()) {
+    entry = *best;
+    free_list.erase(best);
+  } else {
+    // Replace the too small workspace rather than growing the pool with another one
+    if (too_small != free_list.end()) {
+      Release(*too_small);
+      free_list.erase(too_small);
+    }
+    CUDA_CALL(cudaSetDevice(device_id));
+    CUDA_CALL(cudaMalloc(&entry.data, size));
+    entry.size = size;
+  }
+  entry.stream = stream;
+  allocated_[entry.data] = entry;
+  return entry.data;
+}
+
+void CUDAStreamWorkspacePool::Free(int device_id, void* ptr, cudaStream_t stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = allocated_.find(ptr);
+  ICHECK(it != allocated_.end()) << "trying to free things that has not been allocated";
+  Entry entry = it->second;
+  allocated_.erase(it);
+  CUDA_CALL(cudaSetDevice(device_id));
+  if (entry.event == nullptr) {
+    CUDA_CALL(cudaEventCreateWithFlags(&entry.event, cudaEventDisableTiming));
+  }
+  CUDA_CALL(cudaEventRecord(entry.event, stream));
+  entry.stream = stream;
+  free_[device_id].push_back(entry);
+}
 
-CUDAThreadEntry::CUDAThreadEntry() : pool(kDLCUDA, CUDADeviceAPI::Global()) {}
+void CUDAStreamWorkspacePool::Release(const Entry& entry) {
+  // cudaFree waits for the device to be idle, so no work can still use the workspace
+  CUDA_CALL(cudaFree(entry.data));
+  CUDA_CALL(cudaEventDestroy(entry.event));
+}
+
+typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
 
 CUDAThreadEntry* CUDAThreadEntry::ThreadLocal() { return CUDAThreadStore::Get(); }
 
@@ -252,6 +397,73 @@ TVM_REGISTER_GLOBAL("device_api.cuda_host").set_body([](TVMArgs args, TVMRetValu
   *rv = static_cast<void*>(ptr);
 });
 
+#if CUDA_VERSION >= 11020
+/*!
+ * \brief Stream ordered allocation on the stream set through SetStream.
+ *
+ * The release threshold of the device memory pool is raised so that freed memory
+ * stays in the pool across stream synchronizations instead of going back to the OS.
+ */
+TVM_REGISTER_GLOBAL("device_api.cuda.alloc_async").set_body_typed([](Device dev, int64_t nbytes) {
+  CUDA_CALL(cudaSetDevice(dev.device_id));
+  static thread_local std::unordered_set<int> configured_devices;
+  if (configured_devices.insert(dev.device_id).second) {
+    cudaMemPool_t pool;
+    CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, dev.device_id));
+    uint64_t threshold = UINT64_MAX;
+    CUDA_CALL(cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+  }
+  void* ret;
+  CUDA_CALL(cudaMallocAsync(&ret, nbytes, CUDAThreadEntry::ThreadLocal()->stream));
+  return ret;
+});
+
+TVM_REGISTER_GLOBAL("device_api.cuda.free_async").set_body_typed([](Device dev, void* ptr) {
+  CUDA_CALL(cudaSetDevice(dev.device_id));
+  CUDA_CALL(cudaFreeAsync(ptr, CUDAThreadEntry::ThreadLocal()->stream));
+});
+#endif
+
+/*!
+ * \brief Get the CUDA IPC handle of the allocation holding an NDArray, so that
+ *  other processes can open it with device_api.cuda.ipc_open_mem_handle.
+ */
+TVM_REGISTER_GLOBAL("device_api.cuda.ipc_get_mem_handle")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      NDArray arr = args[0];
+      ICHECK_EQ(arr->device.device_type, kDLCUDA) << "Only CUDA arrays have IPC handles";
+      ICHECK_EQ(arr->byte_offset, 0) << "Only whole allocations can be shared";
+      CUDA_CALL(cudaSetDevice(arr->device.device_id));
+      cudaIpcMemHandle_t handle;
+      CUDA_CALL(cudaIpcGetMemHandle(&handle, arr->data));
+      *rv = TVMByteArray{reinterpret_cast<const char*>(&handle), sizeof(handle)};
+    });
+
+/*! \brief Close the IPC mapping viewed by an NDArray opened from another process. */
+static void CUDAIpcNDArrayDeleter(Object* obj) {
+  auto* container = static_cast<NDArray::Container*>(obj);
+  CUDA_CALL(cudaSetDevice(container->dl_tensor.device.device_id));
+  CUDA_CALL(cudaIpcCloseMemHandle(container->dl_tensor.data));
+  delete container;
+}
+
+TVM_REGISTER_GLOBAL("device_api.cuda.ipc_open_mem_handle")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string handle_bytes = args[0];
+      ShapeTuple shape = args[1];
+      DLDataType dtype = args[2];
+      Device dev = args[3];
+      cudaIpcMemHandle_t handle;
+      ICHECK_EQ(handle_bytes.size(), sizeof(handle)) << "Invalid CUDA IPC handle";
+      std::memcpy(&handle, handle_bytes.data(), sizeof(handle));
+      CUDA_CALL(cudaSetDevice(dev.device_id));
+      void* data;
+      CUDA_CALL(cudaIpcOpenMemHandle(&data, handle, cudaIpcMemLazyEnablePeerAccess));
+      auto* container = new NDArray::Container(data, shape, dtype, dev);
+      container->SetDeleter(CUDAIpcNDArrayDeleter);
+      *rv = NDArray(GetObjectPtr<Object>(container));
+    });
+
 class CUDATimerNode : public TimerNode {
  public:
   virtual void Start() {
@@ -24,7 +24,9 @@
 
 #include <cuda.h>
 #include <cuda_runtime.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/trace.h>
 
 #include <array>
 #include <mutex>
@@ -118,8 +120,9 @@ class CUDAModuleNode : public runtime::ModuleNode {
     }
     return func;
   }
-  // get a global var from primary context in device_id
-  CUdeviceptr GetGlobal(int device_id, const std::string& global_name, size_t expect_nbytes) {
+  // get a global var from primary context in device_id, of any size when out_nbytes is given
+  CUdeviceptr GetGlobal(int device_id, const std::string& global_name, size_t expect_nbytes,
+                        size_t* out_nbytes = nullptr) {
     std::lock_guard<std::mutex> lock(mutex_);
     // must recheck under the lock scope
     if (module_[device_id] == nullptr) {
@@ -129,7 +132,11 @@ class CUDAModuleNode : public runtime::ModuleNode {
     size_t nbytes;
 
     CUresult result = cuModuleGetGlobal(&global, &nbytes, module_[device_id], global_name.c_str());
-    ICHECK_EQ(nbytes, expect_nbytes);
+    if (out_nbytes != nullptr) {
+      *out_nbytes = nbytes;
+    } else {
+      ICHECK_EQ(nbytes, expect_nbytes);
+    }
     if (result != CUDA_SUCCESS) {
       const char* msg;
       cuGetErrorName(result, &msg);
@@ -138,6 +145,9 @@ class CUDAModuleNode : public runtime::ModuleNode {
     return global;
   }
 
+  // whether the kernels were instrumented by the lightweight profiler
+  bool HasLWPCounters() const { return data_.find(symbol::tvm_lwp_counters) != std::string::npos; }
+
  private:
   // the binary data
   std::string data_;
@@ -185,6 +195,8 @@ class CUDAWrappedFunc {
       }
     }
     CUstream strm = static_cast<CUstream>(CUDAThreadEntry::ThreadLocal()->stream);
+    TVM_TRACE(KernelLaunch, wl.grid_dim(0) * wl.grid_dim(1) * wl.grid_dim(2),
+              wl.block_dim(0) * wl.block_dim(1) * wl.block_dim(2));
     CUresult result = cuLaunchKernel(fcache_[device_id], wl.grid_dim(0), wl.grid_dim(1),
                                      wl.grid_dim(2), wl.block_dim(0), wl.block_dim(1),
                                      wl.block_dim(2), wl.dyn_shmem_size, strm, void_args, nullptr);
@@ -246,6 +258,51 @@ class CUDAPrepGlobalBarrier {
   mutable std::array<CUdeviceptr, kMaxNumGPUs> pcache_;
 };
 
+class CUDAReadLWPCounters {
+ public:
+  CUDAReadLWPCounters(CUDAModuleNode* m, ObjectPtr<Object> sptr) : m_(m), sptr_(sptr) {}
+
+  void operator()(const TVMArgs& args, TVMRetValue* rv) const {
+    using profiling::CountNode;
+    bool reset = args[0];
+    int device_id;
+    CUDA_CALL(cudaGetDevice(&device_id));
+    size_t nbytes;
+    CUdeviceptr ptr = m_->GetGlobal(device_id, symbol::tvm_lwp_counters, 0, &nbytes);
+    // The cycles and the number of executions of each region, summed over the threads.
+    std::vector<uint64_t> counters(nbytes / sizeof(uint64_t));
+    CUDA_CALL(cudaDeviceSynchronize());
+    CUDA_DRIVER_CALL(cuMemcpyDtoH(counters.data(), ptr, nbytes));
+    if (reset) {
+      CUDA_DRIVER_CALL(cuMemsetD8(ptr, 0, nbytes));
+    }
+    int clock_rate_khz;
+    CUDA_CALL(cudaDeviceGetAttribute(&clock_rate_khz, cudaDevAttrClockRate, device_id));
+
+    Array<Map<String, ObjectRef>> calls;
+    for (size_t id = 0; id * 2 + 1 < counters.size(); ++id) {
+      int64_t cycles = static_cast<int64_t>(counters[id * 2]);
+      int64_t count = static_cast<int64_t>(counters[id * 2 + 1]);
+      if (count == 0) continue;
+      double mean_us = static_cast<double>(cycles) / count / clock_rate_khz * 1e3;
+      Map<String, ObjectRef> call;
+      call.Set("Name", String("lwp_" + std::to_string(id)));
+      call.Set("Device", String("cuda" + std::to_string(device_id)));
+      call.Set("Count", ObjectRef(make_object<CountNode>(count)));
+      call.Set("Cycles", ObjectRef(make_object<CountNode>(cycles)));
+      call.Set("Duration (us)", ObjectRef(make_object<profiling::DurationNode>(mean_us)));
+      calls.push_back(call);
+    }
+    *rv = calls;
+  }
+
+ private:
+  // internal module
+  CUDAModuleNode* m_;
+  // the resource holder
+  ObjectPtr<Object> sptr_;
+};
+
 PackedFunc CUDAModuleNode::GetFunction(const std::string& name,
                                        const ObjectPtr<Object>& sptr_to_self) {
   ICHECK_EQ(sptr_to_self.get(), this);
@@ -253,6 +310,10 @@ PackedFunc CUDAModuleNode::GetFunction(const std::string& name,
   if (name == symbol::tvm_prepare_global_barrier) {
     return PackedFunc(CUDAPrepGlobalBarrier(this, sptr_to_self));
   }
+  if (name == symbol::tvm_lwp_read_counters) {
+    if (!HasLWPCounters()) return PackedFunc();
+    return PackedFunc(CUDAReadLWPCounters(this, sptr_to_self));
+  }
   auto it = fmap_.find(name);
   if (it == fmap_.end()) return PackedFunc();
   const FunctionInfo& info = it->second;
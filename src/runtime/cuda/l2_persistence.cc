@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file l2_persistence.cc
+ * \brief Control of the persisting accesses to the L2 cache on Ampere and later GPUs.
+ *
+ * A stream has a single access policy window: the accesses of the kernels launched on the
+ * stream to the window are likely to persist in the part of the L2 cache set aside for
+ * persisting accesses, while the other accesses stream through the rest of the cache.
+ */
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+
+#include "cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Pin a tensor in L2 for the kernels launched afterwards on the thread's stream.
+ * \param tensor The tensor to pin, or the first bytes of it when larger than the maximum window.
+ * \param hit_ratio The fraction of the window accesses which persist in L2.
+ * \return Whether the window is set, false if the device has no persisting L2 cache.
+ */
+bool SetL2PersistingWindow(DLTensor* tensor, double hit_ratio) {
+  CHECK_EQ(tensor->device.device_type, kDLCUDA)
+      << "ValueError: Only CUDA tensors can persist in L2";
+  CHECK(hit_ratio > 0.0 && hit_ratio <= 1.0)
+      << "ValueError: The L2 hit ratio must be in (0, 1], but gets " << hit_ratio;
+#if CUDART_VERSION >= 11000
+  int device_id = tensor->device.device_id;
+  CUDA_CALL(cudaSetDevice(device_id));
+  int max_persisting = 0, max_window = 0;
+  CUDA_CALL(cudaDeviceGetAttribute(&max_persisting, cudaDevAttrMaxPersistingL2CacheSize,
+                                   device_id));
+  CUDA_CALL(cudaDeviceGetAttribute(&max_window, cudaDevAttrMaxAccessPolicyWindowSize, device_id));
+  if (max_persisting == 0 || max_window == 0) return false;
+
+  size_t nbytes = GetDataSize(*tensor);
+  size_t window = std::min(nbytes, static_cast<size_t>(max_window));
+  size_t persisting = std::min(window, static_cast<size_t>(max_persisting));
+  CUDA_CALL(cudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, persisting));
+
+  cudaStreamAttrValue attr;
+  attr.accessPolicyWindow.base_ptr = static_cast<char*>(tensor->data) + tensor->byte_offset;
+  attr.accessPolicyWindow.num_bytes = window;
+  // A window larger than the set-aside part would thrash it, so only a part of it persists
+  attr.accessPolicyWindow.hitRatio =
+      static_cast<float>(std::min(hit_ratio, static_cast<double>(persisting) / window));
+  attr.accessPolicyWindow.hitProp = cudaAccessPropertyPersisting;
+  attr.accessPolicyWindow.missProp = cudaAccessPropertyStreaming;
+  CUDA_CALL(cudaStreamSetAttribute(CUDAThreadEntry::ThreadLocal()->stream,
+                                   cudaStreamAttributeAccessPolicyWindow, &attr));
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*!
+ * \brief Clear the window of the thread's stream, and demote the persisting lines of the device
+ *  to normal ones.
+ * \param dev The device.
+ */
+void ResetL2Persisting(Device dev) {
+#if CUDART_VERSION >= 11000
+  CUDA_CALL(cudaSetDevice(dev.device_id));
+  int max_persisting = 0;
+  CUDA_CALL(cudaDeviceGetAttribute(&max_persisting, cudaDevAttrMaxPersistingL2CacheSize,
+                                   dev.device_id));
+  if (max_persisting == 0) return;
+  cudaStreamAttrValue attr;
+  attr.accessPolicyWindow.base_ptr = nullptr;
+  attr.accessPolicyWindow.num_bytes = 0;
+  attr.accessPolicyWindow.hitRatio = 0.0f;
+  attr.accessPolicyWindow.hitProp = cudaAccessPropertyNormal;
+  attr.accessPolicyWindow.missProp = cudaAccessPropertyNormal;
+  CUDA_CALL(cudaStreamSetAttribute(CUDAThreadEntry::ThreadLocal()->stream,
+                                   cudaStreamAttributeAccessPolicyWindow, &attr));
+  CUDA_CALL(cudaCtxResetPersistingL2Cache());
+#endif
+}
+
+TVM_REGISTER_GLOBAL("device_api.cuda.set_l2_persisting_window")
+    .set_body_typed([](DLTensor* tensor, double hit_ratio) {
+      return SetL2PersistingWindow(tensor, hit_ratio);
+    });
+
+TVM_REGISTER_GLOBAL("device_api.cuda.reset_l2_persisting").set_body_typed(ResetL2Persisting);
+
+}  // namespace runtime
+}  // namespace tvm
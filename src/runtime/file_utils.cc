@@ -24,11 +24,28 @@
 
 #include <dmlc/json.h>
 #include <dmlc/memory_io.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -236,6 +253,378 @@ std::string SaveParams(const Map<String, NDArray>& params) {
   return bytes;
 }
 
+namespace {
+
+size_t RoundUpOffset(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+void MappedNDArrayDeleter(Object* obj) {
+  auto* container = static_cast<NDArray::Container*>(obj);
+  // manager_ctx keeps the underlying mapping alive.
+  delete static_cast<std::shared_ptr<MappedFile>*>(container->manager_ctx);
+  delete container;
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path, bool shared_memory) {
+#ifndef _WIN32
+  int fd = shared_memory ? shm_open(path.c_str(), O_RDONLY, 0) : open(path.c_str(), O_RDONLY);
+  ICHECK_GE(fd, 0) << "Unable to open file " << path << ": " << strerror(errno);
+  struct stat st;
+  ICHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file " << path << ": " << strerror(errno);
+  size_ = static_cast<size_t>(st.st_size);
+  ICHECK_GT(size_, 0) << "Unable to map empty file " << path;
+  // Map copy-on-write, so that writes through a view never reach the file.
+  void* ptr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  ICHECK(ptr != MAP_FAILED) << "Unable to mmap file " << path << ": " << strerror(errno);
+  data_ = static_cast<char*>(ptr);
+#else
+  ICHECK(!shared_memory) << "Named shared memory is not supported on this platform";
+  // No mmap, fall back to reading the file into a page aligned buffer.
+  std::ifstream fs(path, std::ios::binary | std::ios::ate);
+  ICHECK(fs) << "Unable to open file " << path;
+  size_ = static_cast<size_t>(fs.tellg());
+  data_ = static_cast<char*>(_aligned_malloc(size_, kTVMNDArrayMmapPageAlignment));
+  ICHECK(data_ != nullptr) << "Unable to allocate " << size_ << " bytes";
+  fs.seekg(0);
+  ICHECK(fs.read(data_, size_)) << "Unable to read file " << path;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  munmap(data_, size_);
+#else
+  _aligned_free(data_);
+#endif
+}
+
+NDArray ViewMappedFile(const std::shared_ptr<MappedFile>& file, size_t offset, ShapeTuple shape,
+                       DLDataType dtype) {
+  ICHECK_EQ(offset % kAllocAlignment, 0) << "Misaligned tensor in mapped file";
+  auto* container = new NDArray::Container(file->data() + offset, shape, dtype, {kDLCPU, 0});
+  container->manager_ctx = new std::shared_ptr<MappedFile>(file);
+  container->SetDeleter(MappedNDArrayDeleter);
+  NDArray arr(GetObjectPtr<Object>(container));
+  ICHECK_LE(offset + GetDataSize(*arr.operator->()), file->size())
+      << "Tensor out of the bounds of the mapped file";
+  return arr;
+}
+
+namespace {
+
+/*!
+ * \brief Write parameters in the memory mappable layout.
+ * \param params Parameters to save.
+ * \param open Called with the total size in bytes, returns the stream to write to.
+ */
+template <typename FOpen>
+void WriteParamsMmap(const Map<String, NDArray>& params, FOpen open) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Memory mapped parameters require a little endian host";
+  std::vector<std::string> names;
+  std::vector<const DLTensor*> arrays;
+  for (auto& p : params) {
+    names.push_back(p.first);
+    arrays.push_back(p.second.operator->());
+  }
+  std::vector<uint64_t> offsets(arrays.size(), 0), nbytes(arrays.size());
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    nbytes[i] = GetDataSize(*arrays[i]);
+  }
+  auto write_header = [&](std::string* header) {
+    header->clear();
+    dmlc::MemoryStringStream mstrm(header);
+    dmlc::Stream* strm = &mstrm;
+    uint64_t magic = kTVMNDArrayMmapListMagic, reserved = 0;
+    strm->Write(magic);
+    strm->Write(reserved);
+    strm->Write(names);
+    uint64_t sz = static_cast<uint64_t>(arrays.size());
+    strm->Write(sz);
+    for (size_t i = 0; i < arrays.size(); ++i) {
+      strm->Write(arrays[i]->ndim);
+      strm->Write(arrays[i]->dtype);
+      strm->WriteArray(arrays[i]->shape, arrays[i]->ndim);
+      strm->Write(offsets[i]);
+      strm->Write(nbytes[i]);
+    }
+  };
+  // The header has a fixed size, so the offsets can be filled in by a second pass.
+  std::string header;
+  write_header(&header);
+  uint64_t offset = RoundUpOffset(header.size(), kTVMNDArrayMmapPageAlignment);
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    offsets[i] = offset;
+    offset = RoundUpOffset(offset + nbytes[i], kAllocAlignment);
+  }
+  write_header(&header);
+
+  uint64_t total_size = arrays.empty() ? header.size() : offsets.back() + nbytes.back();
+  dmlc::Stream* strm = open(total_size);
+  strm->Write(header.data(), header.size());
+  uint64_t pos = header.size();
+  std::vector<char> bytes;
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    bytes.assign(offsets[i] - pos, 0);
+    strm->Write(bytes.data(), bytes.size());
+    const DLTensor* tensor = arrays[i];
+    if (tensor->device.device_type == kDLCPU && IsContiguous(*tensor)) {
+      strm->Write(static_cast<const char*>(tensor->data) + tensor->byte_offset, nbytes[i]);
+    } else {
+      bytes.resize(nbytes[i]);
+      ICHECK_EQ(TVMArrayCopyToBytes(const_cast<DLTensor*>(tensor), bytes.data(), nbytes[i]), 0)
+          << TVMGetLastError();
+      strm->Write(bytes.data(), nbytes[i]);
+    }
+    pos = offsets[i] + nbytes[i];
+  }
+}
+
+}  // namespace
+
+void SaveParamsMmap(const std::string& path, const Map<String, NDArray>& params) {
+  std::unique_ptr<SimpleBinaryFileStream> file;
+  WriteParamsMmap(params, [&](uint64_t total_size) {
+    file = std::make_unique<SimpleBinaryFileStream>(path, "wb");
+    return file.get();
+  });
+}
+
+void SaveParamsShared(const std::string& name, const Map<String, NDArray>& params) {
+#ifndef _WIN32
+  int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ICHECK_GE(fd, 0) << "Unable to create shared memory " << name << ": " << strerror(errno);
+  void* ptr = MAP_FAILED;
+  size_t size = 0;
+  std::unique_ptr<dmlc::MemoryFixedSizeStream> mstrm;
+  WriteParamsMmap(params, [&](uint64_t total_size) {
+    size = static_cast<size_t>(total_size);
+    ICHECK_EQ(ftruncate(fd, size), 0)
+        << "Unable to resize shared memory " << name << ": " << strerror(errno);
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ICHECK(ptr != MAP_FAILED) << "Unable to mmap shared memory " << name << ": "
+                              << strerror(errno);
+    mstrm = std::make_unique<dmlc::MemoryFixedSizeStream>(ptr, size);
+    return mstrm.get();
+  });
+  munmap(ptr, size);
+  close(fd);
+#else
+  LOG(FATAL) << "Named shared memory is not supported on this platform";
+#endif
+}
+
+void RemoveParamsShared(const std::string& name) {
+#ifndef _WIN32
+  shm_unlink(name.c_str());
+#endif
+}
+
+Map<String, NDArray> LoadParamsMmap(const std::string& path) {
+  return LoadParamsMapped(std::make_shared<MappedFile>(path));
+}
+
+Map<String, NDArray> LoadParamsShared(const std::string& name) {
+  return LoadParamsMapped(std::make_shared<MappedFile>(name, /*shared_memory=*/true));
+}
+
+namespace {
+
+/*! \brief Metadata of a tensor in the memory mappable layout. */
+struct MmapParamEntry {
+  std::string name;
+  DLDataType dtype;
+  std::vector<ShapeTuple::index_type> shape;
+  uint64_t offset;
+  uint64_t nbytes;
+};
+
+/*!
+ * \brief Read the header written by WriteParamsMmap.
+ * \param strm The stream positioned at the start of the file.
+ * \param file_size The size of the file, used to validate the offsets.
+ * \return The metadata of every tensor.
+ */
+std::vector<MmapParamEntry> ReadParamsMmapHeader(dmlc::Stream* strm, size_t file_size) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Memory mapped parameters require a little endian host";
+  uint64_t header, reserved;
+  ICHECK(strm->Read(&header)) << "Invalid parameters file format";
+  ICHECK(header == kTVMNDArrayMmapListMagic) << "Invalid parameters file format";
+  ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
+
+  std::vector<std::string> names;
+  ICHECK(strm->Read(&names)) << "Invalid parameters file format";
+  uint64_t sz;
+  ICHECK(strm->Read(&sz)) << "Invalid parameters file format";
+  ICHECK(static_cast<size_t>(sz) == names.size()) << "Invalid parameters file format";
+
+  std::vector<MmapParamEntry> entries(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    MmapParamEntry& entry = entries[i];
+    entry.name = names[i];
+    int ndim;
+    ICHECK(strm->Read(&ndim)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&entry.dtype)) << "Invalid parameters file format";
+    entry.shape.resize(ndim);
+    if (ndim != 0) {
+      ICHECK(strm->ReadArray(entry.shape.data(), ndim)) << "Invalid parameters file format";
+    }
+    ICHECK(strm->Read(&entry.offset)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&entry.nbytes)) << "Invalid parameters file format";
+    ICHECK_LE(entry.offset + entry.nbytes, file_size) << "Invalid parameters file format";
+    ICHECK_EQ(entry.offset % kAllocAlignment, 0) << "Invalid parameters file format";
+  }
+  return entries;
+}
+
+/*! \brief Size of the host buffer used by each thread of LoadParamsToDevice. */
+constexpr size_t kParamsReadChunkBytes = 64 << 20;
+
+/*! \brief Positional reads from a file, one instance per reading thread. */
+class FileReader {
+ public:
+  explicit FileReader(const std::string& path) : path_(path) {
+#ifndef _WIN32
+    fd_ = open(path.c_str(), O_RDONLY);
+    ICHECK_GE(fd_, 0) << "Unable to open file " << path << ": " << strerror(errno);
+#else
+    fs_.open(path, std::ios::binary);
+    ICHECK(fs_) << "Unable to open file " << path;
+#endif
+  }
+  ~FileReader() {
+#ifndef _WIN32
+    close(fd_);
+#endif
+  }
+
+  /*! \brief Read exactly size bytes at offset into data. */
+  void ReadAt(void* data, size_t size, uint64_t offset) {
+#ifndef _WIN32
+    char* ptr = static_cast<char*>(data);
+    while (size != 0) {
+      ssize_t n = pread(fd_, ptr, size, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) continue;
+      ICHECK_GT(n, 0) << "Unable to read file " << path_ << ": "
+                      << (n < 0 ? strerror(errno) : "unexpected end of file");
+      ptr += n;
+      size -= static_cast<size_t>(n);
+      offset += static_cast<uint64_t>(n);
+    }
+#else
+    fs_.seekg(static_cast<std::streamoff>(offset));
+    ICHECK(fs_.read(static_cast<char*>(data), size)) << "Unable to read file " << path_;
+#endif
+  }
+
+ private:
+  std::string path_;
+#ifndef _WIN32
+  int fd_{-1};
+#else
+  std::ifstream fs_;
+#endif
+};
+
+}  // namespace
+
+Map<String, NDArray> LoadParamsMapped(const std::shared_ptr<MappedFile>& file) {
+  dmlc::MemoryFixedSizeStream mstrm(file->data(), file->size());
+  Map<String, NDArray> params;
+  for (const MmapParamEntry& entry : ReadParamsMmapHeader(&mstrm, file->size())) {
+    NDArray arr = ViewMappedFile(file, entry.offset, ShapeTuple(entry.shape), entry.dtype);
+    ICHECK_EQ(GetDataSize(*arr.operator->()), entry.nbytes) << "Invalid parameters file format";
+    params.Set(entry.name, arr);
+  }
+  return params;
+}
+
+Map<String, NDArray> LoadParamsToDevice(const std::string& path, Device dev, int num_threads) {
+  std::vector<MmapParamEntry> entries;
+  {
+    std::ifstream fs(path, std::ios::binary | std::ios::ate);
+    ICHECK(fs) << "Unable to open file " << path;
+    size_t file_size = static_cast<size_t>(fs.tellg());
+    SimpleBinaryFileStream strm(path, "rb");
+    entries = ReadParamsMmapHeader(&strm, file_size);
+  }
+  std::vector<NDArray> arrays;
+  arrays.reserve(entries.size());
+  for (const MmapParamEntry& entry : entries) {
+    arrays.push_back(NDArray::Empty(ShapeTuple(entry.shape), entry.dtype, dev));
+    ICHECK_EQ(GetDataSize(*arrays.back().operator->()), entry.nbytes)
+        << "Invalid parameters file format";
+  }
+
+  const PackedFunc* fdirect =
+      Registry::Get(std::string("runtime.params.direct_read.") + DeviceName(dev.device_type));
+  auto read_tensor = [&](size_t i, FileReader* reader, std::vector<char>* staging) {
+    const MmapParamEntry& entry = entries[i];
+    DLTensor* tensor = const_cast<DLTensor*>(arrays[i].operator->());
+    if (entry.nbytes == 0) return;
+    if (fdirect != nullptr) {
+      bool done = (*fdirect)(path, static_cast<int64_t>(entry.offset), arrays[i]);
+      if (done) return;
+    }
+    if (dev.device_type == kDLCPU) {
+      reader->ReadAt(static_cast<char*>(tensor->data) + tensor->byte_offset, entry.nbytes,
+                     entry.offset);
+      return;
+    }
+    // Stage through a bounded host buffer, so peak host memory does not grow with the tensor.
+    DeviceAPI* api = DeviceAPI::Get(dev);
+    staging->resize(std::min<uint64_t>(entry.nbytes, kParamsReadChunkBytes));
+    for (uint64_t pos = 0; pos < entry.nbytes; pos += staging->size()) {
+      int64_t n = static_cast<int64_t>(std::min<uint64_t>(entry.nbytes - pos, staging->size()));
+      reader->ReadAt(staging->data(), n, entry.offset + pos);
+      DLTensor from{staging->data(), {kDLCPU, 0}, 1, DLDataType{kDLUInt, 8, 1}, &n, nullptr, 0};
+      DLTensor to{tensor->data, dev, 1, DLDataType{kDLUInt, 8, 1}, &n, nullptr,
+                  tensor->byte_offset + pos};
+      api->CopyDataFromTo(&from, &to, nullptr);
+      // The staging buffer is reused by the next chunk.
+      api->StreamSync(dev, nullptr);
+    }
+  };
+
+  size_t nthreads = num_threads > 0 ? static_cast<size_t>(num_threads)
+                                    : std::max(1U, std::thread::hardware_concurrency());
+  nthreads = std::max<size_t>(1, std::min(nthreads, entries.size()));
+  std::atomic<size_t> next{0};
+  std::mutex error_mutex;
+  std::string error;
+  auto worker = [&]() {
+    try {
+      FileReader reader(path);
+      std::vector<char> staging;
+      for (size_t i = next++; i < entries.size(); i = next++) {
+        read_tensor(i, &reader, &staging);
+      }
+    } catch (const std::exception& e) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error.empty()) error = e.what();
+      next = entries.size();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nthreads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ICHECK(error.empty()) << error;
+
+  Map<String, NDArray> params;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    params.Set(entries[i].name, arrays[i]);
+  }
+  return params;
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, NDArray>& params) {
   std::string s = ::tvm::runtime::SaveParams(params);
   // copy return array so it is owned by the ret value
@@ -259,5 +648,19 @@ TVM_REGISTER_GLOBAL("runtime.LoadParamsFromFile").set_body_typed([](const String
   return LoadParams(&strm);
 });
 
+TVM_REGISTER_GLOBAL("runtime.SaveParamsMmap")
+    .set_body_typed([](const Map<String, NDArray>& params, const String& path) {
+      SaveParamsMmap(path, params);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.LoadParamsMmap").set_body_typed([](const String& path) {
+  return LoadParamsMmap(path);
+});
+
+TVM_REGISTER_GLOBAL("runtime.LoadParamsToDevice")
+    .set_body_typed([](const String& path, Device dev, int num_threads) {
+      return LoadParamsToDevice(path, dev, num_threads);
+    });
+
 }  // namespace runtime
 }  // namespace tvm
@@ -27,6 +27,7 @@
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -130,6 +131,108 @@ std::string SaveParams(const Map<String, NDArray>& params);
  */
 void SaveParams(dmlc::Stream* strm, const Map<String, NDArray>& params);
 
+constexpr uint64_t kTVMNDArrayMmapListMagic = 0xF7E58D4F05049CB8;
+/*! \brief Alignment of the data region of a memory mappable parameters file. */
+constexpr size_t kTVMNDArrayMmapPageAlignment = 4096;
+/*!
+ * \brief Save parameters to a file that can be memory mapped by LoadParamsMmap.
+ *
+ * Unlike SaveParams, all the metadata is stored in a header in front of the
+ * tensor contents, and each tensor starts at an offset aligned to kAllocAlignment
+ * inside a page aligned data region.
+ * \param path The file to write to.
+ * \param params Parameters to save.
+ */
+void SaveParamsMmap(const std::string& path, const Map<String, NDArray>& params);
+/*!
+ * \brief Load parameters saved by SaveParamsMmap.
+ *
+ * The file is mapped copy-on-write, and the returned CPU NDArrays are views
+ * over the mapping, so the contents are paged in lazily and shared with every
+ * other process that maps the same file. The mapping is released once the
+ * last of the arrays is destroyed.
+ * \param path The file to load from.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsMmap(const std::string& path);
+/*!
+ * \brief Load parameters saved by SaveParamsMmap into arrays allocated on a device.
+ *
+ * Tensors are read in parallel at their offsets, through a bounded host buffer
+ * per thread, so the host never holds a copy of the whole file. If a
+ * "runtime.params.direct_read.<device>" function is registered, e.g. by the
+ * cuFile contrib for CUDA, it is tried first to read without a host copy.
+ * \param path The file to load from.
+ * \param dev The device to allocate the arrays on.
+ * \param num_threads The number of reading threads, 0 uses the hardware concurrency.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsToDevice(const std::string& path, Device dev, int num_threads = 0);
+/*!
+ * \brief Save parameters to a named shared memory object, in the layout of SaveParamsMmap.
+ *
+ * Other processes load them with LoadParamsShared, and share the pages of the
+ * object instead of each keeping its own copy of the parameters.
+ * \param name The name of the shared memory object, starting with a slash.
+ * \param params Parameters to save.
+ */
+void SaveParamsShared(const std::string& name, const Map<String, NDArray>& params);
+/*!
+ * \brief Load parameters saved by SaveParamsShared, as views over a copy-on-write mapping.
+ * \param name The name of the shared memory object.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsShared(const std::string& name);
+/*!
+ * \brief Remove the name of a shared memory object, the processes mapping it keep their views.
+ * \param name The name of the shared memory object.
+ */
+void RemoveParamsShared(const std::string& name);
+
+/*!
+ * \brief A private, copy-on-write, mapping of a whole file, unmapped on destruction.
+ *
+ * The pages are shared with every other process mapping the same file until
+ * they are written to. Without mmap the file is read into a page aligned buffer.
+ */
+class MappedFile {
+ public:
+  /*!
+   * \param path The path of the file or, with shared_memory, the name of a POSIX
+   *  shared memory object.
+   * \param shared_memory Whether to open a shared memory object instead of a file.
+   */
+  explicit MappedFile(const std::string& path, bool shared_memory = false);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  char* data_{nullptr};
+  size_t size_{0};
+};
+
+/*!
+ * \brief Wrap a range of a mapped file as a CPU NDArray, keeping the mapping alive.
+ * \param file The mapped file.
+ * \param offset The offset of the tensor contents, aligned to kAllocAlignment.
+ * \param shape The shape of the tensor.
+ * \param dtype The data type of the tensor.
+ * \return The view over the mapping.
+ */
+NDArray ViewMappedFile(const std::shared_ptr<MappedFile>& file, size_t offset, ShapeTuple shape,
+                       DLDataType dtype);
+
+/*!
+ * \brief Load parameters in the layout of SaveParamsMmap from a mapped file.
+ * \param file The mapped file.
+ * \return Map of parameter name to parameter value, viewing the mapping.
+ */
+Map<String, NDArray> LoadParamsMapped(const std::shared_ptr<MappedFile>& file);
+
 /*!
  * \brief A dmlc stream which wraps standard file operations.
  */
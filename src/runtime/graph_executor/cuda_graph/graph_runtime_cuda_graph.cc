@@ -23,6 +23,11 @@
 
 #include <tvm/runtime/registry.h>
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 #include "../../cuda/cuda_common.h"
 #include "../graph_executor.h"
 
@@ -41,13 +46,24 @@ namespace runtime {
  */
 class GraphExecutorCudaGraph : public GraphExecutor {
  public:
+  /*! \brief The default number of graphs kept by the capture cache. */
+  static constexpr size_t kDefaultGraphCacheSize = 8;
+
+  ~GraphExecutorCudaGraph() {
+    for (auto& entry : graph_cache_) {
+      CUDA_CALL(cudaGraphExecDestroy(entry.second));
+    }
+  }
+
   /*!
    * \brief Begin CUDA graph capture on stream, the stream enters capture mode.
    */
   void StartCapture() {
     const Device& dev = data_entry_[entry_id(0, 0)]->device;
 
-    TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
     TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
 
     CUDA_CALL(cudaStreamBeginCapture(static_cast<cudaStream_t>(capture_stream_),
@@ -77,6 +93,62 @@ class GraphExecutorCudaGraph : public GraphExecutor {
     LOG(INFO) << "Num of nodes in the cuda graph created using stream capture API = " << numNodes;
 
     CUDA_CALL(cudaGraphInstantiate(&cuda_graph_exec_, graph, NULL, NULL, 0));
+    CUDA_CALL(cudaGraphDestroy(graph));
+  }
+
+  /*!
+   * \brief Run the graph through the capture cache.
+   *
+   *  The graphs are keyed by the addresses and shapes of the input and output
+   *  tensors, so that several sets of buffers bound with SetInputZeroCopy and
+   *  SetOutputZeroCopy can be rotated while still launching a single graph per
+   *  run. A missing graph is captured and inserted, evicting the least recently
+   *  used graph once the cache holds cache_size graphs.
+   */
+  void RunCached() {
+    if (!warmed_up_) {
+      // Kernel modules must be loaded before capture, as the first run does.
+      GraphExecutor::Run();
+      warmed_up_ = true;
+      return;
+    }
+    std::string key = GraphKey();
+    auto it = graph_index_.find(key);
+    if (it == graph_index_.end()) {
+      StartCapture();
+      GraphExecutor::Run();
+      cudaGraph_t graph;
+      CUDA_CALL(cudaStreamEndCapture(static_cast<cudaStream_t>(capture_stream_), &graph));
+      cudaGraphExec_t graph_exec;
+      CUDA_CALL(cudaGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
+      CUDA_CALL(cudaGraphDestroy(graph));
+      graph_cache_.emplace_front(key, graph_exec);
+      it = graph_index_.emplace(std::move(key), graph_cache_.begin()).first;
+      while (graph_cache_.size() > graph_cache_size_) {
+        CUDA_CALL(cudaGraphExecDestroy(graph_cache_.back().second));
+        graph_index_.erase(graph_cache_.back().first);
+        graph_cache_.pop_back();
+      }
+    } else {
+      graph_cache_.splice(graph_cache_.begin(), graph_cache_, it->second);
+    }
+    cudaStream_t stream = static_cast<cudaStream_t>(capture_stream_);
+    CUDA_CALL(cudaGraphLaunch(it->second->second, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+  }
+
+  /*!
+   * \brief Set the number of graphs kept by the capture cache.
+   * \param cache_size The maximum number of cached graphs.
+   */
+  void SetGraphCacheSize(int cache_size) {
+    ICHECK_GT(cache_size, 0) << "The CUDA graph cache must hold at least one graph";
+    graph_cache_size_ = cache_size;
+    while (graph_cache_.size() > graph_cache_size_) {
+      CUDA_CALL(cudaGraphExecDestroy(graph_cache_.back().second));
+      graph_index_.erase(graph_cache_.back().first);
+      graph_cache_.pop_back();
+    }
   }
 
   /*!
@@ -87,10 +159,40 @@ class GraphExecutorCudaGraph : public GraphExecutor {
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self);
 
  private:
+  /*! \brief Build the key of the current input and output buffers. */
+  std::string GraphKey() const {
+    std::string key;
+    auto append = [&key](const DLTensor* tensor) {
+      key.append(reinterpret_cast<const char*>(&tensor->data), sizeof(tensor->data));
+      key.append(reinterpret_cast<const char*>(tensor->shape), sizeof(int64_t) * tensor->ndim);
+    };
+    // The zero copy buffers are bound to the arguments of the operators.
+    for (uint32_t nid : input_nodes_) {
+      uint32_t eid = entry_id(nid, 0);
+      const auto& args = input_dltensors_[eid];
+      append(args.empty() ? data_entry_[eid].operator->() : args[0]);
+    }
+    for (const NodeEntry& output : outputs_) {
+      uint32_t eid = entry_id(output);
+      const auto& args = output_dltensors_[eid];
+      append(args.empty() ? data_entry_[eid].operator->() : args[0]);
+    }
+    return key;
+  }
+
   /*! \brief The Cuda stream on which to capture a CUDA graph. */
-  TVMStreamHandle capture_stream_;
+  TVMStreamHandle capture_stream_{nullptr};
   /*! \brief The captured CUDA graph will be instantiated to this. */
   cudaGraphExec_t cuda_graph_exec_;
+  /*! \brief Whether the graph ran once, loading the kernel modules. */
+  bool warmed_up_{false};
+  /*! \brief The cached graphs, most recently used first. */
+  std::list<std::pair<std::string, cudaGraphExec_t>> graph_cache_;
+  /*! \brief The cached graphs by key. */
+  std::unordered_map<std::string, std::list<std::pair<std::string, cudaGraphExec_t>>::iterator>
+      graph_index_;
+  /*! \brief The maximum number of cached graphs. */
+  size_t graph_cache_size_{kDefaultGraphCacheSize};
 };
 
 PackedFunc GraphExecutorCudaGraph::GetFunction(const std::string& name,
@@ -103,6 +205,12 @@ PackedFunc GraphExecutorCudaGraph::GetFunction(const std::string& name,
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartCapture(); });
   } else if (name == "end_capture") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->EndCapture(); });
+  } else if (name == "run_cuda_graph_cached") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->RunCached(); });
+  } else if (name == "set_cuda_graph_cache_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetGraphCacheSize(args[0]);
+    });
   } else {
     return GraphExecutor::GetFunction(name, sptr_to_self);
   }
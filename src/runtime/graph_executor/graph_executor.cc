@@ -22,6 +22,7 @@
  */
 #include "graph_executor.h"
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/runtime/data_type.h>
@@ -31,18 +32,25 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../file_utils.h"
 #include "../texture.h"
+#include "graph_executor_async.h"
 
 namespace tvm {
 namespace runtime {
@@ -53,18 +61,384 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
   return align;
 }
 constexpr auto Is2DStorage = IsTextureStorage;
+
+/*! \brief Append the fields of a graph in the binary format to a buffer. */
+class BinaryGraphWriter {
+ public:
+  explicit BinaryGraphWriter(std::string* out) : out_(out) {}
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+    out_->append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <typename T>
+  void Write(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+    Write(static_cast<uint32_t>(values.size()));
+    out_->append(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+  }
+  void Write(const std::string& value) {
+    Write(static_cast<uint32_t>(value.size()));
+    out_->append(value);
+  }
+
+ private:
+  std::string* out_;
+};
+
+/*! \brief Read the fields of a graph in the binary format, in order, from a flat buffer. */
+class BinaryGraphReader {
+ public:
+  explicit BinaryGraphReader(const std::string& data)
+      : ptr_(data.data()), end_(data.data() + data.size()) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    Take(&value, sizeof(T));
+    return value;
+  }
+  template <typename T>
+  void Read(std::vector<T>* values) {
+    values->resize(Read<uint32_t>());
+    Take(values->data(), sizeof(T) * values->size());
+  }
+  void Read(std::string* value) {
+    uint32_t size = Read<uint32_t>();
+    ICHECK_LE(size, static_cast<size_t>(end_ - ptr_)) << "truncated binary graph";
+    value->assign(ptr_, size);
+    ptr_ += size;
+  }
+  bool Done() const { return ptr_ == end_; }
+
+ private:
+  void Take(void* dst, size_t size) {
+    ICHECK_LE(size, static_cast<size_t>(end_ - ptr_)) << "truncated binary graph";
+    std::memcpy(dst, ptr_, size);
+    ptr_ += size;
+  }
+
+  const char* ptr_;
+  const char* end_;
+};
+
+/*! \brief Bits telling which optional attributes a graph in the binary format has. */
+enum BinaryGraphAttrFlag : uint32_t {
+  kHasStorageOffset = 1,
+  kHasDeviceIndex = 2,
+  kHasStorageScope = 4,
+};
 }  // namespace details
 
 /*!
  * \brief Run all the operations one by one.
  */
 void GraphExecutor::Run() {
+  if (l2_persisting_eid_ >= 0) {
+    static const PackedFunc* set_window =
+        Registry::Get("device_api.cuda.set_l2_persisting_window");
+    ICHECK(set_window != nullptr) << "ValueError: TVM is not built with USE_CUDA=ON";
+    (*set_window)(data_entry_[l2_persisting_eid_], l2_hit_ratio_);
+  }
+  if (inter_op_threads_ > 1) {
+    RunInterOp();
+    return;
+  }
+  if (weight_stream_ != nullptr) {
+    RunWeightStreaming();
+    return;
+  }
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
   }
 }
 
+void GraphExecutor::SetInterOpParallelism(int num_threads) {
+  ICHECK_GE(num_threads, 1) << "The number of inter-op threads must be positive";
+  CHECK(weight_stream_ == nullptr || num_threads == 1)
+      << "ValueError: Weight streaming runs the operators in order, without inter-op parallelism";
+  for (const Device& dev : devices_) {
+    if (dev.device_type != kDLCPU && num_threads > 1) {
+      LOG(WARNING) << "Inter-op parallelism is only supported on CPU, running sequentially";
+      num_threads = 1;
+    }
+  }
+  inter_op_threads_ = num_threads;
+  if (inter_op_threads_ > 1 && op_pending_ == nullptr) SetupInterOpGraph();
+}
+
+void GraphExecutor::SetL2PersistingInput(int index, double hit_ratio) {
+  if (index < 0) {
+    l2_persisting_eid_ = -1;
+    return;
+  }
+  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
+  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  CHECK_EQ(data_entry_[eid]->device.device_type, kDLCUDA)
+      << "ValueError: Only the inputs on CUDA devices can persist in L2";
+  CHECK(hit_ratio > 0.0 && hit_ratio <= 1.0)
+      << "ValueError: The L2 hit ratio must be in (0, 1], but gets " << hit_ratio;
+  l2_persisting_eid_ = static_cast<int>(eid);
+  l2_hit_ratio_ = hit_ratio;
+}
+
+GraphExecutor::WeightStream::~WeightStream() {
+  DeviceAPI* api = DeviceAPI::Get(device);
+  for (TVMStreamHandle stream : copy_streams) {
+    api->FreeStream(device, stream);
+  }
+  if (compute_stream != nullptr) api->FreeStream(device, compute_stream);
+}
+
+void GraphExecutor::EnableWeightStreaming(int num_buffers) {
+  CHECK_GE(num_buffers, 2) << "ValueError: Weight streaming needs at least 2 buffers, but gets "
+                           << num_buffers;
+  CHECK(weight_stream_ == nullptr) << "ValueError: Weight streaming is already enabled";
+  CHECK_EQ(inter_op_threads_, 1)
+      << "ValueError: Weight streaming runs the operators in order, without inter-op parallelism";
+  auto ws = std::make_unique<WeightStream>();
+  // Move the parameters planned on a GPU to pinned host memory. The parameters shared by
+  // another streaming executor are already there.
+  std::unordered_set<uint32_t> streamed;
+  for (uint32_t nid : input_nodes_) {
+    if (param_names_.count(nodes_[nid].name) == 0) continue;
+    uint32_t eid = entry_id(nid, 0);
+    DLDeviceType type = data_entry_[eid]->device.device_type;
+    if (type == kDLCUDAHost) type = kDLCUDA;
+    if (type == kDLROCMHost) type = kDLROCM;
+    if (type != kDLCUDA && type != kDLROCM) continue;
+    auto it = std::find_if(devices_.begin(), devices_.end(),
+                           [type](const Device& d) { return d.device_type == type; });
+    Device dev = it == devices_.end() ? Device{type, 0} : *it;
+    if (streamed.empty()) {
+      ws->device = dev;
+    } else {
+      CHECK(dev == ws->device) << "ValueError: Weight streaming supports a single device";
+    }
+    if (data_entry_[eid]->device.device_type == dev.device_type) {
+      Device host{dev.device_type == kDLCUDA ? kDLCUDAHost : kDLROCMHost, 0};
+      NDArray host_copy = NDArray::Empty(data_entry_[eid].Shape(), data_entry_[eid]->dtype, host);
+      host_copy.CopyFrom(data_entry_[eid]);
+      data_entry_[eid] = host_copy;
+    }
+    streamed.insert(eid);
+  }
+  CHECK(!streamed.empty()) << "ValueError: The graph has no parameter on a CUDA or ROCm device";
+  DeviceAPI* api = DeviceAPI::Get(ws->device);
+  api->StreamSync(ws->device, nullptr);
+  // Release the device storage which is only used by the streamed parameters
+  std::unordered_set<int> kept_sids;
+  for (uint32_t eid = 0; eid < num_node_entries(); ++eid) {
+    if (streamed.count(eid) == 0) kept_sids.insert(attrs_.storage_id[eid]);
+  }
+  for (uint32_t eid : streamed) {
+    int sid = attrs_.storage_id[eid];
+    if (kept_sids.count(sid) == 0) storage_pool_[sid] = NDArray();
+  }
+  // Lay out the parameters of each operator in a buffer
+  size_t buffer_bytes = 0;
+  for (uint32_t nid = 0; nid < GetNumOfNodes(); ++nid) {
+    if (nodes_[nid].op_type == "null") continue;
+    std::vector<WeightStream::Weight> weights;
+    size_t offset = 0;
+    for (size_t i = 0; i < nodes_[nid].inputs.size(); ++i) {
+      uint32_t eid = entry_id(nodes_[nid].inputs[i]);
+      if (streamed.count(eid) == 0) continue;
+      auto it = std::find_if(weights.begin(), weights.end(),
+                             [eid](const WeightStream::Weight& w) { return w.eid == eid; });
+      if (it != weights.end()) {
+        it->arg_indices.push_back(i);
+        continue;
+      }
+      weights.push_back({eid, offset, {i}});
+      size_t nbytes = GetDataSize(*data_entry_[eid].operator->());
+      offset += (nbytes + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+    }
+    if (weights.empty()) continue;
+    buffer_bytes = std::max(buffer_bytes, offset);
+    ws->nids.push_back(nid);
+    ws->weights.push_back(std::move(weights));
+  }
+  for (int i = 0; i < num_buffers; ++i) {
+    ws->buffers.push_back(NDArray::Empty({static_cast<int64_t>(buffer_bytes)},
+                                         DLDataType{kDLUInt, 8, 1}, ws->device));
+    ws->copy_streams.push_back(api->CreateStream(ws->device));
+  }
+  ws->compute_stream = api->CreateStream(ws->device);
+  weight_stream_ = std::move(ws);
+}
+
+void GraphExecutor::RunWeightStreaming() {
+  WeightStream* ws = weight_stream_.get();
+  DeviceAPI* api = DeviceAPI::Get(ws->device);
+  size_t num_buffers = ws->buffers.size();
+  size_t num_layers = ws->nids.size();
+  // Copy the parameters of the k-th streamed operator into its buffer, once the operators
+  // reading the previous content of the buffer are done. Each buffer has its own copy stream,
+  // so that an operator only waits for its own parameters.
+  auto f_fill = [&](size_t k) {
+    size_t b = k % num_buffers;
+    api->SyncStreamFromTo(ws->device, ws->compute_stream, ws->copy_streams[b]);
+    for (const WeightStream::Weight& weight : ws->weights[k]) {
+      const DLTensor* from = data_entry_[weight.eid].operator->();
+      DLTensor to = *from;
+      to.device = ws->device;
+      to.data = ws->buffers[b]->data;
+      to.byte_offset = weight.offset;
+      NDArray::CopyFromTo(from, &to, ws->copy_streams[b]);
+    }
+  };
+  api->SetStream(ws->device, ws->compute_stream);
+  for (size_t k = 0; k < std::min(num_buffers, num_layers); ++k) {
+    f_fill(k);
+  }
+  size_t next = 0;
+  for (uint32_t nid = 0; nid < op_execs_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    bool streamed = next < num_layers && ws->nids[next] == nid;
+    if (streamed) {
+      size_t b = next % num_buffers;
+      api->SyncStreamFromTo(ws->device, ws->copy_streams[b], ws->compute_stream);
+      char* base = static_cast<char*>(ws->buffers[b]->data);
+      for (const WeightStream::Weight& weight : ws->weights[next]) {
+        for (size_t i : weight.arg_indices) {
+          op_args_[nid]->args[i].data = base + weight.offset;
+        }
+      }
+    }
+    op_execs_[nid]();
+    if (streamed) {
+      if (next + num_buffers < num_layers) f_fill(next + num_buffers);
+      ++next;
+    }
+  }
+  // Order the work issued later on the default stream, e.g. reading the outputs, after the run
+  api->SyncStreamFromTo(ws->device, ws->compute_stream, nullptr);
+  api->SetStream(ws->device, nullptr);
+}
+
+void GraphExecutor::SetupInterOpGraph() {
+  uint32_t num_nodes = this->GetNumOfNodes();
+  op_successors_.assign(num_nodes, {});
+  op_num_deps_.assign(num_nodes, 0);
+  op_roots_.clear();
+  num_ops_ = 0;
+  // Order the accesses to each storage as in the sequential execution: a read after
+  // the last write, and a write after the previous write and the reads since. The
+  // accesses are tracked per byte range, as entries may live at offsets of a storage.
+  struct StorageRange {
+    size_t begin;
+    size_t end;
+    int64_t last_writer;
+    std::vector<uint32_t> readers;
+  };
+  std::unordered_map<int, std::vector<StorageRange>> ranges;
+  std::vector<uint32_t> deps;
+  auto access = [&](uint32_t eid, uint32_t nid, bool write) {
+    const DLTensor* tensor = data_entry_[eid].operator->();
+    size_t begin = tensor->byte_offset;
+    size_t end = begin + std::max<size_t>(GetDataSize(*tensor), 1);
+    StorageRange* range = nullptr;
+    for (auto& other : ranges[attrs_.storage_id[eid]]) {
+      if (other.end <= begin || end <= other.begin) continue;
+      if (other.last_writer != -1) deps.push_back(other.last_writer);
+      if (write) deps.insert(deps.end(), other.readers.begin(), other.readers.end());
+      if (other.begin == begin && other.end == end) range = &other;
+    }
+    if (range == nullptr) {
+      auto& sid_ranges = ranges[attrs_.storage_id[eid]];
+      sid_ranges.push_back({begin, end, -1, {}});
+      range = &sid_ranges.back();
+    }
+    if (write) {
+      range->last_writer = nid;
+      range->readers.clear();
+    } else {
+      range->readers.push_back(nid);
+    }
+  };
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    if (!op_execs_[nid]) continue;
+    ++num_ops_;
+    deps.clear();
+    const auto& inode = nodes_[nid];
+    for (const auto& e : inode.inputs) {
+      access(entry_id(e), nid, false);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      access(entry_id(nid, index), nid, true);
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    for (uint32_t dep : deps) {
+      if (dep == nid) continue;
+      op_successors_[dep].push_back(nid);
+      ++op_num_deps_[nid];
+    }
+    if (op_num_deps_[nid] == 0) op_roots_.push_back(nid);
+  }
+  op_pending_.reset(new std::atomic<uint32_t>[num_nodes]);
+}
+
+void GraphExecutor::RunInterOp() {
+  for (size_t nid = 0; nid < op_num_deps_.size(); ++nid) {
+    op_pending_[nid].store(op_num_deps_[nid], std::memory_order_relaxed);
+  }
+  ready_ops_ = op_roots_;
+  num_ops_done_.store(0, std::memory_order_relaxed);
+  inter_op_error_ = nullptr;
+  inter_op_failed_.store(false, std::memory_order_relaxed);
+  auto task = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+    static_cast<GraphExecutor*>(cdata)->RunInterOpTask();
+    return 0;
+  };
+  int num_task = std::min(inter_op_threads_, threading::NumThreads());
+  TVMBackendParallelLaunch(task, this, num_task);
+  if (inter_op_error_ != nullptr) std::rethrow_exception(inter_op_error_);
+}
+
+void GraphExecutor::RunInterOpTask() {
+  int64_t nid = -1;
+  while (num_ops_done_.load(std::memory_order_acquire) < num_ops_) {
+    if (nid < 0) {
+      std::lock_guard<std::mutex> lock(ready_mutex_);
+      if (!ready_ops_.empty()) {
+        nid = ready_ops_.back();
+        ready_ops_.pop_back();
+      }
+    }
+    if (nid < 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    // After a failure the remaining operators are only drained, so that every task ends.
+    if (!inter_op_failed_.load(std::memory_order_relaxed)) {
+      try {
+        op_execs_[nid]();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        if (inter_op_error_ == nullptr) inter_op_error_ = std::current_exception();
+        inter_op_failed_.store(true, std::memory_order_relaxed);
+      }
+    }
+    // Keep running the first operator made ready, and share the others.
+    uint32_t done = static_cast<uint32_t>(nid);
+    nid = -1;
+    for (uint32_t succ : op_successors_[done]) {
+      if (op_pending_[succ].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+      if (nid < 0) {
+        nid = succ;
+      } else {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_ops_.push_back(succ);
+      }
+    }
+    num_ops_done_.fetch_add(1, std::memory_order_release);
+  }
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -77,9 +451,14 @@ void GraphExecutor::Run() {
 void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module module,
                          const std::vector<Device>& devs,
                          const PackedFunc lookup_linked_param_func) {
-  std::istringstream is(graph_json);
-  dmlc::JSONReader reader(&is);
-  this->Load(&reader);
+  if (IsBinaryGraph(graph_json)) {
+    this->LoadBinary(graph_json);
+  } else {
+    std::istringstream is(graph_json);
+    dmlc::JSONReader reader(&is);
+    this->Load(&reader);
+  }
+  graph_json_ = graph_json;
   module_ = module;
   devices_ = devs;
   lookup_linked_param_ = lookup_linked_param_func;
@@ -103,6 +482,132 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
   }
 }
 
+bool GraphExecutor::IsBinaryGraph(const std::string& graph) {
+  uint64_t magic;
+  if (graph.size() < sizeof(magic)) return false;
+  std::memcpy(&magic, graph.data(), sizeof(magic));
+  return magic == kTVMGraphExecutorBinaryMagic;
+}
+
+std::string GraphExecutor::EncodeBinaryGraph(const std::string& graph_json) {
+  if (IsBinaryGraph(graph_json)) return graph_json;
+  GraphExecutor exec;
+  std::istringstream is(graph_json);
+  dmlc::JSONReader reader(&is);
+  exec.Load(&reader);
+  std::string graph_binary;
+  exec.SaveBinary(&graph_binary);
+  return graph_binary;
+}
+
+void GraphExecutor::SaveBinary(std::string* graph_binary) const {
+  details::BinaryGraphWriter writer(graph_binary);
+  writer.Write(kTVMGraphExecutorBinaryMagic);
+  // reserved
+  writer.Write(uint64_t(0));
+  writer.Write(static_cast<uint32_t>(nodes_.size()));
+  for (const Node& node : nodes_) {
+    writer.Write(node.op_type);
+    writer.Write(node.name);
+    writer.Write(node.inputs);
+    writer.Write(node.control_deps);
+    // Only operator nodes have attributes.
+    uint32_t has_param = node.op_type != "null";
+    writer.Write(has_param);
+    if (!has_param) continue;
+    writer.Write(node.param.func_name);
+    writer.Write(node.param.num_inputs);
+    writer.Write(node.param.num_outputs);
+    writer.Write(node.param.flatten_data);
+    // Sort the extra attributes to keep the encoding deterministic.
+    std::vector<std::pair<std::string, std::string>> attrs;
+    for (const auto& kv : node.param.attrs) {
+      attrs.emplace_back(kv.first, Downcast<String>(kv.second));
+    }
+    std::sort(attrs.begin(), attrs.end());
+    writer.Write(static_cast<uint32_t>(attrs.size()));
+    for (const auto& kv : attrs) {
+      writer.Write(kv.first);
+      writer.Write(kv.second);
+    }
+  }
+  writer.Write(input_nodes_);
+  writer.Write(outputs_);
+  writer.Write(node_row_ptr_);
+
+  uint32_t flags = 0;
+  if (!attrs_.storage_offset.empty()) flags |= details::kHasStorageOffset;
+  if (!attrs_.device_index.empty()) flags |= details::kHasDeviceIndex;
+  if (!attrs_.storage_scope.empty()) flags |= details::kHasStorageScope;
+  writer.Write(flags);
+  writer.Write(attrs_.storage_id);
+  if (flags & details::kHasStorageOffset) writer.Write(attrs_.storage_offset);
+  if (flags & details::kHasDeviceIndex) writer.Write(attrs_.device_index);
+  writer.Write(static_cast<uint32_t>(attrs_.dltype.size()));
+  for (const std::string& dltype : attrs_.dltype) {
+    writer.Write(dltype);
+  }
+  if (flags & details::kHasStorageScope) {
+    writer.Write(static_cast<uint32_t>(attrs_.storage_scope.size()));
+    for (const std::string& scope : attrs_.storage_scope) {
+      writer.Write(scope);
+    }
+  }
+  writer.Write(static_cast<uint32_t>(attrs_.shape.size()));
+  for (const auto& shape : attrs_.shape) {
+    writer.Write(shape);
+  }
+}
+
+void GraphExecutor::LoadBinary(const std::string& graph_binary) {
+  details::BinaryGraphReader reader(graph_binary);
+  ICHECK_EQ(reader.Read<uint64_t>(), kTVMGraphExecutorBinaryMagic) << "invalid binary graph";
+  // reserved
+  reader.Read<uint64_t>();
+  nodes_.resize(reader.Read<uint32_t>());
+  for (Node& node : nodes_) {
+    reader.Read(&node.op_type);
+    reader.Read(&node.name);
+    reader.Read(&node.inputs);
+    reader.Read(&node.control_deps);
+    if (!reader.Read<uint32_t>()) continue;
+    reader.Read(&node.param.func_name);
+    node.param.num_inputs = reader.Read<uint32_t>();
+    node.param.num_outputs = reader.Read<uint32_t>();
+    node.param.flatten_data = reader.Read<uint32_t>();
+    uint32_t num_attrs = reader.Read<uint32_t>();
+    std::string key, value;
+    for (uint32_t i = 0; i < num_attrs; ++i) {
+      reader.Read(&key);
+      reader.Read(&value);
+      node.param.attrs[key] = String(value);
+    }
+  }
+  reader.Read(&input_nodes_);
+  reader.Read(&outputs_);
+  reader.Read(&node_row_ptr_);
+
+  uint32_t flags = reader.Read<uint32_t>();
+  reader.Read(&attrs_.storage_id);
+  if (flags & details::kHasStorageOffset) reader.Read(&attrs_.storage_offset);
+  if (flags & details::kHasDeviceIndex) reader.Read(&attrs_.device_index);
+  attrs_.dltype.resize(reader.Read<uint32_t>());
+  for (std::string& dltype : attrs_.dltype) {
+    reader.Read(&dltype);
+  }
+  if (flags & details::kHasStorageScope) {
+    attrs_.storage_scope.resize(reader.Read<uint32_t>());
+    for (std::string& scope : attrs_.storage_scope) {
+      reader.Read(&scope);
+    }
+  }
+  attrs_.shape.resize(reader.Read<uint32_t>());
+  for (auto& shape : attrs_.shape) {
+    reader.Read(&shape);
+  }
+  ICHECK(reader.Done()) << "trailing data after the binary graph";
+}
+
 /*!
  * \brief Get the input index given the name of input.
  * \param name The name of the input.
@@ -293,6 +798,117 @@ void GraphExecutor::CopyOutputTo(int index, DLTensor* data_out) {
   data_entry_[eid].CopyTo(data_out);
 }
 
+GraphExecutor::IOStream::~IOStream() {
+  if (stream != nullptr) DeviceAPI::Get(device)->FreeStream(device, stream);
+}
+
+GraphExecutor::IOStream* GraphExecutor::GetIOStream(Device dev) {
+  for (const auto& io : io_streams_) {
+    if (io->device == dev) return io.get();
+  }
+  auto io = std::make_unique<IOStream>();
+  io->device = dev;
+  if (dev.device_type != kDLCPU) io->stream = DeviceAPI::Get(dev)->CreateStream(dev);
+  io_streams_.push_back(std::move(io));
+  return io_streams_.back().get();
+}
+
+void GraphExecutor::SetInputs(const Map<String, NDArray>& inputs, int64_t pack_bytes) {
+  std::vector<IOStream*> used;
+  // The inputs to pack and their entries, by stream.
+  std::vector<std::pair<IOStream*, std::vector<std::pair<NDArray, uint32_t>>>> packed;
+  for (const auto& kv : inputs) {
+    int in_idx = GetInputIndex(kv.first);
+    if (in_idx < 0) continue;
+    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    const NDArray& from = kv.second;
+    Device dev = data_entry_[eid]->device;
+    IOStream* io = GetIOStream(dev);
+    if (std::find(used.begin(), used.end(), io) == used.end()) used.push_back(io);
+    size_t nbytes = GetDataSize(*from.operator->());
+    if (from->device.device_type == kDLCPU && dev.device_type == kDLCUDA &&
+        static_cast<int64_t>(nbytes) < pack_bytes) {
+      auto it = std::find_if(packed.begin(), packed.end(),
+                             [io](const auto& entry) { return entry.first == io; });
+      if (it == packed.end()) {
+        packed.emplace_back(io, std::vector<std::pair<NDArray, uint32_t>>());
+        it = std::prev(packed.end());
+      }
+      it->second.emplace_back(from, eid);
+      continue;
+    }
+    NDArray::CopyFromTo(from.operator->(), const_cast<DLTensor*>(data_entry_[eid].operator->()),
+                        io->stream);
+  }
+  for (auto& kv : packed) {
+    IOStream* io = kv.first;
+    if (kv.second.size() == 1) {
+      const NDArray& to = data_entry_[kv.second[0].second];
+      NDArray::CopyFromTo(kv.second[0].first.operator->(), const_cast<DLTensor*>(to.operator->()),
+                          io->stream);
+      continue;
+    }
+    // Lay out the inputs in the staging buffers.
+    std::vector<size_t> offsets;
+    size_t total_bytes = 0;
+    for (const auto& input : kv.second) {
+      offsets.push_back(total_bytes);
+      size_t nbytes = GetDataSize(*input.first.operator->());
+      total_bytes += (nbytes + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+    }
+    DLDataType bytes_type{kDLUInt, 8, 1};
+    if (!io->host_staging.defined() ||
+        io->host_staging->shape[0] < static_cast<int64_t>(total_bytes)) {
+      ShapeTuple shape{static_cast<int64_t>(total_bytes)};
+      io->host_staging = NDArray::Empty(shape, bytes_type, {kDLCUDAHost, 0});
+      io->device_staging = NDArray::Empty(shape, bytes_type, io->device);
+    }
+    // The staging buffers are free, since the previous batch was synchronized.
+    char* host_data = static_cast<char*>(io->host_staging->data);
+    for (size_t i = 0; i < kv.second.size(); ++i) {
+      const NDArray& from = kv.second[i].first;
+      from.CopyToBytes(host_data + offsets[i], GetDataSize(*from.operator->()));
+    }
+    ShapeTuple packed_shape{static_cast<int64_t>(total_bytes)};
+    NDArray host_view = io->host_staging.CreateView(packed_shape, bytes_type);
+    NDArray device_view = io->device_staging.CreateView(packed_shape, bytes_type);
+    NDArray::CopyFromTo(host_view.operator->(), const_cast<DLTensor*>(device_view.operator->()),
+                        io->stream);
+    for (size_t i = 0; i < kv.second.size(); ++i) {
+      const NDArray& to = data_entry_[kv.second[i].second];
+      NDArray staged = io->device_staging.CreateView(to.Shape(), to->dtype, offsets[i]);
+      NDArray::CopyFromTo(staged.operator->(), const_cast<DLTensor*>(to.operator->()),
+                          io->stream);
+    }
+  }
+  for (IOStream* io : used) {
+    DeviceAPI::Get(io->device)->StreamSync(io->device, io->stream);
+  }
+}
+
+Array<NDArray> GraphExecutor::GetOutputs() {
+  std::vector<IOStream*> used;
+  Array<NDArray> outputs;
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    const NDArray& data = data_entry_[this->entry_id(outputs_[i])];
+    IOStream* io = GetIOStream(data->device);
+    if (std::find(used.begin(), used.end(), io) == used.end()) {
+      used.push_back(io);
+      // Order the copies after the operators, which run on the default stream.
+      if (io->stream != nullptr) {
+        DeviceAPI::Get(io->device)->SyncStreamFromTo(io->device, nullptr, io->stream);
+      }
+    }
+    NDArray out = NDArray::Empty(data.Shape(), data->dtype, {kDLCPU, 0});
+    NDArray::CopyFromTo(data.operator->(), const_cast<DLTensor*>(out.operator->()), io->stream);
+    outputs.push_back(out);
+  }
+  for (IOStream* io : used) {
+    DeviceAPI::Get(io->device)->StreamSync(io->device, io->stream);
+  }
+  return outputs;
+}
+
 /*!
  * \brief Load parameters from parameter blob.
  * \param param_blob A binary blob of parameter.
@@ -313,6 +929,33 @@ void GraphExecutor::LoadParams(dmlc::Stream* strm) {
   }
 }
 
+void GraphExecutor::LoadParamsMmap(const std::string& path) {
+  BindParams(::tvm::runtime::LoadParamsMmap(path));
+}
+
+void GraphExecutor::BindParams(const Map<String, NDArray>& params) {
+  for (const auto& p : params) {
+    param_names_.insert(p.first);
+    int in_idx = GetInputIndex(p.first);
+    if (in_idx < 0) continue;
+    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    const NDArray& entry = data_entry_[eid];
+    ShapeTuple shape = entry.Shape(), param_shape = p.second.Shape();
+    const Device& dev = p.second->device;
+    bool zero_copy = entry->device.device_type == dev.device_type &&
+                     entry->device.device_id == dev.device_id && entry.use_count() == 1 &&
+                     entry.DataType() == p.second.DataType() &&
+                     std::equal(shape.begin(), shape.end(), param_shape.begin(), param_shape.end());
+    if (!zero_copy) {
+      data_entry_[eid].CopyFrom(p.second);
+      continue;
+    }
+    data_entry_[eid] = p.second;
+    data_alignment_[eid] = details::GetDataAlignment(*p.second.operator->());
+  }
+  this->SetupOpExecs();
+}
+
 void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm) {
   uint64_t header, reserved;
   ICHECK(strm->Read(&header)) << "Invalid parameters file format";
@@ -325,19 +968,69 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
   size_t size = static_cast<size_t>(sz);
   ICHECK(size == names.size()) << "Invalid parameters file format";
   for (size_t i = 0; i < size; ++i) {
-    int in_idx = GetInputIndex(names[i]);
-    if (in_idx < 0) continue;
-    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
-    ICHECK_LT(eid, data_entry_.size());
-    ICHECK_EQ(data_entry_[eid].use_count(), 1);
-    data_entry_[eid] = other.GetInput(GetInputIndex(names[i]));
-    ICHECK_GT(data_entry_[eid].use_count(), 1);
-    const DLTensor* tmp = data_entry_[eid].operator->();
-    data_alignment_[eid] = details::GetDataAlignment(*tmp);
+    ShareParam(other, names[i]);
   }
   this->SetupOpExecs();
 }
 
+void GraphExecutor::ShareParam(const GraphExecutor& other, const std::string& name) {
+  int in_idx = GetInputIndex(name);
+  if (in_idx < 0) return;
+  uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+  ICHECK_LT(eid, data_entry_.size());
+  ICHECK_EQ(data_entry_[eid].use_count(), 1);
+  data_entry_[eid] = other.GetInput(in_idx);
+  ICHECK_GT(data_entry_[eid].use_count(), 1);
+  const DLTensor* tmp = data_entry_[eid].operator->();
+  data_alignment_[eid] = details::GetDataAlignment(*tmp);
+}
+
+ObjectPtr<GraphExecutor> GraphExecutor::Clone() const {
+  auto exec = make_object<GraphExecutor>();
+  exec->graph_json_ = graph_json_;
+  exec->nodes_ = nodes_;
+  exec->input_nodes_ = input_nodes_;
+  exec->param_names_ = param_names_;
+  exec->input_map_ = input_map_;
+  exec->output_map_ = output_map_;
+  exec->node_row_ptr_ = node_row_ptr_;
+  exec->outputs_ = outputs_;
+  exec->attrs_ = attrs_;
+  exec->module_ = module_;
+  exec->devices_ = devices_;
+  exec->op_funcs_ = op_funcs_;
+  // The linked parameters are taken from this executor, so the lookup is never needed.
+  exec->SetupStorage(this);
+  for (const std::string& name : param_names_) {
+    exec->ShareParam(*this, name);
+  }
+  exec->SetupOpExecs();
+  if (inter_op_threads_ > 1) exec->SetInterOpParallelism(inter_op_threads_);
+  if (weight_stream_ != nullptr) exec->EnableWeightStreaming(weight_stream_->buffers.size());
+  return exec;
+}
+
+void GraphExecutor::InitAsync(int num_slots) {
+  ICHECK_GT(num_slots, 0) << "The number of request slots must be positive";
+  // Drain the requests of the previous queue before replacing it.
+  async_queue_.reset();
+  std::vector<ObjectPtr<GraphExecutor>> slots;
+  for (int i = 0; i < num_slots; ++i) {
+    slots.push_back(Clone());
+  }
+  async_queue_ = std::make_shared<AsyncRequestQueue>(std::move(slots));
+}
+
+int64_t GraphExecutor::Enqueue(Map<String, NDArray> inputs) {
+  ICHECK(async_queue_ != nullptr) << "init_async must be called before enqueue";
+  return async_queue_->Enqueue(inputs);
+}
+
+Array<NDArray> GraphExecutor::Wait(int64_t request_id) {
+  ICHECK(async_queue_ != nullptr) << "init_async must be called before wait";
+  return async_queue_->Wait(request_id);
+}
+
 void GraphExecutor::LinkedNDArrayDeleter(Object* container) {
   // container is the NDArray::Container which needs to get deleted.
   // The data member points to global const memory, so it does not need deleting.
@@ -375,12 +1068,19 @@ void GraphExecutor::DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv) {
   *rv = NDArray(GetObjectPtr<Object>(container));
 }
 
-void GraphExecutor::SetupStorage() {
+void GraphExecutor::SetupStorage(const GraphExecutor* share_from) {
   // Grab saved optimization plan from graph.
   std::vector<DLDataType> vtype;
   for (const std::string& s_type : attrs_.dltype) {
     vtype.push_back(tvm::runtime::String2DLDataType(s_type));
   }
+  // The entries holding parameters, whose storage a clone shares with its source.
+  std::unordered_set<uint32_t> param_eids;
+  for (uint32_t nid : input_nodes_) {
+    if (param_names_.count(nodes_[nid].name)) param_eids.insert(entry_id(nid, 0));
+  }
+  // Whether each storage id backs any entry other than a parameter.
+  std::vector<bool> holds_activation;
 
   // Size and device type of each storage pool entry.
   std::vector<PoolEntry> pool_entry;
@@ -394,6 +1094,7 @@ void GraphExecutor::SetupStorage() {
       device_type = attrs_.device_index[i];
     }
 
+    int64_t storage_offset = attrs_.storage_offset.empty() ? 0 : attrs_.storage_offset[i];
     uint32_t sid = static_cast<uint32_t>(storage_id);
     if (sid >= pool_entry.size()) {
       pool_entry.resize(sid + 1, {-1, {0}, {}});
@@ -401,8 +1102,10 @@ void GraphExecutor::SetupStorage() {
       ICHECK(pool_entry[sid].device_type == -1 || pool_entry[sid].device_type == device_type)
           << "The same pool entry cannot be assigned to multiple devices";
     }
+    if (sid >= holds_activation.size()) holds_activation.resize(sid + 1, false);
+    if (!param_eids.count(i)) holds_activation[sid] = true;
     TVMRetValue lookup_rv;
-    {
+    if (share_from == nullptr) {
       std::vector<int64_t> shape_vec{attrs_.shape[i].begin(), attrs_.shape[i].end()};
       DLTensor template_tensor{nullptr,  Device{kDLCPU, 0}, static_cast<int>(shape_vec.size()),
                                vtype[i], shape_vec.data(),  nullptr,
@@ -425,7 +1128,7 @@ void GraphExecutor::SetupStorage() {
       size_t bits = t.bits * t.lanes;
       ICHECK(bits % 8U == 0U || bits == 1U || bits == 4U);
       int64_t bytes = ((bits + 7U) / 8U) * size;
-      pool_entry[sid].shape[0] = std::max(pool_entry[sid].shape[0], bytes);
+      pool_entry[sid].shape[0] = std::max(pool_entry[sid].shape[0], storage_offset + bytes);
       pool_entry[sid].dtype = DLDataType{kDLFloat, 32, 1};
     } else {
       if (pool_entry[sid].shape.size() == 1) {
@@ -448,7 +1151,8 @@ void GraphExecutor::SetupStorage() {
   }
 
   // Allocate the space.
-  for (const auto& pit : pool_entry) {
+  for (uint32_t sid = 0; sid < pool_entry.size(); ++sid) {
+    const PoolEntry& pit = pool_entry[sid];
     // This for loop is very fast since there are usually only a couple of
     // devices available on the same hardware.
     const auto& cit = std::find_if(devices_.begin(), devices_.end(), [&pit](const Device& d) {
@@ -457,6 +1161,11 @@ void GraphExecutor::SetupStorage() {
     Device dev = cit == devices_.end() ? devices_[0] : *cit;
     if (pit.linked_param.defined()) {
       storage_pool_.push_back(pit.linked_param);
+      linked_storage_ids_.insert(sid);
+    } else if (share_from != nullptr &&
+               (share_from->linked_storage_ids_.count(sid) || !holds_activation[sid])) {
+      storage_pool_.push_back(share_from->storage_pool_[sid]);
+      if (share_from->linked_storage_ids_.count(sid)) linked_storage_ids_.insert(sid);
     } else {
       std::vector<int64_t> shape = pit.shape;
       if (shape.size() == 1) {
@@ -478,7 +1187,9 @@ void GraphExecutor::SetupStorage() {
   for (size_t i = 0; i < data_entry_.size(); ++i) {
     int storage_id = attrs_.storage_id[i];
     ICHECK_LT(static_cast<size_t>(storage_id), storage_pool_.size());
-    data_entry_[i] = storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    uint64_t storage_offset = attrs_.storage_offset.empty() ? 0 : attrs_.storage_offset[i];
+    data_entry_[i] =
+        storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i], storage_offset);
 
     const DLTensor* tmp = data_entry_[i].operator->();
     data_alignment_[i] = details::GetDataAlignment(*tmp);
@@ -487,6 +1198,7 @@ void GraphExecutor::SetupStorage() {
 
 void GraphExecutor::SetupOpExecs() {
   op_execs_.resize(this->GetNumOfNodes());
+  op_args_.resize(this->GetNumOfNodes());
   input_dltensors_.resize(num_node_entries());
   output_dltensors_.resize(num_node_entries());
   both_output_opinput_dltensors_.resize(num_node_entries());
@@ -517,6 +1229,7 @@ void GraphExecutor::SetupOpExecs() {
 
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args);
+    op_args_[nid] = op_args;
 
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t input_eid = this->entry_id(inode.inputs[i]);
@@ -581,8 +1294,11 @@ std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphEx
 
   // Get compiled function from the module that contains both host and device
   // code.
-  tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
-  ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
+  tvm::runtime::PackedFunc& pf = op_funcs_[param.func_name];
+  if (pf == nullptr) {
+    pf = module_.GetFunction(param.func_name, true);
+    ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
+  }
 
   auto fexec = [arg_ptr, pf]() {
     TVMRetValue rv;
@@ -643,6 +1359,13 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
         *rv = this->GetOutput(out_idx);
       }
     });
+  } else if (name == "set_inputs") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetInputs(args[0], args[1]);
+    });
+  } else if (name == "get_outputs") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetOutputs(); });
   } else if (name == "get_input") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       int in_idx = 0;
@@ -695,6 +1418,13 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
     });
+  } else if (name == "load_params_mmap") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->LoadParamsMmap(args[0].operator std::string());
+    });
+  } else if (name == "clone") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = Module(this->Clone()); });
   } else if (name == "share_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       const auto& module = args[0].operator Module();
@@ -703,6 +1433,37 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
       dmlc::MemoryStringStream strm(const_cast<std::string*>(&param_blob));
       this->ShareParams(dynamic_cast<const GraphExecutor&>(*module.operator->()), &strm);
     });
+  } else if (name == "set_inter_op_parallelism") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetInterOpParallelism(args[0]);
+    });
+  } else if (name == "enable_weight_streaming") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->EnableWeightStreaming(args[0]);
+    });
+  } else if (name == "set_l2_persisting_input") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int in_idx = -1;
+      if (String::CanConvertFrom(args[0])) {
+        in_idx = this->GetInputIndex(args[0].operator String());
+        CHECK_GE(in_idx, 0) << "ValueError: " << args[0].operator String()
+                            << " is not a valid input name";
+      } else {
+        in_idx = args[0];
+      }
+      this->SetL2PersistingInput(in_idx, args[1]);
+    });
+  } else if (name == "init_async") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->InitAsync(args[0]); });
+  } else if (name == "enqueue") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->Enqueue(args[0].operator Map<String, NDArray>());
+    });
+  } else if (name == "wait") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->Wait(args[0].operator int64_t());
+    });
   } else if (name == "get_input_index") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
@@ -769,5 +1530,11 @@ TVM_REGISTER_GLOBAL("tvm.graph_executor.create").set_body([](TVMArgs args, TVMRe
   const auto& devices = GetAllDevice(args, dev_start_arg);
   *rv = GraphExecutorCreate(args[0], args[1], devices, lookup_linked_param_func);
 });
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor.encode_binary_graph")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string graph_binary = GraphExecutor::EncodeBinaryGraph(args[0]);
+      *rv = TVMByteArray{graph_binary.data(), graph_binary.size()};
+    });
 }  // namespace runtime
 }  // namespace tvm
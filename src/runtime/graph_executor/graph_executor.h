@@ -31,7 +31,10 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -42,6 +45,8 @@
 namespace tvm {
 namespace runtime {
 
+class AsyncRequestQueue;
+
 /*! \brief macro to do C API call */
 #define TVM_CCALL(func)                     \
   {                                         \
@@ -49,6 +54,9 @@ namespace runtime {
     ICHECK_EQ(ret, 0) << TVMGetLastError(); \
   }
 
+/*! \brief Magic number at the start of a graph in the binary format. */
+constexpr uint64_t kTVMGraphExecutorBinaryMagic = 0xB1A7E5F0A3C2D94E;
+
 /*! \brief operator attributes about tvm op */
 struct TVMOpParam {
   std::string func_name;
@@ -94,7 +102,7 @@ class TVM_DLL GraphExecutor : public ModuleNode {
 
   /*!
    * \brief Initialize the graph executor with graph and device.
-   * \param graph_json The execution graph.
+   * \param graph_json The execution graph, in JSON or in the binary format.
    * \param module The module containing the compiled functions for the host
    *  processor.
    * \param devs The device of the host and devices where graph nodes will be
@@ -107,6 +115,20 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void Init(const std::string& graph_json, tvm::runtime::Module module,
             const std::vector<Device>& devs, const PackedFunc lookup_linked_param_func = nullptr);
 
+  /*!
+   * \brief Encode a graph in the binary format, which loads in a single pass
+   *  over a flat buffer instead of going through the JSON parser.
+   * \param graph_json The execution graph in JSON format.
+   * \return The execution graph in the binary format.
+   */
+  static std::string EncodeBinaryGraph(const std::string& graph_json);
+
+  /*!
+   * \brief Check whether a graph is in the binary format.
+   * \param graph The execution graph.
+   */
+  static bool IsBinaryGraph(const std::string& graph);
+
   /*!
    * \brief Get the input index given the name of input.
    * \param name The name of the input.
@@ -183,6 +205,19 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_out the output data.
    */
   void CopyOutputTo(int index, DLTensor* data_out);
+  /*!
+   * \brief Set several inputs with a single synchronization. The copies are issued on a stream
+   *  of the executor, and the CPU inputs smaller than \p pack_bytes going to the same CUDA device
+   *  are packed into a single host to device transfer.
+   * \param inputs The input values by name, the names which are not inputs are ignored.
+   * \param pack_bytes The size under which inputs are packed, 0 disables packing.
+   */
+  void SetInputs(const Map<String, NDArray>& inputs, int64_t pack_bytes);
+  /*!
+   * \brief Copy all the outputs to the CPU with a single synchronization.
+   * \return The copies of the outputs.
+   */
+  Array<NDArray> GetOutputs();
   /*!
    * \brief Load parameters from binary stream
    * \param strm The input stream.
@@ -193,6 +228,23 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param param_blob A binary blob of parameter.
    */
   void LoadParams(const std::string& param_blob);
+  /*!
+   * \brief Load parameters from a file written by SaveParamsMmap.
+   *
+   * CPU inputs are bound to views over the mapped file instead of being copied
+   * into the storage pool, the other inputs are copied as in LoadParams.
+   * \param path The path to the parameter file.
+   */
+  void LoadParamsMmap(const std::string& path);
+  /*!
+   * \brief Bind parameters without copying them when possible.
+   *
+   * Inputs on the device of their parameter, with the same shape and type, are
+   * bound to the parameter itself instead of copying it into the storage pool,
+   * the other inputs are copied as in LoadParams.
+   * \param params The parameters.
+   */
+  void BindParams(const Map<String, NDArray>& params);
 
   /*!
    * \brief Share parameters from pre-existing GraphExecutor instance.
@@ -202,6 +254,80 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   void ShareParams(const GraphExecutor& other, dmlc::Stream* strm);
 
+  /*!
+   * \brief Create an executor of the same graph and module for another thread.
+   *
+   * The clone shares the parsed graph, the resolved functions, the parameters and the
+   * linked storage with this executor, and only allocates the storage of the activations.
+   * Parameters set on this executor afterwards are not seen by the clone.
+   * \return The new executor.
+   */
+  ObjectPtr<GraphExecutor> Clone() const;
+
+  /*!
+   * \brief Prepare storage sets to serve several requests at the same time.
+   * \param num_slots The number of requests that can be in flight, each one getting
+   *  its own storage set, driving thread and device streams.
+   */
+  void InitAsync(int num_slots);
+  /*!
+   * \brief Queue a request, InitAsync must have been called before.
+   * \param inputs The inputs of the request by name.
+   * \return The id of the request to pass to Wait.
+   */
+  int64_t Enqueue(Map<String, NDArray> inputs);
+  /*!
+   * \brief Wait for a queued request to finish.
+   * \param request_id The id returned by Enqueue.
+   * \return The outputs of the request, owned by the caller.
+   */
+  Array<NDArray> Wait(int64_t request_id);
+
+  /*!
+   * \brief Run independent operators concurrently on the CPU thread pool.
+   *
+   * The operators are ordered by the entries they read and write, storage reuse
+   * included, and each one is run by one of num_threads tasks of a parallel job as
+   * soon as the operators it depends on are done. The parallel loops of the kernels
+   * are nested in that job, so they run inline on the task's thread unless nested
+   * parallelism is enabled in the thread pool, in which case they share the threads
+   * left idle. num_threads thus sets the split between inter-op and intra-op threads.
+   * Graphs running on other devices than the CPU always run sequentially.
+   * \param num_threads The number of operators run at the same time, 1 runs the
+   *  operators in order on the calling thread.
+   */
+  void SetInterOpParallelism(int num_threads);
+
+  /*!
+   * \brief Pin an input or parameter in the L2 cache of a CUDA device during the runs.
+   *
+   * Before each run, the entry is set as the L2 access policy window of the stream of the
+   * calling thread, so that the kernels of the graph keep it in the persisting part of the L2
+   * cache. A stream has a single window, so a later call replaces the pinned entry. Devices
+   * without a persisting L2 cache, i.e. before Ampere, ignore the window.
+   * \param index The index of the input, or -1 to stop pinning.
+   * \param hit_ratio The fraction of the accesses to the entry which persist in L2.
+   */
+  void SetL2PersistingInput(int index, double hit_ratio);
+
+  /*!
+   * \brief Keep the parameters of a CUDA or ROCm device in pinned host memory, and stream
+   *  them to the device during the runs.
+   *
+   * The operators reading parameters take turns on num_buffers device buffers, each sized for
+   * the parameters of the largest such operator. The parameters of an operator are copied on
+   * the copy stream of its buffer while the operators before it run, so that a graph whose
+   * parameters do not fit on the device runs at the speed of the host to device link rather
+   * than falling back to the CPU. The operators then run on a stream of the executor. The
+   * device storage of the parameters is released.
+   * \param num_buffers The number of device buffers, i.e. operators whose parameters are
+   *  resident at the same time, at least 2.
+   */
+  void EnableWeightStreaming(int num_buffers);
+
+  /*! \brief Get the devices the graph is executed on. */
+  const std::vector<Device>& devices() const { return devices_; }
+
   /*!
    * \brief Get total number of nodes.
    * \return Total number of nodes.
@@ -211,6 +337,43 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::string GetNodeName(uint32_t nid) const { return nodes_[nid].name; }
 
  protected:
+  /*! \brief The stream and the packing buffers of the batched copies to and from a device. */
+  struct IOStream {
+    ~IOStream();
+    /*! \brief The device. */
+    Device device;
+    /*! \brief The stream of the copies, null on the CPU. */
+    TVMStreamHandle stream{nullptr};
+    /*! \brief The pinned host buffer the small inputs are packed in. */
+    NDArray host_staging;
+    /*! \brief The device buffer the packed inputs are transferred to. */
+    NDArray device_staging;
+  };
+  /*! \brief The state of weight streaming, see EnableWeightStreaming. */
+  struct WeightStream {
+    /*! \brief A parameter streamed for an operator. */
+    struct Weight {
+      /*! \brief The entry of the parameter, holding its host copy. */
+      uint32_t eid;
+      /*! \brief The offset of the parameter in the device buffer. */
+      size_t offset;
+      /*! \brief The indices of the operator arguments reading the parameter. */
+      std::vector<size_t> arg_indices;
+    };
+    ~WeightStream();
+    /*! \brief The device the parameters are streamed to. */
+    Device device;
+    /*! \brief The rotating device buffers. */
+    std::vector<NDArray> buffers;
+    /*! \brief The stream filling each buffer. */
+    std::vector<TVMStreamHandle> copy_streams;
+    /*! \brief The stream running the operators. */
+    TVMStreamHandle compute_stream{nullptr};
+    /*! \brief The operators reading streamed parameters, in execution order. */
+    std::vector<uint32_t> nids;
+    /*! \brief The parameters of each of these operators. */
+    std::vector<std::vector<Weight>> weights;
+  };
   // Memory pool entry.
   struct PoolEntry {
     int device_type;
@@ -312,6 +475,7 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   struct GraphAttr {
     size_t storage_num_not_alloctaed{0};
     std::vector<int> storage_id;
+    std::vector<int64_t> storage_offset;
     std::vector<int> device_index;
     std::vector<std::string> dltype;
     std::vector<std::string> storage_scope;
@@ -358,6 +522,14 @@ class TVM_DLL GraphExecutor : public ModuleNode {
           reader->Read(&shape);
           ICHECK(!reader->NextArrayItem());
           bitmask |= 4;
+        } else if (key == "storage_offset") {
+          reader->BeginArray();
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&type);
+          ICHECK_EQ(type, "list_int");
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&storage_offset);
+          ICHECK(!reader->NextArrayItem());
         } else if (key == "device_index") {
           reader->BeginArray();
           ICHECK(reader->NextArrayItem());
@@ -416,12 +588,19 @@ class TVM_DLL GraphExecutor : public ModuleNode {
     }
     ICHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
   }
+  /*! \brief Load the graph from the binary format. */
+  void LoadBinary(const std::string& graph_binary);
+  /*! \brief Save the graph in the binary format. */
+  void SaveBinary(std::string* graph_binary) const;
   /*! \brief PackedFunc to lookup a linked paramter from a local Module. */
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
   static void LinkedNDArrayDeleter(Object* container);
-  /*! \brief Setup the temporal storage */
-  void SetupStorage();
+  /*!
+   * \brief Setup the temporal storage
+   * \param share_from If given, the executor to take the parameter and linked storage from.
+   */
+  void SetupStorage(const GraphExecutor* share_from = nullptr);
   /*! \brief Setup the executors. */
   void SetupOpExecs();
   /*!
@@ -438,12 +617,30 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   std::pair<std::function<void()>, std::shared_ptr<OpArgs>> CreateTVMOp(
       const TVMOpParam& attrs, const std::vector<DLTensor>& args);
+  /*! \brief Compute the dependencies between operators used by inter-op parallelism. */
+  void SetupInterOpGraph();
+  /*! \brief Run the operators of the graph, each one once its dependencies are done. */
+  void RunInterOp();
+  /*! \brief Run the ready operators until the whole graph is done. */
+  void RunInterOpTask();
+  /*! \brief Run the operators in order while streaming the parameters to the device. */
+  void RunWeightStreaming();
+  /*! \brief Get the stream of the batched copies to and from \p dev, creating it if needed. */
+  IOStream* GetIOStream(Device dev);
+  /*!
+   * \brief Share one parameter with another executor of the same graph.
+   * \param other The executor owning the parameter.
+   * \param name The name of the parameter.
+   */
+  void ShareParam(const GraphExecutor& other, const std::string& name);
   // Get node entry index.
   uint32_t entry_id(uint32_t nid, uint32_t index) const { return node_row_ptr_[nid] + index; }
   // Get node entry index.
   uint32_t entry_id(const NodeEntry& e) const { return entry_id(e.node_id, e.index); }
   // Number of node entries.
   uint32_t num_node_entries() const { return node_row_ptr_.back(); }
+  /*! \brief The graph as given to Init, used to create the storage sets of async requests. */
+  std::string graph_json_;
   /*! \brief The graph nodes. */
   std::vector<Node> nodes_;
   /*! \brief The argument nodes. */
@@ -478,6 +675,12 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*! \brief The arguments of the operator on each node. */
+  std::vector<std::shared_ptr<OpArgs>> op_args_;
+  /*! \brief The storage ids holding linked parameters, which are never written. */
+  std::unordered_set<uint32_t> linked_storage_ids_;
+  /*! \brief The functions of the module resolved by the operators, by name. */
+  std::unordered_map<std::string, PackedFunc> op_funcs_;
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
@@ -487,6 +690,36 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * When the module does not include linked parmeters, module_lookup_linked_param_ will be nullptr.
    */
   bool module_lookup_linked_param_valid_;
+  /*! \brief The queue serving asynchronous requests, created by InitAsync. */
+  std::shared_ptr<AsyncRequestQueue> async_queue_;
+  /*! \brief The number of operators run at the same time. */
+  int inter_op_threads_{1};
+  /*! \brief The entry pinned in L2 during the runs, -1 for none. */
+  int l2_persisting_eid_{-1};
+  /*! \brief The fraction of the accesses to the pinned entry which persist in L2. */
+  double l2_hit_ratio_{1.0};
+  /*! \brief The operators depending on each node. */
+  std::vector<std::vector<uint32_t>> op_successors_;
+  /*! \brief The number of operators each node depends on. */
+  std::vector<uint32_t> op_num_deps_;
+  /*! \brief The operators without dependencies. */
+  std::vector<uint32_t> op_roots_;
+  /*! \brief The number of operators in the graph. */
+  size_t num_ops_{0};
+  /*! \brief The number of dependencies of each node not done yet in the current run. */
+  std::unique_ptr<std::atomic<uint32_t>[]> op_pending_;
+  /*! \brief The number of operators done in the current run. */
+  std::atomic<size_t> num_ops_done_{0};
+  /*! \brief The operators ready to run, not taken by a task yet. */
+  std::vector<uint32_t> ready_ops_;
+  std::mutex ready_mutex_;
+  /*! \brief The first error raised by an operator of the current run. */
+  std::exception_ptr inter_op_error_;
+  std::atomic<bool> inter_op_failed_{false};
+  /*! \brief The weight streaming state, null when the parameters stay on the device. */
+  std::unique_ptr<WeightStream> weight_stream_;
+  /*! \brief The streams of the batched copies, by device. */
+  std::vector<std::unique_ptr<IOStream>> io_streams_;
 };
 
 std::vector<Device> GetAllDevice(const TVMArgs& args, int dev_start_arg);
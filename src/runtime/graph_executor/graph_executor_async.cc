@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_executor_async.cc
+ */
+#include "graph_executor_async.h"
+
+#include <tvm/runtime/device_api.h>
+
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+AsyncRequestQueue::AsyncRequestQueue(std::vector<ObjectPtr<GraphExecutor>> slots)
+    : slots_(std::move(slots)) {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    threads_.emplace_back([this, i]() { this->RunSlot(i); });
+  }
+}
+
+AsyncRequestQueue::~AsyncRequestQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  pending_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+int64_t AsyncRequestQueue::Enqueue(Map<String, NDArray> inputs) {
+  auto request = std::make_shared<Request>();
+  request->inputs = std::move(inputs);
+  int64_t request_id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request_id = next_request_id_++;
+    requests_[request_id] = request;
+    pending_.push_back(request);
+  }
+  pending_cv_.notify_one();
+  return request_id;
+}
+
+Array<NDArray> AsyncRequestQueue::Wait(int64_t request_id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = requests_.find(request_id);
+  ICHECK(it != requests_.end()) << "Unknown or already retrieved request " << request_id;
+  std::shared_ptr<Request> request = it->second;
+  done_cv_.wait(lock, [&request] { return request->done; });
+  requests_.erase(it);
+  if (!request->error.empty()) {
+    LOG(FATAL) << "Request " << request_id << " failed: " << request->error;
+  }
+  return request->outputs;
+}
+
+void AsyncRequestQueue::RunSlot(size_t index) {
+  GraphExecutor* exec = slots_[index].get();
+  // Every slot thread issues its work on its own streams.
+  std::unordered_map<int, TVMStreamHandle> streams;
+  for (const Device& dev : exec->devices()) {
+    if (dev.device_type == kDLCPU || streams.count(dev.device_type)) continue;
+    TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+    DeviceAPI::Get(dev)->SetStream(dev, stream);
+    streams[dev.device_type] = stream;
+  }
+  while (true) {
+    std::shared_ptr<Request> request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      pending_cv_.wait(lock, [this] { return exit_ || !pending_.empty(); });
+      if (pending_.empty()) break;
+      request = pending_.front();
+      pending_.pop_front();
+    }
+    try {
+      Process(exec, streams, request.get());
+    } catch (const std::exception& err) {
+      request->error = err.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      request->done = true;
+      request->inputs = Map<String, NDArray>();
+    }
+    done_cv_.notify_all();
+  }
+  for (const Device& dev : exec->devices()) {
+    auto it = streams.find(dev.device_type);
+    if (it == streams.end()) continue;
+    DeviceAPI::Get(dev)->SetStream(dev, nullptr);
+    DeviceAPI::Get(dev)->FreeStream(dev, it->second);
+    streams.erase(it);
+  }
+}
+
+void AsyncRequestQueue::Process(GraphExecutor* exec,
+                                const std::unordered_map<int, TVMStreamHandle>& streams,
+                                Request* request) {
+  auto stream_of = [&streams](const DLTensor* from, const DLTensor* to) -> TVMStreamHandle {
+    const DLTensor* dev_tensor = from->device.device_type != kDLCPU ? from : to;
+    auto it = streams.find(dev_tensor->device.device_type);
+    return it == streams.end() ? nullptr : it->second;
+  };
+  for (const auto& kv : request->inputs) {
+    int index = exec->GetInputIndex(kv.first);
+    ICHECK_GE(index, 0) << kv.first << " is not a valid input name";
+    const DLTensor* from = kv.second.operator->();
+    DLTensor* to = const_cast<DLTensor*>(exec->GetInput(index).operator->());
+    NDArray::CopyFromTo(from, to, stream_of(from, to));
+  }
+  // Bind freshly allocated outputs so that they can be handed back without a copy.
+  Array<NDArray> outputs;
+  for (int i = 0; i < exec->NumOutputs(); ++i) {
+    NDArray internal = exec->GetOutput(i);
+    NDArray output = NDArray::Empty(internal.Shape(), internal.DataType(), internal->device);
+    exec->SetOutputZeroCopy(i, const_cast<DLTensor*>(output.operator->()));
+    outputs.push_back(output);
+  }
+  exec->Run();
+  for (const Device& dev : exec->devices()) {
+    auto it = streams.find(dev.device_type);
+    if (it != streams.end()) {
+      DeviceAPI::Get(dev)->StreamSync(dev, it->second);
+    }
+  }
+  request->outputs = outputs;
+}
+
+}  // namespace runtime
+}  // namespace tvm
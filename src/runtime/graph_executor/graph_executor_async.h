@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_executor_async.h
+ * \brief Asynchronous multi-request execution for the graph executor.
+ */
+#ifndef TVM_RUNTIME_GRAPH_EXECUTOR_GRAPH_EXECUTOR_ASYNC_H_
+#define TVM_RUNTIME_GRAPH_EXECUTOR_GRAPH_EXECUTOR_ASYNC_H_
+
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Serve requests with several storage sets ("slots") of the same graph.
+ *
+ *  Every slot is a GraphExecutor sharing its parameters with the executor that owns
+ *  the queue, and is driven by its own thread with its own stream on each device. The
+ *  input copy of one request therefore overlaps with the compute of another. Outputs
+ *  are written straight into fresh arrays handed back to the caller.
+ */
+class AsyncRequestQueue {
+ public:
+  /*!
+   * \brief Start the slot threads.
+   * \param slots The executors, one per storage set.
+   */
+  explicit AsyncRequestQueue(std::vector<ObjectPtr<GraphExecutor>> slots);
+  /*! \brief Stop the slot threads after the pending requests are served. */
+  ~AsyncRequestQueue();
+  /*!
+   * \brief Queue a request.
+   * \param inputs The inputs of the request by name.
+   * \return The id of the request to wait for.
+   */
+  int64_t Enqueue(Map<String, NDArray> inputs);
+  /*!
+   * \brief Wait for a request to finish.
+   * \param request_id The id returned by Enqueue.
+   * \return The outputs of the request.
+   */
+  Array<NDArray> Wait(int64_t request_id);
+
+ private:
+  struct Request {
+    Map<String, NDArray> inputs;
+    Array<NDArray> outputs;
+    std::string error;
+    bool done{false};
+  };
+  // The loop of the thread driving a slot.
+  void RunSlot(size_t index);
+  // Serve a request on a slot using the given stream for each device type.
+  void Process(GraphExecutor* exec, const std::unordered_map<int, TVMStreamHandle>& streams,
+               Request* request);
+
+  std::vector<ObjectPtr<GraphExecutor>> slots_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  // Signaled when a request is queued or the queue stops.
+  std::condition_variable pending_cv_;
+  // Signaled when a request is done.
+  std::condition_variable done_cv_;
+  std::deque<std::shared_ptr<Request>> pending_;
+  std::unordered_map<int64_t, std::shared_ptr<Request>> requests_;
+  int64_t next_request_id_{0};
+  bool exit_{false};
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_GRAPH_EXECUTOR_GRAPH_EXECUTOR_ASYNC_H_
@@ -30,20 +30,86 @@
 #include <tvm/runtime/registry.h>
 
 #include <iterator>
+#include <string>
 #include <vector>
 
+#include "../file_utils.h"
+
 namespace tvm {
 namespace runtime {
 
 GraphExecutorFactory::GraphExecutorFactory(
     const std::string& graph_json,
     const std::unordered_map<std::string, tvm::runtime::NDArray>& params,
-    const std::string& module_name) {
+    const std::string& module_name, const std::string& graph_binary) {
   graph_json_ = graph_json;
+  graph_binary_ = graph_binary;
   params_ = params;
   module_name_ = module_name;
 }
 
+GraphExecutorFactory::~GraphExecutorFactory() {
+  if (!shared_params_name_.empty()) {
+    RemoveParamsShared(shared_params_name_);
+  }
+}
+
+void GraphExecutorFactory::ShareParams(const std::string& name, Device dev) {
+  ICHECK(shared_params_name_.empty()) << "The params are already shared as " << shared_params_name_;
+  Map<String, NDArray> shared;
+  if (dev.device_type == kDLCPU) {
+    Map<String, NDArray> params;
+    for (const auto& kv : params_) {
+      params.Set(kv.first, kv.second);
+    }
+    SaveParamsShared(name, params);
+    // Use the shared pages in this process as well.
+    shared = LoadParamsShared(name);
+    for (const auto& kv : shared) {
+      params_[kv.first] = kv.second;
+    }
+  } else {
+    ICHECK_EQ(dev.device_type, kDLCUDA) << "Only CPU and CUDA params can be shared";
+    const PackedFunc* get_handle = Registry::Get("device_api.cuda.ipc_get_mem_handle");
+    ICHECK(get_handle != nullptr) << "CUDA IPC requires the CUDA runtime";
+    for (auto& kv : params_) {
+      NDArray arr = NDArray::Empty(kv.second.Shape(), kv.second.DataType(), dev);
+      arr.CopyFrom(kv.second);
+      kv.second = arr;
+      std::string handle = (*get_handle)(arr);
+      NDArray handle_arr = NDArray::Empty({static_cast<int64_t>(handle.size())},
+                                          DLDataType{kDLUInt, 8, 1}, {kDLCPU, 0});
+      handle_arr.CopyFromBytes(handle.data(), handle.size());
+      shared.Set(kv.first, handle_arr);
+    }
+    SaveParamsShared(name, shared);
+  }
+  shared_params_name_ = name;
+  bind_params_ = true;
+}
+
+void GraphExecutorFactory::AttachParams(const std::string& name, Device dev) {
+  Map<String, NDArray> shared = LoadParamsShared(name);
+  const PackedFunc* open_handle = nullptr;
+  if (dev.device_type != kDLCPU) {
+    ICHECK_EQ(dev.device_type, kDLCUDA) << "Only CPU and CUDA params can be shared";
+    open_handle = Registry::Get("device_api.cuda.ipc_open_mem_handle");
+    ICHECK(open_handle != nullptr) << "CUDA IPC requires the CUDA runtime";
+  }
+  for (const auto& kv : shared) {
+    auto it = params_.find(kv.first);
+    ICHECK(it != params_.end()) << "Shared param " << kv.first << " is not a param of the graph";
+    if (open_handle == nullptr) {
+      it->second = kv.second;
+      continue;
+    }
+    TVMByteArray handle{static_cast<const char*>(kv.second->data),
+                        static_cast<size_t>(kv.second.Shape()[0])};
+    it->second = (*open_handle)(handle, it->second.Shape(), it->second.DataType(), dev);
+  }
+  bind_params_ = true;
+}
+
 PackedFunc GraphExecutorFactory::GetFunction(
     const std::string& name, const tvm::runtime::ObjectPtr<tvm::runtime::Object>& sptr_to_self) {
   if (name == module_name_) {
@@ -80,11 +146,19 @@ PackedFunc GraphExecutorFactory::GetFunction(
   } else if (name == "remove_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       std::unordered_map<std::string, tvm::runtime::NDArray> empty_params{};
-      auto exec =
-          make_object<GraphExecutorFactory>(this->graph_json_, empty_params, this->module_name_);
+      auto exec = make_object<GraphExecutorFactory>(this->graph_json_, empty_params,
+                                                    this->module_name_, this->graph_binary_);
       exec->Import(this->imports_[0]);
       *rv = Module(exec);
     });
+  } else if (name == "share_params") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->ShareParams(args[0], args[1]);
+    });
+  } else if (name == "attach_params") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->AttachParams(args[0], args[1]);
+    });
   } else if (name == "cuda_graph_create") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       std::vector<Device> devices;
@@ -99,6 +173,12 @@ PackedFunc GraphExecutorFactory::GetFunction(
 }
 
 void GraphExecutorFactory::SaveToBinary(dmlc::Stream* stream) {
+  // The binary graph goes first so that loading can tell it from a JSON only module, the JSON
+  // is kept for get_graph_json and the debug executor.
+  if (graph_binary_.empty()) {
+    graph_binary_ = GraphExecutor::EncodeBinaryGraph(graph_json_);
+  }
+  stream->Write(graph_binary_);
   stream->Write(graph_json_);
   std::vector<std::string> names;
   std::vector<DLTensor*> arrays;
@@ -118,7 +198,8 @@ void GraphExecutorFactory::SaveToBinary(dmlc::Stream* stream) {
 
 Module GraphExecutorFactory::ExecutorCreate(const std::vector<Device>& devs) {
   auto exec = make_object<GraphExecutor>();
-  exec->Init(this->graph_json_, this->imports_[0], devs, PackedFunc());
+  exec->Init(graph_binary_.empty() ? graph_json_ : graph_binary_, this->imports_[0], devs,
+             PackedFunc());
   // set params
   SetParams(exec.get(), this->params_);
   return Module(exec);
@@ -164,7 +245,9 @@ Module GraphExecutorFactory::CudaGraphExecutorCreate(const std::vector<Device>&
   std::vector<TVMValue> values(args_size);
   std::vector<int> codes(args_size);
   runtime::TVMArgsSetter setter(values.data(), codes.data());
-  setter(0, this->graph_json_);
+  const std::string& graph = graph_binary_.empty() ? graph_json_ : graph_binary_;
+  TVMByteArray graph_bytes{graph.data(), graph.size()};
+  setter(0, graph_bytes);
   setter(1, this->imports_[0]);
   for (size_t i = 0; i < unpacked_devs.size(); ++i) {
     setter(i + 2, unpacked_devs[i]);
@@ -179,9 +262,14 @@ Module GraphExecutorFactory::CudaGraphExecutorCreate(const std::vector<Device>&
 Module GraphExecutorFactoryModuleLoadBinary(void* strm) {
   dmlc::Stream* stream = static_cast<dmlc::Stream*>(strm);
   std::string graph_json;
+  std::string graph_binary;
   std::unordered_map<std::string, tvm::runtime::NDArray> params;
   std::string module_name;
   ICHECK(stream->Read(&graph_json));
+  if (GraphExecutor::IsBinaryGraph(graph_json)) {
+    graph_binary = std::move(graph_json);
+    ICHECK(stream->Read(&graph_json));
+  }
   uint64_t sz;
   ICHECK(stream->Read(&sz));
   std::vector<std::string> names;
@@ -193,7 +281,7 @@ Module GraphExecutorFactoryModuleLoadBinary(void* strm) {
     params[names[i]] = temp;
   }
   ICHECK(stream->Read(&module_name));
-  auto exec = make_object<GraphExecutorFactory>(graph_json, params, module_name);
+  auto exec = make_object<GraphExecutorFactory>(graph_json, params, module_name, graph_binary);
   return Module(exec);
 }
 
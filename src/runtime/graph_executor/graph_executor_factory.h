@@ -26,6 +26,7 @@
 #define TVM_RUNTIME_GRAPH_EXECUTOR_GRAPH_EXECUTOR_FACTORY_H_
 
 #include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/container/map.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
@@ -49,10 +50,14 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
    * \param graph_json The execution graph.
    * \param params The params of graph.
    * \param module_name The module name of graph.
+   * \param graph_binary The execution graph in the binary format, if already encoded.
    */
   GraphExecutorFactory(const std::string& graph_json,
                        const std::unordered_map<std::string, tvm::runtime::NDArray>& params,
-                       const std::string& module_name = "default");
+                       const std::string& module_name = "default",
+                       const std::string& graph_binary = "");
+
+  ~GraphExecutorFactory();
 
   /*!
    * \brief Get member function to front-end
@@ -100,6 +105,26 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
    */
   Module CudaGraphExecutorCreate(const std::vector<Device>& devs);
 
+  /*!
+   * \brief Place the params in a named shared memory object that factories of the
+   *  same module in other processes can attach to.
+   *
+   * With a CPU device, the params themselves are stored in the object. With a CUDA
+   * device, the params are copied to the device once and the object holds their
+   * CUDA IPC handles. The executors created afterwards bind the shared params
+   * instead of copying them. The name is removed when this factory is destroyed.
+   * \param name The name of the shared memory object, starting with a slash.
+   * \param dev The device the params are shared on.
+   */
+  void ShareParams(const std::string& name, Device dev);
+
+  /*!
+   * \brief Replace the params with the ones shared by ShareParams in another process.
+   * \param name The name of the shared memory object.
+   * \param dev The device the params were shared on, the CUDA device to open them on.
+   */
+  void AttachParams(const std::string& name, Device dev);
+
   /*!
    * \brief Set params.
    * \param graph_executor The graph executor we want to set the params into.
@@ -107,6 +132,15 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
    */
   void SetParams(GraphExecutor* graph_executor,
                  const std::unordered_map<std::string, tvm::runtime::NDArray>& params) const {
+    if (bind_params_) {
+      // Shared params are bound in place, copies would defeat the sharing.
+      Map<String, NDArray> value;
+      for (const auto& kv : params) {
+        value.Set(kv.first, kv.second);
+      }
+      graph_executor->BindParams(value);
+      return;
+    }
     std::unordered_map<std::string, tvm::runtime::NDArray> value = params;
     // upload big arrays first to avoid memory issue in rpc mode
     std::vector<std::string> keys;
@@ -130,6 +164,12 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
  protected:
   /*! \brief The execution graph. */
   std::string graph_json_;
+  /*! \brief The execution graph in the binary format, encoded when the module is saved. */
+  std::string graph_binary_;
+  /*! \brief Whether the params are shared with other processes, and bound without copies. */
+  bool bind_params_{false};
+  /*! \brief The shared memory object created by ShareParams, if any. */
+  std::string shared_params_name_;
   /*! \brief The params. */
   std::unordered_map<std::string, tvm::runtime::NDArray> params_;
   /*! \brief module name */
@@ -0,0 +1,245 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_runtime_hip_graph.cc
+ */
+
+#include <tvm/runtime/registry.h>
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../../rocm/rocm_common.h"
+#include "../graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Graph executor with HIP Graph Support.
+ *
+ *  The ROCm counterpart of GraphExecutorCudaGraph: the kernel launches of a run
+ *  are captured from the HIP stream into a HIP graph, which is then launched
+ *  with a single call instead of one launch per operator.
+ */
+class GraphExecutorHipGraph : public GraphExecutor {
+ public:
+  /*! \brief The default number of graphs kept by the capture cache. */
+  static constexpr size_t kDefaultGraphCacheSize = 8;
+
+  ~GraphExecutorHipGraph() {
+    for (auto& entry : graph_cache_) {
+      ROCM_CALL(hipGraphExecDestroy(entry.second));
+    }
+    if (hip_graph_exec_ != nullptr) {
+      ROCM_CALL(hipGraphExecDestroy(hip_graph_exec_));
+    }
+  }
+
+  /*!
+   * \brief Begin HIP graph capture on stream, the stream enters capture mode.
+   */
+  void StartCapture() {
+    const Device& dev = data_entry_[entry_id(0, 0)]->device;
+
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
+    TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
+
+    ROCM_CALL(hipStreamBeginCapture(static_cast<hipStream_t>(capture_stream_),
+                                    hipStreamCaptureModeGlobal));
+  }
+
+  /*!
+   * \brief Launch the instantiated graph on stream
+   */
+  void RunHipGraph() {
+    ICHECK(hip_graph_exec_ != nullptr) << "capture_hip_graph must be called before run_hip_graph";
+    hipStream_t stream = static_cast<hipStream_t>(capture_stream_);
+    ROCM_CALL(hipGraphLaunch(hip_graph_exec_, stream));
+    ROCM_CALL(hipStreamSynchronize(stream));
+  }
+
+  /*!
+   * \brief End HIP graph capture on stream, a graph will be created and
+   * instantiated.
+   */
+  void EndCapture() {
+    hipGraph_t graph;
+    ROCM_CALL(hipStreamEndCapture(static_cast<hipStream_t>(capture_stream_), &graph));
+
+    size_t num_nodes = 0;
+    ROCM_CALL(hipGraphGetNodes(graph, nullptr, &num_nodes));
+    LOG(INFO) << "Num of nodes in the hip graph created using stream capture API = "
+              << num_nodes;
+
+    if (hip_graph_exec_ != nullptr) {
+      ROCM_CALL(hipGraphExecDestroy(hip_graph_exec_));
+    }
+    ROCM_CALL(hipGraphInstantiate(&hip_graph_exec_, graph, nullptr, nullptr, 0));
+    ROCM_CALL(hipGraphDestroy(graph));
+  }
+
+  /*!
+   * \brief Run the graph through the capture cache.
+   *
+   *  The graphs are keyed by the addresses and shapes of the input and output
+   *  tensors, as in GraphExecutorCudaGraph::RunCached.
+   */
+  void RunCached() {
+    if (!warmed_up_) {
+      // Kernel modules and workspaces must be loaded before capture, as the first run does.
+      GraphExecutor::Run();
+      warmed_up_ = true;
+      return;
+    }
+    std::string key = GraphKey();
+    auto it = graph_index_.find(key);
+    if (it == graph_index_.end()) {
+      StartCapture();
+      GraphExecutor::Run();
+      hipGraph_t graph;
+      ROCM_CALL(hipStreamEndCapture(static_cast<hipStream_t>(capture_stream_), &graph));
+      hipGraphExec_t graph_exec;
+      ROCM_CALL(hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
+      ROCM_CALL(hipGraphDestroy(graph));
+      graph_cache_.emplace_front(key, graph_exec);
+      it = graph_index_.emplace(std::move(key), graph_cache_.begin()).first;
+      while (graph_cache_.size() > graph_cache_size_) {
+        ROCM_CALL(hipGraphExecDestroy(graph_cache_.back().second));
+        graph_index_.erase(graph_cache_.back().first);
+        graph_cache_.pop_back();
+      }
+    } else {
+      graph_cache_.splice(graph_cache_.begin(), graph_cache_, it->second);
+    }
+    hipStream_t stream = static_cast<hipStream_t>(capture_stream_);
+    ROCM_CALL(hipGraphLaunch(it->second->second, stream));
+    ROCM_CALL(hipStreamSynchronize(stream));
+  }
+
+  /*!
+   * \brief Set the number of graphs kept by the capture cache.
+   * \param cache_size The maximum number of cached graphs.
+   */
+  void SetGraphCacheSize(int cache_size) {
+    ICHECK_GT(cache_size, 0) << "The HIP graph cache must hold at least one graph";
+    graph_cache_size_ = cache_size;
+    while (graph_cache_.size() > graph_cache_size_) {
+      ROCM_CALL(hipGraphExecDestroy(graph_cache_.back().second));
+      graph_index_.erase(graph_cache_.back().first);
+      graph_cache_.pop_back();
+    }
+  }
+
+  /*!
+   * \brief GetFunction Get the function based on input.
+   * \param name The function which needs to be invoked.
+   * \param sptr_to_self Packed function pointer.
+   */
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self);
+
+ private:
+  /*! \brief Build the key of the current input and output buffers. */
+  std::string GraphKey() const {
+    std::string key;
+    auto append = [&key](const DLTensor* tensor) {
+      key.append(reinterpret_cast<const char*>(&tensor->data), sizeof(tensor->data));
+      key.append(reinterpret_cast<const char*>(tensor->shape), sizeof(int64_t) * tensor->ndim);
+    };
+    // The zero copy buffers are bound to the arguments of the operators.
+    for (uint32_t nid : input_nodes_) {
+      uint32_t eid = entry_id(nid, 0);
+      const auto& args = input_dltensors_[eid];
+      append(args.empty() ? data_entry_[eid].operator->() : args[0]);
+    }
+    for (const NodeEntry& output : outputs_) {
+      uint32_t eid = entry_id(output);
+      const auto& args = output_dltensors_[eid];
+      append(args.empty() ? data_entry_[eid].operator->() : args[0]);
+    }
+    return key;
+  }
+
+  /*! \brief The HIP stream on which to capture a HIP graph. */
+  TVMStreamHandle capture_stream_{nullptr};
+  /*! \brief The captured HIP graph will be instantiated to this. */
+  hipGraphExec_t hip_graph_exec_{nullptr};
+  /*! \brief Whether the graph ran once, loading the kernel modules. */
+  bool warmed_up_{false};
+  /*! \brief The cached graphs, most recently used first. */
+  std::list<std::pair<std::string, hipGraphExec_t>> graph_cache_;
+  /*! \brief The cached graphs by key. */
+  std::unordered_map<std::string, std::list<std::pair<std::string, hipGraphExec_t>>::iterator>
+      graph_index_;
+  /*! \brief The maximum number of cached graphs. */
+  size_t graph_cache_size_{kDefaultGraphCacheSize};
+};
+
+PackedFunc GraphExecutorHipGraph::GetFunction(const std::string& name,
+                                              const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "run_hip_graph") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->RunHipGraph(); });
+  } else if (name == "start_capture") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartCapture(); });
+  } else if (name == "end_capture") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->EndCapture(); });
+  } else if (name == "run_hip_graph_cached") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->RunCached(); });
+  } else if (name == "set_hip_graph_cache_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetGraphCacheSize(args[0]);
+    });
+  } else {
+    return GraphExecutor::GetFunction(name, sptr_to_self);
+  }
+}
+
+Module GraphExecutorHipGraphCreate(const std::string& sym_json, const tvm::runtime::Module& m,
+                                   const std::vector<Device>& devs,
+                                   PackedFunc lookup_linked_param_func) {
+  auto exec = make_object<GraphExecutorHipGraph>();
+  exec->Init(sym_json, m, devs, lookup_linked_param_func);
+  return Module(exec);
+}
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor_hip_graph.create")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_GE(args.num_args, 4)
+          << "The expected number of arguments for graph_executor.create is "
+             "at least 4, but it has "
+          << args.num_args;
+      PackedFunc lookup_linked_param_func;
+      int dev_start_arg = 2;
+      if (args[2].type_code() == kTVMPackedFuncHandle) {
+        lookup_linked_param_func = args[2];
+        dev_start_arg++;
+      }
+
+      *rv = GraphExecutorHipGraphCreate(args[0], args[1], GetAllDevice(args, dev_start_arg),
+                                        lookup_linked_param_func);
+    });
+}  // namespace runtime
+}  // namespace tvm
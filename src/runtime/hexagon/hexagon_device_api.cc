@@ -304,6 +304,38 @@ TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_device_bytes")
       *rv = static_cast<int32_t>(api->VtcmPool()->VtcmDeviceBytes());
     });
 
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_reserve_partition")
+    .set_body_typed([](int64_t nbytes) {
+      return HexagonDeviceAPI::Global()->VtcmPool()->ReservePartition(nbytes);
+    });
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_release_partition").set_body_typed([](int partition) {
+  HexagonDeviceAPI::Global()->VtcmPool()->ReleasePartition(partition);
+});
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_set_thread_partition")
+    .set_body_typed([](int partition) {
+      HexagonDeviceAPI::Global()->VtcmPool()->SetThreadPartition(partition);
+    });
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.set_parallel_threads")
+    .set_body_typed([](int num_threads) {
+      CHECK_GE(num_threads, 0) << "ValueError: The number of parallel threads must be non-negative";
+      HexagonDeviceAPI::Global()->ThreadManager()->SetParallelThreads(num_threads);
+    });
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.parallel_threads").set_body_typed([]() {
+  return static_cast<int>(HexagonDeviceAPI::Global()->ThreadManager()->ParallelThreads());
+});
+
+bool ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task, int* ret) {
+  HexagonDeviceAPI* api = HexagonDeviceAPI::Global();
+  if (!api->HasThreadManager()) {
+    return false;
+  }
+  return api->ThreadManager()->ParallelLaunch(flambda, cdata, num_task, ret);
+}
+
 TVM_REGISTER_GLOBAL("device_api.hexagon").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = HexagonDeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
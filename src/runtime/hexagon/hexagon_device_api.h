@@ -153,6 +153,9 @@ class HexagonDeviceAPI final : public DeviceAPI {
     return runtime_threads.get();
   }
 
+  //! \brief Whether the thread manager exists, i.e. the runtime resources are acquired.
+  bool HasThreadManager() const { return runtime_threads != nullptr; }
+
   HexagonUserDMA* UserDMA() {
     CHECK(runtime_dma) << "runtime_dma has not been created";
     return runtime_dma.get();
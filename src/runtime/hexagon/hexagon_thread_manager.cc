@@ -19,10 +19,35 @@
 
 #include "hexagon_thread_manager.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace tvm {
 namespace runtime {
 namespace hexagon {
 
+namespace {
+//! \brief Stride between the sync counters of the tasks, as expected by TVMBackendParallelBarrier.
+constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
+
+//! \brief Whether the current thread is running a task of `ParallelLaunch`.
+thread_local bool in_parallel_task = false;
+
+//! \brief One task of `ParallelLaunch`, sent to a parallel thread.
+struct ParallelTask {
+  FTVMParallelLambda flambda;
+  void* cdata;
+  int task_id;
+  TVMParallelGroupEnv* env;
+  std::atomic<int>* ret;
+  qurt_sem_t* done;
+};
+
+bool IsHvx(HardwareResourceType type) {
+  return type == HVX_0 || type == HVX_1 || type == HVX_2 || type == HVX_3;
+}
+}  // namespace
+
 HexagonThreadManager::HexagonThreadManager(unsigned num_threads, unsigned thread_stack_size_bytes,
                                            unsigned thread_pipe_size_words,
                                            const std::vector<HardwareResourceType> hw_resources) {
@@ -54,6 +79,14 @@ HexagonThreadManager::HexagonThreadManager(unsigned num_threads, unsigned thread
   DLOG(INFO) << "Spawning threads";
   SpawnThreads(thread_stack_size_bytes, thread_pipe_size_words);
 
+  // Parallel tasks run on the threads holding an HVX context, or on any thread when there are no
+  // hardware resources to bind to.
+  for (unsigned i = 0; i < nthreads_; i++) {
+    if (hw_resources_.empty() || IsHvx(hw_resources_[i])) {
+      parallel_threads_.push_back(reinterpret_cast<TVMStreamHandle>(i));
+    }
+  }
+
   // Initially, block all threads until we get the Start() call
   qurt_sem_init_val(&start_semaphore_, 0);
   for (unsigned i = 0; i < nthreads_; i++) {
@@ -264,6 +297,72 @@ void HexagonThreadManager::WaitOnThreads() {
   }
 }
 
+bool HexagonThreadManager::ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task,
+                                          int* ret) {
+  if (in_parallel_task) {
+    // Nested parallelism: the parallel threads are all busy, run the lambda as a single task.
+    std::atomic<int> sync_counter{0};
+    TVMParallelGroupEnv env;
+    env.num_task = 1;
+    env.sync_handle = &sync_counter;
+    *ret = (*flambda)(0, &env, cdata);
+    return true;
+  }
+  std::unique_lock<std::mutex> lock(parallel_mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || parallel_threads_.empty()) {
+    return false;
+  }
+
+  // In case Start() was never explicitly called, call it now to prevent deadlock
+  if (qurt_sem_get_val(&start_semaphore_) == 0) {
+    Start();
+  }
+
+  // All the tasks must run concurrently for TVMBackendParallelBarrier, so there is at most one
+  // task per parallel thread.
+  int max_task = ParallelThreads();
+  num_task = (num_task <= 0) ? max_task : std::min(num_task, max_task);
+
+  std::vector<std::atomic<int>> sync_counter(num_task * kSyncStride);
+  for (auto& counter : sync_counter) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  TVMParallelGroupEnv env;
+  env.num_task = num_task;
+  env.sync_handle = sync_counter.data();
+  std::atomic<int> status{0};
+  qurt_sem_t done;
+  qurt_sem_init_val(&done, 0);
+
+  std::vector<ParallelTask> tasks(num_task);
+  for (int i = 0; i < num_task; i++) {
+    tasks[i] = ParallelTask{flambda, cdata, i, &env, &status, &done};
+    bool success = Dispatch(parallel_threads_[i], thread_parallel_task, &tasks[i]);
+    while (!success) {
+      success = Dispatch(parallel_threads_[i], thread_parallel_task, &tasks[i]);
+    }
+  }
+  for (int i = 0; i < num_task; i++) {
+    qurt_sem_down(&done);
+  }
+  qurt_sem_destroy(&done);
+
+  *ret = status.load();
+  return true;
+}
+
+void HexagonThreadManager::SetParallelThreads(unsigned num_threads) {
+  CHECK_LE(num_threads, parallel_threads_.size())
+      << "ValueError: Cannot use " << num_threads << " parallel threads, only "
+      << parallel_threads_.size() << " are available";
+  std::lock_guard<std::mutex> lock(parallel_mutex_);
+  num_parallel_threads_ = num_threads;
+}
+
+unsigned HexagonThreadManager::ParallelThreads() const {
+  return num_parallel_threads_ ? num_parallel_threads_ : parallel_threads_.size();
+}
+
 void HexagonThreadManager::CheckSemaphore(unsigned syncID) {
   // We want the success case to be fast, so do not lock the mutex
   if (semaphores_.find(syncID) == semaphores_.end()) {
@@ -340,6 +439,18 @@ void HexagonThreadManager::thread_exit(void* context) {
   qurt_thread_exit((uint64_t)tc->status);
 }
 
+void HexagonThreadManager::thread_parallel_task(void* task) {
+  ParallelTask* t = static_cast<ParallelTask*>(task);
+  in_parallel_task = true;
+  int ret = (*t->flambda)(t->task_id, t->env, t->cdata);
+  in_parallel_task = false;
+  if (ret != 0) {
+    int expected = 0;
+    t->ret->compare_exchange_strong(expected, ret);
+  }
+  qurt_sem_up(t->done);
+}
+
 void HexagonThreadManager::thread_main(void* context) {
   ThreadContext* tc = static_cast<ThreadContext*>(context);
   unsigned index = tc->index;
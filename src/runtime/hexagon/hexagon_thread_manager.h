@@ -20,11 +20,13 @@
 #ifndef TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 #define TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -145,6 +147,29 @@ class HexagonThreadManager {
   //! call to wait until all threads have empty pipes.
   void WaitOnThreads();
 
+  /*!
+   * \brief Blocking launch of a TVM parallel lambda, one task per parallel thread. The parallel
+   * threads are the HVX threads, or all the threads if no hardware resources were requested.
+   * \param flambda The parallel lambda to launch.
+   * \param cdata The closure data of the lambda.
+   * \param num_task The number of tasks requested, 0 to use all the parallel threads; capped to
+   * the number of parallel threads.
+   * \param ret Set to 0 on success, or to the non-zero value returned by a failing task.
+   * \returns Boolean value indicating whether the lambda was launched; false if the parallel
+   * threads are busy with a launch from another thread, in which case the caller runs the lambda
+   * elsewhere. Launches from within a parallel task run inline as a single task.
+   */
+  bool ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task, int* ret);
+
+  /*!
+   * \brief Set the number of threads used by `ParallelLaunch`.
+   * \param num_threads Number of threads, 0 to use all the parallel threads.
+   */
+  void SetParallelThreads(unsigned num_threads);
+
+  //! \brief Number of threads used by `ParallelLaunch`.
+  unsigned ParallelThreads() const;
+
  private:
   struct ThreadContext {
     qurt_pipe_t* pipe;
@@ -187,6 +212,9 @@ class HexagonThreadManager {
   //! \brief Void function executed by each thread as `main`.
   static void thread_main(void* context);
 
+  //! \brief Void function executed by a thread to run one task of a `ParallelLaunch`.
+  static void thread_parallel_task(void* task);
+
   //! \brief Manages underlying HexagonBuffer allocations.
   HexagonBufferManager hexbuffs_;
 
@@ -231,6 +259,15 @@ class HexagonThreadManager {
   //! \brief List of hardware resources
   std::vector<HardwareResourceType> hw_resources_;
 
+  //! \brief Threads running the tasks of `ParallelLaunch`.
+  std::vector<TVMStreamHandle> parallel_threads_;
+
+  //! \brief Number of threads used by `ParallelLaunch`, 0 for all of `parallel_threads_`.
+  unsigned num_parallel_threads_{0};
+
+  //! \brief Serializes `ParallelLaunch` calls, whose tasks must not interleave in the pipes.
+  std::mutex parallel_mutex_;
+
   //! \brief Whether or not resource managers should be created
   bool create_resource_managers_{false};
 
@@ -19,6 +19,8 @@
 
 #include "hexagon_user_dma.h"
 
+#include <HAP_perf.h>
+
 #include <algorithm>
 
 #include "hexagon_device_api.h"
@@ -101,13 +103,23 @@ int HexagonUserDMA::Copy(uint32_t queue_id, void* dst, void* src, uint32_t lengt
 
   // update tail
   tail_dma_desc_ = dma_desc;
+
+  stats_.copies += 1;
+  stats_.bytes += length;
+  if (src_is_ddr && !dst_is_ddr) {
+    stats_.ddr_to_vtcm_bytes += length;
+  } else if (!src_is_ddr && dst_is_ddr) {
+    stats_.vtcm_to_ddr_bytes += length;
+  }
   return DMA_SUCCESS;
 }
 
 void HexagonUserDMA::Wait(uint32_t queue_id, uint32_t max_dmas_in_flight) {
+  uint64_t start = HAP_perf_get_pcycles();
   // wait (forever) until max DMAs in flight <= actual DMAs in flight
   while (DMAGroupsInFlight(queue_id) > max_dmas_in_flight) {
   }
+  stats_.wait_cycles += HAP_perf_get_pcycles() - start;
 }
 
 uint32_t HexagonUserDMA::Poll(uint32_t queue_id) { return DMAGroupsInFlight(queue_id); }
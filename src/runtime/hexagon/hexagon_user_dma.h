@@ -37,6 +37,16 @@ namespace hexagon {
 #define MAX_DMA_QUEUES 10
 #define SYNC_DMA_QUEUE MAX_DMA_QUEUES - 1
 
+//! \brief Counters of the DMAs issued since the last ResetStats
+struct HexagonUserDMAStats {
+  uint64_t copies{0};
+  uint64_t bytes{0};
+  uint64_t ddr_to_vtcm_bytes{0};
+  uint64_t vtcm_to_ddr_bytes{0};
+  //! \brief Processor cycles spent in Wait
+  uint64_t wait_cycles{0};
+};
+
 class HexagonUserDMA {
  public:
   HexagonUserDMA();
@@ -83,6 +93,12 @@ class HexagonUserDMA {
    */
   void EndGroup(uint32_t queue_id) { descriptors_->EndGroup(queue_id); }
 
+  //! \brief The counters of the DMAs issued, reported by the LWP profiler
+  const HexagonUserDMAStats& Stats() const { return stats_; }
+
+  //! \brief Reset the counters returned by Stats
+  void ResetStats() { stats_ = HexagonUserDMAStats(); }
+
  private:
   //! \brief Initializes the Hexagon User DMA engine
   unsigned int Init();
@@ -101,6 +117,8 @@ class HexagonUserDMA {
 
   //! \brief Storage for all DMA descriptors
   QueuedRingBuffer<dma_desc_2d_t>* descriptors_ = nullptr;
+
+  HexagonUserDMAStats stats_;
 };
 
 }  // namespace hexagon
@@ -54,69 +54,118 @@ HexagonVtcmPool::HexagonVtcmPool() {
   CHECK(vtcm_data_ != nullptr) << "HAP_compute_res_acquire returned nullptr when allocating VTCM.";
   CHECK(vtcm_allocated_size_ >= avail_block_size)
       << "HAP_compute_res_acquire failed to allocate minimum amount of VTCM";
-  free_.emplace_back(
-      std::pair<char*, size_t>(static_cast<char*>(vtcm_data_), vtcm_allocated_size_));
+  shared_ = std::make_unique<Region>(static_cast<char*>(vtcm_data_), vtcm_allocated_size_);
   // DebugDump();
 }
 
 HexagonVtcmPool::~HexagonVtcmPool() { HEXAGON_SAFE_CALL(HAP_compute_res_release(context_id_)); }
 
-void* HexagonVtcmPool::Allocate(size_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+namespace {
+//! \brief The partition each thread allocates from
+thread_local int thread_partition = HexagonVtcmPool::kSharedPartition;
+}  // namespace
 
-  CHECK(!free_.empty()) << "No free VTCM";
-  CHECK(nbytes >= 0x80) << "Minimum VTCM alloation must be 128 bytes - nbytes " << nbytes;
+void* HexagonVtcmPool::Allocate(size_t nbytes) { return Allocate(nbytes, thread_partition); }
 
-  // If this is not aligned on a 2k block, allocate from the end to avoid fragmentation
-  if (nbytes & size_t(0x7FF)) {
-    DLOG(INFO) << "VTCM nbytes requested: " << nbytes << " allocate from the end";
-    auto last_free_entry = free_.end();
-    last_free_entry--;
-    CHECK(last_free_entry->second >= nbytes)
-        << "Not enough contiguous VTCM space at the end to allocate";
-    char* ptr = last_free_entry->first + (last_free_entry->second - nbytes);
-    allocations_.emplace_back(std::pair<char*, size_t>(ptr, nbytes));
-    last_free_entry->second -= nbytes;
-    if (last_free_entry->second == 0) {
-      free_.erase(last_free_entry);
-    }
-    // DebugDump();
+void* HexagonVtcmPool::Allocate(size_t nbytes, int partition) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (partition == kSharedPartition) {
+    void* ptr = shared_->Allocate(nbytes);
+    peak_used_ = std::max(peak_used_, shared_->used_);
     return ptr;
   }
+  auto it = partitions_.find(partition);
+  CHECK(it != partitions_.end()) << "VTCM partition " << partition << " is not reserved";
+  return it->second.Allocate(nbytes);
+}
+
+void HexagonVtcmPool::Free(void* ptr, size_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  char* ptr_to_free = static_cast<char*>(ptr);
+  FindRegion(ptr_to_free)->Free(ptr_to_free, nbytes);
+}
+
+int HexagonVtcmPool::ReservePartition(size_t nbytes) {
+  // Partitions are 2k aligned, so that they are carved from the front of a free segment, and
+  // their own 2k aligned allocations stay aligned.
+  nbytes = (nbytes + 0x7FF) & ~size_t(0x7FF);
+  CHECK(nbytes > 0) << "VTCM partition must not be empty";
+  std::lock_guard<std::mutex> lock(mutex_);
+  char* base = static_cast<char*>(shared_->Allocate(nbytes));
+  peak_used_ = std::max(peak_used_, shared_->used_);
+  int partition = next_partition_++;
+  partitions_.emplace(partition, Region(base, nbytes));
+  return partition;
+}
+
+void HexagonVtcmPool::ReleasePartition(int partition) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = partitions_.find(partition);
+  CHECK(it != partitions_.end()) << "VTCM partition " << partition << " is not reserved";
+  CHECK(it->second.allocations_.empty())
+      << "VTCM partition " << partition << " still holds " << it->second.allocations_.size()
+      << " allocations";
+  shared_->Free(it->second.base_, it->second.size_);
+  partitions_.erase(it);
+}
+
+void HexagonVtcmPool::SetThreadPartition(int partition) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(partition == kSharedPartition || partitions_.count(partition))
+      << "VTCM partition " << partition << " is not reserved";
+  thread_partition = partition;
+}
+
+HexagonVtcmPool::Region* HexagonVtcmPool::FindRegion(const char* ptr) {
+  for (auto& kv : partitions_) {
+    if (kv.second.Contains(ptr)) return &kv.second;
+  }
+  return shared_.get();
+}
 
-  auto entry_to_allocate = free_.begin();
+void* HexagonVtcmPool::Region::Allocate(size_t nbytes) {
+  CHECK(!free_.empty()) << "No free VTCM";
+  CHECK(nbytes >= 0x80) << "Minimum VTCM alloation must be 128 bytes - nbytes " << nbytes;
+
+  // Find the smallest free segment that fits, to keep the large segments for large allocations
+  auto entry_to_allocate = free_.end();
   for (auto it = free_.begin(); it != free_.end(); it++) {
-    if ((entry_to_allocate->second < nbytes || it->second < entry_to_allocate->second) &&
-        it->second >= nbytes) {
+    if (it->second >= nbytes &&
+        (entry_to_allocate == free_.end() || it->second < entry_to_allocate->second)) {
       entry_to_allocate = it;
       if (entry_to_allocate->second == nbytes) {
         break;
       }
     }
   }
-  CHECK(entry_to_allocate->second >= nbytes) << "Not enough contiguous VTCM space to allocate";
-  char* ptr = entry_to_allocate->first;
-  allocations_.emplace(allocations_.end(), std::pair<char*, size_t>(ptr, nbytes));
+  CHECK(entry_to_allocate != free_.end()) << "Not enough contiguous VTCM space to allocate";
 
-  if (entry_to_allocate->second == nbytes) {
-    free_.erase(entry_to_allocate);
+  char* ptr;
+  if (nbytes & size_t(0x7FF)) {
+    // If this is not aligned on a 2k block, allocate from the end of the segment, so that the
+    // rest of the segment keeps its 2k aligned start
+    DLOG(INFO) << "VTCM nbytes requested: " << nbytes << " allocate from the end";
+    ptr = entry_to_allocate->first + (entry_to_allocate->second - nbytes);
   } else {
-    entry_to_allocate->first = entry_to_allocate->first + nbytes;
-    entry_to_allocate->second = entry_to_allocate->second - nbytes;
+    ptr = entry_to_allocate->first;
+    entry_to_allocate->first += nbytes;
   }
-  // DebugDump();
+  entry_to_allocate->second -= nbytes;
+  if (entry_to_allocate->second == 0) {
+    free_.erase(entry_to_allocate);
+  }
+  allocations_.emplace_back(ptr, nbytes);
+  used_ += nbytes;
   return ptr;
 }
 
-void HexagonVtcmPool::Free(void* ptr, size_t nbytes) {
-  char* ptr_to_free = static_cast<char*>(ptr);
-  std::lock_guard<std::mutex> lock(mutex_);
-
+void HexagonVtcmPool::Region::Free(char* ptr_to_free, size_t nbytes) {
   auto it = std::find_if(allocations_.begin(), allocations_.end(),
                          [&](auto entry) { return entry.first == ptr_to_free; });
   CHECK(it != allocations_.end()) << "Attempted to free a pointer that had not been allocated";
   CHECK(it->second == nbytes) << "Attempted to free a different size than was allocated";
   allocations_.erase(it);
+  used_ -= nbytes;
 
   it = std::lower_bound(free_.begin(), free_.end(), std::pair<char*, size_t>(ptr_to_free, nbytes),
                         [](auto p, auto q) { return p.first <= q.first; });
@@ -148,16 +197,22 @@ void HexagonVtcmPool::Free(void* ptr, size_t nbytes) {
       free_.erase(it);
     }
   }
-  // DebugDump();
 }
 
 void HexagonVtcmPool::DebugDump() {
   LOG(INFO) << "VTCM list state";
-  for (auto entry : allocations_) {
-    LOG(INFO) << "VTCM alloc: " << static_cast<void*>(entry.first) << " " << entry.second;
-  }
-  for (auto entry : free_) {
-    LOG(INFO) << "VTCM  free: " << static_cast<void*>(entry.first) << " " << entry.second;
+  auto dump = [](const Region& region) {
+    for (auto entry : region.allocations_) {
+      LOG(INFO) << "VTCM alloc: " << static_cast<void*>(entry.first) << " " << entry.second;
+    }
+    for (auto entry : region.free_) {
+      LOG(INFO) << "VTCM  free: " << static_cast<void*>(entry.first) << " " << entry.second;
+    }
+  };
+  dump(*shared_);
+  for (auto& kv : partitions_) {
+    LOG(INFO) << "VTCM partition " << kv.first;
+    dump(kv.second);
   }
 }
 
@@ -26,6 +26,9 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -54,11 +57,22 @@ class HexagonVtcmPool {
   HexagonVtcmPool& operator=(HexagonVtcmPool&&) = delete;
 
   /* \brief Allocate memory from the VTCM manager
+   *
+   * The memory comes from the partition bound to the calling thread by SetThreadPartition,
+   * or from the shared part of VTCM if the thread is not bound to a partition.
    *
    * \param nbytes The number of bytes to allocate.
    */
   void* Allocate(size_t nbytes);
 
+  /* \brief Allocate memory from a partition of VTCM
+   *
+   * \param nbytes The number of bytes to allocate.
+   *
+   * \param partition The id of the partition, or kSharedPartition for the shared part of VTCM.
+   */
+  void* Allocate(size_t nbytes, int partition);
+
   /* \brief Copy data from a Hexagon Buffer an external buffer.
    *
    * \param ptr The pointer to the buffer to be freed.
@@ -67,12 +81,56 @@ class HexagonVtcmPool {
    */
   void Free(void* ptr, size_t nbytes);
 
+  //! \brief The id of the shared part of VTCM, which is not reserved by any partition
+  static constexpr int kSharedPartition = 0;
+
+  /* \brief Reserve a partition of VTCM, for the exclusive use of a model or a thread.
+   *
+   * The partition is carved out of the shared part of VTCM as a contiguous, 2k aligned
+   * segment, so that the allocations of other models cannot fragment it.
+   *
+   * \param nbytes The size of the partition, rounded up to a multiple of 2k.
+   *
+   * \return The id of the partition.
+   */
+  int ReservePartition(size_t nbytes);
+
+  /* \brief Give a partition back to the shared part of VTCM.
+   *
+   * \param partition The id of the partition, which must not hold allocations anymore.
+   */
+  void ReleasePartition(int partition);
+
+  /* \brief Bind the calling thread to a partition, used by Allocate(nbytes).
+   *
+   * \param partition The id of the partition, or kSharedPartition to unbind the thread.
+   */
+  void SetThreadPartition(int partition);
+
   //! \brief Returns the total number of bytes in this pool
   size_t VtcmDeviceBytes() { return reinterpret_cast<size_t>(vtcm_device_size_); }
 
   //! \brief Returns the total number of bytes in this pool
   size_t VtcmAllocatedBytes() { return reinterpret_cast<size_t>(vtcm_allocated_size_); }
 
+  //! \brief Returns the number of bytes of the pool in use, counting reserved partitions as used
+  size_t VtcmUsedBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return shared_->used_;
+  }
+
+  //! \brief Returns the largest VtcmUsedBytes since the last ResetPeak
+  size_t VtcmPeakBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_used_;
+  }
+
+  //! \brief Reset VtcmPeakBytes to the bytes currently in use
+  void ResetPeak() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peak_used_ = shared_->used_;
+  }
+
   bool IsVtcm(void* ptr, unsigned size) {
     auto char_ptr = static_cast<char*>(ptr);
     CHECK(char_ptr != nullptr);
@@ -98,11 +156,41 @@ class HexagonVtcmPool {
   //! \brief Context for HAP_compute_res_*
   unsigned int context_id_{0};
 
-  //! \brief List of allocations
-  std::vector<std::pair<char*, size_t>> allocations_;
+  //! \brief A contiguous segment of VTCM with its own allocations
+  struct Region {
+    //! \brief List of allocations
+    std::vector<std::pair<char*, size_t>> allocations_;
+
+    //! \brief List of free segments, sorted by address
+    std::vector<std::pair<char*, size_t>> free_;
+
+    //! \brief The beginning and the size of the segment
+    char* base_{nullptr};
+    size_t size_{0};
+
+    //! \brief The number of bytes allocated
+    size_t used_{0};
+
+    Region(char* base, size_t size) : base_(base), size_(size) { free_.emplace_back(base, size); }
+    bool Contains(const char* ptr) const { return ptr >= base_ && ptr < base_ + size_; }
+    void* Allocate(size_t nbytes);
+    void Free(char* ptr, size_t nbytes);
+  };
+
+  //! \brief Find the region holding an allocation
+  Region* FindRegion(const char* ptr);
+
+  //! \brief The shared part of VTCM, the partitions are allocations of it
+  std::unique_ptr<Region> shared_;
+
+  //! \brief The reserved partitions by id
+  std::unordered_map<int, Region> partitions_;
+
+  //! \brief The peak of shared_->used_
+  size_t peak_used_{0};
 
-  //! \brief List of free segments
-  std::vector<std::pair<char*, size_t>> free_;
+  //! \brief The id of the next reserved partition
+  int next_partition_{kSharedPartition + 1};
 
   //! \brief Mutext to protect access to the lists
   std::mutex mutex_;
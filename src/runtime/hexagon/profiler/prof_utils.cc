@@ -17,9 +17,20 @@
  * under the License.
  */
 
+#include "prof_utils.h"
+
+#include <HAP_perf.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <string>
+#include <vector>
+
+#include "../hexagon_device_api.h"
 
 // The max loop/function id used among all lwp_handler calls. Since
 // the id is used to index into the lwp_counter buffer, the size of the
@@ -76,3 +87,136 @@ bool WriteLWPOutput(const std::string& out_json) {
   ofc.close();
   return true;
 }
+
+namespace {
+
+/*! \brief The frequency of the processor cycle counter read by lwp_handler, in Hz. */
+double PcyclesFrequency() {
+  static double freq = [] {
+    uint64_t start_us = HAP_perf_get_time_us();
+    uint64_t start_cycles = HAP_perf_get_pcycles();
+    while (HAP_perf_get_time_us() - start_us < 1000) {
+    }
+    double seconds = (HAP_perf_get_time_us() - start_us) * 1e-6;
+    return (HAP_perf_get_pcycles() - start_cycles) / seconds;
+  }();
+  return freq;
+}
+
+}  // namespace
+
+tvm::runtime::profiling::Report HexagonLWPReport(bool reset) {
+  using namespace tvm::runtime;
+  using namespace tvm::runtime::profiling;
+  struct Stats {
+    uint32_t id;
+    uint32_t ret;
+    int64_t count{0};
+    uint64_t cycles{0};
+    uint64_t exclusive_cycles{0};
+  };
+  struct Frame {
+    uint32_t id;
+    uint32_t ret;
+    uint64_t start;
+    uint64_t children_cycles;
+    std::string stack;
+  };
+  // Keyed by the call stack, so that a loop reached from two functions gets two rows.
+  std::map<std::string, Stats> stats;
+  uint64_t total_cycles = 0;
+  // lwp_handler is called with the same id at the start and at the end of a function or loop.
+  // The ids of a nest are distinct, so an id already open is the end of its innermost frame.
+  std::vector<Frame> open;
+  for (size_t i = 0; i + 4 <= __lwp_buffer_count; i += 4) {
+    uint32_t ret = lwp_buffer[i];
+    uint32_t id = lwp_buffer[i + 1];
+    uint64_t cycles = (static_cast<uint64_t>(lwp_buffer[i + 3]) << 32) + lwp_buffer[i + 2];
+    auto it = std::find_if(open.rbegin(), open.rend(), [&](const Frame& f) { return f.id == id; });
+    if (it == open.rend()) {
+      std::string name = "lwp_" + std::to_string(id);
+      std::string stack = open.empty() ? name : open.back().stack + ";" + name;
+      open.push_back(Frame{id, ret, cycles, 0, stack});
+      continue;
+    }
+    // The frames opened after this one have no end once their ids stop being recorded.
+    open.erase(it.base(), open.end());
+    Frame frame = open.back();
+    open.pop_back();
+    uint64_t inclusive = cycles - frame.start;
+    Stats& stat = stats[frame.stack];
+    stat.id = frame.id;
+    stat.ret = frame.ret;
+    stat.count += 1;
+    stat.cycles += inclusive;
+    stat.exclusive_cycles += inclusive - std::min(inclusive, frame.children_cycles);
+    if (open.empty()) {
+      total_cycles += inclusive;
+    } else {
+      open.back().children_cycles += inclusive;
+    }
+  }
+
+  double freq = PcyclesFrequency();
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& kv : stats) {
+    const Stats& stat = kv.second;
+    std::ostringstream ret;
+    ret << "0x" << std::hex << stat.ret;
+    Map<String, ObjectRef> row;
+    row.Set("Name", String("lwp_" + std::to_string(stat.id)));
+    row.Set("Call Stack", String(kv.first));
+    row.Set("Return Address", String(ret.str()));
+    row.Set("Device", String("hexagon0"));
+    row.Set("Count", ObjectRef(make_object<CountNode>(stat.count)));
+    row.Set("Total Count",
+            ObjectRef(make_object<CountNode>(static_cast<int64_t>(lwp_counter[stat.id] / 2))));
+    row.Set("Cycles", ObjectRef(make_object<CountNode>(static_cast<int64_t>(stat.cycles))));
+    row.Set("Exclusive Cycles",
+            ObjectRef(make_object<CountNode>(static_cast<int64_t>(stat.exclusive_cycles))));
+    row.Set("Duration (us)", ObjectRef(make_object<DurationNode>(stat.cycles / freq * 1e6)));
+    double percent = total_cycles == 0 ? 0.0 : 100.0 * stat.cycles / total_cycles;
+    row.Set("Percent", ObjectRef(make_object<PercentNode>(percent)));
+    calls.push_back(row);
+  }
+
+  auto count = [](uint64_t value) {
+    return ObjectRef(make_object<CountNode>(static_cast<int64_t>(value)));
+  };
+  Map<String, ObjectRef> device;
+  device.Set("Cycles", count(total_cycles));
+  device.Set("Duration (us)", ObjectRef(make_object<DurationNode>(total_cycles / freq * 1e6)));
+  hexagon::HexagonDeviceAPI* api = hexagon::HexagonDeviceAPI::Global();
+  // The DMA engine and the VTCM pool only exist while the runtime resources are acquired.
+  if (api->HasThreadManager()) {
+    const hexagon::HexagonUserDMAStats& dma = api->UserDMA()->Stats();
+    device.Set("DMA Copies", count(dma.copies));
+    device.Set("DMA Bytes", count(dma.bytes));
+    device.Set("DMA DDR to VTCM (bytes)", count(dma.ddr_to_vtcm_bytes));
+    device.Set("DMA VTCM to DDR (bytes)", count(dma.vtcm_to_ddr_bytes));
+    device.Set("DMA Wait Cycles", count(dma.wait_cycles));
+    hexagon::HexagonVtcmPool* vtcm = api->VtcmPool();
+    device.Set("VTCM Size (bytes)", count(vtcm->VtcmAllocatedBytes()));
+    device.Set("VTCM Used (bytes)", count(vtcm->VtcmUsedBytes()));
+    device.Set("VTCM Peak (bytes)", count(vtcm->VtcmPeakBytes()));
+    if (reset) {
+      api->UserDMA()->ResetStats();
+      vtcm->ResetPeak();
+    }
+  }
+  if (reset) {
+    std::fill(lwp_counter, lwp_counter + LWP_COUNTER_SIZE, 0);
+    __lwp_buffer_count = 0;
+  }
+
+  Map<String, ObjectRef> configuration;
+  configuration.Set("Cycle Counter Frequency (MHz)", String(std::to_string(freq / 1e6)));
+  Map<String, Map<String, ObjectRef>> device_metrics;
+  device_metrics.Set("hexagon0", device);
+  return Report(calls, device_metrics, configuration);
+}
+
+// Returns JSON, reports are not passed over RPC.
+TVM_REGISTER_GLOBAL("tvm.hexagon.lwp_report").set_body_typed([](bool reset) {
+  return HexagonLWPReport(reset)->AsJSON();
+});
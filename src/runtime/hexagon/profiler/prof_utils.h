@@ -23,8 +23,22 @@
 #ifndef TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
 #define TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
 
+#include <tvm/runtime/profiling.h>
+
 #include <string>
 
 bool WriteLWPOutput(const std::string&);
 
+/*!
+ * \brief The LWP cycle counts as a profiling report.
+ *
+ * Every instrumented function and loop gets one row per call stack it was reached by, with its
+ * inclusive and exclusive cycles. The DMA and VTCM counters of the device are reported as device
+ * metrics of hexagon0. Like lwp.json, only the first 50 executions of every function and loop are
+ * timed, while "Total Count" counts all of them.
+ *
+ * \param reset Whether to clear the LWP buffers and the DMA and VTCM counters afterwards.
+ */
+tvm::runtime::profiling::Report HexagonLWPReport(bool reset);
+
 #endif  // TVM_RUNTIME_HEXAGON_PROFILER_PROF_UTILS_H_
@@ -0,0 +1,225 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/lwp.cc
+ * \brief Runtime support of the lightweight profiling instrumentation (`tir.instrument_lwp`).
+ */
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TVM_LWP_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+namespace {
+
+struct LWPEvent {
+  int32_t id;
+  int32_t is_end;
+  int64_t cycles;
+};
+
+/*! \brief The events recorded by one thread, the oldest ones are overwritten once it is full. */
+struct LWPRingBuffer {
+  static constexpr uint64_t kCapacity = 1 << 16;
+  std::vector<LWPEvent> events = std::vector<LWPEvent>(kCapacity);
+  /*! \brief The number of events recorded so far, only written by the owning thread. */
+  std::atomic<uint64_t> head{0};
+};
+
+/*! \brief The ring buffers of all the threads which recorded events. */
+struct LWPRegistry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<LWPRingBuffer>> buffers;
+
+  static LWPRegistry* Global() {
+    // Leaked on purpose, threads may still record events at exit.
+    static LWPRegistry* inst = new LWPRegistry();
+    return inst;
+  }
+};
+
+LWPRingBuffer* ThreadRingBuffer() {
+  thread_local std::shared_ptr<LWPRingBuffer> buffer = [] {
+    auto buf = std::make_shared<LWPRingBuffer>();
+    LWPRegistry* registry = LWPRegistry::Global();
+    std::lock_guard<std::mutex> lock(registry->mutex);
+    registry->buffers.push_back(buf);
+    return buf;
+  }();
+  return buffer.get();
+}
+
+/*! \brief Read the counter the instrumented code reads, see CodeGenCPU. */
+int64_t ReadCycleCounter() {
+#if defined(TVM_LWP_X86)
+  return static_cast<int64_t>(__rdtsc());
+#elif defined(__aarch64__)
+  int64_t cycles;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+  return cycles;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/*! \brief The frequency of the cycle counter, in Hz. */
+double CycleCounterFrequency() {
+  static double freq = [] {
+#if defined(TVM_LWP_X86)
+    // The time stamp counter runs at a constant rate, measure it.
+    auto start = std::chrono::steady_clock::now();
+    int64_t start_cycles = ReadCycleCounter();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    int64_t cycles = ReadCycleCounter() - start_cycles;
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    return cycles / seconds.count();
+#elif defined(__aarch64__)
+    int64_t freq;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+    return static_cast<double>(freq);
+#else
+    return 1e9;
+#endif
+  }();
+  return freq;
+}
+
+}  // namespace
+
+Report LWPReport(Optional<Module> mod, bool reset) {
+  struct Stats {
+    int64_t count{0};
+    int64_t cycles{0};
+  };
+  std::map<int32_t, Stats> stats;
+  // The cycles spent in the outermost regions, which do not overlap.
+  int64_t total_cycles = 0;
+  {
+    LWPRegistry* registry = LWPRegistry::Global();
+    std::lock_guard<std::mutex> lock(registry->mutex);
+    for (const auto& buf : registry->buffers) {
+      uint64_t head = buf->head.load(std::memory_order_acquire);
+      uint64_t begin = head > LWPRingBuffer::kCapacity ? head - LWPRingBuffer::kCapacity : 0;
+      // The starts of the regions not yet ended, innermost last.
+      std::vector<std::pair<int32_t, int64_t>> open;
+      for (uint64_t i = begin; i < head; ++i) {
+        const LWPEvent& event = buf->events[i % LWPRingBuffer::kCapacity];
+        if (!event.is_end) {
+          open.emplace_back(event.id, event.cycles);
+          continue;
+        }
+        auto it = std::find_if(open.rbegin(), open.rend(),
+                               [&](const auto& start) { return start.first == event.id; });
+        // The start of the region was overwritten.
+        if (it == open.rend()) continue;
+        int64_t cycles = event.cycles - it->second;
+        open.erase(std::prev(it.base()), open.end());
+        Stats& stat = stats[event.id];
+        stat.count += 1;
+        stat.cycles += cycles;
+        if (open.empty()) total_cycles += cycles;
+      }
+      if (reset) buf->head.store(0, std::memory_order_release);
+    }
+  }
+
+  double freq = CycleCounterFrequency();
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& kv : stats) {
+    Map<String, ObjectRef> row;
+    row.Set("Name", String("lwp_" + std::to_string(kv.first)));
+    row.Set("Device", String("cpu0"));
+    row.Set("Count", ObjectRef(make_object<CountNode>(kv.second.count)));
+    row.Set("Cycles", ObjectRef(make_object<CountNode>(kv.second.cycles)));
+    row.Set("Duration (us)", ObjectRef(make_object<DurationNode>(kv.second.cycles / freq * 1e6)));
+    double percent = total_cycles == 0 ? 0.0 : 100.0 * kv.second.cycles / total_cycles;
+    row.Set("Percent", ObjectRef(make_object<PercentNode>(percent)));
+    calls.push_back(row);
+  }
+
+  // The device modules keep their own counters.
+  if (mod.defined()) {
+    std::vector<Module> stack = {mod.value()};
+    std::unordered_set<const ModuleNode*> visited;
+    while (!stack.empty()) {
+      Module m = stack.back();
+      stack.pop_back();
+      if (!visited.insert(m.operator->()).second) continue;
+      PackedFunc f = m.GetFunction(symbol::tvm_lwp_read_counters);
+      if (f != nullptr) {
+        Array<Map<String, ObjectRef>> rows = f(reset);
+        for (const auto& row : rows) {
+          calls.push_back(row);
+        }
+      }
+      for (const Module& import : m->imports()) {
+        stack.push_back(import);
+      }
+    }
+  }
+
+  Map<String, ObjectRef> configuration;
+  configuration.Set("Cycle Counter Frequency (MHz)", String(std::to_string(freq / 1e6)));
+  return Report(calls, {}, configuration);
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.LWPReport").set_body_typed(LWPReport);
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+int TVMBackendProfileEvent(int32_t id, int32_t is_end, int64_t cycles) {
+  using tvm::runtime::profiling::LWPEvent;
+  using tvm::runtime::profiling::LWPRingBuffer;
+  if (cycles == -1) cycles = tvm::runtime::profiling::ReadCycleCounter();
+  LWPRingBuffer* buf = tvm::runtime::profiling::ThreadRingBuffer();
+  uint64_t head = buf->head.load(std::memory_order_relaxed);
+  buf->events[head % LWPRingBuffer::kCapacity] = LWPEvent{id, is_end, cycles};
+  buf->head.store(head + 1, std::memory_order_release);
+  return 0;
+}
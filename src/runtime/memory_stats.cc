@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file memory_stats.cc
+ * \brief Live accounting of the device memory held by the runtime.
+ */
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/memory_stats.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/trace.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+String DeviceKeyString(int device_type, int device_id) {
+  return String(DeviceName(device_type) + std::to_string(device_id));
+}
+
+ObjectRef MakeCount(int64_t value) { return ObjectRef(make_object<profiling::CountNode>(value)); }
+}  // namespace
+
+MemoryStats::MemoryStats() { tracing_ = std::getenv("TVM_MEMORY_TRACE") != nullptr; }
+
+MemoryStats* MemoryStats::Global() {
+  // Leaked on purpose: memory is freed by static destructors which may run after this one.
+  static MemoryStats* inst = new MemoryStats();
+  return inst;
+}
+
+void MemoryStats::RecordAlloc(Device dev, const char* owner, const void* ptr, size_t nbytes) {
+  TVM_TRACE(Alloc, nbytes, dev.device_type);
+  // Collect the stack outside of the lock, it is much slower than the accounting.
+  bool tracing = tracing_;
+  std::string stack = tracing ? Backtrace() : "";
+  std::lock_guard<std::mutex> lock(mu_);
+  for (Counter* counter : {&owners_[{dev.device_type, dev.device_id, owner}],
+                           &devices_[{dev.device_type, dev.device_id}]}) {
+    counter->current += nbytes;
+    counter->peak = std::max(counter->peak, counter->current);
+    counter->num_allocs += 1;
+  }
+  if (tracing) {
+    live_[ptr] = LiveAllocation{dev, owner, nbytes, std::move(stack)};
+  }
+}
+
+void MemoryStats::RecordFree(Device dev, const char* owner, const void* ptr, size_t nbytes) {
+  TVM_TRACE(Free, nbytes, dev.device_type);
+  std::lock_guard<std::mutex> lock(mu_);
+  for (Counter* counter : {&owners_[{dev.device_type, dev.device_id, owner}],
+                           &devices_[{dev.device_type, dev.device_id}]}) {
+    ICHECK_GE(counter->current, nbytes)
+        << "InternalError: freeing more memory than allocated on " << dev << " by " << owner;
+    counter->current -= nbytes;
+    counter->num_allocs -= 1;
+  }
+  live_.erase(ptr);
+}
+
+void MemoryStats::SetTracing(bool enable) {
+  std::lock_guard<std::mutex> lock(mu_);
+  tracing_ = enable;
+  if (!enable) live_.clear();
+}
+
+void MemoryStats::ResetPeak() {
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto& kv : owners_) kv.second.peak = kv.second.current;
+  for (auto& kv : devices_) kv.second.peak = kv.second.current;
+}
+
+profiling::Report MemoryStats::Report() {
+  Array<Map<String, ObjectRef>> calls;
+  Map<String, Map<String, ObjectRef>> device_metrics;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (const auto& kv : owners_) {
+      calls.push_back({{"Name", String(std::get<2>(kv.first))},
+                       {"Device", DeviceKeyString(std::get<0>(kv.first), std::get<1>(kv.first))},
+                       {"Current (bytes)", MakeCount(kv.second.current)},
+                       {"Peak (bytes)", MakeCount(kv.second.peak)},
+                       {"Allocations", MakeCount(kv.second.num_allocs)}});
+    }
+    for (const auto& kv : devices_) {
+      device_metrics.Set(DeviceKeyString(kv.first.first, kv.first.second),
+                         {{"Current (bytes)", MakeCount(kv.second.current)},
+                          {"Peak (bytes)", MakeCount(kv.second.peak)},
+                          {"Allocations", MakeCount(kv.second.num_allocs)}});
+    }
+    // Group the live allocations by owner, device and stack.
+    std::map<std::tuple<std::string, std::string, std::string>, Counter> sites;
+    for (const auto& kv : live_) {
+      const LiveAllocation& alloc = kv.second;
+      std::string device = DeviceKeyString(alloc.dev.device_type, alloc.dev.device_id);
+      Counter& site = sites[{alloc.owner, device, alloc.stack}];
+      site.current += alloc.nbytes;
+      site.num_allocs += 1;
+    }
+    for (const auto& kv : sites) {
+      calls.push_back({{"Name", String("live " + std::get<0>(kv.first))},
+                       {"Device", String(std::get<1>(kv.first))},
+                       {"Current (bytes)", MakeCount(kv.second.current)},
+                       {"Allocations", MakeCount(kv.second.num_allocs)},
+                       {"Stack", String(std::get<2>(kv.first))}});
+    }
+  }
+  // The VM allocators are optional, they report their pools if they are linked in.
+  if (const PackedFunc* f = Registry::Get("vm.memory_manager.PoolStats")) {
+    Array<Map<String, ObjectRef>> pools = (*f)();
+    for (const auto& pool : pools) {
+      calls.push_back(pool);
+    }
+  }
+  return profiling::Report(calls, device_metrics, {{"Tracing", String(tracing_ ? "on" : "off")}});
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.MemoryReport").set_body_typed([]() {
+  return MemoryStats::Global()->Report();
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.SetMemoryTracing").set_body_typed([](bool enable) {
+  MemoryStats::Global()->SetTracing(enable);
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.ResetMemoryPeak").set_body_typed([]() {
+  MemoryStats::Global()->ResetPeak();
+});
+
+}  // namespace runtime
+}  // namespace tvm
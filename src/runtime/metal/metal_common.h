@@ -28,8 +28,10 @@
 #import <Metal/MTLBuffer.h>
 #import <Metal/MTLCommandBuffer.h>
 #import <Metal/MTLCommandQueue.h>
+#import <Metal/MTLComputeCommandEncoder.h>
 #import <Metal/MTLDevice.h>
 #import <Metal/MTLLibrary.h>
+#include <dispatch/dispatch.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
@@ -102,27 +104,102 @@ class AutoReleasePoolWrapper {
 };
 
 /*!
- * \brief Structure for error handling in queues
+ * \brief Command queue of a device, batching the kernel launches and handling the errors.
+ *
+ * Consecutive kernel launches are encoded in a single compute encoder of a pending command
+ * buffer, which is committed when another command is issued on the stream, on synchronization,
+ * or once it holds kMaxBatchedDispatches dispatches. At most kMaxInFlight command buffers are
+ * committed and not completed at a time, so that the encoding on the CPU runs ahead of the GPU
+ * without queueing an unbounded amount of work.
  */
 class Stream {
  public:
+  /*! \brief The maximum number of dispatches encoded in one command buffer. */
+  static constexpr int kMaxBatchedDispatches = 64;
+  /*! \brief The maximum number of command buffers committed and not completed. */
+  static constexpr int kMaxInFlight = 3;
+
   explicit Stream(id<MTLDevice> device) : error_happened_(false) {
     queue_ = [device newCommandQueue];
+    in_flight_ = dispatch_semaphore_create(kMaxInFlight);
+  }
+  ~Stream() {
+    FlushCommandBuffer();
+    // wait for the command buffers in flight, which signal the semaphore on completion
+    for (int i = 0; i < kMaxInFlight; ++i) {
+      dispatch_semaphore_wait(in_flight_, DISPATCH_TIME_FOREVER);
+    }
+    for (int i = 0; i < kMaxInFlight; ++i) {
+      dispatch_semaphore_signal(in_flight_);
+    }
+    dispatch_release(in_flight_);
+    [queue_ release];
   }
-  ~Stream() { [queue_ release]; }
+  /*!
+   * \brief Get a new command buffer, after committing the pending kernel launches.
+   *  The command buffer counts as in flight until it completes, so it must be committed.
+   */
   id<MTLCommandBuffer> GetCommandBuffer() {
+    FlushCommandBuffer();
+    return NewCommandBuffer();
+  }
+  /*!
+   * \brief Get the compute encoder of the pending command buffer, to encode a kernel launch.
+   * \param pipeline The pipeline state of the kernel, only set when it changes.
+   */
+  id<MTLComputeCommandEncoder> GetComputeEncoder(id<MTLComputePipelineState> pipeline) {
+    if (pending_cb_ != nil && num_dispatches_ >= kMaxBatchedDispatches) {
+      FlushCommandBuffer();
+    }
+    if (pending_cb_ == nil) {
+      pending_cb_ = [NewCommandBuffer() retain];
+      pending_encoder_ = [[pending_cb_ computeCommandEncoder] retain];
+      pending_pipeline_ = nil;
+    }
+    if (pending_pipeline_ != pipeline) {
+      [pending_encoder_ setComputePipelineState:pipeline];
+      pending_pipeline_ = pipeline;
+    }
+    ++num_dispatches_;
+    return pending_encoder_;
+  }
+  /*! \brief Commit the pending kernel launches, without waiting for them. */
+  void FlushCommandBuffer() {
+    if (pending_cb_ == nil) return;
+    [pending_encoder_ endEncoding];
+    [pending_cb_ commit];
+    [pending_encoder_ release];
+    [pending_cb_ release];
+    pending_encoder_ = nil;
+    pending_cb_ = nil;
+    pending_pipeline_ = nil;
+    num_dispatches_ = 0;
+  }
+  bool HasErrorHappened() { return error_happened_; }
+
+ private:
+  id<MTLCommandBuffer> NewCommandBuffer() {
+    dispatch_semaphore_wait(in_flight_, DISPATCH_TIME_FOREVER);
     id<MTLCommandBuffer> cb = [queue_ commandBuffer];
+    dispatch_semaphore_t in_flight = in_flight_;
     [cb addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
       if (buffer.status == MTLCommandBufferStatusError) SetErrorStatus();
+      dispatch_semaphore_signal(in_flight);
     }];
     return cb;
   }
-  bool HasErrorHappened() { return error_happened_; }
-
- private:
   void SetErrorStatus() { error_happened_ = true; }
   // Queue
   id<MTLCommandQueue> queue_;
+  // Counts the command buffers which can still be created before one completes
+  dispatch_semaphore_t in_flight_;
+  // The command buffer and encoder of the kernel launches not committed yet
+  id<MTLCommandBuffer> pending_cb_{nil};
+  id<MTLComputeCommandEncoder> pending_encoder_{nil};
+  // The pipeline state last set on the pending encoder
+  id<MTLComputePipelineState> pending_pipeline_{nil};
+  // The number of dispatches in the pending encoder
+  int num_dispatches_{0};
   // Check if error happened in one previous run
   bool error_happened_;
 };
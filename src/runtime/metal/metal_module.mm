@@ -200,9 +200,8 @@ class MetalWrappedFunc {
       int blockSize = wl.block_dim(0) * wl.block_dim(1) * wl.block_dim(2);
       auto maxTotalThreadsPerThreadgroup = scache_[device_id].maxTotalThreadsPerThreadgroup;
       CHECK_LE(blockSize, maxTotalThreadsPerThreadgroup);
-      id<MTLCommandBuffer> cb = stream->GetCommandBuffer();
-      id<MTLComputeCommandEncoder> encoder = [cb computeCommandEncoder];
-      [encoder setComputePipelineState:scache_[device_id]];
+      // The launch is batched with the previous ones in the pending command buffer of the stream
+      id<MTLComputeCommandEncoder> encoder = stream->GetComputeEncoder(scache_[device_id]);
       for (size_t i = 0; i < num_buffer_args_; ++i) {
         void* buf = args[static_cast<int>(i)];
         [encoder setBuffer:(id<MTLBuffer>)(buf) offset:0 atIndex:i];
@@ -216,8 +215,6 @@ class MetalWrappedFunc {
       MTLSize dimGrid = MTLSizeMake(wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
       MTLSize dimBlock = MTLSizeMake(wl.block_dim(0), wl.block_dim(1), wl.block_dim(2));
       [encoder dispatchThreadgroups:dimGrid threadsPerThreadgroup:dimBlock];
-      [encoder endEncoding];
-      [cb commit];
     };
   }
 
@@ -58,9 +58,11 @@
 #include <CL/opencl.h>
 #endif
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -463,6 +465,8 @@ class OpenCLModuleNode : public OpenCLModuleNodeBase {
   explicit OpenCLModuleNode(std::string data, std::string fmt,
                             std::unordered_map<std::string, FunctionInfo> fmap, std::string source)
       : OpenCLModuleNodeBase(fmap), data_(data), fmt_(fmt), source_(source) {}
+  // destructor, waits for the background builds
+  ~OpenCLModuleNode();
 
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
   void SaveToFile(const std::string& file_name, const std::string& format) final;
@@ -478,6 +482,10 @@ class OpenCLModuleNode : public OpenCLModuleNodeBase {
                           const std::string& func_name, const KTRefEntry& e) override;
 
  private:
+  // build the program of a kernel for a device, need to hold build_lock_.
+  cl_program BuildProgram(int device_id, const std::string& func_name);
+  // build the programs of the kernels which are not called yet, in a background thread.
+  void BackgroundBuild(int device_id);
   // the binary data
   std::string data_;
   // The format
@@ -486,6 +494,10 @@ class OpenCLModuleNode : public OpenCLModuleNodeBase {
   std::string source_;
   // parsed kernel data
   std::unordered_map<std::string, std::string> parsed_kernels_;
+  // the background build thread of each device, started on the first kernel install.
+  std::unordered_map<int, std::thread> background_builds_;
+  // whether the background builds should stop.
+  std::atomic<bool> stop_background_builds_{false};
 };
 
 /*! \brief OpenCL timer node */
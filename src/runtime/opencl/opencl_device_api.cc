@@ -569,6 +569,15 @@ TVM_REGISTER_GLOBAL("device_api.opencl.free_nd").set_body([](TVMArgs args, TVMRe
   *rv = static_cast<int32_t>(0);
 });
 
+TVM_REGISTER_GLOBAL("device_api.opencl.set_texture_pool_limit")
+    .set_body_typed([](int64_t nbytes) {
+      OpenCLWorkspace::Global()->GetThreadEntry()->texture_pool.SetMemoryLimit(nbytes);
+    });
+
+TVM_REGISTER_GLOBAL("device_api.opencl.release_free_textures").set_body_typed([](Device dev) {
+  OpenCLWorkspace::Global()->GetThreadEntry()->texture_pool.ReleaseFree(dev);
+});
+
 TVM_REGISTER_GLOBAL("device_api.opencl").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = OpenCLWorkspace::Global();
   *rv = static_cast<void*>(ptr);
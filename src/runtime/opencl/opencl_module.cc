@@ -23,8 +23,14 @@
 #include "opencl_module.h"
 
 #include <dmlc/memory_io.h>
+#include <sys/stat.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -108,6 +114,121 @@ class OpenCLWrappedFunc {
   LaunchParamConfig launch_param_config_;
 };
 
+namespace cl {
+std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
+}  // namespace cl
+
+namespace {
+
+std::mutex program_cache_dir_mutex;
+
+/*! \brief The directory of the program binary cache, empty when the cache is disabled. */
+std::string& ProgramCacheDirRef() {
+  static std::string cache_dir = [] {
+    const char* dir = getenv("TVM_OPENCL_PROGRAM_CACHE_DIR");
+    return std::string(dir != nullptr ? dir : "");
+  }();
+  return cache_dir;
+}
+
+std::string GetProgramCacheDir() {
+  std::lock_guard<std::mutex> lock(program_cache_dir_mutex);
+  return ProgramCacheDirRef();
+}
+
+void SetProgramCacheDir(std::string cache_dir) {
+  std::lock_guard<std::mutex> lock(program_cache_dir_mutex);
+  ProgramCacheDirRef() = cache_dir;
+}
+
+/*! \brief Get the binary of a program built for the given device. */
+std::vector<unsigned char> GetProgramBinary(cl_program program, cl_device_id dev) {
+  cl_uint num_devices;
+  OPENCL_CALL(clGetProgramInfo(program, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &num_devices,
+                               nullptr));
+  std::vector<cl_device_id> devices(num_devices);
+  OPENCL_CALL(clGetProgramInfo(program, CL_PROGRAM_DEVICES, sizeof(cl_device_id) * num_devices,
+                               devices.data(), nullptr));
+  std::vector<size_t> sizes(num_devices);
+  OPENCL_CALL(clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t) * num_devices,
+                               sizes.data(), nullptr));
+  // The binaries are only returned for the devices with a non-null destination.
+  std::vector<std::vector<unsigned char>> binaries(num_devices);
+  std::vector<unsigned char*> pointers(num_devices, nullptr);
+  for (cl_uint i = 0; i < num_devices; ++i) {
+    if (devices[i] == dev) {
+      binaries[i].resize(sizes[i]);
+      pointers[i] = binaries[i].data();
+    }
+  }
+  OPENCL_CALL(clGetProgramInfo(program, CL_PROGRAM_BINARIES,
+                               sizeof(unsigned char*) * num_devices, pointers.data(), nullptr));
+  for (cl_uint i = 0; i < num_devices; ++i) {
+    if (devices[i] == dev) return binaries[i];
+  }
+  return {};
+}
+
+/*!
+ * \brief On-device cache of the OpenCL program binaries.
+ *
+ * The binary of a program is stored in the cache directory after its first build from source,
+ * keyed by the hash of the device name, the driver version and the kernel source, so that a
+ * driver update invalidates the entries. The key is stored along with the binary to guard
+ * against hash collisions.
+ */
+class OpenCLProgramCache {
+ public:
+  OpenCLProgramCache(const std::string& cache_dir, cl_device_id dev, const std::string& source)
+      : key_(cl::GetDeviceInfo(dev, CL_DEVICE_NAME) + "\n" +
+             cl::GetDeviceInfo(dev, CL_DRIVER_VERSION) + "\n" + source) {
+#ifndef _WIN32
+    mkdir(cache_dir.c_str(), 0777);
+#endif
+    // 64-bit FNV-1a, as std::hash is not stable across the runs.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : key_) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    std::ostringstream path;
+    path << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0') << hash
+         << ".clbin";
+    path_ = path.str();
+  }
+
+  /*! \brief Load the cached binary, return whether it is found. */
+  bool Lookup(std::vector<unsigned char>* binary) const {
+    if (!std::ifstream(path_).good()) return false;
+    std::string data;
+    LoadBinaryFromFile(path_, &data);
+    dmlc::MemoryStringStream reader(&data);
+    std::string key;
+    return reader.Read(&key) && key == key_ && reader.Read(binary) && !binary->empty();
+  }
+
+  /*! \brief Store the binary built from the source. */
+  void Store(const std::vector<unsigned char>& binary) const {
+    if (binary.empty()) return;
+    std::string data;
+    dmlc::MemoryStringStream writer(&data);
+    writer.Write(key_);
+    writer.Write(binary);
+    // Write to a unique name and rename, so that concurrent runs never see partial files.
+    std::ostringstream tmp;
+    tmp << path_ << ".tmp." << std::hex << std::random_device()();
+    SaveBinaryToFile(tmp.str(), data);
+    std::rename(tmp.str().c_str(), path_.c_str());
+  }
+
+ private:
+  /*! \brief The device name and driver version followed by the kernel source. */
+  std::string key_;
+  /*! \brief The path of the entry. */
+  std::string path_;
+};
+
+}  // namespace
+
 OpenCLModuleNodeBase::~OpenCLModuleNodeBase() {
   {
     // free the kernel ids in global table.
@@ -214,45 +335,95 @@ void OpenCLModuleNode::Init() {
   }
 }
 
+OpenCLModuleNode::~OpenCLModuleNode() {
+  stop_background_builds_ = true;
+  for (auto& kv : background_builds_) {
+    kv.second.join();
+  }
+}
+
+cl_program OpenCLModuleNode::BuildProgram(int device_id, const std::string& func_name) {
+  cl_device_id dev = workspace_->GetCLDeviceID(device_id);
+  cl_context context = workspace_->contexts[workspace_->device_to_platform[dev]];
+  cl_program program = nullptr;
+  cl_int err;
+  std::unique_ptr<OpenCLProgramCache> cache;
+  // create program
+  if (fmt_ == "cl") {
+    const std::string& source = parsed_kernels_[func_name];
+    std::string cache_dir = GetProgramCacheDir();
+    if (!cache_dir.empty()) {
+      cache = std::make_unique<OpenCLProgramCache>(cache_dir, dev, source);
+      std::vector<unsigned char> binary;
+      if (cache->Lookup(&binary)) {
+        const unsigned char* s = binary.data();
+        size_t len = binary.size();
+        cl_int status;
+        program = clCreateProgramWithBinary(context, 1, &dev, &len, &s, &status, &err);
+        if (err == CL_SUCCESS && status == CL_SUCCESS &&
+            clBuildProgram(program, 1, &dev, nullptr, nullptr, nullptr) == CL_SUCCESS) {
+          return program;
+        }
+        // The entry is rejected by the driver, rebuild from the source and overwrite it.
+        if (program != nullptr) {
+          OPENCL_CALL(clReleaseProgram(program));
+        }
+      }
+    }
+    const char* s = source.c_str();
+    size_t len = source.length();
+    program = clCreateProgramWithSource(context, 1, &s, &len, &err);
+    OPENCL_CHECK_ERROR(err);
+  } else if (fmt_ == "xclbin" || fmt_ == "awsxclbin" || fmt_ == "aocx") {
+    const unsigned char* s = (const unsigned char*)data_.c_str();
+    size_t len = data_.length();
+    program = clCreateProgramWithBinary(context, 1, &dev, &len, &s, nullptr, &err);
+    OPENCL_CHECK_ERROR(err);
+  } else {
+    LOG(FATAL) << "Unknown OpenCL format " << fmt_;
+  }
+  // build program
+  err = clBuildProgram(program, 1, &dev, nullptr, nullptr, nullptr);
+  if (err != CL_SUCCESS) {
+    size_t len;
+    std::string log;
+    clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, 0, nullptr, &len);
+    log.resize(len);
+    clGetProgramBuildInfo(program, dev, CL_PROGRAM_BUILD_LOG, len, &log[0], nullptr);
+    LOG(FATAL) << "OpenCL build error for device=" << dev << "\n" << log;
+  }
+  if (cache != nullptr) {
+    cache->Store(GetProgramBinary(program, dev));
+  }
+  return program;
+}
+
+void OpenCLModuleNode::BackgroundBuild(int device_id) {
+  for (const auto& kv : parsed_kernels_) {
+    if (stop_background_builds_) return;
+    std::lock_guard<std::mutex> lock(build_lock_);
+    if (programs_[kv.first][device_id] != nullptr) continue;
+    try {
+      programs_[kv.first][device_id] = BuildProgram(device_id, kv.first);
+    } catch (const std::exception& e) {
+      // Leave the program to the first call of the kernel, which reports the error.
+      LOG(WARNING) << "OpenCL background build of " << kv.first << " failed: " << e.what();
+    }
+  }
+}
+
 cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThreadEntry* t,
                                           const std::string& func_name, const KTRefEntry& e) {
   std::lock_guard<std::mutex> lock(build_lock_);
   int device_id = t->device.device_id;
-  auto did = w->GetCLDeviceID(device_id);
-  auto platform = w->device_to_platform[did];
   if (programs_[func_name][device_id] == nullptr) {
-    // create program
-    if (fmt_ == "cl") {
-      const char* s = parsed_kernels_[func_name].c_str();
-      size_t len = parsed_kernels_[func_name].length();
-      cl_int err;
-      programs_[func_name][device_id] =
-          clCreateProgramWithSource(w->contexts[platform], 1, &s, &len, &err);
-      OPENCL_CHECK_ERROR(err);
-    } else if (fmt_ == "xclbin" || fmt_ == "awsxclbin" || fmt_ == "aocx") {
-      const unsigned char* s = (const unsigned char*)data_.c_str();
-      size_t len = data_.length();
-      cl_int err;
-      cl_device_id dev = w->devices[device_id];
-      programs_[func_name][device_id] =
-          clCreateProgramWithBinary(w->contexts[platform], 1, &dev, &len, &s, nullptr, &err);
-      OPENCL_CHECK_ERROR(err);
-    } else {
-      LOG(FATAL) << "Unknown OpenCL format " << fmt_;
-    }
-    // build program
-    cl_int err;
-    cl_device_id dev = w->devices[device_id];
-    err = clBuildProgram(programs_[func_name][device_id], 1, &dev, nullptr, nullptr, nullptr);
-    if (err != CL_SUCCESS) {
-      size_t len;
-      std::string log;
-      clGetProgramBuildInfo(programs_[func_name][device_id], dev, CL_PROGRAM_BUILD_LOG, 0, nullptr,
-                            &len);
-      log.resize(len);
-      clGetProgramBuildInfo(programs_[func_name][device_id], dev, CL_PROGRAM_BUILD_LOG, len,
-                            &log[0], nullptr);
-      LOG(FATAL) << "OpenCL build error for device=" << dev << "\n" << log;
+    programs_[func_name][device_id] = BuildProgram(device_id, func_name);
+    // With the program cache, the other kernels are built ahead of their first call, so that
+    // the cold builds overlap with the execution and are cached for the later runs.
+    if (fmt_ == "cl" && parsed_kernels_.size() > 1 && !GetProgramCacheDir().empty() &&
+        !background_builds_.count(device_id)) {
+      background_builds_[device_id] = std::thread(&OpenCLModuleNode::BackgroundBuild, this,
+                                                  device_id);
     }
   }
   // build kernel
@@ -273,6 +444,7 @@ void OpenCLModuleNode::SetPreCompiledPrograms(const std::string& bytes) {
   strm->Read(&kernels_num);
   cl::OpenCLThreadEntry* t = workspace_->GetThreadEntry();
   int device_id = t->device.device_id;
+  std::lock_guard<std::mutex> lock(build_lock_);
   for (size_t i = 0; i < kernels_num; ++i) {
     std::string name;
     std::vector<unsigned char> bin_vector;
@@ -320,14 +492,9 @@ std::string OpenCLModuleNode::GetPreCompiledPrograms() {
     if (programs_[std::string(name)][device_id] == nullptr) {
       InstallKernel(workspace_, t, name, kid_map_[name]);
     }
-    size_t size;
-    clGetProgramInfo(programs_[name][device_id], CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &size,
-                     nullptr);
-    ICHECK(size > 0) << "Size of binary is 0";
-    std::vector<unsigned char> bin_vector(size);
-    unsigned char* binary = bin_vector.data();
-    clGetProgramInfo(programs_[name][device_id], CL_PROGRAM_BINARIES, sizeof(unsigned char*),
-                     &binary, nullptr);
+    std::vector<unsigned char> bin_vector =
+        GetProgramBinary(programs_[name][device_id], workspace_->GetCLDeviceID(device_id));
+    ICHECK(bin_vector.size() > 0) << "Size of binary is 0";
 
     strm->Write(name);
     strm->Write(bin_vector);
@@ -379,6 +546,8 @@ Module OpenCLModuleLoadBinary(void* strm) {
   return OpenCLModuleCreate(data, fmt, fmap, std::string());
 }
 
+TVM_REGISTER_GLOBAL("runtime.opencl.SetProgramCacheDir").set_body_typed(SetProgramCacheDir);
+
 TVM_REGISTER_GLOBAL("runtime.module.loadfile_cl").set_body_typed(OpenCLModuleLoadFile);
 
 TVM_REGISTER_GLOBAL("runtime.module.loadfile_clbin").set_body_typed(OpenCLModuleLoadFile);
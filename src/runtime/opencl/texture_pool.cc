@@ -21,92 +21,114 @@
  * \file texture_pool.h
  * \brief Texture pool utility.
  */
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <memory>
+#include <string>
 
 #include "../texture.h"
 
 namespace tvm {
 namespace runtime {
 
+namespace {
+/*! \brief The size in bytes of a RGBA texture. */
+size_t TextureBytes(size_t width, size_t height, DLDataType type) {
+  return width * height * 4 * ((type.bits + 7) / 8);
+}
+}  // namespace
+
 void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
                     DLDataType type_hint) {
   Entry e;
-  Entry new_mem;
+  e.data = nullptr;
   // Processed several experiments and found that when we are trying to fit
   // small texture to too big texture then it may lead to the performance
   // degradation.
   // Coefficient at 5 looks like robust variant for reusing textures.
-  const int64_t max_ratio = 5;
-  e.data = nullptr;
-  std::vector<Entry>::iterator best_mem;
-  if (free_list_.size() != 0) {
-    int64_t min_added_size_x = std::numeric_limits<int64_t>::max();
-    int64_t min_added_size_y = std::numeric_limits<int64_t>::max();
-    int64_t min_wasted_size_x = std::numeric_limits<int64_t>::max();
-    int64_t min_wasted_size_y = std::numeric_limits<int64_t>::max();
-    for (auto it = free_list_.begin(); it != free_list_.end(); ++it) {
-      if (it->type.code != type_hint.code) {
-        continue;
-      }
-      // avoid reusing too small and too big textures
-      if (width / it->x > max_ratio || it->x / width > max_ratio || height / it->y > max_ratio ||
-          it->y / height > max_ratio) {
-        continue;
+  const size_t max_ratio = 5;
+  const size_t area = width * height;
+  // The best free texture which fits the request, minimizing the wasted area.
+  auto best_fit = free_list_.end();
+  size_t min_wasted_area = std::numeric_limits<size_t>::max();
+  // The best free texture to grow to fit the request, minimizing the added area.
+  auto best_grow = free_list_.end();
+  size_t min_added_area = std::numeric_limits<size_t>::max();
+  for (auto it = free_list_.begin(); it != free_list_.end(); ++it) {
+    // the channel type of the image depends on both of the code and the bits
+    if (it->type.code != type_hint.code || it->type.bits != type_hint.bits) {
+      continue;
+    }
+    // avoid reusing too small and too big textures
+    if (width / it->x > max_ratio || it->x / width > max_ratio || height / it->y > max_ratio ||
+        it->y / height > max_ratio) {
+      continue;
+    }
+    if (it->x >= width && it->y >= height) {
+      size_t wasted_area = it->x * it->y - area;
+      if (wasted_area < min_wasted_area) {
+        min_wasted_area = wasted_area;
+        best_fit = it;
       }
-      int64_t new_width = std::max(it->x, width);
-      int64_t new_height = std::max(it->y, height);
-      int64_t added_size_x = new_width - it->x;
-      int64_t added_size_y = new_height - it->y;
-      int64_t wasted_size_x = new_width - width;
-      int64_t wasted_size_y = new_height - height;
-      // Minimize added size first and wasted size thereafter
-      if ((min_added_size_x > 0 && added_size_x < min_added_size_x) ||
-          (min_added_size_y > 0 && added_size_y < min_added_size_y) ||
-          (min_added_size_x == added_size_x && wasted_size_x < min_wasted_size_x) ||
-          (min_added_size_y == added_size_y && wasted_size_y < min_wasted_size_y)) {
-        min_added_size_x = added_size_x;
-        min_added_size_y = added_size_y;
-        min_wasted_size_x = wasted_size_x;
-        min_wasted_size_y = wasted_size_y;
-        best_mem = it;
-        new_mem.x = new_width;
-        new_mem.y = new_height;
+    } else {
+      size_t added_area = std::max(it->x, width) * std::max(it->y, height) - it->x * it->y;
+      if (added_area < min_added_area) {
+        min_added_area = added_area;
+        best_grow = it;
       }
     }
-
-    if (min_added_size_x == 0 && min_added_size_y == 0) {
-      // use existing block
-      e = *best_mem;
-      free_list_.erase(best_mem);
-    } else if (static_cast<size_t>(min_added_size_x) <= width ||
-               static_cast<size_t>(min_added_size_y) <= height) {
-      // if added size is less or equal to
-      // what is needed by alloc, then grow entry
-      device->FreeDataSpace(dev, best_mem->data);
-      free_list_.erase(best_mem);
-      new_mem.type = type_hint;
-      std::vector<int64_t> shape{int64_t(new_mem.y), int64_t(new_mem.x), 4};
-      new_mem.data = device->AllocDataSpace(dev, shape.size(), shape.data(), new_mem.type,
-                                            Optional<String>("global.texture"));
-      e = new_mem;
-    }
   }
 
-  if (e.data == nullptr) {
+  if (best_fit != free_list_.end()) {
+    // use existing block
+    e = *best_fit;
+    free_list_.erase(best_fit);
+  } else {
+    size_t new_width = width;
+    size_t new_height = height;
+    // if added area is less or equal to what is needed by alloc, then grow
+    // entry instead of creating a new one
+    if (best_grow != free_list_.end() && min_added_area <= area) {
+      new_width = std::max(best_grow->x, width);
+      new_height = std::max(best_grow->y, height);
+      FreeEntry(dev, device, *best_grow);
+      free_list_.erase(best_grow);
+    }
+    // Make room for the new texture within the memory limit by releasing the
+    // free textures, the largest first.
+    size_t new_bytes = TextureBytes(new_width, new_height, type_hint);
+    while (memory_limit_ != 0 && !free_list_.empty() && used_bytes_ + new_bytes > memory_limit_) {
+      auto largest = std::max_element(
+          free_list_.begin(), free_list_.end(), [](const Entry& a, const Entry& b) {
+            return TextureBytes(a.x, a.y, a.type) < TextureBytes(b.x, b.y, b.type);
+          });
+      FreeEntry(dev, device, *largest);
+      free_list_.erase(largest);
+    }
+    if (memory_limit_ != 0 && used_bytes_ + new_bytes > memory_limit_) {
+      LOG(WARNING) << "The texture pool exceeds its memory limit of " << memory_limit_
+                   << " bytes, with " << used_bytes_ + new_bytes << " bytes in use";
+    }
     // create new block
-    std::vector<int64_t> shape{int64_t(height), int64_t(width), 4};
+    std::vector<int64_t> shape{int64_t(new_height), int64_t(new_width), 4};
     e.data = device->AllocDataSpace(dev, shape.size(), shape.data(), type_hint,
                                     Optional<String>("global.texture"));
-    e.x = width;
-    e.y = height;
+    e.x = new_width;
+    e.y = new_height;
     e.type = type_hint;
+    used_bytes_ += new_bytes;
   }
 
   allocated_.push_back(e);
   return e.data;
 }
 
+void Pool2D::FreeEntry(Device dev, DeviceAPI* device, const Entry& e) {
+  device->FreeDataSpace(dev, e.data);
+  used_bytes_ -= TextureBytes(e.x, e.y, e.type);
+}
+
 void Pool2D::Free(void* data) {
   Entry e;
   if (allocated_.back().data == data) {
@@ -134,10 +156,22 @@ void Pool2D::Release(Device dev, DeviceAPI* device) {
   }
   allocated_.clear();
   free_list_.clear();
+  used_bytes_ = 0;
+}
+
+void Pool2D::ReleaseFree(Device dev, DeviceAPI* device) {
+  for (auto& e : free_list_) {
+    FreeEntry(dev, device, e);
+  }
+  free_list_.clear();
 }
 
 TexturePool::TexturePool(DLDeviceType device_type, DeviceAPI* device)
-    : device_type_(device_type), device_(device) {}
+    : device_type_(device_type), device_(device) {
+  if (const char* limit = getenv("TVM_TEXTURE_POOL_LIMIT")) {
+    memory_limit_ = std::stoull(limit);
+  }
+}
 
 TexturePool::~TexturePool() {
   for (size_t i = 0; i < array_.size(); ++i) {
@@ -157,6 +191,7 @@ void* TexturePool::AllocTexture(Device dev, size_t width, size_t height, DLDataT
   }
   if (array_[dev.device_id] == nullptr) {
     array_[dev.device_id] = new Pool2D();
+    array_[dev.device_id]->SetMemoryLimit(memory_limit_);
   }
   return array_[dev.device_id]->Alloc(dev, device_, width, height, type_hint);
 }
@@ -167,5 +202,20 @@ void TexturePool::FreeTexture(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+void TexturePool::SetMemoryLimit(size_t nbytes) {
+  memory_limit_ = nbytes;
+  for (Pool2D* pool : array_) {
+    if (pool != nullptr) {
+      pool->SetMemoryLimit(nbytes);
+    }
+  }
+}
+
+void TexturePool::ReleaseFree(Device dev) {
+  if (static_cast<size_t>(dev.device_id) < array_.size() && array_[dev.device_id] != nullptr) {
+    array_[dev.device_id]->ReleaseFree(dev, device_);
+  }
+}
+
 }  // namespace runtime
 }  // namespace tvm
@@ -24,12 +24,20 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/threading_backend.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdlib>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -121,16 +129,64 @@ struct ModuleIDHash {
 /*!\brief The data notification structure.*/
 class DataNotify {
  private:
-  /*!\brief The 'contitional variable' is used to wait for notification.*/
+  /*!\brief The default upper bound of the adaptive spin budget of 'Wait'.*/
+  static constexpr uint32_t kDefaultMaxSpinCount = 1 << 14;
+  /*!\brief The lower bound of the adaptive spin budget of 'Wait'.*/
+  static constexpr uint32_t kMinSpinCount = 16;
+  /*!
+   * \brief The number of notifications not consumed yet. A single 'Wait' consumes all of
+   *  them, so the data pushed by several notifications is handed off with one wake-up.
+   *  It is also the futex word the waiting thread sleeps on.
+   */
+  std::atomic<uint32_t> pending_{0};
+  /*!\brief Whether the waiting thread is about to sleep, or sleeping.*/
+  std::atomic<bool> sleeping_{false};
+  /*!\brief The current spin budget, adapted to how fast the notifications arrive.*/
+  uint32_t spin_count_ = kMinSpinCount;
+#ifndef __linux__
+  /*!\brief The 'contitional variable' is used to sleep without a futex.*/
   std::condition_variable notify_cv_;
   /*!\brief The mutex is used to protect the 'conditional variable'.*/
   std::mutex mutex_;
-  /*!\brief Whether a data is ready or not.*/
-  bool data_ready_ = false;
+#endif
   /*!\brief Whether the thread should exit or not.*/
   std::atomic<bool> exit_state_{false};
   /*!\brief The 'ModuleInterfaceID' of an interface which sent this notification.*/
   ModuleInterfaceID notification_source_;
+  /*!\brief Getting the upper bound of the spin budget, from 'TVM_PIPELINE_SPIN_COUNT'.*/
+  static uint32_t MaxSpinCount() {
+    static uint32_t max_spin_count = [] {
+      const char* val = getenv("TVM_PIPELINE_SPIN_COUNT");
+      return val == nullptr ? kDefaultMaxSpinCount : static_cast<uint32_t>(atoi(val));
+    }();
+    return max_spin_count;
+  }
+  /*!\brief Consuming all the pending notifications, returning whether there were any.*/
+  bool TryConsume() {
+    return pending_.load(std::memory_order_relaxed) != 0 &&
+           pending_.exchange(0, std::memory_order_acquire) != 0;
+  }
+  /*!\brief Sleeping until 'pending_' is no longer zero.*/
+  void Sleep() {
+#ifdef __linux__
+    static_assert(sizeof(pending_) == sizeof(uint32_t), "The futex word must be 32 bits");
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&pending_), FUTEX_WAIT_PRIVATE, 0, nullptr,
+            nullptr, 0);
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+    notify_cv_.wait(lock, [&] { return pending_.load(std::memory_order_acquire) != 0; });
+#endif
+  }
+  /*!\brief Waking up the sleeping thread.*/
+  void Wake() {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&pending_), FUTEX_WAKE_PRIVATE, 1, nullptr,
+            nullptr, 0);
+#else
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    notify_cv_.notify_one();
+#endif
+  }
 
  public:
   /*!
@@ -148,22 +204,37 @@ class DataNotify {
   ModuleInterfaceID GetNotifySource(void) { return notification_source_; }
   /*!
    *\brief Waiting for the notification.
+   *
+   * The thread spins first and only sleeps when nothing arrives within its spin budget.
+   * The budget doubles each time a notification arrives while spinning and halves each
+   * time the thread has to sleep, so busy pipelines stay out of the kernel while idle ones
+   * do not burn a core.
    *\return Returning the value 'false' when the notification is in a 'exit' state, else
    * return true.
    */
   bool Wait(void) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    notify_cv_.wait(lock, [&] { return this->data_ready_; });
-    data_ready_ = false;
+    for (uint32_t i = 0; i < spin_count_; ++i) {
+      if (TryConsume()) {
+        spin_count_ = std::min(spin_count_ * 2, std::max(MaxSpinCount(), kMinSpinCount));
+        return !GetExitState();
+      }
+      tvm::runtime::threading::Yield();
+    }
+    spin_count_ = std::max(spin_count_ / 2, kMinSpinCount);
+    while (!TryConsume()) {
+      sleeping_.store(true, std::memory_order_seq_cst);
+      // Checking again after publishing 'sleeping_', the notifier either sees it or its
+      // notification is seen here.
+      if (pending_.load(std::memory_order_seq_cst) == 0) Sleep();
+      sleeping_.store(false, std::memory_order_relaxed);
+    }
     return !GetExitState();
   }
   /*!brief Sending the notification in which the related data is ready.*/
   void Notify(void) {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      data_ready_ = true;
-    }
-    notify_cv_.notify_one();
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    // Only going into the kernel when the waiting thread stopped spinning.
+    if (sleeping_.load(std::memory_order_seq_cst)) Wake();
   }
   /*!brief Sending the notification when the notification state changes into 'exit'.*/
   void ExitNotify(void) {
@@ -756,6 +827,7 @@ class BasicRuntime {
                   << " into stop.";
         return false;
       }
+      tvm::runtime::threading::Yield();
     }
     child_runtime->ParentNotify(child_input_index);
     return true;
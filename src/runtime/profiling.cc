@@ -129,8 +129,11 @@ Profiler::Profiler(std::vector<Device> devs, std::vector<MetricCollector> metric
   for (auto& x : collectors_) {
     x->Init(wrapped_devs);
   }
-  // reset the thread pool so that PAPI eventset hooks are set in all threads.
-  threading::ResetThreadPool();
+  // reset the thread pool so that PAPI eventset hooks are set in all threads. It is only
+  // needed by collectors, and expensive enough to skip for profilers created per run.
+  if (!collectors_.empty()) {
+    threading::ResetThreadPool();
+  }
 
   configuration_[String("Number of threads")] =
       ObjectRef(make_object<CountNode>(threading::NumThreads()));
@@ -382,6 +385,67 @@ String ReportNode::AsJSON() const {
   return s.str();
 }
 
+namespace {
+double metric_as_double(ObjectRef o) {
+  if (const CountNode* n = o.as<CountNode>()) {
+    return static_cast<double>(n->value);
+  } else if (const DurationNode* n = o.as<DurationNode>()) {
+    return n->microseconds;
+  } else if (const PercentNode* n = o.as<PercentNode>()) {
+    return n->percent;
+  } else if (const RatioNode* n = o.as<RatioNode>()) {
+    return n->ratio;
+  }
+  LOG(FATAL) << "Metric of type " << o->GetTypeKey() << " is not a number";
+  return 0;
+}
+}  // namespace
+
+String ReportNode::AsChromeTrace() const {
+  std::ostringstream s;
+  s << std::setprecision(std::numeric_limits<double>::max_digits10) << std::fixed;
+  // Each device gets a process in the trace, named by a metadata event.
+  std::unordered_map<std::string, int> pids;
+  // End of the last call of each device, to lay out the calls without a timestamp.
+  std::unordered_map<std::string, double> cursors;
+  s << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& call : calls) {
+    std::string device = call.count("Device") ? std::string(Downcast<String>(call["Device"])) : "";
+    if (!pids.count(device)) {
+      int pid = static_cast<int>(pids.size());
+      pids[device] = pid;
+      s << (first ? "" : ",") << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\"" << device << "\"}}";
+      first = false;
+    }
+    double dur = call.count("Duration (us)") ? metric_as_double(call["Duration (us)"]) : 0;
+    double ts = cursors[device];
+    if (call.count("Start (us)")) {
+      ts = metric_as_double(call["Start (us)"]);
+      if (call.count("End (us)")) {
+        dur = metric_as_double(call["End (us)"]) - ts;
+      }
+    }
+    cursors[device] = std::max(cursors[device], ts + dur);
+    std::string name = call.count("Name") ? std::string(Downcast<String>(call["Name"])) : "";
+    s << ",{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur
+      << ",\"pid\":" << pids[device] << ",\"tid\":0,\"args\":{";
+    size_t j = 0;
+    for (const auto& kv : call) {
+      s << (j++ ? "," : "") << "\"" << kv.first << "\":";
+      if (kv.second.as<StringObj>()) {
+        s << "\"" << Downcast<String>(kv.second) << "\"";
+      } else {
+        s << metric_as_double(kv.second);
+      }
+    }
+    s << "}}";
+  }
+  s << "]}";
+  return s.str();
+}
+
 // Aggregate a set of values for a metric. Computes sum for Duration, Count,
 // and Percent; average for Ratio; and assumes all Strings are the same. All
 // ObjectRefs in metrics must have the same type.
@@ -793,11 +857,75 @@ TVM_REGISTER_GLOBAL("runtime.profiling.AsCSV").set_body_typed([](Report n) { ret
 TVM_REGISTER_GLOBAL("runtime.profiling.AsJSON").set_body_typed([](Report n) {
   return n->AsJSON();
 });
+TVM_REGISTER_GLOBAL("runtime.profiling.AsChromeTrace").set_body_typed([](Report n) {
+  return n->AsChromeTrace();
+});
 TVM_REGISTER_GLOBAL("runtime.profiling.FromJSON").set_body_typed(Report::FromJSON);
 TVM_REGISTER_GLOBAL("runtime.profiling.DeviceWrapper").set_body_typed([](Device dev) {
   return DeviceWrapper(dev);
 });
 
+/*! \brief The state of a call in flight in the TimelineCollector. */
+struct TimelineFrameNode : public Object {
+  Device dev;
+  double start_us;
+
+  static constexpr const char* _type_key = "runtime.profiling.TimelineFrame";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TimelineFrameNode, Object);
+};
+
+/*! \brief MetricCollector recording the start and end timestamps of every call. */
+class TimelineCollectorNode final : public MetricCollectorNode {
+ public:
+  explicit TimelineCollectorNode(bool sync) : sync_(sync) {}
+
+  void Init(Array<DeviceWrapper> devs) final { started_ = false; }
+
+  ObjectRef Start(Device dev) final {
+    if (!started_) {
+      origin_ = std::chrono::steady_clock::now();
+      started_ = true;
+    }
+    auto frame = make_object<TimelineFrameNode>();
+    frame->dev = dev;
+    frame->start_us = Now(dev);
+    return ObjectRef(frame);
+  }
+
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const auto* frame = obj.as<TimelineFrameNode>();
+    ICHECK(frame != nullptr) << "TimelineCollector stopped a call it did not start";
+    double end_us = Now(frame->dev);
+    return {{"Start (us)", ObjectRef(make_object<DurationNode>(frame->start_us))},
+            {"End (us)", ObjectRef(make_object<DurationNode>(end_us))}};
+  }
+
+  static constexpr const char* _type_key = "runtime.profiling.TimelineCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TimelineCollectorNode, MetricCollectorNode);
+
+ private:
+  double Now(Device dev) {
+    if (sync_) {
+      TVMSynchronize(dev.device_type, dev.device_id, nullptr);
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin_)
+        .count();
+  }
+
+  bool sync_;
+  bool started_{false};
+  std::chrono::steady_clock::time_point origin_;
+};
+
+TVM_REGISTER_OBJECT_TYPE(TimelineFrameNode);
+TVM_REGISTER_OBJECT_TYPE(TimelineCollectorNode);
+
+MetricCollector CreateTimelineCollector(bool sync) {
+  return MetricCollector(make_object<TimelineCollectorNode>(sync));
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.TimelineCollector").set_body_typed(CreateTimelineCollector);
+
 PackedFunc ProfileFunction(Module mod, std::string func_name, int device_type, int device_id,
                            int warmup_iters, Array<MetricCollector> collectors) {
   // Module::GetFunction is not const, so this lambda has to be mutable
@@ -163,6 +163,18 @@ class ROCMDeviceAPI final : public DeviceAPI {
     }
   }
 
+  TVMStreamHandle CreateStream(Device dev) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    hipStream_t retval;
+    ROCM_CALL(hipStreamCreate(&retval));
+    return static_cast<TVMStreamHandle>(retval);
+  }
+
+  void FreeStream(Device dev, TVMStreamHandle stream) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(hipStreamDestroy(static_cast<hipStream_t>(stream)));
+  }
+
   void StreamSync(Device dev, TVMStreamHandle stream) final {
     ROCM_CALL(hipSetDevice(dev.device_id));
     ROCM_CALL(hipStreamSynchronize(static_cast<hipStream_t>(stream)));
@@ -28,6 +28,7 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#include <tvm/runtime/trace.h>
 
 #include <algorithm>
 #include <array>
@@ -289,6 +290,7 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   void HandleProcessPacket(RPCSession::FEncodeReturn setreturn) {
     RPCCode code = RPCCode::kNone;
     this->Read(&code);
+    TVM_TRACE(RPCMessage, code, 0);
 
     if (code >= RPCCode::kSyscallCodeStart) {
       this->HandleSyscall(code);
@@ -666,6 +668,7 @@ void RPCEndpoint::Init() {
   // Quick function to for syscall remote.
   syscall_remote_ = PackedFunc([this](TVMArgs all_args, TVMRetValue* rv) {
     std::lock_guard<std::mutex> lock(mutex_);
+    HandlePendingCalls(0);
     RPCCode code = static_cast<RPCCode>(all_args[0].operator int());
     TVMArgs args(all_args.values + 1, all_args.type_codes + 1, all_args.num_args - 1);
 
@@ -786,6 +789,7 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
                            const int* arg_type_codes, int num_args,
                            RPCSession::FEncodeReturn encode_return) {
   std::lock_guard<std::mutex> lock(mutex_);
+  HandlePendingCalls(0);
 
   handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
   RPCCode code = RPCCode::kCallFunc;
@@ -804,46 +808,149 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
   ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
-void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+void RPCEndpoint::AsyncCallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                                const int* arg_type_codes, int num_args,
+                                RPCSession::FAsyncCallback callback) {
   std::lock_guard<std::mutex> lock(mutex_);
+
+  handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
+  RPCCode code = RPCCode::kCallFunc;
+  uint64_t handle = reinterpret_cast<uint64_t>(h);
+
+  uint64_t packet_nbytes =
+      sizeof(code) + sizeof(handle) +
+      handler_->PackedSeqGetNumBytes(arg_values, arg_type_codes, num_args, true);
+
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  handler_->Write(handle);
+  handler_->SendPackedSeq(arg_values, arg_type_codes, num_args, true);
+  pending_calls_.push_back(callback);
+  // Bound the calls in flight, so that the returns never fill up the channel while the
+  // requests are sent.
+  HandlePendingCalls(kRPCMaxPendingCalls);
+}
+
+void RPCEndpoint::WaitPendingCalls() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HandlePendingCalls(0);
+}
+
+void RPCEndpoint::HandlePendingCalls(size_t max_pending) {
+  while (pending_calls_.size() > max_pending) {
+    RPCSession::FAsyncCallback callback = std::move(pending_calls_.front());
+    pending_calls_.pop_front();
+    bool returned = false;
+    try {
+      RPCCode code = HandleUntilReturnEvent(true, [&](TVMArgs args) {
+        returned = true;
+        callback(RPCCode::kReturn, args);
+      });
+      ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+    } catch (const std::exception& e) {
+      if (returned) throw;
+      TVMValue value;
+      value.v_str = e.what();
+      int32_t tcode = kTVMStr;
+      callback(RPCCode::kException, TVMArgs(&value, &tcode, 1));
+    }
+  }
+}
+
+void RPCEndpoint::WriteCopyPayload(const void* data, uint64_t size) {
+  if (size < kRPCZeroCopyMinBytes) {
+    handler_->WriteArray(static_cast<const char*>(data), size);
+    return;
+  }
+  // Flush the packet header, then send the payload straight from the source memory instead of
+  // staging a copy of it in the ring buffer.
+  while (writer_.bytes_available() != 0) {
+    writer_.ReadWithCallback(
+        [this](const void* data, size_t size) { return channel_->Send(data, size); },
+        writer_.bytes_available());
+  }
+  const char* ptr = static_cast<const char*>(data);
+  while (size != 0) {
+    size_t n = channel_->Send(ptr, size);
+    ICHECK_NE(n, 0U) << "Channel closes before the copy is sent";
+    ptr += n;
+    size -= n;
+  }
+}
+
+void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                               uint64_t block_size, int max_pending_blocks) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HandlePendingCalls(0);
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
   ICHECK_LE(to->byte_offset + nbytes, tensor_total_size_bytes)
       << "CopyToRemote: overflow in tensor size: (byte_offset=" << to->byte_offset
       << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+  ICHECK_GT(block_size, 0U) << "CopyToRemote: Invalid block size!";
+  ICHECK_GT(max_pending_blocks, 0);
 
-  uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(to, code, nbytes);
-  uint64_t packet_nbytes = overhead + nbytes;
+  uint64_t byte_offset = to->byte_offset;
+  int num_pending = 0;
+  for (uint64_t offset = 0; offset < nbytes; offset += block_size) {
+    uint64_t size = std::min(block_size, nbytes - offset);
+    to->byte_offset = byte_offset + offset;
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(to, code, size);
+    uint64_t packet_nbytes = overhead + size;
 
-  handler_->Write(packet_nbytes);
-  handler_->Write(code);
-  RPCReference::SendDLTensor(handler_, to);
-  handler_->Write(nbytes);
-  handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
-  ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
+    handler_->Write(packet_nbytes);
+    handler_->Write(code);
+    RPCReference::SendDLTensor(handler_, to);
+    handler_->Write(size);
+    WriteCopyPayload(static_cast<char*>(from_bytes) + offset, size);
+    if (++num_pending == max_pending_blocks) {
+      ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
+      --num_pending;
+    }
+  }
+  for (; num_pending != 0; --num_pending) {
+    ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
+  }
+  to->byte_offset = byte_offset;
 }
 
-void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
+void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                 uint64_t block_size, int max_pending_blocks) {
   std::lock_guard<std::mutex> lock(mutex_);
+  HandlePendingCalls(0);
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
   ICHECK_LE(from->byte_offset + nbytes, tensor_total_size_bytes)
       << "CopyFromRemote: overflow in tensor size: (byte_offset=" << from->byte_offset
       << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+  ICHECK_GT(block_size, 0U) << "CopyFromRemote: Invalid block size!";
+  ICHECK_GT(max_pending_blocks, 0);
+
+  uint64_t byte_offset = from->byte_offset;
+  uint64_t requested = 0;
+  for (uint64_t offset = 0; offset < nbytes; offset += block_size) {
+    // Request the blocks ahead, so the remote sends them back to back.
+    while (requested < nbytes && requested - offset < max_pending_blocks * block_size) {
+      uint64_t size = std::min(block_size, nbytes - requested);
+      from->byte_offset = byte_offset + requested;
+      uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(from, code, size);
+      uint64_t packet_nbytes = overhead;
+
+      handler_->Write(packet_nbytes);
+      handler_->Write(code);
+      RPCReference::SendDLTensor(handler_, from);
+      handler_->Write(size);
+      requested += size;
+    }
+    ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kCopyAck);
 
-  uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(from, code, nbytes);
-  uint64_t packet_nbytes = overhead;
-
-  handler_->Write(packet_nbytes);
-  handler_->Write(code);
-  RPCReference::SendDLTensor(handler_, from);
-  handler_->Write(nbytes);
-  ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kCopyAck);
-
-  handler_->ReadArray(reinterpret_cast<char*>(to_bytes), nbytes);
-  handler_->FinishCopyAck();
+    uint64_t size = std::min(block_size, nbytes - offset);
+    handler_->ReadArray(static_cast<char*>(to_bytes) + offset, size);
+    handler_->FinishCopyAck();
+  }
+  from->byte_offset = byte_offset;
 }
 
 // SysCallEventHandler functions
@@ -1012,30 +1119,21 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     endpoint_->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
   }
 
+  void PipelinedCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                         const int* arg_type_codes, int num_args, FAsyncCallback callback) final {
+    endpoint_->AsyncCallFunc(func, arg_values, arg_type_codes, num_args, callback);
+  }
+
+  void WaitPipelinedCalls() final { endpoint_->WaitPendingCalls(); }
+
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
     RPCCode code = RPCCode::kCopyToRemote;
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
     uint64_t rpc_max_size = GetRPCMaxTransferSize();
     ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* from_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
-    }
-
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
-    }
+    uint64_t block_size = std::min(rpc_max_size - overhead, kRPCCopyBlockSizeBytes);
+    endpoint_->CopyToRemote(local_from_bytes, remote_to, nbytes, block_size,
+                            GetMaxPendingCopyBlocks());
   }
 
   void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
@@ -1043,25 +1141,9 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_from, code, nbytes);
     uint64_t rpc_max_size = GetRPCMaxTransferSize();
     ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* to_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, block_size);
-    }
-
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, remainder_bytes);
-    }
+    uint64_t block_size = std::min(rpc_max_size - overhead, kRPCCopyBlockSizeBytes);
+    endpoint_->CopyFromRemote(remote_from, local_to_bytes, nbytes, block_size,
+                              GetMaxPendingCopyBlocks());
   }
 
   void FreeHandle(void* handle, int type_code) final {
@@ -1153,6 +1235,12 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     return (uint64_t)rpc_chunk_max_size_bytes_;
   }
 
+  // The remotes limiting the packet size, e.g. microTVM, have no room to buffer several blocks.
+  int GetMaxPendingCopyBlocks() {
+    return GetRPCMaxTransferSize() == kRPCMaxTransferSizeBytesDefault ? kRPCMaxPendingCopyBlocks
+                                                                       : 1;
+  }
+
   std::shared_ptr<RPCEndpoint> endpoint_;
   int64_t rpc_chunk_max_size_bytes_ = -1;
 };
@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/packed_func.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -48,6 +49,14 @@ const int kRPCTrackerMagic = 0x2f271;
 const int kRPCSuccess = kRPCMagic + 0;
 // cannot found matched key in server
 const int kRPCMismatch = kRPCMagic + 2;
+// block size of the tensor copies when the remote does not limit the packet size
+const uint64_t kRPCCopyBlockSizeBytes = 4 << 20;
+// number of copy blocks in flight before waiting for the remote
+const int kRPCMaxPendingCopyBlocks = 4;
+// minimum payload size sent directly from the source memory instead of the ring buffer
+const uint64_t kRPCZeroCopyMinBytes = 64 << 10;
+// number of async calls in flight before waiting for the remote
+const size_t kRPCMaxPendingCalls = 16;
 
 /*! \brief Enumeration code for the RPC tracker */
 enum class TrackerCode : int {
@@ -140,28 +149,51 @@ class RPCEndpoint {
    */
   void CallFunc(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
                 const int* arg_type_codes, int num_args, RPCSession::FEncodeReturn encode_return);
+  /*!
+   * \brief Call into remote function without waiting for the return.
+   *
+   *  The calls are pipelined, the remote runs them in order and their returns are received
+   *  in the same order: when more than kRPCMaxPendingCalls calls are in flight, by
+   *  WaitPendingCalls, or before any synchronous request, so that the later requests observe
+   *  the effects of the calls.
+   * \param handle The function handle
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param callback The callback to pass the return value or exception, called with the
+   *  endpoint locked.
+   */
+  void AsyncCallFunc(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
+                     const int* arg_type_codes, int num_args, RPCSession::FAsyncCallback callback);
+  /*! \brief Receive the returns of all the async calls in flight. */
+  void WaitPendingCalls();
   /*!
    * \brief Copy bytes into remote array content.
-   * \param from The source host data.
-   * \param from_offset The byte offeset in the from.
+   *
+   *  The bytes are sent in blocks, up to max_pending_blocks of which are in flight before
+   *  waiting for the remote to acknowledge them, overlapping the transfer of a block with the
+   *  remote copying the previous ones.
+   * \param from_bytes The source host data.
    * \param to The target array.
-   * \param to_offset The byte offset in the to.
    * \param nbytes The size of the memory in bytes.
-   * \param dev_to The target device.
-   * \param type_hint Hint of content data type.
+   * \param block_size The maximum number of bytes in a block.
+   * \param max_pending_blocks The maximum number of blocks in flight.
    */
-  void CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  void CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes, uint64_t block_size,
+                    int max_pending_blocks);
   /*!
    * \brief Copy bytes from remote array content.
-   * \param from The source host data.
-   * \param from_offset The byte offeset in the from.
-   * \param to The target array.
-   * \param to_offset The byte offset in the to.
+   *
+   *  The bytes are requested in blocks, up to max_pending_blocks ahead of the block being
+   *  received, so that the remote prepares the next blocks during the transfer.
+   * \param from The source array.
+   * \param to_bytes The target host data.
    * \param nbytes The size of the memory in bytes.
-   * \param dev_from The source device.
-   * \param type_hint Hint of content data type.
+   * \param block_size The maximum number of bytes in a block.
+   * \param max_pending_blocks The maximum number of blocks in flight.
    */
-  void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
+  void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes, uint64_t block_size,
+                      int max_pending_blocks);
 
   /*!
    * \brief Call a remote defined system function with arguments.
@@ -191,6 +223,10 @@ class RPCEndpoint {
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
   // Initalization
   void Init();
+  // Send the copy payload, bypassing the ring buffer for large payloads.
+  void WriteCopyPayload(const void* data, uint64_t size);
+  // Receive the returns of the async calls in flight until at most max_pending remain.
+  void HandlePendingCalls(size_t max_pending);
   // Internal channel.
   std::unique_ptr<RPCChannel> channel_;
 
@@ -200,6 +236,8 @@ class RPCEndpoint {
   support::RingBuffer reader_, writer_;
   // Event handler.
   std::shared_ptr<EventHandler> handler_;
+  // Callbacks of the async calls in flight, in the order of the calls.
+  std::deque<RPCSession::FAsyncCallback> pending_calls_;
   // syscall remote with specified function code.
   PackedFunc syscall_remote_;
   // The name of the session.
@@ -29,7 +29,9 @@
 #include <chrono>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #if defined(_M_X64) || defined(__x86_64__)
 #include <immintrin.h>
 #endif
@@ -78,6 +80,40 @@ NDArray NDArrayFromRemoteOpaqueHandle(std::shared_ptr<RPCSession> sess, void* ha
   return NDArray(GetObjectPtr<Object>(data));
 }
 
+class RPCWrappedFunc;
+
+/*!
+ * \brief Table of the remote functions wrapped as PackedFunc, to find the remote function
+ *  behind a PackedFunc when it is called asynchronously.
+ */
+class RPCWrappedFuncTable {
+ public:
+  static RPCWrappedFuncTable* Global() {
+    static RPCWrappedFuncTable* inst = new RPCWrappedFuncTable();
+    return inst;
+  }
+
+  void Insert(const Object* packed, std::weak_ptr<RPCWrappedFunc> func) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    funcs_[packed] = func;
+  }
+
+  void Erase(const Object* packed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    funcs_.erase(packed);
+  }
+
+  std::shared_ptr<RPCWrappedFunc> Get(const Object* packed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = funcs_.find(packed);
+    return it == funcs_.end() ? nullptr : it->second.lock();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<const Object*, std::weak_ptr<RPCWrappedFunc>> funcs_;
+};
+
 /*!
  * \brief A wrapped remote function as a PackedFunc.
  */
@@ -85,68 +121,145 @@ class RPCWrappedFunc : public Object {
  public:
   RPCWrappedFunc(void* handle, std::shared_ptr<RPCSession> sess) : handle_(handle), sess_(sess) {}
 
+  /*!
+   * \brief Wrap a remote function as a PackedFunc.
+   * \param handle The remote function handle.
+   * \param sess The session of the remote function.
+   * \return The PackedFunc calling the remote function.
+   */
+  static PackedFunc Wrap(void* handle, std::shared_ptr<RPCSession> sess) {
+    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess);
+    PackedFunc packed([wf](TVMArgs args, TVMRetValue* rv) { return wf->operator()(args, rv); });
+    wf->packed_ = packed.get();
+    RPCWrappedFuncTable::Global()->Insert(wf->packed_, wf);
+    return packed;
+  }
+
   void operator()(TVMArgs args, TVMRetValue* rv) const {
-    std::vector<TVMValue> values(args.values, args.values + args.size());
-    std::vector<int> type_codes(args.type_codes, args.type_codes + args.size());
+    std::vector<TVMValue> values;
+    std::vector<int> type_codes;
+    std::vector<std::unique_ptr<DLTensor>> temp_dltensors;
+    RemapArgs(args, &values, &type_codes, &temp_dltensors);
+    auto set_return = [this, rv](TVMArgs args) { WrapRemoteReturnToValue(sess_, args, rv); };
+    sess_->CallFunc(handle_, values.data(), type_codes.data(), args.size(), set_return);
+  }
+
+  /*!
+   * \brief Call the remote function without waiting for its return.
+   *
+   *  The call is pipelined with the other calls of the session, see
+   *  RPCSession::PipelinedCallFunc.
+   * \param args The arguments.
+   * \return The future of the call, a function without arguments which waits for the return
+   *  and returns it.
+   */
+  PackedFunc AsyncCall(TVMArgs args) const {
+    std::vector<TVMValue> values;
+    std::vector<int> type_codes;
     std::vector<std::unique_ptr<DLTensor>> temp_dltensors;
+    RemapArgs(args, &values, &type_codes, &temp_dltensors);
+
+    struct Future {
+      std::shared_ptr<RPCSession> sess;
+      bool done{false};
+      TVMRetValue value;
+      std::string error;
+    };
+    auto future = std::make_shared<Future>();
+    future->sess = sess_;
+    // The callback only holds a weak reference, so that the pending calls of a session do not
+    // keep the session alive. The return of a dropped future is ignored.
+    std::weak_ptr<Future> weak_future = future;
+    sess_->PipelinedCallFunc(handle_, values.data(), type_codes.data(), args.size(),
+                             [weak_future](RPCCode status, TVMArgs args) {
+                               auto future = weak_future.lock();
+                               if (future == nullptr) return;
+                               if (status == RPCCode::kException) {
+                                 future->error = args[0].operator std::string();
+                               } else {
+                                 WrapRemoteReturnToValue(future->sess, args, &future->value);
+                               }
+                               future->done = true;
+                             });
+    return PackedFunc([future](TVMArgs args, TVMRetValue* rv) {
+      if (!future->done) {
+        future->sess->WaitPipelinedCalls();
+      }
+      ICHECK(future->done) << "InternalError: the RPC call did not return";
+      if (!future->error.empty()) {
+        LOG(FATAL) << future->error;
+      }
+      *rv = future->value;
+    });
+  }
+
+  ~RPCWrappedFunc() {
+    if (packed_ != nullptr) {
+      RPCWrappedFuncTable::Global()->Erase(packed_);
+    }
+    try {
+      sess_->FreeHandle(handle_, kTVMPackedFuncHandle);
+    } catch (const Error& e) {
+      // fault tolerance to remote close
+    }
+  }
+
+ private:
+  // remote function handle
+  void* handle_{nullptr};
+  // pointer to the session.
+  std::shared_ptr<RPCSession> sess_;
+  // the PackedFunc wrapping this function
+  const Object* packed_{nullptr};
+
+  // rewrite the arguments to their remote variant.
+  void RemapArgs(TVMArgs args, std::vector<TVMValue>* values, std::vector<int>* type_codes,
+                 std::vector<std::unique_ptr<DLTensor>>* temp_dltensors) const {
+    values->assign(args.values, args.values + args.size());
+    type_codes->assign(args.type_codes, args.type_codes + args.size());
 
     // scan and check whether we need rewrite these arguments
     // to their remote variant.
     for (int i = 0; i < args.size(); ++i) {
       if (args[i].IsObjectRef<String>()) {
         String str = args[i];
-        type_codes[i] = kTVMStr;
-        values[i].v_str = str.c_str();
+        (*type_codes)[i] = kTVMStr;
+        (*values)[i].v_str = str.c_str();
         continue;
       }
-      int tcode = type_codes[i];
+      int tcode = (*type_codes)[i];
       switch (tcode) {
         case kTVMDLTensorHandle:
         case kTVMNDArrayHandle: {
           // Pass NDArray as DLTensor, NDArray and DLTensor
           // are compatible to each other, just need to change the index.
-          type_codes[i] = kTVMDLTensorHandle;
+          (*type_codes)[i] = kTVMDLTensorHandle;
           // translate to a remote view of DLTensor
-          auto dptr = std::make_unique<DLTensor>(*static_cast<DLTensor*>(values[i].v_handle));
+          auto dptr = std::make_unique<DLTensor>(*static_cast<DLTensor*>((*values)[i].v_handle));
           dptr->device = RemoveSessMask(dptr->device);
           dptr->data = static_cast<RemoteSpace*>(dptr->data)->data;
-          values[i].v_handle = dptr.get();
-          temp_dltensors.emplace_back(std::move(dptr));
+          (*values)[i].v_handle = dptr.get();
+          temp_dltensors->emplace_back(std::move(dptr));
           break;
         }
         case kDLDevice: {
-          values[i].v_device = RemoveSessMask(values[i].v_device);
+          (*values)[i].v_device = RemoveSessMask((*values)[i].v_device);
           break;
         }
         case kTVMPackedFuncHandle:
         case kTVMModuleHandle: {
-          values[i].v_handle = UnwrapRemoteValueToHandle(TVMArgValue(values[i], tcode));
+          (*values)[i].v_handle = UnwrapRemoteValueToHandle(TVMArgValue((*values)[i], tcode));
           break;
         }
       }
     }
-    auto set_return = [this, rv](TVMArgs args) { this->WrapRemoteReturnToValue(args, rv); };
-    sess_->CallFunc(handle_, values.data(), type_codes.data(), args.size(), set_return);
-  }
-
-  ~RPCWrappedFunc() {
-    try {
-      sess_->FreeHandle(handle_, kTVMPackedFuncHandle);
-    } catch (const Error& e) {
-      // fault tolerance to remote close
-    }
   }
 
- private:
-  // remote function handle
-  void* handle_{nullptr};
-  // pointer to the session.
-  std::shared_ptr<RPCSession> sess_;
-
   // unwrap a remote value to the underlying handle.
   void* UnwrapRemoteValueToHandle(const TVMArgValue& arg) const;
   // wrap a remote return via Set
-  void WrapRemoteReturnToValue(TVMArgs args, TVMRetValue* rv) const;
+  static void WrapRemoteReturnToValue(const std::shared_ptr<RPCSession>& sess, TVMArgs args,
+                                      TVMRetValue* rv);
 
   // remove a remote session mask
   Device RemoveSessMask(Device dev) const {
@@ -243,8 +356,7 @@ class RPCModuleNode final : public ModuleNode {
 
   PackedFunc WrapRemoteFunc(RPCSession::PackedFuncHandle handle) {
     if (handle == nullptr) return PackedFunc();
-    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess_);
-    return PackedFunc([wf](TVMArgs args, TVMRetValue* rv) { return wf->operator()(args, rv); });
+    return RPCWrappedFunc::Wrap(handle, sess_);
   }
 
   // The module handle
@@ -279,26 +391,26 @@ void* RPCWrappedFunc::UnwrapRemoteValueToHandle(const TVMArgValue& arg) const {
   }
 }
 
-void RPCWrappedFunc::WrapRemoteReturnToValue(TVMArgs args, TVMRetValue* rv) const {
+void RPCWrappedFunc::WrapRemoteReturnToValue(const std::shared_ptr<RPCSession>& sess,
+                                             TVMArgs args, TVMRetValue* rv) {
   int tcode = args[0];
 
   if (tcode == kTVMNullptr) return;
   if (tcode == kTVMPackedFuncHandle) {
     ICHECK_EQ(args.size(), 2);
     void* handle = args[1];
-    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess_);
-    *rv = PackedFunc([wf](TVMArgs args, TVMRetValue* rv) { return wf->operator()(args, rv); });
+    *rv = Wrap(handle, sess);
   } else if (tcode == kTVMModuleHandle) {
     ICHECK_EQ(args.size(), 2);
     void* handle = args[1];
-    auto n = make_object<RPCModuleNode>(handle, sess_);
+    auto n = make_object<RPCModuleNode>(handle, sess);
     *rv = Module(n);
   } else if (tcode == kTVMDLTensorHandle || tcode == kTVMNDArrayHandle) {
     ICHECK_EQ(args.size(), 3);
     DLTensor* tensor = args[1];
     void* nd_handle = args[2];
-    *rv = NDArrayFromRemoteOpaqueHandle(sess_, tensor->data, tensor,
-                                        AddRPCSessionMask(tensor->device, sess_->table_index()),
+    *rv = NDArrayFromRemoteOpaqueHandle(sess, tensor->data, tensor,
+                                        AddRPCSessionMask(tensor->device, sess->table_index()),
                                         nd_handle);
   } else {
     ICHECK_EQ(args.size(), 2);
@@ -442,6 +554,17 @@ TVM_REGISTER_GLOBAL("rpc.ImportRemoteModule").set_body_typed([](Module parent, M
   static_cast<RPCModuleNode*>(parent.operator->())->ImportModule(child);
 });
 
+TVM_REGISTER_GLOBAL("rpc.AsyncCall").set_body([](TVMArgs args, TVMRetValue* rv) {
+  PackedFunc func = args[0];
+  auto wf = RPCWrappedFuncTable::Global()->Get(func.get());
+  ICHECK(wf != nullptr) << "ValueError: Only remote functions can be called asynchronously";
+  *rv = wf->AsyncCall(TVMArgs(args.values + 1, args.type_codes + 1, args.size() - 1));
+});
+
+TVM_REGISTER_GLOBAL("rpc.WaitPendingCalls").set_body_typed([](Module sess) {
+  RPCModuleGetSession(sess)->WaitPipelinedCalls();
+});
+
 TVM_REGISTER_GLOBAL("rpc.SessTableIndex").set_body([](TVMArgs args, TVMRetValue* rv) {
   Module m = args[0];
   std::string tkey = m->type_key();
@@ -51,6 +51,12 @@ void RPCSession::AsyncCallFunc(PackedFuncHandle func, const TVMValue* arg_values
   }
 }
 
+void RPCSession::PipelinedCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                                   const int* arg_type_codes, int num_args,
+                                   FAsyncCallback callback) {
+  this->AsyncCallFunc(func, arg_values, arg_type_codes, num_args, callback);
+}
+
 void RPCSession::AsyncCopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes,
                                    RPCSession::FAsyncCallback callback) {
   TVMValue value;
@@ -208,6 +208,32 @@ class RPCSession {
   virtual void AsyncCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
                              const int* arg_type_codes, int num_args, FAsyncCallback callback);
 
+  /*!
+   * \brief Call func without waiting for the return, pipelining the calls to the remote.
+   *
+   *  Unlike AsyncCallFunc, which serves the requests of an RPC server, this is meant for the
+   *  clients. The remote runs the calls in order, and the callbacks are called in the same
+   *  order once the returns are received, at the latest by WaitPipelinedCalls or before the
+   *  next synchronous request of the session.
+   *
+   *  The default implementation calls func synchronously.
+   *
+   * \param func The function handle.
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param callback The callback to pass the return value or exception, which must not call
+   *  back into the session.
+   */
+  virtual void PipelinedCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                                 const int* arg_type_codes, int num_args,
+                                 FAsyncCallback callback);
+
+  /*!
+   * \brief Wait until the callbacks of all the pipelined calls are called.
+   */
+  virtual void WaitPipelinedCalls() {}
+
   /*!
    * \brief Asynchrous version of CopyToRemote.
    *
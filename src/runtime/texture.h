@@ -101,6 +101,10 @@ class TVM_DLL Pool2D {
   void Free(void* data);
   // Release all resources immediately
   void Release(Device dev, DeviceAPI* device);
+  // Release the free textures, keeping the allocated ones
+  void ReleaseFree(Device dev, DeviceAPI* device);
+  // Set the memory limit in bytes of the textures, 0 for no limit
+  void SetMemoryLimit(size_t nbytes) { memory_limit_ = nbytes; }
 
  protected:
   struct Entry {
@@ -109,8 +113,15 @@ class TVM_DLL Pool2D {
     size_t y;
     DLDataType type;
   };
+  // Release the memory of an entry
+  void FreeEntry(Device dev, DeviceAPI* device, const Entry& e);
+
   std::vector<Entry> free_list_;
   std::vector<Entry> allocated_;
+  // The size in bytes of all the textures, allocated or free
+  size_t used_bytes_{0};
+  // The memory limit in bytes, 0 for no limit
+  size_t memory_limit_{0};
 };
 
 /*!
@@ -134,11 +145,14 @@ class TVM_DLL TexturePool {
    *
    * \note Two dimensional texture workspaces will be grown and reused
    * according to the following strategy:
-   *  - Choose the workspace which minimizes the amount of memory required to
-   *    grow the workspace to fit the request.
    *  - If a set of workspaces exist that fit the current request without
    *    expansion, choose the workspace of that set which most closely
-   *    matches the request size, minimizing wasted space.
+   *    matches the request area, minimizing wasted space.
+   *  - Otherwise, choose the workspace which minimizes the area required to
+   *    grow the workspace to fit the request, if it is not larger than the
+   *    requested area.
+   *  - When a new texture exceeds the memory limit, the free workspaces are
+   *    released, the largest first.
    *
    * \param dev The context of allocation.
    * \param width The width of the 2d texture to be allocated.
@@ -153,10 +167,26 @@ class TVM_DLL TexturePool {
    * \param ptr The pointer to be freed.
    */
   void FreeTexture(Device dev, void* ptr);
+  /*!
+   * \brief Set the memory limit of the textures of each device.
+   *
+   * The limit defaults to the TVM_TEXTURE_POOL_LIMIT environment variable.
+   *
+   * \param nbytes The limit in bytes, 0 for no limit.
+   */
+  void SetMemoryLimit(size_t nbytes);
+  /*!
+   * \brief Release the free textures, e.g. between the runs of different models.
+   *
+   * \param dev The context of allocation.
+   */
+  void ReleaseFree(Device dev);
 
  private:
   /*! \brief pool of device local array */
   std::vector<Pool2D*> array_;
+  /*! \brief The memory limit in bytes of the textures of each device, 0 for no limit */
+  size_t memory_limit_{0};
   /*! \brief device type this pool support */
   DLDeviceType device_type_;
   /*! \brief The device API */
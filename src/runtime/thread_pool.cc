@@ -25,15 +25,18 @@
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/threading_backend.h>
+#include <tvm/runtime/trace.h>
 #if TVM_THREADPOOL_USE_OPENMP
 #include <omp.h>
 #endif
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstring>
 #include <memory>
@@ -51,6 +54,8 @@ namespace runtime {
 namespace {
 using support::IsNumber;
 constexpr uint32_t kDefaultSpinCount = 300000;
+// The longest gap between parallel jobs the workers spin through with the adaptive policy.
+constexpr int64_t kAdaptiveSpinGapNs = 500000;
 
 uint32_t GetSpinCount() {
   const char* val = getenv("TVM_THREAD_POOL_SPIN_COUNT");
@@ -60,11 +65,66 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+bool GetNestedParallelism() {
+  const char* val = getenv("TVM_THREAD_POOL_NESTED");
+  return val != nullptr && atoi(val) != 0;
+}
+
+int GetWorkStealingChunks() {
+  const char* val = getenv("TVM_THREAD_POOL_WORK_STEALING");
+  if (!val) {
+    return 0;
+  }
+  return std::max(atoi(val), 0);
+}
+
 }  // namespace
 
 // stride in the page, fit to cache line.
 constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 
+class ThreadPool;
+
+/*!
+ * \brief A parallel job launched from inside a task of another job. Its tasks are
+ *  claimed one at a time by the launching thread and by the idle workers it recruits.
+ */
+struct NestedJob {
+  NestedJob(FTVMParallelLambda flambda, void* cdata, int num_task)
+      : flambda(flambda), cdata(cdata), num_pending(num_task) {
+    env.num_task = num_task;
+    // Tasks are not guaranteed to run concurrently, so the barrier is not available.
+    env.sync_handle = nullptr;
+  }
+  // Claim and run tasks until none is left.
+  void Run() {
+    int task_id;
+    while ((task_id = next.fetch_add(1, std::memory_order_relaxed)) < env.num_task) {
+      if ((*flambda)(task_id, &env, cdata) != 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error << "Task " << task_id << " error: " << TVMGetLastError() << '\n';
+        has_error.store(true);
+      }
+      num_pending.fetch_sub(1, std::memory_order_release);
+    }
+  }
+  // The parallel lambda
+  FTVMParallelLambda flambda;
+  // The closure data
+  void* cdata;
+  // Local env
+  TVMParallelGroupEnv env;
+  // The next task to be claimed.
+  std::atomic<int32_t> next{0};
+  // The number of tasks that have not finished yet.
+  std::atomic<int32_t> num_pending;
+  // Whether error has been countered.
+  std::atomic<bool> has_error{false};
+  // The error message and its lock.
+  std::ostringstream error;
+  std::mutex mutex;
+};
+
 /*!
  * \brief Thread local main environment.
  */
@@ -76,6 +136,7 @@ class ParallelLauncher {
     this->cdata = cdata;
     this->flambda = flambda;
     this->env.num_task = num_task;
+    this->work_stealing = false;
     has_error_.store(false);
     // reshape
     if (static_cast<size_t>(num_task) > par_errors_.size()) {
@@ -94,6 +155,44 @@ class ParallelLauncher {
       this->env.sync_handle = nullptr;
     }
   }
+  /*!
+   * \brief Distribute the tasks set up by Init over the participants in contiguous ranges
+   *  that idle participants can steal from, instead of one task per thread.
+   * \param num_participants The number of threads running RunParticipant.
+   */
+  void InitWorkStealing(int num_participants) {
+    if (num_participants > num_ranges_) {
+      ranges_.reset(new TaskRange[num_participants]);
+      num_ranges_ = num_participants;
+    }
+    int num_task = env.num_task;
+    for (int i = 0; i < num_participants; ++i) {
+      ranges_[i].next.store(num_task * i / num_participants, std::memory_order_relaxed);
+      ranges_[i].end = num_task * (i + 1) / num_participants;
+    }
+    num_participants_ = num_participants;
+    work_stealing = true;
+    // In this mode the pending counter tracks the participants rather than the tasks.
+    num_pending_.store(num_participants);
+  }
+  /*!
+   * \brief Run the tasks of the participant's own range, then steal the remaining tasks
+   *  of the other participants.
+   * \param participant The index of the calling participant.
+   */
+  void RunParticipant(int participant) {
+    for (int k = 0; k < num_participants_; ++k) {
+      TaskRange& range = ranges_[(participant + k) % num_participants_];
+      int task_id;
+      while ((task_id = range.next.fetch_add(1, std::memory_order_relaxed)) < range.end) {
+        if ((*flambda)(task_id, &env, cdata) != 0) {
+          par_errors_[task_id] = TVMGetLastError();
+          has_error_.store(true);
+        }
+      }
+    }
+    num_pending_.fetch_sub(1);
+  }
   ~ParallelLauncher() { delete[] sync_counter_; }
   // Wait n jobs to finish
   int WaitForJobs() {
@@ -130,8 +229,18 @@ class ParallelLauncher {
   // Whether this thread is worker of the pool.
   // used to prevent recursive launch.
   bool is_worker{false};
+  // The pool whose job this thread is running a task of, launches from such a
+  // task are nested launches.
+  ThreadPool* active_pool{nullptr};
+  // Whether the current job runs in work stealing mode.
+  bool work_stealing{false};
 
  private:
+  // A range of task ids claimed one at a time by its owner and by thieves.
+  struct TaskRange {
+    alignas(kL1CacheBytes) std::atomic<int32_t> next{0};
+    int32_t end{0};
+  };
   // The pending jobs.
   std::atomic<int32_t> num_pending_;
   // Whether error has been countered.
@@ -140,6 +249,12 @@ class ParallelLauncher {
   std::atomic<int32_t>* sync_counter_{nullptr};
   // The error message
   std::vector<std::string> par_errors_;
+  // The task ranges of the participants in work stealing mode.
+  std::unique_ptr<TaskRange[]> ranges_;
+  // The number of allocated task ranges.
+  int num_ranges_{0};
+  // The number of participants of the current job in work stealing mode.
+  int num_participants_{0};
 };
 
 /*! \brief Lock-free single-producer-single-consumer queue for each thread */
@@ -149,6 +264,8 @@ class SpscTaskQueue {
   struct Task {
     ParallelLauncher* launcher;
     int32_t task_id;
+    // The nested job to help with, in which case launcher is not used.
+    std::shared_ptr<NestedJob> nested;
   };
 
   SpscTaskQueue() : buffer_(new Task[kRingSize]), head_(0), tail_(0) {}
@@ -163,24 +280,33 @@ class SpscTaskQueue {
     while (!Enqueue(input)) {
       tvm::runtime::threading::Yield();
     }
-    if (pending_.fetch_add(1) == -1) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      cv_.notify_one();
-    }
+    Notify();
+  }
+
+  /*!
+   * \brief Push a task into the queue unless it is full.
+   * \param input The task to be enqueued.
+   * \return Whether the task is enqueued.
+   */
+  bool TryPush(const Task& input) {
+    if (!Enqueue(input)) return false;
+    Notify();
+    return true;
   }
 
   /*!
    * \brief Pop a task out of the queue and condition wait if no tasks.
    * \param output The pointer to the task to be dequeued.
    * \param spin_count The number of iterations to spin before sleep.
+   * \param yield Whether to yield the core while spinning.
    * \return Whether pop is successful (true) or we need to exit now (false).
    */
-  bool Pop(Task* output, uint32_t spin_count) {
+  bool Pop(Task* output, uint32_t spin_count, bool yield = true) {
     // Busy wait a bit when the queue is empty.
     // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
     // The default spin count is set by following the typical omp convention
     for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
-      tvm::runtime::threading::Yield();
+      if (yield) tvm::runtime::threading::Yield();
     }
     if (pending_.fetch_sub(1) == 0) {
       std::unique_lock<std::mutex> lock(mutex_);
@@ -207,6 +333,14 @@ class SpscTaskQueue {
   }
 
  protected:
+  // Notify the consumer of a new task if it is on wait.
+  void Notify() {
+    if (pending_.fetch_add(1) == -1) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.notify_one();
+    }
+  }
+
   /*!
    * \brief Lock-free enqueue.
    * \param input The task to be enqueued.
@@ -264,6 +398,9 @@ class ThreadPool {
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
     }
+    work_stealing_chunks_ = GetWorkStealingChunks();
+    nested_ = GetNestedParallelism();
+    spin_count_ = GetSpinCount();
     Init();
   }
 
@@ -285,9 +422,29 @@ class ThreadPool {
   }
 
   int Launch(FTVMParallelLambda flambda, void* cdata, int num_task, int need_sync) {
+    if (wait_policy_.load(std::memory_order_relaxed) != threading::kWaitAdaptive) {
+      return LaunchJob(flambda, cdata, num_task, need_sync);
+    }
+    // Track the gaps the workers wait through, smoothed over the last few jobs.
+    int64_t start = NowNs();
+    if (last_finish_ns_ != 0) {
+      int64_t gap = start - last_finish_ns_;
+      int64_t avg = avg_gap_ns_.load(std::memory_order_relaxed);
+      avg_gap_ns_.store(avg + (gap - avg) / 4, std::memory_order_relaxed);
+    }
+    int res = LaunchJob(flambda, cdata, num_task, need_sync);
+    last_finish_ns_ = NowNs();
+    return res;
+  }
+
+  int LaunchJob(FTVMParallelLambda flambda, void* cdata, int num_task, int need_sync) {
     ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
     ICHECK(!launcher->is_worker)
         << "Cannot launch parallel job inside worker, consider fuse then parallel";
+    // Only jobs whose decomposition is left to the runtime can be over-decomposed.
+    if (num_task == 0 && work_stealing_chunks_ != 0) {
+      return LaunchWorkStealing(launcher, flambda, cdata);
+    }
     if (num_task == 0) {
       num_task = num_workers_used_;
     }
@@ -302,16 +459,18 @@ class ThreadPool {
     // if worker0 is taken by the main, queues_[0] is abandoned
     for (int i = exclude_worker0_; i < num_task; ++i) {
       tsk.task_id = i;
-      queues_[i]->Push(tsk);
+      PushTask(i, tsk);
     }
     // use the main thread to run task 0
     if (exclude_worker0_) {
       TVMParallelGroupEnv* penv = &(tsk.launcher->env);
+      launcher->active_pool = this;
       if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
         tsk.launcher->SignalJobFinish();
       } else {
         tsk.launcher->SignalJobError(tsk.task_id);
       }
+      launcher->active_pool = nullptr;
     }
     int res = launcher->WaitForJobs();
     return res;
@@ -319,6 +478,57 @@ class ThreadPool {
 
   static ThreadPool* ThreadLocal() { return dmlc::ThreadLocalStore<ThreadPool>::Get(); }
 
+  void UpdateWorkStealing(int chunks_per_worker) {
+    work_stealing_chunks_ = std::max(chunks_per_worker, 0);
+  }
+
+  void UpdateNestedParallelism(bool nested) { nested_ = nested; }
+
+  void UpdateWaitPolicy(threading::WaitPolicy policy, int spin_count) {
+    if (spin_count >= 0) spin_count_.store(spin_count, std::memory_order_relaxed);
+    avg_gap_ns_.store(0, std::memory_order_relaxed);
+    last_finish_ns_ = 0;
+    wait_policy_.store(policy, std::memory_order_relaxed);
+  }
+
+  void WarmUp() {
+    auto nop = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) { return 0; };
+    ICHECK_EQ(Launch(nop, nullptr, num_workers_used_, 0), 0);
+  }
+
+  /*!
+   * \brief Launch a job from inside a task of the job this pool is running.
+   *
+   * Without nested parallelism the tasks run inline on the calling thread. Otherwise
+   * they are shared with the workers that already finished their part of the outer
+   * job, while the calling thread keeps running tasks itself. Recruited workers only
+   * ever run tasks and never wait, so nested launches can not deadlock.
+   */
+  int LaunchNested(FTVMParallelLambda flambda, void* cdata, int num_task) {
+    if (num_task == 0) {
+      num_task = num_workers_used_;
+    }
+    auto job = std::make_shared<NestedJob>(flambda, cdata, num_task);
+    if (nested_) {
+      SpscTaskQueue::Task tsk;
+      tsk.launcher = nullptr;
+      tsk.task_id = 0;
+      tsk.nested = job;
+      int num_helpers = 0;
+      for (int i = exclude_worker0_; i < num_workers_used_ && num_helpers + 1 < num_task; ++i) {
+        num_helpers += TryRecruit(i, tsk);
+      }
+    }
+    job->Run();
+    while (job->num_pending.load(std::memory_order_acquire) != 0) {
+      tvm::runtime::threading::Yield();
+    }
+    if (!job->has_error.load()) return 0;
+    std::lock_guard<std::mutex> lock(job->mutex);
+    TVMAPISetLastError(job->error.str().c_str());
+    return -1;
+  }
+
   void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads,
                                  const std::vector<unsigned int>& cpus) {
     // this will also reset the affinity of the ThreadGroup
@@ -331,9 +541,18 @@ class ThreadPool {
 
   int32_t NumThreads() const { return num_workers_used_; }
 
+  void UpdateNumaNode(int node) { numa_node_.store(node, std::memory_order_relaxed); }
+
  private:
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
   // Shared initialization code
   void Init() {
+    worker_states_.reset(new WorkerState[num_workers_]);
     for (int i = 0; i < num_workers_; ++i) {
       // The SpscTaskQueue only hosts ONE item at a time
       queues_.emplace_back(std::make_unique<SpscTaskQueue>());
@@ -344,24 +563,93 @@ class ThreadPool {
     num_workers_used_ = threads_->Configure(threading::ThreadGroup::kBig, 0, exclude_worker0_);
   }
 
+  /*!
+   * \brief Split the job into chunks_per_worker tasks per worker. Each worker runs its
+   *  own tasks first and then takes over the remaining tasks of slower workers.
+   *  Tasks may no longer run concurrently, so the parallel barrier is not available.
+   */
+  int LaunchWorkStealing(ParallelLauncher* launcher, FTVMParallelLambda flambda, void* cdata) {
+    int num_participants = num_workers_used_;
+    launcher->Init(flambda, cdata, num_participants * work_stealing_chunks_, false);
+    launcher->InitWorkStealing(num_participants);
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    for (int i = exclude_worker0_; i < num_participants; ++i) {
+      tsk.task_id = i;
+      PushTask(i, tsk);
+    }
+    if (exclude_worker0_) {
+      launcher->active_pool = this;
+      launcher->RunParticipant(0);
+      launcher->active_pool = nullptr;
+    }
+    return launcher->WaitForJobs();
+  }
+
+  // The scheduling state of a worker, padded to avoid false sharing.
+  struct WorkerState {
+    // Whether the worker waits for a task, only used as a hint when recruiting.
+    alignas(kL1CacheBytes) std::atomic<bool> idle{true};
+    // Serializes the producers of the worker's single producer queue.
+    std::atomic<bool> push_lock{false};
+  };
+
+  // Push a task to a worker, waiting for the other producers of its queue.
+  void PushTask(int worker_id, const SpscTaskQueue::Task& tsk) {
+    WorkerState& state = worker_states_[worker_id];
+    while (state.push_lock.exchange(true, std::memory_order_acquire)) {
+      tvm::runtime::threading::Yield();
+    }
+    queues_[worker_id]->Push(tsk);
+    state.push_lock.store(false, std::memory_order_release);
+  }
+
+  // Hand a task to a worker if it is idle, without waiting.
+  bool TryRecruit(int worker_id, const SpscTaskQueue::Task& tsk) {
+    WorkerState& state = worker_states_[worker_id];
+    if (!state.idle.load(std::memory_order_relaxed)) return false;
+    if (state.push_lock.exchange(true, std::memory_order_acquire)) return false;
+    bool success = queues_[worker_id]->TryPush(tsk);
+    state.push_lock.store(false, std::memory_order_release);
+    return success;
+  }
+
   // Internal worker function.
   void RunWorker(int worker_id) {
     SpscTaskQueue* queue = queues_[worker_id].get();
+    WorkerState& state = worker_states_[worker_id];
     SpscTaskQueue::Task task;
     ParallelLauncher::ThreadLocal()->is_worker = true;
-    // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
-    // the global first use of the ThreadPool.
-    // TODO(tulloch): should we make this configurable via standard APIs?
-    static size_t spin_count = GetSpinCount();
-    while (queue->Pop(&task, spin_count)) {
-      ICHECK(task.launcher != nullptr);
-      TVMParallelGroupEnv* penv = &(task.launcher->env);
-      void* cdata = task.launcher->cdata;
-      if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
-        task.launcher->SignalJobFinish();
+    ParallelLauncher::ThreadLocal()->active_pool = this;
+    while (true) {
+      // The policy is read before each wait, so that it can be changed between jobs.
+      threading::WaitPolicy policy = wait_policy_.load(std::memory_order_relaxed);
+      uint32_t spin_count = spin_count_.load(std::memory_order_relaxed);
+      if (policy == threading::kWaitSleep ||
+          (policy == threading::kWaitAdaptive &&
+           avg_gap_ns_.load(std::memory_order_relaxed) > kAdaptiveSpinGapNs)) {
+        spin_count = 0;
+      }
+      if (!queue->Pop(&task, spin_count, policy != threading::kWaitSpin)) break;
+      state.idle.store(false, std::memory_order_relaxed);
+      // Place the workspaces allocated by the task on the node of the pool.
+      int numa_node = numa_node_.load(std::memory_order_relaxed);
+      if (numa_node != threading::CurrentNumaNode()) threading::SetCurrentNumaNode(numa_node);
+      if (task.nested != nullptr) {
+        task.nested->Run();
+        task.nested.reset();
+      } else if (task.launcher->work_stealing) {
+        task.launcher->RunParticipant(task.task_id);
       } else {
-        task.launcher->SignalJobError(task.task_id);
+        TVMParallelGroupEnv* penv = &(task.launcher->env);
+        void* cdata = task.launcher->cdata;
+        if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
+          task.launcher->SignalJobFinish();
+        } else {
+          task.launcher->SignalJobError(task.task_id);
+        }
       }
+      state.idle.store(true, std::memory_order_relaxed);
     }
   }
   int num_workers_;
@@ -369,7 +657,21 @@ class ThreadPool {
   int num_workers_used_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
+  // number of tasks per worker in work stealing mode, 0 disables work stealing
+  int work_stealing_chunks_{0};
+  // whether jobs launched from inside a task are shared with the idle workers
+  bool nested_{false};
+  // the NUMA node the workers are bound to, -1 for none
+  std::atomic<int> numa_node_{-1};
+  // how the idle workers wait for the next job
+  std::atomic<threading::WaitPolicy> wait_policy_{threading::kWaitYield};
+  // the number of iterations the idle workers spin before sleeping
+  std::atomic<uint32_t> spin_count_{kDefaultSpinCount};
+  // the smoothed gap between jobs and the end of the last job, for the adaptive policy
+  std::atomic<int64_t> avg_gap_ns_{0};
+  int64_t last_finish_ns_{0};
   std::vector<std::unique_ptr<SpscTaskQueue>> queues_;
+  std::unique_ptr<WorkerState[]> worker_states_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
 
@@ -392,6 +694,54 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRe
   threading::Configure(mode, nthreads, cpus);
 });
 
+/*!
+ * \brief args[0] is the number of tasks per worker a parallel job is split into so that
+ *  idle workers can steal the tasks of preempted ones, 0 disables work stealing.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_work_stealing")
+    .set_body_typed([](int chunks_per_worker) {
+      threading::ConfigureWorkStealing(chunks_per_worker);
+    });
+
+/*!
+ * \brief args[0] is whether parallel jobs launched from inside a parallel task are
+ *  shared with the idle workers of the pool instead of running inline.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_nested").set_body_typed([](bool nested) {
+  threading::ConfigureNestedParallelism(nested);
+});
+
+/*!
+ * \brief args[0] is the NUMA node the thread pool of the calling thread is bound to,
+ *  args[1] is the number of threads.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_numa_node")
+    .set_body_typed([](int node, int nthreads) { threading::ConfigureNumaNode(node, nthreads); });
+
+/*!
+ * \brief args[0] is the WaitPolicy of the idle workers, args[1] is the number of spin
+ *  iterations before sleeping, -1 to keep the current one.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_wait_policy")
+    .set_body_typed([](int policy, int spin_count) {
+      ICHECK(policy >= threading::kWaitYield && policy <= threading::kWaitAdaptive)
+          << "ValueError: unknown thread pool wait policy " << policy;
+      threading::ConfigureWaitPolicy(static_cast<threading::WaitPolicy>(policy), spin_count);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.threadpool_warm_up").set_body_typed([]() {
+  threading::WarmUpThreadPool();
+});
+
+TVM_REGISTER_GLOBAL("runtime.NumNumaNodes").set_body_typed([]() -> int32_t {
+  return threading::NumNumaNodes();
+});
+
+TVM_REGISTER_GLOBAL("runtime.NumaNodeCPUs").set_body_typed([](int node) {
+  std::vector<unsigned int> cpus = threading::NumaNodeCPUs(node);
+  return ShapeTuple(cpus.begin(), cpus.end());
+});
+
 TVM_REGISTER_GLOBAL("runtime.NumThreads").set_body_typed([]() -> int32_t {
   return threading::NumThreads();
 });
@@ -466,12 +816,59 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
   ConfigureOMP(mode, nthreads, cpus);
 #endif
 }
+void ConfigureWorkStealing(int chunks_per_worker) {
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->UpdateWorkStealing(chunks_per_worker);
+#endif
+}
+void ConfigureNestedParallelism(bool nested) {
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->UpdateNestedParallelism(nested);
+#endif
+}
+void ConfigureWaitPolicy(WaitPolicy policy, int spin_count) {
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->UpdateWaitPolicy(policy, spin_count);
+#endif
+}
+void WarmUpThreadPool() {
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->WarmUp();
+#endif
+}
+void ConfigureNumaNode(int node, int nthreads) {
+  std::vector<unsigned int> cpus = NumaNodeCPUs(node);
+  ICHECK_GE(nthreads, 0) << "ValueError: the number of threads can not be negative";
+  Configure(ThreadGroup::kSpecifyThreadShareAllCore, nthreads, cpus);
+  SetCurrentNumaNode(node);
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->UpdateNumaNode(node);
+#endif
+}
 int32_t NumThreads() { return tvm::runtime::ThreadPool::ThreadLocal()->NumThreads(); }
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
 
+#if defined(__hexagon__)
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+// Defined in hexagon_device_api.cc; runs the lambda on the HVX threads of the thread manager.
+bool ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task, int* ret);
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
+#endif
+
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  TVM_TRACE(ParallelLaunch, num_task, 0);
+#if defined(__hexagon__)
+  int ret = 0;
+  if (tvm::runtime::hexagon::ParallelLaunch(flambda, cdata, num_task, &ret)) {
+    return ret;
+  }
+#endif
   int num_workers = tvm::runtime::threading::MaxConcurrency();
   if (num_workers == 1) {
     std::atomic<int32_t> sync_counter{0};
@@ -482,6 +879,10 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
     return 0;
   } else {
 #if !TVM_THREADPOOL_USE_OPENMP
+    tvm::runtime::ParallelLauncher* launcher = tvm::runtime::ParallelLauncher::ThreadLocal();
+    if (launcher->active_pool != nullptr) {
+      return launcher->active_pool->LaunchNested(flambda, cdata, num_task);
+    }
     int res = tvm::runtime::ThreadPool::ThreadLocal()->Launch(flambda, cdata, num_task, 1);
     return res;
 #else
@@ -503,6 +904,8 @@ int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) {
 #pragma omp barrier
 #else
   using tvm::runtime::kSyncStride;
+  ICHECK(penv->sync_handle != nullptr)
+      << "Parallel barrier is not supported when the thread pool runs in work stealing mode";
   int num_task = penv->num_task;
   std::atomic<int>* sync_counter = reinterpret_cast<std::atomic<int>*>(penv->sync_handle);
   int old_counter = sync_counter[task_id * kSyncStride].fetch_add(1, std::memory_order_release);
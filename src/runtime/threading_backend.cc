@@ -35,6 +35,10 @@
 #if defined(__linux__)
 #include <sched.h>
 #endif
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #if defined(__hexagon__)
 extern "C" {
 #include <qurt_hvx.h>
@@ -46,6 +50,7 @@ extern "C" {
 #define HEXAGON_STACK_ALIGNMENT 32
 #endif
 #include <algorithm>
+#include <string>
 #include <thread>
 #define CURRENT_THREAD_HANDLE (static_cast<std::thread::native_handle_type>(0))
 namespace tvm {
@@ -431,6 +436,76 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+namespace {
+
+/*! \brief The CPUs of each NUMA node, read once from sysfs. */
+const std::vector<std::vector<unsigned int>>& NumaTopology() {
+  static const std::vector<std::vector<unsigned int>> topology = []() {
+    std::vector<std::vector<unsigned int>> nodes;
+#if defined(__linux__) || defined(__ANDROID__)
+    // Each node lists its CPUs as ranges, e.g. "0-15,32-47".
+    for (int node = 0;; ++node) {
+      std::ifstream ifs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      if (ifs.fail()) break;
+      std::vector<unsigned int> cpus;
+      std::string range;
+      while (std::getline(ifs, range, ',')) {
+        unsigned int first = 0, last = 0;
+        char dash;
+        std::istringstream is(range);
+        if (!(is >> first)) continue;
+        if (!(is >> dash >> last)) last = first;
+        for (unsigned int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+      }
+      nodes.push_back(cpus);
+    }
+#endif
+    if (nodes.empty()) {
+      std::vector<unsigned int> cpus(std::max(std::thread::hardware_concurrency(), 1U));
+      for (size_t i = 0; i < cpus.size(); ++i) cpus[i] = i;
+      nodes.push_back(cpus);
+    }
+    return nodes;
+  }();
+  return topology;
+}
+
+thread_local int current_numa_node = -1;
+
+}  // namespace
+
+int NumNumaNodes() { return NumaTopology().size(); }
+
+std::vector<unsigned int> NumaNodeCPUs(int node) {
+  ICHECK(node >= 0 && node < NumNumaNodes())
+      << "ValueError: NUMA node " << node << " does not exist, the system has "
+      << NumNumaNodes() << " nodes";
+  return NumaTopology()[node];
+}
+
+int CurrentNumaNode() { return current_numa_node; }
+
+void SetCurrentNumaNode(int node) { current_numa_node = node; }
+
+void BindMemoryToNumaNode(void* ptr, size_t nbytes, int node) {
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SYS_mbind)
+  // MPOL_PREFERRED from numaif.h, which is only shipped with libnuma.
+  constexpr int kPolicyPreferred = 1;
+  constexpr size_t kMaxNodes = 1024;
+  if (node < 0 || static_cast<size_t>(node) >= kMaxNodes) return;
+  uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page - 1) / page * page;
+  uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + nbytes) / page * page;
+  if (end <= begin) return;
+  uint64_t mask[kMaxNodes / 64] = {0};
+  mask[node / 64] = uint64_t(1) << (node % 64);
+  // The pages are not touched yet, so the policy decides where they are placed.
+  if (syscall(SYS_mbind, begin, end - begin, kPolicyPreferred, mask, kMaxNodes, 0) != 0) {
+    VLOG(1) << "mbind to NUMA node " << node << " failed";
+  }
+#endif
+}
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file trace.cc
+ * \brief The ring buffer behind the runtime tracepoints.
+ */
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/trace.h>
+
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace trace {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+struct TraceRecord {
+  int64_t ts_ns;
+  int64_t a0;
+  int64_t a1;
+  int32_t tid;
+  TraceEvent event;
+};
+
+const char* EventName(TraceEvent event) {
+  switch (event) {
+    case kKernelLaunch:
+      return "KernelLaunch";
+    case kAlloc:
+      return "Alloc";
+    case kFree:
+      return "Free";
+    case kCopy:
+      return "Copy";
+    case kVMInstruction:
+      return "VMInstruction";
+    case kParallelLaunch:
+      return "ParallelLaunch";
+    case kRPCMessage:
+      return "RPCMessage";
+  }
+  return "Unknown";
+}
+
+/*!
+ * \brief The records, written lock free by the tracepoints. Once full, the oldest records are
+ * overwritten. The buffer is only resized while tracing is disabled, under mu.
+ */
+struct RingBuffer {
+  std::mutex mu;
+  std::vector<TraceRecord> records;
+  std::atomic<uint64_t> next{0};
+  std::chrono::steady_clock::time_point origin;
+
+  static RingBuffer* Global() {
+    // Leaked, so that tracepoints hit during static destruction still find it.
+    static RingBuffer* inst = new RingBuffer();
+    return inst;
+  }
+};
+
+int32_t ThreadIndex() {
+  static std::atomic<int32_t> num_threads{0};
+  thread_local int32_t tid = num_threads.fetch_add(1);
+  return tid;
+}
+
+}  // namespace
+
+void Record(TraceEvent event, int64_t a0, int64_t a1) {
+  RingBuffer* buf = RingBuffer::Global();
+  if (buf->records.empty()) return;
+  uint64_t slot = buf->next.fetch_add(1, std::memory_order_relaxed) % buf->records.size();
+  int64_t ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - buf->origin)
+                   .count();
+  buf->records[slot] = {ts, a0, a1, ThreadIndex(), event};
+}
+
+void Enable(int64_t capacity) {
+  ICHECK_GT(capacity, 0) << "ValueError: the tracepoint buffer needs a positive capacity";
+  RingBuffer* buf = RingBuffer::Global();
+  std::lock_guard<std::mutex> lock(buf->mu);
+  enabled.store(false);
+  if (buf->records.size() != static_cast<size_t>(capacity)) {
+    buf->records.assign(capacity, TraceRecord());
+  }
+  buf->next.store(0);
+  buf->origin = std::chrono::steady_clock::now();
+  enabled.store(true);
+}
+
+void Disable() { enabled.store(false); }
+
+/*! \brief The records in the buffer as a Chrome trace of instant events, oldest first. */
+String Dump() {
+  RingBuffer* buf = RingBuffer::Global();
+  std::lock_guard<std::mutex> lock(buf->mu);
+  uint64_t end = buf->next.load();
+  uint64_t size = buf->records.size();
+  uint64_t begin = end > size ? end - size : 0;
+  std::ostringstream s;
+  s << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (uint64_t i = begin; i < end; ++i) {
+    const TraceRecord& r = buf->records[i % size];
+    s << (i == begin ? "" : ",") << "{\"name\":\"" << EventName(r.event)
+      << "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << r.ts_ns / 1000.0 << ",\"pid\":0,\"tid\":"
+      << r.tid << ",\"args\":{\"a0\":" << r.a0 << ",\"a1\":" << r.a1 << "}}";
+  }
+  s << "]}";
+  return s.str();
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.EnableTracepoints").set_body_typed(Enable);
+TVM_REGISTER_GLOBAL("runtime.profiling.DisableTracepoints").set_body_typed(Disable);
+TVM_REGISTER_GLOBAL("runtime.profiling.DumpTracepoints").set_body_typed(Dump);
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/cuda_graph/vm_cuda_graph.cc
+ * \brief The Relay virtual machine with CUDA graph support.
+ */
+
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief Virtual machine replaying the kernels of static regions as CUDA graphs.
+ *
+ *  A region is a straight-line range of instructions, without branch targets,
+ *  made only of InvokePacked, AllocTensor and KillRegister, and holding at least
+ *  kMinRegionKernels kernel calls. Given the objects in the registers the region
+ *  reads before writing them (its live-ins), every tensor and kernel launch of the
+ *  region is fully determined, so the launches are captured with the CUDA stream
+ *  capture API the second time a region runs with the same live-ins, and replayed
+ *  with a single graph launch afterwards. The host side instructions of a replayed
+ *  region still run as usual, only the kernel calls are skipped.
+ */
+class VirtualMachineCudaGraph : public VirtualMachine {
+ public:
+  /*! \brief The minimum number of kernel calls of a region worth capturing. */
+  static constexpr size_t kMinRegionKernels = 2;
+  /*! \brief The maximum number of graphs kept for each region. */
+  static constexpr size_t kMaxGraphsPerRegion = 16;
+
+  ~VirtualMachineCudaGraph() {
+    for (auto& kv : regions_) {
+      for (auto& region : kv.second) {
+        for (auto& graph : region.second.graphs) {
+          CUDA_CALL(cudaGraphExecDestroy(graph.second));
+        }
+      }
+    }
+    for (auto& kv : streams_) {
+      TVMStreamFree(kDLCUDA, kv.first, kv.second);
+    }
+  }
+
+  void LoadExecutable(const ObjectPtr<Executable>& exec) final {
+    VirtualMachine::LoadExecutable(exec);
+    for (const VMFunction& func : exec_->functions) {
+      regions_[func.instructions.data()] = FindRegions(func);
+    }
+  }
+
+ private:
+  /*! \brief How the region uses one of its live-in registers. */
+  enum class LiveInKind { kTensor, kStorage, kScalar };
+
+  struct Region {
+    /*! \brief The first instruction of the region, always an InvokePacked. */
+    Index start;
+    /*! \brief The last InvokePacked of the region. */
+    Index last_kernel;
+    /*! \brief The registers read before being written, and how they are used. */
+    std::vector<std::pair<RegName, LiveInKind>> live_ins;
+    /*! \brief The keys which ran once, and will be captured the next time they run. */
+    std::unordered_set<std::string> seen;
+    /*! \brief The captured graphs keyed by the live-ins they were captured with. */
+    std::unordered_map<std::string, cudaGraphExec_t> graphs;
+  };
+
+  static std::unordered_map<Index, Region> FindRegions(const VMFunction& func) {
+    const std::vector<Instruction>& code = func.instructions;
+    std::vector<bool> is_target(code.size() + 1, false);
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+      if (code[pc].op == Opcode::Goto) {
+        is_target[pc + code[pc].pc_offset] = true;
+      } else if (code[pc].op == Opcode::If) {
+        is_target[pc + code[pc].if_op.true_offset] = true;
+        is_target[pc + code[pc].if_op.false_offset] = true;
+      }
+    }
+
+    std::unordered_map<Index, Region> regions;
+    size_t pc = 0;
+    while (pc < code.size()) {
+      if (code[pc].op != Opcode::InvokePacked) {
+        ++pc;
+        continue;
+      }
+      Region region;
+      region.start = pc;
+      region.last_kernel = pc;
+      size_t num_kernels = 0;
+      size_t num_live_ins = 0;
+      std::unordered_set<RegName> written;
+      auto read = [&](RegName reg, LiveInKind kind) {
+        if (!written.count(reg)) {
+          region.live_ins.emplace_back(reg, kind);
+          written.insert(reg);
+        }
+      };
+      size_t end = pc;
+      for (; end < code.size() && (end == pc || !is_target[end]); ++end) {
+        const Instruction& instr = code[end];
+        if (instr.op == Opcode::InvokePacked) {
+          for (Index i = 0; i < instr.arity; ++i) {
+            read(instr.packed_args[i], LiveInKind::kTensor);
+          }
+          region.last_kernel = end;
+          num_live_ins = region.live_ins.size();
+          ++num_kernels;
+        } else if (instr.op == Opcode::AllocTensor) {
+          read(instr.alloc_tensor.storage, LiveInKind::kStorage);
+          read(instr.alloc_tensor.offset, LiveInKind::kScalar);
+          written.insert(instr.dst);
+        } else if (instr.op == Opcode::KillRegister) {
+          written.insert(instr.dst);
+        } else {
+          break;
+        }
+      }
+      if (num_kernels >= kMinRegionKernels) {
+        // Registers read after the last kernel belong to the code following the region.
+        region.live_ins.resize(num_live_ins);
+        regions.emplace(pc, std::move(region));
+      }
+      pc = end;
+    }
+    return regions;
+  }
+
+  Region* FindRegion(Index pc) {
+    auto it = regions_.find(code_);
+    if (it == regions_.end()) return nullptr;
+    auto region = it->second.find(pc);
+    return region == it->second.end() ? nullptr : &region->second;
+  }
+
+  /*!
+   * \brief Build the key identifying the live-ins of a region.
+   * \return false if the region cannot be captured with the current live-ins.
+   */
+  bool MakeKey(const Region& region, std::string* key, int* device_id) {
+    auto append = [key](const void* data, size_t size) {
+      key->append(static_cast<const char*>(data), size);
+    };
+    *device_id = -1;
+    auto on_capture_device = [device_id](const Device& dev) {
+      if (dev.device_type != kDLCUDA) return false;
+      if (*device_id == -1) *device_id = dev.device_id;
+      return dev.device_id == *device_id;
+    };
+    auto append_tensor = [&](const ObjectRef& obj) {
+      const auto* tensor = obj.as<NDArray::Container>();
+      if (tensor == nullptr || !on_capture_device(tensor->dl_tensor.device)) return false;
+      const DLTensor& dl = tensor->dl_tensor;
+      append(&dl.data, sizeof(dl.data));
+      append(&dl.byte_offset, sizeof(dl.byte_offset));
+      append(&dl.dtype, sizeof(dl.dtype));
+      append(dl.shape, sizeof(int64_t) * dl.ndim);
+      return true;
+    };
+    for (const auto& live_in : region.live_ins) {
+      ObjectRef obj = ReadRegister(live_in.first);
+      if (!obj.defined()) return false;
+      if (live_in.second == LiveInKind::kScalar) {
+        int64_t value = LoadScalarInt(live_in.first);
+        append(&value, sizeof(value));
+      } else if (live_in.second == LiveInKind::kStorage) {
+        const auto* storage = obj.as<StorageObj>();
+        if (storage == nullptr || !on_capture_device(storage->buffer.device)) return false;
+        append(&storage->buffer.data, sizeof(storage->buffer.data));
+        append(&storage->buffer.size, sizeof(storage->buffer.size));
+      } else if (const auto* adt = obj.as<ADTObj>()) {
+        for (size_t i = 0; i < adt->size; ++i) {
+          if (!append_tensor((*adt)[i])) return false;
+        }
+      } else if (!append_tensor(obj)) {
+        return false;
+      }
+    }
+    return *device_id != -1;
+  }
+
+  TVMStreamHandle GetStream(int device_id) {
+    auto it = streams_.find(device_id);
+    if (it != streams_.end()) return it->second;
+    TVMStreamHandle stream;
+    TVMStreamCreate(kDLCUDA, device_id, &stream);
+    streams_[device_id] = stream;
+    return stream;
+  }
+
+  void InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count, Index output_size,
+                    const std::vector<ObjectRef>& args) final {
+    if (capturing_ != nullptr) {
+      VirtualMachine::InvokePacked(packed_index, func, arg_count, output_size, args);
+      if (pc_ == capturing_->last_kernel) EndCapture();
+      return;
+    }
+    if (replaying_ != nullptr && code_ == replay_code_ && pc_ > replaying_->start &&
+        pc_ <= replaying_->last_kernel) {
+      // Already launched as part of the graph of the region.
+      return;
+    }
+    replaying_ = nullptr;
+
+    // Tensors given through set_outputs are not live-ins of the regions writing them.
+    Region* region = output_tensor_reg_indices_.empty() ? FindRegion(pc_) : nullptr;
+    std::string key;
+    int device_id;
+    if (region == nullptr || !MakeKey(*region, &key, &device_id)) {
+      VirtualMachine::InvokePacked(packed_index, func, arg_count, output_size, args);
+      return;
+    }
+
+    auto it = region->graphs.find(key);
+    if (it != region->graphs.end()) {
+      cudaStream_t stream = static_cast<cudaStream_t>(GetStream(device_id));
+      CUDA_CALL(cudaGraphLaunch(it->second, stream));
+      replaying_ = region;
+      replay_code_ = code_;
+      return;
+    }
+    if (region->graphs.size() < kMaxGraphsPerRegion && !region->seen.insert(key).second) {
+      // Capture the region on its second run, so that kernel modules are already loaded.
+      TVMStreamHandle stream = GetStream(device_id);
+      TVMSetStream(kDLCUDA, device_id, stream);
+      CUDA_CALL(cudaStreamBeginCapture(static_cast<cudaStream_t>(stream),
+                                       cudaStreamCaptureModeGlobal));
+      capturing_ = region;
+      capture_key_ = std::move(key);
+      capture_device_id_ = device_id;
+    }
+    VirtualMachine::InvokePacked(packed_index, func, arg_count, output_size, args);
+  }
+
+  void EndCapture() {
+    cudaStream_t stream = static_cast<cudaStream_t>(GetStream(capture_device_id_));
+    cudaGraph_t graph;
+    CUDA_CALL(cudaStreamEndCapture(stream, &graph));
+    TVMSetStream(kDLCUDA, capture_device_id_, nullptr);
+    cudaGraphExec_t graph_exec;
+    CUDA_CALL(cudaGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
+    CUDA_CALL(cudaGraphDestroy(graph));
+    // The captured kernels were only recorded, run them now.
+    CUDA_CALL(cudaGraphLaunch(graph_exec, stream));
+    capturing_->graphs.emplace(std::move(capture_key_), graph_exec);
+    capturing_->seen.erase(capture_key_);
+    capturing_ = nullptr;
+  }
+
+  /*! \brief The regions of each function, keyed by the function's code. */
+  std::unordered_map<const Instruction*, std::unordered_map<Index, Region>> regions_;
+  /*! \brief The stream graphs are captured and launched on, per CUDA device. */
+  std::unordered_map<int, TVMStreamHandle> streams_;
+  /*! \brief The region being captured, if any. */
+  Region* capturing_{nullptr};
+  std::string capture_key_;
+  int capture_device_id_{0};
+  /*! \brief The region whose graph was just launched, if any. */
+  Region* replaying_{nullptr};
+  const Instruction* replay_code_{nullptr};
+};
+
+runtime::Module CreateVirtualMachineCudaGraph(Executable* exec) {
+  auto vm = make_object<VirtualMachineCudaGraph>();
+  vm->LoadExecutable(GetObjectPtr<Executable>(exec));
+  return runtime::Module(vm);
+}
+
+TVM_REGISTER_GLOBAL("runtime._VirtualMachineCudaGraph")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      runtime::Module mod = args[0];
+      auto* exec = dynamic_cast<Executable*>(mod.operator->());
+      *rv = CreateVirtualMachineCudaGraph(exec);
+    });
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,336 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/dynamic_batcher.cc
+ * \brief A dynamic request batching front-end for the Relay virtual machine.
+ */
+
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief Batch the requests of concurrent callers into single VM invocations.
+ *
+ *  Every input of a request holds the same number of rows along its first axis.
+ *  Requests whose inputs agree on everything but that number are gathered into
+ *  the rows of one batch, until either max_batch_size rows are pending or the
+ *  oldest request waited for the timeout. The batch is padded to the smallest
+ *  bucket holding all its rows, so that the VM only sees a few distinct batch
+ *  sizes, and the outputs of each request are views over its rows of the batch
+ *  outputs. The rows of the function must therefore be independent of each other.
+ *
+ *  The batch input tensors are allocated once per bucket and input shape, and the
+ *  inputs of the requests are copied into them directly. The rows of padding are
+ *  left uninitialized.
+ */
+class DynamicBatcher : public ModuleNode {
+ public:
+  DynamicBatcher(Module vm, std::string func_name, int64_t max_batch_size,
+                 int64_t timeout_us, std::vector<int64_t> buckets, Device dev)
+      : vm_(vm),
+        func_name_(std::move(func_name)),
+        max_batch_size_(max_batch_size),
+        timeout_(timeout_us),
+        buckets_(std::move(buckets)),
+        dev_(dev) {
+    ICHECK_GT(max_batch_size_, 0) << "The maximum batch size must be positive";
+    ICHECK_GE(timeout_us, 0) << "The batching timeout must be non negative";
+    std::sort(buckets_.begin(), buckets_.end());
+    if (!buckets_.empty()) {
+      ICHECK_GT(buckets_.front(), 0) << "Batch buckets must be positive";
+      ICHECK_LE(max_batch_size_, buckets_.back())
+          << "The maximum batch size " << max_batch_size_ << " exceeds the largest bucket "
+          << buckets_.back();
+    }
+    set_input_ = vm_.GetFunction("set_input");
+    invoke_ = vm_.GetFunction("invoke");
+    ICHECK(set_input_ != nullptr && invoke_ != nullptr) << "Expected a VirtualMachine module";
+    worker_ = std::thread([this]() { this->Loop(); });
+  }
+
+  ~DynamicBatcher() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "submit") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::vector<NDArray> inputs;
+        inputs.reserve(args.size());
+        for (int i = 0; i < args.size(); ++i) {
+          inputs.push_back(args[i]);
+        }
+        *rv = Submit(std::move(inputs));
+      });
+    } else if (name == "get_num_batches") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mu_);
+        *rv = num_batches_;
+      });
+    }
+    return nullptr;
+  }
+
+  const char* type_key() const final { return "DynamicBatcher"; }
+
+  /*!
+   * \brief Run one request as part of a batch, blocking until its outputs are ready.
+   * \param inputs The inputs of the request, all holding the same number of rows.
+   * \return The outputs of the request, views over the outputs of the batch.
+   */
+  Array<NDArray> Submit(std::vector<NDArray> inputs) {
+    ICHECK(!inputs.empty()) << "A batched request needs at least one input";
+    auto request = std::make_shared<Request>();
+    request->rows = inputs[0]->ndim > 0 ? inputs[0]->shape[0] : 0;
+    ICHECK(request->rows > 0 && request->rows <= max_batch_size_)
+        << "The number of rows of a request must be in [1, " << max_batch_size_ << "], got "
+        << request->rows;
+    for (const NDArray& input : inputs) {
+      ICHECK(input.IsContiguous()) << "Batched inputs must be contiguous";
+      ICHECK(input->ndim > 0 && input->shape[0] == request->rows)
+          << "All the inputs of a request must have the same number of rows";
+    }
+    request->signature = Signature(inputs);
+    request->inputs = std::move(inputs);
+    request->arrival = Clock::now();
+    std::future<Array<NDArray>> result = request->result.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      ICHECK(!stop_) << "The batcher is shutting down";
+      pending_rows_ += request->rows;
+      queue_.push_back(std::move(request));
+    }
+    cv_.notify_all();
+    return result.get();
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    std::vector<NDArray> inputs;
+    /*! \brief The dtypes and non batch dimensions of the inputs. */
+    std::string signature;
+    int64_t rows;
+    Clock::time_point arrival;
+    std::promise<Array<NDArray>> result;
+  };
+
+  static std::string Signature(const std::vector<NDArray>& inputs) {
+    std::string signature;
+    auto append = [&signature](const void* data, size_t size) {
+      signature.append(static_cast<const char*>(data), size);
+    };
+    for (const NDArray& input : inputs) {
+      append(&input->dtype, sizeof(input->dtype));
+      append(&input->ndim, sizeof(input->ndim));
+      append(input->shape + 1, sizeof(int64_t) * (input->ndim - 1));
+    }
+    return signature;
+  }
+
+  void Loop() {
+    while (true) {
+      std::vector<std::shared_ptr<Request>> batch;
+      {
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) return;
+        cv_.wait_until(lock, queue_.front()->arrival + timeout_,
+                       [this]() { return stop_ || pending_rows_ >= max_batch_size_; });
+        batch = TakeBatch();
+      }
+      RunBatch(batch);
+    }
+  }
+
+  /*! \brief Take the oldest request, and the queued requests compatible with it that fit. */
+  std::vector<std::shared_ptr<Request>> TakeBatch() {
+    std::vector<std::shared_ptr<Request>> batch;
+    std::deque<std::shared_ptr<Request>> remaining;
+    int64_t rows = 0;
+    for (auto& request : queue_) {
+      if ((batch.empty() || request->signature == batch[0]->signature) &&
+          rows + request->rows <= max_batch_size_) {
+        rows += request->rows;
+        batch.push_back(std::move(request));
+      } else {
+        remaining.push_back(std::move(request));
+      }
+    }
+    queue_.swap(remaining);
+    pending_rows_ -= rows;
+    return batch;
+  }
+
+  int64_t Bucket(int64_t rows) const {
+    auto it = std::lower_bound(buckets_.begin(), buckets_.end(), rows);
+    return it == buckets_.end() ? rows : *it;
+  }
+
+  /*! \brief Get the preallocated input tensors of a batch of the given size. */
+  std::vector<NDArray>& BatchInputs(const Request& request, int64_t bucket) {
+    std::string key(reinterpret_cast<const char*>(&bucket), sizeof(bucket));
+    key += request.signature;
+    auto it = batch_inputs_.find(key);
+    if (it != batch_inputs_.end()) return it->second;
+    std::vector<NDArray> tensors;
+    for (const NDArray& input : request.inputs) {
+      std::vector<int64_t> shape(input->shape, input->shape + input->ndim);
+      shape[0] = bucket;
+      tensors.push_back(NDArray::Empty(ShapeTuple(shape), input->dtype, dev_));
+    }
+    return batch_inputs_.emplace(std::move(key), std::move(tensors)).first->second;
+  }
+
+  void RunBatch(const std::vector<std::shared_ptr<Request>>& batch) {
+    try {
+      int64_t rows = 0;
+      for (const auto& request : batch) rows += request->rows;
+      std::vector<NDArray>& inputs = BatchInputs(*batch[0], Bucket(rows));
+
+      // Gather the inputs of the requests into their rows of the batch.
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        size_t row_bytes = GetDataSize(*inputs[i].operator->()) / inputs[i]->shape[0];
+        int64_t offset = 0;
+        for (const auto& request : batch) {
+          const NDArray& input = request->inputs[i];
+          std::vector<int64_t> shape(input->shape, input->shape + input->ndim);
+          inputs[i].CreateView(ShapeTuple(shape), input->dtype, offset * row_bytes).CopyFrom(input);
+          offset += request->rows;
+        }
+      }
+
+      std::vector<TVMValue> values(inputs.size() + 1);
+      std::vector<int> codes(inputs.size() + 1);
+      TVMArgsSetter setter(values.data(), codes.data());
+      setter(0, func_name_);
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        setter(i + 1, inputs[i]);
+      }
+      TVMRetValue rv;
+      set_input_.CallPacked(TVMArgs(values.data(), codes.data(), values.size()), &rv);
+      ObjectRef ret = invoke_(func_name_);
+
+      std::vector<NDArray> outputs;
+      if (const auto* adt = ret.as<ADTObj>()) {
+        for (size_t i = 0; i < adt->size; ++i) {
+          outputs.push_back(Downcast<NDArray>((*adt)[i]));
+        }
+      } else {
+        outputs.push_back(Downcast<NDArray>(ret));
+      }
+      for (NDArray& output : outputs) {
+        ICHECK(output->ndim > 0 && output->shape[0] == inputs[0]->shape[0])
+            << "The outputs of a batched function must have the rows of its inputs";
+        ICHECK(output.IsContiguous()) << "The outputs of a batched function must be contiguous";
+        for (const NDArray& input : inputs) {
+          // The batch inputs are overwritten by the next batch, so must not be returned.
+          if (output->data == input->data) output = output.CopyTo(output->device);
+        }
+      }
+
+      // Scatter the outputs as views over the rows of each request.
+      int64_t offset = 0;
+      for (const auto& request : batch) {
+        Array<NDArray> result;
+        for (NDArray& output : outputs) {
+          size_t row_bytes = GetDataSize(*output.operator->()) / output->shape[0];
+          std::vector<int64_t> shape(output->shape, output->shape + output->ndim);
+          shape[0] = request->rows;
+          result.push_back(output.CreateView(ShapeTuple(shape), output->dtype, offset * row_bytes));
+        }
+        offset += request->rows;
+        request->result.set_value(result);
+      }
+    } catch (...) {
+      for (const auto& request : batch) {
+        request->result.set_exception(std::current_exception());
+      }
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    ++num_batches_;
+  }
+
+  /*! \brief The virtual machine running the batches. */
+  Module vm_;
+  PackedFunc set_input_;
+  PackedFunc invoke_;
+  /*! \brief The name of the batched function. */
+  std::string func_name_;
+  int64_t max_batch_size_;
+  /*! \brief How long the oldest request waits for more requests to batch with. */
+  std::chrono::microseconds timeout_;
+  /*! \brief The sorted batch sizes the batches are padded to. */
+  std::vector<int64_t> buckets_;
+  /*! \brief The device the batch inputs are allocated on. */
+  Device dev_;
+  /*! \brief The batch input tensors keyed by bucket and request signature. */
+  std::unordered_map<std::string, std::vector<NDArray>> batch_inputs_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Request>> queue_;
+  int64_t pending_rows_{0};
+  int64_t num_batches_{0};
+  bool stop_{false};
+  std::thread worker_;
+};
+
+TVM_REGISTER_GLOBAL("runtime._DynamicBatcher")
+    .set_body_typed([](Module vm, String func_name, int64_t max_batch_size, int64_t timeout_us,
+                       ShapeTuple buckets, Device dev) {
+      std::vector<int64_t> bucket_sizes(buckets.begin(), buckets.end());
+      auto batcher = make_object<DynamicBatcher>(vm, func_name, max_batch_size, timeout_us,
+                                                 std::move(bucket_sizes), dev);
+      return Module(batcher);
+    });
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
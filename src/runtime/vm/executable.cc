@@ -25,6 +25,7 @@
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/debug.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/vm.h>
@@ -87,6 +88,7 @@ PackedFunc Executable::GetFunction(const std::string& name, const ObjectPtr<Obje
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       auto vm = make_object<VirtualMachine>();
       ICHECK(sptr_to_self.get() == this);
+      vm->SetLazyPrimitives(args.size() > 0 && static_cast<bool>(args[0]));
       vm->LoadExecutable(GetObjectPtr<Executable>(this));
       *rv = Module(vm);
     });
@@ -110,6 +112,12 @@ PackedFunc Executable::GetFunction(const std::string& name, const ObjectPtr<Obje
       std::string path = args[0];
       LoadLateBoundConstantsFromFile(path);
     });
+  } else if (name == "save_to_mmap_file") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      CHECK_EQ(args.size(), 1);
+      std::string path = args[0];
+      SaveToMmapFile(path);
+    });
   } else if (name == "load_late_bound_consts_from_map") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
       CHECK_EQ(args.size(), 1);
@@ -378,6 +386,20 @@ void Executable::LoadLateBoundConstantsFromMap(Map<String, NDArray> map) {
 }
 
 void Executable::LoadLateBoundConstantsFromFile(const std::string& path) {
+  uint64_t header = 0;
+  {
+    tvm::runtime::SimpleBinaryFileStream stream(path, "rb");
+    stream.Read(&header, sizeof(header));
+  }
+  if (header == kTVMNDArrayMmapListMagic) {
+    // Bind the constants to views over the mapped file rather than reading them in.
+    if (late_bound_constant_names.empty()) {
+      VLOG(1) << "Found no late-bound constants to load";
+      return;
+    }
+    LoadLateBoundConstantsFromMap(runtime::LoadParamsMmap(path));
+    return;
+  }
   tvm::runtime::SimpleBinaryFileStream stream(path, "rb");
   LoadLateBoundConstantsFromStream(&stream);
 }
@@ -401,6 +423,7 @@ namespace {
 // Tags to distinguish immediate vs late-bound constants in constants table bytestream.
 constexpr uint32_t kImmediateConstTag = 0;
 constexpr uint32_t kLateBoundConstTag = 1;
+constexpr uint32_t kMappedConstTag = 2;
 }  // namespace
 
 void Executable::SaveConstantSection(dmlc::Stream* stream) {
@@ -408,7 +431,19 @@ void Executable::SaveConstantSection(dmlc::Stream* stream) {
   stream->Write(static_cast<uint64_t>(constants.size()));
 
   for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
-    if (late_bound_constant_names.empty() || !late_bound_constant_names[const_index].defined()) {
+    bool immediate =
+        late_bound_constant_names.empty() || !late_bound_constant_names[const_index].defined();
+    if (immediate && !mapped_const_offsets_.empty()) {
+      // Tag constants stored in the data region of a mappable file by 2.
+      const auto ndarray = Downcast<runtime::NDArray>(constants[const_index]);
+      ICHECK(ndarray.defined());
+      stream->Write(kMappedConstTag);
+      stream->Write(ndarray->ndim);
+      stream->Write(ndarray->dtype);
+      stream->WriteArray(ndarray->shape, ndarray->ndim);
+      stream->Write(mapped_const_offsets_[const_index]);
+      VLOG(1) << "save " << const_index << " as mapped";
+    } else if (immediate) {
       // Tag immediate constants by 0.
       stream->Write(kImmediateConstTag);
       // Write as DLTensor.
@@ -464,6 +499,24 @@ void Executable::LoadConstantSection(dmlc::Stream* stream) {
       constants[const_index] = NDArray(nullptr);
       late_bound_constant_names[const_index] = std::move(name);
       any_late_bound = true;
+    } else if (tag == kMappedConstTag) {
+      // Constants in the data region of a mappable file tagged by 2.
+      VLOG(1) << "load " << const_index << " as mapped";
+      ICHECK(mapped_file_ != nullptr)
+          << "The executable was saved by SaveToMmapFile and must be loaded by LoadFromMmapFile";
+      int ndim;
+      DLDataType dtype;
+      uint64_t offset;
+      STREAM_CHECK(stream->Read(&ndim), "mapped constant");
+      STREAM_CHECK(stream->Read(&dtype), "mapped constant");
+      std::vector<ShapeTuple::index_type> shape(ndim);
+      if (ndim != 0) {
+        STREAM_CHECK(stream->ReadArray(shape.data(), ndim), "mapped constant");
+      }
+      STREAM_CHECK(stream->Read(&offset), "mapped constant");
+      constants[const_index] =
+          ViewMappedFile(mapped_file_, mapped_data_offset_ + offset, ShapeTuple(shape), dtype);
+      late_bound_constant_names[const_index] = String(ObjectPtr<StringObj>(nullptr));
     } else {
       STREAM_CHECK(false, "constant tag");
     }
@@ -743,7 +796,14 @@ void Executable::SetLib(const runtime::Module& lib) {
 }
 
 runtime::Module Executable::Load(const std::string& code, const runtime::Module lib) {
+  return Load(code, lib, nullptr, 0);
+}
+
+runtime::Module Executable::Load(const std::string& code, const runtime::Module lib,
+                                 std::shared_ptr<MappedFile> mapped_file, size_t data_offset) {
   auto exec = make_object<Executable>();
+  exec->mapped_file_ = std::move(mapped_file);
+  exec->mapped_data_offset_ = data_offset;
 
   // Support null-initialization of lib, to enable initialization during
   // deserialization before we have deserialized the imports.
@@ -772,9 +832,82 @@ runtime::Module Executable::Load(const std::string& code, const runtime::Module
   // Code section.
   exec->LoadCodeSection(&strm);
 
+  // The mapping is only kept alive by the constants wrapping it.
+  exec->mapped_file_ = nullptr;
   return runtime::Module(exec);
 }
 
+namespace {
+
+uint64_t RoundUpOffset(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/*! \brief The magic, a reserved field and the size of the bytecode. */
+constexpr uint64_t kMmapExecutableHeaderSize = 3 * sizeof(uint64_t);
+
+}  // namespace
+
+void Executable::SaveToMmapFile(const std::string& path) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Memory mapped constants require a little endian host";
+  // Lay out the immediate constants in the data region.
+  std::vector<uint64_t> offsets(constants.size(), 0);
+  uint64_t data_size = 0;
+  for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
+    if (!constants[const_index].defined()) continue;
+    offsets[const_index] = data_size;
+    const auto ndarray = Downcast<NDArray>(constants[const_index]);
+    data_size = RoundUpOffset(data_size + GetDataSize(*ndarray.operator->()), kAllocAlignment);
+  }
+  mapped_const_offsets_ = offsets;
+  TVMByteArray code = Save();
+  mapped_const_offsets_.clear();
+
+  tvm::runtime::SimpleBinaryFileStream fs(path, "wb");
+  dmlc::Stream* strm = &fs;
+  uint64_t magic = kTVMVMMmapExecutableMagic, reserved = 0, code_size = code.size;
+  strm->Write(magic);
+  strm->Write(reserved);
+  strm->Write(code_size);
+  strm->Write(code.data, code.size);
+  uint64_t pos = kMmapExecutableHeaderSize + code.size;
+  uint64_t data_offset = RoundUpOffset(pos, kTVMNDArrayMmapPageAlignment);
+  std::vector<char> bytes;
+  for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
+    if (!constants[const_index].defined()) continue;
+    const auto ndarray = Downcast<NDArray>(constants[const_index]);
+    const DLTensor* tensor = ndarray.operator->();
+    size_t nbytes = GetDataSize(*tensor);
+    uint64_t offset = data_offset + offsets[const_index];
+    bytes.assign(offset - pos, 0);
+    strm->Write(bytes.data(), bytes.size());
+    if (tensor->device.device_type == kDLCPU && ndarray.IsContiguous()) {
+      strm->Write(static_cast<const char*>(tensor->data) + tensor->byte_offset, nbytes);
+    } else {
+      bytes.resize(nbytes);
+      ndarray.CopyToBytes(bytes.data(), nbytes);
+      strm->Write(bytes.data(), nbytes);
+    }
+    pos = offset + nbytes;
+  }
+}
+
+runtime::Module Executable::LoadFromMmapFile(const std::string& path, const runtime::Module lib) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Memory mapped constants require a little endian host";
+  auto file = std::make_shared<MappedFile>(path);
+  dmlc::MemoryFixedSizeStream mstrm(file->data(), file->size());
+  dmlc::Stream* strm = &mstrm;
+  uint64_t magic, reserved, code_size;
+  STREAM_CHECK(strm->Read(&magic) && magic == kTVMVMMmapExecutableMagic, "header");
+  STREAM_CHECK(strm->Read(&reserved), "header");
+  STREAM_CHECK(strm->Read(&code_size), "header");
+  STREAM_CHECK(kMmapExecutableHeaderSize + code_size <= file->size(), "header");
+  std::string code(file->data() + kMmapExecutableHeaderSize, code_size);
+  size_t data_offset =
+      RoundUpOffset(kMmapExecutableHeaderSize + code_size, kTVMNDArrayMmapPageAlignment);
+  return Load(code, lib, std::move(file), data_offset);
+}
+
 void Executable::LoadVirtualDevicesSection(dmlc::Stream* strm) {
   STREAM_CHECK(strm->Read(&virtual_devices), "virtual_device");
   STREAM_CHECK(strm->Read(&host_device_index), "virtual_device");
@@ -1123,6 +1256,11 @@ TVM_REGISTER_GLOBAL("runtime.Load_Executable")
       return Executable::Load(code, lib);
     });
 
+TVM_REGISTER_GLOBAL("runtime.Load_ExecutableFromMmapFile")
+    .set_body_typed([](std::string path, runtime::Module lib) {
+      return Executable::LoadFromMmapFile(path, lib);
+    });
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
@@ -21,13 +21,20 @@
  * \file tvm/runtime/vm/memory_manager.cc
  * \brief Allocate and manage memory for the runtime.
  */
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
+#include "size_class_allocator.h"
+#include "stream_ordered_allocator.h"
 
 namespace tvm {
 namespace runtime {
@@ -125,9 +132,32 @@ Allocator* MemoryManager::GetOrCreateAllocator(Device dev, AllocatorType type) {
         break;
       }
       case kPooled: {
+        // Per-thread free lists in front of the shared pool are enabled through the environment.
+        size_t thread_cache_bytes = 0;
+        if (const char* val = std::getenv("TVM_VM_POOL_THREAD_CACHE_BYTES")) {
+          thread_cache_bytes = std::strtoull(val, nullptr, 10);
+        }
         VLOG(1) << "New pooled allocator for " << DeviceName(dev.device_type) << "("
+                << dev.device_id << "), thread cache bytes " << thread_cache_bytes;
+        alloc.reset(
+            new PooledAllocator(dev, PooledAllocator::kDefaultPageSize, thread_cache_bytes));
+        break;
+      }
+      case kSizeClass: {
+        // The amount of idle memory kept by the pool can be capped through the environment.
+        size_t max_cached_bytes = 0;
+        if (const char* val = std::getenv("TVM_VM_POOL_MAX_CACHED_BYTES")) {
+          max_cached_bytes = std::strtoull(val, nullptr, 10);
+        }
+        VLOG(1) << "New size class allocator for " << DeviceName(dev.device_type) << "("
+                << dev.device_id << "), max cached bytes " << max_cached_bytes;
+        alloc.reset(new SizeClassAllocator(dev, max_cached_bytes));
+        break;
+      }
+      case kStreamOrdered: {
+        VLOG(1) << "New stream ordered allocator for " << DeviceName(dev.device_type) << "("
                 << dev.device_id << ")";
-        alloc.reset(new PooledAllocator(dev));
+        alloc.reset(new StreamOrderedAllocator(dev));
         break;
       }
       default:
@@ -157,6 +187,47 @@ Allocator* MemoryManager::GetAllocator(Device dev) {
   return it->second.get();
 }
 
+std::vector<std::pair<Device, Allocator*>> MemoryManager::ListAllocators() {
+  MemoryManager* m = MemoryManager::Global();
+  std::lock_guard<std::mutex> lock(m->mu_);
+  std::vector<std::pair<Device, Allocator*>> ret;
+  for (const auto& it : m->allocators_) {
+    ret.emplace_back(it.first, it.second.get());
+  }
+  return ret;
+}
+
+const char* Allocator::name() const {
+  switch (type_) {
+    case kNaive:
+      return "vm.naive";
+    case kPooled:
+      return "vm.pooled";
+    case kSizeClass:
+      return "vm.size_class";
+    case kStreamOrdered:
+      return "vm.stream_ordered";
+  }
+  return "vm.unknown";
+}
+
+TVM_REGISTER_GLOBAL("vm.memory_manager.PoolStats").set_body_typed([]() {
+  Array<Map<String, ObjectRef>> rows;
+  for (const auto& it : MemoryManager::ListAllocators()) {
+    Allocator* alloc = it.second;
+    size_t used = alloc->UsedMemory();
+    size_t cached = alloc->CachedMemory();
+    double occupancy = used == 0 ? 100.0 : 100.0 * (used - std::min(cached, used)) / used;
+    rows.push_back(
+        {{"Name", String(std::string(alloc->name()) + " pool")},
+         {"Device", String(DeviceName(it.first.device_type) + std::to_string(it.first.device_id))},
+         {"Current (bytes)", ObjectRef(make_object<profiling::CountNode>(used))},
+         {"Cached (bytes)", ObjectRef(make_object<profiling::CountNode>(cached))},
+         {"Occupancy", ObjectRef(make_object<profiling::PercentNode>(occupancy))}});
+  }
+  return rows;
+});
+
 NDArray Allocator::Empty(std::vector<int64_t> shape, DLDataType dtype, DLDevice dev) {
   VerifyDataType(dtype);
   NDArray::Container* container = new NDArray::Container(nullptr, shape, dtype, dev);
@@ -24,6 +24,7 @@
 #define TVM_RUNTIME_VM_NAIVE_ALLOCATOR_H_
 
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory_stats.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
 #include <atomic>
@@ -41,12 +42,14 @@ class NaiveAllocator final : public Allocator {
     buf.device = device_;
     buf.size = nbytes;
     buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, nbytes, alignment, type_hint);
+    MemoryStats::Global()->RecordAlloc(device_, name(), buf.data, nbytes);
     used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
     DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
     return buf;
   }
 
   void Free(const Buffer& buffer) override {
+    MemoryStats::Global()->RecordFree(buffer.device, name(), buffer.data, buffer.size);
     DeviceAPI::Get(device_)->FreeDataSpace(buffer.device, buffer.data);
     used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
     DLOG(INFO) << "free " << buffer.size << " B, used memory " << used_memory_ << " B";
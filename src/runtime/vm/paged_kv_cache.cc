@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/paged_kv_cache.cc
+ * \brief A paged key/value cache for autoregressive decoding.
+ */
+
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief The keys and values of the attention layers of many sequences, kept in fixed size pages.
+ *
+ *  All the sequences share one pool of pages, a single tensor of shape
+ *  [num_layers, 2, num_pages, page_size, num_heads, head_dim] allocated through the pooled
+ *  allocator of the device, where index 0 of the second axis holds the keys and 1 the values.
+ *  Each sequence owns a list of pages, its block table, so that growing it by a token only
+ *  writes that token, and takes a new page once every page_size tokens. The attention kernels,
+ *  e.g. topi.nn.paged_attention, read the keys and values through the block tables.
+ *
+ *  A sequence forked from another one shares its pages, which are copied only when one of the
+ *  two writes into a page they share, so that the sequences of a beam search only hold the
+ *  tokens where they differ.
+ */
+class PagedKVCache : public ModuleNode {
+ public:
+  PagedKVCache(int64_t num_layers, int64_t num_heads, int64_t head_dim, int64_t page_size,
+               int64_t num_pages, DLDataType dtype, Device dev)
+      : num_layers_(num_layers),
+        num_heads_(num_heads),
+        head_dim_(head_dim),
+        page_size_(page_size),
+        num_pages_(num_pages) {
+    ICHECK(num_layers > 0 && num_heads > 0 && head_dim > 0)
+        << "ValueError: the number of layers, heads and the head dimension must be positive";
+    ICHECK(page_size > 0 && num_pages > 0)
+        << "ValueError: the page size and the number of pages must be positive";
+    Allocator* alloc = MemoryManager::GetOrCreateAllocator(dev, kPooled);
+    pages_ = alloc->Empty({num_layers, 2, num_pages, page_size, num_heads, head_dim}, dtype, dev);
+    page_refs_.assign(num_pages, 0);
+    // Pages are handed out from the back, so that the first pages are used first.
+    for (int64_t page = num_pages - 1; page >= 0; --page) {
+      free_pages_.push_back(static_cast<int32_t>(page));
+    }
+  }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "add_sequence") {
+      return TypedPackedFunc<void(int64_t)>([this](int64_t seq_id) { AddSequence(seq_id); });
+    } else if (name == "remove_sequence") {
+      return TypedPackedFunc<void(int64_t)>([this](int64_t seq_id) { RemoveSequence(seq_id); });
+    } else if (name == "fork_sequence") {
+      return TypedPackedFunc<void(int64_t, int64_t)>(
+          [this](int64_t parent, int64_t child) { ForkSequence(parent, child); });
+    } else if (name == "reserve") {
+      return TypedPackedFunc<void(int64_t, int64_t)>(
+          [this](int64_t seq_id, int64_t num_tokens) { Reserve(seq_id, num_tokens); });
+    } else if (name == "append") {
+      return TypedPackedFunc<void(int64_t, int64_t, NDArray, NDArray)>(
+          [this](int64_t seq_id, int64_t layer, NDArray keys, NDArray values) {
+            Append(seq_id, layer, keys, values);
+          });
+    } else if (name == "get_block_table") {
+      return TypedPackedFunc<Array<NDArray>(ShapeTuple)>(
+          [this](ShapeTuple seq_ids) { return GetBlockTable(seq_ids); });
+    } else if (name == "get_pages") {
+      return TypedPackedFunc<NDArray()>([this]() { return pages_; });
+    } else if (name == "get_length") {
+      return TypedPackedFunc<int64_t(int64_t)>(
+          [this](int64_t seq_id) { return GetSequence(seq_id).length; });
+    } else if (name == "get_num_free_pages") {
+      return TypedPackedFunc<int64_t()>([this]() { return free_pages_.size(); });
+    }
+    return nullptr;
+  }
+
+  const char* type_key() const final { return "PagedKVCache"; }
+
+  /*! \brief Start an empty sequence. */
+  void AddSequence(int64_t seq_id) {
+    ICHECK(!sequences_.count(seq_id)) << "ValueError: sequence " << seq_id << " already exists";
+    sequences_[seq_id] = Sequence();
+  }
+
+  /*! \brief Drop a sequence and release the pages no other sequence holds. */
+  void RemoveSequence(int64_t seq_id) {
+    Sequence& seq = GetSequence(seq_id);
+    for (int32_t page : seq.pages) {
+      ReleasePage(page);
+    }
+    sequences_.erase(seq_id);
+  }
+
+  /*! \brief Start a sequence holding the tokens of another one, sharing its pages. */
+  void ForkSequence(int64_t parent, int64_t child) {
+    ICHECK(!sequences_.count(child)) << "ValueError: sequence " << child << " already exists";
+    Sequence seq = GetSequence(parent);
+    for (int32_t page : seq.pages) {
+      ++page_refs_[page];
+    }
+    sequences_[child] = std::move(seq);
+  }
+
+  /*!
+   * \brief Grow a sequence by num_tokens tokens, whose keys and values are then written by
+   *  Append for each layer.
+   */
+  void Reserve(int64_t seq_id, int64_t num_tokens) {
+    ICHECK_GT(num_tokens, 0) << "ValueError: the number of reserved tokens must be positive";
+    Sequence& seq = GetSequence(seq_id);
+    // The last page is about to be written, so it can not be shared anymore.
+    if (seq.length % page_size_ != 0) {
+      int32_t& last = seq.pages.back();
+      if (page_refs_[last] > 1) {
+        int32_t copy = AllocPage();
+        CopyPage(last, copy);
+        ReleasePage(last);
+        last = copy;
+      }
+    }
+    seq.length += num_tokens;
+    while (static_cast<int64_t>(seq.pages.size()) * page_size_ < seq.length) {
+      seq.pages.push_back(AllocPage());
+    }
+    seq.num_reserved = num_tokens;
+  }
+
+  /*!
+   * \brief Write the keys and values of the tokens reserved last for a layer.
+   * \param keys The keys, of shape [num_tokens, num_heads, head_dim] on any device.
+   * \param values The values, of the same shape.
+   */
+  void Append(int64_t seq_id, int64_t layer, const NDArray& keys, const NDArray& values) {
+    ICHECK(layer >= 0 && layer < num_layers_)
+        << "ValueError: layer " << layer << " is out of range [0, " << num_layers_ << ")";
+    const Sequence& seq = GetSequence(seq_id);
+    int64_t num_tokens = seq.num_reserved;
+    for (const NDArray& data : {keys, values}) {
+      ICHECK(data.IsContiguous()) << "ValueError: the appended keys and values must be contiguous";
+      ICHECK(data->ndim == 3 && data->shape[0] == num_tokens && data->shape[1] == num_heads_ &&
+             data->shape[2] == head_dim_)
+          << "ValueError: expected keys and values of shape [" << num_tokens << ", " << num_heads_
+          << ", " << head_dim_ << "], the shape of the tokens reserved last, but got "
+          << data.Shape();
+      ICHECK(data.DataType() == pages_.DataType())
+          << "ValueError: the keys and values must be of the data type of the cache";
+    }
+    int64_t token_bytes = num_heads_ * head_dim_ * pages_.DataType().bytes();
+    // Copy the tokens one run of contiguous slots of a page at a time.
+    int64_t pos = seq.length - num_tokens;
+    for (int64_t done = 0; done < num_tokens;) {
+      int64_t slot = pos % page_size_;
+      int64_t count = std::min(page_size_ - slot, num_tokens - done);
+      int32_t page = seq.pages[pos / page_size_];
+      for (int kv = 0; kv < 2; ++kv) {
+        const NDArray& src = kv == 0 ? keys : values;
+        DLTensor from = *src.operator->();
+        int64_t shape[3] = {count, num_heads_, head_dim_};
+        from.shape = shape;
+        from.strides = nullptr;
+        from.byte_offset += done * token_bytes;
+        DLTensor to = PageSlots(layer, kv, page, slot, shape);
+        NDArray::CopyFromTo(&from, &to);
+      }
+      pos += count;
+      done += count;
+    }
+  }
+
+  /*!
+   * \brief The block tables and lengths of a batch of sequences, on the device of the cache.
+   * \return The block table, of shape [batch, max_pages] and padded with page 0, and the
+   *  lengths, of shape [batch], both int32.
+   */
+  Array<NDArray> GetBlockTable(const ShapeTuple& seq_ids) {
+    int64_t batch = seq_ids.size();
+    size_t max_pages = 1;
+    for (int64_t seq_id : seq_ids) {
+      max_pages = std::max(max_pages, GetSequence(seq_id).pages.size());
+    }
+    std::vector<int32_t> table(batch * max_pages, 0);
+    std::vector<int32_t> lengths(batch);
+    for (int64_t i = 0; i < batch; ++i) {
+      const Sequence& seq = GetSequence(seq_ids[i]);
+      std::copy(seq.pages.begin(), seq.pages.end(), table.begin() + i * max_pages);
+      lengths[i] = static_cast<int32_t>(seq.length);
+    }
+    DLDataType int32{kDLInt, 32, 1};
+    NDArray table_nd =
+        NDArray::Empty({batch, static_cast<int64_t>(max_pages)}, int32, pages_->device);
+    NDArray lengths_nd = NDArray::Empty({batch}, int32, pages_->device);
+    table_nd.CopyFromBytes(table.data(), table.size() * sizeof(int32_t));
+    lengths_nd.CopyFromBytes(lengths.data(), lengths.size() * sizeof(int32_t));
+    return {table_nd, lengths_nd};
+  }
+
+ private:
+  struct Sequence {
+    /*! \brief The pages holding the tokens, in order. */
+    std::vector<int32_t> pages;
+    /*! \brief The number of tokens. */
+    int64_t length{0};
+    /*! \brief The number of tokens of the last Reserve, written by Append. */
+    int64_t num_reserved{0};
+  };
+
+  Sequence& GetSequence(int64_t seq_id) {
+    auto it = sequences_.find(seq_id);
+    ICHECK(it != sequences_.end()) << "ValueError: sequence " << seq_id << " does not exist";
+    return it->second;
+  }
+
+  int32_t AllocPage() {
+    ICHECK(!free_pages_.empty()) << "The KV cache is out of pages, all " << num_pages_
+                                 << " pages of " << page_size_ << " tokens are in use";
+    int32_t page = free_pages_.back();
+    free_pages_.pop_back();
+    page_refs_[page] = 1;
+    return page;
+  }
+
+  void ReleasePage(int32_t page) {
+    if (--page_refs_[page] == 0) free_pages_.push_back(page);
+  }
+
+  /*! \brief A view of count slots of a page, starting at slot, for one layer and kv. */
+  DLTensor PageSlots(int64_t layer, int kv, int32_t page, int64_t slot, int64_t* shape) {
+    int64_t token_elems = num_heads_ * head_dim_;
+    int64_t offset = (((layer * 2 + kv) * num_pages_ + page) * page_size_ + slot) * token_elems;
+    DLTensor view = *pages_.operator->();
+    view.ndim = 3;
+    view.shape = shape;
+    view.strides = nullptr;
+    view.byte_offset += offset * pages_.DataType().bytes();
+    return view;
+  }
+
+  void CopyPage(int32_t src, int32_t dst) {
+    int64_t shape[3] = {page_size_, num_heads_, head_dim_};
+    for (int64_t layer = 0; layer < num_layers_; ++layer) {
+      for (int kv = 0; kv < 2; ++kv) {
+        DLTensor from = PageSlots(layer, kv, src, 0, shape);
+        DLTensor to = PageSlots(layer, kv, dst, 0, shape);
+        NDArray::CopyFromTo(&from, &to);
+      }
+    }
+  }
+
+  int64_t num_layers_;
+  int64_t num_heads_;
+  int64_t head_dim_;
+  int64_t page_size_;
+  int64_t num_pages_;
+  /*! \brief The pool of pages shared by all the sequences. */
+  NDArray pages_;
+  /*! \brief The number of sequences holding each page. */
+  std::vector<int32_t> page_refs_;
+  std::vector<int32_t> free_pages_;
+  std::unordered_map<int64_t, Sequence> sequences_;
+};
+
+TVM_REGISTER_GLOBAL("runtime._PagedKVCache")
+    .set_body_typed([](int64_t num_layers, int64_t num_heads, int64_t head_dim, int64_t page_size,
+                       int64_t num_pages, DLDataType dtype, Device dev) {
+      auto cache = make_object<PagedKVCache>(num_layers, num_heads, head_dim, page_size,
+                                             num_pages, dtype, dev);
+      return Module(cache);
+    });
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
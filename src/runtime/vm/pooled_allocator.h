@@ -24,9 +24,11 @@
 #define TVM_RUNTIME_VM_POOLED_ALLOCATOR_H_
 
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory_stats.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -38,20 +40,55 @@ namespace vm {
 class PooledAllocator final : public Allocator {
  public:
   static constexpr size_t kDefaultPageSize = 4096;
+  /*! \brief The number of buffers moved between a thread cache and the shared pool at once. */
+  static constexpr size_t kTransferBatchSize = 8;
 
-  explicit PooledAllocator(Device dev, size_t page_size = kDefaultPageSize)
-      : Allocator(kPooled), page_size_(page_size), used_memory_(0), device_(dev) {}
+  /*!
+   * \brief Construct the allocator.
+   * \param dev The device to allocate on.
+   * \param page_size The allocation granularity.
+   * \param thread_cache_bytes The maximum number of bytes of free buffers each thread caches
+   *  before returning a batch to the shared pool, 0 disables the thread caches.
+   */
+  explicit PooledAllocator(Device dev, size_t page_size = kDefaultPageSize,
+                           size_t thread_cache_bytes = 0)
+      : Allocator(kPooled),
+        page_size_(page_size),
+        thread_cache_bytes_(thread_cache_bytes),
+        used_memory_(0),
+        device_(dev),
+        id_(NextAllocatorId()),
+        self_(std::make_shared<PooledAllocator*>(this)) {}
 
-  ~PooledAllocator() { ReleaseAll(); }
+  ~PooledAllocator() {
+    self_.reset();
+    ReleaseAll();
+  }
 
   Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
-    std::lock_guard<std::recursive_mutex> lock(mu_);
     size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
+    if (thread_cache_bytes_ != 0) {
+      ThreadCache* cache = GetThreadCache();
+      auto it = cache->free_lists.find(size);
+      if (it == cache->free_lists.end() || it->second.empty()) {
+        FetchBatch(cache, size);
+        it = cache->free_lists.find(size);
+      }
+      if (it != cache->free_lists.end() && !it->second.empty()) {
+        auto ret = it->second.back();
+        it->second.pop_back();
+        cache->cached_bytes -= ret.size;
+        cached_memory_.fetch_sub(ret.size, std::memory_order_relaxed);
+        return ret;
+      }
+    }
+    std::lock_guard<std::recursive_mutex> lock(mu_);
     auto&& it = memory_pool_.find(size);
     if (it != memory_pool_.end() && !it->second.empty()) {
       auto&& pool = it->second;
       auto ret = pool.back();
       pool.pop_back();
+      cached_memory_.fetch_sub(ret.size, std::memory_order_relaxed);
       return ret;
     }
     Buffer buf;
@@ -62,9 +99,11 @@ class PooledAllocator final : public Allocator {
     } catch (InternalError& err) {
       LOG(WARNING) << "PooledAllocator got InternalError during allocation: " << err.message();
       LOG(WARNING) << "Trying to release all unused memory and reallocate...";
+      if (thread_cache_bytes_ != 0) Flush(GetThreadCache(), 0);
       ReleaseAll();
       buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, size, alignment, type_hint);
     }
+    MemoryStats::Global()->RecordAlloc(device_, name(), buf.data, size);
 
     used_memory_.fetch_add(size, std::memory_order_relaxed);
     VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
@@ -72,6 +111,16 @@ class PooledAllocator final : public Allocator {
   }
 
   void Free(const Buffer& buffer) override {
+    cached_memory_.fetch_add(buffer.size, std::memory_order_relaxed);
+    if (thread_cache_bytes_ != 0) {
+      ThreadCache* cache = GetThreadCache();
+      cache->free_lists[buffer.size].push_back(buffer);
+      cache->cached_bytes += buffer.size;
+      if (cache->cached_bytes > thread_cache_bytes_) {
+        Flush(cache, thread_cache_bytes_ / 2);
+      }
+      return;
+    }
     std::lock_guard<std::recursive_mutex> lock(mu_);
     if (memory_pool_.find(buffer.size) == memory_pool_.end()) {
       memory_pool_.emplace(buffer.size, std::vector<Buffer>{});
@@ -82,13 +131,89 @@ class PooledAllocator final : public Allocator {
 
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  size_t CachedMemory() const override { return cached_memory_.load(std::memory_order_relaxed); }
+
  private:
+  /*!
+   * \brief Free buffers owned by a single thread, accessed without locking.
+   *
+   * The cache only keeps a weak reference to its allocator: when the thread exits the
+   * buffers go back to the shared pool, or to the device if the allocator is gone.
+   */
+  struct ThreadCache {
+    std::unordered_map<size_t, std::vector<Buffer>> free_lists;
+    size_t cached_bytes{0};
+    std::weak_ptr<PooledAllocator*> owner;
+    /*! \brief The name the buffers are recorded with in MemoryStats. */
+    const char* owner_name;
+
+    ~ThreadCache() {
+      if (auto alloc = owner.lock()) {
+        (*alloc)->Flush(this, 0);
+        return;
+      }
+      for (auto const& it : free_lists) {
+        for (auto const& buf : it.second) {
+          MemoryStats::Global()->RecordFree(buf.device, owner_name, buf.data, buf.size);
+          DeviceAPI::Get(buf.device)->FreeDataSpace(buf.device, buf.data);
+        }
+      }
+    }
+  };
+
+  static uint64_t NextAllocatorId() {
+    static std::atomic<uint64_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  ThreadCache* GetThreadCache() {
+    static thread_local std::unordered_map<uint64_t, std::unique_ptr<ThreadCache>> caches;
+    auto&& cache = caches[id_];
+    if (cache == nullptr) {
+      cache = std::make_unique<ThreadCache>();
+      cache->owner = self_;
+      cache->owner_name = name();
+    }
+    return cache.get();
+  }
+
+  /*! \brief Move up to kTransferBatchSize buffers of the given size into the thread cache. */
+  void FetchBatch(ThreadCache* cache, size_t size) {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    auto it = memory_pool_.find(size);
+    if (it == memory_pool_.end()) return;
+    auto&& pool = it->second;
+    auto&& local = cache->free_lists[size];
+    for (size_t i = 0; i < kTransferBatchSize && !pool.empty(); ++i) {
+      if (i != 0 && cache->cached_bytes + size > thread_cache_bytes_) break;
+      local.push_back(pool.back());
+      cache->cached_bytes += size;
+      pool.pop_back();
+    }
+  }
+
+  /*! \brief Return thread cached buffers to the shared pool until at most limit bytes remain. */
+  void Flush(ThreadCache* cache, size_t limit) {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    for (auto&& it : cache->free_lists) {
+      auto&& local = it.second;
+      while (!local.empty() && cache->cached_bytes > limit) {
+        memory_pool_[it.first].push_back(local.back());
+        cache->cached_bytes -= local.back().size;
+        local.pop_back();
+      }
+    }
+    VLOG(1) << "return thread cached buffers, " << cache->cached_bytes << " B left in cache";
+  }
+
   void ReleaseAll() {
     std::lock_guard<std::recursive_mutex> lock(mu_);
     for (auto const& it : memory_pool_) {
       auto const& pool = it.second;
       for (auto const& buf : pool) {
+        MemoryStats::Global()->RecordFree(buf.device, name(), buf.data, buf.size);
         DeviceAPI::Get(buf.device)->FreeDataSpace(buf.device, buf.data);
+        cached_memory_.fetch_sub(buf.size, std::memory_order_relaxed);
       }
     }
     memory_pool_.clear();
@@ -98,10 +223,17 @@ class PooledAllocator final : public Allocator {
 
  private:
   size_t page_size_;
+  size_t thread_cache_bytes_;
   std::atomic<size_t> used_memory_;
+  /*! \brief The bytes of the free buffers, in the shared pool and the thread caches. */
+  std::atomic<size_t> cached_memory_{0};
   std::unordered_map<size_t, std::vector<Buffer>> memory_pool_;
   std::recursive_mutex mu_;
   Device device_;
+  /*! \brief Unique id of the allocator used to look up the thread caches. */
+  uint64_t id_;
+  /*! \brief Handle on this allocator, thread caches only hold weak references to it. */
+  std::shared_ptr<PooledAllocator*> self_;
 };
 
 }  // namespace vm
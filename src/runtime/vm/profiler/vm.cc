@@ -85,11 +85,102 @@ PackedFunc VirtualMachineDebug::GetFunction(const std::string& name,
       profiling::Report report = profile(arg_name, Array<profiling::MetricCollector>());
       return report->AsJSON();
     });
+  } else if (name == "set_sampling") {
+    return TypedPackedFunc<void(int64_t)>(
+        [sptr_to_self, this](int64_t interval) { SetSampling(interval); });
+  } else if (name == "sampled_report") {
+    return TypedPackedFunc<profiling::Report()>([sptr_to_self, this]() { return SampledReport(); });
+  } else if (name == "sampled_report_rpc") {
+    return TypedPackedFunc<std::string()>(
+        [sptr_to_self, this]() { return std::string(SampledReport()->AsJSON()); });
+  } else if (name == "invoke" || name == "invoke_stateful") {
+    return SampledInvoke(VirtualMachine::GetFunction(name, sptr_to_self));
   } else {
     return VirtualMachine::GetFunction(name, sptr_to_self);
   }
 }
 
+void VirtualMachineDebug::SetSampling(int64_t interval) {
+  ICHECK_GE(interval, 0) << "The sampling interval must not be negative";
+  sample_interval_ = interval;
+  num_invocations_ = 0;
+}
+
+PackedFunc VirtualMachineDebug::SampledInvoke(PackedFunc invoke) {
+  return PackedFunc([this, invoke](TVMArgs args, TVMRetValue* rv) {
+    bool sample = sample_interval_ > 0 && !prof_ && num_invocations_++ % sample_interval_ == 0;
+    if (!sample) {
+      invoke.CallPacked(args, rv);
+      return;
+    }
+    std::vector<Device> devices;
+    for (auto dev : devices_) {
+      if (dev.device_type > 0) {
+        devices.push_back(dev);
+      }
+    }
+    prof_ = profiling::Profiler(devices, {}, {{String("Executor"), String("VM")}});
+    prof_.operator*().Start();
+    invoke.CallPacked(args, rv);
+    prof_.operator*().Stop();
+    if (samples_.size() == kMaxSamples) {
+      samples_.pop_front();
+    }
+    samples_.push_back(std::move(prof_.operator*()));
+    prof_ = std::nullopt;
+  });
+}
+
+profiling::Report VirtualMachineDebug::SampledReport() {
+  // Reading the timers synchronizes with the devices, which is deferred until now.
+  std::vector<profiling::Report> reports;
+  for (auto& sample : samples_) {
+    reports.push_back(sample.Report());
+  }
+  samples_.clear();
+
+  double total_us = 0;
+  std::unordered_map<String, std::pair<double, Map<String, ObjectRef>>> device_metrics;
+  for (const auto& report : reports) {
+    double sample_us = 0;
+    for (const auto& kv : report->device_metrics) {
+      double us = kv.second["Duration (us)"].as<profiling::DurationNode>()->microseconds;
+      sample_us = std::max(sample_us, us);
+      auto& entry = device_metrics[kv.first];
+      entry.first += us;
+      entry.second = kv.second;
+    }
+    total_us += sample_us;
+  }
+
+  // Percentages are relative to the time of all the samples together.
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& report : reports) {
+    for (Map<String, ObjectRef> call : report->calls) {
+      double us = call["Duration (us)"].as<profiling::DurationNode>()->microseconds;
+      call.Set("Percent", ObjectRef(make_object<profiling::PercentNode>(us / total_us * 100)));
+      calls.push_back(call);
+    }
+  }
+  Map<String, Map<String, ObjectRef>> devices;
+  for (auto& kv : device_metrics) {
+    Map<String, ObjectRef> metrics = kv.second.second;
+    metrics.Set("Duration (us)", ObjectRef(make_object<profiling::DurationNode>(kv.second.first)));
+    metrics.Set("Count", ObjectRef(make_object<profiling::CountNode>(reports.size())));
+    devices.Set(kv.first, metrics);
+  }
+  Map<String, ObjectRef> configuration;
+  if (!reports.empty()) {
+    configuration = reports[0]->configuration;
+  }
+  configuration.Set("Executor", String("VM"));
+  configuration.Set("Sampled calls",
+                    ObjectRef(make_object<profiling::CountNode>(reports.size())));
+  configuration.Set("Sampling interval",
+                    ObjectRef(make_object<profiling::CountNode>(sample_interval_)));
+  return profiling::Report(calls, devices, configuration);
+}
+
 void VirtualMachineDebug::LoadExecutable(const ObjectPtr<Executable>& exec) {
   VirtualMachine::LoadExecutable(exec);
   for (auto kv : exec_->primitive_map) {
@@ -97,7 +188,7 @@ void VirtualMachineDebug::LoadExecutable(const ObjectPtr<Executable>& exec) {
   }
 }
 
-void VirtualMachineDebug::OpStartHook(Instruction instr) {
+void VirtualMachineDebug::OpStartHook(const Instruction& instr) {
   if (prof_ && prof_.operator*().IsRunning()) {
     if (instr.op == Opcode::LoadConst) {
       Device dev = GetDevice(exec_->const_device_indexes[instr.const_index]);
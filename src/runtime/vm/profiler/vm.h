@@ -28,6 +28,7 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -40,7 +41,7 @@ namespace vm {
 
 class VirtualMachineDebug : public VirtualMachine {
  public:
-  VirtualMachineDebug() : VirtualMachine(), prof_({}) {}
+  VirtualMachineDebug() : VirtualMachine(), prof_({}) { op_hooks_enabled_ = true; }
 
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
 
@@ -51,11 +52,32 @@ class VirtualMachineDebug : public VirtualMachine {
  private:
   void InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count, Index output_size,
                     const std::vector<ObjectRef>& args) final;
-  void OpStartHook(Instruction instr) final;
+  void OpStartHook(const Instruction& instr) final;
   void OpStopHook() final;
 
+  /*!
+   * \brief Profile one in every \p interval calls to invoke, 0 disables sampling.
+   *
+   * Sampled calls are timed without metric collectors, so that on devices with
+   * asynchronous timers (e.g. CUDA events) no synchronization is added per op.
+   */
+  void SetSampling(int64_t interval);
+  /*! \brief Wrap an invoke function so that it profiles the sampled calls. */
+  PackedFunc SampledInvoke(PackedFunc invoke);
+  /*! \brief Aggregate the samples collected so far into a report, and drop them. */
+  profiling::Report SampledReport();
+
+  /*! \brief The maximum number of samples kept until SampledReport is called. */
+  static constexpr size_t kMaxSamples = 1024;
+
   std::unordered_map<Index, std::string> packed_index_map_;
   std::optional<profiling::Profiler> prof_;
+  /*! \brief The sampling interval, 0 when sampling is disabled. */
+  int64_t sample_interval_{0};
+  /*! \brief The number of calls to invoke since sampling was enabled. */
+  int64_t num_invocations_{0};
+  /*! \brief The profilers of the sampled calls, their timers are only read when reporting. */
+  std::deque<profiling::Profiler> samples_;
 };
 
 }  // namespace vm
@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/size_class_allocator.h
+ * \brief A pooled allocator that bins requests into size classes.
+ *
+ * Unlike PooledAllocator, which only reuses a buffer of exactly the same
+ * page-rounded size, requests are rounded up to a size class (a power of two
+ * followed by kNumSubBuckets evenly spaced sub-buckets), so that buffers of
+ * slightly different sizes produced by dynamic shapes share the same free list.
+ * Large requests may additionally reuse the smallest cached block that is at
+ * most kMaxBestFitSlack times bigger than the request.
+ *
+ * Device buffers are opaque handles on some backends (e.g. OpenCL), so blocks
+ * are never split; instead the amount of idle memory kept in the pool can be
+ * capped, after which freed buffers are returned to the device directly.
+ */
+#ifndef TVM_RUNTIME_VM_SIZE_CLASS_ALLOCATOR_H_
+#define TVM_RUNTIME_VM_SIZE_CLASS_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory_stats.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+class SizeClassAllocator final : public Allocator {
+ public:
+  static constexpr size_t kDefaultPageSize = 4096;
+  /*! \brief Number of size classes between two consecutive powers of two. */
+  static constexpr size_t kNumSubBuckets = 4;
+  /*! \brief Requests at least this large may be served by a bigger cached block. */
+  static constexpr size_t kBestFitThreshold = 1 << 20;
+  /*! \brief Upper bound of the ratio between a reused block and the request. */
+  static constexpr size_t kMaxBestFitSlack = 2;
+
+  /*!
+   * \brief Construct the allocator.
+   * \param dev The device to allocate on.
+   * \param max_cached_bytes The maximum number of bytes of free buffers kept in
+   *  the pool, 0 means unlimited.
+   * \param page_size The minimum allocation granularity.
+   */
+  explicit SizeClassAllocator(Device dev, size_t max_cached_bytes = 0,
+                              size_t page_size = kDefaultPageSize)
+      : Allocator(kSizeClass),
+        page_size_(page_size),
+        max_cached_bytes_(max_cached_bytes),
+        used_memory_(0),
+        device_(dev) {}
+
+  ~SizeClassAllocator() { ReleaseCached(); }
+
+  Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    size_t size = SizeClass(nbytes);
+    auto it = free_lists_.lower_bound(size);
+    bool best_fit = size >= kBestFitThreshold;
+    if (it != free_lists_.end() &&
+        (it->first == size || (best_fit && it->first <= size * kMaxBestFitSlack))) {
+      auto&& pool = it->second;
+      Buffer ret = pool.back();
+      pool.pop_back();
+      if (pool.empty()) free_lists_.erase(it);
+      cached_bytes_ -= ret.size;
+      VLOG(1) << "reuse " << ret.size << " B buffer for a " << nbytes << " B request";
+      return ret;
+    }
+    Buffer buf;
+    buf.device = device_;
+    buf.size = size;
+    try {
+      buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, size, alignment, type_hint);
+    } catch (InternalError& err) {
+      LOG(WARNING) << "SizeClassAllocator got InternalError during allocation: " << err.message();
+      LOG(WARNING) << "Trying to release all cached memory and reallocate...";
+      ReleaseCached();
+      buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, size, alignment, type_hint);
+    }
+    MemoryStats::Global()->RecordAlloc(device_, name(), buf.data, size);
+    used_memory_.fetch_add(size, std::memory_order_relaxed);
+    VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
+    return buf;
+  }
+
+  void Free(const Buffer& buffer) override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    if (max_cached_bytes_ != 0 && cached_bytes_ + buffer.size > max_cached_bytes_) {
+      MemoryStats::Global()->RecordFree(buffer.device, name(), buffer.data, buffer.size);
+      DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+      used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+      VLOG(1) << "pool is full, free " << buffer.size << " B, used memory " << used_memory_
+              << " B";
+      return;
+    }
+    free_lists_[buffer.size].push_back(buffer);
+    cached_bytes_ += buffer.size;
+    VLOG(1) << "reclaim buffer " << buffer.size;
+  }
+
+  size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
+
+  size_t CachedMemory() const override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    return cached_bytes_;
+  }
+
+  /*!
+   * \brief Compute the size class a request of nbytes falls into.
+   * \param nbytes The requested size.
+   * \return The size of the buffer that will be allocated.
+   */
+  size_t SizeClass(size_t nbytes) const {
+    size_t size = RoundUp(std::max<size_t>(nbytes, 1), page_size_);
+    size_t pow2 = 1;
+    while (pow2 <= size / 2) pow2 <<= 1;
+    if (pow2 == size) return size;
+    size_t step = std::max(pow2 / kNumSubBuckets, page_size_);
+    return RoundUp(size, step);
+  }
+
+ private:
+  static size_t RoundUp(size_t value, size_t factor) {
+    return ((value + factor - 1) / factor) * factor;
+  }
+
+  void ReleaseCached() {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    for (auto const& it : free_lists_) {
+      for (auto const& buf : it.second) {
+        MemoryStats::Global()->RecordFree(buf.device, name(), buf.data, buf.size);
+        DeviceAPI::Get(buf.device)->FreeDataSpace(buf.device, buf.data);
+        used_memory_.fetch_sub(buf.size, std::memory_order_relaxed);
+      }
+    }
+    free_lists_.clear();
+    cached_bytes_ = 0;
+    VLOG(1) << "release all cached buffers";
+  }
+
+ private:
+  size_t page_size_;
+  size_t max_cached_bytes_;
+  size_t cached_bytes_{0};
+  std::atomic<size_t> used_memory_;
+  /*! \brief Free buffers keyed by (and sorted on) their size class. */
+  std::map<size_t, std::vector<Buffer>> free_lists_;
+  mutable std::recursive_mutex mu_;
+  Device device_;
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_SIZE_CLASS_ALLOCATOR_H_
@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/stream_ordered_allocator.h
+ * \brief An allocator whose allocations are ordered on the current device stream.
+ *
+ * Devices that support it register "device_api.<name>.alloc_async" and
+ * "device_api.<name>.free_async" (e.g. cudaMallocAsync/cudaFreeAsync on the stream
+ * set through DeviceAPI::SetStream), which neither synchronize the device nor the
+ * other streams. Devices without such support fall back to the synchronous API.
+ */
+#ifndef TVM_RUNTIME_VM_STREAM_ORDERED_ALLOCATOR_H_
+#define TVM_RUNTIME_VM_STREAM_ORDERED_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory_stats.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <atomic>
+#include <string>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+class StreamOrderedAllocator final : public Allocator {
+ public:
+  explicit StreamOrderedAllocator(Device dev)
+      : Allocator(kStreamOrdered), used_memory_(0), device_(dev) {
+    std::string name = DeviceName(dev.device_type);
+    const PackedFunc* alloc = Registry::Get("device_api." + name + ".alloc_async");
+    const PackedFunc* free = Registry::Get("device_api." + name + ".free_async");
+    if (alloc != nullptr && free != nullptr) {
+      alloc_async_ = *alloc;
+      free_async_ = *free;
+    } else {
+      LOG(WARNING) << "Stream ordered allocation is not supported on " << name
+                   << ", falling back to synchronous allocation";
+    }
+  }
+
+  Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
+    Buffer buf;
+    buf.device = device_;
+    buf.size = nbytes;
+    if (alloc_async_ != nullptr) {
+      void* data = alloc_async_(device_, static_cast<int64_t>(nbytes));
+      buf.data = data;
+    } else {
+      buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, nbytes, alignment, type_hint);
+    }
+    MemoryStats::Global()->RecordAlloc(device_, name(), buf.data, nbytes);
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    VLOG(1) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
+    return buf;
+  }
+
+  void Free(const Buffer& buffer) override {
+    MemoryStats::Global()->RecordFree(buffer.device, name(), buffer.data, buffer.size);
+    if (free_async_ != nullptr) {
+      free_async_(buffer.device, buffer.data);
+    } else {
+      DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+    }
+    used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+    VLOG(1) << "free " << buffer.size << " B, used memory " << used_memory_ << " B";
+  }
+
+  size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> used_memory_;
+  Device device_;
+  PackedFunc alloc_async_;
+  PackedFunc free_async_;
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_STREAM_ORDERED_ALLOCATOR_H_
@@ -26,9 +26,11 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/debug.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory.h>
 #include <tvm/runtime/object.h>
+#include <tvm/runtime/trace.h>
 #include <tvm/runtime/vm/vm.h>
 
 #include <algorithm>
@@ -39,6 +41,16 @@
 
 #include "../file_utils.h"
 
+// Dispatch the interpreter loop through a table of label addresses (the GNU
+// "labels as values" extension) when the compiler supports it.
+#ifndef TVM_VM_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_VM_COMPUTED_GOTO 1
+#else
+#define TVM_VM_COMPUTED_GOTO 0
+#endif
+#endif
+
 using namespace tvm::runtime;
 
 namespace tvm {
@@ -47,6 +59,11 @@ namespace vm {
 
 TVM_REGISTER_OBJECT_TYPE(VMClosureObj);
 
+/*! \brief The states of the entries of the packed function table. */
+constexpr int kPackedFuncUnresolved = 0;
+constexpr int kPackedFuncResolving = 1;
+constexpr int kPackedFuncResolved = 2;
+
 VMClosure::VMClosure(size_t func_index, std::vector<ObjectRef> free_vars) {
   auto ptr = make_object<VMClosureObj>();
   ptr->func_index = func_index;
@@ -124,7 +141,14 @@ std::vector<int64_t> ToShape(NDArray shape_tensor) {
   return shape;
 }
 
-void VirtualMachine::OpStartHook(Instruction instr) {}
+VirtualMachine::~VirtualMachine() {
+  StopPrewarm();
+  for (TVMStreamHandle stream : streams_) {
+    DeviceAPI::Get(stream_device_)->FreeStream(stream_device_, stream);
+  }
+}
+
+void VirtualMachine::OpStartHook(const Instruction& instr) {}
 void VirtualMachine::OpStopHook() {}
 
 PackedFunc VirtualMachine::GetFunction(const std::string& name,
@@ -235,6 +259,34 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
   } else if (name == "set_outputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { SetOutputs(args[0], args); });
+  } else if (name == "begin_stream") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { BeginStream(args[0], args, 1); });
+  } else if (name == "run_stream_chunk") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = RunStreamChunk(args[0], args, 1);
+    });
+  } else if (name == "end_stream") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = EndStream(args[0]); });
+  } else if (name == "set_shape_func_memo") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_EQ(args.size(), 1) << "The expected number of arguments is 1 (enable)";
+      SetShapeFuncMemo(args[0]);
+    });
+  } else if (name == "prewarm_primitives") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_EQ(args.size(), 1) << "The expected number of arguments is 1 (num_threads)";
+      PrewarmPrimitives(args[0]);
+    });
+  } else if (name == "clone") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = Module(this->Clone()); });
+  } else if (name == "set_num_streams") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_EQ(args.size(), 1) << "The expected number of arguments is 1 (num_streams)";
+      SetNumStreams(args[0]);
+    });
   } else if (name == "load_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
       CHECK_EQ(args.size(), 1);
@@ -261,6 +313,103 @@ void VirtualMachine::SetInput(std::string func_name, TVMArgs args, int offset) {
   inputs_.emplace(func_name, func_args);
 }
 
+void VirtualMachine::SetShapeFuncMemo(bool enable) {
+  shape_func_memo_enabled_ = enable;
+  if (!enable) {
+    shape_func_memo_.clear();
+  }
+}
+
+void VirtualMachine::SetNumStreams(int num_streams) {
+  ICHECK_GE(num_streams, 1) << "The number of streams must be positive";
+  SyncStreams();
+  for (TVMStreamHandle stream : streams_) {
+    DeviceAPI::Get(stream_device_)->FreeStream(stream_device_, stream);
+  }
+  streams_.clear();
+  stream_stale_.clear();
+  next_stream_ = 0;
+  num_streams_ = num_streams;
+}
+
+void VirtualMachine::SyncStreams() const {
+  if (streams_.empty()) return;
+  DeviceAPI* api = DeviceAPI::Get(stream_device_);
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    if (!stream_stale_[i]) {
+      api->SyncStreamFromTo(stream_device_, streams_[i], nullptr);
+      stream_stale_[i] = true;
+    }
+  }
+  stream_accesses_.clear();
+}
+
+/*! \brief Once this many accesses are tracked, the stream pool is synchronized. */
+constexpr size_t kMaxStreamAccesses = 256;
+
+int VirtualMachine::AssignStream(const TVMValue* values, size_t num_inputs, size_t arity,
+                                 Device* dev) {
+  if (arity == 0) return -1;
+  *dev = static_cast<const DLTensor*>(values[0].v_handle)->device;
+  if (dev->device_type == kDLCPU) return -1;
+  for (size_t i = 1; i < arity; ++i) {
+    const Device& arg_dev = static_cast<const DLTensor*>(values[i].v_handle)->device;
+    if (arg_dev.device_type != dev->device_type || arg_dev.device_id != dev->device_id) {
+      return -1;
+    }
+  }
+  if (streams_.empty()) {
+    stream_device_ = *dev;
+    for (int i = 0; i < num_streams_; ++i) {
+      streams_.push_back(DeviceAPI::Get(*dev)->CreateStream(*dev));
+    }
+    stream_stale_.assign(num_streams_, true);
+  } else if (dev->device_type != stream_device_.device_type ||
+             dev->device_id != stream_device_.device_id) {
+    return -1;
+  }
+  if (stream_accesses_.size() + arity > kMaxStreamAccesses) {
+    SyncStreams();
+  }
+
+  // Find the streams running kernels this one depends on, the most recent one is used to
+  // issue the kernel so that it is ordered after its producer without an event.
+  std::vector<bool> depends(streams_.size(), false);
+  int stream = -1;
+  size_t begin = stream_accesses_.size();
+  for (size_t i = 0; i < arity; ++i) {
+    const DLTensor* tensor = static_cast<const DLTensor*>(values[i].v_handle);
+    uintptr_t data = reinterpret_cast<uintptr_t>(tensor->data) + tensor->byte_offset;
+    StreamAccess access{data, data + GetDataSize(*tensor), i >= num_inputs, -1};
+    for (size_t j = 0; j < begin; ++j) {
+      const StreamAccess& other = stream_accesses_[j];
+      if ((access.write || other.write) && access.begin < other.end && other.begin < access.end) {
+        depends[other.stream] = true;
+        stream = other.stream;
+      }
+    }
+    stream_accesses_.push_back(access);
+  }
+  if (stream == -1) {
+    stream = static_cast<int>(next_stream_);
+    next_stream_ = (next_stream_ + 1) % streams_.size();
+  }
+  DeviceAPI* api = DeviceAPI::Get(*dev);
+  if (stream_stale_[stream]) {
+    api->SyncStreamFromTo(*dev, nullptr, streams_[stream]);
+    stream_stale_[stream] = false;
+  }
+  for (size_t s = 0; s < streams_.size(); ++s) {
+    if (depends[s] && static_cast<int>(s) != stream) {
+      api->SyncStreamFromTo(*dev, streams_[s], streams_[stream]);
+    }
+  }
+  for (size_t i = begin; i < stream_accesses_.size(); ++i) {
+    stream_accesses_[i].stream = stream;
+  }
+  return stream;
+}
+
 void VirtualMachine::SetOneInput(std::string func_name, const TVMArgValue& tag,
                                  const TVMArgValue& tensor) {
   const auto& vm_func = CheckAndGetVMFunction(func_name);
@@ -297,6 +446,86 @@ void VirtualMachine::SetOutputs(std::string func_name, TVMArgs args) {
   outputs_.emplace(func_name, func_args);
 }
 
+void VirtualMachine::BeginStream(std::string func_name, TVMArgs args, int offset) {
+  const auto& vm_func = CheckAndGetVMFunction(func_name);
+  ICHECK_GT(args.size(), offset) << "The expected arguments are (reuse_outputs, states...)";
+  size_t num_states = args.size() - offset - 1;
+  ICHECK_LT(num_states, vm_func.params.size())
+      << "ValueError: function " << func_name << " takes " << vm_func.params.size()
+      << " parameters, which must be the inputs of a chunk followed by " << num_states
+      << " states";
+  ChunkStream stream;
+  stream.reuse_outputs = args[offset];
+  size_t first_state = vm_func.params.size() - num_states;
+  for (size_t i = 0; i < num_states; ++i) {
+    Device dev = GetDevice(vm_func.param_device_indexes[first_state + i]);
+    NDArray state = Downcast<NDArray>(TensorFromTVMArgValueToObjectRef(args[offset + 1 + i]));
+    // The states are owned by the stream, as their buffers may be written by later chunks.
+    stream.states.push_back(state.CopyTo(dev));
+  }
+  chunk_streams_[func_name] = std::move(stream);
+}
+
+ObjectRef VirtualMachine::RunStreamChunk(std::string func_name, TVMArgs args, int offset) {
+  auto it = chunk_streams_.find(func_name);
+  ICHECK(it != chunk_streams_.end()) << "No stream has been begun for function " << func_name;
+  ChunkStream& stream = it->second;
+  const auto& vm_func = CheckAndGetVMFunction(func_name);
+  size_t num_inputs = args.size() - offset;
+  ICHECK_EQ(num_inputs + stream.states.size(), vm_func.params.size())
+      << "The number of provided inputs doesn't match the number of inputs of a chunk";
+  std::vector<ObjectRef> func_args(vm_func.params.size());
+  std::vector<ShapeTuple> input_shapes;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    Device dev = GetDevice(vm_func.param_device_indexes[i]);
+    SetInputTensorWithIndex(func_args, args[offset + i], i, dev);
+    input_shapes.push_back(Downcast<NDArray>(func_args[i]).Shape());
+  }
+  std::copy(stream.states.begin(), stream.states.end(), func_args.begin() + num_inputs);
+
+  // The outputs keep their shapes, and so fit the spare buffers, as long as the inputs do.
+  bool reuse = !stream.spare.empty() && input_shapes.size() == stream.input_shapes.size() &&
+               std::equal(input_shapes.begin(), input_shapes.end(), stream.input_shapes.begin(),
+                          [](const ShapeTuple& a, const ShapeTuple& b) {
+                            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+                          });
+  ObjectRef result = reuse ? Invoke(vm_func, func_args, stream.spare) : Invoke(vm_func, func_args);
+
+  std::vector<ObjectRef> fields;
+  if (result.as<ADTObj>()) {
+    ADT adt = Downcast<ADT>(result);
+    for (size_t i = 0; i < adt.size(); ++i) {
+      fields.push_back(adt[i]);
+    }
+  } else {
+    fields.push_back(result);
+  }
+  ICHECK_GT(fields.size(), stream.states.size())
+      << "ValueError: function " << func_name
+      << " must return its outputs followed by the new states, but returned " << fields.size()
+      << " fields for " << stream.states.size() << " states";
+  size_t num_outputs = fields.size() - stream.states.size();
+  std::vector<ObjectRef> outputs(fields.begin(), fields.begin() + num_outputs);
+  if (stream.reuse_outputs) {
+    // The states just read are free once the new ones are written, and the outputs once the
+    // caller moved on to the next chunk.
+    stream.spare = outputs;
+    stream.spare.insert(stream.spare.end(), stream.states.begin(), stream.states.end());
+  }
+  stream.states.assign(fields.begin() + num_outputs, fields.end());
+  stream.input_shapes = std::move(input_shapes);
+  if (num_outputs == 1) return outputs[0];
+  return ADT(0, outputs);
+}
+
+ObjectRef VirtualMachine::EndStream(std::string func_name) {
+  auto it = chunk_streams_.find(func_name);
+  ICHECK(it != chunk_streams_.end()) << "No stream has been begun for function " << func_name;
+  ObjectRef states = ADT(0, it->second.states);
+  chunk_streams_.erase(it);
+  return states;
+}
+
 void VirtualMachine::PrintInfoAndSetInputArgs(const VMFunction& func,
                                               const std::vector<ObjectRef>& args) {
   VLOG(2) << "Executing Function: " << std::endl << func;
@@ -395,18 +624,32 @@ inline Allocator* VirtualMachine::GetAllocator(Index device_index) const {
 }
 
 void VirtualMachine::PushFrame(Index arg_count, Index ret_pc, const VMFunction& vm_func) {
-  auto frame = VMFrame(ret_pc, func_index_, arg_count, code_, vm_func.register_file_size);
-  frames_.push_back(frame);
+  if (num_frames_ == frames_.size()) {
+    frames_.emplace_back(ret_pc, func_index_, arg_count, code_, vm_func.register_file_size);
+  } else {
+    // Reuse a frame popped earlier, its registers were cleared by PopFrame, and the
+    // register file only needs to grow if this function uses more registers.
+    VMFrame& frame = frames_[num_frames_];
+    frame.pc = ret_pc;
+    frame.func_index = func_index_;
+    frame.args = arg_count;
+    frame.code = code_;
+    frame.register_file.resize(vm_func.register_file_size);
+    frame.caller_return_register = 0;
+  }
+  ++num_frames_;
 }
 
 Index VirtualMachine::PopFrame() {
-  ICHECK_GT(frames_.size(), 0);
-  const VMFrame& fr = frames_.back();
+  ICHECK_GT(num_frames_, 0);
+  VMFrame& fr = frames_[num_frames_ - 1];
   func_index_ = fr.func_index;
   code_ = fr.code;
   pc_ = fr.pc;
-  auto call_stack_size = frames_.size();
-  frames_.pop_back();
+  // Release the objects held by the frame but keep its storage around.
+  std::fill(fr.register_file.begin(), fr.register_file.end(), ObjectRef());
+  auto call_stack_size = num_frames_;
+  --num_frames_;
   return call_stack_size;
 }
 
@@ -424,6 +667,31 @@ void VirtualMachine::InvokeGlobal(const VMFunction& func, const std::vector<Obje
   pc_ = 0;
 }
 
+void VirtualMachine::InvokeGlobalFromRegisters(const VMFunction& func,
+                                               const std::vector<ObjectRef>* free_vars,
+                                               const RegName* arg_registers, Index num_args,
+                                               RegName dst) {
+  VLOG(2) << "Invoking global " << func.name << " with " << num_args << " register args";
+
+  PushFrame(func.params.size(), this->pc_ + 1, func);
+  // Take the references only after pushing, which may grow frames_.
+  const VMFrame& caller = frames_[num_frames_ - 2];
+  VMFrame& callee = frames_[num_frames_ - 1];
+  Index reg = 0;
+  if (free_vars != nullptr) {
+    for (const ObjectRef& free_var : *free_vars) {
+      callee.register_file[reg++] = free_var;
+    }
+  }
+  for (Index i = 0; i < num_args; ++i) {
+    callee.register_file[reg++] = caller.register_file[arg_registers[i]];
+  }
+  callee.caller_return_register = dst;
+
+  code_ = func.instructions.data();
+  pc_ = 0;
+}
+
 ObjectRef VirtualMachine::Invoke(const VMFunction& func, const std::vector<ObjectRef>& args) {
   PrintInfoAndSetInputArgs(func, args);
   RunLoop();
@@ -447,6 +715,38 @@ ObjectRef VirtualMachine::Invoke(const VMFunction& func, const std::vector<Objec
   return return_register_;
 }
 
+/*! \brief The maximum number of distinct shape function calls kept by the memo. */
+constexpr size_t kMaxShapeFuncMemoEntries = 4096;
+/*! \brief Shape functions reading more input data than this are not memoized. */
+constexpr size_t kMaxShapeFuncMemoKeyBytes = 4096;
+
+/*!
+ * \brief Build the memo key of a shape function call from the contents of its inputs.
+ * \return false if the call cannot be memoized.
+ */
+bool MakeShapeFuncMemoKey(Index packed_index, const TVMValue* values, size_t num_inputs,
+                          std::string* key) {
+  auto append = [key](const void* data, size_t size) {
+    key->append(static_cast<const char*>(data), size);
+  };
+  append(&packed_index, sizeof(packed_index));
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const DLTensor* tensor = static_cast<const DLTensor*>(values[i].v_handle);
+    if (tensor->device.device_type != kDLCPU || !IsContiguous(*tensor)) {
+      return false;
+    }
+    size_t nbytes = GetDataSize(*tensor);
+    if (key->size() + nbytes > kMaxShapeFuncMemoKeyBytes) {
+      return false;
+    }
+    append(&tensor->dtype, sizeof(tensor->dtype));
+    append(&tensor->ndim, sizeof(tensor->ndim));
+    append(tensor->shape, sizeof(int64_t) * tensor->ndim);
+    append(static_cast<const char*>(tensor->data) + tensor->byte_offset, nbytes);
+  }
+  return true;
+}
+
 void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count,
                                   Index output_size, const std::vector<ObjectRef>& args) {
   size_t arity = 0;
@@ -458,37 +758,96 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  std::vector<TVMValue> values(arity);
-  std::vector<int> codes(arity);
-  runtime::TVMArgsSetter setter(values.data(), codes.data());
-  int idx = 0;
+  // The buffers are reused across calls, so that only the handles are written here.
+  if (packed_values_.size() < arity) {
+    packed_values_.resize(arity);
+    packed_codes_.resize(arity);
+  }
+  TVMValue* values = packed_values_.data();
+  int* codes = packed_codes_.data();
+  auto set_tensor = [&](size_t idx, const ObjectRef& obj) {
+    ICHECK(obj->IsInstance<NDArray::ContainerType>())
+        << "Expect an NDArray argument, but got " << obj->GetTypeKey();
+    // Same handle as NDArray::FFIGetHandle, without going through a temporary NDArray.
+    const auto* container = static_cast<const NDArray::Container*>(obj.get());
+    values[idx].v_handle = const_cast<DLTensor*>(&container->dl_tensor);
+    codes[idx] = kTVMNDArrayHandle;
+  };
+  size_t idx = 0;
+  size_t num_inputs = arity;
   bool is_empty_output = false;
   for (Index i = 0; i < arg_count; i++) {
+    if (i == arg_count - output_size) {
+      num_inputs = idx;
+    }
     if (const auto* dt_cell = args[i].as<ADTObj>()) {
       for (size_t fi = 0; fi < dt_cell->size; ++fi) {
-        auto obj = (*dt_cell)[fi];
-        auto nd_array = Downcast<NDArray>(obj);
-        setter(idx++, nd_array);
+        set_tensor(idx++, (*dt_cell)[fi]);
       }
     } else {
-      auto nd_array = Downcast<NDArray>(args[i]);
+      set_tensor(idx++, args[i]);
       // We can safely skip CallPacked if there is only one
       // output and it is empty.
       if (i == arg_count - 1 && output_size == 1) {
-        for (const auto& dim : nd_array.Shape()) {
-          if (!dim) {
+        const DLTensor* tensor = static_cast<const DLTensor*>(values[idx - 1].v_handle);
+        for (int d = 0; d < tensor->ndim; ++d) {
+          if (!tensor->shape[d]) {
             is_empty_output = true;
             break;
           }
         }
       }
-      setter(idx++, nd_array);
     }
   }
 
-  if (!is_empty_output) {
-    TVMRetValue rv;
-    func.CallPacked(TVMArgs(values.data(), codes.data(), arity), &rv);
+  if (is_empty_output) {
+    return;
+  }
+
+  std::string memo_key;
+  bool memoize = shape_func_memo_enabled_ &&
+                 static_cast<size_t>(packed_index) < is_shape_func_.size() &&
+                 is_shape_func_[packed_index] &&
+                 MakeShapeFuncMemoKey(packed_index, values, num_inputs, &memo_key);
+  if (memoize) {
+    auto it = shape_func_memo_.find(memo_key);
+    if (it != shape_func_memo_.end()) {
+      ICHECK_EQ(it->second.size(), arity - num_inputs);
+      for (size_t i = num_inputs; i < arity; ++i) {
+        it->second[i - num_inputs].CopyTo(static_cast<DLTensor*>(values[i].v_handle));
+      }
+      return;
+    }
+  }
+
+  TVMRetValue rv;
+  Device dev;
+  int stream = num_streams_ > 1 ? AssignStream(values, num_inputs, arity, &dev) : -1;
+  if (stream >= 0) {
+    DeviceAPI::Get(dev)->SetStream(dev, streams_[stream]);
+    func.CallPacked(TVMArgs(values, codes, static_cast<int>(arity)), &rv);
+    DeviceAPI::Get(dev)->SetStream(dev, nullptr);
+  } else {
+    // Anything running on the default stream must see the results of the stream pool.
+    SyncStreams();
+    func.CallPacked(TVMArgs(values, codes, static_cast<int>(arity)), &rv);
+  }
+
+  if (memoize) {
+    std::vector<NDArray> outputs;
+    for (size_t i = num_inputs; i < arity; ++i) {
+      const DLTensor* out = static_cast<const DLTensor*>(values[i].v_handle);
+      if (out->device.device_type != kDLCPU) return;
+      NDArray copy = NDArray::Empty(ShapeTuple(out->shape, out->shape + out->ndim), out->dtype,
+                                    out->device);
+      copy.CopyFrom(out);
+      outputs.push_back(copy);
+    }
+    if (shape_func_memo_.size() >= kMaxShapeFuncMemoEntries) {
+      // The traffic does not come from a small set of shapes, start over.
+      shape_func_memo_.clear();
+    }
+    shape_func_memo_.emplace(std::move(memo_key), std::move(outputs));
   }
 }
 
@@ -504,19 +863,125 @@ void VirtualMachine::LoadExecutable(const ObjectPtr<Executable>& exec) {
       << "If the executable has declared primitive functions, the "
       << "generated kernel library must non-be null.";
 
+  StopPrewarm();
+  packed_func_names_.clear();
   for (const auto& it : exec_->primitive_map) {
-    const auto& packed_name = it.first;
     auto packed_index = static_cast<size_t>(it.second);
-    if (packed_funcs_.size() <= packed_index) {
-      packed_funcs_.resize(packed_index + 1);
+    if (packed_func_names_.size() <= packed_index) {
+      packed_func_names_.resize(packed_index + 1);
+    }
+    packed_func_names_[packed_index] = it.first;
+  }
+  for (size_t i = 0; i < packed_func_names_.size(); ++i) {
+    ICHECK(!packed_func_names_[i].empty()) << "Packed function " << i << " is not initialized";
+  }
+  packed_funcs_.assign(packed_func_names_.size(), nullptr);
+  packed_func_states_.reset(new std::atomic<int>[packed_funcs_.size()]);
+  for (size_t i = 0; i < packed_funcs_.size(); ++i) {
+    packed_func_states_[i].store(kPackedFuncUnresolved, std::memory_order_relaxed);
+    if (!lazy_primitives_) ResolvePackedFunc(i, /*wait=*/true);
+  }
+
+  is_shape_func_.assign(packed_funcs_.size(), false);
+  for (const auto& it : exec_->op_attrs) {
+    if (static_cast<size_t>(it.first) < is_shape_func_.size() && it.second.count(kShapeFuncAttr)) {
+      is_shape_func_[it.first] = true;
+    }
+  }
+  shape_func_memo_.clear();
+}
+
+inline const PackedFunc& VirtualMachine::GetPackedFunc(Index packed_index) {
+  if (packed_func_states_[packed_index].load(std::memory_order_acquire) != kPackedFuncResolved) {
+    ResolvePackedFunc(packed_index, /*wait=*/true);
+  }
+  return packed_funcs_[packed_index];
+}
+
+bool VirtualMachine::ResolvePackedFunc(Index packed_index, bool wait) {
+  std::atomic<int>& state = packed_func_states_[packed_index];
+  int expected = kPackedFuncUnresolved;
+  while (!state.compare_exchange_weak(expected, kPackedFuncResolving,
+                                      std::memory_order_acquire)) {
+    if (expected == kPackedFuncResolved) return true;
+    if (expected == kPackedFuncResolving) {
+      if (!wait) return false;
+      std::this_thread::yield();
     }
-    tvm::runtime::PackedFunc pf = lib.GetFunction(packed_name, /*query_imports=*/true);
-    ICHECK(pf != nullptr) << "Cannot find function in module: " << packed_name;
-    packed_funcs_[packed_index] = pf;
+    expected = kPackedFuncUnresolved;
+  }
+  const std::string& name = packed_func_names_[packed_index];
+  PackedFunc pf;
+  try {
+    pf = exec_->GetLib().GetFunction(name, /*query_imports=*/true);
+  } catch (...) {
+    state.store(kPackedFuncUnresolved, std::memory_order_release);
+    throw;
   }
+  if (pf == nullptr) {
+    state.store(kPackedFuncUnresolved, std::memory_order_release);
+    ICHECK(!wait) << "Cannot find function in module: " << name;
+    return false;
+  }
+  packed_funcs_[packed_index] = pf;
+  state.store(kPackedFuncResolved, std::memory_order_release);
+  return true;
+}
+
+void VirtualMachine::PrewarmPrimitives(int num_threads) {
+  ICHECK(exec_) << "The executable is not loaded yet.";
+  ICHECK_GT(num_threads, 0) << "The number of prewarming threads must be positive";
+  StopPrewarm();
+  stop_prewarm_.store(false);
+  next_prewarm_.store(0);
+  for (int i = 0; i < num_threads; ++i) {
+    prewarm_threads_.emplace_back([this]() {
+      for (size_t index = next_prewarm_++; index < packed_funcs_.size(); index = next_prewarm_++) {
+        if (stop_prewarm_.load(std::memory_order_relaxed)) return;
+        try {
+          ResolvePackedFunc(index, /*wait=*/false);
+        } catch (const std::exception& err) {
+          // The failure is reported again when the VM calls the function.
+          VLOG(1) << "failed to resolve " << packed_func_names_[index] << ": " << err.what();
+        }
+      }
+    });
+  }
+}
+
+ObjectPtr<VirtualMachine> VirtualMachine::Clone() const {
+  ICHECK(exec_) << "The executable is not loaded yet.";
+  auto vm = make_object<VirtualMachine>();
+  vm->exec_ = exec_;
+  vm->lazy_primitives_ = lazy_primitives_;
+  vm->packed_func_names_ = packed_func_names_;
+  vm->packed_funcs_.assign(packed_funcs_.size(), nullptr);
+  vm->packed_func_states_.reset(new std::atomic<int>[packed_funcs_.size()]);
   for (size_t i = 0; i < packed_funcs_.size(); ++i) {
-    ICHECK(packed_funcs_[i] != nullptr) << "Packed function " << i << " is not initialized";
+    // The functions still being resolved by a prewarming thread are resolved again on use.
+    int state = packed_func_states_[i].load(std::memory_order_acquire);
+    if (state == kPackedFuncResolved) {
+      vm->packed_funcs_[i] = packed_funcs_[i];
+    } else {
+      state = kPackedFuncUnresolved;
+    }
+    vm->packed_func_states_[i].store(state, std::memory_order_relaxed);
   }
+  vm->is_shape_func_ = is_shape_func_;
+  vm->shape_func_memo_enabled_ = shape_func_memo_enabled_;
+  vm->devices_ = devices_;
+  vm->allocators_ = allocators_;
+  vm->const_pool_ = const_pool_;
+  if (num_streams_ > 1) vm->SetNumStreams(num_streams_);
+  return vm;
+}
+
+void VirtualMachine::StopPrewarm() {
+  stop_prewarm_.store(true);
+  for (std::thread& thread : prewarm_threads_) {
+    thread.join();
+  }
+  prewarm_threads_.clear();
 }
 
 void VirtualMachine::Init(const std::vector<Device>& physical_devices,
@@ -548,12 +1013,15 @@ void VirtualMachine::Init(const std::vector<Device>& physical_devices,
 }
 
 inline void VirtualMachine::WriteRegister(Index r, const ObjectRef& val) {
-  frames_.back().register_file[r] = val;
+  frames_[num_frames_ - 1].register_file[r] = val;
 }
 
-ObjectRef VirtualMachine::ReadRegister(Index r) const { return frames_.back().register_file[r]; }
+ObjectRef VirtualMachine::ReadRegister(Index r) const {
+  return frames_[num_frames_ - 1].register_file[r];
+}
 
 int64_t VirtualMachine::LoadScalarInt(Index r) const {
+  SyncStreams();
   int64_t result = 0;
   const auto& obj = ReadRegister(r);
   NDArray array = Downcast<NDArray>(CopyTo(obj, GetDevice(exec_->host_device_index)));
@@ -627,77 +1095,115 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
   ICHECK(this->exec_);
   ICHECK(this->code_);
   pc_ = 0;
-  Index frame_start = frames_.size();
+  Index frame_start = num_frames_;
+  const Instruction* instr;
+#if TVM_VM_COMPUTED_GOTO
+  // Every handler jumps straight to the next one through this table, indexed by Opcode,
+  // which spares the bounds check of the switch and gives each handler its own branch
+  // history. Computed gotos do not run destructors of the scopes they leave, so handlers
+  // must only dispatch after their block has been closed.
+  static void* const kDispatchTable[] = {
+      &&vm_op_Move,          &&vm_op_Ret,          &&vm_op_Invoke,         &&vm_op_InvokeClosure,
+      &&vm_op_InvokePacked,  &&vm_op_AllocTensor,  &&vm_op_AllocTensorReg, &&vm_op_AllocADT,
+      &&vm_op_AllocClosure,  &&vm_op_GetField,     &&vm_op_If,             &&vm_op_LoadConst,
+      &&vm_op_Goto,          &&vm_op_GetTag,       &&vm_op_LoadConsti,     &&vm_op_Fatal,
+      &&vm_op_AllocStorage,  &&vm_op_ShapeOf,      &&vm_op_ReshapeTensor,  &&vm_op_DeviceCopy,
+      &&vm_op_KillRegister};
+  static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                    static_cast<size_t>(Opcode::KillRegister) + 1,
+                "kDispatchTable must have one entry per Opcode");
+  constexpr size_t kNumOpcodes = sizeof(kDispatchTable) / sizeof(kDispatchTable[0]);
+#define VM_CASE(name) \
+  case Opcode::name:  \
+  vm_op_##name:
+#define VM_DISPATCH()                                                               \
+  do {                                                                              \
+    instr = &code_[pc_];                                                            \
+    VLOG(2) << "Executing(" << pc_ << "): " << *instr;                              \
+    TVM_TRACE(VMInstruction, instr->op, pc_);                                       \
+    size_t op = static_cast<size_t>(instr->op);                                     \
+    if (op >= kNumOpcodes) LOG(FATAL) << "Unknown instruction opcode: " << int(op); \
+    goto* kDispatchTable[op];                                                       \
+  } while (0)
+#else
+#define VM_CASE(name) case Opcode::name:
+#define VM_DISPATCH() goto main_loop
+#endif
+#define VM_OP_START_HOOK(instr) \
+  if (op_hooks_enabled_) OpStartHook(instr)
+#define VM_OP_STOP_HOOK() \
+  if (op_hooks_enabled_) OpStopHook()
   while (true) {
   main_loop:
-    auto const& instr = code_[this->pc_];
-    VLOG(2) << "Executing(" << pc_ << "): " << instr;
+    instr = &code_[this->pc_];
+    VLOG(2) << "Executing(" << pc_ << "): " << *instr;
+#if !TVM_VM_COMPUTED_GOTO
+    TVM_TRACE(VMInstruction, instr->op, pc_);
+#endif
 
-    switch (instr.op) {
-      case Opcode::Move: {
+    switch (instr->op) {
+      VM_CASE(Move) {
         ObjectRef from_obj;
-        from_obj = ReadRegister(instr.from);
-        WriteRegister(instr.dst, from_obj);
+        from_obj = ReadRegister(instr->from);
+        WriteRegister(instr->dst, from_obj);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::Fatal: {
+      VM_DISPATCH();
+      VM_CASE(Fatal) {
         throw std::runtime_error("VM encountered fatal error");
       }
-      case Opcode::LoadConst: {
-        bool is_not_cached = const_pool_.size() <= static_cast<size_t>(instr.const_index) ||
-                             !const_pool_[instr.const_index].defined();
+      VM_CASE(LoadConst) {
+        bool is_not_cached = const_pool_.size() <= static_cast<size_t>(instr->const_index) ||
+                             !const_pool_[instr->const_index].defined();
         if (is_not_cached) {
-          OpStartHook(instr);
+          VM_OP_START_HOOK(*instr);
+          SyncStreams();
         }
-        auto constant_obj = exec_->constants[instr.const_index];
+        auto constant_obj = exec_->constants[instr->const_index];
         // We cache the allocated object in the constant pool. To measure, the
         // first iteration will set the pool up. The other iterations will
         // directly reuse the allocated objects.
-        if (const_pool_.size() <= static_cast<size_t>(instr.const_index)) {
-          const_pool_.resize(instr.const_index + 1);
+        if (const_pool_.size() <= static_cast<size_t>(instr->const_index)) {
+          const_pool_.resize(instr->const_index + 1);
         }
 
-        if (!const_pool_[instr.const_index].defined()) {
-          Device dev = GetDevice(exec_->const_device_indexes[instr.const_index]);
-          const_pool_[instr.const_index] = CopyTo(constant_obj, dev);
+        if (!const_pool_[instr->const_index].defined()) {
+          Device dev = GetDevice(exec_->const_device_indexes[instr->const_index]);
+          const_pool_[instr->const_index] = CopyTo(constant_obj, dev);
         }
-        WriteRegister(instr.dst, const_pool_[instr.const_index]);
+        WriteRegister(instr->dst, const_pool_[instr->const_index]);
         if (is_not_cached) {
-          OpStopHook();
+          VM_OP_STOP_HOOK();
         }
         pc_++;
-        goto main_loop;
       }
-      case Opcode::LoadConsti: {
+      VM_DISPATCH();
+      VM_CASE(LoadConsti) {
         auto tensor = NDArray::Empty({1}, {kDLInt, 64, 1}, GetDevice(exec_->host_device_index));
-        reinterpret_cast<int64_t*>(tensor->data)[0] = instr.load_consti.val;
-        WriteRegister(instr.dst, tensor);
+        reinterpret_cast<int64_t*>(tensor->data)[0] = instr->load_consti.val;
+        WriteRegister(instr->dst, tensor);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::Invoke: {
-        std::vector<ObjectRef> args;
-        for (Index i = 0; i < instr.num_args; ++i) {
-          args.push_back(ReadRegister(instr.invoke_args_registers[i]));
-        }
-        InvokeGlobal(exec_->functions[instr.func_index], args);
-        frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
-      }
-      case Opcode::InvokePacked: {
-        ICHECK_LE(instr.packed_index, packed_funcs_.size());
-        const auto& func = packed_funcs_[instr.packed_index];
-        const auto& arity = instr.arity;
-        std::vector<ObjectRef> args;
+      VM_DISPATCH();
+      VM_CASE(Invoke) {
+        InvokeGlobalFromRegisters(exec_->functions[instr->func_index], nullptr,
+                                  instr->invoke_args_registers, instr->num_args, instr->dst);
+      }
+      VM_DISPATCH();
+      VM_CASE(InvokePacked) {
+        ICHECK_LT(instr->packed_index, packed_funcs_.size());
+        const auto& func = GetPackedFunc(instr->packed_index);
+        const auto& arity = instr->arity;
+        std::vector<ObjectRef>& args = packed_args_;
+        args.resize(arity);
+        const VMFrame& frame = frames_[num_frames_ - 1];
         for (Index i = 0; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
-          args.push_back(arg);
+          args[i] = frame.register_file[instr->packed_args[i]];
 #if TVM_LOG_DEBUG
           if (i < arity) {
-            const bool is_input = i < arity - instr.output_size;
+            const bool is_input = i < arity - instr->output_size;
             VLOG(2) << (is_input ? "input" : "placeholder") << " arg " << i << " = "
-                    << RuntimeObject2String(arg, GetDevice(exec_->host_device_index),
+                    << RuntimeObject2String(args[i], GetDevice(exec_->host_device_index),
                                             /*show_contents=*/is_input);
           }
 #endif
@@ -705,140 +1211,137 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
 
         // We no longer need to write the registers back, we write directly
         // through the registers mutably.
-        InvokePacked(instr.packed_index, func, arity, instr.output_size, args);
+        InvokePacked(instr->packed_index, func, arity, instr->output_size, args);
+        // Drop the references so that killed registers still free their tensors.
+        std::fill(args.begin(), args.end(), ObjectRef());
 
 #if TVM_LOG_DEBUG
-        for (Index i = arity - instr.output_size; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
+        for (Index i = arity - instr->output_size; i < arity; ++i) {
+          auto arg = ReadRegister(instr->packed_args[i]);
           VLOG(2) << "output arg " << i << " = "
                   << RuntimeObject2String(arg, GetDevice(exec_->host_device_index));
         }
 #endif
 
         pc_++;
-        goto main_loop;
       }
-      case Opcode::InvokeClosure: {
-        auto object = ReadRegister(instr.closure);
+      VM_DISPATCH();
+      VM_CASE(InvokeClosure) {
+        auto object = ReadRegister(instr->closure);
         const auto* closure = object.as<VMClosureObj>();
         ICHECK(closure);
-        std::vector<ObjectRef> args;
-        for (auto free_var : closure->free_vars) {
-          args.push_back(free_var);
-        }
-        for (Index i = 0; i < instr.num_closure_args; ++i) {
-          args.push_back(ReadRegister(instr.closure_args[i]));
-        }
-        InvokeGlobal(exec_->functions[closure->func_index], args);
-        frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
+        InvokeGlobalFromRegisters(exec_->functions[closure->func_index], &closure->free_vars,
+                                  instr->closure_args, instr->num_closure_args, instr->dst);
       }
-      case Opcode::GetField: {
-        auto object = ReadRegister(instr.object);
+      VM_DISPATCH();
+      VM_CASE(GetField) {
+        auto object = ReadRegister(instr->object);
         const auto& tuple = Downcast<ADT>(object);
-        auto field = tuple[instr.field_index];
-        WriteRegister(instr.dst, field);
+        auto field = tuple[instr->field_index];
+        WriteRegister(instr->dst, field);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::GetTag: {
-        auto object = ReadRegister(instr.get_tag.object);
+      VM_DISPATCH();
+      VM_CASE(GetTag) {
+        auto object = ReadRegister(instr->get_tag.object);
         const auto& adt = Downcast<ADT>(object);
         auto tag = adt.tag();
         auto tag_tensor = NDArray::Empty({1}, {kDLInt, 32, 1}, GetDevice(exec_->host_device_index));
         reinterpret_cast<int32_t*>(tag_tensor->data)[0] = tag;
-        WriteRegister(instr.dst, tag_tensor);
+        WriteRegister(instr->dst, tag_tensor);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::Goto: {
-        pc_ += instr.pc_offset;
-        goto main_loop;
+      VM_DISPATCH();
+      VM_CASE(Goto) {
+        pc_ += instr->pc_offset;
       }
-      case Opcode::If: {
-        int32_t test_val = LoadScalarInt(instr.if_op.test);
-        int32_t target_val = LoadScalarInt(instr.if_op.target);
+      VM_DISPATCH();
+      VM_CASE(If) {
+        int32_t test_val = LoadScalarInt(instr->if_op.test);
+        int32_t target_val = LoadScalarInt(instr->if_op.target);
 
         if (test_val == target_val) {
-          ICHECK_NE(instr.if_op.true_offset, 0);
-          pc_ += instr.if_op.true_offset;
+          ICHECK_NE(instr->if_op.true_offset, 0);
+          pc_ += instr->if_op.true_offset;
         } else {
-          ICHECK_NE(instr.if_op.false_offset, 0);
-          pc_ += instr.if_op.false_offset;
+          ICHECK_NE(instr->if_op.false_offset, 0);
+          pc_ += instr->if_op.false_offset;
         }
 
-        goto main_loop;
       }
-      case Opcode::AllocTensor: {
-        OpStartHook(instr);
-        if (!output_tensor_reg_indices.empty() && FindIndex(output_tensor_reg_indices, instr.dst)) {
-          WriteAllocatedTensorFromOutside(instr);
+      VM_DISPATCH();
+      VM_CASE(AllocTensor) {
+        VM_OP_START_HOOK(*instr);
+        if (!output_tensor_reg_indices.empty() &&
+            FindIndex(output_tensor_reg_indices, instr->dst)) {
+          WriteAllocatedTensorFromOutside(*instr);
         } else {
-          WriteAllocatedTensor(instr);
+          WriteAllocatedTensor(*instr);
         }
-        OpStopHook();
+        VM_OP_STOP_HOOK();
         pc_++;
-        goto main_loop;
       }
-      case Opcode::AllocTensorReg: {
-        OpStartHook(instr);
+      VM_DISPATCH();
+      VM_CASE(AllocTensorReg) {
+        VM_OP_START_HOOK(*instr);
+        SyncStreams();
         Device cpu_dev = GetDevice(exec_->host_device_index);
-        auto shape_obj = ReadRegister(instr.alloc_tensor_reg.shape_register);
+        auto shape_obj = ReadRegister(instr->alloc_tensor_reg.shape_register);
         NDArray shape_tensor = Downcast<NDArray>(CopyTo(shape_obj, cpu_dev));
         auto shape = ToShape(shape_tensor);
-        auto storage_obj = ReadRegister(instr.alloc_tensor_reg.storage);
+        auto storage_obj = ReadRegister(instr->alloc_tensor_reg.storage);
         auto storage = Downcast<Storage>(storage_obj);
-        auto offset = LoadScalarInt(instr.alloc_tensor.offset);
-        auto obj = storage->AllocNDArray(offset, shape, instr.alloc_tensor_reg.dtype);
+        auto offset = LoadScalarInt(instr->alloc_tensor.offset);
+        auto obj = storage->AllocNDArray(offset, shape, instr->alloc_tensor_reg.dtype);
         VLOG(2) << "allocated "
                 << RuntimeObject2String(obj, GetDevice(exec_->host_device_index),
                                         /*show_contents=*/false);
 
-        WriteRegister(instr.dst, obj);
-        OpStopHook();
+        WriteRegister(instr->dst, obj);
+        VM_OP_STOP_HOOK();
         pc_++;
-        goto main_loop;
       }
-      case Opcode::AllocADT: {
+      VM_DISPATCH();
+      VM_CASE(AllocADT) {
         std::vector<ObjectRef> fields;
-        for (Index i = 0; i < instr.num_fields; ++i) {
-          fields.push_back(ReadRegister(instr.datatype_fields[i]));
+        for (Index i = 0; i < instr->num_fields; ++i) {
+          fields.push_back(ReadRegister(instr->datatype_fields[i]));
         }
-        ObjectRef obj = ADT(instr.constructor_tag, fields);
-        WriteRegister(instr.dst, obj);
+        ObjectRef obj = ADT(instr->constructor_tag, fields);
+        WriteRegister(instr->dst, obj);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::AllocClosure: {
+      VM_DISPATCH();
+      VM_CASE(AllocClosure) {
         std::vector<ObjectRef> free_vars;
-        for (Index i = 0; i < instr.num_freevar; i++) {
-          free_vars.push_back(ReadRegister(instr.free_vars[i]));
+        for (Index i = 0; i < instr->num_freevar; i++) {
+          free_vars.push_back(ReadRegister(instr->free_vars[i]));
         }
-        WriteRegister(instr.dst, VMClosure(instr.func_index, free_vars));
+        WriteRegister(instr->dst, VMClosure(instr->func_index, free_vars));
         pc_++;
-        goto main_loop;
       }
-      case Opcode::AllocStorage: {
-        OpStartHook(instr);
-        auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
-        auto alignment = instr.alloc_storage.alignment;
+      VM_DISPATCH();
+      VM_CASE(AllocStorage) {
+        VM_OP_START_HOOK(*instr);
+        auto size = LoadScalarInt(instr->alloc_storage.allocation_size);
+        auto alignment = instr->alloc_storage.alignment;
 
         auto storage_obj = SimpleObjAllocator().make_object<StorageObj>();
-        Allocator* allocator = GetAllocator(instr.alloc_storage.device_index);
+        Allocator* allocator = GetAllocator(instr->alloc_storage.device_index);
         ICHECK(allocator) << "Did you forget to init the VirtualMachine with devices?";
         VLOG(2) << "allocating with allocation_size=" << size << ", alignment=" << alignment
-                << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
-                << ", device_index=" << instr.alloc_storage.device_index;
+                << ", dtype_hint=" << DLDataType2String(instr->alloc_storage.dtype_hint)
+                << ", device_index=" << instr->alloc_storage.device_index;
 
-        storage_obj->buffer = allocator->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
+        storage_obj->buffer = allocator->Alloc(size, alignment, instr->alloc_storage.dtype_hint);
         Storage storage(storage_obj);
-        WriteRegister(instr.dst, storage);
-        OpStopHook();
+        WriteRegister(instr->dst, storage);
+        VM_OP_STOP_HOOK();
         pc_++;
-        goto main_loop;
       }
-      case Opcode::ShapeOf: {
-        auto input = ReadRegister(instr.shape_of.tensor);
+      VM_DISPATCH();
+      VM_CASE(ShapeOf) {
+        auto input = ReadRegister(instr->shape_of.tensor);
         NDArray input_array = Downcast<NDArray>(input);
         int ndim = input_array->ndim;
         auto out_tensor =
@@ -848,32 +1351,33 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         }
         VLOG(2) << "shape = "
                 << RuntimeObject2String(out_tensor, GetDevice(exec_->host_device_index));
-        WriteRegister(instr.dst, out_tensor);
+        WriteRegister(instr->dst, out_tensor);
         pc_++;
-        goto main_loop;
       }
-      case Opcode::Ret: {
+      VM_DISPATCH();
+      VM_CASE(Ret) {
         // If we have hit the point from which we started
         // running, we should return to the caller breaking
         // the dispatch loop.
-        return_register_ = ReadRegister(instr.result);
-        auto caller_return_register = frames_.back().caller_return_register;
+        return_register_ = ReadRegister(instr->result);
+        auto caller_return_register = frames_[num_frames_ - 1].caller_return_register;
 
         if (PopFrame() == frame_start) {
+          SyncStreams();
           return;
-          // Otherwise we are just returning from a local call.
-        } else {
-          WriteRegister(caller_return_register, return_register_);
-          goto main_loop;
         }
+        // Otherwise we are just returning from a local call.
+        WriteRegister(caller_return_register, return_register_);
       }
-      case Opcode::ReshapeTensor: {
-        OpStartHook(instr);
+      VM_DISPATCH();
+      VM_CASE(ReshapeTensor) {
+        VM_OP_START_HOOK(*instr);
+        SyncStreams();
         Device cpu_dev = GetDevice(exec_->host_device_index);
-        auto tensor_obj = ReadRegister(instr.reshape_tensor.tensor);
+        auto tensor_obj = ReadRegister(instr->reshape_tensor.tensor);
         NDArray tensor_arr = Downcast<NDArray>(tensor_obj);
         // Read the shape from shape tensor
-        auto shape_obj = ReadRegister(instr.reshape_tensor.newshape);
+        auto shape_obj = ReadRegister(instr->reshape_tensor.newshape);
         NDArray shape_tensor = Downcast<NDArray>(CopyTo(shape_obj, cpu_dev));
         const DLTensor* dl_tensor = shape_tensor.operator->();
         ICHECK_EQ(dl_tensor->dtype.code, 0u);
@@ -886,38 +1390,52 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         VLOG(2) << "reshaped "
                 << RuntimeObject2String(tensor_obj, GetDevice(exec_->host_device_index)) << " to "
                 << RuntimeObject2String(out_tensor, GetDevice(exec_->host_device_index));
-        WriteRegister(instr.dst, out_tensor);
-        OpStopHook();
+        WriteRegister(instr->dst, out_tensor);
+        VM_OP_STOP_HOOK();
         pc_++;
-        goto main_loop;
       }
-      case Opcode::DeviceCopy: {
-        OpStartHook(instr);
-        auto tensor_src = ReadRegister(instr.device_copy.src);
+      VM_DISPATCH();
+      VM_CASE(DeviceCopy) {
+        VM_OP_START_HOOK(*instr);
+        SyncStreams();
+        auto tensor_src = ReadRegister(instr->device_copy.src);
         NDArray src_data = Downcast<NDArray>(tensor_src);
         Device actual_src_dev = src_data->device;
-        Device inst_src_dev = GetDevice(instr.device_copy.src_device_index);
+        Device inst_src_dev = GetDevice(instr->device_copy.src_device_index);
         ICHECK_EQ(actual_src_dev.device_type, inst_src_dev.device_type);
         ICHECK_EQ(actual_src_dev.device_id, inst_src_dev.device_id);
-        Device dst_dev = GetDevice(instr.device_copy.dst_device_index);
+        Device dst_dev = GetDevice(instr->device_copy.dst_device_index);
 
         NDArray dst_data = src_data.CopyTo(dst_dev);
-        WriteRegister(instr.dst, dst_data);
-        OpStopHook();
+        WriteRegister(instr->dst, dst_data);
+        VM_OP_STOP_HOOK();
         pc_++;
-        goto main_loop;
       }
-      case Opcode::KillRegister: {
-        OpStartHook(instr);
-        WriteRegister(instr.dst, ObjectRef());
-        OpStopHook();
-        pc_++;
-        goto main_loop;
+      VM_DISPATCH();
+      VM_CASE(KillRegister) {
+        if (op_hooks_enabled_) {
+          OpStartHook(*instr);
+          WriteRegister(instr->dst, ObjectRef());
+          OpStopHook();
+          pc_++;
+        } else {
+          // The memory planner emits the kills of a basic block back to back, release the
+          // whole run without going through the dispatch for each of them.
+          do {
+            WriteRegister(instr->dst, ObjectRef());
+            instr = &code_[++pc_];
+          } while (instr->op == Opcode::KillRegister);
+        }
       }
+      VM_DISPATCH();
       default:
-        LOG(FATAL) << "Unknown instruction opcode: " << int(instr.op);
+        LOG(FATAL) << "Unknown instruction opcode: " << int(instr->op);
     }
   }
+#undef VM_CASE
+#undef VM_DISPATCH
+#undef VM_OP_START_HOOK
+#undef VM_OP_STOP_HOOK
 }
 
 void VirtualMachine::WriteAllocatedTensor(const Instruction& instr) {
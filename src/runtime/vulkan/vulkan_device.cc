@@ -70,6 +70,8 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+  VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
 
   // Set up linked list for feature query
   {
@@ -86,6 +88,10 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       *pp_next = &float16_int8;
       pp_next = &float16_int8.pNext;
     }
+    if (device.HasExtension("VK_KHR_timeline_semaphore")) {
+      *pp_next = &timeline_semaphore;
+      pp_next = &timeline_semaphore.pNext;
+    }
   }
 
   if (instance.HasExtension("VK_KHR_get_physical_device_properties2")) {
@@ -136,6 +142,14 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
 
   supports_cooperative_matrix = device.HasExtension("VK_NV_cooperative_matrix");
 
+  supports_khr_cooperative_matrix = device.HasExtension("VK_KHR_cooperative_matrix");
+
+  // Support is available based on this extension, but allow it to
+  // be disabled based on an environment variable.
+  supports_timeline_semaphore =
+      device.HasExtension("VK_KHR_timeline_semaphore") && timeline_semaphore.timelineSemaphore &&
+      !support::BoolEnvironmentVar("TVM_VULKAN_DISABLE_TIMELINE_SEMAPHORE");
+
   // The check of VK_SHADER_STAGE_COMPUTE_BIT isn't technically
   // needed, since it will be set so long at least one queue has
   // VK_QUEUE_COMPUTE_BIT.  Including it to avoid potential future
@@ -230,6 +244,11 @@ VulkanGetBufferMemoryRequirements2Functions::VulkanGetBufferMemoryRequirements2F
       vkGetDeviceProcAddr(device, "vkGetBufferMemoryRequirements2KHR"));
 }
 
+VulkanTimelineSemaphoreKHRFunctions::VulkanTimelineSemaphoreKHRFunctions(VkDevice device) {
+  vkWaitSemaphoresKHR = (PFN_vkWaitSemaphoresKHR)ICHECK_NOTNULL(
+      vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR"));
+}
+
 VulkanQueueInsertDebugUtilsLabelFunctions::VulkanQueueInsertDebugUtilsLabelFunctions(
     VkInstance instance) {
   vkQueueInsertDebugUtilsLabelEXT = (PFN_vkQueueInsertDebugUtilsLabelEXT)ICHECK_NOTNULL(
@@ -334,6 +353,11 @@ VulkanDevice::VulkanDevice(const VulkanInstance& instance, VkPhysicalDevice phy_
         std::make_unique<VulkanGetBufferMemoryRequirements2Functions>(device_);
   }
 
+  if (device_properties.supports_timeline_semaphore) {
+    timeline_semaphore_khr_functions =
+        std::make_unique<VulkanTimelineSemaphoreKHRFunctions>(device_);
+  }
+
   if (instance.HasExtension("VK_EXT_debug_utils")) {
     queue_insert_debug_utils_label_functions =
         std::make_unique<VulkanQueueInsertDebugUtilsLabelFunctions>(instance);
@@ -378,6 +402,7 @@ void VulkanDevice::do_swap(VulkanDevice&& other) {
             other.get_buffer_memory_requirements_2_functions);
   std::swap(queue_insert_debug_utils_label_functions,
             other.queue_insert_debug_utils_label_functions);
+  std::swap(timeline_semaphore_khr_functions, other.timeline_semaphore_khr_functions);
   std::swap(compute_mtype_index, other.compute_mtype_index);
   std::swap(queue, other.queue);
   std::swap(queue_family_index, other.queue_family_index);
@@ -438,7 +463,9 @@ std::vector<const char*> VulkanDevice::SelectEnabledExtensions() const {
                                                "VK_KHR_dedicated_allocation",
                                                "VK_KHR_spirv_1_4",
                                                "VK_KHR_shader_integer_dot_product",
-                                               "VK_NV_cooperative_matrix"};
+                                               "VK_NV_cooperative_matrix",
+                                               "VK_KHR_cooperative_matrix",
+                                               "VK_KHR_timeline_semaphore"};
 
   uint32_t device_extension_prop_count;
   VULKAN_CALL(vkEnumerateDeviceExtensionProperties(physical_device_, nullptr,
@@ -464,6 +491,12 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+  VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
+#ifdef VK_KHR_cooperative_matrix
+  VkPhysicalDeviceCooperativeMatrixFeaturesKHR cooperative_matrix = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_KHR};
+#endif
 
   void** pp_next = &enabled_features.pNext;
   bool needs_float16_int8 = false;
@@ -501,6 +534,20 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
     pp_next = &float16_int8.pNext;
   }
 
+  if (device_properties.supports_timeline_semaphore) {
+    timeline_semaphore.timelineSemaphore = true;
+    *pp_next = &timeline_semaphore;
+    pp_next = &timeline_semaphore.pNext;
+  }
+
+#ifdef VK_KHR_cooperative_matrix
+  if (device_properties.supports_khr_cooperative_matrix) {
+    cooperative_matrix.cooperativeMatrix = true;
+    *pp_next = &cooperative_matrix;
+    pp_next = &cooperative_matrix.pNext;
+  }
+#endif
+
   float priority = 1.0f;
 
   struct VkDeviceQueueCreateInfo queue_create_info;
@@ -245,6 +245,14 @@ void VulkanDeviceAPI::GetTargetProperty(Device dev, const std::string& property,
     *rv = prop.supports_cooperative_matrix;
   }
 
+  if (property == "supports_khr_cooperative_matrix") {
+    *rv = prop.supports_khr_cooperative_matrix;
+  }
+
+  if (property == "supports_timeline_semaphore") {
+    *rv = prop.supports_timeline_semaphore;
+  }
+
   if (property == "device_name") {
     *rv = prop.device_name;
   }
@@ -386,7 +394,7 @@ void VulkanDeviceAPI::CopyDataFromTo(const void* from, size_t from_offset, void*
     auto& device = this->device(dev_to.device_id);
     auto& stream = device.ThreadLocalStream();
     const auto* to_buf = static_cast<const VulkanBuffer*>(to);
-    auto& staging_buffer = device.ThreadLocalStagingBuffer(size);
+    auto& staging_buffer = stream.StagingBuffer(size);
     memcpy(staging_buffer.host_addr, static_cast<const char*>(from) + from_offset, size);
     // host side flush if access is not coherent.
     // so writes from CPU is visible to GPU
@@ -417,12 +425,19 @@ void VulkanDeviceAPI::CopyDataFromTo(const void* from, size_t from_offset, void*
       copy_info.size = size;
       vkCmdCopyBuffer(state->cmd_buffer_, staging_buffer.vk_buf.buffer, to_buf->buffer, 1,
                       &copy_info);
+      // 2: barrier(transfer-> compute|transfer), as the host no longer waits for the copy
+      barrier_info.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier_info.dstAccessMask = (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+      vkCmdPipelineBarrier(state->cmd_buffer_, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                           1, &barrier_info, 0, nullptr, 0, nullptr);
     });
 
     stream.ProfilerReady();
-    // TODO(tulloch): should we instead make the staging buffer a property of the
-    // Stream? This would allow us to elide synchronizations here.
-    stream.Synchronize();
+    // The staging buffer belongs to the submitted command buffer, so
+    // the host does not need to wait for the copy.
+    stream.Submit();
   } else {
     LOG(FATAL) << "Expect copy from/to Vulkan or between Vulkan"
                << ", from=" << from_dev_type << ", to=" << to_dev_type;
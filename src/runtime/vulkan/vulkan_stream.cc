@@ -26,8 +26,21 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
-VulkanStream::VulkanStream(const VulkanDevice* device)
-    : device_(device), state_(new VulkanStreamState()) {
+namespace {
+// The number of command buffers which can be submitted or recorded at a time.
+constexpr size_t kNumCommandBuffers = 3;
+
+void BeginCommandBuffer(VkCommandBuffer cmd_buffer) {
+  VkCommandBufferBeginInfo cb_begin;
+  cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  cb_begin.pNext = nullptr;
+  cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  cb_begin.pInheritanceInfo = 0;
+  VULKAN_CALL(vkBeginCommandBuffer(cmd_buffer, &cb_begin));
+}
+}  // namespace
+
+VulkanStream::VulkanStream(const VulkanDevice* device) : device_(device) {
   // create command pool
   VkCommandPoolCreateInfo cmd_pool_cinfo;
   cmd_pool_cinfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -36,26 +49,42 @@ VulkanStream::VulkanStream(const VulkanDevice* device)
   cmd_pool_cinfo.queueFamilyIndex = device_->queue_family_index;
   VULKAN_CALL(vkCreateCommandPool(*device_, &cmd_pool_cinfo, nullptr, &cmd_pool_));
 
-  VkCommandBufferAllocateInfo buffer_alloc_info;
-  buffer_alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  buffer_alloc_info.pNext = nullptr;
-  buffer_alloc_info.commandPool = cmd_pool_;
-  buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  buffer_alloc_info.commandBufferCount = 1;
-  VULKAN_CALL(vkAllocateCommandBuffers(*device_, &buffer_alloc_info, &(state_->cmd_buffer_)));
+  if (device_->UseTimelineSemaphore()) {
+    VkSemaphoreTypeCreateInfo type_cinfo;
+    type_cinfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    type_cinfo.pNext = nullptr;
+    type_cinfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    type_cinfo.initialValue = timeline_value_;
 
-  VkFenceCreateInfo fence_cinfo;
-  fence_cinfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-  fence_cinfo.pNext = nullptr;
-  fence_cinfo.flags = 0;  // VK_FENCE_CREATE_SIGNALED_BIT;
-  VULKAN_CALL(vkCreateFence(*device_, &fence_cinfo, nullptr, &(state_->fence_)));
+    VkSemaphoreCreateInfo semaphore_cinfo;
+    semaphore_cinfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_cinfo.pNext = &type_cinfo;
+    semaphore_cinfo.flags = 0;
+    VULKAN_CALL(vkCreateSemaphore(*device_, &semaphore_cinfo, nullptr, &timeline_semaphore_));
+  }
 
-  VkCommandBufferBeginInfo cb_begin;
-  cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  cb_begin.pNext = nullptr;
-  cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-  cb_begin.pInheritanceInfo = 0;
-  VULKAN_CALL(vkBeginCommandBuffer(state_->cmd_buffer_, &cb_begin));
+  for (size_t i = 0; i < kNumCommandBuffers; ++i) {
+    auto state = std::make_unique<VulkanStreamState>();
+
+    VkCommandBufferAllocateInfo buffer_alloc_info;
+    buffer_alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    buffer_alloc_info.pNext = nullptr;
+    buffer_alloc_info.commandPool = cmd_pool_;
+    buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    buffer_alloc_info.commandBufferCount = 1;
+    VULKAN_CALL(vkAllocateCommandBuffers(*device_, &buffer_alloc_info, &(state->cmd_buffer_)));
+
+    state->fence_ = VK_NULL_HANDLE;
+    if (!device_->UseTimelineSemaphore()) {
+      VkFenceCreateInfo fence_cinfo;
+      fence_cinfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+      fence_cinfo.pNext = nullptr;
+      fence_cinfo.flags = 0;  // VK_FENCE_CREATE_SIGNALED_BIT;
+      VULKAN_CALL(vkCreateFence(*device_, &fence_cinfo, nullptr, &(state->fence_)));
+    }
+    states_.push_back(std::move(state));
+  }
+  BeginCommandBuffer(states_[current_]->cmd_buffer_);
 
   if (support::BoolEnvironmentVar("TVM_USE_AMD_RGP")) {
     profiler_ = new AmdRgpProfiler(device_);
@@ -63,7 +92,17 @@ VulkanStream::VulkanStream(const VulkanDevice* device)
 }
 
 VulkanStream::~VulkanStream() {
-  vkDestroyFence(*device_, state_->fence_, nullptr);
+  // The command buffers may not be destroyed while running.
+  WaitSubmitted();
+  for (auto& state : states_) {
+    state->staging_buffer_.reset();
+    if (state->fence_ != VK_NULL_HANDLE) {
+      vkDestroyFence(*device_, state->fence_, nullptr);
+    }
+  }
+  if (timeline_semaphore_ != VK_NULL_HANDLE) {
+    vkDestroySemaphore(*device_, timeline_semaphore_, nullptr);
+  }
   vkDestroyCommandPool(*device_, cmd_pool_, nullptr);
 
   if (profiler_) {
@@ -73,7 +112,7 @@ VulkanStream::~VulkanStream() {
 
 void VulkanStream::Launch(const std::function<void(VulkanStreamState*)>& kernel) {
   if (device_->UseImmediate()) {
-    kernel(state_.get());
+    kernel(states_[current_].get());
   } else {
     deferred_kernels_.push_back(kernel);
   }
@@ -117,10 +156,41 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
   deferred_tokens_[deferred_token.descriptor_set_].push_back(deferred_token);
 }
 
+VulkanStagingBuffer& VulkanStream::StagingBuffer(size_t min_size) {
+  auto& staging_buffer = states_[current_]->staging_buffer_;
+  if (!staging_buffer || staging_buffer->size < min_size) {
+    auto usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    staging_buffer = std::make_unique<VulkanStagingBuffer>(*device_, min_size, usage,
+                                                           device_->staging_mtype_index);
+  }
+  return *staging_buffer;
+}
+
+void VulkanStream::Submit() {
+  if (!device_->UseImmediate()) {
+    // The descriptor sets of the deferred kernels may only be updated
+    // again once the kernels using them are finished.
+    Synchronize();
+    return;
+  }
+  SubmitCurrent();
+}
+
+void VulkanStream::WaitSubmitted() {
+  for (auto& state : states_) {
+    Wait(state.get());
+  }
+}
+
 void VulkanStream::Synchronize() {
+  SubmitCurrent();
+  WaitSubmitted();
+}
+
+void VulkanStream::SubmitCurrent() {
   if (!device_->UseImmediate()) {
     for (const auto& deferred_kernel : deferred_kernels_) {
-      deferred_kernel(state_.get());
+      deferred_kernel(states_[current_].get());
     }
     deferred_kernels_.clear();
     deferred_tokens_.clear();
@@ -129,7 +199,8 @@ void VulkanStream::Synchronize() {
     DCHECK_EQ(deferred_tokens_.size(), 0);
   }
 
-  VULKAN_CALL(vkEndCommandBuffer(state_->cmd_buffer_));
+  VulkanStreamState* state = states_[current_].get();
+  VULKAN_CALL(vkEndCommandBuffer(state->cmd_buffer_));
   VkSubmitInfo cb_submit;
   cb_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   cb_submit.pNext = nullptr;
@@ -137,32 +208,66 @@ void VulkanStream::Synchronize() {
   cb_submit.pWaitSemaphores = nullptr;
   cb_submit.pWaitDstStageMask = 0;
   cb_submit.commandBufferCount = 1;
-  cb_submit.pCommandBuffers = &(state_->cmd_buffer_);
+  cb_submit.pCommandBuffers = &(state->cmd_buffer_);
   cb_submit.signalSemaphoreCount = 0;
   cb_submit.pSignalSemaphores = nullptr;
 
+  VkTimelineSemaphoreSubmitInfo timeline_submit;
+  if (timeline_semaphore_ != VK_NULL_HANDLE) {
+    state->timeline_value_ = ++timeline_value_;
+    timeline_submit.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_submit.pNext = nullptr;
+    timeline_submit.waitSemaphoreValueCount = 0;
+    timeline_submit.pWaitSemaphoreValues = nullptr;
+    timeline_submit.signalSemaphoreValueCount = 1;
+    timeline_submit.pSignalSemaphoreValues = &(state->timeline_value_);
+    cb_submit.pNext = &timeline_submit;
+    cb_submit.signalSemaphoreCount = 1;
+    cb_submit.pSignalSemaphores = &timeline_semaphore_;
+  }
+
   if (profiler_) {
     profiler_->capture();
   }
 
-  device_->QueueSubmit(cb_submit, state_->fence_);
+  device_->QueueSubmit(cb_submit, state->fence_);
+  state->in_flight_ = true;
+
+  // Begin recording into the next command buffer, which must be
+  // finished before it is reused.
+  current_ = (current_ + 1) % states_.size();
+  Wait(states_[current_].get());
+  BeginCommandBuffer(states_[current_]->cmd_buffer_);
+}
 
+void VulkanStream::Wait(VulkanStreamState* state) {
+  if (!state->in_flight_) {
+    return;
+  }
   uint64_t timeout = 1UL << 30UL;
   VkResult res;
-  do {
-    res = vkWaitForFences(*device_, 1, &(state_->fence_), 0, timeout);
-  } while (res == VK_TIMEOUT);
-  VULKAN_CHECK_ERROR(res);
-  VULKAN_CALL(vkResetCommandBuffer(state_->cmd_buffer_, 0));
-  VULKAN_CALL(vkResetFences(*device_, 1, &(state_->fence_)));
-
-  // Re-initialize the command buffer
-  VkCommandBufferBeginInfo cb_begin;
-  cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  cb_begin.pNext = nullptr;
-  cb_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-  cb_begin.pInheritanceInfo = 0;
-  VULKAN_CALL(vkBeginCommandBuffer(state_->cmd_buffer_, &cb_begin));
+  if (timeline_semaphore_ != VK_NULL_HANDLE) {
+    VkSemaphoreWaitInfo wait_info;
+    wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    wait_info.pNext = nullptr;
+    wait_info.flags = 0;
+    wait_info.semaphoreCount = 1;
+    wait_info.pSemaphores = &timeline_semaphore_;
+    wait_info.pValues = &(state->timeline_value_);
+    do {
+      res = device_->timeline_semaphore_khr_functions->vkWaitSemaphoresKHR(*device_, &wait_info,
+                                                                           timeout);
+    } while (res == VK_TIMEOUT);
+    VULKAN_CHECK_ERROR(res);
+  } else {
+    do {
+      res = vkWaitForFences(*device_, 1, &(state->fence_), 0, timeout);
+    } while (res == VK_TIMEOUT);
+    VULKAN_CHECK_ERROR(res);
+    VULKAN_CALL(vkResetFences(*device_, 1, &(state->fence_)));
+  }
+  VULKAN_CALL(vkResetCommandBuffer(state->cmd_buffer_, 0));
+  state->in_flight_ = false;
 }
 
 }  // namespace vulkan
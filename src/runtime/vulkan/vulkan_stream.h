@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "vulkan_amdrgp.h"
+#include "vulkan_buffer.h"
 #include "vulkan_common.h"
 
 namespace tvm {
@@ -38,6 +39,12 @@ class VulkanStreamState {
  public:
   VkCommandBuffer cmd_buffer_;
   VkFence fence_;
+  // Whether the command buffer is submitted and may still be running.
+  bool in_flight_{false};
+  // The value of the timeline semaphore signaled by the last submission.
+  uint64_t timeline_value_{0};
+  // The staging buffer for the uploads recorded into the command buffer.
+  std::unique_ptr<VulkanStagingBuffer> staging_buffer_;
 };
 
 // Used to identify state that should only be used once-per-stream.
@@ -56,6 +63,14 @@ struct VulkanStreamToken {
  *  finish.  The queued commands can also be explicitly pushed/waited
  *  on by calling VulkanStream::Synchronize.
  *
+ *  The stream cycles through a small ring of command buffers, so that
+ *  VulkanStream::Submit can push the queued commands to the GPU
+ *  without waiting for them, and the CPU can record the next batch
+ *  while the previous ones run.  The CPU only waits when it reuses a
+ *  command buffer which is still running.  The completion of the
+ *  submissions is tracked with a timeline semaphore if the device
+ *  supports it, and with a fence per command buffer otherwise.
+ *
  *  Currently, there exists one VulkanStream for each GPU device, for
  *  each CPU thread.  Each time a VulkanWrappedFunc is called, it is
  *  submitted to the VulkanStream associated with the submitting CPU
@@ -114,12 +129,43 @@ class VulkanStream {
     }
   }
 
-  // Synchronize the current stream `state_` with respect to the host.
+  /*! \brief Return the staging buffer of the command buffer being recorded.
+   *
+   * The buffer is not reused until the commands recorded with it are
+   * finished, so that uploads can be submitted without waiting.
+   *
+   * \param min_size The size in bytes of the staging buffer to be
+   * returned.
+   */
+  VulkanStagingBuffer& StagingBuffer(size_t min_size);
+
+  /*! \brief Submit the queued commands to the GPU without waiting for them.
+   *
+   * Can only skip the wait if device.UseImmediate() is true, as the
+   * deferred kernels share descriptor sets across submissions.
+   * Otherwise, it is the same as Synchronize.
+   */
+  void Submit();
+
+  // Wait for the submitted commands to finish.
+  void WaitSubmitted();
+
+  // Submit the queued commands, and wait for all of them to finish.
   void Synchronize();
 
  private:
+  // Submit the command buffer being recorded, and begin recording the next one.
+  void SubmitCurrent();
+  // Wait for the submission of a command buffer to finish, and reset it.
+  void Wait(VulkanStreamState* state);
+
   const VulkanDevice* device_;
-  std::unique_ptr<VulkanStreamState> state_;
+  // The ring of command buffers, states_[current_] is being recorded.
+  std::vector<std::unique_ptr<VulkanStreamState>> states_;
+  size_t current_{0};
+  // The timeline semaphore signaled by the submissions, if supported by the device.
+  VkSemaphore timeline_semaphore_{VK_NULL_HANDLE};
+  uint64_t timeline_value_{0};
   // An index of deferred tokens, allowing us to efficiently detect duplicated
   // deferred_initializer blocks.
   std::unordered_map<VkDescriptorSet, std::vector<VulkanStreamToken>> deferred_tokens_;
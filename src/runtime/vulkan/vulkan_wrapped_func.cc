@@ -80,6 +80,8 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
           descriptor_buffers.data());
 
       if (pipeline->use_ubo) {
+        // The uniform buffer may still be read by the submitted kernels.
+        device.ThreadLocalStream().WaitSubmitted();
         auto& ubo = device.ThreadLocalUniformBuffer(nbytes_scalars);
         memcpy(ubo.host_addr, pack_args, nbytes_scalars);
       } else if (num_pack_args_ > 0) {
@@ -291,6 +291,26 @@ String DocPrinter::GetString() const {
                       MergeAndExemptSpans(underlines_, underlines_exempted_));
 }
 
+void DocPrinter::StreamTo(std::ostream* stream) {
+  ICHECK(!options_->print_line_numbers && options_->path_to_underline.empty())
+      << "ValueError: Line numbers and underlines can not be streamed";
+  stream_ = stream;
+}
+
+void DocPrinter::Flush() {
+  ICHECK(stream_ != nullptr) << "The printer does not stream, see StreamTo";
+  std::string text = output_.str();
+  size_t end = text.size();
+  while (end > 0 && std::isspace(text[end - 1])) {
+    --end;
+  }
+  stream_->write(text.data(), end);
+  // Spans are only needed for underlines, which are not streamed, so the offsets may restart
+  output_.str("");
+  output_.clear();
+  output_ << text.substr(end);
+}
+
 void DocPrinter::PrintDoc(const Doc& doc) {
   size_t start_pos = output_.tellp();
 
@@ -83,6 +83,28 @@ class DocPrinter {
    */
   String GetString() const;
 
+  /*!
+   * \brief Write the printed content to a stream as it is printed, instead of keeping it for
+   *        GetString
+   *
+   * The content is written a chunk of lines at a time, so that printing a large Doc does not
+   * hold its whole text in memory. Neither line numbers nor underlines can be printed, as they
+   * need the whole text.
+   *
+   * \param stream The stream to write to
+   *
+   * \sa Flush
+   */
+  void StreamTo(std::ostream* stream);
+
+  /*!
+   * \brief Write the content printed since the last write to the stream, except its trailing
+   *        whitespace, which is only written if more content follows
+   *
+   * \sa StreamTo
+   */
+  void Flush();
+
  protected:
   /*!
    * \brief Get the printed string
@@ -232,6 +254,9 @@ class DocPrinter {
    * \sa output_
    */
   std::ostream& NewLine() {
+    if (stream_ != nullptr && static_cast<size_t>(output_.tellp()) >= kStreamChunkBytes) {
+      Flush();
+    }
     size_t start_pos = output_.tellp();
     output_ << "\n";
     line_starts_.push_back(output_.tellp());
@@ -257,6 +282,12 @@ class DocPrinter {
  private:
   void MarkSpan(const ByteSpan& span, const ObjectPath& path);
 
+  /*! \brief The size of the content written at once to stream_ */
+  static constexpr size_t kStreamChunkBytes = 1 << 16;
+
+  /*! \brief The stream the content is written to, if any, see StreamTo */
+  std::ostream* stream_ = nullptr;
+
   /*! \brief Options to customize certain aspects of the output */
   PrinterConfig options_;
 
@@ -702,7 +702,19 @@ String DocToPythonScript(Doc doc, const PrinterConfig& cfg) {
   return result.substr(0, last_space);
 }
 
-TVM_REGISTER_GLOBAL("script.printer.DocToPythonScript").set_body_typed(DocToPythonScript);
+void DocToPythonScript(Doc doc, const PrinterConfig& cfg, std::ostream* os) {
+  if (cfg->print_line_numbers || !cfg->path_to_underline.empty()) {
+    *os << DocToPythonScript(doc, cfg);
+    return;
+  }
+  PythonDocPrinter printer(cfg);
+  printer.StreamTo(os);
+  printer.Append(doc, cfg);
+  printer.Flush();
+}
+
+TVM_REGISTER_GLOBAL("script.printer.DocToPythonScript")
+    .set_body_typed([](Doc doc, PrinterConfig cfg) { return DocToPythonScript(doc, cfg); });
 
 }  // namespace printer
 }  // namespace script
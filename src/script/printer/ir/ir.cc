@@ -17,6 +17,10 @@
  * under the License.
  */
 #include <tvm/ir/tensor_type.h>
+#include <tvm/support/parallel_for.h>
+
+#include <atomic>
+#include <fstream>
 
 #include "./utils.h"
 
@@ -55,6 +59,51 @@ struct SortableFunction {
   }
 };
 
+/*!
+ * \brief Convert the functions of a module to docs in parallel, each with an IRDocsifier of its
+ *  own, where the module and the GlobalVars are defined like in the IRDocsifier of the module.
+ * \return The docs, or nothing if a function needs metadata, whose indices are shared by all the
+ *  functions.
+ */
+Optional<Array<Doc>> DocsifyFunctionsInParallel(const IRModule& mod,
+                                                const std::vector<SortableFunction>& functions,
+                                                const String& module_name, const ObjectPath& p,
+                                                const IRDocsifier& d) {
+  int n = functions.size();
+  std::vector<ObjectRef> docs(n);
+  std::vector<std::unordered_set<std::string>> ir_usages(n);
+  std::atomic<bool> has_metadata{false};
+  support::parallel_for_dynamic(0, n, d->cfg->num_threads, [&](int thread_id, int i) {
+    PrinterConfig cfg(make_object<PrinterConfigNode>(*d->cfg.get()));
+    IRDocsifier fd(cfg);
+    With<IRFrame> f(fd);
+    (*f)->AddDispatchToken(fd, "ir");
+    fd->Define(mod, f(), module_name);
+    for (const auto& entry : functions) {
+      const GlobalVar& gv = entry.gv;
+      fd->Define(gv, f(), [=]() {
+        return fd->AsDoc<ExprDoc>(mod, p->Attr("global_vars"))->Attr(gv->name_hint);
+      });
+    }
+    const GlobalVar& gv = functions[i].gv;
+    cfg->binding_names.push_back(gv->name_hint);
+    docs[i] = fd->AsDoc(functions[i].func, p->Attr("functions")->MapValue(gv));
+    ir_usages[i] = fd->ir_usage;
+    if (!fd->metadata.empty()) {
+      has_metadata = true;
+    }
+  });
+  if (has_metadata) {
+    return NullOpt;
+  }
+  Array<Doc> result;
+  for (int i = 0; i < n; ++i) {
+    d->ir_usage.insert(ir_usages[i].begin(), ir_usages[i].end());
+    result.push_back(Downcast<Doc>(docs[i]));
+  }
+  return result;
+}
+
 TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
     .set_dispatch<IRModule>("", [](IRModule mod, ObjectPath p, IRDocsifier d) -> Doc {
       std::vector<SortableFunction> functions;
@@ -80,13 +129,19 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
         });
       }
       // Print functions
-
-      for (const auto& entry : functions) {
-        const GlobalVar& gv = entry.gv;
-        const BaseFunc& func = entry.func;
-        d->cfg->binding_names.push_back(gv->name_hint);
-        Doc doc = d->AsDoc(func, p->Attr("functions")->MapValue(gv));
-        d->cfg->binding_names.pop_back();
+      Optional<Array<Doc>> parallel_docs = NullOpt;
+      if (d->cfg->num_threads > 1 && functions.size() > 1) {
+        parallel_docs = DocsifyFunctionsInParallel(mod, functions, module_doc->name, p, d);
+      }
+      for (size_t i = 0; i < functions.size(); ++i) {
+        const GlobalVar& gv = functions[i].gv;
+        const BaseFunc& func = functions[i].func;
+        Doc doc = parallel_docs ? parallel_docs.value()[i] : [&]() {
+          d->cfg->binding_names.push_back(gv->name_hint);
+          Doc doc = d->AsDoc(func, p->Attr("functions")->MapValue(gv));
+          d->cfg->binding_names.pop_back();
+          return doc;
+        }();
         if (const auto* stmt_block = doc.as<StmtBlockDocNode>()) {
           (*f)->stmts.push_back(stmt_block->stmts.back());
           (*f)->stmts.back()->source_paths = std::move(doc->source_paths);
@@ -165,6 +220,26 @@ std::string ReprPrintIRModule(const ObjectRef& mod, const PrinterConfig& cfg) {
   return ReprPrintIR(mod, cfg);
 }
 
+TVM_REGISTER_GLOBAL("script.printer.ScriptToFile")
+    .set_body_typed([](ObjectRef obj, PrinterConfig cfg, String path) {
+      std::ofstream os(path);
+      ICHECK(os) << "ValueError: Cannot open " << path << " to print the script to";
+      if (!obj->IsInstance<IRModuleNode>()) {
+        os << TVMScriptPrinter::Script(obj, cfg);
+        return;
+      }
+      if (const auto* f = runtime::Registry::Get("relay.ir.PrintRelayModule")) {
+        if (Optional<String> s = (*f)(obj)) {
+          os << s.value();
+          return;
+        }
+      }
+      IRDocsifier d(cfg);
+      With<IRFrame> f(d);
+      (*f)->AddDispatchToken(d, "ir");
+      Docsify(obj, d, *f, cfg, &os);
+    });
+
 TVM_SCRIPT_REPR(TypeVarNode, ReprPrintIR);
 TVM_SCRIPT_REPR(GlobalTypeVarNode, ReprPrintIR);
 TVM_SCRIPT_REPR(GlobalVarNode, ReprPrintIR);
@@ -273,14 +273,26 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
     .set_dispatch<tir::BufferStore>(  //
         "", [](tir::BufferStore store, ObjectPath p, IRDocsifier d) -> Doc {
           ExprDoc buffer = d->AsDoc<ExprDoc>(store->buffer, p->Attr("buffer"));
+          ExprDoc value = d->AsDoc<ExprDoc>(store->value, p->Attr("value"));
+          if (store->predicate) {
+            ExprDoc predicate = d->AsDoc<ExprDoc>(store->predicate, p->Attr("predicate"));
+            return ExprStmtDoc(buffer->Attr("vstore")->Call(
+                {d->AsDoc<ExprDoc>(store->indices, p->Attr("indices")), value}, {"predicate"},
+                {predicate}));
+          }
           return AssignDoc(/*lhs=*/buffer[BufferIndices(store->indices, p->Attr("indices"), d)],
-                           /*rhs=*/d->AsDoc<ExprDoc>(store->value, p->Attr("value")), NullOpt);
+                           /*rhs=*/value, NullOpt);
         });
 
 TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
     .set_dispatch<tir::BufferLoad>(  //
         "", [](tir::BufferLoad load, ObjectPath p, IRDocsifier d) -> Doc {
           ExprDoc buffer = d->AsDoc<ExprDoc>(load->buffer, p->Attr("buffer"));
+          if (load->predicate) {
+            ExprDoc predicate = d->AsDoc<ExprDoc>(load->predicate, p->Attr("predicate"));
+            return buffer->Attr("vload")->Call(
+                {d->AsDoc<ExprDoc>(load->indices, p->Attr("indices"))}, {"predicate"}, {predicate});
+          }
           return buffer[BufferIndices(load->indices, p->Attr("indices"), d)];
         });
 
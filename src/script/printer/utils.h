@@ -58,8 +58,9 @@ inline void RedirectedReprPrinterMethod(const ObjectRef& obj, ReprPrinter* p) {
   }
 }
 
-inline std::string Docsify(const ObjectRef& obj, const IRDocsifier& d, const Frame& f,
-                           const PrinterConfig& cfg) {
+/*! \brief Print an object as TVMScript to a stream, as the script is printed */
+inline void Docsify(const ObjectRef& obj, const IRDocsifier& d, const Frame& f,
+                    const PrinterConfig& cfg, std::ostream* os) {
   Doc doc = d->AsDoc(obj, ObjectPath::Root());
   bool move_source_paths = false;
   if (const auto* expr_doc = doc.as<ExprDocNode>()) {
@@ -77,13 +78,12 @@ inline std::string Docsify(const ObjectRef& obj, const IRDocsifier& d, const Fra
   } else {
     LOG(FATAL) << "TypeError: Unexpected doc type: " << doc->GetTypeKey();
   }
-  std::ostringstream os;
   if (!d->metadata.empty()) {
     if (d->cfg->show_meta) {
-      os << "metadata = tvm.ir.load_json(\""
-         << support::StrEscape(
-                SaveJSON(Map<String, ObjectRef>(d->metadata.begin(), d->metadata.end())))
-         << "\")\n";
+      *os << "metadata = tvm.ir.load_json(\""
+          << support::StrEscape(
+                 SaveJSON(Map<String, ObjectRef>(d->metadata.begin(), d->metadata.end())))
+          << "\")\n";
     } else {
       f->stmts.push_back(
           CommentDoc("Metadata omitted. Use show_meta=True in script() method to show it."));
@@ -92,10 +92,16 @@ inline std::string Docsify(const ObjectRef& obj, const IRDocsifier& d, const Fra
   if (move_source_paths) {
     StmtBlockDoc new_doc(f->stmts);
     new_doc->source_paths = std::move(doc->source_paths);
-    os << DocToPythonScript(new_doc, cfg);
+    DocToPythonScript(new_doc, cfg, os);
   } else {
-    os << DocToPythonScript(StmtBlockDoc(f->stmts), cfg);
+    DocToPythonScript(StmtBlockDoc(f->stmts), cfg, os);
   }
+}
+
+inline std::string Docsify(const ObjectRef& obj, const IRDocsifier& d, const Frame& f,
+                           const PrinterConfig& cfg) {
+  std::ostringstream os;
+  Docsify(obj, d, f, cfg, &os);
   return os.str();
 }
 
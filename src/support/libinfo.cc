@@ -167,6 +167,10 @@
 #define TVM_INFO_USE_CUBLAS "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_CUFILE
+#define TVM_INFO_USE_CUFILE "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_THRUST
 #define TVM_INFO_USE_THRUST "NOT-FOUND"
 #endif
@@ -175,6 +179,14 @@
 #define TVM_INFO_USE_CURAND "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_CUPTI
+#define TVM_INFO_USE_CUPTI "NOT-FOUND"
+#endif
+
+#ifndef TVM_INFO_USE_NCCL
+#define TVM_INFO_USE_NCCL "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_MIOPEN
 #define TVM_INFO_USE_MIOPEN "NOT-FOUND"
 #endif
@@ -183,6 +195,10 @@
 #define TVM_INFO_USE_ROCBLAS "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_EMBEDDING
+#define TVM_INFO_USE_EMBEDDING "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_SORT
 #define TVM_INFO_USE_SORT "NOT-FOUND"
 #endif
@@ -281,14 +297,18 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_CUBLAS", TVM_INFO_USE_CUBLAS},
       {"USE_CUDA", TVM_INFO_USE_CUDA},
       {"USE_CUDNN", TVM_INFO_USE_CUDNN},
+      {"USE_CUFILE", TVM_INFO_USE_CUFILE},
       {"USE_CUSTOM_LOGGING", TVM_INFO_USE_CUSTOM_LOGGING},
       {"USE_CUTLASS", TVM_INFO_USE_CUTLASS},
       {"USE_AMX", TVM_INFO_USE_AMX},
       {"USE_DNNL", TVM_INFO_USE_DNNL},
+      {"USE_EMBEDDING", TVM_INFO_USE_EMBEDDING},
       {"USE_ETHOSN", TVM_INFO_USE_ETHOSN},
       {"USE_FALLBACK_STL_MAP", TVM_INFO_USE_FALLBACK_STL_MAP},
       {"USE_GRAPH_EXECUTOR_CUDA_GRAPH", TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH},
+      {"USE_GRAPH_EXECUTOR_HIP_GRAPH", TVM_INFO_USE_GRAPH_EXECUTOR_HIP_GRAPH},
       {"USE_GRAPH_EXECUTOR", TVM_INFO_USE_GRAPH_EXECUTOR},
+      {"USE_GBENCHMARK", TVM_INFO_USE_GBENCHMARK},
       {"USE_GTEST", TVM_INFO_USE_GTEST},
       {"USE_HEXAGON", TVM_INFO_USE_HEXAGON},
       {"USE_HEXAGON_RPC", TVM_INFO_USE_HEXAGON_RPC},
@@ -322,6 +342,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_RTTI", TVM_INFO_USE_RTTI},
       {"USE_RUST_EXT", TVM_INFO_USE_RUST_EXT},
       {"USE_SORT", TVM_INFO_USE_SORT},
+      {"USE_SPIRV_KHR_COOPERATIVE_MATRIX", TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX},
       {"USE_SPIRV_KHR_INTEGER_DOT_PRODUCT", TVM_INFO_USE_SPIRV_KHR_INTEGER_DOT_PRODUCT},
       {"USE_STACKVM_RUNTIME", TVM_INFO_USE_STACKVM_RUNTIME},
       {"USE_TARGET_ONNX", TVM_INFO_USE_TARGET_ONNX},
@@ -333,12 +354,15 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_THREADS", TVM_INFO_USE_THREADS},
       {"USE_THRUST", TVM_INFO_USE_THRUST},
       {"USE_CURAND", TVM_INFO_USE_CURAND},
+      {"USE_CUPTI", TVM_INFO_USE_CUPTI},
+      {"USE_NCCL", TVM_INFO_USE_NCCL},
       {"USE_VITIS_AI", TVM_INFO_USE_VITIS_AI},
       {"USE_VULKAN", TVM_INFO_USE_VULKAN},
       {"USE_CLML", TVM_INFO_USE_CLML},
       {"TVM_CLML_VERSION", TVM_INFO_USE_TVM_CLML_VERSION},
       {"USE_CLML_GRAPH_EXECUTOR", TVM_INFO_USE_CLML_GRAPH_EXECUTOR},
       {"USE_UMA", TVM_INFO_USE_UMA},
+      {"USE_USDT", TVM_INFO_USE_USDT},
       {"USE_VERILATOR", TVM_INFO_USE_VERILATOR},
       {"USE_CCACHE", TVM_INFO_USE_CCACHE},
       {"BACKTRACE_ON_SEGFAULT", TVM_INFO_BACKTRACE_ON_SEGFAULT},
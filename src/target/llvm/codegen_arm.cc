@@ -30,7 +30,11 @@
 #endif
 #include <llvm/Target/TargetMachine.h>
 
+#include <algorithm>
+#include <string>
+
 #include "codegen_cpu.h"
+#include "llvm_instance.h"
 
 namespace tvm {
 namespace codegen {
@@ -45,18 +49,38 @@ class CodeGenARM final : public CodeGenCPU {
   void InitTarget() final {
     // set native vector bits.
     native_vector_bits_ = 16 * 8;
+    is_aarch64_ = llvm::StringRef(llvm_target_->GetTargetTriple()).startswith("aarch64");
+    // With SVE, the vectors are as wide as the minimum SVE vector length that LLVM lowers the
+    // fixed-length vectors to, e.g. -cl-opt=aarch64-sve-vector-bits-min:uint=256 on Graviton3.
+    // The accesses that do not fill a vector become predicated SVE loads and stores.
+    if (HasTargetFeature("+sve") || HasTargetFeature("+sve2")) {
+      for (const auto& opt : llvm_target_->GetCommandLineOptions()) {
+        if (opt.name != "aarch64-sve-vector-bits-min") continue;
+        int bits = opt.type == LLVMTargetInfo::Option::OptType::Int ? opt.value.i : opt.value.u;
+        ICHECK(bits >= 128 && bits <= 2048 && bits % 128 == 0)
+            << "ValueError: invalid SVE vector length: " << bits
+            << ", should be a multiple of 128 between 128 and 2048";
+        native_vector_bits_ = bits;
+      }
+    }
     CodeGenCPU::InitTarget();
   }
   llvm::Value* CreateIntrinsic(const CallNode* op) override;
 
  private:
+  bool HasTargetFeature(const std::string& feature) const {
+    llvm::ArrayRef<std::string> features = llvm_target_->GetTargetFeatures();
+    return std::find(features.begin(), features.end(), feature) != features.end();
+  }
+  // Whether the target is AArch64, which has no NEON vpaddl intrinsics of AArch32
+  bool is_aarch64_{false};
   PrimExpr ARMPopcount(const CallNode* op);
 };
 
 llvm::Value* CodeGenARM::CreateIntrinsic(const CallNode* op) {
   if (op->op.same_as(builtin_call_llvm_intrin_) || op->op.same_as(builtin_call_llvm_pure_intrin_)) {
     llvm::Intrinsic::ID id = static_cast<llvm::Intrinsic::ID>(Downcast<IntImm>(op->args[0])->value);
-    if (id == llvm::Intrinsic::ctpop) {
+    if (id == llvm::Intrinsic::ctpop && !is_aarch64_) {
       PrimExpr e = ARMPopcount(op);
       return CodeGenCPU::CreateIntrinsic(e.as<CallNode>());
     }
@@ -137,6 +161,11 @@ TVM_REGISTER_GLOBAL("tvm.codegen.llvm.target_arm")
       *rv = static_cast<void*>(new CodeGenARM());
     });
 
+TVM_REGISTER_GLOBAL("tvm.codegen.llvm.target_aarch64")
+    .set_body([](const TVMArgs& targs, TVMRetValue* rv) {
+      *rv = static_cast<void*>(new CodeGenARM());
+    });
+
 }  // namespace codegen
 }  // namespace tvm
 
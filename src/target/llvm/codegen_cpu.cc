@@ -38,6 +38,7 @@
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InlineAsm.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/MDBuilder.h>
@@ -541,6 +542,7 @@ void CodeGenCPU::InitGlobalContext(bool dynamic_lookup) {
       // Mark as context functions
       gv_func_map_["TVMBackendAllocWorkspace"] = nullptr;
       gv_func_map_["TVMBackendFreeWorkspace"] = nullptr;
+      gv_func_map_["TVMBackendProfileEvent"] = nullptr;
     }
   }
 }
@@ -742,6 +744,46 @@ void CodeGenCPU::CreateParallelLaunch(const Stmt& body, int num_task, std::strin
   builder_->SetInsertPoint(par_launch_end);
 }
 
+llvm::Value* CodeGenCPU::CreateProfileEvent(const CallNode* op, bool is_end) {
+  ICHECK_EQ(op->args.size(), 1U);
+  // Read the cycle counter inline, rather than in the runtime, to keep the
+  // cost of the call out of the measured region.
+  llvm::Value* cycles;
+  llvm::Triple::ArchType arch =
+      llvm_target_->GetOrCreateTargetMachine()->getTargetTriple().getArch();
+  if (arch == llvm::Triple::x86 || arch == llvm::Triple::x86_64) {
+    // Lowered to rdtsc.
+    llvm::Function* f = GetIntrinsicDecl(llvm::Intrinsic::readcyclecounter, t_int64_, {});
+    cycles = builder_->CreateCall(f);
+  } else if (arch == llvm::Triple::aarch64) {
+    auto fty = llvm::FunctionType::get(t_int64_, false);
+    cycles = builder_->CreateCall(fty, llvm::InlineAsm::get(fty, "mrs $0, cntvct_el0", "=r", true));
+  } else {
+    // Let the runtime read the counter.
+    cycles = llvm::ConstantInt::getSigned(t_int64_, -1);
+  }
+  llvm::Value* id = builder_->CreateIntCast(MakeValue(op->args[0]), t_int32_, true);
+
+  // Defined in include/tvm/runtime/c_backend_api.h:
+  // int TVMBackendProfileEvent(int32_t id, int32_t is_end, int64_t cycles);
+  std::string global_symbol = "TVMBackendProfileEvent";
+  llvm::FunctionType* ftype =
+      llvm::FunctionType::get(t_int_, {t_int32_, t_int32_, t_int64_}, false);
+  llvm::Value* callee;
+  if (auto it = gv_func_map_.find(global_symbol); it != gv_func_map_.end()) {
+    if (it->second == nullptr) {
+      it->second = InitContextPtr(ftype->getPointerTo(), "__" + global_symbol);
+    }
+    callee = GetContextPtr(it->second);
+  } else if (llvm::Function* f = module_->getFunction(global_symbol)) {
+    callee = f;
+  } else {
+    callee = llvm::Function::Create(ftype, llvm::Function::ExternalLinkage, global_symbol,
+                                    module_.get());
+  }
+  return builder_->CreateCall(ftype, callee, {id, ConstInt32(is_end), cycles});
+}
+
 llvm::Value* CodeGenCPU::CreateStaticHandle() {
   llvm::GlobalVariable* gv =
       new llvm::GlobalVariable(*module_, t_void_p_, false, llvm::GlobalValue::PrivateLinkage,
@@ -1415,6 +1457,10 @@ llvm::Value* CodeGenCPU::CreateIntrinsic(const CallNode* op) {
     return CreateCallPacked(op, false /* use_string_lookup */);
   } else if (op->op.same_as(builtin::tvm_static_handle())) {
     return CreateStaticHandle();
+  } else if (op->op.same_as(builtin::start_profile_intrinsic())) {
+    return CreateProfileEvent(op, false);
+  } else if (op->op.same_as(builtin::end_profile_intrinsic())) {
+    return CreateProfileEvent(op, true);
   } else if (op->op.same_as(builtin::tvm_throw_last_error())) {
     builder_->CreateRet(ConstInt32(-1));
     auto next_block = std::next(builder_->GetInsertBlock()->getIterator());
@@ -155,6 +155,8 @@ class CodeGenCPU : public CodeGenLLVM {
   llvm::Value* CreateCallPacked(const CallNode* op, bool use_string_lookup);
   // Create trace call into tvm packed function.
   llvm::Value* CreateCallTracePacked(const CallNode* op);
+  // Record the start or the end of a region instrumented for profiling.
+  llvm::Value* CreateProfileEvent(const CallNode* op, bool is_end);
   // Create static initialization
   void CreateStaticInit(const std::string& init_fname, const Stmt& body);
   // Create parallel launch
@@ -177,6 +177,9 @@ void CodeGenLLVM::InitTarget() {
       native_vector_bits_ = 256;
     } else if (arch == llvm::Triple::arm || arch == llvm::Triple::aarch64) {
       native_vector_bits_ = 128;
+    } else if (arch == llvm::Triple::wasm32 || arch == llvm::Triple::wasm64) {
+      // simd128
+      native_vector_bits_ = 128;
     } else {
       native_vector_bits_ = 128;
       std::string arch_name = std::string(tm->getTargetTriple().getArchName());
@@ -235,6 +238,7 @@ void CodeGenLLVM::AddFunction(const GlobalVar& gvar, const PrimFunc& f) {
 void CodeGenLLVM::InitFuncState() {
   var_map_.clear();
   alias_var_set_.clear();
+  alias_scope_md_.clear();
   alloc_storage_info_.clear();
   volatile_buf_.clear();
   analyzer_.reset(new arith::Analyzer());
@@ -318,6 +322,9 @@ void CodeGenLLVM::AddFunctionInternal(const GlobalVar& gvar, const PrimFunc& f,
       }
     }
   }
+  if (is_restricted_) {
+    InitAliasScopes(f);
+  }
   llvm::LLVMContext* ctx = llvm_target_->GetContext();
   llvm::BasicBlock* entry = llvm::BasicBlock::Create(*ctx, "entry", function_);
   builder_->SetInsertPoint(entry);
@@ -612,6 +619,10 @@ llvm::Type* CodeGenLLVM::GetLLVMType(const PrimExpr& expr) const {
 //
 void CodeGenLLVM::AddAliasInfo(llvm::Instruction* inst, const VarNode* buffer_var, PrimExpr index,
                                DataType access_dtype) {
+  if (auto it = alias_scope_md_.find(buffer_var); it != alias_scope_md_.end()) {
+    inst->setMetadata(llvm::LLVMContext::MD_alias_scope, it->second.first);
+    inst->setMetadata(llvm::LLVMContext::MD_noalias, it->second.second);
+  }
   if (alias_var_set_.count(buffer_var) != 0) {
     // Mark all possibly aliased pointer as same type.
     llvm::MDNode* meta = md_tbaa_alias_set_;
@@ -665,6 +676,69 @@ void CodeGenLLVM::AddAliasInfo(llvm::Instruction* inst, const VarNode* buffer_va
   inst->setMetadata("tbaa", md_builder_->createTBAAStructTagNode(meta, meta, 0));
 }
 
+// Add scoped alias information for the buffers of a restricted function
+//
+// The noalias attribute only applies to the pointer parameters, while the buffer pointers of a
+// packed function are loaded from its argument array. Each pointer that is known to be distinct,
+// i.e. a pointer parameter, a data pointer unpacked from a DLTensor argument or an allocation,
+// gets its own alias scope, and its accesses are declared to not alias the other scopes.
+//
+void CodeGenLLVM::InitAliasScopes(const PrimFunc& f) {
+  std::unordered_set<const VarNode*> distinct_vars;
+  for (const Var& param : f->params) {
+    if (param.dtype().is_handle()) {
+      distinct_vars.insert(param.get());
+    }
+  }
+  std::vector<const VarNode*> accessed_vars;
+  std::unordered_set<const VarNode*> visited;
+  auto f_access = [&](const VarNode* var) {
+    if (visited.insert(var).second) {
+      accessed_vars.push_back(var);
+    }
+  };
+  tir::PostOrderVisit(f->body, [&](const ObjectRef& node) {
+    if (const auto* let = node.as<LetStmtNode>()) {
+      const auto* call = let->value.as<CallNode>();
+      if (call != nullptr && call->op.same_as(builtin::tvm_struct_get()) &&
+          Downcast<IntImm>(call->args[2])->value == builtin::kArrData) {
+        distinct_vars.insert(let->var.get());
+      }
+    } else if (const auto* alloc = node.as<AllocateNode>()) {
+      distinct_vars.insert(alloc->buffer_var.get());
+    } else if (const auto* load = node.as<BufferLoadNode>()) {
+      f_access(load->buffer->data.get());
+    } else if (const auto* store = node.as<BufferStoreNode>()) {
+      f_access(store->buffer->data.get());
+    }
+  });
+  std::vector<const VarNode*> vars;
+  for (const VarNode* var : accessed_vars) {
+    if (distinct_vars.count(var) && !alias_var_set_.count(var)) {
+      vars.push_back(var);
+    }
+  }
+  if (vars.size() < 2) {
+    return;
+  }
+  llvm::LLVMContext* ctx = llvm_target_->GetContext();
+  llvm::MDNode* domain = md_builder_->createAnonymousAliasScopeDomain(function_->getName());
+  std::vector<llvm::MDNode*> scopes;
+  for (const VarNode* var : vars) {
+    scopes.push_back(md_builder_->createAnonymousAliasScope(domain, var->name_hint.c_str()));
+  }
+  for (size_t i = 0; i < vars.size(); ++i) {
+    std::vector<llvm::Metadata*> others;
+    for (size_t j = 0; j < vars.size(); ++j) {
+      if (j != i) {
+        others.push_back(scopes[j]);
+      }
+    }
+    alias_scope_md_[vars[i]] = {llvm::MDNode::get(*ctx, {scopes[i]}),
+                                llvm::MDNode::get(*ctx, others)};
+  }
+}
+
 void CodeGenLLVM::GetAlignment(DataType t, const VarNode* buf_var, const PrimExpr& index,
                                int* p_alignment, int* p_native_bits) {
   int max_align_bits = t.bits();
@@ -845,7 +919,8 @@ llvm::Value* CodeGenLLVM::CreateVecConcat(std::vector<llvm::Value*> vecs) {
 }
 
 void CodeGenLLVM::CreateSerialFor(llvm::Value* begin, llvm::Value* end, llvm::Value* stride,
-                                  const Var& loop_var, const Stmt& body) {
+                                  const Var& loop_var, const Stmt& body,
+                                  llvm::ArrayRef<llvm::Metadata*> loop_properties) {
   EmitDebugLocation(body->span);
   llvm::BasicBlock* pre_block = builder_->GetInsertBlock();
   std::string loop_var_name = loop_var->name_hint;
@@ -867,10 +942,113 @@ void CodeGenLLVM::CreateSerialFor(llvm::Value* begin, llvm::Value* end, llvm::Va
   var_map_.erase(loop_var.get());
   llvm::Value* loop_next = CreateAdd(loop_var.dtype(), loop_value, stride);
   loop_value->addIncoming(loop_next, builder_->GetInsertBlock());
-  builder_->CreateBr(for_begin);
+  llvm::BranchInst* backedge = builder_->CreateBr(for_begin);
+  if (!loop_properties.empty()) {
+    // The loop id is a distinct node whose first operand refers to itself
+    std::vector<llvm::Metadata*> operands{nullptr};
+    operands.insert(operands.end(), loop_properties.begin(), loop_properties.end());
+    llvm::MDNode* loop_id = llvm::MDNode::getDistinct(*ctx, operands);
+    loop_id->replaceOperandWith(0, loop_id);
+    backedge->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
+  }
   builder_->SetInsertPoint(for_end);
 }
 
+Stmt CodeGenLLVM::InjectLoopPrefetch(const ForNode* op, int64_t distance) {
+  // The addresses to prefetch cannot depend on the vars defined in the loop body
+  std::unordered_set<const VarNode*> body_vars;
+  Map<Var, PrimExpr> body_loop_mins;
+  std::vector<BufferLoad> loads;
+  tir::PostOrderVisit(op->body, [&](const ObjectRef& node) {
+    if (const auto* loop = node.as<ForNode>()) {
+      body_vars.insert(loop->loop_var.get());
+      body_loop_mins.Set(loop->loop_var, loop->min);
+    } else if (const auto* let = node.as<LetStmtNode>()) {
+      body_vars.insert(let->var.get());
+    } else if (const auto* let = node.as<LetNode>()) {
+      body_vars.insert(let->var.get());
+    } else if (const auto* alloc = node.as<AllocateNode>()) {
+      body_vars.insert(alloc->buffer_var.get());
+    } else if (const auto* load = node.as<BufferLoadNode>()) {
+      loads.push_back(GetRef<BufferLoad>(load));
+    }
+  });
+  auto f_use_vars = [&](const PrimExpr& expr, bool* use_loop_var, bool* use_body_var) {
+    tir::PostOrderVisit(expr, [&](const ObjectRef& node) {
+      if (const auto* var = node.as<VarNode>()) {
+        *use_loop_var |= var == op->loop_var.get();
+        *use_body_var |= body_vars.count(var) != 0;
+      }
+    });
+  };
+  PrimExpr ahead = op->loop_var + make_const(op->loop_var.dtype(), distance);
+  // The offsets of a gather are really loaded ahead, so they must stay within the loop
+  PrimExpr last = op->min + op->extent - make_const(op->extent.dtype(), 1);
+  std::vector<PrimExpr> addresses;
+  std::vector<Stmt> seq;
+  for (const BufferLoad& load : loads) {
+    if (load->indices.size() != 1 || body_vars.count(load->buffer->data.get())) {
+      continue;
+    }
+    PrimExpr index = load->indices[0];
+    if (const auto* ramp = index.as<RampNode>()) {
+      index = ramp->base;
+    }
+    if (index.dtype().lanes() != 1) {
+      continue;
+    }
+    std::vector<BufferLoad> offsets;
+    tir::PostOrderVisit(index, [&](const ObjectRef& node) {
+      if (const auto* offset = node.as<BufferLoadNode>()) {
+        offsets.push_back(GetRef<BufferLoad>(offset));
+      }
+    });
+    bool use_loop_var = false;
+    bool use_body_var = false;
+    if (offsets.empty()) {
+      // Only the strided streams that move with the loop and whose addresses are known at the
+      // start of each iteration are prefetched
+      f_use_vars(index, &use_loop_var, &use_body_var);
+      if (!use_loop_var || use_body_var) {
+        continue;
+      }
+      index = Substitute(index, Map<Var, PrimExpr>{{op->loop_var, ahead}});
+    } else {
+      // Gathers are prefetched when their offsets are read from streams that move with the
+      // loop. The inner loops of the body are prefetched from their first iteration.
+      for (const BufferLoad& offset : offsets) {
+        use_body_var |= body_vars.count(offset->buffer->data.get()) != 0;
+        for (const PrimExpr& offset_index : offset->indices) {
+          f_use_vars(offset_index, &use_loop_var, &use_body_var);
+        }
+      }
+      if (!use_loop_var || use_body_var) {
+        continue;
+      }
+      index = Substitute(index, body_loop_mins);
+      bool unused = false;
+      f_use_vars(index, &unused, &use_body_var);
+      if (use_body_var) {
+        continue;
+      }
+      index = Substitute(index, Map<Var, PrimExpr>{{op->loop_var, tvm::min(ahead, last)}});
+    }
+    PrimExpr address =
+        Call(DataType::Handle(), builtin::address_of(), {BufferLoad(load->buffer, {index})});
+    if (std::any_of(addresses.begin(), addresses.end(),
+                    [&](const PrimExpr& other) { return deep_equal_(address, other); })) {
+      continue;
+    }
+    addresses.push_back(address);
+    seq.push_back(Evaluate(Call(load->buffer->dtype, builtin::prefetch(), {address, 0, 3, 1})));
+  }
+  if (seq.empty()) {
+    return op->body;
+  }
+  seq.push_back(op->body);
+  return SeqStmt(seq);
+}
+
 // cast operatpr
 llvm::Value* CodeGenLLVM::CreateCast(DataType from, DataType to, llvm::Value* value) {
   llvm::Type* target = DTypeToLLVMType(to);
@@ -1339,6 +1517,17 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
       }
     }
 
+    // The element types of some intrinsics have no TIR counterpart, e.g. the bfloat operands of
+    // llvm.x86.avx512bf16.dpbf16ps, which TIR passes as integers of the same width.
+    llvm::FunctionType* ftype = f->getFunctionType();
+    for (size_t i = 0; i < arg_value.size() && i < ftype->getNumParams(); ++i) {
+      llvm::Type* param_type = ftype->getParamType(i);
+      llvm::Type* value_type = arg_value[i]->getType();
+      if (param_type != value_type && param_type->isVectorTy() && value_type->isVectorTy() &&
+          param_type->getPrimitiveSizeInBits() == value_type->getPrimitiveSizeInBits()) {
+        arg_value[i] = builder_->CreateBitCast(arg_value[i], param_type);
+      }
+    }
     return builder_->CreateCall(f, arg_value);
   } else if (op->op.same_as(builtin::bitwise_and())) {
     return builder_->CreateAnd(MakeValue(op->args[0]), MakeValue(op->args[1]));
@@ -1730,8 +1919,24 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const BufferLoadNode* op) {
 
   std::vector<llvm::Value*> loads;
 
-  auto make_load = [this, &loads](TypedPointer buffer_ptr, int /* subelement_i */, int alignment,
-                                  bool is_volatile) {
+  llvm::Value* predicate = op->predicate ? MakeValue(op->predicate.value()) : nullptr;
+  auto make_load = [this, &loads, predicate](TypedPointer buffer_ptr, int subelement_i,
+                                             int alignment,
+                                             bool is_volatile) -> llvm::Instruction* {
+    if (predicate != nullptr) {
+      ICHECK_EQ(subelement_i, -1) << "Predicated loads must access contiguous elements";
+#if TVM_LLVM_VERSION >= 130
+      auto load = builder_->CreateMaskedLoad(buffer_ptr.type, buffer_ptr.addr,
+                                             llvm::Align(alignment), predicate);
+#elif TVM_LLVM_VERSION >= 110
+      auto load = builder_->CreateMaskedLoad(buffer_ptr.addr, llvm::Align(alignment), predicate);
+#else
+      LOG(FATAL) << "Predicated loads require LLVM 11 or later";
+      llvm::Instruction* load = nullptr;
+#endif
+      loads.push_back(load);
+      return load;
+    }
 #if TVM_LLVM_VERSION >= 110
     auto load = builder_->CreateAlignedLoad(buffer_ptr.type, buffer_ptr.addr,
                                             llvm::Align(alignment), is_volatile);
@@ -1840,9 +2045,20 @@ void CodeGenLLVM::VisitStmt_(const BufferStoreNode* op) {
   Var buffer_var = op->buffer->data;
 
   llvm::Value* value = MakeValue(op->value);
+  llvm::Value* predicate = op->predicate ? MakeValue(op->predicate.value()) : nullptr;
 
-  auto make_store = [this, value](TypedPointer buffer_ptr, int subelement_i, int alignment,
-                                  bool is_volatile) {
+  auto make_store = [this, value, predicate](TypedPointer buffer_ptr, int subelement_i,
+                                             int alignment,
+                                             bool is_volatile) -> llvm::Instruction* {
+    if (predicate != nullptr) {
+      ICHECK_EQ(subelement_i, -1) << "Predicated stores must access contiguous elements";
+#if TVM_LLVM_VERSION >= 110
+      return builder_->CreateMaskedStore(value, buffer_ptr.addr, llvm::Align(alignment), predicate);
+#else
+      LOG(FATAL) << "Predicated stores require LLVM 11 or later";
+      return nullptr;
+#endif
+    }
     llvm::Value* to_store = value;
     if (subelement_i != -1) {
       to_store = builder_->CreateExtractElement(value, subelement_i);
@@ -1865,14 +2081,47 @@ void CodeGenLLVM::VisitStmt_(const ForNode* op) {
   EmitDebugLocation(op);
   ICHECK(is_zero(op->min));
   analyzer_->Bind(op->loop_var, Range::FromMinExtent(op->min, op->extent));
+  ICHECK(op->kind == ForKind::kSerial || op->kind == ForKind::kUnrolled);
+  llvm::LLVMContext* ctx = llvm_target_->GetContext();
+  std::vector<llvm::Metadata*> loop_properties;
+  auto f_add_property = [&](const char* name, llvm::Metadata* value) {
+    std::vector<llvm::Metadata*> operands{llvm::MDString::get(*ctx, name)};
+    if (value != nullptr) {
+      operands.push_back(value);
+    }
+    loop_properties.push_back(llvm::MDNode::get(*ctx, operands));
+  };
+  auto f_int_value = [&](const ObjectRef& value) -> llvm::Metadata* {
+    return llvm::ConstantAsMetadata::get(
+        llvm::ConstantInt::get(t_int32_, Downcast<Integer>(value)->value));
+  };
   if (op->kind == ForKind::kUnrolled) {
-    LOG(WARNING) << "Unroll hint get ignore at CodeGenLLVM backend, "
-                 << " consider set unroll_explicit=True";
-  } else {
-    ICHECK(op->kind == ForKind::kSerial);
+    f_add_property("llvm.loop.unroll.full", nullptr);
+  }
+  auto width = op->annotations.Get(attr::llvm_loop_vectorize_width);
+  auto scalable = op->annotations.Get(attr::llvm_loop_vectorize_scalable);
+  if (width || scalable) {
+    f_add_property("llvm.loop.vectorize.enable",
+                   llvm::ConstantAsMetadata::get(llvm::ConstantInt::getTrue(*ctx)));
+  }
+  if (width) {
+    f_add_property("llvm.loop.vectorize.width", f_int_value(width.value()));
+  }
+  if (scalable) {
+    f_add_property("llvm.loop.vectorize.scalable.enable",
+                   llvm::ConstantAsMetadata::get(
+                       llvm::ConstantInt::getBool(*ctx, Downcast<Integer>(scalable.value())->value)));
+  }
+  if (auto count = op->annotations.Get(attr::llvm_loop_unroll_count)) {
+    f_add_property("llvm.loop.unroll.count", f_int_value(count.value()));
+  }
+  Stmt body = op->body;
+  if (auto distance = op->annotations.Get(attr::llvm_loop_prefetch_distance)) {
+    body = InjectLoopPrefetch(op, Downcast<Integer>(distance.value())->value);
   }
   CreateSerialFor(MakeValue(op->min), MakeValue(op->extent),
-                  llvm::ConstantInt::getSigned(GetLLVMType(op->extent), 1), op->loop_var, op->body);
+                  llvm::ConstantInt::getSigned(GetLLVMType(op->extent), 1), op->loop_var, body,
+                  loop_properties);
 }
 
 void CodeGenLLVM::VisitStmt_(const WhileNode* op) {
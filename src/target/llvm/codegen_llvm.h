@@ -476,12 +476,18 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   llvm::Value* CreateVecFlip(llvm::Value* vec);
   llvm::Value* CreateVecConcat(std::vector<llvm::Value*> vecs);
   llvm::Value* CreateVecPad(llvm::Value* vec, int target_lanes);
-  // Create serial for
+  // Create serial for, with the llvm.loop properties attached to its backedge
   void CreateSerialFor(llvm::Value* begin, llvm::Value* end, llvm::Value* stride,
-                       const Var& loop_var, const Stmt& body);
+                       const Var& loop_var, const Stmt& body,
+                       llvm::ArrayRef<llvm::Metadata*> loop_properties = {});
+  // Insert the software prefetches of the strided and gathered loads of a loop, `distance`
+  // iterations ahead
+  Stmt InjectLoopPrefetch(const ForNode* op, int64_t distance);
   // add alias information.
   void AddAliasInfo(llvm::Instruction* inst, const VarNode* buffer_var, PrimExpr index,
                     DataType access_dtype);
+  // Create the scoped alias metadata of the disjoint buffers of a restricted function
+  void InitAliasScopes(const PrimFunc& f);
 
   llvm::GlobalVariable* AllocateSharedMemory(DataType dtype, size_t size,
                                              unsigned int shared_address_space, int alignment,
@@ -556,6 +562,8 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   std::unique_ptr<arith::Analyzer> analyzer_;
   // set of var that are not restricted(can alias)
   std::unordered_set<const VarNode*> alias_var_set_;
+  // The alias.scope and noalias metadata of the disjoint buffers in a restricted function
+  std::unordered_map<const VarNode*, std::pair<llvm::MDNode*, llvm::MDNode*>> alias_scope_md_;
   // set of volatile buffer.
   std::unordered_set<const VarNode*> volatile_buf_;
   // deep comparison of PrimExpr
@@ -27,7 +27,7 @@
 #include <tvm/runtime/ndarray.h>
 
 namespace llvm {
-class ConstantArray;
+class Constant;
 class LLVMContext;
 }  // namespace llvm
 
@@ -37,13 +37,15 @@ namespace codegen {
 /*!
  * \brief Convert an NDArray to an LLVM array of constants.
  *
- * The supplied NDArray is flattened, and each element is converted to the appropriate LLVM type.
+ * The supplied NDArray is flattened into a ConstantDataArray of the appropriate LLVM element
+ * type, which holds the raw bytes of the array instead of one LLVM constant per element, so that
+ * the cost of embedding large parameters stays that of copying their data.
  *
  * \param ctx LLVM context used to create the various primitive datatypes.
  * \param arr NDArray to convert.
  * \return LLVM array containing the array data.
  */
-llvm::ConstantArray* NDArrayToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
+llvm::Constant* NDArrayToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
 
 }  // namespace codegen
 }  // namespace tvm
@@ -24,6 +24,11 @@
 #include <dmlc/base.h>
 #include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/StringRef.h>
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/TargetParser/Triple.h>
+#else
+#include <llvm/ADT/Triple.h>
+#endif
 #if TVM_LLVM_VERSION >= 150
 #include <llvm/IR/FMF.h>
 #else
@@ -56,6 +61,7 @@
 #include <tvm/runtime/object.h>
 #include <tvm/target/target.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cctype>
 #include <memory>
@@ -73,6 +79,11 @@ namespace {
 namespace defaults {
 static const char* cpu = "generic";
 static const llvm::CodeGenOpt::Level opt_level = llvm::CodeGenOpt::Aggressive;
+#if TVM_LLVM_VERSION >= 130
+static const char* jit = "orcjit";
+#else
+static const char* jit = "mcjit";
+#endif
 }  // namespace defaults
 }  // namespace
 
@@ -175,6 +186,15 @@ LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& instance, const Target& target) {
       attrs_.push_back(s);
     }
   }
+  // Vectorize to wasm SIMD128 by default, which all the major browsers support.
+  // It can be turned off with -mattr=-simd128.
+  llvm::Triple::ArchType arch = llvm::Triple(triple_).getArch();
+  if ((arch == llvm::Triple::wasm32 || arch == llvm::Triple::wasm64) &&
+      std::none_of(attrs_.begin(), attrs_.end(), [](const std::string& attr) {
+        return attr == "+simd128" || attr == "-simd128";
+      })) {
+    attrs_.push_back("+simd128");
+  }
 
   if (const Optional<Array<String>>& v = target->GetAttr<Array<String>>("cl-opt")) {
     llvm::StringMap<llvm::cl::Option*>& options = llvm::cl::getRegisteredOptions();
@@ -244,6 +264,18 @@ LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& instance, const Target& target) {
 
   target_options_.UseInitArray = true;
 
+  jit_engine_ = target->GetAttr<String>("jit").value_or(defaults::jit);
+  if (jit_engine_ != "mcjit" && jit_engine_ != "orcjit") {
+    LOG(FATAL) << "ValueError: invalid -jit option " << jit_engine_
+               << ", should be \"mcjit\" or \"orcjit\"";
+  }
+#if TVM_LLVM_VERSION < 130
+  if (jit_engine_ == "orcjit") {
+    LOG(WARNING) << "ORC JIT requires LLVM 13 or later, using MCJIT instead";
+    jit_engine_ = "mcjit";
+  }
+#endif
+
   // Fast math options
 
   auto GetBoolFlag = [&target](llvm::StringRef flag) -> bool {
@@ -380,6 +412,10 @@ std::string LLVMTargetInfo::str() const {
     }
   }
 
+  if (jit_engine_ != defaults::jit) {
+    os << " -jit=" << jit_engine_;
+  }
+
   if (size_t num = llvm_options_.size(); num > 0) {
     os << " -cl-opt=";
     std::vector<std::string> opts;
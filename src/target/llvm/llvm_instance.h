@@ -217,6 +217,11 @@ class LLVMTargetInfo {
    * \return optimization level for this target
    */
   llvm::CodeGenOpt::Level GetOptLevel() const { return opt_level_; }
+  /*!
+   * \brief Get the JIT engine that runs the modules built for this target
+   * \return "orcjit" for the lazily compiling ORC LLJIT, or "mcjit" for MCJIT
+   */
+  const std::string& GetJITEngine() const { return jit_engine_; }
 
   /*!
    * \class Option
@@ -283,6 +288,7 @@ class LLVMTargetInfo {
   llvm::TargetOptions target_options_;
   llvm::FastMathFlags fast_math_flags_;
   llvm::CodeGenOpt::Level opt_level_;
+  std::string jit_engine_;
   llvm::Reloc::Model reloc_model_ = llvm::Reloc::PIC_;
   llvm::CodeModel::Model code_model_ = llvm::CodeModel::Small;
   std::shared_ptr<llvm::TargetMachine> target_machine_;
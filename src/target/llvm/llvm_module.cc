@@ -31,6 +31,14 @@
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/MCJIT.h>  // Force linking of MCJIT
+#if TVM_LLVM_VERSION >= 130
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#endif
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Intrinsics.h>
@@ -40,13 +48,19 @@
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Process.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <tvm/ir/module.h>
+#include <tvm/node/serialization.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/ir/transform.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/string.h>
@@ -56,21 +70,28 @@
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/support/with.h>
 #include <tvm/target/codegen.h>
 #include <tvm/target/target.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "../../runtime/file_utils.h"
 #include "../../runtime/library_module.h"
+#include "../../support/utils.h"
 #include "../func_registry_generator.h"
 #include "codegen_blob.h"
 #include "codegen_cpu.h"
@@ -103,16 +124,39 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::string GetSource(const std::string& format) final;
 
   void Init(const IRModule& mod, const Target& target);
+  /*!
+   * \brief Initialize from the PrimFuncs of mod, each compiled into an LLVM module of its
+   *  own and linked together.
+   *
+   * The optimized bitcode of every PrimFunc is stored in cache_dir, keyed by the structural
+   * hash of the function and the compilation context, and reused by later builds, in this
+   * process or another one, instead of compiling the function again.
+   * \param mod The module to compile.
+   * \param target The target to compile for.
+   * \param cache_dir The directory holding the cache.
+   */
+  void InitCached(const IRModule& mod, const Target& target, const std::string& cache_dir);
   void Init(std::unique_ptr<llvm::Module> module, std::unique_ptr<LLVMInstance> llvm_instance);
   void LoadIR(const std::string& file_name);
+  /*!
+   * \brief Attach a module holding another codegen partition of the same IRModule.
+   *  The partition is imported by this module, which also resolves its functions.
+   * \param partition The module of the partition.
+   */
+  void AddPartition(ObjectPtr<LLVMModuleNode> partition);
 
   bool ImplementsFunction(const String& name, bool query_imports) final;
 
  private:
   void LazyInitJIT();
+  void InitMCJIT(const LLVMTarget& llvm_target);
+#if TVM_LLVM_VERSION >= 130
+  void InitORCJIT(const LLVMTarget& llvm_target);
+#endif
   bool IsCompatibleWithHost(const llvm::TargetMachine* tm) const;
   void* GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const;
   void* GetFunctionAddr(const std::string& name, const LLVMTarget& llvm_target) const;
+  void* LookupJITSymbol(const std::string& name, bool is_function = false) const;
 
   // The LLVM scope object.
   std::unique_ptr<LLVMInstance> llvm_instance_;
@@ -120,6 +164,12 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::mutex mutex_;
   // execution engine
   llvm::ExecutionEngine* ee_{nullptr};
+#if TVM_LLVM_VERSION >= 130
+  // The ORC JIT compiling the functions of a copy of the module on their first call
+  std::unique_ptr<llvm::orc::LLLazyJIT> lazy_jit_;
+#endif
+  // Whether the JIT engine has been initialized
+  bool jit_initialized_{false};
   // The raw pointer to the module.
   llvm::Module* module_{nullptr};
   // The unique_ptr owning the module. This becomes empty once JIT has been initialized
@@ -127,6 +177,10 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::unique_ptr<llvm::Module> module_owning_ptr_;
   /* \brief names of the external functions declared in this module */
   Array<String> function_names_;
+  /* \brief the other codegen partitions, when this module holds the first one */
+  std::vector<runtime::Module> partitions_;
+  /* \brief the module holding the first partition, when this module holds another one */
+  LLVMModuleNode* parent_{nullptr};
 };
 
 LLVMModuleNode::~LLVMModuleNode() {
@@ -134,6 +188,15 @@ LLVMModuleNode::~LLVMModuleNode() {
     ee_->runStaticConstructorsDestructors(true);
     delete ee_;
   }
+#if TVM_LLVM_VERSION >= 130
+  if (lazy_jit_ != nullptr) {
+    if (auto err = lazy_jit_->deinitialize(lazy_jit_->getMainJITDylib())) {
+      LOG(WARNING) << "Failed to run the static destructors of the JIT module: "
+                   << llvm::toString(std::move(err));
+    }
+    lazy_jit_.reset();
+  }
+#endif
   module_owning_ptr_.reset();
 }
 
@@ -162,7 +225,7 @@ PackedFunc LLVMModuleNode::GetFunction(const std::string& name,
     std::string target_string = LLVMTarget::GetTargetMetadata(*module_);
     return PackedFunc([target_string](TVMArgs args, TVMRetValue* rv) { *rv = target_string; });
   }
-  if (ee_ == nullptr) LazyInitJIT();
+  if (!jit_initialized_) LazyInitJIT();
 
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -177,7 +240,18 @@ PackedFunc LLVMModuleNode::GetFunction(const std::string& name,
   } else {
     faddr = reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(name, *llvm_target));
   }
-  if (faddr == nullptr) return PackedFunc();
+  if (faddr == nullptr) {
+    for (runtime::Module& partition : partitions_) {
+      PackedFunc pf = partition.GetFunction(name);
+      if (pf != nullptr) {
+        // Keep this module, which the partition's module context points to, alive as well.
+        return PackedFunc([pf, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
+          pf.CallPacked(args, rv);
+        });
+      }
+    }
+    return PackedFunc();
+  }
   return WrapPackedFunc(faddr, sptr_to_self);
 }
 
@@ -277,6 +351,15 @@ std::string LLVMModuleNode::GetSource(const std::string& format) {
 #endif
     pass.run(*m);
     return rso.str().str();
+  } else if (fmt == "bc") {
+    std::string bitcode;
+    llvm::raw_string_ostream rso(bitcode);
+#if TVM_LLVM_VERSION <= 60
+    llvm::WriteBitcodeToFile(module_, rso);
+#else
+    llvm::WriteBitcodeToFile(*module_, rso);
+#endif
+    return rso.str();
   } else if (fmt == "" || fmt == "ll") {
     std::string type_str;
     llvm::raw_string_ostream rso(type_str);
@@ -355,6 +438,83 @@ void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
   }
 }
 
+void LLVMModuleNode::InitCached(const IRModule& mod, const Target& target,
+                                const std::string& cache_dir) {
+  llvm::sys::fs::create_directories(cache_dir);
+  // Everything but the function itself that affects the generated code.
+  std::ostringstream context;
+  context << TVM_VERSION << ";" << TVM_LLVM_VERSION << ";" << target->str();
+  uint64_t context_hash =
+      support::HashCombine(StructuralHash()(String(context.str())), StructuralHash()(mod->attrs));
+
+  struct Entry {
+    GlobalVar gvar;
+    PrimFunc func;
+    std::string path;
+    std::string bitcode;
+  };
+  std::vector<Entry> entries;
+  std::vector<size_t> misses;
+  for (auto kv : mod->functions) {
+    if (!kv.second->IsInstance<PrimFuncNode>()) continue;
+    auto f = Downcast<PrimFunc>(kv.second);
+    if (auto global_symbol = f->GetAttr<String>(tvm::attr::kGlobalSymbol)) {
+      function_names_.push_back(global_symbol.value());
+    }
+    std::ostringstream path;
+    path << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0')
+         << support::HashCombine(context_hash, StructuralHash()(f));
+    Entry entry{kv.first, f, path.str(), ""};
+    // The stored function guards against hash collisions.
+    std::string json;
+    if (std::ifstream(entry.path + ".json").good() && std::ifstream(entry.path + ".bc").good()) {
+      runtime::LoadBinaryFromFile(entry.path + ".json", &json);
+    }
+    if (!json.empty() && StructuralEqual()(LoadJSON(json), f)) {
+      runtime::LoadBinaryFromFile(entry.path + ".bc", &entry.bitcode);
+    } else {
+      misses.push_back(entries.size());
+    }
+    entries.push_back(std::move(entry));
+  }
+  VLOG(1) << "reusing " << entries.size() - misses.size() << " of " << entries.size()
+          << " functions from " << cache_dir;
+
+  int num_threads = std::min<int>(misses.size(), std::thread::hardware_concurrency());
+  support::parallel_for_dynamic(0, misses.size(), std::max(num_threads, 1), [&](int, int index) {
+    Entry& entry = entries[misses[index]];
+    auto n = make_object<LLVMModuleNode>();
+    n->Init(IRModule({{entry.gvar, entry.func}}, {}, {}, {}, mod->attrs), target);
+    entry.bitcode = n->GetSource("bc");
+    // Write to unique names and rename, so that concurrent builds never see partial files.
+    std::ostringstream suffix;
+    suffix << ".tmp." << llvm::sys::Process::getProcessId() << "."
+           << std::this_thread::get_id();
+    auto save = [&suffix](const std::string& file_name, const std::string& data) {
+      runtime::SaveBinaryToFile(file_name + suffix.str(), data);
+      std::rename((file_name + suffix.str()).c_str(), file_name.c_str());
+    };
+    save(entry.path + ".bc", entry.bitcode);
+    save(entry.path + ".json", SaveJSON(entry.func));
+  });
+
+  llvm_instance_ = std::make_unique<LLVMInstance>();
+  for (Entry& entry : entries) {
+    std::unique_ptr<llvm::Module> module = llvm_instance_->ParseIR(entry.bitcode);
+    if (module_owning_ptr_ == nullptr) {
+      module_owning_ptr_ = std::move(module);
+    } else {
+      ICHECK(!llvm::Linker::linkModules(*module_owning_ptr_, std::move(module)))
+          << "Failed to link the module of " << entry.gvar->name_hint;
+    }
+  }
+  if (module_owning_ptr_ == nullptr) {
+    Init(mod, target);
+    return;
+  }
+  module_ = module_owning_ptr_.get();
+}
+
 void LLVMModuleNode::Init(std::unique_ptr<llvm::Module> module,
                           std::unique_ptr<LLVMInstance> llvm_instance) {
   module_owning_ptr_ = std::move(module);
@@ -368,22 +528,54 @@ void LLVMModuleNode::LoadIR(const std::string& file_name) {
   Init(std::move(module), std::move(llvm_instance));
 }
 
+void LLVMModuleNode::AddPartition(ObjectPtr<LLVMModuleNode> partition) {
+  partition->parent_ = this;
+  for (const String& name : partition->function_names_) {
+    function_names_.push_back(name);
+  }
+  runtime::Module mod(partition);
+  partitions_.push_back(mod);
+  Import(mod);
+}
+
 bool LLVMModuleNode::ImplementsFunction(const String& name, bool query_imports) {
   return std::find(function_names_.begin(), function_names_.end(), name) != function_names_.end();
 }
 
 void LLVMModuleNode::LazyInitJIT() {
   std::lock_guard<std::mutex> lock(mutex_);
-  if (ee_) {
+  if (jit_initialized_) {
     return;
   }
   With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+#if TVM_LLVM_VERSION >= 130
+  if (llvm_target->GetJITEngine() == "orcjit") {
+    InitORCJIT(*llvm_target);
+  } else {
+    InitMCJIT(*llvm_target);
+  }
+#else
+  InitMCJIT(*llvm_target);
+#endif
+  jit_initialized_ = true;
+
+  if (void** ctx_addr =
+          reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx, *llvm_target))) {
+    // Packed calls from the functions of a partition are resolved against the imports of
+    // the first partition, which is the module device modules get imported into.
+    *ctx_addr = parent_ != nullptr ? parent_ : this;
+  }
+  runtime::InitContextFunctions(
+      [this, &llvm_target](const char* name) { return GetGlobalAddr(name, *llvm_target); });
+}
+
+void LLVMModuleNode::InitMCJIT(const LLVMTarget& llvm_target) {
   llvm::EngineBuilder builder(std::move(module_owning_ptr_));
   builder.setEngineKind(llvm::EngineKind::JIT);
   builder.setOptLevel(llvm::CodeGenOpt::Aggressive);
-  builder.setMCPU(llvm_target->GetCPU());
-  builder.setMAttrs(llvm_target->GetTargetFeatures());
-  builder.setTargetOptions(llvm_target->GetTargetOptions());
+  builder.setMCPU(llvm_target.GetCPU());
+  builder.setMAttrs(llvm_target.GetTargetFeatures());
+  builder.setTargetOptions(llvm_target.GetTargetOptions());
   auto tm = std::unique_ptr<llvm::TargetMachine>(builder.selectTarget());
   if (!IsCompatibleWithHost(tm.get())) {
     LOG(FATAL) << "Cannot run module, architecture mismatch";
@@ -396,13 +588,6 @@ void LLVMModuleNode::LazyInitJIT() {
   ee_ = builder.create(tm.release());
   ICHECK(ee_ != nullptr) << "Failed to initialize jit engine for " << module_->getTargetTriple();
   ee_->runStaticConstructorsDestructors(false);
-
-  if (void** ctx_addr =
-          reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx, *llvm_target))) {
-    *ctx_addr = this;
-  }
-  runtime::InitContextFunctions(
-      [this, &llvm_target](const char* name) { return GetGlobalAddr(name, *llvm_target); });
   // There is a problem when a JITed function contains a call to a runtime function.
   // The runtime function (e.g. __truncsfhf2) may not be resolved, and calling it will
   // lead to a runtime crash.
@@ -411,6 +596,71 @@ void LLVMModuleNode::LazyInitJIT() {
   ee_->getFunctionAddress("__some_name_that_hopefully_doesnt_exist__b49f8aaade5877eaba7583b91");
 }
 
+#if TVM_LLVM_VERSION >= 130
+void LLVMModuleNode::InitORCJIT(const LLVMTarget& llvm_target) {
+  // The JIT compiles a copy of the module in a context of its own, from its compilation
+  // threads, while module_ stays available to GetSource and SaveToFile.
+  llvm::SmallString<0> bitcode;
+  {
+    llvm::raw_svector_ostream os(bitcode);
+    llvm::WriteBitcodeToFile(*module_, os);
+  }
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::Expected<std::unique_ptr<llvm::Module>> jit_module = llvm::parseBitcodeFile(
+      llvm::MemoryBufferRef(llvm::StringRef(bitcode.data(), bitcode.size()), "tvm_jit"),
+      *context);
+  ICHECK(jit_module) << "Failed to copy the module for the JIT: "
+                     << llvm::toString(jit_module.takeError());
+
+  llvm::orc::JITTargetMachineBuilder tm_builder((llvm::Triple(module_->getTargetTriple())));
+  tm_builder.setCPU(llvm_target.GetCPU());
+  tm_builder.addFeatures(std::vector<std::string>(llvm_target.GetTargetFeatures().begin(),
+                                                  llvm_target.GetTargetFeatures().end()));
+  tm_builder.setOptions(llvm_target.GetTargetOptions());
+  tm_builder.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+  auto tm = tm_builder.createTargetMachine();
+  ICHECK(tm) << "Failed to create the target machine of the JIT: "
+             << llvm::toString(tm.takeError());
+  if (!IsCompatibleWithHost(tm->get())) {
+    LOG(FATAL) << "Cannot run module, architecture mismatch";
+  }
+  llvm::DataLayout layout((*tm)->createDataLayout());
+  ICHECK(layout == module_->getDataLayout())
+      << "Data layout mismatch between module("
+      << module_->getDataLayout().getStringRepresentation() << ")"
+      << " and ORC JIT (" << layout.getStringRepresentation() << ")";
+
+  // Functions are compiled on their first call, each in a partition of its own, by a pool of
+  // compilation threads; the functions that are never called are never compiled.
+  unsigned num_threads = std::max(1U, std::min(8U, std::thread::hardware_concurrency()));
+  auto jit = llvm::orc::LLLazyJITBuilder()
+                 .setJITTargetMachineBuilder(std::move(tm_builder))
+                 .setNumCompileThreads(num_threads)
+                 .create();
+  ICHECK(jit) << "Failed to initialize ORC JIT for " << module_->getTargetTriple() << ": "
+              << llvm::toString(jit.takeError());
+  lazy_jit_ = std::move(jit.get());
+  lazy_jit_->setPartitionFunction(llvm::orc::CompileOnDemandLayer::compileRequested);
+
+  // Resolve the TVM runtime API and the libc functions called by the module in the process
+  llvm::orc::JITDylib& main_dylib = lazy_jit_->getMainJITDylib();
+  auto process_symbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+      layout.getGlobalPrefix());
+  ICHECK(process_symbols) << "Failed to resolve the symbols of the process: "
+                          << llvm::toString(process_symbols.takeError());
+  main_dylib.addGenerator(std::move(process_symbols.get()));
+
+  llvm::orc::ThreadSafeModule tsm(std::move(jit_module.get()), std::move(context));
+  if (auto err = lazy_jit_->addLazyIRModule(std::move(tsm))) {
+    LOG(FATAL) << "Failed to add the module to ORC JIT: " << llvm::toString(std::move(err));
+  }
+  if (auto err = lazy_jit_->initialize(main_dylib)) {
+    LOG(FATAL) << "Failed to run the static constructors of the JIT module: "
+               << llvm::toString(std::move(err));
+  }
+}
+#endif
+
 bool LLVMModuleNode::IsCompatibleWithHost(const llvm::TargetMachine* tm) const {
   LLVMTargetInfo host_target(*llvm_instance_, "llvm");
   auto tm_host = host_target.GetOrCreateTargetMachine();
@@ -426,7 +676,7 @@ bool LLVMModuleNode::IsCompatibleWithHost(const llvm::TargetMachine* tm) const {
 void* LLVMModuleNode::GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
   if (module_->getGlobalVariable(name) != nullptr) {
-    return reinterpret_cast<void*>(ee_->getGlobalValueAddress(name));
+    return LookupJITSymbol(name);
   } else {
     return nullptr;
   }
@@ -436,17 +686,139 @@ void* LLVMModuleNode::GetFunctionAddr(const std::string& name,
                                       const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
   if (module_->getFunction(name) != nullptr) {
-    return reinterpret_cast<void*>(ee_->getFunctionAddress(name));
+    return LookupJITSymbol(name, /*is_function=*/true);
   } else {
     return nullptr;
   }
 }
 
+void* LLVMModuleNode::LookupJITSymbol(const std::string& name, bool is_function) const {
+#if TVM_LLVM_VERSION >= 130
+  if (lazy_jit_ != nullptr) {
+    // A function resolves to its lazy call-through stub, which compiles it on its first call
+    auto symbol = lazy_jit_->lookup(name);
+    ICHECK(symbol) << "Failed to look up " << name << " in ORC JIT: "
+                   << llvm::toString(symbol.takeError());
+#if TVM_LLVM_VERSION >= 150
+    return symbol->toPtr<void*>();
+#else
+    return reinterpret_cast<void*>(symbol->getAddress());
+#endif
+  }
+#endif
+  if (is_function) {
+    return reinterpret_cast<void*>(ee_->getFunctionAddress(name));
+  }
+  return reinterpret_cast<void*>(ee_->getGlobalValueAddress(name));
+}
+
+/*!
+ * \brief Check whether the PrimFuncs of a module can be compiled into separate LLVM modules.
+ *
+ * This is not the case when they can not live in different objects (system library,
+ * C runtime, calls between PrimFuncs), or when the target changes global LLVM options,
+ * which would race between concurrent compilations.
+ */
+static bool CanCompileSeparately(const IRModule& mod, const Target& target) {
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  if (runtime->name == "crt" || runtime->GetAttr<Bool>("system-lib").value_or(Bool(false)) ||
+      mod->GetAttr<String>(tvm::attr::kSystemLibPrefix) ||
+      !target->GetAttr<Array<String>>("cl-opt").value_or({}).empty()) {
+    return false;
+  }
+  bool calls_global = false;
+  for (auto kv : mod->functions) {
+    if (!kv.second->IsInstance<PrimFuncNode>()) continue;
+    tir::PostOrderVisit(Downcast<PrimFunc>(kv.second)->body, [&](const ObjectRef& node) {
+      if (const auto* call = node.as<tir::CallNode>()) {
+        calls_global = calls_global || call->op->IsInstance<GlobalVarNode>();
+      }
+    });
+  }
+  return !calls_global;
+}
+
+/*!
+ * \brief Split the PrimFuncs of a module into at most num_partitions modules of similar size
+ *  that can be compiled independently.
+ *
+ * Modules that can not be compiled separately are kept whole. The partition holding the
+ * entry function, if any, comes first.
+ */
+static std::vector<IRModule> PartitionForCodegen(const IRModule& mod, const Target& target,
+                                                 int num_partitions) {
+  if (num_partitions <= 1 || !CanCompileSeparately(mod, target)) return {mod};
+
+  struct Entry {
+    GlobalVar gvar;
+    PrimFunc func;
+    size_t cost;
+  };
+  std::vector<Entry> entries;
+  for (auto kv : mod->functions) {
+    if (!kv.second->IsInstance<PrimFuncNode>()) continue;
+    PrimFunc func = Downcast<PrimFunc>(kv.second);
+    // The number of IR nodes is a cheap proxy for the codegen time of the function.
+    size_t cost = 0;
+    tir::PostOrderVisit(func->body, [&](const ObjectRef& node) { ++cost; });
+    entries.push_back({kv.first, func, cost});
+  }
+  if (entries.size() <= 1) return {mod};
+
+  // Greedily assign the most expensive remaining function to the lightest partition.
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.cost != b.cost ? a.cost > b.cost : a.gvar->name_hint < b.gvar->name_hint;
+  });
+  num_partitions = std::min<int>(num_partitions, entries.size());
+  std::vector<Map<GlobalVar, BaseFunc>> functions(num_partitions);
+  std::vector<size_t> loads(num_partitions, 0);
+  size_t entry_partition = 0;
+  for (const Entry& entry : entries) {
+    size_t index = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    functions[index].Set(entry.gvar, entry.func);
+    loads[index] += entry.cost;
+    if (entry.func->HasNonzeroAttr(tir::attr::kIsEntryFunc)) entry_partition = index;
+  }
+  std::swap(functions[0], functions[entry_partition]);
+
+  std::vector<IRModule> partitions;
+  for (auto& funcs : functions) {
+    partitions.push_back(IRModule(funcs, {}, {}, {}, mod->attrs));
+  }
+  return partitions;
+}
+
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.num_partitions", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.cache_dir", String);
+
 TVM_REGISTER_GLOBAL("target.build.llvm")
     .set_body_typed([](IRModule mod, Target target) -> runtime::Module {
-      auto n = make_object<LLVMModuleNode>();
-      n->Init(mod, target);
-      return runtime::Module(n);
+      int num_partitions = tvm::transform::PassContext::Current()
+                               ->GetConfig<Integer>("codegen.llvm.num_partitions", Integer(1))
+                               .value()
+                               .IntValue();
+      Optional<String> cache_dir = tvm::transform::PassContext::Current()->GetConfig<String>(
+          "codegen.llvm.cache_dir", Optional<String>());
+      if (cache_dir && CanCompileSeparately(mod, target)) {
+        auto n = make_object<LLVMModuleNode>();
+        n->InitCached(mod, target, cache_dir.value());
+        return runtime::Module(n);
+      }
+      std::vector<IRModule> partitions = PartitionForCodegen(mod, target, num_partitions);
+      // Every partition gets its own LLVMInstance, hence its own context, so they can be
+      // lowered, optimized and later emitted concurrently. The other partitions are
+      // imported by the first one and linked with it by export_library.
+      std::vector<ObjectPtr<LLVMModuleNode>> nodes(partitions.size());
+      support::parallel_for_dynamic(0, partitions.size(), partitions.size(),
+                                    [&](int thread_id, int index) {
+                                      nodes[index] = make_object<LLVMModuleNode>();
+                                      nodes[index]->Init(partitions[index], target);
+                                    });
+      for (size_t i = 1; i < nodes.size(); ++i) {
+        nodes[0]->AddPartition(nodes[i]);
+      }
+      return runtime::Module(nodes[0]);
     });
 
 TVM_REGISTER_GLOBAL("codegen.LLVMModuleCreate")
@@ -29,10 +29,20 @@
 #include <cuda_runtime.h>
 #include <nvrtc.h>
 
+#include <tvm/ir/transform.h>
+#include <tvm/node/structural_hash.h>
+
 #include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
 
 #include "../../runtime/cuda/cuda_common.h"
 #include "../../runtime/cuda/cuda_module.h"
+#include "../../runtime/file_utils.h"
+#include "../../support/utils.h"
 #include "../build_common.h"
 #include "../source/codegen_cuda.h"
 
@@ -78,21 +88,24 @@ std::string FindCUDAIncludePath() {
   return cuda_include_path;
 }
 
-std::string NVRTCCompile(const std::string& code, bool include_path = false) {
-  std::vector<std::string> compile_params;
-  std::vector<const char*> param_cstrings{};
-  nvrtcProgram prog;
-  std::string cc = "30";
+/*! \brief The compute capability of device 0 that NVRTC compiles for, e.g. "80". */
+std::string GetComputeCapability() {
   int major, minor;
   cudaError_t e1 = cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
   cudaError_t e2 = cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0);
-
   if (e1 == cudaSuccess && e2 == cudaSuccess) {
-    cc = std::to_string(major) + std::to_string(minor);
-  } else {
-    LOG(WARNING) << "cannot detect compute capability from your device, "
-                 << "fall back to compute_30.";
+    return std::to_string(major) + std::to_string(minor);
   }
+  LOG(WARNING) << "cannot detect compute capability from your device, "
+               << "fall back to compute_30.";
+  return "30";
+}
+
+std::string NVRTCCompile(const std::string& code, bool include_path = false) {
+  std::vector<std::string> compile_params;
+  std::vector<const char*> param_cstrings{};
+  nvrtcProgram prog;
+  std::string cc = GetComputeCapability();
 
   compile_params.push_back("-arch=compute_" + cc);
 
@@ -125,6 +138,65 @@ std::string NVRTCCompile(const std::string& code, bool include_path = false) {
   return ptx;
 }
 
+/*!
+ * \brief Content addressed on-disk cache of the compiled CUDA modules.
+ *
+ * The PTX or cubin of a module is stored in cache_dir, keyed by the hash of the CUDA source
+ * and of the compile context, i.e. the TVM version, the target, the compiler and its flags.
+ * The key and the source are stored next to the binary to guard against hash collisions.
+ */
+class CUDACompileCache {
+ public:
+  CUDACompileCache(const std::string& cache_dir, const std::string& context,
+                   const std::string& code)
+      : key_(context + "\n" + code) {
+#if defined(__linux__)
+    mkdir(cache_dir.c_str(), 0777);
+#endif
+    std::ostringstream path;
+    path << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0')
+         << support::HashCombine(StructuralHash()(String(context)), StructuralHash()(String(code)));
+    path_ = path.str();
+  }
+
+  /*! \brief Load the cached binary and its format, return whether it is found. */
+  bool Lookup(std::string* data, std::string* fmt) const {
+    std::string key;
+    if (std::ifstream(path_ + ".cu").good()) {
+      runtime::LoadBinaryFromFile(path_ + ".cu", &key);
+    }
+    if (key != key_) return false;
+    for (const char* ext : {"ptx", "cubin"}) {
+      if (std::ifstream(path_ + "." + ext).good()) {
+        runtime::LoadBinaryFromFile(path_ + "." + ext, data);
+        *fmt = ext;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*! \brief Store the compiled binary of the given format. */
+  void Store(const std::string& data, const std::string& fmt) const {
+    // Write to unique names and rename, so that concurrent builds never see partial files.
+    std::ostringstream suffix;
+    suffix << ".tmp." << std::hex << std::random_device()();
+    auto save = [&suffix](const std::string& file_name, const std::string& data) {
+      runtime::SaveBinaryToFile(file_name + suffix.str(), data);
+      std::rename((file_name + suffix.str()).c_str(), file_name.c_str());
+    };
+    // The binary goes first, the key only makes it visible to the lookups.
+    save(path_ + "." + fmt, data);
+    save(path_ + ".cu", key_);
+  }
+
+ private:
+  /*! \brief The compile context followed by the CUDA source. */
+  std::string key_;
+  /*! \brief The path of the entry without the extension. */
+  std::string path_;
+};
+
 runtime::Module BuildCUDA(IRModule mod, Target target) {
   using tvm::runtime::Registry;
   bool output_ssa = false;
@@ -149,19 +221,43 @@ runtime::Module BuildCUDA(IRModule mod, Target target) {
   std::string ptx;
   const auto* f_enter = Registry::Get("target.TargetEnterScope");
   (*f_enter)(target);
-  if (const auto* f = Registry::Get("tvm_callback_cuda_compile")) {
-    ptx = (*f)(code).operator std::string();
-    // Dirty matching to check PTX vs cubin.
-    // TODO(tqchen) more reliable checks
-    if (ptx[0] != '/') fmt = "cubin";
+  const auto* f_compile = Registry::Get("tvm_callback_cuda_compile");
+  Optional<String> cache_dir = tvm::transform::PassContext::Current()->GetConfig<String>(
+      "codegen.cuda.cache_dir", Optional<String>());
+  std::unique_ptr<CUDACompileCache> cache;
+  if (cache_dir) {
+    // Everything but the source itself that affects the compiled binary.
+    std::ostringstream context;
+    context << TVM_VERSION << ";" << target->str() << ";";
+    if (f_compile != nullptr) {
+      context << "tvm_callback_cuda_compile";
+    } else {
+      int major, minor;
+      NVRTC_CALL(nvrtcVersion(&major, &minor));
+      context << "nvrtc " << major << "." << minor << ";compute_" << GetComputeCapability() << ";"
+              << cg.need_include_path();
+    }
+    cache = std::make_unique<CUDACompileCache>(cache_dir.value(), context.str(), code);
+  }
+  if (cache != nullptr && cache->Lookup(&ptx, &fmt)) {
+    VLOG(1) << "reusing the " << fmt << " of the CUDA module from " << cache_dir.value();
   } else {
-    ptx = NVRTCCompile(code, cg.need_include_path());
+    if (f_compile != nullptr) {
+      ptx = (*f_compile)(code).operator std::string();
+      // Dirty matching to check PTX vs cubin.
+      // TODO(tqchen) more reliable checks
+      if (ptx[0] != '/') fmt = "cubin";
+    } else {
+      ptx = NVRTCCompile(code, cg.need_include_path());
+    }
+    if (cache != nullptr) cache->Store(ptx, fmt);
   }
   const auto* f_exit = Registry::Get("target.TargetExitScope");
   (*f_exit)(target);
   return CUDAModuleCreate(ptx, fmt, ExtractFuncInfo(mod), code);
 }
 
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.cuda.cache_dir", String);
 TVM_REGISTER_GLOBAL("target.build.cuda").set_body_typed(BuildCUDA);
 }  // namespace codegen
 }  // namespace tvm
@@ -112,7 +112,10 @@ static TargetFeatures GetFeatures(TargetJSON target) {
 
   const bool simd_flag = HasFlag(mcpu, mattr, "+neon") || HasFlag(mcpu, mattr, "+simd");
   const bool has_asimd = is_aarch64 || simd_flag;
+  // "+sve" also matches "+sve2", which implies SVE
   const bool has_sve = HasFlag(mcpu, mattr, "+sve");
+  const bool has_sve2 = is_aarch64 && HasFlag(mcpu, mattr, "+sve2");
+  const bool has_sme = is_aarch64 && HasFlag(mcpu, mattr, "+sme");
 
   const bool i8mm_flag = HasFlag(mcpu, mattr, "+i8mm");
   const bool i8mm_disable = HasFlag(mcpu, mattr, "+noi8mm");
@@ -129,7 +132,8 @@ static TargetFeatures GetFeatures(TargetJSON target) {
 
   return {
       {"is_aarch64", Bool(is_aarch64)},  {"has_asimd", Bool(has_asimd)},
-      {"has_sve", Bool(has_sve)},        {"has_dotprod", Bool(has_dotprod)},
+      {"has_sve", Bool(has_sve)},        {"has_sve2", Bool(has_sve2)},
+      {"has_sme", Bool(has_sme)},        {"has_dotprod", Bool(has_dotprod)},
       {"has_matmul_i8", Bool(has_i8mm)},
   };
 }
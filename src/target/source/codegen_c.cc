@@ -642,6 +642,32 @@ void CodeGenC::VisitStmt_(const AllocateConstNode* op) {
     num_elements *= dim;
   }
 
+  if (num_elements * data.DataType().bytes() >= kLargeConstantBytes) {
+    // C compilers parse a string literal of the bytes of a large constant much faster than a
+    // list of initializers. The constant is the typed member of a union with the bytes.
+    std::string storage_name = symbol_name + "_storage";
+    decl_stream << "\n"
+                << "#ifdef __cplusplus\n"
+                << "extern \"C\" {\n"
+                << "#endif\n"
+                << "static const union {\n"
+                << "  unsigned char bytes[" << num_elements * data.DataType().bytes() + 1 << "];\n"
+                << "  ";
+    PrintType(data.DataType(), decl_stream);
+    decl_stream << " data[" << num_elements << "];\n"
+                << "} __attribute__((section(\".rodata.tvm\"), "
+                << "aligned(" << constants_byte_alignment_->value << "))) " << storage_name
+                << " = {\n";
+    NDArrayDataToCString(data, 4, decl_stream);
+    decl_stream << "};\n"
+                << "#ifdef __cplusplus\n"
+                << "}  // extern \"C\"\n"
+                << "#endif\n";
+    var_idmap_[op->buffer_var.operator->()] = storage_name + ".data";
+    this->PrintStmt(op->body);
+    return;
+  }
+
   decl_stream << "\n"
               << "#ifdef __cplusplus\n"
               << "extern \"C\" {\n"
@@ -668,6 +694,7 @@ void CodeGenC::VisitStmt_(const DeclBufferNode* op) { this->PrintStmt(op->body);
 
 void CodeGenC::VisitExpr_(const BufferLoadNode* op, std::ostream& os) {  // NOLINT(*)
   ICHECK_EQ(op->indices.size(), 1) << "Load from non-flat memory not supported.";
+  ICHECK(!op->predicate.defined()) << "Predicated buffer load is not supported.";
 
   DataType value_dtype = op->dtype;
   PrimExpr index = op->indices[0];
@@ -727,6 +754,7 @@ void CodeGenC::VisitExpr_(const BufferLoadNode* op, std::ostream& os) {  // NOLI
 
 void CodeGenC::VisitStmt_(const BufferStoreNode* op) {
   ICHECK_EQ(op->indices.size(), 1) << "Store to non-flat memory not supported.";
+  ICHECK(!op->predicate.defined()) << "Predicated buffer store is not supported.";
 
   DataType value_dtype = op->value.dtype();
   DataType element_dtype = op->buffer->dtype;
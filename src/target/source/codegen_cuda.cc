@@ -28,6 +28,7 @@
 #include <tvm/tir/index_map.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <utility>
@@ -46,6 +47,7 @@ void CodeGenCUDA::Init(bool output_ssa) {
   CodeGenC::Init(output_ssa);
   vid_global_barrier_state_ = name_supply_->FreshName(runtime::symbol::tvm_global_barrier_state);
   vid_global_barrier_expect_ = name_supply_->FreshName("__barrier_expect");
+  vid_barriers_ = name_supply_->FreshName("barrier");
   ICHECK_EQ(vid_global_barrier_state_, runtime::symbol::tvm_global_barrier_state);
 }
 
@@ -117,6 +119,13 @@ std::string CodeGenCUDA::Finish() {
     decl_stream << _cuda_bfloat16_util;
   }
 
+  if (enable_fp8_) {
+    decl_stream << "#if (((__CUDACC_VER_MAJOR__ == 11) && (__CUDACC_VER_MINOR__ >= 8)) || \\\n";
+    decl_stream << "     (__CUDACC_VER_MAJOR__ > 11))\n";
+    decl_stream << "#include <cuda_fp8.h>\n";
+    decl_stream << "#endif\n\n";
+  }
+
   if (enable_warp_shuffle_) {
     decl_stream << _cuda_warp_intrinsic_util;
   }
@@ -156,6 +165,13 @@ std::string CodeGenCUDA::Finish() {
   decl_stream << "  #define uint64_t unsigned long long\n";
   decl_stream << "#endif\n";
 
+  if (lwp_max_id_ >= 0) {
+    // The cycles and the number of executions of each instrumented region,
+    // read back by the CUDA module.
+    decl_stream << "\n__device__ unsigned long long " << runtime::symbol::tvm_lwp_counters << "["
+                << 2 * (lwp_max_id_ + 1) << "];\n";
+  }
+
   return CodeGenC::Finish();
 }
 
@@ -250,6 +266,22 @@ void CodeGenCUDA::PrintType(DataType t, std::ostream& os) {  // NOLINT(*)
       fail = true;
     }
     if (!fail) return;
+  } else if (t.is_float8()) {
+    enable_fp8_ = true;
+    std::string suffix = t.is_e4m3_float8() ? "_e4m3" : "_e5m2";
+    if (t.is_scalar()) {
+      os << "__nv_fp8" << suffix;
+    } else if (lanes == 2 || lanes == 4) {
+      os << "__nv_fp8x" << lanes << suffix;
+    } else if (lanes == 8) {
+      // fp8x8 is stored as uint2, and the elements are accessed through pointer casts.
+      os << "uint2";
+    } else if (lanes == 16) {
+      os << "uint4";
+    } else {
+      fail = true;
+    }
+    if (!fail) return;
   } else if (t == DataType::Bool()) {
     os << "bool";
     return;
@@ -460,6 +492,9 @@ void CodeGenCUDA::PrintVecElemLoad(const std::string& vec, DataType t, int i,
       std::string ac = t.lanes() == 4 ? vec : (vec + "." + access[i / 4]);
       os << "((" << type_name << ")(" << ac << " >> " << i % 4 * 8 << "))";
     }
+  } else if (t.is_float8()) {
+    os << "((" << (t.is_e4m3_float8() ? "__nv_fp8_e4m3" : "__nv_fp8_e5m2") << "*)(&(" << vec
+       << ")))[" << i << "]";
   } else if (t.is_float16()) {
     os << "((half2*)(&(" << vec << "." << access[i / 2] << ")))->" << access[i % 2];
   } else if (t.is_bfloat16()) {
@@ -506,6 +541,9 @@ void CodeGenCUDA::PrintVecElemStore(const std::string& vec, DataType t, int i,
       }
       stream << "(" << value << " << " << i % 4 * 8 << ");\n";
     }
+  } else if (t.is_float8()) {
+    stream << "((" << (t.is_e4m3_float8() ? "__nv_fp8_e4m3" : "__nv_fp8_e5m2") << "*)(&(" << vec
+           << ")))[" << i << "] = " << value << ";\n";
   } else if (t.is_float16()) {
     stream << "((half2*)(&(" << vec << "." << access[i / 2] << ")))->" << access[i % 2] << " = "
            << value << ";\n";
@@ -934,6 +972,32 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
   } else if (op->op.same_as(builtin::ptx_wait_group())) {
     int n = Downcast<IntImm>(op->args[0])->value;
     this->stream << "__asm__ __volatile__(\"cp.async.wait_group " << n << ";\");\n\n";
+  } else if (op->op.same_as(builtin::ptx_cp_async_bulk())) {
+    std::string dst = this->PrintExpr(op->args[0]);
+    std::string dst_offset = this->PrintExpr(op->args[1]);
+    std::string src = this->PrintExpr(op->args[2]);
+    std::string src_offset = this->PrintExpr(op->args[3]);
+    std::string size = this->PrintExpr(op->args[4]);
+    std::string barrier = vid_barriers_ + "[" + this->PrintExpr(op->args[5]) + "]";
+    this->stream << PrintCpAsyncBulkAsm(dst, dst_offset, src, src_offset, size, barrier);
+  } else if (op->op.same_as(builtin::create_barriers())) {
+    int barrier_count = Downcast<IntImm>(op->args[0])->value;
+    this->stream << "__shared__ __align__(8) uint64_t " << vid_barriers_ << "[" << barrier_count
+                 << "];\n";
+  } else if (op->op.same_as(builtin::ptx_init_barrier_thread_count())) {
+    std::string barrier = vid_barriers_ + "[" + this->PrintExpr(op->args[0]) + "]";
+    std::string thread_count = this->PrintExpr(op->args[1]);
+    this->stream << PrintInitBarrierThreadCountAsm(barrier, thread_count);
+  } else if (op->op.same_as(builtin::ptx_arrive_barrier_expect_tx())) {
+    std::string barrier = vid_barriers_ + "[" + this->PrintExpr(op->args[0]) + "]";
+    std::string byte_count = this->PrintExpr(op->args[1]);
+    this->stream << PrintArriveBarrierExpectTxAsm(barrier, byte_count);
+  } else if (op->op.same_as(builtin::ptx_wait_barrier())) {
+    std::string barrier = vid_barriers_ + "[" + this->PrintExpr(op->args[0]) + "]";
+    this->stream << PrintWaitBarrierAsm(barrier);
+  } else if (op->op.same_as(builtin::ptx_inval_barrier())) {
+    std::string barrier = vid_barriers_ + "[" + this->PrintExpr(op->args[0]) + "]";
+    this->stream << PrintInvalBarrierAsm(barrier);
   } else if (op->op.same_as(builtin::ptx_ldg32())) {
     /*
     asm volatile (
@@ -1060,6 +1124,23 @@ void CodeGenCUDA::VisitStmt_(const EvaluateNode* op) {
     stream << "  " << vid_global_barrier_expect_ << " = 0;\n";
     PrintIndent();
     stream << "}\n";
+  } else if (call && call->op.same_as(builtin::start_profile_intrinsic())) {
+    int64_t id = Downcast<IntImm>(call->args[0])->value;
+    std::string start = name_supply_->FreshName("lwp_start");
+    lwp_starts_[id] = start;
+    lwp_max_id_ = std::max(lwp_max_id_, id);
+    PrintIndent();
+    stream << "long long " << start << " = clock64();\n";
+  } else if (call && call->op.same_as(builtin::end_profile_intrinsic())) {
+    int64_t id = Downcast<IntImm>(call->args[0])->value;
+    auto it = lwp_starts_.find(id);
+    ICHECK(it != lwp_starts_.end()) << "end_profile_intrinsic(" << id << ") without a start";
+    std::string counters = runtime::symbol::tvm_lwp_counters;
+    PrintIndent();
+    stream << "atomicAdd(&" << counters << "[" << 2 * id << "], (unsigned long long)(clock64() - "
+           << it->second << "));\n";
+    PrintIndent();
+    stream << "atomicAdd(&" << counters << "[" << 2 * id + 1 << "], 1ULL);\n";
   } else {
     CodeGenC::VisitStmt_(op);
   }
@@ -1175,6 +1256,13 @@ void CodeGenCUDA::VisitExpr_(const BroadcastNode* op, std::ostream& os) {  // NO
 }
 
 void CodeGenCUDA::VisitExpr_(const ShuffleNode* op, std::ostream& os) {
+  if (op->vectors.size() == 1 && op->indices.size() == 1 && op->vectors[0].dtype().is_vector()) {
+    // Extract a single element of a vector.
+    const int64_t* val = as_const_int(op->indices[0]);
+    ICHECK(val && *val >= 0 && *val < op->vectors[0].dtype().lanes());
+    PrintVecElemLoad(PrintExpr(op->vectors[0]), op->vectors[0].dtype(), *val, os);
+    return;
+  }
   std::vector<std::string> to_shuffle(op->vectors.size());
   for (int i = 0, e = op->vectors.size(); i < e; ++i) {
     ICHECK(op->vectors[i].dtype().lanes() == 1) << "Only scalars can be shuffled in CUDA!";
@@ -1238,6 +1326,12 @@ inline void PrintConst(const FloatImmNode* op, std::ostream& os, CodeGenCUDA* p)
     os << '(' << std::scientific << op->value << 'f' << ')';
     return;
   }
+  // Type code is kE4M3Float or kE5M2Float
+  if (op->dtype.is_float8()) {
+    p->PrintType(op->dtype, os);
+    os << '(' << std::scientific << op->value << 'f' << ')';
+    return;
+  }
   // Type code is kFloat
   switch (op->dtype.bits()) {
     case 64:
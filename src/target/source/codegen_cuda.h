@@ -42,7 +42,8 @@ class CodeGenCUDA final : public CodeGenC {
   void Init(bool output_ssa);
   std::string Finish();
   bool need_include_path() {
-    return (enable_fp16_ || enable_bf16_ || enable_int8_ || need_math_constants_h_ || need_mma_h_);
+    return (enable_fp16_ || enable_bf16_ || enable_fp8_ || enable_int8_ || need_math_constants_h_ ||
+            need_mma_h_);
   }
   // override behavior
   void PrintFuncPrefix(std::ostream& os) final;
@@ -89,10 +90,18 @@ class CodeGenCUDA final : public CodeGenC {
   std::string vid_global_barrier_state_;
   // Global barrier expected node.
   std::string vid_global_barrier_expect_;
+  // The shared memory array of mbarriers declared by create_barriers.
+  std::string vid_barriers_;
+  // The largest id of the regions instrumented by the lightweight profiler, -1 if none.
+  int64_t lwp_max_id_{-1};
+  // The variables holding the start cycles of the instrumented regions.
+  std::unordered_map<int64_t, std::string> lwp_starts_;
   // whether enable fp16
   bool enable_fp16_{false};
   // whether enable bf16
   bool enable_bf16_{false};
+  // whether enable fp8
+  bool enable_fp8_{false};
   // whether enable int8
   bool enable_int8_{false};
   // whether enable warp shuffle intrinsics
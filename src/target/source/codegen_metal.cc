@@ -289,6 +289,43 @@ void CodeGenMetal::PrintStorageScope(const std::string& scope, std::ostream& os)
   }
 }
 
+void CodeGenMetal::VisitStmt_(const AllocateNode* op) {
+  std::string scope = GetPtrStorageScope(op->buffer_var);
+  if (scope.find("wmma.") != 0) {
+    CodeGenC::VisitStmt_(op);
+    return;
+  }
+  // The WMMA fragments are held in 8x8 simdgroup matrices, one per 64 elements.
+  ICHECK(!is_zero(op->condition));
+  const VarNode* buffer = op->buffer_var.get();
+  ICHECK(fragment_shapes_.count(buffer))
+      << "Cannot find shape of the simdgroup matrix " << buffer->name_hint;
+  CHECK_EQ(fragment_shapes_.at(buffer), "8, 8, 8")
+      << "ValueError: Metal simdgroup matrices only support the 8x8x8 shape";
+  CHECK(op->dtype == DataType::Float(16) || op->dtype == DataType::Float(32))
+      << "ValueError: Metal simdgroup matrices only support float16 and float32, but gets "
+      << op->dtype;
+  size_t constant_size = op->ConstantAllocationSize();
+  ICHECK_EQ(constant_size % 64, 0U);
+  std::string vid = AllocVarID(buffer);
+  alloc_storage_scope_[buffer] = scope;
+  this->PrintIndent();
+  stream << "simdgroup_";
+  PrintType(op->dtype, stream);
+  stream << "8x8 " << vid << '[' << constant_size / 64 << "];\n";
+  RegisterHandleType(buffer, op->dtype);
+  this->PrintStmt(op->body);
+}
+
+void CodeGenMetal::VisitStmt_(const AttrStmtNode* op) {
+  if (op->attr_key == tir::attr::fragment_shape) {
+    const VarNode* buffer = op->node.as<VarNode>();
+    const StringImmNode* shape_str = op->value.as<StringImmNode>();
+    fragment_shapes_[buffer] = shape_str->value;
+  }
+  CodeGenC::VisitStmt_(op);
+}
+
 void CodeGenMetal::VisitExpr_(const SelectNode* op, std::ostream& os) {  // NOLINT(*)
   os << "select(" << PrintExpr(op->false_value) << ", " << PrintExpr(op->true_value) << ", "
      << PrintExpr(op->condition) << ")";
@@ -313,6 +350,45 @@ void CodeGenMetal::VisitExpr_(const CallNode* op, std::ostream& os) {  // NOLINT
     os << ">(";
     this->PrintExpr(op->args[0], os);
     os << "))";
+  } else if (op->op.same_as(builtin::tvm_fill_fragment())) {
+    // fill(d, m, n, k, index, value)
+    ICHECK_EQ(op->args.size(), 6U);
+    const VarNode* buffer = op->args[0].as<VarNode>();
+    ICHECK(buffer && handle_data_type_.count(buffer));
+    this->PrintExpr(op->args[0], os);
+    os << "[";
+    this->PrintExpr(op->args[4], os);
+    os << "] = make_filled_simdgroup_matrix<";
+    this->PrintType(handle_data_type_.at(buffer), os);
+    os << ", 8, 8>(";
+    this->PrintExpr(op->args[5], os);
+    os << ")";
+  } else if (op->op.same_as(builtin::tvm_load_matrix_sync()) ||
+             op->op.same_as(builtin::tvm_store_matrix_sync())) {
+    // load/store(d, m, n, k, index, ptr, stride, layout)
+    ICHECK_EQ(op->args.size(), 8U);
+    const StringImmNode* layout = op->args[7].as<StringImmNode>();
+    ICHECK(layout) << "Invalid parameters";
+    os << (op->op.same_as(builtin::tvm_load_matrix_sync()) ? "simdgroup_load("
+                                                             : "simdgroup_store(");
+    this->PrintExpr(op->args[0], os);
+    os << "[";
+    this->PrintExpr(op->args[4], os);
+    os << "], ";
+    this->PrintExpr(op->args[5], os);
+    os << ", ";
+    this->PrintExpr(op->args[6], os);
+    os << ", ulong2(0, 0), " << (layout->value == "col_major" ? "true" : "false") << ")";
+  } else if (op->op.same_as(builtin::tvm_mma_sync())) {
+    // mma(d, index_d, a, index_a, b, index_b, c, index_c)
+    ICHECK_EQ(op->args.size(), 8U);
+    os << "simdgroup_multiply_accumulate(";
+    for (int i = 0; i < 4; ++i) {
+      this->PrintExpr(op->args[i * 2], os);
+      os << "[";
+      this->PrintExpr(op->args[i * 2 + 1], os);
+      os << "]" << ((i < 3) ? ", " : ")");
+    }
   } else {
     CodeGenC::VisitExpr_(op, os);
   }
@@ -25,6 +25,7 @@
 
 #include <dlpack/dlpack.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <memory>
@@ -247,5 +248,27 @@ void NDArrayDataToC(::tvm::runtime::NDArray arr, int indent_chars, std::ostream&
   os.flags(old_fmtflags);
 }
 
+void NDArrayDataToCString(::tvm::runtime::NDArray arr, int indent_chars, std::ostream& os,
+                          const std::string& eol) {
+  CHECK(arr.IsContiguous()) << "CodegenParams: only support contiguous arrays";
+  static constexpr const char* kHexDigits = "0123456789abcdef";
+  // Each byte is printed as "\xhh", between the quotes of each line.
+  size_t bytes_per_row = std::max(1, (kMaxLineLength - indent_chars - 2) / 4);
+  std::string indent_str(indent_chars, ' ');
+
+  size_t num_bytes = runtime::GetDataSize(*arr.operator->());
+  const auto* data = static_cast<const unsigned char*>(arr->data) + arr->byte_offset;
+  std::string line;
+  for (size_t i = 0; i < num_bytes; i += bytes_per_row) {
+    line.clear();
+    for (size_t j = i; j < std::min(num_bytes, i + bytes_per_row); ++j) {
+      line += "\\x";
+      line += kHexDigits[data[j] >> 4];
+      line += kHexDigits[data[j] & 0xf];
+    }
+    os << indent_str << '"' << line << '"' << eol;
+  }
+}
+
 }  // namespace codegen
 }  // namespace tvm
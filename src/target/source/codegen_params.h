@@ -48,6 +48,23 @@ namespace codegen {
 void NDArrayDataToC(::tvm::runtime::NDArray arr, int indent_chars, std::ostream& os,
                     const std::string& eol = "\n");
 
+/*! \brief The size from which constants are emitted as string literals, see NDArrayDataToCString */
+static constexpr const int64_t kLargeConstantBytes = 64 * 1024;
+
+/*!
+ * \brief Write the bytes of arr to os as a C string literal.
+ *
+ * The string is split into indented lines of escaped bytes, e.g. "\x01\x00\xff", which C
+ * compilers parse much faster than a list of initializers for large arrays. The bytes are written
+ * in the byte order of the host.
+ *
+ * \param arr The array to generate
+ * \param indent_chars Number of chars to indent
+ * \param os Output stream where the array data should be written.
+ */
+void NDArrayDataToCString(::tvm::runtime::NDArray arr, int indent_chars, std::ostream& os,
+                          const std::string& eol = "\n");
+
 }  // namespace codegen
 }  // namespace tvm
 
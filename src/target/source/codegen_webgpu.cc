@@ -40,7 +40,13 @@ namespace tvm {
 namespace codegen {
 
 std::string CodeGenWebGPU::Finish() {
-  return decl_stream.str() + this->fwd_decl_stream.str() + stream.str();
+  std::string header;
+  if (enable_subgroups_) {
+    // The reductions only call the subgroup operations where all the invocations
+    // of the subgroup are active, which the uniformity analysis cannot prove.
+    header = "enable subgroups;\ndiagnostic(off, subgroup_uniformity);\n\n";
+  }
+  return header + decl_stream.str() + this->fwd_decl_stream.str() + stream.str();
 }
 
 void CodeGenWebGPU::InitFuncState(const PrimFunc& f) {
@@ -52,6 +58,7 @@ void CodeGenWebGPU::InitFuncState(const PrimFunc& f) {
     }
   }
   std::fill(workgroup_size_, workgroup_size_ + 3, 1);
+  enable_subgroups_ = false;
 }
 
 CodeGenWebGPU::CodeGenWebGPU(Target target) : target_(target) {}
@@ -229,6 +236,26 @@ void CodeGenWebGPU::VisitExpr_(const CallNode* op, std::ostream& os) {  // NOLIN
     os << ">(";
     this->PrintExpr(op->args[0], os);
     os << ")";
+  } else if (op->op.same_as(builtin::tvm_warp_activemask())) {
+    // WGSL subgroup operations take no mask.
+    enable_subgroups_ = true;
+    os << "0xffffffffu";
+  } else if (op->op.same_as(builtin::tvm_warp_shuffle()) ||
+             op->op.same_as(builtin::tvm_warp_shuffle_down())) {
+    // tvm_warp_shuffle[_down](mask, value, lane_or_delta, width, warp_size)
+    ICHECK_EQ(op->args.size(), 5U);
+    arith::Analyzer analyzer;
+    ICHECK(analyzer.CanProve(op->args[3] == op->args[4]))
+        << "CodeGenWebGPU: subgroup shuffle does not support width != warp_size";
+    enable_subgroups_ = true;
+    if (op->op.same_as(builtin::tvm_warp_shuffle())) {
+      // The lane is taken modulo the width, as in CUDA.
+      PrimExpr lane = analyzer.Simplify(truncmod(op->args[2], op->args[4]));
+      os << "subgroupShuffle(" << PrintExpr(op->args[1]) << ", u32(" << PrintExpr(lane) << "))";
+    } else {
+      os << "subgroupShuffleDown(" << PrintExpr(op->args[1]) << ", u32("
+         << PrintExpr(op->args[2]) << "))";
+    }
   } else if (op->op.same_as(builtin::if_then_else())) {
     // conditional that skips eval if cond evals to false
     std::string result = name_supply_->FreshName("condval");
@@ -80,6 +80,10 @@ class CodeGenWebGPU final : public CodeGenC {
    * \brief Records the workgroup size of the kernel.
    */
   uint32_t workgroup_size_[3];
+  /*!
+   * \brief Whether the kernel uses subgroup operations.
+   */
+  bool enable_subgroups_{false};
   /*!
    * \brief Storage type of bool values.
    */
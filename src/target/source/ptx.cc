@@ -65,13 +65,16 @@ enum class DataType : int {
   kBit16 = 18,
   kBit32 = 19,
   kBit64 = 20,
+  kE4M3 = 21,
+  kE5M2 = 22,
 };
 
 static const char* dtype_str[] = {".s4",   ".u4",  ".s8",  ".u8",  ".s16",  ".u16",   ".s32",
                                   ".u32",  ".s64", ".u64", ".f16", ".bf16", ".f16x2", ".f32",
-                                  ".tf32", ".f64", ".b1",  ".b8",  ".b16",  ".b32",   ".b64"};
-static const uint32_t num_bits[] = {4,  4,  8,  8,  16, 16, 32, 32, 64, 64, 16,
-                                    16, 32, 32, 32, 64, 1,  8,  16, 32, 64};
+                                  ".tf32", ".f64", ".b1",  ".b8",  ".b16",  ".b32",   ".b64",
+                                  ".e4m3", ".e5m2"};
+static const uint32_t num_bits[] = {4,  4,  8,  8,  16, 16, 32, 32, 64, 64, 16, 16,
+                                    32, 32, 32, 64, 1,  8,  16, 32, 64, 8,  8};
 
 /*!
  * \brief Create PTX data type from string.
@@ -119,6 +122,10 @@ inline DataType DTypeFromString(const std::string str) {
     return DataType::kBit32;
   } else if (str == ".b64") {
     return DataType::kBit64;
+  } else if (str == "e4m3_float8" || str == "e4m3" || str == ".e4m3") {
+    return DataType::kE4M3;
+  } else if (str == "e5m2_float8" || str == "e5m2" || str == ".e5m2") {
+    return DataType::kE5M2;
   } else {
     LOG(FATAL) << "Unrecognized PTX data type " << str;
   }
@@ -209,6 +216,8 @@ const MMAConfig valid_mma_configs[] = {
     MMAConfig(8, 8, 16, DataType::kUInt8, false, false),
     MMAConfig(16, 8, 16, DataType::kUInt8, false, false),
     MMAConfig(16, 8, 32, DataType::kUInt8, false, false),
+    MMAConfig(16, 8, 32, DataType::kE4M3, false, false),
+    MMAConfig(16, 8, 32, DataType::kE5M2, false, false),
     MMAConfig(8, 8, 32, DataType::kInt4, false, false),
     MMAConfig(16, 8, 32, DataType::kInt4, false, false),
     MMAConfig(16, 8, 64, DataType::kInt4, false, false),
@@ -263,6 +272,10 @@ void CheckMMADTypeCompatible(DataType dtype_a, DataType dtype_b, DataType dtype_
     case DataType::kUInt8:
       CHECK(dtype_b == DataType::kInt8 || dtype_b == DataType::kUInt8) << ab_not_match_err_str;
       break;
+    case DataType::kE4M3:
+    case DataType::kE5M2:
+      CHECK(dtype_b == DataType::kE4M3 || dtype_b == DataType::kE5M2) << ab_not_match_err_str;
+      break;
     default:
       CHECK(false) << "Invalid multiplicand data types: " << DTypeToString(dtype_a)
                    << DTypeToString(dtype_b);
@@ -287,6 +300,11 @@ void CheckMMADTypeCompatible(DataType dtype_a, DataType dtype_b, DataType dtype_
       CHECK(dtype_c == DataType::kFloat32)
           << "For multiplicand data type bf16/tf32, accumulator data type can only be f32.";
       break;
+    case DataType::kE4M3:
+    case DataType::kE5M2:
+      CHECK(dtype_c == DataType::kFloat32)
+          << "For multiplicand data type e4m3/e5m2, accumulator data type can only be f32.";
+      break;
     case DataType::kFloat64:
       CHECK(dtype_c == DataType::kFloat64)
           << "For multiplicand data type f64, accumulator data type can only be f64.";
@@ -371,6 +389,8 @@ inline FragAttrs GetFragAttrs(DataType dtype) {
     case DataType::kUInt4:
     case DataType::kInt8:
     case DataType::kUInt8:
+    case DataType::kE4M3:
+    case DataType::kE5M2:
     case DataType::kBit16:
     case DataType::kFloat16:  // .f16x2 register
     case DataType::kBFloat16:
@@ -724,5 +744,93 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
   return predicated_asm_code;
 }
 
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier) {
+  std::string asm_code = R"(
+  {
+    unsigned int smem_addr_int;
+    unsigned int barrier_addr_int;
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(smem_addr_int)
+      : "l"((void *)({smem_addr}))
+    );
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(barrier_addr_int)
+      : "l"((void *)(&{barrier}))
+    );
+    __asm__ __volatile__(
+      "cp.async.bulk.shared::cluster.global.mbarrier::complete_tx::bytes [%0], [%1], %2, [%3];"
+      :: "r"(smem_addr_int), "l"((void*)({global_ptr})), "r"({bytes}), "r"(barrier_addr_int)
+      : "memory"
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{smem_addr}", shared_ptr + " + " + shared_elem_offset);
+  replacer.register_rule("{global_ptr}", global_ptr + " + " + global_elem_offset);
+  replacer.register_rule("{bytes}", bytes);
+  replacer.register_rule("{barrier}", barrier);
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
+/*! \brief Print the asm code running the given mbarrier instruction with a second operand. */
+static std::string PrintBarrierAsm(const std::string& barrier, const std::string& instruction,
+                                   const std::string& operand) {
+  std::string asm_code = R"(
+  {
+    unsigned int barrier_addr_int;
+    __asm__ __volatile__(
+      "{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\n"
+      : "=r"(barrier_addr_int)
+      : "l"((void *)(&{barrier}))
+    );
+    __asm__ __volatile__(
+      "{instruction}"
+      :: "r"(barrier_addr_int){operand}
+      : "memory"
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{barrier}", barrier);
+  replacer.register_rule("{instruction}", instruction);
+  replacer.register_rule("{operand}", operand.empty() ? "" : ", \"r\"(" + operand + ")");
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count) {
+  return PrintBarrierAsm(barrier,
+                         "mbarrier.init.shared::cta.b64 [%0], %1;\"\n"
+                         "      \"fence.mbarrier_init.release.cluster;",
+                         thread_count);
+}
+
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count) {
+  return PrintBarrierAsm(barrier, "mbarrier.arrive.expect_tx.shared::cta.b64 _, [%0], %1;",
+                         byte_count);
+}
+
+std::string PrintWaitBarrierAsm(const std::string& barrier) {
+  // Wait for the completion of the first phase of the barrier.
+  return PrintBarrierAsm(barrier,
+                         "{ .reg .pred P1; LAB_WAIT: \"\n"
+                         "      \"mbarrier.try_wait.parity.shared::cta.b64 P1, [%0], 0; \"\n"
+                         "      \"@P1 bra DONE; bra LAB_WAIT; DONE: }",
+                         "");
+}
+
+std::string PrintInvalBarrierAsm(const std::string& barrier) {
+  return PrintBarrierAsm(barrier, "mbarrier.inval.shared::cta.b64 [%0];", "");
+}
+
 }  // namespace codegen
 }  // namespace tvm
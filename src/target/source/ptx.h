@@ -108,6 +108,51 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
                                            const std::string& bytes,
                                            const std::string& predicate_value);
 
+/*!
+ * \brief Print ptx cp.async.bulk assembly string given parameters, the copy signals
+ *  its completion on an mbarrier.
+ * \param shared_ptr: The pointer to the destination shared memory.
+ * \param shared_elem_offset: The offset into the shared memory.
+ * \param global_ptr: The pointer to the global memory.
+ * \param global_elem_offset: The offset into the global memory.
+ * \param bytes: The number of bytes to copy, a multiple of 16.
+ * \param barrier: The mbarrier in shared memory tracking the completion of the copy.
+ */
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier);
+
+/*!
+ * \brief Print ptx assembly initializing an mbarrier.
+ * \param barrier: The mbarrier in shared memory.
+ * \param thread_count: The number of arrivals completing a phase of the barrier.
+ */
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count);
+
+/*!
+ * \brief Print ptx assembly arriving on an mbarrier, and expecting bytes to be transferred
+ *  by asynchronous copies before the phase of the barrier completes.
+ * \param barrier: The mbarrier in shared memory.
+ * \param byte_count: The number of bytes the asynchronous copies transfer.
+ */
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count);
+
+/*!
+ * \brief Print ptx assembly waiting for the first phase of an mbarrier to complete.
+ * \param barrier: The mbarrier in shared memory.
+ */
+std::string PrintWaitBarrierAsm(const std::string& barrier);
+
+/*!
+ * \brief Print ptx assembly invalidating an mbarrier, so that it can be initialized again.
+ * \param barrier: The mbarrier in shared memory.
+ */
+std::string PrintInvalBarrierAsm(const std::string& barrier);
+
 }  // namespace codegen
 }  // namespace tvm
 
@@ -60,7 +60,12 @@ void IRBuilder::InitHeader() {
   }
 #endif
 
-  if (spirv_support_.supports_cooperative_matrix) {
+  if (spirv_support_.supports_khr_cooperative_matrix) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+    capabilities_used_.insert(spv::CapabilityCooperativeMatrixKHR);
+    extensions_used_.insert("SPV_KHR_cooperative_matrix");
+#endif
+  } else if (spirv_support_.supports_cooperative_matrix) {
     capabilities_used_.insert(spv::CapabilityCooperativeMatrixNV);
     extensions_used_.insert("SPV_NV_cooperative_matrix");
   }
@@ -112,7 +117,8 @@ std::vector<uint32_t> IRBuilder::Finalize() {
   return data;
 }
 
-SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col) {
+SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col,
+                         CooperativeMatrixUse use) {
   if (dtype == DataType::Int(32)) {
     return t_int32_;
   } else if (dtype == DataType::UInt(1)) {
@@ -131,13 +137,17 @@ SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col) {
   } else {
     type_key |= static_cast<uint64_t>(row) << 32U;
     type_key |= static_cast<uint64_t>(col) << 40U;
+    // Only the KHR cooperative matrix types depend on the use of the matrix.
+    if (spirv_support_.supports_khr_cooperative_matrix) {
+      type_key |= static_cast<uint64_t>(use) << 48U;
+    }
   }
 
   auto it = pod_type_tbl_.find(type_key);
   if (it != pod_type_tbl_.end()) {
     return it->second;
   }
-  SType t = DeclareType(dtype, row, col);
+  SType t = DeclareType(dtype, row, col, use);
   pod_type_tbl_[type_key] = t;
   return t;
 }
@@ -494,7 +504,8 @@ Value IRBuilder::GetConst_(const SType& dtype, const uint64_t* pvalue) {
   return ret;
 }
 
-SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col) {
+SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col,
+                            CooperativeMatrixUse use) {
   AddCapabilityFor(dtype);
 
   if (dtype.lanes() == 1) {
@@ -527,9 +538,20 @@ SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col)
       Value v_row = GetSpecConst(GetSType(DataType::UInt(32)), row);
       Value v_col = GetSpecConst(GetSType(DataType::UInt(32)), col);
       Value scope = UIntImm(GetSType(DataType::UInt(32)), spv::ScopeSubgroup);
-      ib_.Begin(spv::OpTypeCooperativeMatrixNV)
-          .AddSeq(t, base_type, scope, v_row, v_col)
-          .Commit(&global_);
+      if (spirv_support_.supports_khr_cooperative_matrix) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+        Value v_use = UIntImm(GetSType(DataType::UInt(32)), use);
+        ib_.Begin(spv::OpTypeCooperativeMatrixKHR)
+            .AddSeq(t, base_type, scope, v_row, v_col, v_use)
+            .Commit(&global_);
+#else
+        LOG(FATAL) << "Please turn on USE_SPIRV_KHR_COOPERATIVE_MATRIX in config.cmake";
+#endif
+      } else {
+        ib_.Begin(spv::OpTypeCooperativeMatrixNV)
+            .AddSeq(t, base_type, scope, v_row, v_col)
+            .Commit(&global_);
+      }
     }
     return t;
   }
@@ -671,6 +693,63 @@ Value IRBuilder::CallKHRIntegerDotProduct(const SType& ret_type, const std::vect
   return val;
 }
 
+Value IRBuilder::CooperativeMatrixLoad(const SType& matrix_type, Value ptr, Value stride,
+                                       bool column_major) {
+  if (spirv_support_.supports_khr_cooperative_matrix) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+    Value layout = UIntImm(t_uint32_, column_major ? spv::CooperativeMatrixLayoutColumnMajorKHR
+                                                   : spv::CooperativeMatrixLayoutRowMajorKHR);
+    return MakeValue(spv::OpCooperativeMatrixLoadKHR, matrix_type, ptr, layout, stride);
+#else
+    LOG(FATAL) << "Please turn on USE_SPIRV_KHR_COOPERATIVE_MATRIX in config.cmake";
+#endif
+  }
+  return MakeValue(spv::OpCooperativeMatrixLoadNV, matrix_type, ptr, stride,
+                   UIntImm(t_bool_, column_major));
+}
+
+void IRBuilder::CooperativeMatrixStore(Value ptr, Value matrix, Value stride, bool column_major) {
+  if (spirv_support_.supports_khr_cooperative_matrix) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+    Value layout = UIntImm(t_uint32_, column_major ? spv::CooperativeMatrixLayoutColumnMajorKHR
+                                                   : spv::CooperativeMatrixLayoutRowMajorKHR);
+    MakeInst(spv::OpCooperativeMatrixStoreKHR, ptr, matrix, layout, stride);
+    return;
+#else
+    LOG(FATAL) << "Please turn on USE_SPIRV_KHR_COOPERATIVE_MATRIX in config.cmake";
+#endif
+  }
+  MakeInst(spv::OpCooperativeMatrixStoreNV, ptr, matrix, stride, UIntImm(t_bool_, column_major));
+}
+
+Value IRBuilder::CooperativeMatrixMulAdd(const SType& ret_type, Value a, Value b, Value c) {
+  if (spirv_support_.supports_khr_cooperative_matrix) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+    // Unlike the NV instruction, the signedness of integer components is explicit.
+    uint32_t operands = spv::CooperativeMatrixOperandsMaskNone;
+    if (a.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixASignedComponentsKHRMask;
+    }
+    if (b.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixBSignedComponentsKHRMask;
+    }
+    if (c.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixCSignedComponentsKHRMask;
+    }
+    if (ret_type.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixResultSignedComponentsKHRMask;
+    }
+    if (operands == spv::CooperativeMatrixOperandsMaskNone) {
+      return MakeValue(spv::OpCooperativeMatrixMulAddKHR, ret_type, a, b, c);
+    }
+    return MakeValue(spv::OpCooperativeMatrixMulAddKHR, ret_type, a, b, c, operands);
+#else
+    LOG(FATAL) << "Please turn on USE_SPIRV_KHR_COOPERATIVE_MATRIX in config.cmake";
+#endif
+  }
+  return MakeValue(spv::OpCooperativeMatrixMulAddNV, ret_type, a, b, c);
+}
+
 Value IRBuilder::Concat(const std::vector<Value>& vec) {
   bool is_const = vec[0].flag == kConstant;
   DataType etype = vec[0].stype.type;
@@ -69,6 +69,13 @@ enum ValueKind {
   kSpecConst,
 };
 
+/*! \brief The use of a cooperative matrix, with the values of spv::CooperativeMatrixUse */
+enum CooperativeMatrixUse : uint32_t {
+  kMatrixA = 0,
+  kMatrixB = 1,
+  kMatrixAccumulator = 2,
+};
+
 /*! \brief Represent the SPIRV Value */
 struct Value {
   /*! \brief The Id to represent value */
@@ -432,6 +439,41 @@ class IRBuilder {
   Value CallKHRIntegerDotProduct(const SType& ret_type, const std::vector<Value>& args,
                                  const DataType& dtype);
 
+  /*!
+   * \brief Load a cooperative matrix from memory
+   *
+   * Uses SPV_KHR_cooperative_matrix if the target supports it, and
+   * SPV_NV_cooperative_matrix otherwise.
+   *
+   * \param matrix_type The cooperative matrix type.
+   * \param ptr The pointer to the first element.
+   * \param stride The distance in elements between consecutive rows or columns.
+   * \param column_major Whether the matrix is stored in column major order.
+   * \return The loaded matrix.
+   */
+  Value CooperativeMatrixLoad(const SType& matrix_type, Value ptr, Value stride, bool column_major);
+
+  /*!
+   * \brief Store a cooperative matrix to memory
+   *
+   * \param ptr The pointer to the first element.
+   * \param matrix The matrix to store.
+   * \param stride The distance in elements between consecutive rows or columns.
+   * \param column_major Whether the matrix is stored in column major order.
+   */
+  void CooperativeMatrixStore(Value ptr, Value matrix, Value stride, bool column_major);
+
+  /*!
+   * \brief Compute a * b + c of cooperative matrices
+   *
+   * \param ret_type The cooperative matrix type of the result.
+   * \param a The matrix a.
+   * \param b The matrix b.
+   * \param c The accumulator c.
+   * \return The result matrix.
+   */
+  Value CooperativeMatrixMulAdd(const SType& ret_type, Value a, Value b, Value c);
+
   /*!
    * \brief Build vector by concatenating components
    *
@@ -442,9 +484,13 @@ class IRBuilder {
   /*!
    * \brief Get the spirv type for a given tvm data type.
    * \param dtype The data type.
+   * \param row The number of rows, if it is a cooperative matrix type.
+   * \param col The number of columns, if it is a cooperative matrix type.
+   * \param use The use of the cooperative matrix type.
    * \return The corresponding spirv type.
    */
-  SType GetSType(const tvm::DataType& dtype, uint32_t row = 0, uint32_t col = 0);
+  SType GetSType(const tvm::DataType& dtype, uint32_t row = 0, uint32_t col = 0,
+                 CooperativeMatrixUse use = kMatrixA);
   /*!
    * \brief Get the pointer type that points to value_type
    * \param value_type.
@@ -656,7 +702,8 @@ class IRBuilder {
   Value GetConst_(const SType& dtype, const uint64_t* pvalue);
 
   // declare type
-  SType DeclareType(const DataType& dtype, uint32_t row = 0, uint32_t col = 0);
+  SType DeclareType(const DataType& dtype, uint32_t row = 0, uint32_t col = 0,
+                    CooperativeMatrixUse use = kMatrixA);
 
   // Declare the appropriate SPIR-V capabilities and extensions to use
   // this data type.
@@ -106,6 +106,10 @@ SPIRVSupport::SPIRVSupport(tvm::Target target) {
   if (target->GetAttr<Bool>("supports_cooperative_matrix")) {
     supports_cooperative_matrix = target->GetAttr<Bool>("supports_cooperative_matrix").value();
   }
+  if (target->GetAttr<Bool>("supports_khr_cooperative_matrix")) {
+    supports_khr_cooperative_matrix =
+        target->GetAttr<Bool>("supports_khr_cooperative_matrix").value();
+  }
 }
 
 }  // namespace codegen
@@ -290,6 +290,19 @@ struct SPIRVSupport {
    */
 
   bool supports_cooperative_matrix{false};
+
+  /*!
+   * \brief  Whether the driver supports the cross-vendor cooperative matrix operations.
+   *
+   * Vulkan extension: VK_KHR_cooperative_matrix
+   * SPV Extension name: SPV_KHR_cooperative_matrix
+   * SPV Capability: spv::CapabilityCooperativeMatrixKHR
+   *
+   * If support is present, cooperative matrix operations are emitted with
+   * the KHR instructions, which are also available on AMD and Intel GPUs,
+   * instead of the NV ones.
+   */
+  bool supports_khr_cooperative_matrix{false};
 };
 
 }  // namespace codegen
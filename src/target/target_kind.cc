@@ -273,8 +273,14 @@ TVM_REGISTER_TARGET_KIND("llvm", kDLCPU)
     .add_attr_option<Bool>("fast-math-contract")
     .add_attr_option<Bool>("fast-math-reassoc")
     .add_attr_option<Integer>("opt-level")
+    // The JIT engine running the module in process: "orcjit" (default) or "mcjit"
+    .add_attr_option<String>("jit")
     // LLVM command line flags, see below
     .add_attr_option<Array<String>>("cl-opt")
+    // The peak throughput of the device in GFLOP/s and its peak memory bandwidth in GB/s,
+    // used as the roofline of the profiled kernels, see tvm.utils.roofline
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"cpu"})
     // Force the external codegen kind attribute to be registered, even if no external
     // codegen targets are enabled by the TVM build.
@@ -319,6 +325,8 @@ TVM_REGISTER_TARGET_KIND("cuda", kDLCUDA)
     .add_attr_option<Integer>("thread_warp_size", Integer(32))
     .add_attr_option<Integer>("registers_per_block")
     .add_attr_option<Integer>("max_num_threads", Integer(1024))  // TODO(@zxybazh): deprecate it
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"cuda", "gpu"})
     .set_target_parser(UpdateCUDAAttrs);
 
@@ -327,6 +335,8 @@ TVM_REGISTER_TARGET_KIND("nvptx", kDLCUDA)
     .add_attr_option<String>("mtriple")
     .add_attr_option<Integer>("max_num_threads", Integer(1024))
     .add_attr_option<Integer>("thread_warp_size", Integer(32))
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"cuda", "gpu"})
     .set_target_parser(UpdateNVPTXAttrs);
 
@@ -340,6 +350,8 @@ TVM_REGISTER_TARGET_KIND("rocm", kDLROCM)
     .add_attr_option<Integer>("max_threads_per_block", Integer(256))
     .add_attr_option<Integer>("max_shared_memory_per_block", Integer(65536))
     .add_attr_option<Integer>("thread_warp_size", Integer(64))
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"rocm", "gpu"})
     .set_target_parser(UpdateROCmAttrs);
 
@@ -347,6 +359,8 @@ TVM_REGISTER_TARGET_KIND("opencl", kDLOpenCL)
     .add_attr_option<Integer>("max_num_threads", Integer(256))
     .add_attr_option<Integer>("thread_warp_size", Integer(1))
     .add_attr_option<Integer>("texture_spatial_limit", Integer(16384))
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"opencl", "gpu"});
 
 // The metal has some limitations on the number of input parameters. This is why attribute
@@ -360,6 +374,8 @@ TVM_REGISTER_TARGET_KIND("metal", kDLMetal)
     .add_attr_option<Integer>("max_shared_memory_per_block", Integer(32768))
     .add_attr_option<Integer>("thread_warp_size", Integer(16))
     .add_attr_option<Integer>("max_function_args", Integer(31))
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"metal", "gpu"});
 
 TVM_REGISTER_TARGET_KIND("vulkan", kDLVulkan)
@@ -379,6 +395,8 @@ TVM_REGISTER_TARGET_KIND("vulkan", kDLVulkan)
     .add_attr_option<Bool>("supports_dedicated_allocation")
     .add_attr_option<Bool>("supports_integer_dot_product")
     .add_attr_option<Bool>("supports_cooperative_matrix")
+    .add_attr_option<Bool>("supports_khr_cooperative_matrix")
+    .add_attr_option<Bool>("supports_timeline_semaphore")
     .add_attr_option<Integer>("supported_subgroup_operations")
     // Physical device limits
     .add_attr_option<Integer>("max_num_threads", Integer(256))
@@ -400,10 +418,15 @@ TVM_REGISTER_TARGET_KIND("vulkan", kDLVulkan)
     .add_attr_option<Integer>("vulkan_api_version")
     .add_attr_option<Integer>("max_spirv_version")
     // Tags
+    .add_attr_option<Integer>("peak_gflops")
+    .add_attr_option<Integer>("peak_gbps")
     .set_default_keys({"vulkan", "gpu"});
 
 TVM_REGISTER_TARGET_KIND("webgpu", kDLWebGPU)
     .add_attr_option<Integer>("max_num_threads", Integer(256))
+    .add_attr_option<Bool>("supports_subgroups", Bool(false))
+    // The subgroup size, which the reductions assume when using subgroup operations.
+    .add_attr_option<Integer>("thread_warp_size", Integer(1))
     .set_default_keys({"webgpu", "gpu"});
 
 TVM_REGISTER_TARGET_KIND("sdaccel", kDLOpenCL)  // line break
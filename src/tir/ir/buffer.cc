@@ -396,7 +396,8 @@ Buffer Buffer::GetFlattenedBuffer() const {
   return output;
 }
 
-PrimExpr Buffer::vload(Array<PrimExpr> begin, DataType value_dtype) const {
+PrimExpr Buffer::vload(Array<PrimExpr> begin, DataType value_dtype,
+                       Optional<PrimExpr> predicate) const {
   // specially handle bool, stored as DataType::Int(8)
   const BufferNode* n = operator->();
   ICHECK(n != nullptr);
@@ -409,10 +410,10 @@ PrimExpr Buffer::vload(Array<PrimExpr> begin, DataType value_dtype) const {
   if (factor > 1) {
     indices.Set(indices.size() - 1, Ramp(indices[indices.size() - 1], 1, factor));
   }
-  return BufferLoad(*this, indices);
+  return BufferLoad(*this, indices, predicate);
 }
 
-Stmt Buffer::vstore(Array<PrimExpr> begin, PrimExpr value) const {
+Stmt Buffer::vstore(Array<PrimExpr> begin, PrimExpr value, Optional<PrimExpr> predicate) const {
   // specially handle bool, stored as DataType::Int(8)
   const BufferNode* n = operator->();
   ICHECK(n != nullptr);
@@ -423,10 +424,10 @@ Stmt Buffer::vstore(Array<PrimExpr> begin, PrimExpr value) const {
 
   Array<PrimExpr> indices = begin;
   int factor = value_dtype.lanes() / n->dtype.lanes();
-  if (factor > 1) {
+  if (factor > 1 && indices[indices.size() - 1].dtype().is_scalar()) {
     indices.Set(indices.size() - 1, Ramp(indices[indices.size() - 1], 1, factor));
   }
-  return BufferStore(*this, value, indices);
+  return BufferStore(*this, value, indices, predicate);
 }
 
 String Buffer::scope() const {
@@ -36,6 +36,7 @@ void ExprVisitor::VisitExpr_(const AnyNode* op) {}
 
 void ExprVisitor::VisitExpr_(const BufferLoadNode* op) {
   VisitArray(op->indices, [this](const PrimExpr& e) { this->VisitExpr(e); });
+  if (op->predicate) this->VisitExpr(op->predicate.value());
 }
 
 void ExprVisitor::VisitExpr_(const ProducerLoadNode* op) {
@@ -124,10 +125,12 @@ PrimExpr ExprMutator::VisitExpr_(const AnyNode* op) { return GetRef<PrimExpr>(op
 PrimExpr ExprMutator::VisitExpr_(const BufferLoadNode* op) {
   auto fmutate = [this](const PrimExpr& e) { return this->VisitExpr(e); };
   Array<PrimExpr> indices = op->indices.Map(fmutate);
-  if (indices.same_as(op->indices)) {
+  Optional<PrimExpr> predicate = op->predicate;
+  if (predicate) predicate = this->VisitExpr(predicate.value());
+  if (indices.same_as(op->indices) && predicate.same_as(op->predicate)) {
     return GetRef<PrimExpr>(op);
   } else {
-    return BufferLoad(op->buffer, indices);
+    return BufferLoad(op->buffer, indices, predicate);
   }
 }
 
@@ -455,7 +455,8 @@ TVM_REGISTER_GLOBAL("tir.Evaluate").set_body_typed([](PrimExpr value, Span span)
 TVM_REGISTER_NODE_TYPE(EvaluateNode);
 
 // BufferStore
-BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices, Span span) {
+BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
+                         Optional<PrimExpr> predicate, Span span) {
   ICHECK_EQ(buffer->shape.size(), indices.size())
       << "Buffer " << buffer->name << " is " << buffer->shape.size()
       << "-dimensional, cannot be indexed with the " << indices.size()
@@ -479,18 +480,26 @@ BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
                << "`, the lanes of indexing are: `" << index_lanes  //
                << "`, but RHS's dtype is `" << value.dtype() << "`";
   }
+  if (predicate) {
+    DataType predicate_dtype = predicate.value().dtype();
+    ICHECK(predicate_dtype.is_bool() && predicate_dtype.lanes() == value.dtype().lanes())
+        << "The predicate of a store of " << value.dtype() << " must be a boolean with "
+        << value.dtype().lanes() << " lanes, but got " << predicate_dtype;
+  }
 
   ObjectPtr<BufferStoreNode> node = make_object<BufferStoreNode>();
   node->buffer = std::move(buffer);
   node->value = std::move(value);
   node->indices = std::move(indices);
+  node->predicate = std::move(predicate);
   node->span = std::move(span);
   data_ = std::move(node);
 }
 
 TVM_REGISTER_GLOBAL("tir.BufferStore")
-    .set_body_typed([](Buffer buffer, PrimExpr value, Array<PrimExpr> indices, Span span) {
-      return BufferStore(buffer, value, indices, span);
+    .set_body_typed([](Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
+                       Optional<PrimExpr> predicate, Span span) {
+      return BufferStore(buffer, value, indices, predicate, span);
     });
 
 TVM_REGISTER_NODE_TYPE(BufferStoreNode);
@@ -23,12 +23,18 @@
  */
 #include <tvm/node/repr_printer.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.num_pass_threads", Integer);
+
 /*!
  * \brief Function level pass that applies transformations to all
  *        TIR functions within the module.
@@ -41,6 +47,9 @@ class PrimFuncPassNode : public PassNode {
   /*! \brief The pass function called on each. */
   runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func;
 
+  /*! \brief Whether pass_func can run on several functions of a module concurrently. */
+  bool thread_safe = false;
+
   void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("pass_info", &pass_info); }
 
   /*!
@@ -68,20 +77,22 @@ class PrimFuncPass : public Pass {
    * \brief The constructor
    * \param pass_func The packed function which implements a pass.
    * \param pass_info The pass info.
+   * \param thread_safe Whether the pass function can run on several functions concurrently.
    */
   TVM_DLL PrimFuncPass(
       runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-      PassInfo pass_info);
+      PassInfo pass_info, bool thread_safe = false);
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFuncPass, Pass, PrimFuncPassNode);
 };
 
 PrimFuncPass::PrimFuncPass(
     runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-    PassInfo pass_info) {
+    PassInfo pass_info, bool thread_safe) {
   auto n = make_object<PrimFuncPassNode>();
   n->pass_func = std::move(pass_func);
   n->pass_info = std::move(pass_info);
+  n->thread_safe = thread_safe;
   data_ = std::move(n);
 }
 
@@ -92,6 +103,41 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
+
+  int num_threads = 1;
+  if (thread_safe) {
+    num_threads =
+        pass_ctx->GetConfig<Integer>("tir.num_pass_threads", Integer(1)).value().IntValue();
+  }
+  if (num_threads > 1) {
+    // The functions are transformed concurrently while the module is left untouched, so that
+    // each call sees the same module, and are written back in the order of the module.
+    std::vector<GlobalVar> gvars;
+    std::vector<PrimFunc> funcs;
+    for (const auto& kv : *func_dict) {
+      if (kv.second->IsInstance<PrimFuncNode>()) {
+        gvars.push_back(Downcast<GlobalVar>(kv.first));
+        funcs.push_back(Downcast<PrimFunc>(kv.second));
+      }
+    }
+    num_threads = std::min(num_threads, static_cast<int>(funcs.size()));
+    support::parallel_for_dynamic(0, funcs.size(), std::max(num_threads, 1),
+                                  [&](int thread_id, int task_id) {
+                                    funcs[task_id] = pass_func(funcs[task_id], mod, pass_ctx);
+                                  });
+    for (size_t i = 0; i < gvars.size(); ++i) {
+      if (funcs[i].defined()) {
+        func_dict->at(gvars[i]) = funcs[i];
+      } else {
+        deleted_list.push_back(gvars[i]);
+      }
+    }
+    for (const auto& gv : deleted_list) {
+      mod_ptr->Remove(gv);
+    }
+    return mod;
+  }
+
   // directly loop over the underlying dict
   for (auto& kv : *func_dict) {
     // only picks up tir::PrimFunc
@@ -118,9 +164,9 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe) {
   PassInfo pass_info = PassInfo(opt_level, name, required);
-  return PrimFuncPass(pass_func, pass_info);
+  return PrimFuncPass(pass_func, pass_info, thread_safe);
 }
 
 TVM_REGISTER_NODE_TYPE(PrimFuncPassNode);
@@ -69,6 +69,7 @@ class ScheduleCopier {
  private:
   /*! \brief Create the copier and properly set up the `old2new_` table */
   explicit ScheduleCopier(const ScheduleState& state) {
+    old2new_.reserve(state->stmt2ref.size());
     // Create SRef tree without parents
     for (const auto& kv : state->stmt2ref) {
       const StmtSRefNode* sref = kv.second.operator->();
@@ -91,8 +92,9 @@ class ScheduleCopier {
 
   /*! \brief Copy StmtSRefNode */
   StmtSRef Copy(const StmtSRefNode* sref) {
-    if (old2new_.count(sref)) {
-      return old2new_.at(sref);
+    auto it = old2new_.find(sref);
+    if (it != old2new_.end()) {
+      return it->second;
     }
     // Handle expired sref
     return old2new_[sref] = StmtSRef(nullptr, nullptr, -1);
@@ -141,6 +143,7 @@ class ScheduleCopier {
   /*! \brief Copy SMap<StmtSRef, Scope> */
   SMap<StmtSRef, BlockInfo> Copy(const SMap<StmtSRef, BlockInfo>& scopes) {
     SMap<StmtSRef, BlockInfo> result;
+    result.reserve(scopes.size());
     for (const auto& kv : scopes) {
       const StmtSRef& old_sref = kv.first;
       const BlockInfo& old_info = kv.second;
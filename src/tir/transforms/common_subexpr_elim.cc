@@ -120,39 +120,48 @@ bool CommonSubexpressionEliminator::CanContainEligibleComputations(const PrimExp
 }
 
 /*!
- * \brief Implements an order on pairs (expression,frequency). First attempts to compare them
-          using the size of the expression. If it is the same, decides something else still
-          deterministic.
- * \param a The first pair
- * \param b The second pair
- * \return A boolean telling if the first pair `a` comes before the second pair `b`
+ * \brief Sorts pairs (expression,frequency) by decreasing size of the expression. The pairs of
+          the same size are then ordered according to the textual representation of their
+          expression.
+ * \param computations The pairs to sort
  * \note We need this order to be deterministic in order to have a fully deterministic pass,
  *       as we will deal with elements that are coming from a hashtable, but the order in which
  *       they appeared in the hashtable was based on some runtime addresses, so it can potentially
  *       change with every execution.
+ *       The size and the representation of each expression are computed once beforehand, as
+ *       computing them inside the comparison is very slow for large kernels.
  */
-bool CommonSubexpressionEliminator::OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a,
-                                                            std::pair<PrimExpr, size_t> b) {
-  size_t a_size = CalculateExprComplexity(a.first);
-  size_t b_size = CalculateExprComplexity(b.first);
-
-  // Criteria 1 - Size of the expression comes first
-  // `a` comes before `b` if the size of `a` is bigger
-  if (a_size > b_size) {
-    return true;
+void CommonSubexpressionEliminator::SortComputations(
+    std::vector<std::pair<PrimExpr, size_t>>* computations) {
+  struct Key {
+    size_t size;
+    std::string repr;
+    size_t index;
+  };
+  std::vector<Key> keys;
+  keys.reserve(computations->size());
+  for (size_t i = 0; i < computations->size(); ++i) {
+    const PrimExpr& expr = (*computations)[i].first;
+    size_t size = CalculateExprComplexity(expr);
+    std::stringstream stream;
+    stream << AsLegacyRepr(expr);
+    keys.push_back({size, stream.str(), i});
   }
-  // `a` does NOT come before `b` if the size of `b` is bigger
-  if (b_size > a_size) {
-    return false;
+  std::sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) {
+    // Criteria 1 - Size of the expression comes first, bigger first
+    if (a.size != b.size) {
+      return a.size > b.size;
+    }
+    // Criteria 2 - If they had the same size, use the lexicographic order as a last resort
+    // as we need a deterministic order
+    return a.repr.compare(b.repr) < 0;
+  });
+  std::vector<std::pair<PrimExpr, size_t>> sorted;
+  sorted.reserve(computations->size());
+  for (const Key& key : keys) {
+    sorted.push_back(std::move((*computations)[key.index]));
   }
-
-  // Criteria 2 - If they had the same size, use the lexicographic order as a last resort
-  // as we need a deterministic order
-  std::stringstream a_stream;
-  std::stringstream b_stream;
-  a_stream << AsLegacyRepr(a.first);
-  b_stream << AsLegacyRepr(b.first);
-  return (a_stream.str().compare(b_stream.str()) < 0);
+  *computations = std::move(sorted);
 }
 
 /*!
@@ -173,7 +182,7 @@ Var CommonSubexpressionEliminator::GenerateNewVar(DataType type_annotation) {
   // Check that the name that we want to use for the new variable isn't already being used
   // (names don't really have to be unique as they are just hints, and having the same name
   // doesn't means that it's the same variable, but it's clearer for dumps)
-  if (UsesVarName::StmtUsesVarName(initial_body_, string_name)) {
+  if (used_var_names_.count(string_name)) {
     // If the name is already used, call ourselves recursively for trying with the next one
     return GenerateNewVar(type_annotation);
   }
@@ -207,7 +216,10 @@ Stmt CommonSubexpressionEliminator::PerformCSE(const Stmt& stmt, const Context&
   // for the one we are having now.
   CommonSubexpressionEliminator common_subexpression_eliminator(stmt, context_init,
                                                                 identify_equiv_terms);
-  return common_subexpression_eliminator.VisitStmt(stmt);
+  Stmt result = common_subexpression_eliminator.VisitStmt(stmt);
+  // The tables of computations are only reused within a function, drop them to bound the memory
+  ComputationsDoneBy::ClearCache();
+  return result;
 }
 
 /*!
@@ -218,7 +230,79 @@ Stmt CommonSubexpressionEliminator::PerformCSE(const Stmt& stmt, const Context&
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(const Stmt& stmt,
                                                              const Context& context_init,
                                                              bool identify_equiv_terms)
-    : initial_body_(stmt), context_(context_init), identify_equiv_terms_(identify_equiv_terms) {}
+    : identify_equiv_terms_(identify_equiv_terms) {
+  for (const auto& var_and_value : context_init) {
+    PushContext(var_and_value.first, var_and_value.second);
+  }
+  // Collect once the names already used, which the new variables will avoid
+  PostOrderVisit(stmt, [this](const ObjectRef& node) {
+    if (const auto* var = node.as<VarNode>()) {
+      used_var_names_.insert(var->name_hint);
+    }
+  });
+}
+
+/*!
+ * \brief Gives the normal form of a term, which identifies the equivalent computations.
+          The normal forms are memoized, as the same terms are compared many times.
+ * \param expr The term to normalize
+ * \return The normal form of `expr`
+ */
+PrimExpr CommonSubexpressionEliminator::Normalize(const PrimExpr& expr) {
+  if (!identify_equiv_terms_) {
+    return expr;
+  }
+  auto it = normal_forms_.find(expr);
+  if (it != normal_forms_.end()) {
+    return it->second;
+  }
+  PrimExpr normal_form = NormalizeTerm(expr, true);
+  normal_forms_[expr] = normal_form;
+  return normal_form;
+}
+
+/*!
+ * \brief Extends the context with a variable, indexing its value (if any) by its normal form.
+ * \param var The variable being introduced
+ * \param value Its value, if any
+ */
+void CommonSubexpressionEliminator::PushContext(const Var& var, const MaybeValue& value) {
+  PrimExpr key;
+  if (value.has_value()) {
+    key = Normalize(value.value());
+    // Only the outermost variable holding a given value is indexed, as it is the one used
+    context_values_.emplace(key, var);
+  }
+  context_.push_back({var, value});
+  context_keys_.push_back(key);
+}
+
+/*!
+ * \brief Restores the context to its first `size` entries, removing the others from the index.
+ * \param size The size of the context to restore
+ */
+void CommonSubexpressionEliminator::PopContext(size_t size) {
+  while (context_.size() > size) {
+    const PrimExpr& key = context_keys_.back();
+    if (key.defined()) {
+      auto it = context_values_.find(key);
+      if (it != context_values_.end() && it->second.same_as(context_.back().first)) {
+        context_values_.erase(it);
+      }
+    }
+    context_.pop_back();
+    context_keys_.pop_back();
+  }
+}
+
+/*!
+ * \brief Gives the variables of the context, for the analysis of the undefined variables.
+ */
+Array<Var> CommonSubexpressionEliminator::ContextVars() const {
+  std::function<Var(const std::pair<Var, MaybeValue>&)> forget_value =
+      [](const std::pair<Var, MaybeValue>& pair) { return pair.first; };
+  return Array<Var>(VectorMap(context_, forget_value));
+}
 
 /*!
  * \brief The method which overrides the generic dispatcher of StmtExprMutator.
@@ -241,50 +325,46 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
       SyntacticToSemanticComputations(table_syntactic_comp_done_by_expr, identify_equiv_terms_);
 
   // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_expr.begin(), semantic_comp_done_by_expr.end(),
-            OrderOnExprAndFrequency);
+  SortComputations(&semantic_comp_done_by_expr);
+
+  // The variables of the context, only computed if needed, as the context does not change here
+  Optional<Array<Var>> array_vars_known;
 
   // For each computation done (considering them from biggest to smallest)
   for (size_t i = 0; i < semantic_comp_done_by_expr.size(); i++) {
     std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_expr[i];
 
-    bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
+    // The normal form of the current computation, computed once for all the comparisons
+    PrimExpr normal_form = Normalize(computation_and_nb.first);
 
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [this, normal_form](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(Normalize(current_expr), normal_form) &&
                   IsEligibleComputation(current_expr));
         };
 
     // See if there is a pair (`var`, `value`) in the context where `value` is semantically
-    // equivalent to `computation_and_nb.first`
-    auto it_on_var = std::find_if(
-        context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
-          // Note : safe to call value() as we check has_value() just before
-          return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
-        });
+    // equivalent to `computation_and_nb.first`, using the index of the values of the context
+    auto it_on_var = context_values_.find(normal_form);
 
     // Case where we have a perfectly equivalent computation already available in a variable
     // introduced (i.e, present in context_).
     // Note that this case is needed when the user has written something like
     // [let x = A in ....A...A...] : we need to be able to replace all the occurrences of A by
     // an already existing variable holding A, when such a variable happens to exist.
-    if (it_on_var != context_.end()) {
+    if (it_on_var != context_values_.end()) {
       // Replace in the current `result` everything that is selected by the selector with
       // the existing variable, without diving into expressions in which we don't have the
       // right to dive.
       result = ReplaceSelectedExpr::ReplaceSelectedExprInExpr(
-          result, predicate_selector, it_on_var->first, CanContainEligibleComputations);
+          result, predicate_selector, it_on_var->second, CanContainEligibleComputations);
     } else {
       // The current computation is not equivalent to a computation already done. We will
       // need to see if we want to introduce it.
@@ -292,16 +372,15 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
       // --- Chunk needed for reusing the UndefinedVars() analysis ---
       // 1 - Wraps the computation into a statement
       Stmt computation_wrapped_in_stmt = Evaluate(computation_and_nb.first);
-      // 2.1 - Transform the context into a vector of variables instead of pairs
-      std::function<Var(const std::pair<Var, MaybeValue>&)> forget_value =
-          [](const std::pair<Var, MaybeValue>& pair) { return pair.first; };
-      std::vector<Var> vector_vars_known = VectorMap(context_, forget_value);
-      // 2.2 - Transform the std::vector into an Array
-      Array<Var> array_vars_known = Array<Var>(vector_vars_known);
+      // 2 - Transform the context into an Array of variables instead of pairs
+      if (!array_vars_known.defined()) {
+        array_vars_known = ContextVars();
+      }
       // --- End of chunk needed for reusing the UndefinedVars() analysis ---
 
       // We use the UndefinedVars() analysis to get the undefined vars of the computation
-      Array<Var> vars_undefined = UndefinedVars(computation_wrapped_in_stmt, array_vars_known);
+      Array<Var> vars_undefined =
+          UndefinedVars(computation_wrapped_in_stmt, array_vars_known.value());
 
       // Check if we can introduce it : if it contains no undefined variables and if we want
       // to introduce it according to the predicate
@@ -366,14 +445,14 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr_(const LetNode* op) {
   // was doable at the toplevel of the given let-in.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `value` field for potentially rewriting it
   PrimExpr value_new = VisitExpr(op->value);
 
   // Augment the context with the association (`var`, `value`) for preparing the next recursion
   // on the `body`
-  context_.push_back({op->var, MaybeValue(op->value)});
+  PushContext(op->var, MaybeValue(op->value));
 
   // Recurse on the `body` (with this extended context)
   // The recursive call will have potentially done new simplifications, because in this recursive
@@ -384,7 +463,7 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr_(const LetNode* op) {
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the let-in is not in scope outside of its body
-  context_ = context_at_entry;
+  PopContext(context_size_at_entry);
 
   // Rebuild the let-in with a new `value_new` and `body_new` where new simplifications might
   // have been done.
@@ -421,50 +500,46 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
       SyntacticToSemanticComputations(table_syntactic_comp_done_by_stmt, identify_equiv_terms_);
 
   // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_stmt.begin(), semantic_comp_done_by_stmt.end(),
-            OrderOnExprAndFrequency);
+  SortComputations(&semantic_comp_done_by_stmt);
+
+  // The variables of the context, only computed if needed, as the context does not change here
+  Optional<Array<Var>> array_vars_known;
 
   // For each computation done (considering them from biggest to smallest)
   for (size_t i = 0; i < semantic_comp_done_by_stmt.size(); i++) {
     std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_stmt[i];
 
-    bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
+    // The normal form of the current computation, computed once for all the comparisons
+    PrimExpr normal_form = Normalize(computation_and_nb.first);
 
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [this, normal_form](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(Normalize(current_expr), normal_form) &&
                   IsEligibleComputation(current_expr));
         };
 
     // See if there is a pair (`var`, `value`) in the context where `value` is semantically
-    // equivalent to `computation_and_nb.first`
-    auto it_on_var = std::find_if(
-        context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
-          // Note : safe to call value() as we check has_value() just before
-          return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
-        });
+    // equivalent to `computation_and_nb.first`, using the index of the values of the context
+    auto it_on_var = context_values_.find(normal_form);
 
     // Case where we have a perfectly equivalent computation already available in a variable
     // introduced (i.e, present in context_).
     // Note that this case is needed when the user has written something like
     // [let x = A in ....A...A...] : we need to be able to replace all the occurrences of A by
     // an already existing variable holding A, when such a variable happens to exist.
-    if (it_on_var != context_.end()) {
+    if (it_on_var != context_values_.end()) {
       // Replace in the current `result` everything that is selected by the selector with
       // the existing variable, without diving into expressions in which we don't have the
       // right to dive.
       result = ReplaceSelectedExpr::ReplaceSelectedExprInStmt(
-          result, predicate_selector, it_on_var->first, CanContainEligibleComputations);
+          result, predicate_selector, it_on_var->second, CanContainEligibleComputations);
     } else {
       // The current computation is not equivalent to a computation already done. We will
       // need to see if we want to introduce it.
@@ -472,16 +547,15 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
       // --- Chunk needed for reusing the UndefinedVars() analysis ---
       // 1 - Wraps the computation into a statement
       Stmt computation_wrapped_in_stmt = Evaluate(computation_and_nb.first);
-      // 2.1 - Transform the context into a vector of variables instead of pairs
-      std::function<Var(const std::pair<Var, MaybeValue>&)> forget_value =
-          [](const std::pair<Var, MaybeValue>& pair) { return pair.first; };
-      std::vector<Var> vector_vars_known = VectorMap(context_, forget_value);
-      // 2.2 - Transform the std::vector into an Array
-      Array<Var> array_vars_known = Array<Var>(vector_vars_known);
+      // 2 - Transform the context into an Array of variables instead of pairs
+      if (!array_vars_known.defined()) {
+        array_vars_known = ContextVars();
+      }
       // --- End of chunk needed for reusing the UndefinedVars() analysis ---
 
       // We use the UndefinedVars() analysis to get the undefined vars of the computation
-      Array<Var> vars_undefined = UndefinedVars(computation_wrapped_in_stmt, array_vars_known);
+      Array<Var> vars_undefined =
+          UndefinedVars(computation_wrapped_in_stmt, array_vars_known.value());
 
       // Check if we can introduce it : if it contains no undefined variables and if we want
       // to introduce it according to the predicate
@@ -547,14 +621,14 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const LetStmtNode* op) {
   // was doable at the toplevel of the given let-in.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `value` field for potentially rewriting it
   PrimExpr value_new = VisitExpr(op->value);
 
   // Augment the context with the association (`var`, `value`) for preparing the next recursion
   // on the `body`
-  context_.push_back({op->var, MaybeValue(op->value)});
+  PushContext(op->var, MaybeValue(op->value));
 
   // Recurse on the `body` (with this extended context)
   // The recursive call will have potentially done new simplifications, because in this recursive
@@ -565,7 +639,7 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const LetStmtNode* op) {
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the let-in is not in scope outside of its body
-  context_ = context_at_entry;
+  PopContext(context_size_at_entry);
 
   // Rebuild the let-in with a new `value_new` and `body_new` where new simplifications might
   // have been done.
@@ -589,7 +663,7 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const ForNode* op) {
   // was doable at the toplevel of the given for loop.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `min` field for potentially rewriting it
   PrimExpr min_new = VisitExpr(op->min);
@@ -599,14 +673,14 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const ForNode* op) {
 
   // Augment the context with the association {loop_var, no value} (no value as its value will
   // change during the execution of the loop) for preparing the next recursion on the `body`
-  context_.push_back({op->loop_var, MaybeValue()});
+  PushContext(op->loop_var, MaybeValue());
 
   // Recurse on the `body` (with this extended context)
   Stmt body_new = VisitStmt(op->body);
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the for loop is not in scope outside of its body
-  context_ = context_at_entry;
+  PopContext(context_size_at_entry);
 
   // Rebuild the for loop with (potentially) a new `min_new`, `extent_new` and `body_new`, where
   // new simplifications might have been done.
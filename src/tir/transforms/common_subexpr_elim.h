@@ -34,6 +34,9 @@
 #include <tvm/tir/stmt_functor.h>  // For the class StmtExprMutator
 #include <tvm/tir/var.h>
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>  // For std::pair
 #include <vector>
 
@@ -73,18 +76,29 @@ class CommonSubexpressionEliminator : public StmtExprMutator {
   Stmt VisitStmt_(const ForNode* op) override;
 
  private:
-  Stmt initial_body_;     // Kept for checking if names of new variables already exist
+  std::unordered_set<std::string> used_var_names_;  // Names of the vars of the initial body
   Context context_;       // Context associating variables to (maybe) definitions
   int num_last_try_ = 0;  // Number of the last variable tried
   int nb_var_ = 0;        // Number of variables introduced by the CSE pass
 
   bool identify_equiv_terms_ = false;
 
+  // Normal forms of the values of the context, mapped to the outermost variable holding them
+  std::unordered_map<PrimExpr, Var, StructuralHash, ExprDeepEqual> context_values_;
+  // Key in `context_values_` of each entry of `context_`, undefined for entries without value
+  std::vector<PrimExpr> context_keys_;
+  // Memoized normal forms, only filled when identifying equivalent terms
+  std::unordered_map<PrimExpr, PrimExpr, ObjectPtrHash, ObjectPtrEqual> normal_forms_;
+
   static bool ForbiddenComputation(const PrimExpr& expr);
   static bool IsEligibleComputation(const PrimExpr& expr);
   static bool CanContainEligibleComputations(const PrimExpr& expr);
-  static bool OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b);
+  static void SortComputations(std::vector<std::pair<PrimExpr, size_t>>* computations);
   Var GenerateNewVar(DataType type_annotation);
+  PrimExpr Normalize(const PrimExpr& expr);
+  void PushContext(const Var& var, const MaybeValue& value);
+  void PopContext(size_t size);
+  Array<Var> ContextVars() const;
 };
 
 }  // namespace tir
@@ -36,7 +36,9 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>  // For the declaration of the pass
 
-#include <algorithm>      // For std::find_if
+#include <algorithm>  // For std::find_if
+#include <sstream>
+#include <string>
 #include <unordered_map>  // For the hashtable datatype
 #include <utility>
 #include <vector>
@@ -50,6 +52,15 @@ namespace tir {
 // such static attribute, otherwise it causes a linking error.
 ComputationCache ComputationsDoneBy::cache_;
 
+/*!
+ * \brief Empties the cache of computations, which would otherwise keep alive (and keep growing
+          with) every statement and expression ever analyzed.
+ */
+void ComputationsDoneBy::ClearCache() {
+  cache_.cache_stmt_table_computations_.clear();
+  cache_.cache_expr_table_computations_.clear();
+}
+
 /* ********************************** Class ComputationsDoneBy **********************************
 *********************************************************************************************** */
 
@@ -810,19 +821,23 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // iterating through its items soon, and the order of appearance will be used to determine the
   // individual representant for each class of equivalence, which we want to be deterministic
   // (otherwise {x+y, y+x} could be both replaced by x+y, and on another run by y+x).
-  std::vector<std::pair<PrimExpr, size_t>> sorted_items_of_table(table.begin(), table.end());
-
-  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering
-  sort(sorted_items_of_table.begin(), sorted_items_of_table.end(),
-       [](std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b) {
-         std::stringstream a_stream;
-         std::stringstream b_stream;
-         a_stream << AsLegacyRepr(a.first);
-         b_stream << AsLegacyRepr(b.first);
-         return a_stream.str().compare(b_stream.str()) < 0;
-       });
-
-  for (const auto& elem : sorted_items_of_table) {
+  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering.
+  // The reprs are computed once beforehand, as printing them in each comparison is very slow.
+  std::vector<std::pair<std::string, std::pair<PrimExpr, size_t>>> sorted_items_of_table;
+  sorted_items_of_table.reserve(table.size());
+  for (const auto& elem : table) {
+    std::stringstream stream;
+    stream << AsLegacyRepr(elem.first);
+    sorted_items_of_table.emplace_back(stream.str(), elem);
+  }
+  std::sort(sorted_items_of_table.begin(), sorted_items_of_table.end(),
+            [](const std::pair<std::string, std::pair<PrimExpr, size_t>>& a,
+               const std::pair<std::string, std::pair<PrimExpr, size_t>>& b) {
+              return a.first.compare(b.first) < 0;
+            });
+
+  for (const auto& repr_and_elem : sorted_items_of_table) {
+    const std::pair<PrimExpr, size_t>& elem = repr_and_elem.second;
     PrimExpr norm_elem = NormalizeTerm(elem.first, identify_equiv_terms);
     // If the normalized term is not already a key in the normalized table
     auto it_found = norm_table.find(norm_elem);
@@ -888,10 +903,12 @@ void InsertElemToSortedSemanticComputations(std::vector<std::pair<PrimExpr, size
   // does not return true with the given value (`pair` here), i.e, an iterator pointing to the
   // first element that is not greater or equal than `pair`, i.e, the first element that is
   // strictly smaller than `pair`.
+  // The size of `pair` is computed only once, instead of in each comparison.
+  size_t pair_complexity = CalculateExprComplexity(pair.first);
   auto insertion_point = std::lower_bound(
-      sorted_vec->begin(), sorted_vec->end(), pair,
-      [](const std::pair<PrimExpr, size_t>& left, const std::pair<PrimExpr, size_t>& right) {
-        return (CalculateExprComplexity(left.first) >= CalculateExprComplexity(right.first));
+      sorted_vec->begin(), sorted_vec->end(), pair_complexity,
+      [](const std::pair<PrimExpr, size_t>& left, size_t right_complexity) {
+        return (CalculateExprComplexity(left.first) >= right_complexity);
       });
   sorted_vec->insert(insertion_point, pair);
 }
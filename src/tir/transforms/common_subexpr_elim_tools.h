@@ -84,6 +84,8 @@ class ComputationsDoneBy : public StmtExprVisitor {
   static ComputationTable GetComputationsDoneBy(
       const Stmt& stmt, std::function<bool(const PrimExpr&)> is_eligible_computation,
       std::function<bool(const PrimExpr&)> can_contain_computations);
+  // Empties the cache of computations, once a function has been processed
+  static void ClearCache();
 
  protected:
   // Constructor
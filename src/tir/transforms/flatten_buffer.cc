@@ -294,7 +294,7 @@ Pass FlattenBuffer() {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     return FlattenBuffer(std::move(f));
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.FlattenBuffer", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.FlattenBuffer", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.FlattenBuffer").set_body_typed(FlattenBuffer);
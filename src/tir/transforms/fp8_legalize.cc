@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file fp8_legalize.cc
+ * \brief legalize fp8 compute by promoting the operands to a wider float type
+ */
+
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+namespace tvm {
+namespace tir {
+
+// NOTE: Legalize the FP8 computations
+// Unlike bf16, the fp8 storage is kept as is, since the targets that have fp8 types, e.g. CUDA
+// through cuda_fp8.h, only support conversions of them but not arithmetics. Each operation on
+// fp8 values is computed in the promoted type, and its result is cast back to fp8, so that every
+// operation is still rounded to fp8 like a native fp8 operation would be.
+class FP8ComputeLegalizer : public StmtExprMutator {
+ public:
+  explicit FP8ComputeLegalizer(DataType promote_dtype) : promote_dtype_(promote_dtype) {}
+
+  PrimFunc Legalize(PrimFunc func) {
+    auto* n = func.CopyOnWrite();
+    n->body = this->VisitStmt(std::move(n->body));
+    return func;
+  }
+
+ protected:
+#define DEFINE_BIOP_EXPR_LEGALIZE(OP, FUNC)                                \
+  PrimExpr VisitExpr_(const OP* op) final {                                \
+    PrimExpr a = this->VisitExpr(op->a);                                   \
+    PrimExpr b = this->VisitExpr(op->b);                                   \
+    if (!a.dtype().is_float8() && !b.dtype().is_float8()) {                \
+      if (a.same_as(op->a) && b.same_as(op->b)) {                          \
+        return GetRef<PrimExpr>(op);                                       \
+      }                                                                    \
+      return FUNC(a, b);                                                   \
+    }                                                                      \
+    return DemoteToFP8(FUNC(PromoteFP8(a), PromoteFP8(b)), op->dtype);     \
+  }
+
+  DEFINE_BIOP_EXPR_LEGALIZE(AddNode, operator+);
+  DEFINE_BIOP_EXPR_LEGALIZE(SubNode, operator-);
+  DEFINE_BIOP_EXPR_LEGALIZE(MulNode, operator*);
+  DEFINE_BIOP_EXPR_LEGALIZE(DivNode, div);
+  DEFINE_BIOP_EXPR_LEGALIZE(MinNode, min);
+  DEFINE_BIOP_EXPR_LEGALIZE(MaxNode, max);
+  DEFINE_BIOP_EXPR_LEGALIZE(LTNode, operator<);
+  DEFINE_BIOP_EXPR_LEGALIZE(LENode, operator<=);
+  DEFINE_BIOP_EXPR_LEGALIZE(GTNode, operator>);
+  DEFINE_BIOP_EXPR_LEGALIZE(GENode, operator>=);
+  DEFINE_BIOP_EXPR_LEGALIZE(EQNode, operator==);
+  DEFINE_BIOP_EXPR_LEGALIZE(NENode, operator!=);
+
+#undef DEFINE_BIOP_EXPR_LEGALIZE
+
+  PrimExpr VisitExpr_(const CallNode* op) final {
+    PrimExpr ret = StmtExprMutator::VisitExpr_(op);
+    op = ret.as<CallNode>();
+    // The math intrinsics compute on fp8 values, while reinterpret and if_then_else only move
+    // the bits.
+    if (op == nullptr || !op->dtype.is_float8() || !op->op->IsInstance<OpNode>() ||
+        op->op.same_as(builtin::reinterpret()) || op->op.same_as(builtin::if_then_else())) {
+      return ret;
+    }
+    Array<PrimExpr> args = op->args.Map([this](const PrimExpr& arg) { return PromoteFP8(arg); });
+    return DemoteToFP8(Call(promote_dtype_.with_lanes(op->dtype.lanes()), op->op, args), op->dtype);
+  }
+
+ private:
+  /*! \brief Cast a fp8 value to the promoted type, keeping the other values unchanged. */
+  PrimExpr PromoteFP8(PrimExpr value) {
+    if (!value.dtype().is_float8()) return value;
+    return cast(promote_dtype_.with_lanes(value.dtype().lanes()), value);
+  }
+
+  /*! \brief Cast a promoted value back to the original fp8 type of the operation. */
+  PrimExpr DemoteToFP8(PrimExpr value, DataType dtype) {
+    if (!dtype.is_float8()) return value;
+    return cast(dtype, value);
+  }
+
+  /*! \brief The type that fp8 operations are computed in */
+  DataType promote_dtype_;
+};
+
+namespace transform {
+
+Pass FP8ComputeLegalize(String promote_dtype_str) {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    DataType promote_dtype(runtime::String2DLDataType(promote_dtype_str));
+    CHECK(promote_dtype.is_float() && promote_dtype.bits() >= 16)
+        << "ValueError: fp8 compute can only be promoted to float16/float32, but gets "
+        << promote_dtype;
+    return FP8ComputeLegalizer(promote_dtype).Legalize(f);
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.FP8ComputeLegalize", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.FP8ComputeLegalize").set_body_typed(FP8ComputeLegalize);
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
@@ -21,12 +21,20 @@
  * \brief Replace copy from global to shared with async copy
  * \file inject_ptx_async_copy.cc
  */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <string>
+#include <unordered_set>
+
+#include "../../support/utils.h"
 #include "../ir/buffer_common.h"
 #include "storage_access.h"
 #include "tvm/tir/stmt.h"
@@ -36,6 +44,12 @@ namespace tir {
 
 class PTXAsyncCopyInjector : public StmtMutator {
  public:
+  /*!
+   * \param enable_bulk_copy Whether loops copying more than 16 contiguous bytes into dynamic
+   *  shared memory are lowered to bulk copies, available from sm_90.
+   */
+  explicit PTXAsyncCopyInjector(bool enable_bulk_copy) : enable_bulk_copy_(enable_bulk_copy) {}
+
   Stmt VisitStmt_(const AttrStmtNode* attr) {
     if (attr->attr_key == tir::attr::async_scope) {
       ICHECK(in_async == false) << "Nested async scopes not supported";
@@ -44,9 +58,133 @@ class PTXAsyncCopyInjector : public StmtMutator {
       in_async = false;
       return body;
     }
+    if (attr->attr_key == tir::attr::thread_extent && enable_bulk_copy_) {
+      IterVar iv = Downcast<IterVar>(attr->node);
+      if (!in_kernel_) {
+        // Each thread waits for its bulk copies on its own barrier.
+        in_kernel_ = true;
+        CollectThreads(attr);
+        bound_threads_.insert(iv->var.get());
+        Stmt stmt = StmtMutator::VisitStmt_(attr);
+        bound_threads_.clear();
+        in_kernel_ = false;
+        if (use_barriers_) {
+          use_barriers_ = false;
+          auto* n = stmt.as<AttrStmtNode>();
+          Stmt create =
+              Evaluate(Call(DataType::Void(), builtin::create_barriers(), {num_threads_}));
+          return AttrStmt(n->node, n->attr_key, n->value, SeqStmt({create, n->body}));
+        }
+        return stmt;
+      }
+      bound_threads_.insert(iv->var.get());
+      Stmt stmt = StmtMutator::VisitStmt_(attr);
+      bound_threads_.erase(iv->var.get());
+      return stmt;
+    }
     return StmtMutator::VisitStmt_(attr);
   }
 
+  Stmt VisitStmt_(const ForNode* loop) {
+    if (in_async && in_kernel_) {
+      if (Optional<Stmt> bulk_copy = InjectBulkCopy(loop)) {
+        return bulk_copy.value();
+      }
+    }
+    return StmtMutator::VisitStmt_(loop);
+  }
+
+  /*!
+   * \brief Lower a loop copying contiguous global memory into dynamic shared memory to a bulk
+   * copy, issued and waited for by the thread running the loop.
+   */
+  Optional<Stmt> InjectBulkCopy(const ForNode* loop) {
+    const auto* extent = loop->extent.as<IntImmNode>();
+    const auto* store = loop->body.as<BufferStoreNode>();
+    if (extent == nullptr || store == nullptr || num_threads_ == 0 ||
+        (loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled)) {
+      return NullOpt;
+    }
+    for (const Var& var : thread_vars_) {
+      if (!bound_threads_.count(var.get())) return NullOpt;
+    }
+    const auto* load = store->value.as<BufferLoadNode>();
+    if (load == nullptr || store->buffer.scope() != "shared.dyn" ||
+        load->buffer.scope() != "global" || store->indices.size() != 1 ||
+        load->indices.size() != 1 || store->predicate.defined() || load->predicate.defined()) {
+      return NullOpt;
+    }
+    auto dst_elem_type = GetPointerType(store->buffer->data->type_annotation);
+    auto src_elem_type = GetPointerType(load->buffer->data->type_annotation);
+    if (!dst_elem_type.has_value() || !src_elem_type.has_value()) {
+      return NullOpt;
+    }
+
+    // The offset of a contiguous access of `lanes` elements in each iteration.
+    int lanes = load->dtype.lanes();
+    auto f_offset = [&](const PrimExpr& index) -> Optional<PrimExpr> {
+      PrimExpr base = index;
+      if (const auto* ramp = index.as<RampNode>()) {
+        if (!is_one(ramp->stride)) return NullOpt;
+        base = ramp->base;
+      } else if (lanes != 1) {
+        // The dst index into the byte buffer of merged dynamic shared memory.
+        const auto* add = index.as<AddNode>();
+        if (add == nullptr) return NullOpt;
+        const auto* ramp = add->a.as<RampNode>();
+        const auto* broadcast = add->b.as<BroadcastNode>();
+        if (ramp == nullptr || broadcast == nullptr || !is_one(ramp->stride)) return NullOpt;
+        base = ramp->base + broadcast->value;
+      }
+      Array<PrimExpr> coeffs = arith::DetectLinearEquation(base, {loop->loop_var});
+      if (coeffs.size() != 2) return NullOpt;
+      const auto* stride = coeffs[0].as<IntImmNode>();
+      if (stride == nullptr || stride->value != lanes) return NullOpt;
+      return coeffs[1] + loop->min * lanes;
+    };
+    Optional<PrimExpr> src_offset = f_offset(load->indices[0]);
+    Optional<PrimExpr> dst_offset = f_offset(store->indices[0]);
+    if (!src_offset.defined() || !dst_offset.defined()) {
+      return NullOpt;
+    }
+
+    int64_t bytes = extent->value * lanes * load->dtype.bytes();
+    if (bytes <= 16 || bytes % 16 != 0) {
+      // Smaller copies are better served by cp.async.
+      return NullOpt;
+    }
+    // The shared memory of merged dynamic allocations is a byte buffer, see InjectPTX.
+    PrimExpr dst_elem_offset = dst_offset.value();
+    if (dst_elem_type.value() != src_elem_type.value()) {
+      if (dst_elem_type.value() != DataType::UInt(8)) return NullOpt;
+      dst_elem_offset = dst_elem_offset * src_elem_type->bytes();
+    }
+    // Both addresses of a bulk copy must be 16 bytes aligned.
+    auto f_aligned = [&](const PrimExpr& elem_offset, int elem_bytes) {
+      return analyzer_.CanProve(floormod(elem_offset * elem_bytes, 16) == 0);
+    };
+    if (!f_aligned(src_offset.value(), src_elem_type->bytes()) ||
+        !f_aligned(dst_elem_offset, dst_elem_type->bytes())) {
+      return NullOpt;
+    }
+
+    use_barriers_ = true;
+    PrimExpr barrier = thread_index_;
+    PrimExpr num_bytes = IntImm(DataType::Int(32), bytes);
+    auto f_barrier_op = [&](const Op& op, Array<PrimExpr> args) {
+      return Evaluate(Call(DataType::Void(), op, args));
+    };
+    return SeqStmt({
+        f_barrier_op(builtin::ptx_init_barrier_thread_count(), {barrier, 1}),
+        f_barrier_op(builtin::ptx_arrive_barrier_expect_tx(), {barrier, num_bytes}),
+        Evaluate(Call(store->buffer->dtype, builtin::ptx_cp_async_bulk(),
+                      {store->buffer->data, dst_elem_offset, load->buffer->data,
+                       src_offset.value(), num_bytes, barrier})),
+        f_barrier_op(builtin::ptx_wait_barrier(), {barrier}),
+        f_barrier_op(builtin::ptx_inval_barrier(), {barrier}),
+    });
+  }
+
   Stmt InjectPTX(const BufferLoadNode* load, const BufferStoreNode* store, bool predicated = false,
                  PrimExpr predicate_value = PrimExpr()) {
     if (load->buffer.scope() == "global") {
@@ -184,15 +322,68 @@ class PTXAsyncCopyInjector : public StmtMutator {
   }
 
  private:
+  /*! \brief Find the threads of a kernel, and the linear index of the running thread. */
+  void CollectThreads(const AttrStmtNode* kernel) {
+    Var thread_var[3];
+    int64_t thread_extent[3] = {1, 1, 1};
+    bool is_const = true;
+    PostOrderVisit(GetRef<Stmt>(kernel), [&](const ObjectRef& node) {
+      const auto* attr = node.as<AttrStmtNode>();
+      if (attr == nullptr || attr->attr_key != tir::attr::thread_extent) return;
+      IterVar iv = Downcast<IterVar>(attr->node);
+      std::string tag = iv->thread_tag;
+      if (!support::StartsWith(tag, "threadIdx.")) return;
+      int dim = tag.back() - 'x';
+      thread_var[dim] = iv->var;
+      if (const auto* extent = attr->value.as<IntImmNode>()) {
+        thread_extent[dim] = extent->value;
+      } else {
+        is_const = false;
+      }
+    });
+    thread_vars_.clear();
+    num_threads_ = 0;
+    if (!is_const) return;
+    PrimExpr index = make_const(DataType::Int(32), 0);
+    int64_t stride = 1;
+    for (int dim = 0; dim < 3; ++dim) {
+      if (!thread_var[dim].defined()) continue;
+      thread_vars_.push_back(thread_var[dim]);
+      index = index + cast(DataType::Int(32), thread_var[dim]) * static_cast<int>(stride);
+      stride *= thread_extent[dim];
+    }
+    thread_index_ = analyzer_.Simplify(index);
+    num_threads_ = IntImm(DataType::Int(32), stride);
+  }
+
   bool in_async{false};
+  bool enable_bulk_copy_;
+  /*! \brief Whether the visitor is inside a kernel. */
+  bool in_kernel_{false};
+  /*! \brief Whether bulk copies were injected in the current kernel. */
+  bool use_barriers_{false};
+  /*! \brief The threadIdx variables of the current kernel, and the ones in scope. */
+  Array<Var> thread_vars_;
+  std::unordered_set<const VarNode*> bound_threads_;
+  /*! \brief The linear index of the running thread, and the number of threads. */
+  PrimExpr thread_index_;
+  Integer num_threads_{0};
+  arith::Analyzer analyzer_;
 };
 
 namespace transform {
 
 Pass InjectPTXAsyncCopy() {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    bool enable_bulk_copy = false;
+    if (auto target = f->GetAttr<Target>(tvm::attr::kTarget)) {
+      if (auto arch = target.value()->GetAttr<String>("arch")) {
+        std::string sm = arch.value();
+        enable_bulk_copy = support::StartsWith(sm, "sm_") && std::atoi(sm.c_str() + 3) >= 90;
+      }
+    }
     auto* n = f.CopyOnWrite();
-    n->body = PTXAsyncCopyInjector()(n->body);
+    n->body = PTXAsyncCopyInjector(enable_bulk_copy)(n->body);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.InjectPTXAsyncCopy", {});
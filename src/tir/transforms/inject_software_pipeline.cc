@@ -22,9 +22,11 @@
  * \brief Transform annotated loops into pipelined one that parallelize producers and consumers
  */
 #include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "../../support/utils.h"
@@ -996,12 +998,37 @@ class PipelineInjector : private StmtExprMutator {
       injector.buffer_data_to_buffer_.Set(buffer->data, buffer);
     }
     injector.fragment_info_ = GetTensorCoreFragmentInfo(func->body);
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    injector.vtcm_capacity_ = GetVTCMCapacity(
+        func->GetAttr<Target>(tvm::attr::kTarget).value_or(Target()), pass_ctx);
+    injector.use_async_copy_ =
+        pass_ctx->GetConfig<Bool>("tir.use_async_copy", Bool(false)).value();
+    PostOrderVisit(func->body, [&injector](const ObjectRef& obj) {
+      if (const auto* block = obj.as<BlockNode>()) {
+        for (const Buffer& buffer : block->alloc_buffers) {
+          if (buffer.scope() == "global.vtcm") {
+            injector.vtcm_bytes_ += std::max<int64_t>(ConstantBufferBytes(buffer), 0);
+          }
+        }
+      }
+    });
     return injector(func->body);
   }
 
  private:
   explicit PipelineInjector(Optional<String> global_symbol) : global_symbol_(global_symbol) {}
 
+  /*! \return The number of bytes of the buffer, or -1 if its shape is not constant. */
+  static int64_t ConstantBufferBytes(const Buffer& buffer) {
+    int64_t bytes = buffer->dtype.bytes() * buffer->dtype.lanes();
+    for (const PrimExpr& dim : buffer->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      if (imm == nullptr) return -1;
+      bytes *= imm->value;
+    }
+    return bytes;
+  }
+
   /*!
    * \brief Check the pipeline satisfies the following conditions:
    * 1. No conflicting order: The order of each statement should be unique.
@@ -1044,11 +1071,117 @@ class PipelineInjector : private StmtExprMutator {
     }
   }
 
+  /*!
+   * \brief Derive the stage and order of the statements of a loop annotated with
+   * software_pipeline_max_stages.
+   *
+   * The producers are the statements only reading global buffers which are not written in the
+   * loop, and only writing shared (or VTCM) buffers of the pipeline that no other statement
+   * writes. They are put in stage 0 and the other statements in the last stage. The number of
+   * stages is the largest one, up to the maximum and the loop extent, for which the staging
+   * buffers of the pipeline fit in the budget given by software_pipeline_shared_memory_bytes,
+   * knowing that one version of the buffers written in stage 0 is kept for each stage. Without
+   * this annotation, VTCM staging buffers are bounded by the VTCM capacity left by the other
+   * VTCM buffers of the function.
+   * \param async_producers Set to whether stage 0 should be made asynchronous, which is the
+   *  case for DDR to VTCM copies when tir.use_async_copy lowers them to DMA.
+   * \return Whether the loop can be pipelined.
+   */
+  bool MakeAutoPipelineAnnotation(const ForNode* op, const Array<Block>& original_order,
+                                  const Array<Buffer>& pipeline_allocs,
+                                  Array<Integer>* pipeline_stages, Array<Integer>* pipeline_orders,
+                                  bool* async_producers) const {
+    int64_t num_stages =
+        Downcast<Integer>(op->annotations.at(attr::software_pipeline_max_stages))->value;
+    int64_t budget = 0;
+    if (auto annot = op->annotations.Get(attr::software_pipeline_shared_memory_bytes)) {
+      budget = Downcast<Integer>(annot)->value;
+    }
+    if (const auto* extent = op->extent.as<IntImmNode>()) {
+      num_stages = std::min(num_stages, extent->value);
+    }
+
+    auto is_staging = [](const Buffer& buffer) {
+      String scope = buffer.scope();
+      return scope == "shared" || scope == "shared.dyn" || scope == "global.vtcm";
+    };
+    std::unordered_set<const BufferNode*> allocated;
+    for (const Buffer& buffer : pipeline_allocs) {
+      allocated.insert(buffer.get());
+    }
+    std::unordered_map<const BufferNode*, int> num_writers;
+    for (const Block& block : original_order) {
+      for (const BufferRegion& write : block->writes) {
+        ++num_writers[write->buffer.get()];
+      }
+    }
+
+    std::vector<bool> is_producer;
+    std::unordered_set<const BufferNode*> versioned;
+    for (const Block& block : original_order) {
+      bool producer = !block->reads.empty() && !block->writes.empty();
+      for (const BufferRegion& read : block->reads) {
+        producer = producer && read->buffer.scope() == "global" &&
+                   !num_writers.count(read->buffer.get());
+      }
+      for (const BufferRegion& write : block->writes) {
+        producer = producer && is_staging(write->buffer) && allocated.count(write->buffer.get()) &&
+                   num_writers.at(write->buffer.get()) == 1;
+      }
+      if (producer) {
+        for (const BufferRegion& write : block->writes) {
+          versioned.insert(write->buffer.get());
+        }
+      }
+      is_producer.push_back(producer);
+    }
+    size_t num_producers = std::count(is_producer.begin(), is_producer.end(), true);
+    if (num_producers == 0 || num_producers == is_producer.size()) {
+      return false;
+    }
+
+    int64_t fixed_bytes = 0;
+    int64_t versioned_bytes = 0;
+    int64_t loop_vtcm_bytes = 0;
+    bool vtcm_staging = false;
+    for (const Buffer& buffer : pipeline_allocs) {
+      if (!is_staging(buffer)) continue;
+      int64_t bytes = ConstantBufferBytes(buffer);
+      if (bytes < 0) return false;
+      (versioned.count(buffer.get()) ? versioned_bytes : fixed_bytes) += bytes;
+      if (buffer.scope() == "global.vtcm") {
+        loop_vtcm_bytes += bytes;
+        vtcm_staging = vtcm_staging || versioned.count(buffer.get());
+      }
+    }
+    if (budget == 0 && vtcm_staging && vtcm_capacity_ > 0) {
+      // The other VTCM buffers of the function are counted as live, as in VerifyVTCMLimit.
+      budget = std::max<int64_t>(vtcm_capacity_ - (vtcm_bytes_ - loop_vtcm_bytes), 1);
+    }
+    while (budget > 0 && num_stages >= 2 && fixed_bytes + versioned_bytes * num_stages > budget) {
+      --num_stages;
+    }
+    if (num_stages < 2) {
+      return false;
+    }
+
+    *async_producers = vtcm_staging && use_async_copy_;
+    for (size_t i = 0; i < is_producer.size(); ++i) {
+      pipeline_stages->push_back(Integer(is_producer[i] ? 0 : num_stages - 1));
+      pipeline_orders->push_back(Integer(static_cast<int>(i)));
+    }
+    return true;
+  }
+
   Stmt VisitStmt_(const ForNode* op) final {
     // Step 1: Recursively rewrite the children first.
     For for_node = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    bool auto_pipeline = false;
     if (!HasPipelineAnnotation(op)) {
-      return std::move(for_node);
+      if (!op->annotations.count(attr::software_pipeline_max_stages)) {
+        return std::move(for_node);
+      }
+      auto_pipeline = true;
     }
     // Step 2: Find the body and buffer allocations of the pipeline. The body can be direct child of
     // the for-loop. If the for-loop has BlockRealize as its child, the pipeline body will be the
@@ -1067,7 +1200,24 @@ class PipelineInjector : private StmtExprMutator {
       pipeline_body = for_node->body;
     }
 
+    // Loops which cannot be pipelined automatically are left unchanged.
+    auto f_skip_auto_pipeline = [&]() {
+      if (const auto* realize = op->body.as<BlockRealizeNode>()) {
+        for (const auto& buffer : realize->block->alloc_buffers) {
+          buffer_data_to_buffer_.erase(buffer->data);
+        }
+      }
+      For::ContainerType* n = for_node.CopyOnWrite();
+      n->annotations.erase(attr::software_pipeline_max_stages);
+      n->annotations.erase(attr::software_pipeline_shared_memory_bytes);
+      n->annotations.erase(attr::software_pipeline_async_stages);
+      return std::move(for_node);
+    };
+
     const SeqStmtNode* pipeline_body_seq = pipeline_body.as<SeqStmtNode>();
+    if (auto_pipeline && pipeline_body_seq == nullptr) {
+      return f_skip_auto_pipeline();
+    }
     CHECK(pipeline_body_seq)
         << "ValueError: The body of the software pipeline should be SeqStmt, got "
         << pipeline_body->GetTypeKey();
@@ -1100,10 +1250,18 @@ class PipelineInjector : private StmtExprMutator {
       }
     }
 
-    auto pipeline_stages =
-        Downcast<Array<Integer>>(op->annotations.at(attr::software_pipeline_stage));
-    auto pipeline_orders =
-        Downcast<Array<Integer>>(op->annotations.at(attr::software_pipeline_order));
+    Array<Integer> pipeline_stages;
+    Array<Integer> pipeline_orders;
+    bool async_producers = false;
+    if (auto_pipeline) {
+      if (!MakeAutoPipelineAnnotation(op, original_order, pipeline_allocs, &pipeline_stages,
+                                      &pipeline_orders, &async_producers)) {
+        return f_skip_auto_pipeline();
+      }
+    } else {
+      pipeline_stages = Downcast<Array<Integer>>(op->annotations.at(attr::software_pipeline_stage));
+      pipeline_orders = Downcast<Array<Integer>>(op->annotations.at(attr::software_pipeline_order));
+    }
     CHECK_EQ(pipeline_stages.size(), original_order.size())
         << "PrimFunc " << global_symbol_ << " has original order "
         << original_order.Map([](const auto& block) { return block->name_hint; })
@@ -1118,13 +1276,17 @@ class PipelineInjector : private StmtExprMutator {
       for (auto s : Downcast<Array<Integer>>(annot)) {
         pipeline_async_stages.insert(s->value);
       }
+    } else if (async_producers) {
+      pipeline_async_stages.insert(0);
     }
 
     Map<String, ObjectRef> preserved_annotations;
     for (const auto& kv : op->annotations) {
       const String& key = kv.first;
       if (kv.first != attr::software_pipeline_stage && kv.first != attr::software_pipeline_order &&
-          kv.first != attr::software_pipeline_async_stages) {
+          kv.first != attr::software_pipeline_async_stages &&
+          kv.first != attr::software_pipeline_max_stages &&
+          kv.first != attr::software_pipeline_shared_memory_bytes) {
         preserved_annotations.Set(key, kv.second);
       }
     }
@@ -1213,6 +1375,11 @@ class PipelineInjector : private StmtExprMutator {
   std::unordered_map<const VarNode*, FragmentInfo> fragment_info_;
   std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual> double_buffers;
   Optional<String> global_symbol_;
+  /*! \brief The VTCM capacity of the target, 0 when unknown. */
+  int64_t vtcm_capacity_{0};
+  /*! \brief The number of bytes of all the VTCM buffers allocated by the function. */
+  int64_t vtcm_bytes_{0};
+  bool use_async_copy_{false};
 };
 
 }  // namespace software_pipeline
@@ -44,6 +44,8 @@ struct LoopPartitionConfigNode : public tvm::AttrsNode<LoopPartitionConfigNode>
   bool partition_const_loop;
   bool no_unroll_loop_with_extent_one;
   bool unroll_loop_with_partition_hint_no_interval;
+  int max_variants;
+  int max_code_size;
 
   TVM_DECLARE_ATTRS(LoopPartitionConfigNode, "tir.transform.LoopPartitionConfig") {
     TVM_ATTR_FIELD(partition_const_loop).describe("Split constant loop").set_default(false);
@@ -53,6 +55,14 @@ struct LoopPartitionConfigNode : public tvm::AttrsNode<LoopPartitionConfigNode>
     TVM_ATTR_FIELD(unroll_loop_with_partition_hint_no_interval)
         .describe("Unroll loops with pragma_loop_partition_hint and no interval")
         .set_default(false);
+    TVM_ATTR_FIELD(max_variants)
+        .describe("Maximum number of loop variants generated per function, -1 means unlimited")
+        .set_default(-1);
+    TVM_ATTR_FIELD(max_code_size)
+        .describe(
+            "Maximum estimated code size, in IR nodes, of a function after partitioning, "
+            "-1 means unlimited")
+        .set_default(-1);
   }
 };
 
@@ -382,10 +392,21 @@ class ThreadPartitionInserter : public StmtMutator {
 class LoopPartitioner : public StmtMutator {
  public:
   explicit LoopPartitioner(bool partition_const_loop, bool no_unroll_loop_with_extent_one,
-                           bool unroll_loop_with_partition_hint_no_interval)
+                           bool unroll_loop_with_partition_hint_no_interval,
+                           int64_t max_variants = -1, int64_t max_code_size = -1)
       : selector(CandidateSelector(partition_const_loop)),
         no_unroll_loop_with_extent_one_(no_unroll_loop_with_extent_one),
-        unroll_loop_with_partition_hint_no_interval_(unroll_loop_with_partition_hint_no_interval) {}
+        unroll_loop_with_partition_hint_no_interval_(unroll_loop_with_partition_hint_no_interval),
+        max_variants_(max_variants),
+        max_code_size_(max_code_size) {}
+
+  /*! \brief Partition stmt, the whole body of a function, within the variant and size budget. */
+  Stmt Run(Stmt stmt) {
+    if (max_code_size_ >= 0) {
+      code_size_ = EstimateCodeSize(stmt);
+    }
+    return VisitAndMutate(std::move(stmt));
+  }
 
   Stmt VisitAndMutate(Stmt stmt) {
     selector(stmt);
@@ -448,6 +469,18 @@ class LoopPartitioner : public StmtMutator {
 
   inline Stmt MakeFor(const Object* op, PrimExpr extent, Stmt body);
 
+  /*!
+   * \brief Charge num_copies extra copies of body to the partitioning budget.
+   * \return false, without charging, if the copies would exceed the budget.
+   */
+  bool ConsumeBudget(int64_t num_copies, const Stmt& body);
+
+  static int64_t EstimateCodeSize(const Stmt& stmt) {
+    int64_t size = 0;
+    PostOrderVisit(stmt, [&size](const ObjectRef&) { ++size; });
+    return size;
+  }
+
   /* Candidate IRs that may be partitioned potentially */
   std::unordered_map<const VarNode*, IntSet> hint_map_;
   std::unordered_map<const VarNode*, IntSet> relax_map_;
@@ -455,8 +488,23 @@ class LoopPartitioner : public StmtMutator {
   CandidateSelector selector;
   bool no_unroll_loop_with_extent_one_;
   bool unroll_loop_with_partition_hint_no_interval_;
+  /*! \brief Budget of generated loop variants and estimated code size, -1 means unlimited. */
+  int64_t max_variants_;
+  int64_t max_code_size_;
+  int64_t num_variants_{0};
+  int64_t code_size_{0};
 };
 
+bool LoopPartitioner::ConsumeBudget(int64_t num_copies, const Stmt& body) {
+  if (num_copies == 0) return true;
+  if (max_variants_ >= 0 && num_variants_ + num_copies > max_variants_) return false;
+  int64_t size = max_code_size_ >= 0 ? EstimateCodeSize(body) * num_copies : 0;
+  if (max_code_size_ >= 0 && code_size_ + size > max_code_size_) return false;
+  num_variants_ += num_copies;
+  code_size_ += size;
+  return true;
+}
+
 // Returns an interval (in the first component) in which all the conditions
 // given in the second component provably have value given by cond_value
 std::pair<IntSet, ExpressionSet> LoopPartitioner::GetIntervalAndCondset(
@@ -661,6 +709,16 @@ Stmt LoopPartitioner::TryPartition(const Stmt& stmt, Var var, PrimExpr min, Prim
     post_doubt_begin = max + 1;
   }
 
+  // Every subrange besides the middle one copies the body. Once the budget is
+  // exhausted the loop is left whole, and rare edge subranges of an already
+  // partitioned loop keep their predicated bodies.
+  if (!partition_thread_scope &&
+      !ConsumeBudget(static_cast<int64_t>(pre_stmt.defined()) +
+                         static_cast<int64_t>(post_stmt.defined()),
+                     body)) {
+    return Stmt();
+  }
+
   Stmt s;
 
   // Generating code for middle subrange
@@ -729,10 +787,11 @@ class RemoveLikelyTagsAndHints : public StmtExprMutator {
 };
 
 Stmt LoopPartition(Stmt stmt, bool partition_const_loop, bool no_unroll_loop_with_extent_one,
-                   bool unroll_loop_with_partition_hint_no_interval) {
+                   bool unroll_loop_with_partition_hint_no_interval, int64_t max_variants = -1,
+                   int64_t max_code_size = -1) {
   stmt = LoopPartitioner(partition_const_loop, no_unroll_loop_with_extent_one,
-                         unroll_loop_with_partition_hint_no_interval)
-             .VisitAndMutate(std::move(stmt));
+                         unroll_loop_with_partition_hint_no_interval, max_variants, max_code_size)
+             .Run(std::move(stmt));
   stmt = RemoveLikelyTagsAndHints()(std::move(stmt));
   return stmt;
 }
@@ -746,12 +805,21 @@ Pass LoopPartition() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<LoopPartitionConfig>();
     }
+    int64_t max_variants =
+        f->GetAttr<Integer>(attr::kLoopPartitionMaxVariants, Integer(cfg.value()->max_variants))
+            .value()
+            ->value;
+    int64_t max_code_size =
+        f->GetAttr<Integer>(attr::kLoopPartitionMaxCodeSize, Integer(cfg.value()->max_code_size))
+            .value()
+            ->value;
     n->body = LoopPartition(std::move(n->body), cfg.value()->partition_const_loop,
                             cfg.value()->no_unroll_loop_with_extent_one,
-                            cfg.value()->unroll_loop_with_partition_hint_no_interval);
+                            cfg.value()->unroll_loop_with_partition_hint_no_interval, max_variants,
+                            max_code_size);
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LoopPartition", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.LoopPartition", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LoopPartition").set_body_typed(LoopPartition);
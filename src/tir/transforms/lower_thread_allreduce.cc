@@ -82,6 +82,21 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       return StmtExprMutator::VisitStmt_(op);
     }
   }
+  Stmt VisitStmt_(const ForNode* op) final {
+    // Only the loops inside of a kernel run the same reduction several times.
+    int in_kernel = thread_extents_.empty() ? 0 : 1;
+    loop_depth_ += in_kernel;
+    Stmt ret = StmtExprMutator::VisitStmt_(op);
+    loop_depth_ -= in_kernel;
+    return ret;
+  }
+  Stmt VisitStmt_(const WhileNode* op) final {
+    int in_kernel = thread_extents_.empty() ? 0 : 1;
+    loop_depth_ += in_kernel;
+    Stmt ret = StmtExprMutator::VisitStmt_(op);
+    loop_depth_ -= in_kernel;
+    return ret;
+  }
   Stmt VisitStmt_(const EvaluateNode* op) final {
     Stmt stmt = StmtExprMutator::VisitStmt_(op);
     op = stmt.as<EvaluateNode>();
@@ -126,7 +141,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     {
       auto it = buf_remap_.find(op->buffer.get());
       if (it != buf_remap_.end()) {
-        return BufferLoad(it->second, op->indices, op->span);
+        return BufferLoad(it->second, op->indices, op->predicate, op->span);
       }
     }
 
@@ -139,7 +154,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
                                op->buffer->buffer_type, op->buffer->axis_separators,
                                op->buffer->span);
         buf_remap_[op->buffer.get()] = remapped_buffer;
-        return BufferLoad(remapped_buffer, op->indices, op->span);
+        return BufferLoad(remapped_buffer, op->indices, op->predicate, op->span);
       }
     }
     return StmtExprMutator::VisitExpr_(op);
@@ -162,7 +177,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     {
       auto it = buf_remap_.find(store->buffer.get());
       if (it != buf_remap_.end()) {
-        return BufferStore(it->second, store->value, store->indices, store->span);
+        return BufferStore(it->second, store->value, store->indices, store->predicate, store->span);
       }
     }
 
@@ -175,7 +190,8 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
                                store->buffer->offset_factor, store->buffer->buffer_type,
                                store->buffer->axis_separators, store->buffer->span);
         buf_remap_[store->buffer.get()] = remapped_buffer;
-        return BufferStore(remapped_buffer, store->value, store->indices, store->span);
+        return BufferStore(remapped_buffer, store->value, store->indices, store->predicate,
+                           store->span);
       }
     }
 
@@ -304,6 +320,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     std::vector<Var> shared_buffer_vars(size);
     std::vector<Buffer> shared_bufs(size);
     std::vector<Buffer> local_bufs;
+    std::vector<Buffer> staging_bufs;
     //
     // This is an optimization. For small reduction sizes, it may be beneficial
     // for a single warp to performance the entire reduction. No trips to shared
@@ -321,8 +338,24 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     // broadcast results from lane 0 to all other lanes and store
     // the final reduction result to the proper location.
     //
-    if (is_warp_reduction(types, group_extent, reduce_extent, contiguous_reduce_extent)) {
-      ICHECK_LE(reduce_extent, warp_size_) << "not a warp reduction";
+    // Larger reductions whose extent is a multiple of the warp size are
+    // done in two phases, with a single barrier in between:
+    //
+    //   reduce v[i] within each warp as above
+    //   if lane == 0: staging[i][warp_id] <- v[i]
+    //   sync
+    //   v[i] <- lane < num_warps ? staging[i][lane] : identity
+    //   reduce v[i] within each warp as above, and broadcast from lane 0
+    //
+    // Every warp redundantly does the second phase, so that no second
+    // barrier is needed before the result is read.
+    //
+    bool warp_reduction =
+        is_warp_reduction(types, group_extent, reduce_extent, contiguous_reduce_extent);
+    bool multi_warp_reduction =
+        !warp_reduction && is_multi_warp_reduction(types, reduce_extent, contiguous_reduce_extent);
+    if (warp_reduction || multi_warp_reduction) {
+      ICHECK(multi_warp_reduction || reduce_extent <= warp_size_) << "not a warp reduction";
       //
       // This is the index to the reduction variable, one reduction
       // variable per warp. Local scope seems easier to reason without
@@ -354,7 +387,8 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       Buffer mask_buffer = decl_buffer({1}, mask_dtype, "mask");
       {
         PrimExpr mask = Call(mask_dtype, builtin::tvm_warp_activemask(), {});
-        if (group_extent > 1) {
+        // With multiple warps, every warp belongs to a single group.
+        if (group_extent > 1 && warp_reduction) {
           mask = mask & (((1 << reduce_extent) - 1) << (reduce_extent * group_index));
         }
         seq.emplace_back(BufferStore(mask_buffer, mask, zero_indices));
@@ -363,65 +397,38 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         local_bufs.push_back(mask_buffer);
       }
 
-      // Emit reductions within a warp.
-      int start_offset = 1;
-      while (start_offset * 2 < reduce_extent) {
-        start_offset *= 2;
-      }
-      for (int offset = start_offset; offset > 0; offset /= 2) {
-        // Load reduction values, no synchronization needed.
-        Array<PrimExpr> a, b;
-        for (size_t i = 0; i < size; ++i) {
-          Buffer shared_buf = shared_bufs[i];
-          BufferLoad val(shared_buf, zero_indices);
-          ICHECK_EQ(val->dtype, types[i]);
-          a.push_back(val);
-
-          // __shfl_*sync calls shall not appear in if_then_else expressions
-          // as this is causing extra divergency. E.g.
-          //
-          // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
-          //
-          // behaves differently from
-          //
-          // int t = __shfl_sync(mask, v1, 0);
-          // v1 = (v2 < v3) ? v3 : t;
-          //
-          // The former may cause dead lock as there is a divergent
-          // branch with a warp sync call inside.
-          //
-          PrimExpr other = WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_buffer, val, offset);
-          Buffer local_buf = local_bufs[i];
-          Stmt s = BufferStore(local_buf, other, zero_indices);
-          seq.push_back(s);
-
-          BufferLoad load = BufferLoad(local_buf, zero_indices);
-          ICHECK_EQ(load->dtype, types[i]);
-          b.push_back(load);
+      PrimExpr broadcast_lane = reduce_extent * group_index;
+      if (warp_reduction) {
+        EmitWarpReduce(combiner, shared_bufs, local_bufs, mask_buffer, reduce_index, reduce_extent,
+                       &seq);
+      } else {
+        int num_warps = reduce_extent / warp_size_;
+        PrimExpr lane = floormod(reduce_index, warp_size_);
+        PrimExpr warp_id = floordiv(reduce_index, warp_size_);
+        // The staging buffer may still be read by other warps in the
+        // previous iteration of a surrounding loop.
+        if (loop_depth_ > 0) {
+          seq.insert(seq.begin(), SyncThread("shared"));
         }
+        EmitWarpReduce(combiner, shared_bufs, local_bufs, mask_buffer, lane, warp_size_, &seq);
 
-        // Do reductions.
-        Array<PrimExpr> ret = (*combiner)(a, b);
-
-        // Store the reduction result to itself.
-        std::vector<Stmt> stores(size);
+        std::vector<Stmt> stores;
         for (size_t i = 0; i < size; ++i) {
-          Buffer buf = shared_bufs[i];
-          stores[i] = BufferStore(buf, ret[i], zero_indices);
+          Buffer staging_buf = decl_buffer({group_extent * num_warps}, types[i],
+                                           "red_buf_staging" + std::to_string(i));
+          staging_bufs.push_back(staging_buf);
+          stores.push_back(BufferStore(staging_buf, BufferLoad(shared_bufs[i], zero_indices),
+                                       {BufIndex(warp_id, group_index, num_warps)}));
         }
-
-        // During the sub-warp reduction, values from inactive threads could be read,
-        // which is an undefined behavior according to the cuda document.
-        //
-        // In practise, the return value are usually 0, which does no harm to sum reduction.
-        // However, the result can be incorrect in max or prod reduction.
-        // Therefore an additional range check has to be performed to ensure the correctness.
-        if (offset * 2 > reduce_extent) {
-          PrimExpr cond = reduce_index + offset < reduce_extent;
-          seq.push_back(IfThenElse(cond, SeqStmt::Flatten(stores)));
-        } else {
-          seq.push_back(SeqStmt::Flatten(stores));
+        seq.push_back(IfThenElse(lane == 0, SeqStmt::Flatten(stores)));
+        seq.emplace_back(SyncThread("shared"));
+        for (size_t i = 0; i < size; ++i) {
+          PrimExpr partial = BufferLoad(staging_bufs[i], {BufIndex(lane, group_index, num_warps)});
+          partial = if_then_else(lane < num_warps, partial, inits[i]);
+          seq.push_back(BufferStore(shared_bufs[i], partial, zero_indices));
         }
+        EmitWarpReduce(combiner, shared_bufs, local_bufs, mask_buffer, lane, num_warps, &seq);
+        broadcast_lane = 0;
       }
 
       // Broadcast the reduction result from lane 0 to all other lanes.
@@ -432,8 +439,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         Buffer buf = shared_bufs[i];
         PrimExpr val = BufferLoad(buf, zero_indices);
         ICHECK_EQ(val->dtype, types[i]);
-        PrimExpr splat =
-            WarpShuffle(builtin::tvm_warp_shuffle(), mask_buffer, val, reduce_extent * group_index);
+        PrimExpr splat = WarpShuffle(builtin::tvm_warp_shuffle(), mask_buffer, val, broadcast_lane);
         seq.push_back(BufferStore(buf, splat, zero_indices));
       }
 
@@ -498,10 +504,81 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
       new_storage_scopes_[buf->data.get()] = "local";
     }
+    for (Buffer buf : staging_bufs) {
+      body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
+      new_storage_scopes_[buf->data.get()] = "shared";
+    }
 
     return body;
   }
 
+  // Emit the shuffle down steps reducing the values of reduce_extent
+  // contiguous lanes into the first of them, within a warp.
+  void EmitWarpReduce(const CommReducerNode* combiner, const std::vector<Buffer>& shared_bufs,
+                      const std::vector<Buffer>& local_bufs, Buffer mask_buffer,
+                      PrimExpr reduce_index, int reduce_extent, std::vector<Stmt>* out_seq) {
+    std::vector<Stmt>& seq = *out_seq;
+    size_t size = shared_bufs.size();
+    Array<PrimExpr> zero_indices = {0};
+    int start_offset = 1;
+    while (start_offset * 2 < reduce_extent) {
+      start_offset *= 2;
+    }
+    for (int offset = start_offset; offset > 0; offset /= 2) {
+      // Load reduction values, no synchronization needed.
+      Array<PrimExpr> a, b;
+      for (size_t i = 0; i < size; ++i) {
+        Buffer shared_buf = shared_bufs[i];
+        BufferLoad val(shared_buf, zero_indices);
+        a.push_back(val);
+
+        // __shfl_*sync calls shall not appear in if_then_else expressions
+        // as this is causing extra divergency. E.g.
+        //
+        // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
+        //
+        // behaves differently from
+        //
+        // int t = __shfl_sync(mask, v1, 0);
+        // v1 = (v2 < v3) ? v3 : t;
+        //
+        // The former may cause dead lock as there is a divergent
+        // branch with a warp sync call inside.
+        //
+        PrimExpr other = WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_buffer, val, offset);
+        Buffer local_buf = local_bufs[i];
+        Stmt s = BufferStore(local_buf, other, zero_indices);
+        seq.push_back(s);
+
+        BufferLoad load = BufferLoad(local_buf, zero_indices);
+        b.push_back(load);
+      }
+
+      // Do reductions.
+      Array<PrimExpr> ret = (*combiner)(a, b);
+
+      // Store the reduction result to itself.
+      std::vector<Stmt> stores(size);
+      for (size_t i = 0; i < size; ++i) {
+        Buffer buf = shared_bufs[i];
+        stores[i] = BufferStore(buf, ret[i], zero_indices);
+      }
+
+      // During the sub-warp reduction, values from inactive threads could be read,
+      // which is an undefined behavior according to the cuda document.
+      //
+      // In practise, the return value are usually 0, which does no harm to sum reduction.
+      // However, the result can be incorrect in max or prod reduction.
+      // Therefore an additional range check has to be performed to ensure the correctness.
+      if (offset * 2 > reduce_extent) {
+        PrimExpr cond = reduce_index + offset < reduce_extent;
+        seq.push_back(IfThenElse(cond, SeqStmt::Flatten(stores)));
+      } else {
+        seq.push_back(SeqStmt::Flatten(stores));
+      }
+    }
+  }
+
   // make allreduce.
   Stmt MakeBufAllreduce(const CommReducerNode* combiner, const std::vector<DataType>& types,
                         const Array<Buffer>& shared_bufs, PrimExpr reduce_index,
@@ -650,6 +727,15 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     Array<PrimExpr> indices = {0};
     PrimExpr mask = BufferLoad(mask_buffer, indices);
     PrimExpr width = IntImm(DataType::Int(32), warp_size_);
+    if (val.dtype().is_vector() && !val.dtype().is_float16()) {
+      // Shuffle the vector element by element, half2 is shuffled as a whole.
+      Array<PrimExpr> elems;
+      for (int i = 0; i < val.dtype().lanes(); ++i) {
+        PrimExpr elem = Shuffle::ExtractElement(val, i);
+        elems.push_back(WarpShuffle(op, mask_buffer, elem, delta_or_lane));
+      }
+      return Shuffle::Concat(elems);
+    }
     Array<PrimExpr> args{mask, val, delta_or_lane, width, width};
     return Call(val.dtype(), op, args);
   }
@@ -660,11 +746,14 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
   // Also, the warp/wavefront size differs (64 on rocm, 32 on cuda).
   bool is_warp_reduction(const std::vector<DataType>& types, int group_extent, int reduce_extent,
                          int contiguous_reduce_extent) const {
-    // Only cuda target supports warp reductions.
-    if ((target_->kind->name != "cuda") && (target_->kind->name != "rocm")) return false;
+    // Only cuda, rocm and webgpu with subgroups support warp reductions.
+    if ((target_->kind->name != "cuda") && (target_->kind->name != "rocm") &&
+        !is_webgpu_subgroup_target()) {
+      return false;
+    }
 
-    // rocm only supports 32 bit operands for shuffling at the moment
-    if ((target_->kind->name == "rocm") &&
+    // rocm and WGSL subgroups only support 32 bit operands for shuffling at the moment
+    if ((target_->kind->name == "rocm" || target_->kind->name == "webgpu") &&
         (std::any_of(types.begin(), types.end(), [](DataType ty) {
           if (ty.is_vector()) return true;
           return ty.bits() != 32;
@@ -672,16 +761,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       return false;
     }
 
-    // Supported types:
-    // {u}int, {u}long, {u}long long, float, double, half/half2
-    if (std::any_of(types.begin(), types.end(), [](DataType ty) {
-          if (ty.is_float16()) return ty.lanes() > 2;
-          if (ty.is_vector()) return true;
-          return ty.bytes() < 4 || ty.bytes() > 8;
-        })) {
-      return false;
-    }
-    if (thread_extents_.empty()) {
+    if (!is_shuffle_supported(types) || thread_extents_.empty()) {
       return false;
     }
 
@@ -693,7 +773,7 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     // whether reduce_extent and group_extent are vaild for warp reduction.
     if (target_->kind->name == "rocm") {
       return reduce_extent == warp_size_;
-    } else {  // target_->kind->name == "cuda"
+    } else {  // target_->kind->name == "cuda" or "webgpu"
       if (reduce_extent == 1) {
         return false;  // no need to warp reduce
       } else {
@@ -706,6 +786,45 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     }
   }
 
+  // Check if the reduction can be done within each warp, and then across
+  // the warps through shared memory.
+  bool is_multi_warp_reduction(const std::vector<DataType>& types, int reduce_extent,
+                               int contiguous_reduce_extent) const {
+    if (target_->kind->name != "cuda" && !is_webgpu_subgroup_target()) return false;
+    if (!is_shuffle_supported(types) || thread_extents_.empty()) {
+      return false;
+    }
+    if (target_->kind->name == "webgpu" &&
+        std::any_of(types.begin(), types.end(), [](DataType ty) { return ty.bits() != 32; })) {
+      return false;
+    }
+    // reduce region must be contiguous, so that every warp belongs to
+    // a single group.
+    if (contiguous_reduce_extent != reduce_extent || reduce_extent % warp_size_ != 0) {
+      return false;
+    }
+    // the partial results of all the warps are reduced by a single warp.
+    return reduce_extent > warp_size_ && reduce_extent <= warp_size_ * warp_size_;
+  }
+
+  // Check if the target is webgpu with subgroup operations, which implement
+  // the warp shuffles with a subgroup of thread_warp_size invocations.
+  bool is_webgpu_subgroup_target() const {
+    return target_->kind->name == "webgpu" && warp_size_ > 1 &&
+           target_->GetAttr<Bool>("supports_subgroups").value_or(Bool(false));
+  }
+
+  // Supported types:
+  // {u}int, {u}long, {u}long long, float, double, half/half2,
+  // and vectors of up to 4 of the 32 and 64 bits types.
+  static bool is_shuffle_supported(const std::vector<DataType>& types) {
+    return std::none_of(types.begin(), types.end(), [](DataType ty) {
+      if (ty.is_float16()) return ty.lanes() > 2;
+      if (ty.lanes() > 4) return true;
+      return ty.element_of().bytes() < 4 || ty.element_of().bytes() > 8;
+    });
+  }
+
   // The target.
   const TargetNode* target_ = nullptr;
 
@@ -727,6 +846,8 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
   std::unordered_map<const BufferNode*, Buffer> buf_remap_;
   // Allocate from warp reductions
   std::unordered_set<const void*> warp_allocs_;
+  // The number of loops surrounding the reduction in the kernel
+  int loop_depth_{0};
   // Internal analyzer
   arith::Analyzer analyzer_;
 };
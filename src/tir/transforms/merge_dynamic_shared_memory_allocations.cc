@@ -27,11 +27,12 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "../../runtime/thread_storage_scope.h"
-#include "../../support/arena.h"
 #include "ir_utils.h"
 
 namespace tvm {
@@ -40,6 +41,35 @@ namespace tir {
 using runtime::StorageRank;
 using runtime::StorageScope;
 
+struct MergeDynamicSharedMemoryAllocationsConfigNode
+    : public tvm::AttrsNode<MergeDynamicSharedMemoryAllocationsConfigNode> {
+  int align_bytes;
+  int swizzle_pad_bytes;
+
+  TVM_DECLARE_ATTRS(MergeDynamicSharedMemoryAllocationsConfigNode,
+                    "tir.transform.MergeDynamicSharedMemoryAllocationsConfig") {
+    TVM_ATTR_FIELD(align_bytes)
+        .describe("The minimum alignment of the offset of each buffer, on top of its dtype")
+        .set_default(0);
+    TVM_ATTR_FIELD(swizzle_pad_bytes)
+        .describe(
+            "Padding added after each buffer whose size is a multiple of the 128 bytes of a "
+            "shared memory bank row, so that buffers packed next to each other start in "
+            "different banks")
+        .set_default(0);
+  }
+};
+
+class MergeDynamicSharedMemoryAllocationsConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(MergeDynamicSharedMemoryAllocationsConfig, Attrs,
+                                            MergeDynamicSharedMemoryAllocationsConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(MergeDynamicSharedMemoryAllocationsConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.MergeDynamicSharedMemoryAllocations",
+                                MergeDynamicSharedMemoryAllocationsConfig);
+
 bool IsDynamicSharedMemory(Var buffer_var) {
   StorageScope storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
   return storage_scope.rank == runtime::StorageRank::kShared && storage_scope.tag == ".dyn";
@@ -225,12 +255,17 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
 
 /*!
  * \brief merge the buffers whose live range has no intersection and rewrite the body
+ *
+ * The buffers of constant size are packed by their live intervals: from the largest to the
+ * smallest, each buffer is put at the lowest aligned offset that does not overlap a buffer
+ * already placed and live at the same time. The buffers of symbolic size follow, without reuse.
  */
 class DynamicSharedMemoryRewriter : public StmtExprMutator {
  public:
-  explicit DynamicSharedMemoryRewriter(
-      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs)
-      : dyn_shmem_allocs_{dyn_shmem_allocs} {}
+  DynamicSharedMemoryRewriter(
+      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs,
+      const MergeDynamicSharedMemoryAllocationsConfig& config)
+      : dyn_shmem_allocs_{dyn_shmem_allocs}, config_{config} {}
 
   /*!
    * \brief plan the memory reuse for all the buffer allocated in the statement
@@ -247,43 +282,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == attr::thread_extent && !allocated_) {
       // Allocate one dynamic shared memory allocation at the beginning of thread scope
-      int max_layer_num = 0;
-      std::vector<const StorageEntry*> all_entry;
-      for (const auto& e : const_free_map_) {
-        all_entry.push_back(e.second);
-      }
-      for (const StorageEntry* e : sym_free_list_) {
-        all_entry.push_back(e);
-      }
-      for (const StorageEntry* e : all_entry) {
-        max_layer_num = std::max(max_layer_num, static_cast<int>(e->allocs.size()));
-      }
-      // calculate align for each layer of each storage entry.
-      std::vector<int> align(max_layer_num, 0);
-      for (const StorageEntry* e : all_entry) {
-        for (int i = 0; i < static_cast<int>(e->allocs.size()); i++) {
-          for (const VarNode* buffer : e->allocs[i]) {
-            const AllocateNode* alloc = dyn_shmem_allocs_[buffer];
-            align[i] = std::max(align[i], alloc->dtype.bytes());
-          }
-        }
-      }
-      // calculate offset for each buffer based on the align of each layer
-      for (const StorageEntry* e : all_entry) {
-        PrimExpr max_inner_offset = 0;
-        for (int i = 0; i < static_cast<int>(e->allocs.size()); i++) {
-          PrimExpr inner_offset = 0;
-          for (const VarNode* buffer : e->allocs[i]) {
-            const AllocateNode* alloc = dyn_shmem_allocs_[buffer];
-            buffer_byte_offsets_[buffer] = merged_alloc_size_ + inner_offset;
-            inner_offset += alloc->extents[0] * alloc->dtype.bytes();
-            inner_offset += indexmod(align[i] - indexmod(inner_offset, align[i]), align[i]);
-          }
-          max_inner_offset = max(max_inner_offset, inner_offset);
-        }
-        merged_alloc_size_ += max_inner_offset;
-      }
-
+      PackBuffers();
       allocated_ = true;
       Allocate new_body(merged_buf_var_, DataType::UInt(8), {merged_alloc_size_}, const_true(),
                         StmtExprMutator::VisitStmt(op->body));
@@ -373,17 +372,6 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   }
 
   using StmtEntry = DynSharedMemLinearAccessPatternFinder::StmtEntry;
-  struct StorageEntry {
-    // The constant size of the buffer in bits, only used if it is constant
-    uint64_t const_nbits{0};
-    // Allocs that shares this entry.
-    // The inner vector means a "layer"
-    // For example, it we need to allocate C in the memory of A and B:
-    // |  A: 4096 bytes |  B: 4096 bytes |
-    // |            C: 8192 bytes        |
-    // Then the allocs = {{A, B}, {C}}
-    std::vector<std::vector<const VarNode*>> allocs;
-  };
 
   // Event entry in liveness analysis
   struct EventEntry {
@@ -393,6 +381,12 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
     std::vector<const VarNode*> kill;
   };
 
+  // The live interval of a buffer, both ends included
+  struct LiveRange {
+    int64_t gen{0};
+    int64_t kill{std::numeric_limits<int64_t>::max()};
+  };
+
   /*!
    * \brief Liveness analysis to find gen and kill point of each variable.
    * \param seq the linear pattern of storage access
@@ -425,150 +419,122 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   }
 
   /*!
-   * \brief Memory plan algorithm
+   * \brief Memory plan algorithm, computing the live interval of each buffer.
+   *
+   * The kill events of a statement happen before its gen events, so that a buffer last read
+   * by a statement can be reused by the buffer it writes.
    * \param seq the linear pattern of storage access
-   * \param alloc_info
    */
   void PlanMemory(const std::vector<StmtEntry>& seq) {
-    std::unordered_set<const VarNode*> inplace_flag;
-
     for (size_t i = 0; i < seq.size(); ++i) {
       auto it = event_map_.find(seq[i].stmt);
+      if (it == event_map_.end()) continue;
+      int64_t time = static_cast<int64_t>(i) * 2;
       // scope_pair_offset <= 0 means it is either
       // - leaf stmt(offset = 0)
       // - end of scope(offset < 0)
       // In both cases, we need to handle the kill event correctly
-      if (it != event_map_.end() && seq[i].scope_pair_offset <= 0) {
+      if (seq[i].scope_pair_offset <= 0) {
         for (const VarNode* var : it->second.kill) {
-          this->Free(var);
+          live_ranges_[var].kill = time;
         }
       }
       // scope_pair_offset >= 0 means it is either
       // - leaf stmt(offset = 0)
       // - beginning of scope(offset < 0)
       // In both cases, we need to handle the gen event correctly
-      if (it != event_map_.end() && seq[i].scope_pair_offset >= 0) {
+      if (seq[i].scope_pair_offset >= 0) {
         for (const VarNode* var : it->second.gen) {
           ICHECK(dyn_shmem_allocs_.count(var));
-          const AllocateNode* alloc = dyn_shmem_allocs_[var];
-          StorageEntry* dst_entry = FindAlloc(alloc);
-          alloc_map_[var] = dst_entry;
+          live_ranges_[var].gen = time + 1;
         }
       }
     }
-  }
-  /*!
-   * \brief Allocate new storage entry.
-   * \param op the allocate node
-   * \param the size of the allocation in bits
-   * \return the new storage entry
-   */
-  StorageEntry* NewAlloc(const AllocateNode* op, size_t const_nbits) {
-    ICHECK(op != nullptr);
-    // Re-use not successful, allocate a new buffer.
-    StorageEntry* entry = arena_.make<StorageEntry>();
-    entry->allocs.push_back({op->buffer_var.get()});
-    entry->const_nbits = const_nbits;
-    return entry;
-  }
-  /*!
-   * \brief find the storage entry in the free list for the allocate
-   * \param op the allocate node
-   * \return the storage entry
-   */
-  StorageEntry* FindAlloc(const AllocateNode* op) {
-    ICHECK(op != nullptr);
-    // skip plan for local variable,
-    // compiler can do a better job with register allocation.
-    const uint64_t match_range = 16;
-    uint64_t op_elem_bits = op->dtype.bits() * op->dtype.lanes();
-    uint64_t const_nbits = static_cast<uint64_t>(op->ConstantAllocationSize() * op_elem_bits);
-    // disable reuse of small arrays, they will be lowered to registers in LLVM
-    // This rules only apply if we are using non special memory
-    if (const_nbits > 0 && const_nbits <= 32) {
-      return NewAlloc(op, const_nbits);
+    for (auto& kv : live_ranges_) {
+      kv.second.kill = std::max(kv.second.kill, kv.second.gen);
     }
+  }
 
-    if (const_nbits != 0) {
-      // constant allocation.
-      auto begin = const_free_map_.lower_bound(0);
-      auto mid = const_free_map_.lower_bound(const_nbits);
-      auto end = const_free_map_.upper_bound(const_nbits * match_range);
-      // Start looking at the buffer that is bigger than the required size first.
-      // If we find one, directly allocate the buffer in its location and remove its entry in the
-      // free list
-      for (auto it = mid; it != end; ++it) {
-        StorageEntry* e = it->second;
-        e->const_nbits = std::max(const_nbits, e->const_nbits);
-        const_free_map_.erase(it);
-        return e;
-      }
-      // Then start looking at smaller buffers.
-      // Keep collecting the buffer until the sum of their size exceeds the buffer to allocate
-      // and finally free all these entry in the free list
-      std::vector<std::multimap<uint64_t, StorageEntry*>::iterator> delete_it;
-      // the alloc list for the new entry
-      std::vector<std::vector<const VarNode*>> reuse_allocs;
-      uint64_t mem_ct = 0;
-      for (auto it = mid; it != begin;) {
-        --it;
-        delete_it.push_back(it);
-        mem_ct += it->second->const_nbits;
-        int n = it->second->allocs.size();
-        if (n > static_cast<int>(reuse_allocs.size())) {
-          reuse_allocs.resize(n, {});
-        }
-        for (int i = 0; i < n; i++) {
-          for (const VarNode* alloc : it->second->allocs[i]) {
-            reuse_allocs[i].push_back(alloc);
-          }
-        }
-        if (mem_ct >= const_nbits) {
-          break;
-        }
+  /*! \brief Compute the offset of each buffer in the merged buffer, and its size. */
+  void PackBuffers() {
+    struct Placement {
+      LiveRange range;
+      int64_t offset;
+      int64_t size;
+    };
+    auto align_up = [](int64_t value, int64_t align) {
+      return (value + align - 1) / align * align;
+    };
+    auto f_align = [this](const AllocateNode* alloc) {
+      return std::max<int64_t>(alloc->dtype.bytes() * alloc->dtype.lanes(), config_->align_bytes);
+    };
+
+    std::vector<const AllocateNode*> const_allocs;
+    std::vector<const AllocateNode*> sym_allocs;
+    for (const auto& kv : dyn_shmem_allocs_) {
+      (kv.second->ConstantAllocationSize() != 0 ? const_allocs : sym_allocs).push_back(kv.second);
+    }
+    auto f_size = [this](const AllocateNode* alloc) {
+      int64_t size = alloc->ConstantAllocationSize() * alloc->dtype.bytes() * alloc->dtype.lanes();
+      if (config_->swizzle_pad_bytes > 0 && size % kBankRowBytes == 0) {
+        size += config_->swizzle_pad_bytes;
       }
-      reuse_allocs.push_back({op->buffer_var.get()});
-      if (mem_ct != 0) {
-        StorageEntry* e = arena_.make<StorageEntry>();
-        e->const_nbits = std::max(const_nbits, mem_ct);
-        e->allocs = reuse_allocs;
-        for (auto it : delete_it) {
-          const_free_map_.erase(it);
+      return size;
+    };
+    // Sort for a deterministic output, the larger buffers are harder to fit.
+    std::sort(const_allocs.begin(), const_allocs.end(),
+              [&](const AllocateNode* a, const AllocateNode* b) {
+                int64_t size_a = f_size(a);
+                int64_t size_b = f_size(b);
+                if (size_a != size_b) return size_a > size_b;
+                return GetLiveRange(a).gen < GetLiveRange(b).gen;
+              });
+
+    std::vector<Placement> placed;
+    int64_t const_size = 0;
+    for (const AllocateNode* alloc : const_allocs) {
+      LiveRange range = GetLiveRange(alloc);
+      int64_t size = f_size(alloc);
+      int64_t align = f_align(alloc);
+      std::vector<const Placement*> conflicts;
+      for (const Placement& p : placed) {
+        if (p.range.gen <= range.kill && range.gen <= p.range.kill) {
+          conflicts.push_back(&p);
         }
-        return e;
       }
-    } else {
-      // if its symbolic allocation, just arbitrarily choose one entry to fit in because we don't
-      // know its actual size
-      for (auto it = sym_free_list_.begin(); it != sym_free_list_.end(); ++it) {
-        StorageEntry* e = *it;
-        sym_free_list_.erase(it);
-        return e;
+      std::sort(conflicts.begin(), conflicts.end(),
+                [](const Placement* a, const Placement* b) { return a->offset < b->offset; });
+      int64_t offset = 0;
+      for (const Placement* p : conflicts) {
+        if (offset + size <= p->offset) break;
+        offset = std::max(offset, align_up(p->offset + p->size, align));
       }
+      placed.push_back({range, offset, size});
+      buffer_byte_offsets_[alloc->buffer_var.get()] = Integer(offset);
+      const_size = std::max(const_size, offset + size);
+    }
+    merged_alloc_size_ = Integer(const_size);
+
+    std::sort(sym_allocs.begin(), sym_allocs.end(),
+              [&](const AllocateNode* a, const AllocateNode* b) {
+                return GetLiveRange(a).gen < GetLiveRange(b).gen;
+              });
+    for (const AllocateNode* alloc : sym_allocs) {
+      int align = static_cast<int>(f_align(alloc));
+      merged_alloc_size_ += indexmod(align - indexmod(merged_alloc_size_, align), align);
+      buffer_byte_offsets_[alloc->buffer_var.get()] = merged_alloc_size_;
+      merged_alloc_size_ += alloc->extents[0] * alloc->dtype.bytes() * alloc->dtype.lanes();
     }
-    return NewAlloc(op, const_nbits);
   }
 
-  /*!
-   * \brief add the storage entry to the buffer var into the free list.
-   * \param var the buffer var
-   */
-  void Free(const VarNode* var) {
-    auto it = alloc_map_.find(var);
-    ICHECK(it != alloc_map_.end());
-    StorageEntry* e = it->second;
-    ICHECK_NE(e->allocs.size(), 0U);
-
-    // disable reuse of small arrays
-    if (e->const_nbits > 0 && e->const_nbits <= 32) return;
-
-    // normal free.
-    if (e->const_nbits != 0) {
-      const_free_map_.insert({e->const_nbits, e});
-    } else {
-      sym_free_list_.push_back(e);
-    }
+  LiveRange GetLiveRange(const AllocateNode* alloc) const {
+    // Buffers which are never accessed are kept alive for the whole kernel.
+    auto it = live_ranges_.find(alloc->buffer_var.get());
+    return it == live_ranges_.end() ? LiveRange() : it->second;
   }
+
+  /*! \brief The bytes of a row of the 32 4-byte wide shared memory banks. */
+  static constexpr int64_t kBankRowBytes = 128;
   // The var for the merged buffer
   Var merged_buf_var_{"buf_dyn_shmem", PointerType(PrimType(DataType::UInt(8)), "shared.dyn")};
   // The mapping from the original buffer var to its allocate
@@ -583,21 +549,18 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   bool allocated_{false};
   // Locations of free ops.
   std::unordered_map<const Object*, EventEntry> event_map_;
-  // constant size free map.
-  std::multimap<uint64_t, StorageEntry*> const_free_map_;
-  // symbolic free list, for non constant items.
-  std::list<StorageEntry*> sym_free_list_;
-  // The allocation assign map
-  std::unordered_map<const VarNode*, StorageEntry*> alloc_map_;
-  /*! \brief allocator of all the StorageEntry*/
-  support::Arena arena_;
+  // The live interval of each buffer
+  std::unordered_map<const VarNode*, LiveRange> live_ranges_;
+  // The alignment and padding options
+  MergeDynamicSharedMemoryAllocationsConfig config_;
 };
 
-Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt) {
+Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt,
+                                         const MergeDynamicSharedMemoryAllocationsConfig& config) {
   AllocateCollector collector;
   collector(stmt);
   if (collector.dyn_shmem_allocs_.size() > 1) {
-    DynamicSharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_);
+    DynamicSharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_, config);
     rewriter.PlanReuse(stmt);
     return rewriter(std::move(stmt));
   }
@@ -608,8 +571,13 @@ namespace transform {
 
 Pass MergeDynamicSharedMemoryAllocations() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<MergeDynamicSharedMemoryAllocationsConfig>(
+        "tir.MergeDynamicSharedMemoryAllocations");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<MergeDynamicSharedMemoryAllocationsConfig>();
+    }
     auto* n = f.CopyOnWrite();
-    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body));
+    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body), cfg.value());
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.MergeDynamicSharedMemoryAllocations", {});
@@ -305,7 +305,7 @@ Pass NarrowDataType(int target_bits) {
     n->body = NarrowDataTypeRewriter(target_bits)(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.NarrowDataType", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.NarrowDataType", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.NarrowDataType").set_body_typed(NarrowDataType);
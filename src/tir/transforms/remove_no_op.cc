@@ -313,7 +313,7 @@ Pass RemoveNoOp() {
     }
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.RemoveNoOp").set_body_typed(RemoveNoOp);
@@ -45,6 +45,7 @@ struct SimplifyConfigNode : public tvm::AttrsNode<SimplifyConfigNode> {
   bool propagate_knowns_to_simplify_expressions;
   bool convert_boolean_to_and_of_ors;
   bool apply_constraints_to_boolean_branches;
+  bool memoize_simplifications;
 
   TVM_DECLARE_ATTRS(SimplifyConfigNode, "tir.transform.SimplifyConfig") {
     TVM_ATTR_FIELD(transitively_prove_inequalities)
@@ -72,6 +73,12 @@ struct SimplifyConfigNode : public tvm::AttrsNode<SimplifyConfigNode> {
             "If true, simplify each branch of AND/OR "
             "under a constraints provided by the other branch")
         .set_default(false);
+
+    TVM_ATTR_FIELD(memoize_simplifications)
+        .describe(
+            "If true, reuse the simplification of an expression object while the known facts "
+            "are unchanged")
+        .set_default(false);
   }
 
   RewriteSimplifier::Extension GetEnabledExtensions() const {
@@ -104,6 +111,9 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
   static Stmt Apply(Stmt stmt, Analyzer* analyzer, Optional<SimplifyConfig> config_opt = NullOpt) {
     auto config = config_opt.value_or(AttrsWithDefaultValues<arith::SimplifyConfig>());
     analyzer->rewrite_simplify.SetEnabledExtensions(config->GetEnabledExtensions());
+    if (config->memoize_simplifications) {
+      analyzer->rewrite_simplify.SetMemoizationEnabled(true);
+    }
 
     std::optional<ControlFlowGraph> touch_pattern = std::nullopt;
     if (config->propagate_knowns_to_prove_conditional ||
@@ -277,11 +287,32 @@ Pass Simplify() {
     arith::Analyzer analyzer;
     auto cfg = ctx->GetConfig<arith::SimplifyConfig>("tir.Simplify");
 
+    // The shapes of the buffers are non-negative, and their offsets are multiples of the
+    // offset factor, which lets the bounds of dynamic shapes propagate into the body.
+    PrimExpr buffer_constraints = Bool(true);
+    for (const auto& kv : f->buffer_map) {
+      const Buffer& buffer = kv.second;
+      for (const PrimExpr& dim : buffer->shape) {
+        if (dim->IsInstance<VarNode>() && dim.dtype().is_int()) {
+          buffer_constraints = buffer_constraints && (dim >= make_zero(dim.dtype()));
+        }
+      }
+      if (buffer->elem_offset->IsInstance<VarNode>() && buffer->offset_factor > 1) {
+        PrimExpr factor = make_const(buffer->elem_offset.dtype(), buffer->offset_factor);
+        buffer_constraints =
+            buffer_constraints &&
+            (floormod(buffer->elem_offset, factor) == make_zero(buffer->elem_offset.dtype()));
+      }
+    }
+    With<arith::ConstraintContext> ctx(&analyzer, buffer_constraints);
+
     auto* n = f.CopyOnWrite();
     n->body = arith::StmtSimplifier::Apply(std::move(n->body), &analyzer, cfg);
+    VLOG(1) << "Simplify " << f->GetAttr<String>(tvm::attr::kGlobalSymbol).value_or("<anonymous>")
+            << ": " << analyzer.rewrite_simplify.GetStatsCounters();
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.Simplify").set_body_typed(Simplify);
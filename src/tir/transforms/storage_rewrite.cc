@@ -225,6 +225,9 @@ class LinearAccessPatternFinder final : public StmtExprVisitor {
 //
 // Detect pattern: dst[index] = f(src[index])
 //
+// dst and src may have different element types, as long as the elements
+// are of the same size, so that the same index refers to the same bytes.
+//
 // WARNING: the current detection algorithm cannot handle the case
 // when a location in an array is written multiple times
 //
@@ -325,7 +328,8 @@ class InplaceOpVerifier : public StmtExprVisitor {
       return;
     }
     if (src_ == buf) {
-      if (store_ == nullptr || store_->value.dtype() != op->dtype) {
+      if (store_ == nullptr || !SameElementBits(store_->value.dtype(), op->dtype) ||
+          !SameElementBits(store_->buffer->dtype, op->buffer->dtype)) {
         result_ = false;
         return;
       }
@@ -345,6 +349,11 @@ class InplaceOpVerifier : public StmtExprVisitor {
   }
 
  private:
+  static bool SameElementBits(DataType a, DataType b) {
+    if (a == b) return true;
+    if (a.is_bool() || b.is_bool()) return false;
+    return a.bits() * a.lanes() == b.bits() * b.lanes();
+  }
   // result of the check
   bool result_{true};
   // destination memory
@@ -518,7 +527,7 @@ class StoragePlanRewriter : public StmtExprMutator {
     // The physical dimensionality of the allocations.  Since
     // StorageRewrite is applied after StorageFlatten/FlattenBuffer,
     // this is size of `AllocateNode::extents`.  If moved
-    size_t ndim;
+    size_t ndim{1};
     // Allocs that shares this entry.
     std::vector<const AllocateNode*> allocs;
     // The children of this entry, not including itself.
@@ -543,6 +552,13 @@ class StoragePlanRewriter : public StmtExprMutator {
     uint64_t bits_offset{0};
   };
 
+  // Checks whether allocations of the two element types can share a storage entry.
+  // The entry is sized in bits, except for booleans which may be stored wider than
+  // a bit by the code generators, so these only share with other booleans.
+  static bool CanShareAcrossTypes(DataType a, DataType b) {
+    return a == b || (!a.is_bool() && !b.is_bool());
+  }
+
   // Checks whether the storage_scope is especially tagged for a specific memory.
   // Special memory is all combined into a single allocation.
   bool IsSpecialTaggedMemory(const StorageScope& scope) {
@@ -609,9 +625,10 @@ class StoragePlanRewriter : public StmtExprMutator {
         }
         // Get the allocation size;
         e->alloc_var = e->allocs[0]->buffer_var;
+        // Allocate with the widest element, so that the storage is aligned for all of them.
         DataType alloc_type = e->allocs[0]->dtype;
         for (const AllocateNode* op : e->allocs) {
-          if (op->dtype.lanes() > alloc_type.lanes()) {
+          if (op->dtype.bits() * op->dtype.lanes() > alloc_type.bits() * alloc_type.lanes()) {
             alloc_type = op->dtype;
           }
         }
@@ -820,11 +837,19 @@ class StoragePlanRewriter : public StmtExprMutator {
                 StorageEntry* src_entry = alloc_map_.at(src);
                 if (src_entry->scope == storage_scope &&
                     src_entry->attach_scope_ == thread_scope_ &&
-                    src_entry->elem_type == alloc->dtype.element_of() &&
+                    CanShareAcrossTypes(src_entry->elem_type, alloc->dtype.element_of()) &&
                     visitor.Check(s.stmt, var, src)) {
                   uint64_t const_nbits = static_cast<uint64_t>(alloc->ConstantAllocationSize()) *
                                          alloc->dtype.bits() * alloc->dtype.lanes();
-                  if (src_entry->const_nbits == const_nbits && !inplace_found) {
+                  // A different type or a smaller destination needs a merged
+                  // allocation, which is only supported for flat memory.
+                  bool same_layout = src_entry->elem_type == alloc->dtype.element_of() &&
+                                     src_entry->const_nbits == const_nbits;
+                  bool fits = same_layout || (const_nbits != 0 &&
+                                              const_nbits <= src_entry->const_nbits &&
+                                              src_entry->ndim == 1 &&
+                                              entry.num_physical_dimensions == 1);
+                  if (fits && !inplace_found) {
                     // successfully inplace
                     dst_entry = src_entry;
                     inplace_flag.insert(src);
@@ -875,12 +900,14 @@ class StoragePlanRewriter : public StmtExprMutator {
   }
   // Allocate new storage entry.
   StorageEntry* NewAlloc(const AllocateNode* op, const Object* attach_scope,
-                         const StorageScope& scope, size_t const_nbits) {
+                         const StorageScope& scope, size_t const_nbits,
+                         size_t num_physical_dimensions) {
     ICHECK(op != nullptr);
     // Re-use not successful, allocate a new buffer.
     auto entry = std::make_unique<StorageEntry>();
     entry->attach_scope_ = attach_scope;
     entry->scope = scope;
+    entry->ndim = num_physical_dimensions;
     entry->elem_type = op->dtype.element_of();
     entry->const_nbits = const_nbits;
     StorageEntry* e = entry.get();
@@ -913,7 +940,7 @@ class StoragePlanRewriter : public StmtExprMutator {
                                       (is_known_size && const_nbits <= 32));
 
     if (is_small_array || !is_flat_memory_space) {
-      return NewAlloc(op, attach_scope, scope, const_nbits);
+      return NewAlloc(op, attach_scope, scope, const_nbits, num_physical_dimensions);
     }
 
     if (is_known_size) {
@@ -926,6 +953,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = it->second;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
+        if (!CanShareAcrossTypes(e->elem_type, op->dtype.element_of())) continue;
         // when not divided, no reuse, eg, float4 vs float3
         if (e->bits_offset % op_elem_bits != 0) continue;
         e->const_nbits = std::max(const_nbits, e->const_nbits);
@@ -938,7 +966,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = it->second;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
+        if (!CanShareAcrossTypes(e->elem_type, op->dtype.element_of())) continue;
         e->const_nbits = std::max(const_nbits, e->const_nbits);
         const_free_map_.erase(it);
         return e;
@@ -949,12 +977,12 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = *it;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
+        if (!CanShareAcrossTypes(e->elem_type, op->dtype.element_of())) continue;
         sym_free_list_.erase(it);
         return e;
       }
     }
-    return NewAlloc(op, attach_scope, scope, const_nbits);
+    return NewAlloc(op, attach_scope, scope, const_nbits, num_physical_dimensions);
   }
   // simulated free.
   void Free(const VarNode* var) {
@@ -1631,7 +1659,7 @@ Pass StorageRewrite() {
     // handle vectorized constants.
     return PointerValueTypeRewrite(std::move(f), true, false, false, true, true, true, false);
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.StorageRewrite", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.StorageRewrite", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.StorageRewrite").set_body_typed(StorageRewrite);
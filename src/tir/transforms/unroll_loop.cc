@@ -45,6 +45,8 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
   int auto_max_extent;
   int explicit_unroll;
   int unroll_local_access;
+  int auto_max_registers;
+  int auto_max_code_size;
 
   TVM_DECLARE_ATTRS(UnrollLoopConfigNode, "tir.transform.UnrollLoopConfig") {
     TVM_ATTR_FIELD(auto_max_step)
@@ -62,6 +64,14 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
     TVM_ATTR_FIELD(unroll_local_access)
         .describe("Whether to always unroll local access")
         .set_default(false);
+    TVM_ATTR_FIELD(auto_max_registers)
+        .describe("The maximum estimated number of registers of an automatically unrolled loop, "
+                  "0 for no limit.")
+        .set_default(0);
+    TVM_ATTR_FIELD(auto_max_code_size)
+        .describe("The maximum estimated number of instructions of an automatically unrolled "
+                  "loop, 0 for no limit.")
+        .set_default(0);
   }
 };
 
@@ -88,15 +98,23 @@ class VarLocalAccessMarker : public ExprVisitor {
 // The Visitor is used to check whether var is used as write index in a local memory
 // If a loop var is used as indices to a local memory, it must be unrolled so
 // the local memory access can be turned into register access.
+//
+// The automatic unrolling is also bounded by a register and code size model. The unrolled copies
+// of a body are scheduled together, so each copy of a loaded value or of a local store may hold a
+// register at the same time, and each expression node is replicated into an instruction. Going
+// past the register file spills on GPUs, and past the instruction cache stalls on CPUs.
 class LoopUnroller : public StmtExprMutator {
  public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth, int auto_max_extent,
-                        bool explicit_unroll, bool unroll_local_access)
+                        bool explicit_unroll, bool unroll_local_access, int auto_max_registers,
+                        int auto_max_code_size)
       : auto_max_step_(auto_max_step),
         auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent),
         explicit_unroll_(explicit_unroll),
-        unroll_local_access_(unroll_local_access) {}
+        unroll_local_access_(unroll_local_access),
+        auto_max_registers_(auto_max_registers),
+        auto_max_code_size_(auto_max_code_size) {}
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
@@ -105,6 +123,18 @@ class LoopUnroller : public StmtExprMutator {
       Stmt ret = this->VisitStmt(op->body);
       std::swap(value, auto_max_step_);
       return ret;
+    } else if (op->attr_key == attr::pragma_auto_unroll_max_registers) {
+      int value = static_cast<int>(Downcast<Integer>(op->value)->value);
+      std::swap(value, auto_max_registers_);
+      Stmt ret = this->VisitStmt(op->body);
+      std::swap(value, auto_max_registers_);
+      return ret;
+    } else if (op->attr_key == attr::pragma_auto_unroll_max_code_size) {
+      int value = static_cast<int>(Downcast<Integer>(op->value)->value);
+      std::swap(value, auto_max_code_size_);
+      Stmt ret = this->VisitStmt(op->body);
+      std::swap(value, auto_max_code_size_);
+      return ret;
     } else if (op->attr_key == "pragma_unroll_explicit") {
       bool explicit_unroll = Downcast<Integer>(op->value)->value;
       std::swap(explicit_unroll, explicit_unroll_);
@@ -128,6 +158,16 @@ class LoopUnroller : public StmtExprMutator {
     auto_unroll =
         auto_unroll && (value * step_count_ <= auto_max_step_ || value <= auto_max_extent_);
 
+    // Keep the loop if its unrolled copies would not fit in the registers or the code size.
+    if (auto_max_registers_ > 0 &&
+        static_cast<int64_t>(value) * register_count_ > auto_max_registers_) {
+      auto_unroll = false;
+    }
+    if (auto_max_code_size_ > 0 &&
+        static_cast<int64_t>(value) * code_size_ > auto_max_code_size_) {
+      auto_unroll = false;
+    }
+
     if (op->kind == ForKind::kUnrolled) {
       ICHECK_GE(value, 0) << "Cannot unroll non-constant loop";
       auto_unroll = true;
@@ -141,6 +181,8 @@ class LoopUnroller : public StmtExprMutator {
 
     if (auto_unroll) {
       step_count_ *= value;
+      register_count_ *= value;
+      code_size_ *= value;
       unroll_depth_ += 1;
     } else {
       normal_loop_depth_ += 1;
@@ -177,21 +219,28 @@ class LoopUnroller : public StmtExprMutator {
 
   Stmt VisitStmt_(const BufferStoreNode* op) final {
     ++step_count_;
-    if (unroll_local_access_) {
-      auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
-      if (storage_scope.rank == runtime::StorageRank::kLocal ||
-          storage_scope.rank == runtime::StorageRank::kWarp) {
-        VarLocalAccessMarker marker(&var_touched_local_);
-        for (PrimExpr e : op->indices) {
-          marker(e);
-        }
+    auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
+    bool is_local = storage_scope.rank == runtime::StorageRank::kLocal ||
+                    storage_scope.rank == runtime::StorageRank::kWarp;
+    if (unroll_local_access_ && is_local) {
+      VarLocalAccessMarker marker(&var_touched_local_);
+      for (PrimExpr e : op->indices) {
+        marker(e);
       }
     }
+    // A local store becomes a register once unrolled.
+    if (is_local) ++register_count_;
+    CountCost(op->value);
+    for (const PrimExpr& index : op->indices) {
+      CountCost(index);
+    }
+    ++code_size_;
     return StmtExprMutator::VisitStmt_(op);
   }
 
   Stmt VisitStmt_(const EvaluateNode* op) final {
     ++step_count_;
+    CountCost(op->value);
     return StmtExprMutator::VisitStmt_(op);
   }
 
@@ -200,11 +249,18 @@ class LoopUnroller : public StmtExprMutator {
       int step_count = step_count_;
       int unroll_depth = unroll_depth_;
       int normal_loop_depth = normal_loop_depth_;
+      int64_t register_count = register_count_;
+      int64_t code_size = code_size_;
       step_count_ = 0;
       unroll_depth_ = 0;
       normal_loop_depth_ = 0;
+      register_count_ = 0;
+      code_size_ = 0;
       Stmt ret = this->VisitStmt(s);
       step_count_ += step_count;
+      // The registers of consecutive statements are reused, while their code adds up.
+      register_count_ = std::max(register_count_, register_count);
+      code_size_ += code_size;
       normal_loop_depth_ = std::max(normal_loop_depth, normal_loop_depth_);
       unroll_depth_ = std::max(unroll_depth_, unroll_depth);
       return ret;
@@ -229,6 +285,14 @@ class LoopUnroller : public StmtExprMutator {
   }
 
  private:
+  // Add the loads of expr to the register count and its nodes to the code size.
+  void CountCost(const PrimExpr& expr) {
+    PostOrderVisit(expr, [this](const ObjectRef& node) {
+      if (node->IsInstance<BufferLoadNode>()) ++register_count_;
+      ++code_size_;
+    });
+  }
+
   // returns the extent of the loop if it's a constant integer, otherwise return -1
   int GetExtent(const ForNode* op) {
     // constant folding.
@@ -258,6 +322,14 @@ class LoopUnroller : public StmtExprMutator {
   int unroll_depth_{0};
   // Number of total steps unrolled
   int step_count_{0};
+  // maximum estimated number of registers of an auto unrolled loop, 0 for no limit
+  int auto_max_registers_;
+  // maximum estimated number of instructions of an auto unrolled loop, 0 for no limit
+  int auto_max_code_size_;
+  // Estimated number of registers live at once in the current scope, once unrolled
+  int64_t register_count_{0};
+  // Estimated number of instructions in the current scope, once unrolled
+  int64_t code_size_{0};
   // set of indices touched during visit local memory
   std::unordered_set<Var, ObjectPtrHash, ObjectPtrEqual> var_touched_local_;
   // analyzer
@@ -266,7 +338,8 @@ class LoopUnroller : public StmtExprMutator {
 
 Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
+                          cfg->explicit_unroll, cfg->unroll_local_access, cfg->auto_max_registers,
+                          cfg->auto_max_code_size)(stmt);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -286,7 +359,7 @@ Pass UnrollLoop() {
     n->body = UnrollLoop(std::move(f->body), cfg.value());
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.UnrollLoop").set_body_typed(UnrollLoop);
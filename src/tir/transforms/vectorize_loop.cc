@@ -141,6 +141,70 @@ class VecAllocAccess : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
+/*!
+ * \brief Predicate the vectorized buffer accesses guarded by a vector condition.
+ *
+ *  The guarded statement must only be made of buffer stores, and every vector load
+ *  or store must have as many lanes as the condition and access contiguous elements,
+ *  so that the masked off lanes are not accessed at all.
+ */
+class BufferAccessPredicator : public StmtExprMutator {
+ public:
+  explicit BufferAccessPredicator(PrimExpr predicate) : predicate_(predicate) {}
+
+  /*! \return The predicated statement, or NullOpt if it cannot be predicated. */
+  Optional<Stmt> Predicate(const Stmt& stmt) {
+    Stmt ret = this->VisitStmt(stmt);
+    if (!success_) return NullOpt;
+    return ret;
+  }
+
+ private:
+  Stmt VisitStmt(const Stmt& stmt) final {
+    if (!stmt->IsInstance<SeqStmtNode>() && !stmt->IsInstance<BufferStoreNode>()) {
+      success_ = false;
+      return stmt;
+    }
+    return StmtExprMutator::VisitStmt(stmt);
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    auto load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    if (load->dtype.lanes() == 1) return std::move(load);
+    if (load->dtype.lanes() != lanes() || !IsContiguous(load->indices, load->buffer)) {
+      success_ = false;
+    } else {
+      load.CopyOnWrite()->predicate = Combine(load->predicate);
+    }
+    return std::move(load);
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    auto store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    if (store->value.dtype().lanes() != lanes() || !IsContiguous(store->indices, store->buffer)) {
+      success_ = false;
+    } else {
+      store.CopyOnWrite()->predicate = Combine(store->predicate);
+    }
+    return std::move(store);
+  }
+
+  int lanes() const { return predicate_.dtype().lanes(); }
+
+  PrimExpr Combine(const Optional<PrimExpr>& existing) const {
+    return existing ? And(existing.value(), predicate_) : predicate_;
+  }
+
+  static bool IsContiguous(const Array<PrimExpr>& indices, const Buffer& buffer) {
+    if (buffer->dtype.lanes() != 1) return false;
+    const auto* ramp = indices[indices.size() - 1].as<RampNode>();
+    return ramp && is_one(ramp->stride);
+  }
+
+  PrimExpr predicate_;
+  bool success_{true};
+};
+
 // We use ExprFunctor directly instead of StmtExprMutator
 // This is because the transformation can change the dtype of the Expr
 // The existing ExprMutator transformation rules may not be well defined.
@@ -149,7 +213,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool enable_predication)
+      : var_(var), var_lanes_(var_lanes), enable_predication_(enable_predication) {
     ramp_ = Ramp(IntImm(var->dtype, 0), IntImm(var->dtype, 1), var_lanes);
   }
 
@@ -465,6 +530,11 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   // IfThenElse
   Stmt VisitStmt_(const IfThenElseNode* op) final {
     ICHECK(!op->condition.dtype().is_vector());
+    if (enable_predication_ && !op->else_case) {
+      if (Optional<Stmt> predicated = PredicateIfThenElse(op)) {
+        return predicated.value();
+      }
+    }
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
       return Scalarize(GetRef<Stmt>(op));
@@ -541,6 +611,28 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  /*!
+   * \brief Turn a guard whose condition varies across the lanes, such as the
+   *  bound check of the tail of a non-divisible split, into masked accesses.
+   * \return The predicated statement, or NullOpt to handle the guard as usual.
+   */
+  Optional<Stmt> PredicateIfThenElse(const IfThenElseNode* op) {
+    PrimExpr condition = op->condition;
+    if (const auto* call = condition.as<CallNode>()) {
+      if (call->op.same_as(builtin::likely())) condition = call->args[0];
+    }
+    PrimExpr mask = this->VisitExpr(condition);
+    if (need_scalarize_ || !mask.dtype().is_vector()) {
+      need_scalarize_ = false;
+      return NullOpt;
+    }
+    Stmt then_case = this->VisitStmt(op->then_case);
+    if (Optional<Stmt> predicated = BufferAccessPredicator(mask).Predicate(then_case)) {
+      return predicated;
+    }
+    return Scalarize(GetRef<Stmt>(op));
+  }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
     Var idx(var_->name_hint + ".s", var_->dtype);
@@ -564,6 +656,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   int var_lanes_;
   // ramp representing the var.
   PrimExpr ramp_;
+  // whether guarded accesses may be predicated instead of scalarized.
+  bool enable_predication_;
   // flag to mark requirment of scalarization.
   bool need_scalarize_{false};
   // Let binding
@@ -633,6 +727,9 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool enable_predication = false)
+      : enable_predication_(enable_predication) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->kind == ForKind::kVectorized) {
       ICHECK(is_zero(op->min));
@@ -640,11 +737,15 @@ class LoopVectorizer : public StmtMutator {
       if (!extent_as_int || extent_as_int->value < 1) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value),
+                        enable_predication_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  bool enable_predication_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -664,6 +765,8 @@ class VectorizeSkipper : public StmtMutator {
 
 Stmt SkipVectorize(Stmt stmt) { return VectorizeSkipper()(std::move(stmt)); }
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_buffer_level_predication", Bool);
+
 namespace transform {
 
 // TODO(tvm-team): Make it as a target property.
@@ -671,13 +774,15 @@ Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      bool enable_predication =
+          ctx->GetConfig<Bool>("tir.enable_buffer_level_predication", Bool(false)).value();
+      n->body = LoopVectorizer(enable_predication)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.VectorizeLoop", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.VectorizeLoop", {}, /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.VectorizeLoop").set_body_typed(VectorizeLoop);
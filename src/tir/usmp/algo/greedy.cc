@@ -20,8 +20,8 @@
 /*!
  * \file tir/analysis/usmp/algo/greedy.cc
  * \brief This source contains greedy algorithms for planning
- * memory for USMP. There are two algorithms present here :
- * 1) greedy_by_size and 2) greedy_by_conflicts.
+ * memory for USMP. There are three algorithms present here :
+ * 1) greedy_by_size, 2) greedy_by_conflicts and 3) greedy_by_bandwidth.
  *
  * greedy_by_size : this algorithm prioritizes placing the
  * largest size buffer to the given pools. The BufferInfo objects
@@ -32,6 +32,14 @@
  * the most liveness conflicted buffer to the given pools. The
  * BufferInfo objects are sorted based on the number of conflicts
  * and placed on each pool adhering to size_hint constraint.
+ *
+ * greedy_by_bandwidth : this algorithm decides which buffers go to the
+ * fast pools when the pools differ in bandwidth, e.g. SRAM and DRAM.
+ * The BufferInfo objects are sorted based on the number of bytes read and
+ * written per byte of the buffer, so that the hottest buffers fill the fast
+ * pools first. Each buffer is placed on the candidate pool that serves its
+ * traffic in the fewest cycles, as given by the read and write bandwidth of
+ * the pools, adhering to size_hint constraint, and spills to the slower ones.
  */
 
 #include <tvm/arith/analyzer.h>
@@ -43,6 +51,11 @@
 #include <tvm/tir/usmp/algorithms.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace usmp {
@@ -82,6 +95,10 @@ bool GreedyBase::IsValidPlacement(const PoolInfo& candidate_pool, const size_t&
   return false;
 }
 
+Array<PoolInfo> GreedyBase::GetOrderedPoolCandidates(const BufferInfo& buf_info) {
+  return buf_info->pool_candidates;
+}
+
 /*!
  * \brief Selects a pool for placement in the given set of ordered pool candidates
  */
@@ -91,7 +108,7 @@ PoolInfo GreedyBase::SelectPlacementPool(
   // Here the pool candidates are ordered when it is consumed by the algorithm.
   // This could be from order the user has specified. However, schedulers are
   // welcome to change the order for performance reasons.
-  for (const auto& pool_info : buf_info->pool_candidates) {
+  for (const auto& pool_info : GetOrderedPoolCandidates(buf_info)) {
     if (pool_offsets.count(pool_info)) {
       return pool_info;
     }
@@ -205,6 +222,72 @@ class GreedyConflicts : public GreedyBase {
   }
 };
 
+/*!
+ * \brief This class implements Greedy by the bandwidth demand of
+ * BufferInfo greedy algorithm. Please refer to main documentation
+ * of the file for more details.
+ */
+class GreedyBandwidth : public GreedyBase {
+ public:
+  GreedyBandwidth() {}
+  Map<BufferInfo, PoolAllocation> PlanMemory(const Array<BufferInfo>& buffer_info_arr) {
+    std::vector<BufferInfo> buffer_info_vec;
+    for (const auto& buffer_info : buffer_info_arr) {
+      buffer_info_vec.push_back(buffer_info);
+    }
+    std::sort(buffer_info_vec.begin(), buffer_info_vec.end(),
+              [](const BufferInfo& a, const BufferInfo& b) {
+                double a_density = AccessDensity(a);
+                double b_density = AccessDensity(b);
+                if (a_density == b_density) {
+                  if (a->size_bytes->value == b->size_bytes->value) {
+                    return std::string(a->name_hint->data) > std::string(b->name_hint->data);
+                  }
+                  return a->size_bytes->value > b->size_bytes->value;
+                }
+                return a_density > b_density;
+              });
+    return PostSortAllocation(buffer_info_vec);
+  }
+
+ protected:
+  /*!
+   * \brief Orders the pool candidates by the estimated cycles spent on the traffic
+   * of the buffer. Pools of unknown bandwidth come last, in the user-given order.
+   */
+  Array<PoolInfo> GetOrderedPoolCandidates(const BufferInfo& buf_info) final {
+    std::vector<PoolInfo> pool_candidates(buf_info->pool_candidates.begin(),
+                                          buf_info->pool_candidates.end());
+    std::stable_sort(pool_candidates.begin(), pool_candidates.end(),
+                     [&buf_info](const PoolInfo& a, const PoolInfo& b) {
+                       return AccessCycles(a, buf_info) < AccessCycles(b, buf_info);
+                     });
+    return Array<PoolInfo>(pool_candidates);
+  }
+
+ private:
+  /*!
+   * \brief The number of bytes read and written per byte of the buffer
+   */
+  static double AccessDensity(const BufferInfo& buf_info) {
+    double size_bytes = std::max<int64_t>(buf_info->size_bytes->value, 1);
+    return static_cast<double>(buf_info->read_bytes + buf_info->write_bytes) / size_bytes;
+  }
+
+  /*!
+   * \brief The estimated number of cycles spent on the traffic of the buffer in the pool
+   */
+  static double AccessCycles(const PoolInfo& pool_info, const BufferInfo& buf_info) {
+    int64_t read_bandwidth = pool_info->read_bandwidth_bytes_per_cycle.IntValue();
+    int64_t write_bandwidth = pool_info->write_bandwidth_bytes_per_cycle.IntValue();
+    if (read_bandwidth <= 0 || write_bandwidth <= 0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return static_cast<double>(buf_info->read_bytes) / read_bandwidth +
+           static_cast<double>(buf_info->write_bytes) / write_bandwidth;
+  }
+};
+
 Map<BufferInfo, PoolAllocation> GreedyBySize(const Array<BufferInfo>& buffer_info_arr,
                                              const Integer& memory_pressure) {
   return GreedySize().PlanMemory(buffer_info_arr);
@@ -215,6 +298,11 @@ Map<BufferInfo, PoolAllocation> GreedyByConflicts(const Array<BufferInfo>& buffe
   return GreedyConflicts().PlanMemory(buffer_info_arr);
 }
 
+Map<BufferInfo, PoolAllocation> GreedyByBandwidth(const Array<BufferInfo>& buffer_info_arr,
+                                                  const Integer& memory_pressure) {
+  return GreedyBandwidth().PlanMemory(buffer_info_arr);
+}
+
 TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_size")
     .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
       return GreedyBySize(buffer_info_arr, memory_pressure);
@@ -225,6 +313,11 @@ TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_conflicts")
       return GreedyByConflicts(buffer_info_arr, memory_pressure);
     });
 
+TVM_REGISTER_GLOBAL("tir.usmp.algo.greedy_by_bandwidth")
+    .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
+      return GreedyByBandwidth(buffer_info_arr, memory_pressure);
+    });
+
 }  // namespace algo
 }  // namespace usmp
 }  // namespace tir
@@ -22,8 +22,9 @@
  *
  * \brief This analysis pass consumes a TIR IRModule with a main function
  * that defines a ordering in the callees to operators and produces BufferInfo
- * objects that contains information about tir.allocate nodes and liveness
- * conflicts between other tir.allocate nodes.
+ * objects that contains information about tir.allocate nodes, liveness
+ * conflicts between other tir.allocate nodes and the estimated number of bytes
+ * read from and written to each of them.
  */
 #include <tvm/arith/analyzer.h>
 #include <tvm/relay/executor.h>
@@ -34,6 +35,7 @@
 #include <tvm/tir/usmp/analysis.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
 #include <stack>
 
 #include "../../../runtime/thread_storage_scope.h"
@@ -81,6 +83,7 @@ class BufferInfoExtractor : public StmtExprVisitor {
   void VisitStmt_(const ForNode* op) override;
 
   void UpdateAliases(const Array<PrimExpr>& args, const PrimFunc& func);
+  void RecordAccessBytes(const Var& buffer_var, const DataType& dtype, bool is_write);
   void RecordAllocateNodeInfo(const AllocateNode* op);
   void RecordAllocateConstNodeInfo(const AllocateConstNode* op);
   void VisitPrimFunc(const PrimFunc& func, const Call& call);
@@ -130,6 +133,16 @@ class BufferInfoExtractor : public StmtExprVisitor {
    * \brief Indicates a count of stmts visited so far to use as a metric of liveness
    */
   int current_stmt_idx_ = 0;
+  /*!
+   * \brief The number of times the current stmt is executed, i.e. the product of the
+   * constant extents of the enclosing loops, including the loops around the calls.
+   */
+  int64_t loop_trip_count_ = 1;
+  /*!
+   * \brief The estimated number of bytes read from and written to each allocate.
+   */
+  std::unordered_map<Stmt, int64_t, ObjectPtrHash, ObjectPtrEqual> read_bytes_;
+  std::unordered_map<Stmt, int64_t, ObjectPtrHash, ObjectPtrEqual> write_bytes_;
   /*!
    * \brief This structure is supposed to contain information around the scope
    * the visitor is currently in.
@@ -362,7 +375,12 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   Call current_call = scope_stack_.top().call;
   PrimFunc current_primfunc = scope_stack_.top().func;
   scope_stack_.push(si);
+  int64_t outer_trip_count = loop_trip_count_;
+  if (const auto* extent = op->extent.as<IntImmNode>()) {
+    loop_trip_count_ *= std::max<int64_t>(extent->value, 0);
+  }
   StmtExprVisitor::VisitStmt_(op);
+  loop_trip_count_ = outer_trip_count;
   // Extending the liveness to beginning of for-loop next and end of the current for-loop
   for (const Allocate& allocate : scope_stack_.top().allocate_nodes) {
     AllocateInfo ai = allocate_infos[allocate->buffer_var];
@@ -384,13 +402,29 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   scope_stack_.pop();
 }
 
+void BufferInfoExtractor::RecordAccessBytes(const Var& buffer_var, const DataType& dtype,
+                                            bool is_write) {
+  auto it = allocate_infos.find(buffer_var);
+  if (it == allocate_infos.end()) {
+    return;
+  }
+  int64_t bytes = loop_trip_count_ * ((dtype.bits() * dtype.lanes() + 7) / 8);
+  if (is_write) {
+    write_bytes_[it->second.Allocate] += bytes;
+  } else {
+    read_bytes_[it->second.Allocate] += bytes;
+  }
+}
+
 void BufferInfoExtractor::VisitExpr_(const BufferLoadNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccessBytes(op->buffer->data, op->dtype, false);
   StmtExprVisitor::VisitExpr_(op);
 }
 
 void BufferInfoExtractor::VisitStmt_(const BufferStoreNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccessBytes(op->buffer->data, op->value.dtype(), true);
   StmtExprVisitor::VisitStmt_(op);
 }
 
@@ -502,6 +536,10 @@ void BufferInfoExtractor::VisitExpr_(const CallNode* op) {
 BufferInfoAnalysis BufferInfoExtractor::operator()(const PrimFunc& main_func) {
   VisitPrimFunc(main_func, Call());
 
+  for (const auto& kv : buffer_info_map_) {
+    kv.first->SetAccessBytes(read_bytes_[kv.second], write_bytes_[kv.second]);
+  }
+
   // Create a vector of liveness events
   // associated with each BufferNodes.
   std::vector<LivenessEvent> le_events_timeline;
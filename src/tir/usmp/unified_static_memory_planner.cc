@@ -52,6 +52,7 @@ static std::unordered_map<String, std::function<Map<BufferInfo, PoolAllocation>(
                                       const Array<BufferInfo>&, const Integer&)>>
     algorithms{{"greedy_by_size", algo::GreedyBySize},
                {"greedy_by_conflicts", algo::GreedyByConflicts},
+               {"greedy_by_bandwidth", algo::GreedyByBandwidth},
                {"hill_climb", algo::HillClimb}};
 
 IRModule PlanMemory(const IRModule& mod, String algo, bool use_workspace_io,
@@ -51,6 +51,11 @@ void BufferInfoNode::SetConflicts(Array<ObjectRef> conflicting_buffer_info_objs)
   this->conflicts = conflicting_buffer_info_objs;
 }
 
+void BufferInfoNode::SetAccessBytes(int64_t read_bytes, int64_t write_bytes) {
+  this->read_bytes = read_bytes;
+  this->write_bytes = write_bytes;
+}
+
 TVM_REGISTER_NODE_TYPE(BufferInfoNode);
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfo")
     .set_body_typed([](String name_hint, Integer size_bytes, Array<PoolInfo> pool_candidates,
@@ -62,6 +67,8 @@ TVM_REGISTER_GLOBAL("tir.usmp.BufferInfo")
     });
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfoSetConflicts")
     .set_body_method<BufferInfo>(&BufferInfoNode::SetConflicts);
+TVM_REGISTER_GLOBAL("tir.usmp.BufferInfoSetAccessBytes")
+    .set_body_method<BufferInfo>(&BufferInfoNode::SetAccessBytes);
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<BufferInfoNode>([](const ObjectRef& ref, ReprPrinter* p) {
@@ -74,7 +81,9 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
                 << "name_hint=" << node->name_hint << ",\n  size_bytes=" << node->size_bytes
                 << ",\n  pool_candidates=" << node->pool_candidates
                 << ",\n  alignment=" << node->alignment << ",\n  kind=" << toString[node->kind]
-                << ",\n  conflicts=" << node->conflicts.size() << ")";
+                << ",\n  conflicts=" << node->conflicts.size()
+                << ",\n  read_bytes=" << node->read_bytes
+                << ",\n  write_bytes=" << node->write_bytes << ")";
     });
 
 BufferInfoAnalysis::BufferInfoAnalysis(Map<BufferInfo, tir::Stmt> buffer_info_stmts,
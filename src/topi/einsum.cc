@@ -24,6 +24,10 @@
 #include <tvm/topi/broadcast.h>
 #include <tvm/topi/einsum.h>
 
+#include <functional>
+#include <limits>
+#include <optional>
+
 namespace tvm {
 namespace topi {
 
@@ -332,9 +336,182 @@ class EinsumBuilder {
   Optional<Array<PrimExpr>> ellipsis_shape_;
 };
 
-Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std::string name,
-              std::string tag) {
-  EinsumEquation equation = EinsumEquation::FromString(subscripts_str);
+/*!
+ * \brief The planner of the pairwise contraction order of a multi-operand Einsum, in the spirit of
+ * opt_einsum. A group of operands is identified by the bit mask of the operand indices. Contracting
+ * two groups keeps only the labels needed by the other operands or the output, so that the other
+ * labels are reduced as early as possible.
+ */
+class EinsumContractionPlanner {
+ public:
+  /*! \brief The maximum number of operands for which the optimal order is searched exhaustively */
+  static constexpr int kMaxOptimalOperands = 8;
+
+  /*!
+   * \brief Create the planner if the contraction order can be planned, i.e. the equation has more
+   * than two operands, no ellipsis, and all the extents are constant.
+   */
+  static std::optional<EinsumContractionPlanner> Create(const EinsumEquation& equation,
+                                                        const Array<Array<PrimExpr>>& shapes) {
+    int n = equation.inputs.size();
+    if (n <= 2 || n > 31) {
+      return std::nullopt;
+    }
+    EinsumContractionPlanner planner;
+    for (int i = 0; i < n; ++i) {
+      const EinsumEquation::Subscript& subscript = equation.inputs[i];
+      if (subscript.size() != shapes[i].size()) {
+        return std::nullopt;
+      }
+      planner.operand_labels_.emplace_back();
+      for (int j = 0, ndim = subscript.size(); j < ndim; ++j) {
+        const auto* extent = shapes[i][j].as<IntImmNode>();
+        if (subscript[j] == EinsumEquation::kEllipsis || extent == nullptr) {
+          return std::nullopt;
+        }
+        int64_t& label_extent = planner.label_extents_[subscript[j]];
+        label_extent = std::max(label_extent, extent->value);
+        planner.operand_labels_.back().insert(subscript[j]);
+      }
+    }
+    for (EinsumEquation::Label label : equation.output) {
+      if (label == EinsumEquation::kEllipsis) {
+        return std::nullopt;
+      }
+    }
+    planner.output_labels_.insert(equation.output.begin(), equation.output.end());
+    return planner;
+  }
+
+  /*!
+   * \brief Plan the contraction order
+   * \return The two groups contracted to form each group of more than one operand
+   */
+  std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> Plan() const {
+    int n = operand_labels_.size();
+    return n <= kMaxOptimalOperands ? PlanOptimal(n) : PlanGreedy(n);
+  }
+
+  /*!
+   * \brief The labels of the result of contracting a group, sorted alphabetically
+   * \param group The bit mask of the group
+   */
+  EinsumEquation::Subscript KeptLabels(uint32_t group) const {
+    std::set<EinsumEquation::Label> inside, outside(output_labels_);
+    for (int i = 0, n = operand_labels_.size(); i < n; ++i) {
+      std::set<EinsumEquation::Label>& labels = (group >> i & 1) ? inside : outside;
+      labels.insert(operand_labels_[i].begin(), operand_labels_[i].end());
+    }
+    EinsumEquation::Subscript result;
+    for (EinsumEquation::Label label : inside) {
+      if (outside.count(label)) {
+        result.push_back(label);
+      }
+    }
+    return result;
+  }
+
+ private:
+  /*! \brief The number of multiply-adds of contracting two groups */
+  double ContractionCost(uint32_t lhs, uint32_t rhs) const {
+    std::set<EinsumEquation::Label> labels;
+    for (uint32_t group : {lhs, rhs}) {
+      EinsumEquation::Subscript kept =
+          IsSingleOperand(group) ? OperandLabels(group) : KeptLabels(group);
+      labels.insert(kept.begin(), kept.end());
+    }
+    return Size(labels);
+  }
+
+  /*! \brief The number of elements of a tensor with the given labels */
+  template <typename Labels>
+  double Size(const Labels& labels) const {
+    double size = 1.0;
+    for (EinsumEquation::Label label : labels) {
+      size *= label_extents_.at(label);
+    }
+    return size;
+  }
+
+  /*! \brief Whether a group consists of a single operand */
+  static bool IsSingleOperand(uint32_t group) { return (group & (group - 1)) == 0; }
+
+  /*! \brief The labels of the single operand in a group */
+  EinsumEquation::Subscript OperandLabels(uint32_t group) const {
+    int i = 0;
+    while (!(group >> i & 1)) ++i;
+    return EinsumEquation::Subscript(operand_labels_[i].begin(), operand_labels_[i].end());
+  }
+
+  /*! \brief Search the order with the minimum total cost over all the subsets of operands */
+  std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> PlanOptimal(int n) const {
+    uint32_t full = (1u << n) - 1;
+    std::vector<double> costs(full + 1, std::numeric_limits<double>::infinity());
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> splits;
+    for (int i = 0; i < n; ++i) {
+      costs[1u << i] = 0.0;
+    }
+    // Visiting the groups in increasing order visits the subsets of a group before the group
+    for (uint32_t group = 1; group <= full; ++group) {
+      if (IsSingleOperand(group)) {
+        continue;
+      }
+      for (uint32_t lhs = (group - 1) & group; lhs > 0; lhs = (lhs - 1) & group) {
+        uint32_t rhs = group ^ lhs;
+        if (lhs < rhs) {
+          continue;
+        }
+        double cost = costs[lhs] + costs[rhs] + ContractionCost(lhs, rhs);
+        if (cost < costs[group]) {
+          costs[group] = cost;
+          splits[group] = {lhs, rhs};
+        }
+      }
+    }
+    return splits;
+  }
+
+  /*!
+   * \brief Repeatedly contract the pair of groups with the minimum cost, breaking the ties by the
+   * size of the result
+   */
+  std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> PlanGreedy(int n) const {
+    std::vector<uint32_t> groups;
+    for (int i = 0; i < n; ++i) {
+      groups.push_back(1u << i);
+    }
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> splits;
+    while (groups.size() > 1) {
+      int best_i = -1, best_j = -1;
+      std::pair<double, double> best_cost;
+      for (int i = 0, m = groups.size(); i < m; ++i) {
+        for (int j = i + 1; j < m; ++j) {
+          std::pair<double, double> cost{ContractionCost(groups[i], groups[j]),
+                                         Size(KeptLabels(groups[i] | groups[j]))};
+          if (best_i == -1 || cost < best_cost) {
+            best_i = i, best_j = j, best_cost = cost;
+          }
+        }
+      }
+      uint32_t group = groups[best_i] | groups[best_j];
+      splits[group] = {groups[best_i], groups[best_j]};
+      groups.erase(groups.begin() + best_j);
+      groups[best_i] = group;
+    }
+    return splits;
+  }
+
+  /*! \brief The distinct labels of each operand */
+  std::vector<std::set<EinsumEquation::Label>> operand_labels_;
+  /*! \brief The labels of the output */
+  std::set<EinsumEquation::Label> output_labels_;
+  /*! \brief The extent of each label with broadcast rules applied */
+  std::unordered_map<EinsumEquation::Label, int64_t> label_extents_;
+};
+
+/*! \brief Build a single compute over all the operands of the equation */
+Tensor EinsumCompute(const EinsumEquation& equation, const Array<Tensor>& inputs,
+                     const std::string& name, const std::string& tag) {
   Array<Array<PrimExpr>> input_shapes;
   for (const Tensor& input : inputs) {
     input_shapes.push_back(input->shape);
@@ -347,6 +524,46 @@ Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std
       name, tag);
 }
 
+Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std::string name,
+              std::string tag) {
+  EinsumEquation equation = EinsumEquation::FromString(subscripts_str);
+  Array<Array<PrimExpr>> input_shapes;
+  for (const Tensor& input : inputs) {
+    input_shapes.push_back(input->shape);
+  }
+  std::optional<EinsumContractionPlanner> planner =
+      EinsumContractionPlanner::Create(equation, input_shapes);
+  if (!planner.has_value()) {
+    return EinsumCompute(equation, inputs, name, tag);
+  }
+  // A single compute over all the operands iterates over the product of the extents of all the
+  // labels, so that multi-operand einsums are instead built as a tree of pairwise contractions
+  std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> splits = planner->Plan();
+  uint32_t full = (1u << inputs.size()) - 1;
+  int num_intermediates = 0;
+  std::function<std::pair<Tensor, EinsumEquation::Subscript>(uint32_t)> f_build =
+      [&](uint32_t group) -> std::pair<Tensor, EinsumEquation::Subscript> {
+    auto it = splits.find(group);
+    if (it == splits.end()) {
+      int i = 0;
+      while (!(group >> i & 1)) ++i;
+      return {inputs[i], equation.inputs[i]};
+    }
+    auto [lhs, lhs_subscript] = f_build(it->second.first);
+    auto [rhs, rhs_subscript] = f_build(it->second.second);
+    EinsumEquation step;
+    step.inputs = {lhs_subscript, rhs_subscript};
+    if (group == full) {
+      step.output = equation.output;
+      return {EinsumCompute(step, {lhs, rhs}, name, tag), step.output};
+    }
+    step.output = planner->KeptLabels(group);
+    std::string step_name = name + "_intermediate" + std::to_string(num_intermediates++);
+    return {EinsumCompute(step, {lhs, rhs}, step_name, tag), step.output};
+  };
+  return f_build(full).first;
+}
+
 Array<PrimExpr> InferEinsumShape(const std::string& subscripts,
                                  const std::vector<Array<PrimExpr>>& operands) {
   EinsumEquation equation = EinsumEquation::FromString(subscripts);
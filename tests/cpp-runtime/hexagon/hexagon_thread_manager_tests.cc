@@ -20,6 +20,8 @@
 #include <gtest/gtest.h>
 #include <tvm/runtime/logging.h>
 
+#include <atomic>
+
 #include "../src/runtime/hexagon/hexagon_device_api.h"
 #include "../src/runtime/hexagon/hexagon_thread_manager.h"
 
@@ -359,3 +361,45 @@ TEST_F(HexagonThreadManagerTest, threads_for_resource_types) {
   thread = reinterpret_cast<TVMStreamHandle>(6);
   EXPECT_THROW(thread_manager->GetResourceTypeForStreamHandle(thread), InternalError);
 }
+
+int count_tasks(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  std::atomic<int>* count = static_cast<std::atomic<int>*>(cdata);
+  count[task_id] += penv->num_task;
+  TVMBackendParallelBarrier(task_id, penv);
+  return 0;
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch) {
+  std::atomic<int> count[6] = {};
+  int ret = -1;
+  CHECK(htm->ParallelLaunch(count_tasks, count, 0, &ret));
+  CHECK_EQ(ret, 0);
+  for (unsigned i = 0; i < threads; i++) {
+    CHECK_EQ(count[i].load(), threads);
+  }
+
+  // capped to the parallel threads
+  htm->SetParallelThreads(2);
+  CHECK_EQ(htm->ParallelThreads(), 2);
+  CHECK(htm->ParallelLaunch(count_tasks, count, 4, &ret));
+  CHECK_EQ(count[0].load(), threads + 2);
+  CHECK_EQ(count[1].load(), threads + 2);
+  CHECK_EQ(count[2].load(), threads);
+  EXPECT_THROW(htm->SetParallelThreads(threads + 1), InternalError);
+}
+
+int fail_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  return task_id == 1 ? -1 : 0;
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_error) {
+  int ret = 0;
+  CHECK(htm->ParallelLaunch(fail_task, nullptr, 2, &ret));
+  CHECK_EQ(ret, -1);
+}
+
+// Parallel tasks of the global manager run on the HVX threads only
+TEST_F(HexagonThreadManagerTest, parallel_threads_are_hvx) {
+  HexagonThreadManager* thread_manager = HexagonDeviceAPI::Global()->ThreadManager();
+  CHECK_EQ(thread_manager->ParallelThreads(), 4);
+}
@@ -285,3 +285,62 @@ TEST_F(HexagonVtcmPoolTest, vtcm_alignment) {
   ptr = vtcm_pool->Allocate(max_bytes);
   vtcm_pool->Free(ptr, max_bytes);
 }
+
+TEST_F(HexagonVtcmPoolTest, best_fit_unaligned) {
+  // Leave a hole in the middle, smaller than the free space at the end
+  void* ptr1 = vtcm_pool->Allocate(two_k_block);
+  void* ptr2 = vtcm_pool->Allocate(two_k_block);
+  void* ptr3 = vtcm_pool->Allocate(two_k_block);
+  vtcm_pool->Free(ptr2, two_k_block);
+
+  // The unaligned allocation goes to the end of the hole, not of the largest segment
+  void* ptr4 = vtcm_pool->Allocate(one_k_block);
+  CHECK(static_cast<char*>(ptr4) == static_cast<char*>(ptr2) + one_k_block);
+
+  // The rest of the hole keeps its 2k aligned start
+  void* ptr5 = vtcm_pool->Allocate(one_k_block);
+  CHECK(ptr5 == ptr2);
+
+  vtcm_pool->Free(ptr1, two_k_block);
+  vtcm_pool->Free(ptr3, two_k_block);
+  vtcm_pool->Free(ptr4, one_k_block);
+  vtcm_pool->Free(ptr5, one_k_block);
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
+
+TEST_F(HexagonVtcmPoolTest, partitions) {
+  int part1 = vtcm_pool->ReservePartition(four_k_block);
+  int part2 = vtcm_pool->ReservePartition(four_k_block + 1);
+  CHECK_NE(part1, part2);
+
+  // The partitions are carved out of the shared part
+  EXPECT_THROW(vtcm_pool->Allocate(max_bytes), InternalError);
+
+  // A partition only serves its own size
+  void* ptr1 = vtcm_pool->Allocate(four_k_block, part1);
+  CHECK((reinterpret_cast<uintptr_t>(ptr1) & 0x7FF) == 0) << "Must be multiple of 2k " << ptr1;
+  EXPECT_THROW(vtcm_pool->Allocate(min_bytes, part1), InternalError);
+
+  // The thread allocates from its partition, the second one being rounded up to 6k
+  vtcm_pool->SetThreadPartition(part2);
+  void* ptr2 = vtcm_pool->Allocate(four_k_block + two_k_block);
+  vtcm_pool->SetThreadPartition(HexagonVtcmPool::kSharedPartition);
+  void* ptr3 = vtcm_pool->Allocate(max_bytes - 2 * four_k_block - two_k_block);
+
+  // A partition holding allocations cannot be released
+  EXPECT_THROW(vtcm_pool->ReleasePartition(part1), InternalError);
+
+  vtcm_pool->Free(ptr1, four_k_block);
+  vtcm_pool->Free(ptr2, four_k_block + two_k_block);
+  vtcm_pool->Free(ptr3, max_bytes - 2 * four_k_block - two_k_block);
+  vtcm_pool->ReleasePartition(part1);
+  vtcm_pool->ReleasePartition(part2);
+  EXPECT_THROW(vtcm_pool->Allocate(min_bytes, part1), InternalError);
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
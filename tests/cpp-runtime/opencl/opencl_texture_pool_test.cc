@@ -149,3 +149,61 @@ TEST(OpenCLTexturePool, avoid_reusing_too_small_textures) {
   EXPECT_EQ(item.first, 12544);
   EXPECT_EQ(item.second, 64);
 }
+
+TEST(OpenCLTexturePool, reuse_best_fit_texture) {
+  OpenCLWorkspace* workspace = OpenCLWorkspace::Global();
+  OpenCLThreadEntry* t = workspace->GetThreadEntry();
+  PoolWrapper pool;
+
+  DLDataType type{kDLFloat, 16, 1};
+  void* data1 = pool.Alloc(t->device, workspace, 1024, 1024, type);
+  void* data2 = pool.Alloc(t->device, workspace, 512, 512, type);
+  pool.Free(data1);
+  pool.Free(data2);
+  EXPECT_EQ(pool.FreeListSize(), 2);
+
+  // Both textures fit, the one with the least wasted area is chosen
+  pool.Alloc(t->device, workspace, 400, 400, type);
+  EXPECT_EQ(pool.AllocatedListSize(), 1);
+  EXPECT_EQ(pool.FreeListSize(), 1);
+  auto item = pool.AllocatedListItemSize(0);
+  EXPECT_EQ(item.first, 512);
+  EXPECT_EQ(item.second, 512);
+  item = pool.FreeListItemSize(0);
+  EXPECT_EQ(item.first, 1024);
+  EXPECT_EQ(item.second, 1024);
+
+  // The textures of another channel type are not reused
+  pool.Alloc(t->device, workspace, 1024, 1024, DLDataType{kDLFloat, 32, 1});
+  EXPECT_EQ(pool.AllocatedListSize(), 2);
+  EXPECT_EQ(pool.FreeListSize(), 1);
+}
+
+TEST(OpenCLTexturePool, release_free_textures_over_memory_limit) {
+  OpenCLWorkspace* workspace = OpenCLWorkspace::Global();
+  OpenCLThreadEntry* t = workspace->GetThreadEntry();
+  PoolWrapper pool;
+
+  DLDataType type{kDLFloat, 16, 1};
+  // Room for a 256x256 and a 1024x16 RGBA fp16 texture
+  pool.SetMemoryLimit((256 * 256 + 1024 * 16) * 4 * 2);
+  void* data1 = pool.Alloc(t->device, workspace, 256, 256, type);
+  pool.Free(data1);
+  void* data2 = pool.Alloc(t->device, workspace, 1024, 16, type);
+  EXPECT_EQ(pool.FreeListSize(), 1);
+  pool.Free(data2);
+  EXPECT_EQ(pool.FreeListSize(), 2);
+
+  // Neither of the free textures can be reused, and the largest one is
+  // released to stay within the limit.
+  pool.Alloc(t->device, workspace, 16, 1024, type);
+  EXPECT_EQ(pool.AllocatedListSize(), 1);
+  EXPECT_EQ(pool.FreeListSize(), 1);
+  auto item = pool.FreeListItemSize(0);
+  EXPECT_EQ(item.first, 1024);
+  EXPECT_EQ(item.second, 16);
+
+  pool.ReleaseFree(t->device, workspace);
+  EXPECT_EQ(pool.AllocatedListSize(), 1);
+  EXPECT_EQ(pool.FreeListSize(), 0);
+}
@@ -20,6 +20,7 @@
 #include <dmlc/logging.h>
 #include <gtest/gtest.h>
 #include <tvm/arith/analyzer.h>
+#include <tvm/arith/iter_affine_map.h>
 #include <tvm/te/operation.h>
 
 TEST(Simplify, MinMax) {
@@ -75,3 +76,29 @@ TEST(ConstantFold, Ramp) {
   auto f32x4_expected = tvm::tir::Cast(tvm::DataType::Float(32, 4), i32x4);
   ASSERT_TRUE(checker(f32x4, f32x4_expected));
 }
+
+TEST(Simplify, MemoizedDetectIterMap) {
+  tvm::arith::Analyzer ana;
+  ana.rewrite_simplify.SetMemoizationEnabled(true);
+  auto x = tvm::te::var("x");
+  auto y = tvm::te::var("y");
+  auto detect = [&](tvm::arith::Analyzer* analyzer) {
+    tvm::Map<tvm::tir::Var, tvm::Range> iters{{x, tvm::Range(0, 4)}, {y, tvm::Range(0, 8)}};
+    return tvm::arith::DetectIterMap({x * 8 + y}, iters, tvm::Bool(true),
+                                     tvm::arith::IterMapLevel::Surjective, analyzer);
+  };
+  auto first = detect(&ana);
+  auto second = detect(&ana);
+  ASSERT_TRUE(first->errors.empty());
+  ASSERT_FALSE(first.same_as(second));
+  ASSERT_TRUE(tvm::StructuralEqual()(first->indices, second->indices));
+  // The memoized result is not reused after the facts of the analyzer changed
+  auto n = tvm::te::var("n");
+  ana.Bind(n, tvm::Range(0, 4));
+  tvm::arith::Analyzer fresh;
+  fresh.Bind(n, tvm::Range(0, 4));
+  auto third = detect(&ana);
+  auto expected = detect(&fresh);
+  ASSERT_EQ(third->errors.size(), expected->errors.size());
+  ASSERT_TRUE(tvm::StructuralEqual()(third->indices, expected->indices));
+}
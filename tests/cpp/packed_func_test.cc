@@ -206,6 +206,34 @@ TEST(TypedPackedFunc, Deduce) {
                 "invariant3");
 }
 
+TEST(TypedPackedFunc, DirectCall) {
+  using namespace tvm;
+  using namespace tvm::runtime;
+  TypedPackedFunc<Array<Integer>(Array<Integer>, int)> fappend(
+      [](Array<Integer> arr, int value) {
+        arr.push_back(value);
+        return arr;
+      },
+      "append");
+  PackedFunc packed = fappend;
+  // same signature, called without packing the arguments
+  TypedPackedFunc<Array<Integer>(Array<Integer>, int)> fsame(packed);
+  Array<Integer> arr = fsame({1, 2}, 3);
+  ICHECK_EQ(arr.size(), 3);
+  ICHECK_EQ(arr[2]->value, 3);
+  // different signature, called through the packed arguments
+  TypedPackedFunc<Array<Integer>(Array<Integer>, int64_t)> fother(packed);
+  ICHECK_EQ(fother(arr, 4).size(), 4);
+  // the packed calling convention still checks the arguments
+  EXPECT_THROW(packed(arr), Error);
+
+  int count = 0;
+  TypedPackedFunc<void(int)> fadd([&count](int x) { count += x; });
+  TypedPackedFunc<void(int)>(fadd.packed())(2);
+  fadd.packed()(3);
+  ICHECK_EQ(count, 5);
+}
+
 TEST(PackedFunc, ObjectConversion) {
   using namespace tvm;
   using namespace tvm::tir;
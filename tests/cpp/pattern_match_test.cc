@@ -160,3 +160,22 @@ TEST(Pattern, MatchWithType) {
   ICHECK(vpat.Match(vx + vy * tir::Broadcast(2.0f, 8)));
   ICHECK(!vpat.Match(vx_int + vy_int * tir::Broadcast(2, 8)));
 }
+
+TEST(Pattern, MayMatch) {
+  using namespace tvm;
+  tir::Var x("x"), y("y");
+  arith::PVar<PrimExpr> px, py;
+  arith::PVar<IntImm> c;
+  // the node types alone are checked, so repeated PVars may still differ
+  ICHECK((px - py + py).MayMatch_(x - y + x));
+  ICHECK(!(px - py + py).Match(x - y + x));
+  ICHECK(!(px - py + py).MayMatch_(x * y + y));
+  ICHECK(!(px + c).MayMatch_(x + y));
+  ICHECK((px + c).MayMatch_(x + 1));
+  ICHECK(!(px + 2).MayMatch_(x + 1));
+  // a rejected match does not touch the previously filled PVars
+  ICHECK((px + c).Match(y + 3));
+  ICHECK(!(px * c).Match(x + 1));
+  ICHECK(px.Eval().same_as(y));
+  ICHECK_EQ(c.Eval()->value, 3);
+}
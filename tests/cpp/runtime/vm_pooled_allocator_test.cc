@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <thread>
+#include <vector>
+
+#include "../src/runtime/vm/pooled_allocator.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+TEST(PooledAllocator, ThreadCacheReuse) {
+  PooledAllocator alloc({kDLCPU, 0}, PooledAllocator::kDefaultPageSize, 1 << 20);
+  DLDataType dtype{kDLFloat, 32, 1};
+  Buffer a = alloc.Alloc(1000, 64, dtype);
+  alloc.Free(a);
+  Buffer b = alloc.Alloc(1000, 64, dtype);
+  EXPECT_EQ(a.data, b.data);
+  alloc.Free(b);
+  EXPECT_EQ(alloc.UsedMemory(), 4096);
+}
+
+TEST(PooledAllocator, CachedMemory) {
+  PooledAllocator alloc({kDLCPU, 0});
+  DLDataType dtype{kDLFloat, 32, 1};
+  Buffer a = alloc.Alloc(1000, 64, dtype);
+  EXPECT_EQ(alloc.CachedMemory(), 0);
+  alloc.Free(a);
+  EXPECT_EQ(alloc.CachedMemory(), 4096);
+  Buffer b = alloc.Alloc(4096, 64, dtype);
+  EXPECT_EQ(alloc.CachedMemory(), 0);
+  EXPECT_EQ(alloc.UsedMemory(), 4096);
+  alloc.Free(b);
+}
+
+TEST(PooledAllocator, ThreadCacheReturnedOnThreadExit) {
+  PooledAllocator alloc({kDLCPU, 0}, PooledAllocator::kDefaultPageSize, 1 << 20);
+  DLDataType dtype{kDLFloat, 32, 1};
+  void* data = nullptr;
+  std::thread worker([&]() {
+    Buffer buf = alloc.Alloc(4096, 64, dtype);
+    data = buf.data;
+    alloc.Free(buf);
+  });
+  worker.join();
+  // The buffer cached by the exited worker is visible to other threads again.
+  Buffer buf = alloc.Alloc(4096, 64, dtype);
+  EXPECT_EQ(buf.data, data);
+  alloc.Free(buf);
+}
+
+TEST(PooledAllocator, ThreadCacheConcurrent) {
+  PooledAllocator alloc({kDLCPU, 0}, PooledAllocator::kDefaultPageSize, 16384);
+  DLDataType dtype{kDLFloat, 32, 1};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&]() {
+      for (int i = 0; i < 1000; ++i) {
+        Buffer a = alloc.Alloc(4096 * (i % 4 + 1), 64, dtype);
+        Buffer b = alloc.Alloc(4096, 64, dtype);
+        alloc.Free(a);
+        alloc.Free(b);
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  EXPECT_GT(alloc.UsedMemory(), 0);
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include "../src/runtime/vm/size_class_allocator.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+TEST(SizeClassAllocator, SizeClass) {
+  SizeClassAllocator alloc({kDLCPU, 0});
+  EXPECT_EQ(alloc.SizeClass(1), 4096);
+  EXPECT_EQ(alloc.SizeClass(4096), 4096);
+  EXPECT_EQ(alloc.SizeClass(4100), 8192);
+  EXPECT_EQ(alloc.SizeClass(9000), 12288);
+  EXPECT_EQ(alloc.SizeClass((1 << 20) + 1), (1 << 20) + (1 << 18));
+}
+
+TEST(SizeClassAllocator, ReuseWithinSizeClass) {
+  SizeClassAllocator alloc({kDLCPU, 0});
+  DLDataType dtype{kDLFloat, 32, 1};
+  Buffer a = alloc.Alloc(8000, 64, dtype);
+  alloc.Free(a);
+  Buffer b = alloc.Alloc(4100, 64, dtype);
+  EXPECT_EQ(a.data, b.data);
+  EXPECT_EQ(alloc.UsedMemory(), 8192);
+  alloc.Free(b);
+}
+
+TEST(SizeClassAllocator, BestFitForLargeBlocks) {
+  SizeClassAllocator alloc({kDLCPU, 0});
+  DLDataType dtype{kDLFloat, 32, 1};
+  Buffer big = alloc.Alloc(3 << 20, 64, dtype);
+  alloc.Free(big);
+  // A smaller large request may reuse the cached block ...
+  Buffer reused = alloc.Alloc(2 << 20, 64, dtype);
+  EXPECT_EQ(reused.data, big.data);
+  alloc.Free(reused);
+  // ... but not when it would waste more than half of the block.
+  Buffer fresh = alloc.Alloc(1 << 20, 64, dtype);
+  EXPECT_NE(fresh.data, big.data);
+  alloc.Free(fresh);
+}
+
+TEST(SizeClassAllocator, MaxCachedBytes) {
+  SizeClassAllocator alloc({kDLCPU, 0}, 8192);
+  DLDataType dtype{kDLFloat, 32, 1};
+  Buffer a = alloc.Alloc(8192, 64, dtype);
+  Buffer b = alloc.Alloc(8192, 64, dtype);
+  EXPECT_EQ(alloc.UsedMemory(), 16384);
+  alloc.Free(a);
+  alloc.Free(b);
+  // Only one buffer fits in the pool, the other one is released immediately.
+  EXPECT_EQ(alloc.UsedMemory(), 8192);
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
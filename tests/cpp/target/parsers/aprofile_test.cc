@@ -307,11 +307,42 @@ TEST_P(AProfileOptionalSVE, OptionalSVESupport) {
   EXPECT_TRUE(Downcast<Bool>(features.at("has_sve")));
 }
 
+using AProfileOptionalSVE2 = testing::TestWithParam<float>;
+TEST_P(AProfileOptionalSVE2, OptionalSVE2Support) {
+  const std::string arch_attr = "+v" + std::to_string(GetParam()) + "a";
+
+  TargetJSON target = ParseTargetWithAttrs("", "aarch64-arm-none-eabi", {arch_attr, "+sve"});
+  TargetFeatures features = Downcast<TargetFeatures>(target.at("features"));
+  EXPECT_FALSE(Downcast<Bool>(features.at("has_sve2")));
+
+  // Check that "+sve2" sets both the "has_sve2" and the "has_sve" features.
+  target = ParseTargetWithAttrs("", "aarch64-arm-none-eabi", {arch_attr, "+sve2"});
+  features = Downcast<TargetFeatures>(target.at("features"));
+  EXPECT_TRUE(Downcast<Bool>(features.at("has_sve2")));
+  EXPECT_TRUE(Downcast<Bool>(features.at("has_sve")));
+}
+
+TEST(AProfileParser, OptionalSMESupport) {
+  TargetJSON target = ParseTargetWithAttrs("", "aarch64-arm-none-eabi", {"+v9a"});
+  TargetFeatures features = Downcast<TargetFeatures>(target.at("features"));
+  EXPECT_FALSE(Downcast<Bool>(features.at("has_sme")));
+
+  target = ParseTargetWithAttrs("", "aarch64-arm-none-eabi", {"+v9a", "+sme"});
+  features = Downcast<TargetFeatures>(target.at("features"));
+  EXPECT_TRUE(Downcast<Bool>(features.at("has_sme")));
+
+  // SME is an AArch64 only extension
+  target = ParseTargetWithAttrs("", "armv8a-arm-none-eabi", {"+sme"});
+  features = Downcast<TargetFeatures>(target.at("features"));
+  EXPECT_FALSE(Downcast<Bool>(features.at("has_sme")));
+}
+
 INSTANTIATE_TEST_CASE_P(AProfileParser, AProfileOptionalI8MM, ::testing::ValuesIn(optionalI8MM));
 INSTANTIATE_TEST_CASE_P(AProfileParser, AProfileOptionalDotProd,
                         ::testing::ValuesIn(optionalDotProd));
 INSTANTIATE_TEST_CASE_P(AProfileParser, AProfileOptionalSVE,
                         ::testing::Values(8.0, 8.1, 8.2, 8.3, 8.4, 8.5, 8.6, 8.7, 8.8, 8.9, 9.0));
+INSTANTIATE_TEST_CASE_P(AProfileParser, AProfileOptionalSVE2, ::testing::Values(9.0, 9.1, 9.2));
 
 }  // namespace aprofile
 }  // namespace parsers
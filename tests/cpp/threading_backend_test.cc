@@ -124,6 +124,39 @@ TEST(ThreadingBackend, TVMBackendParallelLaunch) {
   EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
 }
 
+TEST(ThreadingBackend, TVMBackendParallelLaunchWorkStealing) {
+  tvm::runtime::threading::ConfigureWorkStealing(4);
+  for (int i = 0; i < 10; ++i) {
+    std::atomic<size_t> acc(0);
+    TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0);
+    EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+  }
+  tvm::runtime::threading::ConfigureWorkStealing(0);
+}
+
+struct NestedLaunchData {
+  std::atomic<size_t> acc{0};
+  std::atomic<size_t> num_outer_tasks{0};
+};
+
+static FTVMParallelLambda nested_launch_task_id = [](int task_id, TVMParallelGroupEnv* penv,
+                                                     void* cdata) -> int {
+  auto* data = reinterpret_cast<NestedLaunchData*>(cdata);
+  data->num_outer_tasks.fetch_add(1, std::memory_order_relaxed);
+  return TVMBackendParallelLaunch(atomic_add_task_id, &data->acc, 0);
+};
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchNested) {
+  for (bool nested : {false, true}) {
+    tvm::runtime::threading::ConfigureNestedParallelism(nested);
+    NestedLaunchData data;
+    EXPECT_EQ(TVMBackendParallelLaunch(nested_launch_task_id, &data, 0), 0);
+    EXPECT_EQ(data.acc.load(std::memory_order_relaxed),
+              data.num_outer_tasks.load(std::memory_order_relaxed) * N * (N - 1) / 2);
+  }
+  tvm::runtime::threading::ConfigureNestedParallelism(false);
+}
+
 TEST(ThreadingBackend, TVMBackendParallelLaunchMultipleThreads) {
   // TODO(tulloch) use parameterised tests when available.
   size_t num_jobs_per_thread = 3;
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file ndarray_bench.cc
+ * \brief Overhead of allocating and copying NDArrays, and of the VM pooled allocator.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/ndarray.h>
+
+#include "../../src/runtime/vm/pooled_allocator.h"
+
+namespace tvm {
+namespace runtime {
+
+static void BM_NDArrayEmpty(benchmark::State& state) {
+  ShapeTuple shape{state.range(0)};
+  DLDataType dtype{kDLFloat, 32, 1};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NDArray::Empty(shape, dtype, {kDLCPU, 0}));
+  }
+}
+BENCHMARK(BM_NDArrayEmpty)->RangeMultiplier(64)->Range(1, 1 << 24);
+
+static void BM_NDArrayCopyFrom(benchmark::State& state) {
+  ShapeTuple shape{state.range(0)};
+  DLDataType dtype{kDLFloat, 32, 1};
+  NDArray src = NDArray::Empty(shape, dtype, {kDLCPU, 0});
+  NDArray dst = NDArray::Empty(shape, dtype, {kDLCPU, 0});
+  for (auto _ : state) {
+    dst.CopyFrom(src);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float));
+}
+BENCHMARK(BM_NDArrayCopyFrom)->RangeMultiplier(64)->Range(1, 1 << 24);
+
+static void BM_PooledAllocatorAllocFree(benchmark::State& state) {
+  // Shared by the threads of the multi-threaded runs, like the allocator of a VM.
+  static vm::PooledAllocator alloc({kDLCPU, 0});
+  DLDataType dtype{kDLFloat, 32, 1};
+  size_t nbytes = state.range(0);
+  for (auto _ : state) {
+    vm::Buffer buf = alloc.Alloc(nbytes, 64, dtype);
+    alloc.Free(buf);
+  }
+}
+BENCHMARK(BM_PooledAllocatorAllocFree)->RangeMultiplier(64)->Range(64, 1 << 26)->ThreadRange(1, 8);
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file packed_func_bench.cc
+ * \brief Overhead of calling PackedFuncs, directly, typed, and through the C API.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+namespace tvm {
+namespace runtime {
+
+TVM_REGISTER_GLOBAL("cppbench.add_one").set_body_typed([](int64_t x) { return x + 1; });
+
+static void BM_PackedFuncCall(benchmark::State& state) {
+  PackedFunc f([](TVMArgs args, TVMRetValue* rv) { *rv = args[0]; });
+  int64_t x = 0;
+  for (auto _ : state) {
+    x = f(x).operator int64_t();
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK(BM_PackedFuncCall);
+
+static void BM_TypedPackedFuncCall(benchmark::State& state) {
+  TypedPackedFunc<int64_t(int64_t)> f = *Registry::Get("cppbench.add_one");
+  int64_t x = 0;
+  for (auto _ : state) {
+    x = f(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK(BM_TypedPackedFuncCall);
+
+static void BM_PackedFuncCallCAPI(benchmark::State& state) {
+  TVMFunctionHandle handle;
+  ICHECK_EQ(TVMFuncGetGlobal("cppbench.add_one", &handle), 0);
+  TVMValue value, ret_value;
+  int type_code = kDLInt, ret_type_code;
+  value.v_int64 = 0;
+  for (auto _ : state) {
+    ICHECK_EQ(TVMFuncCall(handle, &value, &type_code, 1, &ret_value, &ret_type_code), 0);
+    value = ret_value;
+  }
+  benchmark::DoNotOptimize(value.v_int64);
+}
+BENCHMARK(BM_PackedFuncCallCAPI);
+
+static void BM_RegistryGet(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Registry::Get("cppbench.add_one"));
+  }
+}
+BENCHMARK(BM_RegistryGet);
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_bench.cc
+ * \brief Round trip latency of RPC calls, to a server running in a thread of this process.
+ */
+// socketpair is POSIX only.
+#if defined(__linux__) || defined(__APPLE__)
+
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <tvm/runtime/registry.h>
+#include <unistd.h>
+
+#include <memory>
+#include <thread>
+
+#include "../../src/runtime/rpc/rpc_endpoint.h"
+#include "../../src/runtime/rpc/rpc_session.h"
+
+namespace tvm {
+namespace runtime {
+
+TVM_REGISTER_GLOBAL("cppbench.rpc_echo").set_body([](TVMArgs args, TVMRetValue* rv) {
+  *rv = args[0];
+});
+
+/*! \brief RPCChannel over one end of a socketpair. */
+class SocketPairChannel final : public RPCChannel {
+ public:
+  explicit SocketPairChannel(int fd) : fd_(fd) {}
+  ~SocketPairChannel() { close(fd_); }
+
+  size_t Send(const void* data, size_t size) final {
+    ssize_t n = write(fd_, data, size);
+    ICHECK_NE(n, -1) << "Socket write error";
+    return static_cast<size_t>(n);
+  }
+
+  size_t Recv(void* data, size_t size) final {
+    ssize_t n = read(fd_, data, size);
+    ICHECK_NE(n, -1) << "Socket read error";
+    return static_cast<size_t>(n);
+  }
+
+ private:
+  int fd_;
+};
+
+static void BM_RPCRoundTrip(benchmark::State& state) {
+  int fds[2];
+  ICHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  std::thread server([fd = fds[1]]() {
+    RPCEndpoint::Create(std::make_unique<SocketPairChannel>(fd), "cppbench_server", "")
+        ->ServerLoop();
+  });
+  {
+    auto endpt = RPCEndpoint::Create(std::make_unique<SocketPairChannel>(fds[0]),
+                                     "cppbench_client", "cppbench_server");
+    endpt->InitRemoteSession(TVMArgs(nullptr, nullptr, 0));
+    Module sess = CreateRPCSessionModule(CreateClientSession(endpt));
+    PackedFunc echo = sess.GetFunction("cppbench.rpc_echo");
+    ICHECK(echo != nullptr);
+    int64_t x = 0;
+    for (auto _ : state) {
+      x = echo(x + 1).operator int64_t();
+    }
+    benchmark::DoNotOptimize(x);
+  }
+  // Releasing the session shuts down the server loop.
+  server.join();
+}
+BENCHMARK(BM_RPCRoundTrip)->UseRealTime();
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif
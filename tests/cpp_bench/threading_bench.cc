@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file threading_bench.cc
+ * \brief Latency of launching parallel tasks on the runtime thread pool.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_backend_api.h>
+
+#include <atomic>
+
+namespace tvm {
+namespace runtime {
+
+static int EmptyTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  static_cast<std::atomic<int>*>(cdata)->fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+static int BarrierTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  static_cast<std::atomic<int>*>(cdata)->fetch_add(1, std::memory_order_relaxed);
+  return TVMBackendParallelBarrier(task_id, penv);
+}
+
+// The time from launching num_task empty tasks to all of them having returned.
+static void BM_ParallelLaunch(benchmark::State& state) {
+  int num_task = static_cast<int>(state.range(0));
+  std::atomic<int> counter{0};
+  // Warm up, so that the threads of the pool are started.
+  TVMBackendParallelLaunch(EmptyTask, &counter, num_task);
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(EmptyTask, &counter, num_task);
+  }
+  benchmark::DoNotOptimize(counter.load());
+}
+BENCHMARK(BM_ParallelLaunch)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void BM_ParallelBarrier(benchmark::State& state) {
+  int num_task = static_cast<int>(state.range(0));
+  std::atomic<int> counter{0};
+  TVMBackendParallelLaunch(BarrierTask, &counter, num_task);
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(BarrierTask, &counter, num_task);
+  }
+  benchmark::DoNotOptimize(counter.load());
+}
+BENCHMARK(BM_ParallelBarrier)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file vm_bench.cc
+ * \brief Overhead of invoking a Relay VM function and of dispatching its instructions.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/vm/executable.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+// A VM running "main", which loads a constant and moves it back and forth num_moves times.
+static Module MoveChainVM(int num_moves) {
+  auto exec = make_object<Executable>();
+  exec->virtual_devices = {Device{kDLCPU, 0}};
+  exec->host_device_index = 0;
+  std::vector<Instruction> instructions;
+  instructions.push_back(Instruction::LoadConsti(1, 0));
+  for (int i = 0; i < num_moves; ++i) {
+    instructions.push_back(Instruction::Move(i % 2, 1 - i % 2));
+  }
+  instructions.push_back(Instruction::Ret(num_moves % 2));
+  exec->functions.emplace_back("main", std::vector<std::string>{}, instructions, 2,
+                               std::vector<Index>{});
+  exec->global_map["main"] = 0;
+
+  auto vm = make_object<VirtualMachine>();
+  vm->LoadExecutable(exec);
+  Module mod(vm);
+  mod.GetFunction("init")(static_cast<int>(kDLCPU), 0, static_cast<int>(AllocatorType::kPooled));
+  return mod;
+}
+
+static void BM_VMDispatch(benchmark::State& state) {
+  int num_moves = static_cast<int>(state.range(0));
+  Module vm = MoveChainVM(num_moves);
+  PackedFunc invoke = vm.GetFunction("invoke");
+  for (auto _ : state) {
+    ObjectRef ret = invoke("main");
+    benchmark::DoNotOptimize(ret);
+  }
+  // One LoadConsti, the moves, and one Ret per invocation.
+  state.SetItemsProcessed(state.iterations() * (num_moves + 2));
+}
+BENCHMARK(BM_VMDispatch)->Arg(0)->Arg(64)->Arg(4096);
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -112,4 +112,64 @@ TEST(TVMGraphExecutor_Load, Parse) {
   EXPECT_EQ(executor.nodes_count, 3);
 }
 
+// The graph of kJson, in the binary graph format.
+struct alignas(8) BinaryGraph {
+  TVMGraphExecutorBinaryHeader header;
+  int64_t shape[3 * 2];
+  TVMGraphExecutorBinaryNode nodes[3];
+  TVMGraphExecutorNodeEntry node_entries[2];
+  TVMGraphExecutorNodeEntry outputs[1];
+  uint32_t input_nodes[2];
+  uint32_t node_row_ptr[4];
+  uint32_t storage_id[3];
+  uint32_t ndim[3];
+  DLDataType dltype[3];
+  char strings[32];
+};
+
+constexpr const BinaryGraph kBinary = {
+    {kTVMGraphBinaryMagic, kTVMGraphBinaryVersion, 3, 2, 2, 1, 3, 2, 32},
+    {10, 5, 1, 5, 10, 5},
+    {{0, kTVMGraphBinaryNullOp, 0, 0, 1, 0},
+     {2, kTVMGraphBinaryNullOp, 0, 0, 1, 0},
+     {5, 5, 0, 2, 1, 0}},
+    {{0, 0, 0}, {1, 0, 0}},
+    {{2, 0, 0}},
+    {0, 1},
+    {0, 1, 2, 3},
+    {0, 1, 2},
+    {2, 2, 2},
+    {{kDLFloat, 32, 1}, {kDLFloat, 32, 1}, {kDLFloat, 32, 1}},
+    "x\0p0\0tvmgen_default_fused_add",
+};
+
+// Check a binary graph is loaded in place.
+TEST(TVMGraphExecutor_LoadBinary, InPlace) {
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  EXPECT_EQ(TVMGraphExecutor_LoadBinary(&executor, &kBinary), 0);
+  EXPECT_EQ(executor.nodes_count, 3);
+  EXPECT_EQ(executor.nodes, nullptr);
+  EXPECT_EQ(executor.input_nodes_count, 2);
+  EXPECT_EQ(executor.outputs_count, 1);
+  EXPECT_EQ(executor.outputs[0].node_id, 2);
+  EXPECT_EQ(executor.node_row_ptr, kBinary.node_row_ptr);
+  EXPECT_EQ(executor.attrs.shape[1 * executor.shape_stride + 1], 5);
+  EXPECT_EQ(executor.attrs.storage_id[2], 2);
+  EXPECT_EQ(executor.binary_dltype[2].bits, 32);
+  EXPECT_EQ(executor.binary_nodes[2].inputs_count, 2);
+  EXPECT_STREQ(executor.binary_strings + executor.binary_nodes[2].func_name,
+               "tvmgen_default_fused_add");
+  EXPECT_EQ(TVMGraphExecutor_GetInputIndex(&executor, "p0"), 1);
+}
+
+// Check a buffer which is not a binary graph is rejected.
+TEST(TVMGraphExecutor_LoadBinary, BadMagic) {
+  BinaryGraph binary = kBinary;
+  binary.header.magic = 0;
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  EXPECT_NE(TVMGraphExecutor_LoadBinary(&executor, &binary), 0);
+}
+
 }  // namespace
@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/crt/internal/memory/page_allocator.h>
+#include <tvm/runtime/crt/page_allocator.h>
+
+#include "crt_config.h"
+
+#define ROUND_UP(qty, modulo) (((qty) + ((modulo)-1)) / (modulo) * (modulo))
+
+static constexpr const unsigned int kTotalPages = 128;
+static constexpr const unsigned int kPageSizeBytesLog = 8;  // 256 byte pages.
+static constexpr const unsigned int kPageSizeBytes = 1 << kPageSizeBytesLog;
+static constexpr const unsigned int kMemoryPoolSizeBytes = kTotalPages * kPageSizeBytes;
+
+class TLSFPageAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(raw_memory_pool, 0, sizeof(raw_memory_pool));
+    memory_pool = reinterpret_cast<uint8_t*>(
+        ROUND_UP(((uintptr_t)raw_memory_pool), (1 << kPageSizeBytesLog)));
+    ASSERT_EQ(TLSFPageMemoryManagerCreate(&interface, memory_pool, kMemoryPoolSizeBytes,
+                                          kPageSizeBytesLog),
+              kTvmErrorNoError);
+    mgr = reinterpret_cast<TLSFMemoryManager*>(interface);
+    num_pages = mgr->num_pages;
+    ASSERT_GT(num_pages, 0);
+    ASSERT_LE(num_pages, kTotalPages);
+    dev_ = {kDLCPU, 0};
+  }
+
+  unsigned int AddressToPageNumber(void* a) {
+    return (reinterpret_cast<uintptr_t>(a) - reinterpret_cast<uintptr_t>(memory_pool)) >>
+           kPageSizeBytesLog;
+  }
+
+  uint8_t raw_memory_pool[kMemoryPoolSizeBytes + (1 << kPageSizeBytesLog)];
+  uint8_t* memory_pool;
+  MemoryManagerInterface* interface;
+  TLSFMemoryManager* mgr;
+  unsigned int num_pages;
+  DLDevice dev_;
+};
+
+#define EXPECT_PAGE(expected, actual) EXPECT_EQ(expected, AddressToPageNumber(actual))
+
+TEST_F(TLSFPageAllocatorTest, AllocFreeFifo) {
+  EXPECT_EQ(interface->vleak_size, 0);
+
+  for (int i = 0; i < 2; i++) {
+    void* ptrs[kTotalPages];
+    for (size_t idx = 0; idx < num_pages; idx++) {
+      void* a;
+      EXPECT_EQ(interface->Allocate(interface, 1, dev_, &a), kTvmErrorNoError);
+      EXPECT_PAGE(idx, a);
+      EXPECT_EQ(static_cast<size_t>(interface->vleak_size), idx + 1);
+      ptrs[idx] = a;
+    }
+    void* a;
+    EXPECT_EQ(interface->Allocate(interface, 1, dev_, &a), kTvmErrorPlatformNoMemory);
+
+    for (int idx = num_pages - 1; idx >= 0; idx--) {
+      EXPECT_EQ(interface->Free(interface, ptrs[idx], dev_), kTvmErrorNoError);
+      EXPECT_EQ(interface->vleak_size, idx);
+    }
+  }
+}
+
+TEST_F(TLSFPageAllocatorTest, CoalesceFreeNeighbours) {
+  // Split the pool into three blocks, then free them out of order: the whole pool must be
+  // available again as a single block.
+  void* a;
+  void* b;
+  void* c;
+  EXPECT_EQ(interface->Allocate(interface, 3 * kPageSizeBytes, dev_, &a), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, 5 * kPageSizeBytes, dev_, &b), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, (num_pages - 8) * kPageSizeBytes, dev_, &c),
+            kTvmErrorNoError);
+  EXPECT_PAGE(0, a);
+  EXPECT_PAGE(3, b);
+  EXPECT_PAGE(8, c);
+
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, c, dev_), kTvmErrorNoError);
+  // b is still in use, so the pool cannot be allocated as a whole.
+  void* whole;
+  EXPECT_EQ(interface->Allocate(interface, num_pages * kPageSizeBytes, dev_, &whole),
+            kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(interface->Free(interface, b, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, num_pages * kPageSizeBytes, dev_, &whole),
+            kTvmErrorNoError);
+  EXPECT_PAGE(0, whole);
+  EXPECT_EQ(interface->Free(interface, whole, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->vleak_size, 0);
+}
+
+TEST_F(TLSFPageAllocatorTest, ReuseFreedBlock) {
+  void* ptrs[3];
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(interface->Allocate(interface, 4 * kPageSizeBytes, dev_, &ptrs[i]),
+              kTvmErrorNoError);
+  }
+  EXPECT_EQ(interface->Free(interface, ptrs[1], dev_), kTvmErrorNoError);
+  // A smaller request is carved from the hole, and the rest of the hole stays usable.
+  void* a;
+  void* b;
+  EXPECT_EQ(interface->Allocate(interface, 1, dev_, &a), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, 3 * kPageSizeBytes, dev_, &b), kTvmErrorNoError);
+  EXPECT_PAGE(4, a);
+  EXPECT_PAGE(5, b);
+}
+
+TEST_F(TLSFPageAllocatorTest, BadFree) {
+  void* a;
+  EXPECT_EQ(interface->Allocate(interface, 2 * kPageSizeBytes, dev_, &a), kTvmErrorNoError);
+  // Not the start of a block.
+  EXPECT_EQ(interface->Free(interface, static_cast<uint8_t*>(a) + kPageSizeBytes, dev_),
+            kTvmErrorPlatformPageAllocBadFree);
+  // Not page-aligned.
+  EXPECT_EQ(interface->Free(interface, static_cast<uint8_t*>(a) + 1, dev_),
+            kTvmErrorPlatformPageAllocBadFree);
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorNoError);
+  // Double free.
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorPlatformPageAllocBadFree);
+  EXPECT_EQ(interface->vleak_size, 0);
+}
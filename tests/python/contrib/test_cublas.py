@@ -377,5 +377,33 @@ def test_relay_cublas_dense(n, m, k, in_dtype, out_dtype):
     _verify_cublas_relay(dense)
 
 
+@tvm.testing.requires_cuda
+@pytest.mark.parametrize("activation", [None, "relu", "gelu"])
+@pytest.mark.parametrize("dtype", ["float32", "float16"])
+def test_relay_cublas_dense_bias_epilogue(activation, dtype):
+    n, m, k = 64, 128, 32
+    data = tvm.relay.var("data", tvm.relay.TensorType((n, k), dtype))
+    weight = tvm.relay.var("weight", tvm.relay.TensorType((m, k), dtype))
+    bias = tvm.relay.var("bias", tvm.relay.TensorType((m,), dtype))
+    out = relay.nn.bias_add(relay.op.nn.dense(data, weight), bias)
+    if activation == "relu":
+        out = relay.nn.relu(out)
+    elif activation == "gelu":
+
+        def const(value):
+            return relay.const(value, dtype)
+
+        erf = relay.erf(out * const(1 / np.sqrt(2)))
+        out = (erf * const(0.5) + const(0.5)) * out
+
+    # The bias and activation are fused into the cuBLASLt matmul.
+    composite = "cublas.dense_bias" + (f"_{activation}" if activation else "")
+    cublas_mod = partition_for_cublas(tvm.IRModule.from_expr(out))
+    partitions = [func for gv, func in cublas_mod.functions.items() if gv.name_hint != "main"]
+    assert len(partitions) == 1
+    assert partitions[0].body.op.attrs["Composite"] == composite
+    _verify_cublas_relay(out)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -1105,5 +1105,25 @@ def test_dense_transpose_dense():
     verify_dense_transpose_dense(get_dense_transpose_dense(M, N, K), M, N, K)
 
 
+def test_profile_cache():
+    from tvm.contrib.cutlass.gen_tensor_op import ProfileCache
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        ops = [
+            {"name": "cutlass_tensorop_h1688gemm_64x64_32x2_tn_align8", "runtime": float("inf")},
+            {"name": "cutlass_tensorop_h1688gemm_128x64_32x2_tn_align8", "runtime": float("inf")},
+        ]
+        key = ProfileCache.get_key("sm80", "gemm", M, N, K, "float16", "float16", "float16")
+        cache = ProfileCache(tmp_dir)
+        assert cache.lookup(key, ops) is None
+        cache.insert(key, {**ops[1], "runtime": 0.5})
+
+        # A fresh cache, e.g. in another build, reads the recorded kernel back from the disk.
+        op = ProfileCache(tmp_dir).lookup(key, ops)
+        assert op["name"] == ops[1]["name"] and op["runtime"] == 0.5
+        other_key = ProfileCache.get_key("sm75", "gemm", M, N, K, "float16", "float16", "float16")
+        assert ProfileCache(tmp_dir).lookup(other_key, ops) is None
+
+
 if __name__ == "__main__":
     tvm.testing.main()
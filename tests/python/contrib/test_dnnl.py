@@ -969,6 +969,25 @@ def test_dense(run_module, dtype="float32"):
     config = dense, dic, param_lst
     run_and_verify_func(config, run_module=run_module, dtype=dtype)
 
+
+def test_dense_dynamic_batch(run_module, dtype="float32"):
+    x = relay.var("x", shape=(relay.Any(), 16), dtype=dtype)
+    k_data = np.random.uniform(-1, 1, (32, 16)).astype(dtype)
+    dense = relay.nn.dense(x, relay.const(k_data), units=32)
+    mod = partition_for_dnnl(tvm.IRModule.from_expr(dense), alter_layout=False)
+    check_dnnl_used(mod)
+    if not run_module:
+        return
+
+    with tvm.transform.PassContext(opt_level=3):
+        func = relay.create_executor("vm", mod=mod, device=tvm.cpu(), target="llvm").evaluate()
+    # The primitives of each batch size are built once and reused by the later runs.
+    for batch in [2, 5, 2]:
+        x_data = np.random.uniform(-1, 1, (batch, 16)).astype(dtype)
+        tvm.testing.assert_allclose(
+            func(x_data).numpy(), np.dot(x_data, k_data.T), rtol=1e-5, atol=1e-5
+        )
+
     dense, dic, param_lst = get_dense(x_shape, k_shape, activation="gelu", dtype=dtype)
     dense = tvm.IRModule.from_expr(dense)
     config = dense, dic, param_lst
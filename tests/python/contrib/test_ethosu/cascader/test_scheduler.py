@@ -79,5 +79,35 @@ def test_compute_cycles_annotation(SRAM, FLASH, TwoConv2DTE):
         assert op_attrs.pragma_values[0] == compute_cycles_hint
 
 
+def test_choose_proposal_dram_weight(SRAM, FLASH, TwoConv2DTE):
+    device_config = cs.EthosuDeviceConfig("ethos-u55-256")
+    options = infra.make_options(
+        cascade_region=SRAM,
+        max_proposals=64,
+        stripe_factors=4,
+        max_plan_size=10,
+        max_open_plans=8,
+        max_closed_plans=32,
+        always_copy_size=1024,
+        disable_pareto_plans=False,
+        disable_pareto_proposals=False,
+    )
+    _, te_graph, const_dict = TwoConv2DTE
+    graph = cs.create_cascader_graph(te_graph, const_dict, device_config)
+    home_map = cs.scheduler.create_home_map(graph, SRAM, FLASH, [SRAM])
+    proposals = cs.proposal_generator.generate_proposals(graph, home_map, options)
+
+    fastest = cs.scheduler.choose_proposal(proposals, SRAM, -1)
+    frugal = cs.scheduler.choose_proposal(proposals, SRAM, -1, dram_weight=1e6)
+    fitting = [p for p in proposals if p.memory_usage < SRAM.size]
+    # The weights are read from FLASH, so every proposal moves some bytes outside of SRAM
+    assert all(cs.scheduler.get_dram_bytes(p) > 0 for p in proposals)
+    assert fastest.cycles == min(p.cycles for p in fitting)
+    assert cs.scheduler.get_dram_bytes(frugal) == min(
+        cs.scheduler.get_dram_bytes(p) for p in fitting
+    )
+    assert cs.scheduler.get_dram_bytes(frugal) <= cs.scheduler.get_dram_bytes(fastest)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
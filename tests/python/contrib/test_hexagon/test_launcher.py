@@ -617,6 +617,12 @@ def test_lwp(
     graph_mod.run(**inputs)
     hexagon_output = graph_mod.get_output(0).numpy()
 
+    # The same data as a profiling report, without resetting it for get_profile_output
+    report = profiler.get_report(hexagon_session)
+    assert len(report.calls) > 0
+    assert all(call["Device"] == "hexagon0" for call in report.calls)
+    assert "DMA Copies" in report.device_metrics["hexagon0"]
+
     # Get lightweight profiling output as a CSV file
     profiler.get_profile_output(hexagon_launcher, hexagon_session)
 
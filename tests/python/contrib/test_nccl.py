@@ -0,0 +1,105 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import threading
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import te
+from tvm.contrib import nccl
+
+NRANKS = 2
+
+
+def _skip_if_unavailable():
+    if not tvm.get_global_func("tvm.contrib.nccl.init", True):
+        pytest.skip("skip because extern function is not available")
+    if not all(tvm.cuda(i).exist for i in range(NRANKS)):
+        pytest.skip(f"skip because {NRANKS} CUDA devices are required")
+
+
+@tvm.testing.requires_cuda
+def test_collectives_in_group():
+    _skip_if_unavailable()
+    nccl.init(list(range(NRANKS)))
+    assert nccl.size() == NRANKS
+    devs = [tvm.cuda(i) for i in range(NRANKS)]
+    data = [np.random.uniform(size=(4, 8)).astype("float32") for _ in range(NRANKS)]
+    send = [tvm.nd.array(x, dev) for x, dev in zip(data, devs)]
+
+    reduced = [tvm.nd.empty((4, 8), "float32", dev) for dev in devs]
+    gathered = [tvm.nd.empty((4 * NRANKS, 8), "float32", dev) for dev in devs]
+    scattered = [tvm.nd.empty((4 // NRANKS, 8), "float32", dev) for dev in devs]
+    allreduce = tvm.get_global_func("tvm.contrib.nccl.allreduce")
+    allgather = tvm.get_global_func("tvm.contrib.nccl.allgather")
+    reduce_scatter = tvm.get_global_func("tvm.contrib.nccl.reduce_scatter")
+    with nccl.group():
+        for i in range(NRANKS):
+            allreduce(send[i], reduced[i], "sum")
+    with nccl.group():
+        for i in range(NRANKS):
+            allgather(send[i], gathered[i])
+    with nccl.group():
+        for i in range(NRANKS):
+            reduce_scatter(send[i], scattered[i], "max")
+
+    expected_sum = sum(data)
+    expected_max = np.maximum.reduce(data)
+    for i in range(NRANKS):
+        tvm.testing.assert_allclose(reduced[i].numpy(), expected_sum, rtol=1e-5)
+        tvm.testing.assert_allclose(gathered[i].numpy(), np.concatenate(data), rtol=1e-5)
+        tvm.testing.assert_allclose(scattered[i].numpy(), np.split(expected_max, NRANKS)[i])
+
+
+@tvm.testing.requires_cuda
+def test_allreduce_extern():
+    _skip_if_unavailable()
+    nccl.init(list(range(NRANKS)))
+    n = 1024
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.compute((n,), lambda i: A[i] * 2.0, name="B")
+    C = nccl.allreduce(B)
+    s = te.create_schedule(C.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=64)
+    s[B].bind(xo, te.thread_axis("blockIdx.x"))
+    s[B].bind(xi, te.thread_axis("threadIdx.x"))
+    f = tvm.build(s, [A, C], "cuda")
+
+    data = [np.random.uniform(size=n).astype("float32") for _ in range(NRANKS)]
+    outs = [None] * NRANKS
+
+    # One thread per rank, as each rank of a tensor-parallel model would run
+    def _run(rank):
+        dev = tvm.cuda(rank)
+        a = tvm.nd.array(data[rank], dev)
+        c = tvm.nd.empty((n,), "float32", dev)
+        f(a, c)
+        outs[rank] = c.numpy()
+
+    threads = [threading.Thread(target=_run, args=(rank,)) for rank in range(NRANKS)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    for out in outs:
+        tvm.testing.assert_allclose(out, 2.0 * sum(data), rtol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -97,6 +97,39 @@ def test_normal():
     verify()
 
 
+@tvm.testing.uses_gpu
+def test_philox():
+    shape = (1027, 33)
+    philox_uniform = tvm.get_global_func("tvm.contrib.random.philox_uniform", True)
+    philox_normal = tvm.get_global_func("tvm.contrib.random.philox_normal", True)
+    if not philox_uniform:
+        print("skip because extern function is not available")
+        return
+
+    def fill(func, dev, *args):
+        value = tvm.nd.empty(shape, "float32", dev)
+        func(*args, value)
+        return value.numpy()
+
+    cpu = tvm.cpu(0)
+    uniform = fill(philox_uniform, cpu, 42, 0, 0.0, 1.0)
+    assert abs(np.mean(uniform) - 0.5) < 1e-2
+    assert np.min(uniform) >= 0.0 and np.max(uniform) < 1.0
+    # The values only depend on the seed, the offset and the index.
+    np.testing.assert_array_equal(uniform, fill(philox_uniform, cpu, 42, 0, 0.0, 1.0))
+    assert not np.array_equal(uniform, fill(philox_uniform, cpu, 42, 1, 0.0, 1.0))
+    normal = fill(philox_normal, cpu, 42, 0, 3.0, 4.0)
+    assert abs(np.mean(normal) - 3) < 1e-1
+    assert abs(np.std(normal) - 4) < 1e-1
+
+    if tvm.testing.device_enabled("cuda") and tvm.get_global_func(
+        "runtime.contrib.random.PhiloxFillCUDA", True
+    ):
+        dev = tvm.cuda(0)
+        np.testing.assert_array_equal(uniform, fill(philox_uniform, dev, 42, 0, 0.0, 1.0))
+        np.testing.assert_allclose(normal, fill(philox_normal, dev, 42, 0, 3.0, 4.0), atol=1e-4)
+
+
 @tvm.testing.uses_gpu
 def test_random_fill():
     def test_local(dev, dtype):
@@ -186,5 +219,6 @@ if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
+    test_philox()
     test_random_fill()
     test_random_fill_mt()
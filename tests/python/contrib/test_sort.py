@@ -91,6 +91,29 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.numpy(), np_out, rtol=1e-5)
 
 
+def test_topk_and_sort_parallel_rows():
+    # Enough rows to be sorted on the thread pool, with ties that must be broken by index.
+    shape = (64, 1024)
+    k = 10
+    np_data = np.random.randint(0, 100, size=shape).astype("int32")
+    data = tvm.nd.array(np_data)
+
+    values = tvm.nd.empty((shape[0], k), "int32")
+    indices = tvm.nd.empty((shape[0], k), "int64")
+    tvm.get_global_func("tvm.contrib.sort.topk")(data, values, indices, k, -1, "both", False)
+    ref_indices = np.argsort(-np_data, axis=-1, kind="stable")[:, :k]
+    tvm.testing.assert_allclose(indices.numpy(), ref_indices)
+    tvm.testing.assert_allclose(values.numpy(), np.take_along_axis(np_data, ref_indices, -1))
+
+    out = tvm.nd.empty(shape, "int32")
+    tvm.get_global_func("tvm.contrib.sort.sort")(data, out, 0, True)
+    tvm.testing.assert_allclose(out.numpy(), np.sort(np_data, axis=0))
+
+    argsort_out = tvm.nd.empty(shape, "int64")
+    tvm.get_global_func("tvm.contrib.sort.argsort")(data, argsort_out, -1, True)
+    tvm.testing.assert_allclose(argsort_out.numpy(), np.argsort(np_data, axis=-1, kind="stable"))
+
+
 def test_sort_by_key_gpu():
     size = 6
     keys = te.placeholder((size,), name="keys", dtype="int32")
@@ -126,4 +149,5 @@ def test_sort_by_key_gpu():
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_topk_and_sort_parallel_rows()
     test_sort_by_key_gpu()
@@ -17,6 +17,8 @@
 import pytest
 import pathlib
 
+import numpy as np
+
 import tvm
 from tests.python.contrib.test_uma.test_uma_utils import _create_schedule, _generate_io_arrays
 from tvm import topi
@@ -24,8 +26,9 @@ from apps.uma._template.passes import MyAiHwConv2dPass
 import tvm.testing
 from tvm import te
 from tvm.relay.backend.contrib.uma.api.lower import UMALower
-from tvm.relay.backend.contrib.uma.api.utils import PassPhase
+from tvm.relay.backend.contrib.uma.api.utils import PassPhase, double_buffer_dma
 from tvm.relay.backend.contrib.uma import uma_available
+from tests.python.contrib.test_uma.test_uma_vanilla_accelerator import VanillaAcceleratorBackend
 
 
 pytestmark = pytest.mark.skipif(not uma_available(), reason="UMA not available")
@@ -117,5 +120,56 @@ def test_lower_with_uma(n, w, h, ci, kw, kh, co):
     tvm.testing.assert_allclose(dut_results, ref_results, rtol=1e-5)
 
 
+def _row_dma_schedule(sch):
+    block = sch.get_block("compute")
+    row = sch.get_loops(block)[0]
+    copy = sch.cache_read(block, 0, "global")
+    sch.compute_at(copy, row)
+    double_buffer_dma(sch, row, [sch.get(copy).name_hint])
+
+
+def test_double_buffer_dma():
+    a = te.placeholder((16, 16), dtype="float32", name="a")
+    b = te.compute((16, 16), lambda i, j: a[i, j] * 2.0, name="compute")
+    prim_func = te.create_prim_func([a, b]).with_attr("global_symbol", "main")
+
+    uma_lower = UMALower("lower_test")
+    uma_lower._tir_schedules.append(_row_dma_schedule)
+    with tvm.transform.PassContext():
+        prim_func = uma_lower._schedule_stir(prim_func)
+        prim_func = uma_lower._lower_stir_to_nstir(prim_func)
+
+    # The staging buffer of one row holds two versions, the one being copied and the one
+    # being consumed.
+    extents = []
+    tvm.tir.stmt_functor.post_order_visit(
+        prim_func.body,
+        lambda n: extents.append(int(n.extents[0])) if isinstance(n, tvm.tir.Allocate) else None,
+    )
+    assert extents == [32]
+
+    dev = tvm.cpu()
+    a_np = np.random.uniform(size=(16, 16)).astype("float32")
+    a_nd = tvm.nd.array(a_np, dev)
+    b_nd = tvm.nd.empty((16, 16), "float32", dev)
+    tvm.build(prim_func, target="llvm")(a_nd, b_nd)
+    tvm.testing.assert_allclose(b_nd.numpy(), a_np * 2.0, rtol=1e-5)
+
+
+def test_memory_pools():
+    class PooledAcceleratorBackend(VanillaAcceleratorBackend):
+        def __init__(self):
+            super().__init__()
+            self._register_memory_pool("vanilla_sram", size_hint_bytes=1024, read_latency_cycles=2)
+
+    backend = PooledAcceleratorBackend()
+    backend.register()
+    (pool,) = backend.memory_pools()
+    assert pool.pool_name == "vanilla_sram"
+    assert [str(target.kind) for target in pool.targets] == ["vanilla_accelerator"]
+    assert pool.size_hint_bytes == 1024
+    assert pool.read_latency_cycles == 2
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -607,6 +607,78 @@ def test_warp_reduction2():
     check_target("rocm")
 
 
+@tvm.testing.requires_cuda
+def test_multi_warp_reduction():
+    """Test reductions across several warps use a single barrier."""
+    target = tvm.target.Target("cuda")
+    nthx = 256
+    m, n = 16, 1024
+
+    placeholder_a = te.placeholder((m, n), name="A")
+    axis_k = te.reduce_axis((0, n))
+    placeholder_b = te.compute(
+        (m,), lambda i: te.sum(placeholder_a[i][axis_k], axis=axis_k), name="B"
+    )
+    schedule = te.create_schedule(placeholder_b.op)
+    axis_ko, _ = schedule[placeholder_b].split(axis_k, nparts=nthx)
+    schedule[placeholder_b].bind(axis_ko, te.thread_axis((0, nthx), "threadIdx.x"))
+    schedule[placeholder_b].bind(schedule[placeholder_b].op.axis[0], te.thread_axis("blockIdx.x"))
+
+    mod = schedule_to_module(schedule, [placeholder_a, placeholder_b])
+    mod = tvm.tir.transform.Apply(lambda f: f.with_attr("target", target))(mod)
+    mod = tvm.transform.Sequential(
+        [
+            tvm.tir.transform.StorageFlatten(64),
+            tvm.tir.transform.Simplify(),
+            tvm.tir.transform.LowerThreadAllreduce(),
+        ]
+    )(mod)
+
+    syncs = []
+
+    def count_syncs(op):
+        if isinstance(op, tvm.tir.Call) and op.op.same_as(tvm.ir.Op.get("tir.tvm_storage_sync")):
+            syncs.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, count_syncs)
+    assert len(syncs) == 1
+
+    dev = tvm.cuda(0)
+    func = tvm.build(schedule, [placeholder_a, placeholder_b], target)
+    a_np = np.random.uniform(size=(m, n)).astype(placeholder_a.dtype)
+    buff_a = tvm.nd.array(a_np, dev)
+    buff_b = tvm.nd.array(np.zeros((m,), dtype=placeholder_b.dtype), dev)
+    func(buff_a, buff_b)
+    tvm.testing.assert_allclose(buff_b.numpy(), np.sum(a_np, axis=1), rtol=1e-3, atol=1e-3)
+
+
+@tvm.testing.requires_llvm
+def test_webgpu_subgroup_reduction():
+    """Test reductions use subgroup operations on webgpu targets with subgroups."""
+    m, n = 16, 32
+    placeholder_a = te.placeholder((m, n), name="A")
+    axis_k = te.reduce_axis((0, n))
+    placeholder_b = te.compute(
+        (m,), lambda i: te.sum(placeholder_a[i][axis_k], axis=axis_k), name="B"
+    )
+    schedule = te.create_schedule(placeholder_b.op)
+    schedule[placeholder_b].bind(axis_k, te.thread_axis("threadIdx.x"))
+    schedule[placeholder_b].bind(schedule[placeholder_b].op.axis[0], te.thread_axis("blockIdx.x"))
+
+    def get_source(target):
+        target = tvm.target.Target(target, host="llvm")
+        func = tvm.build(schedule, [placeholder_a, placeholder_b], target)
+        return func.imported_modules[0].get_source()
+
+    code = get_source("webgpu -supports_subgroups=1 -thread_warp_size=32")
+    assert "enable subgroups;" in code
+    assert "subgroupShuffleDown" in code
+    assert "subgroupShuffle(" in code
+    # Without subgroups, the reduction goes through workgroup shared memory.
+    code = get_source("webgpu")
+    assert "subgroup" not in code
+
+
 @tvm.testing.requires_cuda
 def test_reduce_storage_reuse():
     """Test reduction reuses storage."""
@@ -109,7 +109,7 @@ def test_create_executor_metadata_single_func():
         "executor": "aot",
         "mod_name": "test_mod",
         "interface_api": "c",
-        "unpacked_api": False,
+        "unpacked_api": True,
         "workspace_alignment": 16,
         "constant_alignment": 1,
         "pool_inputs": {
@@ -160,7 +160,7 @@ def test_create_executor_metadata_no_usmp():
         "executor": "aot",
         "mod_name": "test_mod",
         "interface_api": "c",
-        "unpacked_api": False,
+        "unpacked_api": True,
         "workspace_alignment": 16,
         "constant_alignment": 1,
         "pool_inputs": {},
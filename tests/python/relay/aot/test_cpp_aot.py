@@ -38,7 +38,7 @@ def test_error_c_interface():
     with pytest.raises(
         tvm.TVMError,
         match=re.escape(
-            'Need unpacked-api == false (got: 0) and interface-api == "packed" (got: c) when '
+            'Need unpacked-api == false (got: 1) and interface-api == "packed" (got: c) when '
             "targeting c++ runtime"
         ),
     ):
@@ -152,6 +152,92 @@ def test_mobilenet(enable_usmp: bool, target_kind: str):
     assert (runner.get_output(0).asnumpy() == list(ref_outputs.values())[0]).all()
 
 
+@pytest.mark.parametrize("target_kind", ["c", "llvm"])
+def test_num_cores(target_kind: str):
+    """Independent operators scheduled over several cores compute the same outputs"""
+    relay_model = textwrap.dedent(
+        """\
+        #[version = "0.0.5"]
+        def @main(%data : Tensor[(1, 3, 32, 32), float32],
+                  %weight : Tensor[(3, 3, 3, 3), float32]) {
+            %0 = nn.conv2d(%data, %weight, padding=[1, 1], channels=3, kernel_size=[3, 3]);
+            %1 = nn.max_pool2d(%data, pool_size=[3, 3], padding=[1, 1]);
+            %2 = nn.avg_pool2d(%data, pool_size=[3, 3], padding=[1, 1]);
+            %3 = add(%0, %1);
+            multiply(%3, %2)
+        }
+    """
+    )
+    ir_mod = tvm.relay.fromtext(relay_model)
+    inputs = {"data": np.random.uniform(size=(1, 3, 32, 32)).astype("float32")}
+    params = {"weight": np.random.uniform(size=(3, 3, 3, 3)).astype("float32")}
+    ref_outputs = generate_ref_data(ir_mod, inputs, params)
+
+    with tvm.transform.PassContext(opt_level=3, config={"tir.usmp.enable": False}):
+        mod = tvm.relay.build(
+            ir_mod,
+            params=params,
+            target=target_kind,
+            executor=backend.Executor("aot", {"interface-api": "packed", "num-cores": 2}),
+        )
+    temp_dir = tvm.contrib.utils.TempDirectory()
+    test_so_path = temp_dir / "test.so"
+    mod.export_library(test_so_path, cc="gcc", options=["-std=c11"])
+    loaded_mod = tvm.runtime.load_module(test_so_path)
+    runner = tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+    runner.set_input(**inputs)
+    runner.run()
+    tvm.testing.assert_allclose(
+        runner.get_output(0).numpy(), list(ref_outputs.values())[0], rtol=1e-5
+    )
+
+    with pytest.raises(tvm.TVMError, match="USMP is not supported with num-cores > 1"):
+        with tvm.transform.PassContext(opt_level=3, config={"tir.usmp.enable": True}):
+            tvm.relay.build(
+                ir_mod,
+                params=params,
+                target=target_kind,
+                executor=backend.Executor("aot", {"num-cores": 2}),
+            )
+
+
+@pytest.mark.parametrize("target_kind", ["c", "llvm"])
+def test_zero_copy(target_kind: str):
+    """Buffers bound without copies are read and written in place"""
+    x = relay.var("x", shape=(8, 16), dtype="float32")
+    y = relay.var("y", shape=(8, 16), dtype="float32")
+    ir_mod = IRModule.from_expr(relay.Function([x, y], relay.add(x, y)))
+    with tvm.transform.PassContext(opt_level=3, config={"tir.usmp.enable": False}):
+        mod = tvm.relay.build(
+            ir_mod,
+            target=target_kind,
+            executor=backend.Executor("aot", {"interface-api": "packed"}),
+        )
+    temp_dir = tvm.contrib.utils.TempDirectory()
+    test_so_path = temp_dir / "test.so"
+    mod.export_library(test_so_path, cc="gcc", options=["-std=c11"])
+    loaded_mod = tvm.runtime.load_module(test_so_path)
+    runner = tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+
+    x_data = tvm.nd.array(np.random.uniform(size=(8, 16)).astype("float32"))
+    y_data = tvm.nd.array(np.random.uniform(size=(8, 16)).astype("float32"))
+    out = tvm.nd.empty((8, 16), "float32")
+    runner.set_input_zero_copy(x=x_data, y=y_data)
+    runner.set_output_zero_copy(0, out)
+    runner.run()
+    expected = x_data.numpy() + y_data.numpy()
+    tvm.testing.assert_allclose(out.numpy(), expected)
+    tvm.testing.assert_allclose(runner.get_output(0).numpy(), expected)
+
+    # Updating the bound buffer in place is seen by the next run.
+    x_data.copyfrom(np.zeros((8, 16), "float32"))
+    runner.run()
+    tvm.testing.assert_allclose(out.numpy(), y_data.numpy())
+
+    with pytest.raises(tvm.TVMError):
+        runner.set_input_zero_copy("x", tvm.nd.empty((8, 8), "float32"))
+
+
 def test_module_list():
     """Checks the correct list of module names is generated"""
     input_x = tvm.relay.var("x", tvm.relay.TensorType([1], dtype="float32"))
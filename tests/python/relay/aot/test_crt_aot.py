@@ -464,13 +464,12 @@ def test_mobilenet(debug_calculated_workspaces, workspace_byte_alignment):
 
 
 @pytest.mark.parametrize("merge_compiler_regions", [False, True])
-def test_byoc_microtvm(merge_compiler_regions):
+@pytest.mark.parametrize("interface_api,use_unpacked_api", [("packed", False), ("c", True)])
+def test_byoc_microtvm(merge_compiler_regions, interface_api, use_unpacked_api):
     """
     This is a simple test to check BYOC capabilities of AOT
     with and without merging compiler regions to test for https://github.com/apache/tvm/issues/9036
     """
-    use_unpacked_api = False
-    interface_api = "packed"
     test_runner = AOT_DEFAULT_RUNNER
 
     input_x = relay.var("x", shape=(10, 10))
@@ -516,10 +515,9 @@ def test_byoc_microtvm(merge_compiler_regions):
 
 
 @pytest.mark.parametrize("merge_compiler_regions", [False, True])
-def test_byoc_microtvm_multiple_subgraphs(merge_compiler_regions):
+@pytest.mark.parametrize("interface_api,use_unpacked_api", [("packed", False), ("c", True)])
+def test_byoc_microtvm_multiple_subgraphs(merge_compiler_regions, interface_api, use_unpacked_api):
     """This is a test case to check BYOC capabilities of AOT with multiple sub graphs"""
-    use_unpacked_api = False
-    interface_api = "packed"
     test_runner = AOT_DEFAULT_RUNNER
 
     input_x = relay.var("x", shape=(10, 10))
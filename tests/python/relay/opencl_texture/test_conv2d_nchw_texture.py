@@ -1289,5 +1289,37 @@ def test_injective_nwo_inputs2(remote, target, dtype):
     )
 
 
+@tvm.testing.requires_opencl
+@tvm.testing.parametrize_targets("opencl -device=adreno")
+def test_conv2d_measured_texture_slowdown(remote, target, dtype):
+    """
+    conv2d measured to be slower on textures keeps its tensors in buffers
+    """
+    input_shape = (1, 32, 40, 40)
+    filter_shape = (32, 32, 1, 1)
+    A = relay.var("data", shape=input_shape, dtype=dtype)
+    B = relay.var("weight", shape=filter_shape, dtype=dtype)
+    D = relay.nn.conv2d(A, B, channels=32, kernel_size=(1, 1), out_dtype=dtype)
+    D = relay.op.nn.relu(D)
+
+    mod = relay.Function([A, B], D)
+    np.random.seed(1)
+    initializer = relay.testing.init.Xavier()
+    filter_data = np.zeros(filter_shape).astype(dtype)
+    initializer("weight", filter_data)
+    params1 = {
+        "weight": tvm.nd.array(filter_data),
+    }
+
+    tvm.ir.register_op_attr("nn.conv2d", "TTextureSpeedup", 0.5)
+    try:
+        graph = build_run_compare(
+            remote, mod, params1, {"data": input_shape}, {"data": dtype}, target
+        )
+    finally:
+        relay.op.get("nn.conv2d").reset_attr("TTextureSpeedup")
+    assert "texture" not in graph
+
+
 if __name__ == "__main__":
     tvm.testing.main()
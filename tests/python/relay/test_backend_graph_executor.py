@@ -184,6 +184,56 @@ def test_plan_memory():
     )
 
 
+def test_plan_memory_greedy_by_size():
+    x = relay.var("x", shape=(10,))
+    y = relay.var("x", shape=(1,))
+    y2 = relay.exp(y)
+    z = relay.add(x, y2)
+    z = relay.exp(z)
+    z = relay.exp(z)
+    z = relay.exp(z)
+    z = relay.exp(z)
+    z = relay.exp(z)
+    func = relay.Function([x, y], z)
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps(0)(mod)
+    func = mod["main"]
+    mod = relay.transform.InferType()(mod)
+    config = {"relay.backend.graph_memory_planner": "greedy_by_size"}
+    with tvm.transform.PassContext(config=config):
+        memory_plan = relay.backend._backend.GraphPlanMemory(func)
+
+    storage_ids = set()
+    offsets = set()
+    for k, v in memory_plan.expr_to_storage_info.items():
+        for sid, offset in zip(v.storage_ids, v.storage_offsets):
+            storage_ids.add(int(sid))
+            offsets.add((int(sid), int(offset)))
+
+    # The two inputs keep their own storage, all the other tensors share one arena
+    # where the chain of exp alternates between two aligned slots.
+    assert len(storage_ids) == 3, f"found storage_ids: {storage_ids}"
+    arena_sizes = {int(k): int(v) for k, v in memory_plan.arena_sizes.items()}
+    assert arena_sizes == {2: 104}
+    assert offsets == {(0, 0), (1, 0), (2, 0), (2, 64)}
+
+    x_data = np.random.rand(10).astype("float32")
+    y_data = np.random.rand(1).astype("float32")
+    with tvm.transform.PassContext(opt_level=0, config=config):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(lib.get_graph_json())
+    assert "storage_offset" in graph_json["attrs"]
+    gmod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    gmod.set_input(0, x_data)
+    gmod.set_input(1, y_data)
+    gmod.run()
+    expected = x_data + np.exp(y_data)
+    for _ in range(5):
+        expected = np.exp(expected)
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
 def test_plan_2d_memory():
     """Verification if GraphPlanMemory manages 2d memory reffered as
     global.texture* memory scopes in json file."""
@@ -37,6 +37,15 @@ def test_create_executor_with_default():
     assert not executor["link-params"]
 
 
+def test_create_executor_c_interface_unpacked_api():
+    executor = Executor("aot", {"interface-api": "c"})
+    assert executor["unpacked-api"]
+    executor = Executor("aot", {"interface-api": "c", "unpacked-api": False})
+    assert not executor["unpacked-api"]
+    executor = Executor("aot", {"interface-api": "packed"})
+    assert "unpacked-api" not in executor
+
+
 def test_attr_check():
     executor = Executor("aot", {"interface-api": "c"})
     assert "woof" not in executor
@@ -15,12 +15,15 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import os
+import tempfile
+
 import tvm
 import tvm.testing
 import pytest
 from tvm.relay.transform import CollagePartition, InferType, CapturePostDfsIndexInSpans
 from tvm.target import make_compilation_config
-from tvm.relay.collage import MockCostEstimator
+from tvm.relay.collage import CachingCostEstimator, MockCostEstimator
 from unittest.mock import patch
 from tvm.relay.dataflow_pattern import is_op, wildcard
 
@@ -114,6 +117,42 @@ def test_partition_single_op_llvm(mock_get_pattern_table):
     run_collage(mod, targets, cost_estimator, expected_mod)
 
 
+@patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
+def test_partition_caching_cost_estimator(mock_get_pattern_table):
+    mod_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) {
+        nn.relu(%x)
+      }
+    """
+    mod = tvm.relay.fromtext(mod_txt)
+
+    expected_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) -> Tensor[(10, 10), float32] {
+        nn.relu(%x)
+      }
+    """
+    expected_mod = tvm.relay.fromtext(expected_txt)
+
+    targets = [
+        tvm.target.Target("llvm"),
+        tvm.target.Target("example_target_hook"),
+    ]
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "costs.tsv")
+        mock_estimator = MockCostEstimator({"llvm": 1, "example_target_hook": 2})
+        run_collage(mod, targets, CachingCostEstimator(mock_estimator, path), expected_mod)
+        with open(path) as cache_file:
+            num_costs = len(cache_file.readlines())
+        assert num_costs > 0
+        # All the costs come from the file, the mock estimator knows none of the targets
+        empty_estimator = MockCostEstimator({})
+        run_collage(mod, targets, CachingCostEstimator(empty_estimator, path), expected_mod)
+        with open(path) as cache_file:
+            assert len(cache_file.readlines()) == num_costs
+
+
 @patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
 def test_partition_single_op_byoc(mock_get_pattern_table):
     mod_txt = """
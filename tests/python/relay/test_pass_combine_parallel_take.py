@@ -0,0 +1,121 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,too-many-locals,too-many-arguments,missing-module-docstring
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+
+def run_opt_pass(expr, opt_pass):
+    "runs the opt_pass on the expr of a function the function"
+    assert isinstance(opt_pass, tvm.transform.Pass)
+    mod = tvm.IRModule.from_expr(expr)
+    mod = tvm.relay.transform.InferType()(mod)
+    mod = opt_pass(mod)
+    return mod["main"]
+
+
+def test_combine_parallel_take():
+    """Simple testcase."""
+
+    def before(table, i1, i2, i3):
+        args = [table, i1, i2, i3]
+        y1 = relay.take(table, i1, axis=0)
+        y2 = relay.take(table, i2, axis=0)
+        y3 = relay.take(table, i3, axis=0)
+        y = relay.Tuple((y1, y2, y3))
+        return relay.Function(args, y)
+
+    def expected(table, i1, i2, i3):
+        args = [table, i1, i2, i3]
+        indices = relay.stack((i1, i2, i3), axis=0)
+        y = relay.take(table, indices, axis=0)
+        y1, y2, y3 = relay.split(y, 3, 0).astuple()
+        y1 = relay.squeeze(y1, [0])
+        y2 = relay.squeeze(y2, [0])
+        y3 = relay.squeeze(y3, [0])
+        y = relay.Tuple((y1, y2, y3))
+        return relay.Function(args, y)
+
+    def check(n, b, m):
+        table = relay.var("table", shape=(n, m))
+        i1 = relay.var("i1", shape=(b,), dtype="int32")
+        i2 = relay.var("i2", shape=(b,), dtype="int32")
+        i3 = relay.var("i3", shape=(b,), dtype="int32")
+
+        y_before = before(table, i1, i2, i3)
+        y = run_opt_pass(y_before, transform.CombineParallelTake(min_num_branches=2))
+        y_expected = expected(table, i1, i2, i3)
+        y_expected = run_opt_pass(y_expected, transform.InferType())
+        tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    check(10, 3, 4)
+    check(100, 16, 8)
+
+
+def test_combine_parallel_take_biasadd():
+    """Testcase of combining take + 1d biasadd"""
+
+    def before(table, i1, i2, b1, b2):
+        args = [table, i1, i2, b1, b2]
+        y1 = relay.add(relay.take(table, i1, axis=0), b1)
+        y2 = relay.add(relay.take(table, i2, axis=0), b2)
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    def expected(table, i1, i2, b1, b2):
+        args = [table, i1, i2, b1, b2]
+        y = relay.take(table, relay.stack((i1, i2), axis=0), axis=0)
+        b = relay.stack((relay.expand_dims(b1, 0, 1), relay.expand_dims(b2, 0, 1)), axis=0)
+        y = relay.add(y, b)
+        y1, y2 = relay.split(y, 2, 0).astuple()
+        y1 = relay.squeeze(y1, [0])
+        y2 = relay.squeeze(y2, [0])
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    table = relay.var("table", shape=(10, 4))
+    i1 = relay.var("i1", shape=(3,), dtype="int32")
+    i2 = relay.var("i2", shape=(3,), dtype="int32")
+    b1 = relay.var("b1", shape=(4,))
+    b2 = relay.var("b2", shape=(4,))
+
+    y_before = before(table, i1, i2, b1, b2)
+    y = run_opt_pass(y_before, transform.CombineParallelTake(min_num_branches=2))
+    y_expected = expected(table, i1, i2, b1, b2)
+    y_expected = run_opt_pass(y_expected, transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+def test_combine_parallel_take_different_indices_shape():
+    """Takes whose indices differ in shape are left alone"""
+    table = relay.var("table", shape=(10, 4))
+    i1 = relay.var("i1", shape=(3,), dtype="int32")
+    i2 = relay.var("i2", shape=(5,), dtype="int32")
+    y = relay.Tuple((relay.take(table, i1, axis=0), relay.take(table, i2, axis=0)))
+    func = relay.Function([table, i1, i2], y)
+
+    y = run_opt_pass(func, transform.CombineParallelTake(min_num_branches=2))
+    y_expected = run_opt_pass(func, transform.InferType())
+    tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+
+if __name__ == "__main__":
+    test_combine_parallel_take()
+    test_combine_parallel_take_biasadd()
+    test_combine_parallel_take_different_indices_shape()
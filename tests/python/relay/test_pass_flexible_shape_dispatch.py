@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 """Test flexible shape dispatch pass"""
+import json
+
 import numpy as np
 import pytest
 import tvm
@@ -115,5 +117,30 @@ def test_multiple_outputs():
     assert list(result_10[1].shape) == [10, 5]
 
 
+def test_build_buckets():
+    x = relay.var("x", shape=[relay.Any(), 4], dtype="float32")
+    w = relay.var("w", shape=[8, 4], dtype="float32")
+    y = relay.var("y", shape=[4], dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Tuple([relay.nn.dense(x, w), relay.exp(y)]))
+    factory = relay.build_buckets(mod, [1, 4], target="llvm")
+
+    # The buckets share the kernel of exp, which does not depend on the batch
+    def kernels(bucket):
+        graph = json.loads(factory.graphs[bucket][0])
+        return {node["attrs"]["func_name"] for node in graph["nodes"] if node["op"] == "tvm_op"}
+
+    assert len(kernels(1) & kernels(4)) == 1
+
+    module = factory.create(tvm.cpu())
+    w_np = np.random.normal(size=[8, 4]).astype("float32")
+    y_np = np.random.normal(size=[4]).astype("float32")
+    # Batch 3 is not a bucket, and runs on the VM
+    for batch in [1, 4, 3]:
+        x_np = np.random.normal(size=[batch, 4]).astype("float32")
+        dense_out, exp_out = module.run(x_np, w_np, y_np)
+        tvm.testing.assert_allclose(dense_out.numpy(), x_np @ w_np.T, rtol=1e-5)
+        tvm.testing.assert_allclose(exp_out.numpy(), np.exp(y_np), rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
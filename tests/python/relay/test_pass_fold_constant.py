@@ -219,6 +219,29 @@ def test_fold_concat():
     tvm.ir.assert_structural_equal(zz, zexpected)
 
 
+def test_fold_repeated_subexpression():
+    w_data = np.random.rand(4, 8).astype("float32")
+    t = relay.TensorType([8, 4], "float32")
+
+    def before():
+        x = relay.var("x", t)
+        # Distinct constant nodes holding the same data.
+        y = relay.add(x, relay.transpose(relay.const(w_data)))
+        z = relay.multiply(y, relay.transpose(relay.const(w_data)))
+        return relay.Function([x], z)
+
+    def expected():
+        x = relay.var("x", t)
+        w_t = relay.const(w_data.T)
+        return relay.Function([x], relay.multiply(relay.add(x, w_t), w_t))
+
+    zz = run_opt_pass(before(), transform.FoldConstant())
+    zexpected = run_opt_pass(expected(), transform.InferType())
+    tvm.ir.assert_structural_equal(zz, zexpected)
+    # Both occurrences are folded to the very same constant.
+    assert zz.body.args[1].same_as(zz.body.args[0].args[1])
+
+
 def test_fold_if():
     cond_data = np.array(1).astype("bool")
     x_data = np.array([[1, 2, 3]]).astype("float32")
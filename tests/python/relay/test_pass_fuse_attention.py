@@ -0,0 +1,92 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+from tvm.relay.testing import run_opt_pass
+
+
+def _attention(scale_op="multiply", transpose_value=False):
+    q = relay.var("q", shape=(4, 32, 64), dtype="float32")
+    k = relay.var("k", shape=(4, 96, 64), dtype="float32")
+    v = relay.var("v", shape=(4, 96, 48), dtype="float32")
+    score = relay.nn.batch_matmul(q, k)
+    if scale_op == "multiply":
+        score = relay.multiply(score, relay.const(0.125))
+    elif scale_op == "divide":
+        score = relay.divide(score, relay.const(8.0))
+    prob = relay.nn.softmax(score, axis=-1)
+    if transpose_value:
+        out = relay.nn.batch_matmul(prob, relay.transpose(v, [0, 2, 1]))
+    else:
+        out = relay.nn.batch_matmul(prob, v, transpose_b=False)
+    return relay.Function([q, k, v], out)
+
+
+def test_fuse_attention():
+    def expected(scale):
+        q = relay.var("q", shape=(4, 32, 64), dtype="float32")
+        k = relay.var("k", shape=(4, 96, 64), dtype="float32")
+        v = relay.var("v", shape=(4, 96, 48), dtype="float32")
+        out = relay.nn.fused_attention(q, k, v, scale, out_dtype="float32")
+        return relay.Function([q, k, v], out)
+
+    for scale_op, scale in [("multiply", 0.125), ("divide", 0.125), (None, 1.0)]:
+        after = run_opt_pass(_attention(scale_op), transform.FuseAttention())
+        tvm.ir.assert_structural_equal(after, run_opt_pass(expected(scale), transform.InferType()))
+
+
+def test_fuse_attention_transposed_value():
+    after = run_opt_pass(
+        _attention(transpose_value=True),
+        tvm.transform.Sequential([transform.FuseAttention(), transform.SimplifyExpr()]),
+    )
+    assert isinstance(after.body, relay.Call)
+    assert after.body.op.name == "nn.fused_attention"
+    # The transpose back to [b, n, d] cancels the transpose in the graph
+    assert isinstance(after.body.args[2], relay.Var)
+
+
+def test_no_fuse_attention_on_other_axis():
+    q = relay.var("q", shape=(4, 32, 64), dtype="float32")
+    k = relay.var("k", shape=(4, 96, 64), dtype="float32")
+    v = relay.var("v", shape=(4, 32, 48), dtype="float32")
+    prob = relay.nn.softmax(relay.nn.batch_matmul(q, k), axis=1)
+    out = relay.nn.batch_matmul(relay.transpose(prob, [0, 2, 1]), v, transpose_b=False)
+    before = relay.Function([q, k, v], out)
+    after = run_opt_pass(before, transform.FuseAttention())
+    tvm.ir.assert_structural_equal(after, run_opt_pass(before, transform.InferType()))
+
+
+def test_fuse_attention_numerics():
+    func = _attention("divide")
+    mod = tvm.IRModule.from_expr(func)
+    fused_mod = transform.FuseAttention()(transform.InferType()(mod))
+    inputs = [
+        np.random.uniform(-1, 1, size=(4, 32, 64)).astype("float32"),
+        np.random.uniform(-1, 1, size=(4, 96, 64)).astype("float32"),
+        np.random.uniform(-1, 1, size=(4, 96, 48)).astype("float32"),
+    ]
+    ref = relay.create_executor("graph", mod=mod, target="llvm").evaluate()(*inputs)
+    out = relay.create_executor("graph", mod=fused_mod, target="llvm").evaluate()(*inputs)
+    tvm.testing.assert_allclose(out.numpy(), ref.numpy(), rtol=1e-5, atol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -766,6 +766,34 @@ def test_fuse_max_diamond():
     assert tvm.ir.structural_equal(fused, expected)
 
 
+def test_fuse_max_function_args():
+    """Test the limit on the number of arguments of fused functions."""
+
+    def before(num_inputs):
+        inputs = [relay.var("x%d" % i, shape=(10, 20)) for i in range(num_inputs)]
+        out = inputs[0]
+        for x in inputs[1:]:
+            out = relay.add(out, x)
+        return relay.Function(inputs, out)
+
+    def after():
+        def fused_add3():
+            p = [relay.var("p%d" % i, shape=(10, 20)) for i in range(3)]
+            f = relay.Function(p, relay.add(relay.add(p[0], p[1]), p[2]))
+            return f.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+
+        inputs = [relay.var("x%d" % i, shape=(10, 20)) for i in range(5)]
+        y = relay.Call(fused_add3(), inputs[:3])
+        out = relay.Call(fused_add3(), [y] + inputs[3:])
+        return relay.Function(inputs, out)
+
+    with tvm.transform.PassContext(config={"relay.FuseOps.max_function_args": 3}):
+        fused = run_opt_pass(before(5), transform.FuseOps())
+
+    expected = run_opt_pass(after(), transform.InferType())
+    assert tvm.ir.structural_equal(fused, expected)
+
+
 def test_fuse_dynamic_squeeze_slice_take():
     input_data = [
         np.random.random([1, 2, 4]).astype("float32"),
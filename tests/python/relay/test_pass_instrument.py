@@ -16,11 +16,13 @@
 # under the License.
 """ Instrument test cases.
 """
+import json
+
 import pytest
 import tvm
 import tvm.relay
 from tvm.relay import op
-from tvm.ir.instrument import PassTimingInstrument, pass_instrument
+from tvm.ir.instrument import PassProfileInstrument, PassTimingInstrument, pass_instrument
 
 
 def get_test_model():
@@ -59,6 +61,27 @@ def test_pass_timing_instrument():
     assert profiles == ""
 
 
+def test_pass_profile_instrument(tmp_path):
+    output_path = str(tmp_path / "passes.json")
+    profile = PassProfileInstrument(output_path, budgets={"ToANormalForm": {"ir_size_growth": 1.0}})
+
+    mod = get_test_model()
+    with pytest.warns(UserWarning, match="ToANormalForm exceeds its budget of ir_size_growth"):
+        with tvm.transform.PassContext(instruments=[profile]):
+            mod = tvm.relay.transform.InferType()(mod)
+            mod = tvm.relay.transform.ToANormalForm()(mod)
+
+    names = [record["name"] for record in profile.records]
+    assert "InferType" in names
+    assert "ToANormalForm" in names
+    for record in profile.records:
+        assert record["time_ms"] >= 0
+        assert record["peak_rss_delta_kb"] >= 0
+        assert record["ir_size_before"] > 0
+    with open(output_path) as f:
+        assert json.load(f) == profile.records
+
+
 instrument_definition_type = tvm.testing.parameter("decorator", "subclass")
 
 
@@ -535,6 +535,24 @@ def test_nested_sequential_with_scoping():
     assert tvm.ir.structural_equal(zz, expected)
 
 
+def test_sequential_with_object_pool():
+    def before():
+        x = relay.var("x", shape=(1, 16, 16, 16), dtype="float32")
+        c = relay.add(relay.const(1.0), relay.const(2.0))
+        y = relay.reshape(relay.add(x, c), newshape=(1, 16, -1))
+        y = relay.reshape(y, newshape=(16, -1))
+        return tvm.IRModule.from_expr(y)
+
+    passes = tvm.transform.Sequential(
+        [relay.transform.FoldConstant(), relay.transform.SimplifyExpr()]
+    )
+    with tvm.transform.PassContext(opt_level=3):
+        expected = passes(before())
+    with tvm.transform.PassContext(opt_level=3, config={"ir.enable_object_pool": True}):
+        zz = passes(before())
+    tvm.ir.assert_structural_equal(zz, expected)
+
+
 def test_print_ir(capfd):
     shape = (1, 2, 3)
     tp = relay.TensorType(shape, "float32")
@@ -1746,6 +1746,55 @@ def test_lowered():
     exercise(input(), expected(), None, None)
 
 
+def test_cost_based_placement():
+    metatable = {"VirtualDevice": [CPU, GPU]}
+
+    def input():
+        return tvm.relay.parse(
+            """
+            #[version = "0.0.5"]
+            def @main(%a {virtual_device=meta[VirtualDevice][0]}: Tensor[(64, 1024), float32],
+                      %s {virtual_device=meta[VirtualDevice][0]}: Tensor[(4), float32],
+                      %w: Tensor[(1024, 1024), float32]) {
+              // Cheap, stays next to its argument on the CPU
+              %0 = add(%s, %s);
+              // Expensive, worth copying %a to the GPU
+              %1 = nn.dense(%a, %w);
+              (%0, %1)
+            }
+        """,
+            "from_string",
+            None,
+            metatable,
+        )
+
+    def placement(config_options):
+        ctxt = tvm.transform.PassContext(
+            config={"relay.fallback_device_type": DEFAULT.device_type_int, **config_options}
+        )
+        config = tvm.target.make_compilation_config(ctxt, TARGETS)
+        with ctxt:
+            mod = relay.transform.InferType()(input())
+            mod = relay.transform.PlanDevices(config)(mod)
+            mod = relay.transform.InferType()(mod)
+        raw_map = recover_virtual_device_map(mod, mod["main"])
+        return {
+            e.op.name: d.device_type
+            for e, d in raw_map.items()
+            if isinstance(e, relay.Call)
+            and isinstance(e.op, tvm.ir.Op)
+            and e.op.name in ["add", "nn.dense"]
+        }
+
+    # Without the option the dense follows %a to the CPU.
+    assert placement({}) == {"add": CPU.device_type, "nn.dense": CPU.device_type}
+    options = {"relay.PlanDevices.cost_based_placement": True}
+    assert placement(options) == {"add": CPU.device_type, "nn.dense": GPU.device_type}
+    # The dense result does not fit in the device memory limit.
+    options["relay.PlanDevices.device_memory_limit"] = 1024
+    assert placement(options) == {"add": CPU.device_type, "nn.dense": CPU.device_type}
+
+
 def test_stack_overflow():
     metatable = {"VirtualDevice": [CPU, GPU]}
 
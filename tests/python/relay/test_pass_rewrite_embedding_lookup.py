@@ -0,0 +1,86 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+from tvm.relay.testing import run_opt_pass
+
+
+def _lookup(indices_shape, reduce_op=None, mode="clip"):
+    table = relay.var("table", shape=(1000, 16), dtype="float32")
+    indices = relay.var("indices", shape=indices_shape, dtype="int64")
+    out = relay.take(table, indices, axis=0, mode=mode)
+    if reduce_op is not None:
+        out = reduce_op(out, axis=len(indices_shape) - 1)
+    return relay.Function([table, indices], out)
+
+
+def test_rewrite_embedding_gather():
+    after = run_opt_pass(_lookup((8, 4)), transform.RewriteEmbeddingLookup(0))
+    assert after.body.op.name == "nn.contrib_embedding_lookup"
+    assert after.body.attrs.mode == "none"
+    assert tuple(after.body.checked_type.shape) == (8, 4, 16)
+
+
+def test_rewrite_embedding_bag():
+    for reduce_op, mode in [(relay.sum, "sum"), (relay.mean, "mean")]:
+        after = run_opt_pass(_lookup((8, 4), reduce_op), transform.RewriteEmbeddingLookup(0))
+        assert after.body.op.name == "nn.contrib_embedding_lookup"
+        assert after.body.attrs.mode == mode
+        assert tuple(after.body.checked_type.shape) == (8, 16)
+
+
+def test_no_rewrite_embedding_lookup():
+    # small tables, wrapped indices and reductions over the embedding axis are left alone
+    for before, min_table_bytes in [(_lookup((8, 4)), 1 << 20), (_lookup((8, 4), mode="wrap"), 0)]:
+        after = run_opt_pass(before, transform.RewriteEmbeddingLookup(min_table_bytes))
+        tvm.ir.assert_structural_equal(after, run_opt_pass(before, transform.InferType()))
+    table = relay.var("table", shape=(1000, 16), dtype="float32")
+    indices = relay.var("indices", shape=(8, 4), dtype="int64")
+    before = relay.Function([table, indices], relay.sum(relay.take(table, indices, axis=0), axis=2))
+    after = run_opt_pass(before, transform.RewriteEmbeddingLookup(0))
+    assert after.body.op.name == "sum"
+    assert after.body.args[0].op.name == "nn.contrib_embedding_lookup"
+
+
+@tvm.testing.requires_llvm
+def test_embedding_lookup_numerics():
+    if not tvm.get_global_func("tvm.contrib.embedding.lookup", True):
+        print("skip because embedding lookup is not enabled...")
+        return
+    np_table = np.random.uniform(size=(1000, 16)).astype("float32")
+    # enough indices to take the sorted and parallel paths, with out of bound ones clipped
+    np_indices = np.random.randint(-10, 1010, size=(256, 12)).astype("int64")
+    clipped = np.clip(np_indices, 0, 999)
+    for reduce_op, ref in [
+        (None, np_table[clipped]),
+        (relay.sum, np_table[clipped].sum(axis=1)),
+        (relay.mean, np_table[clipped].mean(axis=1)),
+    ]:
+        mod = tvm.IRModule.from_expr(_lookup(np_indices.shape, reduce_op))
+        mod = transform.RewriteEmbeddingLookup(0)(transform.InferType()(mod))
+        assert mod["main"].body.op.name == "nn.contrib_embedding_lookup"
+        out = relay.create_executor("graph", mod=mod, target="llvm").evaluate()(
+            np_table, np_indices
+        )
+        tvm.testing.assert_allclose(out.numpy(), ref, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -752,6 +752,32 @@ def test_simplify_cast_clip():
     assert tvm.ir.structural_equal(opt, ref)
 
 
+def test_simplify_layout_transform_around_elemwise():
+    x = relay.var("x", shape=(1, 8, 16, 16), dtype="float32")
+
+    def before():
+        y = relay.layout_transform(x, "NCHW", "NCHW4c")
+        y = relay.nn.relu(y)
+        y = relay.cast(y, "float16")
+        return relay.layout_transform(y, "NCHW4c", "NCHW")
+
+    def expected():
+        return relay.cast(relay.nn.relu(x), "float16")
+
+    def not_inverse():
+        y = relay.layout_transform(x, "NCHW", "NCHW4c")
+        y = relay.nn.relu(y)
+        return relay.layout_transform(y, "NCHW4c", "NHWC")
+
+    opt = run_opt_pass(before(), transform.SimplifyExpr())
+    ref = run_infer_type(expected())
+    assert tvm.ir.structural_equal(opt, ref)
+
+    opt = run_opt_pass(not_inverse(), transform.SimplifyExpr())
+    ref = run_infer_type(not_inverse())
+    assert tvm.ir.structural_equal(opt, ref)
+
+
 def test_simplify_add():
     x = relay.var("x", shape=(1, 3, 100, 100), dtype="float32")
 
@@ -623,5 +623,48 @@ def test_pipeline():
             reset_cpu_affinity(affinity)
 
 
+def test_auto_partition():
+    data = relay.var("data_a", relay.TensorType((1, 32), "float32"))
+    weights = [np.random.uniform(size=(32, 32)).astype("float32") for _ in range(4)]
+    out = data
+    for weight in weights:
+        out = relay.nn.relu(relay.nn.dense(out, relay.const(weight)))
+    # "data_a" is forwarded from the first stage to the stage using it again.
+    out = relay.add(out, data)
+    mod = tvm.IRModule.from_expr(relay.Function([data], out))
+
+    stages = [{"target": "llvm", "dev": tvm.cpu(0), "cpu_affinity": "0"} for _ in range(2)]
+    pipe_config, stage_costs = pipeline_executor_build.auto_partition(mod, stages)
+    assert len(stage_costs) == 2
+    # Each stage holds two of the four dense layers.
+    assert max(stage_costs) < 0.6 * sum(stage_costs)
+    mconfig = pipe_config.get_config()
+    assert len(mconfig["module_connection"]) == 2
+    assert mconfig["input_connection"] == [
+        {"global_interface_name": "data_a", "mod_idx": 0, "module_interface_name": "data_a"}
+    ]
+
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    affinity = os.sched_getaffinity(0)
+    with tvm.transform.PassContext(opt_level=3):
+        pipeline_mod_factory = pipeline_executor_build.build(pipe_config)
+        lib = relay.build(mod, "llvm")
+    pipeline_module = pipeline_executor.PipelineModule(pipeline_mod_factory)
+    module = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+    data_in = np.random.uniform(size=(1, 32)).astype("float32")
+    module.run(data_a=data_in)
+    pipeline_module.set_input("data_a", tvm.nd.array(data_in))
+    pipeline_module.run()
+    outputs = pipeline_module.get_output()
+    for _ in range(5):
+        if outputs:
+            break
+        time.sleep(1)
+        outputs = pipeline_module.get_output()
+    tvm.testing.assert_allclose(outputs[0].numpy(), module.get_output(0).numpy(), rtol=1e-5)
+    reset_cpu_affinity(affinity)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
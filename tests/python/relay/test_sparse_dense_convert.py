@@ -86,5 +86,28 @@ def test_bsr_sparse_dense():
     np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
 
 
+def test_bsr_sparse_dense_auto():
+    data = relay.var("data", shape=(1, 128), dtype="float32")
+    w = relay.var("weight", shape=(768, 128), dtype="float32")
+    z = relay.nn.relu(relay.nn.dense(data, w))
+    func = relay.Function(relay.analysis.free_vars(z), z)
+
+    w_np = random_bsr_matrix(768, 128, 32, 1, 0.1).todense()
+    bsr_dense = relay.data_dep_optimization.bsr_dense
+    assert bsr_dense._block_sparsity(np.asarray(w_np), (32, 1)) >= 0.8
+    assert bsr_dense._block_sparsity(np.asarray(w_np), (7, 1)) == 0.0
+
+    params = {"weight": tvm.nd.array(w_np)}
+    x_np = np.random.randn(1, 128).astype("float32")
+    dense_output = run_func(func, params, x_np)
+    # Whichever format is measured faster, the outputs stay the same
+    sparse_func, params = bsr_dense.convert_auto(
+        func, params, "llvm", blocksizes=[(16, 1), (32, 1)], number=1, repeat=1
+    )
+    sparse_output = run_func(sparse_func, params, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_bsr_sparse_dense()
+    test_bsr_sparse_dense_auto()
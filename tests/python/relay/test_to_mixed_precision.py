@@ -167,6 +167,38 @@ def test_convert_single_conv(target_precision):
     assert tvm.ir.structural_equal(amp_mod, expected_mod)
 
 
+def test_never_ops_keep_conv_in_fp32(target_precision):
+    """Ops given in the never_ops config are kept in fp32, even if they are green listed."""
+    data_shape = (1, 3, 32, 32)
+    weight_shape = (5, 3, 3, 3)
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight = relay.var("weight", shape=weight_shape, dtype="float32")
+    conv = relay.nn.conv2d(data, weight, strides=(1, 1), padding=(1, 1), out_dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.nn.relu(conv))
+    mod = tvm.relay.transform.InferType()(mod)
+
+    with tvm.transform.PassContext(config={"relay.ToMixedPrecision.never_ops": ["nn.conv2d"]}):
+        amp_mod = ToMixedPrecision(target_precision)(mod)
+    assert tvm.ir.structural_equal(amp_mod, mod)
+
+
+def test_search_mixed_precision():
+    data_shape = (1, 3, 16, 16)
+    weight_shape = (8, 3, 3, 3)
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight = relay.var("weight", shape=weight_shape, dtype="float32")
+    conv = relay.nn.conv2d(data, weight, padding=(1, 1))
+    mod = tvm.IRModule.from_expr(relay.nn.relu(conv))
+    params = {"weight": np.random.uniform(-1, 1, size=weight_shape).astype("float32")}
+    dataset = [{"data": np.random.uniform(-1, 1, size=data_shape).astype("float32")}]
+
+    # No reduced precision result matches fp32 exactly, so that conv2d is kept in fp32
+    never_ops = mixed_precision.search_mixed_precision(
+        mod, params, "llvm", dataset, rtol=0, atol=0, number=1, repeat=1
+    )
+    assert never_ops == ["nn.conv2d"]
+
+
 def test_convert_single_conv_fp64():
     """As above but checks choosing a mixed_precision_type other than FP16 works"""
     data_shape = (1, 3, 32, 32)
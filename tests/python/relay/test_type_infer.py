@@ -283,6 +283,38 @@ def test_global_var_recursion():
     assert func_ty == relay.FuncType([tt], tt)
 
 
+def test_incremental_infer_type():
+    x = relay.var("x", shape=[3], dtype="float32")
+    y = relay.var("y", shape=[3], dtype="float32")
+    mod = tvm.IRModule()
+    f = relay.GlobalVar("f")
+    mod[f] = relay.Function([y], relay.nn.relu(y))
+    mod["g"] = relay.Function([y], relay.exp(y))
+    mod["main"] = relay.Function([x], relay.Call(f, [x]))
+    mod = transform.InferType()(mod)
+    old_g = mod["g"]
+    old_main = mod["main"]
+
+    # Only the changed function is checked again, as its type does not change
+    mod[f] = relay.Function([y], relay.sigmoid(y))
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        mod = transform.InferType()(mod)
+    assert mod["g"].same_as(old_g)
+    assert mod["main"].same_as(old_main)
+    assert mod[f].body.checked_type == relay.TensorType([3], "float32")
+
+    # The callers are checked again if the type of the changed function changes
+    mod[f] = relay.Function([y], relay.cast(y, "float16"))
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        mod = transform.InferType()(mod)
+    assert mod["g"].same_as(old_g)
+    assert mod["main"].checked_type.ret_type == relay.TensorType([3], "float16")
+
+    # All the functions are checked again by default
+    mod = transform.InferType()(mod)
+    assert not mod["g"].same_as(old_g)
+
+
 def test_equal():
     i = relay.var("i", shape=[], dtype="int32")
     eq = op.equal(i, relay.const(0, dtype="int32"))
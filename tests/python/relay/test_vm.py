@@ -705,6 +705,178 @@ def test_vm_optimize_dynamic():
     assert "shape_func" in opt_mod.astext(False)
 
 
+def test_vm_shape_func_memo():
+    dtype = "float32"
+    x = relay.var("x", shape=(relay.Any(), relay.Any()), dtype=dtype)
+    y = relay.var("y", shape=(relay.Any(), relay.Any()), dtype=dtype)
+    mod = tvm.IRModule()
+    mod["main"] = relay.Function([x, y], relay.concatenate([x + y, x], axis=0))
+    exe = relay.vm.compile(mod, target="llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    vm.set_shape_func_memo(True)
+    for shape in [(2, 3), (4, 3), (2, 3), (2, 5)]:
+        x_np = np.random.rand(*shape).astype(dtype)
+        y_np = np.random.rand(*shape).astype(dtype)
+        res = vm.invoke("main", x_np, y_np)
+        tvm.testing.assert_allclose(res.numpy(), np.concatenate([x_np + y_np, x_np], axis=0))
+    vm.set_shape_func_memo(False)
+    res = vm.invoke("main", x_np, y_np)
+    tvm.testing.assert_allclose(res.numpy(), np.concatenate([x_np + y_np, x_np], axis=0))
+
+
+@tvm.testing.requires_cuda
+def test_vm_multi_stream():
+    x = relay.var("x", shape=(64, 64), dtype="float32")
+    branches = [relay.nn.relu(x * relay.const(float(i))) for i in range(4)]
+    y = relay.concatenate(branches, axis=0)
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    dev = tvm.cuda()
+    exe = relay.vm.compile(mod, target="cuda")
+    vm = runtime.vm.VirtualMachine(exe, dev)
+    vm.set_num_streams(4)
+    for _ in range(3):
+        x_np = np.random.uniform(-1, 1, size=(64, 64)).astype("float32")
+        res = vm.invoke("main", tvm.nd.array(x_np, dev))
+        ref = np.concatenate([np.maximum(x_np * i, 0) for i in range(4)], axis=0)
+        tvm.testing.assert_allclose(res.numpy(), ref, rtol=1e-5)
+
+
+def test_vm_dynamic_batcher():
+    import threading
+
+    x = relay.var("x", shape=(relay.Any(), 3), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], x * relay.const(2.0)))
+    exe = relay.vm.compile(mod, target="llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    batcher = runtime.vm.DynamicBatcher(
+        vm, tvm.cpu(), max_batch_size=4, timeout_us=10000000, buckets=[2, 4]
+    )
+    inputs = [np.random.rand(1, 3).astype("float32") for _ in range(4)]
+    results = [None] * len(inputs)
+
+    def run(i):
+        results[i] = batcher.submit(inputs[i])[0].numpy()
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(len(inputs))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    for x_np, res in zip(inputs, results):
+        tvm.testing.assert_allclose(res, x_np * 2.0)
+    assert batcher.num_batches == 1
+
+
+def test_vm_share_dynamic_storage():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    out = relay.split(relay.nn.relu(x), 2, axis=1)
+    mod = tvm.IRModule.from_expr(relay.Function([x], out.astuple()))
+    x_np = np.random.uniform(-1, 1, size=(5, 4)).astype("float32")
+    ref = np.split(np.maximum(x_np, 0), 2, axis=1)
+
+    num_alloc_storage = []
+    for share in [False, True]:
+        config = {"relay.ManifestAlloc.share_dynamic_storage": share}
+        with tvm.transform.PassContext(opt_level=3, config=config):
+            exe = relay.vm.compile(mod, target="llvm")
+        num_alloc_storage.append(exe.bytecode.count("alloc_storage"))
+        vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+        res = vm.invoke("main", x_np)
+        for r, r_np in zip(res, ref):
+            tvm.testing.assert_allclose(r.numpy(), r_np)
+    # The two outputs of split are placed in one storage
+    assert num_alloc_storage[1] == num_alloc_storage[0] - 1
+
+
+def test_vm_lazy_primitives():
+    x = relay.var("x", shape=(10,), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.nn.relu(x + x) * x))
+    exe = relay.vm.compile(mod, target="llvm")
+    x_np = np.random.uniform(-1, 1, size=(10,)).astype("float32")
+    ref = np.maximum(x_np + x_np, 0) * x_np
+    for prewarm in [False, True]:
+        vm = runtime.vm.VirtualMachine(exe, tvm.cpu(), lazy_primitives=True)
+        if prewarm:
+            vm.prewarm_primitives(num_threads=2)
+        tvm.testing.assert_allclose(vm.invoke("main", x_np).numpy(), ref)
+
+
+def test_vm_clone():
+    x = relay.var("x", shape=(10,), dtype="float32")
+    c = relay.const(np.arange(10).astype("float32"))
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.nn.relu(x + c)))
+    exe = relay.vm.compile(mod, target="llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    x_a = np.random.uniform(-1, 1, size=(10,)).astype("float32")
+    x_b = np.random.uniform(-1, 1, size=(10,)).astype("float32")
+    vm.invoke("main", x_a)
+    clone = vm.clone()
+    vm.set_input("main", x_a)
+    clone.set_input("main", x_b)
+    out_a = vm.invoke("main")
+    out_b = clone.invoke("main")
+    tvm.testing.assert_allclose(out_a.numpy(), np.maximum(x_a + np.arange(10), 0))
+    tvm.testing.assert_allclose(out_b.numpy(), np.maximum(x_b + np.arange(10), 0))
+
+
+def test_vm_stream():
+    x = relay.var("x", shape=(8,), dtype="float32")
+    s = relay.var("s", shape=(8,), dtype="float32")
+    out = relay.add(x, s)
+    mod = tvm.IRModule.from_expr(relay.Function([x, s], relay.Tuple([out, relay.tanh(out)])))
+    exe = relay.vm.compile(mod, target="llvm")
+    chunks = [np.random.uniform(-1, 1, size=(8,)).astype("float32") for _ in range(5)]
+    for reuse_outputs in [False, True]:
+        vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+        state = np.zeros((8,), "float32")
+        with vm.stream("main", [state], reuse_outputs=reuse_outputs) as stream:
+            for chunk in chunks:
+                ref = chunk + state
+                tvm.testing.assert_allclose(stream(chunk).numpy(), ref, rtol=1e-5)
+                state = np.tanh(ref)
+            final = stream.end()
+        tvm.testing.assert_allclose(final[0].numpy(), state, rtol=1e-5)
+
+
+def test_paged_kv_cache():
+    num_heads, head_dim, page_size = 2, 4, 4
+    cache = runtime.vm.PagedKVCache(2, num_heads, head_dim, page_size, 8, "float32", tvm.cpu())
+
+    def tokens(n):
+        return np.random.uniform(-1, 1, size=(n, num_heads, head_dim)).astype("float32")
+
+    def read(seq_id, layer, kv):
+        table, lengths = cache.block_table([seq_id])
+        pages = cache.pages.numpy()[layer, kv, table.numpy()[0]]
+        return pages.reshape(-1, num_heads, head_dim)[: lengths.numpy()[0]]
+
+    cache.add_sequence(0)
+    keys, values = tokens(6), tokens(6)
+    cache.reserve(0, 6)
+    for layer in range(2):
+        cache.append(0, layer, keys, values)
+    assert cache.length(0) == 6
+    assert cache.num_free_pages == 6
+
+    # The fork shares both pages, until the partially filled last page is written
+    cache.fork_sequence(0, 1)
+    assert cache.num_free_pages == 6
+    child_keys, child_values = tokens(3), tokens(3)
+    cache.reserve(1, 3)
+    for layer in range(2):
+        cache.append(1, layer, child_keys, child_values)
+    assert cache.num_free_pages == 4
+    tvm.testing.assert_allclose(read(0, 1, 0), keys)
+    tvm.testing.assert_allclose(read(1, 1, 0), np.concatenate([keys, child_keys]))
+    tvm.testing.assert_allclose(read(1, 0, 1), np.concatenate([values, child_values]))
+
+    cache.remove_sequence(0)
+    assert cache.num_free_pages == 5
+    tvm.testing.assert_allclose(read(1, 0, 0), np.concatenate([keys, child_keys]))
+    cache.remove_sequence(1)
+    assert cache.num_free_pages == 8
+
+
 def test_vm_optimize():
     mod, params = testing.synthetic.get_workload()
     comp = relay.vm.VMCompiler()
@@ -1483,6 +1655,31 @@ def test_vm_save_and_load_without_designating_late_bound_consts():
     tvm.testing.assert_allclose(expected, actual.numpy())
 
 
+def test_vm_save_and_load_mmap_file():
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    x = relay.var("x", shape=(1000, 1000))
+    const_data = np.random.rand(1000, 1000).astype("float32")
+    small_data = np.random.rand(3).astype("float32")
+    y = relay.op.add(x, relay.const(const_data, dtype="float32"))
+    func = relay.Function([x], relay.Tuple([y, relay.const(small_data, dtype="float32")]))
+    vm_exec = vm.compile(tvm.IRModule.from_expr(func), target=target)
+
+    temp = utils.tempdir()
+    path_exec = temp.relpath("exec.mmap")
+    vm_exec.save_to_mmap_file(path_exec)
+    _, lib = vm_exec.save()
+    exe = runtime.vm.Executable.load_exec_from_mmap_file(path_exec, lib)
+    del vm_exec
+
+    x_data = np.random.rand(1000, 1000).astype("float32")
+    loaded_vm = runtime.vm.VirtualMachine(exe, dev)
+    actual = loaded_vm.invoke("main", x_data)
+    tvm.testing.assert_allclose(x_data + const_data, actual[0].numpy())
+    tvm.testing.assert_allclose(small_data, actual[1].numpy())
+
+
 def test_load_and_save_constants_via_map():
     """Large constants can be serialized outside of executable"""
     target = tvm.target.Target("llvm")
@@ -0,0 +1,133 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test code for fused_attention operator"""
+import numpy as np
+import tvm
+import tvm.testing
+import tvm.topi.testing
+from tvm import te, topi
+from tvm.runtime.vm import PagedKVCache
+
+_fused_attention_implement = {
+    "generic": (topi.nn.fused_attention, topi.generic.schedule_fused_attention),
+    "cpu": (topi.x86.fused_attention, topi.x86.schedule_fused_attention),
+    "gpu": (topi.cuda.fused_attention, topi.cuda.schedule_fused_attention),
+}
+
+_paged_attention_schedule = {
+    "generic": topi.generic.schedule_paged_attention,
+    "gpu": topi.cuda.schedule_paged_attention,
+}
+
+
+
+def get_shape(tensor):
+    return [int(dim) for dim in tensor.shape]
+
+
+batch, seq_q, seq_kv, head_dim, value_dim = tvm.testing.parameters(
+    (1, 1, 128, 64, 64),
+    (4, 32, 96, 32, 48),
+)
+
+
+def test_fused_attention(target, dev, batch, seq_q, seq_kv, head_dim, value_dim):
+    dtype = "float32"
+    scale = 1.0 / np.sqrt(head_dim)
+    query = te.placeholder((batch, seq_q, head_dim), name="query", dtype=dtype)
+    key = te.placeholder((batch, seq_kv, head_dim), name="key", dtype=dtype)
+    value = te.placeholder((batch, seq_kv, value_dim), name="value", dtype=dtype)
+
+    q_np = np.random.uniform(-1, 1, size=get_shape(query)).astype(dtype)
+    k_np = np.random.uniform(-1, 1, size=get_shape(key)).astype(dtype)
+    v_np = np.random.uniform(-1, 1, size=get_shape(value)).astype(dtype)
+    out_np = tvm.topi.testing.attention_python(q_np, k_np, v_np, scale)
+
+    with tvm.target.Target(target):
+        fcompute, fschedule = tvm.topi.testing.dispatch(target, _fused_attention_implement)
+        out = fcompute(query, key, value, scale)
+        s = fschedule([out])
+
+    f = tvm.build(s, [query, key, value, out], target, name="fused_attention")
+    out_nd = tvm.nd.array(np.zeros(out_np.shape, dtype=dtype), dev)
+    f(tvm.nd.array(q_np, dev), tvm.nd.array(k_np, dev), tvm.nd.array(v_np, dev), out_nd)
+    tvm.testing.assert_allclose(out_nd.numpy(), out_np, rtol=1e-5, atol=1e-5)
+
+
+def test_fused_attention_large_scores():
+    # The online softmax rescales the partial sums, so that large scores do not overflow
+    query = te.placeholder((1, 4, 8), name="query")
+    key = te.placeholder((1, 16, 8), name="key")
+    value = te.placeholder((1, 16, 8), name="value")
+    out = topi.nn.fused_attention(query, key, value, 100.0)
+    s = te.create_schedule(out.op)
+    f = tvm.build(s, [query, key, value, out], "llvm")
+
+    q_np = np.random.uniform(-1, 1, size=(1, 4, 8)).astype("float32")
+    k_np = np.random.uniform(-1, 1, size=(1, 16, 8)).astype("float32")
+    v_np = np.random.uniform(-1, 1, size=(1, 16, 8)).astype("float32")
+    out_np = tvm.topi.testing.attention_python(q_np, k_np, v_np, 100.0)
+    out_nd = tvm.nd.empty((1, 4, 8))
+    f(tvm.nd.array(q_np), tvm.nd.array(k_np), tvm.nd.array(v_np), out_nd)
+    assert np.isfinite(out_nd.numpy()).all()
+    tvm.testing.assert_allclose(out_nd.numpy(), out_np, rtol=1e-4, atol=1e-5)
+
+
+def test_paged_attention(target, dev):
+    num_layers, num_heads, head_dim, page_size = 2, 4, 32, 16
+    lengths = [1, 37, 16]
+    dtype = "float32"
+    scale = 1.0 / np.sqrt(head_dim)
+    cache = PagedKVCache(num_layers, num_heads, head_dim, page_size, 16, dtype, dev)
+    keys, values = [], []
+    for seq_id, length in enumerate(lengths):
+        cache.add_sequence(seq_id)
+        cache.reserve(seq_id, length)
+        for layer in range(num_layers):
+            k = np.random.uniform(-1, 1, size=(length, num_heads, head_dim)).astype(dtype)
+            v = np.random.uniform(-1, 1, size=(length, num_heads, head_dim)).astype(dtype)
+            cache.append(seq_id, layer, k, v)
+            if layer == 1:
+                keys.append(k)
+                values.append(v)
+    block_table_nd, seq_lens_nd = cache.block_table(list(range(len(lengths))))
+
+    batch = len(lengths)
+    query = te.placeholder((batch, num_heads, head_dim), name="query", dtype=dtype)
+    pages = te.placeholder(get_shape(cache.pages), name="pages", dtype=dtype)
+    block_table = te.placeholder(block_table_nd.shape, name="block_table", dtype="int32")
+    seq_lens = te.placeholder((batch,), name="seq_lens", dtype="int32")
+    with tvm.target.Target(target):
+        out = topi.nn.paged_attention(query, pages, block_table, seq_lens, 1, scale)
+        fschedule = tvm.topi.testing.dispatch(target, _paged_attention_schedule)
+        s = fschedule([out])
+    f = tvm.build(s, [query, pages, block_table, seq_lens, out], target, name="paged_attention")
+
+    q_np = np.random.uniform(-1, 1, size=(batch, num_heads, head_dim)).astype(dtype)
+    out_nd = tvm.nd.empty((batch, num_heads, head_dim), dtype, dev)
+    f(tvm.nd.array(q_np, dev), cache.pages, block_table_nd, seq_lens_nd, out_nd)
+
+    for b in range(batch):
+        for h in range(num_heads):
+            out_np = tvm.topi.testing.attention_python(
+                q_np[b : b + 1, h : h + 1], keys[b][None, :, h], values[b][None, :, h], scale
+            )
+            tvm.testing.assert_allclose(out_nd.numpy()[b, h], out_np[0, 0], rtol=1e-5, atol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -183,5 +183,40 @@ def test_dense_cuda_int8(
         )
 
 
+@pytest.mark.parametrize("bits,group_size", [(8, None), (8, 16), (4, None), (4, 16)])
+def test_dense_weight_quantized(bits, group_size):
+    batch, in_dim, out_dim = 2, 64, 8
+    num_groups = 1 if group_size is None else in_dim // group_size
+    a_np = np.random.uniform(-1, 1, size=(batch, in_dim)).astype("float32")
+    if bits == 8:
+        w_np = np.random.randint(-128, 128, size=(out_dim, in_dim)).astype("int8")
+        zp_np = np.random.randint(-4, 4, size=(out_dim, num_groups)).astype("int8")
+        packed_np = w_np
+    else:
+        w_np = np.random.randint(0, 16, size=(out_dim, in_dim)).astype("uint8")
+        zp_np = np.random.randint(6, 10, size=(out_dim, num_groups)).astype("uint8")
+        packed_np = (w_np[:, 0::2] | (w_np[:, 1::2] << 4)).astype("uint8")
+    scale_np = np.random.uniform(0.01, 0.1, size=(out_dim, num_groups)).astype("float32")
+    group = in_dim // num_groups
+    w_float = (w_np.astype("float32") - np.repeat(zp_np, group, axis=1)) * np.repeat(
+        scale_np, group, axis=1
+    )
+    ref = np.dot(a_np, w_float.T)
+    if group_size is None:
+        scale_np, zp_np = scale_np[:, 0], zp_np[:, 0]
+
+    A = te.placeholder(a_np.shape, name="A", dtype="float32")
+    W = te.placeholder(packed_np.shape, name="W", dtype=str(packed_np.dtype))
+    S = te.placeholder(scale_np.shape, name="S", dtype="float32")
+    Z = te.placeholder(zp_np.shape, name="Z", dtype=str(zp_np.dtype))
+    D = topi.nn.dense_weight_quantized(A, W, S, Z, bits=bits, group_size=group_size)
+    s = te.create_schedule(D.op)
+    f = tvm.build(s, [A, W, S, Z, D], "llvm")
+    dev = tvm.cpu()
+    d = tvm.nd.array(np.zeros((batch, out_dim), dtype="float32"), dev)
+    f(*[tvm.nd.array(x, dev) for x in [a_np, packed_np, scale_np, zp_np]], d)
+    tvm.testing.assert_allclose(d.numpy(), ref, rtol=1e-4, atol=1e-4)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
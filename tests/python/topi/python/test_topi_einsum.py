@@ -68,14 +68,7 @@ def verify_einsum(subscripts, shapes, shape_dict={}):
     c1 = np.einsum(subscripts, *ops)
     out_shape = c1.shape
 
-    if len(ops) == 1:
-        c2 = with_tvm(lambda A: topi.einsum(subscripts, A), symbolic_shapes, ops, out_shape)
-    elif len(ops) == 2:
-        c2 = with_tvm(lambda A, B: topi.einsum(subscripts, A, B), symbolic_shapes, ops, out_shape)
-    elif len(ops) == 3:
-        c2 = with_tvm(
-            lambda A, B, C: topi.einsum(subscripts, A, B, C), symbolic_shapes, ops, out_shape
-        )
+    c2 = with_tvm(lambda *args: topi.einsum(subscripts, *args), symbolic_shapes, ops, out_shape)
 
     tvm.testing.assert_allclose(c1, c2, rtol=1e-5, atol=1e-5)
 
@@ -96,12 +89,33 @@ def verify_einsum(subscripts, shapes, shape_dict={}):
         ("...ik, ...jk, ...hk -> i...jh", [(3, 4, 4), (1, 5, 3, 8, 4), (2, 5, 3, 6, 4)]),
         ("ij,jk->ik", [(2, 3), (3, 4)]),
         ("ij,jk,km->im", [(2, 3), (3, 4), (4, 5)]),
+        ("ij,jk,kl,lm->im", [(2, 30), (30, 40), (40, 3), (3, 5)]),
+        ("abc,bd,ce,de->a", [(4, 5, 6), (5, 7), (6, 8), (7, 8)]),
+        ("ii,ij,jk,k->", [(3, 3), (3, 4), (4, 5), (5,)]),
+        ("ij,ij,kj,k->ik", [(1, 4), (2, 4), (3, 4), (1,)]),
     ],
 )
 def test_einsum(equation, inputs):
     verify_einsum(equation, inputs)
 
 
+def test_einsum_pairwise_contraction():
+    A = te.placeholder((2, 30), name="A")
+    B = te.placeholder((30, 40), name="B")
+    C = te.placeholder((40, 3), name="C")
+    D = te.placeholder((3, 5), name="D")
+    out = topi.einsum("ij,jk,kl,lm->im", A, B, C, D)
+    s = te.create_schedule([out.op])
+    computes = [stage.op for stage in s.stages if isinstance(stage.op, te.ComputeOp)]
+    # Three pairwise contractions instead of a single compute over all the labels
+    assert len(computes) == 3
+    for op in computes:
+        assert len(op.input_tensors) == 2
+        assert len(op.reduce_axis) == 1
+    # The cheapest order is ((A B) C) D, which only has the small (2, 40) and (2, 3) intermediates
+    assert [get_const_tuple(op.output(0).shape) for op in computes] == [(2, 40), (2, 3), (2, 5)]
+
+
 @pytest.mark.parametrize(
     "equation,inputs,shape_dict",
     [
@@ -222,6 +222,30 @@ def test_complex_reduce(target, dev):
     tvm.testing.assert_allclose(out_tvm.numpy(), out_npy, 1e-3, 1e-3)
 
 
+@pytest.mark.parametrize("reduce_type", ["sum", "max"])
+def test_two_stage_reduce_x86(reduce_type):
+    in_shape = (4, 1 << 16)
+    dtype = "float32"
+    A = te.placeholder(shape=in_shape, name="A", dtype=dtype)
+    B = getattr(topi, reduce_type)(A, axis=1)
+
+    target = tvm.target.Target("llvm -num-cores=8")
+    with target:
+        s = topi.x86.schedule_reduce(B)
+    # The output has fewer elements than cores, so that the reduction is split into per-core
+    # partial reductions and a final combine
+    assert len(s.stages) == 3
+    foo = tvm.build(s, [A, B], target)
+
+    dev = tvm.cpu(0)
+    in_npy = np.random.uniform(-1, 1, size=in_shape).astype(dtype)
+    out_npy = getattr(np, reduce_type)(in_npy, axis=1)
+    data_tvm = tvm.nd.array(in_npy, device=dev)
+    out_tvm = tvm.nd.empty(shape=out_npy.shape, device=dev, dtype=dtype)
+    foo(data_tvm, out_tvm)
+    tvm.testing.assert_allclose(out_tvm.numpy(), out_npy, 1e-3, 1e-3)
+
+
 n = tir.Var("n", "int32")
 m = tir.Var("m", "int32")
 true_value_map = {n: 3, m: 5}
@@ -65,5 +65,26 @@ def test_regression_simplify_inf_recursion():
     ana.rewrite_simplify(res)
 
 
+def test_simplify_memoization():
+    ana = tvm.arith.Analyzer()
+    ana.set_memoization_enabled(True)
+
+    i = tir.Var("i", "int32")
+    ana.bind(i, tvm.ir.Range(0, 8))
+    expr = (i * 4 + 3) // 4
+    assert tvm.ir.structural_equal(ana.simplify(expr), i)
+    hits = ana.rewrite_simplify_stats.cache_hits
+    assert tvm.ir.structural_equal(ana.simplify(expr), i)
+    assert ana.rewrite_simplify_stats.cache_hits == hits + 1
+
+    # The constraints in scope are part of the key.
+    cond = i < 4
+    with ana.constraint_scope(i == 0):
+        assert ana.simplify(cond).value == 1
+    assert not isinstance(ana.simplify(cond), tir.IntImm)
+    with ana.constraint_scope(i == 7):
+        assert ana.simplify(cond).value == 0
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -79,6 +79,24 @@ def test_xgb_model():
     model.load(tmpfile)
 
 
+def test_tree_ensemble_model():
+    task, inputs, results = get_sample_records(50)
+    states = [x.state for x in inputs]
+
+    model = auto_scheduler.XGBModel(num_warmup_sample=-1)
+    model.update(inputs, results)
+    preds = model.predict(task, states)
+
+    tmpdir = tvm.contrib.utils.tempdir()
+    tmpfile = tmpdir.relpath("model.json")
+    model.save(tmpfile)
+    native_model = auto_scheduler.TreeEnsembleModel(tmpfile)
+    native_model.update(inputs, results)
+    native_preds = native_model.predict(task, states)
+    assert np.allclose(native_preds, preds, rtol=1e-4, atol=1e-4)
+
+
 if __name__ == "__main__":
     test_random_model()
     test_xgb_model()
+    test_tree_ensemble_model()
@@ -23,6 +23,7 @@ from contextlib import redirect_stderr
 from io import StringIO
 
 import numpy as np
+import pytest
 import tvm
 import tvm.relay
 import tvm.testing
@@ -382,6 +383,31 @@ def test_crt_link_params(linkable_dtype):
         np.testing.assert_allclose(unlinked_output, linked_output)
 
 
+@pytest.mark.parametrize("target", ["c", pytest.param("llvm", marks=tvm.testing.requires_llvm)])
+def test_large_link_params(target):
+    """Large constants are embedded as raw bytes, a string literal in C"""
+    data = relay.var("data", shape=(256, 256), dtype="float32")
+    weight = relay.var("weight", shape=(256, 256), dtype="float32")
+    relay_mod = tvm.IRModule.from_expr(relay.Function([data, weight], relay.add(data, weight)))
+    data_np = np.random.randn(256, 256).astype("float32")
+    weight_np = np.random.randn(256, 256).astype("float32")
+
+    executor = Executor("graph", {"link-params": True})
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        lib = relay.build(relay_mod, target, executor=executor, params={"weight": weight_np})
+    if target == "c":
+        assert "_storage = {" in lib.lib.get_source()
+
+    temp_dir = utils.tempdir()
+    lib_path = temp_dir.relpath(f"test-large-{target}.so")
+    lib.export_library(lib_path)
+    lib_mod = tvm.runtime.load_module(lib_path)
+    graph_rt = tvm.contrib.graph_executor.GraphModule(lib_mod["default"](tvm.cpu(0)))
+    graph_rt.set_input("data", data_np)
+    graph_rt.run()
+    np.testing.assert_allclose(graph_rt.get_output(0).numpy(), data_np + weight_np)
+
+
 def test_tir_link_params():
     def get_dense(data_shape, weight_shape):
         data = relay.var("data", shape=data_shape, dtype="float32")
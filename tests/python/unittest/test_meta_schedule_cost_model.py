@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 # pylint: disable=missing-docstring
+import json
 import os
 import re
 import shutil
@@ -26,7 +27,7 @@ from typing import List
 import numpy as np
 import tvm
 import tvm.testing
-from tvm.meta_schedule.cost_model import PyCostModel, RandomModel, XGBModel
+from tvm.meta_schedule.cost_model import PyCostModel, RandomModel, TreeEnsembleModel, XGBModel
 from tvm.meta_schedule.cost_model.xgb_model import PackSum, _get_custom_call_back
 from tvm.meta_schedule.feature_extractor import RandomFeatureExtractor
 from tvm.meta_schedule.runner import RunnerResult
@@ -191,6 +192,55 @@ def test_meta_schedule_xgb_model_no_feature():
     model.predict(tune_ctx, [candidate])
 
 
+def test_meta_schedule_tree_ensemble_model():
+    def _tree(left, right, split_indices, split_conditions):
+        return {
+            "left_children": left,
+            "right_children": right,
+            "split_indices": split_indices,
+            "split_conditions": split_conditions,
+            "default_left": [0] * len(left),
+        }
+
+    trees = [
+        # feature[3] < 0.5 ? 1.0 : 2.0
+        _tree([1, -1, -1], [2, -1, -1], [3, 0, 0], [0.5, 1.0, 2.0]),
+        # 0.25
+        _tree([-1], [-1], [0], [0.25]),
+    ]
+    model_json = {
+        "learner": {
+            "learner_model_param": {"base_score": "5E-1"},
+            "gradient_booster": {"name": "gbtree", "model": {"trees": trees}},
+        }
+    }
+    predict_sample_count = 20
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "model.json")
+        with open(path, "w") as file:
+            json.dump(model_json, file)
+        model = TreeEnsembleModel(path, extractor=RandomFeatureExtractor(seed=1))
+        model.update(TuneContext(), [], [])
+        res = model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+        model.save(os.path.join(tmpdir, "saved.json"))
+        reloaded = TreeEnsembleModel(extractor=RandomFeatureExtractor(seed=1))
+        reloaded.load(os.path.join(tmpdir, "saved.json"))
+        res_reloaded = reloaded.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+    features = RandomFeatureExtractor(seed=1).extract_from(
+        TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+    )
+    expected = [
+        sum(0.5 + (1.0 if x[3] < 0.5 else 2.0) + 0.25 for x in f.numpy().astype("float32"))
+        for f in features
+    ]
+    assert np.allclose(res, expected)
+    assert np.allclose(res_reloaded, expected)
+
+
 def test_meta_schedule_xgb_model_reload():
     extractor = RandomFeatureExtractor()
     model = XGBModel(extractor=extractor, num_warmup_samples=10)
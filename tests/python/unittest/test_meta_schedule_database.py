@@ -584,6 +584,56 @@ def test_json_database_get_top_k(k, expected):
     assert result == expected
 
 
+@pytest.mark.parametrize(
+    "k,expected",
+    [
+        (0, []),
+        (4, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+        (5, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+    ],
+)
+def test_binary_database_get_top_k(k, expected):
+    run_secs_list = [[1.5, 4.5], [], [0.0, 2.0], None, [2.0], [3.0, 1e10], [1e10]]
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = osp.join(tmpdir, "database.bin")
+        database = ms.database.BinaryDatabase(path)
+        result = call_get_top_k(run_secs_list, database, k)
+        assert result == expected
+        # The records are indexed again, and deserialized lazily, after reloading
+        reloaded = ms.database.BinaryDatabase(path)
+        assert len(reloaded) == len(run_secs_list)
+        workload = reloaded.commit_workload(Matmul)
+        assert [[v.value for v in r.run_secs] for r in reloaded.get_top_k(workload, k)] == expected
+        assert len(reloaded.get_all_tuning_records()) == len(run_secs_list)
+
+
+@tvm.testing.requires_rpc
+def test_rpc_database_shared_by_clients():
+    run_secs_list = [[1.5, 4.5], [], [0.0, 2.0], None, [2.0], [3.0, 1e10], [1e10]]
+    server = ms.database.RPCDatabaseServer(ms.database.MemoryDatabase(), host="127.0.0.1")
+    try:
+        client_0 = ms.database.RPCDatabase("127.0.0.1", server.port, cache_seconds=0)
+        client_1 = ms.database.RPCDatabase("127.0.0.1", server.port, cache_seconds=0)
+        assert call_get_top_k(run_secs_list, client_0, 4) == [
+            [0.0, 2.0],
+            [2.0],
+            [1.5, 4.5],
+            [3.0, 1e10],
+        ]
+        # The records committed by a client are visible to the others
+        assert client_1.has_workload(Matmul)
+        assert len(client_1) == len(run_secs_list)
+        workload = client_1.commit_workload(Matmul)
+        assert [[v.value for v in r.run_secs] for r in client_1.get_top_k(workload, 2)] == [
+            [0.0, 2.0],
+            [2.0],
+        ]
+        assert len(client_1.get_all_tuning_records()) == len(run_secs_list)
+        assert len(server.database) == len(run_secs_list)
+    finally:
+        server.terminate()
+
+
 def MatmulFunc() -> IRModule:
     a = relay.var("a", relay.TensorType((1024, 1024), "float32"))
     b = relay.var("b", relay.TensorType((1024, 1024), "float32"))
@@ -1632,5 +1632,29 @@ def test_negative_extent():
     assert named_features["B0.unique_bytes"] == 0
 
 
+def test_cached_feature():
+    def _create_schedule(factor):
+        sch = tir.Schedule(matmul)
+        i, _, _ = sch.get_loops(sch.get_block("C"))
+        sch.split(i, factors=[None, factor])
+        return sch
+
+    context = _make_context(tvm.target.Target("llvm"))
+    candidates = [
+        _make_candidate(lambda: _create_schedule(16)),
+        _make_candidate(lambda: _create_schedule(8)),
+        _make_candidate(lambda: _create_schedule(16)),
+    ]
+    uncached = ms.feature_extractor.PerStoreFeature(max_cache_size=0).extract_from(
+        context, candidates
+    )
+    extractor = ms.feature_extractor.PerStoreFeature(max_cache_size=2)
+    for _ in range(2):
+        features = extractor.extract_from(context, candidates)
+        for feature, expected in zip(features, uncached):
+            assert_allclose(actual=feature.numpy(), desired=expected.numpy())
+    assert (features[0].numpy() != features[1].numpy()).any()
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import numpy as np
+
 import tvm
 import tvm.testing
 from tvm.meta_schedule.postproc import RewriteParallelVectorizeUnroll
@@ -269,5 +271,64 @@ def test_no_unroll_for_spatial_block():
     tvm.ir.assert_structural_equal(mod["main"], expected)
 
 
+def test_prefetch_gather():
+    # fmt: off
+    @T.prim_func
+    def embedding(table: T.Buffer((1024, 64), "float32"), idx: T.Buffer((256,), "int32"), out: T.Buffer((256, 64), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i, j in T.grid(256, 64):
+            with T.block("take"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                out[vi, vj] = table[idx[vi], vj]
+    # fmt: on
+
+    sch = Schedule(embedding)
+    root = sch.get_block("root")
+    sch.annotate(root, "meta_schedule.vectorize", 64)
+    sch.annotate(root, "meta_schedule.prefetch_distance", 8)
+    assert RewriteParallelVectorizeUnroll().apply(sch)
+    # The rows are vectorized, so the gathers are prefetched over the serial loop of the indices
+    i, j = sch.get_loops(sch.get_block("take"))
+    assert sch.get(j).kind == tvm.tir.ForKind.VECTORIZED
+    assert sch.get(i).annotations["llvm_loop_prefetch_distance"] == 8
+    assert "meta_schedule.prefetch_distance" not in sch.get(root).annotations
+
+    f = tvm.build(sch.mod, target="llvm")
+    assert "llvm.prefetch" in f.get_source("ll")
+    table = np.random.uniform(size=(1024, 64)).astype("float32")
+    idx = np.random.randint(0, 1024, size=(256,)).astype("int32")
+    out = tvm.nd.empty((256, 64), "float32")
+    f(tvm.nd.array(table), tvm.nd.array(idx), out)
+    tvm.testing.assert_allclose(out.numpy(), table[idx])
+
+
+def test_unroll_register_limit():
+    # fmt: off
+    @T.prim_func
+    def matmul(a: T.Buffer((64, 64), "float32"), b: T.Buffer((64, 64), "float32"), c: T.Buffer((64, 64), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i, j, k in T.grid(64, 64, 64):
+            with T.block("matmul"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                with T.init():
+                    c[vi, vj] = T.float32(0)
+                c[vi, vj] = c[vi, vj] + a[vi, vk] * b[vk, vj]
+    # fmt: on
+
+    sch = Schedule(matmul)
+    root = sch.get_block("root")
+    sch.annotate(root, "meta_schedule.unroll_explicit", 64)
+    sch.annotate(root, "meta_schedule.unroll_max_registers", 32)
+    sch.annotate(root, "meta_schedule.unroll_max_code_size", 512)
+    assert RewriteParallelVectorizeUnroll().apply(sch)
+    i, _, _ = sch.get_loops(sch.get_block("matmul"))
+    annotations = sch.get(i).annotations
+    assert annotations["pragma_auto_unroll_max_step"] == 64
+    assert annotations["pragma_auto_unroll_max_registers"] == 32
+    assert annotations["pragma_auto_unroll_max_code_size"] == 512
+    assert "meta_schedule.unroll_max_registers" not in sch.get(root).annotations
+    assert "meta_schedule.unroll_max_code_size" not in sch.get(root).annotations
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 """ Test Meta Schedule Profiler """
+import json
+import threading
 import time
 
 from tvm import meta_schedule as ms
@@ -36,6 +38,36 @@ def test_meta_schedule_profiler_context_manager():
     assert 1.9 <= result["Level1"] <= 2.1
 
 
+def test_meta_schedule_profiler_timeline():
+    def _worker():
+        with ms.Profiler.timeit("Worker"):
+            time.sleep(0.2)
+
+    with ms.Profiler() as profiler:
+        with ms.Profiler.timeit("Level0"):
+            thread = threading.Thread(target=_worker)
+            thread.start()
+            with ms.Profiler.timeit("Level1"):
+                time.sleep(0.4)
+            thread.join()
+    # The scopes of other threads are on the timeline, but not in the totals
+    assert "Worker" not in profiler.get()
+
+    trace = json.loads(profiler.chrome_trace())
+    events = {event["name"]: event for event in trace["traceEvents"] if event["ph"] == "X"}
+    assert set(events) == {"Total", "Level0", "Level1", "Worker"}
+    assert events["Worker"]["tid"] != events["Level0"]["tid"]
+    assert events["Level1"]["tid"] == events["Level0"]["tid"]
+    assert events["Level0"]["ts"] <= events["Level1"]["ts"]
+    assert events["Level1"]["ts"] + events["Level1"]["dur"] <= (
+        events["Level0"]["ts"] + events["Level0"]["dur"]
+    )
+
+    stacks = dict(line.rsplit(" ", 1) for line in profiler.flame_graph().splitlines())
+    assert 0.35e6 <= int(stacks["Total;Level0;Level1"]) <= 0.45e6
+    assert 0.15e6 <= int(stacks["Worker"]) <= 0.25e6
+
+
 def test_meta_schedule_no_context():
     with ms.Profiler.timeit("Level0"):
         assert ms.Profiler.current() is None
@@ -43,4 +75,5 @@ def test_meta_schedule_no_context():
 
 if __name__ == "__main__":
     test_meta_schedule_profiler_context_manager()
+    test_meta_schedule_profiler_timeline()
     test_meta_schedule_no_context()
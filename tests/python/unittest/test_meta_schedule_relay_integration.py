@@ -64,6 +64,26 @@ def test_meta_schedule_dynamic_loop_extent():
     assert not extracted_tasks
 
 
+def test_meta_schedule_extract_from_shape_histogram():
+    data = relay.var("data", shape=(relay.Any(), 64), dtype="float32")
+    weight = relay.var("weight", shape=(32, 64), dtype="float32")
+    mod = IRModule.from_expr(relay.nn.relu(relay.nn.dense(data, weight)))
+    params = {"weight": np.random.randn(32, 64).astype("float32")}
+    extracted_tasks = ms.relay_integration.extract_tasks_from_shape_histogram(
+        mod,
+        target="llvm",
+        params=params,
+        shape_histogram=[
+            ({"data": (1, 64)}, 90),
+            ({"data": (16, 64)}, 10),
+            ({"data": (1, 64)}, 5),
+        ],
+    )
+    # The two entries of batch 1 merge into one task, weighted by their total traffic
+    assert sorted(task.weight for task in extracted_tasks) == [10, 95]
+    assert len({task.task_name for task in extracted_tasks}) == 2
+
+
 @pytest.mark.skipif(
     platform.machine() == "aarch64",
     reason="Currently torch.jit.trace fails on AArch64",
@@ -685,6 +705,42 @@ def test_rewrite_layout_link_params():
         np.testing.assert_allclose(ref, out, rtol=1e-4, atol=1e-4)
 
 
+def test_rewrite_layout_vm():
+    target = "llvm --num-cores=4"
+    data_shape = (128, 128)
+    weight_shape = (128, 128)
+
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight = relay.var("weight", shape=weight_shape, dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.nn.dense(data, weight))
+
+    weight_np = np.random.randn(*weight_shape).astype("float32")
+    params = {"weight": weight_np}
+    data_np = np.random.randn(*data_shape).astype("float32")
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        database = ms.relay_integration.tune_relay(
+            mod=mod,
+            target=target,
+            params=params,
+            work_dir=work_dir,
+            max_trials_global=4,
+            strategy="replay-trace",
+        )
+        exe = ms.relay_integration.compile_relay(
+            database=database,
+            mod=mod,
+            target=target,
+            params=params,
+            backend="vm",
+        )
+
+    # The weight is pre-packed at build time, leaving only the data as an input
+    vm = tvm.runtime.vm.VirtualMachine(exe, tvm.cpu())
+    out = vm.invoke("main", data_np).numpy()
+    np.testing.assert_allclose(np.dot(data_np, weight_np.transpose()), out, rtol=1e-4, atol=1e-4)
+
+
 def test_module_equality_ignore_ndarray():
     target = "llvm --num-cores=4"
 
@@ -27,10 +27,12 @@ import tvm
 import tvm.testing
 from tvm._ffi import register_func
 from tvm.meta_schedule.arg_info import TensorInfo
-from tvm.meta_schedule.builder import BuilderInput, LocalBuilder
+from tvm.meta_schedule.builder import BuilderInput, InMemoryBuilder, LocalBuilder
 from tvm.meta_schedule.runner import (
     EvaluatorConfig,
+    InMemoryRunner,
     LocalRunner,
+    MultiDeviceRunner,
     PyRunner,
     RPCConfig,
     RPCRunner,
@@ -375,6 +377,93 @@ def test_meta_schedule_local_multiple_runs():
         _clean_build(builder_result.artifact_path)
 
 
+def test_meta_schedule_multi_device_runner():
+    """Test meta schedule multi-device runner preserves the order of the inputs"""
+    builder = LocalBuilder()
+    (builder_result,) = builder.build([BuilderInput(MatmulModule, Target("llvm"))])
+    assert builder_result.artifact_path is not None
+    assert builder_result.error_msg is None
+
+    args_info = [
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+    ]
+    # The second input misses an argument, so that only its run fails
+    runner_inputs = [
+        RunnerInput(builder_result.artifact_path, "llvm", args_info),
+        RunnerInput(builder_result.artifact_path, "llvm", args_info[:2]),
+        RunnerInput(builder_result.artifact_path, "llvm", args_info),
+    ]
+
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=1,
+        min_repeat_ms=0,
+        enable_cpu_cache_flush=False,
+    )
+
+    runner = MultiDeviceRunner(timeout_sec=100, evaluator_config=evaluator_config)
+
+    # Run the module
+    runner_futures = runner.run(runner_inputs)
+    runner_results = [runner_future.result() for runner_future in runner_futures]
+
+    assert runner_results[1].error_msg is not None
+    for runner_result in [runner_results[0], runner_results[2]]:
+        assert runner_result.error_msg is None
+        for result in runner_result.run_secs:
+            if isinstance(result, FloatImm):
+                result = result.value
+            assert isinstance(result, float)
+            assert result >= 0.0
+
+    _clean_build(builder_result.artifact_path)
+
+
+def test_meta_schedule_in_memory_runner():
+    """Test meta schedule in-memory runner with the modules kept in memory by the builder"""
+    builder = InMemoryBuilder(max_workers=2)
+    builder_results = builder.build(
+        [BuilderInput(MatmulModule, Target("llvm")), BuilderInput(AddModule, Target("llvm"))]
+    )
+    for builder_result in builder_results:
+        assert builder_result.artifact_path is not None
+        assert builder_result.artifact_path.startswith("memory:")
+        assert builder_result.error_msg is None
+    matmul_path, add_path = [builder_result.artifact_path for builder_result in builder_results]
+
+    runner_inputs = [
+        RunnerInput(matmul_path, "llvm", [TensorInfo("float32", (MATMUL_N, MATMUL_N))] * 3),
+        RunnerInput(add_path, "llvm", [TensorInfo("float32", [MATMUL_M])] * 3),
+        # Misses an argument, so that only its run fails
+        RunnerInput(add_path, "llvm", [TensorInfo("float32", [MATMUL_M])] * 2),
+    ]
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=1,
+        min_repeat_ms=0,
+        enable_cpu_cache_flush=False,
+    )
+    runner = InMemoryRunner(evaluator_config=evaluator_config)
+    runner_results = [runner_future.result() for runner_future in runner.run(runner_inputs)]
+
+    assert runner_results[2].error_msg is not None
+    for runner_result in runner_results[:2]:
+        assert runner_result.error_msg is None
+        for result in runner_result.run_secs:
+            if isinstance(result, FloatImm):
+                result = result.value
+            assert isinstance(result, float)
+            assert result >= 0.0
+
+    _clean_build(matmul_path)
+    _clean_build(add_path)
+    # The released modules can no longer be run
+    (runner_future,) = runner.run(runner_inputs[:1])
+    assert runner_future.result().error_msg is not None
+
+
 def test_meta_schedule_py_runner():
     """Test meta schedule PyRunner"""
 
@@ -39,6 +39,7 @@ def multi_level_tiling_tensor_core(
     out_dtype="float32",
     trans_b=False,
     use_software_pipeline=False,
+    split_k_factors=None,
 ) -> ms.schedule_rule.ScheduleRule:
     assert read_reuse_scope in ["shared", "shared.dyn"]
     assert write_reuse_scope in ["shared", "shared.dyn", "global"]
@@ -72,6 +73,7 @@ def multi_level_tiling_tensor_core(
             scope=write_reuse_scope,
         ),
         use_software_pipeline=use_software_pipeline,
+        split_k_factors=split_k_factors,
     )
 
 
@@ -887,14 +889,57 @@ def test_padded_matmul_relu():
         sch_rules=[multi_level_tiling_tensor_core(write_reuse_scope="shared")]
         + get_rules("cuda", ms.schedule_rule.AutoInline),
     )
+    # The padding of the inputs is either inlined into the shared memory fetch, or decomposed into
+    # a stage filling the pad values and a stage copying the in-bound values
+    assert len(actual) == 2
+    decomposed = [
+        sch
+        for sch in actual
+        if any(inst.kind.name == "DecomposePadding" for inst in sch.trace.insts)
+    ]
+    assert len(decomposed) == 1
+    assert "if_then_else" not in decomposed[0].mod.script()
     check_sketches(
         mod,
-        sketches=actual,
+        sketches=[sch for sch in actual if sch not in decomposed],
         expected_mods=[padded_matmul_relu_0],
         expected_decisions=[decision_0],
     )
 
 
+def test_matmul_split_k():
+    mod = te.create_prim_func(
+        te_workload.matmul(
+            n=16,
+            m=128,
+            k=4096,
+            in_dtype="float16",
+            out_dtype="float32",
+        )
+    )
+    actual = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=tvm.target.Target("cuda"),
+        types=None,
+        sch_rules=[multi_level_tiling_tensor_core(split_k_factors=[4])]
+        + get_rules("cuda", ms.schedule_rule.AutoInline),
+    )
+    assert len(actual) == 2
+    split_k = [
+        sch for sch in actual if any(inst.kind.name == "RFactor" for inst in sch.trace.insts)
+    ]
+    assert len(split_k) == 1
+    # The partial sums of the 4 parts are tensorized, and added up by a separate reduction
+    rf_buffers = [
+        buf
+        for buf in split_k[0].mod["main"].body.block.alloc_buffers
+        if buf.scope() == "global" and list(buf.shape) == [4, 16, 128]
+    ]
+    assert len(rf_buffers) == 1
+    assert "wmma_sync_16x16x16_f16f16f32" in split_k[0].mod.script()
+
+
 def test_conv_1x1():
     # fmt: off
     @T.prim_func
@@ -1052,5 +1097,23 @@ def test_conv_1x1():
     )
 
 
+def test_vulkan_tensorcore_matmul():
+    mod = te.create_prim_func(
+        te_workload.matmul(n=128, m=128, k=128, in_dtype="float16", out_dtype="float32")
+    )
+    actual = generate_design_space(
+        kind="vulkan-tensorcore",
+        mod=mod,
+        target=tvm.target.Target("vulkan -supports_float16=1 -supports_khr_cooperative_matrix=1"),
+        types=ms.schedule_rule.MultiLevelTilingTensorCore,
+    )
+    assert len(actual) == 1
+    script = actual[0].mod.script()
+    # SPIR-V has no dynamic shared memory, so the fragments are loaded from static shared memory
+    assert "shared.dyn" not in script
+    assert "wmma_load_16x16x16_f16_a_shared" in str(actual[0].trace)
+    assert "wmma_sync_16x16x16_f16f16f32" in str(actual[0].trace)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
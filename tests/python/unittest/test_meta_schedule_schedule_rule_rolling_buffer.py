@@ -0,0 +1,106 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm.meta_schedule.testing.space_generation import generate_design_space
+from tvm.script import tir as T
+from tvm.target import Target
+
+# fmt: off
+# pylint: disable=no-member,invalid-name,unused-variable,no-self-argument,line-too-long,chained-comparison,not-callable,too-many-nested-blocks
+
+@T.prim_func
+def cascade_2_max_pool2d(A: T.Buffer((1, 12, 12, 16), "int8"), C: T.Buffer((1, 8, 8, 16), "int8")):
+    B = T.alloc_buffer([1, 10, 10, 16], dtype="int8")
+    for i0, i1, i2, i3, i4, i5 in T.grid(1, 10, 10, 16, 3, 3):
+        with T.block("B"):
+            ax0, ax1, ax2, ax3, rv0, rv1 = T.axis.remap("SSSSRR", [i0, i1, i2, i3, i4, i5])
+            with T.init():
+                B[ax0, ax1, ax2, ax3] = T.int8(-128)
+            B[ax0, ax1, ax2, ax3] = T.max(B[ax0, ax1, ax2, ax3], A[ax0, ax1 + rv0, ax2 + rv1, ax3])
+    for i0, i1, i2, i3, i4, i5 in T.grid(1, 8, 8, 16, 3, 3):
+        with T.block("C"):
+            ax0, ax1, ax2, ax3, rv0, rv1 = T.axis.remap("SSSSRR", [i0, i1, i2, i3, i4, i5])
+            with T.init():
+                C[ax0, ax1, ax2, ax3] = T.int8(-128)
+            C[ax0, ax1, ax2, ax3] = T.max(C[ax0, ax1, ax2, ax3], B[ax0, ax1 + rv0, ax2 + rv1, ax3])
+
+# pylint: enable=no-member,invalid-name,unused-variable,no-self-argument,line-too-long,chained-comparison,not-callable,too-many-nested-blocks
+# fmt: on
+
+
+def _get_alloc_shape(mod: tvm.IRModule, name: str):
+    shapes = []
+
+    def _visit(stmt):
+        if isinstance(stmt, tvm.tir.Block):
+            for buf in stmt.alloc_buffers:
+                if buf.name == name:
+                    shapes.append([int(dim) for dim in buf.shape])
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, _visit)
+    assert len(shapes) == 1
+    return shapes[0]
+
+
+def test_rolling_buffer_cascade_max_pool2d():
+    mod = tvm.IRModule({"main": cascade_2_max_pool2d})
+    actual = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.RollingBuffer()],
+    )
+    assert len(actual) == 2
+    shapes = sorted(_get_alloc_shape(sch.mod, "B") for sch in actual)
+    # The untouched design space keeps the whole feature map, while the rolled one only keeps the
+    # 3 rows of B that an output row of C reads
+    assert shapes == [[1, 3, 10, 16], [1, 10, 10, 16]]
+    rolled = [sch for sch in actual if _get_alloc_shape(sch.mod, "B")[1] == 3][0]
+    annotations = [
+        inst
+        for inst in rolled.trace.insts
+        if inst.kind.name == "Annotate" and inst.attrs[0] == "meta_schedule.rolling_buffer"
+    ]
+    assert len(annotations) == 1
+
+
+def test_rolling_buffer_skip_without_consumer():
+    @T.prim_func
+    def single_pool(A: T.Buffer((1, 12, 12, 16), "int8"), B: T.Buffer((1, 10, 10, 16), "int8")):
+        for i0, i1, i2, i3, i4, i5 in T.grid(1, 10, 10, 16, 3, 3):
+            with T.block("B"):
+                ax0, ax1, ax2, ax3, rv0, rv1 = T.axis.remap("SSSSRR", [i0, i1, i2, i3, i4, i5])
+                with T.init():
+                    B[ax0, ax1, ax2, ax3] = T.int8(-128)
+                B[ax0, ax1, ax2, ax3] = T.max(B[ax0, ax1, ax2, ax3], A[ax0, ax1 + rv0, ax2 + rv1, ax3])
+
+    actual = generate_design_space(
+        kind="llvm",
+        mod=tvm.IRModule({"main": single_pool}),
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.RollingBuffer()],
+    )
+    assert len(actual) == 1
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,74 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm.meta_schedule.testing.space_generation import generate_design_space
+from tvm.script import tir as T
+from tvm.target import Target
+
+# fmt: off
+# pylint: disable=no-member,invalid-name,unused-variable,no-self-argument,line-too-long,chained-comparison,not-callable,too-many-nested-blocks
+
+@T.prim_func
+def embedding(table: T.Buffer((1024, 64), "float32"), idx: T.Buffer((256,), "int32"), out: T.Buffer((256, 64), "float32")):
+    for i, j in T.grid(256, 64):
+        with T.block("take"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            out[vi, vj] = table[idx[vi], vj]
+
+# pylint: enable=no-member,invalid-name,unused-variable,no-self-argument,line-too-long,chained-comparison,not-callable,too-many-nested-blocks
+# fmt: on
+
+
+def test_software_prefetch_embedding():
+    actual = generate_design_space(
+        kind="llvm",
+        mod=tvm.IRModule({"main": embedding}),
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.SoftwarePrefetch([0, 8, 16])],
+    )
+    assert len(actual) == 1
+    insts = actual[0].trace.insts
+    samples = [inst for inst in insts if inst.kind.name == "SampleCategorical"]
+    assert len(samples) == 1
+    assert [int(v) for v in samples[0].attrs[0]] == [0, 8, 16]
+    annotations = [
+        inst
+        for inst in insts
+        if inst.kind.name == "Annotate" and inst.attrs[0] == "meta_schedule.prefetch_distance"
+    ]
+    assert len(annotations) == 1
+    assert annotations[0].inputs[1].same_as(samples[0].outputs[0])
+
+
+def test_software_prefetch_disabled():
+    actual = generate_design_space(
+        kind="llvm",
+        mod=tvm.IRModule({"main": embedding}),
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.SoftwarePrefetch([])],
+    )
+    assert len(actual) == 1
+    assert not [inst for inst in actual[0].trace.insts if inst.kind.name == "Annotate"]
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -18,6 +18,7 @@
 # pylint: disable=missing-function-docstring
 from typing import List
 
+import numpy as np
 import pytest
 import tvm
 import tvm.testing
@@ -47,6 +48,22 @@ class Matmul:
                     C[vi, vj] = 0.0 # type: ignore
                 C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
 
+
+@tvm.script.ir_module
+class Matmul64:
+    @T.prim_func
+    def main(a: T.handle, b: T.handle, c: T.handle) -> None: # type: ignore
+        T.func_attr({"global_symbol": "main"})
+        A = T.match_buffer(a, (64, 64), "float32")
+        B = T.match_buffer(b, (64, 64), "float32")
+        C = T.match_buffer(c, (64, 64), "float32")
+        for i, j, k in T.grid(64, 64, 64):
+            with T.block("matmul"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                with T.init():
+                    C[vi, vj] = 0.0 # type: ignore
+                C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
+
 # fmt: on
 # pylint: enable=missing-class-docstring,invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument
 
@@ -306,9 +323,202 @@ def test_meta_schedule_evolutionary_search_fail_init_population():  # pylint: di
     assert candidates is None
 
 
+def test_meta_schedule_evolutionary_search_transfer():  # pylint: disable = invalid-name
+    @derived_object
+    class RecordingCostModel(ms.cost_model.PyCostModel):
+        """A cost model that records the traces it scores."""
+
+        def __init__(self):
+            super().__init__()
+            self.traces = []
+
+        def load(self, path: str) -> None:
+            pass
+
+        def save(self, path: str) -> None:
+            pass
+
+        def update(self, context, candidates, results) -> None:
+            pass
+
+        def predict(self, context, candidates):
+            self.traces.extend(str(candidate.sch.trace) for candidate in candidates)
+            return np.ones(len(candidates))
+
+    # Tune the 64x64x64 matmul with tiles that are still perfect on the 32x32x32 one
+    database = ms.database.MemoryDatabase()
+    sch = Schedule(Matmul64)
+    block = sch.get_block("matmul")
+    i, j, k = sch.get_loops(block=block)
+    i_0, i_1, i_2, i_3 = sch.split(i, sch.sample_perfect_tile(i, n=4, decision=[4, 2, 2, 4]))
+    j_0, j_1, j_2, j_3 = sch.split(j, sch.sample_perfect_tile(j, n=4, decision=[4, 2, 2, 4]))
+    k_0, k_1 = sch.split(k, sch.sample_perfect_tile(k, n=2, decision=[8, 8]))
+    sch.reorder(i_0, j_0, i_1, j_1, k_0, i_2, j_2, k_1, i_3, j_3)
+    database.commit_tuning_record(
+        ms.database.TuningRecord(
+            sch.trace,
+            database.commit_workload(Matmul64),
+            [1.0],
+            tvm.target.Target("llvm"),
+            ms.arg_info.ArgInfo.from_prim_func(Matmul64["main"]),
+        )
+    )
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=10,
+            init_measured_ratio=0.5,
+            init_min_unmeasured=5,
+            genetic_num_iters=1,
+            eps_greedy=0.5,
+            num_transfer_workloads=1,
+        ),
+        target=tvm.target.Target("llvm"),
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    cost_model = RecordingCostModel()
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=10,
+        num_trials_per_iter=5,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=database,
+        cost_model=cost_model,
+    )
+    candidates = strategy.generate_measure_candidates()
+    strategy.post_tuning()
+    assert candidates is not None
+    # The inner tiles of the record are kept, while the outermost ones shrink to fit
+    assert any("decision=[2, 2, 2, 4]" in trace for trace in cost_model.traces)
+    assert any("decision=[4, 8]" in trace for trace in cost_model.traces)
+
+
+def test_meta_schedule_evolutionary_search_reuse_scores():  # pylint: disable = invalid-name
+    @derived_object
+    class CountingCostModel(ms.cost_model.PyCostModel):
+        """A cost model that records the sizes of the batches it scores."""
+
+        def __init__(self):
+            super().__init__()
+            self.batch_sizes = []
+
+        def load(self, path: str) -> None:
+            pass
+
+        def save(self, path: str) -> None:
+            pass
+
+        def update(self, context, candidates, results) -> None:
+            pass
+
+        def predict(self, context, candidates):
+            self.batch_sizes.append(len(candidates))
+            return np.ones(len(candidates))
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=5,
+            init_measured_ratio=0.1,
+            init_min_unmeasured=5,
+            genetic_num_iters=3,
+            genetic_mutate_prob=0.0,
+            eps_greedy=0.0,
+        ),
+        target=tvm.target.Target("llvm"),
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    cost_model = CountingCostModel()
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=10,
+        num_trials_per_iter=5,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=ms.database.MemoryDatabase(),
+        cost_model=cost_model,
+    )
+    candidates = strategy.generate_measure_candidates()
+    strategy.post_tuning()
+    assert candidates is not None
+    # Without mutation, the population is only scored in the first of the 4 iterations
+    assert len(cost_model.batch_sizes) == 1
+    assert cost_model.batch_sizes[0] <= 5
+
+
+def test_meta_schedule_evolutionary_search_dedup_lowered_ir():  # pylint: disable = invalid-name
+    def _schedule_matmul_split_k(sch: Schedule):
+        block = sch.get_block("matmul")
+        _, _, k = sch.get_loops(block=block)
+        # The splits [1, 32] and [32, 1] lower to the same loop nest
+        sch.split(k, sch.sample_perfect_tile(k, n=2))
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul_split_k,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=20,
+            init_measured_ratio=0.0,
+            init_min_unmeasured=20,
+            genetic_num_iters=1,
+            eps_greedy=1.0,
+            dedup_lowered_ir=True,
+        ),
+        target=tvm.target.Target("llvm"),
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=20,
+        num_trials_per_iter=10,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=ms.database.MemoryDatabase(),
+        cost_model=ms.cost_model.RandomModel(),
+    )
+    lowered: List[tvm.IRModule] = []
+    candidates = strategy.generate_measure_candidates()
+    while candidates is not None:
+        for candidate in candidates:
+            mod = tvm.lower(candidate.sch.mod)
+            assert not any(tvm.ir.structural_equal(mod, prev) for prev in lowered)
+            lowered.append(mod)
+        runner_results = [ms.runner.RunnerResult(run_secs=[0.1], error_msg=None)] * len(candidates)
+        strategy.notify_runner_results(candidates, runner_results)
+        candidates = strategy.generate_measure_candidates()
+    strategy.post_tuning()
+    # 32 has 6 splits into 2 factors, 2 of which lower to the same code
+    assert len(lowered) <= 5
+
+
 if __name__ == "__main__":
     test_meta_schedule_replay_func(ms.search_strategy.ReplayFunc)
     test_meta_schedule_replay_func(ms.search_strategy.ReplayTrace)
     test_meta_schedule_evolutionary_search()
     test_meta_schedule_evolutionary_search_early_stop()
     test_meta_schedule_evolutionary_search_fail_init_population()
+    test_meta_schedule_evolutionary_search_transfer()
+    test_meta_schedule_evolutionary_search_reuse_scores()
+    test_meta_schedule_evolutionary_search_dedup_lowered_ir()
@@ -23,6 +23,7 @@ import pytest
 import tvm
 import tvm.testing
 from tvm._ffi.base import TVMError
+from tvm.meta_schedule.schedule_rule import MultiLevelTilingWithIntrin
 from tvm.meta_schedule.space_generator import (
     PySpaceGenerator,
     ScheduleFn,
@@ -106,5 +107,29 @@ def test_meta_schedule_design_space_generator_NIE():
         generator._initialize_with_tune_context(TuneContext())
 
 
+@pytest.mark.parametrize(
+    "target",
+    [
+        "llvm -mcpu=cascadelake -num-cores=4",
+        "llvm -mattr=+avx512vnni -num-cores=4",
+        "llvm -mcpu=x86-64 -mattr=+avx512f,+amx-int8 -num-cores=4",
+    ],
+)
+def test_meta_schedule_space_generator_x86_vnni_from_target(target):
+    context = TuneContext(mod=Matmul, target=target, space_generator="post-order-apply")
+    sch_rules = context.space_generator.sch_rules
+    assert any(isinstance(rule, MultiLevelTilingWithIntrin) for rule in sch_rules)
+
+
+def test_meta_schedule_space_generator_x86_no_vnni():
+    context = TuneContext(
+        mod=Matmul,
+        target="llvm -mcpu=x86-64 -mattr=+avx2 -num-cores=4",
+        space_generator="post-order-apply",
+    )
+    sch_rules = context.space_generator.sch_rules
+    assert not any(isinstance(rule, MultiLevelTilingWithIntrin) for rule in sch_rules)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -353,6 +353,68 @@ def test_meta_schedule_task_scheduler_multiple_gradient_based():
         )
 
 
+@ms.derived_object
+class ConstantRunnerFuture(ms.runner.PyRunnerFuture):
+    def done(self) -> bool:
+        return True
+
+    def result(self) -> ms.runner.RunnerResult:
+        return ms.runner.RunnerResult([1e-3], None)
+
+
+@ms.derived_object
+class ConstantRunner(ms.runner.PyRunner):
+    def run(self, runner_inputs):
+        return [ConstantRunnerFuture() for _ in runner_inputs]  # type: ignore
+
+
+def test_meta_schedule_task_scheduler_stop_on_convergence():
+    num_trials_per_iter = 6
+    max_trials_per_task = 101
+    patience = 12
+    tasks = [
+        ms.TuneContext(
+            MatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="Matmul",
+            rand_state=42,
+        ),
+        ms.TuneContext(
+            BatchMatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_batch_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="BatchMatmul",
+            rand_state=0x114514,
+        ),
+    ]
+    database = ms.database.MemoryDatabase()
+    gradient_based = ms.task_scheduler.GradientBased()
+    gradient_based.tune(
+        tasks,
+        task_weights=[1.0, 1.0],
+        builder=DummyBuilder(),
+        runner=ConstantRunner(),
+        database=database,
+        measure_callbacks=[
+            ms.measure_callback.StopOnConvergence(patience=patience),
+            ms.measure_callback.AddToDatabase(),
+        ],
+        max_trials_global=max_trials_per_task * len(tasks),
+        max_trials_per_task=max_trials_per_task,
+        num_trials_per_iter=num_trials_per_iter,
+        cost_model=None,
+    )
+    # The first batch sets the best latency, which then never improves
+    for task in tasks:
+        assert (
+            len(database.get_top_k(database.commit_workload(task.mod), 10000))
+            == num_trials_per_iter + patience
+        )
+
+
 def test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy():
     """
     When search strategy of one task returns empty list of candidates or None,
@@ -443,4 +505,5 @@ if __name__ == "__main__":
     test_meta_schedule_task_scheduler_avoid_cyclic()
     test_meta_schedule_task_scheduler_override_next_task_id_only()
     test_meta_schedule_task_scheduler_multiple_gradient_based()
+    test_meta_schedule_task_scheduler_stop_on_convergence()
     test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
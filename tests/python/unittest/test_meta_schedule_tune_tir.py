@@ -61,6 +61,20 @@ def two_step(a: T.handle, c: T.handle) -> None:
             C[vi, vj] = B[vi, vj] + 3.0
 
 
+@T.prim_func
+def matmul_dynamic(a: T.handle, b: T.handle, c: T.handle) -> None:
+    n = T.int32()
+    A = T.match_buffer(a, [n, 128])
+    B = T.match_buffer(b, [128, 128])
+    C = T.match_buffer(c, [n, 128])
+    for i, j, k in T.grid(n, 128, 128):
+        with T.block("update"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                C[vi, vj] = 0.0
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
 @tvm.testing.requires_llvm
 def test_tune_matmul_cpu():
     with tempfile.TemporaryDirectory() as work_dir:
@@ -178,8 +192,40 @@ def test_tune_block_cpu():
         sch.trace.show()
 
 
+@tvm.testing.requires_llvm
+def test_tune_matmul_dynamic_cpu():
+    with tempfile.TemporaryDirectory() as work_dir:
+        target = Target("llvm --num-cores=16")
+        database = ms.tir_integration.tune_tir_dynamic(
+            mod=matmul_dynamic,
+            var_name="n",
+            sample_values=[16, 64],
+            target=target,
+            work_dir=work_dir,
+            max_trials_global=16,
+            num_trials_per_iter=8,
+        )
+        mod = ms.tir_integration.compile_tir_dynamic(
+            database, matmul_dynamic, "n", [16, 64], target
+        )
+    assert ms.tir_integration.dispatch_dynamic(mod, 10) == ("main_n_16", 16)
+    assert ms.tir_integration.dispatch_dynamic(mod, 64) == ("main_n_64", 64)
+    assert ms.tir_integration.dispatch_dynamic(mod, 100) == ("main", None)
+    lib = tvm.build(mod, target=target)
+    b_np = np.random.uniform(size=(128, 128)).astype("float32")
+    for n in [10, 100]:
+        name, padded = ms.tir_integration.dispatch_dynamic(mod, n)
+        rows = padded or n
+        a_np = np.zeros((rows, 128), "float32")
+        a_np[:n] = np.random.uniform(size=(n, 128))
+        c = tvm.nd.array(np.zeros((rows, 128), "float32"))
+        lib[name](tvm.nd.array(a_np), tvm.nd.array(b_np), c)
+        tvm.testing.assert_allclose(c.numpy()[:n], a_np[:n] @ b_np.T, rtol=1e-4)
+
+
 if __name__ == """__main__""":
     test_tune_matmul_cpu()
     test_tune_matmul_cuda()
     test_tune_run_module_via_rpc()
     test_tune_block_cpu()
+    test_tune_matmul_dynamic_cpu()
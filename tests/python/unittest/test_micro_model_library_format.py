@@ -20,6 +20,7 @@ import sys
 import datetime
 import json
 import os
+import struct
 import tarfile
 
 import numpy as np
@@ -139,6 +140,50 @@ def validate_graph_json(extract_dir, factory):
         assert len(graph["nodes"]) == 4
         assert "attrs" in graph
 
+    with open(
+        os.path.join(extract_dir, "executor-config", "graph", f"{factory.libmod_name}.graph.bin"),
+        "rb",
+    ) as graph_bin_f:
+        assert graph_bin_f.read() == micro.graph_binary.serialize_graph(factory.graph_json)
+
+
+@tvm.testing.requires_micro
+def test_serialize_graph_binary():
+    graph = {
+        "nodes": [
+            {"op": "null", "name": "x", "inputs": []},
+            {"op": "null", "name": "p0", "inputs": []},
+            {
+                "op": "tvm_op",
+                "name": "add",
+                "attrs": {"num_outputs": "1", "flatten_data": "0", "func_name": "fused_add"},
+                "inputs": [[0, 0, 0], [1, 0, 0]],
+            },
+        ],
+        "arg_nodes": [0, 1],
+        "heads": [[2, 0, 0]],
+        "attrs": {
+            "dltype": ["list_str", ["float32", "float32", "int8"]],
+            "storage_id": ["list_int", [0, 1, 2]],
+            "shape": ["list_shape", [[10, 5], [5], [10, 5]]],
+        },
+        "node_row_ptr": [0, 1, 2, 3],
+    }
+    binary = micro.graph_binary.serialize_graph(json.dumps(graph))
+    assert len(binary) % 8 == 0
+    header = struct.unpack_from("<QIIIIIIII", binary)
+    assert header == (micro.graph_binary.GRAPH_BINARY_MAGIC, 1, 3, 2, 2, 1, 3, 2, 19)
+    offset = struct.calcsize("<QIIIIIIII")
+    assert struct.unpack_from("<6q", binary, offset) == (10, 5, 5, 0, 10, 5)
+    offset += 6 * 8
+    nodes = [struct.unpack_from("<6I", binary, offset + i * 24) for i in range(3)]
+    null_op = micro.graph_binary.GRAPH_BINARY_NULL_OP
+    assert nodes == [(0, null_op, 0, 0, 1, 0), (2, null_op, 0, 0, 1, 0), (5, 9, 0, 2, 1, 0)]
+    assert binary.endswith(b"x\0p0\0add\0fused_add\0" + b"\0" * 5)
+
+    with pytest.raises(ValueError):
+        micro.graph_binary.serialize_graph(json.dumps(graph), shape_stride=1)
+
 
 @tvm.testing.requires_micro
 @pytest.mark.parametrize(
@@ -195,5 +195,20 @@ def test_alloc_const():
     np.testing.assert_array_equal(np_data, alloc_const2.data.numpy())
 
 
+def test_binary_saveload():
+    dev = tvm.cpu(0)
+    n = te.var("n")
+    A = te.placeholder((n, 10), name="A")
+    B = te.compute((n, 10), lambda i, j: A[i, j] + 1.0, name="B")
+    data = tvm.nd.array(np.random.rand(4).astype("float32"), device=dev)
+    objs = [B.op.body[0], {"key": data, "name": "value"}, tvm.runtime.String("\0\1bytes")]
+    for obj in objs:
+        blob = tvm.ir.save_binary(obj)
+        assert len(blob) < len(tvm.ir.save_json(obj))
+        obj2 = tvm.ir.load_json(blob)
+        tvm.ir.assert_structural_equal(obj, obj2, map_free_vars=True)
+    np.testing.assert_array_equal(tvm.ir.load_json(tvm.ir.save_binary(data)).numpy(), data.numpy())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
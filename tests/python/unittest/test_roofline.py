@@ -131,5 +131,40 @@ def test_roofline_analysis(target, dev):
                 assert 90 >= call["Percent of Theoretical Optimal"].ratio >= 0.01
 
 
+
+def test_roofline_from_target():
+    @T.prim_func
+    def add(a: T.Buffer((1024,), "float32"), b: T.Buffer((1024,), "float32")):
+        T.func_attr({"hash": "add"})
+        for i in range(1024):
+            with T.block("add"):
+                vi = T.axis.remap("S", [i])
+                b[vi] = a[vi] + T.float32(1)
+
+    report = Report(
+        [
+            {"Name": "add", "Hash": "add", "Duration (us)": tvm.runtime.profiling.Duration(1.0)},
+            {"Name": "copy", "Duration (us)": tvm.runtime.profiling.Duration(2.0)},
+        ],
+        {},
+        {},
+    )
+    target = tvm.target.Target("cuda -peak_gflops=1000 -peak_gbps=100")
+    roofline = tvm.utils.roofline.roofline_from_target(
+        report, {tvm.ir.GlobalVar("add"): add}, target, threshold=50.0
+    )
+    call = roofline.calls[0]
+    assert call["Estimated FLOPs"].count == 1024
+    assert call["Estimated Bytes"].count == 8192
+    assert call["GB/s"].ratio == pytest.approx(8.192)
+    # 8192 bytes at 100 GB/s take 0.08192 us, which is 8.192% of the measured 1 us.
+    assert call["Percent of Roofline"].ratio == pytest.approx(8.192)
+    assert call["Below Roofline"] == "yes"
+    assert "Percent of Roofline" not in roofline.calls[1]
+
+    with pytest.raises(ValueError):
+        tvm.utils.roofline.roofline_from_target(report, {}, tvm.target.Target("cuda"))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -14,7 +14,9 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import os
 import tempfile
+import pytest
 import tvm
 import tvm.testing
 from tvm import te, runtime
@@ -139,6 +141,204 @@ def test_load_unexpected_params():
     rt_mod.load_params(runtime.save_param_dict(new_params))
 
 
+@tvm.testing.parametrize_targets("llvm", "cuda")
+def test_set_inputs_get_outputs(target, dev):
+    names = ["x%d" % i for i in range(8)]
+    xs = [relay.var(name, shape=(4, 3)) for name in names]
+    large = relay.var("large", shape=(256, 256))
+    out = xs[0]
+    for x in xs[1:]:
+        out = relay.add(out, x)
+    func = relay.Function(xs + [large], relay.Tuple([out, relay.exp(large)]))
+    graph, lib, _ = relay.build(func, target=target)
+
+    mod = graph_executor.create(graph, lib, dev)
+    inputs = {name: np.random.uniform(size=(4, 3)).astype("float32") for name in names}
+    large_in = np.random.uniform(size=(256, 256)).astype("float32")
+    # The small inputs are packed together, the large one is copied on its own.
+    mod.set_inputs(inputs, pack_bytes=1024, large=large_in, unknown=large_in)
+    mod.run()
+    outputs = mod.get_outputs()
+    assert all(out.device.device_type == tvm.cpu().device_type for out in outputs)
+    tvm.testing.assert_allclose(outputs[0].numpy(), sum(inputs.values()), rtol=1e-5)
+    tvm.testing.assert_allclose(outputs[1].numpy(), np.exp(large_in), rtol=1e-5)
+
+    # Packing can be disabled.
+    inputs = {name: v * 2 for name, v in inputs.items()}
+    mod.set_inputs(inputs, pack_bytes=0)
+    mod.run()
+    tvm.testing.assert_allclose(mod.get_outputs()[0].numpy(), sum(inputs.values()), rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_async_requests():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    func = relay.Function([x, y], relay.add(x, y))
+    x_in = np.ones((1, 10)).astype("float32")
+    graph, lib, params = relay.build(func, target="llvm", params={"x": x_in})
+
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.load_params(runtime.save_param_dict(params))
+    mod.init_async(2)
+    inputs = [np.random.uniform(size=(1, 10)).astype("float32") for _ in range(8)]
+    request_ids = [mod.enqueue(y=a) for a in inputs]
+    outputs = [mod.wait(request_id) for request_id in request_ids]
+    for a, out in zip(inputs, outputs):
+        np.testing.assert_equal(out[0].numpy(), x_in + a)
+
+
+@tvm.testing.requires_llvm
+def test_clone():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    func = relay.Function([x, y], relay.add(x, y))
+    x_in = np.ones((1, 10)).astype("float32")
+    graph, lib, params = relay.build(func, target="llvm", params={"x": x_in})
+
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.load_params(runtime.save_param_dict(params))
+    clone = mod.clone()
+    y_a = np.random.uniform(size=(1, 10)).astype("float32")
+    y_b = np.random.uniform(size=(1, 10)).astype("float32")
+    mod.set_input(y=y_a)
+    clone.set_input(y=y_b)
+    mod.run()
+    clone.run()
+    np.testing.assert_equal(mod.get_output(0).numpy(), x_in + y_a)
+    np.testing.assert_equal(clone.get_output(0).numpy(), x_in + y_b)
+    # The parameter is shared rather than copied.
+    assert mod.get_input("x").handle.contents.data == clone.get_input("x").handle.contents.data
+
+
+def test_inter_op_parallelism():
+    x = relay.var("x", shape=(4, 16))
+    branches = [relay.nn.relu(relay.multiply(x, relay.const(float(i)))) for i in range(4)]
+    out = relay.concatenate([relay.exp(b) for b in branches], axis=0)
+    graph, lib, _ = relay.build(relay.Function([x], out), target="llvm")
+
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.set_inter_op_parallelism(4)
+    for _ in range(3):
+        x_in = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+        mod.run(x=x_in)
+        ref = np.concatenate([np.exp(np.maximum(x_in * i, 0)) for i in range(4)], axis=0)
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), ref, rtol=1e-5)
+
+
+@tvm.testing.requires_cuda
+def test_l2_persisting_input():
+    x = relay.var("x", shape=(16, 64))
+    w = relay.var("w", shape=(32, 64))
+    func = relay.Function([x, w], relay.nn.dense(x, w))
+    w_in = np.random.uniform(size=(32, 64)).astype("float32")
+    graph, lib, params = relay.build(func, target="cuda", params={"w": w_in})
+
+    mod = graph_executor.create(graph, lib, tvm.cuda(0))
+    mod.load_params(runtime.save_param_dict(params))
+    mod.set_l2_persisting_input("w", 0.5)
+    x_in = np.random.uniform(size=(16, 64)).astype("float32")
+    mod.run(x=x_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_in @ w_in.T, rtol=1e-5)
+    mod.set_l2_persisting_input(None)
+    tvm.get_global_func("device_api.cuda.reset_l2_persisting")(tvm.cuda(0))
+    mod.run(x=x_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_in @ w_in.T, rtol=1e-5)
+
+
+@tvm.testing.requires_cuda
+def test_weight_streaming():
+    x = relay.var("x", shape=(8, 64))
+    out, params = x, {}
+    for i in range(4):
+        w = relay.var("w%d" % i, shape=(64, 64))
+        out = relay.nn.relu(relay.nn.dense(out, w))
+        params["w%d" % i] = np.random.uniform(-0.1, 0.1, size=(64, 64)).astype("float32")
+    func = relay.Function(relay.analysis.free_vars(out), out)
+    graph, lib, params = relay.build(func, target="cuda", params=params)
+    x_in = np.random.uniform(size=(8, 64)).astype("float32")
+
+    mod = graph_executor.create(graph, lib, tvm.cuda(0))
+    mod.load_params(runtime.save_param_dict(params))
+    mod.run(x=x_in)
+    expected = mod.get_output(0).numpy()
+
+    mod.enable_weight_streaming(2)
+    assert mod.get_input("w0").device.device_type == tvm.runtime.Device.kDLCUDAHost
+    for _ in range(2):
+        mod.run(x=x_in)
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), expected, rtol=1e-5)
+
+    # A clone streams the parameters it shares with its source.
+    clone = mod.clone()
+    clone.run(x=x_in)
+    tvm.testing.assert_allclose(clone.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_weight_streaming_cpu():
+    x = relay.var("x", shape=(2, 8))
+    w = relay.var("w", shape=(8, 8))
+    func = relay.Function([x, w], relay.nn.dense(x, w))
+    w_in = np.random.uniform(size=(8, 8)).astype("float32")
+    graph, lib, params = relay.build(func, target="llvm", params={"w": w_in})
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.load_params(runtime.save_param_dict(params))
+    with pytest.raises(tvm.TVMError):
+        mod.enable_weight_streaming(2)
+
+
+@tvm.testing.requires_llvm
+def test_binary_graph():
+    x = relay.var("x", shape=(2, 8))
+    y = relay.var("y", shape=(2, 8))
+    func = relay.Function([x, y], relay.exp(relay.add(x, y)))
+    x_in = np.random.uniform(size=(2, 8)).astype("float32")
+    y_in = np.random.uniform(size=(2, 8)).astype("float32")
+    factory = relay.build(func, target="llvm")
+    graph_json = factory.get_graph_json()
+
+    graph_binary = graph_executor.encode_binary_graph(graph_json)
+    mod = graph_executor.create(graph_binary, factory.get_lib(), tvm.cpu(0))
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), np.exp(x_in + y_in), rtol=1e-5)
+
+    # Exported factories carry the binary graph next to the JSON.
+    temp = utils.tempdir()
+    path = temp.relpath("lib.so")
+    factory.export_library(path)
+    loaded = tvm.runtime.load_module(path)
+    assert loaded["get_graph_json"]() == graph_json
+    mod = graph_executor.GraphModule(loaded["default"](tvm.cpu(0)))
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), np.exp(x_in + y_in), rtol=1e-5)
+
+
+def test_share_params():
+    x = relay.var("x", shape=(2, 8))
+    y = relay.var("y", shape=(2, 8))
+    func = relay.Function([x, y], relay.exp(relay.add(x, y)))
+    x_in = np.random.uniform(size=(2, 8)).astype("float32")
+    y_in = np.random.uniform(size=(2, 8)).astype("float32")
+    factory = relay.build(func, target="llvm", params={"y": y_in})
+    temp = utils.tempdir()
+    path = temp.relpath("lib.so")
+    factory.export_library(path)
+
+    name = "/tvm_test_share_params_%d" % os.getpid()
+    factory["share_params"](name, tvm.cpu(0))
+    owner = graph_executor.GraphModule(factory["default"](tvm.cpu(0)))
+    owner.run(x=x_in)
+    tvm.testing.assert_allclose(owner.get_output(0).numpy(), np.exp(x_in + y_in), rtol=1e-5)
+
+    # Another process would load the library and attach to the same name.
+    loaded = tvm.runtime.load_module(path)
+    loaded["attach_params"](name, tvm.cpu(0))
+    mod = graph_executor.GraphModule(loaded["default"](tvm.cpu(0)))
+    mod.run(x=x_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), np.exp(x_in + y_in), rtol=1e-5)
+
+
 def test_save_load_file():
     p = np.random.randn(10)
     params = {"x": p}
@@ -151,5 +351,51 @@ def test_save_load_file():
         np.testing.assert_equal(p, params_loaded["x"].numpy())
 
 
+def test_save_load_mmap_file():
+    params = {"x": np.random.randn(10), "y": np.random.randn(3, 7).astype("float32")}
+
+    with tempfile.NamedTemporaryFile() as fp:
+        tvm.runtime.save_param_dict_to_mmap_file(params, fp.name)
+        params_loaded = tvm.runtime.load_param_dict_from_mmap_file(fp.name)
+
+        for name, value in params.items():
+            assert name in params_loaded
+            np.testing.assert_equal(value, params_loaded[name].numpy())
+
+
+@tvm.testing.parametrize_targets("llvm", "cuda")
+def test_load_param_dict_to_device(target, dev):
+    params = {
+        "x": np.random.randn(10),
+        "y": np.random.randn(3, 7).astype("float32"),
+        "z": np.zeros((0, 4), "float32"),
+    }
+
+    with tempfile.NamedTemporaryFile() as fp:
+        tvm.runtime.save_param_dict_to_mmap_file(params, fp.name)
+        for num_threads in [0, 1, 2]:
+            params_loaded = tvm.runtime.load_param_dict_to_device(fp.name, dev, num_threads)
+            for name, value in params.items():
+                assert params_loaded[name].device == dev
+                np.testing.assert_equal(value, params_loaded[name].numpy())
+
+
+@tvm.testing.requires_llvm
+def test_load_params_mmap():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    func = relay.Function([x, y], relay.add(x, y))
+    x_in = np.random.uniform(size=(1, 10)).astype("float32")
+    y_in = np.random.uniform(size=(1, 10)).astype("float32")
+    graph, lib, params = relay.build(func, target="llvm", params={"x": x_in})
+
+    with tempfile.NamedTemporaryFile() as fp:
+        runtime.save_param_dict_to_mmap_file(params, fp.name)
+        mod = graph_executor.create(graph, lib, tvm.cpu(0))
+        mod.load_params_from_mmap_file(fp.name)
+    mod.run(y=y_in)
+    np.testing.assert_equal(mod.get_output(0).numpy(), x_in + y_in)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -24,11 +24,11 @@ import pytest
 
 import tvm
 import tvm.testing
-from tvm import te
+from tvm import te, relay
 import numpy as np
 
 from tvm.contrib import utils, graph_executor
-from tvm.contrib.cuda_graph import cuda_graph_executor
+from tvm.contrib.cuda_graph import cuda_graph_executor, cuda_graph_vm
 
 
 bx = te.thread_axis("blockIdx.x")
@@ -93,8 +93,44 @@ def test_graph_simple():
         out = mod.get_output(0, tvm.nd.empty((n,)))
         np.testing.assert_equal(out.numpy(), a + 1)
 
+        # rotate between zero copy buffers, each one getting its own cached graph
+        mod.set_cuda_graph_cache_size(2)
+        for i in range(6):
+            a = np.random.uniform(size=(n,)).astype(A.dtype)
+            inp = tvm.nd.array(a, dev)
+            out = tvm.nd.empty((n,), A.dtype, dev)
+            mod.set_input_zero_copy("x", inp)
+            mod.set_output_zero_copy(0, out)
+            mod.run()
+            np.testing.assert_equal(out.numpy(), a + 1)
+
     check_verify()
 
 
+@tvm.testing.requires_cudagraph
+def test_vm_cuda_graph():
+    x = relay.var("x", shape=(16,), dtype="float32")
+    y = relay.subtract(relay.multiply(relay.add(x, relay.const(1.0)), relay.const(2.0)), x)
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    # Keep the operators in separate kernels, so that the region has several launches.
+    with tvm.transform.PassContext(opt_level=0):
+        exe = relay.vm.compile(mod, target="cuda")
+    dev = tvm.cuda(0)
+    try:
+        vm = cuda_graph_vm.VirtualMachineCudaGraph(exe, dev)
+    except ValueError:
+        return
+
+    # Graphs are keyed by the input buffers, so keep feeding the same one.
+    inp = tvm.nd.empty((16,), "float32", dev)
+    for _ in range(4):
+        # The second run captures the graph, the following ones replay it.
+        a = np.random.uniform(size=(16,)).astype("float32")
+        inp.copyfrom(a)
+        out = vm.invoke("main", inp)
+        np.testing.assert_allclose(out.numpy(), (a + 1) * 2 - a, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_graph_simple()
+    test_vm_cuda_graph()
@@ -0,0 +1,93 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import json
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import te
+from tvm.contrib.hip_graph import hip_graph_executor
+
+
+@tvm.testing.requires_rocm
+def test_graph_simple():
+    n = 32
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda *i: A(*i) + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=8)
+    s[B].bind(xo, te.thread_axis("blockIdx.x"))
+    s[B].bind(xi, te.thread_axis("threadIdx.x"))
+
+    node0 = {"op": "null", "name": "x", "inputs": []}
+    node1 = {
+        "op": "tvm_op",
+        "name": "add",
+        "inputs": [[0, 0, 0]],
+        "attrs": {"func_name": "myadd", "flatten_data": "1", "num_inputs": "1", "num_outputs": "1"},
+    }
+    shape = (n,)
+    graph = json.dumps(
+        {
+            "nodes": [node0, node1],
+            "arg_nodes": [0],
+            "node_row_ptr": [0, 1, 2],
+            "heads": [[1, 0, 0]],
+            "attrs": {
+                "shape": ["list_shape", [shape, shape]],
+                "dltype": ["list_str", ["float32", "float32"]],
+                "storage_id": ["list_int", [0, 1]],
+            },
+        }
+    )
+
+    mlib = tvm.build(s, [A, B], "rocm", name="myadd")
+    dev = tvm.rocm(0)
+    try:
+        mod = hip_graph_executor.create(graph, mlib, dev)
+    except ValueError:
+        return
+
+    for _ in range(3):
+        a = np.random.uniform(size=(n,)).astype(A.dtype)
+        mod.run(x=a)  # The first run loads the kernels, the second one captures a HIP graph
+        out = mod.get_output(0, tvm.nd.empty((n,)))
+        np.testing.assert_equal(out.numpy(), a + 1)
+
+    # capture / run HIP graph manually
+    mod.capture_hip_graph()
+    a = np.random.uniform(size=(n,)).astype(A.dtype)
+    mod.set_input(x=a)
+    mod.run_hip_graph()
+    out = mod.get_output(0, tvm.nd.empty((n,)))
+    np.testing.assert_equal(out.numpy(), a + 1)
+
+    # rotate between zero copy buffers, each one getting its own cached graph
+    mod.set_hip_graph_cache_size(2)
+    for _ in range(6):
+        a = np.random.uniform(size=(n,)).astype(A.dtype)
+        inp = tvm.nd.array(a, dev)
+        out = tvm.nd.empty((n,), A.dtype, dev)
+        mod.set_input_zero_copy("x", inp)
+        mod.set_output_zero_copy(0, out)
+        mod.run()
+        np.testing.assert_equal(out.numpy(), a + 1)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
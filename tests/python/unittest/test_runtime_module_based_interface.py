@@ -16,6 +16,7 @@
 # under the License.
 import numpy as np
 import os
+import threading
 from tvm import relay, runtime
 from tvm.relay import testing
 import tvm
@@ -688,6 +689,49 @@ def test_num_threads():
         assert reported == hardware_threads or reported == hardware_threads // 2
 
 
+def test_bind_numa_node():
+    assert tvm.runtime.num_numa_nodes() >= 1
+    cpus = tvm.runtime.numa_node_cpus(0)
+    assert len(cpus) >= 1
+    result = {}
+
+    def run():
+        # The thread pool is per thread, so the binding does not leak to the main thread.
+        tvm.runtime.bind_numa_node(0, 1)
+        result["num_threads"] = tvm.runtime.num_threads()
+
+    thread = threading.Thread(target=run)
+    thread.start()
+    thread.join()
+    assert result["num_threads"] == 1
+
+
+@tvm.testing.requires_llvm
+def test_threadpool_wait_policy():
+    n = 1024
+    A = tvm.te.placeholder((n,), name="A")
+    B = tvm.te.compute((n,), lambda i: A[i] * 2.0, name="B")
+    s = tvm.te.create_schedule(B.op)
+    s[B].parallel(B.op.axis[0])
+    f = tvm.build(s, [A, B], "llvm")
+    a = tvm.nd.array(np.random.uniform(size=n).astype("float32"))
+    outputs = {}
+
+    def run(policy):
+        b = tvm.nd.empty((n,), "float32")
+        tvm.runtime.set_threadpool_wait_policy(policy, 1000)
+        tvm.runtime.warm_up_threadpool()
+        for _ in range(4):
+            f(a, b)
+        outputs[policy] = b.numpy()
+
+    for policy in ["yield", "spin", "sleep", "adaptive"]:
+        thread = threading.Thread(target=run, args=(policy,))
+        thread.start()
+        thread.join()
+        np.testing.assert_allclose(outputs[policy], a.numpy() * 2.0)
+
+
 @tvm.testing.requires_llvm
 @tvm.testing.requires_package("torch")
 def test_graph_module_zero_copy():
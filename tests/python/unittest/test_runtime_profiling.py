@@ -92,6 +92,29 @@ def test_vm(target, dev):
     )
 
 
+@pytest.mark.skipif(not profiler_vm.enabled(), reason="VM Profiler not enabled")
+@tvm.testing.skip_if_wheel_test
+@tvm.testing.parametrize_targets
+def test_vm_sampling(target, dev):
+    x = relay.var("x", shape=(relay.Any(), 16), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.nn.relu(x)))
+    exe = relay.vm.compile(mod, target)
+    vm = profiler_vm.VirtualMachineProfiler(exe, dev)
+
+    vm.set_sampling(3)
+    data = np.random.rand(4, 16).astype("float32")
+    for _ in range(7):
+        vm.invoke("main", data)
+    report = vm.sampled_report()
+    assert report.configuration["Sampled calls"].value == 3
+    assert "fused_nn_relu" in str(report)
+    fused = [name for name in read_csv(report)["Name"] if name.startswith("fused")]
+    assert len(fused) == 3
+
+    # The samples are dropped once reported.
+    assert vm.sampled_report().configuration["Sampled calls"].value == 0
+
+
 @tvm.testing.parametrize_targets
 def test_graph_executor(target, dev):
     mod, params = mlp.get_workload(1)
@@ -138,6 +161,25 @@ def test_papi(target, dev):
     assert any([float(x) > 0 for x in csv[metric]])
 
 
+@tvm.testing.requires_cuda
+@pytest.mark.skipif(
+    tvm.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is None,
+    reason="CUPTI profiling not enabled",
+)
+def test_cupti():
+    dev = tvm.cuda()
+    mod, params = mlp.get_workload(1)
+    exe = relay.build(mod, "cuda", params=params)
+    gr = debug_executor.create(exe.get_graph_json(), exe.lib, dev)
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    report = gr.profile(collectors=[tvm.runtime.profiling.CUPTIMetricCollector()], data=data)
+    csv = read_csv(report)
+    assert "achieved_occupancy" in csv.keys()
+    assert any([float(x) > 0 for x in csv["achieved_occupancy"]])
+    assert "DRAM Bandwidth (GB/s)" in csv.keys()
+
+
 @tvm.testing.requires_llvm
 def test_json():
     mod, params = mlp.get_workload(1)
@@ -160,6 +202,26 @@ def test_json():
         assert isinstance(call["Duration (us)"]["microseconds"], float)
 
 
+@tvm.testing.requires_llvm
+def test_chrome_trace():
+    mod, params = mlp.get_workload(1)
+
+    exe = relay.vm.compile(mod, "llvm", params=params)
+    vm = profiler_vm.VirtualMachineProfiler(exe, tvm.cpu())
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    report = vm.profile(
+        data, func_name="main", collectors=[tvm.runtime.profiling.TimelineCollector()]
+    )
+    trace = json.loads(report.chrome_trace())
+    events = [event for event in trace["traceEvents"] if event["ph"] == "X"]
+    assert len(events) == len(report.calls)
+    for event, call in zip(events, report.calls):
+        assert event["name"] == call["Name"]
+        assert event["ts"] == pytest.approx(call["Start (us)"].microseconds)
+        assert event["dur"] >= 0
+
+
 @tvm.testing.requires_llvm
 def test_rpc_vm():
     server = rpc.Server(key="profiling")
@@ -263,5 +325,48 @@ def test_profile_function(target, dev):
     assert report[metric].value > 0
 
 
+def test_memory_report():
+    def cpu_row(report, name):
+        rows = [c for c in report.calls if c["Name"] == name and c["Device"] == "cpu0"]
+        return rows[0] if rows else None
+
+    tvm.runtime.profiling.set_memory_tracing(True)
+    before = cpu_row(tvm.runtime.profiling.memory_report(), "ndarray")
+    before_bytes = before["Current (bytes)"].value if before else 0
+    tvm.runtime.profiling.reset_memory_peak()
+
+    a = tvm.nd.empty((1024,), "float32")
+    report = tvm.runtime.profiling.memory_report()
+    assert cpu_row(report, "ndarray")["Current (bytes)"].value == before_bytes + 4096
+    assert cpu_row(report, "ndarray")["Peak (bytes)"].value >= before_bytes + 4096
+    live = cpu_row(report, "live ndarray")
+    assert live is not None and len(live["Stack"]) > 0
+    assert "Peak (bytes)" in report.device_metrics["cpu0"]
+
+    del a
+    report = tvm.runtime.profiling.memory_report()
+    assert cpu_row(report, "ndarray")["Current (bytes)"].value == before_bytes
+    assert cpu_row(report, "ndarray")["Peak (bytes)"].value >= before_bytes + 4096
+    tvm.runtime.profiling.set_memory_tracing(False)
+    assert "Name" in report.table(sort=False)
+
+
+def test_tracepoints():
+    tvm.runtime.profiling.enable_tracepoints(4)
+    a = tvm.nd.array(np.ones((16,), "float32"))
+    for _ in range(4):
+        a.copyto(tvm.cpu())
+    tvm.runtime.profiling.disable_tracepoints()
+    tvm.nd.empty((16,), "float32")
+
+    events = json.loads(tvm.runtime.profiling.dump_tracepoints())["traceEvents"]
+    # The buffer only keeps the last 4 records, all made before disabling.
+    assert len(events) == 4
+    assert all(e["ph"] == "i" for e in events)
+    assert [e["ts"] for e in events] == sorted(e["ts"] for e in events)
+    copies = [e for e in events if e["name"] == "Copy"]
+    assert copies and all(e["args"]["a0"] == 64 for e in copies)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -109,6 +109,35 @@ def test_rpc_simple():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_async_call():
+    server = rpc.Server(key="x1")
+    client = rpc.connect("127.0.0.1", server.port, key="x1")
+
+    def check_remote():
+        f1 = client.get_function("rpc.test.addone")
+        f2 = client.get_function("rpc.test.strcat")
+        f3 = client.get_function("rpc.test.except")
+        futures = [client.async_call(f1, i) for i in range(40)]
+        error = client.async_call(f3, "abc")
+        last = client.async_call(f2, "abc", 11)
+        # the synchronous calls are ordered after the pending ones
+        assert f1(100) == 101
+        assert [future.result() for future in futures] == list(range(1, 41))
+        with pytest.raises(tvm._ffi.base.TVMError):
+            error.result()
+        assert last.result() == "abc:11"
+
+        future = client.async_call(f1, 1)
+        client.wait_pending_calls()
+        assert future.result() == 2
+
+        with pytest.raises(ValueError):
+            client.async_call(tvm.get_global_func("testing.echo"), 1)
+
+    check_remote()
+
+
 @tvm.testing.requires_rpc
 def test_rpc_simple_wlog():
     server = rpc.Server(key="x1")
@@ -176,6 +205,25 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_blocked_copy():
+    # the copies are split into pipelined blocks, check that they are put back in order
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+
+    def check_remote():
+        dev = remote.cpu(0)
+        # not a multiple of the copy block size
+        a_np = np.random.uniform(size=(3 * 1024 * 1024 + 17,)).astype("float32")
+        a = tvm.nd.array(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+        b = tvm.nd.empty(a_np.shape, "float32", dev)
+        b.copyfrom(a_np[::-1].copy())
+        np.testing.assert_equal(b.numpy(), a_np[::-1])
+
+    check_remote()
+
+
 @tvm.testing.skip_if_32bit(reason="skipping test for i386.")
 @tvm.testing.requires_rpc
 def test_rpc_echo():
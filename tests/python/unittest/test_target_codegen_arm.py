@@ -16,6 +16,7 @@
 # under the License.
 import tvm
 from tvm import te
+from tvm.script import tir as T
 import re
 import os
 import ctypes
@@ -98,6 +99,46 @@ def test_vmlal_s16():
     check_broadcast_correct_assembly(64)
 
 
+def test_sve_fixed_length_vectors():
+    target = (
+        "llvm -mtriple=aarch64-linux-gnu -mattr=+v8.6a,+sve "
+        "-cl-opt=aarch64-sve-vector-bits-min:uint=256"
+    )
+    A = te.placeholder((64,), dtype="float32", name="A")
+    B = te.placeholder((64,), dtype="float32", name="B")
+    C = te.compute(A.shape, lambda i: A[i] + B[i], name="C")
+    s = te.create_schedule(C.op)
+    _, xi = s[C].split(C.op.axis[0], factor=8)
+    s[C].vectorize(xi)
+    f = tvm.build(s, [A, B, C], target)
+
+    # The 256-bit vectors are lowered onto the SVE registers
+    assembly = f.get_source("asm")
+    assert re.findall(r"fadd\s+z[0-9]+\.s", assembly)
+
+
+def test_sve_scalable_loop_vectorization():
+    target = "llvm -mtriple=aarch64-linux-gnu -mattr=+v8.6a,+sve"
+
+    @T.prim_func
+    def func(a: T.handle, b: T.handle, c: T.handle):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        n = T.int32()
+        A = T.match_buffer(a, (n,), "float32")
+        B = T.match_buffer(b, (n,), "float32")
+        C = T.match_buffer(c, (n,), "float32")
+        for i in T.serial(n, annotations={"llvm_loop_vectorize_scalable": True}):
+            C[i] = A[i] * B[i]
+
+    f = tvm.build(func, target=target)
+
+    # The loop of unknown extent is vectorized with scalable vectors
+    assembly = f.get_source("asm")
+    assert re.findall(r"fmul\s+z[0-9]+\.s", assembly)
+
+
 if __name__ == "__main__":
     test_popcount()
     test_vmlal_s16()
+    test_sve_fixed_length_vectors()
+    test_sve_scalable_loop_vectorization()
@@ -15,10 +15,12 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import os
 import re
 
 import tvm
 from tvm import te
+from tvm.contrib import utils
 import numpy as np
 from tvm import topi
 from tvm.contrib.nvcc import have_fp16, have_int8, have_bf16
@@ -1044,5 +1046,129 @@ def test_try_unaligned_vector_load():
     assert np.allclose(c, expected), f"expected={expected}\nactual={c}"
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda_compute_version(8, 9)
+@pytest.mark.parametrize("dtype", ["e4m3_float8", "e5m2_float8"])
+def test_cuda_fp8_add(dtype):
+    n = 64
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.placeholder((n,), name="B", dtype="float32")
+    A8 = te.compute((n,), lambda i: A[i].astype(dtype), name="A8")
+    B8 = te.compute((n,), lambda i: B[i].astype(dtype), name="B8")
+    C8 = te.compute((n,), lambda i: A8[i] + B8[i], name="C8")
+    C = te.compute((n,), lambda i: C8[i].astype("float32"), name="C")
+    s = te.create_schedule(C.op)
+    for stage in [A8, B8, C8]:
+        s[stage].compute_inline()
+    xo, xi = s[C].split(C.op.axis[0], factor=32)
+    s[C].bind(xo, bx)
+    s[C].bind(xi, tx)
+
+    tgt = tvm.target.Target(target="cuda", host="llvm")
+    dev = tvm.device(tgt.kind.name, 0)
+    f = tvm.build(s, [A, B, C], tgt, name="fp8_add")
+    assert "cuda_fp8.h" in f.imported_modules[0].get_source()
+
+    # Small integers and their sums are exact in both fp8 formats
+    a_np = np.random.randint(-4, 4, size=n).astype("float32")
+    b_np = np.random.randint(-4, 4, size=n).astype("float32")
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(b_np, dev)
+    c = tvm.nd.array(np.zeros(n, dtype="float32"), dev)
+    f(a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a_np + b_np)
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_compile_cache():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda i: A[i] + B[i], name="C")
+    s = te.create_schedule(C.op)
+    xo, xi = s[C].split(C.op.axis[0], factor=64)
+    s[C].bind(xo, bx)
+    s[C].bind(xi, tx)
+
+    temp = utils.tempdir()
+    cache_dir = temp.relpath("cache")
+    with tvm.transform.PassContext(config={"codegen.cuda.cache_dir": cache_dir}):
+        tvm.build(s, [A, B, C], "cuda", name="vadd")
+        cached = sorted(os.listdir(cache_dir))
+        # The source with its compile context, and the compiled binary.
+        assert len(cached) == 2
+        # The second build reuses the compiled binary.
+        f = tvm.build(s, [A, B, C], "cuda", name="vadd")
+    assert sorted(os.listdir(cache_dir)) == cached
+
+    dev = tvm.cuda(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.random.uniform(size=n).astype(B.dtype), dev)
+    c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+    f(a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_pageable_copy():
+    # Large enough to be staged in pinned memory in several chunks
+    n = 5 * 1024 * 1024 + 3
+    x = tvm.nd.array(np.random.uniform(size=n).astype("float32"))
+    x_np = x.numpy()
+    a = x.copyto(tvm.cuda(0))
+    # The source can be reused as soon as the copy returns
+    x.copyfrom(x_np + 1)
+    b = x.copyto(tvm.cuda(0))
+    tvm.testing.assert_allclose(a.numpy(), x_np)
+    tvm.testing.assert_allclose(b.numpy(), x_np + 1)
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_workspace_multi_stream():
+    import threading
+
+    n = 1 << 20
+    A = te.placeholder((n,), name="A")
+    # B is not inlined, so that it lives in a workspace allocated by the host function
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    C = te.compute((n,), lambda i: B[i] * 2.0, name="C")
+    s = te.create_schedule(C.op)
+    for stage in [B, C]:
+        xo, xi = s[stage].split(stage.op.axis[0], factor=256)
+        s[stage].bind(xo, te.thread_axis("blockIdx.x"))
+        s[stage].bind(xi, te.thread_axis("threadIdx.x"))
+    f = tvm.build(s, [A, C], "cuda")
+
+    dev = tvm.cuda(0)
+    errors = []
+
+    def _run(seed):
+        stream = dev.create_raw_stream()
+        dev.set_raw_stream(stream)
+        try:
+            for i in range(10):
+                a_np = np.full(n, seed * 100 + i, dtype="float32")
+                a = tvm.nd.array(a_np, dev)
+                c = tvm.nd.empty((n,), "float32", dev)
+                f(a, c)
+                dev.sync(stream)
+                tvm.testing.assert_allclose(c.numpy(), (a_np + 1.0) * 2.0)
+        except Exception as err:  # pylint: disable=broad-except
+            errors.append(err)
+        finally:
+            dev.set_raw_stream(None)
+            dev.free_raw_stream(stream)
+
+    threads = [threading.Thread(target=_run, args=(seed,)) for seed in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert not errors, errors
+
+
 if __name__ == "__main__":
     tvm.testing.main()
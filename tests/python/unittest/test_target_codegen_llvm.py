@@ -19,6 +19,7 @@ import ctypes
 import json
 import math
 import numpy as np
+import os
 import pytest
 import re
 import sys
@@ -288,6 +289,64 @@ def test_multiple_func():
     check_llvm()
 
 
+@tvm.testing.requires_llvm
+def test_multiple_func_partitioned():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    s = te.create_schedule(C.op)
+    funcs = [tvm.lower(s, [A, B, C], name=f"fadd{i}") for i in range(4)]
+    with tvm.transform.PassContext(config={"codegen.llvm.num_partitions": 3}):
+        m = tvm.build(funcs, "llvm")
+    assert len(m.imported_modules) == 2
+
+    temp = utils.tempdir()
+    path = temp.relpath("lib.so")
+    m.export_library(path)
+    loaded = tvm.runtime.load_module(path)
+
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.random.uniform(size=n).astype(B.dtype), dev)
+    for mod in [m, loaded]:
+        for i in range(4):
+            c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+            mod[f"fadd{i}"](a, b, c)
+            tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+
+
+@tvm.testing.requires_llvm
+def test_llvm_codegen_cache():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    D = te.compute(A.shape, lambda *i: A(*i) * B(*i), name="D")
+    fadd = tvm.lower(te.create_schedule(C.op), [A, B, C], name="fadd")
+    fmul = tvm.lower(te.create_schedule(D.op), [A, B, D], name="fmul")
+
+    temp = utils.tempdir()
+    cache_dir = temp.relpath("cache")
+    with tvm.transform.PassContext(config={"codegen.llvm.cache_dir": cache_dir}):
+        tvm.build([fadd], "llvm")
+        cached = sorted(os.listdir(cache_dir))
+        assert len(cached) == 2
+        # The second build reuses the bitcode of fadd and only compiles fmul.
+        m = tvm.build([fadd, fmul], "llvm")
+    assert set(cached) < set(os.listdir(cache_dir))
+    assert len(os.listdir(cache_dir)) == 4
+
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.random.uniform(size=n).astype(B.dtype), dev)
+    c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+    m["fadd"](a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+    m["fmul"](a, b, c)
+    tvm.testing.assert_allclose(c.numpy(), a.numpy() * b.numpy())
+
+
 @tvm.testing.requires_llvm
 def test_llvm_condition():
     def check_llvm(n, offset):
@@ -660,6 +719,28 @@ def test_dwarf_debug_information():
     check_llvm_ir()
 
 
+@tvm.testing.requires_llvm
+def test_llvm_wasm_simd128():
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda i: A[i] + B[i], name="C")
+    s = te.create_schedule(C.op)
+    _, xi = s[C].split(C.op.axis[0], factor=4)
+    s[C].vectorize(xi)
+    target = "llvm -mtriple=wasm32-unknown-unknown-wasm"
+    try:
+        m = tvm.build(s, [A, B, C], target)
+    except tvm.TVMError:
+        pytest.skip("LLVM is built without the WebAssembly target")
+    ll = m.get_source("ll")
+    assert "+simd128" in ll
+    assert "<4 x float>" in ll
+    # SIMD128 can be turned off explicitly.
+    m = tvm.build(s, [A, B, C], target + " -mattr=-simd128")
+    assert "+simd128" not in m.get_source("ll")
+
+
 @tvm.testing.requires_llvm
 def test_llvm_shuffle():
     a = te.placeholder((8,), "int32")
@@ -1002,6 +1083,79 @@ def test_llvm_assume():
     m = tvm.build(mod, [inp, out], target="llvm")
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("jit", ["orcjit", "mcjit"])
+def test_llvm_jit_engine(jit):
+    if jit == "orcjit" and tvm.target.codegen.llvm_version_major() < 13:
+        pytest.skip("ORC JIT requires LLVM 13+")
+
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def add_one(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            for i in range(16):
+                B[i] = A[i] + T.float32(1)
+
+        @T.prim_func
+        def never_called(A: T.Buffer((16,), "float32")):
+            for i in range(16):
+                A[i] = T.float32(0)
+
+    f = tvm.build(Module, target=f"llvm -jit={jit}")
+    a = tvm.nd.array(np.arange(16, dtype="float32"))
+    b = tvm.nd.empty((16,), "float32")
+    f["add_one"](a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1)
+
+
+@tvm.testing.requires_llvm
+def test_llvm_loop_and_alias_metadata():
+    """Check the loop annotations and the noalias buffers are passed to LLVM as metadata"""
+
+    @T.prim_func
+    def func(A: T.Buffer((1024,), "float32"), B: T.Buffer((1024,), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i in T.serial(
+            1024,
+            annotations={
+                "llvm_loop_vectorize_width": 8,
+                "llvm_loop_unroll_count": 2,
+                "llvm_loop_prefetch_distance": 64,
+            },
+        ):
+            B[i] = A[i] * T.float32(2)
+
+    ll = tvm.build(func, target="llvm").get_source("ll")
+    # The loop properties are consumed by the loop passes, which mark the loop they transformed
+    assert "!llvm.loop" in ll
+    assert "llvm.prefetch" in ll
+    assert "!alias.scope" in ll and "!noalias" in ll
+
+
+@tvm.testing.requires_llvm
+def test_llvm_loop_prefetch_gather():
+    """Check the gathered rows are prefetched from the offsets loaded ahead"""
+
+    @T.prim_func
+    def func(
+        table: T.Buffer((65536,), "float32"),
+        idx: T.Buffer((256,), "int32"),
+        out: T.Buffer((16384,), "float32"),
+    ):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i in T.serial(256, annotations={"llvm_loop_prefetch_distance": 8}):
+            for j in T.serial(64):
+                out[i * 64 + j] = table[idx[i] * 64 + j]
+
+    f = tvm.build(func, target="llvm")
+    assert "llvm.prefetch" in f.get_source("ll")
+    table = np.random.uniform(size=(1024, 64)).astype("float32")
+    idx = np.random.randint(0, 1024, size=(256,)).astype("int32")
+    out = tvm.nd.empty((16384,), "float32")
+    f(tvm.nd.array(table.reshape(-1)), tvm.nd.array(idx), out)
+    tvm.testing.assert_allclose(out.numpy(), table[idx].reshape(-1))
+
+
 @tvm.testing.requires_llvm
 def test_debug_symbol_for_float64():
     """Check that LLVM can define DWARF debug type for float64
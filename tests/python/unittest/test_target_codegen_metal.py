@@ -149,6 +149,85 @@ def test_select_vectorize():
     np.testing.assert_allclose(b_nd.numpy(), a, atol=1e-5, rtol=1e-5)
 
 
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_metal
+def test_batched_launches():
+    n = 256
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=64)
+    s[B].bind(xo, te.thread_axis("blockIdx.x"))
+    s[B].bind(xi, te.thread_axis("threadIdx.x"))
+    f = tvm.build(s, [A, B], "metal")
+
+    dev = tvm.metal()
+    a_np = np.random.uniform(size=n).astype("float32")
+    bufs = [tvm.nd.array(a_np, dev), tvm.nd.empty((n,), "float32", dev)]
+    # More launches than fit in one command buffer, each one reading the result of the previous
+    num_launches = 150
+    for i in range(num_launches):
+        f(bufs[i % 2], bufs[(i + 1) % 2])
+    tvm.testing.assert_allclose(bufs[num_launches % 2].numpy(), a_np + num_launches)
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_metal
+def test_simdgroup_matmul():
+    M, N, K = 16, 16, 32
+    A = te.placeholder((M, K), name="A", dtype="float16")
+    B = te.placeholder((K, N), name="B", dtype="float16")
+    k = te.reduce_axis((0, K), name="k")
+    C = te.compute(
+        (M, N),
+        lambda i, j: te.sum(A[i, k].astype("float32") * B[k, j].astype("float32"), axis=k),
+        name="C",
+    )
+    sch = tvm.tir.Schedule(te.create_prim_func([A, B, C]))
+    block = sch.get_block("C")
+
+    # Every threadgroup computes an 8x8 tile of C with one simdgroup
+    i, j, k = sch.get_loops(block)
+    i_outer, i_inner = sch.split(i, factors=[None, 8])
+    j_outer, j_inner = sch.split(j, factors=[None, 8])
+    k_outer, k_inner = sch.split(k, factors=[None, 8])
+    sch.reorder(i_outer, j_outer, k_outer, i_inner, j_inner, k_inner)
+    fused_outer = sch.fuse(i_outer, j_outer)
+    sch.bind(fused_outer, "blockIdx.x")
+
+    for idx in range(2):
+        block_read = sch.cache_read(block, idx, "shared")
+        sch.compute_at(block_read, k_outer)
+        fused = sch.fuse(*sch.get_loops(block_read)[-2:])
+        _, thread = sch.split(fused, factors=[None, 32])
+        sch.bind(thread, "threadIdx.x")
+
+    A_mat = sch.cache_read(block, 0, "wmma.matrix_a")
+    B_mat = sch.cache_read(block, 1, "wmma.matrix_b")
+    sch.tensorize(sch.get_loops(A_mat)[-2], "simdgroup_load_8x8x8_f16_a_shared")
+    sch.tensorize(sch.get_loops(B_mat)[-2], "simdgroup_load_8x8x8_f16_b_shared")
+
+    store = sch.cache_write(block, 0, "wmma.accumulator")
+    sch.reverse_compute_at(store, fused_outer)
+    init = sch.decompose_reduction(block, sch.get_loops(block)[1])
+    sch.tensorize(sch.get_loops(init)[1], "simdgroup_fill_8x8x8_f32")
+    sch.tensorize(sch.get_loops(store)[1], "simdgroup_store_8x8x8_f32_global")
+    sch.tensorize(sch.get_loops(block)[2], "simdgroup_sync_8x8x8_f16f16f32")
+
+    f = tvm.build(sch.mod, target="metal")
+    assert "simdgroup_multiply_accumulate" in f.imported_modules[0].get_source()
+
+    dev = tvm.metal()
+    a_np = np.random.uniform(size=(M, K)).astype("float16")
+    b_np = np.random.uniform(size=(K, N)).astype("float16")
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(b_np, dev)
+    c = tvm.nd.array(np.zeros((M, N), dtype="float32"), dev)
+    f(a, b, c)
+    ref = np.dot(a_np.astype("float32"), b_np.astype("float32"))
+    tvm.testing.assert_allclose(c.numpy(), ref, rtol=1e-2, atol=1e-2)
+
+
 if __name__ == "__main__":
     test_ramp()
     test_metal_inf_nan()
@@ -14,9 +14,12 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import os
+import numpy as np
 import tvm
 from tvm import te
 import tvm.testing
+from tvm.contrib import utils
 import re
 
 target = "opencl"
@@ -198,5 +201,33 @@ def test_opencl_type_casting():
     # check_type_casting(dev, 16, "float16")
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_opencl
+def test_opencl_program_cache():
+    n = 16
+    A = te.placeholder((n,), name="A")
+    C = te.compute((n,), lambda i: A[i] + 1.0, name="C")
+    s = te.create_schedule(C.op)
+    s[C].bind(s[C].op.axis[0], te.thread_axis("threadIdx.x"))
+
+    temp = utils.tempdir()
+    cache_dir = temp.relpath("cache")
+    set_cache_dir = tvm.get_global_func("runtime.opencl.SetProgramCacheDir")
+    set_cache_dir(cache_dir)
+    try:
+        dev = tvm.device(target, 0)
+        a = tvm.nd.array(np.arange(n, dtype=A.dtype), dev)
+        c = tvm.nd.empty((n,), C.dtype, dev)
+        # The first build stores the binary, and the second one loads it.
+        for _ in range(2):
+            fun = tvm.build(s, [A, C], target)
+            fun(a, c)
+            tvm.testing.assert_allclose(c.numpy(), a.numpy() + 1.0)
+            entries = [f for f in os.listdir(cache_dir) if f.endswith(".clbin")]
+            assert len(entries) == 1
+    finally:
+        set_cache_dir("")
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -100,6 +100,16 @@ def test_array_copy(dev, dtype, fuzz_seed):
     tvm.testing.assert_allclose(a_np, a.numpy())
 
 
+@tvm.testing.parametrize_targets("vulkan")
+def test_vulkan_pipelined_upload(target, dev):
+    # More uploads than command buffers in flight, none of which waits on the host
+    arr_size = 1024
+    arrays_np = [np.random.uniform(size=(arr_size,)).astype("float32") + i for i in range(8)]
+    arrays = [tvm.nd.array(a_np, dev) for a_np in arrays_np]
+    for a_np, a in zip(arrays_np, arrays):
+        tvm.testing.assert_allclose(a_np, a.numpy())
+
+
 @tvm.testing.exclude_targets("llvm")
 def test_array_vectorize_add(target, dev, dtype):
     arr_size = 64
@@ -710,7 +720,9 @@ def test_cooperative_matrix(out_dtype):
     target = "vulkan -from_device=0"
     tgt_attrs = tvm.target.Target(target).attrs
 
-    if tgt_attrs.get("supports_cooperative_matrix"):
+    if tgt_attrs.get("supports_cooperative_matrix") or tgt_attrs.get(
+        "supports_khr_cooperative_matrix"
+    ):
         f = tvm.build(sch.mod, target=target)
 
         dev = tvm.device(target, 0)
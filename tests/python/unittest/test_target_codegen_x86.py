@@ -107,5 +107,32 @@ def test_fp16_fp32_conversions(feature_string):
     np.testing.assert_allclose(out.asnumpy(), expected, rtol=1e-3)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.skipif(llvm_version < 10, reason=f"Requires LLVM 10+, got {llvm_version}")
+def test_avx512bf16_dot_product():
+    from tvm.tir.tensor_intrin.x86 import AVX512BF16_DOT_16x2_INTRIN
+
+    X = te.placeholder((32, 64), name="X", dtype="bfloat16")
+    W = te.placeholder((32, 64), name="W", dtype="bfloat16")
+    k = te.reduce_axis((0, 64), name="k")
+    C = te.compute(
+        (32, 32),
+        lambda i, j: te.sum(X[i, k].astype("float32") * W[j, k].astype("float32"), axis=k),
+        name="compute",
+    )
+    sch = tvm.tir.Schedule(te.create_prim_func([X, W, C]))
+    block = sch.get_block("compute")
+    sch.transform_layout(block, "W", lambda i, j: [i // 16, j // 2, i % 16, j % 2])
+    _, j, k = sch.get_loops(block)
+    _, ji = sch.split(j, factors=[None, 16])
+    ko, ki = sch.split(k, factors=[None, 2])
+    sch.reorder(ko, ji, ki)
+    sch.decompose_reduction(block, ko)
+    sch.tensorize(ji, AVX512BF16_DOT_16x2_INTRIN)
+
+    f = tvm.build(sch.mod, target="llvm -mcpu=cooperlake")
+    assert re.search("vdpbf16ps", f.get_source("asm"))
+
+
 if __name__ == "__main__":
     test_fp16_to_fp32()
@@ -28,7 +28,11 @@ from tvm.tir.tensor_intrin.arm_cpu import (
     ARM_DOT_4x4_i8_SDOT_INTRIN,
 )
 from tvm.tir.tensor_intrin.rocm import AMDGPU_SDOT4_INTRIN
-from tvm.tir.tensor_intrin.x86 import VNNI_DOT_16x4_INTRIN, AVX512_DOT_16x4_INTRIN
+from tvm.tir.tensor_intrin.x86 import (
+    VNNI_DOT_16x4_INTRIN,
+    AVX512_DOT_16x4_INTRIN,
+    AVX512BF16_DOT_16x2_INTRIN,
+)
 from tvm.tir.tensor_intrin.hexagon import VRMPY_u8u8i32_INTRIN, VDMPY_i16i16i32_INTRIN
 
 # fmt: off
@@ -623,6 +627,41 @@ def test_tensorize_avx512():
     tensorize_16x4_test(AVX512_DOT_16x4_INTRIN)
 
 
+def get_matmul_bf16_packed(m, n, k):
+    X = te.placeholder((m, k), name="X", dtype="bfloat16")
+    W = te.placeholder((n, k), name="W", dtype="bfloat16")
+
+    ak = te.reduce_axis((0, k), name="k")
+    matmul = te.compute(
+        (m, n),
+        lambda i, j: te.sum(
+            X[i, ak].astype("float32") * W[j, ak].astype("float32"),
+            axis=ak,
+        ),
+        name="compute",
+    )
+
+    return te.create_prim_func([X, W, matmul])
+
+
+def test_tensorize_avx512bf16():
+    func = get_matmul_bf16_packed(128, 128, 128)
+
+    sch = tir.Schedule(func, debug_mask="all")
+    block = sch.get_block("compute")
+    sch.transform_layout(block, "W", lambda i, j: [i//16, j//2, i%16, j%2])
+    _, j, k = sch.get_loops(block)
+
+    _, ji = sch.split(j, factors=[None, 16])
+    ko, ki = sch.split(k, factors=[None, 2])
+    sch.reorder(ko, ji, ki)
+
+    sch.decompose_reduction(block, ko)
+    sch.tensorize(ji, AVX512BF16_DOT_16x2_INTRIN)
+
+    verify_trace_roundtrip(sch=sch, mod=func)
+
+
 def test_tensorize_arm_dot():
     m, n, k = 128, 128, 128
 
@@ -419,5 +419,57 @@ def test_ir_module_equal():
     assert '<root>.functions[I.GlobalVar("func")].body.extent.value' in err.value.args[0]
 
 
+def test_structural_hash_cache():
+    @I.ir_module
+    class module:
+        @T.prim_func
+        def func(A: T.Buffer(1, "int32")):
+            A[0] = A[0] + 1
+
+    @T.prim_func
+    def other(A: T.Buffer(1, "int32")):
+        A[0] = A[0] + 2
+
+    expected = tvm.ir.structural_hash(module)
+    tvm.ir.configure_structural_hash_cache(16)
+    try:
+        assert tvm.ir.structural_hash(module) == expected
+        assert tvm.ir.structural_hash(module) == expected
+        # Updating the module in place must not reuse the memoized hash
+        module.update_func(module.get_global_var("func"), other)
+        cached = tvm.ir.structural_hash(module)
+        tvm.ir.configure_structural_hash_cache(0)
+        assert cached == tvm.ir.structural_hash(module)
+        assert cached != expected
+    finally:
+        tvm.ir.configure_structural_hash_cache(0)
+
+
+def test_structural_equal_with_cached_hash():
+    def generate(n: int):
+        @I.ir_module
+        class module:
+            @T.prim_func
+            def func(A: T.Buffer(1, "int32")):
+                for i in range(n):
+                    A[0] = A[0] + 1
+
+        return module
+
+    mod_16, mod_16_copy, mod_32 = generate(16), generate(16), generate(32)
+    tvm.ir.configure_structural_hash_cache(16)
+    try:
+        for mod in [mod_16, mod_16_copy, mod_32]:
+            tvm.ir.structural_hash(mod)
+        assert tvm.ir.structural_equal(mod_16, mod_16)
+        assert tvm.ir.structural_equal(mod_16, mod_16_copy)
+        assert not tvm.ir.structural_equal(mod_16, mod_32)
+        # The mismatch is still reported in assert mode
+        with pytest.raises(ValueError):
+            tvm.ir.assert_structural_equal(mod_16, mod_32)
+    finally:
+        tvm.ir.configure_structural_hash_cache(0)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
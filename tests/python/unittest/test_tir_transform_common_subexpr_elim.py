@@ -398,6 +398,45 @@ def test_semantic_equiv_associativity():
     _check(func_associativity, func_associativity_expected)
 
 
+# -----------------------------------------------------
+# Test that verifies the reuse of the variables of the context
+# -----------------------------------------------------
+def test_cse_reuse_context_var_in_scope():
+    """Values already bound by an enclosing let are reused, but only within the scope of the let
+
+    The program
+
+        let y = x + 1 in (let z = x + 1 in z)
+        (x + 1) + (x + 1)
+
+    becomes
+
+        let y = x + 1 in (let z = y in z)
+        let cse_var_1 = x + 1 in cse_var_1 + cse_var_1
+    """
+    x = te.var("x")
+    y = te.var("y")
+    z = te.var("z")
+    first = tvm.tir.LetStmt(y, x + 1, tvm.tir.LetStmt(z, x + 1, tvm.tir.Evaluate(z)))
+    second = tvm.tir.Evaluate((x + 1) + (x + 1))
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([x], tvm.tir.SeqStmt([first, second])))
+    body = tvm.tir.transform.CommonSubexprElimTIR()(mod)["main"].body
+
+    assert isinstance(body, tvm.tir.SeqStmt)
+    # The inner let reuses the outer variable
+    assert body[0].var.same_as(y)
+    assert body[0].body.value.same_as(y)
+    # Out of the scope of the outer let, a new variable is introduced instead
+    assert isinstance(body[1], tvm.tir.LetStmt)
+    assert body[1].var.name == "cse_var_1"
+    tvm.ir.assert_structural_equal(body[1].value, x + 1)
+    used_vars = []
+    tvm.tir.stmt_functor.post_order_visit(
+        body[1], lambda node: used_vars.append(node) if isinstance(node, tvm.tir.Var) else None
+    )
+    assert not any(var.same_as(y) for var in used_vars)
+
+
 # -----------------------------------------------------
 # Tests that verify the determinism of the pass
 # -----------------------------------------------------
@@ -502,6 +541,8 @@ if __name__ == "__main__":
     # Tests that turn on the equivalence of terms and verify the commoning with equivalences:
     test_semantic_equiv_distributivity()
     test_semantic_equiv_associativity()
+    # Test that verifies the reuse of the variables of the context:
+    test_cse_reuse_context_var_in_scope()
     # Tests that verify the determinism of the pass:
     test_deterministic_cse()
     test_deterministic_cse_2()
@@ -0,0 +1,75 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import pytest
+
+import tvm
+import tvm.script
+import tvm.testing
+from tvm.script import tir as T
+
+dtype = tvm.testing.parameter("e4m3_float8", "e5m2_float8")
+promote_dtype = tvm.testing.parameter("float16", "float32")
+
+
+def get_before(dtype: str):
+    @tvm.script.ir_module
+    class Before:
+        @T.prim_func
+        def main(Aptr: T.handle(dtype), Bptr: T.handle(dtype), Dptr: T.handle(dtype)):
+            T.func_attr({"global_symbol": "main"})
+            A = T.decl_buffer((100,), dtype, data=Aptr)
+            B = T.decl_buffer((100,), dtype, data=Bptr)
+            D = T.decl_buffer((100,), dtype, data=Dptr)
+            C = T.decl_buffer((100,), dtype)
+            for i in T.grid(100):
+                C[i] = A[i] + B[i]
+                D[i] = T.exp(C[i])
+
+    return Before
+
+
+def get_after_compute_legalize(dtype: str, promote_dtype: str):
+    @tvm.script.ir_module
+    class After:
+        @T.prim_func
+        def main(Aptr: T.handle(dtype), Bptr: T.handle(dtype), Dptr: T.handle(dtype)):
+            T.func_attr({"global_symbol": "main"})
+            A = T.decl_buffer((100,), dtype, data=Aptr)
+            B = T.decl_buffer((100,), dtype, data=Bptr)
+            D = T.decl_buffer((100,), dtype, data=Dptr)
+            C = T.decl_buffer((100,), dtype)
+            for i in T.grid(100):
+                C[i] = T.Cast(dtype, T.Cast(promote_dtype, A[i]) + T.Cast(promote_dtype, B[i]))
+                D[i] = T.Cast(dtype, T.exp(T.Cast(promote_dtype, C[i])))
+
+    return After
+
+
+def test_fp8_compute_legalize(dtype, promote_dtype):
+    before = get_before(dtype)
+    expected = get_after_compute_legalize(dtype, promote_dtype)
+    after = tvm.tir.transform.FP8ComputeLegalize(promote_dtype)(before)
+    tvm.ir.assert_structural_equal(after, expected)
+
+
+def test_fp8_compute_legalize_invalid_promote_dtype():
+    with pytest.raises(tvm.TVMError):
+        tvm.tir.transform.FP8ComputeLegalize("int32")(get_before("e4m3_float8"))
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
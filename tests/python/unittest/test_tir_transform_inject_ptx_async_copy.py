@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 import numpy as np
+import pytest
 import tvm
 import tvm.testing
 from tvm.script import tir as T
@@ -118,6 +119,51 @@ def ptx_global_to_shared_dyn_copy_fp16x8(
             C[tx, i] = A_shared[tx, i] + B_shared[tx, i]
 
 
+@T.prim_func
+def ptx_global_to_shared_dyn_bulk_copy_fp16(
+    A: T.Buffer((32, 128), "float16"), B: T.Buffer((32, 128), "float16")
+) -> None:
+    T.func_attr({"global_symbol": "main", "tir.noalias": True})
+    bx = T.env_thread("blockIdx.x")
+    tx = T.env_thread("threadIdx.x")
+    T.launch_thread(bx, 1)
+    T.launch_thread(tx, 32)
+    with T.block():
+        A_shared = T.alloc_buffer([32, 128], "float16", scope="shared.dyn")
+        T.reads(A[0:32, 0:128])
+        T.writes(B[0:32, 0:128])
+
+        T.attr("default", "async_scope", 1)
+        for i in T.serial(128):
+            A_shared[tx, i] = A[tx, i]
+
+        T.evaluate(T.ptx_commit_group(dtype=""))
+        T.evaluate(T.ptx_wait_group(0, dtype=""))
+
+        for i in range(128):
+            B[tx, i] = A_shared[tx, i]
+
+
+@pytest.mark.parametrize("arch, num_bulk_copies", [("sm_90", 1), ("sm_80", 0)])
+def test_inject_async_bulk_copy(arch, num_bulk_copies):
+    f = ptx_global_to_shared_dyn_bulk_copy_fp16
+    f = f.with_attr("target", tvm.target.Target("cuda -arch=" + arch))
+    mod = tvm.IRModule.from_expr(f)
+    mod = tvm.tir.transform.LowerOpaqueBlock()(mod)
+    mod = tvm.tir.transform.FlattenBuffer()(mod)
+    mod = tvm.tir.transform.InjectPTXAsyncCopy()(mod)
+
+    calls = []
+    tvm.tir.stmt_functor.post_order_visit(
+        mod["main"].body,
+        lambda n: calls.append(n.op.name) if isinstance(n, tvm.tir.Call) else None,
+    )
+    # Each thread copies a row of 256 bytes, signaling its own barrier.
+    assert calls.count("tir.ptx_cp_async_bulk") == num_bulk_copies
+    assert calls.count("tir.create_barriers") == num_bulk_copies
+    assert calls.count("tir.ptx_wait_barrier") == num_bulk_copies
+
+
 @tvm.testing.requires_cuda
 def test_inject_async_copy():
     for dtype, vec_size in [("float16", 8), ("float16", 4), ("float32", 4), ("float32", 1)]:
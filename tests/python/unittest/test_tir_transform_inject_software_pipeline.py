@@ -1063,6 +1063,93 @@ def test_simple_compute():
     _check(gen_simple_compute(1), transformed_simple_compute)
 
 
+def gen_simple_compute_auto_pipeline(max_stages, shared_memory_bytes):
+    @T.prim_func
+    def simple_compute(A: T.Buffer((16, 16), "float32"), C: T.Buffer((16, 16), "float32")):
+        for tx in T.thread_binding(0, 16, thread="threadIdx.x"):
+            for i in T.serial(
+                0,
+                16,
+                annotations={
+                    "software_pipeline_max_stages": max_stages,
+                    "software_pipeline_shared_memory_bytes": shared_memory_bytes,
+                },
+            ):
+                with T.block("compute"):
+                    T.reads(A[tx, i])
+                    T.writes(C[tx, i])
+                    B = T.alloc_buffer((16, 1), dtype="float32", scope="shared")
+                    with T.block():
+                        T.reads(A[tx, i])
+                        T.writes(B[tx, 0])
+                        B[tx, 0] = A[tx, i] * T.float32(2)
+                    with T.block():
+                        T.reads(B[tx, 0])
+                        T.writes(C[tx, i])
+                        C[tx, i] = B[tx, 0] + T.float32(1)
+
+    return simple_compute
+
+
+@pytest.mark.parametrize(
+    "max_stages, shared_memory_bytes, last_stage", [(3, 0, 2), (3, 128, 1), (8, 192, 2)]
+)
+def test_simple_compute_auto_pipeline(max_stages, shared_memory_bytes, last_stage):
+    # Each version of B takes 64 bytes, the copy into B goes to stage 0 and the
+    # consumer to the last stage that fits.
+    mod = tvm.IRModule.from_expr(gen_simple_compute(last_stage))
+    mod = tvm.tir.transform.InjectSoftwarePipeline()(mod)
+    expected = tvm.tir.transform.Simplify()(mod)["main"]
+    _check(gen_simple_compute_auto_pipeline(max_stages, shared_memory_bytes), expected)
+
+
+def test_simple_compute_auto_pipeline_exceed_budget():
+    func = gen_simple_compute_auto_pipeline(3, 64)
+    mod = tvm.tir.transform.InjectSoftwarePipeline()(tvm.IRModule.from_expr(func))
+    # Two versions of B would not fit, the loop is kept without the annotations.
+    assert not mod["main"].body.body.annotations
+
+
+def gen_vtcm_copy_compute(annotations):
+    @T.prim_func
+    def vtcm_copy_compute(A: T.Buffer((16, 16), "float32"), C: T.Buffer((16, 16), "float32")):
+        for i in T.serial(0, 16, annotations=annotations):
+            with T.block("compute"):
+                T.reads(A[i, 0:16])
+                T.writes(C[i, 0:16])
+                B = T.alloc_buffer((1, 16), dtype="float32", scope="global.vtcm")
+                with T.block():
+                    T.reads(A[i, 0:16])
+                    T.writes(B[0, 0:16])
+                    for j in T.serial(16):
+                        B[0, j] = A[i, j]
+                with T.block():
+                    T.reads(B[0, 0:16])
+                    T.writes(C[i, 0:16])
+                    for j in T.serial(16):
+                        C[i, j] = B[0, j] + T.float32(1)
+
+    return vtcm_copy_compute
+
+
+def test_vtcm_copy_auto_pipeline():
+    # Two versions of B fit in the 128 bytes of VTCM, and the copies in stage 0 are made
+    # asynchronous so that LowerAsyncDMA turns them into DMA.
+    annotations = {
+        "software_pipeline_stage": [0, 1],
+        "software_pipeline_order": [0, 1],
+        "software_pipeline_async_stages": [0],
+    }
+    expected = tvm.tir.transform.InjectSoftwarePipeline()(
+        tvm.IRModule.from_expr(gen_vtcm_copy_compute(annotations))
+    )
+    func = gen_vtcm_copy_compute({"software_pipeline_max_stages": 3})
+    config = {"tir.vtcm_capacity": 128, "tir.use_async_copy": 1}
+    with tvm.transform.PassContext(config=config):
+        mod = tvm.tir.transform.InjectSoftwarePipeline()(tvm.IRModule.from_expr(func))
+    tvm.ir.assert_structural_equal(mod["main"], expected["main"], True)
+
+
 def test_simple_compute_with_other_annotation():
     _check(simple_compute_with_other_annotation, transformed_simple_compute_with_other_annotation)
 
@@ -828,5 +828,54 @@ def test_loop_partition_with_unit_loop_in_condition():
     assert tvm.ir.structural_equal(mod["main"], after)
 
 
+def _multi_likely_func():
+    n = 94
+    m = 62
+    A = te.placeholder((n, m), name="A")
+    B = te.placeholder((n, m), name="B")
+    T = te.compute((n, m), lambda i, j: A[i, j] + B[i, j])
+    s = te.create_schedule(T.op)
+    x, y = T.op.axis
+    xo, xi = s[T].split(x, factor=16)
+    yo, yi = s[T].split(y, factor=16)
+    s[T].reorder(xo, yo, xi, yi)
+    bounds = tvm.te.schedule.InferBound(s)
+    stmt = tvm.te.schedule.ScheduleOps(s, bounds)
+    return tvm.tir.PrimFunc([], stmt)
+
+
+def test_partition_budget():
+    def partition(func, **cfg):
+        mod = tvm.IRModule.from_expr(func)
+        cfg["partition_const_loop"] = True
+        with tvm.transform.PassContext(config={"tir.LoopPartition": cfg}):
+            mod = tvm.tir.transform.LoopPartition()(mod)
+            stmt = tvm.tir.transform.Simplify()(mod)["main"].body
+        num_ifs = sum(collect_visit(stmt, lambda x: isinstance(x, tvm.tir.IfThenElse)))
+        num_loops = sum(collect_visit(stmt, lambda x: isinstance(x, tvm.tir.For)))
+        return num_ifs, num_loops
+
+    func = _multi_likely_func()
+    ifs_unbounded, loops_unbounded = partition(func)
+    assert ifs_unbounded == 0
+
+    # no variant may be generated, the loop nest keeps its predicated body
+    ifs_none, loops_none = partition(func, max_variants=0)
+    assert ifs_none > 0
+    assert loops_none < loops_unbounded
+
+    # the main body is partitioned first, the edges keep their predicates
+    ifs_one, loops_one = partition(func, max_variants=1)
+    assert ifs_one > 0
+    assert loops_none < loops_one < loops_unbounded
+
+    ifs_small, _ = partition(func, max_code_size=1)
+    assert ifs_small > 0
+
+    # the PrimFunc attribute overrides the pass config
+    bounded = func.with_attr("tir.loop_partition_max_variants", 0)
+    assert partition(bounded) == (ifs_none, loops_none)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
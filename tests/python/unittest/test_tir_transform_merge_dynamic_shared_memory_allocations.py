@@ -326,8 +326,66 @@ def test_dyn_shared_more_dtype():
         check_target(target)
 
 
+def test_dyn_shared_interval_packing():
+    """Buffers live at disjoint times share memory, whatever their size"""
+    n = 64
+
+    def test_device_ir(A, B, D):
+        ib = tvm.tir.ir_builder.create()
+
+        tx = te.thread_axis("threadIdx.x")
+        ib.scope_attr(tx, "thread_extent", n)
+
+        A_sh = ib.allocate("float32", (n * 2,), scope="shared.dyn", name="A_sh")
+        B_sh = ib.allocate("float32", (n,), scope="shared.dyn", name="B_sh")
+        C_sh = ib.allocate("float32", (n,), scope="shared.dyn", name="C_sh")
+
+        Aptr = ib.buffer_ptr(A)
+        Bptr = ib.buffer_ptr(B)
+        Dptr = ib.buffer_ptr(D)
+
+        A_sh[tx] = Aptr[tx]
+        Dptr[tx] = A_sh[tx]
+
+        B_sh[tx] = Bptr[tx]
+        C_sh[tx] = Bptr[tx] + 1.0
+        Dptr[tx] += B_sh[tx] + C_sh[tx]
+        return ib.get()
+
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.placeholder((n,), name="B", dtype="float32")
+    D = te.extern(
+        (n,),
+        [A, B],
+        lambda ins, outs: test_device_ir(ins[0], ins[1], outs[0]),
+        name="vadd",
+        dtype="float32",
+    )
+    s = te.create_schedule(D.op)
+
+    def merge(config=None):
+        mod = schedule_to_module(s, [A, B, D])
+        with tvm.transform.PassContext(
+            config={"tir.MergeDynamicSharedMemoryAllocations": config or {}}
+        ):
+            return tvm.transform.Sequential(
+                [
+                    tvm.tir.transform.StorageFlatten(64),
+                    tvm.tir.transform.Simplify(),
+                    tvm.tir.transform.MergeDynamicSharedMemoryAllocations(),
+                ]
+            )(mod)
+
+    # B and C both fit in the 512 bytes of A, which is dead by then.
+    verify_single_allocation(merge()["main"].body, 512)
+    # With padding, A takes 544 bytes, B 288 bytes and C starts 288 bytes after B.
+    mod = merge({"align_bytes": 16, "swizzle_pad_bytes": 32})
+    verify_single_allocation(mod["main"].body, 576)
+
+
 if __name__ == "__main__":
     test_matmul_dyn_shared()
     test_dyn_shared_vectorized_store()
     test_dyn_shared_reuse_and_merge()
     test_dyn_shared_more_dtype()
+    test_dyn_shared_interval_packing()
@@ -63,6 +63,30 @@ def test_cow_pass():
     assert func_hash == mod["main"].__hash__()
 
 
+def test_parallel_prim_func_pass():
+    funcs = {}
+    for i in range(8):
+        x = te.var("x")
+        n = te.var("n")
+        stmt = tvm.tir.IfThenElse(
+            x + i < x + i + 1, tvm.tir.Evaluate(x * 1 + 0), tvm.tir.Evaluate(n)
+        )
+        funcs["func%d" % i] = tvm.tir.PrimFunc([x, n], stmt)
+    mod = tvm.IRModule(funcs)
+
+    expected = tvm.tir.transform.Simplify()(mod)
+    with tvm.transform.PassContext(config={"tir.num_pass_threads": 4}):
+        after = tvm.tir.transform.Simplify()(mod)
+
+    assert [gv.name_hint for gv in after.get_global_vars()] == [
+        gv.name_hint for gv in expected.get_global_vars()
+    ]
+    tvm.ir.assert_structural_equal(after, expected)
+    for i in range(8):
+        assert isinstance(after["func%d" % i].body, tvm.tir.Evaluate)
+
+
 if __name__ == "__main__":
     test_cow_pass()
     test_prim_func_pass()
+    test_parallel_prim_func_pass()
@@ -336,5 +336,24 @@ def test6():
     tvm.ir.assert_structural_equal(mod["main"], test6_expected_output)
 
 
+
+@tvm.testing.requires_llvm
+def test_lwp_report_cpu():
+    with tvm.transform.PassContext(config=default_lwp_test_config):
+        func = tvm.build(tvm.IRModule.from_expr(input1), target="llvm")
+    tvm.runtime.profiling.lwp_report(reset=True)
+    a = tvm.nd.array(numpy.ones((8, 8, 128), dtype="int32"))
+    b = tvm.nd.empty((8, 8, 128), dtype="int32")
+    c = tvm.nd.empty((8, 8, 128), dtype="int32")
+    func(a, b, c)
+    report = tvm.runtime.profiling.lwp_report(func, reset=True)
+    # The two sibling loop nests run once per iteration of the outer loops.
+    assert len(report.calls) == 2
+    for call in report.calls:
+        assert call["Device"] == "cpu0"
+        assert call["Count"].value == 64
+        assert call["Duration (us)"].microseconds > 0
+    assert len(tvm.runtime.profiling.lwp_report().calls) == 0
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -936,6 +936,36 @@ class TestSimplifyRHSOfBooleanAndUsingLHSWithoutConst(BaseBeforeAfter):
         A[0] = n < m + 5
 
 
+class TestTransitiveProofAfterExitingScope(BaseBeforeAfter):
+    """Comparisons known in a scope are forgotten after exiting it
+
+    The chain `a < b < c < d` proves `a < d` inside the nested
+    conditions, but after exiting the `a < b` condition, only `b < c`
+    is known and `a < c` may not be proven.
+    """
+
+    transitively_prove_inequalities = True
+
+    def before(A: T.Buffer(2, "int32"), a: T.int32, b: T.int32, c: T.int32, d: T.int32):
+        if a < b:
+            if b < c:
+                if c < d:
+                    if a < d:
+                        A[0] = 1
+        if b < c:
+            if a < c:
+                A[1] = 1
+
+    def expected(A: T.Buffer(2, "int32"), a: T.int32, b: T.int32, c: T.int32, d: T.int32):
+        if a < b:
+            if b < c:
+                if c < d:
+                    A[0] = 1
+        if b < c:
+            if a < c:
+                A[1] = 1
+
+
 class TestSimplifyLHSOfBooleanAndUsingRHSWithoutConst(BaseBeforeAfter):
     """Boolean expressions can introduce contexts for their arguments.
 
@@ -1166,6 +1196,36 @@ class TestNoSimplifyFromScopedInputAssumption(BaseBeforeAfter):
     expected = before
 
 
+class TestSimplifyUsingSymbolicAssumption(BaseBeforeAfter):
+    """Bounds and divisibility from a T.assume apply to the statements after it"""
+
+    def before(A: T.Buffer(1, "int32"), n: T.int32):
+        T.evaluate(T.assume(n % 4 == 0 and n >= 8))
+        if n >= 4:
+            A[0] = n % 4
+
+    def expected(A: T.Buffer(1, "int32"), n: T.int32):
+        T.evaluate(T.assume(n % 4 == 0 and n >= 8))
+        A[0] = 0
+
+
+class TestSimplifyUsingBufferShape(BaseBeforeAfter):
+    """The symbolic shape of a buffer argument is non-negative"""
+
+    def before(a: T.handle):
+        n = T.int32()
+        A = T.match_buffer(a, (n,), "int32")
+        for i in range(16):
+            if n >= 0:
+                A[0] = i
+
+    def expected(a: T.handle):
+        n = T.int32()
+        A = T.match_buffer(a, (n,), "int32")
+        for i in range(16):
+            A[0] = i
+
+
 class TestSimplifyConditionalUsingBufferValue(BaseBeforeAfter):
     """Simplify a conditional using the known value in the buffer"""
 
@@ -663,6 +663,59 @@ def test_reuse_small_buffer():
     assert num_alloc[0] == 1
 
 
+def test_reuse_smaller_buffer_of_other_dtype():
+    ib = tvm.tir.ir_builder.create()
+    out = ib.pointer("int8", name="out")
+    A = ib.allocate("float32", 200, name="A", scope="global")
+    B = ib.allocate("int8", 1200, name="B", scope="global")
+    with ib.for_range(0, 200, name="j") as j:
+        A[j] = tvm.tir.const(1.5, "float32")
+    with ib.for_range(0, 200, name="j") as j:
+        out[j] = A[j].astype("int8")
+    with ib.for_range(0, 1200, name="j") as j:
+        B[j] = tvm.tir.const(1, "int8")
+    with ib.for_range(0, 1200, name="j") as j:
+        out[j] = B[j]
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([out.asobject().data], ib.get()))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    allocs = []
+    tvm.tir.stmt_functor.post_order_visit(
+        body, lambda n: allocs.append(n) if isinstance(n, tvm.tir.Allocate) else None
+    )
+    # A is dead before B is written, B takes over and grows its storage to 1200 bytes.
+    assert len(allocs) == 1
+    assert allocs[0].dtype == "float32"
+    assert allocs[0].extents[0].value == 300
+
+
+def test_inplace_rule_other_dtype():
+    ib = tvm.tir.ir_builder.create()
+    out = ib.pointer("int32", name="out")
+    A = ib.allocate("float32", 200, name="A", scope="global")
+    B = ib.allocate("int32", 200, name="B", scope="global")
+    with ib.for_range(0, 200, name="j") as j:
+        A[j] = tvm.tir.const(1.5, "float32")
+    with ib.for_range(0, 200, name="j") as j:
+        B[j] = A[j].astype("int32")
+    with ib.for_range(0, 200, name="j") as j:
+        out[j] = B[j]
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([out.asobject().data], ib.get()))
+    body = tvm.tir.transform.StorageRewrite()(mod)["main"].body
+
+    num_alloc = [0]
+
+    def verify(n):
+        if isinstance(n, tvm.tir.Allocate):
+            num_alloc[0] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(body, verify)
+    # B[j] only depends on A[j], and both elements are 32 bits, so B is computed inplace.
+    assert num_alloc[0] == 1
+
+
 def test_replace_dataflow():
     shape = (255,)
     A = te.placeholder(shape, name="A")
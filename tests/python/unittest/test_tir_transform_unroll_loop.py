@@ -69,6 +69,34 @@ def test_unroll_loop():
         assert ret[1].kind != tvm.tir.ForKind.UNROLLED
 
 
+def test_unroll_register_code_size_limit():
+    ib = tvm.tir.ir_builder.create()
+    Ab = tvm.tir.decl_buffer((64,), "float32")
+    Aptr = ib.buffer_ptr(Ab)
+    with ib.for_range(0, 8, name="i") as i:
+        # 3 loads are live per step, so the unrolled loop needs about 24 registers
+        Aptr[i] = Aptr[i + 8] * Aptr[i + 16] + Aptr[i + 24]
+    stmt = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab], stmt))
+
+    def unroll(**config):
+        with tvm.transform.PassContext(config={"tir.UnrollLoop": {"auto_max_step": 64, **config}}):
+            return tvm.tir.transform.UnrollLoop()(mod)["main"].body
+
+    assert not isinstance(unroll(), tvm.tir.For)
+    assert not isinstance(unroll(auto_max_registers=24), tvm.tir.For)
+    assert isinstance(unroll(auto_max_registers=23), tvm.tir.For)
+    assert not isinstance(unroll(auto_max_code_size=10000), tvm.tir.For)
+    assert isinstance(unroll(auto_max_code_size=16), tvm.tir.For)
+
+    # The limits can also be set for a scope by pragmas.
+    ib = tvm.tir.ir_builder.create()
+    ib.scope_attr(tvm.tir.const(0, "int32"), "pragma_auto_unroll_max_registers", 16)
+    ib.emit(stmt)
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab], ib.get()))
+    assert isinstance(unroll(), tvm.tir.For)
+
+
 def test_unroll_fake_loop():
     ib = tvm.tir.ir_builder.create()
     dtype = "int32"
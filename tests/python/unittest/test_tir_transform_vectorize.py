@@ -14,7 +14,10 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
+
 import tvm
+import tvm.testing
 from tvm import te
 
 
@@ -226,6 +229,39 @@ def test_vectorize_dtype_mismatch():
     tvm.lower(s, [A], "llvm", simple_mode=True)
 
 
+def test_vectorize_predicated_tail():
+    n = 77
+    A = te.placeholder((n,), name="A", dtype="float32")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    _, xi = s[B].split(B.op.axis[0], factor=16)
+    s[B].vectorize(xi)
+
+    with tvm.transform.PassContext(config={"tir.enable_buffer_level_predication": True}):
+        mod = tvm.lower(s, [A, B])
+        f = tvm.build(s, [A, B], "llvm")
+
+    accesses = []
+    loops = []
+
+    def _visit(op):
+        if isinstance(op, (tvm.tir.BufferLoad, tvm.tir.BufferStore)):
+            accesses.append(op)
+        elif isinstance(op, tvm.tir.For):
+            loops.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, _visit)
+    # The tail is handled by masked accesses instead of a scalar loop.
+    assert len(loops) == 1
+    assert accesses and all(access.predicate is not None for access in accesses)
+
+    dev = tvm.cpu()
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.zeros(n, dtype=B.dtype), dev)
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+
 if __name__ == "__main__":
     test_vectorize_vector()
     test_vectorize_with_if()
@@ -236,3 +272,4 @@ if __name__ == "__main__":
     test_vectorize_let()
     test_vectorize_while_fail()
     test_vectorize_dtype_mismatch()
+    test_vectorize_predicated_tail()
@@ -124,6 +124,44 @@ def test_no_pool_error():
         buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
 
 
+def test_bandwidth_placement():
+    """This checks the buffers with the most traffic per byte fill the fast pool first"""
+    target = Target("c")
+    slow_memory_pool = WorkspacePoolInfo(
+        "slow_memory",
+        [target],
+        PoolInfoProperties(read_bandwidth_bytes_per_cycle=2, write_bandwidth_bytes_per_cycle=2),
+    )
+    fast_memory_pool = WorkspacePoolInfo(
+        "fast_memory",
+        [target],
+        PoolInfoProperties(
+            size_hint_bytes=96,
+            read_bandwidth_bytes_per_cycle=16,
+            write_bandwidth_bytes_per_cycle=16,
+        ),
+    )
+    pools = [slow_memory_pool, fast_memory_pool]
+    bi_hot = usmp_utils.BufferInfo(name_hint="bi_hot", size_bytes=64, pool_candidates=pools)
+    bi_warm = usmp_utils.BufferInfo(name_hint="bi_warm", size_bytes=32, pool_candidates=pools)
+    bi_cold = usmp_utils.BufferInfo(name_hint="bi_cold", size_bytes=80, pool_candidates=pools)
+    bi_hot.set_access_bytes(4800, 1200)
+    bi_warm.set_access_bytes(800, 200)
+    bi_cold.set_access_bytes(80, 80)
+    bi_hot.set_conflicts([bi_warm, bi_cold])
+    bi_warm.set_conflicts([bi_hot, bi_cold])
+    bi_cold.set_conflicts([bi_hot, bi_warm])
+
+    fusmp_algo = tvm.get_global_func("tir.usmp.algo.greedy_by_bandwidth")
+    buffer_pool_allocations = fusmp_algo([bi_cold, bi_warm, bi_hot], 0)
+    assert buffer_pool_allocations[bi_hot].pool_info == fast_memory_pool
+    assert buffer_pool_allocations[bi_hot].byte_offset == 0
+    assert buffer_pool_allocations[bi_warm].pool_info == fast_memory_pool
+    assert buffer_pool_allocations[bi_warm].byte_offset == 64
+    assert buffer_pool_allocations[bi_cold].pool_info == slow_memory_pool
+    assert buffer_pool_allocations[bi_cold].byte_offset == 0
+
+
 @pytest.mark.parametrize("algorithm", ["greedy_by_size", "greedy_by_conflicts", "hill_climb"])
 def test_name_based_ordering(algorithm):
     """This checks when the size and conlicts are same a stable result is generated"""
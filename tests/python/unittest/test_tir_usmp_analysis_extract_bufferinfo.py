@@ -202,6 +202,14 @@ def test_linear():
     assert buffer_info_map["tensor_2"].size_bytes == 200704
     assert buffer_info_map["sid_9"].size_bytes == 301056
 
+    # check the traffic, weighted by the loop extents
+    assert buffer_info_map["PaddedInput_7"].write_bytes == 314646
+    assert buffer_info_map["PaddedInput_7"].read_bytes == 236027904
+    assert buffer_info_map["tensor_2"].write_bytes == 2007040
+    assert buffer_info_map["tensor_2"].read_bytes == 2007040
+    assert buffer_info_map["sid_9"].write_bytes == 301056
+    assert buffer_info_map["sid_9"].read_bytes == 314646
+
     # check_pool_candidates
     assert [
         pool_info.pool_name for pool_info in list(buffer_info_map["sid_8"].pool_candidates)
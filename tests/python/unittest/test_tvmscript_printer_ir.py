@@ -15,7 +15,10 @@
 # specific language governing permissions and limitations
 # under the License.
 # pylint: disable=missing-docstring
-from tvm import IRModule
+import os
+import tempfile
+
+from tvm import IRModule, te
 from tvm.script.ir_builder import IRBuilder
 from tvm.script.ir_builder import ir as I
 from tvm.script.ir_builder import tir as T
@@ -48,5 +51,30 @@ class Module:
     )
 
 
+def _large_module(num_funcs):
+    funcs = {}
+    for i in range(num_funcs):
+        a = te.placeholder((128, 128), name="A")
+        b = te.compute((128, 128), lambda x, y, i=i: a[x, y] * (i + 1), name="B")
+        funcs[f"func_{i}"] = te.create_prim_func([a, b])
+    return IRModule(funcs)
+
+
+def test_ir_module_parallel():
+    mod = _large_module(16)
+    assert mod.script(num_threads=4) == mod.script()
+
+
+def test_ir_module_script_to_file():
+    # Large enough to be written in several chunks
+    mod = _large_module(200)
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "mod.py")
+        mod.script_to_file(path, num_threads=4)
+        with open(path) as script_file:
+            assert script_file.read() == mod.script()
+
 if __name__ == "__main__":
     test_ir_module()
+    test_ir_module_parallel()
+    test_ir_module_script_to_file()
@@ -52,8 +52,16 @@
 #include "src/runtime/system_library.cc"
 #include "src/runtime/workspace_pool.cc"
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+// The pthreads build runs the parallel loops on the native thread pool,
+// whose workers are backed by web workers sharing the wasm memory.
+#include "src/runtime/thread_pool.cc"
+#include "src/runtime/threading_backend.cc"
+#endif
+
 // --- Implementations of backend and wasm runtime API. ---
 
+#ifndef __EMSCRIPTEN_PTHREADS__
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   TVMParallelGroupEnv env;
   env.num_task = 1;
@@ -62,6 +70,7 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
 }
 
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) { return 0; }
+#endif
 
 // --- Environment PackedFuncs for testing ---
 namespace tvm {
@@ -36,6 +36,24 @@ export async function detectGPUDevice(): Promise<GPUDevice | undefined | null> {
   }
 }
 
+/**
+ * Round the size of a buffer allocation up to its size class.
+ *
+ * The size classes have 2 bits of mantissa, so that a pooled buffer wastes
+ * at most a quarter of its size.
+ *
+ * @param nbytes The requested number of bytes.
+ * @returns The size of the buffer to allocate.
+ */
+function bufferSizeClass(nbytes: number): number {
+  const minSize = 256;
+  if (nbytes <= minSize) {
+    return minSize;
+  }
+  const unit = Math.pow(2, Math.floor(Math.log2(nbytes)) - 2);
+  return Math.ceil(nbytes / unit) * unit;
+}
+
 interface FunctionInfo {
   name: string;
   arg_types: Array<string>;
@@ -50,11 +68,18 @@ export class WebGPUContext {
   device: GPUDevice;
   memory: Memory;
 
-  //private readBuffer:;
   private bufferTable: Array<GPUBuffer | undefined> = [undefined];
   private bufferTableFreeId: Array<number> = [];
   private pendingRead: Promise<void> = Promise.resolve();
   private numPendingReads = 0;
+  // freed storage and readback staging buffers, keyed by size class.
+  private bufferPool: Map<number, Array<GPUBuffer>> = new Map();
+  private stagingBufferPool: Map<number, Array<GPUBuffer>> = new Map();
+  // commands recorded since the last submission.
+  private pendingEncoder: GPUCommandEncoder | undefined = undefined;
+  private numPendingDispatches = 0;
+  /** Maximum number of dispatches recorded before they are submitted. */
+  maxNumPendingDispatches = 1024;
 
   constructor(memory: Memory, device: GPUDevice) {
     this.memory = memory;
@@ -65,6 +90,7 @@ export class WebGPUContext {
    * Wait for all pending GPU tasks to complete
    */
   async sync(): Promise<void> {
+    this.flushCommands();
     if (this.numPendingReads != 0) {
       await Promise.all([
         this.device.queue.onSubmittedWorkDone(),
@@ -75,6 +101,33 @@ export class WebGPUContext {
     }
   }
 
+  /**
+   * Submit the commands recorded so far to the device queue.
+   *
+   * The dispatches and the copies within the GPU are recorded into a single
+   * command encoder, and only submitted when their result is needed or too
+   * many of them are pending.
+   */
+  flushCommands(): void {
+    if (this.pendingEncoder === undefined) return;
+    const command = this.pendingEncoder.finish();
+    this.pendingEncoder = undefined;
+    this.numPendingDispatches = 0;
+    this.device.queue.submit([command]);
+  }
+
+  /**
+   * Release the buffers kept in the pools back to the device.
+   */
+  releasePooledBuffers(): void {
+    for (const pool of [this.bufferPool, this.stagingBufferPool]) {
+      pool.forEach((buffers) => {
+        buffers.forEach((buffer) => buffer.destroy());
+      });
+      pool.clear();
+    }
+  }
+
   /**
    * Create a PackedFunc that runs the given shader
    *
@@ -132,8 +185,7 @@ export class WebGPUContext {
     }
 
     const submitShader = (...args: Array<GPUPointer | number>): void => {
-      const commandEncoder = this.device.createCommandEncoder();
-      const compute = commandEncoder.beginComputePass();
+      const compute = this.getCommandEncoder().beginComputePass();
       compute.setPipeline(pipeline);
       const bindGroupEntries: Array<GPUBindGroupEntry> = [];
       assert(args.length == layoutEntries.length + dispatchToDim.length);
@@ -157,8 +209,10 @@ export class WebGPUContext {
       }
       compute.dispatchWorkgroups(wl[0], wl[1], wl[2])
       compute.end()
-      const command = commandEncoder.finish();
-      this.device.queue.submit([command]);
+      this.numPendingDispatches += 1;
+      if (this.numPendingDispatches >= this.maxNumPendingDispatches) {
+        this.flushCommands();
+      }
     };
 
     return submitShader;
@@ -214,10 +268,11 @@ export class WebGPUContext {
 
   // DeviceAPI
   private deviceAllocDataSpace(nbytes: number): GPUPointer {
-    const buffer = this.device.createBuffer({
-      size: nbytes,
-      usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST,
-    });
+    const buffer = this.allocBuffer(
+      this.bufferPool,
+      nbytes,
+      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST
+    );
     return this.attachToBufferTable(buffer);
   }
 
@@ -227,7 +282,9 @@ export class WebGPUContext {
     this.bufferTable[idx] = undefined;
     assert(buffer !== undefined);
     this.bufferTableFreeId.push(idx);
-    buffer.destroy();
+    // The commands already recorded on the buffer run before any later use of it,
+    // so the buffer can be reused right away.
+    this.freeBuffer(this.bufferPool, buffer);
   }
 
   private deviceCopyToGPU(
@@ -236,30 +293,13 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to use a staging buffer?
-    const gpuTemp = this.device.createBuffer({
-      mappedAtCreation: true,
-      size: nbytes,
-      usage: GPUBufferUsage.MAP_WRITE | GPUBufferUsage.COPY_SRC
-    });
-
-    const cpuTemp = gpuTemp.getMappedRange();
-
-    const viewU8 = new Uint8Array(cpuTemp);
-    viewU8.set(this.memory.loadRawBytes(from, nbytes));
-    gpuTemp.unmap();
-
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
-      gpuTemp,
-      0,
+    // writeBuffer is ordered before the commands that are not submitted yet.
+    this.flushCommands();
+    this.device.queue.writeBuffer(
       this.gpuBufferFromPtr(to),
       toOffset,
-      nbytes
+      this.memory.loadRawBytes(from, nbytes)
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
-    gpuTemp.destroy();
   }
 
   private deviceCopyFromGPU(
@@ -268,30 +308,29 @@ export class WebGPUContext {
     to: Pointer,
     nbytes: number
   ): void {
-    // Perhaps it would be more useful to resuse a staging buffer?
-    const gpuTemp = this.device.createBuffer({
-      size: nbytes,
-      usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
-    });
+    const gpuTemp = this.allocBuffer(
+      this.stagingBufferPool,
+      nbytes,
+      GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST
+    );
 
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
+    this.getCommandEncoder().copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
       gpuTemp,
       0,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
+    this.flushCommands();
 
     this.numPendingReads += 1;
 
-    const readEvent = gpuTemp.mapAsync(GPUMapMode.READ).then(() => {
-      const data = gpuTemp.getMappedRange();
+    const readEvent = gpuTemp.mapAsync(GPUMapMode.READ, 0, nbytes).then(() => {
+      const data = gpuTemp.getMappedRange(0, nbytes);
       this.memory.storeRawBytes(to, new Uint8Array(data));
       this.numPendingReads -= 1;
-      gpuTemp.destroy();
+      gpuTemp.unmap();
+      this.freeBuffer(this.stagingBufferPool, gpuTemp);
     });
 
     if (this.numPendingReads == 1) {
@@ -312,16 +351,42 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
-    const copyEncoder = this.device.createCommandEncoder();
-    copyEncoder.copyBufferToBuffer(
+    this.getCommandEncoder().copyBufferToBuffer(
       this.gpuBufferFromPtr(from),
       fromOffset,
       this.gpuBufferFromPtr(to),
       toOffset,
       nbytes
     );
-    const copyCommands = copyEncoder.finish();
-    this.device.queue.submit([copyCommands]);
+  }
+
+  private getCommandEncoder(): GPUCommandEncoder {
+    if (this.pendingEncoder === undefined) {
+      this.pendingEncoder = this.device.createCommandEncoder();
+    }
+    return this.pendingEncoder;
+  }
+
+  private allocBuffer(
+    pool: Map<number, Array<GPUBuffer>>,
+    nbytes: number,
+    usage: number
+  ): GPUBuffer {
+    const size = bufferSizeClass(nbytes);
+    const buffers = pool.get(size);
+    if (buffers !== undefined && buffers.length != 0) {
+      return buffers.pop() as GPUBuffer;
+    }
+    return this.device.createBuffer({ size: size, usage: usage });
+  }
+
+  private freeBuffer(pool: Map<number, Array<GPUBuffer>>, buffer: GPUBuffer): void {
+    const buffers = pool.get(buffer.size);
+    if (buffers !== undefined) {
+      buffers.push(buffer);
+    } else {
+      pool.set(buffer.size, [buffer]);
+    }
   }
 
   private gpuBufferFromPtr(ptr: GPUPointer): GPUBuffer {